@@ -0,0 +1,627 @@
+/*****************************************************************************
+FILE: espa_bench.c
+
+PURPOSE: Contains reproducible microbenchmarks for the hot kernels in the
+raw binary libraries, for validating vendor kernels and catching regressions
+between releases.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Every benchmark runs on synthetic, fixed inputs so the numbers are
+     comparable between runs and between machines; no scene data is needed.
+  2. Each kernel gets a warmup pass before the timed pass.  The raw binary
+     throughput numbers go through the page cache, like the converters do.
+*****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "ias_math.h"
+#include "ias_angle_gen_distro.h"
+#include "gctp.h"
+#include "espa_metadata.h"
+#include "parse_metadata.h"
+#include "write_metadata.h"
+#include "raw_binary_io.h"
+
+/* Number of vertices in the synthetic point-in-polygon coastline */
+#define BENCH_POLY_VERTS 1024
+
+/* Grid dimension for the RPC angle evaluation (ops = grid * grid) */
+#define BENCH_RPC_GRID 1000
+
+/* Number of coordinate pairs pushed through the UTM transforms */
+#define BENCH_UTM_COORDS 1000000
+
+/* Number of bands in the generated metadata document */
+#define BENCH_XML_NBANDS 100
+
+/* Number of parses of the generated metadata document */
+#define BENCH_XML_PARSES 20
+
+/* Size of the raw binary throughput scratch file */
+#define BENCH_IO_CHUNK (4 * 1024 * 1024)
+#define BENCH_IO_CHUNKS 64
+
+/******************************************************************************
+MODULE:  bench_seconds (static)
+
+PURPOSE:  Returns the monotonic clock in seconds.
+
+RETURN VALUE:
+Type = double
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static double bench_seconds (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/******************************************************************************
+MODULE:  bench_report (static)
+
+PURPOSE:  Prints one result line with ns/op, and GB/s when the benchmark
+moved bytes.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static void bench_report
+(
+    const char *name,     /* I: benchmark name */
+    long long ops,        /* I: operations in the timed pass */
+    double elapsed,       /* I: seconds in the timed pass */
+    long long bytes       /* I: bytes moved in the timed pass, or 0 */
+)
+{
+    printf ("  %-26s %12lld ops  %10.1f ns/op", name, ops,
+        elapsed * 1e9 / ops);
+    if (bytes > 0)
+        printf ("  %7.2f GB/s", bytes / elapsed / 1e9);
+    printf ("\n");
+    fflush (stdout);
+}
+
+/******************************************************************************
+MODULE:  bench_point_in_polygon (static)
+
+PURPOSE:  Times ias_math_point_in_closed_polygon against a fixed 1024-vertex
+polygon with a deterministic stream of query points.
+
+RETURN VALUE:
+Type = int (SUCCESS or ERROR)
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static int bench_point_in_polygon (void)
+{
+    static double vert_x[BENCH_POLY_VERTS + 1];
+    static double vert_y[BENCH_POLY_VERTS + 1];
+    long long ops = 200000;
+    long long inside = 0;
+    unsigned int seed = 12345;
+    double start;
+    long long i;
+    int pass;
+
+    /* A wobbly closed ring standing in for a coastline */
+    for (i = 0; i <= BENCH_POLY_VERTS; i++)
+    {
+        double theta = 2.0 * M_PI * i / BENCH_POLY_VERTS;
+        double radius = 1.0 + 0.3 * sin (9.0 * theta);
+        vert_x[i] = radius * cos (theta);
+        vert_y[i] = radius * sin (theta);
+    }
+
+    for (pass = 0; pass < 2; pass++)
+    {
+        inside = 0;
+        seed = 12345;
+        start = bench_seconds ();
+        for (i = 0; i < ops; i++)
+        {
+            double px, py;
+
+            seed = seed * 1103515245u + 12345u;
+            px = (double) (seed >> 8 & 0xffff) / 65535.0 * 3.0 - 1.5;
+            seed = seed * 1103515245u + 12345u;
+            py = (double) (seed >> 8 & 0xffff) / 65535.0 * 3.0 - 1.5;
+            inside += ias_math_point_in_closed_polygon (BENCH_POLY_VERTS,
+                vert_x, vert_y, px, py, 0, NULL);
+        }
+        if (pass == 1)
+            bench_report ("point_in_polygon", ops, bench_seconds () - start,
+                0);
+    }
+
+    /* Sanity check so the loop cannot be optimized away and the kernel is
+       really classifying points */
+    if (inside <= 0 || inside >= ops)
+    {
+        printf ("  point_in_polygon: unexpected inside count %lld\n", inside);
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+/******************************************************************************
+MODULE:  bench_rpc_angles (static)
+
+PURPOSE:  Times ias_angle_gen_calculate_angles_rpc over a grid of L1T
+locations against synthetic single-SCA band metadata.
+
+RETURN VALUE:
+Type = int (SUCCESS or ERROR)
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The image RPC maps the L1T location straight through to L1R and the
+     angle RPCs use small fixed coefficients, so every grid point lands
+     inside the SCA and takes the full evaluation path.
+******************************************************************************/
+static int bench_rpc_angles (void)
+{
+    static IAS_ANGLE_GEN_METADATA metadata;
+    IAS_ANGLE_GEN_BAND *band = &metadata.band_metadata[0];
+    long long ops = (long long) BENCH_RPC_GRID * BENCH_RPC_GRID;
+    double angle_sum = 0.0;
+    double start;
+    int line, samp;
+    int pass;
+    int t;
+
+    memset (&metadata, 0, sizeof (metadata));
+    metadata.num_bands = 1;
+    metadata.band_present[0] = 1;
+    band->band_number = 1;
+    band->num_scas = 1;
+    band->l1t_lines = BENCH_RPC_GRID;
+    band->l1t_samps = BENCH_RPC_GRID;
+    band->l1r_lines = BENCH_RPC_GRID;
+    band->l1r_samps = BENCH_RPC_GRID;
+
+    /* Identity image RPC: L1R line/sample equals L1T line/sample */
+    band->sca_metadata[0].sca_number = 1;
+    band->sca_metadata[0].line_terms.numerator[1] = 1.0;
+    band->sca_metadata[0].samp_terms.numerator[2] = 1.0;
+
+    /* Small fixed angle RPC coefficients pointing the view vector mostly
+       at zenith */
+    band->satellite.mean_offset.x = 0.05;
+    band->satellite.mean_offset.y = 0.03;
+    band->satellite.mean_offset.z = 0.95;
+    for (t = 0; t < IAS_ANGLE_GEN_ANG_RPC_COEF; t++)
+    {
+        band->satellite.x_terms.numerator[t] = 1e-6 * (t + 1);
+        band->satellite.y_terms.numerator[t] = -1e-6 * (t + 2);
+        band->satellite.z_terms.numerator[t] = 1e-7 * (t + 1);
+    }
+
+    for (pass = 0; pass < 2; pass++)
+    {
+        angle_sum = 0.0;
+        start = bench_seconds ();
+        for (line = 0; line < BENCH_RPC_GRID; line++)
+        {
+            for (samp = 0; samp < BENCH_RPC_GRID; samp++)
+            {
+                double angle[2];
+                int outside;
+
+                if (ias_angle_gen_calculate_angles_rpc (&metadata,
+                    line, samp, NULL, 0, IAS_ANGLE_GEN_SATELLITE,
+                    &outside, angle) != SUCCESS || outside)
+                {
+                    printf ("  rpc_angle_eval: evaluation failed at "
+                        "%d,%d\n", line, samp);
+                    return ERROR;
+                }
+                angle_sum += angle[0];
+            }
+        }
+        if (pass == 1)
+            bench_report ("rpc_angle_eval", ops, bench_seconds () - start, 0);
+    }
+
+    if (angle_sum == 0.0)
+    {
+        printf ("  rpc_angle_eval: degenerate angles\n");
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+/******************************************************************************
+MODULE:  bench_utm (static)
+
+PURPOSE:  Times the GCTP geographic-to-UTM forward and inverse transforms
+over a deterministic set of coordinates.
+
+RETURN VALUE:
+Type = int (SUCCESS or ERROR)
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static int bench_utm (void)
+{
+    GCTP_PROJECTION geo_proj;
+    GCTP_PROJECTION utm_proj;
+    GCTP_TRANSFORMATION *forward = NULL;
+    GCTP_TRANSFORMATION *inverse = NULL;
+    double *geo_coords = NULL;
+    double *utm_coords = NULL;
+    double start;
+    double max_error = 0.0;
+    int i;
+    int pass;
+
+    memset (&geo_proj, 0, sizeof (geo_proj));
+    geo_proj.proj_code = GEO;
+    geo_proj.units = DEGREE;
+    geo_proj.spheroid = 12;          /* WGS 84 */
+
+    memset (&utm_proj, 0, sizeof (utm_proj));
+    utm_proj.proj_code = UTM;
+    utm_proj.zone = 13;
+    utm_proj.units = METER;
+    utm_proj.spheroid = 12;          /* WGS 84 */
+
+    forward = gctp_create_transformation (&geo_proj, &utm_proj);
+    inverse = gctp_create_transformation (&utm_proj, &geo_proj);
+    if (forward == NULL || inverse == NULL)
+    {
+        printf ("  gctp_utm: creating the transformations failed\n");
+        return ERROR;
+    }
+
+    geo_coords = malloc (2 * BENCH_UTM_COORDS * sizeof (double));
+    utm_coords = malloc (2 * BENCH_UTM_COORDS * sizeof (double));
+    if (geo_coords == NULL || utm_coords == NULL)
+    {
+        printf ("  gctp_utm: allocating the coordinate arrays failed\n");
+        return ERROR;
+    }
+
+    /* Coordinates spread over the middle of zone 13 */
+    for (i = 0; i < BENCH_UTM_COORDS; i++)
+    {
+        geo_coords[2 * i] = -106.5 + 2.0 * i / BENCH_UTM_COORDS;
+        geo_coords[2 * i + 1] = 35.0 + 10.0 * i / BENCH_UTM_COORDS;
+    }
+
+    for (pass = 0; pass < 2; pass++)
+    {
+        start = bench_seconds ();
+        for (i = 0; i < BENCH_UTM_COORDS; i++)
+        {
+            if (gctp_transform (forward, &geo_coords[2 * i],
+                &utm_coords[2 * i]) != GCTP_SUCCESS)
+            {
+                printf ("  gctp_utm_forward: transform failed\n");
+                return ERROR;
+            }
+        }
+        if (pass == 1)
+            bench_report ("gctp_utm_forward", BENCH_UTM_COORDS,
+                bench_seconds () - start, 0);
+    }
+
+    for (pass = 0; pass < 2; pass++)
+    {
+        start = bench_seconds ();
+        for (i = 0; i < BENCH_UTM_COORDS; i++)
+        {
+            double back[2];
+
+            if (gctp_transform (inverse, &utm_coords[2 * i], back)
+                != GCTP_SUCCESS)
+            {
+                printf ("  gctp_utm_inverse: transform failed\n");
+                return ERROR;
+            }
+            if (pass == 1)
+            {
+                double err = fabs (back[0] - geo_coords[2 * i])
+                    + fabs (back[1] - geo_coords[2 * i + 1]);
+                if (err > max_error)
+                    max_error = err;
+            }
+        }
+        if (pass == 1)
+            bench_report ("gctp_utm_inverse", BENCH_UTM_COORDS,
+                bench_seconds () - start, 0);
+    }
+
+    free (geo_coords);
+    free (utm_coords);
+    gctp_destroy_transformation (forward);
+    gctp_destroy_transformation (inverse);
+
+    /* Round trip must close to well under a pixel */
+    if (max_error > 1e-6)
+    {
+        printf ("  gctp_utm: round trip error %g degrees\n", max_error);
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+/******************************************************************************
+MODULE:  bench_parse_metadata (static)
+
+PURPOSE:  Times parse_metadata on a generated 100-band metadata document.
+
+RETURN VALUE:
+Type = int (SUCCESS or ERROR)
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The document is produced with write_metadata from a synthetic metadata
+     structure, so the benchmark input always matches the current schema.
+******************************************************************************/
+static int bench_parse_metadata (void)
+{
+    char xml_file[] = "espa_bench_metadata.xml";
+    Espa_internal_meta_t out_metadata;
+    Espa_internal_meta_t metadata;
+    Espa_band_meta_t *bmeta = NULL;
+    double start;
+    int i;
+    int pass;
+
+    /* Build the synthetic 100-band metadata */
+    init_metadata_struct (&metadata);
+    if (allocate_band_metadata (&metadata, BENCH_XML_NBANDS) != SUCCESS)
+    {
+        printf ("  parse_metadata: allocating the bands failed\n");
+        return ERROR;
+    }
+    strcpy (metadata.global.data_provider, "USGS/EROS");
+    strcpy (metadata.global.satellite, "LANDSAT_8");
+    strcpy (metadata.global.instrument, "OLI_TIRS");
+    strcpy (metadata.global.acquisition_date, "2026-08-31");
+    metadata.global.ul_corner[0] = 43.0;
+    metadata.global.ul_corner[1] = -106.0;
+    metadata.global.lr_corner[0] = 41.0;
+    metadata.global.lr_corner[1] = -104.0;
+    metadata.global.proj_info.proj_type = GCTP_UTM_PROJ;
+    metadata.global.proj_info.datum_type = ESPA_WGS84;
+    strcpy (metadata.global.proj_info.units, "meters");
+    strcpy (metadata.global.proj_info.grid_origin, "UL");
+    metadata.global.proj_info.utm_zone = 13;
+    metadata.global.proj_info.ul_corner[0] = 255000.0;
+    metadata.global.proj_info.ul_corner[1] = 4764000.0;
+    metadata.global.proj_info.lr_corner[0] = 465000.0;
+    metadata.global.proj_info.lr_corner[1] = 4554000.0;
+    for (i = 0; i < BENCH_XML_NBANDS; i++)
+    {
+        bmeta = &metadata.band[i];
+        sprintf (bmeta->name, "band%d", i + 1);
+        sprintf (bmeta->file_name, "bench_band%d.img", i + 1);
+        strcpy (bmeta->product, "L1T");
+        strcpy (bmeta->category, "image");
+        strcpy (bmeta->data_units, "reflectance");
+        strcpy (bmeta->short_name, "LC8BENCH");
+        strcpy (bmeta->long_name, "benchmark band");
+        bmeta->data_type = ESPA_INT16;
+        bmeta->nlines = 7000;
+        bmeta->nsamps = 7000;
+        bmeta->fill_value = -9999;
+        bmeta->pixel_size[0] = 30.0;
+        bmeta->pixel_size[1] = 30.0;
+        strcpy (bmeta->pixel_units, "meters");
+    }
+
+    if (write_metadata (&metadata, xml_file) != SUCCESS)
+    {
+        printf ("  parse_metadata: writing the document failed\n");
+        free_metadata (&metadata);
+        return ERROR;
+    }
+    free_metadata (&metadata);
+
+    for (pass = 0; pass < 2; pass++)
+    {
+        start = bench_seconds ();
+        for (i = 0; i < BENCH_XML_PARSES; i++)
+        {
+            init_metadata_struct (&out_metadata);
+            if (parse_metadata (xml_file, &out_metadata) != SUCCESS)
+            {
+                printf ("  parse_metadata: parse failed\n");
+                remove (xml_file);
+                return ERROR;
+            }
+            if (out_metadata.nbands != BENCH_XML_NBANDS)
+            {
+                printf ("  parse_metadata: parsed %d bands, expected %d\n",
+                    out_metadata.nbands, BENCH_XML_NBANDS);
+                remove (xml_file);
+                return ERROR;
+            }
+            free_metadata (&out_metadata);
+        }
+        if (pass == 1)
+            bench_report ("parse_metadata_100band", BENCH_XML_PARSES,
+                bench_seconds () - start, 0);
+    }
+
+    remove (xml_file);
+    return SUCCESS;
+}
+
+/******************************************************************************
+MODULE:  bench_raw_binary_io (static)
+
+PURPOSE:  Times write_raw_binary and read_raw_binary throughput on a scratch
+file.
+
+RETURN VALUE:
+Type = int (SUCCESS or ERROR)
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The scratch file goes through the page cache, matching how the
+     converters read and write bands with "rb"/"wb" access.
+******************************************************************************/
+static int bench_raw_binary_io (void)
+{
+    char scratch[] = "espa_bench_scratch.img";
+    unsigned char *chunk = NULL;
+    long long total = (long long) BENCH_IO_CHUNK * BENCH_IO_CHUNKS;
+    double start;
+    FILE *fp = NULL;
+    int i;
+
+    chunk = malloc (BENCH_IO_CHUNK);
+    if (chunk == NULL)
+    {
+        printf ("  raw_binary_io: allocating the chunk failed\n");
+        return ERROR;
+    }
+    for (i = 0; i < BENCH_IO_CHUNK; i++)
+        chunk[i] = (unsigned char) (i * 131);
+
+    /* Write throughput */
+    fp = open_raw_binary (scratch, "wb");
+    if (fp == NULL)
+    {
+        free (chunk);
+        return ERROR;
+    }
+    start = bench_seconds ();
+    for (i = 0; i < BENCH_IO_CHUNKS; i++)
+    {
+        if (write_raw_binary (fp, 1, BENCH_IO_CHUNK, 1, chunk) != SUCCESS)
+        {
+            free (chunk);
+            return ERROR;
+        }
+    }
+    close_raw_binary (fp);
+    bench_report ("raw_binary_write", BENCH_IO_CHUNKS,
+        bench_seconds () - start, total);
+
+    /* Read throughput */
+    fp = open_raw_binary (scratch, "rb");
+    if (fp == NULL)
+    {
+        free (chunk);
+        return ERROR;
+    }
+    start = bench_seconds ();
+    for (i = 0; i < BENCH_IO_CHUNKS; i++)
+    {
+        if (read_raw_binary (fp, 1, BENCH_IO_CHUNK, 1, chunk) != SUCCESS)
+        {
+            free (chunk);
+            return ERROR;
+        }
+    }
+    close_raw_binary (fp);
+    bench_report ("raw_binary_read", BENCH_IO_CHUNKS,
+        bench_seconds () - start, total);
+
+    free (chunk);
+    remove (scratch);
+    return SUCCESS;
+}
+
+/******************************************************************************
+MODULE:  main
+
+PURPOSE:  Runs every microbenchmark and reports ns/op (and GB/s for the
+throughput benchmarks).
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error running the benchmarks
+SUCCESS         All benchmarks ran and their sanity checks passed
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+int main (void)
+{
+    int status = SUCCESS;
+
+    printf ("espa_bench: microbenchmarks of the hot kernels\n");
+
+    if (bench_point_in_polygon () != SUCCESS)
+        status = ERROR;
+    if (bench_rpc_angles () != SUCCESS)
+        status = ERROR;
+    if (bench_utm () != SUCCESS)
+        status = ERROR;
+    if (bench_parse_metadata () != SUCCESS)
+        status = ERROR;
+    if (bench_raw_binary_io () != SUCCESS)
+        status = ERROR;
+
+    if (status != SUCCESS)
+    {
+        printf ("espa_bench: FAILED\n");
+        exit (EXIT_FAILURE);
+    }
+
+    printf ("espa_bench: complete\n");
+    exit (EXIT_SUCCESS);
+}
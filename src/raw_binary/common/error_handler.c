@@ -17,6 +17,7 @@ NOTES:
 *****************************************************************************/
 
 #include "error_handler.h"
+#include "espa_logging.h"
 
 /******************************************************************************
 MODULE:  error_handler
@@ -30,6 +31,8 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 12/12/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Route the messages through the batched logging
+                              support instead of a printf per message
 
 NOTES:
 ******************************************************************************/
@@ -41,8 +44,5 @@ void error_handler
                             ending EOL */
 )
 {
-    if (error_flag)
-        printf ("Error: %s : %s\n\n", module, errmsg);
-    else
-        printf ("Warning: %s : %s\n", module, errmsg);
+    espa_log_message (error_flag, module, "%s", errmsg);
 }
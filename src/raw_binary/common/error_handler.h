@@ -12,6 +12,8 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 12/12/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added the espa_error/espa_warning macros which
+                              format into the thread-local logging storage
 
 NOTES:
 *****************************************************************************/
@@ -23,6 +25,19 @@ NOTES:
 #include <stdbool.h>
 #include <stdio.h>
 #include "espa_common.h"
+#include "espa_logging.h"
+
+/* Error/warning reporting macros which take a printf-style format and
+   format the message directly into the thread-local logging storage.  These
+   save the local errmsg buffer and the sprintf of the classic
+   sprintf/error_handler pattern, which matters in leaf functions called per
+   block of pixels and in deeply recursive parse paths where the 2KB errmsg
+   stack buffers add up.  The arguments are only evaluated on the error
+   path, so nothing is formatted unless a message is actually emitted. */
+#define espa_error(module, ...) \
+    espa_log_message (true, module, __VA_ARGS__)
+#define espa_warning(module, ...) \
+    espa_log_message (false, module, __VA_ARGS__)
 
 /* Prototypes */
 void error_handler
@@ -0,0 +1,192 @@
+/*****************************************************************************
+FILE: espa_bitset.c
+
+PURPOSE: Contains the packed bitset run fill primitives.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. A run touches at most one partial byte at each end, which is filled
+     with a single masked read-modify-write, and the interior whole bytes
+     are stored eight at a time as 64-bit words.  Runs thousands of bits
+     long therefore cost a handful of word stores instead of one
+     read-modify-write per bit.
+*****************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "espa_bitset.h"
+
+/******************************************************************************
+MODULE:  partial_byte_mask (static)
+
+PURPOSE:  Builds the byte mask covering bits first through first+count-1 of a
+byte, most significant bit first.
+
+RETURN VALUE:
+Type = unsigned char
+Value           Description
+-----           -----------
+(mask)          Mask with the covered bits set
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static unsigned char partial_byte_mask
+(
+    unsigned int first,  /* I: first bit of the byte covered (0 is the most
+                               significant bit) */
+    unsigned int count   /* I: number of bits covered */
+)
+{
+    return ((unsigned char)((0xffu >> first) & (0xffu << (8 - first - count))));
+}
+
+
+/******************************************************************************
+MODULE:  fill_bit_run (static)
+
+PURPOSE:  Fills a run of consecutive bits in a packed bit buffer with ones or
+zeros, using masked stores on the partial bytes at the ends of the run and
+64-bit word stores for the interior.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static void fill_bit_run
+(
+    unsigned char *bits, /* I/O: packed bit buffer */
+    size_t first_bit,    /* I: first bit of the run to be filled */
+    size_t num_bits,     /* I: number of bits in the run */
+    bool set             /* I: set the bits (true) or clear them (false) */
+)
+{
+    unsigned char *byte = NULL;  /* current byte of the run */
+    unsigned char mask;          /* mask for a partial byte */
+    unsigned char fill;          /* fill value for the whole bytes */
+    unsigned int offset;         /* bit offset of the run in its first byte */
+    unsigned int head_bits;      /* bits filled in the partial first byte */
+    uint64_t word;               /* fill value for the whole words */
+    size_t nbytes;               /* number of whole bytes in the run */
+
+    if (num_bits == 0)
+        return;
+
+    /* Fill the partial byte at the start of the run with one masked store.
+       If the run also ends inside this byte then this is the whole run. */
+    byte = bits + first_bit / 8;
+    offset = first_bit % 8;
+    if (offset != 0)
+    {
+        head_bits = 8 - offset;
+        if (head_bits > num_bits)
+            head_bits = num_bits;
+        mask = partial_byte_mask (offset, head_bits);
+        if (set)
+            *byte |= mask;
+        else
+            *byte &= ~mask;
+        byte++;
+        num_bits -= head_bits;
+    }
+
+    /* Fill the whole bytes in the interior of the run, eight at a time as
+       64-bit words and then singly for the remainder */
+    fill = set ? 0xff : 0x00;
+    word = set ? ~(uint64_t)0 : 0;
+    nbytes = num_bits / 8;
+    num_bits %= 8;
+    while (nbytes >= sizeof (word))
+    {
+        memcpy (byte, &word, sizeof (word));
+        byte += sizeof (word);
+        nbytes -= sizeof (word);
+    }
+    while (nbytes > 0)
+    {
+        *byte++ = fill;
+        nbytes--;
+    }
+
+    /* Fill the partial byte at the end of the run with one masked store */
+    if (num_bits > 0)
+    {
+        mask = partial_byte_mask (0, num_bits);
+        if (set)
+            *byte |= mask;
+        else
+            *byte &= ~mask;
+    }
+}
+
+
+/******************************************************************************
+MODULE:  espa_bitset_set_run
+
+PURPOSE:  Sets a run of consecutive bits in a packed bit buffer.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void espa_bitset_set_run
+(
+    unsigned char *bits, /* I/O: packed bit buffer */
+    size_t first_bit,    /* I: first bit of the run to be set */
+    size_t num_bits      /* I: number of bits in the run */
+)
+{
+    fill_bit_run (bits, first_bit, num_bits, true);
+}
+
+
+/******************************************************************************
+MODULE:  espa_bitset_clear_run
+
+PURPOSE:  Clears a run of consecutive bits in a packed bit buffer.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void espa_bitset_clear_run
+(
+    unsigned char *bits, /* I/O: packed bit buffer */
+    size_t first_bit,    /* I: first bit of the run to be cleared */
+    size_t num_bits      /* I: number of bits in the run */
+)
+{
+    fill_bit_run (bits, first_bit, num_bits, false);
+}
@@ -0,0 +1,42 @@
+/*****************************************************************************
+FILE: espa_bitset.h
+
+PURPOSE: Contains prototypes for the packed bitset run fill primitives.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Bits are packed most significant bit first within each byte, matching
+     the packed bit masks written by the land/water mask library (bit n of
+     the buffer is bit (7 - n % 8) of byte n / 8).
+*****************************************************************************/
+
+#ifndef ESPA_BITSET_H
+#define ESPA_BITSET_H
+
+#include <stdlib.h>
+
+/* Prototypes */
+void espa_bitset_set_run
+(
+    unsigned char *bits, /* I/O: packed bit buffer */
+    size_t first_bit,    /* I: first bit of the run to be set */
+    size_t num_bits      /* I: number of bits in the run */
+);
+
+void espa_bitset_clear_run
+(
+    unsigned char *bits, /* I/O: packed bit buffer */
+    size_t first_bit,    /* I: first bit of the run to be cleared */
+    size_t num_bits      /* I: number of bits in the run */
+);
+
+#endif
@@ -0,0 +1,874 @@
+/*****************************************************************************
+FILE: espa_buffer.c
+
+PURPOSE: Contains the large-buffer allocator used by the parallel conversion
+and angle-generation paths.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Back large buffers with transparent huge pages
+8/31/2026    Gail Schmidt     Throttle large buffers against a process
+                              memory budget so concurrent conversions
+                              cannot overcommit the node
+8/31/2026    Gail Schmidt     Pool band buffers for reuse across the band
+                              loops so a scene's conversion stops cycling
+                              hundreds of MB through the allocator
+
+NOTES:
+  1. The first touch is done by zeroing page-aligned slices of the buffer
+     from the worker pool, so the returned memory is zeroed like calloc.
+  2. When the pool is unavailable (single thread configured, or the caller
+     is already running inside a pool task) the buffer is zeroed in place
+     by the calling thread, which on NUMA machines leaves the pages local
+     to that thread -- the right placement for a per-worker buffer.
+*****************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include "espa_thread_pool.h"
+#include "espa_buffer.h"
+
+/* Maximum number of buffers holding a reservation against the memory
+   budget at once */
+#define ESPA_BUFFER_RESERVE_MAX 64
+
+/* One buffer's reservation against the memory budget */
+typedef struct
+{
+    void *buffer;        /* reserved buffer; NULL when the slot is free */
+    size_t nbytes;       /* number of bytes reserved for the buffer */
+} Espa_buffer_reserve_t;
+
+static Espa_buffer_reserve_t reserve_table[ESPA_BUFFER_RESERVE_MAX];
+static size_t reserved_bytes = 0;    /* bytes currently reserved */
+static pthread_mutex_t reserve_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t reserve_released = PTHREAD_COND_INITIALIZER;
+
+/******************************************************************************
+MODULE:  read_memory_limit (static)
+
+PURPOSE:  Reads a memory limit in bytes from a cgroup limit file.
+
+RETURN VALUE:
+Type = long long
+Value           Description
+-----           -----------
+-1              No usable limit in the file (missing, "max", or absurdly
+                large, which cgroup v1 uses for "no limit")
+(bytes)         Limit in bytes
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static long long read_memory_limit
+(
+    const char *path     /* I: cgroup limit file to be read */
+)
+{
+    FILE *fp = NULL;     /* limit file being read */
+    long long limit = -1;    /* limit read from the file */
+
+    fp = fopen (path, "r");
+    if (fp == NULL)
+        return (-1);
+    if (fscanf (fp, "%lld", &limit) != 1)
+        limit = -1;
+    fclose (fp);
+
+    /* cgroup v1 reports "no limit" as a number near LLONG_MAX */
+    if (limit <= 0 || limit >= (1LL << 60))
+        return (-1);
+
+    return (limit);
+}
+
+
+/******************************************************************************
+MODULE:  espa_memory_budget (static)
+
+PURPOSE:  Determines the byte budget large buffers reserve against: the
+ESPA_MEMORY_BUDGET environment variable when set, otherwise half the cgroup
+memory limit of the process (or half the physical memory when the process
+is not limited).
+
+RETURN VALUE:
+Type = size_t
+Value           Description
+-----           -----------
+0               Admission control is disabled
+(bytes)         Budget in bytes
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Half the limit leaves room for the stdio buffers, the libraries, and
+     the page cache pressure of the streams the buffers are fed from.
+******************************************************************************/
+static size_t espa_memory_budget (void)
+{
+    static long long budget = -1; /* cached budget; -1 until first call */
+    char *value = NULL;           /* value of the environment variable */
+    long long limit;              /* memory limit of the process */
+    long page_size;               /* system page size in bytes */
+    long phys_pages;              /* number of physical memory pages */
+
+    if (budget == -1)
+    {
+        value = getenv ("ESPA_MEMORY_BUDGET");
+        if (value != NULL && value[0] != '\0')
+            budget = atoll (value);   /* 0 disables the throttle */
+        else
+        {
+            limit = read_memory_limit ("/sys/fs/cgroup/memory.max");
+            if (limit < 0)
+                limit = read_memory_limit
+                    ("/sys/fs/cgroup/memory/memory.limit_in_bytes");
+            if (limit < 0)
+            {
+                page_size = sysconf (_SC_PAGESIZE);
+                phys_pages = sysconf (_SC_PHYS_PAGES);
+                if (page_size > 0 && phys_pages > 0)
+                    limit = (long long) page_size * phys_pages;
+            }
+            budget = (limit > 0) ? limit / 2 : 0;
+        }
+        if (budget < 0)
+            budget = 0;
+    }
+
+    return ((size_t) budget);
+}
+
+
+/******************************************************************************
+MODULE:  espa_memory_budget_bytes
+
+PURPOSE:  Returns the process memory budget so other facilities (e.g. the
+band prefetch planner) can bound themselves against the same limit the
+large buffers reserve against.
+
+RETURN VALUE:
+Type = size_t
+Value           Description
+-----           -----------
+0               No budget is configured
+(bytes)         Budget in bytes
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+size_t espa_memory_budget_bytes (void)
+{
+    return (espa_memory_budget ());
+}
+
+
+/******************************************************************************
+MODULE:  reserve_buffer_bytes (static)
+
+PURPOSE:  Reserves a large buffer's bytes against the memory budget,
+blocking until enough of the budget has been released by other buffers.
+
+RETURN VALUE:
+Type = bool
+Value           Description
+-----           -----------
+true            Bytes were reserved; they must be released when the buffer
+                is freed
+false           Admission control is disabled; nothing was reserved
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. A buffer larger than the whole budget is admitted as soon as nothing
+     else holds a reservation, so a single oversized band cannot deadlock
+     the process -- the throttle then just serializes it against the other
+     large buffers.
+******************************************************************************/
+static bool reserve_buffer_bytes
+(
+    size_t nbytes        /* I: number of bytes to reserve */
+)
+{
+    size_t budget = espa_memory_budget ();   /* process byte budget */
+
+    if (budget == 0)
+        return (false);
+
+    pthread_mutex_lock (&reserve_lock);
+    while (reserved_bytes != 0 && reserved_bytes + nbytes > budget)
+        pthread_cond_wait (&reserve_released, &reserve_lock);
+    reserved_bytes += nbytes;
+    pthread_mutex_unlock (&reserve_lock);
+
+    return (true);
+}
+
+
+/******************************************************************************
+MODULE:  release_buffer_bytes (static)
+
+PURPOSE:  Releases a reservation against the memory budget and wakes the
+allocations blocked on it.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static void release_buffer_bytes
+(
+    size_t nbytes        /* I: number of bytes to release */
+)
+{
+    pthread_mutex_lock (&reserve_lock);
+    reserved_bytes -= nbytes;
+    pthread_cond_broadcast (&reserve_released);
+    pthread_mutex_unlock (&reserve_lock);
+}
+
+
+/* Context for the parallel first-touch tasks */
+typedef struct
+{
+    unsigned char *buffer;   /* buffer having its pages touched */
+    size_t nbytes;           /* total size of the buffer in bytes */
+    size_t slice_bytes;      /* page-aligned bytes touched per task */
+    bool fill16;             /* fill with the 16-bit pattern, not zeros */
+    short fill_value;        /* 16-bit fill value when fill16 is set */
+} Espa_touch_pool_t;
+
+
+/******************************************************************************
+MODULE:  espa_fill_buffer16
+
+PURPOSE:  Fills an array of 16-bit elements with a fill value, broadcasting
+the value into 64-bit stores so the fill runs at memory bandwidth instead
+of one element per store.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. When both bytes of the value are equal (0, -1, 0x0101-style patterns)
+     the fill degrades to a plain memset.
+  2. The buffer must be 2-byte aligned, which every allocator in the
+     library guarantees.
+******************************************************************************/
+void espa_fill_buffer16
+(
+    void *buffer,        /* I/O: buffer of 16-bit elements to be filled */
+    size_t count,        /* I: number of 16-bit elements to fill */
+    short fill_value     /* I: fill value to store in each element */
+)
+{
+    unsigned short value = (unsigned short) fill_value;  /* raw pattern */
+    unsigned short *sp = buffer;         /* element fill position */
+    unsigned long long *wp = NULL;       /* 64-bit fill position */
+    unsigned long long pattern;          /* value broadcast to 64 bits */
+
+    /* A value with equal bytes is just a byte pattern */
+    if ((value >> 8) == (value & 0xff))
+    {
+        memset (buffer, value & 0xff, count * sizeof (unsigned short));
+        return;
+    }
+
+    /* Fill element-wise up to the first 8-byte boundary */
+    while (count > 0 && ((uintptr_t) sp & 7) != 0)
+    {
+        *sp++ = value;
+        count--;
+    }
+
+    /* Fill four elements per 64-bit store; the compiler widens this loop
+       further with vector stores where available */
+    pattern = value * 0x0001000100010001ULL;
+    wp = (unsigned long long *) sp;
+    for (; count >= 4; count -= 4)
+        *wp++ = pattern;
+
+    /* Fill the remaining tail element-wise */
+    sp = (unsigned short *) wp;
+    while (count > 0)
+    {
+        *sp++ = value;
+        count--;
+    }
+}
+
+
+/******************************************************************************
+MODULE:  espa_buffer_touch_task (static)
+
+PURPOSE:  Fills one page-aligned slice of the buffer -- with zeros or with
+the 16-bit fill pattern -- so its pages are placed on the memory node of
+the worker running the task.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+SUCCESS         Slice was filled
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Optionally fill the slice with a 16-bit
+                              pattern instead of zeros
+
+NOTES:
+******************************************************************************/
+static int espa_buffer_touch_task
+(
+    void *ctx,           /* I: Espa_touch_pool_t context */
+    int item             /* I: index of the slice to touch */
+)
+{
+    Espa_touch_pool_t *pool = ctx;   /* context for this buffer */
+    size_t start;                    /* first byte of this slice */
+    size_t count;                    /* number of bytes in this slice */
+
+    start = (size_t) item * pool->slice_bytes;
+    count = pool->slice_bytes;
+    if (start + count > pool->nbytes)
+        count = pool->nbytes - start;
+    if (pool->fill16)
+        espa_fill_buffer16 (pool->buffer + start, count / 2,
+            pool->fill_value);
+    else
+        memset (pool->buffer + start, 0, count);
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  alloc_buffer_internal (static)
+
+PURPOSE:  Allocates a page-aligned buffer filled with zeros or with a
+16-bit pattern, spreading the first touch of large buffers across the
+worker pool so the pages are interleaved over the NUMA nodes the workers
+run on.
+
+RETURN VALUE:
+Type = void *
+Value           Description
+-----           -----------
+NULL            Error allocating the buffer
+non-NULL        Pointer to the zeroed buffer
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Reserve large buffers against the process
+                              memory budget before allocating
+8/31/2026    Gail Schmidt     Optionally make the first touch a 16-bit
+                              pattern fill instead of zeroing
+
+NOTES:
+  1. The caller is expected to report the allocation error, matching how
+     calloc failures are handled throughout the library.
+******************************************************************************/
+static void *alloc_buffer_internal
+(
+    size_t nbytes,       /* I: number of bytes to allocate */
+    bool fill16,         /* I: fill with the 16-bit pattern, not zeros */
+    short fill_value     /* I: 16-bit fill value when fill16 is set */
+)
+{
+    Espa_touch_pool_t pool;       /* context for the first-touch tasks */
+    void *buffer = NULL;          /* allocated buffer */
+    long page_size;               /* system page size in bytes */
+    int num_threads;              /* number of threads available */
+    int nslices;                  /* number of first-touch slices */
+    int i;                        /* looping variable */
+    bool reserved = false;        /* is the buffer reserved against the
+                                     memory budget */
+
+    if (nbytes == 0)
+        return (NULL);
+
+    /* Reserve large buffers against the process memory budget before
+       allocating, so concurrent large-band conversions queue up instead of
+       overcommitting the node */
+    if (nbytes >= (size_t) ESPA_BUFFER_ADMISSION_BYTES)
+        reserved = reserve_buffer_bytes (nbytes);
+
+    /* Allocate the buffer on a page boundary so the first-touch slices
+       line up with whole pages.  Large buffers are instead aligned to the
+       huge page size and advised to be backed by transparent huge pages,
+       so the conversion loops that stream over them take far fewer TLB
+       misses; the advice is per-allocation and does not require the
+       system-wide THP setting to be "always" */
+    page_size = sysconf (_SC_PAGESIZE);
+    if (page_size <= 0)
+        page_size = 4096;
+    if (nbytes >= ESPA_BUFFER_HUGE_PAGE_BYTES &&
+        page_size < ESPA_BUFFER_HUGE_PAGE_SIZE)
+    {
+        if (posix_memalign (&buffer, ESPA_BUFFER_HUGE_PAGE_SIZE, nbytes) != 0)
+        {
+            if (reserved)
+                release_buffer_bytes (nbytes);
+            return (NULL);
+        }
+#ifdef MADV_HUGEPAGE
+        /* Advisory only; allocation proceeds with 4K pages if it fails */
+        madvise (buffer, nbytes, MADV_HUGEPAGE);
+#endif
+    }
+    else if (posix_memalign (&buffer, (size_t) page_size, nbytes) != 0)
+    {
+        if (reserved)
+            release_buffer_bytes (nbytes);
+        return (NULL);
+    }
+
+    /* Record the reservation so the free releases it.  If every slot is
+       taken the reservation is released right away, which leaves the
+       buffer unthrottled rather than leaking budget */
+    if (reserved)
+    {
+        pthread_mutex_lock (&reserve_lock);
+        for (i = 0; i < ESPA_BUFFER_RESERVE_MAX; i++)
+        {
+            if (reserve_table[i].buffer == NULL)
+            {
+                reserve_table[i].buffer = buffer;
+                reserve_table[i].nbytes = nbytes;
+                break;
+            }
+        }
+        pthread_mutex_unlock (&reserve_lock);
+        if (i == ESPA_BUFFER_RESERVE_MAX)
+            release_buffer_bytes (nbytes);
+    }
+
+    /* Small buffers and single-threaded configurations are just zeroed by
+       the caller; the pool also falls back to this path when the caller is
+       already a pool worker, which leaves the pages local to that worker */
+    num_threads = espa_pool_max_threads ();
+    if (nbytes < ESPA_BUFFER_PARALLEL_TOUCH_BYTES || num_threads <= 1)
+    {
+        if (fill16)
+            espa_fill_buffer16 (buffer, nbytes / 2, fill_value);
+        else
+            memset (buffer, 0, nbytes);
+        return (buffer);
+    }
+
+    /* Split the buffer into page-aligned slices, several per thread so the
+       interleaving is finer than one run of pages per node */
+    pool.buffer = buffer;
+    pool.nbytes = nbytes;
+    pool.fill16 = fill16;
+    pool.fill_value = fill_value;
+    nslices = num_threads * 4;
+    pool.slice_bytes = (nbytes / nslices + (size_t) page_size - 1)
+        / (size_t) page_size * (size_t) page_size;
+    nslices = (int) ((nbytes + pool.slice_bytes - 1) / pool.slice_bytes);
+
+    /* The touch tasks cannot fail, so the run status is ignored; a serial
+       fallback inside the pool still zeroes every slice */
+    espa_pool_run (espa_buffer_touch_task, &pool, nslices, num_threads);
+
+    return (buffer);
+}
+
+
+/******************************************************************************
+MODULE:  espa_alloc_buffer
+
+PURPOSE:  Allocates a zeroed, page-aligned buffer.
+
+RETURN VALUE:
+Type = void *
+Value           Description
+-----           -----------
+NULL            Error allocating the buffer
+non-NULL        Pointer to the zeroed buffer
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void *espa_alloc_buffer
+(
+    size_t nbytes        /* I: number of bytes to allocate */
+)
+{
+    return (alloc_buffer_internal (nbytes, false, 0));
+}
+
+
+/******************************************************************************
+MODULE:  espa_alloc_buffer_fill16
+
+PURPOSE:  Allocates a page-aligned buffer of 16-bit elements initialized to
+a fill value.  The pattern fill doubles as the first touch of the pages, so
+fill-initializing an array costs one pass instead of a zeroing pass
+followed by an element-wise overwrite.
+
+RETURN VALUE:
+Type = void *
+Value           Description
+-----           -----------
+NULL            Error allocating the buffer
+non-NULL        Pointer to the filled buffer
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The memory is compatible with free(), like espa_alloc_buffer.
+******************************************************************************/
+void *espa_alloc_buffer_fill16
+(
+    size_t count,        /* I: number of 16-bit elements to allocate */
+    short fill_value     /* I: fill value to store in each element */
+)
+{
+    return (alloc_buffer_internal (count * sizeof (short), true,
+        fill_value));
+}
+
+
+/******************************************************************************
+MODULE:  espa_free_buffer
+
+PURPOSE:  Frees a buffer returned by espa_alloc_buffer.
+
+RETURN VALUE: N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Release the buffer's reservation against the
+                              memory budget
+
+NOTES:
+******************************************************************************/
+void espa_free_buffer
+(
+    void *buffer         /* I: buffer returned by espa_alloc_buffer */
+)
+{
+    size_t nbytes = 0;   /* reservation held by the buffer, if any */
+    int i;               /* looping variable */
+
+    if (buffer == NULL)
+        return;
+
+    /* Release the buffer's reservation against the memory budget */
+    pthread_mutex_lock (&reserve_lock);
+    for (i = 0; i < ESPA_BUFFER_RESERVE_MAX; i++)
+    {
+        if (reserve_table[i].buffer == buffer)
+        {
+            nbytes = reserve_table[i].nbytes;
+            reserve_table[i].buffer = NULL;
+            break;
+        }
+    }
+    pthread_mutex_unlock (&reserve_lock);
+    if (nbytes != 0)
+        release_buffer_bytes (nbytes);
+
+    free (buffer);
+}
+
+
+/* Maximum number of buffers tracked by the reuse pool; an untracked
+   borrow simply behaves like a plain allocation */
+#define ESPA_BUFFER_POOL_MAX 32
+
+/* Smallest bucket the pool hands out; smaller requests are rounded up */
+#define ESPA_BUFFER_POOL_MIN_BYTES (64L * 1024L)
+
+/* One buffer tracked by the reuse pool */
+typedef struct
+{
+    void *buffer;        /* pooled buffer; NULL when the slot is free */
+    size_t nbytes;       /* bucket size of the buffer in bytes */
+    bool idle;           /* is the buffer waiting to be borrowed again */
+} Espa_buffer_pool_t;
+
+static Espa_buffer_pool_t pool_table[ESPA_BUFFER_POOL_MAX];
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/******************************************************************************
+MODULE:  buffer_pool_enabled (static)
+
+PURPOSE:  Checks whether the buffer reuse pool is enabled.  The pool is on
+by default and turned off by setting ESPA_BUFFER_POOL=0 in the environment.
+
+RETURN VALUE:
+Type = bool
+Value           Description
+-----           -----------
+true            Borrowed buffers are pooled for reuse (the default)
+false           Every borrow is a plain allocation
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static bool buffer_pool_enabled (void)
+{
+    static int enabled = -1;      /* cached setting; -1 until first call */
+    char *value = NULL;           /* value of the environment variable */
+
+    if (enabled == -1)
+    {
+        value = getenv ("ESPA_BUFFER_POOL");
+        enabled = (value == NULL || value[0] == '\0' ||
+            strcmp (value, "0") != 0);
+    }
+
+    return enabled;
+}
+
+
+/******************************************************************************
+MODULE:  buffer_pool_bucket (static)
+
+PURPOSE:  Rounds a request up to its pool bucket size (the next power of
+two), so bands of slightly different sizes still reuse the same buffers.
+
+RETURN VALUE:
+Type = size_t
+Value           Description
+-----           -----------
+(bytes)         Bucket size for the request
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static size_t buffer_pool_bucket
+(
+    size_t nbytes        /* I: number of bytes requested */
+)
+{
+    size_t bucket = ESPA_BUFFER_POOL_MIN_BYTES;  /* bucket for the request */
+
+    while (bucket < nbytes)
+        bucket *= 2;
+
+    return (bucket);
+}
+
+
+/******************************************************************************
+MODULE:  espa_borrow_buffer
+
+PURPOSE:  Borrows a buffer of at least nbytes from the reuse pool,
+allocating a new pooled buffer on a miss.  Reused buffers keep their pages
+faulted in, so the per-band cost of the conversion loops no longer includes
+a first-touch fault storm.
+
+RETURN VALUE:
+Type = void *
+Value           Description
+-----           -----------
+NULL            Error allocating the buffer
+non-NULL        Pointer to the buffer; its contents are indeterminate and
+                the caller must fully write the portion it uses
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Unlike espa_alloc_buffer the returned memory is not guaranteed to be
+     zeroed -- a reused buffer still holds the previous band's data.
+  2. An idle pooled buffer keeps its reservation against the memory
+     budget, so processes which interleave conversions with other large
+     allocations should drain the pool between scenes.
+******************************************************************************/
+void *espa_borrow_buffer
+(
+    size_t nbytes        /* I: number of bytes needed in the buffer */
+)
+{
+    void *buffer = NULL;     /* borrowed or newly allocated buffer */
+    size_t bucket;           /* bucket size for the request */
+    int i;                   /* looping variable */
+
+    if (nbytes == 0)
+        return (NULL);
+    if (!buffer_pool_enabled ())
+        return (espa_alloc_buffer (nbytes));
+
+    /* Reuse an idle pooled buffer of the same bucket if one is waiting */
+    bucket = buffer_pool_bucket (nbytes);
+    pthread_mutex_lock (&pool_lock);
+    for (i = 0; i < ESPA_BUFFER_POOL_MAX; i++)
+    {
+        if (pool_table[i].idle && pool_table[i].nbytes == bucket)
+        {
+            pool_table[i].idle = false;
+            buffer = pool_table[i].buffer;
+            break;
+        }
+    }
+    pthread_mutex_unlock (&pool_lock);
+    if (buffer != NULL)
+        return (buffer);
+
+    /* Allocate the whole bucket so the buffer can serve any later request
+       in the same bucket */
+    buffer = espa_alloc_buffer (bucket);
+    if (buffer == NULL)
+        return (NULL);
+
+    /* Track the buffer so its return parks it in the pool.  If every slot
+       is taken the buffer is simply handed out untracked, and its return
+       falls through to a plain free */
+    pthread_mutex_lock (&pool_lock);
+    for (i = 0; i < ESPA_BUFFER_POOL_MAX; i++)
+    {
+        if (pool_table[i].buffer == NULL)
+        {
+            pool_table[i].buffer = buffer;
+            pool_table[i].nbytes = bucket;
+            pool_table[i].idle = false;
+            break;
+        }
+    }
+    pthread_mutex_unlock (&pool_lock);
+
+    return (buffer);
+}
+
+
+/******************************************************************************
+MODULE:  espa_return_buffer
+
+PURPOSE:  Returns a borrowed buffer to the reuse pool; untracked buffers
+are freed.
+
+RETURN VALUE: N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void espa_return_buffer
+(
+    void *buffer         /* I: buffer returned by espa_borrow_buffer */
+)
+{
+    int i;               /* looping variable */
+
+    if (buffer == NULL)
+        return;
+
+    pthread_mutex_lock (&pool_lock);
+    for (i = 0; i < ESPA_BUFFER_POOL_MAX; i++)
+    {
+        if (pool_table[i].buffer == buffer)
+        {
+            pool_table[i].idle = true;
+            pthread_mutex_unlock (&pool_lock);
+            return;
+        }
+    }
+    pthread_mutex_unlock (&pool_lock);
+
+    espa_free_buffer (buffer);
+}
+
+
+/******************************************************************************
+MODULE:  espa_drain_buffer_pool
+
+PURPOSE:  Frees every idle buffer in the reuse pool, releasing their memory
+and their reservations against the memory budget.  Called between scenes by
+the long-running drivers; buffers still borrowed are left alone.
+
+RETURN VALUE: N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void espa_drain_buffer_pool (void)
+{
+    void *idle_bufs[ESPA_BUFFER_POOL_MAX];   /* idle buffers to be freed */
+    int nidle = 0;       /* number of idle buffers collected */
+    int i;               /* looping variable */
+
+    /* Collect the idle buffers under the lock, then free them outside it */
+    pthread_mutex_lock (&pool_lock);
+    for (i = 0; i < ESPA_BUFFER_POOL_MAX; i++)
+    {
+        if (pool_table[i].idle)
+        {
+            idle_bufs[nidle++] = pool_table[i].buffer;
+            pool_table[i].buffer = NULL;
+            pool_table[i].idle = false;
+        }
+    }
+    pthread_mutex_unlock (&pool_lock);
+
+    for (i = 0; i < nidle; i++)
+        espa_free_buffer (idle_bufs[i]);
+}
@@ -0,0 +1,105 @@
+/*****************************************************************************
+FILE: espa_buffer.h
+
+PURPOSE: Contains prototypes for the large-buffer allocator used by the
+parallel conversion and angle-generation paths.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Back large buffers with transparent huge pages
+8/31/2026    Gail Schmidt     Throttle large buffers against a process
+                              memory budget
+8/31/2026    Gail Schmidt     Pool band buffers for reuse across the band
+                              loops
+8/31/2026    Gail Schmidt     Added the 16-bit pattern fill primitive and
+                              the allocate-and-fill variant
+8/31/2026    Gail Schmidt     Exposed the memory budget for other
+                              facilities to bound against
+
+NOTES:
+  1. On NUMA machines a page is placed on the memory node of the thread
+     that first touches it.  Buffers zeroed serially before being handed
+     to the worker pool therefore all land on one node, and the workers on
+     the other node pay cross-node latency on every access.  This
+     allocator spreads the first touch of large buffers across the worker
+     pool so the pages are interleaved over the nodes the workers run on.
+  2. The memory returned is compatible with free(), so buffers that are
+     released in a different library can still use a plain free.
+  3. The band loops borrow and return their chunk buffers through a
+     size-bucketed pool instead of allocating and freeing per band, so the
+     pages stay faulted in and the process RSS is stable across a scene
+     instead of cycling by hundreds of MB.  Borrowed buffers have
+     indeterminate contents -- the callers fully overwrite the portion they
+     use.  Setting ESPA_BUFFER_POOL=0 in the environment disables the pool
+     and every borrow becomes a plain allocation.
+*****************************************************************************/
+
+#ifndef ESPA_BUFFER_H
+#define ESPA_BUFFER_H
+
+#include <stdlib.h>
+#include "error_handler.h"
+
+/* Buffers at least this large have their pages first-touched in parallel
+   by the worker pool; smaller buffers are simply zeroed by the caller */
+#define ESPA_BUFFER_PARALLEL_TOUCH_BYTES (4L * 1024L * 1024L)
+
+/* Buffers at least this large are aligned to the transparent huge page
+   size and advised to be backed by huge pages, cutting TLB misses in the
+   conversion loops that stream over multi-hundred-MB band buffers */
+#define ESPA_BUFFER_HUGE_PAGE_BYTES (8L * 1024L * 1024L)
+#define ESPA_BUFFER_HUGE_PAGE_SIZE (2L * 1024L * 1024L)
+
+/* Buffers at least this large reserve against the process memory budget
+   before being allocated, blocking until enough of the budget is free.
+   The budget defaults to half the cgroup (or physical) memory limit and
+   can be overridden in bytes with the ESPA_MEMORY_BUDGET environment
+   variable (0 disables the throttle). */
+#define ESPA_BUFFER_ADMISSION_BYTES (64L * 1024L * 1024L)
+
+/* Prototypes */
+void *espa_alloc_buffer
+(
+    size_t nbytes        /* I: number of bytes to allocate */
+);
+
+void *espa_alloc_buffer_fill16
+(
+    size_t count,        /* I: number of 16-bit elements to allocate */
+    short fill_value     /* I: fill value to store in each element */
+);
+
+void espa_fill_buffer16
+(
+    void *buffer,        /* I/O: buffer of 16-bit elements to be filled */
+    size_t count,        /* I: number of 16-bit elements to fill */
+    short fill_value     /* I: fill value to store in each element */
+);
+
+void espa_free_buffer
+(
+    void *buffer         /* I: buffer returned by espa_alloc_buffer */
+);
+
+void *espa_borrow_buffer
+(
+    size_t nbytes        /* I: number of bytes needed in the buffer */
+);
+
+void espa_return_buffer
+(
+    void *buffer         /* I: buffer returned by espa_borrow_buffer */
+);
+
+void espa_drain_buffer_pool (void);
+
+size_t espa_memory_budget_bytes (void);
+
+#endif
@@ -0,0 +1,125 @@
+/*****************************************************************************
+FILE: espa_byteswap.c
+
+PURPOSE: Contains the machine byte order check and the byte-swap kernels
+applied when a band was written on a machine of the other byte order.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The swap loops are written over restrict pointers with the compiler
+     byte-swap builtins so they vectorize (byte-shuffle instructions) under
+     the optimized compile of this file (see the Makefile).
+*****************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "error_handler.h"
+#include "espa_byteswap.h"
+
+/******************************************************************************
+MODULE:  espa_machine_byte_order
+
+PURPOSE:  Determines the byte order of the machine the library is running on.
+
+RETURN VALUE:
+Type = int
+Value                Description
+-----                -----------
+ESPA_BYTE_ORDER_LSB  Least significant byte first (Intel)
+ESPA_BYTE_ORDER_MSB  Most significant byte first (network/IEEE)
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+int espa_machine_byte_order (void)
+{
+    const uint16_t probe = 1;          /* value whose first byte is checked */
+    unsigned char first_byte;          /* first byte of the probe value */
+
+    memcpy (&first_byte, &probe, 1);
+    if (first_byte == 1)
+        return (ESPA_BYTE_ORDER_LSB);
+    else
+        return (ESPA_BYTE_ORDER_MSB);
+}
+
+
+/******************************************************************************
+MODULE:  espa_swap_bytes
+
+PURPOSE:  Swaps the byte order of every value in a buffer in place.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Unsupported value size
+SUCCESS         Buffer was swapped
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Single byte values need no swapping and are left untouched.
+******************************************************************************/
+int espa_swap_bytes
+(
+    void *buf,           /* I/O: buffer of values to be swapped in place */
+    long nvalues,        /* I: number of values in the buffer */
+    int size             /* I: number of bytes per value */
+)
+{
+    char FUNC_NAME[] = "espa_swap_bytes";   /* function name */
+    char errmsg[STR_SIZE];        /* error message */
+    uint16_t * restrict bp16;     /* buffer as two byte values */
+    uint32_t * restrict bp32;     /* buffer as four byte values */
+    uint64_t * restrict bp64;     /* buffer as eight byte values */
+    long i;                       /* value loop counter */
+
+    switch (size)
+    {
+        case 1:    /* nothing to swap */
+            break;
+
+        case 2:
+            bp16 = (uint16_t *) buf;
+            for (i = 0; i < nvalues; i++)
+                bp16[i] = __builtin_bswap16 (bp16[i]);
+            break;
+
+        case 4:
+            bp32 = (uint32_t *) buf;
+            for (i = 0; i < nvalues; i++)
+                bp32[i] = __builtin_bswap32 (bp32[i]);
+            break;
+
+        case 8:
+            bp64 = (uint64_t *) buf;
+            for (i = 0; i < nvalues; i++)
+                bp64[i] = __builtin_bswap64 (bp64[i]);
+            break;
+
+        default:
+            sprintf (errmsg, "Unsupported value size of %d bytes.", size);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+    }
+
+    return (SUCCESS);
+}
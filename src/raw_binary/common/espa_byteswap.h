@@ -0,0 +1,42 @@
+/*****************************************************************************
+FILE: espa_byteswap.h
+
+PURPOSE: Contains prototypes for determining the machine byte order and for
+the byte-swap kernels applied when a band was written on a machine of the
+other byte order.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Byte orders follow the ENVI convention: 0 is least significant byte
+     first (Intel), 1 is most significant byte first (network/IEEE).
+*****************************************************************************/
+
+#ifndef ESPA_BYTESWAP_H
+#define ESPA_BYTESWAP_H
+
+#include <stdlib.h>
+
+/* ENVI byte order values */
+#define ESPA_BYTE_ORDER_LSB 0      /* least significant byte first (Intel) */
+#define ESPA_BYTE_ORDER_MSB 1      /* most significant byte first (IEEE) */
+
+/* Prototypes */
+int espa_machine_byte_order (void);
+
+int espa_swap_bytes
+(
+    void *buf,           /* I/O: buffer of values to be swapped in place */
+    long nvalues,        /* I: number of values in the buffer */
+    int size             /* I: number of bytes per value */
+);
+
+#endif
@@ -0,0 +1,112 @@
+/*****************************************************************************
+FILE: espa_cancel.c
+
+PURPOSE: Contains functions for cooperative cancellation of long-running
+conversions.  A SIGTERM or SIGINT only raises a flag, which the conversion
+loops poll at their line-block boundaries so a preempted job unwinds
+through its normal error paths instead of being killed mid-write.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The signal handler only stores to a volatile sig_atomic_t flag, which
+     is the full set of operations that are async-signal-safe here.
+  2. With ESPA_ATOMIC_OUTPUT set, a canceled band never reaches its final
+     name (only its .partial file), so the bands committed before the
+     cancellation remain intact and the scene can be resumed from the
+     first missing band.
+*****************************************************************************/
+
+#include <signal.h>
+#include <string.h>
+#include "espa_cancel.h"
+
+/* Flag raised by the signal handler and polled by the conversion loops */
+static volatile sig_atomic_t cancel_flag = 0;
+
+
+/******************************************************************************
+MODULE: espa_cancel_handler (static)
+
+PURPOSE: Signal handler which records that a cancellation was requested.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static void espa_cancel_handler (int signum)
+{
+    (void) signum;
+    cancel_flag = 1;
+}
+
+
+/******************************************************************************
+MODULE: espa_cancel_install
+
+PURPOSE: Installs the cancellation handler for SIGTERM and SIGINT.  Tool
+mains call this once at startup before the conversion begins.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. SA_RESTART keeps interrupted reads and writes running to completion,
+     so the cancellation only takes effect at the polling points.
+******************************************************************************/
+void espa_cancel_install (void)
+{
+    struct sigaction action;     /* handler registration */
+
+    memset (&action, 0, sizeof (action));
+    action.sa_handler = espa_cancel_handler;
+    sigemptyset (&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction (SIGTERM, &action, NULL);
+    sigaction (SIGINT, &action, NULL);
+}
+
+
+/******************************************************************************
+MODULE: espa_cancel_requested
+
+PURPOSE: Checks whether a cancellation has been requested.
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+0            No cancellation was requested
+1            A cancellation was requested; the caller unwinds through its
+             normal error path
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+int espa_cancel_requested (void)
+{
+    return (cancel_flag != 0);
+}
@@ -0,0 +1,32 @@
+/*****************************************************************************
+FILE: espa_cancel.h
+
+PURPOSE: Contains defines and prototypes for cooperative cancellation of
+long-running conversions.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Tool mains call espa_cancel_install once at startup.  SIGTERM/SIGINT
+     then only raise a flag, which the long-running loops poll at their
+     line-block boundaries via espa_cancel_requested, unwinding through
+     their normal error paths instead of dying mid-write.
+*****************************************************************************/
+
+#ifndef ESPA_CANCEL_H
+#define ESPA_CANCEL_H
+
+/* Prototypes */
+void espa_cancel_install (void);
+
+int espa_cancel_requested (void);
+
+#endif
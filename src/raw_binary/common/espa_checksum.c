@@ -0,0 +1,255 @@
+/*****************************************************************************
+FILE: espa_checksum.c
+
+PURPOSE: Contains the streaming CRC32C checksum used to fingerprint band
+files as they are written, so a separate full read of every product just to
+checksum it is no longer needed.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. CRC32C (Castagnoli polynomial) is used since x86 processors provide a
+     dedicated instruction for it; on those processors the hardware path is
+     selected at runtime and the checksum costs a fraction of a memory copy.
+     Everywhere else a slicing-by-eight table implementation is used.
+  2. The checksum is streamable: feed the buffers in order, passing the
+     running value back in, starting from 0.
+*****************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "espa_checksum.h"
+
+/* reflected CRC32C (Castagnoli) polynomial */
+#define CRC32C_POLY 0x82f63b78
+
+/* slicing-by-eight lookup tables, built on first use */
+static uint32_t crc32c_table[8][256];
+static pthread_once_t crc32c_once = PTHREAD_ONCE_INIT;
+
+/******************************************************************************
+MODULE: crc32c_init_table (static)
+
+PURPOSE: Builds the slicing-by-eight lookup tables for the software path.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+static void crc32c_init_table (void)
+{
+    uint32_t crc;        /* table entry being built */
+    int i, j;            /* looping variables */
+
+    for (i = 0; i < 256; i++)
+    {
+        crc = i;
+        for (j = 0; j < 8; j++)
+            crc = (crc >> 1) ^ ((crc & 1) ? CRC32C_POLY : 0);
+        crc32c_table[0][i] = crc;
+    }
+
+    for (i = 0; i < 256; i++)
+    {
+        crc = crc32c_table[0][i];
+        for (j = 1; j < 8; j++)
+        {
+            crc = crc32c_table[0][crc & 0xff] ^ (crc >> 8);
+            crc32c_table[j][i] = crc;
+        }
+    }
+}
+
+
+/******************************************************************************
+MODULE: crc32c_sw (static)
+
+PURPOSE: Software CRC32C over a buffer using slicing-by-eight, processing
+eight bytes per table round.
+
+RETURN VALUE:
+Type = uint32_t
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+static uint32_t crc32c_sw
+(
+    uint32_t crc,        /* I: running checksum (pre-complemented) */
+    const unsigned char *buf,  /* I: buffer to be folded in */
+    size_t nbytes        /* I: number of bytes in the buffer */
+)
+{
+    uint64_t chunk;      /* eight input bytes folded per round */
+
+    /* Align to an eight byte boundary one byte at a time */
+    while (nbytes > 0 && ((uintptr_t) buf & 7) != 0)
+    {
+        crc = crc32c_table[0][(crc ^ *buf++) & 0xff] ^ (crc >> 8);
+        nbytes--;
+    }
+
+    /* Eight bytes per round through the sliced tables */
+    while (nbytes >= 8)
+    {
+        chunk = *(const uint64_t *) buf ^ crc;
+        crc = crc32c_table[7][chunk & 0xff] ^
+              crc32c_table[6][(chunk >> 8) & 0xff] ^
+              crc32c_table[5][(chunk >> 16) & 0xff] ^
+              crc32c_table[4][(chunk >> 24) & 0xff] ^
+              crc32c_table[3][(chunk >> 32) & 0xff] ^
+              crc32c_table[2][(chunk >> 40) & 0xff] ^
+              crc32c_table[1][(chunk >> 48) & 0xff] ^
+              crc32c_table[0][(chunk >> 56) & 0xff];
+        buf += 8;
+        nbytes -= 8;
+    }
+
+    /* Tail bytes */
+    while (nbytes > 0)
+    {
+        crc = crc32c_table[0][(crc ^ *buf++) & 0xff] ^ (crc >> 8);
+        nbytes--;
+    }
+
+    return crc;
+}
+
+
+#if defined(__x86_64__)
+/******************************************************************************
+MODULE: crc32c_hw (static)
+
+PURPOSE: Hardware CRC32C over a buffer using the SSE4.2 crc32 instruction,
+processing eight bytes per instruction.
+
+RETURN VALUE:
+Type = uint32_t
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Only called after __builtin_cpu_supports has confirmed the instruction
+     is available, so the library itself doesn't need to be compiled for
+     SSE4.2.
+*****************************************************************************/
+__attribute__((target("sse4.2")))
+static uint32_t crc32c_hw
+(
+    uint32_t crc,        /* I: running checksum (pre-complemented) */
+    const unsigned char *buf,  /* I: buffer to be folded in */
+    size_t nbytes        /* I: number of bytes in the buffer */
+)
+{
+    uint64_t crc64 = crc;  /* 64-bit accumulator for the wide instruction */
+
+    /* Align to an eight byte boundary one byte at a time */
+    while (nbytes > 0 && ((uintptr_t) buf & 7) != 0)
+    {
+        crc64 = __builtin_ia32_crc32qi ((uint32_t) crc64, *buf++);
+        nbytes--;
+    }
+
+    /* Eight bytes per instruction */
+    while (nbytes >= 8)
+    {
+        crc64 = __builtin_ia32_crc32di (crc64, *(const uint64_t *) buf);
+        buf += 8;
+        nbytes -= 8;
+    }
+
+    /* Tail bytes */
+    while (nbytes > 0)
+    {
+        crc64 = __builtin_ia32_crc32qi ((uint32_t) crc64, *buf++);
+        nbytes--;
+    }
+
+    return (uint32_t) crc64;
+}
+#endif
+
+
+/******************************************************************************
+MODULE: espa_crc32c
+
+PURPOSE: Folds a buffer into a streaming CRC32C checksum, using the hardware
+CRC instruction when the processor provides one.
+
+RETURN VALUE:
+Type = unsigned int (the updated running checksum)
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Pass 0 as the running checksum for the first buffer and the returned
+     value for each following buffer.
+*****************************************************************************/
+unsigned int espa_crc32c
+(
+    unsigned int crc,    /* I: running checksum; pass 0 for the first call */
+    const void *buf,     /* I: buffer to be folded into the checksum */
+    size_t nbytes        /* I: number of bytes in the buffer */
+)
+{
+    crc = ~crc;
+
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports ("sse4.2"))
+        return ~crc32c_hw (crc, buf, nbytes);
+#endif
+
+    pthread_once (&crc32c_once, crc32c_init_table);
+    return ~crc32c_sw (crc, buf, nbytes);
+}
+
+
+/******************************************************************************
+MODULE: espa_crc32c_string
+
+PURPOSE: Formats a checksum as the fixed-width lowercase hex string stored
+in the band metadata.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+void espa_crc32c_string
+(
+    unsigned int crc,    /* I: checksum to be formatted */
+    char *str            /* O: string of ESPA_CHECKSUM_STR_SIZE characters */
+)
+{
+    sprintf (str, "%08x", crc);
+}
@@ -0,0 +1,43 @@
+/*****************************************************************************
+FILE: espa_checksum.h
+
+PURPOSE: Contains prototypes for the streaming CRC32C checksum used to
+fingerprint band files as they are written.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+
+#ifndef ESPA_CHECKSUM_H
+#define ESPA_CHECKSUM_H
+
+#include <stdlib.h>
+
+/* number of characters in the formatted checksum string, including the
+   terminating null */
+#define ESPA_CHECKSUM_STR_SIZE 9
+
+/* Prototypes */
+unsigned int espa_crc32c
+(
+    unsigned int crc,    /* I: running checksum; pass 0 for the first call */
+    const void *buf,     /* I: buffer to be folded into the checksum */
+    size_t nbytes        /* I: number of bytes in the buffer */
+);
+
+void espa_crc32c_string
+(
+    unsigned int crc,    /* I: checksum to be formatted */
+    char *str            /* O: string of ESPA_CHECKSUM_STR_SIZE characters */
+);
+
+#endif
@@ -0,0 +1,211 @@
+/*****************************************************************************
+FILE: espa_dms.c
+
+PURPOSE: Contains the conversions between decimal degrees and packed DMS
+(DDDMMMSSS.ss) angles shared by the ESPA libraries.  These used to be
+duplicated in the format conversion and land/water mask libraries; keeping
+one copy here means there is a single implementation to maintain and
+optimize.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development, consolidating the
+                              conversions previously duplicated in the
+                              format conversion and land/water mask libraries
+
+NOTES:
+  1. The decomposition into degrees, minutes and seconds is done with floor
+     on the absolute value, which never produces a minutes or seconds field
+     of 60 and therefore doesn't need the carry handling of the previous
+     per-library copies.  The seconds are also carried in double precision
+     instead of float.
+*****************************************************************************/
+#include <math.h>
+#include "espa_dms.h"
+
+/******************************************************************************
+MODULE:  deg_to_dms
+
+PURPOSE:  Converts the decimal degree value to DMS in the form of DDDMMMSSS.ss.
+
+RETURN VALUE:
+Type = double
+Value      Description
+-----      -----------
+{all}      Packed DMS value
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+HISTORY:
+Date         Programmer       Reason
+---------    ---------------  -------------------------------------
+8/31/2026    Gail Schmidt     Original Development (consolidated from the
+                              copies in espa_hdf_eos.c and the land/water
+                              mask library)
+
+NOTES:
+******************************************************************************/
+double deg_to_dms
+(
+    double flt_deg   /* I: input decimal degree value */
+)
+{
+    double abs_deg;  /* absolute value of the input degree value */
+    double deg;      /* degree portion of the input value */
+    double min;      /* minute portion of the input value */
+    double sec;      /* seconds portion of the input value */
+
+    /* Split the absolute angle into degrees, minutes and seconds.  Using
+       floor keeps each field in its valid range without any carry
+       handling. */
+    abs_deg = fabs (flt_deg);
+    deg = floor (abs_deg);
+    min = floor (abs_deg * 60.0) - deg * 60.0;
+    sec = abs_deg * 3600.0 - deg * 3600.0 - min * 60.0;
+
+    /* Create the packed DMS value with the sign of the input value */
+    return (copysign (deg * 1000000.0 + min * 1000.0 + sec, flt_deg));
+}
+
+
+/******************************************************************************
+MODULE:  dms_to_deg
+
+PURPOSE:  Converts a single packed DMS value to decimal degrees
+
+RETURN VALUE:
+Type = none
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+HISTORY:
+Date          Programmer       Reason
+----------    ---------------  -------------------------------------
+8/31/2026     Gail Schmidt     Original Development (consolidated from dmsdeg
+                              in the geolocation routines)
+
+NOTES:
+  1. For compatibility with the previous implementation, the output value is
+     left untouched if the input DMS value is zero.
+******************************************************************************/
+void dms_to_deg
+(
+    double dms,            /* I: packed DMS value */
+    double *dec_degrees    /* O: degree value; not modified if dms is zero */
+)
+{
+    double abs_dms;  /* absolute value of the input DMS value */
+    double deg;      /* degrees */
+    double min;      /* minutes */
+    double sec;      /* decimal seconds */
+
+    /* Nothing to do? */
+    if (dms == 0.0)
+        return;
+
+    /* Split the absolute packed value into degrees, minutes and seconds */
+    abs_dms = fabs (dms);
+    deg = floor (abs_dms / 1000000.0);
+    min = floor (abs_dms / 1000.0) - deg * 1000.0;
+    sec = abs_dms - deg * 1000000.0 - min * 1000.0;
+
+    /* Calculate the decimal degrees with the sign of the input value */
+    *dec_degrees = copysign (deg + min / 60.0 + sec / 3600.0, dms);
+}
+
+
+/******************************************************************************
+MODULE:  deg_to_dms_batch
+
+PURPOSE:  Converts an array of decimal degree values to packed DMS values.
+
+RETURN VALUE:
+Type = none
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+HISTORY:
+Date          Programmer       Reason
+----------    ---------------  -------------------------------------
+8/31/2026     Gail Schmidt     Original Development
+
+NOTES:
+  1. The conversion is branch-free so the loop can be vectorized by the
+     compiler for callers converting many values.
+******************************************************************************/
+void deg_to_dms_batch
+(
+    int count,             /* I: number of values to convert */
+    const double *flt_deg, /* I: array of count decimal degree values */
+    double *dms            /* O: array of count packed DMS values */
+)
+{
+    double abs_deg;  /* absolute value of the current degree value */
+    double deg;      /* degree portion of the current value */
+    double min;      /* minute portion of the current value */
+    double sec;      /* seconds portion of the current value */
+    int i;           /* looping variable */
+
+    for (i = 0; i < count; i++)
+    {
+        abs_deg = fabs (flt_deg[i]);
+        deg = floor (abs_deg);
+        min = floor (abs_deg * 60.0) - deg * 60.0;
+        sec = abs_deg * 3600.0 - deg * 3600.0 - min * 60.0;
+        dms[i] = copysign (deg * 1000000.0 + min * 1000.0 + sec, flt_deg[i]);
+    }
+}
+
+
+/******************************************************************************
+MODULE:  dms_to_deg_batch
+
+PURPOSE:  Converts an array of packed DMS values to decimal degrees.
+
+RETURN VALUE:
+Type = none
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+HISTORY:
+Date          Programmer       Reason
+----------    ---------------  -------------------------------------
+8/31/2026     Gail Schmidt     Original Development
+
+NOTES:
+  1. The conversion is branch-free so the loop can be vectorized by the
+     compiler for callers converting many values.  Unlike dms_to_deg, zero
+     input values simply convert to zero.
+******************************************************************************/
+void dms_to_deg_batch
+(
+    int count,             /* I: number of values to convert */
+    const double *dms,     /* I: array of count packed DMS values */
+    double *dec_degrees    /* O: array of count degree values */
+)
+{
+    double abs_dms;  /* absolute value of the current DMS value */
+    double deg;      /* degrees */
+    double min;      /* minutes */
+    double sec;      /* decimal seconds */
+    int i;           /* looping variable */
+
+    for (i = 0; i < count; i++)
+    {
+        abs_dms = fabs (dms[i]);
+        deg = floor (abs_dms / 1000000.0);
+        min = floor (abs_dms / 1000.0) - deg * 1000.0;
+        sec = abs_dms - deg * 1000000.0 - min * 1000.0;
+        dec_degrees[i] = copysign (deg + min / 60.0 + sec / 3600.0, dms[i]);
+    }
+}
@@ -0,0 +1,51 @@
+/*****************************************************************************
+FILE: espa_dms.h
+
+PURPOSE: Contains prototypes for the packed DMS (DDDMMMSSS.ss) angle
+conversions shared by the ESPA libraries
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development, consolidating the
+                              conversions previously duplicated in the
+                              format conversion and land/water mask libraries
+
+NOTES:
+*****************************************************************************/
+
+#ifndef ESPA_DMS_H_
+#define ESPA_DMS_H_
+
+/* Prototypes */
+double deg_to_dms
+(
+    double flt_deg   /* I: input decimal degree value */
+);
+
+void dms_to_deg
+(
+    double dms,            /* I: packed DMS value */
+    double *dec_degrees    /* O: degree value; not modified if dms is zero */
+);
+
+void deg_to_dms_batch
+(
+    int count,             /* I: number of values to convert */
+    const double *flt_deg, /* I: array of count decimal degree values */
+    double *dms            /* O: array of count packed DMS values */
+);
+
+void dms_to_deg_batch
+(
+    int count,             /* I: number of values to convert */
+    const double *dms,     /* I: array of count packed DMS values */
+    double *dec_degrees    /* O: array of count degree values */
+);
+
+#endif
@@ -0,0 +1,249 @@
+/*****************************************************************************
+FILE: espa_logging.c
+
+PURPOSE: Contains functions for batched logging of error/warning messages.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Each message is formatted once, when it is submitted, into a ring of
+     pending entries; the arguments cannot be captured for later formatting
+     since string arguments often point at stack buffers which are gone by
+     flush time.  What is deferred is the emission: a flush writes every
+     pending entry with a single writev instead of a syscall per message.
+  2. Errors force an immediate flush since the callers typically exit right
+     after reporting them; warnings are allowed to accumulate and drain when
+     the ring fills, when an error arrives, or at exit.
+  3. Every thread has its own ring, so the converters' worker threads format
+     their messages without taking a lock or touching the heap and only meet
+     each other at the writev, which emits a whole flush in one atomic call
+     so messages from different threads never interleave mid-message.  The
+     ring of a worker thread is drained when the thread exits.
+*****************************************************************************/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/uio.h>
+#include "espa_logging.h"
+
+/* A formatted message waiting to be emitted */
+typedef struct
+{
+    char text[STR_SIZE];     /* framed, formatted message text */
+    size_t length;           /* length of the message text in bytes */
+} Espa_log_entry_t;
+
+/* Per-thread ring of pending messages; each thread formats into its own
+   ring without synchronization and the rings only meet at the writev */
+typedef struct
+{
+    Espa_log_entry_t entries[ESPA_LOG_ENTRIES];  /* pending messages */
+    int pending;             /* number of pending messages */
+    bool registered;         /* was the ring registered for draining when
+                                the thread exits? */
+} Espa_log_ring_t;
+
+static __thread Espa_log_ring_t log_ring;
+
+/* Key whose destructor drains the ring of an exiting worker thread; the
+   main thread's ring is drained by the exit handler instead */
+static pthread_key_t log_key;
+static pthread_once_t log_once = PTHREAD_ONCE_INIT;
+
+/******************************************************************************
+MODULE:  espa_log_drain (static)
+
+PURPOSE:  Emits every pending message of a ring with a single writev, which
+is atomic with respect to the flushes of the other threads.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. stdout is flushed first so the batched messages stay in order with any
+     plain printf output from the tools.
+******************************************************************************/
+static void espa_log_drain
+(
+    Espa_log_ring_t *ring    /* I: ring whose messages are to be emitted */
+)
+{
+    struct iovec iov[ESPA_LOG_ENTRIES];  /* one vector entry per message */
+    int i;                               /* looping variable */
+
+    if (ring->pending == 0)
+        return;
+
+    for (i = 0; i < ring->pending; i++)
+    {
+        iov[i].iov_base = ring->entries[i].text;
+        iov[i].iov_len = ring->entries[i].length;
+    }
+
+    fflush (stdout);
+    if (writev (STDOUT_FILENO, iov, ring->pending) == -1)
+        {}  /* nowhere left to report a failed write of the log itself */
+    ring->pending = 0;
+}
+
+
+/******************************************************************************
+MODULE:  espa_log_thread_exit (static)
+
+PURPOSE:  Drains the ring of a worker thread when the thread exits, so no
+pending warnings are stranded in the ring of a thread which is gone.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static void espa_log_thread_exit
+(
+    void *ring               /* I: ring of the exiting thread */
+)
+{
+    espa_log_drain (ring);
+}
+
+
+/******************************************************************************
+MODULE:  espa_log_init (static)
+
+PURPOSE:  One-time setup of the thread exit draining and the process exit
+flush.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static void espa_log_init (void)
+{
+    pthread_key_create (&log_key, espa_log_thread_exit);
+    atexit (espa_log_flush);
+}
+
+/******************************************************************************
+MODULE:  espa_log_flush
+
+PURPOSE:  Emits every pending message of the calling thread with a single
+writev.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Flushes the calling thread's ring now that
+                              every thread has its own
+
+NOTES:
+******************************************************************************/
+void espa_log_flush (void)
+{
+    espa_log_drain (&log_ring);
+}
+
+/******************************************************************************
+MODULE:  espa_log_message
+
+PURPOSE:  Formats an error/warning message into the ring of pending messages,
+flushing as described in the file notes.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Format into a per-thread ring so concurrent
+                              callers don't contend on a lock
+
+NOTES:
+  1. The formatting is allocation-free: the message goes straight into the
+     thread's static ring entry.
+******************************************************************************/
+void espa_log_message
+(
+    bool error_flag,    /* I: true for errors, false for warnings */
+    const char *module, /* I: calling module name */
+    const char *format, /* I: printf-style format for the message, without
+                              ending EOL */
+    ...                 /* I: arguments for the format string */
+)
+{
+    Espa_log_entry_t *entry = NULL;  /* ring entry for this message */
+    va_list args;                    /* arguments for the format string */
+    int count;                       /* number of chars in the framing */
+    int body;                        /* number of chars in the message body */
+
+    /* Make sure the pending messages drain when the process or this thread
+       exits */
+    pthread_once (&log_once, espa_log_init);
+    if (!log_ring.registered)
+    {
+        pthread_setspecific (log_key, &log_ring);
+        log_ring.registered = true;
+    }
+
+    /* Make room if the ring is full */
+    if (log_ring.pending == ESPA_LOG_ENTRIES)
+        espa_log_drain (&log_ring);
+
+    /* Format the message once, framed the way error_handler always printed
+       it */
+    entry = &log_ring.entries[log_ring.pending];
+    count = snprintf (entry->text, sizeof (entry->text), "%s: %s : ",
+        error_flag ? "Error" : "Warning", module);
+    va_start (args, format);
+    body = vsnprintf (entry->text + count, sizeof (entry->text) - count,
+        format, args);
+    va_end (args);
+    if (body > (int) sizeof (entry->text) - count - 1)
+        body = sizeof (entry->text) - count - 1;
+    count += body;
+
+    /* Tack on the trailing EOLs, dropping message text if there is no room */
+    if (count > (int) sizeof (entry->text) - 3)
+        count = sizeof (entry->text) - 3;
+    entry->text[count++] = '\n';
+    if (error_flag)
+        entry->text[count++] = '\n';
+    entry->length = count;
+    log_ring.pending++;
+
+    /* Errors are emitted right away since the caller typically exits next */
+    if (error_flag)
+        espa_log_drain (&log_ring);
+}
@@ -0,0 +1,48 @@
+/*****************************************************************************
+FILE: espa_logging.h
+
+PURPOSE: Contains defines and prototypes for the batched logging support
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Gave every thread its own ring so concurrent
+                              callers don't contend on a lock
+
+NOTES:
+  1. Messages are formatted once into a ring of pending entries and emitted
+     with a single writev per flush, so callers in tight loops pay for the
+     formatting but not for a stderr/stdout syscall per message.
+  2. Every thread has its own ring; espa_log_flush emits the pending
+     messages of the calling thread and the ring of a worker thread is
+     drained automatically when the thread exits.
+*****************************************************************************/
+
+#ifndef ESPA_LOGGING_H_
+#define ESPA_LOGGING_H_
+
+#include <stdbool.h>
+#include "espa_common.h"
+
+/* Number of messages which can be pending before a flush is forced */
+#define ESPA_LOG_ENTRIES 64
+
+/* Prototypes */
+void espa_log_message
+(
+    bool error_flag,    /* I: true for errors, false for warnings */
+    const char *module, /* I: calling module name */
+    const char *format, /* I: printf-style format for the message, without
+                              ending EOL */
+    ...                 /* I: arguments for the format string */
+);
+
+void espa_log_flush (void);
+
+#endif
@@ -0,0 +1,193 @@
+/*****************************************************************************
+FILE: espa_parallel.c
+
+PURPOSE: Contains functions for choosing thread counts and streaming block
+sizes per stage, based on the band dimensions, the available memory, and the
+available cores.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "espa_parallel.h"
+#include "espa_thread_pool.h"
+
+/******************************************************************************
+MODULE:  espa_parallel_available_memory
+
+PURPOSE:  Returns an estimate of the memory (in bytes) currently available to
+the process, from MemAvailable in /proc/meminfo when present, otherwise from
+the count of free physical pages.
+
+RETURN VALUE:
+Type = long long
+Value           Description
+-----           -----------
+(bytes)         Estimated available memory in bytes
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. MemAvailable accounts for the reclaimable page cache, which the free
+     page count does not, so the fallback underestimates on machines with a
+     warm cache.  Both are only estimates; the callers use the value to size
+     buffers conservatively, not as a reservation.
+******************************************************************************/
+long long espa_parallel_available_memory (void)
+{
+    char line[256];              /* line read from /proc/meminfo */
+    long long mem_kb;            /* available memory in kilobytes */
+    long long pages;             /* free physical pages */
+    long long page_size;         /* size of a page in bytes */
+    FILE *fptr = NULL;           /* file pointer for /proc/meminfo */
+
+    /* Prefer the kernel's own estimate of the available memory */
+    fptr = fopen ("/proc/meminfo", "r");
+    if (fptr != NULL)
+    {
+        while (fgets (line, sizeof (line), fptr) != NULL)
+        {
+            if (sscanf (line, "MemAvailable: %lld kB", &mem_kb) == 1)
+            {
+                fclose (fptr);
+                return mem_kb * 1024LL;
+            }
+        }
+        fclose (fptr);
+    }
+
+    /* Fall back to the free physical pages */
+    pages = (long long) sysconf (_SC_AVPHYS_PAGES);
+    page_size = (long long) sysconf (_SC_PAGESIZE);
+    if (pages < 0 || page_size < 0)
+        return 0;
+
+    return pages * page_size;
+}
+
+
+/******************************************************************************
+MODULE:  espa_parallel_threads
+
+PURPOSE:  Chooses the number of threads a stage should use for a band of the
+given dimensions.  The count starts from the pool cap (the ESPA_NUM_THREADS
+environment variable or the number of online CPUs) and is reduced so each
+thread still receives a worthwhile slice of the band.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+(count)         Number of threads to use for the stage (at least 1)
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Parallel stages hand out work by the line (or by small groups of
+     lines), so the count is additionally capped by the number of lines.
+******************************************************************************/
+int espa_parallel_threads
+(
+    int nlines,         /* I: number of lines in the band the stage works */
+    int nsamps,         /* I: number of samples per line in the band */
+    int size            /* I: number of bytes per pixel */
+)
+{
+    long long band_bytes;        /* total bytes the stage touches */
+    int num_threads;             /* chosen number of threads */
+
+    num_threads = espa_pool_max_threads ();
+
+    /* Don't hand any thread less than the minimum worthwhile slice */
+    band_bytes = (long long) nlines * nsamps * size;
+    if (num_threads > band_bytes / ESPA_PARALLEL_MIN_BYTES_PER_THREAD)
+        num_threads = band_bytes / ESPA_PARALLEL_MIN_BYTES_PER_THREAD;
+
+    /* Work is handed out by the line */
+    if (num_threads > nlines)
+        num_threads = nlines;
+
+    if (num_threads < 1)
+        num_threads = 1;
+
+    return num_threads;
+}
+
+
+/******************************************************************************
+MODULE:  espa_parallel_block_lines
+
+PURPOSE:  Chooses the number of lines a streaming stage should process per
+block for a band of the given dimensions, targeting the block byte size while
+staying within a conservative fraction of the available memory and giving
+every thread at least one line per block.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+(count)         Number of lines per streaming block (at least 1, at most
+                nlines)
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+int espa_parallel_block_lines
+(
+    int nlines,         /* I: number of lines in the band the stage works */
+    int nsamps,         /* I: number of samples per line in the band */
+    int size,           /* I: number of bytes per pixel */
+    int num_threads     /* I: number of threads working the blocks */
+)
+{
+    long long line_bytes;        /* bytes in one line of the band */
+    long long target_bytes;      /* target bytes in one block */
+    long long memory_budget;     /* memory the stage should plan to hold */
+    int block_lines;             /* chosen number of lines per block */
+
+    line_bytes = (long long) nsamps * size;
+    if (line_bytes < 1)
+        line_bytes = 1;
+
+    /* Start from the block target, but don't plan to hold more than a
+       conservative fraction of the available memory */
+    target_bytes = ESPA_PARALLEL_BLOCK_BYTES;
+    memory_budget = espa_parallel_available_memory ()
+        / ESPA_PARALLEL_MEMORY_FRACTION;
+    if (memory_budget > 0 && target_bytes > memory_budget)
+        target_bytes = memory_budget;
+
+    block_lines = target_bytes / line_bytes;
+
+    /* Give every thread at least one line to work in each block */
+    if (num_threads > 1 && block_lines < num_threads)
+        block_lines = num_threads;
+    if (block_lines < 1)
+        block_lines = 1;
+    if (block_lines > nlines)
+        block_lines = nlines;
+
+    return block_lines;
+}
@@ -0,0 +1,64 @@
+/*****************************************************************************
+FILE: espa_parallel.h
+
+PURPOSE: Contains defines and prototypes for the scene-adaptive parallelism
+heuristics.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Static thread counts either starve big scenes or oversubscribe small
+     ones, since the fleet mixes machines of very different sizes.  These
+     routines size the thread count and streaming block for a stage from
+     the band dimensions, the available memory, and the available cores,
+     so a small thermal band isn't spread across 16 threads and a full
+     scene isn't processed serially.
+*****************************************************************************/
+
+#ifndef ESPA_PARALLEL_H
+#define ESPA_PARALLEL_H
+
+#include <stdlib.h>
+#include "error_handler.h"
+
+/* Defines */
+/* minimum number of band bytes a stage should hand each thread; below this
+   the synchronization overhead outweighs the parallel work */
+#define ESPA_PARALLEL_MIN_BYTES_PER_THREAD (4L * 1024L * 1024L)
+
+/* target number of bytes in a streaming block; large enough to amortize the
+   per-block I/O and dispatch overhead, small enough to stay cache and
+   memory friendly */
+#define ESPA_PARALLEL_BLOCK_BYTES (16L * 1024L * 1024L)
+
+/* fraction (denominator) of the available memory a single stage should plan
+   to hold in buffers at once */
+#define ESPA_PARALLEL_MEMORY_FRACTION 4
+
+/* Prototypes */
+long long espa_parallel_available_memory (void);
+
+int espa_parallel_threads
+(
+    int nlines,         /* I: number of lines in the band the stage works */
+    int nsamps,         /* I: number of samples per line in the band */
+    int size            /* I: number of bytes per pixel */
+);
+
+int espa_parallel_block_lines
+(
+    int nlines,         /* I: number of lines in the band the stage works */
+    int nsamps,         /* I: number of samples per line in the band */
+    int size,           /* I: number of bytes per pixel */
+    int num_threads     /* I: number of threads working the blocks */
+);
+
+#endif
@@ -0,0 +1,504 @@
+/*****************************************************************************
+FILE: espa_perf.c
+
+PURPOSE: Contains functions for lightweight performance instrumentation of
+the conversion hot paths.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added stage accounting sampling peak RSS, storage
+                              I/O, and page faults at stage boundaries
+
+NOTES:
+  1. Sites are registered on first use by name; the table is small and the
+     scopes are coarse (a band, a file, a parse), so the linear name lookup
+     under the lock is not itself a hot path.
+  2. When ESPA_PERF is not set every entry point reduces to one check of a
+     cached flag, so the instrumentation can stay wired in production
+     builds.
+*****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include "espa_perf.h"
+
+/* Maximum number of distinct instrumented sites */
+#define ESPA_PERF_MAX_SITES 32
+
+/* Maximum number of stage records kept for the summary */
+#define ESPA_PERF_MAX_STAGES 256
+
+/* Length allowed for a stage label, including the terminator; labels are
+   typically scene or product filenames */
+#define ESPA_PERF_STAGE_NAME_SIZE 128
+
+/* Length allowed for a site name, including the terminator */
+#define ESPA_PERF_NAME_SIZE 64
+
+/* Accumulated numbers for one instrumented site */
+typedef struct
+{
+    char name[ESPA_PERF_NAME_SIZE];  /* site name */
+    long long calls;                 /* timed scopes or counted events */
+    long long total_ns;              /* time spent in the timed scopes */
+    long long bytes;                 /* bytes processed in the scopes */
+} Espa_perf_site_t;
+
+/* Table of instrumented sites, protected by the lock since the converters
+   run their hot paths from multiple threads */
+/* One completed stage record for the summary */
+typedef struct
+{
+    char label[ESPA_PERF_STAGE_NAME_SIZE];  /* stage label */
+    long long total_ns;              /* elapsed time of the stage */
+    long long peak_rss_kb;           /* process peak RSS at the stage end */
+    long long read_bytes;            /* storage bytes read by the stage */
+    long long write_bytes;           /* storage bytes written by the stage */
+    long long minor_faults;          /* minor page faults in the stage */
+    long long major_faults;          /* major page faults in the stage */
+} Espa_perf_stage_rec_t;
+
+static Espa_perf_site_t perf_sites[ESPA_PERF_MAX_SITES];
+static Espa_perf_stage_rec_t perf_stages[ESPA_PERF_MAX_STAGES];
+static int perf_nsites = 0;          /* number of registered sites */
+static int perf_nstages = 0;         /* number of completed stage records */
+static int perf_state = -1;          /* -1 unknown, 0 disabled, 1 enabled */
+static const char *perf_dest = NULL; /* ESPA_PERF value for the dump */
+static pthread_mutex_t perf_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/******************************************************************************
+MODULE:  espa_perf_dump (static)
+
+PURPOSE:  Writes the JSON summary of every instrumented site at exit.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static void espa_perf_dump (void)
+{
+    FILE *fp = stderr;    /* destination of the summary */
+    int i;                /* looping variable */
+
+    /* Anything other than "1" or "stderr" names the output file */
+    if (strcmp (perf_dest, "1") && strcmp (perf_dest, "stderr"))
+    {
+        fp = fopen (perf_dest, "w");
+        if (fp == NULL)
+            fp = stderr;
+    }
+
+    fprintf (fp, "{\"espa_perf\": [\n");
+    for (i = 0; i < perf_nsites; i++)
+    {
+        fprintf (fp, "  {\"site\": \"%s\", \"calls\": %lld, "
+            "\"seconds\": %.6f, \"bytes\": %lld}%s\n",
+            perf_sites[i].name, perf_sites[i].calls,
+            perf_sites[i].total_ns * 1e-9, perf_sites[i].bytes,
+            (i < perf_nsites - 1) ? "," : "");
+    }
+    fprintf (fp, "],\n\"espa_perf_stages\": [\n");
+    for (i = 0; i < perf_nstages; i++)
+    {
+        fprintf (fp, "  {\"stage\": \"%s\", \"seconds\": %.6f, "
+            "\"peak_rss_kb\": %lld, \"read_bytes\": %lld, "
+            "\"write_bytes\": %lld, \"minor_faults\": %lld, "
+            "\"major_faults\": %lld}%s\n",
+            perf_stages[i].label, perf_stages[i].total_ns * 1e-9,
+            perf_stages[i].peak_rss_kb, perf_stages[i].read_bytes,
+            perf_stages[i].write_bytes, perf_stages[i].minor_faults,
+            perf_stages[i].major_faults,
+            (i < perf_nstages - 1) ? "," : "");
+    }
+    fprintf (fp, "]}\n");
+
+    if (fp != stderr)
+        fclose (fp);
+}
+
+/******************************************************************************
+MODULE:  espa_perf_site (static)
+
+PURPOSE:  Finds or registers the site with the specified name.  The lock
+must be held by the caller.
+
+RETURN VALUE:
+Type = Espa_perf_site_t *
+Value        Description
+-----        -----------
+NULL         The site table is full
+non-NULL     Entry for the site
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static Espa_perf_site_t *espa_perf_site
+(
+    const char *site     /* I: name of the instrumented site */
+)
+{
+    int i;               /* looping variable */
+
+    for (i = 0; i < perf_nsites; i++)
+    {
+        if (!strcmp (perf_sites[i].name, site))
+            return &perf_sites[i];
+    }
+
+    if (perf_nsites == ESPA_PERF_MAX_SITES)
+        return NULL;
+
+    snprintf (perf_sites[perf_nsites].name, ESPA_PERF_NAME_SIZE, "%s", site);
+    return &perf_sites[perf_nsites++];
+}
+
+/******************************************************************************
+MODULE:  espa_perf_enabled
+
+PURPOSE:  Reports whether instrumentation was enabled through the ESPA_PERF
+environment variable, checking the environment on the first call only.
+
+RETURN VALUE:
+Type = bool
+Value        Description
+-----        -----------
+true         Instrumentation is enabled
+false        Instrumentation is disabled
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+bool espa_perf_enabled (void)
+{
+    const char *value = NULL;    /* ESPA_PERF environment value */
+
+    if (perf_state == -1)
+    {
+        pthread_mutex_lock (&perf_lock);
+        if (perf_state == -1)
+        {
+            value = getenv ("ESPA_PERF");
+            if (value != NULL && value[0] != '\0' && strcmp (value, "0"))
+            {
+                perf_dest = value;
+                atexit (espa_perf_dump);
+                perf_state = 1;
+            }
+            else
+                perf_state = 0;
+        }
+        pthread_mutex_unlock (&perf_lock);
+    }
+
+    return perf_state == 1;
+}
+
+/******************************************************************************
+MODULE:  espa_perf_start
+
+PURPOSE:  Returns the monotonic clock in nanoseconds for the start of a
+timed scope, or 0 when instrumentation is disabled.
+
+RETURN VALUE:
+Type = long long
+Value        Description
+-----        -----------
+0            Instrumentation is disabled
+non-zero     Monotonic time in nanoseconds
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+long long espa_perf_start (void)
+{
+    struct timespec ts;    /* monotonic clock reading */
+
+    if (!espa_perf_enabled ())
+        return 0;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (long long) ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/******************************************************************************
+MODULE:  espa_perf_record
+
+PURPOSE:  Accumulates the elapsed time and byte count of a timed scope into
+the specified site.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void espa_perf_record
+(
+    const char *site,    /* I: name of the instrumented site */
+    long long start_ns,  /* I: value returned by espa_perf_start */
+    long long nbytes     /* I: bytes processed in the scope, or 0 */
+)
+{
+    struct timespec ts;              /* monotonic clock reading */
+    long long now;                   /* current time in nanoseconds */
+    Espa_perf_site_t *entry = NULL;  /* table entry for the site */
+
+    if (start_ns == 0)
+        return;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    now = (long long) ts.tv_sec * 1000000000LL + ts.tv_nsec;
+
+    pthread_mutex_lock (&perf_lock);
+    entry = espa_perf_site (site);
+    if (entry != NULL)
+    {
+        entry->calls++;
+        entry->total_ns += now - start_ns;
+        entry->bytes += nbytes;
+    }
+    pthread_mutex_unlock (&perf_lock);
+}
+
+/******************************************************************************
+MODULE:  espa_perf_count
+
+PURPOSE:  Adds to a plain counter, such as a cache hit count.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void espa_perf_count
+(
+    const char *site,    /* I: name of the counter */
+    long long count      /* I: amount to add to the counter */
+)
+{
+    Espa_perf_site_t *entry = NULL;  /* table entry for the counter */
+
+    if (!espa_perf_enabled ())
+        return;
+
+    pthread_mutex_lock (&perf_lock);
+    entry = espa_perf_site (site);
+    if (entry != NULL)
+        entry->calls += count;
+    pthread_mutex_unlock (&perf_lock);
+}
+
+/******************************************************************************
+MODULE:  espa_perf_sample_io (static)
+
+PURPOSE:  Samples the storage I/O counters of the process from /proc/self/io.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The counters are left at zero on kernels without /proc/self/io, so the
+     stage records degrade to time and fault accounting there.
+******************************************************************************/
+static void espa_perf_sample_io
+(
+    long long *read_bytes,   /* O: storage bytes read by the process */
+    long long *write_bytes   /* O: storage bytes written by the process */
+)
+{
+    char line[128];          /* current line of /proc/self/io */
+    FILE *fp = NULL;         /* /proc/self/io stream */
+
+    *read_bytes = 0;
+    *write_bytes = 0;
+    fp = fopen ("/proc/self/io", "r");
+    if (fp == NULL)
+        return;
+
+    while (fgets (line, sizeof (line), fp) != NULL)
+    {
+        if (!strncmp (line, "read_bytes:", 11))
+            *read_bytes = atoll (line + 11);
+        else if (!strncmp (line, "write_bytes:", 12))
+            *write_bytes = atoll (line + 12);
+    }
+    fclose (fp);
+}
+
+/******************************************************************************
+MODULE:  espa_perf_peak_rss_kb (static)
+
+PURPOSE:  Returns the peak resident set size of the process in kilobytes.
+
+RETURN VALUE:
+Type = long long
+Value        Description
+-----        -----------
+0            The peak RSS is not available
+non-zero     Peak RSS in kilobytes
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static long long espa_perf_peak_rss_kb (void)
+{
+    struct rusage usage;     /* resource usage of the process */
+
+    if (getrusage (RUSAGE_SELF, &usage) != 0)
+        return 0;
+
+    return (long long) usage.ru_maxrss;
+}
+
+/******************************************************************************
+MODULE:  espa_perf_stage_begin
+
+PURPOSE:  Takes the resource snapshot for the start of a coarse stage: the
+monotonic clock, the storage I/O counters, and the page fault counters.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void espa_perf_stage_begin
+(
+    Espa_perf_stage_t *stage  /* O: resource snapshot for the stage start */
+)
+{
+    struct timespec ts;      /* monotonic clock reading */
+    struct rusage usage;     /* resource usage of the process */
+
+    stage->start_ns = 0;
+    if (!espa_perf_enabled ())
+        return;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    stage->start_ns = (long long) ts.tv_sec * 1000000000LL + ts.tv_nsec;
+    espa_perf_sample_io (&stage->read_bytes, &stage->write_bytes);
+    stage->minor_faults = 0;
+    stage->major_faults = 0;
+    if (getrusage (RUSAGE_SELF, &usage) == 0)
+    {
+        stage->minor_faults = (long long) usage.ru_minflt;
+        stage->major_faults = (long long) usage.ru_majflt;
+    }
+}
+
+/******************************************************************************
+MODULE:  espa_perf_stage_end
+
+PURPOSE:  Emits the summary record for a coarse stage: the elapsed time, the
+peak RSS of the process so far, and the storage bytes and page faults charged
+to the stage since its snapshot.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The peak RSS is a process-wide high-water mark, so for stages run one
+     after another it attributes the pressure to the first stage that
+     reached it; the read/write bytes and fault counts are true deltas.
+  2. Stages running concurrently (scenes across the batch thread pool) each
+     record their own deltas, but the process-wide I/O and fault counters
+     include the work of the overlapping stages.
+******************************************************************************/
+void espa_perf_stage_end
+(
+    const char *label,   /* I: name of the stage (e.g. the scene) */
+    const Espa_perf_stage_t *stage  /* I: snapshot from the stage start */
+)
+{
+    struct timespec ts;      /* monotonic clock reading */
+    struct rusage usage;     /* resource usage of the process */
+    long long now;           /* current time in nanoseconds */
+    long long read_bytes;    /* storage bytes read at the stage end */
+    long long write_bytes;   /* storage bytes written at the stage end */
+    Espa_perf_stage_rec_t *rec = NULL;  /* record for the stage */
+
+    if (stage->start_ns == 0)
+        return;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    now = (long long) ts.tv_sec * 1000000000LL + ts.tv_nsec;
+    espa_perf_sample_io (&read_bytes, &write_bytes);
+
+    pthread_mutex_lock (&perf_lock);
+    if (perf_nstages < ESPA_PERF_MAX_STAGES)
+    {
+        rec = &perf_stages[perf_nstages++];
+        snprintf (rec->label, ESPA_PERF_STAGE_NAME_SIZE, "%s", label);
+        rec->total_ns = now - stage->start_ns;
+        rec->peak_rss_kb = espa_perf_peak_rss_kb ();
+        rec->read_bytes = read_bytes - stage->read_bytes;
+        rec->write_bytes = write_bytes - stage->write_bytes;
+        rec->minor_faults = 0;
+        rec->major_faults = 0;
+        if (getrusage (RUSAGE_SELF, &usage) == 0)
+        {
+            rec->minor_faults = (long long) usage.ru_minflt -
+                stage->minor_faults;
+            rec->major_faults = (long long) usage.ru_majflt -
+                stage->major_faults;
+        }
+    }
+    pthread_mutex_unlock (&perf_lock);
+}
@@ -0,0 +1,84 @@
+/*****************************************************************************
+FILE: espa_perf.h
+
+PURPOSE: Contains defines and prototypes for the lightweight performance
+instrumentation support
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added stage accounting sampling peak RSS, storage
+                              I/O, and page faults at stage boundaries
+
+NOTES:
+  1. Instrumentation is off unless the ESPA_PERF environment variable is
+     set; when off, every call is a single flag check.  Set ESPA_PERF=1 to
+     dump the JSON summary to stderr at exit, or ESPA_PERF=<filename> to
+     dump it to a file.
+  2. Typical timed scope:
+         long long perf_start = espa_perf_start ();
+         ... work ...
+         espa_perf_record ("site_name", perf_start, nbytes);
+     and counters (cache hits and the like) use espa_perf_count.
+  3. Coarse stages (a scene, a conversion) bracket their work with
+         Espa_perf_stage_t stage;
+         espa_perf_stage_begin (&stage);
+         ... work ...
+         espa_perf_stage_end ("label", &stage);
+     which emits one record per stage with the elapsed time, the peak RSS
+     of the process so far, and the storage bytes and page faults charged
+     to the stage.
+*****************************************************************************/
+
+#ifndef ESPA_PERF_H_
+#define ESPA_PERF_H_
+
+#include <stdbool.h>
+
+/* Resource snapshot taken at the start of a stage; the fields are deltas
+   bases for the record emitted when the stage ends */
+typedef struct
+{
+    long long start_ns;      /* monotonic start time of the stage */
+    long long read_bytes;    /* storage bytes read at the start */
+    long long write_bytes;   /* storage bytes written at the start */
+    long long minor_faults;  /* minor page faults at the start */
+    long long major_faults;  /* major page faults at the start */
+} Espa_perf_stage_t;
+
+/* Prototypes */
+bool espa_perf_enabled (void);
+
+long long espa_perf_start (void);
+
+void espa_perf_record
+(
+    const char *site,    /* I: name of the instrumented site */
+    long long start_ns,  /* I: value returned by espa_perf_start */
+    long long nbytes     /* I: bytes processed in the scope, or 0 */
+);
+
+void espa_perf_count
+(
+    const char *site,    /* I: name of the counter */
+    long long count      /* I: amount to add to the counter */
+);
+
+void espa_perf_stage_begin
+(
+    Espa_perf_stage_t *stage  /* O: resource snapshot for the stage start */
+);
+
+void espa_perf_stage_end
+(
+    const char *label,   /* I: name of the stage (e.g. the scene) */
+    const Espa_perf_stage_t *stage  /* I: snapshot from the stage start */
+);
+
+#endif
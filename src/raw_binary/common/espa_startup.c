@@ -0,0 +1,311 @@
+/*****************************************************************************
+FILE: espa_startup.c
+
+PURPOSE: Contains functions for profiling the cold-start latency of the
+command-line tools: the per-invocation fixed costs (library init, schema
+validation, XML parse, first I/O) paid before the main loop starts.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The profile is off unless the tool was run with --startup-profile or
+     the ESPA_STARTUP_PROFILE environment variable is set; when off, the
+     phase marks reduce to one check of a flag.
+  2. The phases are aggregated by name, since the batch tools pass the
+     validation and parse boundaries once per input file before their main
+     loops start.
+*****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "espa_startup.h"
+
+/* Maximum number of distinct startup phases kept for the report */
+#define ESPA_STARTUP_MAX_PHASES 16
+
+/* Length allowed for a phase name, including the terminator */
+#define ESPA_STARTUP_NAME_SIZE 64
+
+/* Accumulated time for one startup phase */
+typedef struct
+{
+    char name[ESPA_STARTUP_NAME_SIZE];  /* phase name */
+    long long passes;                /* times the phase boundary was hit */
+    long long total_ns;              /* time charged to the phase */
+} Espa_startup_phase_t;
+
+/* Phase table, protected by the lock since the first raw binary I/O can
+   come from a reader thread */
+static Espa_startup_phase_t startup_phases[ESPA_STARTUP_MAX_PHASES];
+static int startup_nphases = 0;      /* number of recorded phases */
+static bool startup_enabled = false; /* was the profile requested */
+static bool startup_reported = false;  /* has the report been written */
+static long long startup_t0 = 0;     /* profile start time */
+static long long startup_last = 0;   /* time of the previous phase mark */
+static pthread_mutex_t startup_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/******************************************************************************
+MODULE:  startup_now_ns (static)
+
+PURPOSE:  Returns the monotonic clock in nanoseconds, matching the clock the
+espa_perf timers read.
+
+RETURN VALUE:
+Type = long long
+Value        Description
+-----        -----------
+nanoseconds  Monotonic time in nanoseconds
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static long long startup_now_ns (void)
+{
+    struct timespec ts;    /* monotonic clock reading */
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (long long) ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/******************************************************************************
+MODULE:  espa_startup_report (static)
+
+PURPOSE:  Writes the cold-start profile to stderr.  The lock must be held by
+the caller.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static void espa_startup_report (void)
+{
+    int i;                /* looping variable */
+
+    if (startup_reported)
+        return;
+    startup_reported = true;
+
+    fprintf (stderr, "Startup profile:\n");
+    for (i = 0; i < startup_nphases; i++)
+    {
+        fprintf (stderr, "    %-28s %10.3f ms", startup_phases[i].name,
+            startup_phases[i].total_ns * 1e-6);
+        if (startup_phases[i].passes > 1)
+            fprintf (stderr, "  (%lld passes)", startup_phases[i].passes);
+        fprintf (stderr, "\n");
+    }
+    fprintf (stderr, "    %-28s %10.3f ms\n", "total before the main loop",
+        (startup_now_ns () - startup_t0) * 1e-6);
+}
+
+/******************************************************************************
+MODULE:  espa_startup_report_at_exit (static)
+
+PURPOSE:  Writes the cold-start profile at exit for tools which never reach
+the first raw binary I/O.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static void espa_startup_report_at_exit (void)
+{
+    pthread_mutex_lock (&startup_lock);
+    espa_startup_report ();
+    pthread_mutex_unlock (&startup_lock);
+}
+
+/******************************************************************************
+MODULE:  espa_startup_profile_args
+
+PURPOSE:  Shared option parsing for the cold-start profile.  Strips the
+--startup-profile option from the argument list before the per-tool argument
+parsing runs, and starts the profile clock if the option (or the
+ESPA_STARTUP_PROFILE environment variable) was present.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Called at the top of main, before get_args, so the per-invocation cost
+     of everything after the option scan is charged to a phase.
+******************************************************************************/
+void espa_startup_profile_args
+(
+    int *argc,           /* I/O: argument count from main; reduced if the
+                                 shared option was stripped */
+    char **argv          /* I/O: argument list from main; the shared option
+                                 is stripped in place */
+)
+{
+    int i;               /* looping variable */
+    int nkeep = 1;       /* arguments kept after the strip */
+    bool requested = false;  /* was the profile requested */
+
+    /* Strip every occurrence of the shared option, so the per-tool getopt
+       loops never see it */
+    for (i = 1; i < *argc; i++)
+    {
+        if (!strcmp (argv[i], ESPA_STARTUP_PROFILE_OPTION))
+            requested = true;
+        else
+            argv[nkeep++] = argv[i];
+    }
+    *argc = nkeep;
+    argv[nkeep] = NULL;
+
+    if (getenv ("ESPA_STARTUP_PROFILE") != NULL)
+        requested = true;
+    if (!requested)
+        return;
+
+    startup_t0 = startup_now_ns ();
+    startup_last = startup_t0;
+    startup_enabled = true;
+    atexit (espa_startup_report_at_exit);
+}
+
+/******************************************************************************
+MODULE:  espa_startup_profile_enabled
+
+PURPOSE:  Reports whether the cold-start profile was requested.
+
+RETURN VALUE:
+Type = bool
+Value        Description
+-----        -----------
+true         The profile is enabled
+false        The profile is disabled
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+bool espa_startup_profile_enabled (void)
+{
+    return startup_enabled;
+}
+
+/******************************************************************************
+MODULE:  espa_startup_mark
+
+PURPOSE:  Marks the end of a named startup phase.  All the time since the
+previous phase boundary is charged to the phase.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Marks after the report has been written (i.e. after the main loop has
+     started) are ignored, so the library boundaries can stay wired without
+     polluting the startup numbers with steady-state work.
+******************************************************************************/
+void espa_startup_mark
+(
+    const char *phase    /* I: name of the startup phase which just ended */
+)
+{
+    long long now;       /* current monotonic time */
+    int i;               /* looping variable */
+
+    if (!startup_enabled || startup_reported)
+        return;
+
+    pthread_mutex_lock (&startup_lock);
+    if (!startup_reported)
+    {
+        now = startup_now_ns ();
+        for (i = 0; i < startup_nphases; i++)
+        {
+            if (!strcmp (startup_phases[i].name, phase))
+                break;
+        }
+        if (i == startup_nphases && i < ESPA_STARTUP_MAX_PHASES)
+        {
+            snprintf (startup_phases[i].name, ESPA_STARTUP_NAME_SIZE, "%s",
+                phase);
+            startup_phases[i].passes = 0;
+            startup_phases[i].total_ns = 0;
+            startup_nphases++;
+        }
+        if (i < startup_nphases)
+        {
+            startup_phases[i].passes++;
+            startup_phases[i].total_ns += now - startup_last;
+        }
+        startup_last = now;
+    }
+    pthread_mutex_unlock (&startup_lock);
+}
+
+/******************************************************************************
+MODULE:  espa_startup_note_io
+
+PURPOSE:  Marks the first raw binary I/O and writes the profile report; the
+first band read or write is where the main loop takes over from the startup
+work.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Called from the raw binary read and write entry points; after the
+     report is written the call reduces to one flag check, so the I/O hot
+     path is not paying for the instrumentation.
+******************************************************************************/
+void espa_startup_note_io (void)
+{
+    if (!startup_enabled || startup_reported)
+        return;
+
+    espa_startup_mark ("first raw binary I/O");
+
+    pthread_mutex_lock (&startup_lock);
+    espa_startup_report ();
+    pthread_mutex_unlock (&startup_lock);
+}
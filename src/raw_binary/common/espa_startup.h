@@ -0,0 +1,59 @@
+/*****************************************************************************
+FILE: espa_startup.h
+
+PURPOSE: Contains defines and prototypes for the cold-start latency profile
+shared by the command-line tools.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Every tool calls espa_startup_profile_args at the top of main, before
+     its own argument parsing.  The call strips the shared --startup-profile
+     option from the argument list, so the per-tool getopt loops never see
+     it.  Setting the ESPA_STARTUP_PROFILE environment variable enables the
+     profile without the option.
+  2. The phase boundaries are marked from inside the library (libxml2
+     setup, schema validation, XML parse, first raw binary I/O), so the
+     tools only opt in; they do not time anything themselves.  Each phase
+     is charged all the time since the previous boundary, which is what
+     makes the report useful for bisecting the per-invocation fixed costs.
+  3. The report is written to stderr when the first raw binary I/O happens,
+     which is where the per-band main loop takes over from the startup
+     work, or at exit for tools which never touch the raw binary bands.
+*****************************************************************************/
+
+#ifndef ESPA_STARTUP_H_
+#define ESPA_STARTUP_H_
+
+#include <stdbool.h>
+
+/* Option the tools share for requesting the cold-start profile */
+#define ESPA_STARTUP_PROFILE_OPTION "--startup-profile"
+
+/* Prototypes */
+void espa_startup_profile_args
+(
+    int *argc,           /* I/O: argument count from main; reduced if the
+                                 shared option was stripped */
+    char **argv          /* I/O: argument list from main; the shared option
+                                 is stripped in place */
+);
+
+bool espa_startup_profile_enabled (void);
+
+void espa_startup_mark
+(
+    const char *phase    /* I: name of the startup phase which just ended */
+);
+
+void espa_startup_note_io (void);
+
+#endif
@@ -0,0 +1,72 @@
+/*****************************************************************************
+FILE: espa_strscan.c
+
+PURPOSE: Contains functions for scanning whitespace-delimited tokens out of
+NULL-terminated metadata text.  The MODIS ODL blobs run to several hundred
+KB, so the token walk is the dominant cost of indexing them.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The scanner leans on the C library's strspn/strcspn, which are
+     vectorized on the common platforms, so large metadata blobs are
+     scanned a register at a time instead of a byte at a time.
+*****************************************************************************/
+
+#include <string.h>
+#include "espa_strscan.h"
+
+/* Characters separating the tokens; matches the whitespace set of the
+   scanf %s conversion for ASCII metadata text */
+#define ESPA_SCAN_SEPARATORS " \t\r\n\f\v"
+
+
+/******************************************************************************
+MODULE: espa_scan_token
+
+PURPOSE: Finds the next whitespace-delimited token in the text.  The token
+is returned in place, as a pointer and length into the caller's text, so
+scanning a blob makes no copies.
+
+RETURN VALUE:
+Type = const char *
+Value        Description
+-----        -----------
+NULL         No token remains; the text from the scan position on is all
+             whitespace (or empty)
+non-NULL     Scan position just past the returned token, to be passed back
+             in for the next token
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+const char *espa_scan_token
+(
+    const char *text,         /* I: scan position in NULL-terminated text */
+    const char **token,       /* O: start of the next token */
+    size_t *token_len         /* O: length of the token in bytes */
+)
+{
+    /* Skip the separators in front of the token */
+    text += strspn (text, ESPA_SCAN_SEPARATORS);
+    if (*text == '\0')
+        return (NULL);
+
+    /* The token runs to the next separator or the end of the text */
+    *token = text;
+    *token_len = strcspn (text, ESPA_SCAN_SEPARATORS);
+
+    return (text + *token_len);
+}
@@ -0,0 +1,36 @@
+/*****************************************************************************
+FILE: espa_strscan.h
+
+PURPOSE: Contains defines and prototypes for scanning whitespace-delimited
+tokens out of NULL-terminated metadata text.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The scanner leans on the C library's strspn/strcspn, which are
+     vectorized on the common platforms, so large metadata blobs are
+     scanned a register at a time instead of a byte at a time.
+*****************************************************************************/
+
+#ifndef ESPA_STRSCAN_H
+#define ESPA_STRSCAN_H
+
+#include <stddef.h>
+
+/* Prototypes */
+const char *espa_scan_token
+(
+    const char *text,         /* I: scan position in NULL-terminated text */
+    const char **token,       /* O: start of the next token */
+    size_t *token_len         /* O: length of the token in bytes */
+);
+
+#endif
@@ -0,0 +1,345 @@
+/*****************************************************************************
+FILE: espa_thread_pool.c
+
+PURPOSE: Contains functions for the shared worker thread pool used by the
+parallel loops in the libraries.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The workers are created lazily on the first parallel run and persist
+     for the life of the process, so repeated parallel stages don't pay the
+     thread creation cost again and the process never holds more threads
+     than the cap.
+  2. Items are handed out one at a time from a shared counter under the pool
+     lock, the same way the converters' ad-hoc pools handed out bands; the
+     calling thread works the items alongside the pool workers, so a run
+     with num_threads of N uses N-1 pool workers plus the caller.
+  3. A task which returns ERROR stops the handout of new items; the items
+     already being worked finish and the run returns ERROR.  Tasks report
+     their own error messages.
+  4. Setting ESPA_THREAD_AFFINITY pins the pool workers round-robin to the
+     CPUs of the node, which helps the memory-bound loops on multi-socket
+     nodes at the cost of fighting any other pinned process.
+*****************************************************************************/
+
+#define _GNU_SOURCE
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "espa_thread_pool.h"
+
+/* Pool state; every field is protected by pool_lock */
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t pool_wake = PTHREAD_COND_INITIALIZER;  /* new run */
+static pthread_cond_t pool_done = PTHREAD_COND_INITIALIZER;  /* worker left
+                                                                a run */
+static int pool_nthreads = 0;      /* number of workers created so far */
+static long pool_generation = 0;   /* bumped for every run to wake workers */
+
+/* The current run */
+static int (*run_task) (void *ctx, int item) = NULL;  /* task callback */
+static void *run_ctx = NULL;       /* shared context for the task calls */
+static int run_nitems = 0;         /* number of items in the run */
+static int run_next = 0;           /* next item to be handed out */
+static int run_nworkers = 0;       /* pool workers wanted for the run */
+static int run_joined = 0;         /* pool workers which joined the run */
+static int run_active = 0;         /* pool workers still working the run */
+static int run_status = SUCCESS;   /* overall status of the run */
+
+/* Set while the calling thread is inside a task, so a nested parallel run
+   from within a task falls back to the serial loop instead of deadlocking
+   on the pool */
+static __thread bool pool_in_task = false;
+
+/******************************************************************************
+MODULE:  espa_pool_max_threads
+
+PURPOSE:  Returns the process-wide cap on the pool worker threads: the
+ESPA_NUM_THREADS environment variable when set, otherwise the number of
+online CPUs.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+(count)         Maximum number of threads a parallel run will use
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+int espa_pool_max_threads (void)
+{
+    static int max_threads = 0;   /* cached cap; 0 until first call */
+    char *value = NULL;           /* value of the environment variable */
+
+    if (max_threads == 0)
+    {
+        value = getenv ("ESPA_NUM_THREADS");
+        if (value != NULL && atoi (value) > 0)
+            max_threads = atoi (value);
+        else
+            max_threads = (int) sysconf (_SC_NPROCESSORS_ONLN);
+        if (max_threads < 1)
+            max_threads = 1;
+        if (max_threads > ESPA_POOL_MAX_THREADS)
+            max_threads = ESPA_POOL_MAX_THREADS;
+    }
+
+    return max_threads;
+}
+
+
+/******************************************************************************
+MODULE:  espa_pool_work_items (static)
+
+PURPOSE:  Pulls items from the current run and executes the task for each,
+until the items run out or a task fails.  Called with the pool lock held;
+returns with it held.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static void espa_pool_work_items (void)
+{
+    int item;                 /* item currently being worked */
+
+    while (run_status == SUCCESS && run_next < run_nitems)
+    {
+        item = run_next++;
+        pthread_mutex_unlock (&pool_lock);
+
+        pool_in_task = true;
+        if (run_task (run_ctx, item) != SUCCESS)
+        {  /* Error messages already printed by the task */
+            pool_in_task = false;
+            pthread_mutex_lock (&pool_lock);
+            run_status = ERROR;
+            continue;
+        }
+        pool_in_task = false;
+
+        pthread_mutex_lock (&pool_lock);
+    }
+}
+
+
+/******************************************************************************
+MODULE:  espa_pool_worker (static)
+
+PURPOSE:  Persistent pool worker: waits for a run, works its items, and
+goes back to waiting.
+
+RETURN VALUE:
+Type = void *
+Value           Description
+-----           -----------
+NULL            Never returns; the workers live for the process
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static void *espa_pool_worker
+(
+    void *arg                 /* I: unused */
+)
+{
+    long seen = 0;            /* last run generation this worker saw */
+
+    (void) arg;
+    pthread_mutex_lock (&pool_lock);
+    while (true)
+    {
+        /* Wait for a run this worker hasn't seen */
+        while (pool_generation == seen)
+            pthread_cond_wait (&pool_wake, &pool_lock);
+        seen = pool_generation;
+
+        /* Join the run unless it already has the workers it asked for */
+        if (run_joined >= run_nworkers)
+            continue;
+        run_joined++;
+        run_active++;
+
+        espa_pool_work_items ();
+
+        /* Tell the caller this worker is done with the run */
+        run_active--;
+        if (run_active == 0)
+            pthread_cond_broadcast (&pool_done);
+    }
+
+    return (NULL);
+}
+
+
+/******************************************************************************
+MODULE:  espa_pool_run
+
+PURPOSE:  Processes nitems items by invoking the task callback once per
+item, spreading the calls across the calling thread and the pool workers.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           A task failed, or the pool workers could not be created
+SUCCESS         Every item was processed
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Runs are serialized: a second caller blocks until the current run
+     completes.  A nested run from within a task runs its items serially
+     on the calling thread.
+******************************************************************************/
+int espa_pool_run
+(
+    int (*task) (void *ctx, int item),  /* I: task callback, invoked once per
+                                              item; returns SUCCESS/ERROR */
+    void *ctx,             /* I: shared context passed to every task call */
+    int nitems,            /* I: number of items to be processed */
+    int num_threads        /* I: number of threads to use for this run, which
+                                 is further capped by espa_pool_max_threads;
+                                 1 or less processes the items serially */
+)
+{
+    char FUNC_NAME[] = "espa_pool_run";   /* function name */
+    char errmsg[STR_SIZE];    /* error message */
+    static pthread_mutex_t run_lock = PTHREAD_MUTEX_INITIALIZER;
+                              /* serializes the parallel runs */
+    char *affinity = NULL;    /* value of the affinity environment variable */
+    pthread_attr_t attr;      /* worker thread attributes */
+    pthread_t thread;         /* worker thread handle */
+    int nworkers;             /* pool workers wanted for this run */
+    int status;               /* overall status of the run */
+    int i;                    /* looping variable */
+#ifdef __linux__
+    cpu_set_t cpus;           /* CPU set a worker is pinned to */
+    int ncpus;                /* number of online CPUs */
+#endif
+
+    if (nitems <= 0)
+        return (SUCCESS);
+
+    /* Cap the thread count by the pool-wide knob and the work available */
+    if (num_threads > espa_pool_max_threads ())
+        num_threads = espa_pool_max_threads ();
+    if (num_threads > nitems)
+        num_threads = nitems;
+
+    /* Serial path: one thread, one item, or a nested run from inside a
+       task */
+    if (num_threads <= 1 || pool_in_task)
+    {
+        for (i = 0; i < nitems; i++)
+        {
+            if (task (ctx, i) != SUCCESS)
+            {  /* Error messages already printed by the task */
+                return (ERROR);
+            }
+        }
+        return (SUCCESS);
+    }
+
+    /* One run at a time; the caller works its items, so it can't also be
+       setting up another run */
+    pthread_mutex_lock (&run_lock);
+    pthread_mutex_lock (&pool_lock);
+
+    /* The calling thread is one of the num_threads, so the run wants
+       num_threads - 1 pool workers.  Create workers up to that count; the
+       workers persist, so most runs find them already waiting. */
+    nworkers = num_threads - 1;
+    while (pool_nthreads < nworkers)
+    {
+        pthread_attr_init (&attr);
+        pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_DETACHED);
+#ifdef __linux__
+        /* Optionally pin the workers round-robin across the CPUs */
+        affinity = getenv ("ESPA_THREAD_AFFINITY");
+        if (affinity != NULL && affinity[0] != '\0' &&
+            strcmp (affinity, "0") != 0)
+        {
+            ncpus = (int) sysconf (_SC_NPROCESSORS_ONLN);
+            if (ncpus > 0)
+            {
+                CPU_ZERO (&cpus);
+                CPU_SET (pool_nthreads % ncpus, &cpus);
+                pthread_attr_setaffinity_np (&attr, sizeof (cpus), &cpus);
+            }
+        }
+#endif
+        if (pthread_create (&thread, &attr, espa_pool_worker, NULL) != 0)
+        {
+            pthread_attr_destroy (&attr);
+            if (pool_nthreads == 0)
+            {
+                pthread_mutex_unlock (&pool_lock);
+                pthread_mutex_unlock (&run_lock);
+                sprintf (errmsg, "Creating the pool worker threads");
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
+            }
+
+            /* Run with the workers which did get created */
+            nworkers = pool_nthreads;
+            break;
+        }
+        pthread_attr_destroy (&attr);
+        pool_nthreads++;
+    }
+
+    /* Publish the run and wake the workers */
+    run_task = task;
+    run_ctx = ctx;
+    run_nitems = nitems;
+    run_next = 0;
+    run_nworkers = nworkers;
+    run_joined = 0;
+    run_active = 0;
+    run_status = SUCCESS;
+    pool_generation++;
+    pthread_cond_broadcast (&pool_wake);
+
+    /* Work the items alongside the pool workers */
+    espa_pool_work_items ();
+
+    /* Wait for the workers which joined the run to finish their items.  A
+       worker which wakes after the items are gone never joins, which is
+       fine -- the items it would have pulled are done. */
+    while (run_active > 0)
+        pthread_cond_wait (&pool_done, &pool_lock);
+    status = run_status;
+    run_task = NULL;
+
+    pthread_mutex_unlock (&pool_lock);
+    pthread_mutex_unlock (&run_lock);
+    return (status);
+}
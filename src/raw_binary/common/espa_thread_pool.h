@@ -0,0 +1,48 @@
+/*****************************************************************************
+FILE: espa_thread_pool.h
+
+PURPOSE: Contains defines and prototypes for the shared worker thread pool.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The pool replaces the per-converter thread spawning: every parallel
+     loop in the libraries hands its items to the one process-wide pool, so
+     the thread count is bounded by the single ESPA_NUM_THREADS knob no
+     matter how many parallel stages a tool runs through.
+*****************************************************************************/
+
+#ifndef ESPA_THREAD_POOL_H
+#define ESPA_THREAD_POOL_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "error_handler.h"
+
+/* Defines */
+/* upper bound on the worker threads the pool will ever create */
+#define ESPA_POOL_MAX_THREADS 64
+
+/* Prototypes */
+int espa_pool_max_threads (void);
+
+int espa_pool_run
+(
+    int (*task) (void *ctx, int item),  /* I: task callback, invoked once per
+                                              item; returns SUCCESS/ERROR */
+    void *ctx,             /* I: shared context passed to every task call */
+    int nitems,            /* I: number of items to be processed */
+    int num_threads        /* I: number of threads to use for this run, which
+                                 is further capped by espa_pool_max_threads;
+                                 1 or less processes the items serially */
+);
+
+#endif
@@ -0,0 +1,109 @@
+/*****************************************************************************
+FILE: espa_xml_init.c
+
+PURPOSE: Contains functions for the shared one-time libxml2 global
+initialization and teardown.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Mark the libxml2 setup as a startup phase for
+                              the cold-start profile
+
+NOTES:
+*****************************************************************************/
+
+#include <stdbool.h>
+#include <pthread.h>
+#include <libxml/parser.h>
+#include "espa_xml_init.h"
+#include "espa_startup.h"
+
+/* One-time guard for the libxml2 global setup */
+static pthread_once_t xml_init_once = PTHREAD_ONCE_INIT;
+
+/* Has the libxml2 global setup run?  Read at cleanup time so a process
+   which never parsed XML doesn't tear down uninitialized state */
+static bool xml_initialized = false;
+
+/******************************************************************************
+MODULE:  run_xml_init (static)
+
+PURPOSE: Runs the libxml2 global setup; called exactly once through the
+pthread_once guard.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static void run_xml_init (void)
+{
+    xmlInitParser ();
+    xmlLineNumbersDefault (1);
+    xml_initialized = true;
+    espa_startup_mark ("libxml2 init");
+}
+
+
+/******************************************************************************
+MODULE:  espa_xml_init
+
+PURPOSE: Makes sure the libxml2 global setup has run, from no matter how many
+threads at once.  Every entry point which parses or validates XML calls this
+before touching the library.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The call is cheap after the first time (a single flag check inside
+     pthread_once), so the entry points call it unconditionally.
+******************************************************************************/
+void espa_xml_init (void)
+{
+    pthread_once (&xml_init_once, run_xml_init);
+}
+
+
+/******************************************************************************
+MODULE:  espa_xml_cleanup
+
+PURPOSE: Tears down the libxml2 global state if it was set up.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Per the libxml2 documentation this should only be called once, at
+     process exit, from the main thread.  Library code never calls it;
+     tearing down mid-run would invalidate the cached schema and readers
+     the other entry points keep.
+******************************************************************************/
+void espa_xml_cleanup (void)
+{
+    if (xml_initialized)
+        xmlCleanupParser ();
+    xml_initialized = false;
+}
@@ -0,0 +1,36 @@
+/*****************************************************************************
+FILE: espa_xml_init.h
+
+PURPOSE: Contains prototypes for the shared one-time libxml2 global
+initialization and teardown.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The libxml2 global setup (xmlInitParser) is not safe to run from
+     several threads at once, and letting the library lazily initialize on
+     the first parse has the same race.  Every entry point which parses or
+     validates XML calls espa_xml_init first, which funnels the setup
+     through a pthread_once guard; the per-thread parser contexts are then
+     safe to create and use concurrently.
+  2. espa_xml_cleanup tears down the libxml2 global state and should only
+     be called once, at process exit, from the main thread.
+*****************************************************************************/
+
+#ifndef ESPA_XML_INIT_H
+#define ESPA_XML_INIT_H
+
+/* Prototypes */
+void espa_xml_init (void);
+
+void espa_xml_cleanup (void);
+
+#endif
@@ -13,6 +13,11 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 1/9/2014     Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added support for converting multiple bands
+                              concurrently via a thread pool and for writing
+                              tiled GeoTIFFs
+8/31/2026    Gail Schmidt     Added the browse reduction mode producing
+                              reduced-resolution GeoTIFFs in one pass
 
 NOTES:
   1. The XML metadata format written via this library follows the ESPA internal
@@ -22,164 +27,444 @@ NOTES:
 *****************************************************************************/
 #include <unistd.h>
 #include "convert_espa_to_gtif.h"
+#include "espa_thread_pool.h"
 
 /******************************************************************************
-MODULE:  convert_espa_to_gtif
+MODULE:  convert_gtif_band
 
-PURPOSE: Converts the internal ESPA raw binary file to GeoTIFF file format.
+PURPOSE: Converts a single band from the internal ESPA raw binary format to
+GeoTIFF, and updates the band metadata to use the new GeoTIFF band name.
 
 RETURN VALUE:
 Type = int
 Value           Description
 -----           -----------
-ERROR           Error converting to GeoTIFF
-SUCCESS         Successfully converted to GeoTIFF
+ERROR           Error converting the band to GeoTIFF
+SUCCESS         Successfully converted the band to GeoTIFF
 
 HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
-1/9/2014     Gail Schmidt     Original development
-4/2/2014     Gail Schmidt     Added support for a flag to delete the source
-                              .img and .hdr files
-4/3/2014     Gail Schmidt     Remove the .xml file as well if source files are
-                              specified to be deleted
-4/30/2014    Gail Schmidt     Remove the .tif.aux.xml files that were created
-                              by GDAL in the conversion to GeoTIFF
+8/31/2026    Gail Schmidt     Original development, pulled from the band loop
+                              in convert_espa_to_gtif
+8/31/2026    Gail Schmidt     Added compression codec and level control; the
+                              tiled output now uses a fixed tile size and
+                              parallel tile encoding
+8/31/2026    Gail Schmidt     Added cloud-optimized GeoTIFF output so the
+                              delivered product no longer needs a separate
+                              GDAL pass to add the layout and overviews
+8/31/2026    Gail Schmidt     Run the band conversions through the shared
+                              worker pool instead of ad-hoc pthreads
+8/31/2026    Gail Schmidt     Added the browse reduction factor, decimating
+                              in the translate so the full-resolution
+                              GeoTIFF is never materialized
 
 NOTES:
   1. The GDAL tools will be used for converting the raw binary (ENVI format)
      files to GeoTIFF.
-  2. An associated .tfw (ESRI world file) will be generated for each GeoTIFF
+  2. An associated .tfw (ESRI world file) will be generated for the GeoTIFF
      file.
 ******************************************************************************/
-int convert_espa_to_gtif
+static int convert_gtif_band
 (
-    char *espa_xml_file,   /* I: input ESPA XML metadata filename */
-    char *gtif_file,       /* I: base output GeoTIFF filename */
-    bool del_src           /* I: should the source files be removed after
-                                 conversion? */
+    Espa_band_meta_t *bmeta,   /* I/O: band metadata; the file name is updated
+                                    to the new GeoTIFF band name */
+    char *gtif_file,           /* I: base output GeoTIFF filename */
+    bool del_src,              /* I: should the source files be removed after
+                                    conversion? */
+    bool tiled,                /* I: should the GeoTIFF be written tiled
+                                    instead of stripped? */
+    bool cog,                  /* I: should a cloud-optimized GeoTIFF be
+                                    written instead? */
+    char *compress,            /* I: compression codec ("deflate" or "lzw");
+                                    NULL for uncompressed output */
+    int compress_level,        /* I: deflate compression level (1-9) */
+    int browse_factor          /* I: browse reduction factor; every output
+                                    dimension is 1/factor of the band, 1 for
+                                    full resolution */
 )
 {
-    char FUNC_NAME[] = "convert_espa_to_gtif";  /* function name */
+    char FUNC_NAME[] = "convert_gtif_band";  /* function name */
     char errmsg[STR_SIZE];      /* error message */
     char gdal_cmd[STR_SIZE];    /* command string for GDAL call */
+    char co_opts[STR_SIZE];     /* creation options for the GDAL call */
     char gtif_band[STR_SIZE];   /* name of the GeoTIFF file for this band */
+    char browse_opts[STR_SIZE]; /* browse reduction options for the GDAL
+                                   call */
     char hdr_file[STR_SIZE];    /* name of the header file for this band */
-    char xml_file[STR_SIZE];    /* new XML file for the GeoTIFF product */
     char tmpfile[STR_SIZE];     /* filename of file.tif.aux.xml */
     char *cptr = NULL;          /* pointer to empty space in the band name */
-    int i;                      /* looping variable for each band */
     int count;                  /* number of chars copied in snprintf */
-    Espa_internal_meta_t xml_metadata;  /* XML metadata structure to be
-                                   populated by reading the XML metadata file */
 
-    /* Validate the input metadata file */
-    if (validate_xml_file (espa_xml_file) != SUCCESS)
-    {  /* Error messages already written */
+    /* Determine the output GeoTIFF band name */
+    count = snprintf (gtif_band, sizeof (gtif_band), "%s_%s.tif",
+        gtif_file, bmeta->name);
+    if (count < 0 || count >= sizeof (gtif_band))
+    {
+        sprintf (errmsg, "Overflow of gtif_file string");
+        error_handler (true, FUNC_NAME, errmsg);
         return (ERROR);
     }
 
-    /* Initialize the metadata structure */
-    init_metadata_struct (&xml_metadata);
+    /* Loop through this filename and replace any occurances of blank
+       spaces with underscores */
+    while ((cptr = strchr (gtif_band, ' ')) != NULL)
+        *cptr = '_';
 
-    /* Parse the metadata file into our internal metadata structure; also
-       allocates space as needed for various pointers in the global and band
-       metadata */
-    if (parse_metadata (espa_xml_file, &xml_metadata) != SUCCESS)
-    {  /* Error messages already written */
+    /* Build the creation options.  Cloud-optimized output goes through the
+       COG driver, which lays the file out header-first with a fixed tile
+       size and internal overviews reduced with the fast average kernel, so
+       the product is cloud-ready in the single write.  Plain tiled output
+       uses the same fixed tile size so windowed consumers read single
+       tiles.  Either way GDAL encodes the tiles of the file on all the
+       processors, and compressed output adds the codec, the horizontal
+       differencing predictor (which helps both codecs on imagery), and the
+       deflate level. */
+    count = 0;
+    co_opts[0] = '\0';
+    if (cog)
+    {
+        count = snprintf (co_opts, sizeof (co_opts),
+            "-co \"BLOCKSIZE=%d\" -co \"OVERVIEW_RESAMPLING=AVERAGE\" "
+            "-co \"NUM_THREADS=ALL_CPUS\" ", GTIF_TILE_SIZE);
+    }
+    else if (tiled)
+    {
+        count = snprintf (co_opts, sizeof (co_opts),
+            "-co \"TILED=YES\" -co \"BLOCKXSIZE=%d\" -co \"BLOCKYSIZE=%d\" "
+            "-co \"NUM_THREADS=ALL_CPUS\" ", GTIF_TILE_SIZE, GTIF_TILE_SIZE);
+    }
+    if (compress != NULL && count >= 0 && count < sizeof (co_opts))
+    {
+        if (!strcmp (compress, "deflate"))
+        {
+            if (cog)
+            {
+                count += snprintf (&co_opts[count], sizeof (co_opts) - count,
+                    "-co \"COMPRESS=DEFLATE\" -co \"LEVEL=%d\" "
+                    "-co \"PREDICTOR=YES\" ", compress_level);
+            }
+            else
+            {
+                count += snprintf (&co_opts[count], sizeof (co_opts) - count,
+                    "-co \"COMPRESS=DEFLATE\" -co \"ZLEVEL=%d\" "
+                    "-co \"PREDICTOR=2\" ", compress_level);
+            }
+        }
+        else if (!strcmp (compress, "lzw"))
+        {
+            if (cog)
+            {
+                count += snprintf (&co_opts[count], sizeof (co_opts) - count,
+                    "-co \"COMPRESS=LZW\" -co \"PREDICTOR=YES\" ");
+            }
+            else
+            {
+                count += snprintf (&co_opts[count], sizeof (co_opts) - count,
+                    "-co \"COMPRESS=LZW\" -co \"PREDICTOR=2\" ");
+            }
+        }
+        else
+        {
+            sprintf (errmsg, "Unsupported compression codec: %s", compress);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+    }
+    if (count < 0 || count >= sizeof (co_opts))
+    {
+        sprintf (errmsg, "Overflow of co_opts string");
+        error_handler (true, FUNC_NAME, errmsg);
         return (ERROR);
     }
 
-    /* Loop through the bands in the XML file and convert them to GeoTIFF.
-       The filenames will have the GeoTIFF base name followed by _ and the
-       band name of each band in the XML file.  Blank spaced in the band name
-       will be replaced with underscores. */
-    for (i = 0; i < xml_metadata.nbands; i++)
+    /* Reduce to browse resolution in the translate itself, which streams
+       the band through the average kernel at the reduced size, so the
+       full-resolution GeoTIFF is never materialized */
+    browse_opts[0] = '\0';
+    if (browse_factor > 1)
     {
-        /* Determine the output GeoTIFF band name */
-        count = snprintf (gtif_band, sizeof (gtif_band), "%s_%s.tif",
-            gtif_file, xml_metadata.band[i].name);
-        if (count < 0 || count >= sizeof (gtif_band))
+        count = snprintf (browse_opts, sizeof (browse_opts),
+            "-outsize %.6f%% %.6f%% -r average ",
+            100.0 / browse_factor, 100.0 / browse_factor);
+        if (count < 0 || count >= sizeof (browse_opts))
         {
-            sprintf (errmsg, "Overflow of gtif_file string");
+            sprintf (errmsg, "Overflow of browse_opts string");
             error_handler (true, FUNC_NAME, errmsg);
             return (ERROR);
         }
+    }
+
+    /* Convert the files.  The COG driver carries the georeferencing
+       internally and doesn't take the world file option, so the .tfw
+       sidecar is only written for the plain GeoTIFF output. */
+    printf ("Converting %s to %s\n", bmeta->file_name, gtif_band);
+    count = snprintf (gdal_cmd, sizeof (gdal_cmd),
+        "gdal_translate -of %s -a_nodata %ld %s%s%s-q %s %s",
+        cog ? "COG" : "Gtiff", bmeta->fill_value, co_opts, browse_opts,
+        cog ? "" : "-co \"TFW=YES\" ", bmeta->file_name, gtif_band);
+    if (count < 0 || count >= sizeof (gdal_cmd))
+    {
+        sprintf (errmsg, "Overflow of gdal_cmd string");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    if (system (gdal_cmd) == -1)
+    {
+        sprintf (errmsg, "Running gdal_translate: %s", gdal_cmd);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
 
-        /* Loop through this filename and replace any occurances of blank
-           spaces with underscores */
-        while ((cptr = strchr (gtif_band, ' ')) != NULL)
-            *cptr = '_';
-
-        /* Convert the files */
-        printf ("Converting %s to %s\n", xml_metadata.band[i].file_name,
-            gtif_band);
-        count = snprintf (gdal_cmd, sizeof (gdal_cmd),
-            "gdal_translate -of Gtiff -a_nodata %ld -co \"TFW=YES\" -q %s %s",
-            xml_metadata.band[i].fill_value, xml_metadata.band[i].file_name,
-            gtif_band);
-        if (count < 0 || count >= sizeof (gdal_cmd))
+    /* Remove the {gtif_name}.tif.aux.xml file since it's not needed and
+       clutters the results.  Don't worry about testing the unlink
+       results.  If it doesn't unlink it's not fatal. */
+    count = snprintf (tmpfile, sizeof (tmpfile), "%s.aux.xml", gtif_band);
+    if (count < 0 || count >= sizeof (tmpfile))
+    {
+        sprintf (errmsg, "Overflow of tmpfile string");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+    unlink (tmpfile);
+
+    /* Remove the source file if specified */
+    if (del_src)
+    {
+        /* .img file */
+        printf ("  Removing %s\n", bmeta->file_name);
+        if (unlink (bmeta->file_name) != 0)
         {
-            sprintf (errmsg, "Overflow of gdal_cmd string");
+            sprintf (errmsg, "Deleting source file: %s", bmeta->file_name);
             error_handler (true, FUNC_NAME, errmsg);
             return (ERROR);
         }
 
-        if (system (gdal_cmd) == -1)
+        /* .hdr file */
+        count = snprintf (hdr_file, sizeof (hdr_file), "%s",
+            bmeta->file_name);
+        if (count < 0 || count >= sizeof (hdr_file))
         {
-            sprintf (errmsg, "Running gdal_translate: %s", gdal_cmd);
+            sprintf (errmsg, "Overflow of hdr_file string");
             error_handler (true, FUNC_NAME, errmsg);
             return (ERROR);
         }
 
-        /* Remove the {gtif_name}.tif.aux.xml file since it's not needed and
-           clutters the results.  Don't worry about testing the unlink
-           results.  If it doesn't unlink it's not fatal. */
-        count = snprintf (tmpfile, sizeof (tmpfile), "%s.aux.xml", gtif_band);
-        if (count < 0 || count >= sizeof (tmpfile))
+        cptr = strrchr (hdr_file, '.');
+        strcpy (cptr, ".hdr");
+        printf ("  Removing %s\n", hdr_file);
+        if (unlink (hdr_file) != 0)
         {
-            sprintf (errmsg, "Overflow of tmpfile string");
+            sprintf (errmsg, "Deleting source file: %s", hdr_file);
             error_handler (true, FUNC_NAME, errmsg);
             return (ERROR);
         }
-        unlink (tmpfile);
+    }
 
-        /* Remove the source file if specified */
-        if (del_src)
-        {
-            /* .img file */
-            printf ("  Removing %s\n", xml_metadata.band[i].file_name);
-            if (unlink (xml_metadata.band[i].file_name) != 0)
-            {
-                sprintf (errmsg, "Deleting source file: %s",
-                    xml_metadata.band[i].file_name);
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
+    /* Update the band metadata to use the new GeoTIFF band name */
+    strcpy (bmeta->file_name, gtif_band);
 
-            /* .hdr file */
-            count = snprintf (hdr_file, sizeof (hdr_file), "%s",
-                xml_metadata.band[i].file_name);
-            if (count < 0 || count >= sizeof (hdr_file))
-            {
-                sprintf (errmsg, "Overflow of hdr_file string");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
+    /* Update the band dimensions and pixel size for the reduced product,
+       matching the rounding gdal_translate applies to the output size */
+    if (browse_factor > 1)
+    {
+        bmeta->nlines = (int) ((double) bmeta->nlines / browse_factor + 0.5);
+        bmeta->nsamps = (int) ((double) bmeta->nsamps / browse_factor + 0.5);
+        bmeta->pixel_size[0] *= browse_factor;
+        bmeta->pixel_size[1] *= browse_factor;
+    }
 
-            cptr = strrchr (hdr_file, '.');
-            strcpy (cptr, ".hdr");
-            printf ("  Removing %s\n", hdr_file);
-            if (unlink (hdr_file) != 0)
-            {
-                sprintf (errmsg, "Deleting source file: %s", hdr_file);
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-        }
+    /* Successful conversion */
+    return (SUCCESS);
+}
+
+
+/* Shared context for the band conversion tasks run through the worker
+   pool */
+typedef struct
+{
+    Espa_internal_meta_t *xml_metadata;  /* XML metadata for the bands */
+    char *gtif_file;          /* base output GeoTIFF filename */
+    bool del_src;             /* should the source files be removed? */
+    bool tiled;               /* should the GeoTIFFs be written tiled? */
+    bool cog;                 /* should cloud-optimized GeoTIFFs be written? */
+    char *compress;           /* compression codec; NULL for uncompressed */
+    int compress_level;       /* deflate compression level (1-9) */
+    int browse_factor;        /* browse reduction factor; 1 for full
+                                 resolution */
+} Gtif_band_pool_t;
+
+
+/******************************************************************************
+MODULE:  convert_gtif_band_task
+
+PURPOSE: Pool task which converts one ESPA raw binary band to GeoTIFF.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error converting the band
+SUCCESS         Band was converted
 
-        /* Update the XML file to use the new GeoTIFF band name */
-        strcpy (xml_metadata.band[i].file_name, gtif_band);
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Reworked from a self-contained pthread worker
+                              into a task for the shared worker pool
+
+NOTES:
+  1. Each band is converted by its own gdal_translate process writing to its
+     own output file, so the per-band conversions are independent.
+******************************************************************************/
+static int convert_gtif_band_task
+(
+    void *ctx,                /* I: pointer to the Gtif_band_pool_t context */
+    int i                     /* I: band index to be converted */
+)
+{
+    char FUNC_NAME[] = "convert_gtif_band_task";  /* function name */
+    char errmsg[STR_SIZE];    /* error message */
+    Gtif_band_pool_t *pool = ctx;  /* shared band conversion context */
+
+    if (convert_gtif_band (&pool->xml_metadata->band[i], pool->gtif_file,
+        pool->del_src, pool->tiled, pool->cog, pool->compress,
+        pool->compress_level, pool->browse_factor) != SUCCESS)
+    {
+        sprintf (errmsg, "Converting band %d: %.1024s", i,
+            pool->xml_metadata->band[i].name);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  convert_espa_to_gtif_meta (static function)
+
+PURPOSE: Converts the internal ESPA raw binary file to GeoTIFF file format,
+working from metadata the caller has already parsed.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error converting to GeoTIFF
+SUCCESS         Successfully converted to GeoTIFF
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+1/9/2014     Gail Schmidt     Original development
+4/2/2014     Gail Schmidt     Added support for a flag to delete the source
+                              .img and .hdr files
+4/3/2014     Gail Schmidt     Remove the .xml file as well if source files are
+                              specified to be deleted
+4/30/2014    Gail Schmidt     Remove the .tif.aux.xml files that were created
+                              by GDAL in the conversion to GeoTIFF
+8/31/2026    Gail Schmidt     Added support for converting multiple bands
+                              concurrently via a thread pool and for writing
+                              tiled GeoTIFFs
+8/31/2026    Gail Schmidt     Added compression codec and level control; the
+                              tiled output now uses a fixed tile size and
+                              parallel tile encoding
+8/31/2026    Gail Schmidt     Added cloud-optimized GeoTIFF output so the
+                              delivered product no longer needs a separate
+                              GDAL pass to add the layout and overviews
+8/31/2026    Gail Schmidt     Run the band conversions through the shared
+                              worker pool instead of ad-hoc pthreads
+8/31/2026    Gail Schmidt     Pulled the conversion out of convert_espa_to_gtif
+                              to work from metadata the caller already parsed
+8/31/2026    Gail Schmidt     Filter the bands before conversion so the
+                              unwanted bands are never read
+8/31/2026    Gail Schmidt     Added the browse reduction factor
+
+NOTES:
+  1. The GDAL tools will be used for converting the raw binary (ENVI format)
+     files to GeoTIFF.
+  2. An associated .tfw (ESRI world file) will be generated for each GeoTIFF
+     file.
+  3. Each band conversion writes an independent GeoTIFF via its own
+     gdal_translate process, so the bands can be converted concurrently.
+     Specifying num_threads of 1 (or less) retains the original serial
+     behavior.
+******************************************************************************/
+static int convert_espa_to_gtif_meta
+(
+    Espa_internal_meta_t *xml_metadata,  /* I/O: parsed metadata for the
+                                 scene; the band filenames are updated for
+                                 the GeoTIFF product */
+    char *espa_xml_file,   /* I: input ESPA XML metadata filename */
+    char *gtif_file,       /* I: base output GeoTIFF filename */
+    char *band_filter,     /* I: comma-separated band filter (band names,
+                                 product:<type>, category:<cat> entries);
+                                 NULL or empty converts every band */
+    bool del_src,          /* I: should the source files be removed after
+                                 conversion? */
+    bool tiled,            /* I: should the GeoTIFFs be written tiled instead
+                                 of stripped for faster windowed reads? */
+    bool cog,              /* I: should cloud-optimized GeoTIFFs (tiled,
+                                 header-first layout, internal average-reduced
+                                 overviews) be written instead? */
+    char *compress,        /* I: GeoTIFF compression codec ("deflate" or
+                                 "lzw"); NULL for uncompressed output */
+    int compress_level,    /* I: deflate compression level (1-9); ignored
+                                 for the other codecs */
+    int browse_factor,     /* I: browse reduction factor; every output
+                                 dimension is 1/factor of the source band,
+                                 1 for full resolution */
+    int num_threads        /* I: number of threads to use for converting the
+                                 bands; 1 or less converts serially */
+)
+{
+    char FUNC_NAME[] = "convert_espa_to_gtif_meta";  /* function name */
+    char errmsg[STR_SIZE];      /* error message */
+    char xml_file[STR_SIZE];    /* new XML file for the GeoTIFF product */
+    int count;                  /* number of chars copied in snprintf */
+    Gtif_band_pool_t pool;      /* shared context for the band conversion
+                                   tasks */
+
+    /* Validate the browse reduction factor */
+    if (browse_factor < 1)
+    {
+        sprintf (errmsg, "Browse reduction factor must be 1 or greater: %d",
+            browse_factor);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Prune the bands which don't match the filter so their data is never
+       read; an empty filter keeps every band */
+    if (prune_metadata_bands (xml_metadata, band_filter) != SUCCESS)
+    {
+        sprintf (errmsg, "Filtering the bands for the GeoTIFF product");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Convert the bands in the XML file to GeoTIFF across the shared worker
+       pool; a num_threads of 1 (or less) converts serially.  The filenames
+       will have the GeoTIFF base name followed by _ and the band name of
+       each band in the XML file.  Blank spaces in the band name will be
+       replaced with underscores. */
+    pool.xml_metadata = xml_metadata;
+    pool.gtif_file = gtif_file;
+    pool.del_src = del_src;
+    pool.tiled = tiled;
+    pool.cog = cog;
+    pool.compress = compress;
+    pool.compress_level = compress_level;
+    pool.browse_factor = browse_factor;
+    if (espa_pool_run (convert_gtif_band_task, &pool, xml_metadata->nbands,
+        num_threads) != SUCCESS)
+    {
+        sprintf (errmsg, "Converting the bands to GeoTIFF");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
     }
 
     /* Remove the source XML if specified */
@@ -204,7 +489,7 @@ int convert_espa_to_gtif
     }
 
     /* Write the new XML file containing the GeoTIFF band names */
-    if (write_metadata (&xml_metadata, xml_file) != SUCCESS)
+    if (write_metadata (xml_metadata, xml_file) != SUCCESS)
     {
         sprintf (errmsg, "Error writing updated XML for the GeoTIFF product: "
             "%s", xml_file);
@@ -212,10 +497,176 @@ int convert_espa_to_gtif
         return (ERROR);
     }
 
-    /* Free the metadata structure */
-    free_metadata (&xml_metadata);
-
     /* Successful conversion */
     return (SUCCESS);
 }
 
+
+/******************************************************************************
+MODULE:  convert_espa_to_gtif_scene
+
+PURPOSE: Converts the internal ESPA raw binary file to GeoTIFF file format,
+reusing the metadata cached in the scene context by an earlier stage.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error converting to GeoTIFF
+SUCCESS         Successfully converted to GeoTIFF
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Wait on any write-behind from the previous stage
+                              before reading or removing the scene files
+8/31/2026    Gail Schmidt     Added the band filter pass-through
+8/31/2026    Gail Schmidt     Added the browse reduction factor
+
+NOTES:
+  1. This stage modifies the band filenames in the metadata for the GeoTIFF
+     product, so the cached metadata is invalidated when it finishes.
+******************************************************************************/
+int convert_espa_to_gtif_scene
+(
+    Espa_scene_context_t *context,  /* I/O: scene context holding the cached
+                                 scene metadata */
+    char *espa_xml_file,   /* I: input ESPA XML metadata filename */
+    char *gtif_file,       /* I: base output GeoTIFF filename */
+    char *band_filter,     /* I: comma-separated band filter (band names,
+                                 product:<type>, category:<cat> entries);
+                                 NULL or empty converts every band */
+    bool del_src,          /* I: should the source files be removed after
+                                 conversion? */
+    bool tiled,            /* I: should the GeoTIFFs be written tiled instead
+                                 of stripped for faster windowed reads? */
+    bool cog,              /* I: should cloud-optimized GeoTIFFs (tiled,
+                                 header-first layout, internal average-reduced
+                                 overviews) be written instead? */
+    char *compress,        /* I: GeoTIFF compression codec ("deflate" or
+                                 "lzw"); NULL for uncompressed output */
+    int compress_level,    /* I: deflate compression level (1-9); ignored
+                                 for the other codecs */
+    int browse_factor,     /* I: browse reduction factor; every output
+                                 dimension is 1/factor of the source band,
+                                 1 for full resolution */
+    int num_threads        /* I: number of threads to use for converting the
+                                 bands; 1 or less converts serially */
+)
+{
+    char FUNC_NAME[] = "convert_espa_to_gtif_scene";  /* function name */
+    char errmsg[STR_SIZE];      /* error message */
+    int status;                 /* status of the conversion */
+
+    /* Complete any metadata/header write-behind queued by the previous
+       stage before this stage reads the scene files back or removes them */
+    if (wait_scene_context_writes (context) != SUCCESS)
+    {
+        sprintf (errmsg, "Completing the queued writes for the scene");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Make sure the context holds this scene's metadata; the parse is
+       skipped when an earlier stage left it cached */
+    if (load_scene_context_metadata (context, espa_xml_file) != SUCCESS)
+    {
+        sprintf (errmsg, "Loading the scene metadata from: %s",
+            espa_xml_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    status = convert_espa_to_gtif_meta (&context->xml_metadata,
+        espa_xml_file, gtif_file, band_filter, del_src, tiled, cog,
+        compress, compress_level, browse_factor, num_threads);
+
+    /* The band filenames in the metadata were rewritten for the GeoTIFF
+       product, so release the cached copy */
+    invalidate_scene_context_metadata (context);
+
+    return (status);
+}
+
+
+/******************************************************************************
+MODULE:  convert_espa_to_gtif
+
+PURPOSE: Converts the internal ESPA raw binary file to GeoTIFF file format,
+without a scene context.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error converting to GeoTIFF
+SUCCESS         Successfully converted to GeoTIFF
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development, pulled from the previous
+                              convert_espa_to_gtif when the scene context
+                              variant was added
+8/31/2026    Gail Schmidt     Added the band filter pass-through
+8/31/2026    Gail Schmidt     Added the browse reduction factor
+
+NOTES:
+******************************************************************************/
+int convert_espa_to_gtif
+(
+    char *espa_xml_file,   /* I: input ESPA XML metadata filename */
+    char *gtif_file,       /* I: base output GeoTIFF filename */
+    char *band_filter,     /* I: comma-separated band filter (band names,
+                                 product:<type>, category:<cat> entries);
+                                 NULL or empty converts every band */
+    bool del_src,          /* I: should the source files be removed after
+                                 conversion? */
+    bool tiled,            /* I: should the GeoTIFFs be written tiled instead
+                                 of stripped for faster windowed reads? */
+    bool cog,              /* I: should cloud-optimized GeoTIFFs (tiled,
+                                 header-first layout, internal average-reduced
+                                 overviews) be written instead? */
+    char *compress,        /* I: GeoTIFF compression codec ("deflate" or
+                                 "lzw"); NULL for uncompressed output */
+    int compress_level,    /* I: deflate compression level (1-9); ignored
+                                 for the other codecs */
+    int browse_factor,     /* I: browse reduction factor; every output
+                                 dimension is 1/factor of the source band,
+                                 1 for full resolution */
+    int num_threads        /* I: number of threads to use for converting the
+                                 bands; 1 or less converts serially */
+)
+{
+    int status;                 /* status of the conversion */
+    Espa_internal_meta_t xml_metadata;  /* XML metadata structure to be
+                                   populated by reading the XML metadata file */
+
+    /* Validate the input metadata file */
+    if (validate_xml_file (espa_xml_file) != SUCCESS)
+    {  /* Error messages already written */
+        return (ERROR);
+    }
+
+    /* Initialize the metadata structure */
+    init_metadata_struct (&xml_metadata);
+
+    /* Parse the metadata file into our internal metadata structure; also
+       allocates space as needed for various pointers in the global and band
+       metadata */
+    if (parse_metadata (espa_xml_file, &xml_metadata) != SUCCESS)
+    {  /* Error messages already written */
+        return (ERROR);
+    }
+
+    /* Convert the scene to GeoTIFF */
+    status = convert_espa_to_gtif_meta (&xml_metadata, espa_xml_file,
+        gtif_file, band_filter, del_src, tiled, cog, compress,
+        compress_level, browse_factor, num_threads);
+
+    /* Free the metadata structure */
+    free_metadata (&xml_metadata);
+
+    return (status);
+}
@@ -13,6 +13,15 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 1/9/2014     Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added tiled and num_threads to the conversion
+                              prototype to support tiled output and concurrent
+                              band conversion
+8/31/2026    Gail Schmidt     Added compression codec and level control and a
+                              fixed tile size for the tiled output
+8/31/2026    Gail Schmidt     Added cloud-optimized GeoTIFF output with
+                              internal pyramid overviews
+8/31/2026    Gail Schmidt     Added the band filter pass-through
+8/31/2026    Gail Schmidt     Added the browse reduction factor
 
 NOTES:
 *****************************************************************************/
@@ -27,16 +36,65 @@ NOTES:
 #include "espa_metadata.h"
 #include "parse_metadata.h"
 #include "write_metadata.h"
+#include "espa_scene_context.h"
+#include "subset_metadata.h"
 
 /* Defines */
+/* tile size for tiled GeoTIFF output; windowed consumers then read single
+   tiles instead of whole strips */
+#define GTIF_TILE_SIZE 256
 
 /* Prototypes */
+int convert_espa_to_gtif_scene
+(
+    Espa_scene_context_t *context,  /* I/O: scene context holding the cached
+                                 scene metadata */
+    char *espa_xml_file,   /* I: input ESPA XML metadata filename */
+    char *gtif_file,       /* I: base output GeoTIFF filename */
+    char *band_filter,     /* I: comma-separated band filter (band names,
+                                 product:<type>, category:<cat> entries);
+                                 NULL or empty converts every band */
+    bool del_src,          /* I: should the source files be removed after
+                                 conversion? */
+    bool tiled,            /* I: should the GeoTIFFs be written tiled instead
+                                 of stripped for faster windowed reads? */
+    bool cog,              /* I: should cloud-optimized GeoTIFFs (tiled,
+                                 header-first layout, internal average-reduced
+                                 overviews) be written instead? */
+    char *compress,        /* I: GeoTIFF compression codec ("deflate" or
+                                 "lzw"); NULL for uncompressed output */
+    int compress_level,    /* I: deflate compression level (1-9); ignored
+                                 for the other codecs */
+    int browse_factor,     /* I: browse reduction factor; every output
+                                 dimension is 1/factor of the source band,
+                                 1 for full resolution */
+    int num_threads        /* I: number of threads to use for converting the
+                                 bands; 1 or less converts serially */
+);
+
 int convert_espa_to_gtif
 (
     char *espa_xml_file,   /* I: input ESPA XML metadata filename */
     char *gtif_file,       /* I: base output GeoTIFF filename */
-    bool del_src           /* I: should the source files be removed after
+    char *band_filter,     /* I: comma-separated band filter (band names,
+                                 product:<type>, category:<cat> entries);
+                                 NULL or empty converts every band */
+    bool del_src,          /* I: should the source files be removed after
                                  conversion? */
+    bool tiled,            /* I: should the GeoTIFFs be written tiled instead
+                                 of stripped for faster windowed reads? */
+    bool cog,              /* I: should cloud-optimized GeoTIFFs (tiled,
+                                 header-first layout, internal average-reduced
+                                 overviews) be written instead? */
+    char *compress,        /* I: GeoTIFF compression codec ("deflate" or
+                                 "lzw"); NULL for uncompressed output */
+    int compress_level,    /* I: deflate compression level (1-9); ignored
+                                 for the other codecs */
+    int browse_factor,     /* I: browse reduction factor; every output
+                                 dimension is 1/factor of the source band,
+                                 1 for full resolution */
+    int num_threads        /* I: number of threads to use for converting the
+                                 bands; 1 or less converts serially */
 );
 
 #endif
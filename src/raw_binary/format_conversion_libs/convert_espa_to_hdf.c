@@ -14,6 +14,10 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 1/6/2014     Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Size the product through the compact band
+                              descriptors
+8/31/2026    Gail Schmidt     Added the windowed two-pass conversion mode
+                              (set ESPA_HDF_READ_WINDOW)
 
 NOTES:
   1. The XML metadata format written via this library follows the ESPA internal
@@ -24,6 +28,7 @@ NOTES:
 
 #include <unistd.h>
 #include <math.h>
+#include <pthread.h>
 #include "HE2_config.h"
 #include "convert_espa_to_hdf.h"
 
@@ -339,6 +344,122 @@ int write_global_attributes
     return (SUCCESS);
 }
 
+/******************************************************************************
+MODULE:  assemble_sds_descriptions
+
+PURPOSE: Assemble the bitmap and class description strings for a band, to be
+written as SDS attributes.  If the band doesn't have bitmap or class
+descriptions, then the associated string is left empty.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error assembling the description strings
+SUCCESS         Successfully assembled the description strings
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development, pulled from
+                              write_sds_attributes so the strings can be
+                              assembled ahead of the HDF writes
+
+NOTES:
+  1. This function doesn't touch the HDF file, so it is safe to call from
+     multiple threads for different bands.
+******************************************************************************/
+int assemble_sds_descriptions
+(
+    Espa_band_meta_t *bmeta,          /* I: pointer to band metadata struct */
+    Espa_sds_attr_text_t *attr_text   /* O: assembled description strings */
+)
+{
+    char FUNC_NAME[] = "assemble_sds_descriptions";  /* function name */
+    char errmsg[STR_SIZE];      /* error message */
+    char tmp_msg[STR_SIZE];     /* temporary message */
+    char *message = NULL;       /* description string being assembled */
+    int i;                      /* looping variable for bits/classes */
+    int count;                  /* number of chars copied in snprintf */
+
+    /* Assemble the bitmap description if the band has one */
+    attr_text->bitmap_msg[0] = '\0';
+    if (bmeta->nbits != ESPA_INT_META_FILL && bmeta->nbits > 0)
+    {
+        message = attr_text->bitmap_msg;
+        count = snprintf (message, ESPA_SDS_DESC_SIZE,
+            "\n\tBits are numbered from right to left "
+            "(bit 0 = LSB, bit N = MSB):\n"
+            "\tBit    Description\n");
+        if (count < 0 || count >= ESPA_SDS_DESC_SIZE)
+        {
+            sprintf (errmsg, "Overflow of bitmap_msg string");
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+
+        for (i = 0; i < bmeta->nbits; i++)
+        {
+            count = snprintf (tmp_msg, sizeof (tmp_msg), "\t%d      %s\n", i,
+                bmeta->bitmap_description[i]);
+            if (count < 0 || count >= sizeof (tmp_msg))
+            {
+                sprintf (errmsg, "Overflow of tmp_msg string");
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
+            }
+
+            if (strlen (message) + strlen (tmp_msg) >= ESPA_SDS_DESC_SIZE)
+            {
+                sprintf (errmsg, "Overflow of bitmap_msg string");
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
+            }
+            strcat (message, tmp_msg);
+        }
+    }
+
+    /* Assemble the class description if the band has one */
+    attr_text->class_msg[0] = '\0';
+    if (bmeta->nclass != ESPA_INT_META_FILL && bmeta->nclass > 0)
+    {
+        message = attr_text->class_msg;
+        count = snprintf (message, ESPA_SDS_DESC_SIZE,
+            "\n\tClass  Description\n");
+        if (count < 0 || count >= ESPA_SDS_DESC_SIZE)
+        {
+            sprintf (errmsg, "Overflow of class_msg string");
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+
+        for (i = 0; i < bmeta->nclass; i++)
+        {
+            count = snprintf (tmp_msg, sizeof (tmp_msg), "\t%d      %s\n",
+                bmeta->class_values[i].class,
+                bmeta->class_values[i].description);
+            if (count < 0 || count >= sizeof (tmp_msg))
+            {
+                sprintf (errmsg, "Overflow of tmp_msg string");
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
+            }
+
+            if (strlen (message) + strlen (tmp_msg) >= ESPA_SDS_DESC_SIZE)
+            {
+                sprintf (errmsg, "Overflow of class_msg string");
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
+            }
+            strcat (message, tmp_msg);
+        }
+    }
+
+    /* Successful assembly */
+    return (SUCCESS);
+}
+
+
 /******************************************************************************
 MODULE:  write_sds_attributes
 
@@ -359,44 +480,62 @@ Date         Programmer       Reason
 3/21/2014    Gail Schmidt     Added the application version for band attributes
 1/15/2015    Gail Schmidt     Check the fill value to see if it is META_FILL
                               before writing
+8/31/2026    Gail Schmidt     Take the bitmap/class description strings as
+                              preassembled input so they can be built for all
+                              the bands ahead of the HDF writes
+8/31/2026    Gail Schmidt     Queue the attributes into a batch and write them
+                              in one back-to-back pass per SDS
 
 NOTES:
 ******************************************************************************/
 int write_sds_attributes
 (
     int32 sds_id,             /* I: SDS ID to write attributes */
-    Espa_band_meta_t *bmeta   /* I: pointer to band metadata structure */
+    Espa_band_meta_t *bmeta,  /* I: pointer to band metadata structure */
+    Espa_sds_attr_text_t *attr_text  /* I: preassembled description strings
+                                           for this band, or NULL to have
+                                           them assembled here */
 )
 {
     char FUNC_NAME[] = "write_sds_attributes";  /* function name */
     char errmsg[STR_SIZE];      /* error message */
-    char tmp_msg[STR_SIZE];     /* temporary message */
-    char message[5000];         /* description of QA bits or classes */
-    int i;                      /* looping variable for each SDS */
-    int count;                  /* number of chars copied in snprintf */
     double dval[MAX_TOTAL_BANDS];/* attribute values to be written */
-    Espa_hdf_attr_t attr;       /* attribute fields */
+    Espa_sds_attr_text_t local_text;  /* description strings assembled here
+                                         when none were passed in */
+    Espa_hdf_attr_batch_t batch;  /* attributes queued for the SDS */
 
-    /* Write the band-related attributes to the SDS.  Some are required and
-       others are optional.  If the optional fields are not defined, then
-       they won't be written. */
-    attr.type = DFNT_CHAR8;
-    attr.nval = strlen (bmeta->long_name);
-    attr.name = OUTPUT_LONG_NAME;
-    if (put_attr_string (sds_id, &attr, bmeta->long_name) != SUCCESS)
+    /* Assemble the description strings if the caller didn't */
+    if (attr_text == NULL)
+    {
+        if (assemble_sds_descriptions (bmeta, &local_text) != SUCCESS)
+        {
+            sprintf (errmsg, "Assembling description strings for SDS: %.1024s",
+                bmeta->name);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+        attr_text = &local_text;
+    }
+
+    /* Queue the band-related attributes for the SDS.  Some are required
+       and others are optional.  If the optional fields are not defined,
+       then they won't be written.  The queued attributes are written in
+       one back-to-back pass at the end so the HDF metadata operations for
+       the SDS are issued together. */
+    init_attr_batch (&batch);
+    if (add_attr_batch_string (&batch, OUTPUT_LONG_NAME, bmeta->long_name)
+        != SUCCESS)
     {
-        sprintf (errmsg, "Writing attribute (long name) to SDS: %s",
+        sprintf (errmsg, "Queueing attribute (long name) for SDS: %s",
             bmeta->name);
         error_handler (true, FUNC_NAME, errmsg);
         return (ERROR);
     }
 
-    attr.type = DFNT_CHAR8;
-    attr.nval = strlen (bmeta->data_units);
-    attr.name = OUTPUT_UNITS;
-    if (put_attr_string (sds_id, &attr, bmeta->data_units) != SUCCESS)
+    if (add_attr_batch_string (&batch, OUTPUT_UNITS, bmeta->data_units)
+        != SUCCESS)
     {
-        sprintf (errmsg, "Writing attribute (units ref) to SDS: %s",
+        sprintf (errmsg, "Queueing attribute (units ref) for SDS: %s",
             bmeta->name);
         error_handler (true, FUNC_NAME, errmsg);
         return (ERROR);
@@ -405,14 +544,12 @@ int write_sds_attributes
     if (bmeta->valid_range[0] != ESPA_INT_META_FILL &&
         bmeta->valid_range[1] != ESPA_INT_META_FILL)
     {
-        attr.type = DFNT_INT32;
-        attr.nval = 2;
-        attr.name = OUTPUT_VALID_RANGE;
         dval[0] = (double) bmeta->valid_range[0];
         dval[1] = (double) bmeta->valid_range[1];
-        if (put_attr_double (sds_id, &attr, dval) != SUCCESS)
+        if (add_attr_batch_double (&batch, OUTPUT_VALID_RANGE, DFNT_INT32,
+            2, dval) != SUCCESS)
         {
-            sprintf (errmsg, "Writing attribute (valid range) to SDS: %s",
+            sprintf (errmsg, "Queueing attribute (valid range) for SDS: %s",
                 bmeta->name);
             error_handler (true, FUNC_NAME, errmsg);
             return (ERROR);
@@ -421,13 +558,11 @@ int write_sds_attributes
 
     if (bmeta->fill_value != ESPA_INT_META_FILL)
     {
-        attr.type = DFNT_INT32;
-        attr.nval = 1;
-        attr.name = OUTPUT_FILL_VALUE;
         dval[0] = (double) bmeta->fill_value;
-        if (put_attr_double (sds_id, &attr, dval) != SUCCESS)
+        if (add_attr_batch_double (&batch, OUTPUT_FILL_VALUE, DFNT_INT32,
+            1, dval) != SUCCESS)
         {
-            sprintf (errmsg, "Writing attribute (fill value) to SDS: %s",
+            sprintf (errmsg, "Queueing attribute (fill value) for SDS: %s",
                 bmeta->name);
             error_handler (true, FUNC_NAME, errmsg);
             return (ERROR);
@@ -436,14 +571,12 @@ int write_sds_attributes
 
     if (bmeta->saturate_value != ESPA_INT_META_FILL)
     {
-        attr.type = DFNT_INT32;
-        attr.nval = 1;
-        attr.name = OUTPUT_SATU_VALUE;
         dval[0] = (double) bmeta->saturate_value;
-        if (put_attr_double (sds_id, &attr, dval) != SUCCESS)
+        if (add_attr_batch_double (&batch, OUTPUT_SATU_VALUE, DFNT_INT32,
+            1, dval) != SUCCESS)
         {
-            sprintf (errmsg, "Writing attribute (saturate value) to SDS: %s",
-                bmeta->name);
+            sprintf (errmsg, "Queueing attribute (saturate value) for SDS: "
+                "%s", bmeta->name);
             error_handler (true, FUNC_NAME, errmsg);
             return (ERROR);
         }
@@ -451,29 +584,24 @@ int write_sds_attributes
 
     if (bmeta->scale_factor != ESPA_INT_META_FILL)
     {
-        attr.type = DFNT_FLOAT32;
-        attr.nval = 1;
-        attr.name = OUTPUT_SCALE_FACTOR;
         dval[0] = (float) bmeta->scale_factor;
-        if (put_attr_double (sds_id, &attr, dval) != SUCCESS)
+        if (add_attr_batch_double (&batch, OUTPUT_SCALE_FACTOR, DFNT_FLOAT32,
+            1, dval) != SUCCESS)
         {
-            sprintf (errmsg, "Writing attribute (scale factor) to SDS: %s",
+            sprintf (errmsg, "Queueing attribute (scale factor) for SDS: %s",
                 bmeta->name);
             error_handler (true, FUNC_NAME, errmsg);
             return (ERROR);
         }
-
     }
 
     if (bmeta->add_offset != ESPA_INT_META_FILL)
     {
-        attr.type = DFNT_FLOAT64;
-        attr.nval = 1;
-        attr.name = OUTPUT_ADD_OFFSET;
         dval[0] = (double) bmeta->add_offset;
-        if (put_attr_double (sds_id, &attr, dval) != SUCCESS)
+        if (add_attr_batch_double (&batch, OUTPUT_ADD_OFFSET, DFNT_FLOAT64,
+            1, dval) != SUCCESS)
         {
-            sprintf (errmsg, "Writing attribute (add offset) to SDS: %s",
+            sprintf (errmsg, "Queueing attribute (add offset) for SDS: %s",
                 bmeta->name);
             error_handler (true, FUNC_NAME, errmsg);
             return (ERROR);
@@ -482,197 +610,1410 @@ int write_sds_attributes
 
     if (fabs (bmeta->calibrated_nt - ESPA_FLOAT_META_FILL) > ESPA_EPSILON)
     {
-        attr.type = DFNT_FLOAT32;
-        attr.nval = 1;
-        attr.name = OUTPUT_CALIBRATED_NT;
         dval[0] = (double) bmeta->calibrated_nt;
-        if (put_attr_double (sds_id, &attr, dval) != SUCCESS)
+        if (add_attr_batch_double (&batch, OUTPUT_CALIBRATED_NT,
+            DFNT_FLOAT32, 1, dval) != SUCCESS)
         {
-            sprintf (errmsg, "Writing attribute (calibrated nt) to SDS: %s",
-                bmeta->name);
+            sprintf (errmsg, "Queueing attribute (calibrated nt) for SDS: "
+                "%s", bmeta->name);
             error_handler (true, FUNC_NAME, errmsg);
             return (ERROR);
         }
     }
 
-    if (bmeta->nbits != ESPA_INT_META_FILL && bmeta->nbits > 0)
+    /* The description strings are skipped by the batch when empty */
+    if (add_attr_batch_string (&batch, "Bitmap description",
+        attr_text->bitmap_msg) != SUCCESS)
     {
-        count = snprintf (message, sizeof (message),
-            "\n\tBits are numbered from right to left "
-            "(bit 0 = LSB, bit N = MSB):\n"
-            "\tBit    Description\n");
-        if (count < 0 || count >= sizeof (message))
+        sprintf (errmsg, "Queueing attribute (Bitmap description) for SDS: "
+            "%s", bmeta->name);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    if (add_attr_batch_string (&batch, "Class description",
+        attr_text->class_msg) != SUCCESS)
+    {
+        sprintf (errmsg, "Queueing attribute (Class description) for SDS: "
+            "%s", bmeta->name);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    if (strcmp (bmeta->app_version, ESPA_STRING_META_FILL))
+    {
+        if (add_attr_batch_string (&batch, OUTPUT_APP_VERSION,
+            bmeta->app_version) != SUCCESS)
         {
-            sprintf (errmsg, "Overflow of message string");
+            sprintf (errmsg, "Queueing attribute (app version) for SDS: %s",
+                bmeta->name);
             error_handler (true, FUNC_NAME, errmsg);
             return (ERROR);
         }
+    }
 
-        for (i = 0; i < bmeta->nbits; i++)
-        {
-            count = snprintf (tmp_msg, sizeof (tmp_msg), "\t%d      %s\n", i,
-                bmeta->bitmap_description[i]);
-            if (count < 0 || count >= sizeof (tmp_msg))
-            {
-                sprintf (errmsg, "Overflow of tmp_msg string");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
+    /* Write the queued attributes to the SDS in one pass */
+    if (put_attr_batch (sds_id, &batch) != SUCCESS)
+    {
+        sprintf (errmsg, "Writing the batched attributes to SDS: %.1024s",
+            bmeta->name);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
 
-            if (strlen (message) + strlen (tmp_msg) >= sizeof (message))
-            {
-                sprintf (errmsg, "Overflow of message string");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-            strcat (message, tmp_msg);
-        }
+    /* Successful write */
+    return (SUCCESS);
+}
 
-        attr.type = DFNT_CHAR8;
-        attr.nval = strlen (message);
-        attr.name = "Bitmap description";
-        if (put_attr_string (sds_id, &attr, message) != SUCCESS)
-        {
-            sprintf (errmsg, "Writing attribute (Bitmap description) to SDS: "
-                "%s", bmeta->name);
+
+/******************************************************************************
+MODULE:  hdf_band_data_type
+
+PURPOSE: Determine the HDF data type and the number of bytes in the data type
+for an ESPA band.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Unsupported ESPA data type
+SUCCESS         Successfully determined the HDF data type
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development, pulled from
+                              create_hdf_metadata so the band reader thread
+                              can share it
+
+NOTES:
+******************************************************************************/
+static int hdf_band_data_type
+(
+    enum Espa_data_type espa_type,  /* I: ESPA data type of the band */
+    int32 *data_type,          /* O: matching HDF data type */
+    int *nbytes                /* O: number of bytes in the data type */
+)
+{
+    char FUNC_NAME[] = "hdf_band_data_type";  /* function name */
+    char errmsg[STR_SIZE];     /* error message */
+
+    switch (espa_type)
+    {
+        case (ESPA_INT8):
+            *data_type = DFNT_INT8;
+            *nbytes = 1;
+            break;
+        case (ESPA_UINT8):
+            *data_type = DFNT_UINT8;
+            *nbytes = 1;
+            break;
+        case (ESPA_INT16):
+            *data_type = DFNT_INT16;
+            *nbytes = 2;
+            break;
+        case (ESPA_UINT16):
+            *data_type = DFNT_UINT16;
+            *nbytes = 2;
+            break;
+        case (ESPA_INT32):
+            *data_type = DFNT_INT32;
+            *nbytes = 4;
+            break;
+        case (ESPA_UINT32):
+            *data_type = DFNT_UINT32;
+            *nbytes = 4;
+            break;
+        case (ESPA_FLOAT32):
+            *data_type = DFNT_FLOAT32;
+            *nbytes = 4;
+            break;
+        case (ESPA_FLOAT64):
+            *data_type = DFNT_FLOAT64;
+            *nbytes = 8;
+            break;
+        default:
+            sprintf (errmsg, "Unsupported ESPA data type.");
             error_handler (true, FUNC_NAME, errmsg);
             return (ERROR);
-        }
     }
 
-    if (bmeta->nclass != ESPA_INT_META_FILL && bmeta->nclass > 0)
+    return (SUCCESS);
+}
+
+
+/* Products whose total band bytes are at or below this threshold take the
+   low-latency small-product path: the bands are read serially into one
+   pooled buffer and the reader and description-assembly threads are
+   skipped, since for small products the thread startup and synchronization
+   dwarf the pixel I/O they overlap */
+#define HDF_SMALL_PRODUCT_BYTES (16L * 1024L * 1024L)
+
+/* Number of lines in one full-width chunk of a compressed SDS.  Stripes
+   match the line-oriented access of the downstream readers while keeping
+   each chunk small enough for windowed reads to stay cheap. */
+#define HDF_COMPRESS_CHUNK_NLINES 128
+
+/* Deflate effort per band category: QA bands are mostly long runs and are
+   worth compressing hard; image bands get a light level so the write stays
+   close to I/O speed */
+#define HDF_COMPRESS_LEVEL_QA 9
+#define HDF_COMPRESS_LEVEL_IMAGE 1
+
+/* Maximum number of chunks cached per SDS while writing; the full-band
+   write streams through the chunks in order, so a deeper cache only costs
+   memory */
+#define HDF_COMPRESS_MAX_CACHE_CHUNKS 16
+
+/* Number of band buffers in the read/write pipeline ring.  Two slots are
+   enough to overlap the raw binary read of one band with the HDF write of
+   the previous band. */
+#define HDF_PIPELINE_DEPTH 2
+
+/* Ring of band buffers shared between the band reader thread and the HDF
+   writer.  The reader fills the slots in band order and the writer drains
+   them in band order, so slot i % HDF_PIPELINE_DEPTH always holds band i. */
+typedef struct
+{
+    Espa_internal_meta_t *xml_metadata;  /* XML metadata for the bands */
+    void *buf[HDF_PIPELINE_DEPTH];       /* band buffers, owned by the ring */
+    size_t buf_size[HDF_PIPELINE_DEPTH]; /* allocated size of each buffer */
+    int buf_status[HDF_PIPELINE_DEPTH];  /* read status of the band in each
+                                            slot */
+    bool buf_full[HDF_PIPELINE_DEPTH];   /* does the slot hold an unconsumed
+                                            band? */
+    bool abort;               /* the writer hit an error; stop reading */
+    pthread_mutex_t lock;     /* protects the slot states */
+    pthread_cond_t slot_empty;  /* signaled when the writer drains a slot */
+    pthread_cond_t slot_full;   /* signaled when the reader fills a slot */
+} Hdf_band_ring_t;
+
+
+/******************************************************************************
+MODULE:  read_band_worker
+
+PURPOSE: Reader thread which reads each raw binary band into the next ring
+slot so the read of one band overlaps the HDF write of the previous band.
+
+RETURN VALUE:
+Type = void *
+Value           Description
+-----           -----------
+NULL            Always; per-band read status is reported via the ring
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Advise the kernel of the sequential band reads
+                              and drop the pages of consumed bands
+
+NOTES:
+  1. If a read fails, the failure is published in the slot for the writer to
+     report and the reader stops.
+******************************************************************************/
+static void *read_band_worker
+(
+    void *arg                 /* I: pointer to the shared band ring */
+)
+{
+    char FUNC_NAME[] = "read_band_worker";  /* function name */
+    char errmsg[STR_SIZE];    /* error message */
+    int i;                    /* looping variable for each band */
+    int slot;                 /* ring slot for the current band */
+    int status;               /* read status of the current band */
+    int nbytes;               /* number of bytes in the data type */
+    int32 data_type;          /* data type for HDF file */
+    size_t band_size;         /* number of bytes in the band */
+    void *tmp_buf = NULL;     /* temporary pointer for growing the buffer */
+    FILE *fp_rb = NULL;       /* file pointer for the raw binary file */
+    Espa_band_meta_t *bmeta = NULL;  /* metadata for the current band */
+    Hdf_band_ring_t *ring = (Hdf_band_ring_t *) arg;  /* shared band ring */
+
+    for (i = 0; i < ring->xml_metadata->nbands; i++)
     {
-        count = snprintf (message, sizeof (message),
-            "\n\tClass  Description\n");
-        if (count < 0 || count >= sizeof (message))
+        /* Wait until the slot for this band has been drained */
+        slot = i % HDF_PIPELINE_DEPTH;
+        pthread_mutex_lock (&ring->lock);
+        while (ring->buf_full[slot] && !ring->abort)
+            pthread_cond_wait (&ring->slot_empty, &ring->lock);
+        if (ring->abort)
         {
-            sprintf (errmsg, "Overflow of message string");
-            error_handler (true, FUNC_NAME, errmsg);
-            return (ERROR);
+            pthread_mutex_unlock (&ring->lock);
+            return (NULL);
         }
+        pthread_mutex_unlock (&ring->lock);
 
-        for (i = 0; i < bmeta->nclass; i++)
+        /* Grow the slot buffer if this band needs more room */
+        status = SUCCESS;
+        bmeta = &ring->xml_metadata->band[i];
+        if (hdf_band_data_type (bmeta->data_type, &data_type, &nbytes) !=
+            SUCCESS)
+            status = ERROR;
+
+        if (status == SUCCESS)
         {
-            count = snprintf (tmp_msg, sizeof (tmp_msg), "\t%d      %s\n",
-                bmeta->class_values[i].class,
-                bmeta->class_values[i].description);
-            if (count < 0 || count >= sizeof (tmp_msg))
+            band_size = (size_t) bmeta->nlines * bmeta->nsamps * nbytes;
+            if (band_size > ring->buf_size[slot])
             {
-                sprintf (errmsg, "Overflow of tmp_msg string");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
+                tmp_buf = realloc (ring->buf[slot], band_size);
+                if (tmp_buf == NULL)
+                {
+                    sprintf (errmsg, "Error allocating memory for the file "
+                        "buffer.");
+                    error_handler (true, FUNC_NAME, errmsg);
+                    status = ERROR;
+                }
+                else
+                {
+                    ring->buf[slot] = tmp_buf;
+                    ring->buf_size[slot] = band_size;
+                }
             }
+        }
 
-            if (strlen (message) + strlen (tmp_msg) >= sizeof (message))
+        /* Read the data from the raw binary file */
+        if (status == SUCCESS)
+        {
+            fp_rb = open_raw_binary (bmeta->file_name, "rb");
+            if (fp_rb == NULL)
             {
-                sprintf (errmsg, "Overflow of message string");
+                sprintf (errmsg, "Opening the input raw binary file: %.1024s",
+                    bmeta->file_name);
                 error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
+                status = ERROR;
+            }
+            else
+            {
+                /* Let the kernel size the readahead for the sequential
+                   whole-band read */
+                advise_raw_binary_sequential (fp_rb);
+
+                if (read_raw_binary (fp_rb, bmeta->nlines, bmeta->nsamps,
+                    nbytes, ring->buf[slot]) != SUCCESS)
+                {
+                    sprintf (errmsg, "Reading image data from the raw binary "
+                        "file");
+                    error_handler (true, FUNC_NAME, errmsg);
+                    status = ERROR;
+                }
+
+                /* The band will not be read again, so drop its cached
+                   pages */
+                advise_raw_binary_done (fp_rb);
+                close_raw_binary (fp_rb);
             }
-            strcat (message, tmp_msg);
-        }
-
-        attr.type = DFNT_CHAR8;
-        attr.nval = strlen (message);
-        attr.name = "Class description";
-        if (put_attr_string (sds_id, &attr, message) != SUCCESS)
-        {
-            sprintf (errmsg, "Writing attribute (Class description) to SDS: "
-                "%s", bmeta->name);
-            error_handler (true, FUNC_NAME, errmsg);
-            return (ERROR);
         }
-    }
 
-    if (strcmp (bmeta->app_version, ESPA_STRING_META_FILL))
-    {
-        attr.type = DFNT_CHAR8;
-        attr.nval = strlen (bmeta->app_version);
-        attr.name = OUTPUT_APP_VERSION;
-        if (put_attr_string (sds_id, &attr, bmeta->app_version) != SUCCESS)
-        {
-            sprintf (errmsg, "Writing attribute (app version) to SDS: %s",
-                bmeta->name);
-            error_handler (true, FUNC_NAME, errmsg);
-            return (ERROR);
-        }
+        /* Publish the band to the writer */
+        pthread_mutex_lock (&ring->lock);
+        ring->buf_status[slot] = status;
+        ring->buf_full[slot] = true;
+        pthread_cond_signal (&ring->slot_full);
+        pthread_mutex_unlock (&ring->lock);
+
+        /* If the read failed, stop reading; the writer will report the
+           failure when it drains this slot */
+        if (status != SUCCESS)
+            return (NULL);
     }
 
-    /* Successful write */
-    return (SUCCESS);
+    return (NULL);
 }
 
 
 /******************************************************************************
-MODULE:  create_hdf_metadata
+MODULE:  shutdown_band_ring
 
-PURPOSE: Create the HDF metadata file, using info from the XML file, which will
-point to the existing raw binary bands as external SDSs.
+PURPOSE: Stop the band reader thread and release the ring resources.
 
 RETURN VALUE:
-Type = int
-Value           Description
------           -----------
-ERROR           Error creating the HDF file
-SUCCESS         Successfully created the HDF file
+Type = None
 
 HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
-1/6/2014     Gail Schmidt     Original development
-3/5/2014     Gail Schmidt     Updated to correctly support the external raw
-                              binary files, which need to be in big endian
-                              vs. little endian (as is the case with Linux)
-3/21/2014    Gail Schmidt     Added the HDF and HDF-EOS version
-4/24/2014    Gail Schmidt     Modified grid and dimension naming (in the case
-                              of multiple resolutions) for Geographic
-                              projections to not use the pixel size
-12/8/2014    Gail Schmidt     Delete the source files immediately after the
-                              new big endian files are created
-
+8/31/2026    Gail Schmidt     Original development
 
 NOTES:
-  1. The ESPA products are 2D thus only 2D products are supported.
-  2. XDim, YDim will refer to the x,y dimension size in the first SDS.  From
-     there, different x,y dimensions will contain the pixel size at the end of
-     XDim, YDim.  Example: XDim_15, YDim_15.  For Geographic projections, the
-     name will be based on the count of grids instead of the pixel size.
 ******************************************************************************/
-int create_hdf_metadata
+static void shutdown_band_ring
 (
-    char *hdf_file,                     /* I: output HDF filename */
-    Espa_internal_meta_t *xml_metadata, /* I: XML metadata structure */
-    bool del_src           /* I: should the source files be removed after
-                                 conversion? */
+    Hdf_band_ring_t *ring,    /* I: shared band ring to be shut down */
+    pthread_t reader          /* I: band reader thread to be joined */
 )
 {
-    char FUNC_NAME[] = "create_hdf_metadata";  /* function name */
+    int slot;                 /* looping variable for the ring slots */
+
+    /* Tell the reader to stop and wake it if it is waiting on a slot */
+    pthread_mutex_lock (&ring->lock);
+    ring->abort = true;
+    pthread_cond_signal (&ring->slot_empty);
+    pthread_mutex_unlock (&ring->lock);
+    pthread_join (reader, NULL);
+
+    /* Release the ring resources */
+    for (slot = 0; slot < HDF_PIPELINE_DEPTH; slot++)
+        free (ring->buf[slot]);
+    pthread_mutex_destroy (&ring->lock);
+    pthread_cond_destroy (&ring->slot_empty);
+    pthread_cond_destroy (&ring->slot_full);
+}
+
+
+/* number of threads splitting the description string assembly */
+#define SDS_ATTR_THREADS 4
+
+/* Work shared by the description assembly threads */
+typedef struct
+{
+    Espa_internal_meta_t *xml_metadata;  /* metadata for the bands */
+    Espa_sds_attr_text_t *attr_text;     /* per-band output strings */
+    int next_band;            /* next band to be assembled */
+    int status;               /* overall status across the threads */
+    pthread_mutex_t lock;     /* protects next_band and status */
+} Sds_attr_pool_t;
+
+/******************************************************************************
+MODULE:  assemble_attr_worker
+
+PURPOSE: Thread start routine which assembles the description strings for
+bands pulled from the shared pool until none remain.
+
+RETURN VALUE:
+Type = void *
+Value           Description
+-----           -----------
+NULL            Always; the overall status is tracked in the pool
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static void *assemble_attr_worker
+(
+    void *arg                 /* I: pointer to the shared Sds_attr_pool_t */
+)
+{
+    Sds_attr_pool_t *pool = arg;  /* shared pool of bands to be assembled */
+    int i;                        /* band assembled by this iteration */
+
+    while (true)
+    {
+        /* Grab the next unassembled band */
+        pthread_mutex_lock (&pool->lock);
+        i = pool->next_band++;
+        pthread_mutex_unlock (&pool->lock);
+        if (i >= pool->xml_metadata->nbands)
+            break;
+
+        /* Assemble its description strings */
+        if (assemble_sds_descriptions (&pool->xml_metadata->band[i],
+            &pool->attr_text[i]) != SUCCESS)
+        {   /* Error messages already printed; flag the overall failure */
+            pthread_mutex_lock (&pool->lock);
+            pool->status = ERROR;
+            pthread_mutex_unlock (&pool->lock);
+        }
+    }
+
+    return (NULL);
+}
+
+
+/******************************************************************************
+MODULE:  assemble_all_sds_descriptions
+
+PURPOSE: Assemble the bitmap and class description strings for all the bands
+up front, splitting the bands across a few worker threads.  The HDF attribute
+writes themselves aren't thread-safe and stay in the band loops.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error assembling the description strings
+SUCCESS         Successfully assembled the description strings
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development, pulled from
+                              create_hdf_metadata so the windowed path can
+                              share it
+
+NOTES:
+******************************************************************************/
+static int assemble_all_sds_descriptions
+(
+    Espa_internal_meta_t *xml_metadata, /* I: XML metadata structure */
+    Espa_sds_attr_text_t *attr_text     /* O: description strings for each
+                                              band, one entry per band */
+)
+{
+    char FUNC_NAME[] = "assemble_all_sds_descriptions";  /* function name */
+    char errmsg[STR_SIZE];        /* error message */
+    int i;                        /* looping variable for joining threads */
+    int t;                        /* looping variable for worker threads */
+    int nworkers;                 /* number of description worker threads */
+    pthread_t workers[SDS_ATTR_THREADS];  /* description assembly threads */
+    Sds_attr_pool_t pool;         /* work shared by the assembly threads */
+
+    pool.xml_metadata = xml_metadata;
+    pool.attr_text = attr_text;
+    pool.next_band = 0;
+    pool.status = SUCCESS;
+    pthread_mutex_init (&pool.lock, NULL);
+    nworkers = SDS_ATTR_THREADS;
+    if (nworkers > xml_metadata->nbands)
+        nworkers = xml_metadata->nbands;
+    for (t = 0; t < nworkers; t++)
+    {
+        if (pthread_create (&workers[t], NULL, assemble_attr_worker, &pool)
+            != 0)
+        {
+            sprintf (errmsg, "Creating the description assembly threads");
+            error_handler (true, FUNC_NAME, errmsg);
+            for (i = 0; i < t; i++)
+                pthread_join (workers[i], NULL);
+            return (ERROR);
+        }
+    }
+    for (t = 0; t < nworkers; t++)
+        pthread_join (workers[t], NULL);
+    pthread_mutex_destroy (&pool.lock);
+
+    if (pool.status != SUCCESS)
+    {
+        sprintf (errmsg, "Assembling the band description strings");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  hdf_compress_mode (static)
+
+PURPOSE: Checks whether compressed SDS output was requested through the
+ESPA_HDF_COMPRESS environment variable.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+0               Bands are linked as external uncompressed SDSs (the default)
+1               Bands are written as chunked, deflate-compressed SDSs
+2               Bands are written as chunked, RLE-compressed SDSs
+                (ESPA_HDF_COMPRESS=rle)
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+static int hdf_compress_mode (void)
+{
+    static int mode = -1;         /* cached setting; -1 until first call */
+    char *value = NULL;           /* value of the environment variable */
+
+    if (mode == -1)
+    {
+        value = getenv ("ESPA_HDF_COMPRESS");
+        if (value == NULL || value[0] == '\0' || strcmp (value, "0") == 0)
+            mode = 0;
+        else if (strcmp (value, "rle") == 0)
+            mode = 2;
+        else
+            mode = 1;
+    }
+
+    return mode;
+}
+
+
+/******************************************************************************
+MODULE:  hdf_read_window_bytes (static)
+
+PURPOSE: Checks whether the windowed two-pass conversion was requested
+through the ESPA_HDF_READ_WINDOW environment variable, whose value is the
+window memory budget in megabytes.
+
+RETURN VALUE:
+Type = size_t
+Value           Description
+-----           -----------
+0               Bands are converted through the read/write pipeline (the
+                default)
+window bytes    Bands are bulk-loaded in windows of this many bytes, then
+                written together
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+static size_t hdf_read_window_bytes (void)
+{
+    static long window_mb = -1;   /* cached setting; -1 until first call */
+    char *value = NULL;           /* value of the environment variable */
+
+    if (window_mb == -1)
+    {
+        value = getenv ("ESPA_HDF_READ_WINDOW");
+        if (value == NULL || value[0] == '\0')
+            window_mb = 0;
+        else
+        {
+            window_mb = atol (value);
+            if (window_mb < 0)
+                window_mb = 0;
+        }
+    }
+
+    return (size_t) window_mb * 1024 * 1024;
+}
+
+
+/******************************************************************************
+MODULE:  write_band_sds
+
+PURPOSE: Create the SDS for one band in the HDF file and write its data,
+dimension names, external file link, and attributes.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error writing the SDS
+SUCCESS         Successfully wrote the SDS
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development, pulled from the band loop
+                              in create_hdf_metadata so the small-product
+                              path can share it
+8/31/2026    Gail Schmidt     Optionally store the band as a chunked,
+                              compressed SDS inside the HDF file (set
+                              ESPA_HDF_COMPRESS)
+
+NOTES:
+******************************************************************************/
+static int write_band_sds
+(
+    int32 hdf_id,                       /* I: HDF file ID */
+    Espa_internal_meta_t *xml_metadata, /* I: XML metadata structure */
+    int i,                              /* I: band to be written */
+    int *ngrids,                        /* I/O: number of grids in the
+                                              product (1-based) */
+    void *file_buf,                     /* I: band data to be written */
+    Espa_sds_attr_text_t *attr_text     /* I: assembled description strings
+                                              for this band */
+)
+{
+    char FUNC_NAME[] = "write_band_sds";  /* function name */
     char errmsg[STR_SIZE];        /* error message */
     char bendian_file[STR_SIZE];  /* name of output big endian img file */
     char dim_name[2][STR_SIZE];   /* array of dimension names */
-    char hdr_file[STR_SIZE];      /* ENVI header file */
     char *cptr = NULL;            /* pointer to the file extension */
-    int i;                        /* looping variable for each SDS */
     int nbytes;                   /* number of bytes in the data type */
-    int nlines;                   /* number of lines in the band */
-    int nsamps;                   /* number of samples in the band */
     int dim;                      /* looping variable for dimensions */
     int count;                    /* number of chars copied in snprintf */
-    int ngrids;                   /* current number of grids in the product;
-                                     different grids are written for different
-                                     resolutions (1-based) */
     int mycount;                  /* integer value to use in the name of the
                                      2nd, 3rd, etc. grid dimensions */
-    int32 hdf_id;                 /* HDF file ID */
-    int32 sds_id;                 /* ID for each SDS */
+    int32 sds_id;                 /* ID for the SDS */
     int32 dim_id;                 /* ID for current dimension in SDS */
     int32 data_type;              /* data type for HDF file */
     int32 rank = 2;               /* rank of the SDS; set for 2D products */
     int32 dims[2];                /* array for dimension sizes; only 2D prods */
     int32 start[2];               /* starting location to write the HDF data */
     int32 edge[2];                /* number of values to write the HDF data */
-    FILE *fp_rb = NULL;           /* file pointer for the raw binary file */
+    int32 nchunks;                /* number of chunks cached while writing */
+    int compress;                 /* compressed SDS output mode */
+    HDF_CHUNK_DEF chunk_def;      /* chunking and compression definition */
+
+    /* Define the dimensions for this band */
+    dims[0] = xml_metadata->band[i].nlines;
+    dims[1] = xml_metadata->band[i].nsamps;
+
+    /* Determine the HDF data type */
+    if (hdf_band_data_type (xml_metadata->band[i].data_type, &data_type,
+        &nbytes) != SUCCESS)
+        return (ERROR);
+
+    /* Find the location of the file extension, then modify the filename
+       a bit to depict the big endian version of the imagery needed for
+       the HDF files.  (It's assumed we are running on Linux, thus the
+       current output files will be little endian.  HDF uses big endian
+       for their byte order.) */
+    count = snprintf (bendian_file, sizeof (bendian_file), "%s",
+        xml_metadata->band[i].file_name);
+    if (count < 0 || count >= sizeof (bendian_file))
+    {
+        sprintf (errmsg, "Overflow of bendian_file string");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    cptr = strrchr (bendian_file, '.');
+    if (cptr != NULL)
+        *cptr = '\0';
+    strcpy (cptr, "_hdf.img");
+
+    /* Select/create the SDS index for the current band */
+    sds_id = SDcreate (hdf_id, xml_metadata->band[i].name, data_type,
+        rank, dims);
+    if (sds_id == HDF_ERROR)
+    {
+        sprintf (errmsg, "Creating SDS in the HDF file: %d.", i);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Set the dimension name for each dimension in this SDS.  The default
+       is to use YDim, XDim for the first band or for any bands
+       matching the resolution of the first band */
+    if (i == 0 ||
+        ((xml_metadata->band[i].pixel_size[0] ==
+         xml_metadata->band[0].pixel_size[0]) &&
+        (xml_metadata->band[i].pixel_size[1] ==
+         xml_metadata->band[0].pixel_size[1])))
+    {  /* first band or resolution matching the first band */
+        strcpy (dim_name[0], "YDim");
+        strcpy (dim_name[1], "XDim");
+    }
+    else
+    {  /* create new dimension name for this resolution */
+        /* Use the pixel size for non-geographic projections otherwise
+           use the grid count */
+        (*ngrids)++;
+        if (xml_metadata->global.proj_info.proj_type == GCTP_GEO)
+            mycount = *ngrids;
+        else
+            mycount = (int) xml_metadata->band[i].pixel_size[1]; /* Y dim */
+
+        count = snprintf (dim_name[0], sizeof (dim_name[0]), "YDim_%d",
+            mycount);  /* Y dim */
+        if (count < 0 || count >= sizeof (dim_name[0]))
+        {
+            sprintf (errmsg, "Overflow of dim_name[0] string");
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+
+        if (xml_metadata->global.proj_info.proj_type == GCTP_GEO)
+            mycount = *ngrids;
+        else
+            mycount = (int) xml_metadata->band[i].pixel_size[0]; /* X dim */
+
+        count = snprintf (dim_name[1], sizeof (dim_name[1]), "XDim_%d",
+            mycount);  /* X dim */
+        if (count < 0 || count >= sizeof (dim_name[1]))
+        {
+            sprintf (errmsg, "Overflow of dim_name[1] string");
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+    }
+
+    /* Write the dimension names to the HDF file */
+    for (dim = 0; dim < rank; dim++)
+    {
+        dim_id = SDgetdimid (sds_id, dim);
+        if (dim_id == HDF_ERROR) 
+        {
+            sprintf (errmsg, "Getting dimension id for dimension %d and "
+                "SDS %d.", dim, i);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+
+        if (SDsetdimname (dim_id, dim_name[dim]) == HDF_ERROR)
+        {
+            sprintf (errmsg, "Setting dimension name (%s) for dimension "
+                "%d and SDS %d.", dim_name[dim], dim, i);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+    }
+
+    /* Store the band either as an external dataset (the default) or, when
+       compressed output was requested, as a chunked and compressed dataset
+       inside the HDF file itself */
+    compress = hdf_compress_mode ();
+    if (compress == 0)
+    {
+        /* Identify the external dataset for this SDS, starting at byte
+           location 0 since these are raw binary files without any headers */
+        if (SDsetexternalfile (sds_id, bendian_file, 0 /* offset */) ==
+            HDF_ERROR)
+        {
+            sprintf (errmsg, "Setting the external dataset for this SDS "
+                "(%d): %.1024s.", i, bendian_file);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+    }
+    else
+    {
+        /* Chunks are full-width stripes of lines.  QA bands compress hard
+           since they are mostly long runs; image bands get a light level
+           so the write stays close to I/O speed */
+        memset (&chunk_def, 0, sizeof (chunk_def));
+        chunk_def.comp.chunk_lengths[0] = HDF_COMPRESS_CHUNK_NLINES;
+        if (chunk_def.comp.chunk_lengths[0] > dims[0])
+            chunk_def.comp.chunk_lengths[0] = dims[0];
+        chunk_def.comp.chunk_lengths[1] = dims[1];
+        if (compress == 2)
+            chunk_def.comp.comp_type = COMP_CODE_RLE;
+        else
+        {
+            chunk_def.comp.comp_type = COMP_CODE_DEFLATE;
+            if (!strcmp (xml_metadata->band[i].category, "qa"))
+                chunk_def.comp.cinfo.deflate.level = HDF_COMPRESS_LEVEL_QA;
+            else
+                chunk_def.comp.cinfo.deflate.level =
+                    HDF_COMPRESS_LEVEL_IMAGE;
+        }
+
+        if (SDsetchunk (sds_id, chunk_def, HDF_CHUNK | HDF_COMP) ==
+            HDF_ERROR)
+        {
+            sprintf (errmsg, "Setting chunking and compression for this "
+                "SDS (%d).", i);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+
+        /* Size the chunk cache to a handful of stripes; the advisory call
+           is allowed to fail without affecting the output */
+        nchunks = (dims[0] + chunk_def.comp.chunk_lengths[0] - 1) /
+            chunk_def.comp.chunk_lengths[0];
+        if (nchunks > HDF_COMPRESS_MAX_CACHE_CHUNKS)
+            nchunks = HDF_COMPRESS_MAX_CACHE_CHUNKS;
+        SDsetchunkcache (sds_id, nchunks, 0);
+    }
+
+    /* Write the new big endian data to the SDS.  Start writing at the
+       beginning of the SDS, write every element, and write all the
+       elements in both dimensions. */
+    start[0] = start[1] = 0;
+    edge[0] = dims[0];
+    edge[1] = dims[1];
+    if (SDwritedata (sds_id, start, NULL, edge, file_buf) == HDF_ERROR)
+    {
+        sprintf (errmsg, "Writing the external dataset for this SDS (%d): "
+            "%.1024s.", i, bendian_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Write the SDS-level metadata */
+    if (write_sds_attributes (sds_id, &xml_metadata->band[i], attr_text)
+        != SUCCESS)
+    {
+        sprintf (errmsg, "Writing band attributes for this SDS (%d).", i);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Terminate access to the data set and SD interface */
+    SDendaccess (sds_id);
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  remove_band_source
+
+PURPOSE: Remove the source .img and .hdr files for a band which has been
+converted.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error removing the source files
+SUCCESS         Successfully removed the source files
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development, pulled from the band loop
+                              in create_hdf_metadata so the small-product
+                              path can share it
+
+NOTES:
+******************************************************************************/
+static int remove_band_source
+(
+    Espa_band_meta_t *bmeta   /* I: metadata for the converted band */
+)
+{
+    char FUNC_NAME[] = "remove_band_source";  /* function name */
+    char errmsg[STR_SIZE];    /* error message */
+    char hdr_file[STR_SIZE];  /* ENVI header file */
+    char *cptr = NULL;        /* pointer to the file extension */
+    int count;                /* number of chars copied in snprintf */
+
+    /* .img file */
+    printf ("  Removing %s\n", bmeta->file_name);
+    if (unlink (bmeta->file_name) != 0)
+    {
+        sprintf (errmsg, "Deleting source file: %s", bmeta->file_name);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* .hdr file */
+    count = snprintf (hdr_file, sizeof (hdr_file), "%s", bmeta->file_name);
+    if (count < 0 || count >= sizeof (hdr_file))
+    {
+        sprintf (errmsg, "Overflow of hdr_file string");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    cptr = strrchr (hdr_file, '.');
+    strcpy (cptr, ".hdr");
+    printf ("  Removing %s\n", hdr_file);
+    if (unlink (hdr_file) != 0)
+    {
+        sprintf (errmsg, "Deleting source file: %s", hdr_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  create_hdf_metadata_small
+
+PURPOSE: Low-latency path of create_hdf_metadata for small products.  The
+bands are read serially into a single pooled buffer and the reader and
+description-assembly threads are skipped, since their startup and
+synchronization cost more than the pixel I/O they overlap for a product of a
+few small bands.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error creating the HDF file
+SUCCESS         Successfully created the HDF file
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The HDF product written by this path is identical to the one written
+     by the threaded path; only the fixed per-product costs differ.
+******************************************************************************/
+static int create_hdf_metadata_small
+(
+    char *hdf_file,                     /* I: output HDF filename */
+    Espa_internal_meta_t *xml_metadata, /* I: XML metadata structure */
+    bool del_src           /* I: should the source files be removed after
+                                 conversion? */
+)
+{
+    char FUNC_NAME[] = "create_hdf_metadata_small";  /* function name */
+    char errmsg[STR_SIZE];        /* error message */
+    int i;                        /* looping variable for each SDS */
+    int nbytes;                   /* number of bytes in the data type */
+    int ngrids;                   /* current number of grids in the product */
+    int32 hdf_id;                 /* HDF file ID */
+    int32 data_type;              /* data type for HDF file */
+    size_t band_size;             /* number of bytes in the band */
+    size_t buf_size = 0;          /* allocated size of the pooled buffer */
+    void *file_buf = NULL;        /* pooled buffer shared by all the bands */
+    void *tmp_buf = NULL;         /* temporary pointer for growing the
+                                     buffer */
+    FILE *fp_rb = NULL;           /* file pointer for the raw binary file */
+    Espa_band_meta_t *bmeta = NULL;  /* metadata for the current band */
+    Espa_sds_attr_text_t attr_text;  /* description strings for the current
+                                     band */
+
+    /* Open the HDF file for creation (overwriting if it exists) */
+    hdf_id = SDstart (hdf_file, DFACC_CREATE);
+    if (hdf_id == HDF_ERROR)
+    {
+        sprintf (errmsg, "Creating the HDF file: %s", hdf_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Loop through the bands in the XML file and set each band as an
+       external SDS in this HDF file */
+    ngrids = 1;
+    for (i = 0; i < xml_metadata->nbands; i++)
+    {
+        /* Provide the status of processing */
+        printf ("Processing SDS: %s\n", xml_metadata->band[i].name);
+        bmeta = &xml_metadata->band[i];
+
+        /* Grow the pooled buffer if this band needs more room */
+        if (hdf_band_data_type (bmeta->data_type, &data_type, &nbytes) !=
+            SUCCESS)
+        {
+            free (file_buf);
+            return (ERROR);
+        }
+
+        band_size = (size_t) bmeta->nlines * bmeta->nsamps * nbytes;
+        if (band_size > buf_size)
+        {
+            tmp_buf = realloc (file_buf, band_size);
+            if (tmp_buf == NULL)
+            {
+                sprintf (errmsg, "Error allocating memory for the file "
+                    "buffer.");
+                error_handler (true, FUNC_NAME, errmsg);
+                free (file_buf);
+                return (ERROR);
+            }
+            file_buf = tmp_buf;
+            buf_size = band_size;
+        }
+
+        /* Read the data from the raw binary file */
+        fp_rb = open_raw_binary (bmeta->file_name, "rb");
+        if (fp_rb == NULL)
+        {
+            sprintf (errmsg, "Opening the input raw binary file: %.1024s",
+                bmeta->file_name);
+            error_handler (true, FUNC_NAME, errmsg);
+            free (file_buf);
+            return (ERROR);
+        }
+
+        if (read_raw_binary (fp_rb, bmeta->nlines, bmeta->nsamps, nbytes,
+            file_buf) != SUCCESS)
+        {
+            sprintf (errmsg, "Reading image data from the raw binary file");
+            error_handler (true, FUNC_NAME, errmsg);
+            close_raw_binary (fp_rb);
+            free (file_buf);
+            return (ERROR);
+        }
+        close_raw_binary (fp_rb);
+
+        /* Assemble the band description strings inline */
+        if (assemble_sds_descriptions (bmeta, &attr_text) != SUCCESS)
+        {   /* Error messages already printed */
+            free (file_buf);
+            return (ERROR);
+        }
+
+        /* Create the SDS for this band and write its data and attributes */
+        if (write_band_sds (hdf_id, xml_metadata, i, &ngrids, file_buf,
+            &attr_text) != SUCCESS)
+        {   /* Error messages already printed */
+            free (file_buf);
+            return (ERROR);
+        }
+
+        /* Remove the source files if specified */
+        if (del_src)
+        {
+            if (remove_band_source (bmeta) != SUCCESS)
+            {   /* Error messages already printed */
+                free (file_buf);
+                return (ERROR);
+            }
+        }
+    }
+    free (file_buf);
+
+    /* Write the global metadata */
+    if (write_global_attributes (hdf_id, xml_metadata) != SUCCESS)
+    {
+        sprintf (errmsg, "Writing global attributes for this HDF file.");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Terminate access to the HDF file */
+    SDend (hdf_id);
+
+    /* Write HDF-EOS attributes and metadata */
+    if (write_hdf_eos_attr (hdf_file, xml_metadata) != SUCCESS)
+    {
+        sprintf (errmsg, "Writing HDF-EOS attributes for this HDF file.");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Successful conversion */
+    return (SUCCESS);
+}
+
+
+
+/******************************************************************************
+MODULE:  create_hdf_metadata_windowed
+
+PURPOSE: Two-pass ordering of create_hdf_metadata for many-band products.
+The bands are converted in windows sized to a memory budget: each window's
+bands are bulk-loaded back to back with sequential reads, then written to
+the HDF file together, so the scattered HDF writes and metadata updates are
+batched after the reads instead of interleaved with them.  Interleaving a
+large sequential band read with the HDF writes of the previous band evicts
+the readahead the next read depends on, which is what makes many-band
+conversions run well below the raw drive throughput.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error creating the HDF file
+SUCCESS         Successfully created the HDF file
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The bands stay in metadata order within each window so the SDS order in
+     the HDF product is identical to the other paths; ESPA products already
+     list the bands grouped by resolution, so each window's reads are runs
+     of same-sized files.
+  2. A band larger than the window budget gets a window of its own.
+******************************************************************************/
+static int create_hdf_metadata_windowed
+(
+    char *hdf_file,                     /* I: output HDF filename */
+    Espa_internal_meta_t *xml_metadata, /* I: XML metadata structure */
+    bool del_src,          /* I: should the source files be removed after
+                                 conversion? */
+    size_t window_bytes    /* I: memory budget for one window of bands */
+)
+{
+    char FUNC_NAME[] = "create_hdf_metadata_windowed";  /* function name */
+    char errmsg[STR_SIZE];        /* error message */
+    int i;                        /* looping variable for each SDS */
+    int j;                        /* looping variable for cleanup */
+    int wstart;                   /* first band of the current window */
+    int wend;                     /* first band past the current window */
+    int nbytes;                   /* number of bytes in the data type */
+    int ngrids;                   /* current number of grids in the product */
+    int32 hdf_id;                 /* HDF file ID */
+    int32 data_type;              /* data type for HDF file */
+    size_t band_size;             /* number of bytes in the band */
+    size_t window_used;           /* band bytes pulled into the window */
+    void **band_bufs = NULL;      /* per-band buffers for the window */
+    FILE *fp_rb = NULL;           /* file pointer for the raw binary file */
+    Espa_band_meta_t *bmeta = NULL;  /* metadata for the current band */
+    Espa_sds_attr_text_t *attr_text = NULL;  /* description strings for each
+                                     band, assembled before the HDF writes */
+
+    /* Assemble the description strings for all the bands before the
+       single-threaded HDF writes */
+    attr_text = calloc (xml_metadata->nbands, sizeof (Espa_sds_attr_text_t));
+    if (attr_text == NULL)
+    {
+        sprintf (errmsg, "Allocating the band description strings");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    if (assemble_all_sds_descriptions (xml_metadata, attr_text) != SUCCESS)
+    {   /* Error messages already printed */
+        free (attr_text);
+        return (ERROR);
+    }
+
+    /* One buffer slot per band; only the current window's slots hold
+       memory at any time */
+    band_bufs = calloc (xml_metadata->nbands, sizeof (void *));
+    if (band_bufs == NULL)
+    {
+        sprintf (errmsg, "Allocating the window buffer pointers");
+        error_handler (true, FUNC_NAME, errmsg);
+        free (attr_text);
+        return (ERROR);
+    }
+
+    /* Open the HDF file for creation (overwriting if it exists) */
+    hdf_id = SDstart (hdf_file, DFACC_CREATE);
+    if (hdf_id == HDF_ERROR)
+    {
+        sprintf (errmsg, "Creating the HDF file: %s", hdf_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        free (attr_text);
+        free (band_bufs);
+        return (ERROR);
+    }
+
+    /* Convert the bands window by window */
+    ngrids = 1;
+    for (wstart = 0; wstart < xml_metadata->nbands; wstart = wend)
+    {
+        /* Size the window: pull bands in while they fit the memory budget,
+           always taking at least one */
+        window_used = 0;
+        for (wend = wstart; wend < xml_metadata->nbands; wend++)
+        {
+            bmeta = &xml_metadata->band[wend];
+            if (hdf_band_data_type (bmeta->data_type, &data_type, &nbytes)
+                != SUCCESS)
+            {
+                free (attr_text);
+                free (band_bufs);
+                return (ERROR);
+            }
+            band_size = (size_t) bmeta->nlines * bmeta->nsamps * nbytes;
+            if (wend > wstart && window_used + band_size > window_bytes)
+                break;
+            window_used += band_size;
+        }
+
+        /* Read pass: bulk-load the window's bands back to back, so the
+           reads stay sequential instead of alternating with the HDF
+           writes */
+        for (i = wstart; i < wend; i++)
+        {
+            bmeta = &xml_metadata->band[i];
+            hdf_band_data_type (bmeta->data_type, &data_type, &nbytes);
+            band_size = (size_t) bmeta->nlines * bmeta->nsamps * nbytes;
+
+            band_bufs[i] = malloc (band_size);
+            if (band_bufs[i] == NULL)
+            {
+                sprintf (errmsg, "Error allocating memory for the window "
+                    "band buffers.");
+                error_handler (true, FUNC_NAME, errmsg);
+                for (j = wstart; j < i; j++)
+                    free (band_bufs[j]);
+                free (attr_text);
+                free (band_bufs);
+                return (ERROR);
+            }
+
+            fp_rb = open_raw_binary (bmeta->file_name, "rb");
+            if (fp_rb == NULL)
+            {
+                sprintf (errmsg, "Opening the input raw binary file: %.1024s",
+                    bmeta->file_name);
+                error_handler (true, FUNC_NAME, errmsg);
+                for (j = wstart; j <= i; j++)
+                    free (band_bufs[j]);
+                free (attr_text);
+                free (band_bufs);
+                return (ERROR);
+            }
+
+            /* Let the kernel size the readahead for the sequential
+               whole-band read, and drop the band's pages afterwards since
+               it will not be read again */
+            advise_raw_binary_sequential (fp_rb);
+            if (read_raw_binary (fp_rb, bmeta->nlines, bmeta->nsamps,
+                nbytes, band_bufs[i]) != SUCCESS)
+            {
+                sprintf (errmsg, "Reading image data from the raw binary "
+                    "file");
+                error_handler (true, FUNC_NAME, errmsg);
+                close_raw_binary (fp_rb);
+                for (j = wstart; j <= i; j++)
+                    free (band_bufs[j]);
+                free (attr_text);
+                free (band_bufs);
+                return (ERROR);
+            }
+            advise_raw_binary_done (fp_rb);
+            close_raw_binary (fp_rb);
+        }
+
+        /* Write pass: write the window's bands and their attributes
+           together, batching the HDF data writes and metadata updates
+           after the reads */
+        for (i = wstart; i < wend; i++)
+        {
+            /* Provide the status of processing */
+            printf ("Processing SDS: %s\n", xml_metadata->band[i].name);
+
+            if (write_band_sds (hdf_id, xml_metadata, i, &ngrids,
+                band_bufs[i], &attr_text[i]) != SUCCESS)
+            {   /* Error messages already printed */
+                for (j = i; j < wend; j++)
+                    free (band_bufs[j]);
+                free (attr_text);
+                free (band_bufs);
+                return (ERROR);
+            }
+            free (band_bufs[i]);
+            band_bufs[i] = NULL;
+
+            /* Remove the source files if specified */
+            if (del_src)
+            {
+                if (remove_band_source (&xml_metadata->band[i]) != SUCCESS)
+                {   /* Error messages already printed */
+                    for (j = i + 1; j < wend; j++)
+                        free (band_bufs[j]);
+                    free (attr_text);
+                    free (band_bufs);
+                    return (ERROR);
+                }
+            }
+        }
+    }
+    free (attr_text);
+    free (band_bufs);
+
+    /* Write the global metadata */
+    if (write_global_attributes (hdf_id, xml_metadata) != SUCCESS)
+    {
+        sprintf (errmsg, "Writing global attributes for this HDF file.");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Terminate access to the HDF file */
+    SDend (hdf_id);
+
+    /* Write HDF-EOS attributes and metadata */
+    if (write_hdf_eos_attr (hdf_file, xml_metadata) != SUCCESS)
+    {
+        sprintf (errmsg, "Writing HDF-EOS attributes for this HDF file.");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Successful conversion */
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  create_hdf_metadata
+
+PURPOSE: Create the HDF metadata file, using info from the XML file, which will
+point to the existing raw binary bands as external SDSs.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error creating the HDF file
+SUCCESS         Successfully created the HDF file
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+1/6/2014     Gail Schmidt     Original development
+3/5/2014     Gail Schmidt     Updated to correctly support the external raw
+                              binary files, which need to be in big endian
+                              vs. little endian (as is the case with Linux)
+3/21/2014    Gail Schmidt     Added the HDF and HDF-EOS version
+4/24/2014    Gail Schmidt     Modified grid and dimension naming (in the case
+                              of multiple resolutions) for Geographic
+                              projections to not use the pixel size
+12/8/2014    Gail Schmidt     Delete the source files immediately after the
+                              new big endian files are created
+8/31/2026    Gail Schmidt     Read the bands with a reader thread so the raw
+                              binary read of one band overlaps the HDF write
+                              of the previous band
+8/31/2026    Gail Schmidt     Assemble the band description strings across a
+                              few worker threads before the single-threaded
+                              HDF writes
+8/31/2026    Gail Schmidt     Pulled the per-band SDS write and source removal
+                              into helpers and added a low-latency serial path
+                              for small products
+8/31/2026    Gail Schmidt     Size the product through the compact band
+                              descriptors instead of the full band structures
+8/31/2026    Gail Schmidt     Added the windowed two-pass ordering for
+                              many-band products (set ESPA_HDF_READ_WINDOW
+                              to the window budget in megabytes)
+
+NOTES:
+  1. The ESPA products are 2D thus only 2D products are supported.
+  2. XDim, YDim will refer to the x,y dimension size in the first SDS.  From
+     there, different x,y dimensions will contain the pixel size at the end of
+     XDim, YDim.  Example: XDim_15, YDim_15.  For Geographic projections, the
+     name will be based on the count of grids instead of the pixel size.
+******************************************************************************/
+int create_hdf_metadata
+(
+    char *hdf_file,                     /* I: output HDF filename */
+    Espa_internal_meta_t *xml_metadata, /* I: XML metadata structure */
+    bool del_src           /* I: should the source files be removed after
+                                 conversion? */
+)
+{
+    char FUNC_NAME[] = "create_hdf_metadata";  /* function name */
+    char errmsg[STR_SIZE];        /* error message */
+    int i;                        /* looping variable for each SDS */
+    int nbytes;                   /* number of bytes in the data type */
+    int ngrids;                   /* current number of grids in the product;
+                                     different grids are written for different
+                                     resolutions (1-based) */
+    int32 hdf_id;                 /* HDF file ID */
+    int32 data_type;              /* data type for HDF file */
+    size_t total_bytes;           /* total band bytes in the product */
+    const Espa_band_hot_t *hot = NULL;  /* compact band descriptors, or NULL
+                                     to scan the full band structures */
+    int slot;                     /* ring slot holding the current band */
     void *file_buf = NULL;        /* pointer to correct input file buffer */
+    pthread_t reader;             /* band reader thread */
+    Hdf_band_ring_t ring;         /* ring of band buffers shared with the
+                                     reader thread */
+    Espa_sds_attr_text_t *attr_text = NULL;  /* description strings for each
+                                     band, assembled before the HDF writes */
+
+    /* Small products pay more in thread startup and synchronization than in
+       the pixel I/O the threads overlap, so convert them serially instead.
+       Size the product through the compact band descriptors when they are
+       available so the scan doesn't pull every full band structure through
+       the cache ahead of the pixel loops. */
+    hot = get_band_hot (xml_metadata);
+    total_bytes = 0;
+    for (i = 0; i < xml_metadata->nbands; i++)
+    {
+        if (hot != NULL)
+        {
+            if (hdf_band_data_type (hot[i].data_type, &data_type, &nbytes)
+                != SUCCESS)
+                return (ERROR);
+            total_bytes += (size_t) hot[i].nlines * hot[i].nsamps * nbytes;
+        }
+        else
+        {
+            if (hdf_band_data_type (xml_metadata->band[i].data_type,
+                &data_type, &nbytes) != SUCCESS)
+                return (ERROR);
+            total_bytes += (size_t) xml_metadata->band[i].nlines *
+                xml_metadata->band[i].nsamps * nbytes;
+        }
+    }
+    if (total_bytes <= HDF_SMALL_PRODUCT_BYTES)
+        return (create_hdf_metadata_small (hdf_file, xml_metadata, del_src));
+
+    /* Many-band products can opt into the windowed two-pass ordering, which
+       bulk-loads windows of bands and then writes them together instead of
+       alternating each band's sequential read with the previous band's
+       scattered HDF writes */
+    if (hdf_read_window_bytes () > 0)
+    {
+        return (create_hdf_metadata_windowed (hdf_file, xml_metadata,
+            del_src, hdf_read_window_bytes ()));
+    }
 
     /* Open the HDF file for creation (overwriting if it exists) */
     hdf_id = SDstart (hdf_file, DFACC_CREATE);
@@ -683,6 +2024,38 @@ int create_hdf_metadata
         return (ERROR);
     }
 
+    /* Assemble the description strings for all the bands before the
+       single-threaded HDF writes */
+    attr_text = calloc (xml_metadata->nbands, sizeof (Espa_sds_attr_text_t));
+    if (attr_text == NULL)
+    {
+        sprintf (errmsg, "Allocating the band description strings");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    if (assemble_all_sds_descriptions (xml_metadata, attr_text) != SUCCESS)
+    {   /* Error messages already printed */
+        free (attr_text);
+        return (ERROR);
+    }
+
+    /* Set up the band ring and kick off the reader thread, which reads each
+       band into the next ring slot while the previous band is written to
+       the HDF file */
+    memset (&ring, 0, sizeof (ring));
+    ring.xml_metadata = xml_metadata;
+    pthread_mutex_init (&ring.lock, NULL);
+    pthread_cond_init (&ring.slot_empty, NULL);
+    pthread_cond_init (&ring.slot_full, NULL);
+    if (pthread_create (&reader, NULL, read_band_worker, &ring) != 0)
+    {
+        sprintf (errmsg, "Creating the band reader thread");
+        error_handler (true, FUNC_NAME, errmsg);
+        free (attr_text);
+        return (ERROR);
+    }
+
     /* Loop through the bands in the XML file and set each band as an
        external SDS in this HDF file */
     ngrids = 1;
@@ -691,255 +2064,54 @@ int create_hdf_metadata
         /* Provide the status of processing */
         printf ("Processing SDS: %s\n", xml_metadata->band[i].name);
 
-        /* Open the file for this band of data to allow for reading */
-        fp_rb = open_raw_binary (xml_metadata->band[i].file_name, "rb");
-        if (fp_rb == NULL)
-        {
-            sprintf (errmsg, "Opening the input raw binary file: %s",
-                xml_metadata->band[i].file_name);
-            error_handler (true, FUNC_NAME, errmsg);
-            return (ERROR);
-        }
-
-        /* Define the dimensions for this band */
-        nlines = xml_metadata->band[i].nlines;
-        nsamps = xml_metadata->band[i].nsamps;
-        dims[0] = nlines;
-        dims[1] = nsamps;
-
-        /* Determine the HDF data type */
-        switch (xml_metadata->band[i].data_type)
-        {
-            case (ESPA_INT8):
-                data_type = DFNT_INT8;
-                nbytes = 1;
-                break;
-            case (ESPA_UINT8):
-                data_type = DFNT_UINT8;
-                nbytes = 1;
-                break;
-            case (ESPA_INT16):
-                data_type = DFNT_INT16;
-                nbytes = 2;
-                break;
-            case (ESPA_UINT16):
-                data_type = DFNT_UINT16;
-                nbytes = 2;
-                break;
-            case (ESPA_INT32):
-                data_type = DFNT_INT32;
-                nbytes = 4;
-                break;
-            case (ESPA_UINT32):
-                data_type = DFNT_UINT32;
-                nbytes = 4;
-                break;
-            case (ESPA_FLOAT32):
-                data_type = DFNT_FLOAT32;
-                nbytes = 4;
-                break;
-            case (ESPA_FLOAT64):
-                data_type = DFNT_FLOAT64;
-                nbytes = 8;
-                break;
-            default:
-                sprintf (errmsg, "Unsupported ESPA data type.");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-        }
-
-        /* Allocate memory for the file buffer */
-        file_buf = calloc (nlines * nsamps, nbytes);
-        if (file_buf == NULL)
-        {
-            sprintf (errmsg, "Error allocating memory for the file buffer.");
-            error_handler (true, FUNC_NAME, errmsg);
-            return (ERROR);
-        }
-
-        /* Read the data from the raw binary file */
-        if (read_raw_binary (fp_rb, nlines, nsamps, nbytes, file_buf) !=
-            SUCCESS)
-        {
-            sprintf (errmsg, "Reading image data from the raw binary file");
-            error_handler (true, FUNC_NAME, errmsg);
-            return (ERROR);
-        }
-
-        /* Close the raw binary file */
-        close_raw_binary (fp_rb);
-
-        /* Find the location of the file extension, then modify the filename
-           a bit to depict the big endian version of the imagery needed for
-           the HDF files.  (It's assumed we are running on Linux, thus the
-           current output files will be little endian.  HDF uses big endian
-           for their byte order.) */
-        count = snprintf (bendian_file, sizeof (bendian_file), "%s",
-            xml_metadata->band[i].file_name);
-        if (count < 0 || count >= sizeof (bendian_file))
-        {
-            sprintf (errmsg, "Overflow of bendian_file string");
-            error_handler (true, FUNC_NAME, errmsg);
-            return (ERROR);
-        }
-
-        cptr = strrchr (bendian_file, '.');
-        if (cptr != NULL)
-            *cptr = '\0';
-        strcpy (cptr, "_hdf.img");
-
-        /* Select/create the SDS index for the current band */
-        sds_id = SDcreate (hdf_id, xml_metadata->band[i].name, data_type,
-            rank, dims);
-        if (sds_id == HDF_ERROR)
-        {
-            sprintf (errmsg, "Creating SDS in the HDF file: %d.", i);
-            error_handler (true, FUNC_NAME, errmsg);
-            return (ERROR);
-        }
-
-        /* Set the dimension name for each dimension in this SDS.  The default
-           is to use YDim, XDim for the first band or for any bands
-           matching the resolution of the first band */
-        if (i == 0 ||
-            ((xml_metadata->band[i].pixel_size[0] ==
-             xml_metadata->band[0].pixel_size[0]) &&
-            (xml_metadata->band[i].pixel_size[1] ==
-             xml_metadata->band[0].pixel_size[1])))
-        {  /* first band or resolution matching the first band */
-            strcpy (dim_name[0], "YDim");
-            strcpy (dim_name[1], "XDim");
-        }
-        else
-        {  /* create new dimension name for this resolution */
-            /* Use the pixel size for non-geographic projections otherwise
-               use the grid count */
-            ngrids++;
-            if (xml_metadata->global.proj_info.proj_type == GCTP_GEO)
-                mycount = ngrids;
-            else
-                mycount = (int) xml_metadata->band[i].pixel_size[1]; /* Y dim */
-
-            count = snprintf (dim_name[0], sizeof (dim_name[0]), "YDim_%d",
-                mycount);  /* Y dim */
-            if (count < 0 || count >= sizeof (dim_name[0]))
-            {
-                sprintf (errmsg, "Overflow of dim_name[0] string");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            if (xml_metadata->global.proj_info.proj_type == GCTP_GEO)
-                mycount = ngrids;
-            else
-                mycount = (int) xml_metadata->band[i].pixel_size[0]; /* X dim */
-
-            count = snprintf (dim_name[1], sizeof (dim_name[1]), "XDim_%d",
-                mycount);  /* X dim */
-            if (count < 0 || count >= sizeof (dim_name[1]))
-            {
-                sprintf (errmsg, "Overflow of dim_name[1] string");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-        }
-
-        /* Write the dimension names to the HDF file */
-        for (dim = 0; dim < rank; dim++)
-        {
-            dim_id = SDgetdimid (sds_id, dim);
-            if (dim_id == HDF_ERROR) 
-            {
-                sprintf (errmsg, "Getting dimension id for dimension %d and "
-                    "SDS %d.", dim, i);
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            if (SDsetdimname (dim_id, dim_name[dim]) == HDF_ERROR)
-            {
-                sprintf (errmsg, "Setting dimension name (%s) for dimension "
-                    "%d and SDS %d.", dim_name[dim], dim, i);
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-        }
-
-        /* Identify the external dataset for this SDS, starting at byte
-           location 0 since these are raw binary files without any headers */
-        if (SDsetexternalfile (sds_id, bendian_file, 0 /* offset */) ==
-            HDF_ERROR)
-        {
-            sprintf (errmsg, "Setting the external dataset for this SDS (%d): "
-                "%s.", i, bendian_file);
-            error_handler (true, FUNC_NAME, errmsg);
-            return (ERROR);
-        }
-
-        /* Write the new big endian data to the SDS.  Start writing at the
-           beginning of the SDS, write every element, and write all the
-           elements in both dimensions. */
-        start[0] = start[1] = 0;
-        edge[0] = dims[0];
-        edge[1] = dims[1];
-        if (SDwritedata (sds_id, start, NULL, edge, file_buf) == HDF_ERROR)
-        {
-            sprintf (errmsg, "Writing the external dataset for this SDS (%d): "
-                "%s.", i, bendian_file);
-            error_handler (true, FUNC_NAME, errmsg);
+        /* Wait for the reader to deliver this band */
+        slot = i % HDF_PIPELINE_DEPTH;
+        pthread_mutex_lock (&ring.lock);
+        while (!ring.buf_full[slot])
+            pthread_cond_wait (&ring.slot_full, &ring.lock);
+        pthread_mutex_unlock (&ring.lock);
+
+        if (ring.buf_status[slot] != SUCCESS)
+        {   /* the reader already printed the error message */
+            free (attr_text);
+            shutdown_band_ring (&ring, reader);
             return (ERROR);
         }
-
-        /* Write the SDS-level metadata */
-        if (write_sds_attributes (sds_id, &xml_metadata->band[i]) != SUCCESS)
-        {
-            sprintf (errmsg, "Writing band attributes for this SDS (%d).", i);
-            error_handler (true, FUNC_NAME, errmsg);
+        file_buf = ring.buf[slot];
+
+        /* Create the SDS for this band and write its data and attributes */
+        if (write_band_sds (hdf_id, xml_metadata, i, &ngrids, file_buf,
+            &attr_text[i]) != SUCCESS)
+        {   /* Error messages already printed */
+            free (attr_text);
+            shutdown_band_ring (&ring, reader);
             return (ERROR);
         }
 
-        /* Terminate access to the data set and SD interface */
-        SDendaccess (sds_id);
-
-        /* Free the file buffer */
-        free (file_buf);
+        /* Hand the slot back to the reader for the next band */
+        pthread_mutex_lock (&ring.lock);
+        ring.buf_full[slot] = false;
+        pthread_cond_signal (&ring.slot_empty);
+        pthread_mutex_unlock (&ring.lock);
         file_buf = NULL;
 
         /* Remove the source files if specified */
         if (del_src)
         {
-            /* .img file */
-            printf ("  Removing %s\n", xml_metadata->band[i].file_name);
-            if (unlink (xml_metadata->band[i].file_name) != 0)
-            {
-                sprintf (errmsg, "Deleting source file: %s",
-                    xml_metadata->band[i].file_name);
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            /* .hdr file */
-            count = snprintf (hdr_file, sizeof (hdr_file), "%s",
-                xml_metadata->band[i].file_name);
-            if (count < 0 || count >= sizeof (hdr_file))
-            {
-                sprintf (errmsg, "Overflow of hdr_file string");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            cptr = strrchr (hdr_file, '.');
-            strcpy (cptr, ".hdr");
-            printf ("  Removing %s\n", hdr_file);
-            if (unlink (hdr_file) != 0)
-            {
-                sprintf (errmsg, "Deleting source file: %s", hdr_file);
-                error_handler (true, FUNC_NAME, errmsg);
+            if (remove_band_source (&xml_metadata->band[i]) != SUCCESS)
+            {   /* Error messages already printed */
+                free (attr_text);
+                shutdown_band_ring (&ring, reader);
                 return (ERROR);
             }
         }
     }
 
+    /* All the bands have been converted, so shut down the reader thread and
+       release the band buffers */
+    free (attr_text);
+    shutdown_band_ring (&ring, reader);
+
     /* Write the global metadata */
     if (write_global_attributes (hdf_id, xml_metadata) != SUCCESS)
     {
@@ -965,9 +2137,10 @@ int create_hdf_metadata
 
 
 /******************************************************************************
-MODULE:  convert_espa_to_hdf
+MODULE:  convert_espa_to_hdf_meta (static function)
 
-PURPOSE: Converts the internal ESPA raw binary file to HDF4 file format.
+PURPOSE: Converts the internal ESPA raw binary file to HDF4 file format,
+working from metadata the caller has already parsed.
 
 RETURN VALUE:
 Type = int
@@ -987,6 +2160,12 @@ Date         Programmer       Reason
 12/8/2014    Gail Schmidt     Delete the source files immediately after the
                               new big endian files are created vs. doing the
                               cleanup after all the bands have been converted
+8/31/2026    Gail Schmidt     Pulled the conversion out of convert_espa_to_hdf
+                              to work from metadata the caller already parsed
+8/31/2026    Gail Schmidt     Point the bands of a compressed HDF product at
+                              the HDF file itself
+8/31/2026    Gail Schmidt     Filter the bands before conversion so the
+                              unwanted bands are never read
 
 NOTES:
   1. The ESPA raw binary band files will be used, as-is, and linked to as
@@ -994,15 +2173,21 @@ NOTES:
   2. An ENVI header file will be written for the HDF files which contain
      SDSs of the same resolution (i.e. not a multi-resolution product).
 ******************************************************************************/
-int convert_espa_to_hdf
+static int convert_espa_to_hdf_meta
 (
+    Espa_internal_meta_t *xml_metadata,  /* I/O: parsed metadata for the
+                                 scene; the band filenames are updated for
+                                 the HDF product */
     char *espa_xml_file,   /* I: input ESPA XML metadata filename */
     char *hdf_file,        /* I: output HDF filename */
+    char *band_filter,     /* I: comma-separated band filter (band names,
+                                 product:<type>, category:<cat> entries);
+                                 NULL or empty converts every band */
     bool del_src           /* I: should the source files be removed after
                                  conversion? */
 )
 {
-    char FUNC_NAME[] = "convert_espa_to_hdf";  /* function name */
+    char FUNC_NAME[] = "convert_espa_to_hdf_meta";  /* function name */
     char errmsg[STR_SIZE];   /* error message */
     char hdr_file[STR_SIZE]; /* ENVI header file */
     char xml_file[STR_SIZE]; /* new XML file for the HDF product */
@@ -1011,30 +2196,20 @@ int convert_espa_to_hdf
     int i;                   /* looping variable */
     int count;               /* number of chars copied in snprintf */
     bool multires;           /* is this a multi-resolution product */
-    Espa_internal_meta_t xml_metadata;  /* XML metadata structure to be
-                                populated by reading the MTL metadata file */
     Envi_header_t envi_hdr;  /* output ENVI header information */
 
-    /* Validate the input metadata file */
-    if (validate_xml_file (espa_xml_file) != SUCCESS)
-    {  /* Error messages already written */
-        return (ERROR);
-    }
-
-    /* Initialize the metadata structure */
-    init_metadata_struct (&xml_metadata);
-
-    /* Parse the metadata file into our internal metadata structure; also
-       allocates space as needed for various pointers in the global and band
-       metadata */
-    if (parse_metadata (espa_xml_file, &xml_metadata) != SUCCESS)
-    {  /* Error messages already written */
+    /* Filter the bands before anything is created so the unwanted bands
+       are never read or converted */
+    if (prune_metadata_bands (xml_metadata, band_filter) != SUCCESS)
+    {
+        sprintf (errmsg, "Filtering the bands for the HDF product");
+        error_handler (true, FUNC_NAME, errmsg);
         return (ERROR);
     }
 
     /* Create the HDF file for the HDF metadata from the XML metadata.  This
        also creates the big endian files for the HDF file. */
-    if (create_hdf_metadata (hdf_file, &xml_metadata, del_src) != SUCCESS)
+    if (create_hdf_metadata (hdf_file, xml_metadata, del_src) != SUCCESS)
     {
         sprintf (errmsg, "Creating the HDF metadata file (%s) which links to "
             "the raw binary bands as external SDSs.", hdf_file);
@@ -1045,18 +2220,18 @@ int convert_espa_to_hdf
     /* If this is not a multi-resolution product, then write out the ENVI
        header for the HDF product */
     multires = false;
-    for (i = 0; i < xml_metadata.nbands; i++)
+    for (i = 0; i < xml_metadata->nbands; i++)
     {
-        if ((xml_metadata.band[i].pixel_size[0] !=
-             xml_metadata.band[0].pixel_size[0]) ||
-            (xml_metadata.band[i].pixel_size[1] !=
-             xml_metadata.band[0].pixel_size[1]))
+        if ((xml_metadata->band[i].pixel_size[0] !=
+             xml_metadata->band[0].pixel_size[0]) ||
+            (xml_metadata->band[i].pixel_size[1] !=
+             xml_metadata->band[0].pixel_size[1]))
             multires = true;
     }
     if (!multires)
     {
         /* Create the ENVI structure using the first band */
-        if (create_envi_struct (&xml_metadata.band[0], &xml_metadata.global,
+        if (create_envi_struct (&xml_metadata->band[0], &xml_metadata->global,
             &envi_hdr) != SUCCESS)
         {
             sprintf (errmsg, "Creating the ENVI header for %s", hdf_file);
@@ -1066,7 +2241,7 @@ int convert_espa_to_hdf
 
         /* Make sure the number of bands being written doesn't exceed the
            maximum defined ENVI header bands */
-        if (xml_metadata.nbands > MAX_ENVI_BANDS)
+        if (xml_metadata->nbands > MAX_ENVI_BANDS)
         {
             sprintf (errmsg, "Number of bands being written exceeds the "
                 "predefined maximum of bands in envi_header.h: %d",
@@ -1077,7 +2252,7 @@ int convert_espa_to_hdf
 
         /* Update a few of the parameters in the header file since this is
            a multiband product */
-        envi_hdr.nbands = xml_metadata.nbands;
+        envi_hdr.nbands = xml_metadata->nbands;
         count = snprintf (envi_hdr.file_type, sizeof (envi_hdr.file_type),
             "HDF scientific data");
         if (count < 0 || count >= sizeof (envi_hdr.file_type))
@@ -1086,11 +2261,11 @@ int convert_espa_to_hdf
             error_handler (true, FUNC_NAME, errmsg);
             return (ERROR);
         }
-        for (i = 0; i < xml_metadata.nbands; i++)
+        for (i = 0; i < xml_metadata->nbands; i++)
         {
             count = snprintf (envi_hdr.band_names[i],
                 sizeof (envi_hdr.band_names[i]), "%s",
-                xml_metadata.band[i].long_name);
+                xml_metadata->band[i].long_name);
             if (count < 0 || count >= sizeof (envi_hdr.band_names[i]))
             {
                 sprintf (errmsg, "Overflow of envi_hdr.band_names[i] string");
@@ -1136,11 +2311,19 @@ int convert_espa_to_hdf
     }
 
     /* Loop through the bands and modify the band names to match the new
-       (external) raw binary filenames in the HDF product */
-    for (i = 0; i < xml_metadata.nbands; i++)
+       (external) raw binary filenames in the HDF product.  With compressed
+       output the band data lives inside the HDF file itself, so the bands
+       point at the HDF file instead */
+    for (i = 0; i < xml_metadata->nbands; i++)
     {
+        if (hdf_compress_mode () != 0)
+        {
+            strcpy (xml_metadata->band[i].file_name, hdf_file);
+            continue;
+        }
+
         count = snprintf (bendian_file, sizeof (bendian_file), "%s",
-            xml_metadata.band[i].file_name);
+            xml_metadata->band[i].file_name);
         if (count < 0 || count >= sizeof (bendian_file))
         {
             sprintf (errmsg, "Overflow of bendian_file string");
@@ -1154,7 +2337,7 @@ int convert_espa_to_hdf
         strcpy (cptr, "_hdf.img");
 
         /* Update the XML file to use the new band names */
-        strcpy (xml_metadata.band[i].file_name, bendian_file);
+        strcpy (xml_metadata->band[i].file_name, bendian_file);
     }
 
     /* Create the XML file for the HDF product */
@@ -1172,7 +2355,7 @@ int convert_espa_to_hdf
     strcpy (cptr, "_hdf.xml");
 
     /* Write the new XML file containing the new band names */
-    if (write_metadata (&xml_metadata, xml_file) != SUCCESS)
+    if (write_metadata (xml_metadata, xml_file) != SUCCESS)
     {
         sprintf (errmsg, "Error writing updated XML for the HDF product: %s",
             xml_file);
@@ -1180,10 +2363,145 @@ int convert_espa_to_hdf
         return (ERROR);
     }
 
+    /* Successful conversion */
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  convert_espa_to_hdf_scene
+
+PURPOSE: Converts the internal ESPA raw binary file to HDF4 file format,
+reusing the metadata cached in the scene context by an earlier stage.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error converting to HDF
+SUCCESS         Successfully converted to HDF
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Wait on any write-behind from the previous stage
+                              before reading or removing the scene files
+8/31/2026    Gail Schmidt     Added the band filter pass-through
+
+NOTES:
+  1. This stage modifies the band filenames in the metadata for the HDF
+     product, so the cached metadata is invalidated when it finishes.
+******************************************************************************/
+int convert_espa_to_hdf_scene
+(
+    Espa_scene_context_t *context,  /* I/O: scene context holding the cached
+                                 scene metadata */
+    char *espa_xml_file,   /* I: input ESPA XML metadata filename */
+    char *hdf_file,        /* I: output HDF filename */
+    char *band_filter,     /* I: comma-separated band filter (band names,
+                                 product:<type>, category:<cat> entries);
+                                 NULL or empty converts every band */
+    bool del_src           /* I: should the source files be removed after
+                                 conversion? */
+)
+{
+    char FUNC_NAME[] = "convert_espa_to_hdf_scene";  /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    int status;              /* status of the conversion */
+
+    /* Complete any metadata/header write-behind queued by the previous
+       stage before this stage reads the scene files back or removes them */
+    if (wait_scene_context_writes (context) != SUCCESS)
+    {
+        sprintf (errmsg, "Completing the queued writes for the scene");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Make sure the context holds this scene's metadata; the parse is
+       skipped when an earlier stage left it cached */
+    if (load_scene_context_metadata (context, espa_xml_file) != SUCCESS)
+    {
+        sprintf (errmsg, "Loading the scene metadata from: %s",
+            espa_xml_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    status = convert_espa_to_hdf_meta (&context->xml_metadata, espa_xml_file,
+        hdf_file, band_filter, del_src);
+
+    /* The band filenames in the metadata were rewritten for the HDF
+       product, so release the cached copy */
+    invalidate_scene_context_metadata (context);
+
+    return (status);
+}
+
+
+/******************************************************************************
+MODULE:  convert_espa_to_hdf
+
+PURPOSE: Converts the internal ESPA raw binary file to HDF4 file format,
+without a scene context.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error converting to HDF
+SUCCESS         Successfully converted to HDF
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development, pulled from the previous
+                              convert_espa_to_hdf when the scene context
+                              variant was added
+8/31/2026    Gail Schmidt     Added the band filter pass-through
+
+NOTES:
+******************************************************************************/
+int convert_espa_to_hdf
+(
+    char *espa_xml_file,   /* I: input ESPA XML metadata filename */
+    char *hdf_file,        /* I: output HDF filename */
+    char *band_filter,     /* I: comma-separated band filter (band names,
+                                 product:<type>, category:<cat> entries);
+                                 NULL or empty converts every band */
+    bool del_src           /* I: should the source files be removed after
+                                 conversion? */
+)
+{
+    int status;              /* status of the conversion */
+    Espa_internal_meta_t xml_metadata;  /* XML metadata structure to be
+                                populated by reading the XML metadata file */
+
+    /* Validate the input metadata file */
+    if (validate_xml_file (espa_xml_file) != SUCCESS)
+    {  /* Error messages already written */
+        return (ERROR);
+    }
+
+    /* Initialize the metadata structure */
+    init_metadata_struct (&xml_metadata);
+
+    /* Parse the metadata file into our internal metadata structure; also
+       allocates space as needed for various pointers in the global and band
+       metadata */
+    if (parse_metadata (espa_xml_file, &xml_metadata) != SUCCESS)
+    {  /* Error messages already written */
+        return (ERROR);
+    }
+
+    /* Convert the scene to HDF */
+    status = convert_espa_to_hdf_meta (&xml_metadata, espa_xml_file,
+        hdf_file, band_filter, del_src);
+
     /* Free the metadata structure */
     free_metadata (&xml_metadata);
 
-    /* Successful conversion */
-    return (SUCCESS);
+    return (status);
 }
 
@@ -13,6 +13,9 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 1/6/2014     Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added the preassembled band description strings
+                              so they can be built ahead of the HDF writes
+8/31/2026    Gail Schmidt     Added the band filter pass-through
 
 NOTES:
 *****************************************************************************/
@@ -33,11 +36,30 @@ NOTES:
 #include "espa_hdf_eos.h"
 #include "envi_header.h"
 #include "raw_binary_io.h"
+#include "espa_scene_context.h"
+#include "subset_metadata.h"
 
 /* Defines */
 #define HDF_ERROR -1
 
+/* maximum size of the bitmap and class description strings */
+#define ESPA_SDS_DESC_SIZE 5000
+
+/* Preassembled bitmap and class description strings for one band.  An empty
+   string means the band doesn't have that description. */
+typedef struct espa_sds_attr_text_t
+{
+    char bitmap_msg[ESPA_SDS_DESC_SIZE];  /* bitmap description attribute */
+    char class_msg[ESPA_SDS_DESC_SIZE];   /* class description attribute */
+} Espa_sds_attr_text_t;
+
 /* Prototypes */
+int assemble_sds_descriptions
+(
+    Espa_band_meta_t *bmeta,          /* I: pointer to band metadata struct */
+    Espa_sds_attr_text_t *attr_text   /* O: assembled description strings */
+);
+
 int write_global_attributes
 (
     int32 hdf_id,               /* I: HDF file ID to write attributes */
@@ -47,7 +69,10 @@ int write_global_attributes
 int write_sds_attributes
 (
     int32 sds_id,             /* I: SDS ID to write attributes */
-    Espa_band_meta_t *bmeta   /* I: pointer to band metadata structure */
+    Espa_band_meta_t *bmeta,  /* I: pointer to band metadata structure */
+    Espa_sds_attr_text_t *attr_text  /* I: preassembled description strings
+                                           for this band, or NULL to have
+                                           them assembled here */
 );
 
 int create_hdf_metadata
@@ -58,10 +83,26 @@ int create_hdf_metadata
                                  conversion? */
 );
 
+int convert_espa_to_hdf_scene
+(
+    Espa_scene_context_t *context,  /* I/O: scene context holding the cached
+                                 scene metadata */
+    char *espa_xml_file,   /* I: input ESPA XML metadata filename */
+    char *hdf_file,        /* I: output HDF filename */
+    char *band_filter,     /* I: comma-separated band filter (band names,
+                                 product:<type>, category:<cat> entries);
+                                 NULL or empty converts every band */
+    bool del_src           /* I: should the source files be removed after
+                                 conversion? */
+);
+
 int convert_espa_to_hdf
 (
     char *espa_xml_file,   /* I: input ESPA XML metadata filename */
     char *hdf_file,        /* I: output HDF filename */
+    char *band_filter,     /* I: comma-separated band filter (band names,
+                                 product:<type>, category:<cat> entries);
+                                 NULL or empty converts every band */
     bool del_src           /* I: should the source files be removed after
                                  conversion? */
 );
@@ -14,6 +14,10 @@ Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 12/30/2013   Gail Schmidt     Original development
 6/17/2014    Gail Schmidt     Updated to support L8
+8/31/2026    Gail Schmidt     Added cooperative cancellation checkpoints so
+                              preempted jobs unwind cleanly
+8/31/2026    Gail Schmidt     Added checkpoint/resume of the band conversions
+                              through a sidecar manifest (set ESPA_RESUME)
 
 NOTES:
   1. The XML metadata format written via this library follows the ESPA internal
@@ -23,7 +27,536 @@ NOTES:
 *****************************************************************************/
 #include <unistd.h>
 #include <math.h>
+#include <pthread.h>
+#include "gzip_input.h"
 #include "convert_lpgs_to_espa.h"
+#include "espa_convert_kernels.h"
+#include "espa_perf.h"
+#include "espa_thread_pool.h"
+#include "espa_buffer.h"
+#include "espa_cancel.h"
+#include "espa_resume.h"
+
+/* Number of slots in the MTL key/value table; must be a power of two and
+   comfortably larger than the number of parameters in an MTL file */
+#define MTL_TABLE_SIZE 1024
+
+/* Maximum size of an MTL parameter name */
+#define MTL_KEY_SIZE 64
+
+/* Single KEY = VALUE pair parsed from the MTL file */
+typedef struct
+{
+    char key[MTL_KEY_SIZE];   /* parameter name; empty if the slot is open */
+    char value[STR_SIZE];     /* first token of the parameter value */
+} Mtl_pair_t;
+
+/* Band label suffixes for each band slot by instrument.  The band-related
+   MTL parameters are labeled by band number, which maps to a different band
+   slot per instrument since bands 6L and 6H throw off the count for ETM+.
+   The *_old suffixes are used by the old-style LPGS tags (BANDx_FILE_NAME,
+   QCALMIN_BANDx, ...). */
+static const char *tm_band_suffix[] =
+    {"1", "2", "3", "4", "5", "6", "7"};
+static const char *etm_band_suffix[] =
+    {"1", "2", "3", "4", "5", "6_VCID_1", "6_VCID_2", "7", "8"};
+static const char *etm_band_suffix_old[] =
+    {"1", "2", "3", "4", "5", "61", "62", "7", "8"};
+static const char *oli_band_suffix[] =
+    {"1", "2", "3", "4", "5", "6", "7", "8", "9", "10", "11"};
+
+/* Band slot roles for the per-instrument band tables */
+typedef enum
+{
+    LPGS_BAND_REFLECTIVE,  /* reflective band at the scene resolution */
+    LPGS_BAND_THERMAL,     /* thermal band at the thermal resolution */
+    LPGS_BAND_PAN,         /* panchromatic band at the pan resolution */
+    LPGS_BAND_QUALITY      /* quality band at the scene resolution */
+} Lpgs_band_role_t;
+
+/* Attributes of one band slot in an instrument's band table */
+typedef struct
+{
+    const char *name;       /* band name for the output metadata */
+    const char *long_name;  /* long band name for the output metadata */
+    const char *file_tag;   /* band tag for the output filename */
+    Lpgs_band_role_t role;  /* role deciding the dimensions and constants */
+} Lpgs_band_slot_t;
+
+/* Per-instrument band table driver, selected once from the instrument in
+   the MTL file.  The per-band instrument conditionals become lookups into
+   the slot table, and support for a new sensor is a new table. */
+typedef struct
+{
+    const Lpgs_band_slot_t *slots;  /* band slot attribute table */
+    int nbands;             /* number of bands in the output product */
+    int nband_slots;        /* number of slots labeled by band number */
+    int qa_slot;            /* slot of the quality band, or -1 if none */
+    const char *const *suffix;     /* band label suffix per band slot */
+    const char *const *suffix_old; /* old-style band label suffixes */
+    int data_type;          /* data type of every band (Espa_data_type) */
+    int fill_value;         /* fill value of every band */
+    const char *short_name; /* product short name, or NULL when it depends
+                               on the satellite (TM flew on L4 and L5) */
+    bool refl_by_role;      /* do the reflectance gain/bias apply to the
+                               non-thermal slots?  false keeps the OLI-only
+                               behavior of storing K1/K2 for every band */
+} Lpgs_instrument_t;
+
+static const Lpgs_band_slot_t tm_band_slots[] =
+{
+    {"band1", "band 1 digital numbers", "B1", LPGS_BAND_REFLECTIVE},
+    {"band2", "band 2 digital numbers", "B2", LPGS_BAND_REFLECTIVE},
+    {"band3", "band 3 digital numbers", "B3", LPGS_BAND_REFLECTIVE},
+    {"band4", "band 4 digital numbers", "B4", LPGS_BAND_REFLECTIVE},
+    {"band5", "band 5 digital numbers", "B5", LPGS_BAND_REFLECTIVE},
+    {"band6", "band 6 digital numbers", "B6", LPGS_BAND_THERMAL},
+    {"band7", "band 7 digital numbers", "B7", LPGS_BAND_REFLECTIVE}
+};
+
+static const Lpgs_band_slot_t etm_band_slots[] =
+{
+    {"band1", "band 1 digital numbers", "B1", LPGS_BAND_REFLECTIVE},
+    {"band2", "band 2 digital numbers", "B2", LPGS_BAND_REFLECTIVE},
+    {"band3", "band 3 digital numbers", "B3", LPGS_BAND_REFLECTIVE},
+    {"band4", "band 4 digital numbers", "B4", LPGS_BAND_REFLECTIVE},
+    {"band5", "band 5 digital numbers", "B5", LPGS_BAND_REFLECTIVE},
+    {"band61", "band 61 digital numbers", "B61", LPGS_BAND_THERMAL},
+    {"band62", "band 62 digital numbers", "B62", LPGS_BAND_THERMAL},
+    {"band7", "band 7 digital numbers", "B7", LPGS_BAND_REFLECTIVE},
+    {"band8", "band 8 digital numbers", "B8", LPGS_BAND_PAN}
+};
+
+static const Lpgs_band_slot_t oli_tirs_band_slots[] =
+{
+    {"band1", "band 1 digital numbers", "B1", LPGS_BAND_REFLECTIVE},
+    {"band2", "band 2 digital numbers", "B2", LPGS_BAND_REFLECTIVE},
+    {"band3", "band 3 digital numbers", "B3", LPGS_BAND_REFLECTIVE},
+    {"band4", "band 4 digital numbers", "B4", LPGS_BAND_REFLECTIVE},
+    {"band5", "band 5 digital numbers", "B5", LPGS_BAND_REFLECTIVE},
+    {"band6", "band 6 digital numbers", "B6", LPGS_BAND_REFLECTIVE},
+    {"band7", "band 7 digital numbers", "B7", LPGS_BAND_REFLECTIVE},
+    {"band8", "band 8 digital numbers", "B8", LPGS_BAND_PAN},
+    {"band9", "band 9 digital numbers", "B9", LPGS_BAND_REFLECTIVE},
+    {"band10", "band 10 digital numbers", "B10", LPGS_BAND_THERMAL},
+    {"band11", "band 11 digital numbers", "B11", LPGS_BAND_THERMAL},
+    {"qa", "band quality", "BQA", LPGS_BAND_QUALITY}
+};
+
+static const Lpgs_band_slot_t oli_band_slots[] =
+{
+    {"band1", "band 1 digital numbers", "B1", LPGS_BAND_REFLECTIVE},
+    {"band2", "band 2 digital numbers", "B2", LPGS_BAND_REFLECTIVE},
+    {"band3", "band 3 digital numbers", "B3", LPGS_BAND_REFLECTIVE},
+    {"band4", "band 4 digital numbers", "B4", LPGS_BAND_REFLECTIVE},
+    {"band5", "band 5 digital numbers", "B5", LPGS_BAND_REFLECTIVE},
+    {"band6", "band 6 digital numbers", "B6", LPGS_BAND_REFLECTIVE},
+    {"band7", "band 7 digital numbers", "B7", LPGS_BAND_REFLECTIVE},
+    {"band8", "band 8 digital numbers", "B8", LPGS_BAND_PAN},
+    {"band9", "band 9 digital numbers", "B9", LPGS_BAND_REFLECTIVE},
+    {"qa", "band quality", "BQA", LPGS_BAND_QUALITY}
+};
+
+static const Lpgs_instrument_t tm_instrument =
+    {tm_band_slots, 7, 7, -1, tm_band_suffix, tm_band_suffix,
+     ESPA_UINT8, 0, NULL, true};
+static const Lpgs_instrument_t etm_instrument =
+    {etm_band_slots, 9, 9, -1, etm_band_suffix, etm_band_suffix_old,
+     ESPA_UINT8, 0, "LE7DN", true};
+static const Lpgs_instrument_t oli_tirs_instrument =
+    {oli_tirs_band_slots, 12, 11, 11, oli_band_suffix, oli_band_suffix,
+     ESPA_UINT16, 0, "LC8DN", true};
+static const Lpgs_instrument_t oli_instrument =
+    {oli_band_slots, 10, 9, 9, oli_band_suffix, oli_band_suffix,
+     ESPA_UINT16, 0, "LO8DN", false};
+
+
+/******************************************************************************
+MODULE:  lpgs_instrument_driver
+
+PURPOSE: Select the band table driver for an instrument.
+
+RETURN VALUE:
+Type = const Lpgs_instrument_t *
+Value           Description
+-----           -----------
+NULL            The instrument is not supported
+(driver)        Band table driver for the instrument
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static const Lpgs_instrument_t *lpgs_instrument_driver
+(
+    const char *instrument    /* I: instrument name from the MTL file */
+)
+{
+    if (!strcmp (instrument, "TM"))
+        return (&tm_instrument);
+    else if (!strncmp (instrument, "ETM", 3))
+        return (&etm_instrument);
+    else if (!strcmp (instrument, "OLI_TIRS"))
+        return (&oli_tirs_instrument);
+    else if (!strcmp (instrument, "OLI"))
+        return (&oli_instrument);
+
+    return (NULL);
+}
+
+
+/******************************************************************************
+MODULE:  mtl_hash
+
+PURPOSE: Hash an MTL parameter name for the key/value table.
+
+RETURN VALUE:
+Type = unsigned int
+Value           Description
+-----           -----------
+(hash)          Hash value of the parameter name
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static unsigned int mtl_hash
+(
+    const char *key,          /* I: parameter name to be hashed */
+    int key_len               /* I: length of the parameter name */
+)
+{
+    unsigned int hash = 5381; /* running hash value */
+
+    while (key_len-- > 0)
+        hash = hash * 33 + (unsigned char) *key++;
+
+    return (hash);
+}
+
+
+/******************************************************************************
+MODULE:  mtl_insert
+
+PURPOSE: Insert a KEY = VALUE pair into the MTL key/value table.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           The table is full
+SUCCESS         Successfully inserted the pair
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Keys too long for the table can never be looked up, so they are skipped;
+     the MTL parameters we care about are all short.
+  2. If the key is already in the table the last value wins, matching the
+     previous line-by-line parsing behavior.
+  3. The key and value reference the mapped MTL file and are not
+     NUL-terminated; this copy into the table is the only copy made before
+     the values land in the final metadata fields.
+******************************************************************************/
+static int mtl_insert
+(
+    Mtl_pair_t *mtl_table,    /* I/O: table of MTL_TABLE_SIZE pairs */
+    const char *key,          /* I: parameter name */
+    int key_len,              /* I: length of the parameter name */
+    const char *value,        /* I: parameter value */
+    int value_len             /* I: length of the parameter value */
+)
+{
+    unsigned int slot;        /* current slot in the table */
+    int probes;               /* number of slots probed */
+
+    if (key_len >= (int) sizeof (mtl_table[0].key))
+        return (SUCCESS);
+    if (value_len >= (int) sizeof (mtl_table[0].value))
+        value_len = (int) sizeof (mtl_table[0].value) - 1;
+
+    slot = mtl_hash (key, key_len) & (MTL_TABLE_SIZE - 1);
+    for (probes = 0; probes < MTL_TABLE_SIZE; probes++)
+    {
+        if (mtl_table[slot].key[0] == '\0' ||
+            (!strncmp (mtl_table[slot].key, key, key_len) &&
+             mtl_table[slot].key[key_len] == '\0'))
+        {
+            memcpy (mtl_table[slot].key, key, key_len);
+            mtl_table[slot].key[key_len] = '\0';
+            memcpy (mtl_table[slot].value, value, value_len);
+            mtl_table[slot].value[value_len] = '\0';
+            return (SUCCESS);
+        }
+        slot = (slot + 1) & (MTL_TABLE_SIZE - 1);
+    }
+
+    return (ERROR);
+}
+
+
+/******************************************************************************
+MODULE:  mtl_find
+
+PURPOSE: Look up an MTL parameter in the key/value table.
+
+RETURN VALUE:
+Type = const char *
+Value           Description
+-----           -----------
+NULL            The parameter is not in the table
+(value)         Value of the parameter
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static const char *mtl_find
+(
+    const Mtl_pair_t *mtl_table,  /* I: table of MTL_TABLE_SIZE pairs */
+    const char *key           /* I: parameter name to be looked up */
+)
+{
+    unsigned int slot;        /* current slot in the table */
+    int probes;               /* number of slots probed */
+
+    slot = mtl_hash (key, strlen (key)) & (MTL_TABLE_SIZE - 1);
+    for (probes = 0; probes < MTL_TABLE_SIZE; probes++)
+    {
+        if (mtl_table[slot].key[0] == '\0')
+            return (NULL);
+        if (!strcmp (mtl_table[slot].key, key))
+            return (mtl_table[slot].value);
+        slot = (slot + 1) & (MTL_TABLE_SIZE - 1);
+    }
+
+    return (NULL);
+}
+
+
+/******************************************************************************
+MODULE:  mtl_find2
+
+PURPOSE: Look up an MTL parameter by its new-style tag, falling back to the
+old-style tag.
+
+RETURN VALUE:
+Type = const char *
+Value           Description
+-----           -----------
+NULL            Neither tag is in the table
+(value)         Value of the parameter
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static const char *mtl_find2
+(
+    const Mtl_pair_t *mtl_table,  /* I: table of MTL_TABLE_SIZE pairs */
+    const char *key1,         /* I: new-style parameter name */
+    const char *key2          /* I: old-style parameter name or NULL */
+)
+{
+    const char *val;          /* value of the parameter */
+
+    val = mtl_find (mtl_table, key1);
+    if (val == NULL && key2 != NULL)
+        val = mtl_find (mtl_table, key2);
+
+    return (val);
+}
+
+
+/******************************************************************************
+MODULE:  mtl_copy_field
+
+PURPOSE: Copy the value of an MTL parameter to a string field, checking for
+overflow.  The field is left untouched if the parameter is not in the table.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           The value overflows the field
+SUCCESS         Successfully copied the value (or the parameter was missing)
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static int mtl_copy_field
+(
+    const Mtl_pair_t *mtl_table,  /* I: table of MTL_TABLE_SIZE pairs */
+    const char *key1,         /* I: new-style parameter name */
+    const char *key2,         /* I: old-style parameter name or NULL */
+    char *field,              /* O: string field to be filled */
+    size_t field_size,        /* I: size of the string field */
+    const char *field_name    /* I: name of the field for error messages */
+)
+{
+    char FUNC_NAME[] = "mtl_copy_field";  /* function name */
+    char errmsg[STR_SIZE];    /* error message */
+    int count;                /* number of chars copied in snprintf */
+    const char *val;          /* value of the parameter */
+
+    val = mtl_find2 (mtl_table, key1, key2);
+    if (val == NULL)
+        return (SUCCESS);
+
+    count = snprintf (field, field_size, "%s", val);
+    if (count < 0 || count >= field_size)
+    {
+        sprintf (errmsg, "Overflow of the %s string", field_name);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  mtl_separator
+
+PURPOSE: Identify the characters which separate the tokens of an MTL line.
+
+RETURN VALUE:
+Type = bool
+Value           Description
+-----           -----------
+true            The character separates tokens
+false           The character is part of a token
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static bool mtl_separator
+(
+    char c                    /* I: character from the MTL line */
+)
+{
+    return (c == '=' || c == '"' || c == ' ' || c == '\t' || c == '\r');
+}
+
+
+/******************************************************************************
+MODULE:  load_mtl_table
+
+PURPOSE: Tokenize the mapped MTL file contents in a single pass, splitting
+each line into a KEY = VALUE pair and inserting it into the key/value table.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error loading the MTL contents into the table
+SUCCESS         Successfully loaded the table
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Tokenize the mapped file contents in place
+                              instead of reading the file line by line
+
+NOTES:
+  1. The tokens reference the read-only mapping, so the mapping is scanned
+     without any per-line reads, allocations, or copies; the values are
+     copied once, into the key/value table.
+******************************************************************************/
+static int load_mtl_table
+(
+    const char *mtl_text,     /* I: mapped contents of the MTL file */
+    size_t mtl_length,        /* I: length of the MTL file in bytes */
+    Mtl_pair_t *mtl_table     /* O: table of MTL_TABLE_SIZE pairs, which
+                                    should be zeroed on input */
+)
+{
+    char FUNC_NAME[] = "load_mtl_table";  /* function name */
+    char errmsg[STR_SIZE];    /* error message */
+    const char *end = mtl_text + mtl_length;  /* end of the MTL contents */
+    const char *line = mtl_text;  /* start of the current line */
+    const char *line_end = NULL;  /* end of the current line */
+    const char *label = NULL; /* label token in the line */
+    const char *value = NULL; /* value token in the line */
+    int label_len;            /* length of the label token */
+    int value_len;            /* length of the value token */
+
+    while (line < end)
+    {
+        /* Find the end of the line */
+        line_end = memchr (line, '\n', end - line);
+        if (line_end == NULL)
+            line_end = end;
+
+        /* Get the label token */
+        label = line;
+        while (label < line_end && mtl_separator (*label))
+            label++;
+        label_len = 0;
+        while (label + label_len < line_end &&
+               !mtl_separator (label[label_len]))
+            label_len++;
+
+        /* Advance to the next line */
+        line = (line_end < end) ? line_end + 1 : end;
+
+        /* Skip blank lines */
+        if (label_len == 0)
+            continue;
+
+        /* Quit when the end of the MTL file is reached */
+        if (label_len == 3 && !strncmp (label, "END", 3))
+            break;
+
+        /* Get the value token, skipping labels without a value (GROUP
+           terminators) */
+        value = label + label_len;
+        while (value < line_end && mtl_separator (*value))
+            value++;
+        value_len = 0;
+        while (value + value_len < line_end &&
+               !mtl_separator (value[value_len]))
+            value_len++;
+        if (value_len == 0)
+            continue;
+
+        if (mtl_insert (mtl_table, label, label_len, value, value_len)
+            != SUCCESS)
+        {
+            sprintf (errmsg, "Too many parameters in the MTL file for the "
+                "key/value table (%d slots)", MTL_TABLE_SIZE);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+    }
+
+    return (SUCCESS);
+}
+
 
 /******************************************************************************
 MODULE:  read_lpgs_mtl
@@ -52,6 +585,18 @@ Date         Programmer       Reason
                               gain/bias, and K1/K2 constants. Changed
                               toa_gain/bias to rad_gain/bias to be consistent
                               with refl_gain/bias.
+8/31/2026    Gail Schmidt     Tokenize the MTL file into a key/value table in
+                              a single pass and fill the metadata by lookup
+                              instead of scanning every label for every line
+8/31/2026    Gail Schmidt     Map the MTL file into memory and tokenize the
+                              mapping in place instead of reading the file
+                              line by line
+8/31/2026    Gail Schmidt     Compute the bounding coords analytically from
+                              the edge extrema instead of walking the whole
+                              image perimeter
+8/31/2026    Gail Schmidt     Select a per-instrument band table driver once
+                              and fill the band attributes by table lookup
+                              instead of re-testing the instrument per band
 
 NOTES:
 1. The new MTL files contain the gain and bias coefficients for the TOA
@@ -59,6 +604,9 @@ NOTES:
    parsed and written to our XML metadata file, if they exist.
 2. When processing OLI_TIRS stack the 11 image bands first, then add the
    QA band to the list.
+3. The MTL file is read once into a key/value table, so the parameters can
+   appear in any order; the band-related parameters are resolved to band
+   slots after the instrument is known.
 ******************************************************************************/
 int read_lpgs_mtl
 (
@@ -75,12 +623,12 @@ int read_lpgs_mtl
     char errmsg[STR_SIZE];    /* error message */
     int i;                    /* looping variable */
     int count;                /* number of chars copied in snprintf */
-    bool done_with_mtl;       /* are we done processing the MTL file? */
     bool gain_bias_available; /* are the radiance gain/bias values available
                                  in the MTL file? */
     bool refl_gain_bias_available; /* are TOA reflectance gain/bias values and
                                  K1/K2 constants available in the MTL file? */
-    FILE *mtl_fptr=NULL;      /* file pointer to the MTL metadata file */
+    void *mtl_map = NULL;     /* read-only mapped view of the MTL file */
+    size_t mtl_length = 0;    /* length of the mapped view in bytes */
     Espa_global_meta_t *gmeta = &metadata->global;  /* pointer to the global
                                                        metadata structure */
     Espa_band_meta_t *bmeta;  /* pointer to the array of bands metadata */
@@ -112,813 +660,365 @@ int read_lpgs_mtl
     float k2[MAX_LPGS_BANDS]; /* K2 consts for brightness temp calculations */
 
     /* vars used in parameter parsing */
-    char buffer[STR_SIZE] = "\0";          /* line buffer from MTL file */
-    char *label = NULL;                    /* label value in the line */
-    char *tokenptr = NULL;                 /* pointer to process each line */
-    char *seperator = "=\" \t";            /* separator string */
-    float fnum;                            /* temporary variable for floating
-                                              point numbers */
-
-    /* Open the metadata MTL file with read privelages */
-    mtl_fptr = fopen (mtl_file, "r");
-    if (mtl_fptr == NULL)
+    Mtl_pair_t *mtl_table = NULL;  /* key/value table of the MTL parameters */
+    const char *val = NULL;        /* value of the current parameter */
+    char key1[STR_SIZE];           /* new-style parameter name */
+    char key2[STR_SIZE];           /* old-style parameter name */
+    const Lpgs_instrument_t *inst = NULL;  /* band table driver for the
+                                      instrument in this product */
+    const Lpgs_band_slot_t *slot = NULL;  /* band slot attributes for the
+                                      current band */
+    const char *short_name = NULL; /* product short name for every band */
+    float fnum;                    /* temporary variable for floating
+                                      point numbers */
+
+    /* Map the metadata MTL file into memory with read privelages, so the
+       whole file is tokenized in place without per-line reads */
+    if (open_raw_binary_mapped (mtl_file, &mtl_map, &mtl_length) != SUCCESS)
     {
-        sprintf (errmsg, "Opening %s for read access.", mtl_file);
+        sprintf (errmsg, "Mapping %s for read access.", mtl_file);
         error_handler (true, FUNC_NAME, errmsg);
         return (ERROR);
     }
 
-    /* Process the MTL file line by line */
-    gain_bias_available = false;
-    refl_gain_bias_available = false;
-    done_with_mtl = false;
-    while (fgets (buffer, STR_SIZE, mtl_fptr) != NULL)
+    /* Tokenize the KEY = VALUE pairs from the mapped MTL file into the
+       table in a single pass, then fill in the metadata by lookup */
+    mtl_table = calloc (MTL_TABLE_SIZE, sizeof (Mtl_pair_t));
+    if (mtl_table == NULL)
     {
-        /* If the last character is the end of line, then strip it off */
-        if (buffer[strlen(buffer)-1] == '\n')
-            buffer[strlen(buffer)-1] = '\0';
-
-        /* Get string token */
-        tokenptr = strtok (buffer, seperator);
-        label = tokenptr;
- 
-        if (tokenptr != NULL)
-        {
-            tokenptr = strtok (NULL, seperator);
+        sprintf (errmsg, "Allocating the MTL key/value table");
+        error_handler (true, FUNC_NAME, errmsg);
+        close_raw_binary_mapped (mtl_map, mtl_length);
+        return (ERROR);
+    }
 
-            /* Process each token; in some cases we are supporting both the
-               old and the new LPGS metadata tags */
-            if (!strcmp (label, "PROCESSING_SOFTWARE_VERSION") ||
-                !strcmp (label, "PROCESSING_SOFTWARE"))
-            {
-                count = snprintf (tmp_bmeta.app_version,
-                    sizeof (tmp_bmeta.app_version), "%s", tokenptr);
-                if (count < 0 || count >= sizeof (tmp_bmeta.app_version))
-                {
-                    sprintf (errmsg, "Overflow of tmp_bmeta.app_version");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
-            else if (!strcmp (label, "DATA_TYPE") ||
-                     !strcmp (label, "PRODUCT_TYPE"))
-            {
-                count = snprintf (tmp_bmeta.product, sizeof (tmp_bmeta.product),
-                    "%s", tokenptr);
-                if (count < 0 || count >= sizeof (tmp_bmeta.product))
-                {
-                    sprintf (errmsg, "Overflow of tmp_bmeta.product string");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
-            else if (!strcmp (label, "SPACECRAFT_ID"))
-            {
-                if (strcmp (tokenptr, "LANDSAT_8") == 0 ||
-                    strcmp (tokenptr, "Landsat8") == 0)
-                    strcpy (gmeta->satellite, "LANDSAT_8");
-                else if (strcmp (tokenptr, "LANDSAT_7") == 0 ||
-                    strcmp (tokenptr, "Landsat7") == 0)
-                    strcpy (gmeta->satellite, "LANDSAT_7");
-                else if (strcmp (tokenptr, "LANDSAT_5") == 0 ||
-                         strcmp (tokenptr, "Landsat5") == 0)
-                    strcpy (gmeta->satellite, "LANDSAT_5");
-                else if (strcmp (tokenptr, "LANDSAT_4") == 0 ||
-                         strcmp (tokenptr, "Landsat4") == 0)
-                    strcpy (gmeta->satellite, "LANDSAT_4");
-                else
-                {
-                    sprintf (errmsg, "Unsupported satellite type: %s",
-                        tokenptr);
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
-            else if (!strcmp (label, "SENSOR_ID"))
-            {
-                count = snprintf (gmeta->instrument, sizeof (gmeta->instrument),
-                    "%s", tokenptr);
-                if (count < 0 || count >= sizeof (gmeta->instrument))
-                {
-                    sprintf (errmsg, "Overflow of gmeta->instrument string");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
-            else if (!strcmp (label, "DATE_ACQUIRED") ||
-                     !strcmp (label, "ACQUISITION_DATE"))
-            {
-                count = snprintf (gmeta->acquisition_date,
-                    sizeof (gmeta->acquisition_date), "%s", tokenptr);
-                if (count < 0 || count >= sizeof (gmeta->acquisition_date))
-                {
-                    sprintf (errmsg, "Overflow of gmeta->acquisition_date");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
-            else if (!strcmp (label, "SCENE_CENTER_TIME") ||
-                     !strcmp (label, "SCENE_CENTER_SCAN_TIME"))
-            {
-                count = snprintf (gmeta->scene_center_time,
-                    sizeof (gmeta->scene_center_time), "%s", tokenptr);
-                if (count < 0 || count >= sizeof (gmeta->scene_center_time))
-                {
-                    sprintf (errmsg, "Overflow of gmeta->scene_center_time");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
-            else if (!strcmp (label, "FILE_DATE") ||
-                     !strcmp (label, "PRODUCT_CREATION_TIME"))
-            {
-                count = snprintf (gmeta->level1_production_date,
-                    sizeof (gmeta->level1_production_date), "%s", tokenptr);
-                if (count < 0 ||
-                    count >= sizeof (gmeta->level1_production_date))
-                {
-                    sprintf (errmsg,
-                        "Overflow of gmeta->level1_production_date");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
-            else if (!strcmp (label, "SUN_ELEVATION"))
-            {
-                sscanf (tokenptr, "%f", &fnum);
-                gmeta->solar_zenith = 90.0 - fnum;
-            }
-            else if (!strcmp (label, "SUN_AZIMUTH"))
-                sscanf (tokenptr, "%f", &gmeta->solar_azimuth);
-            else if (!strcmp (label, "EARTH_SUN_DISTANCE"))
-                sscanf (tokenptr, "%f", &gmeta->earth_sun_dist);
-            else if (!strcmp (label, "WRS_PATH"))
-                sscanf (tokenptr, "%d", &gmeta->wrs_path);
-            else if (!strcmp (label, "WRS_ROW") ||
-                     !strcmp (label, "STARTING_ROW"))
-                sscanf (tokenptr, "%d", &gmeta->wrs_row);
-
-            else if (!strcmp (label, "CORNER_UL_LAT_PRODUCT") ||
-                     !strcmp (label, "PRODUCT_UL_CORNER_LAT"))
-                sscanf (tokenptr, "%lf", &gmeta->ul_corner[0]);
-            else if (!strcmp (label, "CORNER_UL_LON_PRODUCT") ||
-                     !strcmp (label, "PRODUCT_UL_CORNER_LON"))
-                sscanf (tokenptr, "%lf", &gmeta->ul_corner[1]);
-            else if (!strcmp (label, "CORNER_LR_LAT_PRODUCT") ||
-                     !strcmp (label, "PRODUCT_LR_CORNER_LAT"))
-                sscanf (tokenptr, "%lf", &gmeta->lr_corner[0]);
-            else if (!strcmp (label, "CORNER_LR_LON_PRODUCT") ||
-                     !strcmp (label, "PRODUCT_LR_CORNER_LON"))
-                sscanf (tokenptr, "%lf", &gmeta->lr_corner[1]);
-
-            else if (!strcmp (label, "CORNER_UR_LAT_PRODUCT") ||
-                     !strcmp (label, "PRODUCT_UR_CORNER_LAT"))
-                sscanf (tokenptr, "%lf", &ur_corner[0]);
-            else if (!strcmp (label, "CORNER_UR_LON_PRODUCT") ||
-                     !strcmp (label, "PRODUCT_UR_CORNER_LON"))
-                sscanf (tokenptr, "%lf", &ur_corner[1]);
-            else if (!strcmp (label, "CORNER_LL_LAT_PRODUCT") ||
-                     !strcmp (label, "PRODUCT_LL_CORNER_LAT"))
-                sscanf (tokenptr, "%lf", &ll_corner[0]);
-            else if (!strcmp (label, "CORNER_LL_LON_PRODUCT") ||
-                     !strcmp (label, "PRODUCT_LL_CORNER_LON"))
-                sscanf (tokenptr, "%lf", &ll_corner[1]);
-
-            else if (!strcmp (label, "CORNER_UL_PROJECTION_X_PRODUCT") ||
-                     !strcmp (label, "PRODUCT_UL_CORNER_MAPX") ||
-                     !strcmp (label, "SCENE_UL_CORNER_MAPX"))
-                sscanf (tokenptr, "%lf", &gmeta->proj_info.ul_corner[0]);
-            else if (!strcmp (label, "CORNER_UL_PROJECTION_Y_PRODUCT") ||
-                     !strcmp (label, "PRODUCT_UL_CORNER_MAPY") ||
-                     !strcmp (label, "SCENE_UL_CORNER_MAPY"))
-                sscanf (tokenptr, "%lf", &gmeta->proj_info.ul_corner[1]);
-            else if (!strcmp (label, "CORNER_LR_PROJECTION_X_PRODUCT") ||
-                     !strcmp (label, "PRODUCT_LR_CORNER_MAPX") ||
-                     !strcmp (label, "SCENE_LR_CORNER_MAPX"))
-                sscanf (tokenptr, "%lf", &gmeta->proj_info.lr_corner[0]);
-            else if (!strcmp (label, "CORNER_LR_PROJECTION_Y_PRODUCT") ||
-                     !strcmp (label, "PRODUCT_LR_CORNER_MAPY") ||
-                     !strcmp (label, "SCENE_LR_CORNER_MAPY"))
-                sscanf (tokenptr, "%lf", &gmeta->proj_info.lr_corner[1]);
-
-            else if (!strcmp (label, "REFLECTIVE_SAMPLES") ||
-                     !strcmp (label, "PRODUCT_SAMPLES_REF"))
-                sscanf (tokenptr, "%d", &tmp_bmeta.nsamps);
-            else if (!strcmp (label, "REFLECTIVE_LINES") ||
-                     !strcmp (label, "PRODUCT_LINES_REF"))
-                sscanf (tokenptr, "%d", &tmp_bmeta.nlines);
-            else if (!strcmp (label, "THERMAL_SAMPLES") ||
-                     !strcmp (label, "PRODUCT_SAMPLES_THM"))
-                sscanf (tokenptr, "%d", &tmp_bmeta_th.nsamps);
-            else if (!strcmp (label, "THERMAL_LINES") ||
-                     !strcmp (label, "PRODUCT_LINES_THM"))
-                sscanf (tokenptr, "%d", &tmp_bmeta_th.nlines);
-            else if (!strcmp (label, "PANCHROMATIC_SAMPLES") ||
-                     !strcmp (label, "PRODUCT_SAMPLES_PAN"))
-                sscanf (tokenptr, "%d", &tmp_bmeta_pan.nsamps);
-            else if (!strcmp (label, "PANCHROMATIC_LINES") ||
-                     !strcmp (label, "PRODUCT_LINES_PAN"))
-                sscanf (tokenptr, "%d", &tmp_bmeta_pan.nlines);
-
-            else if (!strcmp (label, "MAP_PROJECTION"))
-            {
-                if (!strcmp (tokenptr, "UTM"))
-                    gmeta->proj_info.proj_type = GCTP_UTM_PROJ;
-                else if (!strcmp (tokenptr, "PS"))
-                    gmeta->proj_info.proj_type = GCTP_PS_PROJ;
-                else
-                {
-                    sprintf (errmsg, "Unsupported projection type: %s. "
-                        "Only UTM and PS are supported for LPGS.", tokenptr);
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
-            else if (!strcmp (label, "DATUM") ||
-                     !strcmp (label, "REFERENCE_DATUM"))
-            {
-                if (!strcmp (tokenptr, "WGS84"))
-                    gmeta->proj_info.datum_type = ESPA_WGS84;
-                else
-                {
-                    sprintf (errmsg, "Unexpected datum type: %s", tokenptr);
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
-            else if (!strcmp (label, "GRID_CELL_SIZE_REFLECTIVE") ||
-                     !strcmp (label, "GRID_CELL_SIZE_REF"))
-            {
-                sscanf (tokenptr, "%lf", &tmp_bmeta.pixel_size[0]);
-                tmp_bmeta.pixel_size[1] = tmp_bmeta.pixel_size[0];
-            }
-            else if (!strcmp (label, "GRID_CELL_SIZE_THERMAL") ||
-                     !strcmp (label, "GRID_CELL_SIZE_THM"))
-            {
-                sscanf (tokenptr, "%lf", &tmp_bmeta_th.pixel_size[0]);
-                tmp_bmeta_th.pixel_size[1] = tmp_bmeta_th.pixel_size[0];
-            }
-            else if (!strcmp (label, "GRID_CELL_SIZE_PANCHROMATIC") ||
-                     !strcmp (label, "GRID_CELL_SIZE_PAN"))
-            {
-                sscanf (tokenptr, "%lf", &tmp_bmeta_pan.pixel_size[0]);
-                tmp_bmeta_pan.pixel_size[1] = tmp_bmeta_pan.pixel_size[0];
-            }
-            else if (!strcmp (label, "UTM_ZONE") ||
-                     !strcmp (label, "ZONE_NUMBER"))
-                sscanf (tokenptr, "%d", &gmeta->proj_info.utm_zone);
-            else if (!strcmp (label, "VERTICAL_LON_FROM_POLE") ||
-                     !strcmp (label, "VERTICAL_LONGITUDE_FROM_POLE"))
-                sscanf (tokenptr, "%lf", &gmeta->proj_info.longitude_pole);
-            else if (!strcmp (label, "TRUE_SCALE_LAT") ||
-                     !strcmp (label, "LATITUDE_OF_TRUE_SCALE"))
-                sscanf (tokenptr, "%lf", &gmeta->proj_info.latitude_true_scale);
-            else if (!strcmp (label, "FALSE_EASTING"))
-                sscanf (tokenptr, "%lf", &gmeta->proj_info.false_easting);
-            else if (!strcmp (label, "FALSE_NORTHING"))
-                sscanf (tokenptr, "%lf", &gmeta->proj_info.false_northing);
-
-            else if (!strcmp (label, "RESAMPLING_OPTION"))
-            {
-                if (!strcmp (tokenptr, "CUBIC_CONVOLUTION"))
-                    tmp_bmeta.resample_method = ESPA_CC;
-                else if (!strcmp (tokenptr, "NEAREST_NEIGHBOR"))
-                    tmp_bmeta.resample_method = ESPA_NN;
-                else if (!strcmp (tokenptr, "BILINEAR"))
-                    tmp_bmeta.resample_method = ESPA_BI;
-                else
-                {
-                    sprintf (errmsg, "Unsupported resampling option: %s",
-                        tokenptr);
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
+    if (load_mtl_table ((const char *) mtl_map, mtl_length, mtl_table)
+        != SUCCESS)
+    {
+        sprintf (errmsg, "Reading the MTL file: %s", mtl_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        free (mtl_table);
+        close_raw_binary_mapped (mtl_map, mtl_length);
+        return (ERROR);
+    }
+    close_raw_binary_mapped (mtl_map, mtl_length);
+
+    /* Process the global parameters; in some cases we are supporting both
+       the old and the new LPGS metadata tags */
+    if (mtl_copy_field (mtl_table, "PROCESSING_SOFTWARE_VERSION",
+        "PROCESSING_SOFTWARE", tmp_bmeta.app_version,
+        sizeof (tmp_bmeta.app_version), "tmp_bmeta.app_version") != SUCCESS)
+        return (ERROR);
+
+    if (mtl_copy_field (mtl_table, "DATA_TYPE", "PRODUCT_TYPE",
+        tmp_bmeta.product, sizeof (tmp_bmeta.product), "tmp_bmeta.product")
+        != SUCCESS)
+        return (ERROR);
+
+    if ((val = mtl_find (mtl_table, "SPACECRAFT_ID")) != NULL)
+    {
+        if (strcmp (val, "LANDSAT_8") == 0 || strcmp (val, "Landsat8") == 0)
+            strcpy (gmeta->satellite, "LANDSAT_8");
+        else if (strcmp (val, "LANDSAT_7") == 0 ||
+                 strcmp (val, "Landsat7") == 0)
+            strcpy (gmeta->satellite, "LANDSAT_7");
+        else if (strcmp (val, "LANDSAT_5") == 0 ||
+                 strcmp (val, "Landsat5") == 0)
+            strcpy (gmeta->satellite, "LANDSAT_5");
+        else if (strcmp (val, "LANDSAT_4") == 0 ||
+                 strcmp (val, "Landsat4") == 0)
+            strcpy (gmeta->satellite, "LANDSAT_4");
+        else
+        {
+            sprintf (errmsg, "Unsupported satellite type: %s", val);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+    }
 
-            else if (!strcmp (label, "END"))
-            {
-                done_with_mtl = true;
-                break;
-            }
+    if (mtl_copy_field (mtl_table, "SENSOR_ID", NULL, gmeta->instrument,
+        sizeof (gmeta->instrument), "gmeta->instrument") != SUCCESS)
+        return (ERROR);
 
-            /* Read the band names */
-            else if (!strcmp (label, "FILE_NAME_BAND_1") ||
-                     !strcmp (label, "BAND1_FILE_NAME"))
-            {
-                count = snprintf (band_fname[0], sizeof (band_fname[0]), "%s",
-                    tokenptr);
-                if (count < 0 || count >= sizeof (band_fname[0]))
-                {
-                    sprintf (errmsg, "Overflow of band_fname[0] string");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
-            else if (!strcmp (label, "FILE_NAME_BAND_2") ||
-                     !strcmp (label, "BAND2_FILE_NAME"))
-            {
-                count = snprintf (band_fname[1], sizeof (band_fname[1]), "%s",
-                    tokenptr);
-                if (count < 0 || count >= sizeof (band_fname[1]))
-                {
-                    sprintf (errmsg, "Overflow of band_fname[1] string");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
-            else if (!strcmp (label, "FILE_NAME_BAND_3") ||
-                     !strcmp (label, "BAND3_FILE_NAME"))
-            {
-                count = snprintf (band_fname[2], sizeof (band_fname[2]), "%s",
-                    tokenptr);
-                if (count < 0 || count >= sizeof (band_fname[2]))
-                {
-                    sprintf (errmsg, "Overflow of band_fname[2] string");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
-            else if (!strcmp (label, "FILE_NAME_BAND_4") ||
-                     !strcmp (label, "BAND4_FILE_NAME"))
-            {
-                count = snprintf (band_fname[3], sizeof (band_fname[3]), "%s",
-                    tokenptr);
-                if (count < 0 || count >= sizeof (band_fname[3]))
-                {
-                    sprintf (errmsg, "Overflow of band_fname[3] string");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
-            else if (!strcmp (label, "FILE_NAME_BAND_5") ||
-                     !strcmp (label, "BAND5_FILE_NAME"))
-            {
-                count = snprintf (band_fname[4], sizeof (band_fname[4]), "%s",
-                    tokenptr);
-                if (count < 0 || count >= sizeof (band_fname[4]))
-                {
-                    sprintf (errmsg, "Overflow of band_fname[4] string");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
-            else if (!strcmp (label, "FILE_NAME_BAND_6") ||
-                     !strcmp (label, "BAND6_FILE_NAME"))
-            {
-                count = snprintf (band_fname[5], sizeof (band_fname[5]), "%s",
-                    tokenptr);
-                if (count < 0 || count >= sizeof (band_fname[5]))
-                {
-                    sprintf (errmsg, "Overflow of band_fname[5] string");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
-            else if (!strcmp (label, "FILE_NAME_BAND_7") ||
-                     !strcmp (label, "BAND7_FILE_NAME"))
-            {
-                if (!strcmp (gmeta->instrument, "TM") ||
-                    !strcmp (gmeta->instrument, "OLI_TIRS") ||
-                    !strcmp (gmeta->instrument, "OLI"))
-                {  /* only a single band 6 so count is normal */
-                    count = snprintf (band_fname[6], sizeof (band_fname[6]),
-                        "%s", tokenptr);
-                    if (count < 0 || count >= sizeof (band_fname[6]))
-                    {
-                        sprintf (errmsg, "Overflow of band_fname[6] string");
-                        error_handler (true, FUNC_NAME, errmsg);
-                        return (ERROR);
-                    }
-                }
-                else if (!strncmp (gmeta->instrument, "ETM", 3))
-                {  /* band 6L and 6H throw off the count for ETM+ */
-                    count = snprintf (band_fname[7], sizeof (band_fname[7]),
-                        "%s", tokenptr);
-                    if (count < 0 || count >= sizeof (band_fname[7]))
-                    {
-                        sprintf (errmsg, "Overflow of band_fname[7] string");
-                        error_handler (true, FUNC_NAME, errmsg);
-                        return (ERROR);
-                    }
-                }
-            }
-            else if (!strcmp (label, "FILE_NAME_BAND_8") ||
-                     !strcmp (label, "BAND8_FILE_NAME"))
-            {
-                if (!strcmp (gmeta->instrument, "OLI_TIRS") ||
-                    !strcmp (gmeta->instrument, "OLI"))
-                {  /* only a single band 6 so count is normal */
-                    count = snprintf (band_fname[7], sizeof (band_fname[7]),
-                        "%s", tokenptr);
-                    if (count < 0 || count >= sizeof (band_fname[7]))
-                    {
-                        sprintf (errmsg, "Overflow of band_fname[7] string");
-                        error_handler (true, FUNC_NAME, errmsg);
-                        return (ERROR);
-                    }
-                }
-                else if (!strncmp (gmeta->instrument, "ETM", 3))
-                {  /* band 6L and 6H throw off the count for ETM+ */
-                    count = snprintf (band_fname[8], sizeof (band_fname[8]),
-                        "%s", tokenptr);
-                    if (count < 0 || count >= sizeof (band_fname[8]))
-                    {
-                        sprintf (errmsg, "Overflow of band_fname[8] string");
-                        error_handler (true, FUNC_NAME, errmsg);
-                        return (ERROR);
-                    }
-                }
-            }
-            else if (!strcmp (label, "FILE_NAME_BAND_6_VCID_1") ||
-                     !strcmp (label, "BAND61_FILE_NAME"))
-            {
-                count = snprintf (band_fname[5], sizeof (band_fname[5]), "%s",
-                    tokenptr);
-                if (count < 0 || count >= sizeof (band_fname[5]))
-                {
-                    sprintf (errmsg, "Overflow of band_fname[5] string");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
-            else if (!strcmp (label, "FILE_NAME_BAND_6_VCID_2") ||
-                     !strcmp (label, "BAND62_FILE_NAME"))
-            {
-                count = snprintf (band_fname[6], sizeof (band_fname[6]), "%s",
-                    tokenptr);
-                if (count < 0 || count >= sizeof (band_fname[6]))
-                {
-                    sprintf (errmsg, "Overflow of band_fname[6] string");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
-            else if (!strcmp (label, "FILE_NAME_BAND_9") ||
-                     !strcmp (label, "BAND9_FILE_NAME"))
-            {
-                count = snprintf (band_fname[8], sizeof (band_fname[8]), "%s",
-                    tokenptr);
-                if (count < 0 || count >= sizeof (band_fname[8]))
-                {
-                    sprintf (errmsg, "Overflow of band_fname[8] string");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
-            else if (!strcmp (label, "FILE_NAME_BAND_10") ||
-                     !strcmp (label, "BAND10_FILE_NAME"))
-            {
-                count = snprintf (band_fname[9], sizeof (band_fname[9]), "%s",
-                    tokenptr);
-                if (count < 0 || count >= sizeof (band_fname[9]))
-                {
-                    sprintf (errmsg, "Overflow of band_fname[9] string");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
-            else if (!strcmp (label, "FILE_NAME_BAND_11") ||
-                     !strcmp (label, "BAND11_FILE_NAME"))
-            {
-                count = snprintf (band_fname[10], sizeof (band_fname[10]), "%s",
-                    tokenptr);
-                if (count < 0 || count >= sizeof (band_fname[10]))
-                {
-                    sprintf (errmsg, "Overflow of band_fname[10] string");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
-            else if (!strcmp (label, "FILE_NAME_BAND_QUALITY"))
-            {
-                if (!strcmp (gmeta->instrument, "OLI"))
-                {  /* only 9 bands total so QA is 10 */
-                    count = snprintf (band_fname[9], sizeof (band_fname[9]),
-                        "%s", tokenptr);
-                    if (count < 0 || count >= sizeof (band_fname[9]))
-                    {
-                        sprintf (errmsg, "Overflow of band_fname[9] string");
-                        error_handler (true, FUNC_NAME, errmsg);
-                        return (ERROR);
-                    }
-                }
-                else
-                {  /* OLI_TIRS has 11 bands total so QA is 12 */
+    if (mtl_copy_field (mtl_table, "DATE_ACQUIRED", "ACQUISITION_DATE",
+        gmeta->acquisition_date, sizeof (gmeta->acquisition_date),
+        "gmeta->acquisition_date") != SUCCESS)
+        return (ERROR);
 
-                    count = snprintf (band_fname[11], sizeof (band_fname[11]),
-                        "%s", tokenptr);
-                    if (count < 0 || count >= sizeof (band_fname[11]))
-                    {
-                        sprintf (errmsg, "Overflow of band_fname[11] string");
-                        error_handler (true, FUNC_NAME, errmsg);
-                        return (ERROR);
-                    }
-                }
-            }
+    if (mtl_copy_field (mtl_table, "SCENE_CENTER_TIME",
+        "SCENE_CENTER_SCAN_TIME", gmeta->scene_center_time,
+        sizeof (gmeta->scene_center_time), "gmeta->scene_center_time")
+        != SUCCESS)
+        return (ERROR);
 
-            /* Read the min pixel values */
-            else if (!strcmp (label, "QUANTIZE_CAL_MIN_BAND_1") ||
-                     !strcmp (label, "QCALMIN_BAND1"))
-                sscanf (tokenptr, "%d", &band_min[0]);
-            else if (!strcmp (label, "QUANTIZE_CAL_MIN_BAND_2") ||
-                     !strcmp (label, "QCALMIN_BAND2"))
-                sscanf (tokenptr, "%d", &band_min[1]);
-            else if (!strcmp (label, "QUANTIZE_CAL_MIN_BAND_3") ||
-                     !strcmp (label, "QCALMIN_BAND3"))
-                sscanf (tokenptr, "%d", &band_min[2]);
-            else if (!strcmp (label, "QUANTIZE_CAL_MIN_BAND_4") ||
-                     !strcmp (label, "QCALMIN_BAND4"))
-                sscanf (tokenptr, "%d", &band_min[3]);
-            else if (!strcmp (label, "QUANTIZE_CAL_MIN_BAND_5") ||
-                     !strcmp (label, "QCALMIN_BAND5"))
-                sscanf (tokenptr, "%d", &band_min[4]);
-            else if (!strcmp (label, "QUANTIZE_CAL_MIN_BAND_6") ||
-                     !strcmp (label, "QCALMIN_BAND6"))
-                sscanf (tokenptr, "%d", &band_min[5]);
-            else if (!strcmp (label, "QUANTIZE_CAL_MIN_BAND_7") ||
-                     !strcmp (label, "QCALMIN_BAND7"))
-            {
-                if (!strcmp (gmeta->instrument, "TM") ||
-                    !strcmp (gmeta->instrument, "OLI_TIRS") ||
-                    !strcmp (gmeta->instrument, "OLI"))
-                    sscanf (tokenptr, "%d", &band_min[6]);
-                else if (!strncmp (gmeta->instrument, "ETM", 3))
-                    sscanf (tokenptr, "%d", &band_min[7]);
-            }
-            else if (!strcmp (label, "QUANTIZE_CAL_MIN_BAND_8") ||
-                     !strcmp (label, "QCALMIN_BAND8"))
-            {
-                if (!strcmp (gmeta->instrument, "OLI_TIRS") ||
-                    !strcmp (gmeta->instrument, "OLI"))
-                    sscanf (tokenptr, "%d", &band_min[7]);
-                else if (!strncmp (gmeta->instrument, "ETM", 3))
-                    sscanf (tokenptr, "%d", &band_min[8]);
-            }
-            else if (!strcmp (label, "QUANTIZE_CAL_MIN_BAND_6_VCID_1") ||
-                     !strcmp (label, "QCALMIN_BAND61"))
-                sscanf (tokenptr, "%d", &band_min[5]);
-            else if (!strcmp (label, "QUANTIZE_CAL_MIN_BAND_6_VCID_2") ||
-                     !strcmp (label, "QCALMIN_BAND62"))
-                sscanf (tokenptr, "%d", &band_min[6]);
-            else if (!strcmp (label, "QUANTIZE_CAL_MIN_BAND_9"))
-                sscanf (tokenptr, "%d", &band_min[8]);
-            else if (!strcmp (label, "QUANTIZE_CAL_MIN_BAND_10"))
-                sscanf (tokenptr, "%d", &band_min[9]);
-            else if (!strcmp (label, "QUANTIZE_CAL_MIN_BAND_11"))
-                sscanf (tokenptr, "%d", &band_min[10]);
-
-            /* Read the max pixel values */
-            else if (!strcmp (label, "QUANTIZE_CAL_MAX_BAND_1") ||
-                     !strcmp (label, "QCALMAX_BAND1"))
-                sscanf (tokenptr, "%d", &band_max[0]);
-            else if (!strcmp (label, "QUANTIZE_CAL_MAX_BAND_2") ||
-                     !strcmp (label, "QCALMAX_BAND2"))
-                sscanf (tokenptr, "%d", &band_max[1]);
-            else if (!strcmp (label, "QUANTIZE_CAL_MAX_BAND_3") ||
-                     !strcmp (label, "QCALMAX_BAND3"))
-                sscanf (tokenptr, "%d", &band_max[2]);
-            else if (!strcmp (label, "QUANTIZE_CAL_MAX_BAND_4") ||
-                     !strcmp (label, "QCALMAX_BAND4"))
-                sscanf (tokenptr, "%d", &band_max[3]);
-            else if (!strcmp (label, "QUANTIZE_CAL_MAX_BAND_5") ||
-                     !strcmp (label, "QCALMAX_BAND5"))
-                sscanf (tokenptr, "%d", &band_max[4]);
-            else if (!strcmp (label, "QUANTIZE_CAL_MAX_BAND_6") ||
-                     !strcmp (label, "QCALMAX_BAND6"))
-                sscanf (tokenptr, "%d", &band_max[5]);
-            else if (!strcmp (label, "QUANTIZE_CAL_MAX_BAND_7") ||
-                     !strcmp (label, "QCALMAX_BAND7"))
-            {
-                if (!strcmp (gmeta->instrument, "TM") ||
-                    !strcmp (gmeta->instrument, "OLI_TIRS") ||
-                    !strcmp (gmeta->instrument, "OLI"))
-                    sscanf (tokenptr, "%d", &band_max[6]);
-                else if (!strncmp (gmeta->instrument, "ETM", 3))
-                    sscanf (tokenptr, "%d", &band_max[7]);
-            }
-            else if (!strcmp (label, "QUANTIZE_CAL_MAX_BAND_8") ||
-                     !strcmp (label, "QCALMAX_BAND8"))
-            {
-                if (!strcmp (gmeta->instrument, "OLI_TIRS") ||
-                    !strcmp (gmeta->instrument, "OLI"))
-                    sscanf (tokenptr, "%d", &band_max[7]);
-                else if (!strncmp (gmeta->instrument, "ETM", 3))
-                    sscanf (tokenptr, "%d", &band_max[8]);
-            }
-            else if (!strcmp (label, "QUANTIZE_CAL_MAX_BAND_6_VCID_1") ||
-                     !strcmp (label, "QCALMAX_BAND61"))
-                sscanf (tokenptr, "%d", &band_max[5]);
-            else if (!strcmp (label, "QUANTIZE_CAL_MAX_BAND_6_VCID_2") ||
-                     !strcmp (label, "QCALMAX_BAND62"))
-                sscanf (tokenptr, "%d", &band_max[6]);
-            else if (!strcmp (label, "QUANTIZE_CAL_MAX_BAND_9"))
-                sscanf (tokenptr, "%d", &band_max[8]);
-            else if (!strcmp (label, "QUANTIZE_CAL_MAX_BAND_10"))
-                sscanf (tokenptr, "%d", &band_max[9]);
-            else if (!strcmp (label, "QUANTIZE_CAL_MAX_BAND_11"))
-                sscanf (tokenptr, "%d", &band_max[10]);
-
-            /* Read the radiance gains */
-            else if (!strcmp (label, "RADIANCE_MULT_BAND_1"))
-            {
-                sscanf (tokenptr, "%f", &band_gain[0]);
+    if (mtl_copy_field (mtl_table, "FILE_DATE", "PRODUCT_CREATION_TIME",
+        gmeta->level1_production_date,
+        sizeof (gmeta->level1_production_date),
+        "gmeta->level1_production_date") != SUCCESS)
+        return (ERROR);
 
-                /* Assume that if gain value for band 1 is available, then
-                   the gain and bias values for all bands will be available */
-                gain_bias_available = true;
-            }
-            else if (!strcmp (label, "RADIANCE_MULT_BAND_2"))
-                sscanf (tokenptr, "%f", &band_gain[1]);
-            else if (!strcmp (label, "RADIANCE_MULT_BAND_3"))
-                sscanf (tokenptr, "%f", &band_gain[2]);
-            else if (!strcmp (label, "RADIANCE_MULT_BAND_4"))
-                sscanf (tokenptr, "%f", &band_gain[3]);
-            else if (!strcmp (label, "RADIANCE_MULT_BAND_5"))
-                sscanf (tokenptr, "%f", &band_gain[4]);
-            else if (!strcmp (label, "RADIANCE_MULT_BAND_6"))
-                sscanf (tokenptr, "%f", &band_gain[5]);
-            else if (!strcmp (label, "RADIANCE_MULT_BAND_7"))
-            {
-                if (!strcmp (gmeta->instrument, "TM") ||
-                    !strcmp (gmeta->instrument, "OLI_TIRS") ||
-                    !strcmp (gmeta->instrument, "OLI"))
-                    sscanf (tokenptr, "%f", &band_gain[6]);
-                else if (!strncmp (gmeta->instrument, "ETM", 3))
-                    sscanf (tokenptr, "%f", &band_gain[7]);
-            }
-            else if (!strcmp (label, "RADIANCE_MULT_BAND_8"))
-            {
-                if (!strcmp (gmeta->instrument, "OLI_TIRS") ||
-                    !strcmp (gmeta->instrument, "OLI"))
-                    sscanf (tokenptr, "%f", &band_gain[7]);
-                else if (!strncmp (gmeta->instrument, "ETM", 3))
-                    sscanf (tokenptr, "%f", &band_gain[8]);
-            }
-            else if (!strcmp (label, "RADIANCE_MULT_BAND_6_VCID_1"))
-                sscanf (tokenptr, "%f", &band_gain[5]);
-            else if (!strcmp (label, "RADIANCE_MULT_BAND_6_VCID_2"))
-                sscanf (tokenptr, "%f", &band_gain[6]);
-            else if (!strcmp (label, "RADIANCE_MULT_BAND_9"))
-                sscanf (tokenptr, "%f", &band_gain[8]);
-            else if (!strcmp (label, "RADIANCE_MULT_BAND_10"))
-                sscanf (tokenptr, "%f", &band_gain[9]);
-            else if (!strcmp (label, "RADIANCE_MULT_BAND_11"))
-                sscanf (tokenptr, "%f", &band_gain[10]);
-
-            /* Read the radiance biases */
-            else if (!strcmp (label, "RADIANCE_ADD_BAND_1"))
-                sscanf (tokenptr, "%f", &band_bias[0]);
-            else if (!strcmp (label, "RADIANCE_ADD_BAND_2"))
-                sscanf (tokenptr, "%f", &band_bias[1]);
-            else if (!strcmp (label, "RADIANCE_ADD_BAND_3"))
-                sscanf (tokenptr, "%f", &band_bias[2]);
-            else if (!strcmp (label, "RADIANCE_ADD_BAND_4"))
-                sscanf (tokenptr, "%f", &band_bias[3]);
-            else if (!strcmp (label, "RADIANCE_ADD_BAND_5"))
-                sscanf (tokenptr, "%f", &band_bias[4]);
-            else if (!strcmp (label, "RADIANCE_ADD_BAND_6"))
-                sscanf (tokenptr, "%f", &band_bias[5]);
-            else if (!strcmp (label, "RADIANCE_ADD_BAND_7"))
-            {
-                if (!strcmp (gmeta->instrument, "TM") ||
-                    !strcmp (gmeta->instrument, "OLI_TIRS") ||
-                    !strcmp (gmeta->instrument, "OLI"))
-                    sscanf (tokenptr, "%f", &band_bias[6]);
-                else if (!strncmp (gmeta->instrument, "ETM", 3))
-                    sscanf (tokenptr, "%f", &band_bias[7]);
-            }
-            else if (!strcmp (label, "RADIANCE_ADD_BAND_8"))
-            {
-                if (!strcmp (gmeta->instrument, "OLI_TIRS") ||
-                    !strcmp (gmeta->instrument, "OLI"))
-                    sscanf (tokenptr, "%f", &band_bias[7]);
-                else if (!strncmp (gmeta->instrument, "ETM", 3))
-                    sscanf (tokenptr, "%f", &band_bias[8]);
-            }
-            else if (!strcmp (label, "RADIANCE_ADD_BAND_6_VCID_1"))
-                sscanf (tokenptr, "%f", &band_bias[5]);
-            else if (!strcmp (label, "RADIANCE_ADD_BAND_6_VCID_2"))
-                sscanf (tokenptr, "%f", &band_bias[6]);
-            else if (!strcmp (label, "RADIANCE_ADD_BAND_9"))
-                sscanf (tokenptr, "%f", &band_bias[8]);
-            else if (!strcmp (label, "RADIANCE_ADD_BAND_10"))
-                sscanf (tokenptr, "%f", &band_bias[9]);
-            else if (!strcmp (label, "RADIANCE_ADD_BAND_11"))
-                sscanf (tokenptr, "%f", &band_bias[10]);
-
-            /* Read the reflectance gains */
-            else if (!strcmp (label, "REFLECTANCE_MULT_BAND_1"))
-            {
-                sscanf (tokenptr, "%f", &refl_gain[0]);
+    if ((val = mtl_find (mtl_table, "SUN_ELEVATION")) != NULL)
+    {
+        sscanf (val, "%f", &fnum);
+        gmeta->solar_zenith = 90.0 - fnum;
+    }
+    if ((val = mtl_find (mtl_table, "SUN_AZIMUTH")) != NULL)
+        sscanf (val, "%f", &gmeta->solar_azimuth);
+    if ((val = mtl_find (mtl_table, "EARTH_SUN_DISTANCE")) != NULL)
+        sscanf (val, "%f", &gmeta->earth_sun_dist);
+    if ((val = mtl_find (mtl_table, "WRS_PATH")) != NULL)
+        sscanf (val, "%d", &gmeta->wrs_path);
+    if ((val = mtl_find2 (mtl_table, "WRS_ROW", "STARTING_ROW")) != NULL)
+        sscanf (val, "%d", &gmeta->wrs_row);
+
+    /* Geographic corners */
+    if ((val = mtl_find2 (mtl_table, "CORNER_UL_LAT_PRODUCT",
+        "PRODUCT_UL_CORNER_LAT")) != NULL)
+        sscanf (val, "%lf", &gmeta->ul_corner[0]);
+    if ((val = mtl_find2 (mtl_table, "CORNER_UL_LON_PRODUCT",
+        "PRODUCT_UL_CORNER_LON")) != NULL)
+        sscanf (val, "%lf", &gmeta->ul_corner[1]);
+    if ((val = mtl_find2 (mtl_table, "CORNER_LR_LAT_PRODUCT",
+        "PRODUCT_LR_CORNER_LAT")) != NULL)
+        sscanf (val, "%lf", &gmeta->lr_corner[0]);
+    if ((val = mtl_find2 (mtl_table, "CORNER_LR_LON_PRODUCT",
+        "PRODUCT_LR_CORNER_LON")) != NULL)
+        sscanf (val, "%lf", &gmeta->lr_corner[1]);
+
+    if ((val = mtl_find2 (mtl_table, "CORNER_UR_LAT_PRODUCT",
+        "PRODUCT_UR_CORNER_LAT")) != NULL)
+        sscanf (val, "%lf", &ur_corner[0]);
+    if ((val = mtl_find2 (mtl_table, "CORNER_UR_LON_PRODUCT",
+        "PRODUCT_UR_CORNER_LON")) != NULL)
+        sscanf (val, "%lf", &ur_corner[1]);
+    if ((val = mtl_find2 (mtl_table, "CORNER_LL_LAT_PRODUCT",
+        "PRODUCT_LL_CORNER_LAT")) != NULL)
+        sscanf (val, "%lf", &ll_corner[0]);
+    if ((val = mtl_find2 (mtl_table, "CORNER_LL_LON_PRODUCT",
+        "PRODUCT_LL_CORNER_LON")) != NULL)
+        sscanf (val, "%lf", &ll_corner[1]);
+
+    /* Projection corners; the old tags have product and scene variants */
+    if ((val = mtl_find2 (mtl_table, "CORNER_UL_PROJECTION_X_PRODUCT",
+        "PRODUCT_UL_CORNER_MAPX")) == NULL)
+        val = mtl_find (mtl_table, "SCENE_UL_CORNER_MAPX");
+    if (val != NULL)
+        sscanf (val, "%lf", &gmeta->proj_info.ul_corner[0]);
+
+    if ((val = mtl_find2 (mtl_table, "CORNER_UL_PROJECTION_Y_PRODUCT",
+        "PRODUCT_UL_CORNER_MAPY")) == NULL)
+        val = mtl_find (mtl_table, "SCENE_UL_CORNER_MAPY");
+    if (val != NULL)
+        sscanf (val, "%lf", &gmeta->proj_info.ul_corner[1]);
+
+    if ((val = mtl_find2 (mtl_table, "CORNER_LR_PROJECTION_X_PRODUCT",
+        "PRODUCT_LR_CORNER_MAPX")) == NULL)
+        val = mtl_find (mtl_table, "SCENE_LR_CORNER_MAPX");
+    if (val != NULL)
+        sscanf (val, "%lf", &gmeta->proj_info.lr_corner[0]);
+
+    if ((val = mtl_find2 (mtl_table, "CORNER_LR_PROJECTION_Y_PRODUCT",
+        "PRODUCT_LR_CORNER_MAPY")) == NULL)
+        val = mtl_find (mtl_table, "SCENE_LR_CORNER_MAPY");
+    if (val != NULL)
+        sscanf (val, "%lf", &gmeta->proj_info.lr_corner[1]);
+
+    /* Lines and samples for the reflective, thermal, and pan bands */
+    if ((val = mtl_find2 (mtl_table, "REFLECTIVE_SAMPLES",
+        "PRODUCT_SAMPLES_REF")) != NULL)
+        sscanf (val, "%d", &tmp_bmeta.nsamps);
+    if ((val = mtl_find2 (mtl_table, "REFLECTIVE_LINES",
+        "PRODUCT_LINES_REF")) != NULL)
+        sscanf (val, "%d", &tmp_bmeta.nlines);
+    if ((val = mtl_find2 (mtl_table, "THERMAL_SAMPLES",
+        "PRODUCT_SAMPLES_THM")) != NULL)
+        sscanf (val, "%d", &tmp_bmeta_th.nsamps);
+    if ((val = mtl_find2 (mtl_table, "THERMAL_LINES",
+        "PRODUCT_LINES_THM")) != NULL)
+        sscanf (val, "%d", &tmp_bmeta_th.nlines);
+    if ((val = mtl_find2 (mtl_table, "PANCHROMATIC_SAMPLES",
+        "PRODUCT_SAMPLES_PAN")) != NULL)
+        sscanf (val, "%d", &tmp_bmeta_pan.nsamps);
+    if ((val = mtl_find2 (mtl_table, "PANCHROMATIC_LINES",
+        "PRODUCT_LINES_PAN")) != NULL)
+        sscanf (val, "%d", &tmp_bmeta_pan.nlines);
+
+    /* Projection information */
+    if ((val = mtl_find (mtl_table, "MAP_PROJECTION")) != NULL)
+    {
+        if (!strcmp (val, "UTM"))
+            gmeta->proj_info.proj_type = GCTP_UTM_PROJ;
+        else if (!strcmp (val, "PS"))
+            gmeta->proj_info.proj_type = GCTP_PS_PROJ;
+        else
+        {
+            sprintf (errmsg, "Unsupported projection type: %s. "
+                "Only UTM and PS are supported for LPGS.", val);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+    }
 
-                /* Assume that if the reflectance gain value for band 1 is
-                   available, then the gain and bias values for all bands will
-                   be available */
-                refl_gain_bias_available = true;
-            }
-            else if (!strcmp (label, "REFLECTANCE_MULT_BAND_2"))
-                sscanf (tokenptr, "%f", &refl_gain[1]);
-            else if (!strcmp (label, "REFLECTANCE_MULT_BAND_3"))
-                sscanf (tokenptr, "%f", &refl_gain[2]);
-            else if (!strcmp (label, "REFLECTANCE_MULT_BAND_4"))
-                sscanf (tokenptr, "%f", &refl_gain[3]);
-            else if (!strcmp (label, "REFLECTANCE_MULT_BAND_5"))
-                sscanf (tokenptr, "%f", &refl_gain[4]);
-            else if (!strcmp (label, "REFLECTANCE_MULT_BAND_6"))
-                sscanf (tokenptr, "%f", &refl_gain[5]);
-            else if (!strcmp (label, "REFLECTANCE_MULT_BAND_7"))
-            {
-                if (!strcmp (gmeta->instrument, "TM") ||
-                    !strcmp (gmeta->instrument, "OLI_TIRS") ||
-                    !strcmp (gmeta->instrument, "OLI"))
-                    sscanf (tokenptr, "%f", &refl_gain[6]);
-                else if (!strncmp (gmeta->instrument, "ETM", 3))
-                    sscanf (tokenptr, "%f", &refl_gain[7]);
-            }
-            else if (!strcmp (label, "REFLECTANCE_MULT_BAND_8"))
-            {
-                if (!strcmp (gmeta->instrument, "OLI_TIRS") ||
-                    !strcmp (gmeta->instrument, "OLI"))
-                    sscanf (tokenptr, "%f", &refl_gain[7]);
-                else if (!strncmp (gmeta->instrument, "ETM", 3))
-                    sscanf (tokenptr, "%f", &refl_gain[8]);
-            }
-            else if (!strcmp (label, "REFLECTANCE_MULT_BAND_6_VCID_1"))
-                sscanf (tokenptr, "%f", &refl_gain[5]);
-            else if (!strcmp (label, "REFLECTANCE_MULT_BAND_6_VCID_2"))
-                sscanf (tokenptr, "%f", &refl_gain[6]);
-            else if (!strcmp (label, "REFLECTANCE_MULT_BAND_9"))
-                sscanf (tokenptr, "%f", &refl_gain[8]);
-
-            /* Read the reflectance biases */
-            else if (!strcmp (label, "REFLECTANCE_ADD_BAND_1"))
-                sscanf (tokenptr, "%f", &refl_bias[0]);
-            else if (!strcmp (label, "REFLECTANCE_ADD_BAND_2"))
-                sscanf (tokenptr, "%f", &refl_bias[1]);
-            else if (!strcmp (label, "REFLECTANCE_ADD_BAND_3"))
-                sscanf (tokenptr, "%f", &refl_bias[2]);
-            else if (!strcmp (label, "REFLECTANCE_ADD_BAND_4"))
-                sscanf (tokenptr, "%f", &refl_bias[3]);
-            else if (!strcmp (label, "REFLECTANCE_ADD_BAND_5"))
-                sscanf (tokenptr, "%f", &refl_bias[4]);
-            else if (!strcmp (label, "REFLECTANCE_ADD_BAND_6"))
-                sscanf (tokenptr, "%f", &refl_bias[5]);
-            else if (!strcmp (label, "REFLECTANCE_ADD_BAND_7"))
-            {
-                if (!strcmp (gmeta->instrument, "TM") ||
-                    !strcmp (gmeta->instrument, "OLI_TIRS") ||
-                    !strcmp (gmeta->instrument, "OLI"))
-                    sscanf (tokenptr, "%f", &refl_bias[6]);
-                else if (!strncmp (gmeta->instrument, "ETM", 3))
-                    sscanf (tokenptr, "%f", &refl_bias[7]);
-            }
-            else if (!strcmp (label, "REFLECTANCE_ADD_BAND_8"))
+    if ((val = mtl_find2 (mtl_table, "DATUM", "REFERENCE_DATUM")) != NULL)
+    {
+        if (!strcmp (val, "WGS84"))
+            gmeta->proj_info.datum_type = ESPA_WGS84;
+        else
+        {
+            sprintf (errmsg, "Unexpected datum type: %s", val);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+    }
+
+    if ((val = mtl_find2 (mtl_table, "GRID_CELL_SIZE_REFLECTIVE",
+        "GRID_CELL_SIZE_REF")) != NULL)
+    {
+        sscanf (val, "%lf", &tmp_bmeta.pixel_size[0]);
+        tmp_bmeta.pixel_size[1] = tmp_bmeta.pixel_size[0];
+    }
+    if ((val = mtl_find2 (mtl_table, "GRID_CELL_SIZE_THERMAL",
+        "GRID_CELL_SIZE_THM")) != NULL)
+    {
+        sscanf (val, "%lf", &tmp_bmeta_th.pixel_size[0]);
+        tmp_bmeta_th.pixel_size[1] = tmp_bmeta_th.pixel_size[0];
+    }
+    if ((val = mtl_find2 (mtl_table, "GRID_CELL_SIZE_PANCHROMATIC",
+        "GRID_CELL_SIZE_PAN")) != NULL)
+    {
+        sscanf (val, "%lf", &tmp_bmeta_pan.pixel_size[0]);
+        tmp_bmeta_pan.pixel_size[1] = tmp_bmeta_pan.pixel_size[0];
+    }
+
+    if ((val = mtl_find2 (mtl_table, "UTM_ZONE", "ZONE_NUMBER")) != NULL)
+        sscanf (val, "%d", &gmeta->proj_info.utm_zone);
+    if ((val = mtl_find2 (mtl_table, "VERTICAL_LON_FROM_POLE",
+        "VERTICAL_LONGITUDE_FROM_POLE")) != NULL)
+        sscanf (val, "%lf", &gmeta->proj_info.longitude_pole);
+    if ((val = mtl_find2 (mtl_table, "TRUE_SCALE_LAT",
+        "LATITUDE_OF_TRUE_SCALE")) != NULL)
+        sscanf (val, "%lf", &gmeta->proj_info.latitude_true_scale);
+    if ((val = mtl_find (mtl_table, "FALSE_EASTING")) != NULL)
+        sscanf (val, "%lf", &gmeta->proj_info.false_easting);
+    if ((val = mtl_find (mtl_table, "FALSE_NORTHING")) != NULL)
+        sscanf (val, "%lf", &gmeta->proj_info.false_northing);
+
+    if ((val = mtl_find (mtl_table, "RESAMPLING_OPTION")) != NULL)
+    {
+        if (!strcmp (val, "CUBIC_CONVOLUTION"))
+            tmp_bmeta.resample_method = ESPA_CC;
+        else if (!strcmp (val, "NEAREST_NEIGHBOR"))
+            tmp_bmeta.resample_method = ESPA_NN;
+        else if (!strcmp (val, "BILINEAR"))
+            tmp_bmeta.resample_method = ESPA_BI;
+        else
+        {
+            sprintf (errmsg, "Unsupported resampling option: %s", val);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+    }
+
+    /* Select the band table driver for this instrument now that the
+       instrument is known from the table; the band numbers in the parameter
+       names map to different band slots per instrument since bands 6L and
+       6H throw off the count for ETM+, and the per-band attributes below
+       become lookups into the driver's slot table */
+    inst = lpgs_instrument_driver (gmeta->instrument);
+    if (inst == NULL)
+    {
+        sprintf (errmsg, "Unsupported instrument type: %s. Only TM, ETM+, "
+            "OLI, and OLI_TIRS are currently supported.", gmeta->instrument);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* The TM short name depends on which satellite carried the instrument */
+    short_name = inst->short_name;
+    if (short_name == NULL)
+    {
+        if (!strcmp (gmeta->satellite, "LANDSAT_4"))
+            short_name = "LT4DN";
+        else if (!strcmp (gmeta->satellite, "LANDSAT_5"))
+            short_name = "LT5DN";
+    }
+
+    /* Read the band file names, min/max pixel values, and the radiance,
+       reflectance, and thermal constants for each band slot */
+    for (i = 0; i < inst->nband_slots; i++)
+    {
+        /* Band file names */
+        sprintf (key1, "FILE_NAME_BAND_%s", inst->suffix[i]);
+        sprintf (key2, "BAND%s_FILE_NAME", inst->suffix_old[i]);
+        if ((val = mtl_find2 (mtl_table, key1, key2)) != NULL)
+        {
+            count = snprintf (band_fname[i], sizeof (band_fname[i]), "%s",
+                val);
+            if (count < 0 || count >= sizeof (band_fname[i]))
             {
-                if (!strcmp (gmeta->instrument, "OLI_TIRS") ||
-                    !strcmp (gmeta->instrument, "OLI"))
-                    sscanf (tokenptr, "%f", &refl_bias[7]);
-                else if (!strncmp (gmeta->instrument, "ETM", 3))
-                    sscanf (tokenptr, "%f", &refl_bias[8]);
+                sprintf (errmsg, "Overflow of band_fname[%d] string", i);
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
             }
-            else if (!strcmp (label, "REFLECTANCE_ADD_BAND_6_VCID_1"))
-                sscanf (tokenptr, "%f", &refl_bias[5]);
-            else if (!strcmp (label, "REFLECTANCE_ADD_BAND_6_VCID_2"))
-                sscanf (tokenptr, "%f", &refl_bias[6]);
-            else if (!strcmp (label, "REFLECTANCE_ADD_BAND_9"))
-                sscanf (tokenptr, "%f", &refl_bias[8]);
-
-            /* Read the K1, K2 constants */
-            /* TIRS */
-            else if (!strcmp (label, "K1_CONSTANT_BAND_10"))
-                sscanf (tokenptr, "%f", &k1[9]);
-            else if (!strcmp (label, "K1_CONSTANT_BAND_11"))
-                sscanf (tokenptr, "%f", &k1[10]);
-            else if (!strcmp (label, "K2_CONSTANT_BAND_10"))
-                sscanf (tokenptr, "%f", &k2[9]);
-            else if (!strcmp (label, "K2_CONSTANT_BAND_11"))
-                sscanf (tokenptr, "%f", &k2[10]);
-
-            /* ETM+ */
-            else if (!strcmp (label, "K1_CONSTANT_BAND_6_VCID_1"))
-                sscanf (tokenptr, "%f", &k1[5]);
-            else if (!strcmp (label, "K1_CONSTANT_BAND_6_VCID_2"))
-                sscanf (tokenptr, "%f", &k1[6]);
-            else if (!strcmp (label, "K2_CONSTANT_BAND_6_VCID_1"))
-                sscanf (tokenptr, "%f", &k2[5]);
-            else if (!strcmp (label, "K2_CONSTANT_BAND_6_VCID_2"))
-                sscanf (tokenptr, "%f", &k2[6]);
-
-            /* TM */
-            else if (!strcmp (label, "K1_CONSTANT_BAND_6"))
-                sscanf (tokenptr, "%f", &k1[5]);
-            else if (!strcmp (label, "K2_CONSTANT_BAND_6"))
-                sscanf (tokenptr, "%f", &k2[5]);
-        } /* end if tokenptr */
-
-        /* If we are done */
-        if (done_with_mtl)
-            break;
-    }  /* end while fgets */
+        }
+
+        /* Min/max pixel values */
+        sprintf (key1, "QUANTIZE_CAL_MIN_BAND_%s", inst->suffix[i]);
+        sprintf (key2, "QCALMIN_BAND%s", inst->suffix_old[i]);
+        if ((val = mtl_find2 (mtl_table, key1, key2)) != NULL)
+            sscanf (val, "%d", &band_min[i]);
+
+        sprintf (key1, "QUANTIZE_CAL_MAX_BAND_%s", inst->suffix[i]);
+        sprintf (key2, "QCALMAX_BAND%s", inst->suffix_old[i]);
+        if ((val = mtl_find2 (mtl_table, key1, key2)) != NULL)
+            sscanf (val, "%d", &band_max[i]);
+
+        /* Radiance gain/bias */
+        sprintf (key1, "RADIANCE_MULT_BAND_%s", inst->suffix[i]);
+        if ((val = mtl_find (mtl_table, key1)) != NULL)
+            sscanf (val, "%f", &band_gain[i]);
+        sprintf (key1, "RADIANCE_ADD_BAND_%s", inst->suffix[i]);
+        if ((val = mtl_find (mtl_table, key1)) != NULL)
+            sscanf (val, "%f", &band_bias[i]);
+
+        /* TOA reflectance gain/bias; these don't exist for the thermal
+           bands, so the lookups simply miss */
+        sprintf (key1, "REFLECTANCE_MULT_BAND_%s", inst->suffix[i]);
+        if ((val = mtl_find (mtl_table, key1)) != NULL)
+            sscanf (val, "%f", &refl_gain[i]);
+        sprintf (key1, "REFLECTANCE_ADD_BAND_%s", inst->suffix[i]);
+        if ((val = mtl_find (mtl_table, key1)) != NULL)
+            sscanf (val, "%f", &refl_bias[i]);
+
+        /* K1/K2 constants; these only exist for the thermal bands */
+        sprintf (key1, "K1_CONSTANT_BAND_%s", inst->suffix[i]);
+        if ((val = mtl_find (mtl_table, key1)) != NULL)
+            sscanf (val, "%f", &k1[i]);
+        sprintf (key1, "K2_CONSTANT_BAND_%s", inst->suffix[i]);
+        if ((val = mtl_find (mtl_table, key1)) != NULL)
+            sscanf (val, "%f", &k2[i]);
+    }
+
+    /* Quality band file name for OLI/OLI_TIRS */
+    if (inst->qa_slot >= 0 &&
+        (val = mtl_find (mtl_table, "FILE_NAME_BAND_QUALITY")) != NULL)
+    {
+        count = snprintf (band_fname[inst->qa_slot],
+            sizeof (band_fname[inst->qa_slot]), "%s", val);
+        if (count < 0 || count >= sizeof (band_fname[inst->qa_slot]))
+        {
+            sprintf (errmsg, "Overflow of the quality band_fname string");
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+    }
+
+    /* Assume that if the gain values for band 1 are available, then the
+       gain and bias values for all bands will be available */
+    gain_bias_available =
+        (mtl_find (mtl_table, "RADIANCE_MULT_BAND_1") != NULL);
+    refl_gain_bias_available =
+        (mtl_find (mtl_table, "REFLECTANCE_MULT_BAND_1") != NULL);
 
     /* Set defaults that aren't in the MTL file */
     gmeta->wrs_system = 2;
@@ -949,22 +1049,9 @@ int read_lpgs_mtl
        corners as the center of the pixel. */
     strcpy (gmeta->proj_info.grid_origin, "CENTER");
 
-    /* Set up the number of total bands */
-    if (!strcmp (gmeta->instrument, "TM"))
-        metadata->nbands = 7;
-    else if (!strncmp (gmeta->instrument, "ETM", 3))
-        metadata->nbands = 9;
-    else if (!strcmp (gmeta->instrument, "OLI_TIRS"))
-        metadata->nbands = 12;  /* 11 image plus QA band */
-    else if (!strcmp (gmeta->instrument, "OLI"))
-        metadata->nbands = 10;  /* 9 image plus QA band */
-    else
-    {
-        sprintf (errmsg, "Unsupported instrument type: %s. Only TM, ETM+, OLI, "
-            "and OLI_TIRS are currently supported.", gmeta->instrument);
-        error_handler (true, FUNC_NAME, errmsg);
-        return (ERROR);
-    }
+    /* Set up the number of total bands from the driver, which counts the
+       QA band for OLI/OLI_TIRS */
+    metadata->nbands = inst->nbands;
 
     if (allocate_band_metadata (metadata, metadata->nbands) != SUCCESS)
     {   /* Error messages already printed */
@@ -996,6 +1083,9 @@ int read_lpgs_mtl
     *nlpgs_bands = metadata->nbands;
     for (i = 0; i < metadata->nbands; i++)
     {
+        /* Look up this band's slot attributes in the driver's table */
+        slot = &inst->slots[i];
+
         /* Handle the general metadata for each band */
         count = snprintf (lpgs_bands[i], sizeof (lpgs_bands[i]), "%s",
             band_fname[i]);
@@ -1014,10 +1104,7 @@ int read_lpgs_mtl
             error_handler (true, FUNC_NAME, errmsg);
             return (ERROR);
         }
-        if ((!strcmp (gmeta->instrument, "OLI_TIRS") &&
-             i == 11 /* band quality */) ||
-            (!strcmp (gmeta->instrument, "OLI") &&
-             i == 9 /* band quality */))
+        if (slot->role == LPGS_BAND_QUALITY)
         {
             /* This is a QA band and needs the class values set up */
             strcpy (bmeta[i].category, "qa");
@@ -1047,13 +1134,9 @@ int read_lpgs_mtl
 
         if (refl_gain_bias_available)
         {
-            /* Reflectance gain/bias values don't exist for the thermal bands */
-            if ((!strncmp (gmeta->instrument, "ETM", 3) &&
-                ((i != 5 /* band 61 */) && (i != 6 /* band 62 */))) ||
-                (!strcmp (gmeta->instrument, "TM") &&
-                (i != 5 /* band 6 */)) ||
-                (!strcmp (gmeta->instrument, "OLI_TIRS") &&
-                ((i != 9 /* band 10 */) && (i != 10 /* band 11 */))))
+            /* Reflectance gain/bias values don't exist for the thermal
+               bands; the OLI-only driver keeps K1/K2 for every band */
+            if (inst->refl_by_role && slot->role != LPGS_BAND_THERMAL)
             {
                 bmeta[i].refl_gain = refl_gain[i];
                 bmeta[i].refl_bias = refl_bias[i];
@@ -1093,178 +1176,52 @@ int read_lpgs_mtl
             return (ERROR);
         }
 
-        bmeta[i].resample_method = tmp_bmeta.resample_method;
-        if (!strcmp (gmeta->instrument, "TM"))
-        {
-            bmeta[i].data_type = ESPA_UINT8;
-            bmeta[i].fill_value = 0;
-            if (!strcmp (gmeta->satellite, "LANDSAT_4"))
-                strcpy (bmeta[i].short_name, "LT4DN");
-            else if (!strcmp (gmeta->satellite, "LANDSAT_5"))
-                strcpy (bmeta[i].short_name, "LT5DN");
-        }
-        else if (!strncmp (gmeta->instrument, "ETM", 3))
-        {
-            bmeta[i].data_type = ESPA_UINT8;
-            bmeta[i].fill_value = 0;
-            strcpy (bmeta[i].short_name, "LE7DN");
-        }
-        else if (!strcmp (gmeta->instrument, "OLI_TIRS"))
-        {
-            bmeta[i].data_type = ESPA_UINT16;
-            bmeta[i].fill_value = 0;
-            strcpy (bmeta[i].short_name, "LC8DN");
-        }
-        else if (!strcmp (gmeta->instrument, "OLI"))
-        {
-            bmeta[i].data_type = ESPA_UINT16;
-            bmeta[i].fill_value = 0;
-            strcpy (bmeta[i].short_name, "LO8DN");
-        }
-
-        /* Handle the ETM+ and TIRS thermal bands */
-        if ((!strncmp (gmeta->instrument, "ETM", 3) &&
-            ((i == 5 /* band 61 */) || (i == 6 /* band 62 */))) ||
-            (!strcmp (gmeta->instrument, "TM") &&
-            (i == 5 /* band 6 */)) ||
-            (!strcmp (gmeta->instrument, "OLI_TIRS") &&
-            ((i == 9 /* band 10 */) || (i == 10 /* band 11 */))))
-        {
-            if (!strncmp (gmeta->instrument, "ETM", 3) &&
-               (i == 5 /* band 61 */))
-            {
-                strcpy (bmeta[i].name, "band61");
-                strcpy (bmeta[i].long_name, "band 61 digital numbers");
-                count = snprintf (bmeta[i].file_name,
-                    sizeof (bmeta[i].file_name), "%s_B61.img", scene_id);
-                if (count < 0 || count >= sizeof (bmeta[i].file_name))
-                {
-                    sprintf (errmsg, "Overflow of bmeta[i].file_name");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
-            else if (!strncmp (gmeta->instrument, "ETM", 3) &&
-                (i == 6 /* band 62 */))
-            {
-                strcpy (bmeta[i].name, "band62");
-                strcpy (bmeta[i].long_name, "band 62 digital numbers");
-                count = snprintf (bmeta[i].file_name,
-                    sizeof (bmeta[i].file_name), "%s_B62.img", scene_id);
-                if (count < 0 || count >= sizeof (bmeta[i].file_name))
-                {
-                    sprintf (errmsg, "Overflow of bmeta[i].file_name");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
-            else
-            {
-                sprintf (bmeta[i].name, "band%d", i+1);
-                sprintf (bmeta[i].long_name, "band %d digital numbers", i+1);
-                count = snprintf (bmeta[i].file_name,
-                    sizeof (bmeta[i].file_name), "%s_B%d.img", scene_id, i+1);
-                if (count < 0 || count >= sizeof (bmeta[i].file_name))
-                {
-                    sprintf (errmsg, "Overflow of bmeta[i].file_name string");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
-           
-            bmeta[i].nlines = tmp_bmeta_th.nlines;
-            bmeta[i].nsamps = tmp_bmeta_th.nsamps;
-            bmeta[i].pixel_size[0] = tmp_bmeta_th.pixel_size[0];
-            bmeta[i].pixel_size[1] = tmp_bmeta_th.pixel_size[1];
-        }
-
-        /* Handle the pan bands */
-        else if ((!strncmp (gmeta->instrument, "ETM", 3) &&
-            (i == 8 /* band 8 */)) ||
-            (!strncmp (gmeta->instrument, "OLI", 3) &&
-            ((i == 7 /* band 8 */))))
-        {
-            strcpy (bmeta[i].name, "band8");
-            strcpy (bmeta[i].long_name, "band 8 digital numbers");
-            count = snprintf (bmeta[i].file_name, sizeof (bmeta[i].file_name),
-                "%s_B8.img", scene_id);
-            if (count < 0 || count >= sizeof (bmeta[i].file_name))
-            {
-                sprintf (errmsg, "Overflow of bmeta[i].file_name string");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            bmeta[i].nlines = tmp_bmeta_pan.nlines;
-            bmeta[i].nsamps = tmp_bmeta_pan.nsamps;
-            bmeta[i].pixel_size[0] = tmp_bmeta_pan.pixel_size[0];
-            bmeta[i].pixel_size[1] = tmp_bmeta_pan.pixel_size[1];
-        }
-
-        /* Handle the OLI_TIRS quality band */
-        else if ((!strcmp (gmeta->instrument, "OLI_TIRS") &&
-            (i == 11 /* quality band */)) ||
-            (!strcmp (gmeta->instrument, "OLI") &&
-            (i == 9 /* quality band */)))
-        {
-            strcpy (bmeta[i].name, "qa");
-            strcpy (bmeta[i].long_name, "band quality");
-            count = snprintf (bmeta[i].file_name, sizeof (bmeta[i].file_name),
-                "%s_BQA.img", scene_id);
-            if (count < 0 || count >= sizeof (bmeta[i].file_name))
-            {
-                sprintf (errmsg, "Overflow of bmeta[i].file_name string");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            bmeta[i].nlines = tmp_bmeta.nlines;
-            bmeta[i].nsamps = tmp_bmeta.nsamps;
-            bmeta[i].pixel_size[0] = tmp_bmeta.pixel_size[0];
-            bmeta[i].pixel_size[1] = tmp_bmeta.pixel_size[1];
-        }
-
-        /* Handle the TM/OLI thermal and all reflective bands */
-        else
-        {
-            if (!strncmp (gmeta->instrument, "ETM", 3) && i > 6)
-            {
-                strcpy (bmeta[i].name, "band7");
-                strcpy (bmeta[i].long_name, "band 7 digital numbers");
-                count = snprintf (bmeta[i].file_name,
-                    sizeof (bmeta[i].file_name), "%s_B7.img", scene_id);
-                if (count < 0 || count >= sizeof (bmeta[i].file_name))
-                {
-                    sprintf (errmsg, "Overflow of bmeta[i].file_name string");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
-            else  /* bands 1-5 */
-            {
-                sprintf (bmeta[i].name, "band%d", i+1);
-                sprintf (bmeta[i].long_name, "band %d digital numbers", i+1);
-                count = snprintf (bmeta[i].file_name,
-                    sizeof (bmeta[i].file_name), "%s_B%d.img", scene_id, i+1);
-                if (count < 0 || count >= sizeof (bmeta[i].file_name))
-                {
-                    sprintf (errmsg, "Overflow of bmeta[i].file_name string");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
-            bmeta[i].nlines = tmp_bmeta.nlines;
-            bmeta[i].nsamps = tmp_bmeta.nsamps;
-            bmeta[i].pixel_size[0] = tmp_bmeta.pixel_size[0];
-            bmeta[i].pixel_size[1] = tmp_bmeta.pixel_size[1];
-        }
-
-        /* If this is the OLI_TIRS QA band, then overwrite some things for the
+        bmeta[i].resample_method = tmp_bmeta.resample_method;
+        bmeta[i].data_type = inst->data_type;
+        bmeta[i].fill_value = inst->fill_value;
+        if (short_name != NULL)
+            strcpy (bmeta[i].short_name, short_name);
+
+        /* Band names, long names, and filenames come straight from the
+           slot table; the band's role picks which resolution applies */
+        strcpy (bmeta[i].name, slot->name);
+        strcpy (bmeta[i].long_name, slot->long_name);
+        count = snprintf (bmeta[i].file_name, sizeof (bmeta[i].file_name),
+            "%s_%s.img", scene_id, slot->file_tag);
+        if (count < 0 || count >= sizeof (bmeta[i].file_name))
+        {
+            sprintf (errmsg, "Overflow of bmeta[i].file_name string");
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+
+        switch (slot->role)
+        {
+            case LPGS_BAND_THERMAL:
+                bmeta[i].nlines = tmp_bmeta_th.nlines;
+                bmeta[i].nsamps = tmp_bmeta_th.nsamps;
+                bmeta[i].pixel_size[0] = tmp_bmeta_th.pixel_size[0];
+                bmeta[i].pixel_size[1] = tmp_bmeta_th.pixel_size[1];
+                break;
+
+            case LPGS_BAND_PAN:
+                bmeta[i].nlines = tmp_bmeta_pan.nlines;
+                bmeta[i].nsamps = tmp_bmeta_pan.nsamps;
+                bmeta[i].pixel_size[0] = tmp_bmeta_pan.pixel_size[0];
+                bmeta[i].pixel_size[1] = tmp_bmeta_pan.pixel_size[1];
+                break;
+
+            default:  /* reflective and quality bands */
+                bmeta[i].nlines = tmp_bmeta.nlines;
+                bmeta[i].nsamps = tmp_bmeta.nsamps;
+                bmeta[i].pixel_size[0] = tmp_bmeta.pixel_size[0];
+                bmeta[i].pixel_size[1] = tmp_bmeta.pixel_size[1];
+                break;
+        }
+
+        /* If this is the QA band, then overwrite some things for the
            QA band itself */
-        if ((!strcmp (gmeta->instrument, "OLI_TIRS") &&
-             i == 11 /* band quality */) ||
-            ((!strcmp (gmeta->instrument, "OLI") &&
-             i == 9 /* band quality */)))
+        if (slot->role == LPGS_BAND_QUALITY)
         {
             count = snprintf (bmeta[i].data_units, sizeof (bmeta[i].data_units),
                 "quality/feature classification");
@@ -1313,11 +1270,18 @@ int read_lpgs_mtl
             strcpy (bmeta[i].bitmap_description[13], "Cirrus Confidence");
             strcpy (bmeta[i].bitmap_description[14], "Cloud Confidence");
             strcpy (bmeta[i].bitmap_description[15], "Cloud Confidence");
+
+            /* Intern the populated set; the QA bands of a batch all carry
+               this same schema, so they share one copy */
+            if (intern_bitmap_metadata (&bmeta[i]) != SUCCESS)
+            {  /* Error messages already printed */
+                return (ERROR);
+            }
         }
     }
 
     /* Close the metadata file */
-    fclose (mtl_fptr);
+    free (mtl_table);
 
     /* Get geolocation information from the XML file to prepare for computing
        the bounding coordinates */
@@ -1345,8 +1309,8 @@ int read_lpgs_mtl
        southernmost latitude.  However, the UL corner in this case would be
        more south than the LR corner.  Comparing the UL and LR corners will
        allow the user to determine if the scene is flipped. */
-    if (!compute_bounds (geoloc_map, tmp_bmeta.nlines, tmp_bmeta.nsamps,
-        &bounds))
+    if (!compute_bounds_analytic (geoloc_map, tmp_bmeta.nlines,
+        tmp_bmeta.nsamps, &bounds))
     {
         sprintf (errmsg, "Setting up the geolocation mapping structure.");
         error_handler (true, FUNC_NAME, errmsg);
@@ -1365,11 +1329,151 @@ int read_lpgs_mtl
 }
 
 
+/******************************************************************************
+MODULE:  gtif_direct_copy
+
+PURPOSE: Copy the pixel data of an uncompressed striped GeoTIFF straight to
+the raw binary file from a memory map of the input file, bypassing the
+scanline reads and the staging buffer.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error writing the mapped pixel data to the raw binary file
+SUCCESS         The direct copy was made, or the fast path does not apply
+                (indicated via fast_path)
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Write the strips through write_raw_binary so
+                              direct-write output files are supported
+
+NOTES:
+  1. The fast path applies to uncompressed, striped, single-sample TIFFs in
+     native byte order whose strips hold exactly the expected scanline data;
+     anything else silently falls back to the scanline path.
+  2. All the strips are validated against the mapped file size before any
+     data is written, so a fallback never leaves partial data in the raw
+     binary file.
+******************************************************************************/
+static int gtif_direct_copy
+(
+    TIFF *fp_tiff,             /* I: file pointer for the TIFF file */
+    char *gtif_file,           /* I: name of the input GeoTIFF file */
+    Espa_band_meta_t *bmeta,   /* I: pointer to band metadata for this band */
+    int nbytes,                /* I: number of bytes in the data type */
+    FILE *fp_rb,               /* I: file pointer for the raw binary file */
+    bool *fast_path            /* O: was the direct copy made? */
+)
+{
+    char FUNC_NAME[] = "gtif_direct_copy";  /* function name */
+    char errmsg[STR_SIZE];     /* error message */
+    uint16 compression;        /* TIFF compression scheme */
+    uint16 planar_config;      /* TIFF planar configuration */
+    uint16 samples_per_pixel;  /* number of samples per pixel */
+    uint16 bits_per_sample;    /* number of bits per sample */
+    uint32 rows_per_strip;     /* number of rows in each strip */
+    uint32 nrows;              /* number of rows in the current strip */
+    tstrip_t strip;            /* current strip */
+    tstrip_t nstrips;          /* number of strips in the TIFF file */
+#if TIFFLIB_VERSION >= 20100101
+    uint64 *strip_offset = NULL;  /* array of strip file offsets */
+    uint64 *strip_bytes = NULL;   /* array of strip byte counts */
+#else
+    uint32 *strip_offset = NULL;  /* array of strip file offsets */
+    uint32 *strip_bytes = NULL;   /* array of strip byte counts */
+#endif
+    size_t line_size;          /* size of a single scanline in bytes */
+    size_t strip_size;         /* expected size of the current strip */
+    void *map_addr = NULL;     /* address of the mapped input file */
+    size_t map_length;         /* length of the mapped input file */
+
+    *fast_path = false;
+
+    /* The fast path only handles uncompressed, striped, single-sample data
+       in native byte order, where the strips are raw scanlines */
+    if (TIFFIsTiled (fp_tiff))
+        return (SUCCESS);
+    if (!TIFFGetFieldDefaulted (fp_tiff, TIFFTAG_COMPRESSION, &compression) ||
+        compression != COMPRESSION_NONE)
+        return (SUCCESS);
+    if (!TIFFGetFieldDefaulted (fp_tiff, TIFFTAG_PLANARCONFIG,
+        &planar_config) || planar_config != PLANARCONFIG_CONTIG)
+        return (SUCCESS);
+    if (!TIFFGetFieldDefaulted (fp_tiff, TIFFTAG_SAMPLESPERPIXEL,
+        &samples_per_pixel) || samples_per_pixel != 1)
+        return (SUCCESS);
+    if (!TIFFGetFieldDefaulted (fp_tiff, TIFFTAG_BITSPERSAMPLE,
+        &bits_per_sample) || bits_per_sample != nbytes * 8)
+        return (SUCCESS);
+    if (nbytes > 1 && TIFFIsByteSwapped (fp_tiff))
+        return (SUCCESS);
+    if (!TIFFGetFieldDefaulted (fp_tiff, TIFFTAG_ROWSPERSTRIP,
+        &rows_per_strip) || rows_per_strip == 0)
+        return (SUCCESS);
+    if (!TIFFGetField (fp_tiff, TIFFTAG_STRIPOFFSETS, &strip_offset) ||
+        !TIFFGetField (fp_tiff, TIFFTAG_STRIPBYTECOUNTS, &strip_bytes))
+        return (SUCCESS);
+    nstrips = TIFFNumberOfStrips (fp_tiff);
+    if (nstrips == 0)
+        return (SUCCESS);
+
+    /* Map the input file */
+    if (open_raw_binary_mapped (gtif_file, &map_addr, &map_length) != SUCCESS)
+        return (SUCCESS);
+
+    /* Validate every strip against the mapped file size before writing
+       anything, so a fallback never leaves partial data behind */
+    line_size = (size_t) bmeta->nsamps * nbytes;
+    for (strip = 0; strip < nstrips; strip++)
+    {
+        nrows = rows_per_strip;
+        if ((uint32) (strip * rows_per_strip) + nrows >
+            (uint32) bmeta->nlines)
+            nrows = bmeta->nlines - strip * rows_per_strip;
+
+        strip_size = (size_t) nrows * line_size;
+        if ((size_t) strip_bytes[strip] != strip_size ||
+            (size_t) strip_offset[strip] + strip_size > map_length)
+        {
+            close_raw_binary_mapped (map_addr, map_length);
+            return (SUCCESS);
+        }
+    }
+
+    /* Write the mapped pixel data of each strip straight to the raw binary
+       file */
+    for (strip = 0; strip < nstrips; strip++)
+    {
+        nrows = rows_per_strip;
+        if ((uint32) (strip * rows_per_strip) + nrows >
+            (uint32) bmeta->nlines)
+            nrows = bmeta->nlines - strip * rows_per_strip;
+
+        if (write_raw_binary (fp_rb, nrows, bmeta->nsamps, nbytes,
+            (char *) map_addr + strip_offset[strip]) != SUCCESS)
+        {
+            sprintf (errmsg, "Writing mapped strip %d to the raw binary "
+                "file", (int) strip);
+            error_handler (true, FUNC_NAME, errmsg);
+            close_raw_binary_mapped (map_addr, map_length);
+            return (ERROR);
+        }
+    }
+
+    close_raw_binary_mapped (map_addr, map_length);
+    *fast_path = true;
+    return (SUCCESS);
+}
+
+
 /******************************************************************************
 MODULE:  convert_gtif_to_img
 
-PURPOSE: Convert the LPGS GeoTIFF band to ESPA raw binary (.img) file and
-writes the associated ENVI header for each band.
+PURPOSE: Convert the LPGS GeoTIFF band to ESPA raw binary (.img) file.
 
 RETURN VALUE:
 Type = int
@@ -1384,12 +1488,47 @@ Date         Programmer       Reason
 12/30/2013   Gail Schmidt     Original development
 2/12/2014    Gail Schmidt     Updated to support int16
 6/17/2014    Gail Schmidt     Updated to support uint16 for L8
+8/31/2026    Gail Schmidt     Stream the image a chunk of scanlines at a time
+                              instead of buffering the entire band in memory
+8/31/2026    Gail Schmidt     Added a direct-copy fast path for uncompressed
+                              striped TIFFs via a memory map of the input
+8/31/2026    Gail Schmidt     Advise the kernel of the sequential read of the
+                              TIFF file and drop its pages when finished
+8/31/2026    Gail Schmidt     Write the raw binary file with direct writes
+                              to keep the band out of the page cache
+8/31/2026    Gail Schmidt     Added performance instrumentation of the band
+                              conversion and the fast-path hit count
+8/31/2026    Gail Schmidt     The ENVI headers are now written in one batch
+                              by the caller instead of one per band here
+8/31/2026    Gail Schmidt     Optionally clamp the band to its valid range
+                              while the chunk is in cache (set
+                              ESPA_ENFORCE_VALID_RANGE)
+8/31/2026    Gail Schmidt     Optionally accumulate the band statistics while
+                              the chunk is in cache (set ESPA_COMPUTE_STATS)
+8/31/2026    Gail Schmidt     Allocate the chunk buffer through the NUMA-aware
+                              buffer allocator
+8/31/2026    Gail Schmidt     Optionally store runs of all-fill lines as
+                              filesystem holes for mostly-fill polar scenes
+                              (set ESPA_SPARSE_FILL; zero fill value only)
+8/31/2026    Gail Schmidt     Consume gzip-compressed inputs through the
+                              memory-backed inflate layer
+8/31/2026    Gail Schmidt     Resolve the type-specialized kernels once per
+                              band instead of re-branching per chunk
+8/31/2026    Gail Schmidt     Borrow the chunk buffer from the reuse pool
+                              instead of allocating it per band
+8/31/2026    Gail Schmidt     Open the band through the negotiated output
+                              sink so delivery compression happens during
+                              the conversion (set ESPA_IMG_COMPRESS)
+8/31/2026    Gail Schmidt     Poll the cooperative cancellation flag at
+                              the chunk boundaries
 
 NOTES:
 1. TIFF read scanline only supports reading a single line at a time.  We will
-   read a single line, stuff it into a large buffer, then write the entire
-   image at one time.  This is about 40% faster than reading a single line
-   then writing a single line.
+   read a chunk of lines into a buffer, write the chunk to the raw binary
+   file, then reuse the buffer for the next chunk.  This keeps the speedup of
+   writing large blocks (vs. a single line at a time) while bounding the
+   memory used per band to LPGS_GTIF_CHUNK_BYTES, regardless of the band
+   size.
 ******************************************************************************/
 int convert_gtif_to_img
 (
@@ -1400,22 +1539,59 @@ int convert_gtif_to_img
 {
     char FUNC_NAME[] = "convert_gtif_to_img";  /* function name */
     char errmsg[STR_SIZE];    /* error message */
-    char *cptr = NULL;        /* pointer to the file extension */
+    char tiff_path[STR_SIZE]; /* path of the (possibly inflated) TIFF input */
     char *img_file = NULL;    /* name of the output raw binary file */
-    char envi_file[STR_SIZE]; /* name of the output ENVI header file */
+    int gz_fd = -1;           /* descriptor backing an inflated gzip input */
+    int path_count;           /* number of chars copied in snprintf */
     int i;                    /* looping variable for lines in image */
     int nbytes;               /* number of bytes in the data type */
-    int count;                /* number of chars copied in snprintf */
-    void *file_buf = NULL;    /* pointer to correct input file buffer */
-    uint8 *file_buf_u8 = NULL;  /* buffer for uint8 TIFF data to be read */
-    int16 *file_buf_i16 = NULL; /* buffer for int16 TIFF data to be read */
-    int16 *file_buf_u16 = NULL; /* buffer for uint16 TIFF data to be read */
+    int chunk_nlines;         /* number of lines in the chunk buffer */
+    int curr_nlines;          /* number of lines in the current chunk */
+    int chunk_line;           /* first line of the current chunk */
+    bool fast_path;           /* was the mapped direct copy made? */
+    bool clamp_band;          /* clamp the band to its valid range? */
+    bool stats_band;          /* accumulate the band statistics? */
+    bool sparse_band;         /* store the all-fill lines as holes? */
+    bool run_fill;            /* is the current run of lines all fill? */
+    bool line_fill;           /* is the current line all fill? */
+    int line;                 /* first line of the current run */
+    int run_nlines;           /* number of lines in the current run */
+    long nfill_lines = 0;     /* number of all-fill lines stored as holes */
+    Espa_stat_accum_t stats;  /* running statistics accumulator */
+    Espa_band_kernels_t bkern;  /* resolved kernels for the band */
+    void *file_buf = NULL;    /* chunk buffer for the TIFF data to be read */
     TIFF *fp_tiff = NULL;     /* file pointer for the TIFF file */
     FILE *fp_rb = NULL;       /* file pointer for the raw binary file */
-    Envi_header_t envi_hdr;   /* output ENVI header information */
+    long long perf_start = espa_perf_start ();  /* instrumentation scope */
+
+    /* Inflate gzip-compressed inputs into a memory-backed file so the TIFF
+       reader can seek in them, without the temp-file write and re-read that
+       external decompression costs */
+    if (is_gzip_input (gtif_file))
+    {
+        if (open_gzip_input (gtif_file, tiff_path, sizeof (tiff_path),
+            &gz_fd) != SUCCESS)
+        {  /* Error messages already printed */
+            return (ERROR);
+        }
+    }
+    else
+    {
+        path_count = snprintf (tiff_path, sizeof (tiff_path), "%s",
+            gtif_file);
+        if (path_count < 0 || path_count >= sizeof (tiff_path))
+        {
+            sprintf (errmsg, "Overflow of tiff_path string");
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+    }
 
-    /* Open the TIFF file for reading */
-    fp_tiff = XTIFFOpen (gtif_file, "r");
+    /* Open the TIFF file for reading.  The TIFF interface holds its own
+       descriptor, so an inflated input can be released as soon as the open
+       has happened. */
+    fp_tiff = XTIFFOpen (tiff_path, "r");
+    close_gzip_input (gz_fd, tiff_path);
     if (fp_tiff == NULL)
     {
         sprintf (errmsg, "Opening the LPGS GeoTIFF file: %s", gtif_file);
@@ -1423,9 +1599,44 @@ int convert_gtif_to_img
         return (ERROR);
     }
 
-    /* Open the raw binary file for writing */
+    /* Let the kernel size the readahead for the sequential pass over the
+       TIFF file */
+    advise_raw_binary_fd_sequential (TIFFFileno (fp_tiff));
+
+    /* If sparse fill output was requested and the band fill value is
+       zero, runs of all-fill lines are stored as filesystem holes instead
+       of being written.  Holes read back as zero bytes, so only a zero
+       fill value round-trips; bands with a nonzero fill are written in
+       full.  The seeks this needs rule out the direct write path and the
+       mapped direct copy */
+    sparse_band = !raw_binary_compress_enabled () &&
+        espa_sparse_fill_enabled () && bmeta->fill_value == 0;
+
+    /* Open the raw binary file for direct writing; nothing on the node
+       reads the band again, so keep it out of the page cache.  Sparse
+       bands are opened with plain buffered access instead since the fill
+       holes are created by seeking past the all-fill lines.  Compressed
+       output also rules the holes out since a compressed stream cannot
+       seek, so the whole band is compressed instead */
     img_file = bmeta->file_name;
-    fp_rb = open_raw_binary (img_file, "wb");
+
+    /* Determine the number of bytes in the data type */
+    if (bmeta->data_type == ESPA_UINT8)
+        nbytes = sizeof (uint8);
+    else if (bmeta->data_type == ESPA_INT16)
+        nbytes = sizeof (int16);
+    else if (bmeta->data_type == ESPA_UINT16)
+        nbytes = sizeof (uint16);
+    else
+    {
+        sprintf (errmsg, "Unsupported data type.  Currently only uint8, "
+            "int16, and uint16 are supported.");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    fp_rb = open_raw_binary_band (img_file, bmeta->nlines, bmeta->nsamps,
+        nbytes, sparse_band ? "wb" : "wbd");
     if (fp_rb == NULL)
     {
         sprintf (errmsg, "Opening the output raw binary file: %s", img_file);
@@ -1433,159 +1644,363 @@ int convert_gtif_to_img
         return (ERROR);
     }
 
-    /* Allocate memory for the entire image, based on the input data type */
-    if (bmeta->data_type == ESPA_UINT8)
+    /* If valid range enforcement was requested and this band has a valid
+       range, the pixels need to flow through the chunk buffer to be
+       clamped, so the mapped direct copy (which writes the read-only
+       mapped strips straight out) is skipped for the band */
+    clamp_band = espa_valid_range_enforced () &&
+        bmeta->valid_range[0] != ESPA_INT_META_FILL &&
+        bmeta->valid_range[1] != ESPA_INT_META_FILL;
+
+    /* Same story for the fused statistics: they are accumulated from the
+       chunk buffer, so the direct copy is skipped when they were
+       requested */
+    stats_band = espa_stats_enabled ();
+    if (stats_band)
+        espa_stats_init (&stats);
+
+    /* Resolve the type-specialized kernels for the band once, so the chunk
+       loop below runs monomorphic loop bodies through the pointers instead
+       of re-branching on the data type for every chunk */
+    if (clamp_band || stats_band || sparse_band)
     {
-        nbytes = sizeof (uint8);
-        file_buf_u8 = calloc (bmeta->nlines * bmeta->nsamps, nbytes);
-        if (file_buf_u8 == NULL)
-        {
-            sprintf (errmsg, "Allocating memory for the image of uint8 data "
-                "containing %d lines x %d samples.", bmeta->nlines,
-                bmeta->nsamps);
-            error_handler (true, FUNC_NAME, errmsg);
+        if (espa_band_kernels_init (bmeta, &bkern) != SUCCESS)
+        {  /* Error messages already printed */
             return (ERROR);
         }
-        file_buf = file_buf_u8;
     }
-    else if (bmeta->data_type == ESPA_INT16)
+
+    /* For uncompressed striped TIFFs (the common case for LPGS products),
+       the strip data is already raw pixels in scanline order, so map the
+       input file and write the pixel region straight to the raw binary file
+       instead of funneling it through scanline reads */
+    fast_path = false;
+    if (!clamp_band && !stats_band && !sparse_band)
     {
-        nbytes = sizeof (int16);
-        file_buf_i16 = calloc (bmeta->nlines * bmeta->nsamps, nbytes);
-        if (file_buf_i16 == NULL)
-        {
-            sprintf (errmsg, "Allocating memory for the image of int16 data "
-                "containing %d lines x %d samples.", bmeta->nlines,
-                bmeta->nsamps);
-            error_handler (true, FUNC_NAME, errmsg);
+        if (gtif_direct_copy (fp_tiff, gtif_file, bmeta, nbytes, fp_rb,
+            &fast_path) != SUCCESS)
+        {  /* Error messages already printed */
             return (ERROR);
         }
-        file_buf = file_buf_i16;
+        if (fast_path)
+            espa_perf_count ("gtif_direct_copy_hit", 1);
     }
-    else if (bmeta->data_type == ESPA_UINT16)
+
+    if (!fast_path)
     {
-        nbytes = sizeof (uint16);
-        file_buf_u16 = calloc (bmeta->nlines * bmeta->nsamps, nbytes);
-        if (file_buf_u16 == NULL)
+        /* Allocate memory for a chunk of scanlines, bounding the memory used
+           to LPGS_GTIF_CHUNK_BYTES regardless of the band size */
+        chunk_nlines = LPGS_GTIF_CHUNK_BYTES / (bmeta->nsamps * nbytes);
+        if (chunk_nlines < 1)
+            chunk_nlines = 1;
+        if (chunk_nlines > bmeta->nlines)
+            chunk_nlines = bmeta->nlines;
+        file_buf = espa_borrow_buffer ((size_t) chunk_nlines * bmeta->nsamps *
+            nbytes);
+        if (file_buf == NULL)
         {
-            sprintf (errmsg, "Allocating memory for the image of uint16 data "
-                "containing %d lines x %d samples.", bmeta->nlines,
-                bmeta->nsamps);
+            sprintf (errmsg, "Allocating memory for a chunk of %d lines x %d "
+                "samples.", chunk_nlines, bmeta->nsamps);
             error_handler (true, FUNC_NAME, errmsg);
             return (ERROR);
         }
-        file_buf = file_buf_u16;
-    }
-    else
-    {
-        sprintf (errmsg, "Unsupported data type.  Currently only uint8, "
-            "int16, and uint16 are supported.");
-        error_handler (true, FUNC_NAME, errmsg);
-        return (ERROR);
-    }
 
-    /* Loop through the lines in the TIFF file, reading and stuffing in the
-       image buffer */
-    if (bmeta->data_type == ESPA_UINT8)
-    {
-        for (i = 0; i < bmeta->nlines; i++)
+        /* Loop through the chunks of lines in the TIFF file, reading each chunk
+           of scanlines then writing it to the raw binary file and reusing the
+           buffer for the next chunk */
+        for (chunk_line = 0; chunk_line < bmeta->nlines;
+             chunk_line += chunk_nlines)
         {
-            /* Read current line from the TIFF file */
-            if (!TIFFReadScanline (fp_tiff, &file_buf_u8[i*bmeta->nsamps],
-                i, 0))
+            /* Unwind cleanly at the chunk boundary if the scheduler asked
+               for a cancellation; with atomic output commits the band never
+               reaches its final name */
+            if (espa_cancel_requested ())
             {
-                sprintf (errmsg, "Reading line %d from the TIFF file: %s", i,
-                    gtif_file);
+                sprintf (errmsg, "Conversion canceled at line %d of %s",
+                    chunk_line, gtif_file);
                 error_handler (true, FUNC_NAME, errmsg);
+                espa_return_buffer (file_buf);
                 return (ERROR);
             }
-        }
-    }
-    else if (bmeta->data_type == ESPA_INT16)
-    {
-        for (i = 0; i < bmeta->nlines; i++)
-        {
-            /* Read current line from the TIFF file */
-            if (!TIFFReadScanline (fp_tiff, &file_buf_i16[i*bmeta->nsamps],
-                i, 0))
+
+            /* Determine the number of lines in the current chunk; the last chunk
+               can be short */
+            curr_nlines = chunk_nlines;
+            if (chunk_line + curr_nlines > bmeta->nlines)
+                curr_nlines = bmeta->nlines - chunk_line;
+
+            /* Read the lines of the current chunk from the TIFF file */
+            for (i = 0; i < curr_nlines; i++)
             {
-                sprintf (errmsg, "Reading line %d from the TIFF file: %s", i,
-                    gtif_file);
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
+                if (!TIFFReadScanline (fp_tiff,
+                    (char *) file_buf + (size_t) i * bmeta->nsamps * nbytes,
+                    chunk_line + i, 0))
+                {
+                    sprintf (errmsg, "Reading line %d from the TIFF file: %s",
+                        chunk_line + i, gtif_file);
+                    error_handler (true, FUNC_NAME, errmsg);
+                    espa_return_buffer (file_buf);
+                    return (ERROR);
+                }
+            }
+
+            /* Clamp the chunk to the valid range while it is still in
+               cache, if enforcement was requested */
+            if (clamp_band)
+                espa_band_clamp (&bkern, file_buf,
+                    (long) curr_nlines * bmeta->nsamps);
+
+            /* Accumulate the band statistics while the chunk is still in
+               cache, if they were requested */
+            if (stats_band)
+                espa_band_stats (&bkern, file_buf,
+                    (long) curr_nlines * bmeta->nsamps, &stats);
+
+            /* Write the current chunk to the raw binary file.  For sparse
+               bands, walk the chunk in runs of lines with the same fill
+               classification, seeking past the all-fill runs so the
+               filesystem stores them as holes and writing the rest */
+            if (!sparse_band)
+            {
+                if (write_raw_binary (fp_rb, curr_nlines, bmeta->nsamps,
+                    nbytes, file_buf) != SUCCESS)
+                {
+                    sprintf (errmsg, "Writing image to the raw binary "
+                        "file: %s", img_file);
+                    error_handler (true, FUNC_NAME, errmsg);
+                    espa_return_buffer (file_buf);
+                    return (ERROR);
+                }
+            }
+            else
+            {
+                line = 0;
+                while (line < curr_nlines)
+                {
+                    /* Find the run of lines with the same classification
+                       as the current line */
+                    run_fill = espa_band_all_fill (&bkern,
+                        (char *) file_buf +
+                        (size_t) line * bmeta->nsamps * nbytes,
+                        bmeta->nsamps);
+
+                    run_nlines = 1;
+                    while (line + run_nlines < curr_nlines)
+                    {
+                        line_fill = espa_band_all_fill (&bkern,
+                            (char *) file_buf + (size_t) (line + run_nlines) *
+                            bmeta->nsamps * nbytes, bmeta->nsamps);
+                        if (line_fill != run_fill)
+                            break;
+                        run_nlines++;
+                    }
+
+                    if (run_fill)
+                    {
+                        /* Seek past the all-fill run; the bytes are never
+                           written so the filesystem stores them as a
+                           hole, which reads back as the zero fill value
+                           once the file is extended to its full size */
+                        if (fseeko (fp_rb, (off_t) run_nlines *
+                            bmeta->nsamps * nbytes, SEEK_CUR) != 0)
+                        {
+                            sprintf (errmsg, "Seeking past an all-fill run "
+                                "in the raw binary file: %.1024s", img_file);
+                            error_handler (true, FUNC_NAME, errmsg);
+                            espa_return_buffer (file_buf);
+                            return (ERROR);
+                        }
+                        nfill_lines += run_nlines;
+                    }
+                    else
+                    {
+                        if (write_raw_binary (fp_rb, run_nlines,
+                            bmeta->nsamps, nbytes, (char *) file_buf +
+                            (size_t) line * bmeta->nsamps * nbytes)
+                            != SUCCESS)
+                        {
+                            sprintf (errmsg, "Writing image to the raw "
+                                "binary file: %.1024s", img_file);
+                            error_handler (true, FUNC_NAME, errmsg);
+                            espa_return_buffer (file_buf);
+                            return (ERROR);
+                        }
+                    }
+                    line += run_nlines;
+                }
             }
         }
-    }
-    else if (bmeta->data_type == ESPA_UINT16)
-    {
-        for (i = 0; i < bmeta->nlines; i++)
+
+        /* Extend a sparse band to its full size so any trailing fill run
+           is materialized as a hole */
+        if (sparse_band)
         {
-            /* Read current line from the TIFF file */
-            if (!TIFFReadScanline (fp_tiff, &file_buf_u16[i*bmeta->nsamps],
-                i, 0))
+            fflush (fp_rb);
+            if (ftruncate (fileno (fp_rb), (off_t) bmeta->nlines *
+                bmeta->nsamps * nbytes) != 0)
             {
-                sprintf (errmsg, "Reading line %d from the TIFF file: %s", i,
-                    gtif_file);
+                sprintf (errmsg, "Extending the sparse raw binary file to "
+                    "its full size: %.1024s", img_file);
                 error_handler (true, FUNC_NAME, errmsg);
+                espa_return_buffer (file_buf);
                 return (ERROR);
             }
+            espa_perf_count ("gtif_sparse_fill_lines", nfill_lines);
         }
-    }
 
-    /* Write entire image to the raw binary file */
-    if (write_raw_binary (fp_rb, bmeta->nlines, bmeta->nsamps, nbytes,
-        file_buf) != SUCCESS)
-    {
-        sprintf (errmsg, "Writing image to the raw binary file: %s", img_file);
-        error_handler (true, FUNC_NAME, errmsg);
-        return (ERROR);
+        /* Store the accumulated statistics in the band metadata, from where
+           they are written to the XML */
+        if (stats_band)
+            espa_stats_finish (&stats, bmeta);
     }
 
+    /* The TIFF file will not be read again, so drop its cached pages */
+    advise_raw_binary_fd_done (TIFFFileno (fp_tiff));
+
     /* Close the TIFF and raw binary files */
     XTIFFClose (fp_tiff);
     close_raw_binary (fp_rb);
 
     /* Free the memory */
-    free (file_buf_u8);
-    free (file_buf_i16);
-    free (file_buf_u16);
+    espa_return_buffer (file_buf);
+
+    /* Successful conversion.  The ENVI headers for all the bands are
+       written in one batch after the band conversions complete. */
+    espa_perf_record ("convert_gtif_to_img", perf_start,
+        (long long) bmeta->nlines * bmeta->nsamps * nbytes);
+    return (SUCCESS);
+}
+
+
+/* Shared context for the band conversion tasks run through the worker
+   pool */
+typedef struct
+{
+    Espa_internal_meta_t *xml_metadata;  /* XML metadata for the bands */
+    char (*lpgs_bands)[STR_SIZE];  /* file names of the LPGS bands */
+    int nlpgs_bands;          /* number of bands in the LPGS product */
+    bool del_src;             /* should the source .tif files be removed? */
+    Espa_resume_t *resume;    /* checkpoint state for the scene; NULL when
+                                 checkpointing is off */
+} Lpgs_band_pool_t;
+
+
+/******************************************************************************
+MODULE:  convert_lpgs_band_task
+
+PURPOSE: Pool task which converts one LPGS GeoTIFF band to raw binary.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error converting the band
+SUCCESS         Band was converted
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Reworked from a self-contained pthread worker
+                              into a task for the shared worker pool
+
+NOTES:
+  1. Each task calls convert_gtif_to_img, which opens its own TIFF and
+     raw binary file handles, so the per-band conversions are independent.
+******************************************************************************/
+static int convert_lpgs_band_task
+(
+    void *ctx,                /* I: pointer to the Lpgs_band_pool_t context */
+    int i                     /* I: band index to be converted */
+)
+{
+    char FUNC_NAME[] = "convert_lpgs_band_task";  /* function name */
+    char errmsg[STR_SIZE];    /* error message */
+    Lpgs_band_pool_t *pool = ctx;  /* shared band conversion context */
 
-    /* Create the ENVI header file this band */
-    if (create_envi_struct (bmeta, gmeta, &envi_hdr) != SUCCESS)
+    /* Skip bands a previous interrupted run already completed, after
+       verifying them against their recorded size and checksum */
+    if (pool->resume != NULL && espa_resume_band_complete (pool->resume,
+        pool->xml_metadata->band[i].file_name))
     {
-        sprintf (errmsg, "Creating the ENVI header structure for this file.");
-        error_handler (true, FUNC_NAME, errmsg);
-        return (ERROR);
+        printf ("  Band %d: %s is verified complete, skipping\n", i,
+            pool->xml_metadata->band[i].file_name);
+        return (SUCCESS);
     }
 
-    /* Write the ENVI header */
-    count = snprintf (envi_file, sizeof (envi_file), "%s", img_file);
-    if (count < 0 || count >= sizeof (envi_file))
+    printf ("  Band %d: %s to %s\n", i, pool->lpgs_bands[i],
+        pool->xml_metadata->band[i].file_name);
+    if (convert_gtif_to_img (pool->lpgs_bands[i],
+        &pool->xml_metadata->band[i], &pool->xml_metadata->global)
+        != SUCCESS)
     {
-        sprintf (errmsg, "Overflow of envi_file string");
+        sprintf (errmsg, "Converting band %d: %s", i, pool->lpgs_bands[i]);
         error_handler (true, FUNC_NAME, errmsg);
         return (ERROR);
     }
-    cptr = strchr (envi_file, '.');
-    strcpy (cptr, ".hdr");
 
-    if (write_envi_hdr (envi_file, &envi_hdr) != SUCCESS)
-    {
-        sprintf (errmsg, "Writing the ENVI header file: %s.", envi_file);
-        error_handler (true, FUNC_NAME, errmsg);
+    /* Record the completed band in the checkpoint manifest */
+    if (pool->resume != NULL &&
+        espa_resume_record (pool->resume,
+            pool->xml_metadata->band[i].file_name) != SUCCESS)
+    {  /* Error messages already printed */
         return (ERROR);
     }
 
-    /* Successful conversion */
+    /* Remove the source file if specified */
+    if (pool->del_src)
+    {
+        printf ("  Removing %s\n", pool->lpgs_bands[i]);
+        if (unlink (pool->lpgs_bands[i]) != 0)
+        {
+            sprintf (errmsg, "Deleting source file: %s", pool->lpgs_bands[i]);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+    }
+
     return (SUCCESS);
 }
 
 
 /******************************************************************************
-MODULE:  convert_lpgs_to_espa
+MODULE:  write_scene_envi_hdrs
+
+PURPOSE: Write-behind task which writes the ENVI headers for the scene cached
+in the context.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error writing the ENVI header files
+SUCCESS         Successfully wrote the ENVI header files
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static int write_scene_envi_hdrs
+(
+    void *write_arg        /* I: scene context holding the cached metadata
+                                 (Espa_scene_context_t) */
+)
+{
+    Espa_scene_context_t *context = write_arg;  /* scene context */
+
+    return (write_envi_hdrs (&context->xml_metadata));
+}
+
+
+/******************************************************************************
+MODULE:  convert_lpgs_to_espa_scene
 
 PURPOSE: Converts the input LPGS GeoTIFF files (and associated MTL file) to
-the ESPA internal raw binary file format (and associated XML file).
+the ESPA internal raw binary file format (and associated XML file), leaving
+the scene metadata cached in the scene context for the following stages.
 
 RETURN VALUE:
 Type = int
@@ -1600,28 +2015,52 @@ Date         Programmer       Reason
 12/30/2013   Gail Schmidt     Original development
 4/2/2014     Gail Schmidt     Added support for a flag to delete the source
                               .tif files
+8/31/2026    Gail Schmidt     Added support for converting multiple bands
+                              concurrently via a thread pool
+8/31/2026    Gail Schmidt     Write the ENVI headers for all the bands in
+                              one batch after the band conversions
+8/31/2026    Gail Schmidt     Run the band conversions through the shared
+                              worker pool instead of ad-hoc pthreads
+8/31/2026    Gail Schmidt     Added the scene context so the parsed metadata
+                              survives into the following pipeline stages
+8/31/2026    Gail Schmidt     Queue the ENVI header writes behind the scene
+                              when a context is present, so the driver can
+                              start the next stage or scene right away
+8/31/2026    Gail Schmidt     Checkpoint each completed band in a sidecar
+                              manifest and skip the verified-complete bands
+                              on a rerun (set ESPA_RESUME)
 
 NOTES:
   1. The LPGS GeoTIFF band files will be deciphered from the LPGS MTL file.
   2. The ESPA raw binary band files will be generated from the ESPA XML
      filename.
+  3. Each band conversion is independent and uses its own TIFF and raw binary
+     file handles, so the bands can be converted concurrently.  Specifying
+     num_threads of 1 (or less) retains the original serial behavior.
 ******************************************************************************/
-int convert_lpgs_to_espa
+int convert_lpgs_to_espa_scene
 (
+    Espa_scene_context_t *context,  /* I/O: scene context which takes
+                                 ownership of the scene metadata for the
+                                 following stages; NULL to run standalone */
     char *lpgs_mtl_file,   /* I: input LPGS MTL metadata filename */
     char *espa_xml_file,   /* I: output ESPA XML metadata filename */
-    bool del_src           /* I: should the source .tif files be removed after
+    bool del_src,          /* I: should the source .tif files be removed after
                                  conversion? */
+    int num_threads        /* I: number of threads to use for converting the
+                                 bands; 1 or less converts serially */
 )
 {
-    char FUNC_NAME[] = "convert_lpgs_to_espa";  /* function name */
+    char FUNC_NAME[] = "convert_lpgs_to_espa_scene";  /* function name */
     char errmsg[STR_SIZE];   /* error message */
     Espa_internal_meta_t xml_metadata;  /* XML metadata structure to be
                                 populated by reading the MTL metadata file */
-    int i;                   /* looping variable */
     int nlpgs_bands;         /* number of bands in the LPGS product */
     char lpgs_bands[MAX_LPGS_BANDS][STR_SIZE];  /* array containing the file
                                 names of the LPGS bands */
+    Lpgs_band_pool_t pool;   /* shared context for the band conversion
+                                tasks */
+    Espa_resume_t resume;    /* checkpoint state for the scene */
 
     /* Initialize the metadata structure */
     init_metadata_struct (&xml_metadata);
@@ -1649,36 +2088,117 @@ int convert_lpgs_to_espa
         return (ERROR);
     }
 
-    /* Convert each of the LPGS GeoTIFF files to raw binary */
-    for (i = 0; i < nlpgs_bands; i++)
+    /* Open the checkpoint manifest if checkpointing was requested, loading
+       the bands an interrupted previous run already completed */
+    pool.resume = NULL;
+    if (espa_resume_enabled ())
+    {
+        if (espa_resume_open (espa_xml_file, &resume) != SUCCESS)
+        {  /* Error messages already printed */
+            return (ERROR);
+        }
+        pool.resume = &resume;
+    }
+
+    /* Convert the LPGS GeoTIFF files to raw binary across the shared worker
+       pool; a num_threads of 1 (or less) converts serially */
+    pool.xml_metadata = &xml_metadata;
+    pool.lpgs_bands = lpgs_bands;
+    pool.nlpgs_bands = nlpgs_bands;
+    pool.del_src = del_src;
+    if (espa_pool_run (convert_lpgs_band_task, &pool, nlpgs_bands,
+        num_threads) != SUCCESS)
+    {
+        sprintf (errmsg, "Converting the LPGS bands to raw binary");
+        error_handler (true, FUNC_NAME, errmsg);
+        if (pool.resume != NULL)
+            espa_resume_close (pool.resume, 0);
+        return (ERROR);
+    }
+
+    /* All the bands are complete, so the checkpoint manifest can go */
+    if (pool.resume != NULL)
+        espa_resume_close (pool.resume, 1);
+
+    /* Hand the metadata over to the scene context so the following stages
+       can reuse it without re-parsing the XML file, then queue the ENVI
+       header writes behind the scene.  Nothing in this stage reads the
+       headers back, so the driver can start the next stage or scene while
+       they are written; stages which do read or remove them take the
+       wait_scene_context_writes barrier first.  Standalone runs keep the
+       synchronous header writes. */
+    if (context != NULL)
     {
-        printf ("  Band %d: %s to %s\n", i, lpgs_bands[i],
-            xml_metadata.band[i].file_name);
-        if (convert_gtif_to_img (lpgs_bands[i], &xml_metadata.band[i],
-            &xml_metadata.global) != SUCCESS)
+        if (adopt_scene_context_metadata (context, espa_xml_file,
+            &xml_metadata) != SUCCESS)
         {
-            sprintf (errmsg, "Converting band %d: %s", i, lpgs_bands[i]);
+            sprintf (errmsg, "Caching the scene metadata in the context");
             error_handler (true, FUNC_NAME, errmsg);
             return (ERROR);
         }
 
-        /* Remove the source file if specified */
-        if (del_src)
+        if (start_scene_context_writes (context, write_scene_envi_hdrs,
+            context) != SUCCESS)
         {
-            printf ("  Removing %s\n", lpgs_bands[i]);
-            if (unlink (lpgs_bands[i]) != 0)
-            {
-                sprintf (errmsg, "Deleting source file: %s", lpgs_bands[i]);
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
+            sprintf (errmsg, "Queueing the ENVI header writes");
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
         }
     }
+    else
+    {
+        /* Write the ENVI headers for all the bands in one batch, sharing
+           the projection formatting across the bands */
+        if (write_envi_hdrs (&xml_metadata) != SUCCESS)
+        {
+            sprintf (errmsg, "Writing the ENVI header files");
+            error_handler (true, FUNC_NAME, errmsg);
+            free_metadata (&xml_metadata);
+            return (ERROR);
+        }
 
-    /* Free the metadata structure */
-    free_metadata (&xml_metadata);
+        free_metadata (&xml_metadata);
+    }
 
     /* Successful conversion */
     return (SUCCESS);
 }
 
+
+/******************************************************************************
+MODULE:  convert_lpgs_to_espa
+
+PURPOSE: Converts the input LPGS GeoTIFF files (and associated MTL file) to
+the ESPA internal raw binary file format (and associated XML file), without
+a scene context.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error converting the GeoTIFF file
+SUCCESS         Successfully converted GeoTIFF to raw binary
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development, pulled from the previous
+                              convert_lpgs_to_espa when the scene context
+                              variant was added
+
+NOTES:
+******************************************************************************/
+int convert_lpgs_to_espa
+(
+    char *lpgs_mtl_file,   /* I: input LPGS MTL metadata filename */
+    char *espa_xml_file,   /* I: output ESPA XML metadata filename */
+    bool del_src,          /* I: should the source .tif files be removed after
+                                 conversion? */
+    int num_threads        /* I: number of threads to use for converting the
+                                 bands; 1 or less converts serially */
+)
+{
+    return (convert_lpgs_to_espa_scene (NULL, lpgs_mtl_file, espa_xml_file,
+        del_src, num_threads));
+}
+
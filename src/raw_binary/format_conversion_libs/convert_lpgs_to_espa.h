@@ -13,6 +13,8 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 12/30/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added num_threads to convert_lpgs_to_espa to
+                              support concurrent band conversion
 
 NOTES:
 *****************************************************************************/
@@ -30,6 +32,7 @@ NOTES:
 #include "espa_geoloc.h"
 #include "raw_binary_io.h"
 #include "write_metadata.h"
+#include "espa_scene_context.h"
 #include "envi_header.h"
 
 /* Defines */
@@ -38,6 +41,11 @@ NOTES:
    9 bands */
 #define MAX_LPGS_BANDS 12
 
+/* Size in bytes of the scanline chunk buffer used when converting a GeoTIFF
+   band to raw binary; bounds the memory used per band regardless of the
+   band size */
+#define LPGS_GTIF_CHUNK_BYTES (4 * 1024 * 1024)
+
 /* Prototypes */
 int read_lpgs_mtl
 (
@@ -57,12 +65,27 @@ int convert_gtif_to_img
     Espa_global_meta_t *gmeta  /* I: pointer to global metadata */
 );
 
+int convert_lpgs_to_espa_scene
+(
+    Espa_scene_context_t *context,  /* I/O: scene context which takes
+                                 ownership of the scene metadata for the
+                                 following stages; NULL to run standalone */
+    char *lpgs_mtl_file,   /* I: input LPGS MTL metadata filename */
+    char *espa_xml_file,   /* I: output ESPA XML metadata filename */
+    bool del_src,          /* I: should the source .tif files be removed after
+                                 conversion? */
+    int num_threads        /* I: number of threads to use for converting the
+                                 bands; 1 or less converts serially */
+);
+
 int convert_lpgs_to_espa
 (
     char *lpgs_mtl_file,   /* I: input LPGS MTL metadata filename */
     char *espa_xml_file,   /* I: output ESPA XML metadata filename */
-    bool del_src           /* I: should the source .tif files be removed after
+    bool del_src,          /* I: should the source .tif files be removed after
                                  conversion? */
+    int num_threads        /* I: number of threads to use for converting the
+                                 bands; 1 or less converts serially */
 );
 
 #endif
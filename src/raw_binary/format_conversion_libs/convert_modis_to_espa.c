@@ -13,6 +13,18 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 4/22/2014    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added a mosaic mode which stitches multiple
+                              tiled granules into one combined raw binary
+                              product with bounded memory
+8/31/2026    Gail Schmidt     Added a composite mode which selects each pixel
+                              from the best of several granules (QA-priority
+                              or max-NDVI) with bounded memory
+8/31/2026    Gail Schmidt     Added cooperative cancellation checkpoints so
+                              preempted jobs unwind cleanly
+8/31/2026    Gail Schmidt     Index the ODL blobs with the vectorized token
+                              scanner instead of sscanf per token
+8/31/2026    Gail Schmidt     Store the QA description through the
+                              lazily-allocated band accessor
 
 NOTES:
   1. The XML metadata format written via this library follows the ESPA internal
@@ -23,7 +35,14 @@ NOTES:
 #include <unistd.h>
 #include <math.h>
 #include <ctype.h>
+#include <pthread.h>
+#include "gzip_input.h"
 #include "convert_modis_to_espa.h"
+#include "espa_convert_kernels.h"
+#include "espa_buffer.h"
+#include "espa_cancel.h"
+#include "espa_strscan.h"
+#include "espa_thread_pool.h"
 
 /******************************************************************************
 MODULE:  doy_to_month_day
@@ -611,52 +630,189 @@ int get_sds_values
 }
 
 
+/* Number of slots in the ODL object/value table; power of two so the hash
+   can wrap with a mask.  The CoreMetadata and ArchiveMetadata blobs hold a
+   couple hundred objects at most. */
+#define ODL_TABLE_SIZE 512
+
+/* Maximum size of an ODL object name */
+#define ODL_KEY_SIZE 64
+
+/* Single OBJECT/VALUE pair parsed from an ODL metadata blob */
+typedef struct
+{
+    char object[ODL_KEY_SIZE];  /* object name; empty if the slot is open */
+    char value[STR_SIZE];       /* first token of the object value */
+} Odl_pair_t;
+
+
+/******************************************************************************
+MODULE:  odl_hash
+
+PURPOSE: Hash an ODL object name for the object/value table.
+
+RETURN VALUE:
+Type = unsigned int
+Value           Description
+-----           -----------
+(hash)          Hash value of the object name
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static unsigned int odl_hash
+(
+    const char *object        /* I: object name to be hashed */
+)
+{
+    unsigned int hash = 5381; /* running hash value */
+
+    while (*object != '\0')
+        hash = hash * 33 + (unsigned char) *object++;
+
+    return (hash);
+}
+
+
 /******************************************************************************
-MODULE:  read_core_metadata
+MODULE:  odl_insert
 
-PURPOSE: Reads the core metadata, searching for the desired fields.
+PURPOSE: Insert an OBJECT/VALUE pair into the ODL object/value table.
 
 RETURN VALUE:
 Type = int
 Value           Description
 -----           -----------
-ERROR           Error reading the core metadata
-SUCCESS         Successfully read the core metadata
+ERROR           The table is full
+SUCCESS         Successfully inserted the pair
 
 HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
-5/6/2014     Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. If the object is already in the table the first value wins, matching the
+     previous token-scanning behavior which stopped at the first occurrence.
+******************************************************************************/
+static int odl_insert
+(
+    Odl_pair_t *odl_table,    /* I/O: table of ODL_TABLE_SIZE pairs */
+    const char *object,       /* I: object name */
+    const char *value         /* I: object value */
+)
+{
+    unsigned int slot;        /* current slot in the table */
+    int probes;               /* number of slots probed */
+
+    slot = odl_hash (object) & (ODL_TABLE_SIZE - 1);
+    for (probes = 0; probes < ODL_TABLE_SIZE; probes++)
+    {
+        if (odl_table[slot].object[0] == '\0')
+        {
+            strcpy (odl_table[slot].object, object);
+            snprintf (odl_table[slot].value, sizeof (odl_table[slot].value),
+                "%s", value);
+            return (SUCCESS);
+        }
+        if (!strcmp (odl_table[slot].object, object))
+            return (SUCCESS);
+        slot = (slot + 1) & (ODL_TABLE_SIZE - 1);
+    }
+
+    return (ERROR);
+}
+
+
+/******************************************************************************
+MODULE:  odl_find
+
+PURPOSE: Look up an ODL object in the object/value table.
+
+RETURN VALUE:
+Type = const char *
+Value           Description
+-----           -----------
+NULL            The object is not in the table
+(value)         Value of the object
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static const char *odl_find
+(
+    const Odl_pair_t *odl_table,  /* I: table of ODL_TABLE_SIZE pairs */
+    const char *object        /* I: object name to be looked up */
+)
+{
+    unsigned int slot;        /* current slot in the table */
+    int probes;               /* number of slots probed */
+
+    slot = odl_hash (object) & (ODL_TABLE_SIZE - 1);
+    for (probes = 0; probes < ODL_TABLE_SIZE; probes++)
+    {
+        if (odl_table[slot].object[0] == '\0')
+            return (NULL);
+        if (!strcmp (odl_table[slot].object, object))
+            return (odl_table[slot].value);
+        slot = (slot + 1) & (ODL_TABLE_SIZE - 1);
+    }
+
+    return (NULL);
+}
+
+
+/******************************************************************************
+MODULE:  read_odl_blob
+
+PURPOSE: Reads an ODL metadata blob (CoreMetadata or ArchiveMetadata) from
+the HDF file attributes into a newly allocated string.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error reading the metadata blob
+SUCCESS         Successfully read the metadata blob
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
 
 NOTES:
+  1. The caller is responsible for freeing the returned blob.
 ******************************************************************************/
-int read_core_metadata
+static int read_odl_blob
 (
     int32 sd_id,              /* I: file ID for the HDF file */
-    char prod_date_time[],    /* O: production date/time */
-    char pge_version[]        /* O: PGE version */
+    const char *attr_base,    /* I: base name of the ODL attribute, e.g.
+                                    CoreMetadata */
+    char **blob               /* O: NULL-terminated metadata blob text */
 )
 {
-    char FUNC_NAME[] = "read_core_metadata";  /* function name */
+    char FUNC_NAME[] = "read_odl_blob";  /* function name */
     char errmsg[STR_SIZE];      /* error message */
     char attr_name[STR_SIZE];   /* attribute name */
     char attrname[STR_SIZE];    /* holds the file_name string */
     char *file_data = NULL;     /* character string used for reading the
-                                   CoreMetadata */
-    char *file_data_ptr = NULL; /* pointer to file_data for scanning */
+                                   metadata blob */
     int j;                  /* looping variable */
-    int count;              /* number of chars copied in snprintf */
     int32 attr_indx = -1;   /* index for the current attribute */
     int32 data_type;        /* attribute's data type */
     int32 n_values;         /* number of vals of the attribute */
     int32 status;           /* return status */
-    bool prod_date_found;   /* production date/time has been found */
-    bool pge_version_found; /* PGE version has been found */
-    int num_chars;          /* number of characters read in the line */
-    char token_buffer[STR_SIZE]; /* holds the current token */
 
-    /* Look for the CoreMetadata in the HDF file */
-    attr_indx = SDfindattr (sd_id, "CoreMetadata");
+    /* Look for the attribute in the HDF file */
+    attr_indx = SDfindattr (sd_id, attr_base);
 
     /* Only proceed if the attribute was found */
     if (attr_indx == -1)
@@ -664,7 +820,7 @@ int read_core_metadata
         /* If not found then try concatenating sequence numbers */
         for (j = 0; j <= 9; j++)
         {
-            sprintf (attrname, "CoreMetadata.%d", j);
+            sprintf (attrname, "%s.%d", attr_base, j);
             attr_indx = SDfindattr (sd_id, attrname);
             if (attr_indx != -1)
                 break;
@@ -672,7 +828,7 @@ int read_core_metadata
 
         if (attr_indx == -1)
         {
-            sprintf (errmsg, "Unable to locate CoreMetadata for reading");
+            sprintf (errmsg, "Unable to locate %s for reading", attr_base);
             error_handler (true, FUNC_NAME, errmsg);
             return (ERROR);
         }
@@ -682,7 +838,7 @@ int read_core_metadata
     status = SDattrinfo (sd_id, attr_indx, attr_name, &data_type, &n_values);
     if (status == -1)
     {
-        sprintf (errmsg, "Unable to get the size of CoreMetadata attribute");
+        sprintf (errmsg, "Unable to get the size of %s attribute", attr_base);
         error_handler (true, FUNC_NAME, errmsg);
         return (ERROR);
     }
@@ -703,374 +859,382 @@ int read_core_metadata
     if (status == -1 || !strcmp (file_data, ""))
     {
         free (file_data);
-        sprintf (errmsg, "Unable to read the CoreMetadata HDF attributes");
+        sprintf (errmsg, "Unable to read the %s HDF attributes", attr_base);
         error_handler (true, FUNC_NAME, errmsg);
         return (ERROR);
     }
 
-    /* Walk through the file_data string one token at a time looking for the
-       production date and PGE version */
-    prod_date_found = false;
-    pge_version_found = false;
-    file_data_ptr = file_data;
-    status = ERROR;
-    while (sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars) != EOF)
-    {
-        /* If this token is END, then we are done with the metadata */
-        if (!strcmp (token_buffer, "END"))
-            break;
+    *blob = file_data;
+    return (SUCCESS);
+}
 
-        /* If the tokens have already been found, don't waste time with the
-           rest of the metadata */
-        if (prod_date_found && pge_version_found)
-            break;
 
-        /* Increment the file_data_ptr pointer to point to the next token */
-        file_data_ptr += num_chars;
+/******************************************************************************
+MODULE:  index_odl_blob
 
-        /* Look for the PRODUCTIONDATETIME token */
-        if (!strcmp (token_buffer, "PRODUCTIONDATETIME") && !prod_date_found)
-        {
-            /* Read the next three tokens, this should be the
-               NUM_VAL = ... line */
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+PURPOSE: Indexes the VALUE of every OBJECT in an ODL metadata blob into the
+object/value table in a single pass.
 
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error indexing the metadata blob
+SUCCESS         Successfully indexed the metadata blob
 
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Scan the blob with the vectorized token
+                              scanner instead of sscanf per token
 
-            /* Read the next three tokens, this should be the
-               VALUE = ... line */
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+NOTES:
+  1. Only the first token of each VALUE is stored.  The fields pulled from
+     these blobs (dates, versions, bounding coordinates) are all single
+     tokens.
+  2. This routine does not touch the HDF4 API, so it is safe to run on a
+     worker thread while the HDF file is being read.
+******************************************************************************/
+static int index_odl_blob
+(
+    const char *blob,         /* I: NULL-terminated metadata blob text */
+    Odl_pair_t *odl_table     /* O: table of ODL_TABLE_SIZE pairs; should be
+                                    zeroed by the caller */
+)
+{
+    char FUNC_NAME[] = "index_odl_blob";  /* function name */
+    char errmsg[STR_SIZE];      /* error message */
+    char cur_object[ODL_KEY_SIZE];  /* name of the current ODL object */
+    char token_buffer[STR_SIZE]; /* holds the current VALUE token */
+    const char *scan = NULL;    /* scan position in the blob */
+    const char *token = NULL;   /* current token in the blob */
+    size_t token_len;           /* length of the current token */
+
+    /* Walk through the blob one token at a time, indexing the VALUE of
+       each OBJECT by its name */
+    cur_object[0] = '\0';
+    scan = blob;
+    while ((scan = espa_scan_token (scan, &token, &token_len)) != NULL)
+    {
+        /* If this token is END, then we are done with the metadata */
+        if (token_len == 3 && !strncmp (token, "END", 3))
+            break;
 
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+        if (token_len == 6 && !strncmp (token, "OBJECT", 6))
+        {
+            /* Read the next two tokens, this should be the '=' and the
+               object name */
+            scan = espa_scan_token (scan, &token, &token_len);
+            if (scan == NULL)
+                break;
 
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+            scan = espa_scan_token (scan, &token, &token_len);
+            if (scan == NULL)
+                break;
 
-            /* Store the value token (without the surrounding ""s) */
-            count = snprintf (prod_date_time, STR_SIZE, "%s", &token_buffer[1]);
-            if (count < 0 || count >= STR_SIZE)
+            /* Remember the object name; names too long for the table can
+               never be looked up, so they are skipped */
+            if (token_len < sizeof (cur_object))
             {
-                sprintf (errmsg, "Overflow of prod_date_time string");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
+                memcpy (cur_object, token, token_len);
+                cur_object[token_len] = '\0';
             }
-            prod_date_time[strlen(prod_date_time)-1] = '\0';
-
-            /* Production date/time was found */
-            prod_date_found = true;
+            else
+                cur_object[0] = '\0';
         }
-
-        /* Look for the PGEVERSION token */
-        if (!strcmp (token_buffer, "PGEVERSION") && !pge_version_found)
+        else if (token_len == 5 && !strncmp (token, "VALUE", 5) &&
+            cur_object[0] != '\0')
         {
-            /* Read the next three tokens, this should be the
-               NUM_VAL = ... line */
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
-
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
-
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
-
-            /* Read the next three tokens, this should be the
-               VALUE = ... line */
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
-
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+            /* Read the next two tokens, this should be the '=' and the
+               value */
+            scan = espa_scan_token (scan, &token, &token_len);
+            if (scan == NULL)
+                break;
 
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+            scan = espa_scan_token (scan, &token, &token_len);
+            if (scan == NULL)
+                break;
 
-            /* Store the value token (without the surrounding ""s) */
-            count = snprintf (pge_version, STR_SIZE, "%s", &token_buffer[1]);
-            if (count < 0 || count >= STR_SIZE)
+            /* Index the value under the current object name */
+            if (token_len >= sizeof (token_buffer))
+                token_len = sizeof (token_buffer) - 1;
+            memcpy (token_buffer, token, token_len);
+            token_buffer[token_len] = '\0';
+            if (odl_insert (odl_table, cur_object, token_buffer) != SUCCESS)
             {
-                sprintf (errmsg, "Overflow of pge_version string");
+                sprintf (errmsg, "The ODL object table is full");
                 error_handler (true, FUNC_NAME, errmsg);
                 return (ERROR);
             }
-            pge_version[strlen(pge_version)-1] = '\0';
-
-            /* PGE version was found */
-            pge_version_found = true;
+            cur_object[0] = '\0';
         }
     }  /* end while */
 
-    /* Free dynamically allocated memory */
-    free (file_data);
-
     return (SUCCESS);
 }
 
 
 /******************************************************************************
-MODULE:  read_archive_metadata
+MODULE:  parse_core_metadata
 
-PURPOSE: Reads the archive metadata, searching for the desired fields.
+PURPOSE: Parses the core metadata blob, searching for the desired fields.
 
 RETURN VALUE:
 Type = int
 Value           Description
 -----           -----------
-ERROR           Error reading the archive metadata
-SUCCESS         Successfully read the archive metadata
+ERROR           Error parsing the core metadata
+SUCCESS         Successfully parsed the core metadata
 
 HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 5/6/2014     Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Index the ODL objects in a single pass and
+                              resolve the fields from the index
+8/31/2026    Gail Schmidt     Parse the blob text separately from the HDF
+                              attribute read so the parsing can overlap the
+                              SDS walk on a worker thread
 
 NOTES:
 ******************************************************************************/
-int read_archive_metadata
+static int parse_core_metadata
 (
-    int32 sd_id,              /* I: file ID for the HDF file */
-    double *bound_coords      /* O: bounding coordinates */
+    const char *blob,         /* I: CoreMetadata blob text */
+    char prod_date_time[],    /* O: production date/time */
+    char pge_version[]        /* O: PGE version */
 )
 {
-    char FUNC_NAME[] = "read_archive_metadata";  /* function name */
+    char FUNC_NAME[] = "parse_core_metadata";  /* function name */
     char errmsg[STR_SIZE];      /* error message */
-    char attr_name[STR_SIZE];   /* attribute name */
-    char attrname[STR_SIZE];    /* holds the file_name string */
-    char *file_data = NULL;     /* character string used for reading the
-                                   ArchiveMetadata */
-    char *file_data_ptr = NULL; /* pointer to file_data for scanning */
-    int j;                  /* looping variable */
-    int32 attr_indx = -1;   /* index for the current attribute */
-    int32 data_type;        /* attribute's data type */
-    int32 n_values;         /* number of vals of the attribute */
-    int32 status;           /* return status */
-    bool north_bound_found; /* north bounding rectangle coord been found? */
-    bool south_bound_found; /* south bounding rectangle coord been found? */
-    bool east_bound_found;  /* east bounding rectangle coord been found? */
-    bool west_bound_found;  /* west bounding rectangle coord been found? */
-    int num_chars;          /* number of characters read in the line */
-    char token_buffer[STR_SIZE]; /* holds the current token */
-
-    /* Look for the ArchiveMetadata in the HDF file */
-    attr_indx = SDfindattr (sd_id, "ArchiveMetadata");
-
-    /* Only proceed if the attribute was found */
-    if (attr_indx == -1)
-    {
-        /* If not found then try concatenating sequence numbers */
-        for (j = 0; j <= 9; j++)
-        {
-            sprintf (attrname, "ArchiveMetadata.%d", j);
-            attr_indx = SDfindattr (sd_id, attrname);
-            if (attr_indx != -1)
-                break;
-        }
-
-        if (attr_indx == -1)
-        {
-            sprintf (errmsg, "Unable to locate ArchiveMetadata for reading");
-            error_handler (true, FUNC_NAME, errmsg);
-            return (ERROR);
-        }
-    }
+    const char *value = NULL;   /* value of the current object */
+    int count;              /* number of chars copied in snprintf */
+    Odl_pair_t *odl_table = NULL;  /* table of ODL object/value pairs */
 
-    /* Get size of HDF file attribute */
-    status = SDattrinfo (sd_id, attr_indx, attr_name, &data_type, &n_values);
-    if (status == -1)
+    /* Index the ODL objects in the CoreMetadata */
+    odl_table = calloc (ODL_TABLE_SIZE, sizeof (Odl_pair_t));
+    if (odl_table == NULL)
     {
-        sprintf (errmsg, "Unable to get the size of ArchiveMetadata attribute");
+        sprintf (errmsg, "Allocating memory for the ODL object table");
         error_handler (true, FUNC_NAME, errmsg);
         return (ERROR);
     }
 
-    /* Attempt to allocate memory for HDF file attribute contents (add one
-       character for the end of string character) */
-    file_data = calloc (n_values+1, sizeof (char));
-    if (file_data == NULL)
+    if (index_odl_blob (blob, odl_table) != SUCCESS)
     {
-        sprintf (errmsg, "Unable to allocate %d bytes for %s", n_values,
-            attr_name);
+        free (odl_table);
+        sprintf (errmsg, "Indexing the CoreMetadata objects");
         error_handler (true, FUNC_NAME, errmsg);
         return (ERROR);
     }
 
-    /* Read attribute from the HDF file */
-    status = SDreadattr (sd_id, attr_indx, file_data);
-    if (status == -1 || !strcmp (file_data, ""))
+    /* Look for the PRODUCTIONDATETIME object and store the value token
+       (without the surrounding ""s) */
+    value = odl_find (odl_table, "PRODUCTIONDATETIME");
+    if (value != NULL)
     {
-        free (file_data);
-        sprintf (errmsg, "Unable to read the ArchiveMetadata HDF attributes");
-        error_handler (true, FUNC_NAME, errmsg);
-        return (ERROR);
+        count = snprintf (prod_date_time, STR_SIZE, "%s", &value[1]);
+        if (count < 0 || count >= STR_SIZE)
+        {
+            free (odl_table);
+            sprintf (errmsg, "Overflow of prod_date_time string");
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+        prod_date_time[strlen(prod_date_time)-1] = '\0';
     }
 
-    /* Walk through the file_data string one token at a time looking for the
-       bounding coordinates */
-    north_bound_found = false;
-    south_bound_found = false;
-    east_bound_found = false;
-    west_bound_found = false;
-    file_data_ptr = file_data;
-    status = ERROR;
-    while (sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars) != EOF)
+    /* Look for the PGEVERSION object and store the value token (without
+       the surrounding ""s) */
+    value = odl_find (odl_table, "PGEVERSION");
+    if (value != NULL)
     {
-        /* If this token is END, then we are done with the metadata */
-        if (!strcmp (token_buffer, "END"))
-            break;
+        count = snprintf (pge_version, STR_SIZE, "%s", &value[1]);
+        if (count < 0 || count >= STR_SIZE)
+        {
+            free (odl_table);
+            sprintf (errmsg, "Overflow of pge_version string");
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+        pge_version[strlen(pge_version)-1] = '\0';
+    }
 
-        /* If all the bounding coords have been found, don't waste time with
-           the rest of the metadata */
-        if (north_bound_found && south_bound_found && east_bound_found &&
-            west_bound_found)
-            break;
+    /* Free dynamically allocated memory */
+    free (odl_table);
+
+    return (SUCCESS);
+}
 
-        /* Increment the file_data_ptr pointer to point to the next token */
-        file_data_ptr += num_chars;
 
-        /* Look for the NORTHBOUNDINGCOORDINATE token */
-        if (!strcmp (token_buffer, "NORTHBOUNDINGCOORDINATE") &&
-            !north_bound_found)
-        {
-            /* Read the next three tokens, this should be the
-               NUM_VAL = ... line */
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+/******************************************************************************
+MODULE:  parse_archive_metadata
+
+PURPOSE: Parses the archive metadata blob, searching for the desired fields.
 
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error parsing the archive metadata
+SUCCESS         Successfully parsed the archive metadata
 
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+5/6/2014     Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Index the ODL objects in a single pass and
+                              resolve the fields from the index
+8/31/2026    Gail Schmidt     Parse the blob text separately from the HDF
+                              attribute read so the parsing can overlap the
+                              SDS walk on a worker thread
 
-            /* Read the next three tokens, this should be the
-               VALUE = ... line */
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+NOTES:
+******************************************************************************/
+static int parse_archive_metadata
+(
+    const char *blob,         /* I: ArchiveMetadata blob text */
+    double *bound_coords      /* O: bounding coordinates */
+)
+{
+    char FUNC_NAME[] = "parse_archive_metadata";  /* function name */
+    char errmsg[STR_SIZE];      /* error message */
+    const char *value = NULL;   /* value of the current object */
+    Odl_pair_t *odl_table = NULL;  /* table of ODL object/value pairs */
 
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+    /* Index the ODL objects in the ArchiveMetadata */
+    odl_table = calloc (ODL_TABLE_SIZE, sizeof (Odl_pair_t));
+    if (odl_table == NULL)
+    {
+        sprintf (errmsg, "Allocating memory for the ODL object table");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
 
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+    if (index_odl_blob (blob, odl_table) != SUCCESS)
+    {
+        free (odl_table);
+        sprintf (errmsg, "Indexing the ArchiveMetadata objects");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
 
-            /* Store the value of the bounding coordinate */
-            bound_coords[ESPA_NORTH] = atof (token_buffer);
-            north_bound_found = true;
-            continue;  /* don't waste time looking for the other
-                          bounding rectangles with this token */
-        }
+    /* Look for the bounding coordinate objects and store the values */
+    value = odl_find (odl_table, "NORTHBOUNDINGCOORDINATE");
+    if (value != NULL)
+        bound_coords[ESPA_NORTH] = atof (value);
 
-        /* Look for the SOUTHBOUNDINGCOORDINATE token */
-        if (!strcmp (token_buffer, "SOUTHBOUNDINGCOORDINATE") &&
-            !south_bound_found)
-        {
-            /* Read the next three tokens, this should be the
-               NUM_VAL = ... line */
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+    value = odl_find (odl_table, "SOUTHBOUNDINGCOORDINATE");
+    if (value != NULL)
+        bound_coords[ESPA_SOUTH] = atof (value);
 
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+    value = odl_find (odl_table, "EASTBOUNDINGCOORDINATE");
+    if (value != NULL)
+        bound_coords[ESPA_EAST] = atof (value);
 
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+    value = odl_find (odl_table, "WESTBOUNDINGCOORDINATE");
+    if (value != NULL)
+        bound_coords[ESPA_WEST] = atof (value);
 
-            /* Read the next three tokens, this should be the
-               VALUE = ... line */
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+    /* Free dynamically allocated memory */
+    free (odl_table);
 
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+    return (SUCCESS);
+}
 
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
 
-            /* Store the value of the bounding coordinate */
-            bound_coords[ESPA_SOUTH] = atof (token_buffer);
-            south_bound_found = true;
-            continue;  /* don't waste time looking for the other
-                          bounding rectangles with this token */
-        }
+/* State shared with the worker thread that parses the ODL metadata blobs
+   while the main thread walks the SDSs through the HDF4 API */
+typedef struct
+{
+    char *core_blob;          /* CoreMetadata blob text (freed by the
+                                 worker thread) */
+    char *archive_blob;       /* ArchiveMetadata blob text (freed by the
+                                 worker thread) */
+    char *prod_date_time;     /* O: production date/time */
+    char *pge_version;        /* O: PGE version */
+    double *bound_coords;     /* O: bounding coordinates */
+    pthread_t thread;         /* worker thread handle */
+    bool thread_started;      /* is the worker thread running? */
+    int status;               /* SUCCESS/ERROR from the parsing */
+} Modis_odl_parse_t;
 
-        /* Look for the EASTBOUNDINGCOORDINATE token */
-        if (!strcmp (token_buffer, "EASTBOUNDINGCOORDINATE") &&
-            !east_bound_found)
-        {
-            /* Read the next three tokens, this should be the
-               NUM_VAL = ... line */
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
 
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+/******************************************************************************
+MODULE:  parse_odl_metadata_thread
 
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+PURPOSE: Worker thread entry point that parses the CoreMetadata and
+ArchiveMetadata blob text.  No HDF4 calls are made here, so the parsing can
+run while the main thread keeps reading the HDF file.
 
-            /* Read the next three tokens, this should be the
-               VALUE = ... line */
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+RETURN VALUE:
+Type = void *
+Value           Description
+-----           -----------
+NULL            Always; the parsing status is stored in the shared state
 
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
 
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+NOTES:
+******************************************************************************/
+static void *parse_odl_metadata_thread
+(
+    void *arg                 /* I: Modis_odl_parse_t shared state */
+)
+{
+    Modis_odl_parse_t *odl = arg;   /* shared parsing state */
 
-            /* Store the value of the bounding coordinate */
-            bound_coords[ESPA_EAST] = atof (token_buffer);
-            east_bound_found = true;
-            continue;  /* don't waste time looking for the other
-                          bounding rectangles with this token */
-        }
+    odl->status = SUCCESS;
+    if (parse_core_metadata (odl->core_blob, odl->prod_date_time,
+        odl->pge_version) != SUCCESS)
+        odl->status = ERROR;
+    else if (parse_archive_metadata (odl->archive_blob, odl->bound_coords)
+        != SUCCESS)
+        odl->status = ERROR;
 
-        /* Look for the WESTBOUNDINGCOORDINATE token */
-        if (!strcmp (token_buffer, "WESTBOUNDINGCOORDINATE") &&
-            !west_bound_found)
-        {
-            /* Read the next three tokens, this should be the
-               NUM_VAL = ... line */
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+    free (odl->core_blob);
+    free (odl->archive_blob);
 
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+    return (NULL);
+}
 
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
 
-            /* Read the next three tokens, this should be the
-               VALUE = ... line */
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+/******************************************************************************
+MODULE:  finish_odl_parse
 
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+PURPOSE: Waits for the metadata parsing thread to finish and reports its
+status.  Safe to call more than once.
 
-            sscanf (file_data_ptr, "%s%n", token_buffer, &num_chars);
-            file_data_ptr += num_chars;
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error parsing the metadata blobs
+SUCCESS         Successfully parsed the metadata blobs
 
-            /* Store the value of the bounding coordinate */
-            bound_coords[ESPA_WEST] = atof (token_buffer);
-            west_bound_found = true;
-            continue;  /* don't waste time looking for the other
-                          bounding rectangles with this token */
-        }
-    }  /* end while */
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
 
-    /* Free dynamically allocated memory */
-    free (file_data);
+NOTES:
+******************************************************************************/
+static int finish_odl_parse
+(
+    Modis_odl_parse_t *odl    /* I/O: shared parsing state */
+)
+{
+    if (odl->thread_started)
+    {
+        pthread_join (odl->thread, NULL);
+        odl->thread_started = false;
+    }
 
-    return (SUCCESS);
+    return (odl->status);
 }
 
 
@@ -1092,6 +1256,10 @@ Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 4/22/2014    Gail Schmidt     Original development
 11/12/2014   Gail Schmidt     Added support for the resample_method
+8/31/2026    Gail Schmidt     Parse the core and archive metadata text on a
+                              worker thread that overlaps the SDS walk
+8/31/2026    Gail Schmidt     Consume gzip-compressed inputs through the
+                              memory-backed inflate layer
 
 NOTES:
 ******************************************************************************/
@@ -1104,6 +1272,7 @@ int read_modis_hdf
 {
     char FUNC_NAME[] = "read_modis_hdf";  /* function name */
     char errmsg[STR_SIZE];    /* error message */
+    char open_path[STR_SIZE]; /* path of the (possibly inflated) HDF input */
     char basename[STR_SIZE];  /* filename without path (uppercase) */
     char core_basename[STR_SIZE]; /* filename without path and extension */
     char strbuf[STR_SIZE];    /* temporary buffer to string data */
@@ -1142,6 +1311,7 @@ int read_modis_hdf
     int nmodis_bands;         /* number of bands that will be in the ESPA
                                  product from the MODIS file */
     int sdsfield = 0;         /* current SDS field to be processed */
+    int gz_fd = -1;           /* descriptor backing an inflated gzip input */
     int32 fid;                /* file ID for the HDF-EOS file */
     int32 gid;                /* grid ID for the HDF-EOS file */
     int32 sd_id;              /* file ID for the HDF file */
@@ -1178,6 +1348,8 @@ int read_modis_hdf
     Espa_global_meta_t *gmeta = &metadata->global;  /* pointer to the global
                                                        metadata structure */
     Espa_band_meta_t *bmeta;      /* pointer to the array of bands metadata */
+    Modis_odl_parse_t odl;        /* state shared with the metadata parsing
+                                     thread */
 
     /* Get the basename of the input HDF file */
     cptr = strrchr (modis_hdf_name, '/');
@@ -1305,17 +1477,44 @@ int read_modis_hdf
     vtile[2] = '\0';
     gmeta->vtile = atoi (vtile);
 
-    /* Open HDF-EOS file for reading */
-    fid = GDopen (modis_hdf_name, DFACC_READ);
-    if (fid < 0)
+    /* Inflate gzip-compressed inputs into a memory-backed file so the HDF
+       interfaces can seek in them; the identity fields above were parsed
+       from the original filename */
+    if (is_gzip_input (modis_hdf_name))
     {
-        sprintf (errmsg, "Unable to open %s", modis_hdf_name);
+        if (open_gzip_input (modis_hdf_name, open_path, sizeof (open_path),
+            &gz_fd) != SUCCESS)
+        {  /* Error messages already printed */
+            return (ERROR);
+        }
+    }
+    else
+    {
+        count = snprintf (open_path, sizeof (open_path), "%s",
+            modis_hdf_name);
+        if (count < 0 || count >= sizeof (open_path))
+        {
+            sprintf (errmsg, "Overflow of open_path string");
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+    }
+
+    /* Open HDF-EOS file for reading */
+    fid = GDopen (open_path, DFACC_READ);
+    if (fid < 0)
+    {
+        sprintf (errmsg, "Unable to open %s", modis_hdf_name);
         error_handler (true, FUNC_NAME, errmsg);
+        close_gzip_input (gz_fd, open_path);
         return (ERROR);
     }
 
-    /* Open as HDF file for reading */
-    sd_id = SDstart (modis_hdf_name, DFACC_RDONLY);
+    /* Open as HDF file for reading.  Both interfaces hold their own
+       descriptors, so an inflated input can be released as soon as the
+       opens have happened. */
+    sd_id = SDstart (open_path, DFACC_RDONLY);
+    close_gzip_input (gz_fd, open_path);
     if (sd_id < 0)
     {
         sprintf (errmsg, "Unable to open %s for reading as SDS",
@@ -1324,24 +1523,38 @@ int read_modis_hdf
         return (ERROR);
     }
 
-    /* Read the production date/time and PGE version from the core metadata */
-    status = read_core_metadata (sd_id, prod_date_time, pge_version);
-    if (status != SUCCESS)
+    /* Read the CoreMetadata and ArchiveMetadata blobs.  The HDF4 library is
+       not thread safe, so only the attribute reads happen here; parsing the
+       blob text makes no HDF4 calls and is handed to a worker thread that
+       runs while the SDS walk below continues through the HDF4 API. */
+    if (read_odl_blob (sd_id, "CoreMetadata", &odl.core_blob) != SUCCESS)
     {
         sprintf (errmsg, "Reading the core metadata from the HDF file.");
         error_handler (true, FUNC_NAME, errmsg);
         return (ERROR);
     }
 
-    /* Read the bounding coordinates from the core metadata */
-    status = read_archive_metadata (sd_id, gmeta->bounding_coords);
-    if (status != SUCCESS)
+    if (read_odl_blob (sd_id, "ArchiveMetadata", &odl.archive_blob) != SUCCESS)
     {
+        free (odl.core_blob);
         sprintf (errmsg, "Reading the archive metadata from the HDF file.");
         error_handler (true, FUNC_NAME, errmsg);
         return (ERROR);
     }
 
+    odl.prod_date_time = prod_date_time;
+    odl.pge_version = pge_version;
+    odl.bound_coords = gmeta->bounding_coords;
+    odl.status = SUCCESS;
+    odl.thread_started = true;
+    if (pthread_create (&odl.thread, NULL, parse_odl_metadata_thread, &odl)
+        != 0)
+    {
+        /* Parse in line if the worker thread cannot be started */
+        odl.thread_started = false;
+        parse_odl_metadata_thread (&odl);
+    }
+
     /* Get the list of grids in the HDF-EOS file */
     ngrids = GDinqgrid (modis_hdf_name, gridstr, &bufsize);
     gridlist = gridstr;
@@ -1354,6 +1567,7 @@ int read_modis_hdf
             "supports gridded HDF-EOS data, not swath or point HDF-EOS data.",
             modis_hdf_name);
         error_handler (true, FUNC_NAME, errmsg);
+        finish_odl_parse (&odl);
         return (ERROR);
     }
 
@@ -1374,6 +1588,7 @@ int read_modis_hdf
         {
             sprintf (errmsg, "Overflow of grid_names[i] string");
             error_handler (true, FUNC_NAME, errmsg);
+            finish_odl_parse (&odl);
             return (ERROR);
         }
 
@@ -1383,6 +1598,7 @@ int read_modis_hdf
         {
             sprintf (errmsg, "Unable to attach to grid %s", gridname);
             error_handler (true, FUNC_NAME, errmsg);
+            finish_odl_parse (&odl);
             return (ERROR);
         }
 
@@ -1408,6 +1624,7 @@ int read_modis_hdf
             {
                 sprintf (errmsg, "Reading field info for current field.");
                 error_handler (true, FUNC_NAME, errmsg);
+                finish_odl_parse (&odl);
                 return (ERROR);
             }
 
@@ -1445,6 +1662,7 @@ int read_modis_hdf
             {
                 sprintf (errmsg, "Overflow of modis_bands[] string");
                 error_handler (true, FUNC_NAME, errmsg);
+                finish_odl_parse (&odl);
                 return (ERROR);
             }
 
@@ -1459,6 +1677,7 @@ int read_modis_hdf
             {
                 sprintf (errmsg, "Reading SDS-specific values from HDF file");
                 error_handler (true, FUNC_NAME, errmsg);
+                finish_odl_parse (&odl);
                 return (ERROR);
             }
 
@@ -1476,6 +1695,16 @@ int read_modis_hdf
     {
         sprintf (errmsg, "Closing HDF file.");
         error_handler (true, FUNC_NAME, errmsg);
+        finish_odl_parse (&odl);
+        return (ERROR);
+    }
+
+    /* Wait for the metadata parsing to finish before using its outputs */
+    if (finish_odl_parse (&odl) != SUCCESS)
+    {
+        sprintf (errmsg, "Parsing the core and archive metadata from the HDF "
+            "file.");
+        error_handler (true, FUNC_NAME, errmsg);
         return (ERROR);
     }
 
@@ -1719,16 +1948,12 @@ int read_modis_hdf
                this is a QA band and change the category to flag that.  The
                MOD13 products also use Legend for "MIR reflectance" SDSs to
                provide additional information, but these aren't QA bands. */
-            count = snprintf (bmeta[nmodis_bands].qa_desc,
-                sizeof (bmeta[nmodis_bands].qa_desc), "%s",
-                qa_desc[nmodis_bands]);
-            if (count < 0 || count >= sizeof (bmeta[nmodis_bands].qa_desc))
-            {
-                sprintf (errmsg, "Overflow of bmeta[].qa_desc string");
-                error_handler (true, FUNC_NAME, errmsg);
+            if (set_band_qa_desc (&bmeta[nmodis_bands],
+                qa_desc[nmodis_bands]) != SUCCESS)
+            {   /* Error messages already printed */
                 return (ERROR);
             }
-            if (strcmp (bmeta[nmodis_bands].qa_desc, ESPA_STRING_META_FILL) &&
+            if (bmeta[nmodis_bands].qa_desc != NULL &&
                 !strstr (bmeta[nmodis_bands].name, "MIR reflectance"))
                 strcpy (bmeta[nmodis_bands].category, "qa");
 
@@ -1824,10 +2049,10 @@ int read_modis_hdf
 
 
 /******************************************************************************
-MODULE:  convert_hdf_to_img
+MODULE:  convert_hdf_band
 
-PURPOSE: Convert the MODIS HDF SDS to an ESPA raw binary (.img) file and writes
-the associated ENVI header for each band.
+PURPOSE: Convert a single MODIS HDF SDS to an ESPA raw binary (.img) file and
+write the associated ENVI header.
 
 RETURN VALUE:
 Type = int
@@ -1839,25 +2064,56 @@ SUCCESS         Successfully converted MODIS SDS to raw binary
 HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
-4/22/2014    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Original development, pulled from the band loop
+                              in convert_hdf_to_img so the bands can be
+                              converted concurrently
+8/31/2026    Gail Schmidt     Stream the SDS a hyperslab of lines at a time
+                              to bound the memory used per band
+8/31/2026    Gail Schmidt     Write the raw binary file with direct writes
+                              to keep the band out of the page cache
+8/31/2026    Gail Schmidt     Optionally clamp the band to its valid range
+                              while the chunk is in cache (set
+                              ESPA_ENFORCE_VALID_RANGE)
+8/31/2026    Gail Schmidt     Optionally accumulate the band statistics while
+                              the chunk is in cache (set ESPA_COMPUTE_STATS)
+8/31/2026    Gail Schmidt     Allocate the chunk buffer through the NUMA-aware
+                              buffer allocator
+8/31/2026    Gail Schmidt     Resolve the type-specialized kernels once per
+                              band instead of re-branching per chunk
+8/31/2026    Gail Schmidt     Borrow the chunk buffer from the reuse pool
+                              instead of allocating it per band
+8/31/2026    Gail Schmidt     Open the band through the negotiated output
+                              sink so delivery compression happens during
+                              the conversion (set ESPA_IMG_COMPRESS)
+8/31/2026    Gail Schmidt     Write the ENVI header straight from the band
+                              metadata with the direct emitter
+8/31/2026    Gail Schmidt     Poll the cooperative cancellation flag at
+                              the chunk boundaries
 
 NOTES:
+  1. Instead of reading the entire SDS into memory at once, read a chunk of
+     lines as a hyperslab into a buffer, write the chunk to the raw binary
+     file, then reuse the buffer for the next chunk.  This keeps the memory
+     used per SDS flat for the large 250m grids.
 ******************************************************************************/
-int convert_hdf_to_img
+static int convert_hdf_band
 (
-    char *modis_hdf_name,      /* I: name of MODIS file to be processed */
-    Espa_internal_meta_t *xml_metadata /* I: metadata structure for HDF file */
+    int32 sd_id,               /* I: file ID for the HDF file */
+    int band,                  /* I: band index in the XML metadata */
+    Espa_band_meta_t *bmeta,   /* I: pointer to band metadata for this band */
+    Espa_global_meta_t *gmeta  /* I: pointer to global metadata */
 )
 {
-    char FUNC_NAME[] = "convert_hdf_to_img";  /* function name */
+    char FUNC_NAME[] = "convert_hdf_band";  /* function name */
     char errmsg[STR_SIZE];    /* error message */
     char *cptr = NULL;        /* pointer to the file extension */
     char *img_file = NULL;    /* name of the output raw binary file */
     char envi_file[STR_SIZE]; /* name of the output ENVI header file */
-    int i;                    /* looping variable for bands in XML file */
     int nbytes;               /* number of bytes in the data type */
     int count;                /* number of chars copied in snprintf */
-    int32 sd_id;              /* file ID for the HDF file */
+    int chunk_nlines;         /* number of lines in the chunk buffer */
+    int curr_nlines;          /* number of lines in the current chunk */
+    int chunk_line;           /* first line of the current chunk */
     int32 sds_id;             /* SDS ID in the HDF file */
     int32 sds_index;          /* index of current SDS name */
     int32 start[2];           /* starting point to read SDS data */
@@ -1865,163 +2121,2315 @@ int convert_hdf_to_img
     int32 status;             /* return status of the HDF function */
     void *file_buf = NULL;    /* pointer to correct input file buffer */
     FILE *fp_rb = NULL;       /* file pointer for the raw binary file */
-    Envi_header_t envi_hdr;   /* output ENVI header information */
-    Espa_band_meta_t *bmeta = NULL;  /* pointer to band metadata */
-    Espa_global_meta_t *gmeta = &xml_metadata->global;  /* global metadata */
+    Espa_stat_accum_t stats;  /* running statistics accumulator */
+    Espa_band_kernels_t bkern;  /* resolved kernels for the band */
 
-    /* Open as HDF file for reading */
-    sd_id = SDstart (modis_hdf_name, DFACC_RDONLY);
-    if (sd_id < 0)
+    if (espa_stats_enabled ())
+        espa_stats_init (&stats);
+
+    /* Resolve the type-specialized kernels for the band once, so the chunk
+       loop below runs monomorphic loop bodies through the pointers instead
+       of re-branching on the data type for every chunk */
+    if (espa_valid_range_enforced () || espa_stats_enabled ())
     {
-        sprintf (errmsg, "Unable to open %s for reading as SDS",
-            modis_hdf_name);
+        if (espa_band_kernels_init (bmeta, &bkern) != SUCCESS)
+        {  /* Error messages already printed */
+            return (ERROR);
+        }
+    }
+
+    /* Find the SDS name */
+    sds_index = SDnametoindex (sd_id, bmeta->name);
+    if (sds_index == -1)
+    {
+        sprintf (errmsg, "Unable to find %.1024s in the HDF file", bmeta->name);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+    printf ("  SDS %d: %s -- index: %d\n", band, bmeta->name, sds_index);
+
+    /* Open the current band as an SDS */
+    sds_id = SDselect (sd_id, sds_index);
+    if (sds_id < 0)
+    {
+        sprintf (errmsg, "Unable to access %.1024s for reading", bmeta->name);
         error_handler (true, FUNC_NAME, errmsg);
         return (ERROR);
     }
 
-    /* Loop through the bands in the metadata file and convert each on to
-       the ESPA format */
-    for (i = 0; i < xml_metadata->nbands; i++)
+    /* Determine the number of bytes in the input data type.  Since HDF
+       reading works off of a void pointer and the raw binary write works
+       off of a void pointer, there's no need to use a data type specific
+       pointer for reading/writing memory.  Just make sure there are enough
+       bytes for reading the data, based on the data type. */
+    if (bmeta->data_type == ESPA_UINT8 || bmeta->data_type == ESPA_INT8)
+        nbytes = sizeof (uint8);
+    else if (bmeta->data_type == ESPA_UINT16 ||
+        bmeta->data_type == ESPA_INT16)
+        nbytes = sizeof (uint16);
+    else if (bmeta->data_type == ESPA_UINT32 ||
+        bmeta->data_type == ESPA_INT32)
+        nbytes = sizeof (uint32);
+    else if (bmeta->data_type == ESPA_FLOAT32)
+        nbytes = sizeof (float32);
+    else if (bmeta->data_type == ESPA_FLOAT64)
+        nbytes = sizeof (float64);
+    else
     {
-        /* Set up the band metadata pointer */
-        bmeta = &xml_metadata->band[i];
+        sprintf (errmsg, "Unsupported data type %d.", bmeta->data_type);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
 
-        /* Find the SDS name */
-        sds_index = SDnametoindex (sd_id, bmeta->name);
-        if (sds_index == -1)
+    /* Open the raw binary file through the negotiated output sink; plain
+       bands are written directly so nothing on the node rereads them out
+       of the page cache, and compressed output (set ESPA_IMG_COMPRESS)
+       compresses the band while the chunks are still cache-hot */
+    img_file = bmeta->file_name;
+    fp_rb = open_raw_binary_band (img_file, bmeta->nlines, bmeta->nsamps,
+        nbytes, "wbd");
+    if (fp_rb == NULL)
+    {
+        sprintf (errmsg, "Opening the output raw binary file: %s",
+            img_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Allocate memory for a chunk of lines, bounding the memory used per
+       SDS regardless of the grid size */
+    chunk_nlines = MODIS_HDF_CHUNK_BYTES / (bmeta->nsamps * nbytes);
+    if (chunk_nlines < 1)
+        chunk_nlines = 1;
+    if (chunk_nlines > bmeta->nlines)
+        chunk_nlines = bmeta->nlines;
+    file_buf = espa_borrow_buffer ((size_t) chunk_nlines * bmeta->nsamps *
+        nbytes);
+    if (file_buf == NULL)
+    {
+        sprintf (errmsg, "Allocating memory for a chunk of %d lines x %d "
+            "samples.", chunk_nlines, bmeta->nsamps);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Loop through the chunks of lines in the SDS, reading each chunk as a
+       hyperslab then writing it to the raw binary file and reusing the
+       buffer for the next chunk */
+    for (chunk_line = 0; chunk_line < bmeta->nlines;
+         chunk_line += chunk_nlines)
+    {
+        /* Unwind cleanly at the chunk boundary if the scheduler asked for
+           a cancellation; with atomic output commits the band never
+           reaches its final name */
+        if (espa_cancel_requested ())
         {
-            sprintf (errmsg, "Unable to find %s in the HDF file", bmeta->name);
+            sprintf (errmsg, "Conversion canceled at line %d of SDS %s",
+                chunk_line, bmeta->name);
             error_handler (true, FUNC_NAME, errmsg);
+            espa_return_buffer (file_buf);
             return (ERROR);
         }
-        printf ("  SDS %d: %s -- index: %d\n", i, bmeta->name, sds_index);
 
-        /* Open the current band as an SDS */
-        sds_id = SDselect (sd_id, sds_index);
-        if (sds_id < 0)
+        /* Determine the number of lines in the current chunk; the last chunk
+           can be short */
+        curr_nlines = chunk_nlines;
+        if (chunk_line + curr_nlines > bmeta->nlines)
+            curr_nlines = bmeta->nlines - chunk_line;
+
+        /* Read the current chunk of lines from the SDS */
+        start[0] = chunk_line;
+        start[1] = 0;
+        edges[0] = curr_nlines;
+        edges[1] = bmeta->nsamps;
+        status = SDreaddata (sds_id, start, NULL, edges, file_buf);
+        if (status == -1)
         {
-            sprintf (errmsg, "Unable to access %s for reading", bmeta->name);
+            sprintf (errmsg, "Reading data from the SDS: %s", bmeta->name);
             error_handler (true, FUNC_NAME, errmsg);
+            espa_return_buffer (file_buf);
             return (ERROR);
         }
 
-        /* Open the raw binary file for writing */
-        img_file = bmeta->file_name;
-        fp_rb = open_raw_binary (img_file, "wb");
-        if (fp_rb == NULL)
+        /* Clamp the chunk to the valid range while it is still in cache,
+           if enforcement was requested */
+        if (espa_valid_range_enforced ())
+            espa_band_clamp (&bkern, file_buf,
+                (long) curr_nlines * bmeta->nsamps);
+
+        /* Accumulate the band statistics while the chunk is still in cache,
+           if they were requested */
+        if (espa_stats_enabled ())
+            espa_band_stats (&bkern, file_buf,
+                (long) curr_nlines * bmeta->nsamps, &stats);
+
+        /* Write the current chunk to the raw binary file */
+        if (write_raw_binary (fp_rb, curr_nlines, bmeta->nsamps, nbytes,
+            file_buf) != SUCCESS)
         {
-            sprintf (errmsg, "Opening the output raw binary file: %s",
+            sprintf (errmsg, "Writing image to the raw binary file: %s",
                 img_file);
             error_handler (true, FUNC_NAME, errmsg);
+            espa_return_buffer (file_buf);
             return (ERROR);
         }
+    }
 
-        /* Allocate memory for the entire image, based on the input data type.
-           Since HDF reading works off of a void pointer and the raw binary
-           write works off of a void pointer, there's no need to use a data
-           type specific pointer for reading/writing memory.  Just make sure
-           there are enough bytes for reading the data, based on the data
-           type. */
-        if (bmeta->data_type == ESPA_UINT8 || bmeta->data_type == ESPA_INT8)
-            nbytes = sizeof (uint8);
-        else if (bmeta->data_type == ESPA_UINT16 ||
-            bmeta->data_type == ESPA_INT16)
-            nbytes = sizeof (uint16);
-        else if (bmeta->data_type == ESPA_UINT32 ||
-            bmeta->data_type == ESPA_INT32)
-            nbytes = sizeof (uint32);
-        else if (bmeta->data_type == ESPA_FLOAT32)
-            nbytes = sizeof (float32);
-        else if (bmeta->data_type == ESPA_FLOAT64)
-            nbytes = sizeof (float64);
-        else
+    /* Store the accumulated statistics in the band metadata, from where
+       they are written to the XML */
+    if (espa_stats_enabled ())
+        espa_stats_finish (&stats, bmeta);
+
+    /* Close the HDF SDS and raw binary file */
+    close_raw_binary (fp_rb);
+    status = SDendaccess (sds_id);
+    if (status == -1)
+    {
+        sprintf (errmsg, "Ending access to SDS: %.1024s", bmeta->name);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Free the memory */
+    espa_return_buffer (file_buf);
+
+    /* Write the ENVI header for this band straight from the metadata */
+    count = snprintf (envi_file, sizeof (envi_file), "%s", img_file);
+    if (count < 0 || count >= sizeof (envi_file))
+    {
+        sprintf (errmsg, "Overflow of envi_file string");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+    cptr = strrchr (envi_file, '.');
+    strcpy (cptr, ".hdr");
+
+    if (write_envi_hdr_meta (envi_file, bmeta, gmeta) != SUCCESS)
+    {
+        sprintf (errmsg, "Writing the ENVI header file: %.1024s.", envi_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Successful conversion */
+    return (SUCCESS);
+}
+
+
+/* Work pool shared by the SDS conversion threads; the bands to be converted
+   are handed out via the next_band index under the lock */
+typedef struct
+{
+    char *modis_hdf_name;     /* name of the MODIS file being processed */
+    Espa_internal_meta_t *xml_metadata;  /* XML metadata for the bands */
+    int next_band;            /* next band index to be converted */
+    int status;               /* overall conversion status */
+    pthread_mutex_t lock;     /* protects next_band and status */
+} Modis_sds_pool_t;
+
+
+/******************************************************************************
+MODULE:  convert_modis_band_worker
+
+PURPOSE: Thread worker which opens its own HDF file handle, then pulls band
+indices from the shared pool and converts each SDS to raw binary until no
+bands remain.
+
+RETURN VALUE:
+Type = void *
+Value           Description
+-----           -----------
+NULL            Always; the overall status is reported via the pool
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. HDF4 reads of distinct SDSs are independent as long as each thread uses
+     its own file handle from SDstart.
+  2. If any band fails, the failure is recorded in the pool and the remaining
+     workers drain without starting new bands.
+******************************************************************************/
+static void *convert_modis_band_worker
+(
+    void *arg                 /* I: pointer to the Modis_sds_pool_t pool */
+)
+{
+    char FUNC_NAME[] = "convert_modis_band_worker";  /* function name */
+    char errmsg[STR_SIZE];    /* error message */
+    Modis_sds_pool_t *pool = arg;  /* shared SDS conversion pool */
+    int i;                    /* band currently being converted */
+    int32 sd_id;              /* per-thread file ID for the HDF file */
+
+    /* Open a file handle of our own for reading the SDSs */
+    sd_id = SDstart (pool->modis_hdf_name, DFACC_RDONLY);
+    if (sd_id < 0)
+    {
+        sprintf (errmsg, "Unable to open %s for reading as SDS",
+            pool->modis_hdf_name);
+        error_handler (true, FUNC_NAME, errmsg);
+        pthread_mutex_lock (&pool->lock);
+        pool->status = ERROR;
+        pthread_mutex_unlock (&pool->lock);
+        return (NULL);
+    }
+
+    while (true)
+    {
+        /* Grab the next band to be converted; quit if no bands remain or
+           another worker has already hit an error */
+        pthread_mutex_lock (&pool->lock);
+        if (pool->status != SUCCESS ||
+            pool->next_band >= pool->xml_metadata->nbands)
         {
-            sprintf (errmsg, "Unsupported data type %d.", bmeta->data_type);
-            error_handler (true, FUNC_NAME, errmsg);
-            return (ERROR);
+            pthread_mutex_unlock (&pool->lock);
+            break;
         }
+        i = pool->next_band++;
+        pthread_mutex_unlock (&pool->lock);
 
-        file_buf = calloc (bmeta->nlines * bmeta->nsamps, nbytes);
-        if (file_buf == NULL)
+        if (convert_hdf_band (sd_id, i, &pool->xml_metadata->band[i],
+            &pool->xml_metadata->global) != SUCCESS)
         {
-            sprintf (errmsg, "Allocating memory for the image data containing "
-                "%d lines x %d samples.", bmeta->nlines, bmeta->nsamps);
+            sprintf (errmsg, "Converting band %d: %.1024s", i,
+                pool->xml_metadata->band[i].name);
             error_handler (true, FUNC_NAME, errmsg);
-            return (ERROR);
+            pthread_mutex_lock (&pool->lock);
+            pool->status = ERROR;
+            pthread_mutex_unlock (&pool->lock);
+            break;
         }
+    }
 
-        /* Read the entire tile */
-        start[0] = 0;
-        start[1] = 0;
-        edges[0] = bmeta->nlines;
-        edges[1] = bmeta->nsamps;
-        status = SDreaddata (sds_id, start, NULL, edges, file_buf);
-        if (status == -1)
-        {
-            sprintf (errmsg, "Reading data from the SDS: %s", bmeta->name);
-            error_handler (true, FUNC_NAME, errmsg);
+    SDend (sd_id);
+    return (NULL);
+}
+
+
+/******************************************************************************
+MODULE:  convert_hdf_to_img
+
+PURPOSE: Convert the MODIS HDF SDS to an ESPA raw binary (.img) file and writes
+the associated ENVI header for each band.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error converting the MODIS SDS
+SUCCESS         Successfully converted MODIS SDS to raw binary
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+4/22/2014    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added support for converting multiple SDSs
+                              concurrently via a thread pool
+8/31/2026    Gail Schmidt     Consume gzip-compressed inputs through the
+                              memory-backed inflate layer
+
+NOTES:
+  1. Each SDS conversion is independent and the worker threads use their own
+     HDF file handles, so the SDSs can be converted concurrently.  Specifying
+     num_threads of 1 (or less) retains the original serial behavior.
+******************************************************************************/
+int convert_hdf_to_img
+(
+    char *modis_hdf_name,      /* I: name of MODIS file to be processed */
+    Espa_internal_meta_t *xml_metadata, /* I: metadata structure for HDF
+                                    file */
+    int num_threads            /* I: number of threads to use for converting
+                                    the SDSs; 1 or less converts serially */
+)
+{
+    char FUNC_NAME[] = "convert_hdf_to_img";  /* function name */
+    char errmsg[STR_SIZE];    /* error message */
+    char open_path[STR_SIZE]; /* path of the (possibly inflated) HDF input */
+    int i;                    /* looping variable for bands in XML file */
+    int count;                /* number of chars copied in snprintf */
+    int gz_fd = -1;           /* descriptor backing an inflated gzip input */
+    int32 sd_id;              /* file ID for the HDF file */
+    int32 status;             /* return status of the HDF function */
+    pthread_t threads[MAX_MODIS_BANDS];  /* SDS conversion thread handles */
+    Modis_sds_pool_t pool;    /* shared pool for the conversion threads */
+
+    /* No sense spinning up more threads than there are bands */
+    if (num_threads > xml_metadata->nbands)
+        num_threads = xml_metadata->nbands;
+
+    /* Inflate gzip-compressed inputs into a memory-backed file so the SDS
+       reads can seek in them.  The inflated input has to stay alive for the
+       whole conversion since the worker threads each open their own handle
+       to it. */
+    if (is_gzip_input (modis_hdf_name))
+    {
+        if (open_gzip_input (modis_hdf_name, open_path, sizeof (open_path),
+            &gz_fd) != SUCCESS)
+        {  /* Error messages already printed */
             return (ERROR);
         }
-
-        /* Write entire image to the raw binary file */
-        if (write_raw_binary (fp_rb, bmeta->nlines, bmeta->nsamps, nbytes,
-            file_buf) != SUCCESS)
+    }
+    else
+    {
+        count = snprintf (open_path, sizeof (open_path), "%s",
+            modis_hdf_name);
+        if (count < 0 || count >= sizeof (open_path))
         {
-            sprintf (errmsg, "Writing image to the raw binary file: %s",
-                img_file);
+            sprintf (errmsg, "Overflow of open_path string");
             error_handler (true, FUNC_NAME, errmsg);
             return (ERROR);
         }
+    }
 
-        /* Close the HDF SDS and raw binary file */
-        close_raw_binary (fp_rb);
-        status = SDendaccess (sds_id);
-        if (status == -1)
+    if (num_threads <= 1)
+    {
+        /* Open as HDF file for reading */
+        sd_id = SDstart (open_path, DFACC_RDONLY);
+        if (sd_id < 0)
         {
-            sprintf (errmsg, "Ending access to SDS: %s", bmeta->name);
+            sprintf (errmsg, "Unable to open %s for reading as SDS",
+                modis_hdf_name);
             error_handler (true, FUNC_NAME, errmsg);
+            close_gzip_input (gz_fd, open_path);
             return (ERROR);
         }
 
-        /* Free the memory */
-        free (file_buf);
-
-        /* Create the ENVI header file this band */
-        if (create_envi_struct (bmeta, gmeta, &envi_hdr) != SUCCESS)
+        /* Loop through the bands in the metadata file and convert each on to
+           the ESPA format */
+        for (i = 0; i < xml_metadata->nbands; i++)
         {
-            sprintf (errmsg, "Creating the ENVI header structure for this "
-                "file: %s", bmeta->file_name);
-            error_handler (true, FUNC_NAME, errmsg);
-            return (ERROR);
+            if (convert_hdf_band (sd_id, i, &xml_metadata->band[i],
+                &xml_metadata->global) != SUCCESS)
+            {
+                sprintf (errmsg, "Converting band %d: %.1024s", i,
+                    xml_metadata->band[i].name);
+                error_handler (true, FUNC_NAME, errmsg);
+                close_gzip_input (gz_fd, open_path);
+                return (ERROR);
+            }
         }
 
-        /* Write the ENVI header */
-        count = snprintf (envi_file, sizeof (envi_file), "%s", img_file);
-        if (count < 0 || count >= sizeof (envi_file))
+        /* Close the HDF file */
+        status = SDend (sd_id);
+        if (status == -1)
         {
-            sprintf (errmsg, "Overflow of envi_file string");
+            sprintf (errmsg, "Ending access to HDF file: %s", modis_hdf_name);
             error_handler (true, FUNC_NAME, errmsg);
+            close_gzip_input (gz_fd, open_path);
             return (ERROR);
         }
-        cptr = strrchr (envi_file, '.');
-        strcpy (cptr, ".hdr");
+    }
+    else
+    {
+        /* Set up the shared pool and convert the SDSs concurrently; each
+           worker opens its own HDF file handle */
+        pool.modis_hdf_name = open_path;
+        pool.xml_metadata = xml_metadata;
+        pool.next_band = 0;
+        pool.status = SUCCESS;
+        pthread_mutex_init (&pool.lock, NULL);
+
+        for (i = 0; i < num_threads; i++)
+        {
+            if (pthread_create (&threads[i], NULL, convert_modis_band_worker,
+                &pool) != 0)
+            {
+                sprintf (errmsg, "Creating SDS conversion thread %d", i);
+                error_handler (true, FUNC_NAME, errmsg);
+
+                /* Let the threads already started drain the pool */
+                num_threads = i;
+                pthread_mutex_lock (&pool.lock);
+                pool.status = ERROR;
+                pthread_mutex_unlock (&pool.lock);
+                break;
+            }
+        }
 
-        if (write_envi_hdr (envi_file, &envi_hdr) != SUCCESS)
+        /* Wait for the SDS conversions to complete */
+        for (i = 0; i < num_threads; i++)
+            pthread_join (threads[i], NULL);
+        pthread_mutex_destroy (&pool.lock);
+
+        if (pool.status != SUCCESS)
         {
-            sprintf (errmsg, "Writing the ENVI header file: %s.", envi_file);
+            sprintf (errmsg, "Converting the MODIS SDSs to raw binary");
             error_handler (true, FUNC_NAME, errmsg);
+            close_gzip_input (gz_fd, open_path);
             return (ERROR);
         }
-    }  /* end for */
+    }
 
-    /* Close the HDF file */
-    status = SDend (sd_id);
-    if (status == -1)
+    /* Release an inflated input now that the SDS reads are done */
+    close_gzip_input (gz_fd, open_path);
+
+    /* Successful conversion */
+    return (SUCCESS);
+}
+
+
+
+/* Context shared by the mosaic band conversion tasks; the band indices are
+   handed out by the shared worker pool */
+typedef struct
+{
+    char **modis_hdf_files;          /* names of the MODIS granule files */
+    Espa_internal_meta_t *granules;  /* per-granule metadata */
+    int nfiles;                      /* number of granule files */
+    Espa_internal_meta_t *mosaic;    /* combined mosaic metadata */
+    int hmin;                        /* leftmost horizontal tile number */
+    int vmin;                        /* topmost vertical tile number */
+    int ntile_h;                     /* number of tile columns */
+    int ntile_v;                     /* number of tile rows */
+} Modis_mosaic_pool_t;
+
+
+/******************************************************************************
+MODULE:  set_fill_buffer (static)
+
+PURPOSE: Fills a buffer of pixels with the band fill value, converted to the
+data type of the band.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Unsupported data type
+SUCCESS         Buffer was filled
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static int set_fill_buffer
+(
+    void *buf,               /* I/O: buffer of npixels values to be filled */
+    long npixels,            /* I: number of pixels in the buffer */
+    int data_type,           /* I: data type of the band (Espa_data_type) */
+    long fill_value          /* I: fill value for the band */
+)
+{
+    char FUNC_NAME[] = "set_fill_buffer";  /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    long i;                  /* looping variable for pixels */
+
+    switch (data_type)
     {
-        sprintf (errmsg, "Ending access to HDF file: %s", modis_hdf_name);
-        error_handler (true, FUNC_NAME, errmsg);
-        return (ERROR);
-    }
+        case ESPA_UINT8:
+            for (i = 0; i < npixels; i++)
+                ((uint8 *) buf)[i] = (uint8) fill_value;
+            break;
+        case ESPA_INT8:
+            for (i = 0; i < npixels; i++)
+                ((int8 *) buf)[i] = (int8) fill_value;
+            break;
+        case ESPA_UINT16:
+            for (i = 0; i < npixels; i++)
+                ((uint16 *) buf)[i] = (uint16) fill_value;
+            break;
+        case ESPA_INT16:
+            for (i = 0; i < npixels; i++)
+                ((int16 *) buf)[i] = (int16) fill_value;
+            break;
+        case ESPA_UINT32:
+            for (i = 0; i < npixels; i++)
+                ((uint32 *) buf)[i] = (uint32) fill_value;
+            break;
+        case ESPA_INT32:
+            for (i = 0; i < npixels; i++)
+                ((int32 *) buf)[i] = (int32) fill_value;
+            break;
+        case ESPA_FLOAT32:
+            for (i = 0; i < npixels; i++)
+                ((float32 *) buf)[i] = (float32) fill_value;
+            break;
+        case ESPA_FLOAT64:
+            for (i = 0; i < npixels; i++)
+                ((float64 *) buf)[i] = (float64) fill_value;
+            break;
+        default:
+            sprintf (errmsg, "Unsupported data type %d.", data_type);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  convert_hdf_mosaic_band (static)
+
+PURPOSE: Converts a single SDS from every input granule into one combined
+raw binary (.img) file, streaming each granule tile-by-tile into its window
+of the mosaic, and writes the associated ENVI header.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error converting the MODIS SDS
+SUCCESS         Successfully converted MODIS SDS to raw binary
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Resolve the type-specialized kernels once per
+                              band instead of re-branching per chunk
+8/31/2026    Gail Schmidt     Borrow the chunk buffer from the reuse pool
+                              instead of allocating it per band
+8/31/2026    Gail Schmidt     Write the ENVI header straight from the band
+                              metadata with the direct emitter
+
+NOTES:
+  1. The memory used is bounded by one hyperslab chunk of tile lines plus
+     one mosaic line for the fill prefill, regardless of how many granules
+     make up the mosaic.
+  2. Tiles of the combined grid not covered by any input granule are left
+     at the band fill value.
+******************************************************************************/
+static int convert_hdf_mosaic_band
+(
+    void *ctx,                 /* I: Modis_mosaic_pool_t context */
+    int ib                     /* I: band index in the mosaic metadata */
+)
+{
+    char FUNC_NAME[] = "convert_hdf_mosaic_band";  /* function name */
+    char errmsg[STR_SIZE];    /* error message */
+    char *cptr = NULL;        /* pointer to the file extension */
+    char envi_file[STR_SIZE]; /* name of the output ENVI header file */
+    int count;                /* number of chars copied in snprintf */
+    int nbytes;               /* number of bytes in the data type */
+    int tile_nlines;          /* number of lines in each input tile */
+    int tile_nsamps;          /* number of samples in each input tile */
+    int chunk_nlines;         /* number of lines in the chunk buffer */
+    int curr_nlines;          /* number of lines in the current chunk */
+    int chunk_line;           /* first line of the current chunk */
+    int row0;                 /* first mosaic line of the current tile */
+    int samp0;                /* first mosaic sample of the current tile */
+    int g;                    /* looping variable for granules */
+    int line;                 /* looping variable for the fill prefill */
+    int32 sd_id;              /* file ID for the current HDF file */
+    int32 sds_id;             /* SDS ID in the current HDF file */
+    int32 sds_index;          /* index of current SDS name */
+    int32 start[2];           /* starting point to read SDS data */
+    int32 edges[2];           /* number of values to read in SDS data */
+    int32 status;             /* return status of the HDF function */
+    void *file_buf = NULL;    /* chunk buffer for the current tile */
+    FILE *fp_rb = NULL;       /* file pointer for the raw binary file */
+    Modis_mosaic_pool_t *pool = ctx;  /* context for the mosaic */
+    Espa_band_meta_t *bmeta = &pool->mosaic->band[ib];  /* mosaic band */
+    Espa_global_meta_t *gmeta = &pool->mosaic->global;  /* mosaic global */
+    Espa_stat_accum_t stats;  /* running statistics accumulator */
+    Espa_band_kernels_t bkern;  /* resolved kernels for the band */
+
+    if (espa_stats_enabled ())
+        espa_stats_init (&stats);
+
+    /* Resolve the type-specialized kernels for the band once, so the chunk
+       loop below runs monomorphic loop bodies through the pointers instead
+       of re-branching on the data type for every chunk */
+    if (espa_valid_range_enforced () || espa_stats_enabled ())
+    {
+        if (espa_band_kernels_init (bmeta, &bkern) != SUCCESS)
+        {  /* Error messages already printed */
+            return (ERROR);
+        }
+    }
+
+    /* Determine the number of bytes in the data type */
+    if (bmeta->data_type == ESPA_UINT8 || bmeta->data_type == ESPA_INT8)
+        nbytes = sizeof (uint8);
+    else if (bmeta->data_type == ESPA_UINT16 ||
+        bmeta->data_type == ESPA_INT16)
+        nbytes = sizeof (uint16);
+    else if (bmeta->data_type == ESPA_UINT32 ||
+        bmeta->data_type == ESPA_INT32)
+        nbytes = sizeof (uint32);
+    else if (bmeta->data_type == ESPA_FLOAT32)
+        nbytes = sizeof (float32);
+    else if (bmeta->data_type == ESPA_FLOAT64)
+        nbytes = sizeof (float64);
+    else
+    {
+        sprintf (errmsg, "Unsupported data type %d.", bmeta->data_type);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* The mosaic dimensions are exact multiples of the tile dimensions */
+    tile_nlines = bmeta->nlines / pool->ntile_v;
+    tile_nsamps = bmeta->nsamps / pool->ntile_h;
+    printf ("  SDS %d: %s -- mosaic %d x %d from %d granules\n", ib,
+        bmeta->name, bmeta->nlines, bmeta->nsamps, pool->nfiles);
+
+    /* Open the raw binary file with plain buffered access; the granule
+       tiles are stitched in with windowed writes which need to seek */
+    fp_rb = open_raw_binary (bmeta->file_name, "wb");
+    if (fp_rb == NULL)
+    {
+        sprintf (errmsg, "Opening the output raw binary file: %.1024s",
+            bmeta->file_name);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* If the input granules don't cover the combined grid, prefill the
+       mosaic with the band fill value one line at a time so the gaps read
+       as fill */
+    if (pool->nfiles < pool->ntile_h * pool->ntile_v)
+    {
+        file_buf = espa_borrow_buffer ((size_t) bmeta->nsamps * nbytes);
+        if (file_buf == NULL)
+        {
+            sprintf (errmsg, "Allocating memory for a mosaic line of %d "
+                "samples.", bmeta->nsamps);
+            error_handler (true, FUNC_NAME, errmsg);
+            close_raw_binary (fp_rb);
+            return (ERROR);
+        }
+
+        if (set_fill_buffer (file_buf, bmeta->nsamps, bmeta->data_type,
+            bmeta->fill_value) != SUCCESS)
+        {  /* Error messages already printed */
+            espa_return_buffer (file_buf);
+            close_raw_binary (fp_rb);
+            return (ERROR);
+        }
+
+        for (line = 0; line < bmeta->nlines; line++)
+        {
+            if (write_raw_binary (fp_rb, 1, bmeta->nsamps, nbytes, file_buf)
+                != SUCCESS)
+            {
+                sprintf (errmsg, "Prefilling line %d of the raw binary "
+                    "file: %.1024s", line, bmeta->file_name);
+                error_handler (true, FUNC_NAME, errmsg);
+                espa_return_buffer (file_buf);
+                close_raw_binary (fp_rb);
+                return (ERROR);
+            }
+        }
+        espa_return_buffer (file_buf);
+    }
+
+    /* Allocate memory for a chunk of tile lines, bounding the memory used
+       per SDS regardless of the number of granules */
+    chunk_nlines = MODIS_HDF_CHUNK_BYTES / (tile_nsamps * nbytes);
+    if (chunk_nlines < 1)
+        chunk_nlines = 1;
+    if (chunk_nlines > tile_nlines)
+        chunk_nlines = tile_nlines;
+    file_buf = espa_borrow_buffer ((size_t) chunk_nlines * tile_nsamps *
+        nbytes);
+    if (file_buf == NULL)
+    {
+        sprintf (errmsg, "Allocating memory for a chunk of %d lines x %d "
+            "samples.", chunk_nlines, tile_nsamps);
+        error_handler (true, FUNC_NAME, errmsg);
+        close_raw_binary (fp_rb);
+        return (ERROR);
+    }
+
+    /* Stream each granule's tile into its window of the mosaic */
+    for (g = 0; g < pool->nfiles; g++)
+    {
+        row0 = (pool->granules[g].global.vtile - pool->vmin) * tile_nlines;
+        samp0 = (pool->granules[g].global.htile - pool->hmin) * tile_nsamps;
+
+        /* Open the granule and the current SDS; each task opens its own
+           HDF file handles since the HDF library handles are not shared
+           across threads */
+        sd_id = SDstart (pool->modis_hdf_files[g], DFACC_RDONLY);
+        if (sd_id < 0)
+        {
+            sprintf (errmsg, "Unable to open %s for reading",
+                pool->modis_hdf_files[g]);
+            error_handler (true, FUNC_NAME, errmsg);
+            espa_return_buffer (file_buf);
+            close_raw_binary (fp_rb);
+            return (ERROR);
+        }
+
+        sds_index = SDnametoindex (sd_id, bmeta->name);
+        if (sds_index == -1)
+        {
+            sprintf (errmsg, "Unable to find %.1024s in the HDF file: %s",
+                bmeta->name, pool->modis_hdf_files[g]);
+            error_handler (true, FUNC_NAME, errmsg);
+            SDend (sd_id);
+            espa_return_buffer (file_buf);
+            close_raw_binary (fp_rb);
+            return (ERROR);
+        }
+
+        sds_id = SDselect (sd_id, sds_index);
+        if (sds_id < 0)
+        {
+            sprintf (errmsg, "Unable to access %.1024s for reading", bmeta->name);
+            error_handler (true, FUNC_NAME, errmsg);
+            SDend (sd_id);
+            espa_return_buffer (file_buf);
+            close_raw_binary (fp_rb);
+            return (ERROR);
+        }
+
+        /* Loop through the chunks of lines in the tile, reading each chunk
+           as a hyperslab then writing it into the tile's window of the
+           mosaic and reusing the buffer for the next chunk */
+        for (chunk_line = 0; chunk_line < tile_nlines;
+             chunk_line += chunk_nlines)
+        {
+            /* Determine the number of lines in the current chunk; the last
+               chunk can be short */
+            curr_nlines = chunk_nlines;
+            if (chunk_line + curr_nlines > tile_nlines)
+                curr_nlines = tile_nlines - chunk_line;
+
+            /* Read the current chunk of lines from the SDS */
+            start[0] = chunk_line;
+            start[1] = 0;
+            edges[0] = curr_nlines;
+            edges[1] = tile_nsamps;
+            status = SDreaddata (sds_id, start, NULL, edges, file_buf);
+            if (status == -1)
+            {
+                sprintf (errmsg, "Reading data from the SDS: %.1024s",
+                    bmeta->name);
+                error_handler (true, FUNC_NAME, errmsg);
+                SDendaccess (sds_id);
+                SDend (sd_id);
+                espa_return_buffer (file_buf);
+                close_raw_binary (fp_rb);
+                return (ERROR);
+            }
+
+            /* Clamp the chunk to the valid range while it is still in
+               cache, if enforcement was requested */
+            if (espa_valid_range_enforced ())
+                espa_band_clamp (&bkern, file_buf,
+                    (long) curr_nlines * tile_nsamps);
+
+            /* Accumulate the band statistics while the chunk is still in
+               cache, if they were requested; the fill pixels of uncovered
+               tiles are skipped by the accumulator anyway, so accumulating
+               only the covered tiles gives the same result */
+            if (espa_stats_enabled ())
+                espa_band_stats (&bkern, file_buf,
+                    (long) curr_nlines * tile_nsamps, &stats);
+
+            /* Write the current chunk into the tile's window of the
+               mosaic */
+            if (write_raw_binary_window (fp_rb, row0 + chunk_line, samp0,
+                curr_nlines, tile_nsamps, bmeta->nsamps, nbytes, file_buf)
+                != SUCCESS)
+            {
+                sprintf (errmsg, "Writing tile window to the raw binary "
+                    "file: %.1024s", bmeta->file_name);
+                error_handler (true, FUNC_NAME, errmsg);
+                SDendaccess (sds_id);
+                SDend (sd_id);
+                espa_return_buffer (file_buf);
+                close_raw_binary (fp_rb);
+                return (ERROR);
+            }
+        }
+
+        /* Close the granule's SDS and HDF file */
+        status = SDendaccess (sds_id);
+        if (status == -1)
+        {
+            sprintf (errmsg, "Ending access to SDS: %.1024s", bmeta->name);
+            error_handler (true, FUNC_NAME, errmsg);
+            SDend (sd_id);
+            espa_return_buffer (file_buf);
+            close_raw_binary (fp_rb);
+            return (ERROR);
+        }
+        SDend (sd_id);
+    }
+
+    /* Store the accumulated statistics in the band metadata, from where
+       they are written to the XML */
+    if (espa_stats_enabled ())
+        espa_stats_finish (&stats, bmeta);
+
+    /* Close the raw binary file and free the chunk buffer */
+    close_raw_binary (fp_rb);
+    espa_return_buffer (file_buf);
+
+    /* Write the ENVI header for this band straight from the metadata */
+    count = snprintf (envi_file, sizeof (envi_file), "%s",
+        bmeta->file_name);
+    if (count < 0 || count >= sizeof (envi_file))
+    {
+        sprintf (errmsg, "Overflow of envi_file string");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+    cptr = strrchr (envi_file, '.');
+    strcpy (cptr, ".hdr");
+
+    if (write_envi_hdr_meta (envi_file, bmeta, gmeta) != SUCCESS)
+    {
+        sprintf (errmsg, "Writing the ENVI header file: %.1024s.", envi_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Successful conversion */
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  convert_modis_mosaic_to_espa
+
+PURPOSE: Converts multiple MODIS HDF granules from the same product into one
+combined ESPA internal raw binary mosaic (and associated XML file), using
+the htile/vtile numbers of the granules to place each tile in the combined
+grid.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error converting the MODIS files
+SUCCESS         Successfully converted MODIS to ESPA format
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Verify the granules share one projection
+
+NOTES:
+  1. All granules must come from the same product and acquisition, with
+     identical SDS lists, data types, and per-tile dimensions.
+  2. Each SDS is streamed tile-by-tile into the combined output, so the
+     memory used is bounded by one hyperslab chunk per thread regardless
+     of the mosaic size.
+  3. Tiles of the combined grid not covered by any input granule are
+     written as fill.
+******************************************************************************/
+int convert_modis_mosaic_to_espa
+(
+    char **modis_hdf_files, /* I: array of input MODIS HDF filenames */
+    int nfiles,            /* I: number of input MODIS HDF files */
+    char *espa_xml_file,   /* I: output ESPA XML metadata filename */
+    bool del_src,          /* I: should the source files be removed after
+                                 conversion? */
+    int num_threads        /* I: number of threads to use for converting the
+                                 SDSs; 1 or less converts serially */
+)
+{
+    char FUNC_NAME[] = "convert_modis_mosaic_to_espa";  /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    int i, ib;               /* looping variables */
+    int hmin, hmax;          /* horizontal tile range of the mosaic */
+    int vmin, vmax;          /* vertical tile range of the mosaic */
+    int ntile_h, ntile_v;    /* number of tile columns/rows in the mosaic */
+    Espa_internal_meta_t *granules = NULL;  /* per-granule metadata */
+    Espa_internal_meta_t *mosaic = NULL;    /* combined mosaic metadata;
+                                points at the first granule's metadata with
+                                the dimensions and corners scaled up */
+    Espa_global_meta_t *gmeta = NULL;   /* mosaic global metadata */
+    Espa_global_meta_t *ggmeta = NULL;  /* current granule global metadata */
+    Espa_band_meta_t *bmeta = NULL;     /* mosaic band metadata */
+    Modis_mosaic_pool_t pool;           /* context for the band tasks */
+
+    if (nfiles < 1)
+    {
+        sprintf (errmsg, "At least one input MODIS HDF file is required.");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Read the metadata from every granule */
+    granules = calloc (nfiles, sizeof (Espa_internal_meta_t));
+    if (granules == NULL)
+    {
+        sprintf (errmsg, "Allocating metadata for %d granules.", nfiles);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    for (i = 0; i < nfiles; i++)
+    {
+        init_metadata_struct (&granules[i]);
+        if (read_modis_hdf (modis_hdf_files[i], &granules[i]) != SUCCESS)
+        {
+            sprintf (errmsg, "Reading the MODIS HDF file: %s",
+                modis_hdf_files[i]);
+            error_handler (true, FUNC_NAME, errmsg);
+            free (granules);
+            return (ERROR);
+        }
+
+        if (granules[i].global.htile == ESPA_INT_META_FILL ||
+            granules[i].global.vtile == ESPA_INT_META_FILL)
+        {
+            sprintf (errmsg, "No htile/vtile in the granule filename: %s. "
+                "The mosaic placement requires tiled products.",
+                modis_hdf_files[i]);
+            error_handler (true, FUNC_NAME, errmsg);
+            free (granules);
+            return (ERROR);
+        }
+    }
+
+    /* Verify the granules all describe the same product */
+    for (i = 1; i < nfiles; i++)
+    {
+        if (granules[i].nbands != granules[0].nbands)
+        {
+            sprintf (errmsg, "Granule %s has %d SDSs vs. %d in %s. All "
+                "granules in the mosaic must come from the same product.",
+                modis_hdf_files[i], granules[i].nbands, granules[0].nbands,
+                modis_hdf_files[0]);
+            error_handler (true, FUNC_NAME, errmsg);
+            free (granules);
+            return (ERROR);
+        }
+
+        for (ib = 0; ib < granules[0].nbands; ib++)
+        {
+            if (strcmp (granules[i].band[ib].name,
+                    granules[0].band[ib].name) ||
+                granules[i].band[ib].data_type !=
+                    granules[0].band[ib].data_type ||
+                granules[i].band[ib].nlines != granules[0].band[ib].nlines ||
+                granules[i].band[ib].nsamps != granules[0].band[ib].nsamps)
+            {
+                sprintf (errmsg, "SDS %d differs between %s and %s. All "
+                    "granules in the mosaic must come from the same "
+                    "product.", ib, modis_hdf_files[i], modis_hdf_files[0]);
+                error_handler (true, FUNC_NAME, errmsg);
+                free (granules);
+                return (ERROR);
+            }
+        }
+    }
+
+    /* Determine the tile range of the combined grid and check that no two
+       granules land on the same tile */
+    hmin = hmax = granules[0].global.htile;
+    vmin = vmax = granules[0].global.vtile;
+    for (i = 1; i < nfiles; i++)
+    {
+        if (granules[i].global.htile < hmin)
+            hmin = granules[i].global.htile;
+        if (granules[i].global.htile > hmax)
+            hmax = granules[i].global.htile;
+        if (granules[i].global.vtile < vmin)
+            vmin = granules[i].global.vtile;
+        if (granules[i].global.vtile > vmax)
+            vmax = granules[i].global.vtile;
+
+        for (ib = 0; ib < i; ib++)
+        {
+            if (granules[i].global.htile == granules[ib].global.htile &&
+                granules[i].global.vtile == granules[ib].global.vtile)
+            {
+                sprintf (errmsg, "Granules %s and %s are both tile h%02dv"
+                    "%02d.", modis_hdf_files[ib], modis_hdf_files[i],
+                    granules[i].global.htile, granules[i].global.vtile);
+                error_handler (true, FUNC_NAME, errmsg);
+                free (granules);
+                return (ERROR);
+            }
+        }
+    }
+    ntile_h = hmax - hmin + 1;
+    ntile_v = vmax - vmin + 1;
+    printf ("Mosaicking %d granules into a %d x %d tile grid "
+        "(h%02d-h%02d, v%02d-v%02d)\n", nfiles, ntile_h, ntile_v, hmin,
+        hmax, vmin, vmax);
+
+    /* Build the mosaic metadata from the first granule by scaling the band
+       dimensions to the combined grid and expanding the corners over all
+       the granules */
+    mosaic = &granules[0];
+    gmeta = &mosaic->global;
+    for (ib = 0; ib < mosaic->nbands; ib++)
+    {
+        bmeta = &mosaic->band[ib];
+        bmeta->nlines *= ntile_v;
+        bmeta->nsamps *= ntile_h;
+    }
+
+    for (i = 1; i < nfiles; i++)
+    {
+        ggmeta = &granules[i].global;
+
+        /* All the granules must share the mosaic's coordinate reference
+           system; tiles of the same product always do, so this is just a
+           cheap guard against mixed inputs */
+        if (!same_projection (&ggmeta->proj_info, &gmeta->proj_info))
+        {
+            sprintf (errmsg, "Granule %s is not in the same projection as "
+                "%s.", modis_hdf_files[i], modis_hdf_files[0]);
+            error_handler (true, FUNC_NAME, errmsg);
+            free (granules);
+            return (ERROR);
+        }
+
+        /* Projection corners expand to the outermost tiles; taking the
+           min/max over the granules works for partially covered grids
+           since some granule sits on each extreme tile row and column */
+        if (ggmeta->proj_info.ul_corner[0] < gmeta->proj_info.ul_corner[0])
+            gmeta->proj_info.ul_corner[0] = ggmeta->proj_info.ul_corner[0];
+        if (ggmeta->proj_info.ul_corner[1] > gmeta->proj_info.ul_corner[1])
+            gmeta->proj_info.ul_corner[1] = ggmeta->proj_info.ul_corner[1];
+        if (ggmeta->proj_info.lr_corner[0] > gmeta->proj_info.lr_corner[0])
+            gmeta->proj_info.lr_corner[0] = ggmeta->proj_info.lr_corner[0];
+        if (ggmeta->proj_info.lr_corner[1] < gmeta->proj_info.lr_corner[1])
+            gmeta->proj_info.lr_corner[1] = ggmeta->proj_info.lr_corner[1];
+
+        /* Geographic corners and bounding coordinates likewise expand to
+           cover all the granules */
+        if (ggmeta->ul_corner[0] > gmeta->ul_corner[0])
+            gmeta->ul_corner[0] = ggmeta->ul_corner[0];
+        if (ggmeta->ul_corner[1] < gmeta->ul_corner[1])
+            gmeta->ul_corner[1] = ggmeta->ul_corner[1];
+        if (ggmeta->lr_corner[0] < gmeta->lr_corner[0])
+            gmeta->lr_corner[0] = ggmeta->lr_corner[0];
+        if (ggmeta->lr_corner[1] > gmeta->lr_corner[1])
+            gmeta->lr_corner[1] = ggmeta->lr_corner[1];
+
+        if (ggmeta->bounding_coords[ESPA_WEST] <
+            gmeta->bounding_coords[ESPA_WEST])
+            gmeta->bounding_coords[ESPA_WEST] =
+                ggmeta->bounding_coords[ESPA_WEST];
+        if (ggmeta->bounding_coords[ESPA_EAST] >
+            gmeta->bounding_coords[ESPA_EAST])
+            gmeta->bounding_coords[ESPA_EAST] =
+                ggmeta->bounding_coords[ESPA_EAST];
+        if (ggmeta->bounding_coords[ESPA_NORTH] >
+            gmeta->bounding_coords[ESPA_NORTH])
+            gmeta->bounding_coords[ESPA_NORTH] =
+                ggmeta->bounding_coords[ESPA_NORTH];
+        if (ggmeta->bounding_coords[ESPA_SOUTH] <
+            gmeta->bounding_coords[ESPA_SOUTH])
+            gmeta->bounding_coords[ESPA_SOUTH] =
+                ggmeta->bounding_coords[ESPA_SOUTH];
+    }
+
+    /* A mosaic spans multiple tiles, so the single tile numbers no longer
+       apply */
+    gmeta->htile = ESPA_INT_META_FILL;
+    gmeta->vtile = ESPA_INT_META_FILL;
+
+    /* Convert each of the SDSs to one combined raw binary file; the bands
+       are handed out to the worker pool */
+    pool.modis_hdf_files = modis_hdf_files;
+    pool.granules = granules;
+    pool.nfiles = nfiles;
+    pool.mosaic = mosaic;
+    pool.hmin = hmin;
+    pool.vmin = vmin;
+    pool.ntile_h = ntile_h;
+    pool.ntile_v = ntile_v;
+    if (espa_pool_run (convert_hdf_mosaic_band, &pool, mosaic->nbands,
+        num_threads) != SUCCESS)
+    {
+        sprintf (errmsg, "Converting the MODIS SDSs to the raw binary "
+            "mosaic");
+        error_handler (true, FUNC_NAME, errmsg);
+        free (granules);
+        return (ERROR);
+    }
+
+    /* Write the metadata from the mosaic metadata structure to the output
+       XML filename; the band statistics accumulated during the conversion
+       are written along with it */
+    if (write_metadata (mosaic, espa_xml_file) != SUCCESS)
+    {  /* Error messages already written */
+        free (granules);
+        return (ERROR);
+    }
+
+    /* Validate the output metadata file */
+    if (validate_xml_file (espa_xml_file) != SUCCESS)
+    {  /* Error messages already written */
+        free (granules);
+        return (ERROR);
+    }
+
+    /* Remove the source files if specified */
+    if (del_src)
+    {
+        for (i = 0; i < nfiles; i++)
+        {
+            printf ("  Removing %s\n", modis_hdf_files[i]);
+            if (unlink (modis_hdf_files[i]) != 0)
+            {
+                sprintf (errmsg, "Deleting source file: %s",
+                    modis_hdf_files[i]);
+                error_handler (true, FUNC_NAME, errmsg);
+                free (granules);
+                return (ERROR);
+            }
+        }
+    }
+
+    /* Free the metadata structures; the mosaic shares the first granule's
+       structure so it is freed with the granules */
+    for (i = 0; i < nfiles; i++)
+        free_metadata (&granules[i]);
+    free (granules);
+
+    /* Successful conversion */
+    return (SUCCESS);
+}
+
+
+/* Winner map sentinel for pixels where no granule had a valid candidate */
+#define COMPOSITE_NO_WINNER 255
+
+/* Context shared by the composite band conversion tasks; the band indices
+   are handed out by the shared worker pool */
+typedef struct
+{
+    char **modis_hdf_files;          /* names of the MODIS granule files */
+    Espa_internal_meta_t *granules;  /* per-granule metadata */
+    int nfiles;                      /* number of granule files */
+    Espa_internal_meta_t *composite; /* composite metadata; points at the
+                                        first granule's metadata */
+    const unsigned char *winner;     /* per-pixel winning granule index;
+                                        COMPOSITE_NO_WINNER marks pixels
+                                        with no valid candidate */
+    int map_nlines;                  /* number of lines in the winner map */
+    int map_nsamps;                  /* number of samples in the winner map */
+} Modis_composite_pool_t;
+
+/* Computes the per-pixel selection score for the composite engine from the
+   selection SDS value(s) of one granule; the granule with the highest score
+   wins the pixel.  Returns 0 if the pixel is not a valid candidate for this
+   granule.  New selection rules plug in as additional score functions. */
+typedef int (*Modis_composite_score_t)
+(
+    double value1,           /* I: value from the first selection SDS */
+    double value2,           /* I: value from the second selection SDS;
+                                   0.0 for single-SDS rules */
+    float *score             /* O: selection score of the pixel */
+);
+
+
+/******************************************************************************
+MODULE:  composite_type_nbytes (static)
+
+PURPOSE: Returns the number of bytes in one pixel of the specified ESPA data
+type.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+-1              Unsupported data type
+(other)         Number of bytes in the data type
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static int composite_type_nbytes
+(
+    int data_type            /* I: data type of the band (Espa_data_type) */
+)
+{
+    if (data_type == ESPA_UINT8 || data_type == ESPA_INT8)
+        return (sizeof (uint8));
+    else if (data_type == ESPA_UINT16 || data_type == ESPA_INT16)
+        return (sizeof (uint16));
+    else if (data_type == ESPA_UINT32 || data_type == ESPA_INT32)
+        return (sizeof (uint32));
+    else if (data_type == ESPA_FLOAT32)
+        return (sizeof (float32));
+    else if (data_type == ESPA_FLOAT64)
+        return (sizeof (float64));
+
+    return (-1);
+}
+
+
+/******************************************************************************
+MODULE:  pixel_as_double (static)
+
+PURPOSE: Returns the value of one pixel of a typed buffer as a double, for
+the per-pixel selection scoring of the composite engine.
+
+RETURN VALUE:
+Type = double
+Value of the pixel; 0.0 for an unsupported data type (the engine validates
+the selection SDS data types up front)
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static double pixel_as_double
+(
+    const void *buf,         /* I: typed buffer of pixel values */
+    long i,                  /* I: index of the pixel in the buffer */
+    int data_type            /* I: data type of the buffer (Espa_data_type) */
+)
+{
+    switch (data_type)
+    {
+        case ESPA_UINT8:
+            return ((double) ((const uint8 *) buf)[i]);
+        case ESPA_INT8:
+            return ((double) ((const int8 *) buf)[i]);
+        case ESPA_UINT16:
+            return ((double) ((const uint16 *) buf)[i]);
+        case ESPA_INT16:
+            return ((double) ((const int16 *) buf)[i]);
+        case ESPA_UINT32:
+            return ((double) ((const uint32 *) buf)[i]);
+        case ESPA_INT32:
+            return ((double) ((const int32 *) buf)[i]);
+        case ESPA_FLOAT32:
+            return ((double) ((const float32 *) buf)[i]);
+        case ESPA_FLOAT64:
+            return ((double) ((const float64 *) buf)[i]);
+    }
+
+    return (0.0);
+}
+
+
+/******************************************************************************
+MODULE:  composite_score_qa_priority (static)
+
+PURPOSE: Selection score for the QA-priority compositing rule.  The QA SDS
+value is negated so that the lowest QA value (the cleanest observation in
+the MODIS QA conventions) produces the highest score.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+0               Pixel is not a valid candidate
+1               Score was computed
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static int composite_score_qa_priority
+(
+    double value1,           /* I: value from the QA SDS */
+    double value2,           /* I: unused for this rule */
+    float *score             /* O: selection score of the pixel */
+)
+{
+    (void) value2;
+    *score = (float) (-value1);
+    return (1);
+}
+
+
+/******************************************************************************
+MODULE:  composite_score_max_ndvi (static)
+
+PURPOSE: Selection score for the maximum-NDVI compositing rule, computed
+from the red and NIR reflectance SDSs.  The scale factors cancel in the
+normalized difference, so the raw SDS values are used directly.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+0               Pixel is not a valid candidate (red + NIR is zero)
+1               Score was computed
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static int composite_score_max_ndvi
+(
+    double value1,           /* I: value from the red SDS */
+    double value2,           /* I: value from the NIR SDS */
+    float *score             /* O: selection score of the pixel */
+)
+{
+    double sum = value1 + value2;  /* denominator of the NDVI */
+
+    if (sum == 0.0)
+        return (0);
+
+    *score = (float) ((value2 - value1) / sum);
+    return (1);
+}
+
+
+/******************************************************************************
+MODULE:  build_composite_index (static)
+
+PURPOSE: Builds the per-pixel winner map for the composite by streaming the
+selection SDS(s) of every granule chunk-by-chunk and keeping, for each
+pixel, the index of the granule with the best selection score so far.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error reading the selection SDSs
+SUCCESS         Winner map was built
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The memory used is the winner map plus a float score per map pixel
+     plus one hyperslab chunk per selection SDS, regardless of the number
+     of granules.
+  2. Score ties keep the earliest granule in the input list, so the result
+     is deterministic for any input order.
+******************************************************************************/
+static int build_composite_index
+(
+    char **modis_hdf_files,  /* I: array of input MODIS HDF filenames */
+    Espa_internal_meta_t *granules,  /* I: per-granule metadata */
+    int nfiles,              /* I: number of input MODIS HDF files */
+    int isel1,               /* I: band index of the first selection SDS */
+    int isel2,               /* I: band index of the second selection SDS;
+                                   -1 for single-SDS rules */
+    Modis_composite_score_t score_func,  /* I: selection score function */
+    unsigned char *winner    /* O: per-pixel winning granule index;
+                                   COMPOSITE_NO_WINNER for pixels with no
+                                   valid candidate */
+)
+{
+    char FUNC_NAME[] = "build_composite_index";  /* function name */
+    char errmsg[STR_SIZE];    /* error message */
+    int map_nlines;           /* number of lines in the winner map */
+    int map_nsamps;           /* number of samples in the winner map */
+    int nbytes1;              /* bytes per pixel of the first SDS */
+    int nbytes2;              /* bytes per pixel of the second SDS */
+    int chunk_nlines;         /* number of lines in the chunk buffers */
+    int curr_nlines;          /* number of lines in the current chunk */
+    int chunk_line;           /* first line of the current chunk */
+    int g;                    /* looping variable for granules */
+    long i;                   /* looping variable for chunk pixels */
+    long pix;                 /* pixel index in the winner map */
+    double value1;            /* pixel value from the first SDS */
+    double value2;            /* pixel value from the second SDS */
+    float score;              /* selection score of the pixel */
+    float *best = NULL;       /* best score seen so far for each pixel */
+    void *buf1 = NULL;        /* chunk buffer for the first SDS */
+    void *buf2 = NULL;        /* chunk buffer for the second SDS */
+    int32 sd_id;              /* file ID for the current HDF file */
+    int32 sds1_id;            /* first selection SDS ID */
+    int32 sds2_id;            /* second selection SDS ID */
+    int32 sds_index;          /* index of current SDS name */
+    int32 start[2];           /* starting point to read SDS data */
+    int32 edges[2];           /* number of values to read in SDS data */
+    Espa_band_meta_t *sel1 = &granules[0].band[isel1];  /* first SDS meta */
+    Espa_band_meta_t *sel2 = NULL;  /* second SDS metadata */
+
+    map_nlines = sel1->nlines;
+    map_nsamps = sel1->nsamps;
+    nbytes1 = composite_type_nbytes (sel1->data_type);
+    nbytes2 = 0;
+    if (isel2 >= 0)
+    {
+        sel2 = &granules[0].band[isel2];
+        nbytes2 = composite_type_nbytes (sel2->data_type);
+    }
+
+    /* No granule has won any pixel yet */
+    memset (winner, COMPOSITE_NO_WINNER, (size_t) map_nlines * map_nsamps);
+
+    /* Track the best score seen so far for each pixel; the winner map
+       sentinel marks the pixels where no score has been stored yet */
+    best = malloc ((size_t) map_nlines * map_nsamps * sizeof (float));
+    if (best == NULL)
+    {
+        sprintf (errmsg, "Allocating memory for the %d x %d selection "
+            "score map.", map_nlines, map_nsamps);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Allocate memory for a chunk of lines per selection SDS, bounding
+       the memory used regardless of the grid size */
+    chunk_nlines = MODIS_HDF_CHUNK_BYTES / (map_nsamps *
+        (nbytes1 + nbytes2));
+    if (chunk_nlines < 1)
+        chunk_nlines = 1;
+    if (chunk_nlines > map_nlines)
+        chunk_nlines = map_nlines;
+    buf1 = espa_borrow_buffer ((size_t) chunk_nlines * map_nsamps *
+        nbytes1);
+    if (buf1 == NULL)
+    {
+        sprintf (errmsg, "Allocating memory for a chunk of %d lines x %d "
+            "samples.", chunk_nlines, map_nsamps);
+        error_handler (true, FUNC_NAME, errmsg);
+        free (best);
+        return (ERROR);
+    }
+    if (isel2 >= 0)
+    {
+        buf2 = espa_borrow_buffer ((size_t) chunk_nlines * map_nsamps *
+            nbytes2);
+        if (buf2 == NULL)
+        {
+            sprintf (errmsg, "Allocating memory for a chunk of %d lines x "
+                "%d samples.", chunk_nlines, map_nsamps);
+            error_handler (true, FUNC_NAME, errmsg);
+            espa_return_buffer (buf1);
+            free (best);
+            return (ERROR);
+        }
+    }
+
+    /* Stream the selection SDS(s) of each granule through the chunk
+       buffers, scoring every valid pixel against the best seen so far */
+    for (g = 0; g < nfiles; g++)
+    {
+        /* Open the granule and the selection SDS(s) */
+        sd_id = SDstart (modis_hdf_files[g], DFACC_RDONLY);
+        if (sd_id < 0)
+        {
+            sprintf (errmsg, "Unable to open %s for reading",
+                modis_hdf_files[g]);
+            error_handler (true, FUNC_NAME, errmsg);
+            if (buf2)
+                espa_return_buffer (buf2);
+            espa_return_buffer (buf1);
+            free (best);
+            return (ERROR);
+        }
+
+        sds_index = SDnametoindex (sd_id, sel1->name);
+        if (sds_index == -1)
+        {
+            sprintf (errmsg, "Unable to find %.1024s in the HDF file: %s",
+                sel1->name, modis_hdf_files[g]);
+            error_handler (true, FUNC_NAME, errmsg);
+            SDend (sd_id);
+            if (buf2)
+                espa_return_buffer (buf2);
+            espa_return_buffer (buf1);
+            free (best);
+            return (ERROR);
+        }
+
+        sds1_id = SDselect (sd_id, sds_index);
+        if (sds1_id < 0)
+        {
+            sprintf (errmsg, "Unable to access %.1024s for reading", sel1->name);
+            error_handler (true, FUNC_NAME, errmsg);
+            SDend (sd_id);
+            if (buf2)
+                espa_return_buffer (buf2);
+            espa_return_buffer (buf1);
+            free (best);
+            return (ERROR);
+        }
+
+        sds2_id = -1;
+        if (isel2 >= 0)
+        {
+            sds_index = SDnametoindex (sd_id, sel2->name);
+            if (sds_index == -1)
+            {
+                sprintf (errmsg, "Unable to find %.1024s in the HDF file: %s",
+                    sel2->name, modis_hdf_files[g]);
+                error_handler (true, FUNC_NAME, errmsg);
+                SDendaccess (sds1_id);
+                SDend (sd_id);
+                espa_return_buffer (buf2);
+                espa_return_buffer (buf1);
+                free (best);
+                return (ERROR);
+            }
+
+            sds2_id = SDselect (sd_id, sds_index);
+            if (sds2_id < 0)
+            {
+                sprintf (errmsg, "Unable to access %.1024s for reading",
+                    sel2->name);
+                error_handler (true, FUNC_NAME, errmsg);
+                SDendaccess (sds1_id);
+                SDend (sd_id);
+                espa_return_buffer (buf2);
+                espa_return_buffer (buf1);
+                free (best);
+                return (ERROR);
+            }
+        }
+
+        /* Loop through the chunks of lines in the selection SDS(s),
+           scoring each chunk while it is still in cache */
+        for (chunk_line = 0; chunk_line < map_nlines;
+             chunk_line += chunk_nlines)
+        {
+            /* Determine the number of lines in the current chunk; the
+               last chunk can be short */
+            curr_nlines = chunk_nlines;
+            if (chunk_line + curr_nlines > map_nlines)
+                curr_nlines = map_nlines - chunk_line;
+
+            /* Read the current chunk of lines from the selection SDS(s) */
+            start[0] = chunk_line;
+            start[1] = 0;
+            edges[0] = curr_nlines;
+            edges[1] = map_nsamps;
+            if (SDreaddata (sds1_id, start, NULL, edges, buf1) == -1 ||
+                (isel2 >= 0 &&
+                 SDreaddata (sds2_id, start, NULL, edges, buf2) == -1))
+            {
+                sprintf (errmsg, "Reading the selection data from the "
+                    "HDF file: %s", modis_hdf_files[g]);
+                error_handler (true, FUNC_NAME, errmsg);
+                if (sds2_id >= 0)
+                    SDendaccess (sds2_id);
+                SDendaccess (sds1_id);
+                SDend (sd_id);
+                if (buf2)
+                    espa_return_buffer (buf2);
+                espa_return_buffer (buf1);
+                free (best);
+                return (ERROR);
+            }
+
+            /* Score every valid pixel of the chunk; fill pixels in any of
+               the selection SDSs are not candidates */
+            for (i = 0; i < (long) curr_nlines * map_nsamps; i++)
+            {
+                value1 = pixel_as_double (buf1, i, sel1->data_type);
+                if (value1 == (double) sel1->fill_value)
+                    continue;
+
+                value2 = 0.0;
+                if (isel2 >= 0)
+                {
+                    value2 = pixel_as_double (buf2, i, sel2->data_type);
+                    if (value2 == (double) sel2->fill_value)
+                        continue;
+                }
+
+                if (!score_func (value1, value2, &score))
+                    continue;
+
+                pix = (long) chunk_line * map_nsamps + i;
+                if (winner[pix] == COMPOSITE_NO_WINNER ||
+                    score > best[pix])
+                {
+                    best[pix] = score;
+                    winner[pix] = (unsigned char) g;
+                }
+            }
+        }
+
+        /* Close the granule's SDS(s) and HDF file */
+        if (sds2_id >= 0)
+            SDendaccess (sds2_id);
+        SDendaccess (sds1_id);
+        SDend (sd_id);
+    }
+
+    /* Free the score map and the chunk buffers */
+    if (buf2)
+        espa_return_buffer (buf2);
+    espa_return_buffer (buf1);
+    free (best);
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  convert_hdf_composite_band (static)
+
+PURPOSE: Converts a single SDS from every input granule into one composited
+raw binary (.img) file by gathering each pixel from the granule selected in
+the winner map, and writes the associated ENVI header.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error converting the MODIS SDS
+SUCCESS         Successfully converted MODIS SDS to raw binary
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The memory used is two hyperslab chunks (one input, one output),
+     regardless of the number of granules.
+  2. Pixels where no granule had a valid candidate are written as fill.
+  3. SDSs whose dimensions differ from the winner map (mixed-resolution
+     products) are gathered through a nearest-neighbor mapping into the
+     winner map, which is exact when the dimensions are integer multiples.
+******************************************************************************/
+static int convert_hdf_composite_band
+(
+    void *ctx,                 /* I: Modis_composite_pool_t context */
+    int ib                     /* I: band index in the composite metadata */
+)
+{
+    char FUNC_NAME[] = "convert_hdf_composite_band";  /* function name */
+    char errmsg[STR_SIZE];    /* error message */
+    char *cptr = NULL;        /* pointer to the file extension */
+    char envi_file[STR_SIZE]; /* name of the output ENVI header file */
+    int count;                /* number of chars copied in snprintf */
+    int nbytes;               /* number of bytes in the data type */
+    int chunk_nlines;         /* number of lines in the chunk buffers */
+    int curr_nlines;          /* number of lines in the current chunk */
+    int chunk_line;           /* first line of the current chunk */
+    int direct;               /* band dimensions match the winner map? */
+    int g;                    /* looping variable for granules */
+    int line;                 /* looping variable for chunk lines */
+    int samp;                 /* looping variable for samples */
+    int map_samp;             /* sample index in the winner map */
+    long off;                 /* byte offset of the pixel in the chunk */
+    const unsigned char *map_row = NULL;  /* winner map line for the
+                                             current output line */
+    int32 *sd_ids = NULL;     /* file IDs for the granule HDF files */
+    int32 *sds_ids = NULL;    /* SDS IDs in the granule HDF files */
+    int32 sds_index;          /* index of current SDS name */
+    int32 start[2];           /* starting point to read SDS data */
+    int32 edges[2];           /* number of values to read in SDS data */
+    void *file_buf = NULL;    /* chunk buffer for the granule reads */
+    void *out_buf = NULL;     /* chunk buffer for the composited output */
+    FILE *fp_rb = NULL;       /* file pointer for the raw binary file */
+    Modis_composite_pool_t *pool = ctx;  /* context for the composite */
+    Espa_band_meta_t *bmeta = &pool->composite->band[ib];  /* band meta */
+    Espa_global_meta_t *gmeta = &pool->composite->global;  /* global meta */
+    Espa_stat_accum_t stats;  /* running statistics accumulator */
+    Espa_band_kernels_t bkern;  /* resolved kernels for the band */
+
+    if (espa_stats_enabled ())
+        espa_stats_init (&stats);
+
+    /* Resolve the type-specialized kernels for the band once, so the chunk
+       loop below runs monomorphic loop bodies through the pointers instead
+       of re-branching on the data type for every chunk */
+    if (espa_valid_range_enforced () || espa_stats_enabled ())
+    {
+        if (espa_band_kernels_init (bmeta, &bkern) != SUCCESS)
+        {  /* Error messages already printed */
+            return (ERROR);
+        }
+    }
+
+    /* Determine the number of bytes in the data type */
+    nbytes = composite_type_nbytes (bmeta->data_type);
+    if (nbytes < 0)
+    {
+        sprintf (errmsg, "Unsupported data type %d.", bmeta->data_type);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    direct = (bmeta->nlines == pool->map_nlines &&
+        bmeta->nsamps == pool->map_nsamps);
+    printf ("  SDS %d: %s -- composite of %d granules\n", ib, bmeta->name,
+        pool->nfiles);
+
+    /* Open the raw binary file through the negotiated output sink; the
+       composited chunks are written sequentially so the direct and
+       compressed sinks both apply */
+    fp_rb = open_raw_binary_band (bmeta->file_name, bmeta->nlines,
+        bmeta->nsamps, nbytes, "wbd");
+    if (fp_rb == NULL)
+    {
+        sprintf (errmsg, "Opening the output raw binary file: %.1024s",
+            bmeta->file_name);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Allocate memory for an input and an output chunk of lines, bounding
+       the memory used per SDS regardless of the number of granules */
+    chunk_nlines = MODIS_HDF_CHUNK_BYTES / (bmeta->nsamps * nbytes);
+    if (chunk_nlines < 1)
+        chunk_nlines = 1;
+    if (chunk_nlines > bmeta->nlines)
+        chunk_nlines = bmeta->nlines;
+    file_buf = espa_borrow_buffer ((size_t) chunk_nlines * bmeta->nsamps *
+        nbytes);
+    out_buf = espa_borrow_buffer ((size_t) chunk_nlines * bmeta->nsamps *
+        nbytes);
+    if (file_buf == NULL || out_buf == NULL)
+    {
+        sprintf (errmsg, "Allocating memory for two chunks of %d lines x "
+            "%d samples.", chunk_nlines, bmeta->nsamps);
+        error_handler (true, FUNC_NAME, errmsg);
+        if (out_buf)
+            espa_return_buffer (out_buf);
+        if (file_buf)
+            espa_return_buffer (file_buf);
+        close_raw_binary (fp_rb);
+        return (ERROR);
+    }
+
+    /* Open this SDS in every granule up front; each task opens its own
+       HDF file handles since the HDF library handles are not shared
+       across threads */
+    sd_ids = malloc (pool->nfiles * sizeof (int32));
+    sds_ids = malloc (pool->nfiles * sizeof (int32));
+    if (sd_ids == NULL || sds_ids == NULL)
+    {
+        sprintf (errmsg, "Allocating memory for %d HDF file handles.",
+            pool->nfiles);
+        error_handler (true, FUNC_NAME, errmsg);
+        free (sds_ids);
+        free (sd_ids);
+        espa_return_buffer (out_buf);
+        espa_return_buffer (file_buf);
+        close_raw_binary (fp_rb);
+        return (ERROR);
+    }
+    for (g = 0; g < pool->nfiles; g++)
+    {
+        sd_ids[g] = -1;
+        sds_ids[g] = -1;
+    }
+
+    for (g = 0; g < pool->nfiles; g++)
+    {
+        sd_ids[g] = SDstart (pool->modis_hdf_files[g], DFACC_RDONLY);
+        if (sd_ids[g] < 0)
+        {
+            sprintf (errmsg, "Unable to open %s for reading",
+                pool->modis_hdf_files[g]);
+            error_handler (true, FUNC_NAME, errmsg);
+            break;
+        }
+
+        sds_index = SDnametoindex (sd_ids[g], bmeta->name);
+        if (sds_index == -1)
+        {
+            sprintf (errmsg, "Unable to find %.1024s in the HDF file: %s",
+                bmeta->name, pool->modis_hdf_files[g]);
+            error_handler (true, FUNC_NAME, errmsg);
+            break;
+        }
+
+        sds_ids[g] = SDselect (sd_ids[g], sds_index);
+        if (sds_ids[g] < 0)
+        {
+            sprintf (errmsg, "Unable to access %.1024s for reading",
+                bmeta->name);
+            error_handler (true, FUNC_NAME, errmsg);
+            break;
+        }
+    }
+
+    if (g < pool->nfiles)
+    {  /* One of the opens above failed; error message already printed */
+        for (g = 0; g < pool->nfiles; g++)
+        {
+            if (sds_ids[g] >= 0)
+                SDendaccess (sds_ids[g]);
+            if (sd_ids[g] >= 0)
+                SDend (sd_ids[g]);
+        }
+        free (sds_ids);
+        free (sd_ids);
+        espa_return_buffer (out_buf);
+        espa_return_buffer (file_buf);
+        close_raw_binary (fp_rb);
+        return (ERROR);
+    }
+
+    /* Loop through the chunks of lines in the SDS, gathering each output
+       pixel from the granule selected in the winner map and writing the
+       composited chunk before reusing the buffers for the next one */
+    for (chunk_line = 0; chunk_line < bmeta->nlines;
+         chunk_line += chunk_nlines)
+    {
+        /* Determine the number of lines in the current chunk; the last
+           chunk can be short */
+        curr_nlines = chunk_nlines;
+        if (chunk_line + curr_nlines > bmeta->nlines)
+            curr_nlines = bmeta->nlines - chunk_line;
+
+        /* Pixels no granule won read as fill */
+        if (set_fill_buffer (out_buf, (long) curr_nlines * bmeta->nsamps,
+            bmeta->data_type, bmeta->fill_value) != SUCCESS)
+        {  /* Error messages already printed */
+            for (g = 0; g < pool->nfiles; g++)
+            {
+                SDendaccess (sds_ids[g]);
+                SDend (sd_ids[g]);
+            }
+            free (sds_ids);
+            free (sd_ids);
+            espa_return_buffer (out_buf);
+            espa_return_buffer (file_buf);
+            close_raw_binary (fp_rb);
+            return (ERROR);
+        }
+
+        for (g = 0; g < pool->nfiles; g++)
+        {
+            /* Read the current chunk of lines from the granule's SDS */
+            start[0] = chunk_line;
+            start[1] = 0;
+            edges[0] = curr_nlines;
+            edges[1] = bmeta->nsamps;
+            if (SDreaddata (sds_ids[g], start, NULL, edges, file_buf)
+                == -1)
+            {
+                sprintf (errmsg, "Reading data from the SDS: %.1024s in %s",
+                    bmeta->name, pool->modis_hdf_files[g]);
+                error_handler (true, FUNC_NAME, errmsg);
+                for (g = 0; g < pool->nfiles; g++)
+                {
+                    SDendaccess (sds_ids[g]);
+                    SDend (sd_ids[g]);
+                }
+                free (sds_ids);
+                free (sd_ids);
+                espa_return_buffer (out_buf);
+                espa_return_buffer (file_buf);
+                close_raw_binary (fp_rb);
+                return (ERROR);
+            }
+
+            /* Gather the pixels this granule won into the output chunk */
+            for (line = 0; line < curr_nlines; line++)
+            {
+                if (direct)
+                    map_row = &pool->winner[(long) (chunk_line + line) *
+                        pool->map_nsamps];
+                else
+                    map_row = &pool->winner[((long) (chunk_line + line) *
+                        pool->map_nlines / bmeta->nlines) *
+                        pool->map_nsamps];
+
+                for (samp = 0; samp < bmeta->nsamps; samp++)
+                {
+                    if (direct)
+                        map_samp = samp;
+                    else
+                        map_samp = (int) ((long) samp * pool->map_nsamps /
+                            bmeta->nsamps);
+                    if (map_row[map_samp] != g)
+                        continue;
+
+                    off = ((long) line * bmeta->nsamps + samp) * nbytes;
+                    memcpy ((char *) out_buf + off,
+                        (char *) file_buf + off, nbytes);
+                }
+            }
+        }
+
+        /* Clamp the composited chunk to the valid range while it is still
+           in cache, if enforcement was requested */
+        if (espa_valid_range_enforced ())
+            espa_band_clamp (&bkern, out_buf,
+                (long) curr_nlines * bmeta->nsamps);
+
+        /* Accumulate the band statistics while the chunk is still in
+           cache, if they were requested */
+        if (espa_stats_enabled ())
+            espa_band_stats (&bkern, out_buf,
+                (long) curr_nlines * bmeta->nsamps, &stats);
+
+        /* Write the composited chunk to the raw binary file */
+        if (write_raw_binary (fp_rb, curr_nlines, bmeta->nsamps, nbytes,
+            out_buf) != SUCCESS)
+        {
+            sprintf (errmsg, "Writing %d lines to the raw binary file: %.1024s",
+                curr_nlines, bmeta->file_name);
+            error_handler (true, FUNC_NAME, errmsg);
+            for (g = 0; g < pool->nfiles; g++)
+            {
+                SDendaccess (sds_ids[g]);
+                SDend (sd_ids[g]);
+            }
+            free (sds_ids);
+            free (sd_ids);
+            espa_return_buffer (out_buf);
+            espa_return_buffer (file_buf);
+            close_raw_binary (fp_rb);
+            return (ERROR);
+        }
+    }
+
+    /* Close the granule SDSs and HDF files */
+    for (g = 0; g < pool->nfiles; g++)
+    {
+        SDendaccess (sds_ids[g]);
+        SDend (sd_ids[g]);
+    }
+    free (sds_ids);
+    free (sd_ids);
+
+    /* Store the accumulated statistics in the band metadata, from where
+       they are written to the XML */
+    if (espa_stats_enabled ())
+        espa_stats_finish (&stats, bmeta);
+
+    /* Close the raw binary file and free the chunk buffers */
+    close_raw_binary (fp_rb);
+    espa_return_buffer (out_buf);
+    espa_return_buffer (file_buf);
+
+    /* Write the ENVI header for this band straight from the metadata */
+    count = snprintf (envi_file, sizeof (envi_file), "%s",
+        bmeta->file_name);
+    if (count < 0 || count >= sizeof (envi_file))
+    {
+        sprintf (errmsg, "Overflow of envi_file string");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+    cptr = strrchr (envi_file, '.');
+    strcpy (cptr, ".hdr");
+
+    if (write_envi_hdr_meta (envi_file, bmeta, gmeta) != SUCCESS)
+    {
+        sprintf (errmsg, "Writing the ENVI header file: %.1024s.", envi_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Successful conversion */
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  convert_modis_composite_to_espa
+
+PURPOSE: Composites multiple MODIS HDF granules covering the same grid into
+one ESPA internal raw binary product (and associated XML file), selecting
+each pixel from the granule with the best selection score (lowest QA value
+or highest NDVI, depending on the rule).
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error converting the MODIS files
+SUCCESS         Successfully converted MODIS to ESPA format
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. All granules must come from the same product and cover the same grid,
+     with identical SDS lists, data types, dimensions, and projections
+     (e.g. the observations of one tile over a compositing period).
+  2. The selection SDS(s) are streamed once up front to build a per-pixel
+     winner map, then every SDS is streamed through the map, so the memory
+     used is bounded by the winner map (five bytes per map pixel while it
+     is built, one byte afterwards) plus two hyperslab chunks per thread,
+     regardless of the number of granules.
+  3. Pixels where no granule has a valid (non-fill) selection value are
+     written as fill in every band.
+  4. The composited bands take their file names from the first granule's
+     metadata.
+******************************************************************************/
+int convert_modis_composite_to_espa
+(
+    char **modis_hdf_files, /* I: array of input MODIS HDF filenames */
+    int nfiles,            /* I: number of input MODIS HDF files */
+    char *espa_xml_file,   /* I: output ESPA XML metadata filename */
+    Modis_composite_rule_t rule,  /* I: per-pixel selection rule */
+    char *select_sds1,     /* I: name of the QA SDS for the QA-priority
+                                 rule, or of the red reflectance SDS for
+                                 the max-NDVI rule */
+    char *select_sds2,     /* I: name of the NIR reflectance SDS for the
+                                 max-NDVI rule; unused by the QA-priority
+                                 rule */
+    bool del_src,          /* I: should the source files be removed after
+                                 conversion? */
+    int num_threads        /* I: number of threads to use for converting the
+                                 SDSs; 1 or less converts serially */
+)
+{
+    char FUNC_NAME[] = "convert_modis_composite_to_espa";  /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    int i, ib;               /* looping variables */
+    int isel1;               /* band index of the first selection SDS */
+    int isel2;               /* band index of the second selection SDS */
+    unsigned char *winner = NULL;  /* per-pixel winning granule index */
+    Espa_internal_meta_t *granules = NULL;  /* per-granule metadata */
+    Espa_internal_meta_t *composite = NULL; /* composite metadata; points
+                                at the first granule's metadata */
+    Espa_global_meta_t *gmeta = NULL;   /* composite global metadata */
+    Espa_global_meta_t *ggmeta = NULL;  /* current granule global metadata */
+    Modis_composite_score_t score_func = NULL;  /* selection score function */
+    Modis_composite_pool_t pool;        /* context for the band tasks */
+
+    if (nfiles < 1)
+    {
+        sprintf (errmsg, "At least one input MODIS HDF file is required.");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+    if (nfiles > COMPOSITE_NO_WINNER)
+    {
+        sprintf (errmsg, "At most %d granules can be composited; the "
+            "winner map stores the granule index in one byte.",
+            COMPOSITE_NO_WINNER);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+    if (select_sds1 == NULL ||
+        (rule == MODIS_COMPOSITE_MAX_NDVI && select_sds2 == NULL))
+    {
+        sprintf (errmsg, "The selection SDS name(s) for the compositing "
+            "rule must be provided.");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    switch (rule)
+    {
+        case MODIS_COMPOSITE_QA_PRIORITY:
+            score_func = composite_score_qa_priority;
+            break;
+        case MODIS_COMPOSITE_MAX_NDVI:
+            score_func = composite_score_max_ndvi;
+            break;
+        default:
+            sprintf (errmsg, "Unsupported compositing rule %d.", rule);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+    }
+
+    /* Read the metadata from every granule */
+    granules = calloc (nfiles, sizeof (Espa_internal_meta_t));
+    if (granules == NULL)
+    {
+        sprintf (errmsg, "Allocating metadata for %d granules.", nfiles);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    for (i = 0; i < nfiles; i++)
+    {
+        init_metadata_struct (&granules[i]);
+        if (read_modis_hdf (modis_hdf_files[i], &granules[i]) != SUCCESS)
+        {
+            sprintf (errmsg, "Reading the MODIS HDF file: %s",
+                modis_hdf_files[i]);
+            error_handler (true, FUNC_NAME, errmsg);
+            free (granules);
+            return (ERROR);
+        }
+    }
+
+    /* Verify the granules all describe the same product on the same grid;
+       every band of every granule must line up pixel-for-pixel for the
+       winner map to apply across the granules */
+    gmeta = &granules[0].global;
+    for (i = 1; i < nfiles; i++)
+    {
+        ggmeta = &granules[i].global;
+
+        if (granules[i].nbands != granules[0].nbands)
+        {
+            sprintf (errmsg, "Granule %s has %d SDSs vs. %d in %s. All "
+                "granules in the composite must come from the same "
+                "product.", modis_hdf_files[i], granules[i].nbands,
+                granules[0].nbands, modis_hdf_files[0]);
+            error_handler (true, FUNC_NAME, errmsg);
+            free (granules);
+            return (ERROR);
+        }
+
+        if (!same_projection (&ggmeta->proj_info, &gmeta->proj_info) ||
+            ggmeta->proj_info.ul_corner[0] !=
+                gmeta->proj_info.ul_corner[0] ||
+            ggmeta->proj_info.ul_corner[1] !=
+                gmeta->proj_info.ul_corner[1])
+        {
+            sprintf (errmsg, "Granule %s does not cover the same grid as "
+                "%s. All granules in the composite must cover the same "
+                "grid.", modis_hdf_files[i], modis_hdf_files[0]);
+            error_handler (true, FUNC_NAME, errmsg);
+            free (granules);
+            return (ERROR);
+        }
+
+        for (ib = 0; ib < granules[0].nbands; ib++)
+        {
+            if (strcmp (granules[i].band[ib].name,
+                    granules[0].band[ib].name) ||
+                granules[i].band[ib].data_type !=
+                    granules[0].band[ib].data_type ||
+                granules[i].band[ib].nlines != granules[0].band[ib].nlines ||
+                granules[i].band[ib].nsamps != granules[0].band[ib].nsamps)
+            {
+                sprintf (errmsg, "SDS %d differs between %s and %s. All "
+                    "granules in the composite must come from the same "
+                    "product.", ib, modis_hdf_files[i], modis_hdf_files[0]);
+                error_handler (true, FUNC_NAME, errmsg);
+                free (granules);
+                return (ERROR);
+            }
+        }
+    }
+
+    /* Find the selection SDS(s) in the band list */
+    composite = &granules[0];
+    isel1 = -1;
+    isel2 = -1;
+    for (ib = 0; ib < composite->nbands; ib++)
+    {
+        if (!strcmp (composite->band[ib].name, select_sds1))
+            isel1 = ib;
+        if (rule == MODIS_COMPOSITE_MAX_NDVI &&
+            !strcmp (composite->band[ib].name, select_sds2))
+            isel2 = ib;
+    }
+    if (isel1 == -1 ||
+        (rule == MODIS_COMPOSITE_MAX_NDVI && isel2 == -1))
+    {
+        sprintf (errmsg, "The selection SDS(s) %s%s%s were not found in "
+            "the granules.", select_sds1,
+            rule == MODIS_COMPOSITE_MAX_NDVI ? ", " : "",
+            rule == MODIS_COMPOSITE_MAX_NDVI ? select_sds2 : "");
+        error_handler (true, FUNC_NAME, errmsg);
+        free (granules);
+        return (ERROR);
+    }
+
+    if (composite_type_nbytes (composite->band[isel1].data_type) < 0 ||
+        (isel2 >= 0 &&
+         composite_type_nbytes (composite->band[isel2].data_type) < 0))
+    {
+        sprintf (errmsg, "Unsupported data type in the selection SDS(s).");
+        error_handler (true, FUNC_NAME, errmsg);
+        free (granules);
+        return (ERROR);
+    }
+
+    /* The two NDVI selection SDSs must share the same grid so they can be
+       scored pixel-for-pixel */
+    if (isel2 >= 0 &&
+        (composite->band[isel2].nlines != composite->band[isel1].nlines ||
+         composite->band[isel2].nsamps != composite->band[isel1].nsamps))
+    {
+        sprintf (errmsg, "The selection SDSs %s and %s have different "
+            "dimensions.", select_sds1, select_sds2);
+        error_handler (true, FUNC_NAME, errmsg);
+        free (granules);
+        return (ERROR);
+    }
+
+    printf ("Compositing %d granules (%s rule)\n", nfiles,
+        rule == MODIS_COMPOSITE_MAX_NDVI ? "max-NDVI" : "QA-priority");
+
+    /* Build the per-pixel winner map from the selection SDS(s) */
+    winner = malloc ((size_t) composite->band[isel1].nlines *
+        composite->band[isel1].nsamps);
+    if (winner == NULL)
+    {
+        sprintf (errmsg, "Allocating memory for the %d x %d winner map.",
+            composite->band[isel1].nlines, composite->band[isel1].nsamps);
+        error_handler (true, FUNC_NAME, errmsg);
+        free (granules);
+        return (ERROR);
+    }
+
+    if (build_composite_index (modis_hdf_files, granules, nfiles, isel1,
+        isel2, score_func, winner) != SUCCESS)
+    {
+        sprintf (errmsg, "Building the per-pixel winner map for the "
+            "composite");
+        error_handler (true, FUNC_NAME, errmsg);
+        free (winner);
+        free (granules);
+        return (ERROR);
+    }
+
+    /* Composite each of the SDSs to one raw binary file; the bands are
+       handed out to the worker pool and share the read-only winner map */
+    pool.modis_hdf_files = modis_hdf_files;
+    pool.granules = granules;
+    pool.nfiles = nfiles;
+    pool.composite = composite;
+    pool.winner = winner;
+    pool.map_nlines = composite->band[isel1].nlines;
+    pool.map_nsamps = composite->band[isel1].nsamps;
+    if (espa_pool_run (convert_hdf_composite_band, &pool, composite->nbands,
+        num_threads) != SUCCESS)
+    {
+        sprintf (errmsg, "Compositing the MODIS SDSs to raw binary");
+        error_handler (true, FUNC_NAME, errmsg);
+        free (winner);
+        free (granules);
+        return (ERROR);
+    }
+    free (winner);
+
+    /* Write the metadata from the composite metadata structure to the
+       output XML filename; the band statistics accumulated during the
+       conversion are written along with it */
+    if (write_metadata (composite, espa_xml_file) != SUCCESS)
+    {  /* Error messages already written */
+        free (granules);
+        return (ERROR);
+    }
+
+    /* Validate the output metadata file */
+    if (validate_xml_file (espa_xml_file) != SUCCESS)
+    {  /* Error messages already written */
+        free (granules);
+        return (ERROR);
+    }
+
+    /* Remove the source files if specified */
+    if (del_src)
+    {
+        for (i = 0; i < nfiles; i++)
+        {
+            printf ("  Removing %s\n", modis_hdf_files[i]);
+            if (unlink (modis_hdf_files[i]) != 0)
+            {
+                sprintf (errmsg, "Deleting source file: %s",
+                    modis_hdf_files[i]);
+                error_handler (true, FUNC_NAME, errmsg);
+                free (granules);
+                return (ERROR);
+            }
+        }
+    }
+
+    /* Free the metadata structures; the composite shares the first
+       granule's structure so it is freed with the granules */
+    for (i = 0; i < nfiles; i++)
+        free_metadata (&granules[i]);
+    free (granules);
 
     /* Successful conversion */
     return (SUCCESS);
@@ -2045,6 +4453,8 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 4/22/2014    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added num_threads to support concurrent SDS
+                              conversion
 
 NOTES:
   1. The ESPA raw binary band files will be generated from the ESPA XML
@@ -2054,8 +4464,10 @@ int convert_modis_to_espa
 (
     char *modis_hdf_file,  /* I: input MODIS HDF filename */
     char *espa_xml_file,   /* I: output ESPA XML metadata filename */
-    bool del_src           /* I: should the source .tif files be removed after
+    bool del_src,          /* I: should the source .tif files be removed after
                                  conversion? */
+    int num_threads        /* I: number of threads to use for converting the
+                                 SDSs; 1 or less converts serially */
 )
 {
     char FUNC_NAME[] = "convert_modis_to_espa";  /* function name */
@@ -2089,7 +4501,8 @@ int convert_modis_to_espa
     }
 
     /* Convert each of the MODIS HDF bands/SDSs to raw binary */
-    if (convert_hdf_to_img (modis_hdf_file, &xml_metadata) != SUCCESS)
+    if (convert_hdf_to_img (modis_hdf_file, &xml_metadata, num_threads)
+        != SUCCESS)
     {
         sprintf (errmsg, "Converting %s to ESPA", modis_hdf_file);
         error_handler (true, FUNC_NAME, errmsg);
@@ -13,6 +13,14 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 4/22/2014    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added num_threads to the conversion prototypes
+                              to support concurrent SDS conversion
+8/31/2026    Gail Schmidt     Added convert_modis_mosaic_to_espa to stitch
+                              multiple tiled granules into one combined
+                              raw binary mosaic with bounded memory
+8/31/2026    Gail Schmidt     Added convert_modis_composite_to_espa to
+                              composite multiple granules per pixel with
+                              bounded memory
 
 NOTES:
 *****************************************************************************/
@@ -44,6 +52,20 @@ NOTES:
 /* maximum number of grids for each file */
 #define MAX_MODIS_GRIDS 10
 
+/* Size in bytes of the hyperslab chunk buffer used when converting an SDS
+   to raw binary; bounds the memory used per SDS regardless of the grid
+   size */
+#define MODIS_HDF_CHUNK_BYTES (4 * 1024 * 1024)
+
+/* Per-pixel selection rules for the multi-granule composite engine;
+   additional rules plug in as score functions in the engine */
+typedef enum
+{
+    MODIS_COMPOSITE_QA_PRIORITY = 0, /* lowest QA SDS value wins */
+    MODIS_COMPOSITE_MAX_NDVI         /* highest NDVI from the red and NIR
+                                        reflectance SDSs wins */
+} Modis_composite_rule_t;
+
 /* Prototypes */
 int read_modis_hdf
 (
@@ -55,15 +77,49 @@ int read_modis_hdf
 int convert_hdf_to_img
 (
     char *modis_hdf_name,      /* I: name of MODIS file to be processed */
-    Espa_internal_meta_t *xml_metadata /* I: metadata structure for HDF file */
+    Espa_internal_meta_t *xml_metadata, /* I: metadata structure for HDF
+                                    file */
+    int num_threads            /* I: number of threads to use for converting
+                                    the SDSs; 1 or less converts serially */
+);
+
+int convert_modis_mosaic_to_espa
+(
+    char **modis_hdf_files, /* I: array of input MODIS HDF filenames */
+    int nfiles,            /* I: number of input MODIS HDF files */
+    char *espa_xml_file,   /* I: output ESPA XML metadata filename */
+    bool del_src,          /* I: should the source files be removed after
+                                 conversion? */
+    int num_threads        /* I: number of threads to use for converting the
+                                 SDSs; 1 or less converts serially */
+);
+
+int convert_modis_composite_to_espa
+(
+    char **modis_hdf_files, /* I: array of input MODIS HDF filenames */
+    int nfiles,            /* I: number of input MODIS HDF files */
+    char *espa_xml_file,   /* I: output ESPA XML metadata filename */
+    Modis_composite_rule_t rule,  /* I: per-pixel selection rule */
+    char *select_sds1,     /* I: name of the QA SDS for the QA-priority
+                                 rule, or of the red reflectance SDS for
+                                 the max-NDVI rule */
+    char *select_sds2,     /* I: name of the NIR reflectance SDS for the
+                                 max-NDVI rule; unused by the QA-priority
+                                 rule */
+    bool del_src,          /* I: should the source files be removed after
+                                 conversion? */
+    int num_threads        /* I: number of threads to use for converting the
+                                 SDSs; 1 or less converts serially */
 );
 
 int convert_modis_to_espa
 (
     char *modis_hdf_file,  /* I: input MODIS HDF filename */
     char *espa_xml_file,   /* I: output ESPA XML metadata filename */
-    bool del_src           /* I: should the source .tif files be removed after
+    bool del_src,          /* I: should the source .tif files be removed after
                                  conversion? */
+    int num_threads        /* I: number of threads to use for converting the
+                                 SDSs; 1 or less converts serially */
 );
 
 #endif
@@ -0,0 +1,990 @@
+/*****************************************************************************
+FILE: espa_convert_kernels.c
+
+PURPOSE: Contains the per-pixel type conversion and scaling kernels shared
+by the format converters and the downstream science applications.  These
+loops run over every pixel of every delivered product, so they are written
+so the compiler can vectorize them: tight loops over restrict pointers with
+the fill handling expressed as a select instead of a branch.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. This file is compiled with optimization (see the Makefile) so the
+     kernels vectorize; the rest of the library keeps the default flags.
+  2. Fill pixels pass through the scaling untouched and are written as the
+     caller's output fill value, per the usual scale_factor/add_offset
+     conventions (the attributes don't apply to fill).
+*****************************************************************************/
+
+#include <string.h>
+#include <float.h>
+#include "espa_convert_kernels.h"
+
+/******************************************************************************
+MODULE:  espa_scale_int16_to_float32
+
+PURPOSE:  Converts an int16 pixel buffer to float32, applying the scale
+factor and offset and remapping the fill pixels to the output fill value.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void espa_scale_int16_to_float32
+(
+    const int16_t *in,    /* I: input int16 pixel buffer */
+    float *out,           /* O: output float32 pixel buffer */
+    long npixels,         /* I: number of pixels in the buffers */
+    float scale_factor,   /* I: scale factor to be applied */
+    float add_offset,     /* I: offset to be added after scaling */
+    int16_t fill_value,   /* I: fill value in the input buffer */
+    float fill_output     /* I: value written for the fill pixels */
+)
+{
+    const int16_t * restrict ip = in;   /* input pixel pointer */
+    float * restrict op = out;          /* output pixel pointer */
+    long i;                             /* pixel loop counter */
+
+    for (i = 0; i < npixels; i++)
+    {
+        op[i] = (ip[i] == fill_value) ? fill_output :
+            (float) ip[i] * scale_factor + add_offset;
+    }
+}
+
+
+/******************************************************************************
+MODULE:  espa_unscale_float32_to_int16
+
+PURPOSE:  Converts a float32 pixel buffer back to int16, removing the scale
+factor and offset, rounding to the nearest integer, clamping to the int16
+range, and remapping the fill pixels to the output fill value.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The comparison against the fill value is exact, so the caller needs to
+     have left the fill pixels at exactly the fill value.
+******************************************************************************/
+void espa_unscale_float32_to_int16
+(
+    const float *in,      /* I: input float32 pixel buffer */
+    int16_t *out,         /* O: output int16 pixel buffer */
+    long npixels,         /* I: number of pixels in the buffers */
+    float scale_factor,   /* I: scale factor the input was scaled by */
+    float add_offset,     /* I: offset the input was offset by */
+    float fill_value,     /* I: fill value in the input buffer */
+    int16_t fill_output   /* I: value written for the fill pixels */
+)
+{
+    const float * restrict ip = in;     /* input pixel pointer */
+    int16_t * restrict op = out;        /* output pixel pointer */
+    long i;                             /* pixel loop counter */
+    float unscaled;                     /* pixel with the scaling removed */
+
+    for (i = 0; i < npixels; i++)
+    {
+        unscaled = (ip[i] - add_offset) / scale_factor;
+        unscaled += (unscaled >= 0.0f) ? 0.5f : -0.5f;   /* round */
+        unscaled = (unscaled < -32768.0f) ? -32768.0f : unscaled;
+        unscaled = (unscaled > 32767.0f) ? 32767.0f : unscaled;
+        op[i] = (ip[i] == fill_value) ? fill_output : (int16_t) unscaled;
+    }
+}
+
+
+/******************************************************************************
+MODULE:  espa_remap_fill_int16
+
+PURPOSE:  Replaces one fill value with another across an int16 pixel buffer
+in place.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void espa_remap_fill_int16
+(
+    int16_t *buf,         /* I/O: pixel buffer to be remapped in place */
+    long npixels,         /* I: number of pixels in the buffer */
+    int16_t old_fill,     /* I: fill value currently in the buffer */
+    int16_t new_fill      /* I: fill value to replace it with */
+)
+{
+    int16_t * restrict bp = buf;        /* pixel pointer */
+    long i;                             /* pixel loop counter */
+
+    for (i = 0; i < npixels; i++)
+        bp[i] = (bp[i] == old_fill) ? new_fill : bp[i];
+}
+
+
+/******************************************************************************
+MODULE:  espa_remap_fill_uint8
+
+PURPOSE:  Replaces one fill value with another across a uint8 pixel buffer
+in place.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void espa_remap_fill_uint8
+(
+    uint8_t *buf,         /* I/O: pixel buffer to be remapped in place */
+    long npixels,         /* I: number of pixels in the buffer */
+    uint8_t old_fill,     /* I: fill value currently in the buffer */
+    uint8_t new_fill      /* I: fill value to replace it with */
+)
+{
+    uint8_t * restrict bp = buf;        /* pixel pointer */
+    long i;                             /* pixel loop counter */
+
+    for (i = 0; i < npixels; i++)
+        bp[i] = (bp[i] == old_fill) ? new_fill : bp[i];
+}
+
+
+/******************************************************************************
+MODULE:  espa_band_to_float32
+
+PURPOSE:  Converts a pixel buffer in the band's data type to float32 using
+the scale factor, offset, and fill value from the band metadata.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Unsupported data type for the conversion
+SUCCESS         Buffer was converted
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. A scale factor or offset left at the metadata fill value is treated as
+     1.0 and 0.0 respectively, i.e. no scaling.
+******************************************************************************/
+int espa_band_to_float32
+(
+    Espa_band_meta_t *bmeta,  /* I: metadata for the band being converted;
+                                    the scale factor, offset, and fill value
+                                    are taken from here */
+    const void *in,       /* I: input pixel buffer in the band's data type */
+    float *out,           /* O: output float32 pixel buffer */
+    long npixels,         /* I: number of pixels in the buffers */
+    float fill_output     /* I: value written for the fill pixels */
+)
+{
+    char FUNC_NAME[] = "espa_band_to_float32";   /* function name */
+    char errmsg[STR_SIZE];        /* error message */
+    float scale_factor;           /* scale factor to be applied */
+    float add_offset;             /* offset to be added after scaling */
+    long i;                       /* pixel loop counter */
+
+    /* A scale factor/offset which wasn't set in the metadata means the data
+       isn't scaled */
+    scale_factor = bmeta->scale_factor;
+    if (scale_factor == (float) ESPA_INT_META_FILL)
+        scale_factor = 1.0f;
+    add_offset = bmeta->add_offset;
+    if (add_offset == (float) ESPA_INT_META_FILL)
+        add_offset = 0.0f;
+
+    switch (bmeta->data_type)
+    {
+        case ESPA_INT16:
+            espa_scale_int16_to_float32 (in, out, npixels, scale_factor,
+                add_offset, (int16_t) bmeta->fill_value, fill_output);
+            break;
+
+        case ESPA_UINT16:
+        {
+            const uint16_t * restrict ip = in;
+            float * restrict op = out;
+            uint16_t fill_value = (uint16_t) bmeta->fill_value;
+            for (i = 0; i < npixels; i++)
+            {
+                op[i] = (ip[i] == fill_value) ? fill_output :
+                    (float) ip[i] * scale_factor + add_offset;
+            }
+            break;
+        }
+
+        case ESPA_INT8:
+        {
+            const int8_t * restrict ip = in;
+            float * restrict op = out;
+            int8_t fill_value = (int8_t) bmeta->fill_value;
+            for (i = 0; i < npixels; i++)
+            {
+                op[i] = (ip[i] == fill_value) ? fill_output :
+                    (float) ip[i] * scale_factor + add_offset;
+            }
+            break;
+        }
+
+        case ESPA_UINT8:
+        {
+            const uint8_t * restrict ip = in;
+            float * restrict op = out;
+            uint8_t fill_value = (uint8_t) bmeta->fill_value;
+            for (i = 0; i < npixels; i++)
+            {
+                op[i] = (ip[i] == fill_value) ? fill_output :
+                    (float) ip[i] * scale_factor + add_offset;
+            }
+            break;
+        }
+
+        case ESPA_FLOAT32:
+        {
+            const float * restrict ip = in;
+            float * restrict op = out;
+            float fill_value = (float) bmeta->fill_value;
+            for (i = 0; i < npixels; i++)
+            {
+                op[i] = (ip[i] == fill_value) ? fill_output :
+                    ip[i] * scale_factor + add_offset;
+            }
+            break;
+        }
+
+        default:
+            sprintf (errmsg, "Unsupported data type %d for band %.1024s.",
+                bmeta->data_type, bmeta->name);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  espa_valid_range_enforced
+
+PURPOSE:  Checks whether the optional valid range enforcement stage was
+requested through the ESPA_ENFORCE_VALID_RANGE environment variable.
+
+RETURN VALUE:
+Type = bool
+Value           Description
+-----           -----------
+true            Converters should clamp bands to their valid range
+false           Enforcement was not requested (the default)
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+bool espa_valid_range_enforced (void)
+{
+    static int enforced = -1;     /* cached setting; -1 until first call */
+    char *value = NULL;           /* value of the environment variable */
+
+    if (enforced == -1)
+    {
+        value = getenv ("ESPA_ENFORCE_VALID_RANGE");
+        enforced = (value != NULL && value[0] != '\0' &&
+            strcmp (value, "0") != 0);
+    }
+
+    return enforced;
+}
+
+
+/* Clamps one pixel buffer of the given type to [lo, hi], leaving the fill
+   pixels untouched.  The loop body is a pair of selects so the compiler
+   vectorizes it with min/max instructions. */
+#define ESPA_CLAMP_LOOP(type, buffer, np, lo_val, hi_val, has_fill_val, \
+    fill_val) \
+{ \
+    type * restrict bp = (type *) (buffer); \
+    type lo = (type) (lo_val); \
+    type hi = (type) (hi_val); \
+    type fill = (type) (fill_val); \
+    type v; \
+    long i; \
+    if (has_fill_val) \
+    { \
+        for (i = 0; i < (np); i++) \
+        { \
+            v = bp[i] < lo ? lo : bp[i]; \
+            v = v > hi ? hi : v; \
+            bp[i] = (bp[i] == fill) ? bp[i] : v; \
+        } \
+    } \
+    else \
+    { \
+        for (i = 0; i < (np); i++) \
+        { \
+            v = bp[i] < lo ? lo : bp[i]; \
+            bp[i] = v > hi ? hi : v; \
+        } \
+    } \
+}
+
+/******************************************************************************
+MODULE:  espa_clamp_valid_range
+
+PURPOSE:  Clamps a pixel buffer to the valid range from the band metadata,
+leaving the fill pixels untouched.  Applied by the converters while the
+chunk is still in cache, which is nearly free compared to a separate pass
+over the band.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Unsupported data type for the clamp
+SUCCESS         Buffer was clamped (or the band has no valid range)
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Dispatch through the per-type kernel table
+
+NOTES:
+  1. Bands without a valid range in the metadata are left untouched.
+******************************************************************************/
+int espa_clamp_valid_range
+(
+    Espa_band_meta_t *bmeta,  /* I: metadata for the band being clamped; the
+                                    valid range and fill value are taken from
+                                    here */
+    void *buf,            /* I/O: pixel buffer in the band's data type */
+    long npixels          /* I: number of pixels in the buffer */
+)
+{
+    Espa_band_kernels_t bk;       /* resolved kernels for the band */
+
+    /* Bands without a valid range aren't clamped */
+    if (bmeta->valid_range[0] == ESPA_INT_META_FILL ||
+        bmeta->valid_range[1] == ESPA_INT_META_FILL)
+        return (SUCCESS);
+
+    if (espa_band_kernels_init (bmeta, &bk) != SUCCESS)
+    {  /* Error messages already printed */
+        return (ERROR);
+    }
+
+    espa_band_clamp (&bk, buf, npixels);
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  espa_stats_enabled
+
+PURPOSE:  Checks whether the optional fused statistics stage was requested
+through the ESPA_COMPUTE_STATS environment variable.
+
+RETURN VALUE:
+Type = bool
+Value           Description
+-----           -----------
+true            Converters should accumulate band statistics
+false           Statistics were not requested (the default)
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+bool espa_stats_enabled (void)
+{
+    static int enabled = -1;      /* cached setting; -1 until first call */
+    char *value = NULL;           /* value of the environment variable */
+
+    if (enabled == -1)
+    {
+        value = getenv ("ESPA_COMPUTE_STATS");
+        enabled = (value != NULL && value[0] != '\0' &&
+            strcmp (value, "0") != 0);
+    }
+
+    return enabled;
+}
+
+
+/******************************************************************************
+MODULE:  espa_stats_init
+
+PURPOSE:  Initializes a statistics accumulator for a new band.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void espa_stats_init
+(
+    Espa_stat_accum_t *acc    /* O: accumulator to be initialized */
+)
+{
+    memset (acc, 0, sizeof (*acc));
+    acc->min = DBL_MAX;
+    acc->max = -DBL_MAX;
+}
+
+
+/* Accumulates min/max/sum and the histogram over one pixel buffer of the
+   given type, skipping the fill pixels.  The min/max/sum reduction
+   vectorizes; the histogram update is scalar but touches a table which
+   stays resident in L1. */
+#define ESPA_STATS_LOOP(type, buffer, np, has_fill_val, fill_val, \
+    hist_on, lo_val, binsize_val, acc_ptr) \
+{ \
+    const type * restrict bp = (const type *) (buffer); \
+    type fill = (type) (fill_val); \
+    long i; \
+    int bin; \
+    for (i = 0; i < (np); i++) \
+    { \
+        if ((has_fill_val) && bp[i] == fill) \
+            continue; \
+        if ((double) bp[i] < (acc_ptr)->min) \
+            (acc_ptr)->min = (double) bp[i]; \
+        if ((double) bp[i] > (acc_ptr)->max) \
+            (acc_ptr)->max = (double) bp[i]; \
+        (acc_ptr)->sum += (double) bp[i]; \
+        (acc_ptr)->npixels++; \
+        if (hist_on) \
+        { \
+            bin = (int) (((double) bp[i] - (lo_val)) / (binsize_val)); \
+            if (bin < 0) \
+                bin = 0; \
+            else if (bin >= ESPA_STAT_HIST_BINS) \
+                bin = ESPA_STAT_HIST_BINS - 1; \
+            (acc_ptr)->histogram[bin]++; \
+        } \
+    } \
+}
+
+
+/******************************************************************************
+MODULE:  espa_stats_accumulate
+
+PURPOSE:  Accumulates band statistics (min, max, sum, histogram) over one
+pixel buffer, skipping the fill pixels.  Applied by the converters while
+the chunk is still in cache, which eliminates the separate full-band read
+the statistics used to cost.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Unsupported data type for the statistics
+SUCCESS         Buffer was accumulated
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Dispatch through the per-type kernel table
+
+NOTES:
+  1. The histogram is binned over the band's valid range when one is
+     declared and over the data type's range otherwise.  Floating point
+     bands without a valid range get no histogram (min/max/mean are still
+     accumulated) since there is no meaningful fixed binning for them.
+******************************************************************************/
+int espa_stats_accumulate
+(
+    Espa_band_meta_t *bmeta,  /* I: metadata for the band; the fill value,
+                                    valid range, and data type are taken from
+                                    here */
+    const void *buf,      /* I: pixel buffer in the band's data type */
+    long npixels,         /* I: number of pixels in the buffer */
+    Espa_stat_accum_t *acc    /* I/O: running statistics accumulator */
+)
+{
+    Espa_band_kernels_t bk;       /* resolved kernels for the band */
+
+    if (espa_band_kernels_init (bmeta, &bk) != SUCCESS)
+    {  /* Error messages already printed */
+        return (ERROR);
+    }
+
+    espa_band_stats (&bk, buf, npixels, acc);
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  espa_stats_finish
+
+PURPOSE:  Stores the accumulated statistics into the band metadata, from
+where write_metadata emits them into the XML.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. A band whose pixels were all fill records zero pixels and fill values
+     for the min/max/mean.
+******************************************************************************/
+void espa_stats_finish
+(
+    const Espa_stat_accum_t *acc,  /* I: accumulator for the band */
+    Espa_band_meta_t *bmeta   /* I/O: band metadata the statistics are
+                                    stored into */
+)
+{
+    if (acc->npixels == 0)
+    {
+        bmeta->stat_npixels = 0;
+        bmeta->stat_min = ESPA_FLOAT_META_FILL;
+        bmeta->stat_max = ESPA_FLOAT_META_FILL;
+        bmeta->stat_mean = ESPA_FLOAT_META_FILL;
+        memset (bmeta->stat_histogram, 0, sizeof (bmeta->stat_histogram));
+        return;
+    }
+
+    bmeta->stat_npixels = acc->npixels;
+    bmeta->stat_min = acc->min;
+    bmeta->stat_max = acc->max;
+    bmeta->stat_mean = acc->sum / acc->npixels;
+    memcpy (bmeta->stat_histogram, acc->histogram,
+        sizeof (bmeta->stat_histogram));
+}
+
+
+/******************************************************************************
+MODULE:  espa_sparse_fill_enabled
+
+PURPOSE:  Checks whether the optional sparse fill output stage was requested
+through the ESPA_SPARSE_FILL environment variable.
+
+RETURN VALUE:
+Type = bool
+Value           Description
+-----           -----------
+true            Converters should seek past all-fill lines so the
+                filesystem stores them as holes
+false           Sparse output was not requested (the default)
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+bool espa_sparse_fill_enabled (void)
+{
+    static int enabled = -1;      /* cached setting; -1 until first call */
+    char *value = NULL;           /* value of the environment variable */
+
+    if (enabled == -1)
+    {
+        value = getenv ("ESPA_SPARSE_FILL");
+        enabled = (value != NULL && value[0] != '\0' &&
+            strcmp (value, "0") != 0);
+    }
+
+    return enabled;
+}
+
+
+/* Scans one pixel buffer of the given type for any non-fill value.  The
+   comparisons are OR-reduced over blocks of pixels before branching so the
+   compiler vectorizes the inner loop with packed compares. */
+#define ESPA_FILL_SCAN_BLOCK 64
+#define ESPA_FILL_SCAN_LOOP(type, buffer, np, fill_val, found_data) \
+{ \
+    const type * restrict bp = (const type *) (buffer); \
+    type fill = (type) (fill_val); \
+    long i, j, blk; \
+    int hit; \
+    (found_data) = false; \
+    for (i = 0; i < (np) && !(found_data); i += blk) \
+    { \
+        blk = (np) - i; \
+        if (blk > ESPA_FILL_SCAN_BLOCK) \
+            blk = ESPA_FILL_SCAN_BLOCK; \
+        hit = 0; \
+        for (j = 0; j < blk; j++) \
+            hit |= (bp[i + j] != fill); \
+        if (hit) \
+            (found_data) = true; \
+    } \
+}
+
+/******************************************************************************
+MODULE:  espa_buffer_all_fill
+
+PURPOSE:  Checks whether every pixel in the buffer is the band fill value.
+Used by the converters to find runs of all-fill lines that can be stored
+as filesystem holes instead of being written out.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Unsupported data type for the scan
+SUCCESS         The scan completed and all_fill was set
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Dispatch through the per-type kernel table
+
+NOTES:
+  1. Bands without a fill value in the metadata report all_fill false.
+******************************************************************************/
+int espa_buffer_all_fill
+(
+    const Espa_band_meta_t *bmeta,  /* I: metadata for the band; the fill
+                                          value is taken from here */
+    const void *buf,      /* I: pixel buffer in the band's data type */
+    long npixels,         /* I: number of pixels in the buffer */
+    bool *all_fill        /* O: is every pixel in the buffer fill? */
+)
+{
+    Espa_band_kernels_t bk;       /* resolved kernels for the band */
+
+    /* Bands without a fill value can't have fill runs */
+    if (bmeta->fill_value == ESPA_INT_META_FILL)
+    {
+        *all_fill = false;
+        return (SUCCESS);
+    }
+
+    if (espa_band_kernels_init (bmeta, &bk) != SUCCESS)
+    {  /* Error messages already printed */
+        return (ERROR);
+    }
+
+    *all_fill = espa_band_all_fill (&bk, buf, npixels);
+    return (SUCCESS);
+}
+
+
+/* Expands to the three type-specialized kernel functions for one data
+   type: the valid range clamp, the statistics accumulator, and the
+   non-fill pixel scan.  Each body is one of the loop macros above with the
+   type fixed, so every function is a standalone monomorphic loop the
+   compiler vectorizes on its own. */
+#define ESPA_DEFINE_TYPE_KERNELS(suffix, type) \
+static void clamp_##suffix \
+( \
+    void *buf,            /* I/O: pixel buffer */ \
+    long npixels,         /* I: number of pixels in the buffer */ \
+    double range_lo,      /* I: lower bound of the valid range */ \
+    double range_hi,      /* I: upper bound of the valid range */ \
+    bool band_fill,       /* I: does the band define a fill value */ \
+    double fill_value     /* I: band fill value */ \
+) \
+{ \
+    ESPA_CLAMP_LOOP (type, buf, npixels, range_lo, range_hi, band_fill, \
+        fill_value); \
+} \
+ \
+static void stats_##suffix \
+( \
+    const void *buf,      /* I: pixel buffer */ \
+    long npixels,         /* I: number of pixels in the buffer */ \
+    bool band_fill,       /* I: does the band define a fill value */ \
+    double fill_value,    /* I: band fill value */ \
+    bool hist,            /* I: accumulate the histogram? */ \
+    double hist_lo,       /* I: lower edge of the histogram binning */ \
+    double binsize,       /* I: width of one histogram bin */ \
+    Espa_stat_accum_t *acc    /* I/O: running statistics accumulator */ \
+) \
+{ \
+    ESPA_STATS_LOOP (type, buf, npixels, band_fill, fill_value, hist, \
+        hist_lo, binsize, acc); \
+} \
+ \
+static bool scan_data_##suffix \
+( \
+    const void *buf,      /* I: pixel buffer */ \
+    long npixels,         /* I: number of pixels in the buffer */ \
+    double fill_value     /* I: band fill value */ \
+) \
+{ \
+    bool found_data; \
+    ESPA_FILL_SCAN_LOOP (type, buf, npixels, fill_value, found_data); \
+    return found_data; \
+}
+
+ESPA_DEFINE_TYPE_KERNELS (int8, int8_t)
+ESPA_DEFINE_TYPE_KERNELS (uint8, uint8_t)
+ESPA_DEFINE_TYPE_KERNELS (int16, int16_t)
+ESPA_DEFINE_TYPE_KERNELS (uint16, uint16_t)
+ESPA_DEFINE_TYPE_KERNELS (int32, int32_t)
+ESPA_DEFINE_TYPE_KERNELS (uint32, uint32_t)
+ESPA_DEFINE_TYPE_KERNELS (float32, float)
+ESPA_DEFINE_TYPE_KERNELS (float64, double)
+
+/* One row of the kernel dispatch table */
+typedef struct
+{
+    void (*clamp) (void *buf, long npixels, double lo, double hi,
+        bool has_fill, double fill);
+    void (*stats) (const void *buf, long npixels, bool has_fill,
+        double fill, bool hist, double lo, double binsize,
+        Espa_stat_accum_t *acc);
+    bool (*scan_data) (const void *buf, long npixels, double fill);
+} Type_kernels_t;
+
+#define ESPA_TYPE_KERNEL_ENTRY(suffix) \
+    { clamp_##suffix, stats_##suffix, scan_data_##suffix }
+
+/* Kernel dispatch table, in Espa_data_type enumeration order */
+static const Type_kernels_t type_kernel_table[] =
+{
+    ESPA_TYPE_KERNEL_ENTRY (int8),
+    ESPA_TYPE_KERNEL_ENTRY (uint8),
+    ESPA_TYPE_KERNEL_ENTRY (int16),
+    ESPA_TYPE_KERNEL_ENTRY (uint16),
+    ESPA_TYPE_KERNEL_ENTRY (int32),
+    ESPA_TYPE_KERNEL_ENTRY (uint32),
+    ESPA_TYPE_KERNEL_ENTRY (float32),
+    ESPA_TYPE_KERNEL_ENTRY (float64)
+};
+
+
+/******************************************************************************
+MODULE:  espa_band_kernels_init
+
+PURPOSE:  Resolves the type-specialized kernels and precomputed parameters
+for one band, so the chunk loops of the converters dispatch on the data type
+once per band instead of once per chunk.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Unsupported data type for the band
+SUCCESS         Kernels were resolved
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+int espa_band_kernels_init
+(
+    const Espa_band_meta_t *bmeta,  /* I: metadata for the band; the data
+                                          type, fill value, and valid range
+                                          are taken from here */
+    Espa_band_kernels_t *bk   /* O: resolved kernels and parameters for the
+                                    band */
+)
+{
+    char FUNC_NAME[] = "espa_band_kernels_init";   /* function name */
+    char errmsg[STR_SIZE];        /* error message */
+    bool is_float;                /* is the band a floating point type */
+    double hi;                    /* upper edge of the histogram binning */
+
+    if ((int) bmeta->data_type < 0 || (int) bmeta->data_type >=
+        (int) (sizeof (type_kernel_table) / sizeof (type_kernel_table[0])))
+    {
+        sprintf (errmsg, "Unsupported data type %d for band %.1024s.",
+            bmeta->data_type, bmeta->name);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    bk->clamp = type_kernel_table[bmeta->data_type].clamp;
+    bk->stats = type_kernel_table[bmeta->data_type].stats;
+    bk->scan_data = type_kernel_table[bmeta->data_type].scan_data;
+    bk->has_fill = (bmeta->fill_value != ESPA_INT_META_FILL);
+    bk->fill = bmeta->fill_value;
+    bk->clamp_on = (bmeta->valid_range[0] != ESPA_INT_META_FILL &&
+        bmeta->valid_range[1] != ESPA_INT_META_FILL);
+    bk->clamp_lo = bmeta->valid_range[0];
+    bk->clamp_hi = bmeta->valid_range[1];
+    is_float = (bmeta->data_type == ESPA_FLOAT32 ||
+                bmeta->data_type == ESPA_FLOAT64);
+
+    /* Determine the histogram binning range: the declared valid range when
+       there is one, otherwise the range of the data type */
+    bk->hist = true;
+    if (bk->clamp_on)
+    {
+        bk->hist_lo = bmeta->valid_range[0];
+        hi = bmeta->valid_range[1];
+    }
+    else
+    {
+        switch (bmeta->data_type)
+        {
+            case ESPA_UINT8: bk->hist_lo = 0.0; hi = 255.0; break;
+            case ESPA_INT8: bk->hist_lo = -128.0; hi = 127.0; break;
+            case ESPA_UINT16: bk->hist_lo = 0.0; hi = 65535.0; break;
+            case ESPA_INT16: bk->hist_lo = -32768.0; hi = 32767.0; break;
+            case ESPA_UINT32: bk->hist_lo = 0.0; hi = 4294967295.0; break;
+            case ESPA_INT32:
+                bk->hist_lo = -2147483648.0;
+                hi = 2147483647.0;
+                break;
+            default:  /* no fixed binning for an unbounded float band */
+                bk->hist = false;
+                bk->hist_lo = 0.0;
+                hi = 0.0;
+                break;
+        }
+    }
+
+    /* Integer bins cover [lo, hi] inclusive; degenerate ranges land every
+       pixel in the first bin via the index clamp */
+    bk->binsize = (hi - bk->hist_lo + (is_float ? 0.0 : 1.0)) /
+        ESPA_STAT_HIST_BINS;
+    if (bk->binsize <= 0.0)
+        bk->binsize = 1.0;
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  espa_band_clamp
+
+PURPOSE:  Clamps a pixel buffer to the band's valid range through the
+resolved kernels, leaving the fill pixels untouched.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Bands without a valid range in the metadata are left untouched.
+******************************************************************************/
+void espa_band_clamp
+(
+    const Espa_band_kernels_t *bk,  /* I: resolved kernels for the band */
+    void *buf,            /* I/O: pixel buffer in the band's data type */
+    long npixels          /* I: number of pixels in the buffer */
+)
+{
+    if (!bk->clamp_on)
+        return;
+
+    bk->clamp (buf, npixels, bk->clamp_lo, bk->clamp_hi, bk->has_fill,
+        bk->fill);
+}
+
+
+/******************************************************************************
+MODULE:  espa_band_stats
+
+PURPOSE:  Accumulates band statistics over one pixel buffer through the
+resolved kernels, skipping the fill pixels.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void espa_band_stats
+(
+    const Espa_band_kernels_t *bk,  /* I: resolved kernels for the band */
+    const void *buf,      /* I: pixel buffer in the band's data type */
+    long npixels,         /* I: number of pixels in the buffer */
+    Espa_stat_accum_t *acc    /* I/O: running statistics accumulator */
+)
+{
+    bk->stats (buf, npixels, bk->has_fill, bk->fill, bk->hist, bk->hist_lo,
+        bk->binsize, acc);
+}
+
+
+/******************************************************************************
+MODULE:  espa_band_all_fill
+
+PURPOSE:  Checks whether every pixel in the buffer is the band fill value,
+through the resolved kernels.
+
+RETURN VALUE:
+Type = bool
+Value           Description
+-----           -----------
+true            Every pixel in the buffer is fill
+false           A non-fill pixel was found (or the band has no fill value)
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+bool espa_band_all_fill
+(
+    const Espa_band_kernels_t *bk,  /* I: resolved kernels for the band */
+    const void *buf,      /* I: pixel buffer in the band's data type */
+    long npixels          /* I: number of pixels in the buffer */
+)
+{
+    if (!bk->has_fill)
+        return false;
+
+    return !bk->scan_data (buf, npixels, bk->fill);
+}
@@ -0,0 +1,194 @@
+/*****************************************************************************
+FILE: espa_convert_kernels.h
+
+PURPOSE: Contains prototypes for the per-pixel type conversion and scaling
+kernels shared by the format converters
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added the per-band kernel table so the chunk
+                              loops dispatch on the data type once per band
+
+NOTES:
+*****************************************************************************/
+
+#ifndef ESPA_CONVERT_KERNELS_H
+#define ESPA_CONVERT_KERNELS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "error_handler.h"
+#include "espa_metadata.h"
+
+/* Running accumulator for the fused band statistics; initialize with
+   espa_stats_init, feed each buffer to espa_stats_accumulate while it is
+   resident, and store into the band metadata with espa_stats_finish */
+typedef struct
+{
+    double min;           /* minimum of the non-fill pixels so far */
+    double max;           /* maximum of the non-fill pixels so far */
+    double sum;           /* sum of the non-fill pixels so far */
+    long npixels;         /* number of non-fill pixels accumulated */
+    long histogram[ESPA_STAT_HIST_BINS];  /* histogram of the non-fill
+                             pixels accumulated */
+} Espa_stat_accum_t;
+
+/* Type-specialized kernels and precomputed parameters for one band.
+   Resolve the set once per band with espa_band_kernels_init, then feed each
+   chunk to espa_band_clamp/espa_band_stats/espa_band_all_fill; the chunk
+   loops of the converters then run a monomorphic loop body through a
+   pointer instead of re-branching on the data type for every chunk. */
+typedef struct
+{
+    void (*clamp) (void *buf, long npixels, double lo, double hi,
+        bool has_fill, double fill);    /* valid range clamp kernel */
+    void (*stats) (const void *buf, long npixels, bool has_fill,
+        double fill, bool hist, double lo, double binsize,
+        Espa_stat_accum_t *acc);        /* statistics kernel */
+    bool (*scan_data) (const void *buf, long npixels, double fill);
+                                        /* non-fill pixel scan kernel */
+    bool clamp_on;        /* does the band declare a valid range */
+    bool has_fill;        /* does the band declare a fill value */
+    bool hist;            /* accumulate the histogram */
+    double fill;          /* band fill value */
+    double clamp_lo;      /* lower bound of the valid range */
+    double clamp_hi;      /* upper bound of the valid range */
+    double hist_lo;       /* lower edge of the histogram binning */
+    double binsize;       /* width of one histogram bin */
+} Espa_band_kernels_t;
+
+/* Prototypes */
+void espa_scale_int16_to_float32
+(
+    const int16_t *in,    /* I: input int16 pixel buffer */
+    float *out,           /* O: output float32 pixel buffer */
+    long npixels,         /* I: number of pixels in the buffers */
+    float scale_factor,   /* I: scale factor to be applied */
+    float add_offset,     /* I: offset to be added after scaling */
+    int16_t fill_value,   /* I: fill value in the input buffer */
+    float fill_output     /* I: value written for the fill pixels */
+);
+
+void espa_unscale_float32_to_int16
+(
+    const float *in,      /* I: input float32 pixel buffer */
+    int16_t *out,         /* O: output int16 pixel buffer */
+    long npixels,         /* I: number of pixels in the buffers */
+    float scale_factor,   /* I: scale factor the input was scaled by */
+    float add_offset,     /* I: offset the input was offset by */
+    float fill_value,     /* I: fill value in the input buffer */
+    int16_t fill_output   /* I: value written for the fill pixels */
+);
+
+void espa_remap_fill_int16
+(
+    int16_t *buf,         /* I/O: pixel buffer to be remapped in place */
+    long npixels,         /* I: number of pixels in the buffer */
+    int16_t old_fill,     /* I: fill value currently in the buffer */
+    int16_t new_fill      /* I: fill value to replace it with */
+);
+
+void espa_remap_fill_uint8
+(
+    uint8_t *buf,         /* I/O: pixel buffer to be remapped in place */
+    long npixels,         /* I: number of pixels in the buffer */
+    uint8_t old_fill,     /* I: fill value currently in the buffer */
+    uint8_t new_fill      /* I: fill value to replace it with */
+);
+
+bool espa_valid_range_enforced (void);
+
+int espa_clamp_valid_range
+(
+    Espa_band_meta_t *bmeta,  /* I: metadata for the band being clamped; the
+                                    valid range and fill value are taken from
+                                    here */
+    void *buf,            /* I/O: pixel buffer in the band's data type */
+    long npixels          /* I: number of pixels in the buffer */
+);
+
+bool espa_sparse_fill_enabled (void);
+
+int espa_buffer_all_fill
+(
+    const Espa_band_meta_t *bmeta,  /* I: metadata for the band; the fill
+                                          value is taken from here */
+    const void *buf,      /* I: pixel buffer in the band's data type */
+    long npixels,         /* I: number of pixels in the buffer */
+    bool *all_fill        /* O: is every pixel in the buffer fill? */
+);
+
+bool espa_stats_enabled (void);
+
+void espa_stats_init
+(
+    Espa_stat_accum_t *acc    /* O: accumulator to be initialized */
+);
+
+int espa_stats_accumulate
+(
+    Espa_band_meta_t *bmeta,  /* I: metadata for the band; the fill value,
+                                    valid range, and data type are taken from
+                                    here */
+    const void *buf,      /* I: pixel buffer in the band's data type */
+    long npixels,         /* I: number of pixels in the buffer */
+    Espa_stat_accum_t *acc    /* I/O: running statistics accumulator */
+);
+
+void espa_stats_finish
+(
+    const Espa_stat_accum_t *acc,  /* I: accumulator for the band */
+    Espa_band_meta_t *bmeta   /* I/O: band metadata the statistics are
+                                    stored into */
+);
+
+int espa_band_kernels_init
+(
+    const Espa_band_meta_t *bmeta,  /* I: metadata for the band; the data
+                                          type, fill value, and valid range
+                                          are taken from here */
+    Espa_band_kernels_t *bk   /* O: resolved kernels and parameters for the
+                                    band */
+);
+
+void espa_band_clamp
+(
+    const Espa_band_kernels_t *bk,  /* I: resolved kernels for the band */
+    void *buf,            /* I/O: pixel buffer in the band's data type */
+    long npixels          /* I: number of pixels in the buffer */
+);
+
+void espa_band_stats
+(
+    const Espa_band_kernels_t *bk,  /* I: resolved kernels for the band */
+    const void *buf,      /* I: pixel buffer in the band's data type */
+    long npixels,         /* I: number of pixels in the buffer */
+    Espa_stat_accum_t *acc    /* I/O: running statistics accumulator */
+);
+
+bool espa_band_all_fill
+(
+    const Espa_band_kernels_t *bk,  /* I: resolved kernels for the band */
+    const void *buf,      /* I: pixel buffer in the band's data type */
+    long npixels          /* I: number of pixels in the buffer */
+);
+
+int espa_band_to_float32
+(
+    Espa_band_meta_t *bmeta,  /* I: metadata for the band being converted;
+                                    the scale factor, offset, and fill value
+                                    are taken from here */
+    const void *in,       /* I: input pixel buffer in the band's data type */
+    float *out,           /* O: output float32 pixel buffer */
+    long npixels,         /* I: number of pixels in the buffers */
+    float fill_output     /* I: value written for the fill pixels */
+);
+
+#endif
@@ -15,6 +15,11 @@ Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 1/23/2014    Gail Schmidt     Original development, borrowed code from space.c
                               in the LEDAPS application
+8/31/2026    Gail Schmidt     Added update_geo_window_bounds for refreshing
+                              the geographic coordinates of a window subset
+8/31/2026    Gail Schmidt     Added region certification so the batch mapping
+                              kernels can skip the per-point validity checks
+                              over a certified region
 
 NOTES:
 1. Geodetic coordinates are the geodetic latitude and longitude of the point
@@ -35,11 +40,14 @@ NOTES:
 
 #include <stdlib.h>
 #include <math.h>
+#include "espa_dms.h"
 #include "espa_geoloc.h"
 
 /* Constants */
 #define MAX_PROJ (99)  /* Maximum map projection number */
 #define GCTP_OK 0    /* Okay status return from the GCTP package */
+#define BOUNDS_EDGE_SAMPLES 33  /* coarse samples per edge for the analytic\
+                                  bounds computation */
 
 /* Prototypes for initializing the GCTP projections */
 int for_init (int outsys, int outzone, double *outparm, int outdatum, 
@@ -356,17 +364,1762 @@ bool from_space
 }
 
 
+/******************************************************************************
+MODULE:  to_space_batch
+
+PURPOSE:  Maps an array of points from geodetic coordinates to line, sample
+space.
+
+RETURN VALUE:
+Type = bool
+Value      Description
+-----      -----------
+false      Error occurred in the mapping
+true       Successful mapping
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+HISTORY:
+Date          Programmer       Reason
+----------    ---------------  -------------------------------------
+8/31/2026     Gail Schmidt     Original Development
+
+NOTES:
+1. Report image coordinates for the UL corner of the pixel.
+2. This amortizes the per-call overhead of to_space for callers which map
+   many points, such as the per-pixel lat/long generation.  The line, sample
+   computation is pulled out of the per-point function calls so the compiler
+   can vectorize it.
+3. Unlike to_space, input points flagged as fill are not an error; the
+   corresponding output points are simply flagged as fill and skipped, since
+   batches commonly contain fill pixels.
+******************************************************************************/
+bool to_space_batch
+(
+    Geoloc_t *this,          /* I: geolocation structure; for_trans function
+                                   is used for the forward mapping */
+    int npts,                /* I: number of points to be mapped */
+    Geo_coord_t *geo,        /* I: array of npts geodetic coords (radians) */
+    Img_coord_float_t *img   /* O: array of npts image coordinates (for UL
+                                   corner of pixel) */
+)
+{
+    char FUNC_NAME[] = "to_space_batch";  /* function name */
+    char errmsg[STR_SIZE];          /* error message */
+    Map_coord_t map;                /* coordinate in projection space */
+    double dx, dy;                  /* delta x, y values */
+    double dl, ds;                  /* delta line, sample values */
+    double ul_x = this->def.ul_corner.x;  /* UL corner x coordinate */
+    double ul_y = this->def.ul_corner.y;  /* UL corner y coordinate */
+    double sin_orien = this->sin_orien;   /* sine of the orientation angle */
+    double cos_orien = this->cos_orien;   /* cosine of the orientation angle */
+    double pixel_size_x = this->def.pixel_size[0];  /* x pixel size */
+    double pixel_size_y = this->def.pixel_size[1];  /* y pixel size */
+    int i;                          /* looping variable for the points */
+
+    for (i = 0; i < npts; i++)
+    {
+        /* If this coordinate is fill then skip it */
+        if (geo[i].is_fill)
+        {
+            img[i].is_fill = true;
+            continue;
+        }
+
+        /* Do the forward mapping */
+        if (this->for_trans (geo[i].lon, geo[i].lat, &map.x, &map.y) !=
+            GCTP_OK)
+        {
+            sprintf (errmsg, "Geodetic coordinate %d failed the forward "
+                "mapping.", i);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (false);
+        }
+
+        /* Determine the line, sample location from the projection space */
+        dx = map.x - ul_x;
+        dy = map.y - ul_y;
+
+        dl = (dx * sin_orien) - (dy * cos_orien);
+        ds = (dx * cos_orien) + (dy * sin_orien);
+
+        img[i].l = dl / pixel_size_y;
+        img[i].s = ds / pixel_size_x;
+        img[i].is_fill = false;
+    }
+
+    /* Successful completion */
+    return (true);
+}
+
+
+/******************************************************************************
+MODULE:  from_space_batch
+
+PURPOSE:  Maps an array of points from line, sample space to geodetic
+coordinates.
+
+RETURN VALUE:
+Type = bool
+Value      Description
+-----      -----------
+false      Error occurred in the mapping
+true       Successful mapping
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+HISTORY:
+Date          Programmer       Reason
+----------    ---------------  -------------------------------------
+8/31/2026     Gail Schmidt     Original Development
+
+NOTES:
+1. Report image coordinates for the UL corner of the pixel.
+2. This amortizes the per-call overhead of from_space for callers which map
+   many points, such as compute_bounds and the per-pixel lat/long generation.
+   The projection space computation is pulled out of the per-point function
+   calls so the compiler can vectorize it.
+3. Unlike from_space, input points flagged as fill are not an error; the
+   corresponding output points are simply flagged as fill and skipped, since
+   batches commonly contain fill pixels.
+******************************************************************************/
+bool from_space_batch
+(
+    Geoloc_t *this,          /* I: geolocation structure; inv_trans function
+                                   is used for the inverse mapping */
+    int npts,                /* I: number of points to be mapped */
+    Img_coord_float_t *img,  /* I: array of npts image coordinates (for UL
+                                   corner of pixel) */
+    Geo_coord_t *geo         /* O: array of npts geodetic coords (radians) */
+)
+{
+    char FUNC_NAME[] = "from_space_batch";  /* function name */
+    char errmsg[STR_SIZE];            /* error message */
+    Map_coord_t map;                  /* coordinate in projection space */
+    double dx, dy;                    /* delta x, y values */
+    double dl, ds;                    /* delta line, sample values */
+    double ul_x = this->def.ul_corner.x;  /* UL corner x coordinate */
+    double ul_y = this->def.ul_corner.y;  /* UL corner y coordinate */
+    double sin_orien = this->sin_orien;   /* sine of the orientation angle */
+    double cos_orien = this->cos_orien;   /* cosine of the orientation angle */
+    double pixel_size_x = this->def.pixel_size[0];  /* x pixel size */
+    double pixel_size_y = this->def.pixel_size[1];  /* y pixel size */
+    int i;                            /* looping variable for the points */
+
+    for (i = 0; i < npts; i++)
+    {
+        /* If this coordinate is fill then skip it */
+        if (img[i].is_fill)
+        {
+            geo[i].is_fill = true;
+            continue;
+        }
+
+        /* Determine the line,sample location in projection space */
+        dl = img[i].l * pixel_size_y;
+        ds = img[i].s * pixel_size_x;
+
+        dy = (ds * sin_orien) - (dl * cos_orien);
+        dx = (ds * cos_orien) + (dl * sin_orien);
+
+        map.y = ul_y + dy;
+        map.x = ul_x + dx;
+
+        /* Do the inverse mapping */
+        if (this->inv_trans (map.x, map.y, &geo[i].lon, &geo[i].lat) !=
+            GCTP_OK)
+        {
+            sprintf (errmsg, "Projection coordinate %d failed the inverse "
+                "mapping.", i);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (false);
+        }
+        geo[i].is_fill = false;
+    }
+
+    /* Successful completion */
+    return (true);
+}
+
+
+/******************************************************************************
+MODULE:  certify_from_space_region
+
+PURPOSE:  Checks whether every point of a rectangular image region can be
+expected to survive the inverse mapping, by probing the region corners, edge
+midpoints, and center.
+
+RETURN VALUE:
+Type = bool
+Value      Description
+-----      -----------
+false      The region could not be certified; callers should use the checked
+           batch mapping
+true       The region is certified for the unchecked batch mapping
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+HISTORY:
+Date          Programmer       Reason
+----------    ---------------  -------------------------------------
+8/31/2026     Gail Schmidt     Original Development
+
+NOTES:
+1. The projections supported by setup_mapping vary smoothly over a
+   scene-sized extent, so if the corners, edge midpoints, and center of a
+   region all map successfully then every interior point does as well.
+   Certifying the region once lets the batch kernels drop the per-point
+   validity checks.
+2. A failed probe is not an error; it only means the region could not be
+   certified and the checked batch mapping should be used instead.
+******************************************************************************/
+bool certify_from_space_region
+(
+    Geoloc_t *this,          /* I: geolocation structure; inv_trans function
+                                   is used for the inverse mapping */
+    double min_line,         /* I: first line of the region */
+    double min_samp,         /* I: first sample of the region */
+    double max_line,         /* I: last line of the region */
+    double max_samp          /* I: last sample of the region */
+)
+{
+    double lines[3];                  /* probed line coordinates */
+    double samps[3];                  /* probed sample coordinates */
+    double dx, dy;                    /* delta x, y values */
+    double dl, ds;                    /* delta line, sample values */
+    double map_x, map_y;              /* coordinate in projection space */
+    double lon, lat;                  /* probed geodetic coordinate */
+    int il, is;                       /* probe looping variables */
+
+    /* Probe the corners, edge midpoints, and center of the region */
+    lines[0] = min_line;
+    lines[1] = 0.5 * (min_line + max_line);
+    lines[2] = max_line;
+    samps[0] = min_samp;
+    samps[1] = 0.5 * (min_samp + max_samp);
+    samps[2] = max_samp;
+
+    for (il = 0; il < 3; il++)
+    {
+        for (is = 0; is < 3; is++)
+        {
+            /* Determine the line,sample location in projection space */
+            dl = lines[il] * this->def.pixel_size[1];
+            ds = samps[is] * this->def.pixel_size[0];
+
+            dy = (ds * this->sin_orien) - (dl * this->cos_orien);
+            dx = (ds * this->cos_orien) + (dl * this->sin_orien);
+
+            map_y = this->def.ul_corner.y + dy;
+            map_x = this->def.ul_corner.x + dx;
+
+            /* Do the inverse mapping; any failure leaves the region
+               uncertified */
+            if (this->inv_trans (map_x, map_y, &lon, &lat) != GCTP_OK)
+                return (false);
+        }
+    }
+
+    /* The region is certified for the unchecked batch mapping */
+    return (true);
+}
+
+
+/******************************************************************************
+MODULE:  from_space_batch_unchecked
+
+PURPOSE:  Maps an array of points within a certified region from line,
+sample space to geodetic coordinates without the per-point validity checks.
+
+RETURN VALUE:
+Type = N/A
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+HISTORY:
+Date          Programmer       Reason
+----------    ---------------  -------------------------------------
+8/31/2026     Gail Schmidt     Original Development
+
+NOTES:
+1. Report image coordinates for the UL corner of the pixel.
+2. Every input point must lie within a region certified by
+   certify_from_space_region and must not be flagged as fill.  With the
+   validity of the region decided up front, the loop body is straight-line
+   code with no per-point branches.
+******************************************************************************/
+void from_space_batch_unchecked
+(
+    Geoloc_t *this,          /* I: geolocation structure; inv_trans function
+                                   is used for the inverse mapping */
+    int npts,                /* I: number of points to be mapped */
+    Img_coord_float_t *img,  /* I: array of npts image coordinates (for UL
+                                   corner of pixel) */
+    Geo_coord_t *geo         /* O: array of npts geodetic coords (radians) */
+)
+{
+    double dx, dy;                    /* delta x, y values */
+    double dl, ds;                    /* delta line, sample values */
+    double map_x, map_y;              /* coordinate in projection space */
+    double ul_x = this->def.ul_corner.x;  /* UL corner x coordinate */
+    double ul_y = this->def.ul_corner.y;  /* UL corner y coordinate */
+    double sin_orien = this->sin_orien;   /* sine of the orientation angle */
+    double cos_orien = this->cos_orien;   /* cosine of the orientation angle */
+    double pixel_size_x = this->def.pixel_size[0];  /* x pixel size */
+    double pixel_size_y = this->def.pixel_size[1];  /* y pixel size */
+    int i;                            /* looping variable for the points */
+
+    for (i = 0; i < npts; i++)
+    {
+        /* Determine the line,sample location in projection space */
+        dl = img[i].l * pixel_size_y;
+        ds = img[i].s * pixel_size_x;
+
+        dy = (ds * sin_orien) - (dl * cos_orien);
+        dx = (ds * cos_orien) + (dl * sin_orien);
+
+        map_y = ul_y + dy;
+        map_x = ul_x + dx;
+
+        /* Do the inverse mapping; the region certification already decided
+           the points are valid */
+        this->inv_trans (map_x, map_y, &geo[i].lon, &geo[i].lat);
+        geo[i].is_fill = false;
+    }
+}
+
+
+/******************************************************************************
+MODULE:  certify_to_space_region
+
+PURPOSE:  Checks whether every point of a rectangular geographic region can
+be expected to survive the forward mapping, by probing the region corners,
+edge midpoints, and center.
+
+RETURN VALUE:
+Type = bool
+Value      Description
+-----      -----------
+false      The region could not be certified; callers should use the checked
+           batch mapping
+true       The region is certified for the unchecked batch mapping
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+HISTORY:
+Date          Programmer       Reason
+----------    ---------------  -------------------------------------
+8/31/2026     Gail Schmidt     Original Development
+
+NOTES:
+1. The projections supported by setup_mapping vary smoothly over a
+   scene-sized extent, so if the corners, edge midpoints, and center of a
+   region all map successfully then every interior point does as well.
+2. A failed probe is not an error; it only means the region could not be
+   certified and the checked batch mapping should be used instead.
+******************************************************************************/
+bool certify_to_space_region
+(
+    Geoloc_t *this,          /* I: geolocation structure; for_trans function
+                                   is used for the forward mapping */
+    double min_lon,          /* I: minimum longitude of the region (radians) */
+    double min_lat,          /* I: minimum latitude of the region (radians) */
+    double max_lon,          /* I: maximum longitude of the region (radians) */
+    double max_lat           /* I: maximum latitude of the region (radians) */
+)
+{
+    double lons[3];                   /* probed longitudes */
+    double lats[3];                   /* probed latitudes */
+    double map_x, map_y;              /* coordinate in projection space */
+    int ilon, ilat;                   /* probe looping variables */
+
+    /* Probe the corners, edge midpoints, and center of the region */
+    lons[0] = min_lon;
+    lons[1] = 0.5 * (min_lon + max_lon);
+    lons[2] = max_lon;
+    lats[0] = min_lat;
+    lats[1] = 0.5 * (min_lat + max_lat);
+    lats[2] = max_lat;
+
+    for (ilon = 0; ilon < 3; ilon++)
+    {
+        for (ilat = 0; ilat < 3; ilat++)
+        {
+            /* Do the forward mapping; any failure leaves the region
+               uncertified */
+            if (this->for_trans (lons[ilon], lats[ilat], &map_x, &map_y) !=
+                GCTP_OK)
+                return (false);
+        }
+    }
+
+    /* The region is certified for the unchecked batch mapping */
+    return (true);
+}
+
+
+/******************************************************************************
+MODULE:  to_space_batch_unchecked
+
+PURPOSE:  Maps an array of points within a certified region from geodetic
+coordinates to line, sample space without the per-point validity checks.
+
+RETURN VALUE:
+Type = N/A
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+HISTORY:
+Date          Programmer       Reason
+----------    ---------------  -------------------------------------
+8/31/2026     Gail Schmidt     Original Development
+
+NOTES:
+1. Report image coordinates for the UL corner of the pixel.
+2. Every input point must lie within a region certified by
+   certify_to_space_region and must not be flagged as fill.  With the
+   validity of the region decided up front, the loop body is straight-line
+   code with no per-point branches.
+******************************************************************************/
+void to_space_batch_unchecked
+(
+    Geoloc_t *this,          /* I: geolocation structure; for_trans function
+                                   is used for the forward mapping */
+    int npts,                /* I: number of points to be mapped */
+    Geo_coord_t *geo,        /* I: array of npts geodetic coords (radians) */
+    Img_coord_float_t *img   /* O: array of npts image coordinates (for UL
+                                   corner of pixel) */
+)
+{
+    double dx, dy;                  /* delta x, y values */
+    double dl, ds;                  /* delta line, sample values */
+    double map_x, map_y;            /* coordinate in projection space */
+    double ul_x = this->def.ul_corner.x;  /* UL corner x coordinate */
+    double ul_y = this->def.ul_corner.y;  /* UL corner y coordinate */
+    double sin_orien = this->sin_orien;   /* sine of the orientation angle */
+    double cos_orien = this->cos_orien;   /* cosine of the orientation angle */
+    double pixel_size_x = this->def.pixel_size[0];  /* x pixel size */
+    double pixel_size_y = this->def.pixel_size[1];  /* y pixel size */
+    int i;                          /* looping variable for the points */
+
+    for (i = 0; i < npts; i++)
+    {
+        /* Do the forward mapping; the region certification already decided
+           the points are valid */
+        this->for_trans (geo[i].lon, geo[i].lat, &map_x, &map_y);
+
+        /* Determine the line, sample location from the projection space */
+        dx = map_x - ul_x;
+        dy = map_y - ul_y;
+
+        dl = (dx * sin_orien) - (dy * cos_orien);
+        ds = (dx * cos_orien) + (dy * sin_orien);
+
+        img[i].l = dl / pixel_size_y;
+        img[i].s = ds / pixel_size_x;
+        img[i].is_fill = false;
+    }
+}
+
+
 /******************************************************************************
 MODULE:  get_geoloc_info
 
-PURPOSE:  Copy the geolocation information from the XML structure.
+PURPOSE:  Copy the geolocation information from the XML structure.
+
+RETURN VALUE: N/A
+Type = bool
+Value      Description
+-----      -----------
+false      Error occurred getting geolocation information
+true       Successfully obtained geolocation information
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+HISTORY:
+Date          Programmer       Reason
+----------    ---------------  -------------------------------------
+1/23/2014     Gail Schmidt     Original Development
+5/7/2014      Gail Schmidt     Modify to use the first band if band1 is not
+                               available
+7/22/2014     Gail Schmidt     Initialized orientation angle, since it wasn't
+                               being initialized correctly from the XML meta
+
+NOTES:
+1. Make sure UL corner pixel is UL corner of the pixel, since that's what
+   setup_mapping expects.
+******************************************************************************/
+bool get_geoloc_info
+(
+    Espa_internal_meta_t *xml_metadata, /* I: XML metadata information */
+    Space_def_t *geoloc_info            /* O: geolocation space information */
+)
+{
+    char FUNC_NAME[] = "get_geoloc_info"; /* function name */
+    char errmsg[STR_SIZE];                /* error message */
+    int i;                                /* looping variable */
+    int refl_indx = -99;                  /* index of band1 or first band */
+    Espa_global_meta_t *gmeta=&xml_metadata->global;  /* global metadata */
+
+    /* Use 'band1' band-related metadata for the reflectance information for
+       Landsat.  If band1 isn't available then just use the first band in the
+       XML file (for MODIS and others). */
+    for (i = 0; i < xml_metadata->nbands; i++)
+    {
+        if (!strcmp (xml_metadata->band[i].name, "band1") &&
+            !strncmp (xml_metadata->band[i].product, "L1", 2))  /* L1G or L1T */
+        {
+            /* this is the index we'll use for Landsat band info */
+            refl_indx = i;
+        }
+    }
+    if (refl_indx == -99)
+        refl_indx = 0;
+
+    /* Copy the information from the XML file */
+    geoloc_info->proj_num = gmeta->proj_info.proj_type;
+    geoloc_info->pixel_size[0] = xml_metadata->band[refl_indx].pixel_size[0];
+    geoloc_info->pixel_size[1] = xml_metadata->band[refl_indx].pixel_size[1];
+    geoloc_info->img_size.l = xml_metadata->band[refl_indx].nlines;
+    geoloc_info->img_size.s = xml_metadata->band[refl_indx].nsamps;
+
+    /* If the grid origin is center, then adjust for the resolution.  The
+       corners will be written for the UL of the corner. */
+    if (!strcmp (gmeta->proj_info.grid_origin, "CENTER"))
+    {
+        geoloc_info->ul_corner.x = gmeta->proj_info.ul_corner[0] -
+            0.5 * xml_metadata->band[refl_indx].pixel_size[0];
+        geoloc_info->ul_corner.y = gmeta->proj_info.ul_corner[1] +
+            0.5 * xml_metadata->band[refl_indx].pixel_size[1];
+    }
+    else
+    {
+        geoloc_info->ul_corner.x = gmeta->proj_info.ul_corner[0];
+        geoloc_info->ul_corner.y = gmeta->proj_info.ul_corner[1];
+    }
+    geoloc_info->ul_corner_set = true;
+    
+    /* Projection related info */
+    geoloc_info->zone_set = false;
+    for (i = 0; i < NPROJ_PARAM; i++)
+        geoloc_info->proj_param[i] = 0.0;
+
+    switch (gmeta->proj_info.proj_type)
+    {
+        case GCTP_GEO_PROJ:
+            /* just use the already initialized zeros for the proj param */
+            break;
+
+        case GCTP_UTM_PROJ:
+            geoloc_info->zone = gmeta->proj_info.utm_zone;
+            geoloc_info->zone_set = true;
+            break;
+
+        case GCTP_ALBERS_PROJ:
+            geoloc_info->proj_param[2] = gmeta->proj_info.standard_parallel1;
+            geoloc_info->proj_param[3] = gmeta->proj_info.standard_parallel2;
+            geoloc_info->proj_param[4] = gmeta->proj_info.central_meridian;
+            geoloc_info->proj_param[5] = gmeta->proj_info.origin_latitude;
+            geoloc_info->proj_param[6] = gmeta->proj_info.false_easting;
+            geoloc_info->proj_param[7] = gmeta->proj_info.false_northing;
+            break;
+
+        case GCTP_PS_PROJ:
+            geoloc_info->proj_param[4] = gmeta->proj_info.longitude_pole;
+            geoloc_info->proj_param[5] = gmeta->proj_info.latitude_true_scale;
+            geoloc_info->proj_param[6] = gmeta->proj_info.false_easting;
+            geoloc_info->proj_param[7] = gmeta->proj_info.false_northing;
+            break;
+
+        case GCTP_SIN_PROJ:
+            geoloc_info->proj_param[0] = gmeta->proj_info.sphere_radius;
+            geoloc_info->proj_param[4] = gmeta->proj_info.central_meridian;
+            geoloc_info->proj_param[6] = gmeta->proj_info.false_easting;
+            geoloc_info->proj_param[7] = gmeta->proj_info.false_northing;
+            break;
+
+        default:
+            sprintf (errmsg, "Unsupported projection type (%d).  GEO "
+                "projection code (%d) or UTM projection code (%d) or "
+                "ALBERS projection code (%d) or PS projection code (%d) or "
+                "SIN projection code (%d) expected.",
+                gmeta->proj_info.proj_type, GCTP_GEO_PROJ, GCTP_UTM_PROJ,
+                GCTP_ALBERS_PROJ, GCTP_PS_PROJ, GCTP_SIN_PROJ);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+    }
+
+    /* Get the proper spheroid for the current datum
+       WGS84 datum <-- WGS84 spheroid, NAD27 datum <-- Clarke 86 spheroid,
+       NAD83 datum <-- GRS80 spheroid */
+    switch (gmeta->proj_info.datum_type)
+    {
+        case (ESPA_WGS84):
+            geoloc_info->spheroid = GCTP_WGS84;
+            break;
+        case (ESPA_NAD27):
+            geoloc_info->spheroid = GCTP_CLARKE_1866;
+            break;
+        case (ESPA_NAD83):
+            geoloc_info->spheroid = GCTP_GRS80;
+            break;
+        case (ESPA_NODATUM):
+            if (gmeta->proj_info.proj_type == GCTP_SIN_PROJ)
+                geoloc_info->spheroid = GCTP_MODIS_SPHERE;
+            else
+            {
+                sprintf (errmsg, "Unsupported datum/projection combination. "
+                    "NoDatum is currently only supported with Sinusoidal.");
+                error_handler (true, FUNC_NAME, errmsg);
+                return (false);
+            }
+            break;
+        default:
+            sprintf (errmsg, "Unsupported datum. Currently only WGS84, NAD27, "
+                "NAD83, and NODATUM (Sinusoidal) are supported.");
+            error_handler (true, FUNC_NAME, errmsg);
+            return (false);
+    }
+
+    /* Convert the orientation angle to radians */
+    geoloc_info->orientation_angle = gmeta->orientation_angle * RAD;
+ 
+    /* Successful completion */
+    return (true);
+}
+
+
+/******************************************************************************
+MODULE:  same_projection
+
+PURPOSE:  Compares two projection definitions from the XML metadata for
+equality, allowing for floating point noise in the projection parameters.
+
+RETURN VALUE:
+Type = bool
+Value      Description
+-----      -----------
+false      The projections differ
+true       The projections describe the same coordinate reference system
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+HISTORY:
+Date          Programmer       Reason
+----------    ---------------  -------------------------------------
+8/31/2026     Gail Schmidt     Original Development
+
+NOTES:
+1. Only the parameters which are meaningful for the projection type are
+   compared, matching the parameters get_geoloc_info feeds to GCTP.  The
+   corner coordinates are not compared, since two windows of the same
+   coordinate reference system should compare equal.
+2. Callers can use this to skip transform setup entirely when the input
+   and output coordinate reference systems match, which is the dominant
+   case for subsetting and tiling.
+******************************************************************************/
+bool same_projection
+(
+    const Espa_proj_meta_t *proj1,   /* I: first projection definition */
+    const Espa_proj_meta_t *proj2    /* I: second projection definition */
+)
+{
+    if (proj1->proj_type != proj2->proj_type ||
+        proj1->datum_type != proj2->datum_type ||
+        strcmp (proj1->units, proj2->units))
+        return (false);
+
+    switch (proj1->proj_type)
+    {
+        case GCTP_GEO_PROJ:
+            /* no projection parameters beyond the datum */
+            return (true);
+
+        case GCTP_UTM_PROJ:
+            return (proj1->utm_zone == proj2->utm_zone);
+
+        case GCTP_ALBERS_PROJ:
+            return (fabs (proj1->standard_parallel1 -
+                        proj2->standard_parallel1) < ESPA_EPSILON &&
+                    fabs (proj1->standard_parallel2 -
+                        proj2->standard_parallel2) < ESPA_EPSILON &&
+                    fabs (proj1->central_meridian -
+                        proj2->central_meridian) < ESPA_EPSILON &&
+                    fabs (proj1->origin_latitude -
+                        proj2->origin_latitude) < ESPA_EPSILON &&
+                    fabs (proj1->false_easting -
+                        proj2->false_easting) < ESPA_EPSILON &&
+                    fabs (proj1->false_northing -
+                        proj2->false_northing) < ESPA_EPSILON);
+
+        case GCTP_PS_PROJ:
+            return (fabs (proj1->longitude_pole -
+                        proj2->longitude_pole) < ESPA_EPSILON &&
+                    fabs (proj1->latitude_true_scale -
+                        proj2->latitude_true_scale) < ESPA_EPSILON &&
+                    fabs (proj1->false_easting -
+                        proj2->false_easting) < ESPA_EPSILON &&
+                    fabs (proj1->false_northing -
+                        proj2->false_northing) < ESPA_EPSILON);
+
+        case GCTP_SIN_PROJ:
+            return (fabs (proj1->sphere_radius -
+                        proj2->sphere_radius) < ESPA_EPSILON &&
+                    fabs (proj1->central_meridian -
+                        proj2->central_meridian) < ESPA_EPSILON &&
+                    fabs (proj1->false_easting -
+                        proj2->false_easting) < ESPA_EPSILON &&
+                    fabs (proj1->false_northing -
+                        proj2->false_northing) < ESPA_EPSILON);
+
+        default:
+            /* unknown projection types never compare equal */
+            return (false);
+    }
+}
+
+
+/******************************************************************************
+MODULE:  compute_edge_bounds
+
+PURPOSE:  Maps one edge of the image to lat/long and folds the mapped points
+into the bounding coordinates.  The edge is sampled at the specified stride,
+then the neighborhood of each sampled extreme is refined at full resolution.
+
+RETURN VALUE:
+Type = bool
+Value      Description
+-----      -----------
+false      Error occurred in the mapping
+true       Successfully updated the bounds for this edge
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+HISTORY:
+Date          Programmer       Reason
+----------    ---------------  -------------------------------------
+8/31/2026     Gail Schmidt     Original Development
+
+NOTES:
+1. A stride of 1 maps every point on the edge, which is exact for any
+   projection.  A stride larger than 1 assumes the projection varies smoothly
+   (monotonically between samples) along the edge so that the true extremes
+   fall within a stride of the sampled extremes, which holds for the
+   projections supported by setup_mapping.
+2. The edge points are gathered into contiguous arrays and mapped with a
+   single from_space_batch call per pass.
+******************************************************************************/
+static bool compute_edge_bounds
+(
+    Geoloc_t *space,          /* I: geolocation structure which contains the
+                                    information used for forward/inverse
+                                    mapping */
+    bool vary_samp,           /* I: true to vary the sample along the edge
+                                    with a fixed line; false to vary the line
+                                    with a fixed sample */
+    double fixed,             /* I: fixed line (or sample) coord of the edge */
+    int nedge,                /* I: last varying coordinate on the edge; the
+                                    edge covers 0 through nedge inclusive */
+    int stride,               /* I: sampling stride along the edge; 1 maps
+                                    every point */
+    Geo_bounds_t *bounds      /* I/O: bounding coords updated with this edge */
+)
+{
+    char FUNC_NAME[] = "compute_edge_bounds";  /* function name */
+    char errmsg[STR_SIZE];            /* error message */
+    Img_coord_float_t *img = NULL;    /* image coords for the edge pixels */
+    Geo_coord_t *geo = NULL;          /* geodetic coords for the edge pixels
+                                         (note radians) */
+    int *pos = NULL;                  /* edge position of each mapped point */
+    int npts;                         /* number of points mapped this pass */
+    int maxpts;                       /* size of the point arrays */
+    int i;                            /* looping variable */
+    int ip;                           /* current edge position */
+    int lo, hi;                       /* refinement range around an extreme */
+    int ext_pos[4];                   /* edge positions of the min/max lat and
+                                         min/max long from the sampled pass */
+    double lat, lon;                  /* current point in degrees */
+    bool certified;                   /* is the edge region certified for the
+                                         unchecked batch mapping? */
+
+    /* Allocate the arrays for the points along this edge; the refinement
+       pass maps fewer points than the sampled pass */
+    maxpts = nedge / stride + 2;
+    if (4 * 2 * stride > maxpts)
+        maxpts = 4 * 2 * stride;
+    img = calloc (maxpts, sizeof (Img_coord_float_t));
+    geo = calloc (maxpts, sizeof (Geo_coord_t));
+    pos = calloc (maxpts, sizeof (int));
+    if (img == NULL || geo == NULL || pos == NULL)
+    {
+        free (img);
+        free (geo);
+        free (pos);
+        sprintf (errmsg, "Allocating the coordinates for the edge pixels");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (false);
+    }
+
+    /* Certify the edge region once so the batch mappings can skip the
+       per-point validity checks */
+    certified = certify_from_space_region (space,
+        vary_samp ? fixed : 0.0, vary_samp ? 0.0 : fixed,
+        vary_samp ? fixed : (double) nedge,
+        vary_samp ? (double) nedge : fixed);
+
+    /* Gather the sampled points along the edge, always including both
+       endpoints */
+    npts = 0;
+    for (ip = 0; ip < nedge; ip += stride)
+        pos[npts++] = ip;
+    pos[npts++] = nedge;
+
+    for (i = 0; i < npts; i++)
+    {
+        img[i].l = vary_samp ? fixed : (double) pos[i];
+        img[i].s = vary_samp ? (double) pos[i] : fixed;
+        img[i].is_fill = false;
+    }
+
+    /* Convert the sampled edge points to lat/long space in one batch,
+       skipping the per-point validity checks when the edge is certified */
+    if (certified)
+        from_space_batch_unchecked (space, npts, img, geo);
+    else if (!from_space_batch (space, npts, img, geo))
+    {
+        free (img);
+        free (geo);
+        free (pos);
+        sprintf (errmsg, "Mapping an edge of the image to lat/long");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (false);
+    }
+
+    /* Fold the sampled points into the bounds, tracking where each extreme
+       was found for the refinement pass */
+    ext_pos[0] = ext_pos[1] = ext_pos[2] = ext_pos[3] = pos[0];
+    for (i = 0; i < npts; i++)
+    {
+        lat = geo[i].lat * DEG;
+        lon = geo[i].lon * DEG;
+        if (lat > bounds->max_lat)
+        {
+            bounds->max_lat = lat;
+            ext_pos[0] = pos[i];
+        }
+        if (lat < bounds->min_lat)
+        {
+            bounds->min_lat = lat;
+            ext_pos[1] = pos[i];
+        }
+        if (lon > bounds->max_lon)
+        {
+            bounds->max_lon = lon;
+            ext_pos[2] = pos[i];
+        }
+        if (lon < bounds->min_lon)
+        {
+            bounds->min_lon = lon;
+            ext_pos[3] = pos[i];
+        }
+    }
+
+    /* If every point was mapped then there is nothing to refine */
+    if (stride <= 1)
+    {
+        free (img);
+        free (geo);
+        free (pos);
+        return (true);
+    }
+
+    /* Gather the unsampled points within a stride of each sampled extreme */
+    npts = 0;
+    for (i = 0; i < 4; i++)
+    {
+        lo = ext_pos[i] - (stride - 1);
+        if (lo < 0)
+            lo = 0;
+        hi = ext_pos[i] + (stride - 1);
+        if (hi > nedge)
+            hi = nedge;
+        for (ip = lo; ip <= hi; ip++)
+        {
+            if (ip % stride == 0 || ip == nedge)
+                continue;  /* already mapped in the sampled pass */
+            img[npts].l = vary_samp ? fixed : (double) ip;
+            img[npts].s = vary_samp ? (double) ip : fixed;
+            img[npts].is_fill = false;
+            npts++;
+        }
+    }
+
+    /* Convert the refinement points to lat/long space and fold them into
+       the bounds */
+    if (npts > 0)
+    {
+        if (certified)
+            from_space_batch_unchecked (space, npts, img, geo);
+        else if (!from_space_batch (space, npts, img, geo))
+        {
+            free (img);
+            free (geo);
+            free (pos);
+            sprintf (errmsg, "Refining an edge of the image to lat/long");
+            error_handler (true, FUNC_NAME, errmsg);
+            return (false);
+        }
+
+        for (i = 0; i < npts; i++)
+        {
+            bounds->max_lat = max (bounds->max_lat, geo[i].lat*DEG);
+            bounds->min_lat = min (bounds->min_lat, geo[i].lat*DEG);
+            bounds->max_lon = max (bounds->max_lon, geo[i].lon*DEG);
+            bounds->min_lon = min (bounds->min_lon, geo[i].lon*DEG);
+        }
+    }
+
+    /* Free the edge point arrays */
+    free (img);
+    free (geo);
+    free (pos);
+
+    /* Successful completion */
+    return (true);
+}
+
+
+/******************************************************************************
+MODULE:  compute_bounds_sampled
+
+PURPOSE:  Computes the boundary corners of the output image, sampling the
+image perimeter at the specified stride.  For ascending scenes and scenes in
+the polar regions, the scenes are flipped upside down.  The bounding coords
+will be correct in North represents the northernmost latitude and South
+represents the southernmost latitude.  However, the UL corner in this case
+would be more south than the LR corner.  Comparing the UL and LR corners will
+allow the user to determine if the scene is flipped.
+
+RETURN VALUE:
+Type = bool
+Value      Description
+-----      -----------
+false      Error occurred in the computation or mapping
+true       Successfully computed the image bounds
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+HISTORY:
+Date          Programmer       Reason
+----------    ---------------  -------------------------------------
+8/31/2026     Gail Schmidt     Original Development, pulled from
+                               compute_bounds and reworked to map each edge
+                               with the batch inverse mapping
+
+NOTES:
+1. This assumes the setup mapping was setup using the UL of the UL pixel.
+   It then maps the outer edges of each pixel around the outer edges of the
+   entire image.
+2. A stride of 1 maps every perimeter point, matching the original
+   compute_bounds behavior for any projection.  A larger stride samples the
+   perimeter and refines around the sampled extremes, which is much faster
+   for large images and is accurate for projections which vary smoothly
+   along the image edges.
+******************************************************************************/
+bool compute_bounds_sampled
+(
+    Geoloc_t *space,          /* I: geolocation structure which contains the
+                                    information used for forward/inverse
+                                    mapping */
+    int nlines,               /* I: number of lines in the scene */
+    int nsamps,               /* I: number of samples in the scene */
+    int stride,               /* I: sampling stride along the image edges;
+                                    1 maps every perimeter point */
+    Geo_bounds_t *bounds      /* O: output boundary for the scene */
+)
+{
+    char FUNC_NAME[] = "compute_bounds_sampled";  /* function name */
+    char errmsg[STR_SIZE];            /* error message */
+    Img_coord_float_t img;            /* image coordinates for current pixel */
+    Geo_coord_t geo;                  /* geodetic coordinates (note radians) */
+
+    /* Make sure the stride is sensible */
+    if (stride < 1)
+        stride = 1;
+
+    /* Initialize the bounding coordinates with the upper left of the UL
+       corner */
+    img.l = 0.0;
+    img.s = 0.0;
+    img.is_fill = false;
+    if (!from_space (space, &img, &geo))
+    {
+        sprintf (errmsg, "Mapping line, sample pixel to lat/long");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (false);
+    }
+
+    bounds->max_lat = geo.lat * DEG;
+    bounds->min_lat = geo.lat * DEG;
+    bounds->max_lon = geo.lon * DEG;
+    bounds->min_lon = geo.lon * DEG;
+
+    /* Determine the bounding coords from the edges of the image in line,
+       sample space. Remember that the to/from space mappings are initialized
+       using the UL of the UL corner of the image. Thus we need to go an extra
+       pixel to the right and bottom of the image to get the true outer
+       extents. */
+    /** top -- go to (nsamps-1) + 1 to get to the far right edge of the
+        image **/
+    if (!compute_edge_bounds (space, true, 0.0, nsamps, stride, bounds))
+    {
+        sprintf (errmsg, "Mapping top line of the image to lat/long");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (false);
+    }
+
+    /** bottom -- nlines is actually (nlines-1) + 1 to get to the very bottom
+        edge of the image **/
+    if (!compute_edge_bounds (space, true, (double) nlines, nsamps, stride,
+        bounds))
+    {
+        sprintf (errmsg, "Mapping bottom line of the image to lat/long");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (false);
+    }
+
+    /** left -- go to (nlines-1) + 1 to get to the bottom edge of the image **/
+    if (!compute_edge_bounds (space, false, 0.0, nlines, stride, bounds))
+    {
+        sprintf (errmsg, "Mapping left edge of the image to lat/long");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (false);
+    }
+
+    /** right -- nsamps is actually (nsamps-1) + 1 to get to the far right
+        edge of the image **/
+    if (!compute_edge_bounds (space, false, (double) nsamps, nlines, stride,
+        bounds))
+    {
+        sprintf (errmsg, "Mapping right edge of the image to lat/long");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (false);
+    }
+
+    /* Successful completion */
+    return (true);
+}
+
+
+/******************************************************************************
+MODULE:  compute_bounds
+
+PURPOSE:  Computes the boundary corners of the output image.  For ascending
+scenes and scenes in the polar regions, the scenes are flipped upside down.
+The bounding coords will be correct in North represents the northernmost
+latitude and South represents the southernmost latitude.  However, the UL
+corner in this case would be more south than the LR corner.  Comparing the UL
+and LR corners will allow the user to determine if the scene is flipped.
+
+RETURN VALUE:
+Type = bool
+Value      Description
+-----      -----------
+false      Error occurred in the computation or mapping
+true       Successfully computed the image bounds
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+HISTORY:
+Date          Programmer       Reason
+----------    ---------------  -------------------------------------
+1/23/2014     Gail Schmidt     Original Development (based on input routines
+                               from the LEDAPS lndsr application)
+8/31/2026     Gail Schmidt     Map the edges of the image with the batch
+                               inverse mapping instead of one point per call
+
+NOTES:
+1. Memory is allocated for the Geoloc_t pointer.  It is up to the calling
+   routine to free the memory for this pointer.
+2. This assumes the setup mapping was setup using the UL of the UL pixel.
+   It then loops around the outer edges of each pixel as it loops around the
+   outer edges of the entire image.
+3. This maps every perimeter point; callers working with a projection known
+   to vary smoothly along the image edges can use compute_bounds_sampled
+   with a larger stride to map far fewer points.
+******************************************************************************/
+bool compute_bounds
+(
+    Geoloc_t *space,          /* I: geolocation structure which contains the
+                                    information used for forward/inverse
+                                    mapping */
+    int nlines,               /* I: number of lines in the scene */
+    int nsamps,               /* I: number of samples in the scene */
+    Geo_bounds_t *bounds      /* O: output boundary for the scene */
+)
+{
+    return (compute_bounds_sampled (space, nlines, nsamps, 1, bounds));
+}
+
+
+/******************************************************************************
+MODULE:  eval_edge_coord (static function)
+
+PURPOSE:  Evaluates the latitude or longitude (in degrees) at a continuous
+position along an image edge.
+
+RETURN VALUE:
+Type = bool
+Value      Description
+-----      -----------
+false      Error occurred in the mapping
+true       Successfully evaluated the coordinate
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+HISTORY:
+Date          Programmer       Reason
+----------    ---------------  -------------------------------------
+8/31/2026     Gail Schmidt     Original Development
+
+NOTES:
+******************************************************************************/
+static bool eval_edge_coord
+(
+    Geoloc_t *space,          /* I: geolocation structure which contains the
+                                    information used for forward/inverse
+                                    mapping */
+    bool vary_samp,           /* I: true to vary the sample along the edge
+                                    with a fixed line; false to vary the line
+                                    with a fixed sample */
+    double fixed,             /* I: fixed line (or sample) coord of the edge */
+    double t,                 /* I: varying coordinate along the edge */
+    bool want_lat,            /* I: true to evaluate the latitude; false to
+                                    evaluate the longitude */
+    double *value             /* O: latitude or longitude in degrees */
+)
+{
+    Img_coord_float_t img;    /* image coordinates for the point */
+    Geo_coord_t geo;          /* geodetic coordinates (note radians) */
+
+    img.l = vary_samp ? fixed : t;
+    img.s = vary_samp ? t : fixed;
+    img.is_fill = false;
+    if (!from_space (space, &img, &geo))
+        return (false);
+
+    *value = (want_lat ? geo.lat : geo.lon) * DEG;
+    return (true);
+}
+
+
+/******************************************************************************
+MODULE:  refine_edge_extreme (static function)
+
+PURPOSE:  Refines one geographic extreme along an image edge with a
+golden-section search over the bracket around the best coarse sample.
+
+RETURN VALUE:
+Type = bool
+Value      Description
+-----      -----------
+false      Error occurred in the mapping
+true       Successfully refined the extreme
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+HISTORY:
+Date          Programmer       Reason
+----------    ---------------  -------------------------------------
+8/31/2026     Gail Schmidt     Original Development
+
+NOTES:
+1. The search assumes the coordinate is unimodal within the bracket, which
+   holds for the smooth projections accepted by compute_bounds_analytic
+   when the bracket spans a single coarse sampling interval.
+2. The bracket shrinks by the golden ratio per evaluation, so refining to
+   a hundredth of a pixel costs a few dozen transform evaluations no matter
+   how large the image is.
+******************************************************************************/
+static bool refine_edge_extreme
+(
+    Geoloc_t *space,          /* I: geolocation structure which contains the
+                                    information used for forward/inverse
+                                    mapping */
+    bool vary_samp,           /* I: true to vary the sample along the edge
+                                    with a fixed line; false to vary the line
+                                    with a fixed sample */
+    double fixed,             /* I: fixed line (or sample) coord of the edge */
+    double lo,                /* I: low end of the search bracket */
+    double hi,                /* I: high end of the search bracket */
+    bool want_lat,            /* I: true to refine the latitude; false to
+                                    refine the longitude */
+    double sign,              /* I: 1.0 to refine a maximum; -1.0 to refine
+                                    a minimum */
+    double *extreme           /* I/O: extreme value in degrees, updated if a
+                                    better value is found in the bracket */
+)
+{
+    const double invphi = 0.6180339887498949;  /* 1/golden ratio */
+    double a = lo;            /* low end of the shrinking bracket */
+    double b = hi;            /* high end of the shrinking bracket */
+    double c, d;              /* interior probe positions */
+    double fc, fd;            /* signed coordinate at the probe positions */
+    double value;             /* coordinate at the current probe */
+
+    c = b - invphi * (b - a);
+    d = a + invphi * (b - a);
+    if (!eval_edge_coord (space, vary_samp, fixed, c, want_lat, &value))
+        return (false);
+    fc = sign * value;
+    if (!eval_edge_coord (space, vary_samp, fixed, d, want_lat, &value))
+        return (false);
+    fd = sign * value;
+
+    /* Shrink the bracket around the extreme to a hundredth of a pixel */
+    while (b - a > 0.01)
+    {
+        if (fc > fd)
+        {
+            b = d;
+            d = c;
+            fd = fc;
+            c = b - invphi * (b - a);
+            if (!eval_edge_coord (space, vary_samp, fixed, c, want_lat,
+                &value))
+                return (false);
+            fc = sign * value;
+        }
+        else
+        {
+            a = c;
+            c = d;
+            fc = fd;
+            d = a + invphi * (b - a);
+            if (!eval_edge_coord (space, vary_samp, fixed, d, want_lat,
+                &value))
+                return (false);
+            fd = sign * value;
+        }
+    }
+
+    /* Fold the refined extreme into the running value */
+    value = sign * ((fc > fd) ? fc : fd);
+    if (sign > 0.0)
+    {
+        if (value > *extreme)
+            *extreme = value;
+    }
+    else
+    {
+        if (value < *extreme)
+            *extreme = value;
+    }
+
+    return (true);
+}
+
+
+/******************************************************************************
+MODULE:  compute_bounds_edge_analytic (static function)
+
+PURPOSE:  Folds the geographic extrema of one image edge into the bounds,
+coarsely sampling the edge and refining each extreme with a golden-section
+search instead of mapping every perimeter point.
+
+RETURN VALUE:
+Type = bool
+Value      Description
+-----      -----------
+false      Error occurred in the computation or mapping
+true       Successfully computed the edge extrema
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+HISTORY:
+Date          Programmer       Reason
+----------    ---------------  -------------------------------------
+8/31/2026     Gail Schmidt     Original Development
+
+NOTES:
+******************************************************************************/
+static bool compute_bounds_edge_analytic
+(
+    Geoloc_t *space,          /* I: geolocation structure which contains the
+                                    information used for forward/inverse
+                                    mapping */
+    bool vary_samp,           /* I: true to vary the sample along the edge
+                                    with a fixed line; false to vary the line
+                                    with a fixed sample */
+    double fixed,             /* I: fixed line (or sample) coord of the edge */
+    int nedge,                /* I: last varying coordinate on the edge; the
+                                    edge covers 0 through nedge inclusive */
+    Geo_bounds_t *bounds      /* I/O: bounding coords updated with this edge */
+)
+{
+    char FUNC_NAME[] = "compute_bounds_edge_analytic";  /* function name */
+    char errmsg[STR_SIZE];            /* error message */
+    Img_coord_float_t img[BOUNDS_EDGE_SAMPLES];  /* sampled edge points */
+    Geo_coord_t geo[BOUNDS_EDGE_SAMPLES];  /* geodetic coords for the sampled
+                                         points (note radians) */
+    double pos[BOUNDS_EDGE_SAMPLES];  /* edge position of each sampled point */
+    double ext_pos[4];                /* edge positions of the max/min lat and
+                                         max/min long from the sampled pass */
+    double step;                      /* spacing of the sampled points */
+    double lat, lon;                  /* current point in degrees */
+    double lo, hi;                    /* refinement bracket for an extreme */
+    int npts;                         /* number of sampled points */
+    int i;                            /* looping variable */
+    bool certified;                   /* is the edge region certified for the
+                                         unchecked batch mapping? */
+
+    /* Certify the edge region once so the batch mapping can skip the
+       per-point validity checks */
+    certified = certify_from_space_region (space,
+        vary_samp ? fixed : 0.0, vary_samp ? 0.0 : fixed,
+        vary_samp ? fixed : (double) nedge,
+        vary_samp ? (double) nedge : fixed);
+
+    /* Coarsely sample the edge, always including both endpoints */
+    npts = BOUNDS_EDGE_SAMPLES;
+    if (npts > nedge + 1)
+        npts = nedge + 1;
+    step = (npts > 1) ? (double) nedge / (npts - 1) : 0.0;
+    for (i = 0; i < npts; i++)
+    {
+        pos[i] = i * step;
+        img[i].l = vary_samp ? fixed : pos[i];
+        img[i].s = vary_samp ? pos[i] : fixed;
+        img[i].is_fill = false;
+    }
+
+    /* Convert the sampled edge points to lat/long space in one batch,
+       skipping the per-point validity checks when the edge is certified */
+    if (certified)
+        from_space_batch_unchecked (space, npts, img, geo);
+    else if (!from_space_batch (space, npts, img, geo))
+    {
+        sprintf (errmsg, "Mapping an edge of the image to lat/long");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (false);
+    }
+
+    /* Fold the sampled points into the bounds, tracking where each extreme
+       was found for the refinement searches */
+    ext_pos[0] = ext_pos[1] = ext_pos[2] = ext_pos[3] = pos[0];
+    for (i = 0; i < npts; i++)
+    {
+        lat = geo[i].lat * DEG;
+        lon = geo[i].lon * DEG;
+        if (lat > bounds->max_lat)
+        {
+            bounds->max_lat = lat;
+            ext_pos[0] = pos[i];
+        }
+        if (lat < bounds->min_lat)
+        {
+            bounds->min_lat = lat;
+            ext_pos[1] = pos[i];
+        }
+        if (lon > bounds->max_lon)
+        {
+            bounds->max_lon = lon;
+            ext_pos[2] = pos[i];
+        }
+        if (lon < bounds->min_lon)
+        {
+            bounds->min_lon = lon;
+            ext_pos[3] = pos[i];
+        }
+    }
+
+    /* Refine each extreme with a golden-section search over the sampling
+       interval around the best sample */
+    for (i = 0; i < 4; i++)
+    {
+        lo = ext_pos[i] - step;
+        if (lo < 0.0)
+            lo = 0.0;
+        hi = ext_pos[i] + step;
+        if (hi > (double) nedge)
+            hi = (double) nedge;
+        if (hi - lo < 0.01)
+            continue;
+
+        if (!refine_edge_extreme (space, vary_samp, fixed, lo, hi,
+            (i < 2), (i % 2 == 0) ? 1.0 : -1.0,
+            (i == 0) ? &bounds->max_lat :
+            (i == 1) ? &bounds->min_lat :
+            (i == 2) ? &bounds->max_lon : &bounds->min_lon))
+        {
+            sprintf (errmsg, "Refining an edge extreme to lat/long");
+            error_handler (true, FUNC_NAME, errmsg);
+            return (false);
+        }
+    }
+
+    return (true);
+}
+
+
+/******************************************************************************
+MODULE:  compute_bounds_analytic
+
+PURPOSE:  Computes the boundary corners of the output image for the standard
+smooth projections by refining the geographic extrema along each image edge
+with a golden-section search over a handful of transform evaluations, instead
+of mapping every perimeter point.  Projections not known to vary smoothly
+along the image edges fall back to the full perimeter walk.
+
+RETURN VALUE:
+Type = bool
+Value      Description
+-----      -----------
+false      Error occurred in the computation or mapping
+true       Successfully computed the image bounds
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+HISTORY:
+Date          Programmer       Reason
+----------    ---------------  -------------------------------------
+8/31/2026     Gail Schmidt     Original Development
+
+NOTES:
+1. This assumes the setup mapping was setup using the UL of the UL pixel,
+   and covers the outer edges of each pixel around the outer edges of the
+   entire image, matching compute_bounds.
+2. The geographic coordinates vary smoothly and monotonically between the
+   coarse samples for the geographic, UTM, Albers, Polar Stereographic, and
+   sinusoidal projections, so the true extrema fall within one sampling
+   interval of the sampled extremes and the golden-section refinement
+   recovers them to a hundredth of a pixel.  Any other projection falls
+   back to compute_bounds, which maps every perimeter point.
+******************************************************************************/
+bool compute_bounds_analytic
+(
+    Geoloc_t *space,          /* I: geolocation structure which contains the
+                                    information used for forward/inverse
+                                    mapping */
+    int nlines,               /* I: number of lines in the scene */
+    int nsamps,               /* I: number of samples in the scene */
+    Geo_bounds_t *bounds      /* O: output boundary for the scene */
+)
+{
+    char FUNC_NAME[] = "compute_bounds_analytic";  /* function name */
+    char errmsg[STR_SIZE];            /* error message */
+    Img_coord_float_t img;            /* image coordinates for the UL pixel */
+    Geo_coord_t geo;                  /* geodetic coordinates (note radians) */
+
+    /* Fall back to walking the perimeter for projections whose edges aren't
+       known to vary smoothly */
+    switch (space->def.proj_num)
+    {
+        case GCTP_GEO_PROJ:
+        case GCTP_UTM_PROJ:
+        case GCTP_ALBERS_PROJ:
+        case GCTP_PS_PROJ:
+        case GCTP_SIN_PROJ:
+            break;
+        default:
+            return (compute_bounds (space, nlines, nsamps, bounds));
+    }
+
+    /* Initialize the bounding coordinates with the upper left of the UL
+       corner */
+    img.l = 0.0;
+    img.s = 0.0;
+    img.is_fill = false;
+    if (!from_space (space, &img, &geo))
+    {
+        sprintf (errmsg, "Mapping line, sample pixel to lat/long");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (false);
+    }
+
+    bounds->max_lat = geo.lat * DEG;
+    bounds->min_lat = geo.lat * DEG;
+    bounds->max_lon = geo.lon * DEG;
+    bounds->min_lon = geo.lon * DEG;
+
+    /* Fold in the extrema of each of the four edges; as in compute_bounds,
+       the edges run an extra pixel to the right and bottom of the image to
+       cover the true outer extents */
+    if (!compute_bounds_edge_analytic (space, true, 0.0, nsamps, bounds) ||
+        !compute_bounds_edge_analytic (space, true, (double) nlines, nsamps,
+            bounds) ||
+        !compute_bounds_edge_analytic (space, false, 0.0, nlines, bounds) ||
+        !compute_bounds_edge_analytic (space, false, (double) nsamps, nlines,
+            bounds))
+    {
+        sprintf (errmsg, "Computing the analytic bounds of an image edge");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (false);
+    }
+
+    /* Successful completion */
+    return (true);
+}
+
+
+/******************************************************************************
+MODULE:  update_geo_window_bounds
+
+PURPOSE:  Recomputes the geographic corner and bounding coordinates of a
+product from its projection information, after the projection corners have
+been shifted arithmetically to a pixel-aligned window.  The window subsets
+themselves never need a transform -- the new projection corners follow from
+the pixel size and the window offsets -- so the inverse mapping is only set
+up here, when the tight geographic coordinates are actually requested.
+
+RETURN VALUE:
+Type = bool
+Value      Description
+-----      -----------
+false      Error occurred in the computation or mapping
+true       Successfully updated the geographic coordinates
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+HISTORY:
+Date          Programmer       Reason
+----------    ---------------  -------------------------------------
+8/31/2026     Gail Schmidt     Original Development
+
+NOTES:
+1. The corners are mapped at the center of the UL and LR pixels, matching
+   the corner convention of the converters; the bounding coordinates cover
+   the outer edges of the image via compute_bounds_analytic.
+******************************************************************************/
+bool update_geo_window_bounds
+(
+    Espa_internal_meta_t *xml_metadata  /* I/O: XML metadata whose geographic
+                                    corner and bounding coordinates are to be
+                                    recomputed from its projection info */
+)
+{
+    char FUNC_NAME[] = "update_geo_window_bounds";  /* function name */
+    char errmsg[STR_SIZE];            /* error message */
+    Espa_global_meta_t *gmeta = &xml_metadata->global;  /* global metadata */
+    Space_def_t geoloc_def;           /* geolocation space information */
+    Geoloc_t *geoloc_map = NULL;      /* geolocation mapping information */
+    Geo_bounds_t bounds;              /* geographic bounding coordinates */
+    Img_coord_float_t img;            /* image coordinates for the corner */
+    Geo_coord_t geo;                  /* geodetic coordinates (radians) */
+
+    /* Get the geolocation information from the XML structure and set up
+       the inverse mapping */
+    if (!get_geoloc_info (xml_metadata, &geoloc_def))
+    {
+        sprintf (errmsg, "Copying the geolocation information from the XML "
+            "metadata structure.");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (false);
+    }
+
+    geoloc_map = setup_mapping (&geoloc_def);
+    if (geoloc_map == NULL)
+    {
+        sprintf (errmsg, "Setting up the geolocation mapping structure.");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (false);
+    }
+
+    /* Get the geographic coords for the center of the UL pixel */
+    img.l = 0.0;
+    img.s = 0.0;
+    img.is_fill = false;
+    if (!from_space (geoloc_map, &img, &geo))
+    {
+        sprintf (errmsg, "Mapping UL corner to lat/long");
+        error_handler (true, FUNC_NAME, errmsg);
+        free (geoloc_map);
+        return (false);
+    }
+    gmeta->ul_corner[0] = geo.lat * DEG;
+    gmeta->ul_corner[1] = geo.lon * DEG;
+
+    /* Get the geographic coords for the center of the LR pixel */
+    img.l = xml_metadata->band[0].nlines - 1;
+    img.s = xml_metadata->band[0].nsamps - 1;
+    img.is_fill = false;
+    if (!from_space (geoloc_map, &img, &geo))
+    {
+        sprintf (errmsg, "Mapping LR corner to lat/long");
+        error_handler (true, FUNC_NAME, errmsg);
+        free (geoloc_map);
+        return (false);
+    }
+    gmeta->lr_corner[0] = geo.lat * DEG;
+    gmeta->lr_corner[1] = geo.lon * DEG;
+
+    /* Compute the geographic bounds of the image */
+    if (!compute_bounds_analytic (geoloc_map, xml_metadata->band[0].nlines,
+        xml_metadata->band[0].nsamps, &bounds))
+    {
+        sprintf (errmsg, "Computing the geographic bounds of the window.");
+        error_handler (true, FUNC_NAME, errmsg);
+        free (geoloc_map);
+        return (false);
+    }
+    gmeta->bounding_coords[ESPA_WEST] = bounds.min_lon;
+    gmeta->bounding_coords[ESPA_EAST] = bounds.max_lon;
+    gmeta->bounding_coords[ESPA_NORTH] = bounds.max_lat;
+    gmeta->bounding_coords[ESPA_SOUTH] = bounds.min_lat;
+
+    /* Free the geolocation structure */
+    free (geoloc_map);
+
+    return (true);
+}
+
+
+/******************************************************************************
+MODULE:  compute_grid_nodes (static function)
+
+PURPOSE:  Computes the exact geodetic coordinates at the nodes of a
+geolocation grid using the batch inverse mapping.
+
+RETURN VALUE:
+Type = bool
+Value      Description
+-----      -----------
+false      Error occurred in the mapping
+true       Successfully computed the grid nodes
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+HISTORY:
+Date          Programmer       Reason
+----------    ---------------  -------------------------------------
+8/31/2026     Gail Schmidt     Original Development
+
+NOTES:
+1. The nodes along the bottom and right of the grid are clamped to the image
+   extent so the grid exactly covers the image without extrapolation, even
+   when the image size isn't a multiple of the grid stride.
+******************************************************************************/
+static bool compute_grid_nodes
+(
+    Geoloc_t *space,          /* I: geolocation structure which contains the
+                                    information used for forward/inverse
+                                    mapping */
+    Geoloc_grid_t *grid       /* I/O: grid to compute the node lat/longs for */
+)
+{
+    char FUNC_NAME[] = "compute_grid_nodes";  /* function name */
+    char errmsg[STR_SIZE];    /* error message */
+    Img_coord_float_t *img = NULL;  /* image coordinates of the grid nodes */
+    Geo_coord_t *geo = NULL;  /* geodetic coordinates of the grid nodes */
+    int nnodes;               /* total number of nodes in the grid */
+    int il;                   /* node counter in the line direction */
+    int is;                   /* node counter in the sample direction */
+    int indx;                 /* index of the current node */
+
+    /* Allocate arrays for mapping all of the grid nodes in one batch call */
+    nnodes = grid->grid_nlines * grid->grid_nsamps;
+    img = calloc (nnodes, sizeof (Img_coord_float_t));
+    if (img == NULL)
+    {
+        sprintf (errmsg, "Allocating memory for the grid node image "
+            "coordinates");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (false);
+    }
+
+    geo = calloc (nnodes, sizeof (Geo_coord_t));
+    if (geo == NULL)
+    {
+        sprintf (errmsg, "Allocating memory for the grid node geodetic "
+            "coordinates");
+        error_handler (true, FUNC_NAME, errmsg);
+        free (img);
+        return (false);
+    }
+
+    /* Set up the image coordinates of the grid nodes, clamping the last node
+       in each direction to the image extent */
+    indx = 0;
+    for (il = 0; il < grid->grid_nlines; il++)
+    {
+        for (is = 0; is < grid->grid_nsamps; is++, indx++)
+        {
+            img[indx].l = min (il * grid->stride, grid->nlines);
+            img[indx].s = min (is * grid->stride, grid->nsamps);
+            img[indx].is_fill = false;
+        }
+    }
+
+    /* Map the grid nodes to geodetic coordinates */
+    if (!from_space_batch (space, nnodes, img, geo))
+    {
+        sprintf (errmsg, "Mapping the grid nodes to lat/long");
+        error_handler (true, FUNC_NAME, errmsg);
+        free (img);
+        free (geo);
+        return (false);
+    }
+
+    /* Store the node lat/longs in the grid, checking for a longitude
+       discontinuity between neighboring nodes which indicates the scene
+       crosses the international date line and can't be interpolated */
+    for (indx = 0; indx < nnodes; indx++)
+    {
+        grid->lat[indx] = geo[indx].lat;
+        grid->lon[indx] = geo[indx].lon;
+
+        if ((indx % grid->grid_nsamps != 0 &&
+             fabs (grid->lon[indx] - grid->lon[indx-1]) > PI) ||
+            (indx >= grid->grid_nsamps &&
+             fabs (grid->lon[indx] - grid->lon[indx-grid->grid_nsamps]) > PI))
+        {
+            sprintf (errmsg, "Scene crosses the international date line, "
+                "which is not supported by the geolocation grid.  Use the "
+                "exact inverse mapping instead.");
+            error_handler (true, FUNC_NAME, errmsg);
+            free (img);
+            free (geo);
+            return (false);
+        }
+    }
+
+    free (img);
+    free (geo);
 
-RETURN VALUE: N/A
+    /* Successful completion */
+    return (true);
+}
+
+
+/******************************************************************************
+MODULE:  grid_from_space
+
+PURPOSE:  Maps a point from line, sample space to geodetic coordinates by
+bilinear interpolation within a precomputed geolocation grid.
+
+RETURN VALUE:
 Type = bool
 Value      Description
 -----      -----------
-false      Error occurred getting geolocation information
-true       Successfully obtained geolocation information
+false      Error occurred in the mapping
+true       Successful mapping
 
 PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
 at the USGS EROS
@@ -374,172 +2127,97 @@ at the USGS EROS
 HISTORY:
 Date          Programmer       Reason
 ----------    ---------------  -------------------------------------
-1/23/2014     Gail Schmidt     Original Development
-5/7/2014      Gail Schmidt     Modify to use the first band if band1 is not
-                               available
-7/22/2014     Gail Schmidt     Initialized orientation angle, since it wasn't
-                               being initialized correctly from the XML meta
+8/31/2026     Gail Schmidt     Original Development
 
 NOTES:
-1. Make sure UL corner pixel is UL corner of the pixel, since that's what
-   setup_mapping expects.
+1. Report image coordinates for the UL corner of the pixel.
+2. This is much faster than from_space since it does no projection math, at
+   the cost of the interpolation error which setup_geoloc_grid verifies
+   against the caller's tolerance.
 ******************************************************************************/
-bool get_geoloc_info
+bool grid_from_space
 (
-    Espa_internal_meta_t *xml_metadata, /* I: XML metadata information */
-    Space_def_t *geoloc_info            /* O: geolocation space information */
+    Geoloc_grid_t *grid,     /* I: geolocation grid from setup_geoloc_grid */
+    Img_coord_float_t *img,  /* I: image coordinates (for UL corner of pixel) */
+    Geo_coord_t *geo         /* O: geodetic coordinates (radians) */
 )
 {
-    char FUNC_NAME[] = "get_geoloc_info"; /* function name */
-    char errmsg[STR_SIZE];                /* error message */
-    int i;                                /* looping variable */
-    int refl_indx = -99;                  /* index of band1 or first band */
-    Espa_global_meta_t *gmeta=&xml_metadata->global;  /* global metadata */
-
-    /* Use 'band1' band-related metadata for the reflectance information for
-       Landsat.  If band1 isn't available then just use the first band in the
-       XML file (for MODIS and others). */
-    for (i = 0; i < xml_metadata->nbands; i++)
-    {
-        if (!strcmp (xml_metadata->band[i].name, "band1") &&
-            !strncmp (xml_metadata->band[i].product, "L1", 2))  /* L1G or L1T */
-        {
-            /* this is the index we'll use for Landsat band info */
-            refl_indx = i;
-        }
-    }
-    if (refl_indx == -99)
-        refl_indx = 0;
-
-    /* Copy the information from the XML file */
-    geoloc_info->proj_num = gmeta->proj_info.proj_type;
-    geoloc_info->pixel_size[0] = xml_metadata->band[refl_indx].pixel_size[0];
-    geoloc_info->pixel_size[1] = xml_metadata->band[refl_indx].pixel_size[1];
-    geoloc_info->img_size.l = xml_metadata->band[refl_indx].nlines;
-    geoloc_info->img_size.s = xml_metadata->band[refl_indx].nsamps;
+    char FUNC_NAME[] = "grid_from_space";  /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    int il;                  /* grid cell index in the line direction */
+    int is;                  /* grid cell index in the sample direction */
+    int indx;                /* index of the UL node of the grid cell */
+    double l0, s0;           /* image coordinates of the UL node of the cell */
+    double l1, s1;           /* image coordinates of the LR node of the cell */
+    double fl, fs;           /* interpolation fractions in line and sample */
+    double wul, wur, wll, wlr;  /* bilinear interpolation weights */
 
-    /* If the grid origin is center, then adjust for the resolution.  The
-       corners will be written for the UL of the corner. */
-    if (!strcmp (gmeta->proj_info.grid_origin, "CENTER"))
-    {
-        geoloc_info->ul_corner.x = gmeta->proj_info.ul_corner[0] -
-            0.5 * xml_metadata->band[refl_indx].pixel_size[0];
-        geoloc_info->ul_corner.y = gmeta->proj_info.ul_corner[1] +
-            0.5 * xml_metadata->band[refl_indx].pixel_size[1];
-    }
-    else
+    /* If this coordinate is fill then skip */
+    geo->is_fill = true;
+    if (img->is_fill)
     {
-        geoloc_info->ul_corner.x = gmeta->proj_info.ul_corner[0];
-        geoloc_info->ul_corner.y = gmeta->proj_info.ul_corner[1];
+        sprintf (errmsg, "Inverse mapping called with line, sample coordinate "
+            "that is fill.");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (false);
     }
-    geoloc_info->ul_corner_set = true;
-    
-    /* Projection related info */
-    geoloc_info->zone_set = false;
-    for (i = 0; i < NPROJ_PARAM; i++)
-        geoloc_info->proj_param[i] = 0.0;
 
-    switch (gmeta->proj_info.proj_type)
+    /* Verify the point falls within the grid */
+    if (img->l < 0.0 || img->l > grid->nlines ||
+        img->s < 0.0 || img->s > grid->nsamps)
     {
-        case GCTP_GEO_PROJ:
-            /* just use the already initialized zeros for the proj param */
-            break;
-
-        case GCTP_UTM_PROJ:
-            geoloc_info->zone = gmeta->proj_info.utm_zone;
-            geoloc_info->zone_set = true;
-            break;
-
-        case GCTP_ALBERS_PROJ:
-            geoloc_info->proj_param[2] = gmeta->proj_info.standard_parallel1;
-            geoloc_info->proj_param[3] = gmeta->proj_info.standard_parallel2;
-            geoloc_info->proj_param[4] = gmeta->proj_info.central_meridian;
-            geoloc_info->proj_param[5] = gmeta->proj_info.origin_latitude;
-            geoloc_info->proj_param[6] = gmeta->proj_info.false_easting;
-            geoloc_info->proj_param[7] = gmeta->proj_info.false_northing;
-            break;
-
-        case GCTP_PS_PROJ:
-            geoloc_info->proj_param[4] = gmeta->proj_info.longitude_pole;
-            geoloc_info->proj_param[5] = gmeta->proj_info.latitude_true_scale;
-            geoloc_info->proj_param[6] = gmeta->proj_info.false_easting;
-            geoloc_info->proj_param[7] = gmeta->proj_info.false_northing;
-            break;
-
-        case GCTP_SIN_PROJ:
-            geoloc_info->proj_param[0] = gmeta->proj_info.sphere_radius;
-            geoloc_info->proj_param[4] = gmeta->proj_info.central_meridian;
-            geoloc_info->proj_param[6] = gmeta->proj_info.false_easting;
-            geoloc_info->proj_param[7] = gmeta->proj_info.false_northing;
-            break;
-
-        default:
-            sprintf (errmsg, "Unsupported projection type (%d).  GEO "
-                "projection code (%d) or UTM projection code (%d) or "
-                "ALBERS projection code (%d) or PS projection code (%d) or "
-                "SIN projection code (%d) expected.",
-                gmeta->proj_info.proj_type, GCTP_GEO_PROJ, GCTP_UTM_PROJ,
-                GCTP_ALBERS_PROJ, GCTP_PS_PROJ, GCTP_SIN_PROJ);
-            error_handler (true, FUNC_NAME, errmsg);
-            return (ERROR);
+        sprintf (errmsg, "Line, sample coordinate (%f, %f) falls outside the "
+            "geolocation grid", img->l, img->s);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (false);
     }
 
-    /* Get the proper spheroid for the current datum
-       WGS84 datum <-- WGS84 spheroid, NAD27 datum <-- Clarke 86 spheroid,
-       NAD83 datum <-- GRS80 spheroid */
-    switch (gmeta->proj_info.datum_type)
-    {
-        case (ESPA_WGS84):
-            geoloc_info->spheroid = GCTP_WGS84;
-            break;
-        case (ESPA_NAD27):
-            geoloc_info->spheroid = GCTP_CLARKE_1866;
-            break;
-        case (ESPA_NAD83):
-            geoloc_info->spheroid = GCTP_GRS80;
-            break;
-        case (ESPA_NODATUM):
-            if (gmeta->proj_info.proj_type == GCTP_SIN_PROJ)
-                geoloc_info->spheroid = GCTP_MODIS_SPHERE;
-            else
-            {
-                sprintf (errmsg, "Unsupported datum/projection combination. "
-                    "NoDatum is currently only supported with Sinusoidal.");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (false);
-            }
-            break;
-        default:
-            sprintf (errmsg, "Unsupported datum. Currently only WGS84, NAD27, "
-                "NAD83, and NODATUM (Sinusoidal) are supported.");
-            error_handler (true, FUNC_NAME, errmsg);
-            return (false);
-    }
+    /* Find the grid cell containing the point */
+    il = min ((int) (img->l / grid->stride), grid->grid_nlines - 2);
+    is = min ((int) (img->s / grid->stride), grid->grid_nsamps - 2);
+
+    /* Determine the image coordinates of the cell corners.  The LR corner
+       may be clamped to the image extent. */
+    l0 = il * grid->stride;
+    s0 = is * grid->stride;
+    l1 = min ((il + 1) * grid->stride, grid->nlines);
+    s1 = min ((is + 1) * grid->stride, grid->nsamps);
+
+    /* Bilinearly interpolate the lat/long from the cell corner nodes */
+    fl = (img->l - l0) / (l1 - l0);
+    fs = (img->s - s0) / (s1 - s0);
+    wul = (1.0 - fl) * (1.0 - fs);
+    wur = (1.0 - fl) * fs;
+    wll = fl * (1.0 - fs);
+    wlr = fl * fs;
+
+    indx = il * grid->grid_nsamps + is;
+    geo->lat = wul * grid->lat[indx] + wur * grid->lat[indx+1]
+        + wll * grid->lat[indx + grid->grid_nsamps]
+        + wlr * grid->lat[indx + grid->grid_nsamps + 1];
+    geo->lon = wul * grid->lon[indx] + wur * grid->lon[indx+1]
+        + wll * grid->lon[indx + grid->grid_nsamps]
+        + wlr * grid->lon[indx + grid->grid_nsamps + 1];
+    geo->is_fill = false;
 
-    /* Convert the orientation angle to radians */
-    geoloc_info->orientation_angle = gmeta->orientation_angle * RAD;
- 
     /* Successful completion */
     return (true);
 }
 
 
 /******************************************************************************
-MODULE:  compute_bounds
+MODULE:  setup_geoloc_grid
 
-PURPOSE:  Computes the boundary corners of the output image.  For ascending
-scenes and scenes in the polar regions, the scenes are flipped upside down.
-The bounding coords will be correct in North represents the northernmost
-latitude and South represents the southernmost latitude.  However, the UL
-corner in this case would be more south than the LR corner.  Comparing the UL
-and LR corners will allow the user to determine if the scene is flipped.
+PURPOSE:  Sets up a geolocation grid which holds the exact geodetic
+coordinates on a coarse grid of image points and supports fast bilinear
+interpolation of the lat/long for all interior pixels via grid_from_space.
 
 RETURN VALUE:
-Type = bool
+Type = Geoloc_grid_t *
 Value      Description
 -----      -----------
-false      Error occurred in the computation or mapping
-true       Successfully computed the image bounds
+NULL       Error occurred in the grid setup
+non-NULL   Successfully set up the geolocation grid
 
 PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
 at the USGS EROS
@@ -547,139 +2225,172 @@ at the USGS EROS
 HISTORY:
 Date          Programmer       Reason
 ----------    ---------------  -------------------------------------
-1/23/2014     Gail Schmidt     Original Development (based on input routines
-                               from the LEDAPS lndsr application)
+8/31/2026     Gail Schmidt     Original Development
+
 NOTES:
-1. Memory is allocated for the Geoloc_t pointer.  It is up to the calling
-   routine to free the memory for this pointer.
-2. This assumes the setup mapping was setup using the UL of the UL pixel.
-   It then loops around the outer edges of each pixel as it loops around the
-   outer edges of the entire image.
+1. Memory is allocated for the Geoloc_grid_t pointer.  It is up to the
+   calling routine to free the memory for this pointer using
+   free_geoloc_grid.
+2. If a tolerance (degrees) greater than zero is provided, the interpolation
+   error is verified at the center of every grid cell against the exact
+   inverse mapping.  If the maximum error exceeds the tolerance, the stride
+   is halved and the grid is rebuilt until the tolerance is met or the
+   stride reaches one pixel.
+3. Scenes crossing the international date line are not supported; the grid
+   setup will fail and the exact inverse mapping should be used instead.
 ******************************************************************************/
-bool compute_bounds
+Geoloc_grid_t *setup_geoloc_grid
 (
     Geoloc_t *space,          /* I: geolocation structure which contains the
                                     information used for forward/inverse
                                     mapping */
     int nlines,               /* I: number of lines in the scene */
     int nsamps,               /* I: number of samples in the scene */
-    Geo_bounds_t *bounds      /* O: output boundary for the scene */
+    int stride,               /* I: desired image pixels between grid nodes
+                                    (e.g. 32); clamped to a minimum of 1 */
+    double tolerance          /* I: maximum allowed interpolation error
+                                    (degrees); if greater than zero the grid
+                                    stride is refined until the error at the
+                                    grid cell centers is within the tolerance */
 )
 {
-    char FUNC_NAME[] = "compute_bounds";  /* function name */
-    char errmsg[STR_SIZE];            /* error message */
-    Img_coord_float_t img;            /* image coordinates for current pixel */
-    Geo_coord_t geo;                  /* geodetic coordinates (note radians) */
-    int ix, iy;                       /* current x,y coordinates */
-
-    /* Initialize the bounding coordinates with the upper left of the UL
-       corner */
-    img.l = 0.0;
-    img.s = 0.0;
-    img.is_fill = false;
-    if (!from_space (space, &img, &geo))
+    char FUNC_NAME[] = "setup_geoloc_grid";  /* function name */
+    char errmsg[STR_SIZE];    /* error message */
+    Geoloc_grid_t *grid = NULL;  /* geolocation grid to be returned */
+    Img_coord_float_t img;    /* image coordinates of the current cell center */
+    Geo_coord_t exact_geo;    /* exact geodetic coords of the cell center */
+    Geo_coord_t interp_geo;   /* interpolated geodetic coords of the center */
+    double max_err;           /* maximum interpolation error found (degrees) */
+    double err;               /* interpolation error of the current point */
+    int il;                   /* cell counter in the line direction */
+    int is;                   /* cell counter in the sample direction */
+
+    /* Don't allow a stride less than a single pixel */
+    if (stride < 1)
+        stride = 1;
+
+    /* Allocate the grid structure */
+    grid = malloc (sizeof (Geoloc_grid_t));
+    if (grid == NULL)
     {
-        sprintf (errmsg, "Mapping line, sample pixel to lat/long");
+        sprintf (errmsg, "Allocating memory for the geolocation grid");
         error_handler (true, FUNC_NAME, errmsg);
-        return (false);
+        return (NULL);
     }
+    grid->lat = NULL;
+    grid->lon = NULL;
 
-    bounds->max_lat = geo.lat * DEG;
-    bounds->min_lat = geo.lat * DEG;
-    bounds->max_lon = geo.lon * DEG;
-    bounds->min_lon = geo.lon * DEG;
-
-    /* Determine the bounding coords by looping around the edges of the image
-       in line, sample space and converting to lat/long space. Remember that
-       the to/from space mappings are initialized using the UL of the UL corner
-       of the image. Thus we need to go an extra pixel to the right and bottom
-       of the image to get the true outer extents. */
-    /** top -- go to (nsamps-1) + 1 to get to the far right edge of the
-        image **/
-    for (ix = 0; ix <= nsamps; ix++)
+    /* Build the grid, refining the stride until the interpolation error is
+       within the tolerance */
+    while (true)
     {
-        iy = 0;
-        img.l = (double) iy;
-        img.s = (double) ix;
-        img.is_fill = false;
-        if (!from_space (space, &img, &geo))
+        grid->nlines = nlines;
+        grid->nsamps = nsamps;
+        grid->stride = stride;
+        grid->grid_nlines = (nlines + stride - 1) / stride + 1;
+        grid->grid_nsamps = (nsamps + stride - 1) / stride + 1;
+
+        /* Allocate the node arrays */
+        free (grid->lat);
+        free (grid->lon);
+        grid->lat = malloc (grid->grid_nlines * grid->grid_nsamps *
+            sizeof (double));
+        grid->lon = malloc (grid->grid_nlines * grid->grid_nsamps *
+            sizeof (double));
+        if (grid->lat == NULL || grid->lon == NULL)
         {
-            sprintf (errmsg, "Mapping top line of the image to lat/long");
+            sprintf (errmsg, "Allocating memory for the geolocation grid "
+                "nodes");
             error_handler (true, FUNC_NAME, errmsg);
-            return (false);
+            free_geoloc_grid (grid);
+            return (NULL);
         }
 
-        bounds->max_lat = max (bounds->max_lat, geo.lat*DEG);
-        bounds->min_lat = min (bounds->min_lat, geo.lat*DEG);
-        bounds->max_lon = max (bounds->max_lon, geo.lon*DEG);
-        bounds->min_lon = min (bounds->min_lon, geo.lon*DEG);
-    }
-
-    /** bottom -- go to (nsamps-1) + 1 to get to the far right edge of the
-        image **/
-    for (ix = 0; ix <= nsamps; ix++)
-    {
-        iy = nlines;  /* this is actually (nlines-1) + 1 to get to the very
-                         bottom edge of the image */
-        img.l = (double) iy;
-        img.s = (double) ix;
-        img.is_fill = false;
-        if (!from_space (space, &img, &geo))
+        /* Compute the exact lat/long at the grid nodes */
+        if (!compute_grid_nodes (space, grid))
         {
-            sprintf (errmsg, "Mapping top line of the image to lat/long");
+            sprintf (errmsg, "Computing the geolocation grid nodes");
             error_handler (true, FUNC_NAME, errmsg);
-            return (false);
+            free_geoloc_grid (grid);
+            return (NULL);
         }
 
-        bounds->max_lat = max (bounds->max_lat, geo.lat*DEG);
-        bounds->min_lat = min (bounds->min_lat, geo.lat*DEG);
-        bounds->max_lon = max (bounds->max_lon, geo.lon*DEG);
-        bounds->min_lon = min (bounds->min_lon, geo.lon*DEG);
-    }
+        /* If no tolerance was specified or the stride is already down to a
+           single pixel, use the grid as-is */
+        if (tolerance <= 0.0 || stride == 1)
+            break;
 
-    /** left -- go to (nlines-1) + 1 to get to the bottom edge of the image **/
-    for (iy = 0; iy <= nlines; iy++)
-    {
-        ix = 0;
-        img.l = (double) iy;
-        img.s = (double) ix;
-        img.is_fill = false;
-        if (!from_space (space, &img, &geo))
+        /* Verify the interpolation error at the center of each grid cell
+           against the exact inverse mapping */
+        max_err = 0.0;
+        for (il = 0; il < grid->grid_nlines - 1; il++)
         {
-            sprintf (errmsg, "Mapping top line of the image to lat/long");
-            error_handler (true, FUNC_NAME, errmsg);
-            return (false);
+            for (is = 0; is < grid->grid_nsamps - 1; is++)
+            {
+                img.l = min (il * stride + stride * 0.5, (double) nlines);
+                img.s = min (is * stride + stride * 0.5, (double) nsamps);
+                img.is_fill = false;
+
+                if (!from_space (space, &img, &exact_geo) ||
+                    !grid_from_space (grid, &img, &interp_geo))
+                {
+                    sprintf (errmsg, "Verifying the geolocation grid "
+                        "interpolation error");
+                    error_handler (true, FUNC_NAME, errmsg);
+                    free_geoloc_grid (grid);
+                    return (NULL);
+                }
+
+                err = fabs (interp_geo.lat - exact_geo.lat) * DEG;
+                if (err > max_err)
+                    max_err = err;
+                err = fabs (interp_geo.lon - exact_geo.lon) * DEG;
+                if (err > max_err)
+                    max_err = err;
+            }
         }
 
-        bounds->max_lat = max (bounds->max_lat, geo.lat*DEG);
-        bounds->min_lat = min (bounds->min_lat, geo.lat*DEG);
-        bounds->max_lon = max (bounds->max_lon, geo.lon*DEG);
-        bounds->min_lon = min (bounds->min_lon, geo.lon*DEG);
+        /* If the error is within the tolerance then the grid is good,
+           otherwise refine the stride and rebuild */
+        if (max_err <= tolerance)
+            break;
+        stride /= 2;
     }
 
-    /** right -- go to (nlines-1) + 1 to get to the bottom edge of the image **/
-    for (iy = 0; iy <= nlines; iy++)
-    {
-        ix = nsamps;  /* this is actually (nsamps-1) + 1 to get to the far
-                         right edge of the image */
-        img.l = (double) iy;
-        img.s = (double) ix;
-        img.is_fill = false;
-        if (!from_space (space, &img, &geo))
-        {
-            sprintf (errmsg, "Mapping top line of the image to lat/long");
-            error_handler (true, FUNC_NAME, errmsg);
-            return (false);
-        }
+    /* Successful completion */
+    return (grid);
+}
 
-        bounds->max_lat = max (bounds->max_lat, geo.lat*DEG);
-        bounds->min_lat = min (bounds->min_lat, geo.lat*DEG);
-        bounds->max_lon = max (bounds->max_lon, geo.lon*DEG);
-        bounds->min_lon = min (bounds->min_lon, geo.lon*DEG);
-    }
 
-    /* Successful completion */
-    return (true);
+/******************************************************************************
+MODULE:  free_geoloc_grid
+
+PURPOSE:  Frees the memory allocated for a geolocation grid.
+
+RETURN VALUE:
+Type = None
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+HISTORY:
+Date          Programmer       Reason
+----------    ---------------  -------------------------------------
+8/31/2026     Gail Schmidt     Original Development
+
+NOTES:
+******************************************************************************/
+void free_geoloc_grid
+(
+    Geoloc_grid_t *grid      /* I: geolocation grid to be freed */
+)
+{
+    if (grid != NULL)
+    {
+        free (grid->lat);
+        free (grid->lon);
+        free (grid);
+    }
 }
 
 
@@ -852,45 +2563,18 @@ Date          Programmer       Reason
 ----------    ---------------  -------------------------------------
 5/5/2014      Gail Schmidt     Original Development (based on input routines
                                from MRT)
+8/31/2026     Gail Schmidt     Delegate to the shared dms_to_deg in the
+                               common library
 
 NOTES:
 ******************************************************************************/
 void dmsdeg
-( 
+(
     double dms, 	       /* I: DMS value */
     double *dec_degrees	   /* O: degree value */
 )
 {
-    int deg;		   /* degrees */
-    int min;		   /* minutes */
-    double sec;		   /* decimal seconds */
-    double tempstore;  /* temporary storage of the dms */
-    
-    /* Store the dms value */
-    tempstore = dms;
-    
-    if (dms < 0.0)
-    	dms = -dms;
-    
-    /* Nothing to do? */
-    if (dms == 0.0)
-    	return;
-    
-    /* Calculate the degrees */
-    deg = (int) (dms / 1000000.0);
-    
-    /* Calculate minutes */
-    min = (int) (dms / 1000.0 - deg * 1000.0);
-    
-    /* Calculate the seconds */
-    sec = dms - (deg * 1000000.0 + min * 1000.0);
-    
-    /* Calculate the decimal degrees */
-    *dec_degrees = sec / 3600.0 + min / 60.0 + deg;
-    
-    /* Negate if needed */
-    if (tempstore < 0.0)
-    	*dec_degrees = -*dec_degrees;
+    dms_to_deg (dms, dec_degrees);
 }
 
 
@@ -13,6 +13,14 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 1/23/2014    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added batch variants of the forward and inverse
+                              mapping routines
+8/31/2026    Gail Schmidt     Added the precomputed geolocation grid with
+                              bilinear interpolation of the per-pixel lat/long
+8/31/2026    Gail Schmidt     Added update_geo_window_bounds for refreshing
+                              the geographic coordinates of a window subset
+8/31/2026    Gail Schmidt     Added region certification and the unchecked
+                              batch mapping variants
 
 NOTES:
 *****************************************************************************/
@@ -121,6 +129,23 @@ typedef struct
     double sin_orien;      /* Sine of the orientation angle */
 } Geoloc_t;
 
+/* Structure to store a precomputed lat/long lookup grid.  The exact geodetic
+   coordinates are computed on a coarse grid of image points and the lat/long
+   for the interior pixels is bilinearly interpolated between the grid nodes,
+   which is much cheaper than a full inverse projection per pixel. */
+typedef struct
+{
+    int nlines;            /* number of lines covered by the grid */
+    int nsamps;            /* number of samples covered by the grid */
+    int stride;            /* image pixels between grid nodes */
+    int grid_nlines;       /* number of grid nodes in the line direction */
+    int grid_nsamps;       /* number of grid nodes in the sample direction */
+    double *lat;           /* latitude at each grid node (radians), stored as
+                              a grid_nlines x grid_nsamps array */
+    double *lon;           /* longitude at each grid node (radians), stored as
+                              a grid_nlines x grid_nsamps array */
+} Geoloc_grid_t;
+
 /* Prototypes */
 bool get_geoloc_info
 (
@@ -128,6 +153,12 @@ bool get_geoloc_info
     Space_def_t *geoloc_info            /* O: geolocation space information */
 );
 
+bool same_projection
+(
+    const Espa_proj_meta_t *proj1,   /* I: first projection definition */
+    const Espa_proj_meta_t *proj2    /* I: second projection definition */
+);
+
 Geoloc_t *setup_mapping
 (
     Space_def_t *space_def     /* I: space definition structure */
@@ -149,6 +180,74 @@ bool from_space
     Geo_coord_t *geo         /* O: geodetic coordinates (radians) */
 );
 
+bool to_space_batch
+(
+    Geoloc_t *this,          /* I: geolocation structure; for_trans function
+                                   is used for the forward mapping */
+    int npts,                /* I: number of points to be mapped */
+    Geo_coord_t *geo,        /* I: array of npts geodetic coords (radians) */
+    Img_coord_float_t *img   /* O: array of npts image coordinates */
+);
+
+bool from_space_batch
+(
+    Geoloc_t *this,          /* I: geolocation structure; inv_trans function
+                                   is used for the inverse mapping */
+    int npts,                /* I: number of points to be mapped */
+    Img_coord_float_t *img,  /* I: array of npts image coordinates */
+    Geo_coord_t *geo         /* O: array of npts geodetic coords (radians) */
+);
+
+bool certify_to_space_region
+(
+    Geoloc_t *this,          /* I: geolocation structure; for_trans function
+                                   is used for the forward mapping */
+    double min_lon,          /* I: minimum longitude of the region (radians) */
+    double min_lat,          /* I: minimum latitude of the region (radians) */
+    double max_lon,          /* I: maximum longitude of the region (radians) */
+    double max_lat           /* I: maximum latitude of the region (radians) */
+);
+
+bool certify_from_space_region
+(
+    Geoloc_t *this,          /* I: geolocation structure; inv_trans function
+                                   is used for the inverse mapping */
+    double min_line,         /* I: first line of the region */
+    double min_samp,         /* I: first sample of the region */
+    double max_line,         /* I: last line of the region */
+    double max_samp          /* I: last sample of the region */
+);
+
+void to_space_batch_unchecked
+(
+    Geoloc_t *this,          /* I: geolocation structure; for_trans function
+                                   is used for the forward mapping */
+    int npts,                /* I: number of points to be mapped */
+    Geo_coord_t *geo,        /* I: array of npts geodetic coords (radians) */
+    Img_coord_float_t *img   /* O: array of npts image coordinates */
+);
+
+void from_space_batch_unchecked
+(
+    Geoloc_t *this,          /* I: geolocation structure; inv_trans function
+                                   is used for the inverse mapping */
+    int npts,                /* I: number of points to be mapped */
+    Img_coord_float_t *img,  /* I: array of npts image coordinates */
+    Geo_coord_t *geo         /* O: array of npts geodetic coords (radians) */
+);
+
+bool compute_bounds_sampled
+(
+    Geoloc_t *space,          /* I: geolocation structure which contains the
+                                    information used for forward/inverse
+                                    mapping */
+    int nlines,               /* I: number of lines in the scene */
+    int nsamps,               /* I: number of samples in the scene */
+    int stride,               /* I: sampling stride along the image edges;
+                                    1 maps every perimeter point */
+    Geo_bounds_t *bounds      /* O: output boundary for the scene */
+);
+
 bool compute_bounds
 (
     Geoloc_t *space,          /* I: geolocation structure which contains the
@@ -159,6 +258,50 @@ bool compute_bounds
     Geo_bounds_t *bounds      /* O: output boundary for the scene */
 );
 
+bool compute_bounds_analytic
+(
+    Geoloc_t *space,          /* I: geolocation structure which contains the
+                                    information used for forward/inverse
+                                    mapping */
+    int nlines,               /* I: number of lines in the scene */
+    int nsamps,               /* I: number of samples in the scene */
+    Geo_bounds_t *bounds      /* O: output boundary for the scene */
+);
+
+bool update_geo_window_bounds
+(
+    Espa_internal_meta_t *xml_metadata  /* I/O: XML metadata whose geographic
+                                    corner and bounding coordinates are to be
+                                    recomputed from its projection info */
+);
+
+Geoloc_grid_t *setup_geoloc_grid
+(
+    Geoloc_t *space,          /* I: geolocation structure which contains the
+                                    information used for forward/inverse
+                                    mapping */
+    int nlines,               /* I: number of lines in the scene */
+    int nsamps,               /* I: number of samples in the scene */
+    int stride,               /* I: desired image pixels between grid nodes
+                                    (e.g. 32); clamped to a minimum of 1 */
+    double tolerance          /* I: maximum allowed interpolation error
+                                    (degrees); if greater than zero the grid
+                                    stride is refined until the error at the
+                                    grid cell centers is within the tolerance */
+);
+
+bool grid_from_space
+(
+    Geoloc_grid_t *grid,     /* I: geolocation grid from setup_geoloc_grid */
+    Img_coord_float_t *img,  /* I: image coordinates */
+    Geo_coord_t *geo         /* O: geodetic coordinates (radians) */
+);
+
+void free_geoloc_grid
+(
+    Geoloc_grid_t *grid      /* I: geolocation grid to be freed */
+);
+
 bool degdms
 (
     double *deg,     /* I: input angular value in degrees, minutes, or seconds
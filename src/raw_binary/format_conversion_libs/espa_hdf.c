@@ -17,6 +17,7 @@ Date         Programmer       Reason
 NOTES:
 *****************************************************************************/
 
+#include <string.h>
 #include "espa_hdf.h"
 #include "error_handler.h"
 #include "hdf.h"
@@ -321,3 +322,215 @@ int put_attr_string
 
     return (SUCCESS);
 }
+
+/******************************************************************************
+MODULE:  init_attr_batch
+
+PURPOSE:  Initializes an attribute batch to empty.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date        Programmer       Reason
+--------    ---------------  -------------------------------------
+8/31/2026   Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void init_attr_batch
+(
+    Espa_hdf_attr_batch_t *batch   /* O: batch to initialize to empty */
+)
+{
+    batch->nattrs = 0;
+}
+
+
+/******************************************************************************
+MODULE:  add_attr_batch_string
+
+PURPOSE:  Queues a string attribute in the batch.  Empty strings are skipped,
+matching the behavior of writing optional attributes only when they have a
+value.
+
+RETURN VALUE:
+Type = int
+Value      Description
+-----      -----------
+ERROR      The batch is full
+SUCCESS    Successful completion
+
+HISTORY:
+Date        Programmer       Reason
+--------    ---------------  -------------------------------------
+8/31/2026   Gail Schmidt     Original development
+
+NOTES:
+  1. The string is only referenced, not copied, so it must remain valid
+     until the batch is written with put_attr_batch.
+******************************************************************************/
+int add_attr_batch_string
+(
+    Espa_hdf_attr_batch_t *batch,  /* I/O: batch to add the attribute to */
+    char *name,            /* I: attribute name */
+    char *string           /* I: string value; must remain valid until the
+                                 batch is written */
+)
+{
+    char FUNC_NAME[] = "add_attr_batch_string";   /* function name */
+    char errmsg[STR_SIZE];         /* error message */
+    Espa_hdf_attr_entry_t *entry = NULL;  /* entry being filled */
+
+    /* Skip empty optional strings */
+    if (string[0] == '\0')
+        return (SUCCESS);
+
+    if (batch->nattrs >= ESPA_HDF_BATCH_NATTRS)
+    {
+        sprintf (errmsg, "Attribute batch is full (%d attributes); cannot "
+            "queue attribute %s", ESPA_HDF_BATCH_NATTRS, name);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    entry = &batch->entry[batch->nattrs++];
+    entry->attr.type = DFNT_CHAR8;
+    entry->attr.nval = strlen (string);
+    entry->attr.name = name;
+    entry->is_string = true;
+    entry->string = string;
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  add_attr_batch_double
+
+PURPOSE:  Queues a numeric attribute in the batch, copying the values into
+the batch entry.
+
+RETURN VALUE:
+Type = int
+Value      Description
+-----      -----------
+ERROR      The batch is full or too many values were provided
+SUCCESS    Successful completion
+
+HISTORY:
+Date        Programmer       Reason
+--------    ---------------  -------------------------------------
+8/31/2026   Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+int add_attr_batch_double
+(
+    Espa_hdf_attr_batch_t *batch,  /* I/O: batch to add the attribute to */
+    char *name,            /* I: attribute name */
+    int32 type,            /* I: HDF data type of the attribute */
+    int nval,              /* I: number of values (up to
+                                 ESPA_HDF_BATCH_NVALS) */
+    double *val            /* I: array of values; copied into the batch */
+)
+{
+    char FUNC_NAME[] = "add_attr_batch_double";   /* function name */
+    char errmsg[STR_SIZE];         /* error message */
+    int i;                         /* looping variable for the values */
+    Espa_hdf_attr_entry_t *entry = NULL;  /* entry being filled */
+
+    if (nval < 1 || nval > ESPA_HDF_BATCH_NVALS)
+    {
+        sprintf (errmsg, "Invalid number of values (%d) for batched "
+            "attribute %s", nval, name);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    if (batch->nattrs >= ESPA_HDF_BATCH_NATTRS)
+    {
+        sprintf (errmsg, "Attribute batch is full (%d attributes); cannot "
+            "queue attribute %s", ESPA_HDF_BATCH_NATTRS, name);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    entry = &batch->entry[batch->nattrs++];
+    entry->attr.type = type;
+    entry->attr.nval = nval;
+    entry->attr.name = name;
+    entry->is_string = false;
+    for (i = 0; i < nval; i++)
+        entry->dval[i] = val[i];
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  put_attr_batch
+
+PURPOSE:  Writes all the attributes queued in the batch to the SDS in one
+back-to-back pass, so the HDF metadata operations for the SDS are issued
+together instead of interleaved with the attribute assembly.
+
+RETURN VALUE:
+Type = int
+Value      Description
+-----      -----------
+ERROR      Error occurred writing an attribute
+SUCCESS    Successful completion
+
+HISTORY:
+Date        Programmer       Reason
+--------    ---------------  -------------------------------------
+8/31/2026   Gail Schmidt     Original development
+
+NOTES:
+  1. The SD interface has no call for writing several attributes in one
+     operation, and writing the attribute blocks through the low-level
+     vdata interfaces would produce attributes the SD readers don't see.
+     Issuing the SDsetattr calls back-to-back keeps the dirtied metadata
+     blocks together in the library's cache so they flush as one region.
+******************************************************************************/
+int put_attr_batch
+(
+    int32 sds_id,          /* I: SDS ID to write the attributes to */
+    Espa_hdf_attr_batch_t *batch   /* I: batch of queued attributes */
+)
+{
+    char FUNC_NAME[] = "put_attr_batch";   /* function name */
+    char errmsg[STR_SIZE];         /* error message */
+    int i;                         /* looping variable for the attributes */
+    Espa_hdf_attr_entry_t *entry = NULL;  /* entry being written */
+
+    for (i = 0; i < batch->nattrs; i++)
+    {
+        entry = &batch->entry[i];
+        if (entry->is_string)
+        {
+            if (put_attr_string (sds_id, &entry->attr, entry->string)
+                != SUCCESS)
+            {
+                sprintf (errmsg, "Writing batched attribute %s",
+                    entry->attr.name);
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
+            }
+        }
+        else
+        {
+            if (put_attr_double (sds_id, &entry->attr, entry->dval)
+                != SUCCESS)
+            {
+                sprintf (errmsg, "Writing batched attribute %s",
+                    entry->attr.name);
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
+            }
+        }
+    }
+
+    return (SUCCESS);
+}
@@ -12,6 +12,9 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 1/7/2014     Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added the attribute batch so the attributes for
+                              an SDS can be assembled up front and written in
+                              one pass
 
 NOTES:
 *****************************************************************************/
@@ -38,7 +41,63 @@ typedef struct
   char *name;            /* attribute name */
 } Espa_hdf_attr_t;
 
+/* maximum number of attributes which can be queued in a batch for one SDS */
+#define ESPA_HDF_BATCH_NATTRS 16
+
+/* maximum number of values for a numeric attribute queued in a batch */
+#define ESPA_HDF_BATCH_NVALS 4
+
+/* one attribute queued in a batch; the numeric values are copied into the
+   entry, string values are only referenced and must remain valid until the
+   batch is written */
+typedef struct
+{
+  Espa_hdf_attr_t attr;  /* attribute type, count, and name */
+  bool is_string;        /* is this a string attribute? */
+  char *string;          /* string value, if a string attribute */
+  double dval[ESPA_HDF_BATCH_NVALS];  /* numeric values, if numeric */
+} Espa_hdf_attr_entry_t;
+
+/* batch of attributes for one SDS, assembled up front and written with a
+   single put_attr_batch call so the HDF metadata operations are issued
+   back-to-back instead of interleaved with the assembly */
+typedef struct
+{
+  int nattrs;            /* number of attributes queued */
+  Espa_hdf_attr_entry_t entry[ESPA_HDF_BATCH_NATTRS];  /* queued attributes */
+} Espa_hdf_attr_batch_t;
+
 /* Prototypes */
+void init_attr_batch
+(
+    Espa_hdf_attr_batch_t *batch   /* O: batch to initialize to empty */
+);
+
+int add_attr_batch_string
+(
+    Espa_hdf_attr_batch_t *batch,  /* I/O: batch to add the attribute to */
+    char *name,            /* I: attribute name */
+    char *string           /* I: string value; must remain valid until the
+                                 batch is written */
+);
+
+int add_attr_batch_double
+(
+    Espa_hdf_attr_batch_t *batch,  /* I/O: batch to add the attribute to */
+    char *name,            /* I: attribute name */
+    int32 type,            /* I: HDF data type of the attribute */
+    int nval,              /* I: number of values (up to
+                                 ESPA_HDF_BATCH_NVALS) */
+    double *val            /* I: array of values; copied into the batch */
+);
+
+int put_attr_batch
+(
+    int32 sds_id,          /* I: SDS ID to write the attributes to */
+    Espa_hdf_attr_batch_t *batch   /* I: batch of queued attributes */
+);
+
+
 int put_attr_double
 (
     int32 sds_id,          /* I: SDS ID to write attribute to */
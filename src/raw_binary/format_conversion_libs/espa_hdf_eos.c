@@ -13,26 +13,31 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 1/8/2014     Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Use the shared deg_to_dms from the common
+                              library instead of a local copy
 
 NOTES:
 *****************************************************************************/
 
 #include "espa_hdf_eos.h"
+#include "espa_dms.h"
 
 #define OUTPUT_HDFEOS_VERSION ("HDFEOSVersion");
 #define OUTPUT_STRUCT_METADATA ("StructMetadata.0");
 #define OUTPUT_ORIENTATION_ANGLE_HDF ("OrientationAngle")
 
 /******************************************************************************
-MODULE:  deg_to_dms
+MODULE:  init_meta_builder
 
-PURPOSE:  Converts the decimal degree value to DMS in the form of DDDMMMSSS.ss.
+PURPOSE:  Initializes the metadata builder, pre-sizing the buffer from the
+number of bands so the common case never has to grow.
 
 RETURN VALUE:
-Type = double
+Type = bool
 Value      Description
 -----      -----------
-{all}      Packed DMS value
+false      Error allocating the metadata buffer
+true       Successful processing
 
 PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
 at the USGS EROS
@@ -40,58 +45,72 @@ at the USGS EROS
 HISTORY:
 Date         Programmer       Reason
 ---------    ---------------  -------------------------------------
-7/24/2014    Gail Schmidt     Original Development
+8/31/2026    Gail Schmidt     Original Development
 
 NOTES:
 ******************************************************************************/
-double deg_to_dms
+bool init_meta_builder
 (
-    double flt_deg   /* I: input decimal degree value */
+    Espa_meta_builder_t *meta,  /* I/O: metadata builder to be initialized */
+    int nbands   /* I: number of bands, used to estimate the capacity */
 )
 {
-    int deg;         /* integer degree portion of the input value */
-    int min;         /* integer minute portion of the input value */
-    float sec;       /* seconds portion of the input value */
-    double dms;      /* packed degrees, minutes, seconds */
+    meta->alloc = ESPA_MAX_METADATA_SIZE +
+        (size_t) nbands * ESPA_METADATA_BAND_SIZE;
+    meta->buf = malloc (meta->alloc);
+    if (meta->buf == NULL)
+    {
+        meta->alloc = 0;
+        return false;
+    }
+    meta->buf[0] = '\0';
+    meta->used = 0;
+
+    return true;
+}
 
-    /* Grab the integer degrees from the input value */
-    deg = (int) flt_deg;
 
-    /* Obtain the integer minutes from the input value */
-    min = (int) ((flt_deg - deg) * 60.0);
+/******************************************************************************
+MODULE:  free_meta_builder
 
-    /* Obtain the seconds from the input value */
-    sec = (flt_deg - deg - min / 60.0) * 3600.0;
+PURPOSE:  Frees the metadata builder buffer.
 
-    /* If the seconds or minutes are 60, handle that case */
-    if (sec >= 60.0)
-    {
-        sec -= 60.0;
-        min++;
-    }
-    if (min >= 60)
-    {
-        min -= 60;
-        deg++;
-    }
+RETURN VALUE:
+Type = None
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
 
-    /* Create the packed DMS value */
-    dms = deg * 1000000.0 + min * 1000.0 + sec;
+HISTORY:
+Date         Programmer       Reason
+---------    ---------------  -------------------------------------
+8/31/2026    Gail Schmidt     Original Development
 
-    return (dms);
+NOTES:
+******************************************************************************/
+void free_meta_builder
+(
+    Espa_meta_builder_t *meta   /* I/O: metadata builder to be freed */
+)
+{
+    free (meta->buf);
+    meta->buf = NULL;
+    meta->used = 0;
+    meta->alloc = 0;
 }
 
 
 /******************************************************************************
 MODULE:  append_meta
 
-PURPOSE:  Appends the string to the metadata buffer.
+PURPOSE:  Appends the string to the metadata buffer, growing the buffer as
+needed.
 
 RETURN VALUE:
 Type = bool
 Value      Description
 -----      -----------
-false      Error in the number of attributes
+false      Error in the string or growing the metadata buffer
 true       Successful processing
 
 PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
@@ -102,38 +121,260 @@ Date         Programmer       Reason
 ---------    ---------------  -------------------------------------
 1/7/2014     Gail Schmidt     Original Development (based on input routines
                               from the LEDAPS lndsr application)
+8/31/2026    Gail Schmidt     Append to a growable builder buffer instead of
+                              a fixed-size array
 
 NOTES:
 ******************************************************************************/
 bool append_meta
 (
-    char *cbuf,  /* I/O: input metadata buffer */
-    int *ic,     /* I/O: index of current location in metadata buffer */
+    Espa_meta_builder_t *meta,  /* I/O: metadata builder */
     char *str    /* I: string to append to the metadata buffer */
 )
 {
-    int nc, i;
-  
-    /* Validate the string and number of attributes */
-    if (*ic < 0)
-        return false;
+    size_t nc;             /* number of characters to be appended */
+    size_t new_alloc;      /* new allocation size for the buffer */
+    char *new_buf = NULL;  /* temporary pointer for growing the buffer */
+
+    /* Validate the string */
     nc = strlen (str);
-    if (nc <= 0)
+    if (nc == 0)
         return false;
-    if (*ic + nc > ESPA_MAX_METADATA_SIZE)
-        return false;
-  
-    /* Add the string to the metadata */
-    for (i = 0; i < nc; i++)
+
+    /* Grow the buffer if needed, doubling so repeated appends stay cheap */
+    if (meta->used + nc + 1 > meta->alloc)
     {
-        cbuf[*ic] = str[i];
-        (*ic)++;
+        new_alloc = meta->alloc * 2;
+        while (meta->used + nc + 1 > new_alloc)
+            new_alloc *= 2;
+        new_buf = realloc (meta->buf, new_alloc);
+        if (new_buf == NULL)
+            return false;
+        meta->buf = new_buf;
+        meta->alloc = new_alloc;
     }
-    cbuf[*ic] = '\0';
-  
+
+    /* Add the string to the metadata */
+    memcpy (&meta->buf[meta->used], str, nc);
+    meta->used += nc;
+    meta->buf[meta->used] = '\0';
+
     return true;
 }
 
+
+/******************************************************************************
+MODULE:  format_grid_projection (static)
+
+PURPOSE:  Formats the projection name string and the band-independent
+projection, sphere code, datum, and grid origin lines of a grid group.  The
+lines are the same for every grid in the product, so they are formatted once
+and appended per grid instead of redoing the packed-DMS conversions for each
+grid.
+
+RETURN VALUE:
+Type = int
+Value      Description
+-----      -----------
+ERROR      Unsupported projection type
+SUCCESS    Successful completion
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+HISTORY:
+Date         Programmer       Reason
+---------    ---------------  -------------------------------------
+8/31/2026    Gail Schmidt     Original Development (pulled from the per-grid
+                              blocks of write_hdf_eos_attr)
+
+NOTES:
+******************************************************************************/
+static int format_grid_projection
+(
+    Espa_global_meta_t *gmeta, /* I: pointer to global metadata structure */
+    char *proj_str,            /* O: projection name string */
+    char *proj_text,           /* O: projection information, sphere code,
+                                     datum, and grid origin lines shared by
+                                     every grid */
+    size_t proj_text_size      /* I: size of the proj_text string */
+)
+{
+    char FUNC_NAME[] = "format_grid_projection";  /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    char datum_str[STR_SIZE];  /* datum string */
+    double proj_parms[NPROJ_PARAM];  /* projection parameters */
+    int sphere_code;         /* GCTP value for the associated spheroid */
+    int i;                   /* looping variable */
+    int count;               /* number of chars copied in snprintf */
+    size_t used = 0;         /* number of chars formatted into proj_text */
+
+    /* Get the projection name string */
+    switch (gmeta->proj_info.proj_type)
+    {
+        case (GCTP_GEO_PROJ): strcpy (proj_str, "GEO"); break;
+        case (GCTP_UTM_PROJ): strcpy (proj_str, "UTM"); break;
+        case (GCTP_PS_PROJ): strcpy (proj_str, "PS"); break;
+        case (GCTP_ALBERS_PROJ): strcpy (proj_str, "ALBERS"); break;
+        case (GCTP_SIN_PROJ): strcpy (proj_str, "SNSOID"); break;
+    }
+
+    /* Write the projection information */
+    proj_text[0] = '\0';
+    if (gmeta->proj_info.proj_type == GCTP_UTM_PROJ)
+    {
+        /* Write the UTM zone */
+        count = snprintf (&proj_text[used], proj_text_size - used,
+            "\t\tZoneCode=%d\n", gmeta->proj_info.utm_zone);
+        if (count < 0 || count >= proj_text_size - used)
+        {
+            sprintf (errmsg, "Overflow of proj_text string");
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+        used += count;
+    }
+    else if (gmeta->proj_info.proj_type != GCTP_GEO_PROJ)
+    {  /* don't write projection parameters for Geographic */
+        /* Write the projection parameters, converting angular parameters to
+           packed DMS */
+        for (i = 0; i < NPROJ_PARAM; i++)
+            proj_parms[i] = 0.0;
+
+        switch (gmeta->proj_info.proj_type)
+        {
+            case GCTP_ALBERS_PROJ:
+                proj_parms[2] =
+                    deg_to_dms (gmeta->proj_info.standard_parallel1);
+                proj_parms[3] =
+                    deg_to_dms (gmeta->proj_info.standard_parallel2);
+                proj_parms[4] = deg_to_dms (gmeta->proj_info.central_meridian);
+                proj_parms[5] = deg_to_dms (gmeta->proj_info.origin_latitude);
+                proj_parms[6] = gmeta->proj_info.false_easting;
+                proj_parms[7] = gmeta->proj_info.false_northing;
+                break;
+
+            case GCTP_PS_PROJ:
+                proj_parms[4] = deg_to_dms (gmeta->proj_info.longitude_pole);
+                proj_parms[5] =
+                    deg_to_dms (gmeta->proj_info.latitude_true_scale);
+                proj_parms[6] = gmeta->proj_info.false_easting;
+                proj_parms[7] = gmeta->proj_info.false_northing;
+                break;
+
+            case GCTP_SIN_PROJ:
+                proj_parms[0] = gmeta->proj_info.sphere_radius;
+                proj_parms[4] = deg_to_dms (gmeta->proj_info.central_meridian);
+                proj_parms[6] = gmeta->proj_info.false_easting;
+                proj_parms[7] = gmeta->proj_info.false_northing;
+                break;
+
+            default:
+                sprintf (errmsg, "Unsupported projection type (%d).  GEO "
+                    "projection code (%d) or UTM projection code (%d) or "
+                    "ALBERS projection code (%d) or PS projection code (%d) or "
+                    "SIN projection code (%d) expected.",
+                    gmeta->proj_info.proj_type, GCTP_GEO_PROJ, GCTP_UTM_PROJ,
+                    GCTP_ALBERS_PROJ, GCTP_PS_PROJ, GCTP_SIN_PROJ);
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
+        }
+
+        count = snprintf (&proj_text[used], proj_text_size - used,
+            "\t\tProjParams=(");
+        if (count < 0 || count >= proj_text_size - used)
+        {
+            sprintf (errmsg, "Overflow of proj_text string");
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+        used += count;
+
+        for (i = 0; i < NPROJ_PARAM; i++)
+        {
+            if (i == NPROJ_PARAM-1)
+                count = snprintf (&proj_text[used], proj_text_size - used,
+                    "%.6f)", proj_parms[i]);
+            else
+                count = snprintf (&proj_text[used], proj_text_size - used,
+                    "%.6f,", proj_parms[i]);
+            if (count < 0 || count >= proj_text_size - used)
+            {
+                sprintf (errmsg, "Overflow of proj_text string");
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
+            }
+            used += count;
+        }
+
+        count = snprintf (&proj_text[used], proj_text_size - used, "\n");
+        if (count < 0 || count >= proj_text_size - used)
+        {
+            sprintf (errmsg, "Overflow of proj_text string");
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+        used += count;
+    }
+
+    switch (gmeta->proj_info.datum_type)
+    {
+        case (ESPA_WGS84):
+            sphere_code = SPHERE_WGS84;
+            strcpy (datum_str, "WGS84");
+            break;
+        case (ESPA_NAD83):
+            sphere_code = SPHERE_GRS80;
+            strcpy (datum_str, "NAD83");
+            break;
+        case (ESPA_NAD27):
+            sphere_code = SPHERE_CLARKE_1866;
+            strcpy (datum_str, "NAD27");
+            break;
+        case (ESPA_NODATUM):
+        default:
+            sphere_code = -999;
+            strcpy (datum_str, "NoDatum");
+            break;
+    }
+
+    /* Don't write the sphere code if this is the Geographic projection */
+    if (gmeta->proj_info.proj_type != GCTP_GEO_PROJ &&
+        gmeta->proj_info.datum_type != ESPA_NODATUM)
+    {
+        count = snprintf (&proj_text[used], proj_text_size - used,
+            "\t\tSphereCode=%d\n", sphere_code);
+        if (count < 0 || count >= proj_text_size - used)
+        {
+            sprintf (errmsg, "Overflow of proj_text string");
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+        used += count;
+    }
+
+    count = snprintf (&proj_text[used], proj_text_size - used,
+        "\t\tDatum=%s\n"
+        "\t\tGridOrigin=HDFE_GD_UL\n", datum_str);
+    if (count < 0 || count >= proj_text_size - used)
+    {
+        sprintf (errmsg, "Overflow of proj_text string");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    return (SUCCESS);
+}
+
+
+/* DFNT data type names indexed by the Espa_data_type enumeration, which
+   numbers its entries contiguously from ESPA_INT8 */
+static const char *dfnt_type_names[] =
+{
+    "DFNT_INT8", "DFNT_UINT8", "DFNT_INT16", "DFNT_UINT16",
+    "DFNT_INT32", "DFNT_UINT32", "DFNT_FLOAT32", "DFNT_FLOAT64"
+};
+
 /******************************************************************************
 MODULE:  write_hdf_eos_attr
 
@@ -167,6 +408,14 @@ Date         Programmer       Reason
                               the datum string as an attribute.
 9/11/2014    Gail Schmidt     Modified to make the lower right corner in meters
                               represent the outer extent (i.e. LR of the LR)
+8/31/2026    Gail Schmidt     Build the structural metadata with a growable
+                              builder pre-sized from the number of bands
+8/31/2026    Gail Schmidt     Format the shared projection, datum, and grid
+                              origin lines once and reuse them for every grid
+8/31/2026    Gail Schmidt     Look up the DFNT data type names from a table in
+                              the band loops and append the constant metadata
+                              text directly instead of re-formatting it for
+                              every grid
 
 NOTES:
 ******************************************************************************/
@@ -179,19 +428,18 @@ int write_hdf_eos_attr
     char FUNC_NAME[] = "write_hdf_eos_attr";  /* function name */
     char errmsg[STR_SIZE];                    /* error message */
     char grid_name[] = "Grid";                /* name of the HDF-EOS grid */
-    char struct_meta[ESPA_MAX_METADATA_SIZE]; /* structural metadata */
     char cbuf[ESPA_MAX_METADATA_SIZE];        /* temp buffer for metadata */
     char *dim_names[2] = {"YDim", "XDim"};    /* base names for dimensions */
     char proj_str[STR_SIZE];                  /* projection string */
-    char datum_str[STR_SIZE];                 /* datum string */
-    char dtype[STR_SIZE];                     /* data type */
+    char proj_text[STR_SIZE];                 /* projection, sphere code,
+                                                 datum, and grid origin lines
+                                                 shared by every grid */
+    const char *dtype;                        /* data type name from the
+                                                 DFNT lookup table */
     char temp_name[STR_SIZE];                 /* temporary grid name */
     double ul_corner[2];     /* UL corner x,y -- Geographic is DMS */
     double lr_corner[2];     /* LR corner x,y -- Geographic is DMS */
-    double proj_parms[NPROJ_PARAM];  /* projection parameters */
     double dval;             /* temporary double value */
-    int meta_indx;           /* index of current location in metadata buffer */
-    int sphere_code;         /* GCTP value for the associated spheroid */
     int i;                   /* looping variable */
     int count;               /* number of chars copied in snprintf */
     int mycount;             /* integer value to use in the name of the 2nd,
@@ -209,28 +457,30 @@ int write_hdf_eos_attr
     int32 sds_index;         /* index of SDS in the HDF file */
     int32 sds_id;            /* SDS ID */
     Espa_hdf_attr_t attr;    /* attributes for writing the metadata */
+    Espa_meta_builder_t struct_meta;  /* structural metadata builder */
     Espa_global_meta_t *gmeta = &xml_metadata->global;
                              /* pointer to global metadata structure */
-  
+
     /* Initialize the bands to not processed */
     for (isds = 0; isds < xml_metadata->nbands; isds++)
         processed[isds] = false;
 
-    /* Build the HDF-EOS header */
-    meta_indx = 0;
-    count = snprintf (cbuf, sizeof (cbuf),
-        "\nGROUP=SwathStructure\n" 
-        "END_GROUP=SwathStructure\n" 
-        "GROUP=GridStructure\n" 
-        "\tGROUP=GRID_1\n");
-    if (count < 0 || count >= sizeof (cbuf))
+    /* Initialize the metadata builder, pre-sizing the buffer from the number
+       of bands in the product */
+    if (!init_meta_builder (&struct_meta, xml_metadata->nbands))
     {
-        sprintf (errmsg, "Overflow of cbuf string");
+        sprintf (errmsg, "Error allocating the structural metadata buffer");
         error_handler (true, FUNC_NAME, errmsg);
         return (ERROR);
     }
 
-    if (!append_meta (struct_meta, &meta_indx, cbuf))
+    /* Build the HDF-EOS header; the text is constant so it goes straight
+       into the builder */
+    if (!append_meta (&struct_meta,
+        "\nGROUP=SwathStructure\n" 
+        "END_GROUP=SwathStructure\n" 
+        "GROUP=GridStructure\n" 
+        "\tGROUP=GRID_1\n"))
     {
         sprintf (errmsg, "Error appending to the start of the metadata string");
         error_handler (true, FUNC_NAME, errmsg);
@@ -240,16 +490,15 @@ int write_hdf_eos_attr
     /** Build the metadata for the first grid (possibly the only grid if this
         isn't a multi-resolution product) using the information from the first
         band **/
-    /* Get the projection name string */
-    switch (gmeta->proj_info.proj_type)
-    {
-        case (GCTP_GEO_PROJ): strcpy (proj_str, "GEO"); break;
-        case (GCTP_UTM_PROJ): strcpy (proj_str, "UTM"); break;
-        case (GCTP_PS_PROJ): strcpy (proj_str, "PS"); break;
-        case (GCTP_ALBERS_PROJ): strcpy (proj_str, "ALBERS"); break;
-        case (GCTP_SIN_PROJ): strcpy (proj_str, "SNSOID"); break;
+    /* Format the projection name string and the projection, sphere code,
+       datum, and grid origin lines once; every grid in the product shares
+       them, so the packed-DMS conversions aren't redone per grid */
+    if (format_grid_projection (gmeta, proj_str, proj_text,
+        sizeof (proj_text)) != SUCCESS)
+    {   /* Error messages already printed */
+        return (ERROR);
     }
-  
+
     /* If the grid origin is center, then adjust for the resolution.  The
        corners will be written for the outter extents of the corner. */
     if (!strcmp (gmeta->proj_info.grid_origin, "CENTER"))
@@ -296,7 +545,7 @@ int write_hdf_eos_attr
         return (ERROR);
     }
 
-    if (!append_meta (struct_meta, &meta_indx, cbuf))
+    if (!append_meta (&struct_meta, cbuf))
     {
         sprintf (errmsg, "Error appending to metadata string (grid information "
             "start)");
@@ -340,7 +589,7 @@ int write_hdf_eos_attr
         }
     }
 
-    if (!append_meta (struct_meta, &meta_indx, cbuf))
+    if (!append_meta (&struct_meta, cbuf))
     {
         sprintf (errmsg, "Error appending to metadata string (grid information "
             "start)");
@@ -348,210 +597,22 @@ int write_hdf_eos_attr
         return (ERROR);
     }
   
-    /* Write projection information */
-    if (gmeta->proj_info.proj_type == GCTP_UTM_PROJ)
+    /* Write the projection information, sphere code, datum, and grid
+       origin; these lines are the same for every grid so they were
+       formatted once up front */
+    if (!append_meta (&struct_meta, proj_text))
     {
-        /* Write the UTM zone */
-        count = snprintf (cbuf, sizeof (cbuf),
-            "\t\tZoneCode=%d\n", gmeta->proj_info.utm_zone);
-        if (count < 0 || count >= sizeof (cbuf))
-        {
-            sprintf (errmsg, "Overflow of cbuf string");
-            error_handler (true, FUNC_NAME, errmsg);
-            return (ERROR);
-        }
-
-        if (!append_meta (struct_meta, &meta_indx, cbuf))
-        {
-            sprintf (errmsg, "Error appending to metadata string (zone "
-                "number)");
-            error_handler (true, FUNC_NAME, errmsg);
-            return (ERROR);
-        }
-    }
-    else if (gmeta->proj_info.proj_type != GCTP_GEO_PROJ)
-    {  /* don't write projection parameters for Geographic */
-        /* Write the projection parameters */
-        count = snprintf (cbuf, sizeof (cbuf), "\t\tProjParams=(");
-        if (count < 0 || count >= sizeof (cbuf))
-        {
-            sprintf (errmsg, "Overflow of cbuf string");
-            error_handler (true, FUNC_NAME, errmsg);
-            return (ERROR);
-        }
-
-        if (!append_meta (struct_meta, &meta_indx, cbuf))
-        {
-            sprintf (errmsg, "Error appending to metadata string (grid "
-                "projection parameters start)");
-            error_handler (true, FUNC_NAME, errmsg);
-            return (ERROR);
-        }
-  
-        for (i = 0; i < NPROJ_PARAM; i++)
-            proj_parms[i] = 0.0;
-
-        switch (gmeta->proj_info.proj_type)
-        {
-            case GCTP_GEO_PROJ:
-                /* just use the already initialized zeros for the proj parms */
-                break;
-    
-            case GCTP_UTM_PROJ:
-                /* UTM handled in the if statement above */
-                break;
-
-            case GCTP_ALBERS_PROJ:
-                proj_parms[2] =
-                    deg_to_dms (gmeta->proj_info.standard_parallel1);
-                proj_parms[3] =
-                    deg_to_dms (gmeta->proj_info.standard_parallel2);
-                proj_parms[4] = deg_to_dms (gmeta->proj_info.central_meridian);
-                proj_parms[5] = deg_to_dms (gmeta->proj_info.origin_latitude);
-                proj_parms[6] = gmeta->proj_info.false_easting;
-                proj_parms[7] = gmeta->proj_info.false_northing;
-                break;
-    
-            case GCTP_PS_PROJ:
-                proj_parms[4] = deg_to_dms (gmeta->proj_info.longitude_pole);
-                proj_parms[5] =
-                    deg_to_dms (gmeta->proj_info.latitude_true_scale);
-                proj_parms[6] = gmeta->proj_info.false_easting;
-                proj_parms[7] = gmeta->proj_info.false_northing;
-                break;
-    
-            case GCTP_SIN_PROJ:
-                proj_parms[0] = gmeta->proj_info.sphere_radius;
-                proj_parms[4] = deg_to_dms (gmeta->proj_info.central_meridian);
-                proj_parms[6] = gmeta->proj_info.false_easting;
-                proj_parms[7] = gmeta->proj_info.false_northing;
-                break;
-    
-            default:
-                sprintf (errmsg, "Unsupported projection type (%d).  GEO "
-                    "projection code (%d) or UTM projection code (%d) or "
-                    "ALBERS projection code (%d) or PS projection code (%d) or "
-                    "SIN projection code (%d) expected.",
-                    gmeta->proj_info.proj_type, GCTP_GEO_PROJ, GCTP_UTM_PROJ,
-                    GCTP_ALBERS_PROJ, GCTP_PS_PROJ, GCTP_SIN_PROJ);
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-        }
-
-        for (i = 0; i < NPROJ_PARAM; i++)
-        {
-            if (i == NPROJ_PARAM-1)
-                count = snprintf (cbuf, sizeof (cbuf), "%.6f)", proj_parms[i]);
-            else
-                count = snprintf (cbuf, sizeof (cbuf), "%.6f,", proj_parms[i]);
-            if (count < 0 || count >= sizeof (cbuf))
-            {
-                sprintf (errmsg, "Overflow of cbuf string");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            if (!append_meta (struct_meta, &meta_indx, cbuf))
-            {
-                sprintf (errmsg, "Error appending to metadata string ("
-                    "individual grid projection parameters)");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-        }
-
-        count = snprintf (cbuf, sizeof (cbuf), "\n");
-        if (count < 0 || count >= sizeof (cbuf))
-        {
-            sprintf (errmsg, "Overflow of cbuf string");
-            error_handler (true, FUNC_NAME, errmsg);
-            return (ERROR);
-        }
-
-        if (!append_meta (struct_meta, &meta_indx, cbuf))
-        {
-            sprintf (errmsg, "Error appending to metadata string (grid "
-                "projection parameters end)");
-            error_handler (true, FUNC_NAME, errmsg);
-            return (ERROR);
-        }
-    }
-  
-    switch (gmeta->proj_info.datum_type)
-    {
-        case (ESPA_WGS84):
-            sphere_code = SPHERE_WGS84;
-            strcpy (datum_str, "WGS84");
-            break;
-        case (ESPA_NAD83):
-            sphere_code = SPHERE_GRS80;
-            strcpy (datum_str, "NAD83");
-            break;
-        case (ESPA_NAD27):
-            sphere_code = SPHERE_CLARKE_1866;
-            strcpy (datum_str, "NAD27");
-            break;
-        case (ESPA_NODATUM):
-            sphere_code = -999;
-            strcpy (datum_str, "NoDatum");
-            break;
-    }
-  
-    /* Don't write the sphere code if this is the Geographic projection */
-    if (gmeta->proj_info.proj_type != GCTP_GEO_PROJ)
-    {
-        if (gmeta->proj_info.datum_type != ESPA_NODATUM)
-        {
-            count = snprintf (cbuf, sizeof (cbuf),
-                "\t\tSphereCode=%d\n", sphere_code);
-            if (count < 0 || count >= sizeof (cbuf))
-            {
-                sprintf (errmsg, "Overflow of cbuf string");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            if (!append_meta (struct_meta, &meta_indx, cbuf))
-            {
-                sprintf (errmsg, "Error appending to metadata string (grid "
-                    "information end)");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-        }
-    }
-  
-    count = snprintf (cbuf, sizeof (cbuf),
-        "\t\tDatum=%s\n"
-        "\t\tGridOrigin=HDFE_GD_UL\n", datum_str);
-    if (count < 0 || count >= sizeof (cbuf))
-    {
-        sprintf (errmsg, "Overflow of cbuf string");
+        sprintf (errmsg, "Error appending to metadata string (grid "
+            "projection information)");
         error_handler (true, FUNC_NAME, errmsg);
         return (ERROR);
     }
 
-    if (!append_meta (struct_meta, &meta_indx, cbuf))
-    {
-        sprintf (errmsg, "Error appending to metadata string (grid information "
-            "end)");
-        error_handler (true, FUNC_NAME, errmsg);
-        return (ERROR);
-    }
-  
     /* Put SDS group */
-    count = snprintf (cbuf, sizeof (cbuf),
+    if (!append_meta (&struct_meta,
         "\t\tGROUP=Dimension\n" 
         "\t\tEND_GROUP=Dimension\n"
-        "\t\tGROUP=DataField\n");
-    if (count < 0 || count >= sizeof (cbuf))
-    {
-        sprintf (errmsg, "Overflow of cbuf string");
-        error_handler (true, FUNC_NAME, errmsg);
-        return (ERROR);
-    }
-
-    if (!append_meta (struct_meta, &meta_indx, cbuf))
+        "\t\tGROUP=DataField\n"))
     {
         sprintf (errmsg, "Error appending to metadata string (SDS group "
             "start)");
@@ -570,17 +631,7 @@ int write_hdf_eos_attr
              xml_metadata->band[0].pixel_size[1]))
         {
             processed[isds] = true;
-            switch (xml_metadata->band[isds].data_type)
-            {
-                case ESPA_INT8: strcpy (dtype, "DFNT_INT8"); break;
-                case ESPA_UINT8: strcpy (dtype, "DFNT_UINT8"); break;
-                case ESPA_INT16: strcpy (dtype, "DFNT_INT16"); break;
-                case ESPA_UINT16: strcpy (dtype, "DFNT_UINT16"); break;
-                case ESPA_INT32: strcpy (dtype, "DFNT_INT32"); break;
-                case ESPA_UINT32: strcpy (dtype, "DFNT_UINT32"); break;
-                case ESPA_FLOAT32: strcpy (dtype, "DFNT_FLOAT32"); break;
-                case ESPA_FLOAT64: strcpy (dtype, "DFNT_FLOAT64"); break;
-            }
+            dtype = dfnt_type_names[xml_metadata->band[isds].data_type];
 
             count = snprintf (cbuf, sizeof (cbuf),
                 "\t\t\tOBJECT=DataField_%d\n"
@@ -597,7 +648,7 @@ int write_hdf_eos_attr
                 return (ERROR);
             }
 
-            if (!append_meta (struct_meta, &meta_indx, cbuf))
+            if (!append_meta (&struct_meta, cbuf))
             {
                 sprintf (errmsg, "Error appending to metadata string "
                     "(SDS group)");
@@ -609,19 +660,11 @@ int write_hdf_eos_attr
     }
   
     /* Close off the grid */
-    count = snprintf (cbuf, sizeof (cbuf),
+    if (!append_meta (&struct_meta,
       "\t\tEND_GROUP=DataField\n" 
       "\t\tGROUP=MergedFields\n" 
       "\t\tEND_GROUP=MergedFields\n"
-      "\tEND_GROUP=GRID_1\n");
-    if (count < 0 || count >= sizeof (cbuf))
-    {
-        sprintf (errmsg, "Overflow of cbuf string");
-        error_handler (true, FUNC_NAME, errmsg);
-        return (ERROR);
-    }
-
-    if (!append_meta (struct_meta, &meta_indx, cbuf))
+      "\tEND_GROUP=GRID_1\n"))
     {
         sprintf (errmsg, "Error appending to metadata string (SDS group end)");
         error_handler (true, FUNC_NAME, errmsg);
@@ -664,7 +707,7 @@ int write_hdf_eos_attr
                 return (ERROR);
             }
 
-            if (!append_meta (struct_meta, &meta_indx, cbuf))
+            if (!append_meta (&struct_meta, cbuf))
             {
                 sprintf (errmsg, "Error appending grid header to the metadata "
                     "string");
@@ -672,16 +715,6 @@ int write_hdf_eos_attr
                 return (ERROR);
             }
   
-            /* Get the projection name string */
-            switch (gmeta->proj_info.proj_type)
-            {
-                case (GCTP_GEO_PROJ): strcpy (proj_str, "GEO"); break;
-                case (GCTP_UTM_PROJ): strcpy (proj_str, "UTM"); break;
-                case (GCTP_PS_PROJ): strcpy (proj_str, "PS"); break;
-                case (GCTP_ALBERS_PROJ): strcpy (proj_str, "ALBERS"); break;
-                case (GCTP_SIN_PROJ): strcpy (proj_str, "SNSOID"); break;
-            }
-  
             /* If the grid origin is center, then adjust for the resolution.
                The corners will be written for the UL of the corner. */
             if (!strcmp (gmeta->proj_info.grid_origin, "CENTER"))
@@ -728,7 +761,7 @@ int write_hdf_eos_attr
                 return (ERROR);
             }
 
-            if (!append_meta (struct_meta, &meta_indx, cbuf))
+            if (!append_meta (&struct_meta, cbuf))
             {
                 sprintf (errmsg, "Error appending to metadata string (grid "
                     "information start)");
@@ -774,7 +807,7 @@ int write_hdf_eos_attr
                 }
             }
 
-            if (!append_meta (struct_meta, &meta_indx, cbuf))
+            if (!append_meta (&struct_meta, cbuf))
             {
                 sprintf (errmsg, "Error appending to metadata string (grid "
                     "information start)");
@@ -782,219 +815,21 @@ int write_hdf_eos_attr
                 return (ERROR);
             }
 
-            /* Write projection information */
-            if (gmeta->proj_info.proj_type == GCTP_UTM_PROJ)
-            {
-                /* Write the UTM zone */
-                count = snprintf (cbuf, sizeof (cbuf),
-                    "\t\tZoneCode=%d\n", gmeta->proj_info.utm_zone);
-                if (count < 0 || count >= sizeof (cbuf))
-                {
-                    sprintf (errmsg, "Overflow of cbuf string");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-
-                if (!append_meta (struct_meta, &meta_indx, cbuf))
-                {
-                    sprintf (errmsg, "Error appending to metadata string (zone "
-                        "number)");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
-            else if (gmeta->proj_info.proj_type != GCTP_GEO_PROJ)
-            {  /* don't write projection parameters for Geographic */
-                /* Write the projection parameters */
-                count = snprintf (cbuf, sizeof (cbuf), "\t\tProjParams=(");
-                if (count < 0 || count >= sizeof (cbuf))
-                {
-                    sprintf (errmsg, "Overflow of cbuf string");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-
-                if (!append_meta (struct_meta, &meta_indx, cbuf))
-                {
-                    sprintf (errmsg, "Error appending to metadata string (grid "
-                        "projection parameters start)");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-  
-                for (i = 0; i < NPROJ_PARAM; i++)
-                    proj_parms[i] = 0.0;
-        
-                switch (gmeta->proj_info.proj_type)
-                {
-                    case GCTP_GEO_PROJ:
-                        /* just use the already initialized zeros for the proj
-                           parms */
-                        break;
-            
-                    case GCTP_UTM_PROJ:
-                        /* UTM handled in the if statement above */
-                        break;
-        
-                    case GCTP_ALBERS_PROJ:
-                        proj_parms[2] =
-                            deg_to_dms (gmeta->proj_info.standard_parallel1);
-                        proj_parms[3] =
-                            deg_to_dms (gmeta->proj_info.standard_parallel2);
-                        proj_parms[4] =
-                            deg_to_dms (gmeta->proj_info.central_meridian);
-                        proj_parms[5] =
-                            deg_to_dms (gmeta->proj_info.origin_latitude);
-                        proj_parms[6] = gmeta->proj_info.false_easting;
-                        proj_parms[7] = gmeta->proj_info.false_northing;
-                        break;
-            
-                    case GCTP_PS_PROJ:
-                        proj_parms[4] =
-                            deg_to_dms (gmeta->proj_info.longitude_pole);
-                        proj_parms[5] =
-                            deg_to_dms (gmeta->proj_info.latitude_true_scale);
-                        proj_parms[6] = gmeta->proj_info.false_easting;
-                        proj_parms[7] = gmeta->proj_info.false_northing;
-                        break;
-            
-                    case GCTP_SIN_PROJ:
-                        proj_parms[0] = gmeta->proj_info.sphere_radius;
-                        proj_parms[4] =
-                            deg_to_dms (gmeta->proj_info.central_meridian);
-                        proj_parms[6] = gmeta->proj_info.false_easting;
-                        proj_parms[7] = gmeta->proj_info.false_northing;
-                        break;
-
-                    default:
-                        sprintf (errmsg, "Unsupported projection type (%d).  "
-                            "GEO projection code (%d) or UTM projection code "
-                            "(%d) or ALBERS projection code (%d) or PS "
-                            "projection code (%d) or SIN projection code (%d) "
-                            "expected.", gmeta->proj_info.proj_type,
-                            GCTP_GEO_PROJ, GCTP_UTM_PROJ, GCTP_ALBERS_PROJ,
-                            GCTP_PS_PROJ, GCTP_SIN_PROJ);
-                        error_handler (true, FUNC_NAME, errmsg);
-                        return (ERROR);
-                }
-
-                for (i = 0; i < NPROJ_PARAM; i++)
-                {
-                    if (i == NPROJ_PARAM-1)
-                        count = snprintf (cbuf, sizeof (cbuf), "%.6f)",
-                            proj_parms[i]);
-                    else
-                        count = snprintf (cbuf, sizeof (cbuf), "%.6f,",
-                            proj_parms[i]);
-                    if (count < 0 || count >= sizeof (cbuf))
-                    {
-                        sprintf (errmsg, "Overflow of cbuf string");
-                        error_handler (true, FUNC_NAME, errmsg);
-                        return (ERROR);
-                    }
-
-                    if (!append_meta (struct_meta, &meta_indx, cbuf))
-                    {
-                        sprintf (errmsg, "Error appending to metadata string ("
-                            "individual grid projection parameters)");
-                        error_handler (true, FUNC_NAME, errmsg);
-                        return (ERROR);
-                    }
-                }
-
-                count = snprintf (cbuf, sizeof (cbuf), "\n");
-                if (count < 0 || count >= sizeof (cbuf))
-                {
-                    sprintf (errmsg, "Overflow of cbuf string");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-
-                if (!append_meta (struct_meta, &meta_indx, cbuf))
-                {
-                    sprintf (errmsg, "Error appending to metadata string (grid "
-                        "projection parameters end)");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
-  
-            switch (gmeta->proj_info.datum_type)
-            {
-                case (ESPA_WGS84):
-                    sphere_code = SPHERE_WGS84;
-                    strcpy (datum_str, "WGS84");
-                    break;
-                case (ESPA_NAD83):
-                    sphere_code = SPHERE_GRS80;
-                    strcpy (datum_str, "NAD83");
-                    break;
-                case (ESPA_NAD27):
-                    sphere_code = SPHERE_CLARKE_1866;
-                    strcpy (datum_str, "NAD27");
-                    break;
-                case (ESPA_NODATUM):
-                    sphere_code = -999;
-                    strcpy (datum_str, "NoDatum");
-                    break;
-            }
-          
-            /* Don't write the sphere code if this is the Geographic
-               projection */
-            if (gmeta->proj_info.proj_type != GCTP_GEO_PROJ)
-            {
-                if (gmeta->proj_info.datum_type != ESPA_NODATUM)
-                {
-                    count = snprintf (cbuf, sizeof (cbuf),
-                        "\t\tSphereCode=%d\n", sphere_code);
-                    if (count < 0 || count >= sizeof (cbuf))
-                    {
-                        sprintf (errmsg, "Overflow of cbuf string");
-                        error_handler (true, FUNC_NAME, errmsg);
-                        return (ERROR);
-                    }
-        
-                    if (!append_meta (struct_meta, &meta_indx, cbuf))
-                    {
-                        sprintf (errmsg, "Error appending to metadata string "
-                            "(grid information end)");
-                        error_handler (true, FUNC_NAME, errmsg);
-                        return (ERROR);
-                    }
-                }
-            }
-        
-            count = snprintf (cbuf, sizeof (cbuf),
-                "\t\tDatum=%s\n"
-                "\t\tGridOrigin=HDFE_GD_UL\n", datum_str);
-            if (count < 0 || count >= sizeof (cbuf))
-            {
-                sprintf (errmsg, "Overflow of cbuf string");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-        
-            if (!append_meta (struct_meta, &meta_indx, cbuf))
+            /* Write the projection information, sphere code, datum,
+               and grid origin from the lines formatted up front */
+            if (!append_meta (&struct_meta, proj_text))
             {
                 sprintf (errmsg, "Error appending to metadata string (grid "
-                    "information end)");
+                    "projection information)");
                 error_handler (true, FUNC_NAME, errmsg);
                 return (ERROR);
             }
-  
+
             /* Put SDS group */
-            count = snprintf (cbuf, sizeof (cbuf),
+            if (!append_meta (&struct_meta,
                 "\t\tGROUP=Dimension\n" 
                 "\t\tEND_GROUP=Dimension\n"
-                "\t\tGROUP=DataField\n");
-            if (count < 0 || count >= sizeof (cbuf))
-            {
-                sprintf (errmsg, "Overflow of cbuf string");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            if (!append_meta (struct_meta, &meta_indx, cbuf))
+                "\t\tGROUP=DataField\n"))
             {
                 sprintf (errmsg, "Error appending to metadata string (SDS "
                     "group start)");
@@ -1013,17 +848,7 @@ int write_hdf_eos_attr
                      xml_metadata->band[isds].pixel_size[1]))
                 {
                     processed[i] = true;
-                    switch (xml_metadata->band[i].data_type)
-                    {
-                        case ESPA_INT8: strcpy(dtype, "DFNT_INT8"); break;
-                        case ESPA_UINT8: strcpy(dtype, "DFNT_UINT8"); break;
-                        case ESPA_INT16: strcpy(dtype, "DFNT_INT16"); break;
-                        case ESPA_UINT16: strcpy(dtype, "DFNT_UINT16"); break;
-                        case ESPA_INT32: strcpy(dtype, "DFNT_INT32"); break;
-                        case ESPA_UINT32: strcpy(dtype, "DFNT_UINT32"); break;
-                        case ESPA_FLOAT32: strcpy(dtype, "DFNT_FLOAT32"); break;
-                        case ESPA_FLOAT64: strcpy(dtype, "DFNT_FLOAT64"); break;
-                    }
+                    dtype = dfnt_type_names[xml_metadata->band[i].data_type];
 
                     count = snprintf (cbuf, sizeof (cbuf),
                         "\t\t\tOBJECT=DataField_%d\n"
@@ -1039,7 +864,7 @@ int write_hdf_eos_attr
                         error_handler (true, FUNC_NAME, errmsg);
                         return (ERROR);
                     }
-                    if (!append_meta (struct_meta, &meta_indx, cbuf))
+                    if (!append_meta (&struct_meta, cbuf))
                     {
                         sprintf (errmsg, "Error appending to metadata string "
                             "(SDS group)");
@@ -1063,7 +888,7 @@ int write_hdf_eos_attr
                 return (ERROR);
             }
 
-            if (!append_meta (struct_meta, &meta_indx, cbuf))
+            if (!append_meta (&struct_meta, cbuf))
             {
                 sprintf (errmsg, "Error appending to metadata string (SDS "
                     "group end)");
@@ -1091,19 +916,11 @@ int write_hdf_eos_attr
     }  /* end while !done */
 
     /* Put trailer */
-    count = snprintf (cbuf, sizeof (cbuf),
+    if (!append_meta (&struct_meta,
         "END_GROUP=GridStructure\n"
         "GROUP=PointStructure\n"
         "END_GROUP=PointStructure\n"
-        "END\n");
-    if (count < 0 || count >= sizeof (cbuf))
-    {
-        sprintf (errmsg, "Overflow of cbuf string");
-        error_handler (true, FUNC_NAME, errmsg);
-        return (ERROR);
-    }
-
-    if (!append_meta (struct_meta, &meta_indx, cbuf))
+        "END\n"))
     {
         sprintf (errmsg, "Error appending to metadata string (tail)");
         error_handler (true, FUNC_NAME, errmsg);
@@ -1131,15 +948,19 @@ int write_hdf_eos_attr
     }
   
     attr.type = DFNT_CHAR8;
-    attr.nval = strlen (struct_meta);
+    attr.nval = struct_meta.used;
     attr.name = OUTPUT_STRUCT_METADATA;
-    if (put_attr_string (hdf_file_id, &attr, struct_meta) != SUCCESS)
+    if (put_attr_string (hdf_file_id, &attr, struct_meta.buf) != SUCCESS)
     {
         sprintf (errmsg, "Error writing attribute (struct_meta)");
         error_handler (true, FUNC_NAME, errmsg);
         return (ERROR);
     }
-  
+
+    /* The structural metadata has been written, so the builder is no longer
+       needed */
+    free_meta_builder (&struct_meta);
+
     if (SDend (hdf_file_id) == HDF_ERROR) 
     {
         sprintf (errmsg, "Error ending SD access");
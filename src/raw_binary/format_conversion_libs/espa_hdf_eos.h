@@ -40,14 +40,36 @@ NOTES:
 #define SPHERE_GRS80 8
 #define SPHERE_WGS84 12
 
-/* size of the metadata string for defining the HDF-EOS metadata */
+/* initial size of the metadata string for defining the HDF-EOS metadata */
 #define ESPA_MAX_METADATA_SIZE 10240
 
+/* additional metadata bytes estimated per band when pre-sizing the metadata
+   buffer; covers the per-field grid entries */
+#define ESPA_METADATA_BAND_SIZE 512
+
+/* Growable buffer for building the HDF-EOS structural metadata */
+typedef struct
+{
+    char *buf;      /* metadata string storage */
+    size_t used;    /* number of bytes currently used, without the '\0' */
+    size_t alloc;   /* number of bytes currently allocated */
+} Espa_meta_builder_t;
+
 /* Prototypes */
+bool init_meta_builder
+(
+    Espa_meta_builder_t *meta,  /* I/O: metadata builder to be initialized */
+    int nbands   /* I: number of bands, used to estimate the capacity */
+);
+
+void free_meta_builder
+(
+    Espa_meta_builder_t *meta   /* I/O: metadata builder to be freed */
+);
+
 bool append_meta
 (
-    char *cbuf,  /* I/O: input metadata buffer */
-    int *ic,     /* I/O: index of current location in metadata buffer */
+    Espa_meta_builder_t *meta,  /* I/O: metadata builder */
     char *str    /* I: string to append to the metadata buffer */
 );
 
@@ -0,0 +1,495 @@
+/*****************************************************************************
+FILE: espa_scene_context.c
+
+PURPOSE: Contains functions for the reusable per-scene context shared across
+the format conversion entry points.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added the write-behind task so a stage can queue
+                              its final metadata and header writes behind the
+                              scene
+
+NOTES:
+*****************************************************************************/
+
+#include <string.h>
+#include "espa_scene_context.h"
+#include "espa_buffer.h"
+
+/******************************************************************************
+MODULE:  init_scene_context
+
+PURPOSE: Initialize the scene context to an empty state.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void init_scene_context
+(
+    Espa_scene_context_t *context  /* I/O: scene context to be initialized */
+)
+{
+    memset (context, 0, sizeof (*context));
+}
+
+
+/******************************************************************************
+MODULE:  load_scene_context_metadata
+
+PURPOSE: Make sure the scene context holds the parsed metadata for the
+specified XML file.  If the context already caches the metadata for this file
+then nothing is parsed; otherwise the file is validated and parsed and the
+context takes ownership of the result.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error validating or parsing the metadata
+SUCCESS         The context holds the metadata for this file
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+int load_scene_context_metadata
+(
+    Espa_scene_context_t *context, /* I/O: scene context holding the cached
+                                          metadata */
+    char *espa_xml_file            /* I: input ESPA XML metadata filename */
+)
+{
+    char FUNC_NAME[] = "load_scene_context_metadata";  /* function name */
+    char errmsg[STR_SIZE];    /* error message */
+    int count;                /* number of chars copied in snprintf */
+
+    /* Nothing to do if the metadata for this file is already cached */
+    if (context->metadata_valid &&
+        !strcmp (context->xml_file, espa_xml_file))
+        return (SUCCESS);
+
+    /* Release whatever scene was cached before */
+    invalidate_scene_context_metadata (context);
+
+    /* Validate the input metadata file */
+    if (validate_xml_file (espa_xml_file) != SUCCESS)
+    {  /* Error messages already written */
+        return (ERROR);
+    }
+
+    /* Initialize the metadata structure */
+    init_metadata_struct (&context->xml_metadata);
+
+    /* Parse the metadata file into our internal metadata structure; also
+       allocates space as needed for various pointers in the global and band
+       metadata */
+    if (parse_metadata (espa_xml_file, &context->xml_metadata) != SUCCESS)
+    {  /* Error messages already written */
+        return (ERROR);
+    }
+
+    count = snprintf (context->xml_file, sizeof (context->xml_file), "%s",
+        espa_xml_file);
+    if (count < 0 || count >= sizeof (context->xml_file))
+    {
+        sprintf (errmsg, "Overflow of context->xml_file string");
+        error_handler (true, FUNC_NAME, errmsg);
+        free_metadata (&context->xml_metadata);
+        return (ERROR);
+    }
+
+    context->metadata_valid = true;
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  adopt_scene_context_metadata
+
+PURPOSE: Take ownership of metadata which a stage already built in memory, so
+the following stages can use it without re-parsing the XML file.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error caching the metadata
+SUCCESS         The context took ownership of the metadata
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The metadata structure is copied by value, which transfers the
+     ownership of the pointers inside it.  The caller must not use or free
+     the structure after this call.
+******************************************************************************/
+int adopt_scene_context_metadata
+(
+    Espa_scene_context_t *context, /* I/O: scene context to take ownership of
+                                          the metadata */
+    char *espa_xml_file,           /* I: XML file the metadata describes */
+    Espa_internal_meta_t *xml_metadata  /* I: parsed metadata; ownership is
+                                          transferred to the context and the
+                                          caller must not use or free it */
+)
+{
+    char FUNC_NAME[] = "adopt_scene_context_metadata";  /* function name */
+    char errmsg[STR_SIZE];    /* error message */
+    int count;                /* number of chars copied in snprintf */
+
+    /* Release whatever scene was cached before */
+    invalidate_scene_context_metadata (context);
+
+    count = snprintf (context->xml_file, sizeof (context->xml_file), "%s",
+        espa_xml_file);
+    if (count < 0 || count >= sizeof (context->xml_file))
+    {
+        sprintf (errmsg, "Overflow of context->xml_file string");
+        error_handler (true, FUNC_NAME, errmsg);
+        free_metadata (xml_metadata);
+        return (ERROR);
+    }
+
+    context->xml_metadata = *xml_metadata;
+    context->metadata_valid = true;
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  invalidate_scene_context_metadata
+
+PURPOSE: Release the cached metadata and the geolocation mapping derived from
+it.  Stages which modify the metadata in place (the HDF and GeoTIFF stages
+rewrite the band filenames for their products) call this when they finish, so
+a later stage parses the XML file fresh instead of seeing the modified copy.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void invalidate_scene_context_metadata
+(
+    Espa_scene_context_t *context  /* I/O: scene context whose cached
+                                          metadata is to be released */
+)
+{
+    /* Complete any queued write-behind task first since it may still be
+       using the cached metadata; errors were already reported by the task
+       itself */
+    wait_scene_context_writes (context);
+
+    if (context->metadata_valid)
+        free_metadata (&context->xml_metadata);
+    context->metadata_valid = false;
+    context->xml_file[0] = '\0';
+
+    free (context->geoloc_map);
+    context->geoloc_map = NULL;
+}
+
+
+/******************************************************************************
+MODULE:  get_scene_context_geoloc
+
+PURPOSE: Return the geolocation mapping for the cached scene, setting it up
+on the first call and reusing it afterwards.
+
+RETURN VALUE:
+Type = Geoloc_t *
+Value           Description
+-----           -----------
+NULL            Error setting up the mapping, or no metadata is cached
+(mapping)       Geolocation mapping for the cached scene, owned by the
+                context
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+Geoloc_t *get_scene_context_geoloc
+(
+    Espa_scene_context_t *context  /* I/O: scene context holding the cached
+                                          metadata and mapping */
+)
+{
+    char FUNC_NAME[] = "get_scene_context_geoloc";  /* function name */
+    char errmsg[STR_SIZE];    /* error message */
+
+    if (context->geoloc_map != NULL)
+        return (context->geoloc_map);
+
+    if (!context->metadata_valid)
+    {
+        sprintf (errmsg, "No metadata is cached in the scene context");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (NULL);
+    }
+
+    /* Get the geolocation information from the XML metadata */
+    if (!get_geoloc_info (&context->xml_metadata, &context->geoloc_def))
+    {
+        sprintf (errmsg, "Getting the geolocation information from the XML "
+            "metadata");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (NULL);
+    }
+
+    /* Set up the mapping structure for the geolocation information */
+    context->geoloc_map = setup_mapping (&context->geoloc_def);
+    if (context->geoloc_map == NULL)
+    {
+        sprintf (errmsg, "Setting up the geolocation mapping structure");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (NULL);
+    }
+
+    return (context->geoloc_map);
+}
+
+
+/******************************************************************************
+MODULE:  scene_context_writer
+
+PURPOSE: Thread routine which runs the queued write-behind task and records
+its status in the context.
+
+RETURN VALUE:
+Type = void *
+Value           Description
+-----           -----------
+NULL            Always returned
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static void *scene_context_writer
+(
+    void *context_ptr     /* I/O: scene context running the task
+                                 (Espa_scene_context_t) */
+)
+{
+    Espa_scene_context_t *context = context_ptr;  /* scene context */
+
+    context->write_status = context->write_task (context->write_arg);
+    return (NULL);
+}
+
+
+/******************************************************************************
+MODULE:  start_scene_context_writes
+
+PURPOSE: Queue a write-behind task for the scene, so the final metadata and
+header serialization runs behind the driver instead of delaying the next
+stage or scene.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           A previously queued task reported an error
+SUCCESS         Task was queued (or run synchronously if no thread could be
+                started)
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Stages which read or remove the files the task writes must call
+     wait_scene_context_writes first as a barrier.  The barrier is also
+     taken when the cached metadata is invalidated or the context is freed,
+     since the task commonly serializes from the cached metadata.
+******************************************************************************/
+int start_scene_context_writes
+(
+    Espa_scene_context_t *context, /* I/O: scene context to run the task */
+    int (*write_task)(void *write_arg),  /* I: task which serializes the
+                                          final metadata/header products for
+                                          the scene */
+    void *write_arg                /* I: argument handed to the task; must
+                                          stay valid until the writes are
+                                          waited on */
+)
+{
+    char FUNC_NAME[] = "start_scene_context_writes";  /* function name */
+    char errmsg[STR_SIZE];    /* error message */
+
+    /* Complete any earlier task first so the context only tracks one
+       outstanding write, propagating its status */
+    if (wait_scene_context_writes (context) != SUCCESS)
+    {  /* Error messages already written by the task */
+        return (ERROR);
+    }
+
+    context->write_task = write_task;
+    context->write_arg = write_arg;
+    context->write_status = SUCCESS;
+    if (pthread_create (&context->writer_thread, NULL, scene_context_writer,
+        context) != 0)
+    {
+        /* No thread could be started, so just run the task synchronously */
+        sprintf (errmsg, "Unable to create the write-behind thread; running "
+            "the writes synchronously");
+        error_handler (false, FUNC_NAME, errmsg);
+        return (write_task (write_arg));
+    }
+
+    context->write_pending = true;
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  wait_scene_context_writes
+
+PURPOSE: Barrier which completes any queued write-behind task for the scene
+and reports its status.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           The queued task reported an error
+SUCCESS         No task was queued or the task completed successfully
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+int wait_scene_context_writes
+(
+    Espa_scene_context_t *context  /* I/O: scene context whose queued writes
+                                          are to be completed */
+)
+{
+    char FUNC_NAME[] = "wait_scene_context_writes";  /* function name */
+    char errmsg[STR_SIZE];    /* error message */
+
+    if (!context->write_pending)
+        return (SUCCESS);
+
+    context->write_pending = false;
+    if (pthread_join (context->writer_thread, NULL) != 0)
+    {
+        sprintf (errmsg, "Unable to join the write-behind thread");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    return (context->write_status);
+}
+
+
+/******************************************************************************
+MODULE:  get_scene_context_band_buffer
+
+PURPOSE: Return a pooled buffer of at least the requested size, growing the
+buffer when needed and reusing it across bands and stages otherwise.
+
+RETURN VALUE:
+Type = void *
+Value           Description
+-----           -----------
+NULL            Error allocating the buffer
+(buffer)        Buffer of at least the requested size, owned by the context
+                and valid until the next call or free_scene_context
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void *get_scene_context_band_buffer
+(
+    Espa_scene_context_t *context, /* I/O: scene context owning the buffer */
+    size_t size                    /* I: number of bytes needed */
+)
+{
+    char FUNC_NAME[] = "get_scene_context_band_buffer";  /* function name */
+    char errmsg[STR_SIZE];    /* error message */
+
+    if (context->band_buffer != NULL && context->band_buffer_size >= size)
+        return (context->band_buffer);
+
+    espa_free_buffer (context->band_buffer);
+    context->band_buffer = espa_alloc_buffer (size);
+    if (context->band_buffer == NULL)
+    {
+        sprintf (errmsg, "Allocating %lu bytes for the pooled band buffer",
+            (unsigned long) size);
+        error_handler (true, FUNC_NAME, errmsg);
+        context->band_buffer_size = 0;
+        return (NULL);
+    }
+    context->band_buffer_size = size;
+
+    return (context->band_buffer);
+}
+
+
+/******************************************************************************
+MODULE:  free_scene_context
+
+PURPOSE: Release everything owned by the scene context.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void free_scene_context
+(
+    Espa_scene_context_t *context  /* I/O: scene context to be released */
+)
+{
+    invalidate_scene_context_metadata (context);
+    espa_free_buffer (context->band_buffer);
+    context->band_buffer = NULL;
+    context->band_buffer_size = 0;
+}
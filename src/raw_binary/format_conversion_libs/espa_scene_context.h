@@ -0,0 +1,126 @@
+/*****************************************************************************
+FILE: espa_scene_context.h
+
+PURPOSE: Contains defines and prototypes for the reusable per-scene context
+shared across the format conversion entry points.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added the write-behind task so a stage can queue
+                              its final metadata and header writes behind the
+                              scene
+
+NOTES:
+  1. Each conversion entry point independently re-derives per-scene state:
+     the parsed XML metadata, the geolocation mapping, and band-sized
+     buffers.  A driver running several conversion stages for one scene can
+     create a single scene context, pass it to each stage, and the stages
+     share that state instead of re-deriving it.
+  2. A stage whose final work is serializing metadata or header files which
+     it does not read back can queue that work as a write-behind task, so
+     the driver can start the next stage or scene while the files are
+     written.  Stages which read or remove those files call
+     wait_scene_context_writes first as a barrier.
+*****************************************************************************/
+
+#ifndef ESPA_SCENE_CONTEXT_H
+#define ESPA_SCENE_CONTEXT_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <pthread.h>
+#include "error_handler.h"
+#include "espa_metadata.h"
+#include "parse_metadata.h"
+#include "espa_geoloc.h"
+
+/* Per-scene state shared across the conversion entry points */
+typedef struct
+{
+    char xml_file[STR_SIZE];  /* XML file the cached metadata came from;
+                                 empty if no metadata is cached */
+    Espa_internal_meta_t xml_metadata;  /* parsed scene metadata */
+    bool metadata_valid;      /* is the cached metadata populated? */
+    Space_def_t geoloc_def;   /* geolocation space definition */
+    Geoloc_t *geoloc_map;     /* cached geolocation mapping, set up lazily
+                                 from the cached metadata */
+    void *band_buffer;        /* pooled band-sized buffer, grown as needed */
+    size_t band_buffer_size;  /* size of the pooled band buffer in bytes */
+    pthread_t writer_thread;  /* thread running the queued write task */
+    bool write_pending;       /* is a queued write task outstanding? */
+    int write_status;         /* SUCCESS/ERROR result of the write task */
+    int (*write_task)(void *write_arg);  /* queued write-behind task */
+    void *write_arg;          /* argument handed to the write task */
+} Espa_scene_context_t;
+
+/* Prototypes */
+void init_scene_context
+(
+    Espa_scene_context_t *context  /* I/O: scene context to be initialized */
+);
+
+int load_scene_context_metadata
+(
+    Espa_scene_context_t *context, /* I/O: scene context holding the cached
+                                          metadata */
+    char *espa_xml_file            /* I: input ESPA XML metadata filename */
+);
+
+int adopt_scene_context_metadata
+(
+    Espa_scene_context_t *context, /* I/O: scene context to take ownership of
+                                          the metadata */
+    char *espa_xml_file,           /* I: XML file the metadata describes */
+    Espa_internal_meta_t *xml_metadata  /* I: parsed metadata; ownership is
+                                          transferred to the context and the
+                                          caller must not use or free it */
+);
+
+void invalidate_scene_context_metadata
+(
+    Espa_scene_context_t *context  /* I/O: scene context whose cached
+                                          metadata is to be released */
+);
+
+Geoloc_t *get_scene_context_geoloc
+(
+    Espa_scene_context_t *context  /* I/O: scene context holding the cached
+                                          metadata and mapping */
+);
+
+int start_scene_context_writes
+(
+    Espa_scene_context_t *context, /* I/O: scene context to run the task */
+    int (*write_task)(void *write_arg),  /* I: task which serializes the
+                                          final metadata/header products for
+                                          the scene */
+    void *write_arg                /* I: argument handed to the task; must
+                                          stay valid until the writes are
+                                          waited on */
+);
+
+int wait_scene_context_writes
+(
+    Espa_scene_context_t *context  /* I/O: scene context whose queued writes
+                                          are to be completed */
+);
+
+void *get_scene_context_band_buffer
+(
+    Espa_scene_context_t *context, /* I/O: scene context owning the buffer */
+    size_t size                    /* I: number of bytes needed */
+);
+
+void free_scene_context
+(
+    Espa_scene_context_t *context  /* I/O: scene context to be released */
+);
+
+#endif
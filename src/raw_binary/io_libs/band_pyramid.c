@@ -0,0 +1,564 @@
+/*****************************************************************************
+FILE: band_pyramid.c
+
+PURPOSE: Contains functions for generating reduced-resolution pyramid levels
+of a raw binary band, for browse and overview products.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The band is streamed once in chunks of ESPA_PYRAMID_CHUNK_LINES lines;
+     each chunk cascades through the levels (the 2x lines are reduced from
+     the chunk, the 4x lines from the 2x lines, and so on), so all the
+     levels are emitted from the single read of the band.
+  2. Image bands are reduced with 2x2 averaging which skips the fill pixels
+     (a reduced pixel is fill only when all its source pixels are fill); qa
+     and class bands are reduced with a 2x2 mode filter so no new class
+     values are invented.
+  3. The reduction loops are compiled with optimization (see the Makefile)
+     so they vectorize where the fill handling allows.
+*****************************************************************************/
+
+#include <math.h>
+#include <stdint.h>
+#include "band_pyramid.h"
+#include "espa_perf.h"
+
+/* Generates a 2x2 averaging reducer for an integer type.  The second input
+   line may be the same as the first (odd number of lines) and the last
+   sample pair may be degenerate (odd number of samples); the duplicated
+   pixels just weight the average, which keeps the loop branch-free on the
+   sample clamping. */
+#define PYRAMID_AVG_INT_KERNEL(name, type) \
+static void name \
+( \
+    const type * restrict in0,  /* I: first input line */ \
+    const type * restrict in1,  /* I: second input line */ \
+    int in_nsamps,        /* I: number of samples in the input lines */ \
+    type * restrict out,  /* O: reduced output line */ \
+    int out_nsamps,       /* I: number of samples in the output line */ \
+    bool has_fill,        /* I: does the band define a fill value */ \
+    type fill             /* I: fill value for the band */ \
+) \
+{ \
+    long sum;             /* accumulated sample values */ \
+    int n;                /* number of non-fill samples accumulated */ \
+    int j, s0, s1;        /* sample loop counter and source samples */ \
+    type v00, v01, v10, v11;  /* the 2x2 source pixels */ \
+ \
+    for (j = 0; j < out_nsamps; j++) \
+    { \
+        s0 = 2 * j; \
+        s1 = (s0 + 1 < in_nsamps) ? s0 + 1 : s0; \
+        v00 = in0[s0]; \
+        v01 = in0[s1]; \
+        v10 = in1[s0]; \
+        v11 = in1[s1]; \
+        if (!has_fill) \
+        { \
+            out[j] = (type) (((long) v00 + v01 + v10 + v11 + 2) >> 2); \
+            continue; \
+        } \
+        sum = 0; \
+        n = 0; \
+        if (v00 != fill) { sum += v00; n++; } \
+        if (v01 != fill) { sum += v01; n++; } \
+        if (v10 != fill) { sum += v10; n++; } \
+        if (v11 != fill) { sum += v11; n++; } \
+        out[j] = (n == 0) ? fill : (type) lround ((double) sum / n); \
+    } \
+}
+
+/* Generates a 2x2 averaging reducer for a floating point type */
+#define PYRAMID_AVG_FLT_KERNEL(name, type) \
+static void name \
+( \
+    const type * restrict in0,  /* I: first input line */ \
+    const type * restrict in1,  /* I: second input line */ \
+    int in_nsamps,        /* I: number of samples in the input lines */ \
+    type * restrict out,  /* O: reduced output line */ \
+    int out_nsamps,       /* I: number of samples in the output line */ \
+    bool has_fill,        /* I: does the band define a fill value */ \
+    type fill             /* I: fill value for the band */ \
+) \
+{ \
+    double sum;           /* accumulated sample values */ \
+    int n;                /* number of non-fill samples accumulated */ \
+    int j, s0, s1;        /* sample loop counter and source samples */ \
+    type v00, v01, v10, v11;  /* the 2x2 source pixels */ \
+ \
+    for (j = 0; j < out_nsamps; j++) \
+    { \
+        s0 = 2 * j; \
+        s1 = (s0 + 1 < in_nsamps) ? s0 + 1 : s0; \
+        v00 = in0[s0]; \
+        v01 = in0[s1]; \
+        v10 = in1[s0]; \
+        v11 = in1[s1]; \
+        if (!has_fill) \
+        { \
+            out[j] = (type) (((double) v00 + v01 + v10 + v11) * 0.25); \
+            continue; \
+        } \
+        sum = 0.0; \
+        n = 0; \
+        if (v00 != fill) { sum += v00; n++; } \
+        if (v01 != fill) { sum += v01; n++; } \
+        if (v10 != fill) { sum += v10; n++; } \
+        if (v11 != fill) { sum += v11; n++; } \
+        out[j] = (n == 0) ? fill : (type) (sum / n); \
+    } \
+}
+
+/* Generates a 2x2 mode-filter reducer for an integer type.  The most common
+   of the (non-fill) source pixels wins; ties go to the earliest pixel in
+   reading order, and a reduced pixel is fill only when all its source
+   pixels are fill. */
+#define PYRAMID_MODE_KERNEL(name, type) \
+static void name \
+( \
+    const type * restrict in0,  /* I: first input line */ \
+    const type * restrict in1,  /* I: second input line */ \
+    int in_nsamps,        /* I: number of samples in the input lines */ \
+    type * restrict out,  /* O: reduced output line */ \
+    int out_nsamps,       /* I: number of samples in the output line */ \
+    bool has_fill,        /* I: does the band define a fill value */ \
+    type fill             /* I: fill value for the band */ \
+) \
+{ \
+    type v[4];            /* the 2x2 source pixels */ \
+    int count, best_count;  /* occurrence counts of the source pixels */ \
+    type best;            /* most common source pixel so far */ \
+    int j, s0, s1;        /* sample loop counter and source samples */ \
+    int k, m;             /* source pixel loop counters */ \
+ \
+    for (j = 0; j < out_nsamps; j++) \
+    { \
+        s0 = 2 * j; \
+        s1 = (s0 + 1 < in_nsamps) ? s0 + 1 : s0; \
+        v[0] = in0[s0]; \
+        v[1] = in0[s1]; \
+        v[2] = in1[s0]; \
+        v[3] = in1[s1]; \
+        best = fill; \
+        best_count = 0; \
+        for (k = 0; k < 4; k++) \
+        { \
+            if (has_fill && v[k] == fill) \
+                continue; \
+            count = 0; \
+            for (m = 0; m < 4; m++) \
+                if (v[m] == v[k]) \
+                    count++; \
+            if (count > best_count) \
+            { \
+                best = v[k]; \
+                best_count = count; \
+            } \
+        } \
+        out[j] = (best_count == 0) ? fill : best; \
+    } \
+}
+
+PYRAMID_AVG_INT_KERNEL (pyramid_avg_uint8, uint8_t)
+PYRAMID_AVG_INT_KERNEL (pyramid_avg_int8, int8_t)
+PYRAMID_AVG_INT_KERNEL (pyramid_avg_uint16, uint16_t)
+PYRAMID_AVG_INT_KERNEL (pyramid_avg_int16, int16_t)
+PYRAMID_AVG_INT_KERNEL (pyramid_avg_uint32, uint32_t)
+PYRAMID_AVG_INT_KERNEL (pyramid_avg_int32, int32_t)
+PYRAMID_AVG_FLT_KERNEL (pyramid_avg_float32, float)
+PYRAMID_AVG_FLT_KERNEL (pyramid_avg_float64, double)
+
+PYRAMID_MODE_KERNEL (pyramid_mode_uint8, uint8_t)
+PYRAMID_MODE_KERNEL (pyramid_mode_int8, int8_t)
+PYRAMID_MODE_KERNEL (pyramid_mode_uint16, uint16_t)
+PYRAMID_MODE_KERNEL (pyramid_mode_int16, int16_t)
+PYRAMID_MODE_KERNEL (pyramid_mode_uint32, uint32_t)
+PYRAMID_MODE_KERNEL (pyramid_mode_int32, int32_t)
+
+
+/******************************************************************************
+MODULE:  pyramid_reduce_lines (static)
+
+PURPOSE:  Reduces a pair of input lines to one output line with the reducer
+matching the band's data type and category.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Unsupported data type for the reduction
+SUCCESS         Output line was produced
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Floating point class bands don't make sense, so the mode filter only
+     supports the integer types.
+******************************************************************************/
+static int pyramid_reduce_lines
+(
+    Espa_band_meta_t *bmeta,  /* I: metadata for the band being reduced */
+    bool use_mode,        /* I: use the mode filter instead of averaging */
+    const void *in0,      /* I: first input line */
+    const void *in1,      /* I: second input line (may be the first again) */
+    int in_nsamps,        /* I: number of samples in the input lines */
+    void *out,            /* O: reduced output line */
+    int out_nsamps        /* I: number of samples in the output line */
+)
+{
+    char FUNC_NAME[] = "pyramid_reduce_lines";   /* function name */
+    char errmsg[STR_SIZE];    /* error message */
+    bool has_fill = (bmeta->fill_value != ESPA_INT_META_FILL);
+                              /* does the band define a fill value */
+    long fill = bmeta->fill_value;  /* fill value for the band */
+
+    switch (bmeta->data_type)
+    {
+        case ESPA_UINT8:
+            if (use_mode)
+                pyramid_mode_uint8 (in0, in1, in_nsamps, out, out_nsamps,
+                    has_fill, (uint8_t) fill);
+            else
+                pyramid_avg_uint8 (in0, in1, in_nsamps, out, out_nsamps,
+                    has_fill, (uint8_t) fill);
+            break;
+
+        case ESPA_INT8:
+            if (use_mode)
+                pyramid_mode_int8 (in0, in1, in_nsamps, out, out_nsamps,
+                    has_fill, (int8_t) fill);
+            else
+                pyramid_avg_int8 (in0, in1, in_nsamps, out, out_nsamps,
+                    has_fill, (int8_t) fill);
+            break;
+
+        case ESPA_UINT16:
+            if (use_mode)
+                pyramid_mode_uint16 (in0, in1, in_nsamps, out, out_nsamps,
+                    has_fill, (uint16_t) fill);
+            else
+                pyramid_avg_uint16 (in0, in1, in_nsamps, out, out_nsamps,
+                    has_fill, (uint16_t) fill);
+            break;
+
+        case ESPA_INT16:
+            if (use_mode)
+                pyramid_mode_int16 (in0, in1, in_nsamps, out, out_nsamps,
+                    has_fill, (int16_t) fill);
+            else
+                pyramid_avg_int16 (in0, in1, in_nsamps, out, out_nsamps,
+                    has_fill, (int16_t) fill);
+            break;
+
+        case ESPA_UINT32:
+            if (use_mode)
+                pyramid_mode_uint32 (in0, in1, in_nsamps, out, out_nsamps,
+                    has_fill, (uint32_t) fill);
+            else
+                pyramid_avg_uint32 (in0, in1, in_nsamps, out, out_nsamps,
+                    has_fill, (uint32_t) fill);
+            break;
+
+        case ESPA_INT32:
+            if (use_mode)
+                pyramid_mode_int32 (in0, in1, in_nsamps, out, out_nsamps,
+                    has_fill, (int32_t) fill);
+            else
+                pyramid_avg_int32 (in0, in1, in_nsamps, out, out_nsamps,
+                    has_fill, (int32_t) fill);
+            break;
+
+        case ESPA_FLOAT32:
+            if (use_mode)
+            {
+                sprintf (errmsg, "Mode filter is not supported for floating "
+                    "point band %.1024s.", bmeta->name);
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
+            }
+            pyramid_avg_float32 (in0, in1, in_nsamps, out, out_nsamps,
+                has_fill, (float) fill);
+            break;
+
+        case ESPA_FLOAT64:
+            if (use_mode)
+            {
+                sprintf (errmsg, "Mode filter is not supported for floating "
+                    "point band %.1024s.", bmeta->name);
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
+            }
+            pyramid_avg_float64 (in0, in1, in_nsamps, out, out_nsamps,
+                has_fill, (double) fill);
+            break;
+
+        default:
+            sprintf (errmsg, "Unsupported data type %d for band %.1024s.",
+                bmeta->data_type, bmeta->name);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  generate_band_pyramid
+
+PURPOSE:  Streams a raw binary band once and emits the requested reduced-
+resolution levels (2x, 4x, 8x), each with its ENVI header.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error generating the pyramid levels
+SUCCESS         Successfully generated the pyramid levels
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Write the ENVI headers straight from the band
+                              metadata with the direct emitter
+
+NOTES:
+  1. The reduced band files are named after the band file with _2x, _4x,
+     _8x inserted before the .img extension.
+  2. Each level is cascaded from the level above it within the streaming
+     chunk, so the full-resolution band is read exactly once.
+  3. qa and class category bands are reduced with the mode filter; all
+     other categories are reduced with fill-skipping 2x2 averaging.
+******************************************************************************/
+int generate_band_pyramid
+(
+    Espa_band_meta_t *bmeta,   /* I: metadata for the band to be reduced */
+    Espa_global_meta_t *gmeta, /* I: global metadata, for the ENVI headers of
+                                     the reduced bands */
+    int nlevels,               /* I: number of pyramid levels to generate
+                                     (1-3 for 2x, 4x, 8x reductions) */
+    char out_files[][STR_SIZE] /* O: array of nlevels filenames of the
+                                     reduced band files written */
+)
+{
+    char FUNC_NAME[] = "generate_band_pyramid";   /* function name */
+    char errmsg[STR_SIZE];    /* error message */
+    char hdr_file[STR_SIZE];  /* ENVI header filename for a reduced band */
+    char *cptr = NULL;        /* pointer to the file extension */
+    int nbytes;               /* number of bytes in the data type */
+    int level;                /* pyramid level loop counter */
+    int line;                 /* current band line of the streaming pass */
+    int nread;                /* number of band lines in the current chunk */
+    int count[ESPA_PYRAMID_MAX_LEVELS + 1];  /* lines per level in the
+                                 current chunk; level 0 is the band itself */
+    int nlines[ESPA_PYRAMID_MAX_LEVELS + 1]; /* lines per level overall */
+    int nsamps[ESPA_PYRAMID_MAX_LEVELS + 1]; /* samples per level */
+    int i;                    /* line loop counter within a chunk */
+    bool use_mode;            /* reduce with the mode filter? */
+    unsigned char *buf[ESPA_PYRAMID_MAX_LEVELS + 1];  /* chunk line buffers
+                                 per level */
+    unsigned char *in0 = NULL;  /* first input line of a reduction pair */
+    unsigned char *in1 = NULL;  /* second input line of a reduction pair */
+    FILE *fp_in = NULL;       /* file pointer for the band file */
+    FILE *fp_out[ESPA_PYRAMID_MAX_LEVELS];  /* file pointers for the reduced
+                                 band files */
+    Espa_band_meta_t level_bmeta;  /* band metadata for a reduced band */
+    int status = SUCCESS;     /* overall status of the streaming pass */
+    long long perf_start = espa_perf_start ();  /* instrumentation scope */
+
+    /* Validate the number of levels */
+    if (nlevels < 1 || nlevels > ESPA_PYRAMID_MAX_LEVELS)
+    {
+        sprintf (errmsg, "Number of pyramid levels must be between 1 and %d.",
+            ESPA_PYRAMID_MAX_LEVELS);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Determine the number of bytes in the data type */
+    switch (bmeta->data_type)
+    {
+        case ESPA_INT8: nbytes = 1; break;
+        case ESPA_UINT8: nbytes = 1; break;
+        case ESPA_INT16: nbytes = 2; break;
+        case ESPA_UINT16: nbytes = 2; break;
+        case ESPA_INT32: nbytes = 4; break;
+        case ESPA_UINT32: nbytes = 4; break;
+        case ESPA_FLOAT32: nbytes = 4; break;
+        case ESPA_FLOAT64: nbytes = 8; break;
+        default:
+            sprintf (errmsg, "Unsupported data type %d for band %.1024s.",
+                bmeta->data_type, bmeta->name);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+    }
+
+    /* qa and class bands get the mode filter so no new class values are
+       invented by averaging */
+    use_mode = (!strcmp (bmeta->category, "qa") ||
+                !strcmp (bmeta->category, "class"));
+
+    /* Determine the dimensions of each level, rounding up so edge pixels
+       covering a partial 2x2 window are kept */
+    nlines[0] = bmeta->nlines;
+    nsamps[0] = bmeta->nsamps;
+    for (level = 1; level <= nlevels; level++)
+    {
+        nlines[level] = (nlines[level-1] + 1) / 2;
+        nsamps[level] = (nsamps[level-1] + 1) / 2;
+    }
+
+    /* Allocate the per-level chunk buffers; level 0 holds the chunk of band
+       lines and each level above it holds half the lines of the one below */
+    for (level = 0; level <= nlevels; level++)
+    {
+        buf[level] = calloc ((size_t) (ESPA_PYRAMID_CHUNK_LINES >> level) *
+            nsamps[level], nbytes);
+        if (buf[level] == NULL)
+        {
+            sprintf (errmsg, "Allocating the chunk buffer for pyramid level "
+                "%d.", level);
+            error_handler (true, FUNC_NAME, errmsg);
+            for (level--; level >= 0; level--)
+                free (buf[level]);
+            return (ERROR);
+        }
+    }
+
+    /* Open the band file for reading */
+    fp_in = open_raw_binary (bmeta->file_name, "rb");
+    if (fp_in == NULL)
+    {
+        sprintf (errmsg, "Opening the band file: %.1024s", bmeta->file_name);
+        error_handler (true, FUNC_NAME, errmsg);
+        for (level = 0; level <= nlevels; level++)
+            free (buf[level]);
+        return (ERROR);
+    }
+    advise_raw_binary_sequential (fp_in);
+
+    /* Determine the reduced band filenames and open them for writing */
+    for (level = 1; level <= nlevels; level++)
+    {
+        snprintf (out_files[level-1], STR_SIZE, "%s", bmeta->file_name);
+        cptr = strrchr (out_files[level-1], '.');
+        if (cptr == NULL)
+            cptr = out_files[level-1] + strlen (out_files[level-1]);
+        snprintf (cptr, STR_SIZE - (cptr - out_files[level-1]), "_%dx.img",
+            1 << level);
+
+        fp_out[level-1] = open_raw_binary (out_files[level-1], "wb");
+        if (fp_out[level-1] == NULL)
+        {
+            sprintf (errmsg, "Opening the reduced band file: %s",
+                out_files[level-1]);
+            error_handler (true, FUNC_NAME, errmsg);
+            for (level -= 2; level >= 0; level--)
+                close_raw_binary (fp_out[level]);
+            close_raw_binary (fp_in);
+            for (level = 0; level <= nlevels; level++)
+                free (buf[level]);
+            return (ERROR);
+        }
+    }
+
+    /* Stream the band in chunks of lines, cascading each chunk through the
+       levels and appending the reduced lines of every level as they are
+       produced */
+    for (line = 0; line < nlines[0] && status == SUCCESS;
+         line += ESPA_PYRAMID_CHUNK_LINES)
+    {
+        /* Read the chunk of band lines; the last chunk can be short */
+        nread = ESPA_PYRAMID_CHUNK_LINES;
+        if (line + nread > nlines[0])
+            nread = nlines[0] - line;
+        if (read_raw_binary (fp_in, nread, nsamps[0], nbytes, buf[0])
+            != SUCCESS)
+        {
+            sprintf (errmsg, "Reading %d lines from the band file at line "
+                "%d.", nread, line);
+            error_handler (true, FUNC_NAME, errmsg);
+            status = ERROR;
+            break;
+        }
+
+        /* Cascade the chunk through the levels */
+        count[0] = nread;
+        for (level = 1; level <= nlevels && status == SUCCESS; level++)
+        {
+            count[level] = (count[level-1] + 1) / 2;
+            for (i = 0; i < count[level]; i++)
+            {
+                in0 = buf[level-1] +
+                    (size_t) (2 * i) * nsamps[level-1] * nbytes;
+                in1 = (2 * i + 1 < count[level-1]) ?
+                    in0 + (size_t) nsamps[level-1] * nbytes : in0;
+                if (pyramid_reduce_lines (bmeta, use_mode, in0, in1,
+                    nsamps[level-1],
+                    buf[level] + (size_t) i * nsamps[level] * nbytes,
+                    nsamps[level]) != SUCCESS)
+                {  /* Error messages already printed */
+                    status = ERROR;
+                    break;
+                }
+            }
+
+            if (status == SUCCESS &&
+                write_raw_binary (fp_out[level-1], count[level],
+                nsamps[level], nbytes, buf[level]) != SUCCESS)
+            {
+                sprintf (errmsg, "Writing %d lines to the reduced band "
+                    "file: %s", count[level], out_files[level-1]);
+                error_handler (true, FUNC_NAME, errmsg);
+                status = ERROR;
+            }
+        }
+    }
+
+    /* Close the band files and free the chunk buffers */
+    close_raw_binary (fp_in);
+    for (level = 0; level < nlevels; level++)
+        close_raw_binary (fp_out[level]);
+    for (level = 0; level <= nlevels; level++)
+        free (buf[level]);
+    if (status != SUCCESS)
+        return (ERROR);
+
+    /* Write the ENVI header for each reduced band */
+    for (level = 1; level <= nlevels; level++)
+    {
+        level_bmeta = *bmeta;
+        level_bmeta.nlines = nlines[level];
+        level_bmeta.nsamps = nsamps[level];
+        level_bmeta.pixel_size[0] = bmeta->pixel_size[0] * (1 << level);
+        level_bmeta.pixel_size[1] = bmeta->pixel_size[1] * (1 << level);
+        strcpy (level_bmeta.file_name, out_files[level-1]);
+
+        snprintf (hdr_file, sizeof (hdr_file), "%s", out_files[level-1]);
+        cptr = strrchr (hdr_file, '.');
+        strcpy (cptr, ".hdr");
+        if (write_envi_hdr_meta (hdr_file, &level_bmeta, gmeta) != SUCCESS)
+        {
+            sprintf (errmsg, "Writing the ENVI header: %.1024s", hdr_file);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+    }
+
+    espa_perf_record ("generate_band_pyramid", perf_start,
+        (long long) nlines[0] * nsamps[0] * nbytes);
+    return (SUCCESS);
+}
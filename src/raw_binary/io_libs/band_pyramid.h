@@ -0,0 +1,56 @@
+/*****************************************************************************
+FILE: band_pyramid.h
+
+PURPOSE: Contains defines and prototypes for generating reduced-resolution
+pyramid levels of a raw binary band.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The band is streamed once and every requested level is emitted from
+     that single pass, cascading each level from the one above it.
+  2. Image bands are reduced with 2x2 averaging which skips the fill pixels;
+     qa and class bands are reduced with a 2x2 mode filter so no new class
+     values are invented.
+*****************************************************************************/
+
+#ifndef BAND_PYRAMID_H
+#define BAND_PYRAMID_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "error_handler.h"
+#include "espa_metadata.h"
+#include "raw_binary_io.h"
+#include "envi_header.h"
+
+/* Defines */
+/* maximum number of pyramid levels (2x, 4x, and 8x reductions) */
+#define ESPA_PYRAMID_MAX_LEVELS 3
+
+/* number of band lines read per streaming chunk; a multiple of eight so
+   line pairs never straddle a chunk boundary at any level */
+#define ESPA_PYRAMID_CHUNK_LINES 8
+
+/* Prototypes */
+int generate_band_pyramid
+(
+    Espa_band_meta_t *bmeta,   /* I: metadata for the band to be reduced */
+    Espa_global_meta_t *gmeta, /* I: global metadata, for the ENVI headers of
+                                     the reduced bands */
+    int nlevels,               /* I: number of pyramid levels to generate
+                                     (1-3 for 2x, 4x, 8x reductions) */
+    char out_files[][STR_SIZE] /* O: array of nlevels filenames of the
+                                     reduced band files written */
+);
+
+#endif
@@ -0,0 +1,509 @@
+/*****************************************************************************
+FILE: compact_metadata.c
+
+PURPOSE: Contains functions for the string-pool backed compact variant of the
+band metadata.  The compact form stores each string field as an offset into
+a shared, interned pool instead of a fixed char[STR_SIZE] array, shrinking a
+band from ~20KB to a few hundred bytes for typical products.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Strings are interned with a linear scan of the pool.  Metadata files
+     hold at most a few thousand short strings, so the scan cost is noise
+     next to the memory savings.
+*****************************************************************************/
+
+#include "compact_metadata.h"
+
+/******************************************************************************
+MODULE:  init_string_pool
+
+PURPOSE: Initializes an empty string pool.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void init_string_pool
+(
+    Espa_string_pool_t *pool     /* I: string pool to be initialized */
+)
+{
+    pool->buf = NULL;
+    pool->used = 0;
+    pool->alloc = 0;
+}
+
+
+/******************************************************************************
+MODULE:  free_string_pool
+
+PURPOSE: Frees the storage held by a string pool.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void free_string_pool
+(
+    Espa_string_pool_t *pool     /* I: string pool to be freed */
+)
+{
+    free (pool->buf);
+    pool->buf = NULL;
+    pool->used = 0;
+    pool->alloc = 0;
+}
+
+
+/******************************************************************************
+MODULE:  string_pool_add
+
+PURPOSE: Adds a string to the pool, interning it against the strings already
+stored.
+
+RETURN VALUE:
+Type = long
+Value        Description
+-----        -----------
+-1           Error growing the pool
+>= 0         Pool offset of the (possibly pre-existing) string
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The fill string ("undefined") is stored like any other value, so
+     expanding a compact band restores the same field contents the full
+     structure held.
+******************************************************************************/
+long string_pool_add
+(
+    Espa_string_pool_t *pool,    /* I: string pool to add the string to */
+    const char *str              /* I: string to be added (interned) */
+)
+{
+    char FUNC_NAME[] = "string_pool_add";   /* function name */
+    char errmsg[STR_SIZE];        /* error message */
+    char *new_buf = NULL;         /* reallocated pool storage */
+    size_t len;                   /* length of the string with terminator */
+    size_t offset;                /* current scan position in the pool */
+    size_t new_alloc;             /* new pool allocation size */
+
+    len = strlen (str) + 1;
+
+    /* Scan the pool for an existing copy of this string */
+    offset = 0;
+    while (offset < pool->used)
+    {
+        if (!strcmp (&pool->buf[offset], str))
+            return ((long) offset);
+        offset += strlen (&pool->buf[offset]) + 1;
+    }
+
+    /* Grow the pool geometrically if the string doesn't fit */
+    if (pool->used + len > pool->alloc)
+    {
+        new_alloc = (pool->alloc == 0) ? 4096 : pool->alloc * 2;
+        while (pool->used + len > new_alloc)
+            new_alloc *= 2;
+        new_buf = realloc (pool->buf, new_alloc);
+        if (new_buf == NULL)
+        {
+            sprintf (errmsg, "Growing the string pool to %lu bytes",
+                (unsigned long) new_alloc);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (-1);
+        }
+        pool->buf = new_buf;
+        pool->alloc = new_alloc;
+    }
+
+    /* Append the string */
+    memcpy (&pool->buf[pool->used], str, len);
+    offset = pool->used;
+    pool->used += len;
+    return ((long) offset);
+}
+
+
+/******************************************************************************
+MODULE:  string_pool_get
+
+PURPOSE: Returns the string stored at the specified pool offset.
+
+RETURN VALUE:
+Type = const char *
+Value        Description
+-----        -----------
+NULL         Offset is ESPA_POOL_NO_STRING or out of range
+non-NULL     Pointer to the pooled string (owned by the pool)
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+const char *string_pool_get
+(
+    const Espa_string_pool_t *pool,  /* I: string pool holding the string */
+    long offset                  /* I: pool offset of the string */
+)
+{
+    if (offset < 0 || (size_t) offset >= pool->used)
+        return (NULL);
+    return (&pool->buf[offset]);
+}
+
+
+/******************************************************************************
+MODULE:  compact_band_metadata
+
+PURPOSE: Builds the compact, string-pool backed form of the band metadata in
+the specified metadata structure.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error building the compact band metadata
+SUCCESS         Successfully built the compact band metadata
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The returned array holds metadata->nbands entries and should be freed
+     with free_compact_band_metadata; the pool should be freed with
+     free_string_pool.
+******************************************************************************/
+int compact_band_metadata
+(
+    Espa_internal_meta_t *metadata,  /* I: metadata structure whose bands are
+                                           to be compacted */
+    Espa_compact_band_meta_t **cband,  /* O: array of nbands compact band
+                                           structures */
+    Espa_string_pool_t *pool         /* O: string pool backing the compact
+                                           bands; should be initialized via
+                                           init_string_pool */
+)
+{
+    char FUNC_NAME[] = "compact_band_metadata";   /* function name */
+    char errmsg[STR_SIZE];        /* error message */
+    int i, j;                     /* looping variables */
+    Espa_band_meta_t *bmeta = NULL;       /* current full band */
+    Espa_compact_band_meta_t *cb = NULL;  /* current compact band */
+
+    /* Allocate the compact band array */
+    *cband = calloc (metadata->nbands, sizeof (Espa_compact_band_meta_t));
+    if (*cband == NULL && metadata->nbands > 0)
+    {
+        sprintf (errmsg, "Allocating %d compact bands", metadata->nbands);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Compact each band; string fields become interned pool offsets */
+    for (i = 0; i < metadata->nbands; i++)
+    {
+        bmeta = &metadata->band[i];
+        cb = &(*cband)[i];
+
+        if ((cb->product = string_pool_add (pool, bmeta->product)) < 0 ||
+            (cb->source = string_pool_add (pool, bmeta->source)) < 0 ||
+            (cb->name = string_pool_add (pool, bmeta->name)) < 0 ||
+            (cb->category = string_pool_add (pool, bmeta->category)) < 0 ||
+            (cb->short_name = string_pool_add (pool, bmeta->short_name)) < 0 ||
+            (cb->long_name = string_pool_add (pool, bmeta->long_name)) < 0 ||
+            (cb->file_name = string_pool_add (pool, bmeta->file_name)) < 0 ||
+            (cb->pixel_units = string_pool_add (pool, bmeta->pixel_units))
+                < 0 ||
+            (cb->data_units = string_pool_add (pool, bmeta->data_units)) < 0 ||
+            (cb->qa_desc = string_pool_add (pool,
+                get_band_qa_desc (bmeta))) < 0 ||
+            (cb->app_version = string_pool_add (pool, bmeta->app_version))
+                < 0 ||
+            (cb->production_date = string_pool_add (pool,
+                bmeta->production_date)) < 0)
+        {   /* Error messages already printed */
+            return (ERROR);
+        }
+
+        cb->data_type = bmeta->data_type;
+        cb->nlines = bmeta->nlines;
+        cb->nsamps = bmeta->nsamps;
+        cb->fill_value = bmeta->fill_value;
+        cb->saturate_value = bmeta->saturate_value;
+        cb->scale_factor = bmeta->scale_factor;
+        cb->add_offset = bmeta->add_offset;
+        cb->resample_method = bmeta->resample_method;
+        cb->pixel_size[0] = bmeta->pixel_size[0];
+        cb->pixel_size[1] = bmeta->pixel_size[1];
+        cb->valid_range[0] = bmeta->valid_range[0];
+        cb->valid_range[1] = bmeta->valid_range[1];
+        cb->rad_gain = bmeta->rad_gain;
+        cb->rad_bias = bmeta->rad_bias;
+        cb->refl_gain = bmeta->refl_gain;
+        cb->refl_bias = bmeta->refl_bias;
+        cb->k1_const = bmeta->k1_const;
+        cb->k2_const = bmeta->k2_const;
+        cb->calibrated_nt = bmeta->calibrated_nt;
+
+        /* Compact the bitmap descriptions */
+        cb->nbits = bmeta->nbits;
+        if (bmeta->nbits > 0)
+        {
+            cb->bitmap_description = malloc (bmeta->nbits * sizeof (long));
+            if (cb->bitmap_description == NULL)
+            {
+                sprintf (errmsg, "Allocating %d compact bit descriptions",
+                    bmeta->nbits);
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
+            }
+            for (j = 0; j < bmeta->nbits; j++)
+            {
+                cb->bitmap_description[j] = string_pool_add (pool,
+                    bmeta->bitmap_description[j]);
+                if (cb->bitmap_description[j] < 0)
+                {   /* Error messages already printed */
+                    return (ERROR);
+                }
+            }
+        }
+
+        /* Compact the class values */
+        cb->nclass = bmeta->nclass;
+        if (bmeta->nclass > 0)
+        {
+            cb->class_values = malloc (bmeta->nclass *
+                sizeof (Espa_compact_class_t));
+            if (cb->class_values == NULL)
+            {
+                sprintf (errmsg, "Allocating %d compact class values",
+                    bmeta->nclass);
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
+            }
+            for (j = 0; j < bmeta->nclass; j++)
+            {
+                cb->class_values[j].class = bmeta->class_values[j].class;
+                cb->class_values[j].description = string_pool_add (pool,
+                    bmeta->class_values[j].description);
+                if (cb->class_values[j].description < 0)
+                {   /* Error messages already printed */
+                    return (ERROR);
+                }
+            }
+        }
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  expand_band_metadata
+
+PURPOSE: Expands a compact band back into the full band metadata structure.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error expanding the compact band
+SUCCESS         Successfully expanded the compact band
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The output band structure should not hold any allocated bitmap or class
+     storage; this routine allocates both as needed.
+******************************************************************************/
+int expand_band_metadata
+(
+    Espa_compact_band_meta_t *cband, /* I: compact band structure */
+    const Espa_string_pool_t *pool,  /* I: string pool backing the compact
+                                           band */
+    Espa_band_meta_t *bmeta          /* O: band metadata structure to be
+                                           filled */
+)
+{
+    char FUNC_NAME[] = "expand_band_metadata";   /* function name */
+    char errmsg[STR_SIZE];        /* error message */
+    int j;                        /* looping variable */
+    const char *str = NULL;       /* pooled string being copied */
+
+    /* Expand the string fields */
+    memset (bmeta, 0, sizeof (*bmeta));
+    if ((str = string_pool_get (pool, cband->product)) == NULL ||
+        snprintf (bmeta->product, sizeof (bmeta->product), "%s", str) < 0 ||
+        (str = string_pool_get (pool, cband->source)) == NULL ||
+        snprintf (bmeta->source, sizeof (bmeta->source), "%s", str) < 0 ||
+        (str = string_pool_get (pool, cband->name)) == NULL ||
+        snprintf (bmeta->name, sizeof (bmeta->name), "%s", str) < 0 ||
+        (str = string_pool_get (pool, cband->category)) == NULL ||
+        snprintf (bmeta->category, sizeof (bmeta->category), "%s", str) < 0 ||
+        (str = string_pool_get (pool, cband->short_name)) == NULL ||
+        snprintf (bmeta->short_name, sizeof (bmeta->short_name), "%s",
+            str) < 0 ||
+        (str = string_pool_get (pool, cband->long_name)) == NULL ||
+        snprintf (bmeta->long_name, sizeof (bmeta->long_name), "%s",
+            str) < 0 ||
+        (str = string_pool_get (pool, cband->file_name)) == NULL ||
+        snprintf (bmeta->file_name, sizeof (bmeta->file_name), "%s",
+            str) < 0 ||
+        (str = string_pool_get (pool, cband->pixel_units)) == NULL ||
+        snprintf (bmeta->pixel_units, sizeof (bmeta->pixel_units), "%s",
+            str) < 0 ||
+        (str = string_pool_get (pool, cband->data_units)) == NULL ||
+        snprintf (bmeta->data_units, sizeof (bmeta->data_units), "%s",
+            str) < 0 ||
+        (str = string_pool_get (pool, cband->qa_desc)) == NULL ||
+        set_band_qa_desc (bmeta, str) != SUCCESS ||
+        (str = string_pool_get (pool, cband->app_version)) == NULL ||
+        snprintf (bmeta->app_version, sizeof (bmeta->app_version), "%s",
+            str) < 0 ||
+        (str = string_pool_get (pool, cband->production_date)) == NULL ||
+        snprintf (bmeta->production_date, sizeof (bmeta->production_date),
+            "%s", str) < 0)
+    {
+        sprintf (errmsg, "Expanding the string fields of the compact band");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Expand the scalar fields */
+    bmeta->data_type = cband->data_type;
+    bmeta->nlines = cband->nlines;
+    bmeta->nsamps = cband->nsamps;
+    bmeta->fill_value = cband->fill_value;
+    bmeta->saturate_value = cband->saturate_value;
+    bmeta->scale_factor = cband->scale_factor;
+    bmeta->add_offset = cband->add_offset;
+    bmeta->resample_method = cband->resample_method;
+    bmeta->pixel_size[0] = cband->pixel_size[0];
+    bmeta->pixel_size[1] = cband->pixel_size[1];
+    bmeta->valid_range[0] = cband->valid_range[0];
+    bmeta->valid_range[1] = cband->valid_range[1];
+    bmeta->rad_gain = cband->rad_gain;
+    bmeta->rad_bias = cband->rad_bias;
+    bmeta->refl_gain = cband->refl_gain;
+    bmeta->refl_bias = cband->refl_bias;
+    bmeta->k1_const = cband->k1_const;
+    bmeta->k2_const = cband->k2_const;
+    bmeta->calibrated_nt = cband->calibrated_nt;
+
+    /* Expand the bitmap descriptions */
+    if (cband->nbits > 0)
+    {
+        if (allocate_bitmap_metadata (bmeta, cband->nbits) != SUCCESS)
+        {   /* Error messages already printed */
+            return (ERROR);
+        }
+        for (j = 0; j < cband->nbits; j++)
+        {
+            str = string_pool_get (pool, cband->bitmap_description[j]);
+            if (str == NULL)
+            {
+                sprintf (errmsg, "Expanding bit description %d of the "
+                    "compact band", j);
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
+            }
+            snprintf (bmeta->bitmap_description[j], STR_SIZE, "%s", str);
+        }
+    }
+
+    /* Expand the class values */
+    if (cband->nclass > 0)
+    {
+        if (allocate_class_metadata (bmeta, cband->nclass) != SUCCESS)
+        {   /* Error messages already printed */
+            return (ERROR);
+        }
+        for (j = 0; j < cband->nclass; j++)
+        {
+            bmeta->class_values[j].class = cband->class_values[j].class;
+            str = string_pool_get (pool, cband->class_values[j].description);
+            if (str == NULL)
+            {
+                sprintf (errmsg, "Expanding class description %d of the "
+                    "compact band", j);
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
+            }
+            snprintf (bmeta->class_values[j].description,
+                sizeof (bmeta->class_values[j].description), "%s", str);
+        }
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  free_compact_band_metadata
+
+PURPOSE: Frees an array of compact band structures.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The shared string pool is not freed here; use free_string_pool.
+******************************************************************************/
+void free_compact_band_metadata
+(
+    Espa_compact_band_meta_t *cband, /* I: array of compact band structures
+                                           to be freed */
+    int nbands                       /* I: number of bands in the array */
+)
+{
+    int i;                        /* looping variable */
+
+    if (cband == NULL)
+        return;
+
+    for (i = 0; i < nbands; i++)
+    {
+        free (cband[i].bitmap_description);
+        free (cband[i].class_values);
+    }
+    free (cband);
+}
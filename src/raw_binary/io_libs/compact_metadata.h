@@ -0,0 +1,148 @@
+/*****************************************************************************
+FILE: compact_metadata.h
+
+PURPOSE: Contains defines and structures for the string-pool backed compact
+variant of the band metadata
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Pool the lazily-allocated QA description
+                              through the band accessors
+
+NOTES:
+  1. Espa_band_meta_t embeds roughly 15 fixed char[STR_SIZE] arrays, making
+     each band several KB even when the fields hold 10-character values.
+     The compact variant stores each string field as an offset into a
+     shared, interned string pool, so tools that juggle several metadata
+     copies keep their working set small.  The QA description is already a
+     lazily-allocated heap string in the full structure; the pool interns
+     it like the other string fields.
+*****************************************************************************/
+
+#ifndef COMPACT_METADATA_H
+#define COMPACT_METADATA_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "error_handler.h"
+#include "espa_metadata.h"
+
+/* Offset value for a string field which has not been set */
+#define ESPA_POOL_NO_STRING -1L
+
+/* Shared, growable string pool.  Strings are interned, so repeated values
+   (band categories, pixel units, production dates, ...) are stored once. */
+typedef struct
+{
+    char *buf;            /* shared string storage */
+    size_t used;          /* number of bytes currently used */
+    size_t alloc;         /* number of bytes currently allocated */
+} Espa_string_pool_t;
+
+/* Compact class value; the description is an offset into the string pool */
+typedef struct
+{
+    int class;            /* class value */
+    long description;     /* pool offset of the class description */
+} Espa_compact_class_t;
+
+/* Compact band metadata.  Scalar fields mirror Espa_band_meta_t; string
+   fields are offsets into the shared string pool. */
+typedef struct
+{
+    long product;         /* pool offset of the product type */
+    long source;          /* pool offset of the source type */
+    long name;            /* pool offset of the band name */
+    long category;        /* pool offset of the category type */
+    enum Espa_data_type data_type;  /* data type of this band */
+    int nlines;           /* number of lines in the dataset */
+    int nsamps;           /* number of samples in the dataset */
+    long fill_value;      /* use long to support long data types */
+    int saturate_value;   /* saturation value (for Landsat) */
+    float scale_factor;   /* scaling factor */
+    float add_offset;     /* offset to be added */
+    enum Espa_resampling_type resample_method;
+                          /* resampling method for this band */
+    long short_name;      /* pool offset of the short band name */
+    long long_name;       /* pool offset of the long band name */
+    long file_name;       /* pool offset of the raw binary file name */
+    double pixel_size[2]; /* pixel size x, y */
+    long pixel_units;     /* pool offset of the pixel size units */
+    long data_units;      /* pool offset of the data units */
+    long valid_range[2];  /* use long to support the long data types min,max */
+    double rad_gain;      /* gain values for TOA radiance conversion */
+    double rad_bias;      /* bias values for TOA radiance conversion */
+    double refl_gain;     /* gain values for TOA reflectance conversion */
+    double refl_bias;     /* bias values for TOA reflectance conversion */
+    double k1_const;      /* K1 thermal constant for BT conversion */
+    double k2_const;      /* K2 thermal constant for BT conversion */
+    int nbits;            /* number of bits in bitmap_description */
+    long *bitmap_description;  /* array of nbits pool offsets for the bit
+                          descriptions */
+    int nclass;           /* number of classes in class_values */
+    Espa_compact_class_t *class_values;  /* compact class descriptions */
+    long qa_desc;         /* pool offset of the QA description */
+    float calibrated_nt;
+    long app_version;     /* pool offset of the producing app version */
+    long production_date; /* pool offset of the production date */
+} Espa_compact_band_meta_t;
+
+/* Prototypes */
+void init_string_pool
+(
+    Espa_string_pool_t *pool     /* I: string pool to be initialized */
+);
+
+void free_string_pool
+(
+    Espa_string_pool_t *pool     /* I: string pool to be freed */
+);
+
+long string_pool_add
+(
+    Espa_string_pool_t *pool,    /* I: string pool to add the string to */
+    const char *str              /* I: string to be added (interned) */
+);
+
+const char *string_pool_get
+(
+    const Espa_string_pool_t *pool,  /* I: string pool holding the string */
+    long offset                  /* I: pool offset of the string */
+);
+
+int compact_band_metadata
+(
+    Espa_internal_meta_t *metadata,  /* I: metadata structure whose bands are
+                                           to be compacted */
+    Espa_compact_band_meta_t **cband,  /* O: array of nbands compact band
+                                           structures */
+    Espa_string_pool_t *pool         /* O: string pool backing the compact
+                                           bands; should be initialized via
+                                           init_string_pool */
+);
+
+int expand_band_metadata
+(
+    Espa_compact_band_meta_t *cband, /* I: compact band structure */
+    const Espa_string_pool_t *pool,  /* I: string pool backing the compact
+                                           band */
+    Espa_band_meta_t *bmeta          /* O: band metadata structure to be
+                                           filled */
+);
+
+void free_compact_band_metadata
+(
+    Espa_compact_band_meta_t *cband, /* I: array of compact band structures
+                                           to be freed */
+    int nbands                       /* I: number of bands in the array */
+);
+
+#endif
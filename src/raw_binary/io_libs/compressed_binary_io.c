@@ -0,0 +1,996 @@
+/*****************************************************************************
+FILE: compressed_binary_io.c
+
+PURPOSE: Contains functions for reading and writing the block-compressed raw
+binary band container.  QA and class bands compress very well, so storing
+them compressed cuts the archive and network bytes massively, while the
+offset index keeps window reads from touching more than the blocks covering
+the window lines.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Compress whole blocks in batches across the
+                              worker pool during bulk writes
+
+NOTES:
+  1. The container is written and read through the regular raw binary calls.
+     open_raw_binary recognizes a compressed band by its magic number and
+     read_raw_binary/read_raw_binary_window decompress transparently, so the
+     downstream tools are unchanged.  Writing a compressed band starts with
+     open_compressed_raw_binary instead of open_raw_binary.
+  2. The compression is zlib, which the library already depends on through
+     libxml2, so no new dependency is introduced.
+*****************************************************************************/
+
+#include <pthread.h>
+#include <string.h>
+#include <zlib.h>
+#include "compressed_binary_io.h"
+#include "espa_thread_pool.h"
+#include "espa_perf.h"
+
+/* Maximum number of compressed bands which can be open at once */
+#define COMPRESSED_BINARY_MAX_OPEN 16
+
+/* Maximum number of blocks compressed together by the bulk write path;
+   bounds the compressed staging memory at this many blocks */
+#define COMPRESSED_BINARY_BULK_BLOCKS 16
+
+/* State for an open compressed band */
+struct espa_compressed_binary
+{
+    FILE *fptr;              /* stream handed back to the caller; used as the
+                                lookup key */
+    bool writing;            /* was the band opened for writing */
+    Espa_compressed_binary_header_t hdr;  /* container header */
+    unsigned long long *index;  /* nblocks+1 compressed block offsets */
+    unsigned char *line_buf; /* one uncompressed block of band lines */
+    unsigned char *comp_buf; /* staging buffer for one compressed block */
+    size_t comp_size;        /* size of the comp_buf buffer */
+    int cached_block;        /* block decompressed in line_buf, or -1 */
+    unsigned int buffered_lines;  /* write mode: lines staged in line_buf */
+    unsigned int cur_line;   /* next sequential line to be read/written */
+    unsigned int cur_block;  /* write mode: next block to be written */
+};
+
+/* Table of open compressed bands, protected by the lock since converters
+   may process bands from multiple threads */
+static Espa_compressed_binary_t zb_table[COMPRESSED_BINARY_MAX_OPEN];
+static pthread_mutex_t zb_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/******************************************************************************
+MODULE: compressed_binary_lines_in_block (static)
+
+PURPOSE: Returns the number of band lines held by a block; only the last
+block can hold fewer than block_lines lines.
+
+RETURN VALUE:
+Type = unsigned int
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+static unsigned int compressed_binary_lines_in_block
+(
+    Espa_compressed_binary_t *zb,  /* I: state for the compressed band */
+    unsigned int block             /* I: block number (0-based) */
+)
+{
+    unsigned int first_line = block * zb->hdr.block_lines;
+
+    if (first_line + zb->hdr.block_lines > zb->hdr.nlines)
+        return zb->hdr.nlines - first_line;
+    return zb->hdr.block_lines;
+}
+
+
+/******************************************************************************
+MODULE: compressed_binary_claim (static)
+
+PURPOSE: Claims a slot in the open compressed band table and allocates the
+block buffers.
+
+RETURN VALUE:
+Type = Espa_compressed_binary_t *
+Value        Description
+-----        -----------
+NULL         No free slot or error allocating the buffers
+non-NULL     Initialized table entry
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+static Espa_compressed_binary_t *compressed_binary_claim
+(
+    FILE *rb_fptr,           /* I: stream serving as the lookup key */
+    Espa_compressed_binary_header_t *hdr,  /* I: container header */
+    bool writing             /* I: is the band being written */
+)
+{
+    char FUNC_NAME[] = "compressed_binary_claim"; /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    int i;                   /* looping variable */
+    size_t block_bytes;      /* size of an uncompressed block */
+    Espa_compressed_binary_t *zb = NULL;  /* free table entry */
+
+    /* Claim a free slot in the table */
+    pthread_mutex_lock (&zb_lock);
+    for (i = 0; i < COMPRESSED_BINARY_MAX_OPEN; i++)
+    {
+        if (zb_table[i].fptr == NULL)
+        {
+            zb = &zb_table[i];
+            zb->fptr = rb_fptr;
+            break;
+        }
+    }
+    pthread_mutex_unlock (&zb_lock);
+
+    if (zb == NULL)
+    {
+        sprintf (errmsg, "All %d compressed band slots are in use.",
+            COMPRESSED_BINARY_MAX_OPEN);
+        error_handler (true, FUNC_NAME, errmsg);
+        return NULL;
+    }
+
+    /* Allocate the offset index and the block buffers */
+    zb->writing = writing;
+    zb->hdr = *hdr;
+    zb->cached_block = -1;
+    zb->buffered_lines = 0;
+    zb->cur_line = 0;
+    zb->cur_block = 0;
+    block_bytes = (size_t) hdr->block_lines * hdr->nsamps * hdr->size;
+    zb->comp_size = compressBound (block_bytes);
+    zb->index = calloc (hdr->nblocks + 1, sizeof (unsigned long long));
+    zb->line_buf = malloc (block_bytes);
+    zb->comp_buf = malloc (zb->comp_size);
+    if (zb->index == NULL || zb->line_buf == NULL || zb->comp_buf == NULL)
+    {
+        sprintf (errmsg, "Allocating the compressed band block buffers.");
+        error_handler (true, FUNC_NAME, errmsg);
+        free (zb->index);
+        free (zb->line_buf);
+        free (zb->comp_buf);
+        pthread_mutex_lock (&zb_lock);
+        memset (zb, 0, sizeof (*zb));
+        pthread_mutex_unlock (&zb_lock);
+        return NULL;
+    }
+
+    return zb;
+}
+
+
+/******************************************************************************
+MODULE: compressed_binary_release (static)
+
+PURPOSE: Releases a slot in the open compressed band table and frees its
+buffers.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+static void compressed_binary_release
+(
+    Espa_compressed_binary_t *zb   /* I: state for the compressed band */
+)
+{
+    free (zb->index);
+    free (zb->line_buf);
+    free (zb->comp_buf);
+    pthread_mutex_lock (&zb_lock);
+    memset (zb, 0, sizeof (*zb));
+    pthread_mutex_unlock (&zb_lock);
+}
+
+
+/******************************************************************************
+MODULE: compressed_binary_load_block (static)
+
+PURPOSE: Decompresses the specified block into the line buffer, unless it is
+already the cached block.
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+ERROR        An error occurred reading or decompressing the block
+SUCCESS      Block is available in the line buffer
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+static int compressed_binary_load_block
+(
+    Espa_compressed_binary_t *zb,  /* I: state for the compressed band */
+    unsigned int block             /* I: block number to be loaded */
+)
+{
+    char FUNC_NAME[] = "compressed_binary_load_block"; /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    unsigned long long clen; /* compressed length of the block */
+    uLongf dest_len;         /* decompressed length of the block */
+
+    /* The cached block doesn't need to be loaded again */
+    if (zb->cached_block == (int) block)
+        return SUCCESS;
+
+    /* Seek to the block using the offset index and read it */
+    clen = zb->index[block + 1] - zb->index[block];
+    if (clen == 0 || clen > zb->comp_size)
+    {
+        sprintf (errmsg, "Offset index is corrupt for block %u of the "
+            "compressed band.", block);
+        error_handler (true, FUNC_NAME, errmsg);
+        return ERROR;
+    }
+
+    if (fseeko (zb->fptr, (off_t) zb->index[block], SEEK_SET) != 0)
+    {
+        sprintf (errmsg, "Seeking to block %u of the compressed band.", block);
+        error_handler (true, FUNC_NAME, errmsg);
+        return ERROR;
+    }
+
+    if (fread (zb->comp_buf, 1, clen, zb->fptr) != clen)
+    {
+        sprintf (errmsg, "Reading block %u of the compressed band.", block);
+        error_handler (true, FUNC_NAME, errmsg);
+        return ERROR;
+    }
+
+    /* Decompress the block and make sure it holds the expected lines */
+    dest_len = (uLongf) compressed_binary_lines_in_block (zb, block) *
+        zb->hdr.nsamps * zb->hdr.size;
+    if (uncompress (zb->line_buf, &dest_len, zb->comp_buf, clen) != Z_OK ||
+        dest_len != (uLongf) compressed_binary_lines_in_block (zb, block) *
+        zb->hdr.nsamps * zb->hdr.size)
+    {
+        sprintf (errmsg, "Decompressing block %u of the compressed band.",
+            block);
+        error_handler (true, FUNC_NAME, errmsg);
+        return ERROR;
+    }
+
+    zb->cached_block = block;
+    return SUCCESS;
+}
+
+
+/******************************************************************************
+MODULE: compressed_binary_flush_block (static)
+
+PURPOSE: Compresses the staged lines and writes them as the next block,
+recording its offset in the index.
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+ERROR        An error occurred compressing or writing the block
+SUCCESS      Block was written
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+static int compressed_binary_flush_block
+(
+    Espa_compressed_binary_t *zb   /* I: state for the compressed band */
+)
+{
+    char FUNC_NAME[] = "compressed_binary_flush_block"; /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    uLongf comp_len;         /* compressed length of the block */
+
+    /* Compress the staged lines */
+    comp_len = (uLongf) zb->comp_size;
+    if (compress2 (zb->comp_buf, &comp_len, zb->line_buf,
+        (uLong) zb->buffered_lines * zb->hdr.nsamps * zb->hdr.size,
+        Z_DEFAULT_COMPRESSION) != Z_OK)
+    {
+        sprintf (errmsg, "Compressing block %u of the compressed band.",
+            zb->cur_block);
+        error_handler (true, FUNC_NAME, errmsg);
+        return ERROR;
+    }
+
+    /* Write the block and record the offset of the next one */
+    if (fwrite (zb->comp_buf, 1, comp_len, zb->fptr) != comp_len)
+    {
+        sprintf (errmsg, "Writing block %u of the compressed band.",
+            zb->cur_block);
+        error_handler (true, FUNC_NAME, errmsg);
+        return ERROR;
+    }
+
+    zb->index[zb->cur_block + 1] = zb->index[zb->cur_block] + comp_len;
+    zb->cur_block++;
+    zb->buffered_lines = 0;
+    return SUCCESS;
+}
+
+
+/******************************************************************************
+MODULE: open_compressed_raw_binary
+
+PURPOSE: Creates a block-compressed band file and returns the stream to be
+used with the regular raw binary write/close calls.
+
+RETURN VALUE:
+Type = FILE *
+Value        Description
+-----        -----------
+NULL         Error creating the compressed band file
+non-NULL     FILE pointer for write_raw_binary/close_raw_binary
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Space for the offset index is reserved after the header and the index
+     is patched in when the band is closed, so the band has to be written
+     through to close_raw_binary to be usable.
+  2. Lines must be written in order from the top of the band down, which is
+     how every converter in this library writes bands.
+*****************************************************************************/
+FILE *open_compressed_raw_binary
+(
+    char *outfile,       /* I: name of the output file to be created */
+    int nlines,          /* I: number of lines in the band */
+    int nsamps,          /* I: number of samples per line in the band */
+    int size             /* I: number of bytes per pixel */
+)
+{
+    char FUNC_NAME[] = "open_compressed_raw_binary"; /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    FILE *rb_fptr = NULL;    /* pointer to the compressed band file */
+    Espa_compressed_binary_header_t hdr;  /* container header */
+    Espa_compressed_binary_t *zb = NULL;  /* state for the compressed band */
+
+    /* Fill in the container header */
+    hdr.magic = ESPA_COMPRESSED_BINARY_MAGIC;
+    hdr.version = ESPA_COMPRESSED_BINARY_VERSION;
+    hdr.nlines = nlines;
+    hdr.nsamps = nsamps;
+    hdr.size = size;
+    hdr.block_lines = ESPA_COMPRESSED_BINARY_BLOCK_LINES;
+    hdr.nblocks = (nlines + ESPA_COMPRESSED_BINARY_BLOCK_LINES - 1) /
+        ESPA_COMPRESSED_BINARY_BLOCK_LINES;
+    hdr.reserved = 0;
+
+    /* Create the file */
+    rb_fptr = fopen (outfile, "wb");
+    if (rb_fptr == NULL)
+    {
+        sprintf (errmsg, "Creating compressed band file %s.", outfile);
+        error_handler (true, FUNC_NAME, errmsg);
+        return NULL;
+    }
+
+    /* Claim a slot and allocate the block buffers */
+    zb = compressed_binary_claim (rb_fptr, &hdr, true);
+    if (zb == NULL)
+    {  /* Error messages already printed */
+        fclose (rb_fptr);
+        return NULL;
+    }
+
+    /* Write the header and reserve space for the offset index, which gets
+       patched in when the band is closed */
+    if (fwrite (&hdr, sizeof (hdr), 1, rb_fptr) != 1 ||
+        fwrite (zb->index, sizeof (unsigned long long), hdr.nblocks + 1,
+        rb_fptr) != hdr.nblocks + 1)
+    {
+        sprintf (errmsg, "Writing the header of compressed band file %s.",
+            outfile);
+        error_handler (true, FUNC_NAME, errmsg);
+        compressed_binary_release (zb);
+        fclose (rb_fptr);
+        return NULL;
+    }
+
+    /* The first block starts right after the header and index */
+    zb->index[0] = sizeof (hdr) +
+        (unsigned long long) (hdr.nblocks + 1) * sizeof (unsigned long long);
+
+    return rb_fptr;
+}
+
+
+/******************************************************************************
+MODULE: compressed_binary_attach
+
+PURPOSE: Checks a stream freshly opened for reading for the compressed band
+magic number.  If the band is compressed, the header and offset index are
+read and the stream is registered for transparent decompression; otherwise
+the stream is rewound and left untouched.
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+ERROR        The band is compressed but its header or index is unreadable
+SUCCESS      Stream is ready for reading (compressed or not)
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+int compressed_binary_attach
+(
+    FILE *rb_fptr        /* I: stream freshly opened for reading; positioned
+                               back at the start of the data if the file is
+                               not compressed */
+)
+{
+    char FUNC_NAME[] = "compressed_binary_attach"; /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    Espa_compressed_binary_header_t hdr;  /* container header */
+    Espa_compressed_binary_t *zb = NULL;  /* state for the compressed band */
+
+    /* Plain raw binary bands, including ones shorter than the header, are
+       simply rewound and handled by the regular read path */
+    if (fread (&hdr, sizeof (hdr), 1, rb_fptr) != 1 ||
+        hdr.magic != ESPA_COMPRESSED_BINARY_MAGIC)
+    {
+        rewind (rb_fptr);
+        return SUCCESS;
+    }
+
+    /* Refuse containers from a newer format version */
+    if (hdr.version != ESPA_COMPRESSED_BINARY_VERSION)
+    {
+        sprintf (errmsg, "Unsupported compressed band version %u (expected "
+            "%d).", hdr.version, ESPA_COMPRESSED_BINARY_VERSION);
+        error_handler (true, FUNC_NAME, errmsg);
+        return ERROR;
+    }
+
+    if (hdr.block_lines == 0 || hdr.nsamps == 0 || hdr.size == 0 ||
+        hdr.nblocks != (hdr.nlines + hdr.block_lines - 1) / hdr.block_lines)
+    {
+        sprintf (errmsg, "Compressed band header is corrupt.");
+        error_handler (true, FUNC_NAME, errmsg);
+        return ERROR;
+    }
+
+    /* Claim a slot and allocate the block buffers */
+    zb = compressed_binary_claim (rb_fptr, &hdr, false);
+    if (zb == NULL)
+    {  /* Error messages already printed */
+        return ERROR;
+    }
+
+    /* Read the offset index */
+    if (fread (zb->index, sizeof (unsigned long long), hdr.nblocks + 1,
+        rb_fptr) != hdr.nblocks + 1)
+    {
+        sprintf (errmsg, "Reading the offset index of the compressed band.");
+        error_handler (true, FUNC_NAME, errmsg);
+        compressed_binary_release (zb);
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+
+/******************************************************************************
+MODULE: compressed_binary_find
+
+PURPOSE: Looks up the compressed band state for a stream, if any.
+
+RETURN VALUE:
+Type = Espa_compressed_binary_t *
+Value        Description
+-----        -----------
+NULL         The stream is not a compressed band
+non-NULL     Compressed band state for the stream
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+Espa_compressed_binary_t *compressed_binary_find
+(
+    FILE *rb_fptr        /* I: stream to be looked up */
+)
+{
+    Espa_compressed_binary_t *zb = NULL;  /* matching table entry */
+    int i;                                /* looping variable */
+
+    pthread_mutex_lock (&zb_lock);
+    for (i = 0; i < COMPRESSED_BINARY_MAX_OPEN; i++)
+    {
+        if (zb_table[i].fptr == rb_fptr)
+        {
+            zb = &zb_table[i];
+            break;
+        }
+    }
+    pthread_mutex_unlock (&zb_lock);
+
+    return zb;
+}
+
+
+/******************************************************************************
+MODULE: read_compressed_binary
+
+PURPOSE: Reads the next nlines of data sequentially from the compressed band.
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+ERROR        An error occurred reading data from the compressed band
+SUCCESS      Reading was successful
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+int read_compressed_binary
+(
+    Espa_compressed_binary_t *zb,  /* I: state for the compressed band */
+    int nlines,          /* I: number of lines to read from the band */
+    int nsamps,          /* I: number of samples per line to read */
+    int size,            /* I: number of bytes per pixel */
+    void *img_array      /* O: array of nlines * nsamps * size to be read */
+)
+{
+    char FUNC_NAME[] = "read_compressed_binary"; /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+
+    /* The sequential read has to match the band geometry */
+    if ((unsigned int) nsamps != zb->hdr.nsamps ||
+        (unsigned int) size != zb->hdr.size ||
+        zb->cur_line + nlines > zb->hdr.nlines)
+    {
+        sprintf (errmsg, "Reading %d lines of %d samples (%d bytes per "
+            "pixel) doesn't match the compressed band geometry (%u lines, "
+            "%u samples, %u bytes per pixel, %u lines already read).",
+            nlines, nsamps, size, zb->hdr.nlines, zb->hdr.nsamps,
+            zb->hdr.size, zb->cur_line);
+        error_handler (true, FUNC_NAME, errmsg);
+        return ERROR;
+    }
+
+    /* Read the lines as a full-width window at the current position */
+    if (read_compressed_binary_window (zb, zb->cur_line, 0, nlines, nsamps,
+        nsamps, size, img_array) != SUCCESS)
+    {  /* Error messages already printed */
+        return ERROR;
+    }
+
+    zb->cur_line += nlines;
+    return SUCCESS;
+}
+
+
+/******************************************************************************
+MODULE: read_compressed_binary_window
+
+PURPOSE: Reads a spatial window of data from the compressed band, touching
+only the blocks which cover the window lines.
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+ERROR        An error occurred reading data from the compressed band
+SUCCESS      Reading was successful
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. start_line and start_samp are 0-based within the band.
+  2. The output buffer is packed with the window data only, i.e. the window
+     lines are contiguous with nsamps samples per line.
+*****************************************************************************/
+int read_compressed_binary_window
+(
+    Espa_compressed_binary_t *zb,  /* I: state for the compressed band */
+    int start_line,      /* I: first line of the window (0-based) */
+    int start_samp,      /* I: first sample of the window (0-based) */
+    int nlines,          /* I: number of lines to read from the band */
+    int nsamps,          /* I: number of samples per line to read */
+    int band_nsamps,     /* I: number of samples per line in the band */
+    int size,            /* I: number of bytes per pixel */
+    void *img_array      /* O: array of nlines * nsamps * size to be read */
+)
+{
+    char FUNC_NAME[] = "read_compressed_binary_window"; /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    int line;                /* looping variable for lines in the window */
+    unsigned int block;      /* block covering the current window line */
+    unsigned int block_line; /* line within the block */
+    unsigned char *buf = img_array;  /* output position for the next line */
+    long long perf_start = espa_perf_start ();  /* instrumentation scope */
+
+    /* The window has to fit within the band geometry */
+    if ((unsigned int) band_nsamps != zb->hdr.nsamps ||
+        (unsigned int) size != zb->hdr.size ||
+        start_line < 0 || start_samp < 0 ||
+        (unsigned int) (start_line + nlines) > zb->hdr.nlines ||
+        (unsigned int) (start_samp + nsamps) > zb->hdr.nsamps)
+    {
+        sprintf (errmsg, "Window of %d lines x %d samples at line %d, "
+            "sample %d doesn't fit the compressed band geometry (%u lines, "
+            "%u samples, %u bytes per pixel).", nlines, nsamps, start_line,
+            start_samp, zb->hdr.nlines, zb->hdr.nsamps, zb->hdr.size);
+        error_handler (true, FUNC_NAME, errmsg);
+        return ERROR;
+    }
+
+    /* Loop through the window lines, decompressing each covering block once
+       and copying the samples of interest out of the cached block */
+    for (line = 0; line < nlines; line++)
+    {
+        block = (unsigned int) (start_line + line) / zb->hdr.block_lines;
+        block_line = (unsigned int) (start_line + line) %
+            zb->hdr.block_lines;
+
+        if (compressed_binary_load_block (zb, block) != SUCCESS)
+        {  /* Error messages already printed */
+            return ERROR;
+        }
+
+        memcpy (buf, &zb->line_buf[((size_t) block_line * zb->hdr.nsamps +
+            start_samp) * size], (size_t) nsamps * size);
+        buf += (size_t) nsamps * size;
+    }
+
+    espa_perf_record ("read_compressed_binary", perf_start,
+        (long long) nlines * nsamps * size);
+    return SUCCESS;
+}
+
+
+/******************************************************************************
+MODULE: compressed_binary_bulk_task (static)
+
+PURPOSE: Pool task compressing one block of the bulk write straight from
+the caller's buffer into its slot of the compressed staging buffer.
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+ERROR        An error occurred compressing the block
+SUCCESS      Block was compressed
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+typedef struct
+{
+    Espa_compressed_binary_t *zb;  /* state for the compressed band */
+    const unsigned char *src;  /* first line of the first bulk block */
+    unsigned char *comp;     /* per-block compressed staging buffers */
+    uLongf *comp_len;        /* per-block compressed lengths */
+} Espa_compressed_bulk_t;
+
+static int compressed_binary_bulk_task
+(
+    void *ctx,           /* I: bulk compression state */
+    int item             /* I: block of the bulk batch to be compressed */
+)
+{
+    Espa_compressed_bulk_t *bulk = ctx;  /* bulk compression state */
+    Espa_compressed_binary_t *zb = bulk->zb;  /* compressed band state */
+    size_t block_bytes;      /* uncompressed size of one full block */
+    uLongf comp_len;         /* compressed length of the block */
+
+    block_bytes = (size_t) zb->hdr.block_lines * zb->hdr.nsamps *
+        zb->hdr.size;
+    comp_len = (uLongf) zb->comp_size;
+    if (compress2 (bulk->comp + (size_t) item * zb->comp_size, &comp_len,
+        bulk->src + (size_t) item * block_bytes, (uLong) block_bytes,
+        Z_DEFAULT_COMPRESSION) != Z_OK)
+        return ERROR;
+
+    bulk->comp_len[item] = comp_len;
+    return SUCCESS;
+}
+
+
+/******************************************************************************
+MODULE: compressed_binary_flush_bulk (static)
+
+PURPOSE: Compresses a batch of whole blocks straight from the caller's
+buffer across the worker pool, then writes them in order and records their
+offsets in the index.
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+ERROR        An error occurred compressing or writing the blocks
+SUCCESS      Blocks were written
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The blocks are independent zlib streams, so they compress in parallel
+     and the output is identical to the serial path.
+*****************************************************************************/
+static int compressed_binary_flush_bulk
+(
+    Espa_compressed_binary_t *zb,  /* I: state for the compressed band */
+    const unsigned char *src,  /* I: first line of the first block */
+    int nblocks          /* I: number of whole blocks to be written */
+)
+{
+    char FUNC_NAME[] = "compressed_binary_flush_bulk"; /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    Espa_compressed_bulk_t bulk;  /* bulk compression state */
+    int block;               /* looping variable for the blocks */
+
+    /* Allocate the per-block compressed staging buffers */
+    bulk.zb = zb;
+    bulk.src = src;
+    bulk.comp = malloc ((size_t) nblocks * zb->comp_size);
+    bulk.comp_len = malloc (nblocks * sizeof (uLongf));
+    if (bulk.comp == NULL || bulk.comp_len == NULL)
+    {
+        sprintf (errmsg, "Allocating the bulk compression staging buffers.");
+        error_handler (true, FUNC_NAME, errmsg);
+        free (bulk.comp);
+        free (bulk.comp_len);
+        return ERROR;
+    }
+
+    /* Compress the blocks across the worker pool */
+    if (espa_pool_run (compressed_binary_bulk_task, &bulk, nblocks,
+        espa_pool_max_threads ()) != SUCCESS)
+    {
+        sprintf (errmsg, "Compressing blocks %u-%u of the compressed band.",
+            zb->cur_block, zb->cur_block + nblocks - 1);
+        error_handler (true, FUNC_NAME, errmsg);
+        free (bulk.comp);
+        free (bulk.comp_len);
+        return ERROR;
+    }
+
+    /* Write the blocks in order and record their offsets */
+    for (block = 0; block < nblocks; block++)
+    {
+        if (fwrite (bulk.comp + (size_t) block * zb->comp_size, 1,
+            bulk.comp_len[block], zb->fptr) != bulk.comp_len[block])
+        {
+            sprintf (errmsg, "Writing block %u of the compressed band.",
+                zb->cur_block);
+            error_handler (true, FUNC_NAME, errmsg);
+            free (bulk.comp);
+            free (bulk.comp_len);
+            return ERROR;
+        }
+
+        zb->index[zb->cur_block + 1] = zb->index[zb->cur_block] +
+            bulk.comp_len[block];
+        zb->cur_block++;
+    }
+
+    free (bulk.comp);
+    free (bulk.comp_len);
+    return SUCCESS;
+}
+
+
+/******************************************************************************
+MODULE: write_compressed_binary
+
+PURPOSE: Writes the next nlines of data sequentially to the compressed band,
+compressing and writing each block as it fills.
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+ERROR        An error occurred writing data to the compressed band
+SUCCESS      Writing was successful
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Compress whole blocks in batches across the
+                              worker pool
+
+NOTES:
+*****************************************************************************/
+int write_compressed_binary
+(
+    Espa_compressed_binary_t *zb,  /* I: state for the compressed band */
+    int nlines,          /* I: number of lines to write to the band */
+    int nsamps,          /* I: number of samples per line to write */
+    int size,            /* I: number of bytes per pixel */
+    void *img_array      /* I: array of nlines * nsamps * size to be written */
+)
+{
+    char FUNC_NAME[] = "write_compressed_binary"; /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    int line;                /* looping variable for the lines */
+    int nbulk;               /* number of whole blocks in the bulk batch */
+    unsigned char *buf = img_array;  /* input position for the next line */
+
+    /* The sequential write has to match the band geometry */
+    if (!zb->writing || (unsigned int) nsamps != zb->hdr.nsamps ||
+        (unsigned int) size != zb->hdr.size ||
+        zb->cur_line + nlines > zb->hdr.nlines)
+    {
+        sprintf (errmsg, "Writing %d lines of %d samples (%d bytes per "
+            "pixel) doesn't match the compressed band geometry (%u lines, "
+            "%u samples, %u bytes per pixel, %u lines already written).",
+            nlines, nsamps, size, zb->hdr.nlines, zb->hdr.nsamps,
+            zb->hdr.size, zb->cur_line);
+        error_handler (true, FUNC_NAME, errmsg);
+        return ERROR;
+    }
+
+    /* Stage the lines into the block buffer, flushing each block as it
+       fills.  Whole blocks arriving with nothing staged skip the staging
+       copy and are compressed in batches across the worker pool, straight
+       from the caller's buffer while it is still cache-hot */
+    line = 0;
+    while (line < nlines)
+    {
+        if (zb->buffered_lines == 0 &&
+            nlines - line >= (int) zb->hdr.block_lines)
+        {
+            nbulk = (nlines - line) / zb->hdr.block_lines;
+            if (nbulk > COMPRESSED_BINARY_BULK_BLOCKS)
+                nbulk = COMPRESSED_BINARY_BULK_BLOCKS;
+            if (compressed_binary_flush_bulk (zb, buf, nbulk) != SUCCESS)
+            {  /* Error messages already printed */
+                return ERROR;
+            }
+            buf += (size_t) nbulk * zb->hdr.block_lines * nsamps * size;
+            zb->cur_line += nbulk * zb->hdr.block_lines;
+            line += nbulk * zb->hdr.block_lines;
+            continue;
+        }
+
+        memcpy (&zb->line_buf[(size_t) zb->buffered_lines * zb->hdr.nsamps *
+            size], buf, (size_t) nsamps * size);
+        buf += (size_t) nsamps * size;
+        zb->buffered_lines++;
+        zb->cur_line++;
+        line++;
+
+        if (zb->buffered_lines == zb->hdr.block_lines)
+        {
+            if (compressed_binary_flush_block (zb) != SUCCESS)
+            {  /* Error messages already printed */
+                return ERROR;
+            }
+        }
+    }
+
+    return SUCCESS;
+}
+
+
+/******************************************************************************
+MODULE: close_compressed_binary
+
+PURPOSE: Releases the compressed band state for a stream.  Write-mode bands
+get their final partial block flushed and the offset index patched into the
+space reserved after the header.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The stream itself is closed by the caller (close_raw_binary).
+*****************************************************************************/
+void close_compressed_binary
+(
+    FILE *rb_fptr        /* I: stream whose compressed state is released;
+                               write-mode bands get their final block and
+                               offset index flushed */
+)
+{
+    char FUNC_NAME[] = "close_compressed_binary"; /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    Espa_compressed_binary_t *zb = NULL;  /* state for the compressed band */
+
+    zb = compressed_binary_find (rb_fptr);
+    if (zb == NULL)
+        return;
+
+    if (zb->writing)
+    {
+        /* Flush the final partial block */
+        if (zb->buffered_lines > 0)
+        {
+            if (compressed_binary_flush_block (zb) != SUCCESS)
+            {  /* Error messages already printed */
+                compressed_binary_release (zb);
+                return;
+            }
+        }
+
+        /* The band is only usable if every line was written */
+        if (zb->cur_line != zb->hdr.nlines)
+        {
+            sprintf (errmsg, "Compressed band was closed after %u of %u "
+                "lines were written.", zb->cur_line, zb->hdr.nlines);
+            error_handler (true, FUNC_NAME, errmsg);
+            compressed_binary_release (zb);
+            return;
+        }
+
+        /* Patch the offset index into the space reserved after the header */
+        if (fseeko (zb->fptr,
+            (off_t) sizeof (Espa_compressed_binary_header_t), SEEK_SET) != 0
+            || fwrite (zb->index, sizeof (unsigned long long),
+            zb->hdr.nblocks + 1, zb->fptr) != zb->hdr.nblocks + 1)
+        {
+            sprintf (errmsg, "Writing the offset index of the compressed "
+                "band.");
+            error_handler (true, FUNC_NAME, errmsg);
+        }
+    }
+
+    compressed_binary_release (zb);
+}
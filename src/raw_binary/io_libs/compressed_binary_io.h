@@ -0,0 +1,123 @@
+/*****************************************************************************
+FILE: compressed_binary_io.h
+
+PURPOSE: Contains defines and prototypes for the block-compressed raw binary
+band container.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The container compresses the band in blocks of whole lines and keeps an
+     offset index of the compressed blocks, so a spatial window can still be
+     read by touching only the blocks covering the window lines.
+  2. Compressed bands keep their regular .img filename and are recognized by
+     the magic number at the start of the file, so the XML metadata and the
+     downstream readers going through open_raw_binary are unchanged.
+*****************************************************************************/
+
+#ifndef COMPRESSED_BINARY_IO_H
+#define COMPRESSED_BINARY_IO_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "error_handler.h"
+
+/* Defines */
+/* magic number at the start of a compressed band file ("ESPZ") */
+#define ESPA_COMPRESSED_BINARY_MAGIC 0x4553505a
+
+/* version of the compressed band container format */
+#define ESPA_COMPRESSED_BINARY_VERSION 1
+
+/* number of band lines compressed together in one block; window reads
+   decompress whole blocks, so this trades compression ratio for random
+   access granularity */
+#define ESPA_COMPRESSED_BINARY_BLOCK_LINES 64
+
+/* Header at the start of a compressed band file.  It is followed by the
+   offset index, which holds nblocks+1 file offsets (the offset of each
+   compressed block plus the end of the last block), followed by the
+   compressed blocks themselves. */
+typedef struct
+{
+    unsigned int magic;        /* ESPA_COMPRESSED_BINARY_MAGIC */
+    unsigned int version;      /* ESPA_COMPRESSED_BINARY_VERSION */
+    unsigned int nlines;       /* number of lines in the band */
+    unsigned int nsamps;       /* number of samples per line in the band */
+    unsigned int size;         /* number of bytes per pixel */
+    unsigned int block_lines;  /* number of lines per compressed block */
+    unsigned int nblocks;      /* number of compressed blocks */
+    unsigned int reserved;     /* reserved for future use; zero */
+} Espa_compressed_binary_header_t;
+
+/* Opaque state for an open compressed band */
+typedef struct espa_compressed_binary Espa_compressed_binary_t;
+
+/* Prototypes */
+FILE *open_compressed_raw_binary
+(
+    char *outfile,       /* I: name of the output file to be created */
+    int nlines,          /* I: number of lines in the band */
+    int nsamps,          /* I: number of samples per line in the band */
+    int size             /* I: number of bytes per pixel */
+);
+
+int compressed_binary_attach
+(
+    FILE *rb_fptr        /* I: stream freshly opened for reading; positioned
+                               back at the start of the data if the file is
+                               not compressed */
+);
+
+Espa_compressed_binary_t *compressed_binary_find
+(
+    FILE *rb_fptr        /* I: stream to be looked up */
+);
+
+int read_compressed_binary
+(
+    Espa_compressed_binary_t *zb,  /* I: state for the compressed band */
+    int nlines,          /* I: number of lines to read from the band */
+    int nsamps,          /* I: number of samples per line to read */
+    int size,            /* I: number of bytes per pixel */
+    void *img_array      /* O: array of nlines * nsamps * size to be read */
+);
+
+int read_compressed_binary_window
+(
+    Espa_compressed_binary_t *zb,  /* I: state for the compressed band */
+    int start_line,      /* I: first line of the window (0-based) */
+    int start_samp,      /* I: first sample of the window (0-based) */
+    int nlines,          /* I: number of lines to read from the band */
+    int nsamps,          /* I: number of samples per line to read */
+    int band_nsamps,     /* I: number of samples per line in the band */
+    int size,            /* I: number of bytes per pixel */
+    void *img_array      /* O: array of nlines * nsamps * size to be read */
+);
+
+int write_compressed_binary
+(
+    Espa_compressed_binary_t *zb,  /* I: state for the compressed band */
+    int nlines,          /* I: number of lines to write to the band */
+    int nsamps,          /* I: number of samples per line to write */
+    int size,            /* I: number of bytes per pixel */
+    void *img_array      /* I: array of nlines * nsamps * size to be written */
+);
+
+void close_compressed_binary
+(
+    FILE *rb_fptr        /* I: stream whose compressed state is released;
+                               write-mode bands get their final block and
+                               offset index flushed */
+);
+
+#endif
@@ -14,79 +14,270 @@ Date         Programmer       Reason
 12/12/2013   Gail Schmidt     Original development
 3/31/2014    Ron Dilley       Modified to support a data fill value in the
                               ENVI header
+8/31/2026    Gail Schmidt     Format the headers in memory and write each one
+                              with a single call; added a batch writer for
+                              all the bands of a metadata structure
+8/31/2026    Gail Schmidt     Added a reader for existing ENVI headers so
+                              header-only queries skip the XML parse
+8/31/2026    Gail Schmidt     Added the direct metadata-to-header emitter and
+                              split the structure creation into its global
+                              and band-varying halves
 
 NOTES:
 *****************************************************************************/
 
 #include "envi_header.h"
 
+/* Forward references for the static halves of the structure creation,
+   defined beside create_envi_struct below */
+static int create_envi_global
+(
+    Espa_global_meta_t *gmeta, /* I: pointer to global metadata */
+    Envi_header_t *hdr         /* I/O: output ENVI header information */
+);
+
+static int update_envi_band
+(
+    Espa_band_meta_t *bmeta,   /* I: pointer to band metadata for this band */
+    Espa_global_meta_t *gmeta, /* I: pointer to global metadata */
+    Envi_header_t *hdr         /* I/O: output ENVI header information */
+);
+#include "espa_byteswap.h"
+
 /******************************************************************************
-MODULE:  write_envi_hdr
+MODULE:  envi_datum_info
 
-PURPOSE:  Writes the ENVI header to the specified file using the input info
-provided.
+PURPOSE:  Looks up the GCS, DATUM, and SPHEROID strings along with the
+spheroid axes for the specified datum.
 
 RETURN VALUE:
 Type = int
 Value           Description
 -----           -----------
-ERROR           An error occurred generating the header file
-SUCCESS         Header file was successful
+ERROR           Unsupported datum code
+SUCCESS         Datum information was returned
 
 HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
-12/12/2013   Gail Schmidt     Original development
-4/17/2014    Gail Schmidt     Modified to support additional projections
-4/23/2014    Gail Schmidt     Modified to support additional datums
-11/13/2014   Gail Schmidt     fill_value is now optional
+8/31/2026    Gail Schmidt     Original development, pulled out of
+                              write_envi_hdr so the batch writer can share it
 
 NOTES:
-  1. Only supports GEO, UTM, ALBERS, PS, and SIN projections.
-  2. Only supports WGS84, NAD27, NAD83 datums (GEO, UTM, ALBERS, PS).
-  3. Sinusoidal needs to pass the radius of the sphere in the first
-     projection parameter for the ENVI header.
-  4. The following are the strings to use for the various datums, obtained from
+  1. The following are the strings to use for the various datums, obtained from
      ExcelisVis via http://www.exelisvis.com/services/Files/envi_pe/envi_pe_v10/EnviPEReferenceDocs/EnviPeGeogcs_v10.txt
      WGS84: GEOGCS["GCS_WGS_1984",DATUM["D_WGS_1984",SPHEROID["WGS_1984",6378137.0,298.257223563]],PRIMEM["Greenwich",0.0],UNIT["Degree",0.0174532925199433]]
      NAD27: GEOGCS["GCS_North_American_1927",DATUM["D_North_American_1927",SPHEROID["Clarke_1866",6378206.4,294.9786982]],PRIMEM["Greenwich",0.0],UNIT["Degree",0.0174532925199433]]
      NAD83: GEOGCS["GCS_North_American_1983",DATUM["D_North_American_1983",SPHEROID["GRS_1980",6378137.0,298.257222101]],PRIMEM["Greenwich",0.0],UNIT["Degree",0.0174532925199433]]
 ******************************************************************************/
-int write_envi_hdr
+static int envi_datum_info
 (
-    char *hdr_file,     /* I: name of ENVI header file to be generated */
-    Envi_header_t *hdr  /* I: input ENVI header information */
+    int datum_type,            /* I: datum type from the ENVI header */
+    char *geogcs_str,          /* O: string for the GCS code */
+    char *datum_str,           /* O: string for the datum code */
+    char *spheroid_str,        /* O: string for the spheroid code */
+    char *proj_datum_str,      /* O: string for the datum code in projection
+                                     info section */
+    double *semi_major_axis,   /* O: semi-major axis for the spheroid */
+    double *semi_minor_axis,   /* O: semi-minor axis for the spheroid */
+    double *inv_flattening     /* O: inverse flattening for the spheroid */
 )
 {
-    char FUNC_NAME[] = "write_envi_hdr";   /* function name */
+    char FUNC_NAME[] = "envi_datum_info";   /* function name */
+    char errmsg[STR_SIZE];       /* error message */
+
+    switch (datum_type)
+    {
+        case ESPA_WGS84:  /* WGS84 sphere */
+            strcpy (geogcs_str, "GCS_WGS_1984");
+            strcpy (datum_str, "D_WGS_1984");
+            strcpy (spheroid_str, "WGS_1984");
+            strcpy (proj_datum_str, "WGS-84");
+            *semi_major_axis = GCTP_WGS84_SEMI_MAJOR;
+            *semi_minor_axis = GCTP_WGS84_SEMI_MINOR;
+            *inv_flattening = GCTP_WGS84_INV_FLATTENING;
+            break;
+
+        case ESPA_NAD27:  /* Clarke 1866 sphere */
+            strcpy (geogcs_str, "GCS_North_American_1927");
+            strcpy (datum_str, "D_North_American_1927");
+            strcpy (spheroid_str, "Clarke_1866");
+            strcpy (proj_datum_str, "North America 1927");
+            *semi_major_axis = GCTP_CLARKE_1866_SEMI_MAJOR;
+            *semi_minor_axis = GCTP_CLARKE_1866_SEMI_MINOR;
+            *inv_flattening = GCTP_CLARKE_1866_INV_FLATTENING;
+            break;
+
+        case ESPA_NAD83:  /* GRS 1980 sphere */
+            strcpy (geogcs_str, "GCS_North_American_1983");
+            strcpy (datum_str, "D_North_American_1983");
+            strcpy (spheroid_str, "GRS_1980");
+            strcpy (proj_datum_str, "North America 1983");
+            *semi_major_axis = GCTP_GRS80_SEMI_MAJOR;
+            *semi_minor_axis = GCTP_GRS80_SEMI_MINOR;
+            *inv_flattening = GCTP_GRS80_INV_FLATTENING;
+            break;
+
+        case ESPA_NODATUM:  /* no datum; the caller only writes the sphere
+            radius for these projections, so leave the strings empty */
+            geogcs_str[0] = '\0';
+            datum_str[0] = '\0';
+            spheroid_str[0] = '\0';
+            proj_datum_str[0] = '\0';
+            *semi_major_axis = 0.0;
+            *semi_minor_axis = 0.0;
+            *inv_flattening = 0.0;
+            break;
+
+        default:
+            sprintf (errmsg, "Unsupported datum code (%d). WGS84 datum code "
+                "(%d) or NAD27 datum code (%d) or NAD83 datum code (%d) or "
+                "NODATUM datum code (%d) expected.", datum_type, ESPA_WGS84,
+                ESPA_NAD27, ESPA_NAD83, ESPA_NODATUM);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  format_envi_proj
+
+PURPOSE:  Formats the projection-dependent lines of the ENVI header which do
+not vary from band to band (the "projection info" and "coordinate system
+string" lines) into the caller's buffer.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Unsupported projection or datum, or the buffer overflowed
+SUCCESS         Lines were formatted (the buffer is empty for UTM, which
+                only has the per-band "map info" line)
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development, pulled out of
+                              write_envi_hdr so the batch writer can format
+                              these lines once and reuse them for every band
+
+NOTES:
+  1. Only supports GEO, UTM, ALBERS, PS, and SIN projections.
+  2. Sinusoidal needs to pass the radius of the sphere in the first
+     projection parameter for the ENVI header.
+******************************************************************************/
+static int format_envi_proj
+(
+    Envi_header_t *hdr,  /* I: input ENVI header information */
+    char *buf,           /* O: buffer for the formatted lines */
+    size_t bufsize       /* I: size of the buffer */
+)
+{
+    char FUNC_NAME[] = "format_envi_proj";   /* function name */
     char errmsg[STR_SIZE];       /* error message */
     char geogcs_str[STR_SIZE];   /* string for the GCS code */
     char datum_str[STR_SIZE];    /* string for the datum code */
     char proj_datum_str[STR_SIZE];  /* string for the datum code in projection
                                        info section */
     char spheroid_str[STR_SIZE]; /* string for the spheroid code */
-    int i;                       /* looping variable */
+    int count;                   /* number of chars copied in snprintf */
     double semi_major_axis;      /* semi-major axis for the spheroid */
     double semi_minor_axis;      /* semi-minor axis for the spheroid */
     double inv_flattening;       /* inverse flattening for the spheroid */
-    FILE *hdr_fptr = NULL;       /* file pointer to the ENVI header file */
 
-    /* Open the header file */
-    hdr_fptr = fopen (hdr_file, "w");
-    if (hdr_fptr == NULL)
-    {
-        sprintf (errmsg, "Opening %s for write access.", hdr_file);
-        error_handler (true, FUNC_NAME, errmsg);
+    /* Determine the GCS, DATUM, and SPHEROID strings that will get written
+       along with the semi-major and inverse flattening numbers */
+    if (envi_datum_info (hdr->datum_type, geogcs_str, datum_str, spheroid_str,
+        proj_datum_str, &semi_major_axis, &semi_minor_axis, &inv_flattening)
+        != SUCCESS)
+    {   /* Error messages already printed */
         return (ERROR);
     }
 
-    /* Verify the projection is GEO, UTM, ALBERS, PS, or SIN and datum is
-       WGS-84 */
-    if (hdr->proj_type != GCTP_GEO_PROJ &&
-        hdr->proj_type != GCTP_UTM_PROJ &&
-        hdr->proj_type != GCTP_ALBERS_PROJ &&
-        hdr->proj_type != GCTP_PS_PROJ &&
-        hdr->proj_type != GCTP_SIN_PROJ)
+    buf[0] = '\0';
+    if (hdr->proj_type == GCTP_GEO_PROJ)
+    {
+        count = snprintf (buf, bufsize,
+            "coordinate system string = GEOGCS[\"%s\", DATUM[\"%s\", "
+            "SPHEROID[\"%s\",%g,%g]], PRIMEM[\"Greenwich\",0.0], "
+            "UNIT[\"Degree\",0.0174532925199433]]\n", geogcs_str, datum_str,
+            spheroid_str, semi_major_axis, inv_flattening);
+    }
+    else if (hdr->proj_type == GCTP_UTM_PROJ)
+    {
+        /* Only the per-band map info line is written for UTM */
+        count = 0;
+    }
+    else if (hdr->proj_type == GCTP_ALBERS_PROJ)
+    {
+        count = snprintf (buf, bufsize,
+            "projection info = {%d, %g, %g, %g, %g, %g, %g, %g, %g, "
+            "%s, Albers Conical Equal Area, units=Meters}\n"
+            "coordinate system string = "
+            "{PROJCS[\"Albers\",GEOGCS[\"%s\", DATUM[\"%s\", "
+            "SPHEROID[\"%s\",%g,%g]], PRIMEM[\"Greenwich\",0.0], "
+            "UNIT[\"Degree\",0.0174532925199433]], "
+            "PROJECTION[\"Albers\"], PARAMETER[\"False_Easting\",%f], "
+            "PARAMETER[\"False_Northing\",%f], "
+            "PARAMETER[\"Central_Meridian\",%f], "
+            "PARAMETER[\"Standard_Parallel_1\",%f], "
+            "PARAMETER[\"Standard_Parallel_2\",%f], "
+            "PARAMETER[\"Latitude_Of_Origin\",%f], UNIT[\"Meter\",1.0]]}\n",
+            ENVI_ALBERS_PROJ, semi_major_axis, semi_minor_axis,
+            hdr->proj_parms[5], hdr->proj_parms[4], hdr->proj_parms[6],
+            hdr->proj_parms[7], hdr->proj_parms[2], hdr->proj_parms[3],
+            proj_datum_str,
+            geogcs_str, datum_str, spheroid_str, semi_major_axis,
+            inv_flattening, hdr->proj_parms[6], hdr->proj_parms[7],
+            hdr->proj_parms[4], hdr->proj_parms[2], hdr->proj_parms[3],
+            hdr->proj_parms[5]);
+    }
+    else if (hdr->proj_type == GCTP_PS_PROJ)
+    {
+        count = snprintf (buf, bufsize,
+            "projection info = {%d, %g, %g, %g, %g, %g, %g, %s, "
+            "Polar Stereographic, units=Meters}\n"
+            "coordinate system string = "
+            "{PROJCS[\"Stereographic_South_Pole\", "
+            "GEOGCS[\"%s\", DATUM[\"%s\", SPHEROID[\"%s\",%g,%g]], "
+            "PRIMEM[\"Greenwich\",0.0], UNIT[\"Degree\",0.0174532925199433]], "
+            "PROJECTION[\"Stereographic_South_Pole\"], "
+            "PARAMETER[\"False_Easting\",%f], "
+            "PARAMETER[\"False_Northing\",%f], "
+            "PARAMETER[\"Central_Meridian\",%f], "
+            "PARAMETER[\"Standard_Parallel_1\",%f], "
+            "UNIT[\"Meter\",1.0]]}\n", ENVI_PS_PROJ,
+            semi_major_axis, semi_minor_axis, hdr->proj_parms[5],
+            hdr->proj_parms[4], hdr->proj_parms[6], hdr->proj_parms[7],
+            proj_datum_str,
+            geogcs_str, datum_str, spheroid_str, semi_major_axis,
+            inv_flattening, hdr->proj_parms[6], hdr->proj_parms[7],
+            hdr->proj_parms[4], hdr->proj_parms[5]);
+    }
+    else if (hdr->proj_type == GCTP_SIN_PROJ)
+    {
+        /* Note: No datum is used for this projection, just the radius of the
+           sphere */
+        count = snprintf (buf, bufsize,
+            "projection info = {%d, %f, %f, %f, %f, Sinusoidal, "
+            "units=Meters}\n"
+            "coordinate system string = {PROJCS[\"Sphere_Sinusoidal\", "
+            "GEOGCS[\"GCS_Sphere\", DATUM[\"D_Sphere\", "
+            "SPHEROID[\"Sphere\",%f,0.0]], "
+            "PRIMEM[\"Greenwich\",0.0], "
+            "UNIT[\"Degree\",0.0174532925199433]], "
+            "PROJECTION[\"Sinusoidal\"], PARAMETER[\"Central_Meridian\",%f], "
+            "PARAMETER[\"False_Easting\",%f], "
+            "PARAMETER[\"False_Northing\",%f], UNIT[\"Meter\",1.0]]}\n",
+            ENVI_SIN_PROJ, hdr->proj_parms[0],
+            hdr->proj_parms[4], hdr->proj_parms[6], hdr->proj_parms[7],
+            hdr->proj_parms[0], hdr->proj_parms[4], hdr->proj_parms[6],
+            hdr->proj_parms[7]);
+    }
+    else
     {
         sprintf (errmsg, "Unsupported projection code (%d).  GEO projection "
             "code (%d) or UTM projection code (%d) or ALBERS projection code "
@@ -97,56 +288,76 @@ int write_envi_hdr
         return (ERROR);
     }
 
-    if (hdr->datum_type != ESPA_WGS84 &&
-        hdr->datum_type != ESPA_NAD27 &&
-        hdr->datum_type != ESPA_NAD83 &&
-        hdr->datum_type != ESPA_NODATUM)
+    if (count < 0 || count >= bufsize)
     {
-        sprintf (errmsg, "Unsupported datum code (%d). WGS84 datum code (%d) "
-            "or NAD27 datum code (%d) or NAD83 datum code (%d) or NODATUM "
-            "datum code (%d) expected.", hdr->datum_type, ESPA_WGS84,
-            ESPA_NAD27, ESPA_NAD83, ESPA_NODATUM);
+        sprintf (errmsg, "Overflow of the projection lines buffer");
         error_handler (true, FUNC_NAME, errmsg);
         return (ERROR);
     }
 
-    /* Determine the GCS, DATUM, and SPHEROID strings that will get written
-       along with the semi-major and inverse flattening numbers */
-    switch (hdr->datum_type)
-    {
-        case ESPA_WGS84:  /* WGS84 sphere */
-            strcpy (geogcs_str, "GCS_WGS_1984");
-            strcpy (datum_str, "D_WGS_1984");
-            strcpy (spheroid_str, "WGS_1984");
-            strcpy (proj_datum_str, "WGS-84");
-            semi_major_axis = GCTP_WGS84_SEMI_MAJOR;
-            semi_minor_axis = GCTP_WGS84_SEMI_MINOR;
-            inv_flattening = GCTP_WGS84_INV_FLATTENING;
-            break;
+    return (SUCCESS);
+}
 
-        case ESPA_NAD27:  /* Clarke 1866 sphere */
-            strcpy (geogcs_str, "GCS_North_American_1927");
-            strcpy (datum_str, "D_North_American_1927");
-            strcpy (spheroid_str, "Clarke_1866");
-            strcpy (proj_datum_str, "North America 1927");
-            semi_major_axis = GCTP_CLARKE_1866_SEMI_MAJOR;
-            semi_minor_axis = GCTP_CLARKE_1866_SEMI_MINOR;
-            inv_flattening = GCTP_CLARKE_1866_INV_FLATTENING;
-            break;
 
-        case ESPA_NAD83:  /* GRS 1980 sphere */
-            strcpy (geogcs_str, "GCS_North_American_1983");
-            strcpy (datum_str, "D_North_American_1983");
-            strcpy (spheroid_str, "GRS_1980");
-            strcpy (proj_datum_str, "North America 1983");
-            semi_major_axis = GCTP_GRS80_SEMI_MAJOR;
-            semi_minor_axis = GCTP_GRS80_SEMI_MINOR;
-            inv_flattening = GCTP_GRS80_INV_FLATTENING;
-            break;
+/******************************************************************************
+MODULE:  format_envi_hdr
+
+PURPOSE:  Formats the complete ENVI header text into the caller's buffer, so
+the header can be written to the file with a single call.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Unsupported projection or datum, or the buffer overflowed
+SUCCESS         Header text was formatted
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development, from the body of
+                              write_envi_hdr
+
+NOTES:
+  1. proj_str holds the band-independent projection lines, pre-formatted via
+     format_envi_proj, so the batch writer only formats them once per
+     product.
+******************************************************************************/
+static int format_envi_hdr
+(
+    Envi_header_t *hdr,  /* I: input ENVI header information */
+    char *proj_str,      /* I: band-independent projection lines from
+                               format_envi_proj */
+    char *buf,           /* O: buffer for the formatted header text */
+    size_t bufsize,      /* I: size of the buffer */
+    size_t *length       /* O: number of bytes of header text */
+)
+{
+    char FUNC_NAME[] = "format_envi_hdr";   /* function name */
+    char errmsg[STR_SIZE];       /* error message */
+    char geogcs_str[STR_SIZE];   /* string for the GCS code */
+    char datum_str[STR_SIZE];    /* string for the datum code */
+    char proj_datum_str[STR_SIZE];  /* string for the datum code in projection
+                                       info section */
+    char spheroid_str[STR_SIZE]; /* string for the spheroid code */
+    int i;                       /* looping variable */
+    int count;                   /* number of chars copied in snprintf */
+    size_t used;                 /* bytes of the buffer used so far */
+    double semi_major_axis;      /* semi-major axis for the spheroid */
+    double semi_minor_axis;      /* semi-minor axis for the spheroid */
+    double inv_flattening;       /* inverse flattening for the spheroid */
+
+    /* Determine the datum strings for the map info line */
+    if (envi_datum_info (hdr->datum_type, geogcs_str, datum_str, spheroid_str,
+        proj_datum_str, &semi_major_axis, &semi_minor_axis, &inv_flattening)
+        != SUCCESS)
+    {   /* Error messages already printed */
+        return (ERROR);
     }
 
-    /* Write the header to the file */
-    fprintf (hdr_fptr,
+    /* Format the fixed fields of the header */
+    used = 0;
+    count = snprintf (buf, bufsize,
         "ENVI\n"
         "description = {%s}\n"
         "samples = %d\n"
@@ -158,38 +369,58 @@ int write_envi_hdr
         "data type = %d\n",
         hdr->description, hdr->nsamps, hdr->nlines, hdr->nbands,
         hdr->header_offset, hdr->byte_order, hdr->file_type, hdr->data_type);
+    if (count < 0 || count >= bufsize - used)
+    {
+        sprintf (errmsg, "Overflow of the header buffer");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+    used += count;
 
     if (hdr->data_ignore_value != ESPA_INT_META_FILL)
-        fprintf (hdr_fptr, "data ignore value = %ld\n", hdr->data_ignore_value);
-   
-    fprintf (hdr_fptr,
+    {
+        count = snprintf (&buf[used], bufsize - used,
+            "data ignore value = %ld\n", hdr->data_ignore_value);
+        if (count < 0 || count >= bufsize - used)
+        {
+            sprintf (errmsg, "Overflow of the header buffer");
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+        used += count;
+    }
+
+    count = snprintf (&buf[used], bufsize - used,
         "interleave = %s\n"
         "sensor_type = %s\n",
         hdr->interleave, hdr->sensor_type);
-   
+    if (count < 0 || count >= bufsize - used)
+    {
+        sprintf (errmsg, "Overflow of the header buffer");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+    used += count;
+
+    /* Format the map info line, which varies with the band's pixel size */
     if (hdr->proj_type == GCTP_GEO_PROJ)
     {
-        fprintf (hdr_fptr,
+        count = snprintf (&buf[used], bufsize - used,
             "map info = {Geographic Lat/Lon, %d, %d, %f, %f, %g, %g, %s, "
             "units=Degrees}\n", hdr->xy_start[0], hdr->xy_start[1],
             hdr->ul_corner[0], hdr->ul_corner[1], hdr->pixel_size[0],
             hdr->pixel_size[1], proj_datum_str);
-        fprintf (hdr_fptr,
-            "coordinate system string = GEOGCS[\"%s\", DATUM[\"%s\", "
-            "SPHEROID[\"%s\",%g,%g]], PRIMEM[\"Greenwich\",0.0], "
-            "UNIT[\"Degree\",0.0174532925199433]]\n", geogcs_str, datum_str,
-            spheroid_str, semi_major_axis, inv_flattening);
     }
     else if (hdr->proj_type == GCTP_UTM_PROJ)
     {
         if (hdr->utm_zone > 0)
-            fprintf (hdr_fptr,
+            count = snprintf (&buf[used], bufsize - used,
                 "map info = {UTM, %d, %d, %f, %f, %g, %g, %d, North, %s, "
                 "units=Meters}\n", hdr->xy_start[0], hdr->xy_start[1],
                 hdr->ul_corner[0], hdr->ul_corner[1], hdr->pixel_size[0],
                 hdr->pixel_size[1], hdr->utm_zone, proj_datum_str);
         else
-            fprintf (hdr_fptr,
+            count = snprintf (&buf[used], bufsize - used,
                 "map info = {UTM, %d, %d, %f, %f, %f, %f, %d, South, %s, "
                 "units=Meters}\n", hdr->xy_start[0], hdr->xy_start[1],
                 hdr->ul_corner[0], hdr->ul_corner[1], hdr->pixel_size[0],
@@ -197,109 +428,277 @@ int write_envi_hdr
     }
     else if (hdr->proj_type == GCTP_ALBERS_PROJ)
     {
-        fprintf (hdr_fptr,
+        count = snprintf (&buf[used], bufsize - used,
             "map info = {Albers Conical Equal Area, %d, %d, %f, %f, %g, %g, "
             "%s, units=Meters}\n", hdr->xy_start[0], hdr->xy_start[1],
             hdr->ul_corner[0], hdr->ul_corner[1], hdr->pixel_size[0],
             hdr->pixel_size[1], proj_datum_str);
-        fprintf (hdr_fptr,
-            "projection info = {%d, %g, %g, %g, %g, %g, %g, %g, %g, "
-            "%s, Albers Conical Equal Area, units=Meters}\n",
-            ENVI_ALBERS_PROJ, semi_major_axis, semi_minor_axis,
-            hdr->proj_parms[5], hdr->proj_parms[4], hdr->proj_parms[6],
-            hdr->proj_parms[7], hdr->proj_parms[2], hdr->proj_parms[3],
-            proj_datum_str);
-        fprintf (hdr_fptr,
-            "coordinate system string = "
-            "{PROJCS[\"Albers\",GEOGCS[\"%s\", DATUM[\"%s\", "
-            "SPHEROID[\"%s\",%g,%g]], PRIMEM[\"Greenwich\",0.0], "
-            "UNIT[\"Degree\",0.0174532925199433]], "
-            "PROJECTION[\"Albers\"], PARAMETER[\"False_Easting\",%f], "
-            "PARAMETER[\"False_Northing\",%f], "
-            "PARAMETER[\"Central_Meridian\",%f], "
-            "PARAMETER[\"Standard_Parallel_1\",%f], "
-            "PARAMETER[\"Standard_Parallel_2\",%f], "
-            "PARAMETER[\"Latitude_Of_Origin\",%f], UNIT[\"Meter\",1.0]]}\n",
-            geogcs_str, datum_str, spheroid_str, semi_major_axis,
-            inv_flattening, hdr->proj_parms[6], hdr->proj_parms[7],
-            hdr->proj_parms[4], hdr->proj_parms[2], hdr->proj_parms[3],
-            hdr->proj_parms[5]);
     }
     else if (hdr->proj_type == GCTP_PS_PROJ)
     {
-        fprintf (hdr_fptr,
+        count = snprintf (&buf[used], bufsize - used,
             "map info = {Polar Stereographic, %d, %d, %f, %f, %g, %g, %s, "
             "units=Meters}\n", hdr->xy_start[0], hdr->xy_start[1],
             hdr->ul_corner[0], hdr->ul_corner[1], hdr->pixel_size[0],
             hdr->pixel_size[1], proj_datum_str);
-        fprintf (hdr_fptr,
-            "projection info = {%d, %g, %g, %g, %g, %g, %g, %s, "
-            "Polar Stereographic, units=Meters}\n", ENVI_PS_PROJ,
-            semi_major_axis, semi_minor_axis, hdr->proj_parms[5],
-            hdr->proj_parms[4], hdr->proj_parms[6], hdr->proj_parms[7],
-            proj_datum_str);
-        fprintf (hdr_fptr,
-            "coordinate system string = "
-            "{PROJCS[\"Stereographic_South_Pole\", "
-            "GEOGCS[\"%s\", DATUM[\"%s\", SPHEROID[\"%s\",%g,%g]], "
-            "PRIMEM[\"Greenwich\",0.0], UNIT[\"Degree\",0.0174532925199433]], "
-            "PROJECTION[\"Stereographic_South_Pole\"], "
-            "PARAMETER[\"False_Easting\",%f], "
-            "PARAMETER[\"False_Northing\",%f], "
-            "PARAMETER[\"Central_Meridian\",%f], "
-            "PARAMETER[\"Standard_Parallel_1\",%f], "
-            "UNIT[\"Meter\",1.0]]}\n",
-            geogcs_str, datum_str, spheroid_str, semi_major_axis,
-            inv_flattening, hdr->proj_parms[6], hdr->proj_parms[7],
-            hdr->proj_parms[4], hdr->proj_parms[5]);
     }
-    else if (hdr->proj_type == GCTP_SIN_PROJ)
+    else if (hdr->proj_type == GCTP_SIN_PROJ)
+    {
+        count = snprintf (&buf[used], bufsize - used,
+            "map info = {Sinusoidal, %d, %d, %f, %f, %g, %g, "
+            "units=Meters}\n", hdr->xy_start[0], hdr->xy_start[1],
+            hdr->ul_corner[0], hdr->ul_corner[1], hdr->pixel_size[0],
+            hdr->pixel_size[1]);
+    }
+    else
+    {
+        sprintf (errmsg, "Unsupported projection code (%d).  GEO projection "
+            "code (%d) or UTM projection code (%d) or ALBERS projection code "
+            "(%d) or PS projection code (%d) or SIN projection code (%d) "
+            "expected.", hdr->proj_type, GCTP_GEO_PROJ, GCTP_UTM_PROJ,
+            GCTP_ALBERS_PROJ, GCTP_PS_PROJ, GCTP_SIN_PROJ);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+    if (count < 0 || count >= bufsize - used)
+    {
+        sprintf (errmsg, "Overflow of the header buffer");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+    used += count;
+
+    /* Append the band-independent projection lines */
+    count = snprintf (&buf[used], bufsize - used, "%s", proj_str);
+    if (count < 0 || count >= bufsize - used)
+    {
+        sprintf (errmsg, "Overflow of the header buffer");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+    used += count;
+
+    /* Format the array of band names */
+    count = snprintf (&buf[used], bufsize - used, "band names = {%s",
+        hdr->band_names[0]);
+    if (count < 0 || count >= bufsize - used)
+    {
+        sprintf (errmsg, "Overflow of the header buffer");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+    used += count;
+    for (i = 1; i < hdr->nbands; i++)
+    {
+        count = snprintf (&buf[used], bufsize - used, ", %s",
+            hdr->band_names[i]);
+        if (count < 0 || count >= bufsize - used)
+        {
+            sprintf (errmsg, "Overflow of the header buffer");
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+        used += count;
+    }
+    count = snprintf (&buf[used], bufsize - used, "}\n");
+    if (count < 0 || count >= bufsize - used)
+    {
+        sprintf (errmsg, "Overflow of the header buffer");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+    used += count;
+
+    *length = used;
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  write_envi_hdr
+
+PURPOSE:  Writes the ENVI header to the specified file using the input info
+provided.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           An error occurred generating the header file
+SUCCESS         Header file was successful
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+12/12/2013   Gail Schmidt     Original development
+4/17/2014    Gail Schmidt     Modified to support additional projections
+4/23/2014    Gail Schmidt     Modified to support additional datums
+11/13/2014   Gail Schmidt     fill_value is now optional
+8/31/2026    Gail Schmidt     Build the header in memory and write it with a
+                              single call instead of many small writes
+
+NOTES:
+  1. Only supports GEO, UTM, ALBERS, PS, and SIN projections.
+  2. Only supports WGS84, NAD27, NAD83 datums (GEO, UTM, ALBERS, PS).
+  3. Sinusoidal needs to pass the radius of the sphere in the first
+     projection parameter for the ENVI header.
+******************************************************************************/
+int write_envi_hdr
+(
+    char *hdr_file,     /* I: name of ENVI header file to be generated */
+    Envi_header_t *hdr  /* I: input ENVI header information */
+)
+{
+    char FUNC_NAME[] = "write_envi_hdr";   /* function name */
+    char errmsg[STR_SIZE];       /* error message */
+    char proj_str[ENVI_PROJ_BUFSIZE];  /* projection-dependent lines */
+    char buf[ENVI_HDR_BUFSIZE];  /* complete header text */
+    size_t length;               /* number of bytes of header text */
+    FILE *hdr_fptr = NULL;       /* file pointer to the ENVI header file */
+
+    /* Format the header text in memory; this also validates the projection
+       and datum before the file is created */
+    if (format_envi_proj (hdr, proj_str, sizeof (proj_str)) != SUCCESS ||
+        format_envi_hdr (hdr, proj_str, buf, sizeof (buf), &length)
+        != SUCCESS)
+    {   /* Error messages already printed */
+        return (ERROR);
+    }
+
+    /* Open the header file */
+    hdr_fptr = fopen (hdr_file, "w");
+    if (hdr_fptr == NULL)
+    {
+        sprintf (errmsg, "Opening %s for write access.", hdr_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Write the header with a single call */
+    if (fwrite (buf, 1, length, hdr_fptr) != length)
+    {
+        sprintf (errmsg, "Writing the header to %s.", hdr_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        fclose (hdr_fptr);
+        return (ERROR);
+    }
+
+    /* Close the header file */
+    fclose (hdr_fptr);
+
+    /* Successful completion */
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  write_envi_hdrs
+
+PURPOSE:  Writes the ENVI header files for every band in the ESPA internal
+metadata structure in one pass.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           An error occurred generating one of the header files
+SUCCESS         Header files were successful
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The header filenames are the band filenames with the extension
+     replaced by .hdr.
+  2. The header fields and projection lines which do not vary from band to
+     band are mapped and formatted once and shared across all the headers,
+     so a many-band product only pays the per-band work for the fields
+     which actually differ.
+******************************************************************************/
+int write_envi_hdrs
+(
+    Espa_internal_meta_t *xml_metadata  /* I: XML metadata structure with the
+                                              bands to write headers for */
+)
+{
+    char FUNC_NAME[] = "write_envi_hdrs";   /* function name */
+    char errmsg[STR_SIZE];       /* error message */
+    char hdr_file[STR_SIZE];     /* name of the current ENVI header file */
+    char proj_str[ENVI_PROJ_BUFSIZE];  /* shared projection-dependent lines */
+    char buf[ENVI_HDR_BUFSIZE];  /* complete header text */
+    char *cptr = NULL;           /* pointer to the file extension */
+    int i;                       /* looping variable for bands */
+    int count;                   /* number of chars copied in snprintf */
+    size_t length;               /* number of bytes of header text */
+    FILE *hdr_fptr = NULL;       /* file pointer to the ENVI header file */
+    Envi_header_t envi_hdr;      /* ENVI header for the current band */
+
+    /* The band-independent fields and projection lines are the same for
+       every band, so only map and format them once */
+    if (create_envi_global (&xml_metadata->global, &envi_hdr) != SUCCESS)
+    {
+        sprintf (errmsg, "Creating the ENVI header structure");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+    if (format_envi_proj (&envi_hdr, proj_str, sizeof (proj_str)) != SUCCESS)
+    {   /* Error messages already printed */
+        return (ERROR);
+    }
+
+    for (i = 0; i < xml_metadata->nbands; i++)
     {
-        /* Note: No datum is used for this projection, just the radius of the
-           sphere */
-        fprintf (hdr_fptr,
-            "map info = {Sinusoidal, %d, %d, %f, %f, %g, %g, "
-            "units=Meters}\n", hdr->xy_start[0], hdr->xy_start[1],
-            hdr->ul_corner[0], hdr->ul_corner[1], hdr->pixel_size[0],
-            hdr->pixel_size[1]);
-        fprintf (hdr_fptr,
-            "projection info = {%d, %f, %f, %f, %f, Sinusoidal, "
-            "units=Meters}\n", ENVI_SIN_PROJ, hdr->proj_parms[0],
-            hdr->proj_parms[4], hdr->proj_parms[6], hdr->proj_parms[7]);
-        fprintf (hdr_fptr,
-            "coordinate system string = {PROJCS[\"Sphere_Sinusoidal\", "
-            "GEOGCS[\"GCS_Sphere\", DATUM[\"D_Sphere\", "
-            "SPHEROID[\"Sphere\",%f,0.0]], "
-            "PRIMEM[\"Greenwich\",0.0], "
-            "UNIT[\"Degree\",0.0174532925199433]], "
-            "PROJECTION[\"Sinusoidal\"], PARAMETER[\"Central_Meridian\",%f], "
-            "PARAMETER[\"False_Easting\",%f], "
-            "PARAMETER[\"False_Northing\",%f], UNIT[\"Meter\",1.0]]}\n",
-            hdr->proj_parms[0], hdr->proj_parms[4], hdr->proj_parms[6],
-            hdr->proj_parms[7]);
+        /* Refill the band-varying fields for this band */
+        if (update_envi_band (&xml_metadata->band[i], &xml_metadata->global,
+            &envi_hdr) != SUCCESS)
+        {
+            sprintf (errmsg, "Creating the ENVI header structure for band "
+                "%d.", i);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
 
-/*        fprintf (hdr_fptr,
-            "coordinate system string = {PROJCS[\"Sinusoidal\", "
-            "GEOGCS[\"GCS_ELLIPSE_BASED_1\", DATUM[\"D_ELLIPSE_BASED_1\", "
-            "SPHEROID[\"S_ELLIPSE_BASED_1\",%f,0.0]], "
-            "PRIMEM[\"Greenwich\",0.0], "
-            "UNIT[\"Degree\",0.0174532925199433]], "
-            "PROJECTION[\"Sinusoidal\"], PARAMETER[\"Central_Meridian\",%f], "
-            "PARAMETER[\"False_Easting\",%f], "
-            "PARAMETER[\"False_Northing\",%f], UNIT[\"Meter\",1.0]]}\n",
-            hdr->proj_parms[0], hdr->proj_parms[4], hdr->proj_parms[6],
-            hdr->proj_parms[7]);
-*/
-    }
+        /* Format the header text for this band */
+        if (format_envi_hdr (&envi_hdr, proj_str, buf, sizeof (buf), &length)
+            != SUCCESS)
+        {   /* Error messages already printed */
+            return (ERROR);
+        }
 
-    /* Write the array of band names */
-    fprintf (hdr_fptr, "band names = {%s", hdr->band_names[0]);
-    for (i = 1; i < hdr->nbands; i++)
-        fprintf (hdr_fptr, ", %s", hdr->band_names[i]);
-    fprintf (hdr_fptr, "}\n");
+        /* Name the header after the band file */
+        count = snprintf (hdr_file, sizeof (hdr_file), "%s",
+            xml_metadata->band[i].file_name);
+        if (count < 0 || count >= sizeof (hdr_file))
+        {
+            sprintf (errmsg, "Overflow of hdr_file string");
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+        cptr = strrchr (hdr_file, '.');
+        if (cptr != NULL)
+            strcpy (cptr, ".hdr");
+        else
+            strcat (hdr_file, ".hdr");
 
-    /* Close the header file */
-    fclose (hdr_fptr);
+        /* Write the header with a single call */
+        hdr_fptr = fopen (hdr_file, "w");
+        if (hdr_fptr == NULL)
+        {
+            sprintf (errmsg, "Opening %.1024s for write access.", hdr_file);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+        if (fwrite (buf, 1, length, hdr_fptr) != length)
+        {
+            sprintf (errmsg, "Writing the header to %.1024s.", hdr_file);
+            error_handler (true, FUNC_NAME, errmsg);
+            fclose (hdr_fptr);
+            return (ERROR);
+        }
+        fclose (hdr_fptr);
+    }
 
     /* Successful completion */
     return (SUCCESS);
@@ -307,10 +706,10 @@ int write_envi_hdr
 
 
 /******************************************************************************
-MODULE:  create_envi_struct
+MODULE:  create_envi_global (static)
 
-PURPOSE:  Creates the ENVI header structure from the ESPA global and band
-metadata.
+PURPOSE:  Fills the fields of the ENVI header structure which do not vary
+from band to band within a product.
 
 RETURN VALUE:
 Type = int
@@ -325,6 +724,10 @@ Date         Programmer       Reason
 1/3/2014     Gail Schmidt     Original development
 4/17/2014    Gail Schmidt     Modified to support additional projections
 4/23/2014    Gail Schmidt     Modified to support additional datums
+8/31/2026    Gail Schmidt     Declare the actual byte order of the band
+                              instead of assuming LSB first
+8/31/2026    Gail Schmidt     Split out of create_envi_struct so the batch
+                              writer only maps these fields once per product
 
 NOTES:
   1. Only supports GEO, UTM, ALBERS, PS, SIN projections.
@@ -334,24 +737,20 @@ NOTES:
   4. Refer to Working with ENVI Header Files in
      http://www.exelisvis.com/portals/0/pdfs/envi/Getting_Started_with_ENVI.pdf
 ******************************************************************************/
-int create_envi_struct
+static int create_envi_global
 (
-    Espa_band_meta_t *bmeta,   /* I: pointer to band metadata for this band */
     Espa_global_meta_t *gmeta, /* I: pointer to global metadata */
     Envi_header_t *hdr         /* I/O: output ENVI header information */
 )
 {
-    char FUNC_NAME[] = "create_envi_struct";   /* function name */
+    char FUNC_NAME[] = "create_envi_global";   /* function name */
     char errmsg[STR_SIZE];   /* error message */
     int i;                   /* looping variable */
     int count;               /* number of chars copied in snprintf */
 
     strcpy (hdr->description, "ESPA-generated file");
-    hdr->nlines = bmeta->nlines;
-    hdr->nsamps = bmeta->nsamps;
     hdr->nbands = 1;
     hdr->header_offset = 0;
-    hdr->byte_order = 0;  /* assume Linux systems -- if Windows switch to 1 */
     strcpy (hdr->file_type, "ENVI Standard");
     strcpy (hdr->interleave, "BSQ");
     count = snprintf (hdr->sensor_type, sizeof (hdr->sensor_type), "%s %s",
@@ -363,22 +762,6 @@ int create_envi_struct
         return (ERROR);
     }
 
-    /* Data type */
-    switch (bmeta->data_type)
-    {
-        case ESPA_INT8: hdr->data_type=1; break;
-        case ESPA_UINT8: hdr->data_type=1; break;
-        case ESPA_INT16: hdr->data_type=2; break;
-        case ESPA_UINT16: hdr->data_type=12; break;
-        case ESPA_INT32: hdr->data_type=3; break;
-        case ESPA_UINT32: hdr->data_type=13; break;
-        case ESPA_FLOAT32: hdr->data_type=4; break;
-        case ESPA_FLOAT64: hdr->data_type=5; break;
-    }
-
-    /* Data ignore value */
-    hdr->data_ignore_value = bmeta->fill_value;
-
     /* Projection information */
     for (i = 0; i < 15; i++)
         hdr->proj_parms[i] = 0.0;
@@ -441,6 +824,73 @@ int create_envi_struct
         return (ERROR);
     }
 
+    hdr->xy_start[0] = hdr->xy_start[1] = 1;
+
+    /* Successful completion */
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  update_envi_band (static)
+
+PURPOSE:  Fills the fields of the ENVI header structure which vary from band
+to band, on top of the band-independent fields set by create_envi_global.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           An error occurred setting the band fields
+SUCCESS         Band fields were set successfully
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development, pulled out of
+                              create_envi_struct so the batch writer and the
+                              direct emitter only refill the band-varying
+                              fields for each band
+
+NOTES:
+******************************************************************************/
+static int update_envi_band
+(
+    Espa_band_meta_t *bmeta,   /* I: pointer to band metadata for this band */
+    Espa_global_meta_t *gmeta, /* I: pointer to global metadata */
+    Envi_header_t *hdr         /* I/O: output ENVI header information */
+)
+{
+    char FUNC_NAME[] = "update_envi_band";   /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    int count;               /* number of chars copied in snprintf */
+
+    hdr->nlines = bmeta->nlines;
+    hdr->nsamps = bmeta->nsamps;
+
+    /* Use the byte order declared in the band metadata if there is one,
+       otherwise the order of the machine writing the band */
+    if (bmeta->byte_order != ESPA_INT_META_FILL)
+        hdr->byte_order = bmeta->byte_order;
+    else
+        hdr->byte_order = espa_machine_byte_order ();
+
+    /* Data type */
+    switch (bmeta->data_type)
+    {
+        case ESPA_INT8: hdr->data_type=1; break;
+        case ESPA_UINT8: hdr->data_type=1; break;
+        case ESPA_INT16: hdr->data_type=2; break;
+        case ESPA_UINT16: hdr->data_type=12; break;
+        case ESPA_INT32: hdr->data_type=3; break;
+        case ESPA_UINT32: hdr->data_type=13; break;
+        case ESPA_FLOAT32: hdr->data_type=4; break;
+        case ESPA_FLOAT64: hdr->data_type=5; break;
+    }
+
+    /* Data ignore value */
+    hdr->data_ignore_value = bmeta->fill_value;
+
     hdr->pixel_size[0] = bmeta->pixel_size[0];
     hdr->pixel_size[1] = bmeta->pixel_size[1];
     count = snprintf (hdr->band_names[0], sizeof (hdr->band_names[0]), "%s",
@@ -454,7 +904,6 @@ int create_envi_struct
 
     /* The UL corner coordinate refer to 1,1 in the line, sample grid.  If the
        grid origin is center, then adjust for the resolution. */
-    hdr->xy_start[0] = hdr->xy_start[1] = 1;
     if (!strcmp (gmeta->proj_info.grid_origin, "CENTER"))
     {
         hdr->ul_corner[0] = gmeta->proj_info.ul_corner[0] -
@@ -472,3 +921,318 @@ int create_envi_struct
     return (SUCCESS);
 }
 
+
+/******************************************************************************
+MODULE:  create_envi_struct
+
+PURPOSE:  Creates the complete ENVI header structure from the ESPA global
+and band metadata.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           An error occurred generating the ENVI header structure
+SUCCESS         Header structure creation was successful
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+1/3/2014     Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Split into create_envi_global and
+                              update_envi_band so the batch writer and the
+                              direct emitter share the field mapping
+
+NOTES:
+******************************************************************************/
+int create_envi_struct
+(
+    Espa_band_meta_t *bmeta,   /* I: pointer to band metadata for this band */
+    Espa_global_meta_t *gmeta, /* I: pointer to global metadata */
+    Envi_header_t *hdr         /* I/O: output ENVI header information */
+)
+{
+    if (create_envi_global (gmeta, hdr) != SUCCESS)
+        return (ERROR);
+    return (update_envi_band (bmeta, gmeta, hdr));
+}
+
+
+/******************************************************************************
+MODULE:  write_envi_hdr_meta
+
+PURPOSE:  Writes an ENVI header file straight from the ESPA band and global
+metadata, without the caller filling an intermediate header structure.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           An error occurred generating the header file
+SUCCESS         Header file was successful
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The formatting is shared with write_envi_hdr and the batch writer, so
+     the emitted header is byte for byte the same as the structure-based
+     path produces.
+******************************************************************************/
+int write_envi_hdr_meta
+(
+    char *hdr_file,            /* I: name of ENVI header file to be generated */
+    Espa_band_meta_t *bmeta,   /* I: pointer to band metadata for this band */
+    Espa_global_meta_t *gmeta  /* I: pointer to global metadata */
+)
+{
+    char FUNC_NAME[] = "write_envi_hdr_meta";   /* function name */
+    char errmsg[STR_SIZE];       /* error message */
+    char proj_str[ENVI_PROJ_BUFSIZE];  /* projection-dependent lines */
+    char buf[ENVI_HDR_BUFSIZE];  /* complete header text */
+    size_t length;               /* number of bytes of header text */
+    FILE *hdr_fptr = NULL;       /* file pointer to the ENVI header file */
+    Envi_header_t envi_hdr;      /* ENVI header built from the metadata */
+
+    /* Map the metadata into the header fields */
+    if (create_envi_struct (bmeta, gmeta, &envi_hdr) != SUCCESS)
+    {
+        sprintf (errmsg, "Creating the ENVI header structure for %s.",
+            hdr_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Format the header text */
+    if (format_envi_proj (&envi_hdr, proj_str, sizeof (proj_str)) != SUCCESS)
+    {   /* Error messages already printed */
+        return (ERROR);
+    }
+    if (format_envi_hdr (&envi_hdr, proj_str, buf, sizeof (buf), &length)
+        != SUCCESS)
+    {   /* Error messages already printed */
+        return (ERROR);
+    }
+
+    /* Write the header with a single call */
+    hdr_fptr = fopen (hdr_file, "w");
+    if (hdr_fptr == NULL)
+    {
+        sprintf (errmsg, "Opening %s for write access.", hdr_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+    if (fwrite (buf, 1, length, hdr_fptr) != length)
+    {
+        sprintf (errmsg, "Writing the header to %s.", hdr_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        fclose (hdr_fptr);
+        return (ERROR);
+    }
+    fclose (hdr_fptr);
+
+    /* Successful completion */
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  read_envi_hdr
+
+PURPOSE:  Reads an existing ENVI header file into the header structure, so
+tools needing only the dimensions and data type of a band can skip parsing
+the full XML metadata.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error reading the header file, or the file is not a valid
+                ENVI header
+SUCCESS         Successfully read the header
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The file is read with a single call and the key/value pairs are
+     tokenized in place, so a header-only query costs one read and no
+     allocations.
+  2. Only the scalar fields and the band names are recovered.  The map info
+     and projection info lines are not parsed back into the projection
+     fields; consumers needing the projection use the XML metadata.
+******************************************************************************/
+int read_envi_hdr
+(
+    char *hdr_file,     /* I: name of the ENVI header file to be read */
+    Envi_header_t *hdr  /* O: header information read from the file */
+)
+{
+    char FUNC_NAME[] = "read_envi_hdr";   /* function name */
+    char errmsg[STR_SIZE];       /* error message */
+    char buf[ENVI_HDR_BUFSIZE];  /* complete header text */
+    char *cptr = NULL;           /* current position in the header text */
+    char *key = NULL;            /* key of the current line */
+    char *kend = NULL;           /* end of the key of the current line */
+    char *val = NULL;            /* value of the current line */
+    char *vend = NULL;           /* end of the value of the current line */
+    char *eq = NULL;             /* '=' of the current line */
+    char *eol = NULL;            /* end of the current line */
+    char *name = NULL;           /* current name in the band names list */
+    char *comma = NULL;          /* next comma in the band names list */
+    int i;                       /* looping variable for band names */
+    size_t nbytes;               /* number of bytes read from the file */
+    FILE *hdr_fptr = NULL;       /* file pointer to the ENVI header file */
+
+    /* Read the whole header with a single call */
+    hdr_fptr = fopen (hdr_file, "r");
+    if (hdr_fptr == NULL)
+    {
+        sprintf (errmsg, "Opening %s for read access.", hdr_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+    nbytes = fread (buf, 1, sizeof (buf) - 1, hdr_fptr);
+    if (ferror (hdr_fptr) || !feof (hdr_fptr))
+    {
+        sprintf (errmsg, "Reading the ENVI header from %s; headers larger "
+            "than %d bytes are not supported.", hdr_file,
+            (int) sizeof (buf) - 1);
+        error_handler (true, FUNC_NAME, errmsg);
+        fclose (hdr_fptr);
+        return (ERROR);
+    }
+    fclose (hdr_fptr);
+    buf[nbytes] = '\0';
+
+    /* The file must start with the ENVI magic line */
+    if (strncmp (buf, "ENVI", 4) != 0)
+    {
+        sprintf (errmsg, "%s is not an ENVI header file.", hdr_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Initialize the header; the fields not present in the file keep these
+       values */
+    memset (hdr, 0, sizeof (*hdr));
+    hdr->data_ignore_value = ESPA_INT_META_FILL;
+
+    /* Walk the key = value lines, tokenizing them in place */
+    cptr = buf;
+    while (cptr != NULL && *cptr != '\0')
+    {
+        key = cptr;
+        eol = strchr (cptr, '\n');
+        if (eol == NULL)
+            eol = cptr + strlen (cptr);
+        eq = memchr (cptr, '=', eol - cptr);
+        if (eq == NULL)
+        {   /* not a key/value line (e.g. the magic line); skip it */
+            cptr = (*eol == '\0') ? eol : eol + 1;
+            continue;
+        }
+
+        /* Terminate the key, trimming the trailing blanks */
+        kend = eq;
+        while (kend > key && (kend[-1] == ' ' || kend[-1] == '\t'))
+            kend--;
+        *kend = '\0';
+
+        /* Locate the value, trimming the leading blanks */
+        val = eq + 1;
+        while (*val == ' ' || *val == '\t')
+            val++;
+        if (*val == '{')
+        {   /* brace-enclosed value, possibly spanning lines */
+            val++;
+            vend = strchr (val, '}');
+            if (vend == NULL)
+            {
+                sprintf (errmsg, "Unterminated brace for the '%.100s' field "
+                    "of %s.", key, hdr_file);
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
+            }
+            *vend = '\0';
+            for (cptr = val; *cptr != '\0'; cptr++)
+            {
+                if (*cptr == '\n')
+                    *cptr = ' ';
+            }
+            cptr = vend + 1;
+            eol = strchr (cptr, '\n');
+            cptr = (eol == NULL) ? cptr + strlen (cptr) : eol + 1;
+        }
+        else
+        {   /* single-line value; terminate it, trimming the trailing
+               blanks */
+            cptr = (*eol == '\0') ? eol : eol + 1;
+            vend = eol;
+            while (vend > val && (vend[-1] == ' ' || vend[-1] == '\t' ||
+                vend[-1] == '\r'))
+                vend--;
+            *vend = '\0';
+        }
+
+        /* Fill in the field for this key; unknown keys are skipped */
+        if (!strcmp (key, "description"))
+            snprintf (hdr->description, sizeof (hdr->description), "%s", val);
+        else if (!strcmp (key, "samples"))
+            hdr->nsamps = atoi (val);
+        else if (!strcmp (key, "lines"))
+            hdr->nlines = atoi (val);
+        else if (!strcmp (key, "bands"))
+            hdr->nbands = atoi (val);
+        else if (!strcmp (key, "header offset"))
+            hdr->header_offset = atoi (val);
+        else if (!strcmp (key, "byte order"))
+            hdr->byte_order = atoi (val);
+        else if (!strcmp (key, "file type"))
+            snprintf (hdr->file_type, sizeof (hdr->file_type), "%s", val);
+        else if (!strcmp (key, "data type"))
+            hdr->data_type = atoi (val);
+        else if (!strcmp (key, "data ignore value"))
+            hdr->data_ignore_value = atol (val);
+        else if (!strcmp (key, "interleave"))
+            snprintf (hdr->interleave, sizeof (hdr->interleave), "%s", val);
+        else if (!strcmp (key, "sensor_type"))
+            snprintf (hdr->sensor_type, sizeof (hdr->sensor_type), "%s", val);
+        else if (!strcmp (key, "band names"))
+        {   /* split the comma-separated list into the band names array */
+            i = 0;
+            name = val;
+            while (name != NULL && i < MAX_ENVI_BANDS)
+            {
+                comma = strchr (name, ',');
+                if (comma != NULL)
+                    *comma = '\0';
+                while (*name == ' ' || *name == '\t')
+                    name++;
+                vend = name + strlen (name);
+                while (vend > name && (vend[-1] == ' ' || vend[-1] == '\t'))
+                    vend--;
+                *vend = '\0';
+                snprintf (hdr->band_names[i], sizeof (hdr->band_names[i]),
+                    "%s", name);
+                i++;
+                name = (comma == NULL) ? NULL : comma + 1;
+            }
+        }
+    }
+
+    /* Validate the fields a header-only query relies on */
+    if (hdr->nlines <= 0 || hdr->nsamps <= 0 || hdr->data_type <= 0)
+    {
+        sprintf (errmsg, "%s does not contain the lines, samples, and data "
+            "type fields of a valid ENVI header.", hdr_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    return (SUCCESS);
+}
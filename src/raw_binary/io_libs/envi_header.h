@@ -14,6 +14,11 @@ Date         Programmer       Reason
 12/12/2013   Gail Schmidt     Original development
 3/31/2014    Ron Dilley       Added fill value to the ENVI header structure
 4/17/2014    Gail Schmidt     Added support for additional projections
+8/31/2026    Gail Schmidt     Added the batch header writer and the buffer
+                              sizes for formatting the header in memory
+8/31/2026    Gail Schmidt     Added a reader for existing ENVI headers so
+                              header-only queries skip the XML parse
+8/31/2026    Gail Schmidt     Added the direct metadata-to-header emitter
 
 NOTES:
 *****************************************************************************/
@@ -40,6 +45,11 @@ NOTES:
    the maximum to be 50 for the HDF ENVI headers */
 #define MAX_ENVI_BANDS 50
 
+/* buffer sizes for formatting the header text in memory; the header buffer
+   allows for the maximum number of band names */
+#define ENVI_PROJ_BUFSIZE 4096
+#define ENVI_HDR_BUFSIZE (8192 + MAX_ENVI_BANDS * STR_SIZE)
+
 /* Structure to contain the ENVI header information */
 typedef struct {
     char description[STR_SIZE];  /* description of file */
@@ -88,6 +98,19 @@ int write_envi_hdr
     Envi_header_t *hdr  /* I: input ENVI header information */
 );
 
+int write_envi_hdrs
+(
+    Espa_internal_meta_t *xml_metadata  /* I: XML metadata structure with the
+                                              bands to write headers for */
+);
+
+int write_envi_hdr_meta
+(
+    char *hdr_file,            /* I: name of ENVI header file to be generated */
+    Espa_band_meta_t *bmeta,   /* I: pointer to band metadata for this band */
+    Espa_global_meta_t *gmeta  /* I: pointer to global metadata */
+);
+
 int create_envi_struct
 (
     Espa_band_meta_t *bmeta,   /* I: pointer to band metadata for this band */
@@ -95,4 +118,10 @@ int create_envi_struct
     Envi_header_t *hdr         /* I/O: output ENVI header information */
 );
 
+int read_envi_hdr
+(
+    char *hdr_file,     /* I: name of the ENVI header file to be read */
+    Envi_header_t *hdr  /* O: header information read from the file */
+);
+
 #endif
@@ -0,0 +1,390 @@
+/*****************************************************************************
+FILE: espa_copy.c
+
+PURPOSE: Contains functions for staging ESPA products between directories.
+The copies are made with FICLONE reflinks where the filesystem supports
+them, so staging on XFS/btrfs reflink volumes shares the extents instead of
+duplicating them, and fall back to an extent-walking copy that preserves
+the holes in sparse band files.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. A reflinked copy is an independent file; the filesystem shares the
+     underlying extents until one side is rewritten.
+*****************************************************************************/
+
+/* copy_file_range and SEEK_DATA/SEEK_HOLE are GNU extensions */
+#define _GNU_SOURCE
+#include <unistd.h>
+#include <fcntl.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <linux/fs.h>
+#endif
+#include "espa_copy.h"
+
+/* Size in bytes of the bounce buffer used when copy_file_range is not
+   available and the data extents are copied through userspace */
+#define COPY_BOUNCE_BUFSIZE (1024 * 1024)
+
+
+/******************************************************************************
+MODULE:  copy_extent (static)
+
+PURPOSE: Copies one data extent of the source file into the destination
+file at the same offset, using copy_file_range so the kernel moves the
+bytes directly, with a bounce buffer fallback for filesystems and kernels
+without that support.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error copying the extent
+SUCCESS         Extent was copied
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static int copy_extent
+(
+    int src_fd,              /* I: descriptor of the source file */
+    int dst_fd,              /* I: descriptor of the destination file */
+    const char *src_file,    /* I: name of the source file (for errors) */
+    off_t offset,            /* I: starting offset of the data extent */
+    off_t length             /* I: number of bytes in the data extent */
+)
+{
+    char FUNC_NAME[] = "copy_extent";  /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    char *buf = NULL;        /* bounce buffer for the fallback copy */
+    off_t src_off = offset;  /* current offset in the source file */
+    off_t dst_off = offset;  /* current offset in the destination file */
+    off_t remaining = length;  /* extent bytes still to be copied */
+    ssize_t nbytes;          /* bytes moved by the current call */
+    size_t chunk;            /* bytes requested from the current call */
+    int use_fallback = 0;    /* is copy_file_range unusable here? */
+
+    while (remaining > 0)
+    {
+        if (!use_fallback)
+        {
+            /* Let the kernel move the bytes between the files without a
+               round trip through a userspace buffer */
+            nbytes = copy_file_range (src_fd, &src_off, dst_fd, &dst_off,
+                remaining, 0);
+            if (nbytes < 0)
+            {
+                /* Fall back to the bounce buffer on kernels or cross-device
+                   setups where copy_file_range is not supported */
+                if (errno == EXDEV || errno == EINVAL || errno == ENOSYS ||
+                    errno == EOPNOTSUPP)
+                {
+                    use_fallback = 1;
+                    continue;
+                }
+                sprintf (errmsg, "Copying the data of %s.", src_file);
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
+            }
+        }
+        else
+        {
+            if (buf == NULL)
+            {
+                buf = malloc (COPY_BOUNCE_BUFSIZE);
+                if (buf == NULL)
+                {
+                    sprintf (errmsg, "Allocating the copy buffer.");
+                    error_handler (true, FUNC_NAME, errmsg);
+                    return (ERROR);
+                }
+            }
+
+            chunk = COPY_BOUNCE_BUFSIZE;
+            if ((off_t) chunk > remaining)
+                chunk = remaining;
+            nbytes = pread (src_fd, buf, chunk, src_off);
+            if (nbytes > 0 &&
+                pwrite (dst_fd, buf, nbytes, dst_off) != nbytes)
+                nbytes = -1;
+            if (nbytes < 0)
+            {
+                sprintf (errmsg, "Copying the data of %s.", src_file);
+                error_handler (true, FUNC_NAME, errmsg);
+                free (buf);
+                return (ERROR);
+            }
+            src_off += nbytes;
+            dst_off += nbytes;
+        }
+
+        if (nbytes == 0)
+        {
+            sprintf (errmsg, "Source file %s shrank while it was being "
+                "copied.", src_file);
+            error_handler (true, FUNC_NAME, errmsg);
+            free (buf);
+            return (ERROR);
+        }
+        remaining -= nbytes;
+    }
+    free (buf);
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  espa_copy_file
+
+PURPOSE: Copies the source file to the destination filename.  The copy is
+made as a FICLONE reflink where the filesystem supports sharing extents,
+and otherwise walks the data extents with SEEK_DATA/SEEK_HOLE so the holes
+in sparse files stay holes in the copy.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error making the copy
+SUCCESS         Copy was made
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The destination file is created with the permission bits of the source
+     file and is truncated if it already exists.
+******************************************************************************/
+int espa_copy_file
+(
+    char *src_file,         /* I: name of the source file */
+    char *dst_file          /* I: name of the destination file */
+)
+{
+    char FUNC_NAME[] = "espa_copy_file";  /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    int src_fd = -1;         /* descriptor of the source file */
+    int dst_fd = -1;         /* descriptor of the destination file */
+    off_t data_off;          /* starting offset of the current data extent */
+    off_t next_off;          /* offset of the next data extent */
+    off_t hole_off;          /* offset of the hole ending the extent */
+    struct stat st;          /* stat buffer for the source file */
+
+    /* Open the source and create the destination */
+    src_fd = open (src_file, O_RDONLY);
+    if (src_fd < 0)
+    {
+        sprintf (errmsg, "Opening the source file: %s", src_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    if (fstat (src_fd, &st) != 0)
+    {
+        sprintf (errmsg, "Getting the size of the source file: %s",
+            src_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        close (src_fd);
+        return (ERROR);
+    }
+
+    dst_fd = open (dst_file, O_WRONLY | O_CREAT | O_TRUNC,
+        st.st_mode & 0777);
+    if (dst_fd < 0)
+    {
+        sprintf (errmsg, "Creating the destination file: %s", dst_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        close (src_fd);
+        return (ERROR);
+    }
+
+#ifdef FICLONE
+    /* Try to reflink the whole file first; on reflink filesystems the copy
+       is then a metadata operation that shares the source extents */
+    if (ioctl (dst_fd, FICLONE, src_fd) == 0)
+    {
+        close (src_fd);
+        if (close (dst_fd) != 0)
+        {
+            sprintf (errmsg, "Closing the destination file: %s", dst_file);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+        return (SUCCESS);
+    }
+#endif
+
+    /* No reflink support between these files, so copy the data extents and
+       leave the holes in place */
+    data_off = 0;
+    while (data_off < st.st_size)
+    {
+        next_off = lseek (src_fd, data_off, SEEK_DATA);
+        if (next_off < 0)
+        {
+            if (errno == ENXIO)
+                break;   /* nothing but a hole to the end of the file */
+
+            /* SEEK_DATA is not supported here; copy the remainder of the
+               file as one data extent */
+            hole_off = st.st_size;
+        }
+        else
+        {
+            data_off = next_off;
+            hole_off = lseek (src_fd, data_off, SEEK_HOLE);
+            if (hole_off < 0)
+                hole_off = st.st_size;
+        }
+
+        if (copy_extent (src_fd, dst_fd, src_file, data_off,
+            hole_off - data_off) != SUCCESS)
+        {  /* Error messages already printed */
+            close (src_fd);
+            close (dst_fd);
+            return (ERROR);
+        }
+        data_off = hole_off;
+    }
+
+    /* Extend the copy out to the source size so a trailing hole is kept */
+    if (ftruncate (dst_fd, st.st_size) != 0)
+    {
+        sprintf (errmsg, "Setting the size of the destination file: %s",
+            dst_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        close (src_fd);
+        close (dst_fd);
+        return (ERROR);
+    }
+
+    close (src_fd);
+    if (close (dst_fd) != 0)
+    {
+        sprintf (errmsg, "Closing the destination file: %s", dst_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  espa_copy_product
+
+PURPOSE: Stages one scene into the destination directory from its metadata:
+the XML file plus every band's raw binary file and ENVI header, each copied
+under its basename.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error staging the scene
+SUCCESS         Scene was staged
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The destination directory must already exist.
+******************************************************************************/
+int espa_copy_product
+(
+    char *espa_xml_file,    /* I: ESPA XML metadata filename of the scene */
+    Espa_internal_meta_t *xml_metadata,  /* I: parsed scene metadata */
+    char *dest_dir          /* I: destination directory for the copies */
+)
+{
+    char FUNC_NAME[] = "espa_copy_product";  /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    char dst_file[STR_SIZE]; /* destination filename of the current copy */
+    char hdr_file[STR_SIZE]; /* ENVI header beside the raw binary file */
+    char *src_file = NULL;   /* source filename of the current copy */
+    char *base = NULL;       /* basename of the current source file */
+    char *cptr = NULL;       /* pointer to the file extension */
+    int count;               /* number of chars copied in snprintf */
+    int i;                   /* looping variable for the files */
+
+    /* The scene holds the XML file plus a raw binary file and an ENVI
+       header per band; index 0 copies the XML file itself */
+    for (i = 0; i <= xml_metadata->nbands; i++)
+    {
+        if (i == 0)
+            src_file = espa_xml_file;
+        else
+        {
+            src_file = xml_metadata->band[i-1].file_name;
+
+            /* The ENVI header sits beside the raw binary file */
+            count = snprintf (hdr_file, sizeof (hdr_file), "%s", src_file);
+            if (count < 0 || count >= sizeof (hdr_file))
+            {
+                sprintf (errmsg, "Overflow of hdr_file string");
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
+            }
+            cptr = strrchr (hdr_file, '.');
+            if (cptr != NULL)
+            {
+                strcpy (cptr, ".hdr");
+                base = strrchr (hdr_file, '/');
+                base = (base != NULL) ? base + 1 : hdr_file;
+                count = snprintf (dst_file, sizeof (dst_file), "%s/%s",
+                    dest_dir, base);
+                if (count < 0 || count >= sizeof (dst_file))
+                {
+                    sprintf (errmsg, "Overflow of dst_file string");
+                    error_handler (true, FUNC_NAME, errmsg);
+                    return (ERROR);
+                }
+                if (espa_copy_file (hdr_file, dst_file) != SUCCESS)
+                {  /* Error messages already printed */
+                    return (ERROR);
+                }
+            }
+        }
+
+        /* Copy the file itself under its basename */
+        base = strrchr (src_file, '/');
+        base = (base != NULL) ? base + 1 : src_file;
+        count = snprintf (dst_file, sizeof (dst_file), "%s/%s", dest_dir,
+            base);
+        if (count < 0 || count >= sizeof (dst_file))
+        {
+            sprintf (errmsg, "Overflow of dst_file string");
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+        if (espa_copy_file (src_file, dst_file) != SUCCESS)
+        {  /* Error messages already printed */
+            return (ERROR);
+        }
+    }
+
+    return (SUCCESS);
+}
@@ -0,0 +1,42 @@
+/*****************************************************************************
+FILE: espa_copy.h
+
+PURPOSE: Contains defines and prototypes for staging ESPA products between
+directories with reflinks where the filesystem supports them.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+
+#ifndef ESPA_COPY_H
+#define ESPA_COPY_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "error_handler.h"
+#include "espa_metadata.h"
+
+/* Prototypes */
+int espa_copy_file
+(
+    char *src_file,         /* I: name of the source file */
+    char *dst_file          /* I: name of the destination file */
+);
+
+int espa_copy_product
+(
+    char *espa_xml_file,    /* I: ESPA XML metadata filename of the scene */
+    Espa_internal_meta_t *xml_metadata,  /* I: parsed scene metadata */
+    char *dest_dir          /* I: destination directory for the copies */
+);
+
+#endif
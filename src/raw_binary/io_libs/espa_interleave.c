@@ -0,0 +1,595 @@
+/*****************************************************************************
+FILE: espa_interleave.c
+
+PURPOSE: Contains functions for converting imagery between the
+band-sequential (BSQ) layout of the ESPA band files and the pixel- and
+line-interleaved (BIP/BIL) layouts some consumers need.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The interleave kernels work in blocks of pixels small enough that the
+     block of every band plus the interleaved output stays cache-resident,
+     so the strided accesses of the interleave never miss to memory.  The
+     2-byte pixel case, which covers most Landsat bands, gets its own loop
+     over 16-bit elements that the compiler can vectorize.
+  2. The streaming converters read the band files through the windowed
+     reader, so compressed bands are handled transparently and the working
+     set stays bounded regardless of the scene size.
+*****************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+#include "espa_buffer.h"
+#include "espa_interleave.h"
+#include "raw_binary_io.h"
+
+
+/******************************************************************************
+MODULE: espa_interleave_pixels
+
+PURPOSE: Interleaves band-sequential pixel runs into a pixel-interleaved
+(BIP) run, a block of pixels at a time.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The block size keeps the current block of every band and the
+     interleaved output cache-resident, so the strided stores hit resident
+     cache lines instead of streaming through memory once per band.
+******************************************************************************/
+void espa_interleave_pixels
+(
+    const unsigned char *const *bands,  /* I: array of nbands band-sequential
+                                   pixel runs, npixels pixels each */
+    int nbands,          /* I: number of bands to be interleaved */
+    size_t npixels,      /* I: number of pixels in each band run */
+    int size,            /* I: number of bytes per pixel */
+    unsigned char *out   /* O: pixel-interleaved run of npixels * nbands
+                               pixels */
+)
+{
+    size_t start;        /* first pixel of the current block */
+    size_t nblock;       /* number of pixels in the current block */
+    size_t i;            /* looping variable for the pixels of a block */
+    int b;               /* looping variable for the bands */
+
+    for (start = 0; start < npixels; start += nblock)
+    {
+        nblock = ESPA_INTERLEAVE_BLOCK_PIXELS;
+        if (nblock > npixels - start)
+            nblock = npixels - start;
+
+        if (size == 2)
+        {
+            /* 16-bit pixels cover most Landsat bands; a dedicated loop
+               over 16-bit elements lets the compiler vectorize it */
+            for (b = 0; b < nbands; b++)
+            {
+                const uint16_t *sp = (const uint16_t *) bands[b] + start;
+                uint16_t *dp = (uint16_t *) out + start * nbands + b;
+
+                for (i = 0; i < nblock; i++)
+                    dp[i * nbands] = sp[i];
+            }
+        }
+        else
+        {
+            for (b = 0; b < nbands; b++)
+            {
+                const unsigned char *sp = bands[b] + start * size;
+                unsigned char *dp = out + (start * nbands + b) * size;
+
+                for (i = 0; i < nblock; i++)
+                    memcpy (dp + i * nbands * size, sp + i * size, size);
+            }
+        }
+    }
+}
+
+
+/******************************************************************************
+MODULE: espa_deinterleave_pixels
+
+PURPOSE: Deinterleaves a pixel-interleaved (BIP) run into band-sequential
+pixel runs, a block of pixels at a time.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The block size keeps the current block of every band and the
+     interleaved input cache-resident, the same as the forward kernel.
+******************************************************************************/
+void espa_deinterleave_pixels
+(
+    const unsigned char *in,  /* I: pixel-interleaved run of npixels * nbands
+                                    pixels */
+    int nbands,          /* I: number of bands to be deinterleaved */
+    size_t npixels,      /* I: number of pixels in each band run */
+    int size,            /* I: number of bytes per pixel */
+    unsigned char *const *bands  /* O: array of nbands band-sequential pixel
+                                       runs, npixels pixels each */
+)
+{
+    size_t start;        /* first pixel of the current block */
+    size_t nblock;       /* number of pixels in the current block */
+    size_t i;            /* looping variable for the pixels of a block */
+    int b;               /* looping variable for the bands */
+
+    for (start = 0; start < npixels; start += nblock)
+    {
+        nblock = ESPA_INTERLEAVE_BLOCK_PIXELS;
+        if (nblock > npixels - start)
+            nblock = npixels - start;
+
+        if (size == 2)
+        {
+            for (b = 0; b < nbands; b++)
+            {
+                const uint16_t *sp = (const uint16_t *) in +
+                    start * nbands + b;
+                uint16_t *dp = (uint16_t *) bands[b] + start;
+
+                for (i = 0; i < nblock; i++)
+                    dp[i] = sp[i * nbands];
+            }
+        }
+        else
+        {
+            for (b = 0; b < nbands; b++)
+            {
+                const unsigned char *sp = in + (start * nbands + b) * size;
+                unsigned char *dp = bands[b] + start * size;
+
+                for (i = 0; i < nblock; i++)
+                    memcpy (dp + i * size, sp + i * nbands * size, size);
+            }
+        }
+    }
+}
+
+
+/******************************************************************************
+MODULE: interleave_chunk_lines (static)
+
+PURPOSE: Determines the number of band lines processed per streaming chunk,
+bounding the working set (every band plane plus the interleaved run) against
+the process memory budget.
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+1 or more    Number of band lines per chunk
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static int interleave_chunk_lines
+(
+    int nbands,          /* I: number of bands in the scene */
+    int nlines,          /* I: number of lines in each band */
+    int nsamps,          /* I: number of samples per line in each band */
+    int size             /* I: number of bytes per pixel */
+)
+{
+    long long budget;    /* byte bound on the chunk working set */
+    long long per_line;  /* working set bytes per band line */
+    long long chunk;     /* lines per chunk */
+
+    budget = (long long) espa_memory_budget_bytes () / 4;
+    if (budget <= 0)
+        budget = ESPA_INTERLEAVE_DEFAULT_BYTES;
+
+    /* Each chunk line is held once in the band planes and once in the
+       interleaved run */
+    per_line = 2LL * nbands * nsamps * size;
+    chunk = budget / per_line;
+    if (chunk < 1)
+        chunk = 1;
+    if (chunk > nlines)
+        chunk = nlines;
+
+    return ((int) chunk);
+}
+
+
+/******************************************************************************
+MODULE: write_interleaved_scene
+
+PURPOSE: Streams the band-sequential band files of a scene into a single
+pixel-interleaved (BIP) or line-interleaved (BIL) output file.
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+ERROR        An error occurred converting the interleave
+SUCCESS      Interleaved file was written
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The band files are read through the windowed reader in chunks of
+     lines, so compressed bands are handled transparently and the working
+     set stays bounded against the process memory budget regardless of the
+     scene size.
+******************************************************************************/
+int write_interleaved_scene
+(
+    char **band_files,   /* I: array of nbands band-sequential band files */
+    int nbands,          /* I: number of bands in the scene */
+    int nlines,          /* I: number of lines in each band */
+    int nsamps,          /* I: number of samples per line in each band */
+    int size,            /* I: number of bytes per pixel */
+    char *interleave,    /* I: output interleave ("BIP" or "BIL") */
+    char *out_file       /* I: name of the interleaved output file */
+)
+{
+    char FUNC_NAME[] = "write_interleaved_scene";  /* function name */
+    char errmsg[STR_SIZE];       /* error message */
+    unsigned char **planes = NULL;  /* per-band chunk planes */
+    unsigned char *run = NULL;   /* interleaved chunk run */
+    size_t line_bytes;           /* bytes in one band line */
+    int chunk_lines;             /* band lines processed per chunk */
+    int line;                    /* first band line of the current chunk */
+    int nchunk;                  /* number of lines in the current chunk */
+    int l;                       /* looping variable for the chunk lines */
+    int b;                       /* looping variable for the bands */
+    bool bip;                    /* pixel-interleaved output? */
+    FILE **fp_in = NULL;         /* file pointers for the band files */
+    FILE *fp_out = NULL;         /* file pointer for the interleaved file */
+
+    /* Validate the requested interleave */
+    if (!strcmp (interleave, "BIP"))
+        bip = true;
+    else if (!strcmp (interleave, "BIL"))
+        bip = false;
+    else
+    {
+        sprintf (errmsg, "Unsupported output interleave: %s", interleave);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Allocate the per-band state and the chunk buffers */
+    chunk_lines = interleave_chunk_lines (nbands, nlines, nsamps, size);
+    line_bytes = (size_t) nsamps * size;
+    fp_in = calloc (nbands, sizeof (FILE *));
+    planes = calloc (nbands, sizeof (unsigned char *));
+    run = espa_borrow_buffer ((size_t) chunk_lines * nbands * line_bytes);
+    if (fp_in == NULL || planes == NULL || run == NULL)
+    {
+        sprintf (errmsg, "Allocating the interleave chunk buffers.");
+        error_handler (true, FUNC_NAME, errmsg);
+        goto error;
+    }
+    for (b = 0; b < nbands; b++)
+    {
+        planes[b] = espa_borrow_buffer ((size_t) chunk_lines * line_bytes);
+        if (planes[b] == NULL)
+        {
+            sprintf (errmsg, "Allocating the chunk plane for band %d.", b);
+            error_handler (true, FUNC_NAME, errmsg);
+            goto error;
+        }
+    }
+
+    /* Open the band files and the interleaved output file */
+    for (b = 0; b < nbands; b++)
+    {
+        fp_in[b] = open_raw_binary (band_files[b], "rb");
+        if (fp_in[b] == NULL)
+        {
+            sprintf (errmsg, "Opening the band file: %s", band_files[b]);
+            error_handler (true, FUNC_NAME, errmsg);
+            goto error;
+        }
+    }
+    fp_out = open_raw_binary (out_file, "wb");
+    if (fp_out == NULL)
+    {
+        sprintf (errmsg, "Opening the interleaved output file: %s", out_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        goto error;
+    }
+
+    /* Stream the scene through the chunk buffers */
+    for (line = 0; line < nlines; line += nchunk)
+    {
+        nchunk = chunk_lines;
+        if (nchunk > nlines - line)
+            nchunk = nlines - line;
+
+        /* Read this chunk of lines from every band */
+        for (b = 0; b < nbands; b++)
+        {
+            if (read_raw_binary_window (fp_in[b], line, 0, nchunk, nsamps,
+                nsamps, size, planes[b]) != SUCCESS)
+            {
+                sprintf (errmsg, "Reading lines %d-%d of band file %s.",
+                    line, line + nchunk - 1, band_files[b]);
+                error_handler (true, FUNC_NAME, errmsg);
+                goto error;
+            }
+        }
+
+        /* Interleave the chunk */
+        if (bip)
+        {
+            espa_interleave_pixels ((const unsigned char *const *) planes,
+                nbands, (size_t) nchunk * nsamps, size, run);
+        }
+        else
+        {
+            /* BIL keeps each band line contiguous, so the interleave is a
+               copy of whole lines */
+            for (l = 0; l < nchunk; l++)
+                for (b = 0; b < nbands; b++)
+                    memcpy (run + ((size_t) l * nbands + b) * line_bytes,
+                        planes[b] + (size_t) l * line_bytes, line_bytes);
+        }
+
+        /* Write the interleaved chunk */
+        if (write_raw_binary (fp_out, nchunk, nbands * nsamps, size, run)
+            != SUCCESS)
+        {
+            sprintf (errmsg, "Writing lines %d-%d of the interleaved file.",
+                line, line + nchunk - 1);
+            error_handler (true, FUNC_NAME, errmsg);
+            goto error;
+        }
+    }
+
+    /* Release the streaming state */
+    for (b = 0; b < nbands; b++)
+    {
+        close_raw_binary (fp_in[b]);
+        espa_return_buffer (planes[b]);
+    }
+    close_raw_binary (fp_out);
+    espa_return_buffer (run);
+    free (planes);
+    free (fp_in);
+    return (SUCCESS);
+
+error:
+    if (fp_in != NULL)
+    {
+        for (b = 0; b < nbands; b++)
+        {
+            if (fp_in[b] != NULL)
+                close_raw_binary (fp_in[b]);
+        }
+    }
+    if (fp_out != NULL)
+        close_raw_binary (fp_out);
+    if (planes != NULL)
+    {
+        for (b = 0; b < nbands; b++)
+        {
+            if (planes[b] != NULL)
+                espa_return_buffer (planes[b]);
+        }
+    }
+    if (run != NULL)
+        espa_return_buffer (run);
+    free (planes);
+    free (fp_in);
+    return (ERROR);
+}
+
+
+/******************************************************************************
+MODULE: write_band_sequential_scene
+
+PURPOSE: Streams a pixel-interleaved (BIP) or line-interleaved (BIL) file
+back into band-sequential band files.
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+ERROR        An error occurred converting the interleave
+SUCCESS      Band files were written
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The working set stays bounded against the process memory budget
+     regardless of the scene size, the same as write_interleaved_scene.
+******************************************************************************/
+int write_band_sequential_scene
+(
+    char *in_file,       /* I: name of the interleaved input file */
+    char *interleave,    /* I: input interleave ("BIP" or "BIL") */
+    int nbands,          /* I: number of bands in the scene */
+    int nlines,          /* I: number of lines in each band */
+    int nsamps,          /* I: number of samples per line in each band */
+    int size,            /* I: number of bytes per pixel */
+    char **band_files    /* I: array of nbands band-sequential band files to
+                               be written */
+)
+{
+    char FUNC_NAME[] = "write_band_sequential_scene";  /* function name */
+    char errmsg[STR_SIZE];       /* error message */
+    unsigned char **planes = NULL;  /* per-band chunk planes */
+    unsigned char *run = NULL;   /* interleaved chunk run */
+    size_t line_bytes;           /* bytes in one band line */
+    int chunk_lines;             /* band lines processed per chunk */
+    int line;                    /* first band line of the current chunk */
+    int nchunk;                  /* number of lines in the current chunk */
+    int l;                       /* looping variable for the chunk lines */
+    int b;                       /* looping variable for the bands */
+    bool bip;                    /* pixel-interleaved input? */
+    FILE *fp_in = NULL;          /* file pointer for the interleaved file */
+    FILE **fp_out = NULL;        /* file pointers for the band files */
+
+    /* Validate the input interleave */
+    if (!strcmp (interleave, "BIP"))
+        bip = true;
+    else if (!strcmp (interleave, "BIL"))
+        bip = false;
+    else
+    {
+        sprintf (errmsg, "Unsupported input interleave: %s", interleave);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Allocate the per-band state and the chunk buffers */
+    chunk_lines = interleave_chunk_lines (nbands, nlines, nsamps, size);
+    line_bytes = (size_t) nsamps * size;
+    fp_out = calloc (nbands, sizeof (FILE *));
+    planes = calloc (nbands, sizeof (unsigned char *));
+    run = espa_borrow_buffer ((size_t) chunk_lines * nbands * line_bytes);
+    if (fp_out == NULL || planes == NULL || run == NULL)
+    {
+        sprintf (errmsg, "Allocating the interleave chunk buffers.");
+        error_handler (true, FUNC_NAME, errmsg);
+        goto error;
+    }
+    for (b = 0; b < nbands; b++)
+    {
+        planes[b] = espa_borrow_buffer ((size_t) chunk_lines * line_bytes);
+        if (planes[b] == NULL)
+        {
+            sprintf (errmsg, "Allocating the chunk plane for band %d.", b);
+            error_handler (true, FUNC_NAME, errmsg);
+            goto error;
+        }
+    }
+
+    /* Open the interleaved input file and the band files */
+    fp_in = open_raw_binary (in_file, "rb");
+    if (fp_in == NULL)
+    {
+        sprintf (errmsg, "Opening the interleaved input file: %s", in_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        goto error;
+    }
+    for (b = 0; b < nbands; b++)
+    {
+        fp_out[b] = open_raw_binary (band_files[b], "wb");
+        if (fp_out[b] == NULL)
+        {
+            sprintf (errmsg, "Opening the band file: %s", band_files[b]);
+            error_handler (true, FUNC_NAME, errmsg);
+            goto error;
+        }
+    }
+
+    /* Stream the scene through the chunk buffers */
+    for (line = 0; line < nlines; line += nchunk)
+    {
+        nchunk = chunk_lines;
+        if (nchunk > nlines - line)
+            nchunk = nlines - line;
+
+        /* Read this chunk of the interleaved file */
+        if (read_raw_binary (fp_in, nchunk, nbands * nsamps, size, run)
+            != SUCCESS)
+        {
+            sprintf (errmsg, "Reading lines %d-%d of the interleaved file.",
+                line, line + nchunk - 1);
+            error_handler (true, FUNC_NAME, errmsg);
+            goto error;
+        }
+
+        /* Deinterleave the chunk into the band planes */
+        if (bip)
+        {
+            espa_deinterleave_pixels (run, nbands,
+                (size_t) nchunk * nsamps, size,
+                (unsigned char *const *) planes);
+        }
+        else
+        {
+            for (l = 0; l < nchunk; l++)
+                for (b = 0; b < nbands; b++)
+                    memcpy (planes[b] + (size_t) l * line_bytes,
+                        run + ((size_t) l * nbands + b) * line_bytes,
+                        line_bytes);
+        }
+
+        /* Write this chunk of lines to every band */
+        for (b = 0; b < nbands; b++)
+        {
+            if (write_raw_binary (fp_out[b], nchunk, nsamps, size, planes[b])
+                != SUCCESS)
+            {
+                sprintf (errmsg, "Writing lines %d-%d of band file %s.",
+                    line, line + nchunk - 1, band_files[b]);
+                error_handler (true, FUNC_NAME, errmsg);
+                goto error;
+            }
+        }
+    }
+
+    /* Release the streaming state */
+    for (b = 0; b < nbands; b++)
+    {
+        close_raw_binary (fp_out[b]);
+        espa_return_buffer (planes[b]);
+    }
+    close_raw_binary (fp_in);
+    espa_return_buffer (run);
+    free (planes);
+    free (fp_out);
+    return (SUCCESS);
+
+error:
+    if (fp_in != NULL)
+        close_raw_binary (fp_in);
+    if (fp_out != NULL)
+    {
+        for (b = 0; b < nbands; b++)
+        {
+            if (fp_out[b] != NULL)
+                close_raw_binary (fp_out[b]);
+        }
+    }
+    if (planes != NULL)
+    {
+        for (b = 0; b < nbands; b++)
+        {
+            if (planes[b] != NULL)
+                espa_return_buffer (planes[b]);
+        }
+    }
+    if (run != NULL)
+        espa_return_buffer (run);
+    free (planes);
+    free (fp_out);
+    return (ERROR);
+}
@@ -0,0 +1,86 @@
+/*****************************************************************************
+FILE: espa_interleave.h
+
+PURPOSE: Contains defines and prototypes for converting imagery between the
+band-sequential (BSQ) layout of the ESPA band files and the pixel- and
+line-interleaved (BIP/BIL) layouts some consumers need.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The interleave names follow the ENVI header convention: "BSQ" for band
+     sequential, "BIL" for band interleave by line, and "BIP" for band
+     interleave by pixel.
+*****************************************************************************/
+
+#ifndef ESPA_INTERLEAVE_H
+#define ESPA_INTERLEAVE_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "error_handler.h"
+
+/* Number of pixels interleaved per block; the block of every band plus the
+   interleaved output stays within the L1/L2 caches, so the strided stores
+   of the interleave hit cache lines that are still resident */
+#define ESPA_INTERLEAVE_BLOCK_PIXELS 2048
+
+/* Byte bound on the streaming working set when no memory budget is
+   configured */
+#define ESPA_INTERLEAVE_DEFAULT_BYTES (64LL * 1024LL * 1024LL)
+
+/* Prototypes */
+void espa_interleave_pixels
+(
+    const unsigned char *const *bands,  /* I: array of nbands band-sequential
+                                   pixel runs, npixels pixels each */
+    int nbands,          /* I: number of bands to be interleaved */
+    size_t npixels,      /* I: number of pixels in each band run */
+    int size,            /* I: number of bytes per pixel */
+    unsigned char *out   /* O: pixel-interleaved run of npixels * nbands
+                               pixels */
+);
+
+void espa_deinterleave_pixels
+(
+    const unsigned char *in,  /* I: pixel-interleaved run of npixels * nbands
+                                    pixels */
+    int nbands,          /* I: number of bands to be deinterleaved */
+    size_t npixels,      /* I: number of pixels in each band run */
+    int size,            /* I: number of bytes per pixel */
+    unsigned char *const *bands  /* O: array of nbands band-sequential pixel
+                                       runs, npixels pixels each */
+);
+
+int write_interleaved_scene
+(
+    char **band_files,   /* I: array of nbands band-sequential band files */
+    int nbands,          /* I: number of bands in the scene */
+    int nlines,          /* I: number of lines in each band */
+    int nsamps,          /* I: number of samples per line in each band */
+    int size,            /* I: number of bytes per pixel */
+    char *interleave,    /* I: output interleave ("BIP" or "BIL") */
+    char *out_file       /* I: name of the interleaved output file */
+);
+
+int write_band_sequential_scene
+(
+    char *in_file,       /* I: name of the interleaved input file */
+    char *interleave,    /* I: input interleave ("BIP" or "BIL") */
+    int nbands,          /* I: number of bands in the scene */
+    int nlines,          /* I: number of lines in each band */
+    int nsamps,          /* I: number of samples per line in each band */
+    int size,            /* I: number of bytes per pixel */
+    char **band_files    /* I: array of nbands band-sequential band files to
+                               be written */
+);
+
+#endif
@@ -0,0 +1,343 @@
+/*****************************************************************************
+FILE: espa_meta_intern.c
+
+PURPOSE: Contains functions for interning the projection/grid metadata into
+a shared read-only segment keyed by content hash.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The segment holds a fixed table of slots, each with a state word, the
+     content hash, and a normalized copy of the projection metadata.  Slots
+     move from empty to busy to ready with compare-and-swap transitions, so
+     the 64 processes of a node fleet can intern concurrently without a
+     cross-process lock.
+  2. Lookups verify the slot contents with memcmp, so a hash collision
+     falls through to the next slot instead of returning the wrong grid.
+*****************************************************************************/
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "espa_checksum.h"
+#include "espa_meta_intern.h"
+
+/* slot states; transitions are empty -> busy -> ready */
+#define INTERN_SLOT_EMPTY 0
+#define INTERN_SLOT_BUSY 1
+#define INTERN_SLOT_READY 2
+
+/* One slot of the shared intern table */
+typedef struct
+{
+    int state;               /* slot state (see the defines above) */
+    unsigned int crc;        /* content hash of the projection metadata */
+    Espa_proj_meta_t proj;   /* normalized projection metadata */
+} Espa_intern_slot_t;
+
+static Espa_intern_slot_t *intern_table = NULL;  /* mapped shared table */
+static pthread_mutex_t intern_lock = PTHREAD_MUTEX_INITIALIZER;
+static bool intern_failed = false;   /* did mapping the segment fail */
+
+/******************************************************************************
+MODULE: meta_intern_enabled (static)
+
+PURPOSE: Checks whether interning was requested through the
+ESPA_META_INTERN environment variable.
+
+RETURN VALUE:
+Type = bool
+Value        Description
+-----        -----------
+true         Projection metadata is interned in the shared segment
+false        Interning was not requested (the default)
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static bool meta_intern_enabled (void)
+{
+    static int enabled = -1;      /* cached setting; -1 until first call */
+    char *value = NULL;           /* value of the environment variable */
+
+    if (enabled == -1)
+    {
+        value = getenv ("ESPA_META_INTERN");
+        enabled = (value != NULL && value[0] != '\0' &&
+            strcmp (value, "0") != 0);
+    }
+
+    return enabled;
+}
+
+
+/******************************************************************************
+MODULE: meta_intern_name (static)
+
+PURPOSE: Builds the name of the shared segment, keyed by the user id so
+fleets of different users on one node do not share state.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static void meta_intern_name
+(
+    char *name,          /* O: shared memory object name */
+    size_t name_size     /* I: size of the name buffer */
+)
+{
+    snprintf (name, name_size, "/espa-meta-intern-%u",
+        (unsigned int) getuid ());
+}
+
+
+/******************************************************************************
+MODULE: map_intern_table (static)
+
+PURPOSE: Creates or opens the shared segment and maps the intern table,
+caching the mapping for the life of the process.
+
+RETURN VALUE:
+Type = Espa_intern_slot_t *
+Value        Description
+-----        -----------
+NULL         The segment could not be created, sized, or mapped
+non-NULL     Pointer to the mapped table
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Every process opens the segment with O_CREAT and sizes it with
+     ftruncate; both are idempotent, and a freshly created segment is
+     zero-filled so every slot starts empty.
+  2. A mapping failure is reported once as a warning and interning is then
+     disabled for the process; the callers keep their private copies.
+******************************************************************************/
+static Espa_intern_slot_t *map_intern_table (void)
+{
+    char FUNC_NAME[] = "map_intern_table";  /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    char shm_name[64];       /* shared memory object name */
+    size_t nbytes;           /* size of the intern table in bytes */
+    int fd = -1;             /* descriptor for the shared memory object */
+    void *table = NULL;      /* mapped table */
+
+    pthread_mutex_lock (&intern_lock);
+    if (intern_table != NULL || intern_failed)
+    {
+        table = intern_table;
+        pthread_mutex_unlock (&intern_lock);
+        return (table);
+    }
+
+    meta_intern_name (shm_name, sizeof (shm_name));
+    nbytes = (size_t) ESPA_META_INTERN_SLOTS * sizeof (Espa_intern_slot_t);
+    fd = shm_open (shm_name, O_RDWR | O_CREAT, 0600);
+    if (fd == -1 || ftruncate (fd, (off_t) nbytes) == -1)
+    {
+        sprintf (errmsg, "Opening shared metadata segment %s; projection "
+            "metadata will not be interned.", shm_name);
+        error_handler (false, FUNC_NAME, errmsg);
+        if (fd != -1)
+            close (fd);
+        intern_failed = true;
+        pthread_mutex_unlock (&intern_lock);
+        return (NULL);
+    }
+
+    table = mmap (NULL, nbytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close (fd);
+    if (table == MAP_FAILED)
+    {
+        sprintf (errmsg, "Mapping shared metadata segment %s; projection "
+            "metadata will not be interned.", shm_name);
+        error_handler (false, FUNC_NAME, errmsg);
+        intern_failed = true;
+        pthread_mutex_unlock (&intern_lock);
+        return (NULL);
+    }
+
+    intern_table = table;
+    pthread_mutex_unlock (&intern_lock);
+    return (table);
+}
+
+
+/******************************************************************************
+MODULE: normalize_proj_metadata (static)
+
+PURPOSE: Copies the projection metadata field by field into a zeroed
+structure, so the bytes of identical grids are identical regardless of
+whatever followed the string terminators or padding in the source.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static void normalize_proj_metadata
+(
+    Espa_proj_meta_t *proj_info,  /* I: projection information to normalize */
+    Espa_proj_meta_t *norm        /* O: normalized copy */
+)
+{
+    memset (norm, 0, sizeof (*norm));
+    norm->proj_type = proj_info->proj_type;
+    norm->datum_type = proj_info->datum_type;
+    snprintf (norm->units, sizeof (norm->units), "%s", proj_info->units);
+    norm->ul_corner[0] = proj_info->ul_corner[0];
+    norm->ul_corner[1] = proj_info->ul_corner[1];
+    norm->lr_corner[0] = proj_info->lr_corner[0];
+    norm->lr_corner[1] = proj_info->lr_corner[1];
+    snprintf (norm->grid_origin, sizeof (norm->grid_origin), "%s",
+        proj_info->grid_origin);
+    norm->utm_zone = proj_info->utm_zone;
+    norm->longitude_pole = proj_info->longitude_pole;
+    norm->latitude_true_scale = proj_info->latitude_true_scale;
+    norm->false_easting = proj_info->false_easting;
+    norm->false_northing = proj_info->false_northing;
+    norm->standard_parallel1 = proj_info->standard_parallel1;
+    norm->standard_parallel2 = proj_info->standard_parallel2;
+    norm->central_meridian = proj_info->central_meridian;
+    norm->origin_latitude = proj_info->origin_latitude;
+    norm->sphere_radius = proj_info->sphere_radius;
+}
+
+
+/******************************************************************************
+MODULE: intern_proj_metadata
+
+PURPOSE: Interns the projection metadata into the shared segment, returning
+a pointer to the canonical read-only copy shared by every process on the
+node.
+
+RETURN VALUE:
+Type = const Espa_proj_meta_t *
+Value        Description
+-----        -----------
+NULL         Interning is disabled, unavailable, or the table is full; the
+             caller keeps its private copy
+non-NULL     Pointer to the shared copy; it stays valid for the life of the
+             process and must not be written
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The slots are probed linearly from the content hash.  A ready slot
+     with matching contents is a hit; an empty slot is claimed with a
+     compare-and-swap and filled; a busy slot (another process mid-fill)
+     is simply skipped and the caller falls back to its private copy
+     rather than spinning on the other process.
+******************************************************************************/
+const Espa_proj_meta_t *intern_proj_metadata
+(
+    Espa_proj_meta_t *proj_info   /* I: projection information to intern */
+)
+{
+    Espa_intern_slot_t *table = NULL;  /* mapped shared table */
+    Espa_intern_slot_t *slot = NULL;   /* slot being probed */
+    Espa_proj_meta_t norm;   /* normalized copy of the projection */
+    unsigned int crc;        /* content hash of the normalized copy */
+    int probe;               /* probe counter */
+    int indx;                /* index of the slot being probed */
+
+    if (!meta_intern_enabled ())
+        return (NULL);
+    table = map_intern_table ();
+    if (table == NULL)
+        return (NULL);
+
+    normalize_proj_metadata (proj_info, &norm);
+    crc = espa_crc32c (0, &norm, sizeof (norm));
+
+    for (probe = 0; probe < ESPA_META_INTERN_SLOTS; probe++)
+    {
+        indx = (int) ((crc + (unsigned int) probe) % ESPA_META_INTERN_SLOTS);
+        slot = &table[indx];
+
+        if (slot->state == INTERN_SLOT_READY)
+        {
+            if (slot->crc == crc &&
+                memcmp (&slot->proj, &norm, sizeof (norm)) == 0)
+                return (&slot->proj);
+            continue;   /* different grid or a collision; keep probing */
+        }
+
+        if (slot->state == INTERN_SLOT_EMPTY &&
+            __sync_bool_compare_and_swap (&slot->state, INTERN_SLOT_EMPTY,
+                INTERN_SLOT_BUSY))
+        {
+            /* Claimed the slot; publish the grid and mark it ready.  The
+               barrier orders the contents before the state so a reader
+               seeing READY sees the full slot */
+            slot->crc = crc;
+            memcpy (&slot->proj, &norm, sizeof (norm));
+            __sync_synchronize ();
+            slot->state = INTERN_SLOT_READY;
+            return (&slot->proj);
+        }
+
+        /* The slot is busy in another process; skip it rather than spin */
+    }
+
+    /* Table is full of other grids; the caller keeps its private copy */
+    return (NULL);
+}
+
+
+/******************************************************************************
+MODULE: remove_meta_intern_segment
+
+PURPOSE: Removes the shared segment from the system, e.g. between
+campaigns.  Processes that already mapped it keep their mapping until they
+exit.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void remove_meta_intern_segment (void)
+{
+    char shm_name[64];       /* shared memory object name */
+
+    meta_intern_name (shm_name, sizeof (shm_name));
+    shm_unlink (shm_name);
+}
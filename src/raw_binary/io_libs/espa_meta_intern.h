@@ -0,0 +1,48 @@
+/*****************************************************************************
+FILE: espa_meta_intern.h
+
+PURPOSE: Contains defines and prototypes for interning the projection/grid
+metadata into a shared read-only segment keyed by content hash.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. ARD tiles share identical projection/grid metadata across thousands of
+     products, and every process on a node otherwise parses and stores its
+     own copy.  Interning publishes one canonical copy of the projection
+     metadata in a POSIX shared memory segment; the processes of a fleet
+     map the same segment and reference the shared copy.
+  2. Interning is opt-in; set ESPA_META_INTERN in the environment to enable
+     it.  When it is disabled or unavailable the intern call returns NULL
+     and the callers keep their private copy, so behavior is unchanged.
+  3. The segment is keyed by the user id, persists across processes, and is
+     removed with remove_meta_intern_segment (e.g. by a fleet supervisor
+     between campaigns).
+*****************************************************************************/
+
+#ifndef ESPA_META_INTERN_H
+#define ESPA_META_INTERN_H
+
+#include "espa_metadata.h"
+
+/* number of projection metadata slots in the shared segment; ARD
+   campaigns use a handful of distinct grids, so collisions are rare */
+#define ESPA_META_INTERN_SLOTS 128
+
+/* Prototypes */
+const Espa_proj_meta_t *intern_proj_metadata
+(
+    Espa_proj_meta_t *proj_info   /* I: projection information to intern */
+);
+
+void remove_meta_intern_segment (void);
+
+#endif
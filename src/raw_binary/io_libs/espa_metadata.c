@@ -13,6 +13,15 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 12/13/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Validate against the schema embedded into the
+                              library at build time instead of fetching it
+                              from the ESPA http site or reading it from disk
+8/31/2026    Gail Schmidt     Maintain the compact hot band descriptors for
+                              the iteration-heavy metadata scans
+8/31/2026    Gail Schmidt     Mark the schema validation as a startup phase
+                              for the cold-start profile
+8/31/2026    Gail Schmidt     Added the lazily-allocated QA description
+                              accessors (set_band_qa_desc, get_band_qa_desc)
 
 NOTES:
   1. The XML metadata format parsed or written via this library follows the
@@ -22,7 +31,303 @@ NOTES:
   2. This code relies on the libxml2 library developed for the Gnome project.
 *****************************************************************************/
 #include <sys/stat.h>
+#include <pthread.h>
+#include <unistd.h>
 #include "espa_metadata.h"
+#include "espa_checksum.h"
+#include "espa_schema_data.h"
+#include "espa_xml_init.h"
+#include "espa_startup.h"
+
+/******************************************************************************
+MODULE:  trusted_metadata_name (static)
+
+PURPOSE:  Builds the name of the trust sidecar file for a metadata file.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Sidecar filename overflows the buffer
+SUCCESS         Sidecar filename was built
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static int trusted_metadata_name
+(
+    const char *meta_file,    /* I: name of the metadata file */
+    char *trust_file,         /* O: name of the trust sidecar file */
+    size_t size               /* I: size of the trust_file buffer */
+)
+{
+    int count;                /* number of chars copied in snprintf */
+
+    count = snprintf (trust_file, size, "%s.trust", meta_file);
+    if (count < 0 || count >= size)
+        return (ERROR);
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  checksum_metadata_file (static)
+
+PURPOSE:  Computes the CRC32C checksum of the contents of a metadata file.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error reading the metadata file
+SUCCESS         Checksum was computed
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static int checksum_metadata_file
+(
+    const char *meta_file,    /* I: name of the metadata file */
+    unsigned int *crc         /* O: CRC32C of the file contents */
+)
+{
+    unsigned char buf[65536]; /* read buffer */
+    size_t nbytes;            /* number of bytes read */
+    FILE *fptr = NULL;        /* file pointer to the metadata file */
+
+    fptr = fopen (meta_file, "rb");
+    if (fptr == NULL)
+        return (ERROR);
+
+    *crc = 0;
+    while ((nbytes = fread (buf, 1, sizeof (buf), fptr)) > 0)
+        *crc = espa_crc32c (*crc, buf, nbytes);
+
+    if (ferror (fptr))
+    {
+        fclose (fptr);
+        return (ERROR);
+    }
+
+    fclose (fptr);
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  record_trusted_metadata
+
+PURPOSE:  Records the content checksum of a metadata file in a trust sidecar
+file, so later stages in the pipeline can skip schema validation of the
+unchanged document.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Failures are quietly ignored; without a sidecar the document is simply
+     revalidated as before.
+  2. Any modification of the metadata file after the sidecar is written
+     makes the recorded checksum stale, which disables the trust fast path
+     until the sidecar is rewritten.
+******************************************************************************/
+void record_trusted_metadata
+(
+    char *meta_file           /* I: name of the metadata file just written */
+)
+{
+    char trust_file[STR_SIZE];  /* name of the trust sidecar file */
+    char crc_str[ESPA_CHECKSUM_STR_SIZE];  /* formatted checksum */
+    unsigned int crc;         /* CRC32C of the file contents */
+    FILE *fptr = NULL;        /* file pointer to the sidecar file */
+
+    if (trusted_metadata_name (meta_file, trust_file, sizeof (trust_file))
+        != SUCCESS)
+        return;
+
+    if (checksum_metadata_file (meta_file, &crc) != SUCCESS)
+        return;
+
+    fptr = fopen (trust_file, "w");
+    if (fptr == NULL)
+        return;
+
+    espa_crc32c_string (crc, crc_str);
+    fprintf (fptr, "%s\n", crc_str);
+    fclose (fptr);
+}
+
+
+/******************************************************************************
+MODULE:  is_trusted_metadata
+
+PURPOSE:  Checks whether a metadata file carries a trust sidecar whose
+recorded checksum still matches the file contents.
+
+RETURN VALUE:
+Type = bool
+Value           Description
+-----           -----------
+true            The recorded checksum matches the file contents
+false           No sidecar, or the document changed since it was recorded
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+bool is_trusted_metadata
+(
+    char *meta_file           /* I: name of the metadata file */
+)
+{
+    char trust_file[STR_SIZE];  /* name of the trust sidecar file */
+    char crc_str[ESPA_CHECKSUM_STR_SIZE];  /* formatted checksum */
+    char stored_str[ESPA_CHECKSUM_STR_SIZE];  /* checksum from the sidecar */
+    unsigned int crc;         /* CRC32C of the file contents */
+    FILE *fptr = NULL;        /* file pointer to the sidecar file */
+
+    if (trusted_metadata_name (meta_file, trust_file, sizeof (trust_file))
+        != SUCCESS)
+        return (false);
+
+    fptr = fopen (trust_file, "r");
+    if (fptr == NULL)
+        return (false);
+
+    if (fscanf (fptr, "%8s", stored_str) != 1)
+    {
+        fclose (fptr);
+        return (false);
+    }
+    fclose (fptr);
+
+    if (checksum_metadata_file (meta_file, &crc) != SUCCESS)
+        return (false);
+
+    espa_crc32c_string (crc, crc_str);
+    return (strcmp (crc_str, stored_str) == 0);
+}
+
+
+/******************************************************************************
+MODULE:  espa_schema_location (static)
+
+PURPOSE:  Determines the location of the ESPA schema file/URL to validate
+against.
+
+RETURN VALUE:
+Type = char *
+Value           Description
+-----           -----------
+non-NULL        Name of the schema file or URL to be used
+NULL            The schema embedded into the library is to be used
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Prefer the schema embedded into the library so
+                              a fresh container validates without touching
+                              the network or filesystem
+
+NOTES:
+  1. The ESPA_SCHEMA environment variable is preferred, followed by the
+     schema embedded into the library at build time.  The schema installed
+     under /usr/local and the version on the ESPA http site are only
+     consulted if the library was somehow built without the embedded copy.
+******************************************************************************/
+static char *espa_schema_location (void)
+{
+    char *schema_file = NULL;     /* name of schema file or URL */
+    struct stat statbuf;          /* buffer for the file stat function */
+
+    /* Get the ESPA schema environment variable which specifies the location
+       of the XML schema to be used */
+    schema_file = getenv ("ESPA_SCHEMA");
+    if (schema_file == NULL)
+    {  /* ESPA schema environment variable wasn't defined.  Use the schema
+          embedded into the library at build time... */
+        if (espa_embedded_schema_len > 0)
+            return (NULL);
+
+        /* The embedded schema isn't available.  Try the version in
+           /usr/local... */
+        schema_file = LOCAL_ESPA_SCHEMA;
+        if (stat (schema_file, &statbuf) == -1)
+        {  /* /usr/local ESPA schema file doesn't exist.  Try the version on
+              the ESPA http site... */
+            schema_file = ESPA_SCHEMA;
+        }
+    }
+
+    return (schema_file);
+}
+
+
+/******************************************************************************
+MODULE:  espa_schema_parse (static)
+
+PURPOSE:  Parses and compiles the schema from the specified file/URL, or
+from the copy embedded into the library when no file was specified.
+
+RETURN VALUE:
+Type = xmlSchemaPtr
+Value           Description
+-----           -----------
+non-NULL        Compiled schema; the caller frees it with xmlSchemaFree
+NULL            An error occurred parsing or compiling the schema
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static xmlSchemaPtr espa_schema_parse
+(
+    char *schema_file         /* I: name of schema file or URL; NULL compiles
+                                    the embedded schema */
+)
+{
+    xmlSchemaParserCtxtPtr ctxt = NULL;  /* parser context for the schema */
+    xmlSchemaPtr schema = NULL;          /* compiled schema */
+
+    /* Set up the schema parser over the schema file/URL or the embedded
+       schema document */
+    if (schema_file != NULL)
+        ctxt = xmlSchemaNewParserCtxt (schema_file);
+    else
+        ctxt = xmlSchemaNewMemParserCtxt (espa_embedded_schema,
+            (int) espa_embedded_schema_len);
+    if (ctxt == NULL)
+        return (NULL);
+
+    xmlSchemaSetParserErrors (ctxt, (xmlSchemaValidityErrorFunc) fprintf,
+        (xmlSchemaValidityWarningFunc) fprintf, stderr);
+    schema = xmlSchemaParse (ctxt);
+    xmlSchemaFreeParserCtxt (ctxt);
+
+    return (schema);
+}
+
 
 /******************************************************************************
 MODULE:  validate_xml_file
@@ -33,373 +338,1390 @@ RETURN VALUE:
 Type = int
 Value           Description
 -----           -----------
-ERROR           XML does not validate against the specified schema
-SUCCESS         XML validates
+ERROR           XML does not validate against the specified schema
+SUCCESS         XML validates
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+12/13/2013   Gail Schmidt     Original development
+8/5/2014     Gail Schmidt     Obtain the location of the ESPA schema file from
+                              an environment variable vs. the ESPA http site
+8/31/2026    Gail Schmidt     Cache the compiled schema so repeated validations
+                              don't recompile it for every file
+8/31/2026    Gail Schmidt     Skip the validation when a trust sidecar shows
+                              the document is unchanged since it was written
+8/31/2026    Gail Schmidt     Factored the schema location lookup so the bulk
+                              validator shares it
+8/31/2026    Gail Schmidt     Funnel the libxml2 global setup through the
+                              shared once-guarded initializer
+8/31/2026    Gail Schmidt     Validate against the schema embedded into the
+                              library unless ESPA_SCHEMA overrides it
+
+NOTES:
+  1. The compiled schema is cached for the life of the process, keyed by the
+     schema file name.  Batch tools which validate many metadata files only
+     pay the schema parse/compile cost once.
+  2. Files written by write_metadata carry a trust sidecar recording the
+     content checksum; when the checksum still matches, the document came
+     from this library unchanged and the schema validation is skipped.
+******************************************************************************/
+int validate_xml_file
+(
+    char *meta_file           /* I: name of metadata file to be validated */
+)
+{
+    char FUNC_NAME[] = "validate_xml_file";   /* function name */
+    char errmsg[STR_SIZE];        /* error message */
+    char *schema_file = NULL;     /* name of schema file or URL to be validated
+                                     against; NULL for the embedded schema */
+    char *schema_name = NULL;     /* schema name for reporting and caching */
+    int status;                   /* return status */
+    xmlDocPtr doc = NULL;         /* resulting document tree */
+    xmlSchemaValidCtxtPtr valid_ctxt = NULL;  /* pointer to validate from the
+                                                 schema */
+    static xmlSchemaPtr cached_schema = NULL;  /* compiled schema, cached
+                                     across calls for the life of the
+                                     process */
+    static char cached_schema_file[STR_SIZE] = "";  /* schema file name the
+                                     cached schema was compiled from */
+
+    /* Skip the validation if the file carries a trust sidecar recorded by
+       write_metadata and the document has not changed since; chained tools
+       otherwise revalidate the same unchanged document at every stage */
+    if (is_trusted_metadata (meta_file))
+    {
+        printf ("Skipping validation of %s metadata file; the recorded "
+            "content checksum matches ...\n", meta_file);
+        return (SUCCESS);
+    }
+
+    /* Make sure the libxml2 global setup has run before the parser and
+       schema contexts are created */
+    espa_xml_init ();
+
+    /* Get the location of the XML schema to be used; NULL indicates the
+       schema embedded into the library at build time */
+    schema_file = espa_schema_location ();
+    schema_name = (schema_file != NULL) ? schema_file :
+        "the embedded schema";
+    printf ("Validating %s metadata file with %s ...\n", meta_file,
+        schema_name);
+
+    /* Compile the schema if it isn't already cached from a previous call
+       against the same schema file */
+    if (cached_schema == NULL ||
+        strcmp (cached_schema_file, schema_name) != 0)
+    {
+        /* Release any previously-cached schema for a different file */
+        if (cached_schema != NULL)
+        {
+            xmlSchemaFree (cached_schema);
+            cached_schema = NULL;
+        }
+
+        /* Parse and compile the schema file/URL or the embedded schema */
+        cached_schema = espa_schema_parse (schema_file);
+        snprintf (cached_schema_file, sizeof (cached_schema_file), "%s",
+            schema_name);
+    }
+
+    /* Load the XML file and parse it to the document tree */
+    doc = xmlReadFile (meta_file, NULL, 0);
+    if (doc == NULL)
+    {
+        sprintf (errmsg, "Could not parse %s", meta_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        sprintf (errmsg, "Possible schema file not found.  ESPA_SCHEMA "
+            "environment variable isn't defined.  The first default schema "
+            "location of %s doesn't exist.  And the second default location of "
+            "%s was used as the last default.", LOCAL_ESPA_SCHEMA, ESPA_SCHEMA);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Identify the schema file as the validation source */
+    valid_ctxt = xmlSchemaNewValidCtxt (cached_schema);
+    xmlSchemaSetValidErrors (valid_ctxt, (xmlSchemaValidityErrorFunc) fprintf,
+        (xmlSchemaValidityWarningFunc) fprintf, stderr);
+
+    /* Validate the XML metadata against the schema */
+    status = xmlSchemaValidateDoc (valid_ctxt, doc);
+    if (status > 0)
+    {
+        sprintf (errmsg, "%s fails to validate", meta_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+    else if (status != 0)
+    {
+        sprintf (errmsg, "%s validation generated an internal error",
+            meta_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Free the per-file resources; the compiled schema stays cached for
+       the next validation */
+    xmlSchemaFreeValidCtxt (valid_ctxt);
+    xmlFreeDoc (doc);
+
+    /* Successful completion */
+    espa_startup_mark ("schema validation");
+    return (SUCCESS);
+}
+
+
+/* maximum number of worker threads used by validate_xml_files */
+#define ESPA_VALIDATE_MAX_THREADS 16
+
+/* Shared state for the pool of bulk validation workers */
+typedef struct
+{
+    char **meta_files;       /* array of metadata file names to validate */
+    int *file_status;        /* SUCCESS/ERROR validation status per file */
+    int nfiles;              /* number of metadata files */
+    int next_file;           /* next file index, protected by lock */
+    pthread_mutex_t lock;    /* mutex protecting next_file */
+    xmlSchemaPtr schema;     /* compiled schema shared by the workers */
+} Espa_validate_pool_t;
+
+
+/******************************************************************************
+MODULE:  validate_xml_doc (static)
+
+PURPOSE:  Validates a single XML file against an already-compiled schema
+using the caller's validation context.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           XML does not validate against the schema
+SUCCESS         XML validates
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Files carrying a matching trust sidecar are skipped, the same as in
+     validate_xml_file.
+******************************************************************************/
+static int validate_xml_doc
+(
+    xmlSchemaValidCtxtPtr valid_ctxt,  /* I: validation context compiled
+                                             from the schema */
+    char *meta_file           /* I: name of metadata file to be validated */
+)
+{
+    char FUNC_NAME[] = "validate_xml_doc";   /* function name */
+    char errmsg[STR_SIZE];        /* error message */
+    int status;                   /* return status */
+    xmlDocPtr doc = NULL;         /* resulting document tree */
+
+    /* Skip the validation if the file carries a trust sidecar recorded by
+       write_metadata and the document has not changed since */
+    if (is_trusted_metadata (meta_file))
+    {
+        printf ("Skipping validation of %s metadata file; the recorded "
+            "content checksum matches ...\n", meta_file);
+        return (SUCCESS);
+    }
+
+    /* Load the XML file and parse it to the document tree */
+    doc = xmlReadFile (meta_file, NULL, 0);
+    if (doc == NULL)
+    {
+        sprintf (errmsg, "Could not parse %s", meta_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Validate the XML metadata against the schema */
+    status = xmlSchemaValidateDoc (valid_ctxt, doc);
+    xmlFreeDoc (doc);
+    if (status > 0)
+    {
+        sprintf (errmsg, "%s fails to validate", meta_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+    else if (status != 0)
+    {
+        sprintf (errmsg, "%s validation generated an internal error",
+            meta_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  validate_xml_files_worker (static)
+
+PURPOSE:  Thread worker which pulls metadata files from the shared pool and
+validates each one against the shared compiled schema until no files remain.
+
+RETURN VALUE:
+Type = void *
+Value           Description
+-----           -----------
+NULL            Always returned
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Each worker creates its own validation context over the shared compiled
+     schema, since validation contexts are not thread-safe but the compiled
+     schema is read-only.
+  2. A file that fails validation is recorded in the pool status array and
+     does not stop the remaining files from being validated.
+******************************************************************************/
+static void *validate_xml_files_worker
+(
+    void *pool_ptr      /* I/O: pool of files to validate
+                                (Espa_validate_pool_t) */
+)
+{
+    Espa_validate_pool_t *pool = pool_ptr;  /* shared validation pool */
+    xmlSchemaValidCtxtPtr valid_ctxt = NULL;  /* per-thread validation
+                                                 context */
+    int file_index;                 /* index of the current file */
+
+    /* Set up this worker's validation context over the shared schema */
+    valid_ctxt = xmlSchemaNewValidCtxt (pool->schema);
+    if (valid_ctxt == NULL)
+        return (NULL);
+    xmlSchemaSetValidErrors (valid_ctxt, (xmlSchemaValidityErrorFunc) fprintf,
+        (xmlSchemaValidityWarningFunc) fprintf, stderr);
+
+    while (true)
+    {
+        /* Pull the next file from the pool */
+        pthread_mutex_lock (&pool->lock);
+        file_index = pool->next_file;
+        if (file_index < pool->nfiles)
+            pool->next_file++;
+        pthread_mutex_unlock (&pool->lock);
+        if (file_index >= pool->nfiles)
+            break;
+
+        /* Validate this file */
+        pool->file_status[file_index] =
+            validate_xml_doc (valid_ctxt, pool->meta_files[file_index]);
+    }
+
+    xmlSchemaFreeValidCtxt (valid_ctxt);
+    return (NULL);
+}
+
+
+/******************************************************************************
+MODULE:  validate_xml_files
+
+PURPOSE:  Validates a list of XML files against the ESPA schema, sharing one
+compiled schema across a pool of threads with per-thread parser contexts.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           One or more of the XML files does not validate
+SUCCESS         All the XML files validate
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Funnel the libxml2 global setup through the
+                              shared once-guarded initializer
+8/31/2026    Gail Schmidt     Validate against the schema embedded into the
+                              library unless ESPA_SCHEMA overrides it
+
+NOTES:
+  1. The schema is parsed and compiled once for the whole list, so sweeps
+     over large archives don't pay the schema compile (or a process fork)
+     per file.
+  2. If nthreads is zero or less, then one thread per online processor is
+     used, capped at ESPA_VALIDATE_MAX_THREADS.
+  3. Each failing file is reported as it is found, and the overall count of
+     failures is reported at the end.
+******************************************************************************/
+int validate_xml_files
+(
+    char **meta_files,        /* I: array of nfiles metadata file names to be
+                                    validated */
+    int nfiles,               /* I: number of metadata files in the list */
+    int nthreads              /* I: number of validation threads; zero or
+                                    less uses one per online processor */
+)
+{
+    char FUNC_NAME[] = "validate_xml_files";   /* function name */
+    char errmsg[STR_SIZE];        /* error message */
+    char *schema_file = NULL;     /* name of schema file or URL to be validated
+                                     against; NULL for the embedded schema */
+    char *schema_name = NULL;     /* schema name for reporting */
+    int i;                        /* looping variable */
+    int nfailed = 0;              /* number of files failing validation */
+    int threads_created = 0;      /* number of worker threads started */
+    Espa_validate_pool_t pool;    /* shared validation pool */
+
+    /* Nothing to do for an empty list */
+    if (nfiles < 1)
+        return (SUCCESS);
+
+    /* Make sure the libxml2 global setup has run before any of the threads
+       touch the parser */
+    espa_xml_init ();
+
+    /* Parse and compile the schema once; the compiled schema is read-only
+       and shared by all the workers */
+    schema_file = espa_schema_location ();
+    schema_name = (schema_file != NULL) ? schema_file :
+        "the embedded schema";
+    printf ("Validating %d metadata files with %s ...\n", nfiles,
+        schema_name);
+    pool.schema = espa_schema_parse (schema_file);
+    if (pool.schema == NULL)
+    {
+        sprintf (errmsg, "Compiling the schema %s", schema_name);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Set up the validation pool */
+    pool.meta_files = meta_files;
+    pool.nfiles = nfiles;
+    pool.next_file = 0;
+    pool.file_status = malloc (nfiles * sizeof (int));
+    if (pool.file_status == NULL)
+    {
+        sprintf (errmsg, "Allocating the validation status for %d files",
+            nfiles);
+        error_handler (true, FUNC_NAME, errmsg);
+        xmlSchemaFree (pool.schema);
+        return (ERROR);
+    }
+    for (i = 0; i < nfiles; i++)
+        pool.file_status[i] = ERROR;
+    if (pthread_mutex_init (&pool.lock, NULL) != 0)
+    {
+        sprintf (errmsg, "Initializing the validation pool mutex");
+        error_handler (true, FUNC_NAME, errmsg);
+        free (pool.file_status);
+        xmlSchemaFree (pool.schema);
+        return (ERROR);
+    }
+
+    /* Size the thread pool; don't use more threads than there are files */
+    if (nthreads <= 0)
+        nthreads = sysconf (_SC_NPROCESSORS_ONLN);
+    if (nthreads > ESPA_VALIDATE_MAX_THREADS)
+        nthreads = ESPA_VALIDATE_MAX_THREADS;
+    if (nthreads > nfiles)
+        nthreads = nfiles;
+    if (nthreads < 1)
+        nthreads = 1;
+
+    if (nthreads == 1)
+    {
+        /* Validate the files serially */
+        validate_xml_files_worker (&pool);
+    }
+    else
+    {
+        pthread_t threads[nthreads];  /* thread pool handles */
+
+        /* Start the validation workers */
+        for (i = 0; i < nthreads; i++)
+        {
+            if (pthread_create (&threads[i], NULL, validate_xml_files_worker,
+                &pool) != 0)
+            {
+                sprintf (errmsg, "Unable to create all %d validation "
+                    "threads; continuing with %d", nthreads, threads_created);
+                error_handler (false, FUNC_NAME, errmsg);
+                break;
+            }
+            threads_created++;
+        }
+
+        /* Make sure at least one thread was started, otherwise validate the
+           files serially */
+        if (threads_created == 0)
+            validate_xml_files_worker (&pool);
+
+        /* Wait for the workers to drain the pool */
+        for (i = 0; i < threads_created; i++)
+            pthread_join (threads[i], NULL);
+    }
+    pthread_mutex_destroy (&pool.lock);
+
+    /* Report the overall results */
+    for (i = 0; i < nfiles; i++)
+    {
+        if (pool.file_status[i] != SUCCESS)
+            nfailed++;
+    }
+    free (pool.file_status);
+    xmlSchemaFree (pool.schema);
+
+    if (nfailed != 0)
+    {
+        sprintf (errmsg, "%d of %d metadata files failed to validate",
+            nfailed, nfiles);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Successful completion */
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  init_metadata_struct
+
+PURPOSE:  Initializes the ESPA internal metadata structure, particularly the
+pointers within each sub-structure.  Assigns field values to fill to make it
+easier to detect if the values were parsed from the input metadata file or
+assigned by the user.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+12/18/2013   Gail Schmidt     Original development
+5/7/2014     Gail Schmidt     Updated for modis tiles
+3/30/2015    Gail Schmidt     Updated for earth-sun distance
+8/31/2026    Gail Schmidt     Initialize the band-name hash fields
+8/31/2026    Gail Schmidt     Initialize the hot band descriptor fields
+
+NOTES:
+******************************************************************************/
+void init_metadata_struct
+(
+    Espa_internal_meta_t *internal_meta   /* I: pointer to internal metadata
+                                                structure to be initialized */
+)
+{
+    Espa_global_meta_t *gmeta = &internal_meta->global;
+                                 /* pointer to the global metadata structure */
+
+    /* Initialze the number of bands */
+    internal_meta->nbands = 0;
+    internal_meta->nbands_alloc = 0;
+    internal_meta->band = NULL;
+    internal_meta->band_hash = NULL;
+    internal_meta->band_hash_size = 0;
+    internal_meta->band_hash_nbands = 0;
+    internal_meta->band_hot = NULL;
+    internal_meta->band_hot_nbands = 0;
+    internal_meta->shared_proj = NULL;
+
+    /* Initialize the global metadata values to fill for use by the write
+       metadata routines */
+    strcpy (gmeta->data_provider, ESPA_STRING_META_FILL);
+    strcpy (gmeta->satellite, ESPA_STRING_META_FILL);
+    strcpy (gmeta->instrument, ESPA_STRING_META_FILL);
+    strcpy (gmeta->acquisition_date, ESPA_STRING_META_FILL);
+    strcpy (gmeta->scene_center_time, ESPA_STRING_META_FILL);
+    strcpy (gmeta->level1_production_date, ESPA_STRING_META_FILL);
+    gmeta->solar_zenith = ESPA_FLOAT_META_FILL;
+    gmeta->solar_azimuth = ESPA_FLOAT_META_FILL;
+    strcpy (gmeta->solar_units, ESPA_STRING_META_FILL);
+    gmeta->earth_sun_dist = ESPA_FLOAT_META_FILL;
+    gmeta->wrs_system = ESPA_INT_META_FILL;
+    gmeta->wrs_path = ESPA_INT_META_FILL;
+    gmeta->wrs_row = ESPA_INT_META_FILL;
+    gmeta->htile = ESPA_INT_META_FILL;
+    gmeta->vtile = ESPA_INT_META_FILL;
+    strcpy (gmeta->lpgs_metadata_file, ESPA_STRING_META_FILL);
+    gmeta->ul_corner[0] = gmeta->ul_corner[1] = ESPA_FLOAT_META_FILL;
+    gmeta->lr_corner[0] = gmeta->lr_corner[1] = ESPA_FLOAT_META_FILL;
+    gmeta->bounding_coords[0] = ESPA_FLOAT_META_FILL;
+    gmeta->bounding_coords[1] = ESPA_FLOAT_META_FILL;
+    gmeta->bounding_coords[2] = ESPA_FLOAT_META_FILL;
+    gmeta->bounding_coords[3] = ESPA_FLOAT_META_FILL;
+    gmeta->proj_info.proj_type = ESPA_INT_META_FILL;
+    gmeta->proj_info.datum_type = ESPA_NODATUM;
+    gmeta->orientation_angle = ESPA_FLOAT_META_FILL;
+}
+
+
+/******************************************************************************
+MODULE:  allocate_band_metadata
+
+PURPOSE:  Allocates memory in the ESPA internal metadata structure for nbands.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error allocating memory for the nbands
+SUCCESS         Successfully allocated memory
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+12/18/2013   Gail Schmidt     Original development
+2/25/2014    Gail Schmidt     Added support for source and category attributes
+                              for the band metadata
+3/30/2015    Gail Schmidt     Added support for Earth-Sun Distance, reflectance
+                              gain/bias, and K1/K2 constants. Changed
+                              toa_gain/bias to rad_gain/bias to be consistent
+                              with refl_gain/bias.
+
+
+NOTES:
+  1. Initializes the bitmap_description and class_values for each band to NULL
+     and sets the nbits and nclass to 0.
+******************************************************************************/
+int allocate_band_metadata
+(
+    Espa_internal_meta_t *internal_meta,  /* I: pointer to internal metadata
+                                                structure */
+    int nbands                            /* I: number of bands to allocate
+                                                for the band field in the
+                                                internal_meta */
+)
+{
+    /* Start from an empty band array and grow it to the requested size */
+    internal_meta->nbands = 0;
+    internal_meta->nbands_alloc = 0;
+    internal_meta->band = NULL;
+    return (reallocate_band_metadata (internal_meta, nbands));
+}
+
+
+/******************************************************************************
+MODULE:  reallocate_band_metadata
+
+PURPOSE:  Grows the band array in the ESPA internal metadata structure to
+nbands, initializing the newly-added bands and leaving any existing bands
+untouched.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error reallocating memory for the nbands
+SUCCESS         Successfully reallocated memory
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Grow the allocation geometrically and replicate
+                              a fill template band via memcpy instead of
+                              setting each field per band
+8/31/2026    Gail Schmidt     Invalidate the band-name hash when the band
+                              array changes
+8/31/2026    Gail Schmidt     Invalidate the hot band descriptors when the
+                              band array changes
+
+NOTES:
+  1. Initializes the bitmap_description and class_values for each new band to
+     NULL and sets the nbits and nclass to 0.
+  2. Supports the streaming XML parser and HDF readers, which do not know the
+     band count up front; the underlying allocation is grown geometrically so
+     appending one band at a time does not realloc the whole array per band.
+******************************************************************************/
+int reallocate_band_metadata
+(
+    Espa_internal_meta_t *internal_meta,  /* I: pointer to internal metadata
+                                                structure */
+    int nbands                            /* I: number of bands the band field
+                                                in the internal_meta should be
+                                                grown to */
+)
+{
+    char FUNC_NAME[] = "reallocate_band_metadata";   /* function name */
+    char errmsg[STR_SIZE];          /* error message */
+    Espa_band_meta_t *bmeta = NULL; /* pointer to array of bands metadata */
+    int i;                          /* looping variable */
+    int nalloc;                     /* new number of allocated bands */
+    static bool template_valid = false;   /* has the template band been
+                                             initialized */
+    static Espa_band_meta_t template_band;  /* fill-initialized band which is
+                                             replicated via memcpy for each
+                                             new band */
+
+    /* Build the fill template band once.  The nbits and nclass fields are 0
+       and the pointers NULL; the other fields are fill to make it easy to
+       distinguish if they were populated by reading an input metadata file
+       or assigned directly. */
+    if (!template_valid)
+    {
+        memset (&template_band, 0, sizeof (template_band));
+        template_band.nbits = 0;
+        template_band.bitmap_description = NULL;
+        template_band.nclass = 0;
+        template_band.class_values = NULL;
+        template_band.qa_desc = NULL;
+        template_band.qa_desc_size = 0;
+
+        strcpy (template_band.product, ESPA_STRING_META_FILL);
+        strcpy (template_band.source, ESPA_STRING_META_FILL);
+        strcpy (template_band.name, ESPA_STRING_META_FILL);
+        strcpy (template_band.category, ESPA_STRING_META_FILL);
+        template_band.data_type = ESPA_UINT8;
+        template_band.nlines = ESPA_INT_META_FILL;
+        template_band.nsamps = ESPA_INT_META_FILL;
+        template_band.fill_value = ESPA_INT_META_FILL;
+        template_band.saturate_value = ESPA_INT_META_FILL;
+        template_band.scale_factor = ESPA_FLOAT_META_FILL;
+        template_band.add_offset = ESPA_FLOAT_META_FILL;
+        template_band.resample_method = ESPA_NONE;
+        strcpy (template_band.short_name, ESPA_STRING_META_FILL);
+        strcpy (template_band.long_name, ESPA_STRING_META_FILL);
+        strcpy (template_band.file_name, ESPA_STRING_META_FILL);
+        template_band.pixel_size[0] = template_band.pixel_size[1] =
+            ESPA_FLOAT_META_FILL;
+        strcpy (template_band.pixel_units, ESPA_STRING_META_FILL);
+        strcpy (template_band.data_units, ESPA_STRING_META_FILL);
+        template_band.valid_range[0] = template_band.valid_range[1] =
+            ESPA_INT_META_FILL;
+        template_band.rad_gain = ESPA_FLOAT_META_FILL;
+        template_band.rad_bias = ESPA_FLOAT_META_FILL;
+        template_band.refl_gain = ESPA_FLOAT_META_FILL;
+        template_band.refl_bias = ESPA_FLOAT_META_FILL;
+        template_band.k1_const = ESPA_FLOAT_META_FILL;
+        template_band.k2_const = ESPA_FLOAT_META_FILL;
+        template_band.calibrated_nt = ESPA_FLOAT_META_FILL;
+        strcpy (template_band.checksum, ESPA_STRING_META_FILL);
+        template_band.byte_order = ESPA_INT_META_FILL;
+        template_band.stat_npixels = ESPA_INT_META_FILL;
+        template_band.stat_min = ESPA_FLOAT_META_FILL;
+        template_band.stat_max = ESPA_FLOAT_META_FILL;
+        template_band.stat_mean = ESPA_FLOAT_META_FILL;
+        /* stat_histogram is left all zeros from the memset */
+        strcpy (template_band.app_version, ESPA_STRING_META_FILL);
+        strcpy (template_band.production_date, ESPA_STRING_META_FILL);
+        template_valid = true;
+    }
+
+    /* Grow the underlying allocation geometrically if nbands doesn't fit,
+       so callers appending one band at a time don't realloc the whole array
+       for every band */
+    if (nbands > internal_meta->nbands_alloc)
+    {
+        nalloc = (internal_meta->nbands_alloc == 0) ? 8 :
+            internal_meta->nbands_alloc * 2;
+        if (nalloc < nbands)
+            nalloc = nbands;
+
+        bmeta = realloc (internal_meta->band,
+            nalloc * sizeof (Espa_band_meta_t));
+        if (bmeta == NULL)
+        {
+            sprintf (errmsg, "Reallocating ESPA band metadata for %d bands",
+                nalloc);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+        internal_meta->band = bmeta;
+        internal_meta->nbands_alloc = nalloc;
+    }
+
+    /* Replicate the fill template into each new band */
+    bmeta = internal_meta->band;
+    for (i = internal_meta->nbands; i < nbands; i++)
+        memcpy (&bmeta[i], &template_band, sizeof (template_band));
+    internal_meta->nbands = nbands;
+
+    /* Invalidate the band-name hash; find_band_index rebuilds it lazily
+       over the grown band array */
+    free (internal_meta->band_hash);
+    internal_meta->band_hash = NULL;
+    internal_meta->band_hash_size = 0;
+    internal_meta->band_hash_nbands = 0;
+
+    /* Invalidate the hot band descriptors; get_band_hot rebuilds them
+       lazily over the grown band array */
+    free (internal_meta->band_hot);
+    internal_meta->band_hot = NULL;
+    internal_meta->band_hot_nbands = 0;
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  espa_name_hash
+
+PURPOSE:  Hashes a metadata string for the band-name hash and the hot band
+descriptors.
+
+RETURN VALUE:
+Type = unsigned int
+Value           Description
+-----           -----------
+hash            Hash of the string
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Strings hashing differently never compare equal, so a scan can skip
+     the string compare on a hash mismatch; a hash match must still be
+     confirmed with a string compare.
+******************************************************************************/
+unsigned int espa_name_hash
+(
+    const char *name                 /* I: string to be hashed */
+)
+{
+    const unsigned char *c_ptr;   /* pointer for hashing the string */
+    unsigned int hash = 5381;     /* hash being accumulated */
+
+    for (c_ptr = (const unsigned char *) name; *c_ptr != '\0'; c_ptr++)
+        hash = hash * 33 + *c_ptr;
+
+    return (hash);
+}
+
+
+/******************************************************************************
+MODULE:  find_band_index
+
+PURPOSE:  Looks a band up by name in the ESPA internal metadata structure.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+-1              Band name not found in the metadata structure
+>= 0            Index of the named band in the band array
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. A hash index of the band names is built lazily on the first lookup and
+     kept on the metadata structure, so repeated lookups cost one probe
+     instead of a strcmp scan over the band array.  The index is rebuilt
+     automatically after bands are appended.
+  2. If a band name appears more than once the lowest band index is
+     returned, matching a forward scan over the band array.
+  3. Falls back to the linear scan if the hash cannot be allocated.
+******************************************************************************/
+int find_band_index
+(
+    Espa_internal_meta_t *metadata,  /* I: metadata structure to search */
+    const char *band_name            /* I: name of the band to look up */
+)
+{
+    unsigned int hash;            /* hash of the band name */
+    int i;                        /* looping variable */
+    int slot;                     /* current slot in the hash probe */
+
+    if (metadata->nbands <= 0)
+        return (-1);
+
+    /* (Re)build the hash if it is missing or the band count changed since
+       it was built */
+    if (metadata->band_hash == NULL ||
+        metadata->band_hash_nbands != metadata->nbands)
+    {
+        free (metadata->band_hash);
+        metadata->band_hash_size = 16;
+        while (metadata->band_hash_size < 2 * metadata->nbands)
+            metadata->band_hash_size *= 2;
+        metadata->band_hash = calloc (metadata->band_hash_size,
+            sizeof (int));
+        if (metadata->band_hash == NULL)
+        {  /* Fall back to the linear scan */
+            metadata->band_hash_size = 0;
+            metadata->band_hash_nbands = 0;
+            for (i = 0; i < metadata->nbands; i++)
+            {
+                if (!strcmp (metadata->band[i].name, band_name))
+                    return (i);
+            }
+            return (-1);
+        }
+
+        /* Insert the bands in order with linear probing, so a duplicated
+           name is found in band array order on lookup */
+        for (i = 0; i < metadata->nbands; i++)
+        {
+            hash = espa_name_hash (metadata->band[i].name);
+            slot = hash & (metadata->band_hash_size - 1);
+            while (metadata->band_hash[slot] != 0)
+                slot = (slot + 1) & (metadata->band_hash_size - 1);
+            metadata->band_hash[slot] = i + 1;
+        }
+        metadata->band_hash_nbands = metadata->nbands;
+    }
+
+    /* Probe for the name; an empty slot means the name is not present */
+    hash = espa_name_hash (band_name);
+    slot = hash & (metadata->band_hash_size - 1);
+    while (metadata->band_hash[slot] != 0)
+    {
+        i = metadata->band_hash[slot] - 1;
+        if (!strcmp (metadata->band[i].name, band_name))
+            return (i);
+        slot = (slot + 1) & (metadata->band_hash_size - 1);
+    }
+
+    return (-1);
+}
+
+
+/******************************************************************************
+MODULE:  get_band_hot
+
+PURPOSE:  Returns the compact per-band descriptors for the metadata
+structure, building them on the first call.
+
+RETURN VALUE:
+Type = const Espa_band_hot_t *
+Value           Description
+-----           -----------
+NULL            Descriptors could not be allocated or there are no bands
+non-NULL        Array of nbands descriptors, one per band
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The descriptors pack the fields the iteration-heavy scan loops read
+     (name and product hashes, data type, band dimensions, fill value) into
+     one cache line per band, so scanning a large band list doesn't pull
+     every full band structure through the cache between the pixel loops.
+  2. The descriptors are kept on the metadata structure and rebuilt
+     automatically after bands are appended or pruned.  Callers receiving
+     NULL should fall back to scanning the full band structures.
+  3. The descriptors are a read-only snapshot; a caller editing the band
+     metadata in place should not hold them across the edit.
+******************************************************************************/
+const Espa_band_hot_t *get_band_hot
+(
+    Espa_internal_meta_t *metadata   /* I: metadata structure whose compact
+                                           band descriptors are wanted */
+)
+{
+    int i;                        /* looping variable */
+    Espa_band_hot_t *hot;         /* descriptor array being built */
+
+    if (metadata->nbands <= 0)
+        return (NULL);
+
+    /* Rebuild the descriptors if they are missing or the band count changed
+       since they were built */
+    if (metadata->band_hot == NULL ||
+        metadata->band_hot_nbands != metadata->nbands)
+    {
+        free (metadata->band_hot);
+        metadata->band_hot = malloc (metadata->nbands *
+            sizeof (Espa_band_hot_t));
+        if (metadata->band_hot == NULL)
+        {
+            metadata->band_hot_nbands = 0;
+            return (NULL);
+        }
+
+        hot = metadata->band_hot;
+        for (i = 0; i < metadata->nbands; i++)
+        {
+            hot[i].name_hash = espa_name_hash (metadata->band[i].name);
+            hot[i].product_hash = espa_name_hash (metadata->band[i].product);
+            hot[i].data_type = metadata->band[i].data_type;
+            hot[i].nlines = metadata->band[i].nlines;
+            hot[i].nsamps = metadata->band[i].nsamps;
+            hot[i].band_index = i;
+            hot[i].fill_value = metadata->band[i].fill_value;
+        }
+        metadata->band_hot_nbands = metadata->nbands;
+    }
+
+    return (metadata->band_hot);
+}
+
+
+/******************************************************************************
+MODULE:  allocate_class_metadata
+
+PURPOSE:  Allocates memory in the ESPA band metadata structure for nclasses.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error allocating memory for nclasses
+SUCCESS         Successfully allocated memory
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+12/18/2013   Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+int allocate_class_metadata
+(
+    Espa_band_meta_t *band_meta,  /* I: pointer to band metadata structure */
+    int nclass                    /* I: number of classes to allocate for the
+                                        band metadata */
+)
+{
+    char FUNC_NAME[] = "allocate_class_metadata";   /* function name */
+    char errmsg[STR_SIZE];        /* error message */
+
+    /* Allocate the number of classes to nclass and the associated class_values
+       pointer */
+    band_meta->nclass = nclass;
+    band_meta->class_values = calloc (nclass, sizeof (Espa_class_t));
+    if (band_meta->class_values == NULL)
+    {
+        sprintf (errmsg, "Allocating ESPA band metadata for %d nclasses",
+            nclass);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  allocate_bitmap_metadata
+
+PURPOSE:  Allocates memory in the ESPA band metadata structure for nbits.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error allocating memory for nbits
+SUCCESS         Successfully allocated memory
 
 HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
-12/13/2013   Gail Schmidt     Original development
-8/5/2014     Gail Schmidt     Obtain the location of the ESPA schema file from
-                              an environment variable vs. the ESPA http site
+12/18/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Back the descriptions with a single slab
 
 NOTES:
 ******************************************************************************/
-int validate_xml_file
+int allocate_bitmap_metadata
 (
-    char *meta_file           /* I: name of metadata file to be validated */
+    Espa_band_meta_t *band_meta,  /* I: pointer to band metadata structure */
+    int nbits                     /* I: number of bits to allocate for the
+                                        bitmap metadata */
 )
 {
-    char FUNC_NAME[] = "validate_xml_file";   /* function name */
+    char FUNC_NAME[] = "allocate_bitmap_metadata";   /* function name */
     char errmsg[STR_SIZE];        /* error message */
-    char *schema_file = NULL;     /* name of schema file or URL to be validated
-                                     against */
-    int status;                   /* return status */
-    xmlDocPtr doc = NULL;         /* resulting document tree */
-    xmlSchemaPtr schema = NULL;   /* pointer to the schema */
-    xmlSchemaParserCtxtPtr ctxt = NULL;  /* parser context for the schema */
-    xmlSchemaValidCtxtPtr valid_ctxt = NULL;  /* pointer to validate from the
-                                                 schema */
-    struct stat statbuf;          /* buffer for the file stat function */
-
-    /* Get the ESPA schema environment variable which specifies the location
-       of the XML schema to be used */
-    schema_file = getenv ("ESPA_SCHEMA");
-    if (schema_file == NULL)
-    {  /* ESPA schema environment variable wasn't defined. Try the version in
-          /usr/local... */
-        schema_file = LOCAL_ESPA_SCHEMA;
-        if (stat (schema_file, &statbuf) == -1)
-        {  /* /usr/local ESPA schema file doesn't exist.  Try the version on
-              the ESPA http site... */
-            schema_file = ESPA_SCHEMA;
-        }
-    }
-    printf ("Validating %s metadata file with %s ...\n", meta_file,
-        schema_file);
-
-    /* Set up the schema parser and parse the schema file/URL */
-    xmlLineNumbersDefault (1);
-    ctxt = xmlSchemaNewParserCtxt (schema_file);
-    xmlSchemaSetParserErrors (ctxt, (xmlSchemaValidityErrorFunc) fprintf,
-        (xmlSchemaValidityWarningFunc) fprintf, stderr);
-    schema = xmlSchemaParse (ctxt);
-
-    /* Free the schema parser context */
-    xmlSchemaFreeParserCtxt (ctxt);
+    int i;                        /* looping variable */
 
-    /* Load the XML file and parse it to the document tree */
-    doc = xmlReadFile (meta_file, NULL, 0);
-    if (doc == NULL)
+    /* Allocate the number of bits to nbits and the associated bitmap pointer.
+       The descriptions live in a single slab behind the pointer array, so a
+       16-bit QA band costs two allocations instead of seventeen. */
+    band_meta->nbits = nbits;
+    band_meta->bitmap_description = calloc (nbits, sizeof (char *));
+    if (band_meta->bitmap_description == NULL)
     {
-        sprintf (errmsg, "Could not parse %s", meta_file);
-        error_handler (true, FUNC_NAME, errmsg);
-        sprintf (errmsg, "Possible schema file not found.  ESPA_SCHEMA "
-            "environment variable isn't defined.  The first default schema "
-            "location of %s doesn't exist.  And the second default location of "
-            "%s was used as the last default.", LOCAL_ESPA_SCHEMA, ESPA_SCHEMA);
+        sprintf (errmsg, "Allocating ESPA bitmap description");
         error_handler (true, FUNC_NAME, errmsg);
         return (ERROR);
     }
 
-    /* Identify the schema file as the validation source */
-    valid_ctxt = xmlSchemaNewValidCtxt (schema);
-    xmlSchemaSetValidErrors (valid_ctxt, (xmlSchemaValidityErrorFunc) fprintf,
-        (xmlSchemaValidityWarningFunc) fprintf, stderr);
-
-    /* Validate the XML metadata against the schema */
-    status = xmlSchemaValidateDoc (valid_ctxt, doc);
-    if (status > 0)
+    band_meta->bitmap_description[0] = calloc (nbits, STR_SIZE);
+    if (band_meta->bitmap_description[0] == NULL)
     {
-        sprintf (errmsg, "%s fails to validate", meta_file);
-        error_handler (true, FUNC_NAME, errmsg);
-        return (ERROR);
-    }
-    else if (status != 0)
-    {
-        sprintf (errmsg, "%s validation generated an internal error",
-            meta_file);
+        sprintf (errmsg, "Allocating ESPA band metadata for %d nbits",
+            nbits);
         error_handler (true, FUNC_NAME, errmsg);
         return (ERROR);
     }
+    for (i = 1; i < nbits; i++)
+        band_meta->bitmap_description[i] =
+            band_meta->bitmap_description[0] + (size_t) i * STR_SIZE;
 
-    /* Free the resources and clean up the memory */
-    xmlSchemaFreeValidCtxt (valid_ctxt);
-    xmlFreeDoc (doc);
-    if (schema != NULL)
-        xmlSchemaFree (schema);
-    xmlSchemaCleanupTypes();
-    xmlCleanupParser();   /* cleanup the XML library */
-    xmlMemoryDump();      /* for debugging */
-
-    /* Successful completion */
     return (SUCCESS);
 }
 
 
+/* One interned bitmap description set, shared by the bands whose QA
+   schemas are identical */
+typedef struct espa_bitmap_intern
+{
+    char **bitmap_description;    /* shared pointer array and slab */
+    int nbits;                    /* number of bits in the set */
+    int refcount;                 /* number of bands referencing the set */
+    struct espa_bitmap_intern *next;  /* next interned set */
+} Espa_bitmap_intern_t;
+
+/* Interned bitmap description sets of the process; QA-heavy products
+   carry dozens of identical sets, so the list stays short */
+static Espa_bitmap_intern_t *bitmap_intern_list = NULL;
+
+/* Serializes the intern pool across the scene worker threads */
+static pthread_mutex_t bitmap_intern_lock = PTHREAD_MUTEX_INITIALIZER;
+
+
 /******************************************************************************
-MODULE:  init_metadata_struct
+MODULE:  find_bitmap_intern (static)
 
-PURPOSE:  Initializes the ESPA internal metadata structure, particularly the
-pointers within each sub-structure.  Assigns field values to fill to make it
-easier to detect if the values were parsed from the input metadata file or
-assigned by the user.
+PURPOSE:  Finds the interned set a band's bitmap descriptions reference, or
+the interned set whose contents match them.
 
 RETURN VALUE:
-Type = None
+Type = Espa_bitmap_intern_t *
+Value           Description
+-----           -----------
+NULL            No interned set references or matches the band's
+(pointer)       The interned set
 
 HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
-12/18/2013   Gail Schmidt     Original development
-5/7/2014     Gail Schmidt     Updated for modis tiles
-3/30/2015    Gail Schmidt     Updated for earth-sun distance
+8/31/2026    Gail Schmidt     Original development
 
 NOTES:
+  1. The caller holds the intern pool lock.
 ******************************************************************************/
-void init_metadata_struct
+static Espa_bitmap_intern_t *find_bitmap_intern
 (
-    Espa_internal_meta_t *internal_meta   /* I: pointer to internal metadata
-                                                structure to be initialized */
+    Espa_band_meta_t *band_meta,  /* I: band whose set is to be found */
+    int by_content                /* I: also match sets with equal contents,
+                                        not just the referenced set? */
 )
 {
-    Espa_global_meta_t *gmeta = &internal_meta->global;
-                                 /* pointer to the global metadata structure */
+    Espa_bitmap_intern_t *entry;  /* current interned set */
+    int i;                        /* looping variable for the bits */
 
-    /* Initialze the number of bands */
-    internal_meta->nbands = 0;
-    internal_meta->band = NULL;
+    for (entry = bitmap_intern_list; entry != NULL; entry = entry->next)
+    {
+        if (entry->bitmap_description == band_meta->bitmap_description)
+            return (entry);
 
-    /* Initialize the global metadata values to fill for use by the write
-       metadata routines */
-    strcpy (gmeta->data_provider, ESPA_STRING_META_FILL);
-    strcpy (gmeta->satellite, ESPA_STRING_META_FILL);
-    strcpy (gmeta->instrument, ESPA_STRING_META_FILL);
-    strcpy (gmeta->acquisition_date, ESPA_STRING_META_FILL);
-    strcpy (gmeta->scene_center_time, ESPA_STRING_META_FILL);
-    strcpy (gmeta->level1_production_date, ESPA_STRING_META_FILL);
-    gmeta->solar_zenith = ESPA_FLOAT_META_FILL;
-    gmeta->solar_azimuth = ESPA_FLOAT_META_FILL;
-    strcpy (gmeta->solar_units, ESPA_STRING_META_FILL);
-    gmeta->earth_sun_dist = ESPA_FLOAT_META_FILL;
-    gmeta->wrs_system = ESPA_INT_META_FILL;
-    gmeta->wrs_path = ESPA_INT_META_FILL;
-    gmeta->wrs_row = ESPA_INT_META_FILL;
-    gmeta->htile = ESPA_INT_META_FILL;
-    gmeta->vtile = ESPA_INT_META_FILL;
-    strcpy (gmeta->lpgs_metadata_file, ESPA_STRING_META_FILL);
-    gmeta->ul_corner[0] = gmeta->ul_corner[1] = ESPA_FLOAT_META_FILL;
-    gmeta->lr_corner[0] = gmeta->lr_corner[1] = ESPA_FLOAT_META_FILL;
-    gmeta->bounding_coords[0] = ESPA_FLOAT_META_FILL;
-    gmeta->bounding_coords[1] = ESPA_FLOAT_META_FILL;
-    gmeta->bounding_coords[2] = ESPA_FLOAT_META_FILL;
-    gmeta->bounding_coords[3] = ESPA_FLOAT_META_FILL;
-    gmeta->proj_info.proj_type = ESPA_INT_META_FILL;
-    gmeta->proj_info.datum_type = ESPA_NODATUM;
-    gmeta->orientation_angle = ESPA_FLOAT_META_FILL;
+        if (!by_content || entry->nbits != band_meta->nbits)
+            continue;
+
+        for (i = 0; i < entry->nbits; i++)
+        {
+            if (strcmp (entry->bitmap_description[i],
+                band_meta->bitmap_description[i]) != 0)
+                break;
+        }
+        if (i == entry->nbits)
+            return (entry);
+    }
+
+    return (NULL);
 }
 
 
 /******************************************************************************
-MODULE:  allocate_band_metadata
+MODULE:  intern_bitmap_metadata
 
-PURPOSE:  Allocates memory in the ESPA internal metadata structure for nbands.
+PURPOSE:  Moves a band's bitmap descriptions into the process intern pool,
+sharing one refcounted copy among the bands whose sets are identical.
 
 RETURN VALUE:
 Type = int
 Value           Description
 -----           -----------
-ERROR           Error allocating memory for the nbands
-SUCCESS         Successfully allocated memory
+ERROR           Error interning the set
+SUCCESS         The band references an interned set (or has no bitmap)
 
 HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
-12/18/2013   Gail Schmidt     Original development
-2/25/2014    Gail Schmidt     Added support for source and category attributes
-                              for the band metadata
-3/30/2015    Gail Schmidt     Added support for Earth-Sun Distance, reflectance
-                              gain/bias, and K1/K2 constants. Changed
-                              toa_gain/bias to rad_gain/bias to be consistent
-                              with refl_gain/bias.
-
+8/31/2026    Gail Schmidt     Original development
 
 NOTES:
-  1. Initializes the bitmap_description and class_values for each band to NULL
-     and sets the nbits and nclass to 0.
+  1. The parse and copy paths intern each band's set once it is fully
+     populated; the descriptions must not be modified afterwards since
+     other bands may share them.
 ******************************************************************************/
-int allocate_band_metadata
+int intern_bitmap_metadata
 (
-    Espa_internal_meta_t *internal_meta,  /* I: pointer to internal metadata
-                                                structure */
-    int nbands                            /* I: number of bands to allocate
-                                                for the band field in the
-                                                internal_meta */
+    Espa_band_meta_t *band_meta   /* I/O: band whose bitmap descriptions are
+                                        to be interned */
 )
 {
-    char FUNC_NAME[] = "allocate_band_metadata";   /* function name */
-    char errmsg[STR_SIZE];          /* error message */
-    Espa_band_meta_t *bmeta = NULL; /* pointer to array of bands metadata */
-    int i;                          /* looping variable */
+    char FUNC_NAME[] = "intern_bitmap_metadata";   /* function name */
+    char errmsg[STR_SIZE];        /* error message */
+    Espa_bitmap_intern_t *entry;  /* matching or new interned set */
 
-    /* Allocate the number of bands to nbands and the associated pointers */
-    internal_meta->nbands = nbands;
-    internal_meta->band = calloc (nbands, sizeof (Espa_band_meta_t));
-    if (internal_meta->band == NULL)
+    if (band_meta->nbits <= 0 || band_meta->bitmap_description == NULL)
+        return (SUCCESS);
+
+    pthread_mutex_lock (&bitmap_intern_lock);
+    entry = find_bitmap_intern (band_meta, 1);
+    if (entry != NULL)
     {
-        sprintf (errmsg, "Allocating ESPA band metadata for %d bands", nbands);
-        error_handler (true, FUNC_NAME, errmsg);
-        return (ERROR);
+        /* Share the existing set, releasing the band's private copy when
+           it holds one */
+        if (entry->bitmap_description != band_meta->bitmap_description)
+        {
+            free (band_meta->bitmap_description[0]);
+            free (band_meta->bitmap_description);
+            band_meta->bitmap_description = entry->bitmap_description;
+            entry->refcount++;
+        }
+        pthread_mutex_unlock (&bitmap_intern_lock);
+        return (SUCCESS);
     }
-    bmeta = internal_meta->band;
 
-    /* Set the nbits and nclass fields in the band metadata to 0 for each band
-       and initialize the pointers to NULL.  Initialize the other fields to
-       fill to make it easy to distinguish if they were populated by reading
-       an input metadata file or assigned directly. */
-    for (i = 0; i < nbands; i++)
-    {
-        bmeta[i].nbits = 0;
-        bmeta[i].bitmap_description = NULL;
-        bmeta[i].nclass = 0;
-        bmeta[i].class_values = NULL;
-
-        strcpy (bmeta[i].product, ESPA_STRING_META_FILL);
-        strcpy (bmeta[i].source, ESPA_STRING_META_FILL);
-        strcpy (bmeta[i].name, ESPA_STRING_META_FILL);
-        strcpy (bmeta[i].category, ESPA_STRING_META_FILL);
-        bmeta[i].data_type = ESPA_UINT8;
-        bmeta[i].nlines = ESPA_INT_META_FILL;
-        bmeta[i].nsamps = ESPA_INT_META_FILL;
-        bmeta[i].fill_value = ESPA_INT_META_FILL;
-        bmeta[i].saturate_value = ESPA_INT_META_FILL;
-        bmeta[i].scale_factor = ESPA_FLOAT_META_FILL;
-        bmeta[i].add_offset = ESPA_FLOAT_META_FILL;
-        bmeta[i].resample_method = ESPA_NONE;
-        strcpy (bmeta[i].short_name, ESPA_STRING_META_FILL);
-        strcpy (bmeta[i].long_name, ESPA_STRING_META_FILL);
-        strcpy (bmeta[i].file_name, ESPA_STRING_META_FILL);
-        bmeta[i].pixel_size[0] = bmeta[i].pixel_size[1] = ESPA_FLOAT_META_FILL;
-        strcpy (bmeta[i].pixel_units, ESPA_STRING_META_FILL);
-        strcpy (bmeta[i].data_units, ESPA_STRING_META_FILL);
-        bmeta[i].valid_range[0] = bmeta[i].valid_range[1] = ESPA_INT_META_FILL;
-        bmeta[i].rad_gain = ESPA_FLOAT_META_FILL;
-        bmeta[i].rad_bias = ESPA_FLOAT_META_FILL;
-        bmeta[i].refl_gain = ESPA_FLOAT_META_FILL;
-        bmeta[i].refl_bias = ESPA_FLOAT_META_FILL;
-        bmeta[i].k1_const = ESPA_FLOAT_META_FILL;
-        bmeta[i].k2_const = ESPA_FLOAT_META_FILL;
-        bmeta[i].calibrated_nt = ESPA_FLOAT_META_FILL;
-        strcpy (bmeta[i].qa_desc, ESPA_STRING_META_FILL);
-        strcpy (bmeta[i].app_version, ESPA_STRING_META_FILL);
-        strcpy (bmeta[i].production_date, ESPA_STRING_META_FILL);
+    /* First band with this schema; the pool takes ownership of the band's
+       arrays */
+    entry = malloc (sizeof (Espa_bitmap_intern_t));
+    if (entry == NULL)
+    {
+        pthread_mutex_unlock (&bitmap_intern_lock);
+        sprintf (errmsg, "Allocating the interned bitmap description set");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
     }
+    entry->bitmap_description = band_meta->bitmap_description;
+    entry->nbits = band_meta->nbits;
+    entry->refcount = 1;
+    entry->next = bitmap_intern_list;
+    bitmap_intern_list = entry;
+    pthread_mutex_unlock (&bitmap_intern_lock);
 
     return (SUCCESS);
 }
 
 
 /******************************************************************************
-MODULE:  allocate_class_metadata
+MODULE:  share_bitmap_metadata
 
-PURPOSE:  Allocates memory in the ESPA band metadata structure for nclasses.
+PURPOSE:  Points a destination band at the source band's interned bitmap
+descriptions instead of copying them, interning the source set first if it
+is still private.
 
 RETURN VALUE:
 Type = int
 Value           Description
 -----           -----------
-ERROR           Error allocating memory for nclasses
-SUCCESS         Successfully allocated memory
+ERROR           Error sharing the set
+SUCCESS         The destination band references the shared set
 
 HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
-12/18/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Original development
 
 NOTES:
+  1. The destination band must not hold a bitmap allocation of its own.
 ******************************************************************************/
-int allocate_class_metadata
+int share_bitmap_metadata
 (
-    Espa_band_meta_t *band_meta,  /* I: pointer to band metadata structure */
-    int nclass                    /* I: number of classes to allocate for the
-                                        band metadata */
+    Espa_band_meta_t *out_meta,   /* I/O: band to reference the shared set */
+    Espa_band_meta_t *in_meta     /* I/O: band whose set is to be shared; its
+                                        private copy is interned */
 )
 {
-    char FUNC_NAME[] = "allocate_class_metadata";   /* function name */
+    char FUNC_NAME[] = "share_bitmap_metadata";   /* function name */
     char errmsg[STR_SIZE];        /* error message */
+    Espa_bitmap_intern_t *entry;  /* interned set of the source band */
 
-    /* Allocate the number of classes to nclass and the associated class_values
-       pointer */
-    band_meta->nclass = nclass;
-    band_meta->class_values = calloc (nclass, sizeof (Espa_class_t));
-    if (band_meta->class_values == NULL)
+    out_meta->nbits = in_meta->nbits;
+    out_meta->bitmap_description = NULL;
+    if (in_meta->nbits <= 0 || in_meta->bitmap_description == NULL)
+        return (SUCCESS);
+
+    if (intern_bitmap_metadata (in_meta) != SUCCESS)
+    {  /* Error messages already printed */
+        return (ERROR);
+    }
+
+    pthread_mutex_lock (&bitmap_intern_lock);
+    entry = find_bitmap_intern (in_meta, 0);
+    if (entry == NULL)
     {
-        sprintf (errmsg, "Allocating ESPA band metadata for %d nclasses",
-            nclass);
+        pthread_mutex_unlock (&bitmap_intern_lock);
+        sprintf (errmsg, "The source band's bitmap set is not interned");
         error_handler (true, FUNC_NAME, errmsg);
         return (ERROR);
     }
+    entry->refcount++;
+    out_meta->bitmap_description = entry->bitmap_description;
+    pthread_mutex_unlock (&bitmap_intern_lock);
 
     return (SUCCESS);
 }
 
 
 /******************************************************************************
-MODULE:  allocate_bitmap_metadata
+MODULE:  free_bitmap_metadata
 
-PURPOSE:  Allocates memory in the ESPA band metadata structure for nbits.
+PURPOSE:  Releases a band's bitmap descriptions: an interned set drops a
+reference (and is freed with its last one), a private set is freed outright.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void free_bitmap_metadata
+(
+    Espa_band_meta_t *band_meta   /* I/O: band whose bitmap descriptions are
+                                        to be released */
+)
+{
+    Espa_bitmap_intern_t *entry;  /* interned set of the band */
+    Espa_bitmap_intern_t **prev;  /* link to unchain a dying set from */
+
+    if (band_meta->nbits <= 0 || band_meta->bitmap_description == NULL)
+        return;
+
+    pthread_mutex_lock (&bitmap_intern_lock);
+    entry = find_bitmap_intern (band_meta, 0);
+    if (entry != NULL)
+    {
+        if (--entry->refcount == 0)
+        {
+            for (prev = &bitmap_intern_list; *prev != entry;
+                 prev = &(*prev)->next)
+                ;
+            *prev = entry->next;
+            free (entry->bitmap_description[0]);
+            free (entry->bitmap_description);
+            free (entry);
+        }
+        pthread_mutex_unlock (&bitmap_intern_lock);
+    }
+    else
+    {
+        pthread_mutex_unlock (&bitmap_intern_lock);
+        free (band_meta->bitmap_description[0]);
+        free (band_meta->bitmap_description);
+    }
+
+    band_meta->bitmap_description = NULL;
+}
+
+
+/******************************************************************************
+MODULE:  set_band_qa_desc
+
+PURPOSE:  Stores a QA description in the band metadata, lazily allocating
+the heap string which backs it.  The allocation is reused in place when the
+new description fits, and only grown when it doesn't.
 
 RETURN VALUE:
 Type = int
 Value           Description
 -----           -----------
-ERROR           Error allocating memory for nbits
-SUCCESS         Successfully allocated memory
+ERROR           Error allocating memory for the description
+SUCCESS         Description was stored (or dropped for fill)
 
 HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
-12/18/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Original development
 
 NOTES:
+  1. Only the QA bands carry a description, so the non-QA bands never pay
+     for the allocation; a NULL string (and the string fill value) reads
+     back as the fill value through get_band_qa_desc.
 ******************************************************************************/
-int allocate_bitmap_metadata
+int set_band_qa_desc
 (
-    Espa_band_meta_t *band_meta,  /* I: pointer to band metadata structure */
-    int nbits                     /* I: number of bits to allocate for the
-                                        bitmap metadata */
+    Espa_band_meta_t *band_meta,  /* I/O: band whose QA description is to be
+                                        set */
+    const char *qa_desc           /* I: QA description to store; NULL or the
+                                        string fill value drops the band's
+                                        description */
 )
 {
-    char FUNC_NAME[] = "allocate_bitmap_metadata";   /* function name */
+    char FUNC_NAME[] = "set_band_qa_desc";   /* function name */
     char errmsg[STR_SIZE];        /* error message */
-    int i;                        /* looping variable */
+    char *str = NULL;             /* grown description string */
+    size_t len;                   /* length of the description with the
+                                     terminator */
 
-    /* Allocate the number of bits to nbits and the associated bitmap pointer */
-    band_meta->nbits = nbits;
-    band_meta->bitmap_description = calloc (nbits, sizeof (char *));
-    if (band_meta->bitmap_description == NULL)
+    /* Fill (or no value) means the band has no QA description; release the
+       string so the band costs nothing again */
+    if (qa_desc == NULL || !strcmp (qa_desc, ESPA_STRING_META_FILL))
     {
-        sprintf (errmsg, "Allocating ESPA bitmap description");
-        error_handler (true, FUNC_NAME, errmsg);
-        return (ERROR);
+        free (band_meta->qa_desc);
+        band_meta->qa_desc = NULL;
+        band_meta->qa_desc_size = 0;
+        return (SUCCESS);
     }
 
-    for (i = 0; i < nbits; i++)
+    /* Grow the string only when the description doesn't fit the current
+       allocation */
+    len = strlen (qa_desc) + 1;
+    if (band_meta->qa_desc == NULL || (int) len > band_meta->qa_desc_size)
     {
-        band_meta->bitmap_description[i] = calloc (STR_SIZE, sizeof (char));
-        if (band_meta->bitmap_description[i] == NULL)
+        str = realloc (band_meta->qa_desc, len);
+        if (str == NULL)
         {
-            sprintf (errmsg, "Allocating ESPA band metadata for %d nbits",
-                nbits);
+            sprintf (errmsg, "Allocating %lu bytes for the band QA "
+                "description", (unsigned long) len);
             error_handler (true, FUNC_NAME, errmsg);
             return (ERROR);
         }
+        band_meta->qa_desc = str;
+        band_meta->qa_desc_size = (int) len;
     }
 
+    memcpy (band_meta->qa_desc, qa_desc, len);
     return (SUCCESS);
 }
 
 
+/******************************************************************************
+MODULE:  get_band_qa_desc
+
+PURPOSE:  Returns the QA description of the band, or the string fill value
+for the bands which don't carry one.
+
+RETURN VALUE:
+Type = const char *
+Value           Description
+-----           -----------
+(string)        QA description, or the string fill value
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+const char *get_band_qa_desc
+(
+    const Espa_band_meta_t *band_meta  /* I: band whose QA description is to
+                                        be read */
+)
+{
+    if (band_meta->qa_desc == NULL)
+        return (ESPA_STRING_META_FILL);
+    return (band_meta->qa_desc);
+}
+
+
 /******************************************************************************
 MODULE:  free_metadata
 
@@ -411,6 +1733,11 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 12/19/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Free the band-name hash
+8/31/2026    Gail Schmidt     Free the hot band descriptors
+8/31/2026    Gail Schmidt     Release the bitmap descriptions through the
+                              intern pool
+8/31/2026    Gail Schmidt     Free the lazily-allocated QA descriptions
 
 NOTES:
 ******************************************************************************/
@@ -420,24 +1747,36 @@ void free_metadata
                                                 structure */
 )
 {
-    int i, b;                      /* looping variables */
+    int i;                         /* looping variable */
 
     /* Free the pointers in the band metadata */
     for (i = 0; i < internal_meta->nbands; i++)
     {
-        if (internal_meta->band[i].nbits > 0)
-        {
-            for (b = 0; b < internal_meta->band[i].nbits; b++)
-                free (internal_meta->band[i].bitmap_description[b]);
-            free (internal_meta->band[i].bitmap_description);
-        }
+        free_bitmap_metadata (&internal_meta->band[i]);
 
         free (internal_meta->band[i].class_values);
+
+        free (internal_meta->band[i].qa_desc);
     }
 
     /* Free the band pointer itself */
     if (internal_meta->band)
         free (internal_meta->band);
+
+    /* Free the band-name hash if one was built */
+    free (internal_meta->band_hash);
+    internal_meta->band_hash = NULL;
+    internal_meta->band_hash_size = 0;
+    internal_meta->band_hash_nbands = 0;
+
+    /* Free the hot band descriptors if they were built */
+    free (internal_meta->band_hot);
+    internal_meta->band_hot = NULL;
+    internal_meta->band_hot_nbands = 0;
+
+    /* The shared projection copy lives in the intern segment, not in this
+       structure; just drop the reference */
+    internal_meta->shared_proj = NULL;
 }
 
 
@@ -17,6 +17,18 @@ Date         Programmer       Reason
 3/30/2015    Gail Schmidt     Updated to support reflectance gain/bias, thermal
                               constants, and earth sun distance and a version
                               change of schema to v1.2
+8/31/2026    Gail Schmidt     Added the per-band statistics fields (min, max,
+                              mean, histogram)
+8/31/2026    Gail Schmidt     Added the bulk XML validator
+8/31/2026    Gail Schmidt     Reference the interned projection metadata
+                              when the shared segment is in use
+8/31/2026    Gail Schmidt     Intern the bitmap descriptions so identical
+                              QA schemas share one refcounted set
+8/31/2026    Gail Schmidt     Added the compact hot band descriptors for the
+                              iteration-heavy metadata scans
+8/31/2026    Gail Schmidt     Moved the QA description to a lazily-allocated
+                              heap string so the non-QA bands don't carry
+                              the HUGE_STR_SIZE array
 
 NOTES:
 *****************************************************************************/
@@ -73,6 +85,9 @@ enum Espa_geographic_type
 #define ESPA_STRING_META_FILL "undefined"
 #define ESPA_EPSILON 0.00001
 
+/* number of bins in the per-band statistics histogram */
+#define ESPA_STAT_HIST_BINS 256
+
 /* Structures to support the global and band metadata information stored in
    the ESPA internal metadata file */
 typedef struct
@@ -186,21 +201,81 @@ typedef struct
                                     inclusive from 0 to nbits-1 */
     int nclass;                  /* number of classes in class_values */
     Espa_class_t *class_values;  /* support class value descriptions */
-    char qa_desc[HUGE_STR_SIZE]; /* description of the QA bits where
+    char *qa_desc;               /* description of the QA bits where
                                     they are not bit-specific and don't fit
-                                    as classes */
+                                    as classes; lazily allocated via
+                                    set_band_qa_desc since only the QA bands
+                                    carry one; NULL reads as the string fill
+                                    value through get_band_qa_desc */
+    int qa_desc_size;            /* allocated size of qa_desc including the
+                                    terminator; the allocation is reused in
+                                    place when a new description fits */
     float calibrated_nt;
+    char checksum[STR_SIZE];     /* CRC32C checksum of the band file as hex
+                                    digits, computed as the band was written;
+                                    "undefined" if not computed */
+    int byte_order;              /* byte order the band file was written in
+                                    (ENVI convention: 0 - LSB first, 1 - MSB
+                                    first); ESPA_INT_META_FILL if not
+                                    declared, meaning native order */
+    long stat_npixels;           /* number of non-fill pixels the band
+                                    statistics were computed over;
+                                    ESPA_INT_META_FILL if not computed */
+    double stat_min;             /* minimum of the non-fill pixels */
+    double stat_max;             /* maximum of the non-fill pixels */
+    double stat_mean;            /* mean of the non-fill pixels */
+    long stat_histogram[ESPA_STAT_HIST_BINS];  /* histogram of the non-fill
+                                    pixels, binned over the valid range when
+                                    one is declared and over the data type
+                                    range otherwise; all zeros if not
+                                    computed */
     char app_version[STR_SIZE];  /* version of the application which produced
                                     the current band */
     char production_date[STR_SIZE];  /* date the band was produced */
 } Espa_band_meta_t;
 
+/* Compact per-band descriptor holding just the fields the iteration-heavy
+   scan loops read.  A scan over a large band list touches one cache line
+   per band instead of pulling each full band structure through the cache
+   between the pixel loops.  Built lazily by get_band_hot and kept alongside
+   the full band array. */
+typedef struct
+{
+    unsigned int name_hash;     /* espa_name_hash of the band name */
+    unsigned int product_hash;  /* espa_name_hash of the band product type */
+    enum Espa_data_type data_type;  /* data type of the band pixels */
+    int nlines;                 /* number of lines in the band */
+    int nsamps;                 /* number of samples in the band */
+    int band_index;             /* index of the band in the band array */
+    long fill_value;            /* fill value for the band */
+} Espa_band_hot_t;
+
 typedef struct
 {
     char meta_namespace[STR_SIZE];  /* namespace for this metadata file */
     Espa_global_meta_t global;  /* global metadata */
     int nbands;                 /* number of bands in the metadata file */
+    int nbands_alloc;           /* number of bands the band array can hold;
+                                   grown geometrically so bands can be
+                                   appended without a realloc per band */
     Espa_band_meta_t *band;     /* array of band metadata */
+    int *band_hash;             /* optional hash index of band names to band
+                                   array indices, built lazily by
+                                   find_band_index; slots hold band index
+                                   plus one, with zero marking empty */
+    int band_hash_size;         /* number of slots in the band hash */
+    int band_hash_nbands;       /* band count the hash was built for, so a
+                                   stale hash is rebuilt after appends */
+    Espa_band_hot_t *band_hot;  /* optional compact per-band descriptors for
+                                   the iteration-heavy scan loops, built
+                                   lazily by get_band_hot */
+    int band_hot_nbands;        /* band count the descriptors were built
+                                   for, so stale descriptors are rebuilt
+                                   after appends */
+    const Espa_proj_meta_t *shared_proj;  /* canonical copy of proj_info in
+                                   the shared intern segment, when the
+                                   projection metadata was interned (set
+                                   ESPA_META_INTERN); NULL otherwise */
 } Espa_internal_meta_t;
 
 /* Prototypes */
@@ -209,6 +284,25 @@ int validate_xml_file
     char *meta_file           /* I: name of metadata file to be validated */
 );
 
+int validate_xml_files
+(
+    char **meta_files,        /* I: array of nfiles metadata file names to be
+                                    validated */
+    int nfiles,               /* I: number of metadata files in the list */
+    int nthreads              /* I: number of validation threads; zero or
+                                    less uses one per online processor */
+);
+
+void record_trusted_metadata
+(
+    char *meta_file           /* I: name of the metadata file just written */
+);
+
+bool is_trusted_metadata
+(
+    char *meta_file           /* I: name of the metadata file */
+);
+
 void init_metadata_struct
 (
     Espa_internal_meta_t *internal_meta   /* I: pointer to internal metadata
@@ -224,6 +318,32 @@ int allocate_band_metadata
                                                 internal_meta */
 );
 
+int find_band_index
+(
+    Espa_internal_meta_t *metadata,  /* I: metadata structure to search */
+    const char *band_name            /* I: name of the band to look up */
+);
+
+unsigned int espa_name_hash
+(
+    const char *name                 /* I: string to be hashed */
+);
+
+const Espa_band_hot_t *get_band_hot
+(
+    Espa_internal_meta_t *metadata   /* I: metadata structure whose compact
+                                           band descriptors are wanted */
+);
+
+int reallocate_band_metadata
+(
+    Espa_internal_meta_t *internal_meta,  /* I: pointer to internal metadata
+                                                structure */
+    int nbands                            /* I: number of bands the band field
+                                                in the internal_meta should be
+                                                grown to */
+);
+
 int allocate_class_metadata
 (
     Espa_band_meta_t *band_meta,  /* I: pointer to band metadata structure */
@@ -238,6 +358,40 @@ int allocate_bitmap_metadata
                                         bitmap metadata */
 );
 
+int intern_bitmap_metadata
+(
+    Espa_band_meta_t *band_meta   /* I/O: band whose bitmap descriptions are
+                                        to be interned */
+);
+
+int share_bitmap_metadata
+(
+    Espa_band_meta_t *out_meta,   /* I/O: band to reference the shared set */
+    Espa_band_meta_t *in_meta     /* I/O: band whose set is to be shared; its
+                                        private copy is interned */
+);
+
+void free_bitmap_metadata
+(
+    Espa_band_meta_t *band_meta   /* I/O: band whose bitmap descriptions are
+                                        to be released */
+);
+
+int set_band_qa_desc
+(
+    Espa_band_meta_t *band_meta,  /* I/O: band whose QA description is to be
+                                        set */
+    const char *qa_desc           /* I: QA description to store; NULL or the
+                                        string fill value drops the band's
+                                        description */
+);
+
+const char *get_band_qa_desc
+(
+    const Espa_band_meta_t *band_meta  /* I: band whose QA description is to
+                                        be read */
+);
+
 void free_metadata
 (
     Espa_internal_meta_t *internal_meta   /* I: pointer to internal metadata
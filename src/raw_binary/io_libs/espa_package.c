@@ -0,0 +1,476 @@
+/*****************************************************************************
+FILE: espa_package.c
+
+PURPOSE: Contains functions for assembling delivery packages from ESPA
+products.  The package is an uncompressed POSIX ustar archive, assembled
+with copy_file_range where the kernel supports it so the member payloads
+move between the files without passing through userspace buffers.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The archive layout is plain ustar, so the packages are readable by any
+     tar implementation without this library.
+*****************************************************************************/
+
+/* copy_file_range is a GNU extension */
+#define _GNU_SOURCE
+#include <unistd.h>
+#include <fcntl.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "espa_package.h"
+
+/* Size in bytes of a tar block; headers, member payloads, and the archive
+   trailer are all padded to this boundary */
+#define TAR_BLOCK_SIZE 512
+
+/* Size in bytes of the bounce buffer used when copy_file_range is not
+   available and the member payload is copied through userspace */
+#define PACKAGE_COPY_BUFSIZE (1024 * 1024)
+
+/* POSIX ustar header block layout */
+typedef struct
+{
+    char name[100];          /* member filename */
+    char mode[8];            /* permission bits, octal */
+    char uid[8];             /* owner user ID, octal */
+    char gid[8];             /* owner group ID, octal */
+    char size[12];           /* payload size in bytes, octal */
+    char mtime[12];          /* modification time, octal */
+    char chksum[8];          /* header checksum, octal */
+    char typeflag;           /* member type; '0' for a regular file */
+    char linkname[100];      /* link target; unused for regular files */
+    char magic[6];           /* "ustar" */
+    char version[2];         /* "00" */
+    char uname[32];          /* owner user name */
+    char gname[32];          /* owner group name */
+    char devmajor[8];        /* device major number; unused */
+    char devminor[8];        /* device minor number; unused */
+    char prefix[155];        /* filename prefix for long names */
+    char padding[12];        /* pad out to the tar block size */
+} Tar_header_t;
+
+
+/******************************************************************************
+MODULE:  write_member_header (static)
+
+PURPOSE: Writes the ustar header block for one member of the package.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error writing the header block
+SUCCESS         Header block was written
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The member is stored under the basename of the file, since delivery
+     packages are extracted into a per-scene directory.
+******************************************************************************/
+static int write_member_header
+(
+    int package_fd,          /* I: descriptor of the output package */
+    const char *file,        /* I: name of the member file */
+    const struct stat *st    /* I: stat buffer for the member file */
+)
+{
+    char FUNC_NAME[] = "write_member_header";  /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    const char *base = NULL; /* basename of the member file */
+    unsigned int chksum;     /* header checksum */
+    int i;                   /* looping variable */
+    int count;               /* number of chars copied in snprintf */
+    Tar_header_t hdr;        /* header block for the member */
+    const unsigned char *raw = (const unsigned char *) &hdr;  /* header
+                                bytes for the checksum */
+
+    /* Store the member under its basename */
+    base = strrchr (file, '/');
+    base = (base != NULL) ? base + 1 : file;
+
+    memset (&hdr, 0, sizeof (hdr));
+    count = snprintf (hdr.name, sizeof (hdr.name), "%s", base);
+    if (count < 0 || count >= sizeof (hdr.name))
+    {
+        sprintf (errmsg, "Member filename is too long for the tar header: "
+            "%s", base);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* The octal size field holds 11 digits, which bounds the members at
+       8 GiB - 1 */
+    if (st->st_size > 077777777777LL)
+    {
+        sprintf (errmsg, "Member file %s is too large for the tar size "
+            "field.", base);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    snprintf (hdr.mode, sizeof (hdr.mode), "%07o", 0644);
+    snprintf (hdr.uid, sizeof (hdr.uid), "%07o", 0);
+    snprintf (hdr.gid, sizeof (hdr.gid), "%07o", 0);
+    snprintf (hdr.size, sizeof (hdr.size), "%011llo",
+        (unsigned long long) st->st_size);
+    snprintf (hdr.mtime, sizeof (hdr.mtime), "%011llo",
+        (unsigned long long) st->st_mtime);
+    hdr.typeflag = '0';
+    memcpy (hdr.magic, "ustar", 6);
+    memcpy (hdr.version, "00", 2);
+
+    /* The checksum field counts as spaces while the checksum itself is
+       computed */
+    memset (hdr.chksum, ' ', sizeof (hdr.chksum));
+    chksum = 0;
+    for (i = 0; i < TAR_BLOCK_SIZE; i++)
+        chksum += raw[i];
+    snprintf (hdr.chksum, sizeof (hdr.chksum), "%06o", chksum);
+    hdr.chksum[7] = ' ';
+
+    if (write (package_fd, &hdr, TAR_BLOCK_SIZE) != TAR_BLOCK_SIZE)
+    {
+        sprintf (errmsg, "Writing the tar header for member %s.", base);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  copy_member_payload (static)
+
+PURPOSE: Copies the payload of one member file into the package, using
+copy_file_range so the kernel moves the extents directly, with a bounce
+buffer fallback for filesystems and kernels without that support.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error copying the payload
+SUCCESS         Payload was copied and padded to the tar block size
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static int copy_member_payload
+(
+    int package_fd,          /* I: descriptor of the output package */
+    int member_fd,           /* I: descriptor of the member file */
+    const char *file,        /* I: name of the member file (for errors) */
+    off_t size               /* I: number of payload bytes to copy */
+)
+{
+    char FUNC_NAME[] = "copy_member_payload";  /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    char pad[TAR_BLOCK_SIZE];  /* zero padding out to the block boundary */
+    char *buf = NULL;        /* bounce buffer for the fallback copy */
+    off_t remaining = size;  /* payload bytes still to be copied */
+    ssize_t nbytes;          /* bytes moved by the current call */
+    size_t chunk;            /* bytes requested from the current call */
+    int use_fallback = 0;    /* is copy_file_range unusable here? */
+
+    while (remaining > 0)
+    {
+        if (!use_fallback)
+        {
+            /* Let the kernel move the bytes between the files without a
+               round trip through a userspace buffer */
+            nbytes = copy_file_range (member_fd, NULL, package_fd, NULL,
+                remaining, 0);
+            if (nbytes < 0)
+            {
+                /* Fall back to the bounce buffer on kernels or cross-device
+                   setups where copy_file_range is not supported */
+                if (errno == EXDEV || errno == EINVAL || errno == ENOSYS ||
+                    errno == EOPNOTSUPP)
+                {
+                    use_fallback = 1;
+                    continue;
+                }
+                sprintf (errmsg, "Copying member %s into the package.",
+                    file);
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
+            }
+        }
+        else
+        {
+            if (buf == NULL)
+            {
+                buf = malloc (PACKAGE_COPY_BUFSIZE);
+                if (buf == NULL)
+                {
+                    sprintf (errmsg, "Allocating the package copy buffer.");
+                    error_handler (true, FUNC_NAME, errmsg);
+                    return (ERROR);
+                }
+            }
+
+            chunk = PACKAGE_COPY_BUFSIZE;
+            if ((off_t) chunk > remaining)
+                chunk = remaining;
+            nbytes = read (member_fd, buf, chunk);
+            if (nbytes > 0 && write (package_fd, buf, nbytes) != nbytes)
+                nbytes = -1;
+            if (nbytes < 0)
+            {
+                sprintf (errmsg, "Copying member %s into the package.",
+                    file);
+                error_handler (true, FUNC_NAME, errmsg);
+                free (buf);
+                return (ERROR);
+            }
+        }
+
+        if (nbytes == 0)
+        {
+            sprintf (errmsg, "Member file %s shrank while it was being "
+                "packaged.", file);
+            error_handler (true, FUNC_NAME, errmsg);
+            free (buf);
+            return (ERROR);
+        }
+        remaining -= nbytes;
+    }
+    free (buf);
+
+    /* Pad the payload out to the tar block boundary */
+    if (size % TAR_BLOCK_SIZE != 0)
+    {
+        memset (pad, 0, sizeof (pad));
+        nbytes = TAR_BLOCK_SIZE - size % TAR_BLOCK_SIZE;
+        if (write (package_fd, pad, nbytes) != nbytes)
+        {
+            sprintf (errmsg, "Padding member %s in the package.", file);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  espa_package_files
+
+PURPOSE: Assembles the listed files into one uncompressed ustar package,
+moving the payloads with copy_file_range where the kernel supports it.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error assembling the package
+SUCCESS         Package was assembled
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The members are stored under their basenames, so the package extracts
+     flat into a per-scene directory.
+******************************************************************************/
+int espa_package_files
+(
+    char *package_file,     /* I: output package (tar) filename */
+    char * const *files,    /* I: array of filenames to be packaged */
+    int nfiles              /* I: number of filenames in the array */
+)
+{
+    char FUNC_NAME[] = "espa_package_files";  /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    char trailer[2*TAR_BLOCK_SIZE];  /* zero blocks ending the archive */
+    int package_fd = -1;     /* descriptor of the output package */
+    int member_fd = -1;      /* descriptor of the current member file */
+    int i;                   /* looping variable for the files */
+    struct stat st;          /* stat buffer for the current member */
+
+    /* Create the output package */
+    package_fd = open (package_file, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (package_fd < 0)
+    {
+        sprintf (errmsg, "Creating the output package file: %s",
+            package_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Append each member: a ustar header block followed by the payload
+       padded to the block boundary */
+    for (i = 0; i < nfiles; i++)
+    {
+        member_fd = open (files[i], O_RDONLY);
+        if (member_fd < 0)
+        {
+            sprintf (errmsg, "Opening member file %s for packaging.",
+                files[i]);
+            error_handler (true, FUNC_NAME, errmsg);
+            close (package_fd);
+            return (ERROR);
+        }
+
+        if (fstat (member_fd, &st) != 0)
+        {
+            sprintf (errmsg, "Getting the size of member file %s.",
+                files[i]);
+            error_handler (true, FUNC_NAME, errmsg);
+            close (member_fd);
+            close (package_fd);
+            return (ERROR);
+        }
+
+        if (write_member_header (package_fd, files[i], &st) != SUCCESS ||
+            copy_member_payload (package_fd, member_fd, files[i],
+                st.st_size) != SUCCESS)
+        {  /* Error messages already printed */
+            close (member_fd);
+            close (package_fd);
+            return (ERROR);
+        }
+        close (member_fd);
+    }
+
+    /* End the archive with two zero blocks */
+    memset (trailer, 0, sizeof (trailer));
+    if (write (package_fd, trailer, sizeof (trailer)) !=
+        (ssize_t) sizeof (trailer))
+    {
+        sprintf (errmsg, "Writing the trailer of the package: %s",
+            package_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        close (package_fd);
+        return (ERROR);
+    }
+
+    if (close (package_fd) != 0)
+    {
+        sprintf (errmsg, "Closing the output package file: %s",
+            package_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  espa_package_scene
+
+PURPOSE: Assembles the delivery package for one scene from its metadata:
+the XML file plus every band's raw binary file and ENVI header.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error assembling the package
+SUCCESS         Package was assembled
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Any queued write-behind metadata/header writes for the scene must have
+     completed before the scene is packaged.
+******************************************************************************/
+int espa_package_scene
+(
+    char *espa_xml_file,    /* I: ESPA XML metadata filename of the scene */
+    Espa_internal_meta_t *xml_metadata,  /* I: parsed scene metadata */
+    char *package_file      /* I: output package (tar) filename */
+)
+{
+    char FUNC_NAME[] = "espa_package_scene";  /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    char *cptr = NULL;       /* pointer to the file extension */
+    char **files = NULL;     /* array of filenames to be packaged */
+    int nfiles = 0;          /* number of filenames in the array */
+    int i;                   /* looping variable */
+    int status = SUCCESS;    /* return status of the packaging */
+
+    /* The package holds the XML file plus a raw binary file and an ENVI
+       header per band */
+    files = calloc (2 * xml_metadata->nbands + 1, sizeof (char *));
+    if (files == NULL)
+    {
+        sprintf (errmsg, "Allocating the package file list.");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    files[nfiles++] = strdup (espa_xml_file);
+    for (i = 0; i < xml_metadata->nbands; i++)
+    {
+        files[nfiles++] = strdup (xml_metadata->band[i].file_name);
+
+        /* The ENVI header sits beside the raw binary file */
+        files[nfiles] = malloc (strlen (xml_metadata->band[i].file_name)
+            + 5);
+        if (files[nfiles] != NULL)
+        {
+            strcpy (files[nfiles], xml_metadata->band[i].file_name);
+            cptr = strrchr (files[nfiles], '.');
+            if (cptr != NULL)
+                strcpy (cptr, ".hdr");
+        }
+        nfiles++;
+    }
+
+    for (i = 0; i < nfiles; i++)
+    {
+        if (files[i] == NULL)
+        {
+            sprintf (errmsg, "Allocating the package filenames.");
+            error_handler (true, FUNC_NAME, errmsg);
+            status = ERROR;
+            break;
+        }
+    }
+
+    if (status == SUCCESS)
+        status = espa_package_files (package_file, files, nfiles);
+
+    for (i = 0; i < nfiles; i++)
+        free (files[i]);
+    free (files);
+
+    if (status != SUCCESS)
+    {
+        sprintf (errmsg, "Assembling the delivery package for %s.",
+            espa_xml_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    return (SUCCESS);
+}
@@ -0,0 +1,43 @@
+/*****************************************************************************
+FILE: espa_package.h
+
+PURPOSE: Contains defines and prototypes for assembling delivery packages
+from ESPA products without an external tar pass.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+
+#ifndef ESPA_PACKAGE_H
+#define ESPA_PACKAGE_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "error_handler.h"
+#include "espa_metadata.h"
+
+/* Prototypes */
+int espa_package_files
+(
+    char *package_file,     /* I: output package (tar) filename */
+    char * const *files,    /* I: array of filenames to be packaged */
+    int nfiles              /* I: number of filenames in the array */
+);
+
+int espa_package_scene
+(
+    char *espa_xml_file,    /* I: ESPA XML metadata filename of the scene */
+    Espa_internal_meta_t *xml_metadata,  /* I: parsed scene metadata */
+    char *package_file      /* I: output package (tar) filename */
+);
+
+#endif
@@ -0,0 +1,100 @@
+/*****************************************************************************
+FILE: espa_prefetch.c
+
+PURPOSE: Contains functions for prefetching the band files a following
+processing stage will read.  The drivers know which bands the next stage
+touches after the metadata parse, so hinting those files to the kernel
+overlaps the next stage's reads with the current stage's compute.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The prefetch is only an advisory readahead, so the following stage
+     reads identically whether or not the hints took effect.
+*****************************************************************************/
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "espa_buffer.h"
+#include "espa_prefetch.h"
+
+
+/******************************************************************************
+MODULE: espa_prefetch_band_files
+
+PURPOSE: Hints the kernel to read the band files ahead of the stage that
+will consume them, in the declared band order, bounded so the hints stay
+within the prefetch byte budget.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The bands are hinted in their declared order since that is the order
+     the stages read them, so the budget goes to the files that are
+     needed first.
+  2. When no bound is passed, a quarter of the process memory budget is
+     used, falling back to a fixed default when no budget is configured.
+     Hinting more than that just evicts the prefetched pages before the
+     consuming stage reaches them.
+******************************************************************************/
+void espa_prefetch_band_files
+(
+    Espa_internal_meta_t *xml_metadata,  /* I: metadata listing the band
+                                               files in processing order */
+    long long max_bytes                  /* I: byte bound on the prefetch;
+                                               0 or less applies the
+                                               memory-budget default */
+)
+{
+    long long remaining;        /* prefetch bytes still available */
+    long long nbytes;           /* bytes hinted for the current band */
+    struct stat st;             /* information for the current band file */
+    int fd;                     /* descriptor of the current band file */
+    int i;                      /* looping variable for the bands */
+
+    /* Bound the prefetch; the advice is dropped entirely when the budget
+       works out to nothing */
+    if (max_bytes <= 0)
+    {
+        max_bytes = (long long) espa_memory_budget_bytes () / 4;
+        if (max_bytes <= 0)
+            max_bytes = ESPA_PREFETCH_DEFAULT_BYTES;
+    }
+
+    /* Hint each band file, leading portion first, until the budget is
+       spent.  Failures are ignored since the hints are advisory and the
+       consuming stage reports any real errors itself. */
+    remaining = max_bytes;
+    for (i = 0; i < xml_metadata->nbands && remaining > 0; i++)
+    {
+        fd = open (xml_metadata->band[i].file_name, O_RDONLY);
+        if (fd == -1)
+            continue;
+
+        if (fstat (fd, &st) == 0)
+        {
+            nbytes = (long long) st.st_size;
+            if (nbytes > remaining)
+                nbytes = remaining;
+            posix_fadvise (fd, 0, (off_t) nbytes, POSIX_FADV_WILLNEED);
+            remaining -= nbytes;
+        }
+        close (fd);
+    }
+}
@@ -0,0 +1,43 @@
+/*****************************************************************************
+FILE: espa_prefetch.h
+
+PURPOSE: Contains defines and prototypes for prefetching the band files a
+following processing stage will read.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The prefetch is only an advisory readahead, so the following stage
+     reads identically whether or not the hints took effect.
+*****************************************************************************/
+
+#ifndef ESPA_PREFETCH_H
+#define ESPA_PREFETCH_H
+
+#include <stdlib.h>
+#include "espa_metadata.h"
+
+/* Byte bound on the prefetch when no memory budget is configured; hinting
+   more than the page cache will hold just evicts the prefetched pages
+   before they are read */
+#define ESPA_PREFETCH_DEFAULT_BYTES (256LL * 1024LL * 1024LL)
+
+/* Prototypes */
+void espa_prefetch_band_files
+(
+    Espa_internal_meta_t *xml_metadata,  /* I: metadata listing the band
+                                               files in processing order */
+    long long max_bytes                  /* I: byte bound on the prefetch;
+                                               0 or less applies the
+                                               memory-budget default */
+);
+
+#endif
@@ -0,0 +1,396 @@
+/*****************************************************************************
+FILE: espa_resume.c
+
+PURPOSE: Contains functions for checkpointing multi-band conversions.  As
+each band commits, its size and CRC32C checksum are appended to a sidecar
+manifest beside the scene's XML file; a restarted conversion verifies the
+recorded bands against the files on disk and skips the ones that are
+complete, so a preempted scene only redoes its unfinished work.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The manifest is removed when the whole scene converts successfully, so
+     its presence marks an interrupted conversion.
+  2. Checkpointing is enabled with the ESPA_RESUME environment variable and
+     pairs naturally with ESPA_ATOMIC_OUTPUT, which keeps a killed band
+     from reaching its final name half-written.
+*****************************************************************************/
+
+#include <unistd.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "espa_resume.h"
+
+/* Size in bytes of the buffer used to stream a band file through the
+   checksum */
+#define RESUME_READ_BUFSIZE (1024 * 1024)
+
+/* Number of manifest entries allocated at a time */
+#define RESUME_ENTRY_ALLOC 32
+
+
+/******************************************************************************
+MODULE: espa_resume_enabled
+
+PURPOSE: Checks whether conversion checkpointing was requested through the
+ESPA_RESUME environment variable.
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+0            Checkpointing is off (the default)
+1            Completed bands are recorded in a sidecar manifest and a
+             restarted conversion skips the verified-complete ones
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+int espa_resume_enabled (void)
+{
+    static int enabled = -1;      /* cached setting; -1 until first call */
+    char *value = NULL;           /* value of the environment variable */
+
+    if (enabled == -1)
+    {
+        value = getenv ("ESPA_RESUME");
+        enabled = (value != NULL && value[0] != '\0' &&
+            strcmp (value, "0") != 0);
+    }
+
+    return enabled;
+}
+
+
+/******************************************************************************
+MODULE: resume_file_checksum (static)
+
+PURPOSE: Streams a band file through the CRC32C checksum.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error reading the band file
+SUCCESS         Checksum and size were computed
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static int resume_file_checksum
+(
+    char *file_name,            /* I: name of the band file */
+    long long *nbytes,          /* O: size of the band file in bytes */
+    char *checksum              /* O: hex checksum string of
+                                      ESPA_CHECKSUM_STR_SIZE characters */
+)
+{
+    char FUNC_NAME[] = "resume_file_checksum";  /* function name */
+    char errmsg[STR_SIZE];      /* error message */
+    unsigned char *buf = NULL;  /* read buffer */
+    unsigned int crc = 0;       /* running checksum */
+    size_t nread;               /* bytes read by the current call */
+    FILE *fptr = NULL;          /* band file stream */
+
+    fptr = fopen (file_name, "rb");
+    if (fptr == NULL)
+    {
+        sprintf (errmsg, "Opening band file for checksumming: %s",
+            file_name);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    buf = malloc (RESUME_READ_BUFSIZE);
+    if (buf == NULL)
+    {
+        sprintf (errmsg, "Allocating the checksum read buffer.");
+        error_handler (true, FUNC_NAME, errmsg);
+        fclose (fptr);
+        return (ERROR);
+    }
+
+    *nbytes = 0;
+    while ((nread = fread (buf, 1, RESUME_READ_BUFSIZE, fptr)) > 0)
+    {
+        crc = espa_crc32c (crc, buf, nread);
+        *nbytes += nread;
+    }
+    free (buf);
+
+    if (ferror (fptr))
+    {
+        sprintf (errmsg, "Reading band file for checksumming: %s",
+            file_name);
+        error_handler (true, FUNC_NAME, errmsg);
+        fclose (fptr);
+        return (ERROR);
+    }
+    fclose (fptr);
+
+    espa_crc32c_string (crc, checksum);
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE: espa_resume_open
+
+PURPOSE: Opens the checkpoint manifest for a scene, loading the bands
+recorded by an interrupted previous run.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error opening the manifest
+SUCCESS         Manifest was opened; any previously recorded bands were
+                loaded for the completeness checks
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The manifest sits beside the scene's XML file under the .resume
+     extension.
+******************************************************************************/
+int espa_resume_open
+(
+    char *espa_xml_file,        /* I: ESPA XML metadata filename of the
+                                      scene being converted */
+    Espa_resume_t *resume       /* O: checkpoint state for the scene */
+)
+{
+    char FUNC_NAME[] = "espa_resume_open";  /* function name */
+    char errmsg[STR_SIZE];      /* error message */
+    char line[STR_SIZE];        /* current manifest line */
+    int count;                  /* number of chars copied in snprintf */
+    FILE *fptr = NULL;          /* manifest stream for the load pass */
+    Espa_resume_entry_t *entries = NULL;  /* grown entry array */
+    Espa_resume_entry_t entry;  /* entry parsed from the current line */
+
+    resume->fptr = NULL;
+    resume->entries = NULL;
+    resume->nentries = 0;
+    pthread_mutex_init (&resume->lock, NULL);
+
+    count = snprintf (resume->manifest_file, sizeof (resume->manifest_file),
+        "%s.resume", espa_xml_file);
+    if (count < 0 || count >= sizeof (resume->manifest_file))
+    {
+        sprintf (errmsg, "Overflow of manifest_file string");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Load the bands recorded by an interrupted previous run; a missing
+       manifest just means there is nothing to skip */
+    fptr = fopen (resume->manifest_file, "r");
+    if (fptr != NULL)
+    {
+        while (fgets (line, sizeof (line), fptr) != NULL)
+        {
+            if (sscanf (line, "%8s %lld %2047s", entry.checksum,
+                &entry.nbytes, entry.file_name) != 3)
+            {
+                /* A torn final line from a kill mid-append is expected;
+                   everything before it is intact since the entries are
+                   flushed line by line */
+                continue;
+            }
+
+            if (resume->nentries % RESUME_ENTRY_ALLOC == 0)
+            {
+                entries = realloc (resume->entries,
+                    (resume->nentries + RESUME_ENTRY_ALLOC) *
+                    sizeof (Espa_resume_entry_t));
+                if (entries == NULL)
+                {
+                    sprintf (errmsg, "Allocating the resume entries.");
+                    error_handler (true, FUNC_NAME, errmsg);
+                    fclose (fptr);
+                    free (resume->entries);
+                    resume->entries = NULL;
+                    return (ERROR);
+                }
+                resume->entries = entries;
+            }
+            resume->entries[resume->nentries++] = entry;
+        }
+        fclose (fptr);
+    }
+
+    /* Append the bands completed by this run behind the loaded ones */
+    resume->fptr = fopen (resume->manifest_file, "a");
+    if (resume->fptr == NULL)
+    {
+        sprintf (errmsg, "Opening the resume manifest for appending.");
+        error_handler (true, FUNC_NAME, errmsg);
+        free (resume->entries);
+        resume->entries = NULL;
+        return (ERROR);
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE: espa_resume_band_complete
+
+PURPOSE: Checks whether a band was completed by a previous run, verifying
+the recorded size and checksum against the file on disk.
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+0            The band was not recorded, or the file on disk no longer
+             matches its record; it needs to be converted
+1            The band is verified complete and can be skipped
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Verification streams the band file once, which costs a sequential
+     read but is far cheaper than redoing the conversion.
+******************************************************************************/
+int espa_resume_band_complete
+(
+    Espa_resume_t *resume,      /* I: checkpoint state for the scene */
+    char *file_name             /* I: name of the band file to be checked */
+)
+{
+    char checksum[ESPA_CHECKSUM_STR_SIZE];  /* checksum of the file */
+    long long nbytes;           /* size of the file in bytes */
+    int i;                      /* looping variable for the entries */
+
+    for (i = 0; i < resume->nentries; i++)
+    {
+        if (strcmp (resume->entries[i].file_name, file_name) != 0)
+            continue;
+
+        if (resume_file_checksum (file_name, &nbytes, checksum) != SUCCESS)
+            return (0);   /* unreadable; reconvert the band */
+
+        return (nbytes == resume->entries[i].nbytes &&
+            strcmp (checksum, resume->entries[i].checksum) == 0);
+    }
+
+    return (0);
+}
+
+
+/******************************************************************************
+MODULE: espa_resume_record
+
+PURPOSE: Records a band as complete in the checkpoint manifest, flushing
+the entry so it survives the process being killed.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error recording the band
+SUCCESS         Band was recorded
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+int espa_resume_record
+(
+    Espa_resume_t *resume,      /* I: checkpoint state for the scene */
+    char *file_name             /* I: name of the completed band file */
+)
+{
+    char FUNC_NAME[] = "espa_resume_record";  /* function name */
+    char errmsg[STR_SIZE];      /* error message */
+    char checksum[ESPA_CHECKSUM_STR_SIZE];  /* checksum of the band file */
+    long long nbytes;           /* size of the band file in bytes */
+
+    if (resume_file_checksum (file_name, &nbytes, checksum) != SUCCESS)
+    {  /* Error messages already printed */
+        return (ERROR);
+    }
+
+    pthread_mutex_lock (&resume->lock);
+    if (fprintf (resume->fptr, "%s %lld %s\n", checksum, nbytes,
+        file_name) < 0 || fflush (resume->fptr) != 0)
+    {
+        pthread_mutex_unlock (&resume->lock);
+        sprintf (errmsg, "Appending band %s to the resume manifest.",
+            file_name);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+    fsync (fileno (resume->fptr));
+    pthread_mutex_unlock (&resume->lock);
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE: espa_resume_close
+
+PURPOSE: Closes the checkpoint manifest, removing it when the whole scene
+converted so a later rerun starts clean.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void espa_resume_close
+(
+    Espa_resume_t *resume,      /* I: checkpoint state for the scene */
+    int scene_complete          /* I: did the whole scene convert?  The
+                                      manifest is removed when it did */
+)
+{
+    if (resume->fptr != NULL)
+    {
+        fclose (resume->fptr);
+        resume->fptr = NULL;
+    }
+
+    if (scene_complete)
+        unlink (resume->manifest_file);
+
+    free (resume->entries);
+    resume->entries = NULL;
+    resume->nentries = 0;
+    pthread_mutex_destroy (&resume->lock);
+}
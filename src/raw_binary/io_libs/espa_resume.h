@@ -0,0 +1,77 @@
+/*****************************************************************************
+FILE: espa_resume.h
+
+PURPOSE: Contains defines and prototypes for checkpointing multi-band
+conversions so a restarted scene skips its verified-complete bands.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+
+#ifndef ESPA_RESUME_H
+#define ESPA_RESUME_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <pthread.h>
+#include "error_handler.h"
+#include "espa_checksum.h"
+
+/* One completed band recorded in the sidecar manifest */
+typedef struct
+{
+    char file_name[STR_SIZE];   /* name of the completed band file */
+    long long nbytes;           /* size of the band file in bytes */
+    char checksum[ESPA_CHECKSUM_STR_SIZE];  /* CRC32C of the band file */
+} Espa_resume_entry_t;
+
+/* Checkpoint state for one scene conversion */
+typedef struct
+{
+    char manifest_file[STR_SIZE];  /* sidecar manifest filename */
+    FILE *fptr;                 /* manifest stream, appended as bands
+                                   complete */
+    Espa_resume_entry_t *entries;  /* entries loaded from a previous run */
+    int nentries;               /* number of loaded entries */
+    pthread_mutex_t lock;       /* serializes appends from the band tasks */
+} Espa_resume_t;
+
+/* Prototypes */
+int espa_resume_enabled (void);
+
+int espa_resume_open
+(
+    char *espa_xml_file,        /* I: ESPA XML metadata filename of the
+                                      scene being converted */
+    Espa_resume_t *resume       /* O: checkpoint state for the scene */
+);
+
+int espa_resume_band_complete
+(
+    Espa_resume_t *resume,      /* I: checkpoint state for the scene */
+    char *file_name             /* I: name of the band file to be checked */
+);
+
+int espa_resume_record
+(
+    Espa_resume_t *resume,      /* I: checkpoint state for the scene */
+    char *file_name             /* I: name of the completed band file */
+);
+
+void espa_resume_close
+(
+    Espa_resume_t *resume,      /* I: checkpoint state for the scene */
+    int scene_complete          /* I: did the whole scene convert?  The
+                                      manifest is removed when it did */
+);
+
+#endif
@@ -0,0 +1,37 @@
+/*****************************************************************************
+FILE: espa_schema_data.h
+
+PURPOSE: Contains declarations for the ESPA schema embedded into the library
+at build time.  The matching espa_schema_data.c is generated by the Makefile
+from schema/espa_internal_metadata_v1_2.xsd, so validation in a fresh
+container never has to fetch the schema from the ESPA http site or find a
+copy on disk.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The ESPA_SCHEMA environment variable still overrides the embedded
+     copy, so a newer or experimental schema can be validated against
+     without rebuilding the library.
+*****************************************************************************/
+
+#ifndef ESPA_SCHEMA_DATA_H
+#define ESPA_SCHEMA_DATA_H
+
+#include <stddef.h>
+
+/* Schema document embedded at build time; NUL-terminated */
+extern const char espa_embedded_schema[];
+
+/* Length of the embedded schema document, not counting the NUL */
+extern const size_t espa_embedded_schema_len;
+
+#endif
@@ -0,0 +1,228 @@
+/*****************************************************************************
+FILE: gzip_input.c
+
+PURPOSE: Contains functions for consuming gzip-compressed input files
+through a memory-backed inflate layer.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. On Linux the inflated bytes go into a memfd, whose /proc/self/fd path
+     the GeoTIFF and HDF4 readers can open like any file; the data lives in
+     memory and never touches disk.  Elsewhere a regular temp file is used,
+     which still saves the separate decompression step.
+  2. The compression is zlib, which the library already depends on through
+     the XML support.
+*****************************************************************************/
+
+#define _GNU_SOURCE
+#include <unistd.h>
+#include <string.h>
+#include <zlib.h>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+#include "gzip_input.h"
+
+/* Number of inflated bytes moved per write while loading the input */
+#define GZIP_INPUT_CHUNK_BYTES (1024 * 1024)
+
+/******************************************************************************
+MODULE:  is_gzip_input
+
+PURPOSE: Checks whether an input filename names a gzip-compressed file.
+
+RETURN VALUE:
+Type = bool
+Value           Description
+-----           -----------
+true            Filename ends in .gz
+false           Filename does not end in .gz
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+bool is_gzip_input
+(
+    char *file_name      /* I: input filename to be checked */
+)
+{
+    size_t length = strlen (file_name);
+
+    return (length > strlen (".gz") &&
+        strcmp (file_name + length - strlen (".gz"), ".gz") == 0);
+}
+
+
+/******************************************************************************
+MODULE:  open_gzip_input
+
+PURPOSE: Inflates a gzip-compressed input file into a memory-backed file and
+returns the path a reader should open in its place.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error inflating the input
+SUCCESS         Input was inflated and the open path was filled in
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The returned path stays valid until close_gzip_input is called with
+     the returned descriptor, and may be opened multiple times (the HDF-EOS
+     and SD interfaces each open the file).
+******************************************************************************/
+int open_gzip_input
+(
+    char *gz_file,       /* I: gzip-compressed input file */
+    char *open_path,     /* O: path the reader should open instead of the
+                               compressed file */
+    size_t open_path_size,  /* I: size of the open_path string */
+    int *gz_fd           /* O: descriptor backing the path, to be released
+                               with close_gzip_input */
+)
+{
+    char FUNC_NAME[] = "open_gzip_input";  /* function name */
+    char errmsg[STR_SIZE];     /* error message */
+    char *chunk = NULL;        /* chunk buffer for the inflated bytes */
+    int fd = -1;               /* descriptor backing the inflated input */
+    int nread;                 /* number of bytes inflated into the chunk */
+    int count;                 /* number of chars copied in snprintf */
+    ssize_t nwritten;          /* number of bytes written from the chunk */
+    gzFile gz = NULL;          /* handle for the compressed input */
+
+    *gz_fd = -1;
+
+    /* Create the memory-backed destination for the inflated bytes */
+#ifdef __linux__
+    fd = memfd_create ("espa_gzip_input", 0);
+#endif
+    if (fd < 0)
+    {   /* no memfd support, so fall back to a regular temp file */
+        count = snprintf (open_path, open_path_size, "%s/espa_gzip_XXXXXX",
+            getenv ("TMPDIR") ? getenv ("TMPDIR") : "/tmp");
+        if (count < 0 || count >= open_path_size)
+        {
+            sprintf (errmsg, "Overflow of open_path string");
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+        fd = mkstemp (open_path);
+        if (fd < 0)
+        {
+            sprintf (errmsg, "Creating a temp file for the inflated input");
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+    }
+    else
+    {
+        count = snprintf (open_path, open_path_size, "/proc/self/fd/%d", fd);
+        if (count < 0 || count >= open_path_size)
+        {
+            sprintf (errmsg, "Overflow of open_path string");
+            error_handler (true, FUNC_NAME, errmsg);
+            close (fd);
+            return (ERROR);
+        }
+    }
+
+    /* Inflate the input a chunk at a time */
+    chunk = malloc (GZIP_INPUT_CHUNK_BYTES);
+    if (chunk == NULL)
+    {
+        sprintf (errmsg, "Allocating the inflate chunk buffer");
+        error_handler (true, FUNC_NAME, errmsg);
+        close_gzip_input (fd, open_path);
+        return (ERROR);
+    }
+
+    gz = gzopen (gz_file, "rb");
+    if (gz == NULL)
+    {
+        sprintf (errmsg, "Opening the gzip-compressed input: %s", gz_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        free (chunk);
+        close_gzip_input (fd, open_path);
+        return (ERROR);
+    }
+    gzbuffer (gz, GZIP_INPUT_CHUNK_BYTES);
+
+    while ((nread = gzread (gz, chunk, GZIP_INPUT_CHUNK_BYTES)) > 0)
+    {
+        nwritten = write (fd, chunk, nread);
+        if (nwritten != nread)
+        {
+            sprintf (errmsg, "Writing the inflated input for: %s", gz_file);
+            error_handler (true, FUNC_NAME, errmsg);
+            gzclose (gz);
+            free (chunk);
+            close_gzip_input (fd, open_path);
+            return (ERROR);
+        }
+    }
+
+    if (nread < 0)
+    {
+        sprintf (errmsg, "Inflating the gzip-compressed input: %s", gz_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        gzclose (gz);
+        free (chunk);
+        close_gzip_input (fd, open_path);
+        return (ERROR);
+    }
+
+    gzclose (gz);
+    free (chunk);
+    *gz_fd = fd;
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  close_gzip_input
+
+PURPOSE: Releases the memory-backed inflated input.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void close_gzip_input
+(
+    int gz_fd,           /* I: descriptor from open_gzip_input */
+    char *open_path      /* I: path from open_gzip_input */
+)
+{
+    if (gz_fd < 0)
+        return;
+
+    /* The temp file fallback leaves a named file behind; the memfd path
+       under /proc/self/fd goes away with the descriptor */
+    if (strncmp (open_path, "/proc/self/fd/", strlen ("/proc/self/fd/")) != 0)
+        unlink (open_path);
+    close (gz_fd);
+}
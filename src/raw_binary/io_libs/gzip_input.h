@@ -0,0 +1,55 @@
+/*****************************************************************************
+FILE: gzip_input.h
+
+PURPOSE: Contains prototypes for consuming gzip-compressed input files
+through a memory-backed inflate layer.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The GeoTIFF and HDF4 readers need random access to their inputs, so a
+     gzip input cannot be streamed into them directly.  Instead the input
+     is inflated once into a memory-backed file and the readers open that,
+     which removes the temp-file write and re-read from disk that external
+     decompression costs.
+*****************************************************************************/
+
+#ifndef GZIP_INPUT_H
+#define GZIP_INPUT_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "error_handler.h"
+
+/* Prototypes */
+bool is_gzip_input
+(
+    char *file_name      /* I: input filename to be checked */
+);
+
+int open_gzip_input
+(
+    char *gz_file,       /* I: gzip-compressed input file */
+    char *open_path,     /* O: path the reader should open instead of the
+                               compressed file */
+    size_t open_path_size,  /* I: size of the open_path string */
+    int *gz_fd           /* O: descriptor backing the path, to be released
+                               with close_gzip_input */
+);
+
+void close_gzip_input
+(
+    int gz_fd,           /* I: descriptor from open_gzip_input */
+    char *open_path      /* I: path from open_gzip_input */
+);
+
+#endif
@@ -1,6 +1,6 @@
 /*****************************************************************************
 FILE: meta_stack.c
-  
+
 PURPOSE: Contains functions for handling the stack for storing ESPA internal
 metadata elements.
 
@@ -13,6 +13,9 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 12/23/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Replaced the fixed array of strings with a
+                              growable stack over a bump-allocated string
+                              arena, sized lazily on the first push
 
 NOTES:
 *****************************************************************************/
@@ -22,59 +25,49 @@ NOTES:
 /******************************************************************************
 MODULE:  init_stack
 
-PURPOSE:  Initializes memory for the stack of strings.
+PURPOSE:  Initializes the stack of strings.
 
 RETURN VALUE:
 Type = int
 Value           Description
 -----           -----------
-ERROR           Can't allocate memory for the stack
-SUCCESS         Memory was allocated and stack initialized successfully
+ERROR           Stack pointer was invalid
+SUCCESS         Stack initialized successfully
 
 HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 12/23/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     No memory is allocated up front any longer;
+                              the stack and arena grow on push as needed
 
 NOTES:
-  1. Uses the MAX_STACK_SIZE variable in meta_stack.h to specify the size
-     of the stack of strings.
+  1. Documents are commonly only a few levels deep, so the stack starts
+     empty and the first push allocates the initial slots and arena.
 ******************************************************************************/
 int init_stack
 (
-    int *top_of_stack,  /* I: pointer to top of the stack; zero-based */
-    char ***stack       /* I: pointer to the array of strings in the stack;
-                              memory will be allocated for this pointer */
+    Meta_stack_t *stack  /* I: stack to initialize; no memory is allocated
+                               until the first push */
 )
 {
     char FUNC_NAME[] = "init_stack";   /* function name */
     char errmsg[STR_SIZE];             /* error message */
-    int i;                             /* looping variable */
 
-    /* Allocate memory to hold MAX_STACK_SIZE strings */
-    *stack = calloc (MAX_STACK_SIZE, sizeof (char *));
-    if (*stack == NULL)
+    if (stack == NULL)
     {
-        sprintf (errmsg, "Allocating %d elements in the stack.",
-            MAX_STACK_SIZE);
+        sprintf (errmsg, "Invalid stack pointer.");
         error_handler (true, FUNC_NAME, errmsg);
         return (ERROR);
     }
 
-    /* Allocate memory for each of the strings in the array */
-    for (i = 0; i < MAX_STACK_SIZE; i++)
-    {
-        (*stack)[i] = calloc (STR_SIZE, sizeof (char));
-        if ((*stack)[i] == NULL)
-        {
-            sprintf (errmsg, "Allocating individual strings in the stack.");
-            error_handler (true, FUNC_NAME, errmsg);
-            return (ERROR);
-        }
-    }
-
-    /* Initialize the top of the stack such that it is empty */
-    *top_of_stack = -1;
+    /* Initialize the stack such that it is empty and unallocated */
+    stack->top = -1;
+    stack->nalloc = 0;
+    stack->offsets = NULL;
+    stack->arena = NULL;
+    stack->arena_used = 0;
+    stack->arena_alloc = 0;
 
     return (SUCCESS);
 }
@@ -92,27 +85,30 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 3/11/2014    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Frees the offset array and the string arena
+                              instead of the per-element strings
 
 NOTES:
-  1. Uses the MAX_STACK_SIZE variable in meta_stack.h to specify the size
-     of the stack of strings.
 ******************************************************************************/
 void free_stack
 (
-    char ***stack       /* I: pointer to the array of strings in the stack;
-                              memory will be freed for this pointer */
+    Meta_stack_t *stack  /* I: stack whose memory will be freed */
 )
 {
-    int i;                             /* looping variable */
-
-
-    /* Free memory for each of the strings in the array */
-    for (i = 0; i < MAX_STACK_SIZE; i++)
-        free ((*stack)[i]);
-
-    /* Free the stack pointer itself */
-    free (*stack);
-    *stack = NULL;
+    if (stack == NULL)
+        return;
+
+    /* Free the offset array and the string arena */
+    free (stack->offsets);
+    free (stack->arena);
+
+    /* Leave the stack empty and unallocated */
+    stack->top = -1;
+    stack->nalloc = 0;
+    stack->offsets = NULL;
+    stack->arena = NULL;
+    stack->arena_used = 0;
+    stack->arena_alloc = 0;
 }
 
 
@@ -125,54 +121,75 @@ RETURN VALUE:
 Type = int
 Value           Description
 -----           -----------
-ERROR           Stack is already full
+ERROR           Can't allocate memory to grow the stack
 SUCCESS         Successfully added the item to the stack
 
 HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 12/23/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Grow the stack and the string arena as needed
+                              and copy the string into the arena, instead of
+                              failing when the fixed size was exceeded
 
 NOTES:
+  1. The string is copied into the arena at the current bump pointer, so
+     each element only uses the bytes its name needs.
 ******************************************************************************/
 int push
 (
-    int *top_of_stack,    /* I/O: pointer to top of the stack; zero-based */
-    char **stack,         /* I/O: stack to push item to */
+    Meta_stack_t *stack,  /* I/O: stack to push item to */
     const char *strval    /* I: string to push on stack */
 )
 {
     char FUNC_NAME[] = "push";   /* function name */
     char errmsg[STR_SIZE];       /* error message */
-    int count;                   /* number of chars copied in snprintf */
-    int stack_top;               /* value for the top of the stack */
-
-    /* Capture the stack top */
-    stack_top = *top_of_stack;
+    char *new_arena = NULL;      /* reallocated string arena */
+    size_t *new_offsets = NULL;  /* reallocated offset array */
+    size_t len;                  /* length of the string, with terminator */
+    size_t new_alloc;            /* new allocation size */
 
-    /* If the stack isn't full, then add the item to the stack */
-    if (stack_top == MAX_STACK_SIZE - 1)
+    /* Grow the element slots if the stack is full */
+    if (stack->top == stack->nalloc - 1)
     {
-        sprintf (errmsg, "Stack is full. Can't add any additional items to "
-            "the stack. Failed to push %s.", strval);
-        error_handler (true, FUNC_NAME, errmsg);
-        return (ERROR);
+        new_alloc = stack->nalloc ? stack->nalloc * 2 : META_STACK_INIT_DEPTH;
+        new_offsets = realloc (stack->offsets,
+            new_alloc * sizeof (*stack->offsets));
+        if (new_offsets == NULL)
+        {
+            sprintf (errmsg, "Growing the stack to %d elements. Failed to "
+                "push %s.", (int) new_alloc, strval);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+        stack->offsets = new_offsets;
+        stack->nalloc = new_alloc;
     }
-    else
+
+    /* Grow the arena until the string fits */
+    len = strlen (strval) + 1;
+    if (stack->arena_used + len > stack->arena_alloc)
     {
-        stack_top++;
-        count = snprintf (stack[stack_top], STR_SIZE, "%s", strval);
-        if (count < 0 || count >= STR_SIZE)
+        new_alloc = stack->arena_alloc ? stack->arena_alloc :
+            META_STACK_INIT_ARENA;
+        while (stack->arena_used + len > new_alloc)
+            new_alloc *= 2;
+        new_arena = realloc (stack->arena, new_alloc);
+        if (new_arena == NULL)
         {
-            sprintf (errmsg, "Overflow of current stack string at top %d",
-                stack_top);
+            sprintf (errmsg, "Growing the stack arena to %d bytes. Failed "
+                "to push %s.", (int) new_alloc, strval);
             error_handler (true, FUNC_NAME, errmsg);
             return (ERROR);
         }
+        stack->arena = new_arena;
+        stack->arena_alloc = new_alloc;
     }
 
-    /* Update the stack top */
-    *top_of_stack = stack_top;
+    /* Copy the string to the bump pointer and record where it starts */
+    memcpy (&stack->arena[stack->arena_used], strval, len);
+    stack->offsets[++stack->top] = stack->arena_used;
+    stack->arena_used += len;
 
     return (SUCCESS);
 }
@@ -187,43 +204,40 @@ RETURN VALUE:
 Type = int
 Value           Description
 -----           -----------
-ERROR           Stack is empty 
+ERROR           Stack is empty
 SUCCESS         Successfully popped the item from the stack
 
 HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 12/23/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Return a pointer into the arena and rewind the
+                              bump pointer to reclaim the element's bytes
 
 NOTES:
+  1. The returned string lives in the arena and remains valid until the
+     next push, which matches the lifetime of the fixed stack slots this
+     replaced.
 ******************************************************************************/
 char *pop
 (
-    int *top_of_stack,    /* I/O: pointer to top of the stack; zero-based */
-    char **stack          /* I/O: stack to pop item from */
+    Meta_stack_t *stack   /* I/O: stack to pop item from */
 )
 {
     char FUNC_NAME[] = "pop";    /* function name */
     char errmsg[STR_SIZE];       /* error message */
-    int stack_top;               /* value for the top of the stack */
-
-    /* Capture the stack top */
-    stack_top = *top_of_stack;
 
     /* If the stack is empty, then return an error.  Otherwise pop the next
        item from the stack. */
-    if (stack_top == -1)
+    if (stack->top == -1)
     {
         sprintf (errmsg, "No more elements on the stack to pop.");
         error_handler (true, FUNC_NAME, errmsg);
         return NULL;
     }
-    else
-    {
-        /* Update the stack top to the value after we pop this one off */
-        *top_of_stack = stack_top-1;
 
-        return (stack[stack_top]);
-    }
+    /* Rewind the bump pointer so the next push reuses these bytes, and
+       return the popped string in place */
+    stack->arena_used = stack->offsets[stack->top];
+    return (&stack->arena[stack->offsets[stack->top--]]);
 }
-
@@ -1,6 +1,6 @@
 /*****************************************************************************
 FILE: meta_stack.h
-  
+
 PURPOSE: Contains related defines and structures for pushing and popping
 metadata node elements to the stack.
 
@@ -13,6 +13,9 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 12/23/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Replaced the fixed array of strings with a
+                              growable stack over a bump-allocated string
+                              arena, sized lazily on the first push
 
 NOTES:
 *****************************************************************************/
@@ -26,33 +29,47 @@ NOTES:
 #include "error_handler.h"
 
 /* Defines */
-#define MAX_STACK_SIZE 500
+/* Initial number of element slots in the stack; grows as needed */
+#define META_STACK_INIT_DEPTH 32
+
+/* Initial size of the string arena in bytes; grows as needed */
+#define META_STACK_INIT_ARENA 4096
+
+/* Stack of element name strings.  The names live back-to-back in the arena
+   and each element records the arena offset where its name starts, so the
+   stack grows with the actual name lengths instead of a fixed worst-case
+   allocation per element. */
+typedef struct
+{
+    int top;             /* index of the top element; -1 when empty */
+    int nalloc;          /* number of element slots allocated */
+    size_t *offsets;     /* arena byte offset of each element's name */
+    char *arena;         /* bump-allocated region holding the names */
+    size_t arena_used;   /* bytes of the arena in use */
+    size_t arena_alloc;  /* bytes allocated for the arena */
+} Meta_stack_t;
 
 /* Prototypes */
 int init_stack
 (
-    int *top_of_stack,  /* I: pointer to top of the stack; zero-based */
-    char ***stack       /* I: pointer to the array of strings in the stack;
-                              memory will be allocated for this pointer */
+    Meta_stack_t *stack  /* I: stack to initialize; no memory is allocated
+                               until the first push */
 );
 
 void free_stack
 (
-    char ***stack       /* I: pointer to the array of strings in the stack;
-                              memory will be freed for this pointer */
+    Meta_stack_t *stack  /* I: stack whose memory will be freed */
 );
 
 int push
 (
-    int *top_of_stack,    /* I/O: pointer to top of the stack; zero-based */
-    char **stack,         /* I/O: stack to push item to */
+    Meta_stack_t *stack,  /* I/O: stack to push item to */
     const char *strval    /* I: string to push on stack */
 );
 
 char *pop
 (
-    int *top_of_stack,    /* I/O: pointer to top of the stack; zero-based */
-    char **stack          /* I/O: stack to pop item from */
+    Meta_stack_t *stack   /* I/O: stack to pop item from */
 );
 
 #endif
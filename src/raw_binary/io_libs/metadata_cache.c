@@ -0,0 +1,500 @@
+/*****************************************************************************
+FILE: metadata_cache.c
+
+PURPOSE: Contains functions for reading/writing a binary sidecar cache of the
+parsed ESPA internal metadata structure.  Tools later in a conversion
+pipeline can load the metadata with a single read instead of repeating the
+full XML parse and schema validation for the same scene.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Carry the lazily-allocated QA description as a
+                              length-prefixed string after each band
+
+NOTES:
+  1. The cache is versioned with a magic number, a format version, the sizes
+     of the metadata structures, and the modification time of the source XML
+     file.  If any of these don't match, the cache is silently ignored and
+     the caller falls back to the XML parse.
+  2. The cache is host-specific (native byte order and structure layout);
+     it is a scratch artifact of the processing pipeline and is not intended
+     for delivery or cross-platform exchange.
+*****************************************************************************/
+
+#include <sys/stat.h>
+#include "metadata_cache.h"
+#include "parse_metadata.h"
+#include "espa_perf.h"
+
+/* Fixed-size header written at the front of the cache file */
+typedef struct
+{
+    unsigned int magic;         /* ESPA_META_CACHE_MAGIC */
+    unsigned int version;       /* ESPA_META_CACHE_VERSION */
+    unsigned int global_size;   /* sizeof (Espa_global_meta_t) */
+    unsigned int band_size;     /* sizeof (Espa_band_meta_t) */
+    long long xml_mtime;        /* modification time of the source XML file */
+    int nbands;                 /* number of bands in the cached metadata */
+} Espa_meta_cache_hdr_t;
+
+
+/******************************************************************************
+MODULE:  get_cache_filename (static)
+
+PURPOSE: Builds the sidecar cache file name for the specified XML file.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Cache file name overflows the output string
+SUCCESS         Cache file name was built
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static int get_cache_filename
+(
+    char *xml_file,       /* I: name of the source XML metadata file */
+    char *cache_file,     /* O: name of the sidecar cache file */
+    int cache_file_size   /* I: size of the cache_file string */
+)
+{
+    char FUNC_NAME[] = "get_cache_filename";   /* function name */
+    char errmsg[STR_SIZE];        /* error message */
+    int count;                    /* number of chars copied in snprintf */
+
+    count = snprintf (cache_file, cache_file_size, "%s%s", xml_file,
+        ESPA_META_CACHE_EXT);
+    if (count < 0 || count >= cache_file_size)
+    {
+        sprintf (errmsg, "Overflow of the cache file string for %s",
+            xml_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  write_metadata_cache
+
+PURPOSE: Writes the binary sidecar cache for the specified XML file from the
+already-parsed metadata structure.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error writing the cache file
+SUCCESS         Successfully wrote the cache file
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The cache is written beside the XML file with the .mcache extension.
+******************************************************************************/
+int write_metadata_cache
+(
+    char *xml_file,                 /* I: name of the source XML metadata
+                                          file; the cache is written beside
+                                          it with the .mcache extension */
+    Espa_internal_meta_t *metadata  /* I: metadata structure to be cached */
+)
+{
+    char FUNC_NAME[] = "write_metadata_cache";   /* function name */
+    char errmsg[STR_SIZE];        /* error message */
+    char cache_file[STR_SIZE];    /* name of the sidecar cache file */
+    int i, b;                     /* looping variables */
+    int desc_len;                 /* length of the QA description with the
+                                     terminator, or zero for none */
+    FILE *fptr = NULL;            /* cache file pointer */
+    struct stat statbuf;          /* buffer for the file stat function */
+    Espa_meta_cache_hdr_t hdr;    /* cache file header */
+    Espa_band_meta_t *bmeta = NULL;  /* pointer to current band metadata */
+
+    /* Stat the XML file to version the cache against its mtime */
+    if (stat (xml_file, &statbuf) == -1)
+    {
+        sprintf (errmsg, "Obtaining the modification time of XML file %s",
+            xml_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Build the cache file name and open it */
+    if (get_cache_filename (xml_file, cache_file, sizeof (cache_file)) !=
+        SUCCESS)
+    {   /* Error messages already printed */
+        return (ERROR);
+    }
+
+    fptr = fopen (cache_file, "wb");
+    if (fptr == NULL)
+    {
+        sprintf (errmsg, "Opening the metadata cache file for %s for writing",
+            xml_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Write the header */
+    hdr.magic = ESPA_META_CACHE_MAGIC;
+    hdr.version = ESPA_META_CACHE_VERSION;
+    hdr.global_size = sizeof (Espa_global_meta_t);
+    hdr.band_size = sizeof (Espa_band_meta_t);
+    hdr.xml_mtime = (long long) statbuf.st_mtime;
+    hdr.nbands = metadata->nbands;
+    if (fwrite (&hdr, sizeof (hdr), 1, fptr) != 1 ||
+        fwrite (metadata->meta_namespace, sizeof (metadata->meta_namespace),
+            1, fptr) != 1 ||
+        fwrite (&metadata->global, sizeof (metadata->global), 1, fptr) != 1)
+    {
+        sprintf (errmsg, "Writing the header of the metadata cache file for %s",
+            xml_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        fclose (fptr);
+        return (ERROR);
+    }
+
+    /* Write each band, followed by its variable-length bitmap descriptions,
+       class values, and QA description */
+    for (b = 0; b < metadata->nbands; b++)
+    {
+        bmeta = &metadata->band[b];
+        if (fwrite (bmeta, sizeof (Espa_band_meta_t), 1, fptr) != 1)
+        {
+            sprintf (errmsg, "Writing band %d to the metadata cache file for %s", b,
+                xml_file);
+            error_handler (true, FUNC_NAME, errmsg);
+            fclose (fptr);
+            return (ERROR);
+        }
+
+        for (i = 0; i < bmeta->nbits; i++)
+        {
+            if (fwrite (bmeta->bitmap_description[i], STR_SIZE, 1, fptr) != 1)
+            {
+                sprintf (errmsg, "Writing the bitmap description of band %d "
+                    "to the metadata cache file for %s", b, xml_file);
+                error_handler (true, FUNC_NAME, errmsg);
+                fclose (fptr);
+                return (ERROR);
+            }
+        }
+
+        if (bmeta->nclass > 0)
+        {
+            if (fwrite (bmeta->class_values, sizeof (Espa_class_t),
+                bmeta->nclass, fptr) != (size_t) bmeta->nclass)
+            {
+                sprintf (errmsg, "Writing the class values of band %d to "
+                    "the metadata cache file for %s", b, xml_file);
+                error_handler (true, FUNC_NAME, errmsg);
+                fclose (fptr);
+                return (ERROR);
+            }
+        }
+
+        /* Write the QA description as its length followed by the string;
+           the non-QA bands write just a zero length */
+        desc_len = (bmeta->qa_desc != NULL) ?
+            (int) strlen (bmeta->qa_desc) + 1 : 0;
+        if (fwrite (&desc_len, sizeof (desc_len), 1, fptr) != 1 ||
+            (desc_len > 0 &&
+             fwrite (bmeta->qa_desc, desc_len, 1, fptr) != 1))
+        {
+            sprintf (errmsg, "Writing the QA description of band %d to "
+                "the metadata cache file for %s", b, xml_file);
+            error_handler (true, FUNC_NAME, errmsg);
+            fclose (fptr);
+            return (ERROR);
+        }
+    }
+
+    fclose (fptr);
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  read_metadata_cache
+
+PURPOSE: Loads the metadata structure from the binary sidecar cache for the
+specified XML file, if a current cache exists.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Cache is missing, stale, or unreadable
+SUCCESS         Metadata structure was loaded from the cache
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. A missing or stale cache is not reported as an error so callers can
+     quietly fall back to the full XML parse.
+******************************************************************************/
+int read_metadata_cache
+(
+    char *xml_file,                 /* I: name of the source XML metadata
+                                          file whose sidecar cache should be
+                                          loaded */
+    Espa_internal_meta_t *metadata  /* O: metadata structure which has been
+                                          initialized via
+                                          init_metadata_struct */
+)
+{
+    char FUNC_NAME[] = "read_metadata_cache";   /* function name */
+    char errmsg[STR_SIZE];        /* error message */
+    char cache_file[STR_SIZE];    /* name of the sidecar cache file */
+    int i, b;                     /* looping variables */
+    int desc_len;                 /* length of the QA description with the
+                                     terminator, or zero for none */
+    FILE *fptr = NULL;            /* cache file pointer */
+    struct stat statbuf;          /* buffer for the file stat function */
+    Espa_meta_cache_hdr_t hdr;    /* cache file header */
+    Espa_band_meta_t *bmeta = NULL;  /* pointer to current band metadata */
+    char **saved_bitmap = NULL;   /* bitmap pointers to restore after the
+                                     band structure is overwritten */
+    Espa_class_t *saved_class = NULL;  /* class pointer to restore after the
+                                     band structure is overwritten */
+
+    /* Stat the XML file; the cache is only valid if it matches the current
+       XML modification time */
+    if (stat (xml_file, &statbuf) == -1)
+        return (ERROR);
+
+    /* Build the cache file name and open it; a missing cache is expected
+       for the first tool in a pipeline */
+    if (get_cache_filename (xml_file, cache_file, sizeof (cache_file)) !=
+        SUCCESS)
+    {   /* Error messages already printed */
+        return (ERROR);
+    }
+
+    fptr = fopen (cache_file, "rb");
+    if (fptr == NULL)
+        return (ERROR);
+
+    /* Read and verify the header */
+    if (fread (&hdr, sizeof (hdr), 1, fptr) != 1 ||
+        hdr.magic != ESPA_META_CACHE_MAGIC ||
+        hdr.version != ESPA_META_CACHE_VERSION ||
+        hdr.global_size != sizeof (Espa_global_meta_t) ||
+        hdr.band_size != sizeof (Espa_band_meta_t) ||
+        hdr.xml_mtime != (long long) statbuf.st_mtime ||
+        hdr.nbands < 0)
+    {
+        /* Cache is stale or from a different library build; ignore it */
+        fclose (fptr);
+        return (ERROR);
+    }
+
+    /* Read the namespace and global metadata */
+    if (fread (metadata->meta_namespace, sizeof (metadata->meta_namespace),
+            1, fptr) != 1 ||
+        fread (&metadata->global, sizeof (metadata->global), 1, fptr) != 1)
+    {
+        sprintf (errmsg, "Reading the header of the metadata cache file for %s",
+            xml_file);
+        error_handler (false, FUNC_NAME, errmsg);
+        fclose (fptr);
+        return (ERROR);
+    }
+
+    /* Allocate the band array and read each band */
+    if (allocate_band_metadata (metadata, hdr.nbands) != SUCCESS)
+    {   /* Error messages already printed */
+        fclose (fptr);
+        return (ERROR);
+    }
+
+    for (b = 0; b < hdr.nbands; b++)
+    {
+        bmeta = &metadata->band[b];
+        if (fread (bmeta, sizeof (Espa_band_meta_t), 1, fptr) != 1)
+        {
+            sprintf (errmsg, "Reading band %d from the metadata cache file for %s",
+                b, xml_file);
+            error_handler (false, FUNC_NAME, errmsg);
+            fclose (fptr);
+            return (ERROR);
+        }
+
+        /* The pointers in the cached band structure belonged to the writing
+           process; reallocate them in this process and read the contents */
+        saved_bitmap = NULL;
+        saved_class = NULL;
+        bmeta->bitmap_description = NULL;
+        bmeta->class_values = NULL;
+        bmeta->qa_desc = NULL;
+        bmeta->qa_desc_size = 0;
+        if (bmeta->nbits > 0)
+        {
+            i = bmeta->nbits;
+            bmeta->nbits = 0;
+            if (allocate_bitmap_metadata (bmeta, i) != SUCCESS)
+            {   /* Error messages already printed */
+                fclose (fptr);
+                return (ERROR);
+            }
+            saved_bitmap = bmeta->bitmap_description;
+
+            for (i = 0; i < bmeta->nbits; i++)
+            {
+                if (fread (saved_bitmap[i], STR_SIZE, 1, fptr) != 1)
+                {
+                    sprintf (errmsg, "Reading the bitmap description of "
+                        "band %d from the metadata cache file for %s", b, xml_file);
+                    error_handler (false, FUNC_NAME, errmsg);
+                    fclose (fptr);
+                    return (ERROR);
+                }
+            }
+        }
+
+        if (bmeta->nclass > 0)
+        {
+            i = bmeta->nclass;
+            bmeta->nclass = 0;
+            if (allocate_class_metadata (bmeta, i) != SUCCESS)
+            {   /* Error messages already printed */
+                fclose (fptr);
+                return (ERROR);
+            }
+            saved_class = bmeta->class_values;
+
+            if (fread (saved_class, sizeof (Espa_class_t), bmeta->nclass,
+                fptr) != (size_t) bmeta->nclass)
+            {
+                sprintf (errmsg, "Reading the class values of band %d from "
+                    "the metadata cache file for %s", b, xml_file);
+                error_handler (false, FUNC_NAME, errmsg);
+                fclose (fptr);
+                return (ERROR);
+            }
+        }
+
+        /* Read the QA description length and reallocate the string in this
+           process; a zero length means the band has no description */
+        if (fread (&desc_len, sizeof (desc_len), 1, fptr) != 1 ||
+            desc_len < 0)
+        {
+            sprintf (errmsg, "Reading the QA description length of band %d "
+                "from the metadata cache file for %s", b, xml_file);
+            error_handler (false, FUNC_NAME, errmsg);
+            fclose (fptr);
+            return (ERROR);
+        }
+
+        if (desc_len > 0)
+        {
+            bmeta->qa_desc = malloc (desc_len);
+            if (bmeta->qa_desc == NULL)
+            {
+                sprintf (errmsg, "Allocating the QA description of band %d "
+                    "from the metadata cache file for %s", b, xml_file);
+                error_handler (false, FUNC_NAME, errmsg);
+                fclose (fptr);
+                return (ERROR);
+            }
+            bmeta->qa_desc_size = desc_len;
+
+            if (fread (bmeta->qa_desc, desc_len, 1, fptr) != 1 ||
+                bmeta->qa_desc[desc_len - 1] != '\0')
+            {
+                sprintf (errmsg, "Reading the QA description of band %d "
+                    "from the metadata cache file for %s", b, xml_file);
+                error_handler (false, FUNC_NAME, errmsg);
+                fclose (fptr);
+                return (ERROR);
+            }
+        }
+    }
+
+    fclose (fptr);
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  parse_metadata_cached
+
+PURPOSE: Loads the metadata for the specified XML file from the sidecar
+cache when current, otherwise parses the XML and writes the cache for the
+next tool in the pipeline.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error parsing the metadata
+SUCCESS         Metadata structure was populated
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Count the cache hits and misses in the
+                              performance instrumentation
+
+NOTES:
+  1. A failure to write the cache is reported as a warning only; the parsed
+     metadata is still returned.
+******************************************************************************/
+int parse_metadata_cached
+(
+    char *xml_file,                 /* I: input metadata file */
+    Espa_internal_meta_t *metadata  /* O: metadata structure which has been
+                                          initialized via
+                                          init_metadata_struct */
+)
+{
+    char FUNC_NAME[] = "parse_metadata_cached";   /* function name */
+    char errmsg[STR_SIZE];        /* error message */
+
+    /* Use the sidecar cache if it's current */
+    if (read_metadata_cache (xml_file, metadata) == SUCCESS)
+    {
+        espa_perf_count ("metadata_cache_hit", 1);
+        return (SUCCESS);
+    }
+    espa_perf_count ("metadata_cache_miss", 1);
+
+    /* Fall back to the full XML parse */
+    if (parse_metadata (xml_file, metadata) != SUCCESS)
+    {   /* Error messages already printed */
+        return (ERROR);
+    }
+
+    /* Leave a cache behind for the next tool in the pipeline */
+    if (write_metadata_cache (xml_file, metadata) != SUCCESS)
+    {
+        sprintf (errmsg, "Unable to write the metadata cache for %s; "
+            "continuing with the parsed metadata", xml_file);
+        error_handler (false, FUNC_NAME, errmsg);
+    }
+
+    return (SUCCESS);
+}
@@ -0,0 +1,65 @@
+/*****************************************************************************
+FILE: metadata_cache.h
+
+PURPOSE: Contains defines and prototypes for reading/writing the binary
+sidecar cache of the ESPA internal metadata structure
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+
+#ifndef METADATA_CACHE_H
+#define METADATA_CACHE_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "error_handler.h"
+#include "espa_metadata.h"
+
+/* Magic number and version for the binary metadata cache file.  Bump the
+   version whenever the metadata structures change in a way that isn't
+   covered by the structure size checks. */
+#define ESPA_META_CACHE_MAGIC 0x4553504dU    /* "ESPM" */
+#define ESPA_META_CACHE_VERSION 1
+
+/* Extension appended to the XML file name for the sidecar cache file */
+#define ESPA_META_CACHE_EXT ".mcache"
+
+/* Prototypes */
+int write_metadata_cache
+(
+    char *xml_file,                 /* I: name of the source XML metadata
+                                          file; the cache is written beside
+                                          it with the .mcache extension */
+    Espa_internal_meta_t *metadata  /* I: metadata structure to be cached */
+);
+
+int read_metadata_cache
+(
+    char *xml_file,                 /* I: name of the source XML metadata
+                                          file whose sidecar cache should be
+                                          loaded */
+    Espa_internal_meta_t *metadata  /* O: metadata structure which has been
+                                          initialized via
+                                          init_metadata_struct */
+);
+
+int parse_metadata_cached
+(
+    char *xml_file,                 /* I: input metadata file */
+    Espa_internal_meta_t *metadata  /* O: metadata structure which has been
+                                          initialized via
+                                          init_metadata_struct */
+);
+
+#endif
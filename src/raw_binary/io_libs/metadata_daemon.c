@@ -0,0 +1,688 @@
+/*****************************************************************************
+FILE: metadata_daemon.c
+
+PURPOSE: Contains functions for the metadata validation/parsing daemon and
+its client helpers.  The daemon is a long-lived process which keeps libxml2
+and the compiled schema warm and hands back parsed metadata structures over
+a unix socket, so short-lived tools don't pay the libxml2 startup and schema
+compile cost on every invocation.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Carry the lazily-allocated QA description as a
+                              length-prefixed string after each band
+
+NOTES:
+  1. The response body uses the same host-specific layout as the metadata
+     sidecar cache (see metadata_cache.c): the namespace and global metadata
+     structures, then each band structure followed by its variable-length
+     bitmap descriptions, class values, and QA description.  The request and response carry
+     the structure sizes so a daemon and client from different library
+     builds refuse to talk to each other instead of exchanging garbage.
+  2. The daemon validates the XML against the schema before parsing, so a
+     successful daemon response covers both the validate_xml_file and
+     parse_metadata calls of the usual tool startup.
+  3. The client helpers quietly fall back to the in-process validate and
+     parse when ESPA_METADATA_DAEMON isn't set or the daemon can't be
+     reached, so tools behave the same with or without a daemon running.
+*****************************************************************************/
+
+#include <unistd.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "metadata_daemon.h"
+#include "parse_metadata.h"
+#include "espa_perf.h"
+
+/* Fixed-size request sent by the client, followed by path_len bytes of the
+   XML file path (not null terminated on the wire) */
+typedef struct
+{
+    unsigned int magic;         /* ESPA_META_DAEMON_MAGIC */
+    unsigned int version;       /* ESPA_META_DAEMON_VERSION */
+    unsigned int global_size;   /* sizeof (Espa_global_meta_t) */
+    unsigned int band_size;     /* sizeof (Espa_band_meta_t) */
+    int path_len;               /* number of bytes in the XML file path */
+} Espa_meta_daemon_req_t;
+
+/* Fixed-size response sent by the daemon, followed on SUCCESS by the
+   metadata body described in the file notes */
+typedef struct
+{
+    unsigned int magic;         /* ESPA_META_DAEMON_MAGIC */
+    int status;                 /* SUCCESS or ERROR */
+    int nbands;                 /* number of bands in the metadata body */
+} Espa_meta_daemon_rsp_t;
+
+
+/******************************************************************************
+MODULE:  read_full (static)
+
+PURPOSE: Reads the specified number of bytes from the socket, restarting
+after interrupts and short reads.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error or end of stream before all the bytes arrived
+SUCCESS         All the bytes were read
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static int read_full
+(
+    int fd,          /* I: socket to read from */
+    void *buf,       /* O: buffer for the bytes read */
+    size_t nbytes    /* I: number of bytes to read */
+)
+{
+    char *cbuf = buf;     /* current position in the buffer */
+    ssize_t nread;        /* number of bytes read by the current call */
+
+    while (nbytes > 0)
+    {
+        nread = read (fd, cbuf, nbytes);
+        if (nread < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return (ERROR);
+        }
+        if (nread == 0)
+        {   /* Peer closed the connection early */
+            return (ERROR);
+        }
+        cbuf += nread;
+        nbytes -= nread;
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  write_full (static)
+
+PURPOSE: Writes the specified number of bytes to the socket, restarting
+after interrupts and short writes.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error before all the bytes were written
+SUCCESS         All the bytes were written
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static int write_full
+(
+    int fd,           /* I: socket to write to */
+    const void *buf,  /* I: bytes to be written */
+    size_t nbytes     /* I: number of bytes to write */
+)
+{
+    const char *cbuf = buf;   /* current position in the buffer */
+    ssize_t nwritten;         /* number of bytes written by the current call */
+
+    while (nbytes > 0)
+    {
+        nwritten = write (fd, cbuf, nbytes);
+        if (nwritten < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return (ERROR);
+        }
+        cbuf += nwritten;
+        nbytes -= nwritten;
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  send_metadata_body (static)
+
+PURPOSE: Writes the metadata body to the socket in the sidecar cache layout.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error writing to the socket
+SUCCESS         Metadata body was written
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static int send_metadata_body
+(
+    int fd,                         /* I: socket to write to */
+    Espa_internal_meta_t *metadata  /* I: metadata structure to be sent */
+)
+{
+    int i, b;                     /* looping variables */
+    int desc_len;                 /* length of the QA description with the
+                                     terminator, or zero for none */
+    Espa_band_meta_t *bmeta = NULL;  /* pointer to current band metadata */
+
+    if (write_full (fd, metadata->meta_namespace,
+            sizeof (metadata->meta_namespace)) != SUCCESS ||
+        write_full (fd, &metadata->global, sizeof (metadata->global)) !=
+            SUCCESS)
+        return (ERROR);
+
+    for (b = 0; b < metadata->nbands; b++)
+    {
+        bmeta = &metadata->band[b];
+        if (write_full (fd, bmeta, sizeof (Espa_band_meta_t)) != SUCCESS)
+            return (ERROR);
+
+        for (i = 0; i < bmeta->nbits; i++)
+        {
+            if (write_full (fd, bmeta->bitmap_description[i], STR_SIZE) !=
+                SUCCESS)
+                return (ERROR);
+        }
+
+        if (bmeta->nclass > 0)
+        {
+            if (write_full (fd, bmeta->class_values,
+                (size_t) bmeta->nclass * sizeof (Espa_class_t)) != SUCCESS)
+                return (ERROR);
+        }
+
+        /* Send the QA description as its length followed by the string;
+           the non-QA bands send just a zero length */
+        desc_len = (bmeta->qa_desc != NULL) ?
+            (int) strlen (bmeta->qa_desc) + 1 : 0;
+        if (write_full (fd, &desc_len, sizeof (desc_len)) != SUCCESS)
+            return (ERROR);
+        if (desc_len > 0)
+        {
+            if (write_full (fd, bmeta->qa_desc, desc_len) != SUCCESS)
+                return (ERROR);
+        }
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  receive_metadata_body (static)
+
+PURPOSE: Reads the metadata body from the socket into the metadata
+structure, reallocating the per-band pointers in this process.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error reading from the socket or allocating memory
+SUCCESS         Metadata structure was populated
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static int receive_metadata_body
+(
+    int fd,                         /* I: socket to read from */
+    int nbands,                     /* I: number of bands in the body */
+    Espa_internal_meta_t *metadata  /* O: metadata structure which has been
+                                          initialized via
+                                          init_metadata_struct */
+)
+{
+    int i, b;                     /* looping variables */
+    int desc_len;                 /* length of the QA description with the
+                                     terminator, or zero for none */
+    Espa_band_meta_t *bmeta = NULL;  /* pointer to current band metadata */
+
+    if (read_full (fd, metadata->meta_namespace,
+            sizeof (metadata->meta_namespace)) != SUCCESS ||
+        read_full (fd, &metadata->global, sizeof (metadata->global)) !=
+            SUCCESS)
+        return (ERROR);
+
+    if (allocate_band_metadata (metadata, nbands) != SUCCESS)
+    {   /* Error messages already printed */
+        return (ERROR);
+    }
+
+    for (b = 0; b < nbands; b++)
+    {
+        bmeta = &metadata->band[b];
+        if (read_full (fd, bmeta, sizeof (Espa_band_meta_t)) != SUCCESS)
+            return (ERROR);
+
+        /* The pointers in the received band structure belonged to the
+           daemon; reallocate them in this process and read the contents */
+        bmeta->bitmap_description = NULL;
+        bmeta->class_values = NULL;
+        bmeta->qa_desc = NULL;
+        bmeta->qa_desc_size = 0;
+        if (bmeta->nbits > 0)
+        {
+            i = bmeta->nbits;
+            bmeta->nbits = 0;
+            if (allocate_bitmap_metadata (bmeta, i) != SUCCESS)
+            {   /* Error messages already printed */
+                return (ERROR);
+            }
+
+            for (i = 0; i < bmeta->nbits; i++)
+            {
+                if (read_full (fd, bmeta->bitmap_description[i], STR_SIZE) !=
+                    SUCCESS)
+                    return (ERROR);
+            }
+        }
+
+        if (bmeta->nclass > 0)
+        {
+            i = bmeta->nclass;
+            bmeta->nclass = 0;
+            if (allocate_class_metadata (bmeta, i) != SUCCESS)
+            {   /* Error messages already printed */
+                return (ERROR);
+            }
+
+            if (read_full (fd, bmeta->class_values,
+                (size_t) bmeta->nclass * sizeof (Espa_class_t)) != SUCCESS)
+                return (ERROR);
+        }
+
+        /* Read the QA description length and reallocate the string in this
+           process; a zero length means the band has no description */
+        if (read_full (fd, &desc_len, sizeof (desc_len)) != SUCCESS ||
+            desc_len < 0)
+            return (ERROR);
+        if (desc_len > 0)
+        {
+            bmeta->qa_desc = malloc (desc_len);
+            if (bmeta->qa_desc == NULL)
+                return (ERROR);
+            bmeta->qa_desc_size = desc_len;
+
+            if (read_full (fd, bmeta->qa_desc, desc_len) != SUCCESS ||
+                bmeta->qa_desc[desc_len - 1] != '\0')
+                return (ERROR);
+        }
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  serve_connection (static)
+
+PURPOSE: Handles one client connection: reads the request, validates and
+parses the XML file, and sends the metadata (or an error status) back.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Request failures are reported to the client via the response status;
+     the daemon itself keeps running.
+******************************************************************************/
+static void serve_connection
+(
+    int fd                /* I: connected client socket */
+)
+{
+    char FUNC_NAME[] = "serve_connection";   /* function name */
+    char errmsg[STR_SIZE];        /* error message */
+    char xml_file[STR_SIZE];      /* XML file path from the request */
+    Espa_meta_daemon_req_t req;   /* request from the client */
+    Espa_meta_daemon_rsp_t rsp;   /* response to the client */
+    Espa_internal_meta_t xml_metadata;  /* XML metadata structure */
+
+    rsp.magic = ESPA_META_DAEMON_MAGIC;
+    rsp.status = ERROR;
+    rsp.nbands = 0;
+
+    /* Read and verify the request; a client from a different library build
+       is refused via the structure size checks */
+    if (read_full (fd, &req, sizeof (req)) != SUCCESS)
+        return;
+    if (req.magic != ESPA_META_DAEMON_MAGIC ||
+        req.version != ESPA_META_DAEMON_VERSION ||
+        req.global_size != sizeof (Espa_global_meta_t) ||
+        req.band_size != sizeof (Espa_band_meta_t) ||
+        req.path_len <= 0 || req.path_len >= (int) sizeof (xml_file))
+    {
+        sprintf (errmsg, "Refusing a request with a mismatched protocol "
+            "version or structure sizes; the daemon and client library "
+            "builds need to match.");
+        error_handler (false, FUNC_NAME, errmsg);
+        write_full (fd, &rsp, sizeof (rsp));
+        return;
+    }
+
+    if (read_full (fd, xml_file, req.path_len) != SUCCESS)
+        return;
+    xml_file[req.path_len] = '\0';
+
+    /* Validate and parse the XML file with the warm libxml2 state; the
+       compiled schema is cached in-process by validate_xml_file */
+    if (validate_xml_file (xml_file) != SUCCESS)
+    {   /* Error messages already printed */
+        write_full (fd, &rsp, sizeof (rsp));
+        return;
+    }
+
+    init_metadata_struct (&xml_metadata);
+    if (parse_metadata (xml_file, &xml_metadata) != SUCCESS)
+    {   /* Error messages already printed */
+        write_full (fd, &rsp, sizeof (rsp));
+        return;
+    }
+
+    /* Send the metadata back */
+    rsp.status = SUCCESS;
+    rsp.nbands = xml_metadata.nbands;
+    if (write_full (fd, &rsp, sizeof (rsp)) != SUCCESS ||
+        send_metadata_body (fd, &xml_metadata) != SUCCESS)
+    {
+        sprintf (errmsg, "Sending the metadata for %.1024s to the client.",
+            xml_file);
+        error_handler (false, FUNC_NAME, errmsg);
+    }
+
+    free_metadata (&xml_metadata);
+}
+
+
+/******************************************************************************
+MODULE:  run_metadata_daemon
+
+PURPOSE: Runs the metadata daemon, serving validate-and-parse requests on
+the specified unix socket until the process is terminated.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error setting up the socket or accepting connections
+SUCCESS         Not returned; the daemon runs until terminated
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Connections are served one at a time.  The requests are short (one
+     validate and parse each), so a serial accept loop keeps the daemon
+     simple and the libxml2 state single-threaded.
+  2. A stale socket file from a previous daemon run is removed before
+     binding.
+******************************************************************************/
+int run_metadata_daemon
+(
+    char *socket_path     /* I: unix socket path for the daemon to listen on */
+)
+{
+    char FUNC_NAME[] = "run_metadata_daemon";   /* function name */
+    char errmsg[STR_SIZE];        /* error message */
+    int listen_fd;                /* listening socket */
+    int conn_fd;                  /* connected client socket */
+    struct sockaddr_un addr;      /* unix socket address */
+
+    if (strlen (socket_path) >= sizeof (addr.sun_path))
+    {
+        sprintf (errmsg, "Socket path is too long: %s", socket_path);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    listen_fd = socket (AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0)
+    {
+        sprintf (errmsg, "Creating the daemon socket.");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    memset (&addr, 0, sizeof (addr));
+    addr.sun_family = AF_UNIX;
+    strcpy (addr.sun_path, socket_path);
+    unlink (socket_path);
+    if (bind (listen_fd, (struct sockaddr *) &addr, sizeof (addr)) < 0)
+    {
+        sprintf (errmsg, "Binding the daemon socket to %s", socket_path);
+        error_handler (true, FUNC_NAME, errmsg);
+        close (listen_fd);
+        return (ERROR);
+    }
+
+    if (listen (listen_fd, 16) < 0)
+    {
+        sprintf (errmsg, "Listening on the daemon socket %s", socket_path);
+        error_handler (true, FUNC_NAME, errmsg);
+        close (listen_fd);
+        return (ERROR);
+    }
+
+    printf ("Metadata daemon listening on %s\n", socket_path);
+    while (1)
+    {
+        conn_fd = accept (listen_fd, NULL, NULL);
+        if (conn_fd < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            sprintf (errmsg, "Accepting a connection on the daemon socket "
+                "%s", socket_path);
+            error_handler (true, FUNC_NAME, errmsg);
+            close (listen_fd);
+            return (ERROR);
+        }
+
+        serve_connection (conn_fd);
+        close (conn_fd);
+    }
+}
+
+
+/******************************************************************************
+MODULE:  parse_metadata_via_daemon
+
+PURPOSE: Obtains the validated, parsed metadata for the specified XML file
+from a running metadata daemon.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           No daemon is configured or reachable, or the request failed
+SUCCESS         Metadata structure was populated by the daemon
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. An unset ESPA_METADATA_DAEMON or an unreachable daemon is not reported
+     as an error so callers can quietly fall back to the in-process
+     validate and parse.
+  2. The XML file path is resolved to an absolute path before it is sent,
+     since the daemon's working directory is unrelated to the client's.
+******************************************************************************/
+int parse_metadata_via_daemon
+(
+    char *xml_file,                 /* I: input metadata file */
+    Espa_internal_meta_t *metadata  /* O: metadata structure which has been
+                                          initialized via
+                                          init_metadata_struct */
+)
+{
+    char FUNC_NAME[] = "parse_metadata_via_daemon";   /* function name */
+    char errmsg[STR_SIZE];        /* error message */
+    char *socket_path = NULL;     /* daemon socket path from the env */
+    char abs_path[STR_SIZE];      /* absolute path of the XML file */
+    int conn_fd;                  /* connected daemon socket */
+    struct sockaddr_un addr;      /* unix socket address */
+    Espa_meta_daemon_req_t req;   /* request to the daemon */
+    Espa_meta_daemon_rsp_t rsp;   /* response from the daemon */
+
+    /* No daemon configured; the caller falls back */
+    socket_path = getenv (ESPA_META_DAEMON_ENV);
+    if (socket_path == NULL || socket_path[0] == '\0' ||
+        strlen (socket_path) >= sizeof (addr.sun_path))
+        return (ERROR);
+
+    /* Resolve the XML file path for the daemon */
+    if (realpath (xml_file, abs_path) == NULL)
+        return (ERROR);
+
+    /* Connect to the daemon */
+    conn_fd = socket (AF_UNIX, SOCK_STREAM, 0);
+    if (conn_fd < 0)
+        return (ERROR);
+
+    memset (&addr, 0, sizeof (addr));
+    addr.sun_family = AF_UNIX;
+    strcpy (addr.sun_path, socket_path);
+    if (connect (conn_fd, (struct sockaddr *) &addr, sizeof (addr)) < 0)
+    {   /* Daemon isn't running; the caller falls back */
+        close (conn_fd);
+        return (ERROR);
+    }
+
+    /* Send the request */
+    req.magic = ESPA_META_DAEMON_MAGIC;
+    req.version = ESPA_META_DAEMON_VERSION;
+    req.global_size = sizeof (Espa_global_meta_t);
+    req.band_size = sizeof (Espa_band_meta_t);
+    req.path_len = strlen (abs_path);
+    if (write_full (conn_fd, &req, sizeof (req)) != SUCCESS ||
+        write_full (conn_fd, abs_path, req.path_len) != SUCCESS)
+    {
+        close (conn_fd);
+        return (ERROR);
+    }
+
+    /* Read and verify the response */
+    if (read_full (conn_fd, &rsp, sizeof (rsp)) != SUCCESS ||
+        rsp.magic != ESPA_META_DAEMON_MAGIC)
+    {
+        close (conn_fd);
+        return (ERROR);
+    }
+
+    if (rsp.status != SUCCESS || rsp.nbands < 0)
+    {   /* Daemon reported the validate/parse failure on its side */
+        sprintf (errmsg, "Metadata daemon failed to validate and parse %.1024s; "
+            "check the daemon log.", abs_path);
+        error_handler (false, FUNC_NAME, errmsg);
+        close (conn_fd);
+        return (ERROR);
+    }
+
+    if (receive_metadata_body (conn_fd, rsp.nbands, metadata) != SUCCESS)
+    {
+        sprintf (errmsg, "Receiving the metadata for %.1024s from the daemon.",
+            abs_path);
+        error_handler (false, FUNC_NAME, errmsg);
+        close (conn_fd);
+        return (ERROR);
+    }
+
+    close (conn_fd);
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  validate_and_parse_metadata
+
+PURPOSE: Validates and parses the specified XML file, using a running
+metadata daemon when one is configured and falling back to the in-process
+validate and parse otherwise.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error validating or parsing the metadata
+SUCCESS         Metadata structure was populated
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. This is the startup helper for the tools: one call covers both
+     validate_xml_file and parse_metadata, and it transparently uses the
+     daemon when ESPA_METADATA_DAEMON points at a running one.
+******************************************************************************/
+int validate_and_parse_metadata
+(
+    char *xml_file,                 /* I: input metadata file */
+    Espa_internal_meta_t *metadata  /* O: metadata structure which has been
+                                          initialized via
+                                          init_metadata_struct */
+)
+{
+    /* Use the daemon when one is configured and reachable; a successful
+       daemon response covers the schema validation as well */
+    if (parse_metadata_via_daemon (xml_file, metadata) == SUCCESS)
+    {
+        espa_perf_count ("metadata_daemon_hit", 1);
+        return (SUCCESS);
+    }
+    espa_perf_count ("metadata_daemon_miss", 1);
+
+    /* Fall back to the in-process validate and parse */
+    if (validate_xml_file (xml_file) != SUCCESS)
+    {   /* Error messages already printed */
+        return (ERROR);
+    }
+
+    if (parse_metadata (xml_file, metadata) != SUCCESS)
+    {   /* Error messages already printed */
+        return (ERROR);
+    }
+
+    return (SUCCESS);
+}
@@ -0,0 +1,62 @@
+/*****************************************************************************
+FILE: metadata_daemon.h
+
+PURPOSE: Contains defines and prototypes for the metadata validation/parsing
+daemon and its client helpers
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+
+#ifndef METADATA_DAEMON_H
+#define METADATA_DAEMON_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "error_handler.h"
+#include "espa_metadata.h"
+
+/* Magic number and version for the daemon protocol.  Bump the version
+   whenever the request/response layout changes in a way that isn't covered
+   by the structure size checks. */
+#define ESPA_META_DAEMON_MAGIC 0x45535044U    /* "ESPD" */
+#define ESPA_META_DAEMON_VERSION 1
+
+/* Environment variable holding the unix socket path of a running daemon;
+   when it isn't set the client helpers quietly fall back to the in-process
+   validate and parse */
+#define ESPA_META_DAEMON_ENV "ESPA_METADATA_DAEMON"
+
+/* Prototypes */
+int run_metadata_daemon
+(
+    char *socket_path     /* I: unix socket path for the daemon to listen on */
+);
+
+int parse_metadata_via_daemon
+(
+    char *xml_file,                 /* I: input metadata file */
+    Espa_internal_meta_t *metadata  /* O: metadata structure which has been
+                                          initialized via
+                                          init_metadata_struct */
+);
+
+int validate_and_parse_metadata
+(
+    char *xml_file,                 /* I: input metadata file */
+    Espa_internal_meta_t *metadata  /* O: metadata structure which has been
+                                          initialized via
+                                          init_metadata_struct */
+);
+
+#endif
@@ -0,0 +1,504 @@
+/*****************************************************************************
+FILE: multi_band_io.c
+
+PURPOSE: Contains functions for reading several raw binary band files of a
+product as one virtual multi-band image with interleaved (BIL-style) lines.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added a standalone open from the bands' ENVI
+                              headers, with no XML metadata needed
+
+NOTES:
+  1. Each band's window is read with a single preadv which scatters the
+     lines straight into their interleaved positions in the caller's
+     buffer, so a window costs one syscall per band instead of a seek and
+     read per band per line.
+  2. After each window is read the next window is hinted to the kernel
+     with posix_fadvise, so the read-ahead of all the bands overlaps the
+     caller's computation on the current window.
+*****************************************************************************/
+
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include "envi_header.h"
+#include "multi_band_io.h"
+
+/* number of iovec entries passed to one preadv call; kept well under
+   IOV_MAX and sized so a chunk covers a typical window of lines */
+#define MULTI_BAND_IOV_CHUNK 512
+
+/******************************************************************************
+MODULE: multi_band_pixel_size (static)
+
+PURPOSE: Determines the number of bytes per pixel for a band data type.
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+-1           Unsupported data type
+> 0          Number of bytes per pixel
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+static int multi_band_pixel_size
+(
+    int data_type        /* I: data type of the band (Espa_data_type) */
+)
+{
+    switch (data_type)
+    {
+        case ESPA_INT8:
+        case ESPA_UINT8: return 1;
+        case ESPA_INT16:
+        case ESPA_UINT16: return 2;
+        case ESPA_INT32:
+        case ESPA_UINT32:
+        case ESPA_FLOAT32: return 4;
+        case ESPA_FLOAT64: return 8;
+        default: return -1;
+    }
+}
+
+
+/******************************************************************************
+MODULE: open_multi_band
+
+PURPOSE: Opens the raw binary files of the named bands as one virtual
+multi-band view for interleaved line reads.
+
+RETURN VALUE:
+Type = Espa_multi_band_t *
+Value        Description
+-----        -----------
+NULL         Error opening the multi-band view
+non-NULL     Pointer to the opened view
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. All the named bands must exist in the metadata and share the same
+     dimensions and data type.
+  2. Memory is allocated for the returned view; use close_multi_band to
+     close the band files and release it.
+******************************************************************************/
+Espa_multi_band_t *open_multi_band
+(
+    Espa_internal_meta_t *metadata,  /* I: metadata for the product */
+    int nbands,                      /* I: number of bands in the view */
+    char **band_names                /* I: array of nbands band names to be
+                                           included, in interleave order */
+)
+{
+    char FUNC_NAME[] = "open_multi_band";  /* function name */
+    char errmsg[STR_SIZE];       /* error message */
+    int b;                       /* band loop counter */
+    int band_indx;               /* index of the current band */
+    Espa_multi_band_t *multi_band = NULL;  /* view being set up */
+    Espa_band_meta_t *bmeta = NULL;        /* metadata of the current band */
+
+    /* Validate the band count */
+    if (nbands < 1 || nbands > ESPA_MULTI_BAND_MAX)
+    {
+        sprintf (errmsg, "Multi-band views support 1 to %d bands; %d were "
+            "requested.", ESPA_MULTI_BAND_MAX, nbands);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (NULL);
+    }
+
+    /* Allocate the view */
+    multi_band = calloc (1, sizeof (Espa_multi_band_t));
+    if (multi_band == NULL)
+    {
+        sprintf (errmsg, "Allocating the multi-band view.");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (NULL);
+    }
+
+    /* Open each band, verifying the bands are compatible with the first */
+    for (b = 0; b < nbands; b++)
+    {
+        band_indx = find_band_index (metadata, band_names[b]);
+        if (band_indx < 0)
+        {
+            sprintf (errmsg, "Band '%s' not found in the XML structure.",
+                band_names[b]);
+            error_handler (true, FUNC_NAME, errmsg);
+            goto error;
+        }
+        bmeta = &metadata->band[band_indx];
+
+        if (b == 0)
+        {
+            multi_band->nlines = bmeta->nlines;
+            multi_band->nsamps = bmeta->nsamps;
+            multi_band->size = multi_band_pixel_size (bmeta->data_type);
+            if (multi_band->size < 0)
+            {
+                sprintf (errmsg, "Unsupported data type for band '%s'.",
+                    band_names[b]);
+                error_handler (true, FUNC_NAME, errmsg);
+                goto error;
+            }
+        }
+        else if (bmeta->nlines != multi_band->nlines ||
+                 bmeta->nsamps != multi_band->nsamps ||
+                 multi_band_pixel_size (bmeta->data_type) != multi_band->size)
+        {
+            sprintf (errmsg, "Band '%s' does not match the dimensions or "
+                "data type of band '%s'; all the bands of a multi-band view "
+                "must match.", band_names[b], band_names[0]);
+            error_handler (true, FUNC_NAME, errmsg);
+            goto error;
+        }
+
+        multi_band->fd[b] = open (bmeta->file_name, O_RDONLY);
+        if (multi_band->fd[b] < 0)
+        {
+            sprintf (errmsg, "Opening raw binary file %.1024s with read access.",
+                bmeta->file_name);
+            error_handler (true, FUNC_NAME, errmsg);
+            goto error;
+        }
+        multi_band->nbands++;
+    }
+
+    return (multi_band);
+
+error:
+    close_multi_band (multi_band);
+    return (NULL);
+}
+
+
+/******************************************************************************
+MODULE: envi_pixel_size (static)
+
+PURPOSE: Determines the number of bytes per pixel for an ENVI data type
+code.
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+-1           Unsupported data type
+> 0          Number of bytes per pixel
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+static int envi_pixel_size
+(
+    int data_type        /* I: ENVI data type code from the header */
+)
+{
+    switch (data_type)
+    {
+        case 1: return 1;              /* 8-bit byte */
+        case 2: case 12: return 2;     /* 16-bit integers */
+        case 3: case 13: case 4: return 4;  /* 32-bit integers and float */
+        case 5: return 8;              /* 64-bit double */
+        default: return -1;
+    }
+}
+
+
+/******************************************************************************
+MODULE: open_multi_band_files
+
+PURPOSE: Opens the named raw binary files as one virtual multi-band view,
+taking the dimensions and data type from each band's ENVI header so no XML
+metadata is needed.
+
+RETURN VALUE:
+Type = Espa_multi_band_t *
+Value        Description
+-----        -----------
+NULL         Error opening the multi-band view
+non-NULL     Pointer to the opened view
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Each band's header is expected alongside its image file with a .hdr
+     extension, as written by write_envi_hdr.
+  2. All the bands must share the same dimensions and data type, and the
+     headers must not declare a data offset.
+  3. Memory is allocated for the returned view; use close_multi_band to
+     close the band files and release it.
+******************************************************************************/
+Espa_multi_band_t *open_multi_band_files
+(
+    int nbands,          /* I: number of bands in the view */
+    char **img_files     /* I: array of nbands raw binary file names to be
+                               included, in interleave order */
+)
+{
+    char FUNC_NAME[] = "open_multi_band_files";  /* function name */
+    char errmsg[STR_SIZE];       /* error message */
+    char hdr_file[STR_SIZE];     /* name of the current ENVI header file */
+    char *cptr = NULL;           /* pointer to the file extension */
+    int b;                       /* band loop counter */
+    int count;                   /* number of chars copied in snprintf */
+    int size;                    /* bytes per pixel of the current band */
+    Espa_multi_band_t *multi_band = NULL;  /* view being set up */
+    Envi_header_t envi_hdr;      /* ENVI header of the current band */
+
+    /* Validate the band count */
+    if (nbands < 1 || nbands > ESPA_MULTI_BAND_MAX)
+    {
+        sprintf (errmsg, "Multi-band views support 1 to %d bands; %d were "
+            "requested.", ESPA_MULTI_BAND_MAX, nbands);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (NULL);
+    }
+
+    /* Allocate the view */
+    multi_band = calloc (1, sizeof (Espa_multi_band_t));
+    if (multi_band == NULL)
+    {
+        sprintf (errmsg, "Allocating the multi-band view.");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (NULL);
+    }
+
+    /* Open each band, taking its geometry from the ENVI header alongside
+       the image file and verifying the bands are compatible with the
+       first */
+    for (b = 0; b < nbands; b++)
+    {
+        count = snprintf (hdr_file, sizeof (hdr_file), "%s", img_files[b]);
+        if (count < 0 || count >= sizeof (hdr_file))
+        {
+            sprintf (errmsg, "Overflow of hdr_file string");
+            error_handler (true, FUNC_NAME, errmsg);
+            goto error;
+        }
+        cptr = strrchr (hdr_file, '.');
+        if (cptr != NULL)
+            strcpy (cptr, ".hdr");
+        else
+            strcat (hdr_file, ".hdr");
+
+        if (read_envi_hdr (hdr_file, &envi_hdr) != SUCCESS)
+        {
+            sprintf (errmsg, "Reading the ENVI header for %s.", img_files[b]);
+            error_handler (true, FUNC_NAME, errmsg);
+            goto error;
+        }
+        if (envi_hdr.header_offset != 0)
+        {
+            sprintf (errmsg, "Band file %s declares a data offset of %d "
+                "bytes; multi-band views only support bands without a data "
+                "offset.", img_files[b], envi_hdr.header_offset);
+            error_handler (true, FUNC_NAME, errmsg);
+            goto error;
+        }
+
+        size = envi_pixel_size (envi_hdr.data_type);
+        if (size < 0)
+        {
+            sprintf (errmsg, "Unsupported data type for band file %s.",
+                img_files[b]);
+            error_handler (true, FUNC_NAME, errmsg);
+            goto error;
+        }
+
+        if (b == 0)
+        {
+            multi_band->nlines = envi_hdr.nlines;
+            multi_band->nsamps = envi_hdr.nsamps;
+            multi_band->size = size;
+        }
+        else if (envi_hdr.nlines != multi_band->nlines ||
+                 envi_hdr.nsamps != multi_band->nsamps ||
+                 size != multi_band->size)
+        {
+            sprintf (errmsg, "Band file %s does not match the dimensions or "
+                "data type of band file %s; all the bands of a multi-band "
+                "view must match.", img_files[b], img_files[0]);
+            error_handler (true, FUNC_NAME, errmsg);
+            goto error;
+        }
+
+        multi_band->fd[b] = open (img_files[b], O_RDONLY);
+        if (multi_band->fd[b] < 0)
+        {
+            sprintf (errmsg, "Opening raw binary file %.1024s with read access.",
+                img_files[b]);
+            error_handler (true, FUNC_NAME, errmsg);
+            goto error;
+        }
+        multi_band->nbands++;
+    }
+
+    return (multi_band);
+
+error:
+    close_multi_band (multi_band);
+    return (NULL);
+}
+
+
+/******************************************************************************
+MODULE: read_multi_band_lines
+
+PURPOSE: Reads a window of lines from every band of the view, interleaved
+so each output line holds one line of each band in view order (BIL).
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+ERROR        An error occurred reading from one of the band files
+SUCCESS      Reading was successful
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The window of each band is read with one preadv which scatters the
+     lines into their interleaved positions in the output buffer.
+  2. The window following the one just read is hinted to the kernel for
+     read-ahead of every band, so sequential consumers overlap the next
+     window's I/O with their computation.
+******************************************************************************/
+int read_multi_band_lines
+(
+    Espa_multi_band_t *multi_band,   /* I: multi-band view to read from */
+    int start_line,     /* I: first line of the window (0-based) */
+    int nlines,         /* I: number of lines to read from each band */
+    void *img_array     /* O: interleaved output of nlines * nbands * nsamps
+                              * size bytes; each line holds one line of each
+                              band in view order (BIL) */
+)
+{
+    char FUNC_NAME[] = "read_multi_band_lines";  /* function name */
+    char errmsg[STR_SIZE];       /* error message */
+    int b;                       /* band loop counter */
+    int line;                    /* first line of the current iovec chunk */
+    int chunk_lines;             /* lines in the current iovec chunk */
+    int i;                       /* looping variable */
+    size_t line_bytes;           /* number of bytes per band line */
+    ssize_t nbytes;              /* number of bytes read by preadv */
+    off_t offset;                /* band file offset of the current chunk */
+    unsigned char *buf = img_array;  /* output buffer position */
+    struct iovec iov[MULTI_BAND_IOV_CHUNK];  /* scatter list for preadv */
+
+    /* Validate the window */
+    if (start_line < 0 || nlines < 1 ||
+        start_line + nlines > multi_band->nlines)
+    {
+        sprintf (errmsg, "Window of lines %d to %d is not contained in the "
+            "%d lines of the bands.", start_line, start_line + nlines - 1,
+            multi_band->nlines);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    line_bytes = (size_t) multi_band->nsamps * multi_band->size;
+
+    /* Read the window of each band, scattering the lines into their
+       interleaved positions in the output buffer */
+    for (b = 0; b < multi_band->nbands; b++)
+    {
+        for (line = 0; line < nlines; line += chunk_lines)
+        {
+            chunk_lines = nlines - line;
+            if (chunk_lines > MULTI_BAND_IOV_CHUNK)
+                chunk_lines = MULTI_BAND_IOV_CHUNK;
+
+            for (i = 0; i < chunk_lines; i++)
+            {
+                iov[i].iov_base = buf +
+                    ((size_t) (line + i) * multi_band->nbands + b) *
+                    line_bytes;
+                iov[i].iov_len = line_bytes;
+            }
+
+            offset = (off_t) (start_line + line) * line_bytes;
+            nbytes = preadv (multi_band->fd[b], iov, chunk_lines, offset);
+            if (nbytes != (ssize_t) chunk_lines * (ssize_t) line_bytes)
+            {
+                sprintf (errmsg, "Reading lines %d to %d of band %d of the "
+                    "multi-band view.", start_line + line,
+                    start_line + line + chunk_lines - 1, b);
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
+            }
+        }
+
+        /* Hint the next window to the kernel so its read-ahead overlaps
+           the caller's work on this window */
+        if (start_line + nlines < multi_band->nlines)
+        {
+            chunk_lines = multi_band->nlines - (start_line + nlines);
+            if (chunk_lines > nlines)
+                chunk_lines = nlines;
+            posix_fadvise (multi_band->fd[b],
+                (off_t) (start_line + nlines) * line_bytes,
+                (off_t) chunk_lines * line_bytes, POSIX_FADV_WILLNEED);
+        }
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE: close_multi_band
+
+PURPOSE: Closes the band files of a multi-band view and releases it.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+void close_multi_band
+(
+    Espa_multi_band_t *multi_band    /* I: multi-band view to be closed */
+)
+{
+    int b;                       /* band loop counter */
+
+    if (multi_band == NULL)
+        return;
+
+    for (b = 0; b < multi_band->nbands; b++)
+        close (multi_band->fd[b]);
+
+    free (multi_band);
+}
@@ -0,0 +1,87 @@
+/*****************************************************************************
+FILE: multi_band_io.h
+
+PURPOSE: Contains defines and prototypes for the virtual multi-band reader,
+which opens several raw binary band files of a product at once and reads
+them as interleaved (BIL-style) lines.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added a standalone open from the bands' ENVI
+                              headers, with no XML metadata needed
+
+NOTES:
+  1. ESPA products store one .img file per band, so consumers working with
+     several bands at once (e.g. computing an index from two bands) pay a
+     seek per band per window.  The multi-band reader batches the reads of
+     all the bands for a window of lines and prefetches the next window,
+     so the per-band seeks overlap instead of serializing.
+  2. All the bands of a view must share the same dimensions and data type.
+  3. open_multi_band_files opens the bands from their ENVI headers alone,
+     so standalone utilities can set up a view in microseconds without
+     parsing the product XML.
+*****************************************************************************/
+
+#ifndef MULTI_BAND_IO_H
+#define MULTI_BAND_IO_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "error_handler.h"
+#include "espa_metadata.h"
+
+/* maximum number of bands in one multi-band view */
+#define ESPA_MULTI_BAND_MAX 16
+
+/* State for one multi-band view.  The fields are managed by the
+   open/read/close functions below and should be treated as read-only by
+   the caller. */
+typedef struct
+{
+    int nbands;              /* number of bands in the view */
+    int nlines;              /* number of lines in each band */
+    int nsamps;              /* number of samples per line in each band */
+    int size;                /* number of bytes per pixel */
+    int fd[ESPA_MULTI_BAND_MAX];  /* descriptor of each open band file */
+} Espa_multi_band_t;
+
+/* Prototypes */
+Espa_multi_band_t *open_multi_band
+(
+    Espa_internal_meta_t *metadata,  /* I: metadata for the product */
+    int nbands,                      /* I: number of bands in the view */
+    char **band_names                /* I: array of nbands band names to be
+                                           included, in interleave order */
+);
+
+Espa_multi_band_t *open_multi_band_files
+(
+    int nbands,          /* I: number of bands in the view */
+    char **img_files     /* I: array of nbands raw binary file names to be
+                               included, in interleave order */
+);
+
+int read_multi_band_lines
+(
+    Espa_multi_band_t *multi_band,   /* I: multi-band view to read from */
+    int start_line,     /* I: first line of the window (0-based) */
+    int nlines,         /* I: number of lines to read from each band */
+    void *img_array     /* O: interleaved output of nlines * nbands * nsamps
+                              * size bytes; each line holds one line of each
+                              band in view order (BIL) */
+);
+
+void close_multi_band
+(
+    Espa_multi_band_t *multi_band    /* I: multi-band view to be closed */
+);
+
+#endif
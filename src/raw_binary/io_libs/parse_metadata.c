@@ -20,7 +20,15 @@ Date         Programmer       Reason
                               gain/bias, and K1/K2 constants. Changed
                               toa_gain/bias to rad_gain/bias to be consistent
                               with refl_gain/bias.
-
+8/31/2026    Gail Schmidt     Dispatch on element name tokens instead of
+                              string comparison chains, and reuse the parser
+                              context across files
+8/31/2026    Gail Schmidt     Intern the projection metadata into the
+                              shared segment when enabled
+8/31/2026    Gail Schmidt     Mark the XML parse as a startup phase for the
+                              cold-start profile
+8/31/2026    Gail Schmidt     Store the QA description through the
+                              lazily-allocated band accessor
 
 NOTES:
   1. The XML metadata format parsed or written via this library follows the
@@ -30,7 +38,215 @@ NOTES:
   2. This code relies on the libxml2 library developed for the Gnome project.
 *****************************************************************************/
 
+#include <pthread.h>
 #include "espa_metadata.h"
+#include "espa_perf.h"
+#include "espa_startup.h"
+#include "espa_xml_init.h"
+#include "espa_meta_intern.h"
+
+/* Tokens for the element names of the ESPA metadata schema.  The token
+   values match the position of each name in elem_names below, with zero
+   reserved for names which are not part of the schema. */
+typedef enum
+{
+    ESPA_ELEM_UNKNOWN = 0,
+    ESPA_ELEM_ACQUISITION_DATE,
+    ESPA_ELEM_ALBERS_PROJ_PARAMS,
+    ESPA_ELEM_APP_VERSION,
+    ESPA_ELEM_BAND,
+    ESPA_ELEM_BANDS,
+    ESPA_ELEM_BIT,
+    ESPA_ELEM_BITMAP_DESCRIPTION,
+    ESPA_ELEM_BOUNDING_COORDINATES,
+    ESPA_ELEM_BYTE_ORDER,
+    ESPA_ELEM_CALIBRATED_NT,
+    ESPA_ELEM_CENTRAL_MERIDIAN,
+    ESPA_ELEM_CHECKSUM,
+    ESPA_ELEM_CLASS,
+    ESPA_ELEM_CLASS_VALUES,
+    ESPA_ELEM_CORNER,
+    ESPA_ELEM_CORNER_POINT,
+    ESPA_ELEM_DATA_PROVIDER,
+    ESPA_ELEM_DATA_UNITS,
+    ESPA_ELEM_EARTH_SUN_DISTANCE,
+    ESPA_ELEM_EAST,
+    ESPA_ELEM_FALSE_EASTING,
+    ESPA_ELEM_FALSE_NORTHING,
+    ESPA_ELEM_FILE_NAME,
+    ESPA_ELEM_GLOBAL_METADATA,
+    ESPA_ELEM_GRID_ORIGIN,
+    ESPA_ELEM_INSTRUMENT,
+    ESPA_ELEM_LATITUDE_TRUE_SCALE,
+    ESPA_ELEM_LEVEL1_PRODUCTION_DATE,
+    ESPA_ELEM_LONG_NAME,
+    ESPA_ELEM_LONGITUDE_POLE,
+    ESPA_ELEM_LPGS_METADATA_FILE,
+    ESPA_ELEM_MODIS,
+    ESPA_ELEM_NORTH,
+    ESPA_ELEM_ORIENTATION_ANGLE,
+    ESPA_ELEM_ORIGIN_LATITUDE,
+    ESPA_ELEM_PIXEL_SIZE,
+    ESPA_ELEM_PRODUCTION_DATE,
+    ESPA_ELEM_PROJECTION_INFORMATION,
+    ESPA_ELEM_PS_PROJ_PARAMS,
+    ESPA_ELEM_QA_DESCRIPTION,
+    ESPA_ELEM_RADIANCE,
+    ESPA_ELEM_REFLECTANCE,
+    ESPA_ELEM_RESAMPLE_METHOD,
+    ESPA_ELEM_SATELLITE,
+    ESPA_ELEM_SCENE_CENTER_TIME,
+    ESPA_ELEM_SHORT_NAME,
+    ESPA_ELEM_SIN_PROJ_PARAMS,
+    ESPA_ELEM_SOLAR_ANGLES,
+    ESPA_ELEM_SOUTH,
+    ESPA_ELEM_SPHERE_RADIUS,
+    ESPA_ELEM_STANDARD_PARALLEL1,
+    ESPA_ELEM_STANDARD_PARALLEL2,
+    ESPA_ELEM_STATISTICS,
+    ESPA_ELEM_THERMAL_CONST,
+    ESPA_ELEM_UTM_PROJ_PARAMS,
+    ESPA_ELEM_VALID_RANGE,
+    ESPA_ELEM_WEST,
+    ESPA_ELEM_WRS,
+    ESPA_ELEM_ZONE_CODE,
+} Espa_elem_token_t;
+
+/* Element names of the ESPA metadata schema, in token order */
+static const char *elem_names[] =
+{
+    NULL, "acquisition_date", "albers_proj_params", "app_version", "band",
+    "bands", "bit", "bitmap_description", "bounding_coordinates",
+    "byte_order", "calibrated_nt", "central_meridian", "checksum", "class",
+    "class_values", "corner", "corner_point", "data_provider", "data_units",
+    "earth_sun_distance", "east", "false_easting", "false_northing",
+    "file_name", "global_metadata", "grid_origin", "instrument",
+    "latitude_true_scale", "level1_production_date", "long_name",
+    "longitude_pole", "lpgs_metadata_file", "modis", "north",
+    "orientation_angle", "origin_latitude", "pixel_size", "production_date",
+    "projection_information", "ps_proj_params", "qa_description", "radiance",
+    "reflectance", "resample_method", "satellite", "scene_center_time",
+    "short_name", "sin_proj_params", "solar_angles", "south", "sphere_radius",
+    "standard_parallel1", "standard_parallel2", "statistics", "thermal_const",
+    "utm_proj_params", "valid_range", "west", "wrs", "zone_code"
+};
+
+/* number of slots in the element name hash; a power of two which is more
+   than twice the element count so the probe chains stay short */
+#define ELEM_HASH_SIZE 256
+
+static unsigned char elem_hash[ELEM_HASH_SIZE]; /* token per slot; zero marks
+                                                   an empty slot */
+static pthread_once_t elem_hash_once = PTHREAD_ONCE_INIT;  /* one-time build
+                                                   of the element name hash */
+
+/******************************************************************************
+MODULE:  elem_name_hash (static)
+
+PURPOSE:  Hashes an element name for the element token lookup.
+
+RETURN VALUE:
+Type = unsigned int
+Value           Description
+-----           -----------
+any             Hash of the element name
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static unsigned int elem_name_hash
+(
+    const char *name          /* I: element name to be hashed */
+)
+{
+    unsigned int hash = 5381;     /* djb2 hash seed */
+    int c;                        /* current character */
+
+    while ((c = (unsigned char) *name++) != 0)
+        hash = hash * 33 + c;
+
+    return (hash);
+}
+
+
+/******************************************************************************
+MODULE:  build_elem_hash (static)
+
+PURPOSE:  Builds the element name hash, run once per process through
+pthread_once.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static void build_elem_hash (void)
+{
+    int i;                        /* looping variable */
+    int slot;                     /* current hash slot */
+    int ntokens = sizeof (elem_names) / sizeof (elem_names[0]);
+                                  /* number of tokens, including UNKNOWN */
+
+    for (i = 1; i < ntokens; i++)
+    {
+        slot = elem_name_hash (elem_names[i]) & (ELEM_HASH_SIZE - 1);
+        while (elem_hash[slot] != 0)
+            slot = (slot + 1) & (ELEM_HASH_SIZE - 1);
+        elem_hash[slot] = i;
+    }
+}
+
+
+/******************************************************************************
+MODULE:  espa_element_token (static)
+
+PURPOSE:  Looks up the token for an element name, so the element dispatch
+chains compare integers instead of strings.
+
+RETURN VALUE:
+Type = Espa_elem_token_t
+Value               Description
+-----               -----------
+ESPA_ELEM_UNKNOWN   Element name is not part of the schema element set
+other               Token for the element name
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The element name is hashed once per node, replacing the string
+     comparison per candidate element of the dispatch chains.
+******************************************************************************/
+static Espa_elem_token_t espa_element_token
+(
+    const xmlChar *name       /* I: element name from the current node */
+)
+{
+    int slot;                     /* current hash slot */
+
+    pthread_once (&elem_hash_once, build_elem_hash);
+    slot = elem_name_hash ((const char *) name) & (ELEM_HASH_SIZE - 1);
+    while (elem_hash[slot] != 0)
+    {
+        if (!strcmp (elem_names[elem_hash[slot]], (const char *) name))
+            return ((Espa_elem_token_t) elem_hash[slot]);
+        slot = (slot + 1) & (ELEM_HASH_SIZE - 1);
+    }
+
+    return (ESPA_ELEM_UNKNOWN);
+}
+
 
 /******************************************************************************
 MODULE:  add_global_metadata_proj_info_albers
@@ -49,6 +265,8 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 12/26/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Dispatch on element name tokens instead of
+                              string comparisons
 
 NOTES:
 ******************************************************************************/
@@ -62,6 +280,7 @@ int add_global_metadata_proj_info_albers
     char errmsg[STR_SIZE];        /* error message */
     xmlNode *cur_node = NULL;     /* pointer to the current node */
     xmlNode *child_node = NULL;   /* pointer to the child node */
+    int elem_token;               /* token for the current element name */
 
     /* Make sure the projection type specified matches the projection
        parameters type */
@@ -75,14 +294,14 @@ int add_global_metadata_proj_info_albers
     }
 
     /* Process the siblings in the projection information */
-    for (cur_node = a_node->children; cur_node;
+    for (cur_node = xmlFirstElementChild (a_node); cur_node;
          cur_node = xmlNextElementSibling (cur_node))
     {
         /* Set up the child pointer */
         child_node = cur_node->children;
+        elem_token = espa_element_token (cur_node->name);
 
-        if (xmlStrEqual (cur_node->name,
-            (const xmlChar *) "standard_parallel1"))
+        if (elem_token == ESPA_ELEM_STANDARD_PARALLEL1)
         {
             /* Expect the child node to be a text node containing the value of
                this field */
@@ -100,8 +319,7 @@ int add_global_metadata_proj_info_albers
             gmeta->proj_info.standard_parallel1 =
                 atof ((const char *) child_node->content);
         }
-        else if (xmlStrEqual (cur_node->name,
-            (const xmlChar *) "standard_parallel2"))
+        else if (elem_token == ESPA_ELEM_STANDARD_PARALLEL2)
         {
             /* Expect the child node to be a text node containing the value of
                this field */
@@ -119,8 +337,7 @@ int add_global_metadata_proj_info_albers
             gmeta->proj_info.standard_parallel2 =
                 atof ((const char *) child_node->content);
         }
-        else if (xmlStrEqual (cur_node->name,
-            (const xmlChar *) "central_meridian"))
+        else if (elem_token == ESPA_ELEM_CENTRAL_MERIDIAN)
         {
             /* Expect the child node to be a text node containing the value of
                this field */
@@ -138,8 +355,7 @@ int add_global_metadata_proj_info_albers
             gmeta->proj_info.central_meridian =
                 atof ((const char *) child_node->content);
         }
-        else if (xmlStrEqual (cur_node->name,
-            (const xmlChar *) "origin_latitude"))
+        else if (elem_token == ESPA_ELEM_ORIGIN_LATITUDE)
         {
             /* Expect the child node to be a text node containing the value of
                this field */
@@ -157,8 +373,7 @@ int add_global_metadata_proj_info_albers
             gmeta->proj_info.origin_latitude =
                 atof ((const char *) child_node->content);
         }
-        else if (xmlStrEqual (cur_node->name,
-            (const xmlChar *) "false_easting"))
+        else if (elem_token == ESPA_ELEM_FALSE_EASTING)
         {
             /* Expect the child node to be a text node containing the value of
                this field */
@@ -176,8 +391,7 @@ int add_global_metadata_proj_info_albers
             gmeta->proj_info.false_easting =
                 atof ((const char *) child_node->content);
         }
-        else if (xmlStrEqual (cur_node->name,
-            (const xmlChar *) "false_northing"))
+        else if (elem_token == ESPA_ELEM_FALSE_NORTHING)
         {
             /* Expect the child node to be a text node containing the value of
                this field */
@@ -224,6 +438,8 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 12/26/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Dispatch on element name tokens instead of
+                              string comparisons
 
 NOTES:
 ******************************************************************************/
@@ -237,6 +453,7 @@ int add_global_metadata_proj_info_ps
     char errmsg[STR_SIZE];        /* error message */
     xmlNode *cur_node = NULL;     /* pointer to the current node */
     xmlNode *child_node = NULL;   /* pointer to the child node */
+    int elem_token;               /* token for the current element name */
 
     /* Make sure the projection type specified matches the projection
        parameters type */
@@ -249,13 +466,14 @@ int add_global_metadata_proj_info_ps
     }
 
     /* Process the siblings in the projection information */
-    for (cur_node = a_node->children; cur_node;
+    for (cur_node = xmlFirstElementChild (a_node); cur_node;
          cur_node = xmlNextElementSibling (cur_node))
     {
         /* Set up the child pointer */
         child_node = cur_node->children;
+        elem_token = espa_element_token (cur_node->name);
 
-        if (xmlStrEqual (cur_node->name, (const xmlChar *) "longitude_pole"))
+        if (elem_token == ESPA_ELEM_LONGITUDE_POLE)
         {
             /* Expect the child node to be a text node containing the value of
                this field */
@@ -273,8 +491,7 @@ int add_global_metadata_proj_info_ps
             gmeta->proj_info.longitude_pole =
                 atof ((const char *) child_node->content);
         }
-        else if (xmlStrEqual (cur_node->name,
-            (const xmlChar *) "latitude_true_scale"))
+        else if (elem_token == ESPA_ELEM_LATITUDE_TRUE_SCALE)
         {
             /* Expect the child node to be a text node containing the value of
                this field */
@@ -292,8 +509,7 @@ int add_global_metadata_proj_info_ps
             gmeta->proj_info.latitude_true_scale =
                 atof ((const char *) child_node->content);
         }
-        else if (xmlStrEqual (cur_node->name,
-            (const xmlChar *) "false_easting"))
+        else if (elem_token == ESPA_ELEM_FALSE_EASTING)
         {
             /* Expect the child node to be a text node containing the value of
                this field */
@@ -311,8 +527,7 @@ int add_global_metadata_proj_info_ps
             gmeta->proj_info.false_easting =
                 atof ((const char *) child_node->content);
         }
-        else if (xmlStrEqual (cur_node->name,
-            (const xmlChar *) "false_northing"))
+        else if (elem_token == ESPA_ELEM_FALSE_NORTHING)
         {
             /* Expect the child node to be a text node containing the value of
                this field */
@@ -359,6 +574,8 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 4/17/2014    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Dispatch on element name tokens instead of
+                              string comparisons
 
 NOTES:
 ******************************************************************************/
@@ -372,6 +589,7 @@ int add_global_metadata_proj_info_sin
     char errmsg[STR_SIZE];        /* error message */
     xmlNode *cur_node = NULL;     /* pointer to the current node */
     xmlNode *child_node = NULL;   /* pointer to the child node */
+    int elem_token;               /* token for the current element name */
 
     /* Make sure the projection type specified matches the projection
        parameters type */
@@ -385,13 +603,14 @@ int add_global_metadata_proj_info_sin
     }
 
     /* Process the siblings in the projection information */
-    for (cur_node = a_node->children; cur_node;
+    for (cur_node = xmlFirstElementChild (a_node); cur_node;
          cur_node = xmlNextElementSibling (cur_node))
     {
         /* Set up the child pointer */
         child_node = cur_node->children;
+        elem_token = espa_element_token (cur_node->name);
 
-        if (xmlStrEqual (cur_node->name, (const xmlChar *) "sphere_radius"))
+        if (elem_token == ESPA_ELEM_SPHERE_RADIUS)
         {
             /* Expect the child node to be a text node containing the value of
                this field */
@@ -409,8 +628,7 @@ int add_global_metadata_proj_info_sin
             gmeta->proj_info.sphere_radius =
                 atof ((const char *) child_node->content);
         }
-        else if (xmlStrEqual (cur_node->name,
-            (const xmlChar *) "central_meridian"))
+        else if (elem_token == ESPA_ELEM_CENTRAL_MERIDIAN)
         {
             /* Expect the child node to be a text node containing the value of
                this field */
@@ -428,8 +646,7 @@ int add_global_metadata_proj_info_sin
             gmeta->proj_info.central_meridian =
                 atof ((const char *) child_node->content);
         }
-        else if (xmlStrEqual (cur_node->name,
-            (const xmlChar *) "false_easting"))
+        else if (elem_token == ESPA_ELEM_FALSE_EASTING)
         {
             /* Expect the child node to be a text node containing the value of
                this field */
@@ -447,8 +664,7 @@ int add_global_metadata_proj_info_sin
             gmeta->proj_info.false_easting =
                 atof ((const char *) child_node->content);
         }
-        else if (xmlStrEqual (cur_node->name,
-            (const xmlChar *) "false_northing"))
+        else if (elem_token == ESPA_ELEM_FALSE_NORTHING)
         {
             /* Expect the child node to be a text node containing the value of
                this field */
@@ -521,7 +737,7 @@ int add_global_metadata_proj_info_utm
     }
 
     /* Set up the current and child pointers */
-    cur_node = a_node->children;
+    cur_node = xmlFirstElementChild (a_node);
     child_node = cur_node->children;
 
     /* Process the zone code for UTM */
@@ -571,6 +787,8 @@ Date         Programmer       Reason
 12/26/2013   Gail Schmidt     Original development
 4/17/2014    Gail Schmidt     Added support for additional projections
 4/22/2014    Gail Schmidt     Added support for additional datums
+8/31/2026    Gail Schmidt     Dispatch on element name tokens instead of
+                              string comparisons
 
 NOTES:
 ******************************************************************************/
@@ -585,6 +803,7 @@ int add_global_metadata_proj_info
     xmlAttrPtr attr = NULL;       /* pointer to the element attributes */
     xmlNode *cur_node = NULL;     /* pointer to the current node */
     xmlNode *child_node = NULL;   /* pointer to the child node */
+    int elem_token;               /* token for the current element name */
     xmlNsPtr ns = NULL;           /* pointer to the namespace */
     xmlChar *attr_val = NULL;     /* attribute value */
     bool is_ul = false;           /* is this the UL corner */
@@ -594,12 +813,12 @@ int add_global_metadata_proj_info
 
     /* Set up the current and child pointers */
     cur_node = a_node;
-    ns = cur_node->nsDef;
+    ns = cur_node->ns ? cur_node->ns : cur_node->nsDef;
     child_node = cur_node->children;
 
     /* Verify the namespace of this node is our ESPA namespace.  If it isn't
        then the element won't be added to the metadata structure. */
-    if (!xmlStrEqual (ns->href, (const xmlChar *) ESPA_NS))
+    if (ns == NULL || !xmlStrEqual (ns->href, (const xmlChar *) ESPA_NS))
     {
         sprintf (errmsg, "Skipping %s since it is not in the ESPA namespace",
             cur_node->name);
@@ -657,15 +876,16 @@ int add_global_metadata_proj_info
     }
 
     /* Process the siblings in the projection information */
-    for (cur_node = a_node->children; cur_node;
+    for (cur_node = xmlFirstElementChild (a_node); cur_node;
          cur_node = xmlNextElementSibling (cur_node))
     {
         /* Set up the child pointer */
         child_node = cur_node->children;
+        elem_token = espa_element_token (cur_node->name);
 
         /* Check for the element nodes within the projection_information
            element */
-        if (xmlStrEqual (cur_node->name, (const xmlChar *) "corner_point"))
+        if (elem_token == ESPA_ELEM_CORNER_POINT)
         {
             /* Handle the element attributes */
             x = -9999.0;
@@ -713,7 +933,7 @@ int add_global_metadata_proj_info
                 gmeta->proj_info.lr_corner[1] = y;
             }
         }
-        else if (xmlStrEqual (cur_node->name, (const xmlChar *) "grid_origin"))
+        else if (elem_token == ESPA_ELEM_GRID_ORIGIN)
         {
             /* Expect the child node to be a text node containing the value of
                this field */
@@ -737,8 +957,7 @@ int add_global_metadata_proj_info
                 return (ERROR);
             }
         }
-        else if (xmlStrEqual (cur_node->name,
-            (const xmlChar *) "utm_proj_params"))
+        else if (elem_token == ESPA_ELEM_UTM_PROJ_PARAMS)
         {
             /* Handle the projection-specific parameters */
             if (add_global_metadata_proj_info_utm (cur_node, gmeta))
@@ -749,8 +968,7 @@ int add_global_metadata_proj_info
                 return (ERROR);
             }
         }
-        else if (xmlStrEqual (cur_node->name,
-            (const xmlChar *) "ps_proj_params"))
+        else if (elem_token == ESPA_ELEM_PS_PROJ_PARAMS)
         {
             /* Handle the projection-specific parameters */
             if (add_global_metadata_proj_info_ps (cur_node, gmeta))
@@ -761,8 +979,7 @@ int add_global_metadata_proj_info
                 return (ERROR);
             }
         }
-        else if (xmlStrEqual (cur_node->name,
-            (const xmlChar *) "albers_proj_params"))
+        else if (elem_token == ESPA_ELEM_ALBERS_PROJ_PARAMS)
         {
             /* Handle the projection-specific parameters */
             if (add_global_metadata_proj_info_albers (cur_node, gmeta))
@@ -773,8 +990,7 @@ int add_global_metadata_proj_info
                 return (ERROR);
             }
         }
-        else if (xmlStrEqual (cur_node->name,
-            (const xmlChar *) "sin_proj_params"))
+        else if (elem_token == ESPA_ELEM_SIN_PROJ_PARAMS)
         {
             /* Handle the projection-specific parameters */
             if (add_global_metadata_proj_info_sin (cur_node, gmeta))
@@ -813,6 +1029,8 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 12/26/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Dispatch on element name tokens instead of
+                              string comparisons
 
 NOTES:
 ******************************************************************************/
@@ -831,12 +1049,12 @@ int add_global_metadata_bounding_coords
 
     /* Set up the current and child pointers */
     cur_node = a_node;
-    ns = cur_node->nsDef;
+    ns = cur_node->ns ? cur_node->ns : cur_node->nsDef;
     child_node = cur_node->children;
 
     /* Verify the namespace of this node is our ESPA namespace.  If it isn't
        then the element won't be added to the metadata structure. */
-    if (!xmlStrEqual (ns->href, (const xmlChar *) ESPA_NS))
+    if (ns == NULL || !xmlStrEqual (ns->href, (const xmlChar *) ESPA_NS))
     {
         sprintf (errmsg, "Skipping %s since it is not in the ESPA namespace",
             cur_node->name);
@@ -847,18 +1065,25 @@ int add_global_metadata_bounding_coords
     /* Look for the ESPA global metadata bounding coordinates elements and
        process them */
     indx = 0;
-    if (xmlStrEqual (cur_node->name, (const xmlChar *) "west"))
-        indx = ESPA_WEST;
-    else if (xmlStrEqual (cur_node->name, (const xmlChar *) "east"))
-        indx = ESPA_EAST;
-    else if (xmlStrEqual (cur_node->name, (const xmlChar *) "north"))
-        indx = ESPA_NORTH;
-    else if (xmlStrEqual (cur_node->name, (const xmlChar *) "south"))
-        indx = ESPA_SOUTH;
-    else
+    switch (espa_element_token (cur_node->name))
     {
-        sprintf (errmsg, "Unknown bounding coords element: %s", cur_node->name);
-        error_handler (false, FUNC_NAME, errmsg);
+        case ESPA_ELEM_WEST:
+            indx = ESPA_WEST;
+            break;
+        case ESPA_ELEM_EAST:
+            indx = ESPA_EAST;
+            break;
+        case ESPA_ELEM_NORTH:
+            indx = ESPA_NORTH;
+            break;
+        case ESPA_ELEM_SOUTH:
+            indx = ESPA_SOUTH;
+            break;
+        default:
+            sprintf (errmsg, "Unknown bounding coords element: %s",
+                cur_node->name);
+            error_handler (false, FUNC_NAME, errmsg);
+            break;
     }
 
     /* Expect the child node to be a text node containing the value of
@@ -893,6 +1118,8 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 12/26/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Dispatch on element name tokens instead of
+                              string comparisons
 
 NOTES:
 ******************************************************************************/
@@ -907,6 +1134,7 @@ int add_global_metadata
     xmlAttrPtr attr = NULL;       /* pointer to the element attributes */
     xmlNode *cur_node = NULL;     /* pointer to the current node */
     xmlNode *child_node = NULL;   /* pointer to the child node */
+    int elem_token;               /* token for the current element name */
     xmlNsPtr ns = NULL;           /* pointer to the namespace */
     xmlChar *attr_val = NULL;     /* attribute value */
     bool is_ul = false;           /* is this the UL corner */
@@ -916,12 +1144,12 @@ int add_global_metadata
 
     /* Set up the current and child pointers */
     cur_node = a_node;
-    ns = cur_node->nsDef;
+    ns = cur_node->ns ? cur_node->ns : cur_node->nsDef;
     child_node = cur_node->children;
 
     /* Verify the namespace of this node is our ESPA namespace.  If it isn't
        then the element won't be added to the metadata structure. */
-    if (!xmlStrEqual (ns->href, (const xmlChar *) ESPA_NS))
+    if (ns == NULL || !xmlStrEqual (ns->href, (const xmlChar *) ESPA_NS))
     {
         sprintf (errmsg, "Skipping %s since it is not in the ESPA namespace",
             cur_node->name);
@@ -930,7 +1158,8 @@ int add_global_metadata
     }
 
     /* Look for the ESPA global metadata elements and process them */
-    if (xmlStrEqual (cur_node->name, (const xmlChar *) "data_provider"))
+    elem_token = espa_element_token (cur_node->name);
+    if (elem_token == ESPA_ELEM_DATA_PROVIDER)
     {
         /* Expect the child node to be a text node containing the value of
            this field */
@@ -952,7 +1181,7 @@ int add_global_metadata
             return (ERROR);
         }
     }
-    else if (xmlStrEqual (cur_node->name, (const xmlChar *) "satellite"))
+    else if (elem_token == ESPA_ELEM_SATELLITE)
     {
         /* Expect the child node to be a text node containing the value of
            this field */
@@ -974,7 +1203,7 @@ int add_global_metadata
             return (ERROR);
         }
     }
-    else if (xmlStrEqual (cur_node->name, (const xmlChar *) "instrument"))
+    else if (elem_token == ESPA_ELEM_INSTRUMENT)
     {
         /* Expect the child node to be a text node containing the value of
            this field */
@@ -996,7 +1225,7 @@ int add_global_metadata
             return (ERROR);
         }
     }
-    else if (xmlStrEqual (cur_node->name, (const xmlChar *) "acquisition_date"))
+    else if (elem_token == ESPA_ELEM_ACQUISITION_DATE)
     {
         /* Expect the child node to be a text node containing the value of
            this field */
@@ -1019,8 +1248,7 @@ int add_global_metadata
             return (ERROR);
         }
     }
-    else if (xmlStrEqual (cur_node->name,
-        (const xmlChar *) "scene_center_time"))
+    else if (elem_token == ESPA_ELEM_SCENE_CENTER_TIME)
     {
         /* Expect the child node to be a text node containing the value of
            this field */
@@ -1043,8 +1271,7 @@ int add_global_metadata
             return (ERROR);
         }
     }
-    else if (xmlStrEqual (cur_node->name,
-        (const xmlChar *) "level1_production_date"))
+    else if (elem_token == ESPA_ELEM_LEVEL1_PRODUCTION_DATE)
     {
         /* Expect the child node to be a text node containing the value of
            this field */
@@ -1067,7 +1294,7 @@ int add_global_metadata
             return (ERROR);
         }
     }
-    else if (xmlStrEqual (cur_node->name, (const xmlChar *) "solar_angles"))
+    else if (elem_token == ESPA_ELEM_SOLAR_ANGLES)
     {
         /* Handle the element attributes */
         for (attr = cur_node->properties; attr != NULL; attr = attr->next)
@@ -1097,8 +1324,7 @@ int add_global_metadata
             xmlFree (attr_val);
         }
     }
-    else if (xmlStrEqual (cur_node->name,
-        (const xmlChar *) "earth_sun_distance"))
+    else if (elem_token == ESPA_ELEM_EARTH_SUN_DISTANCE)
     {
         /* Expect the child node to be a text node containing the value of
            this field */
@@ -1113,7 +1339,7 @@ int add_global_metadata
         /* Copy the content of the child node into the value for this field */
         gmeta->earth_sun_dist = atof ((const char *) child_node->content);
     }
-    else if (xmlStrEqual (cur_node->name, (const xmlChar *) "wrs"))
+    else if (elem_token == ESPA_ELEM_WRS)
     {
         /* Handle the element attributes */
         for (attr = cur_node->properties; attr != NULL; attr = attr->next)
@@ -1134,7 +1360,7 @@ int add_global_metadata
             xmlFree (attr_val);
         }
     }
-    else if (xmlStrEqual (cur_node->name, (const xmlChar *) "modis"))
+    else if (elem_token == ESPA_ELEM_MODIS)
     {
         /* Handle the element attributes */
         for (attr = cur_node->properties; attr != NULL; attr = attr->next)
@@ -1153,8 +1379,7 @@ int add_global_metadata
             xmlFree (attr_val);
         }
     }
-    else if (xmlStrEqual (cur_node->name,
-        (const xmlChar *) "lpgs_metadata_file"))
+    else if (elem_token == ESPA_ELEM_LPGS_METADATA_FILE)
     {
         /* Expect the child node to be a text node containing the value of
            this field */
@@ -1177,7 +1402,7 @@ int add_global_metadata
             return (ERROR);
         }
     }
-    else if (xmlStrEqual (cur_node->name, (const xmlChar *) "corner"))
+    else if (elem_token == ESPA_ELEM_CORNER)
     {
         /* Handle the element attributes */
         latitude = -9999.0;
@@ -1225,11 +1450,10 @@ int add_global_metadata
             gmeta->lr_corner[1] = longitude;
         }
     }
-    else if (xmlStrEqual (cur_node->name,
-        (const xmlChar *) "bounding_coordinates"))
+    else if (elem_token == ESPA_ELEM_BOUNDING_COORDINATES)
     {
         /* Process the siblings in the bounding coordinates */
-        for (cur_node = a_node->children; cur_node;
+        for (cur_node = xmlFirstElementChild (a_node); cur_node;
              cur_node = xmlNextElementSibling (cur_node))
         {
             if (add_global_metadata_bounding_coords (cur_node, gmeta))
@@ -1241,8 +1465,7 @@ int add_global_metadata
             }
         }
     }
-    else if (xmlStrEqual (cur_node->name,
-        (const xmlChar *) "projection_information"))
+    else if (elem_token == ESPA_ELEM_PROJECTION_INFORMATION)
     {
         /* Process the elements within the projection information */
         if (add_global_metadata_proj_info (cur_node, gmeta))
@@ -1252,8 +1475,7 @@ int add_global_metadata
             return (ERROR);
         }
     }
-    else if (xmlStrEqual (cur_node->name,
-        (const xmlChar *) "orientation_angle"))
+    else if (elem_token == ESPA_ELEM_ORIENTATION_ANGLE)
     {
         /* Expect the child node to be a text node containing the value of
            this field */
@@ -1296,6 +1518,7 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 12/27/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Intern the populated set in the shared pool
 
 NOTES:
 1. Memory is allocated in the band metadata for the number of bits in the
@@ -1373,6 +1596,13 @@ int add_band_metadata_bitmap_description
         nbits++;
     }
 
+    /* Intern the populated set so the bands and scenes with identical QA
+       schemas share one copy */
+    if (intern_bitmap_metadata (bmeta) != SUCCESS)
+    {  /* Error messages already printed */
+        return (ERROR);
+    }
+
     /* Successful processing */
     return (SUCCESS);
 }
@@ -1513,6 +1743,11 @@ Date         Programmer       Reason
 12/27/2013   Gail Schmidt     Original development
 2/25/2014    Gail Schmidt     Added support for source and category attributes
 11/13/2014   Gail Schmidt     Added support for resample_method
+8/31/2026    Gail Schmidt     Added support for the band checksum
+8/31/2026    Gail Schmidt     Added support for the band byte order
+8/31/2026    Gail Schmidt     Added support for the band statistics
+8/31/2026    Gail Schmidt     Dispatch on element name tokens instead of
+                              string comparisons
 
 NOTES:
 ******************************************************************************/
@@ -1528,17 +1763,20 @@ int add_band_metadata
     xmlAttrPtr attr = NULL;       /* pointer to the element attributes */
     xmlNode *cur_node = NULL;     /* pointer to the current node */
     xmlNode *child_node = NULL;   /* pointer to the child node */
+    int elem_token;               /* token for the current element name */
     xmlNsPtr ns = NULL;           /* pointer to the namespace */
     xmlChar *attr_val = NULL;     /* attribute value */
+    char *cptr = NULL;            /* pointer into the histogram bin counts */
     int count;                    /* number of chars copied in snprintf */
+    int ib;                       /* histogram bin looping variable */
 
     /* Set up the current and child pointers */
     cur_node = a_node;
-    ns = cur_node->nsDef;
+    ns = cur_node->ns ? cur_node->ns : cur_node->nsDef;
 
     /* Verify the namespace of this node is our ESPA namespace.  If it isn't
        then the element won't be added to the metadata structure. */
-    if (!xmlStrEqual (ns->href, (const xmlChar *) ESPA_NS))
+    if (ns == NULL || !xmlStrEqual (ns->href, (const xmlChar *) ESPA_NS))
     {
         sprintf (errmsg, "Skipping %s since it is not in the ESPA namespace",
             cur_node->name);
@@ -1637,11 +1875,12 @@ int add_band_metadata
 
     /* Process the children of this node; start with the first child then
        process it's siblings */
-    for (cur_node = a_node->children; cur_node;
+    for (cur_node = xmlFirstElementChild (a_node); cur_node;
          cur_node = xmlNextElementSibling (cur_node))
     {
         child_node = cur_node->children;
-        if (xmlStrEqual (cur_node->name, (const xmlChar *) "short_name"))
+        elem_token = espa_element_token (cur_node->name);
+        if (elem_token == ESPA_ELEM_SHORT_NAME)
         {
             /* Expect the child node to be a text node containing the value of
                this field */
@@ -1663,7 +1902,7 @@ int add_band_metadata
                 return (ERROR);
             }
         }
-        else if (xmlStrEqual (cur_node->name, (const xmlChar *) "long_name"))
+        else if (elem_token == ESPA_ELEM_LONG_NAME)
         {
             /* Expect the child node to be a text node containing the value of
                this field */
@@ -1685,7 +1924,7 @@ int add_band_metadata
                 return (ERROR);
             }
         }
-        else if (xmlStrEqual (cur_node->name, (const xmlChar *) "file_name"))
+        else if (elem_token == ESPA_ELEM_FILE_NAME)
         {
             /* Expect the child node to be a text node containing the value of
                this field */
@@ -1707,7 +1946,7 @@ int add_band_metadata
                 return (ERROR);
             }
         }
-        else if (xmlStrEqual (cur_node->name, (const xmlChar *) "pixel_size"))
+        else if (elem_token == ESPA_ELEM_PIXEL_SIZE)
         {
             /* Handle the element attributes */
             for (attr = cur_node->properties; attr != NULL; attr = attr->next)
@@ -1740,8 +1979,7 @@ int add_band_metadata
                 xmlFree (attr_val);
             }
         }
-        else if (xmlStrEqual (cur_node->name,
-            (const xmlChar *) "resample_method"))
+        else if (elem_token == ESPA_ELEM_RESAMPLE_METHOD)
         {
             /* Expect the child node to be a text node containing the value of
                this field */
@@ -1773,7 +2011,7 @@ int add_band_metadata
                 error_handler (false, FUNC_NAME, errmsg);
             }
         }
-        else if (xmlStrEqual (cur_node->name, (const xmlChar *) "data_units"))
+        else if (elem_token == ESPA_ELEM_DATA_UNITS)
         {
             /* Expect the child node to be a text node containing the value of
                this field */
@@ -1795,8 +2033,7 @@ int add_band_metadata
                 return (ERROR);
             }
         }
-        else if (xmlStrEqual (cur_node->name,
-            (const xmlChar *) "resample_method"))
+        else if (elem_token == ESPA_ELEM_RESAMPLE_METHOD)
         {
             /* Expect the child node to be a text node containing the value of
                this field */
@@ -1819,7 +2056,7 @@ int add_band_metadata
             else if (xmlStrEqual (attr_val, (const xmlChar *) "none"))
                 bmeta->resample_method = ESPA_NONE;
         }
-        else if (xmlStrEqual (cur_node->name, (const xmlChar *) "valid_range"))
+        else if (elem_token == ESPA_ELEM_VALID_RANGE)
         {
             /* Handle the element attributes */
             for (attr = cur_node->properties; attr != NULL; attr = attr->next)
@@ -1838,8 +2075,7 @@ int add_band_metadata
                 xmlFree (attr_val);
             }
         }
-        else if (xmlStrEqual (cur_node->name,
-            (const xmlChar *) "radiance"))
+        else if (elem_token == ESPA_ELEM_RADIANCE)
         {
             /* Handle the element attributes */
             for (attr = cur_node->properties; attr != NULL; attr = attr->next)
@@ -1858,8 +2094,7 @@ int add_band_metadata
                 xmlFree (attr_val);
             }
         }
-        else if (xmlStrEqual (cur_node->name,
-            (const xmlChar *) "reflectance"))
+        else if (elem_token == ESPA_ELEM_REFLECTANCE)
         {
             /* Handle the element attributes */
             for (attr = cur_node->properties; attr != NULL; attr = attr->next)
@@ -1878,8 +2113,7 @@ int add_band_metadata
                 xmlFree (attr_val);
             }
         }
-        else if (xmlStrEqual (cur_node->name,
-            (const xmlChar *) "thermal_const"))
+        else if (elem_token == ESPA_ELEM_THERMAL_CONST)
         {
             /* Handle the element attributes */
             for (attr = cur_node->properties; attr != NULL; attr = attr->next)
@@ -1898,8 +2132,27 @@ int add_band_metadata
                 xmlFree (attr_val);
             }
         }
-        else if (xmlStrEqual (cur_node->name,
-            (const xmlChar *) "qa_description"))
+        else if (elem_token == ESPA_ELEM_QA_DESCRIPTION)
+        {
+            /* Expect the child node to be a text node containing the value of
+               this field */
+            if (child_node == NULL || child_node->type != XML_TEXT_NODE) 
+            {
+                sprintf (errmsg, "Processing band metadata element: %s.",
+                    cur_node->name);
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
+            }
+
+            /* Copy the content of the child node into the lazily-allocated
+               QA description for this band */
+            if (set_band_qa_desc (bmeta,
+                (const char *) child_node->content) != SUCCESS)
+            {   /* Error messages already printed */
+                return (ERROR);
+            }
+        }
+        else if (elem_token == ESPA_ELEM_CALIBRATED_NT)
         {
             /* Expect the child node to be a text node containing the value of
                this field */
@@ -1912,17 +2165,31 @@ int add_band_metadata
             }
 
             /* Copy the content of the child node into value for this field */
-            count = snprintf (bmeta->qa_desc, sizeof (bmeta->qa_desc), "%s",
-                (const char *) child_node->content);
-            if (count < 0 || count >= sizeof (bmeta->qa_desc))
+            bmeta->calibrated_nt = atof ((const char *) child_node->content);
+        }
+        else if (elem_token == ESPA_ELEM_CHECKSUM)
+        {
+            /* Expect the child node to be a text node containing the value of
+               this field */
+            if (child_node == NULL || child_node->type != XML_TEXT_NODE) 
+            {
+                sprintf (errmsg, "Processing band metadata element: %s.",
+                    cur_node->name);
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
+            }
+
+            /* Copy the content of the child node into value for this field */
+            count = snprintf (bmeta->checksum, sizeof (bmeta->checksum),
+                "%s", (const char *) child_node->content);
+            if (count < 0 || count >= sizeof (bmeta->checksum))
             {
-                sprintf (errmsg, "Overflow of bmeta->qa_desc string");
+                sprintf (errmsg, "Overflow of bmeta->checksum string");
                 error_handler (true, FUNC_NAME, errmsg);
                 return (ERROR);
             }
         }
-        else if (xmlStrEqual (cur_node->name,
-            (const xmlChar *) "calibrated_nt"))
+        else if (elem_token == ESPA_ELEM_BYTE_ORDER)
         {
             /* Expect the child node to be a text node containing the value of
                this field */
@@ -1935,9 +2202,41 @@ int add_band_metadata
             }
 
             /* Copy the content of the child node into value for this field */
-            bmeta->calibrated_nt = atof ((const char *) child_node->content);
+            bmeta->byte_order = atoi ((const char *) child_node->content);
         }
-        else if (xmlStrEqual (cur_node->name, (const xmlChar *) "app_version"))
+        else if (elem_token == ESPA_ELEM_STATISTICS)
+        {
+            /* Handle the element attributes */
+            for (attr = cur_node->properties; attr != NULL; attr = attr->next)
+            {
+                attr_val = xmlGetProp (cur_node, attr->name);
+                if (xmlStrEqual (attr->name, (const xmlChar *) "minimum"))
+                    bmeta->stat_min = atof ((const char *) attr_val);
+                else if (xmlStrEqual (attr->name, (const xmlChar *) "maximum"))
+                    bmeta->stat_max = atof ((const char *) attr_val);
+                else if (xmlStrEqual (attr->name, (const xmlChar *) "mean"))
+                    bmeta->stat_mean = atof ((const char *) attr_val);
+                else if (xmlStrEqual (attr->name, (const xmlChar *) "npixels"))
+                    bmeta->stat_npixels = atol ((const char *) attr_val);
+                else
+                {
+                    sprintf (errmsg, "WARNING: unknown attribute for element "
+                        "(%s): %s\n", cur_node->name, attr->name);
+                    error_handler (false, FUNC_NAME, errmsg);
+                }
+                xmlFree (attr_val);
+            }
+
+            /* The element content, when present, is the space-separated
+               histogram bin counts */
+            if (child_node != NULL && child_node->type == XML_TEXT_NODE)
+            {
+                cptr = (char *) child_node->content;
+                for (ib = 0; ib < ESPA_STAT_HIST_BINS && *cptr != '\0'; ib++)
+                    bmeta->stat_histogram[ib] = strtol (cptr, &cptr, 10);
+            }
+        }
+        else if (elem_token == ESPA_ELEM_APP_VERSION)
         {
             /* Expect the child node to be a text node containing the value of
                this field */
@@ -1959,8 +2258,7 @@ int add_band_metadata
                 return (ERROR);
             }
         }
-        else if (xmlStrEqual (cur_node->name,
-            (const xmlChar *) "production_date"))
+        else if (elem_token == ESPA_ELEM_PRODUCTION_DATE)
         {
             /* Expect the child node to be a text node containing the value of
                this field */
@@ -1983,8 +2281,7 @@ int add_band_metadata
                 return (ERROR);
             }
         }
-        else if (xmlStrEqual (cur_node->name,
-            (const xmlChar *) "bitmap_description"))
+        else if (elem_token == ESPA_ELEM_BITMAP_DESCRIPTION)
         {
             if (add_band_metadata_bitmap_description (cur_node->children,
                 bmeta) != SUCCESS)
@@ -1995,7 +2292,7 @@ int add_band_metadata
                 return (ERROR);
             }
         }
-        else if (xmlStrEqual (cur_node->name, (const xmlChar *) "class_values"))
+        else if (elem_token == ESPA_ELEM_CLASS_VALUES)
         {
             if (add_band_metadata_class_values (cur_node->children, bmeta) !=
                 SUCCESS)
@@ -2034,18 +2331,20 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 12/26/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     The stack is now the growable, arena-backed
+                              Meta_stack_t
 
 NOTES:
 1. Uses a stack of character strings to keep track of the nodes that have
-   been parsed.  The stack must be allocated before calling this routine.
+   been parsed.  The stack must be initialized via init_stack before calling
+   this routine.
 ******************************************************************************/
 int parse_xml_into_struct
 (
     xmlNode *a_node,                  /* I: pointer to the current node */
     Espa_internal_meta_t *metadata,   /* I: ESPA internal metadata structure
                                             to be filled */
-    int *top_of_stack,                /* I: pointer to top of the stack */
-    char **stack                      /* I: stack to use for parsing */
+    Meta_stack_t *stack               /* I: stack to use for parsing */
 )
 {
     char FUNC_NAME[] = "parse_xml_into_struct";  /* function name */
@@ -2077,7 +2376,7 @@ int parse_xml_into_struct
             /* Push the element to the stack and turn the booleans on if this
                is either the global_metadata or the bands elements */
             //printf ("***Pushed %s\n", cur_node->name); fflush (stdout);
-            if (push (top_of_stack, stack, (const char *) cur_node->name))
+            if (push (stack, (const char *) cur_node->name))
             {
                 sprintf (errmsg, "Pushing element '%s' to the stack.",
                     cur_node->name);
@@ -2204,8 +2503,7 @@ int parse_xml_into_struct
            elsewhere */
         if (!skip_child)
         {
-            if (parse_xml_into_struct (cur_node->children, metadata,
-                top_of_stack, stack))
+            if (parse_xml_into_struct (cur_node->children, metadata, stack))
             {
                 sprintf (errmsg, "Parsing the children of this element '%s'.",
                     cur_node->name);
@@ -2218,7 +2516,7 @@ int parse_xml_into_struct
            the stack */
         if (cur_node->type == XML_ELEMENT_NODE)
         {
-            curr_stack_element = pop (top_of_stack, stack);
+            curr_stack_element = pop (stack);
             if (curr_stack_element == NULL)
             {
                 sprintf (errmsg, "Popping elements off the stack.");
@@ -2238,6 +2536,11 @@ int parse_xml_into_struct
 }
 
 
+/* Per-thread parser context reused across the files parsed on a thread, so
+   batch tools don't pay the reader allocation and teardown per file */
+static __thread xmlTextReaderPtr cached_reader = NULL;
+
+
 /******************************************************************************
 MODULE:  parse_metadata
 
@@ -2255,13 +2558,24 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 12/26/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Switched to a streaming parse which consumes
+                              each global_metadata and band subtree as it is
+                              read, rather than materializing a document tree
+                              for the entire metadata file
+8/31/2026    Gail Schmidt     Added performance instrumentation of the parse
+8/31/2026    Gail Schmidt     Reuse this thread's parser context across files
+8/31/2026    Gail Schmidt     Funnel the libxml2 global setup through the
+                              shared once-guarded initializer
 
 NOTES:
-1. Uses a stack of character strings to keep track of the nodes that have beend
-   found in the metadata document.
-2. For debugging purposes
-   xmlDocDump (stderr, doc);
-   can be used to dump/print the XML doc to the screen.
+1. The XML file is parsed with the libxml2 text reader.  Only the subtree for
+   the global metadata and the subtree for the current band element are ever
+   expanded in memory, so the peak allocation no longer grows with the number
+   of bands in the metadata file.
+2. The band array is grown as band elements arrive, since the streaming parse
+   does not know the band count up front.
+3. The parser context is cached per thread and reused for the next file, so
+   batch tools which parse many files only set the reader up once per thread.
 ******************************************************************************/
 int parse_metadata
 (
@@ -2274,16 +2588,31 @@ int parse_metadata
     char FUNC_NAME[] = "parse_metadata";  /* function name */
     char errmsg[STR_SIZE];        /* error message */
     xmlTextReaderPtr reader;  /* reader for the XML file */
-    xmlDocPtr doc = NULL;     /* document tree pointer */
-    xmlNodePtr current=NULL;  /* pointer to the current node */
+    xmlNodePtr node = NULL;   /* pointer to the expanded subtree node */
+    xmlNodePtr cur_node = NULL;  /* pointer to the current child node */
+    const xmlChar *name = NULL;  /* name of the current element */
+    const xmlChar *ns_uri = NULL;  /* namespace URI of the root element */
     int status;               /* return status */
     int nodeType;             /* node type (element, text, attribute, etc.) */
-    int top_of_stack;         /* top of the stack */
     int count;                /* number of chars copied in snprintf */
-    char **stack = NULL;      /* stack to keep track of elements in the tree */
-
-    /* Establish the reader for this metadata file */
-    reader = xmlNewTextReaderFilename (metafile);
+    int cur_band = 0;         /* current band being processed in the bands
+                                 metadata section */
+    long long perf_start = espa_perf_start ();  /* instrumentation scope */
+
+    /* Make sure the libxml2 global setup has run before any readers are
+       created; parses may run concurrently across threads */
+    espa_xml_init ();
+
+    /* Establish the reader for this metadata file, reusing this thread's
+       parser context when one exists from a previous parse */
+    if (cached_reader == NULL)
+        cached_reader = xmlReaderForFile (metafile, NULL, 0);
+    else if (xmlReaderNewFile (cached_reader, metafile, NULL, 0) != 0)
+    {
+        xmlFreeTextReader (cached_reader);
+        cached_reader = NULL;
+    }
+    reader = cached_reader;
     if (reader == NULL)
     {
         sprintf (errmsg, "Setting up reader for %s", metafile);
@@ -2291,14 +2620,13 @@ int parse_metadata
         return (ERROR);
     }
 
-    /* Use the reader to parse the XML file, looking at each of the nodes,
-       until the entire file has been parsed.  Start by reading the first
-       node in the file. */
+    /* Use the reader to stream through the XML file.  The global metadata
+       section and each band element are expanded as small subtrees and
+       consumed immediately, then the reader skips past them. */
     status = xmlTextReaderRead (reader);
     while (status == 1)
     {
-        /* Determine what kind of node the reader is at (element, end element,
-           attribute, text/white space) and handle the information as desired */
+        /* Only the start-of-element nodes are of interest */
         nodeType = xmlTextReaderNodeType (reader);
         if (nodeType == -1)
         {
@@ -2306,132 +2634,96 @@ int parse_metadata
             error_handler (true, FUNC_NAME, errmsg);
             return (ERROR);
         }
-        switch (nodeType)
+        if (nodeType != XML_READER_TYPE_ELEMENT)
         {
-            case XML_READER_TYPE_ELEMENT:
-            {  /* Node is an element (ex. <global_metadata> */
-                xmlNodePtr node=NULL;
-                if (doc==NULL)
-                {
-                    doc=xmlNewDoc (BAD_CAST "1.0");
-                }
-
-                /* Get the URI defining the namespace for this node */
-                if (xmlTextReaderConstNamespaceUri (reader) != NULL)
-                {
-                    /* Search the namespace for a document */
-                    xmlNsPtr ns = xmlSearchNs (doc, current,
-                        xmlTextReaderConstNamespaceUri(reader));
-
-                    /* Create a tree node for this element in the XML file
-                       using the element name */
-                    node = xmlNewNode (ns, xmlTextReaderConstName(reader));
-
-                    /* If the namespace is empty (i.e. root) then create a
-                       new namespace pointer with this node */
-                    if (ns == NULL)
-                    {
-                        ns = xmlNewNs (node,
-                            xmlTextReaderConstNamespaceUri(reader),
-                            xmlTextReaderConstPrefix(reader));
-                    }
-                }
-                else
-                {
-                    /* Create a tree node for this element in the XML file
-                       using the element name */
-                    node = xmlNewNode (0, xmlTextReaderConstName(reader));
-                }
+            status = xmlTextReaderRead (reader);
+            continue;
+        }
+        name = xmlTextReaderConstLocalName (reader);
 
-                /* Set the element as the root if appropriate otherwise add
-                   it as a child to the previous element */
-                if (current == NULL)
-                {
-                    xmlDocSetRootElement (doc, node);
-                }
-                else
-                {
-                    xmlAddChild (current, node);
-                }
-                current = node;
+        /* Store the namespace for the overall metadata file from the root
+           element */
+        if (xmlTextReaderDepth (reader) == 0)
+        {
+            ns_uri = xmlTextReaderConstNamespaceUri (reader);
+            if (ns_uri == NULL)
+            {
+                sprintf (errmsg, "No namespace found on the root element "
+                    "of %s", metafile);
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
+            }
+            count = snprintf (metadata->meta_namespace,
+                sizeof (metadata->meta_namespace), "%s",
+                (const char *) ns_uri);
+            if (count < 0 || count >= sizeof (metadata->meta_namespace))
+            {
+                sprintf (errmsg, "Overflow of metadata->meta_namespace "
+                    "string");
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
+            }
+        }
+        else if (xmlStrEqual (name, (const xmlChar *) "global_metadata"))
+        {
+            /* Expand the global metadata subtree and consume each of its
+               child elements */
+            node = xmlTextReaderExpand (reader);
+            if (node == NULL)
+            {
+                sprintf (errmsg, "Expanding the global_metadata subtree.");
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
+            }
 
-                /* If the element has attributes, then handle them */
-                if (xmlTextReaderHasAttributes (reader))
+            for (cur_node = xmlFirstElementChild (node); cur_node;
+                 cur_node = xmlNextElementSibling (cur_node))
+            {
+                if (add_global_metadata (cur_node, &metadata->global))
                 {
-                    /* Get the number of attributes and then process each one */
-                    int i;
-                    int n_att = xmlTextReaderAttributeCount (reader);
-                    for (i = 0; i < n_att; i++)
-                    {
-                        /* Read each attribute, obtain the name and value,
-                           then add it as a property for this node in the
-                           tree */
-                        const xmlChar *k = NULL;
-                        xmlChar *v = NULL;
-                        xmlTextReaderMoveToAttributeNo (reader, i);
-                        k = xmlTextReaderConstName (reader);
-                        v = xmlTextReaderValue (reader);
-                        if (xmlTextReaderConstNamespaceUri (reader) != NULL)
-                        {
-                            if (!xmlStrEqual (
-                                xmlTextReaderConstNamespaceUri(reader),
-                                BAD_CAST "http://www.w3.org/2000/xmlns/"))
-                            {
-                                /* Search the namespace for the document */
-                                xmlNsPtr ns = xmlSearchNs (doc, current,
-                                    xmlTextReaderConstNamespaceUri(reader));
-                                if (ns == NULL)
-                                {
-                                    ns = xmlNewNs (node,
-                                        xmlTextReaderConstNamespaceUri(reader),
-                                        xmlTextReaderConstPrefix(reader));
-                                }
-
-                                /* Create a new property tagged with this
-                                   namespace and carried by this node */
-                                xmlNewNsProp (current, ns,
-                                    xmlTextReaderConstLocalName(reader), v);
-                            }
-                         }
-                         else
-                         {
-                            /* Add the attribute as a property of the node
-                               in the tree */
-                            xmlNewProp (current, k, v);
-                         }
-
-                         /* Free the XML value pointer */
-                         xmlFree (v);
-                    }
-
-                    /* We are done with the attributes so go to the current
-                       attribute node */
-                    xmlTextReaderMoveToElement (reader);
+                    sprintf (errmsg, "Consuming global_metadata element "
+                        "'%s'.", cur_node->name);
+                    error_handler (true, FUNC_NAME, errmsg);
+                    return (ERROR);
                 }
+            }
 
-                /* If this is an empty element, then return to the parent */
-                if (xmlTextReaderIsEmptyElement(reader))
-                    current = current->parent;
-                break;
-            }  /* End: Node is an element */
+            /* Skip past the subtree which was just consumed */
+            status = xmlTextReaderNext (reader);
+            continue;
+        }
+        else if (xmlStrEqual (name, (const xmlChar *) "band"))
+        {
+            /* Grow the band array; the count of band elements is not known
+               up front when streaming, and the underlying allocation grows
+               geometrically */
+            if (reallocate_band_metadata (metadata, cur_band + 1) != SUCCESS)
+            {   /* Error messages already printed */
+                return (ERROR);
+            }
 
-            case XML_READER_TYPE_END_ELEMENT:
-            {  /* Node is an end element (ex. </global_metadata>, so return
-                  to the parent */
-                current = current->parent;
-                break;
+            /* Expand the subtree for this band only and consume it */
+            node = xmlTextReaderExpand (reader);
+            if (node == NULL)
+            {
+                sprintf (errmsg, "Expanding the subtree for band %d.",
+                    cur_band);
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
             }
 
-            case XML_READER_TYPE_TEXT:
-            {  /* Node is text or white space */
-                /* Read the value of the text and add it as text for the
-                   node, which is then added as a child to the tree */
-                const xmlChar *v = xmlTextReaderConstValue (reader);
-                xmlNodePtr node = xmlNewDocText (doc, v);
-                xmlAddChild (current, node);
-                break;
+            if (add_band_metadata (node, &metadata->band[cur_band++]))
+            {
+                sprintf (errmsg, "Consuming band metadata element '%s'.",
+                    node->name);
+                error_handler (true, FUNC_NAME, errmsg);
+                return (ERROR);
             }
-        }  /* end switch */
+
+            /* Skip past the subtree which was just consumed */
+            status = xmlTextReaderNext (reader);
+            continue;
+        }
 
         /* Read the next node */
         status = xmlTextReaderRead (reader);
@@ -2443,50 +2735,18 @@ int parse_metadata
         return (ERROR);
     }
 
-    /* If the document tree is not NULL then send in the root node of the
-       tree to be parsed and read into the ESPA metadata structure */
-    if (doc != NULL)
-    {
-        /* Store the namespace for the overall metadata file */
-        xmlNsPtr ns = xmlDocGetRootElement(doc)->nsDef;
-        count = snprintf (metadata->meta_namespace,
-            sizeof (metadata->meta_namespace), "%s", (const char *) ns->href);
-        if (count < 0 || count >= sizeof (metadata->meta_namespace))
-        {
-            sprintf (errmsg, "Overflow of metadata->meta_namespace string");
-            error_handler (true, FUNC_NAME, errmsg);
-            return (ERROR);
-        }
-
-        /* Initialize the stack to hold the elements */
-        if (init_stack (&top_of_stack, &stack))
-        {
-            sprintf (errmsg, "Initializing the stack.");
-            error_handler (true, FUNC_NAME, errmsg);
-            return (ERROR);
-        }
-        //print_element_names (xmlDocGetRootElement (doc));
-
-        /* Parse the XML document into our ESPA internal metadata structure */
-        if (parse_xml_into_struct (xmlDocGetRootElement(doc), metadata,
-            &top_of_stack, stack))
-        {
-            sprintf (errmsg, "Parsing the metadata file into the internal "
-                "metadata structure.");
-            error_handler (true, FUNC_NAME, errmsg);
-            return (ERROR);
-        }
+    /* The reader is kept cached for reuse by the next parse on this thread
+       rather than freed.  Note xmlCleanupParser is not called here since it
+       tears down the libxml2 global state, which is shared with the compiled
+       schema cached by validate_xml_file.  Per the libxml2 documentation it
+       should only be called once at process exit. */
 
-        /* Clean up the XML document and the stack */
-        xmlFreeDoc (doc);
-        free_stack (&stack);
-    }
-
-    /* Free the reader and associated memory */
-    xmlFreeTextReader (reader);
-    xmlCleanupParser();
-    xmlMemoryDump();
+    /* Reference the canonical copy of the projection metadata in the
+       shared intern segment; a NULL means interning is disabled (the
+       default) and the private copy stands alone */
+    metadata->shared_proj = intern_proj_metadata (&metadata->global.proj_info);
 
+    espa_perf_record ("parse_metadata", perf_start, 0);
+    espa_startup_mark ("xml parse");
     return (SUCCESS);
 }
-
@@ -13,6 +13,8 @@ Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 12/26/2013   Gail Schmidt     Original development
 4/17/2014    Gail Schmidt     Added support for additional projection params
+8/31/2026    Gail Schmidt     parse_xml_into_struct takes the growable
+                              Meta_stack_t
 
 NOTES:
 *****************************************************************************/
@@ -100,8 +102,7 @@ int parse_xml_into_struct
     xmlNode *a_node,                  /* I: pointer to the current node */
     Espa_internal_meta_t *metadata,   /* I: ESPA internal metadata structure
                                             to be filled */
-    int *top_of_stack,                /* I: pointer to top of the stack */
-    char **stack                      /* I: stack to use for parsing */
+    Meta_stack_t *stack               /* I: stack to use for parsing */
 );
 
 int parse_metadata
@@ -13,112 +13,2455 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 12/12/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added windowed writes for stitching tiles into
+                              a combined band file
+8/31/2026    Gail Schmidt     Added packed-bit mask writes and the matching
+                              streaming expander
+8/31/2026    Gail Schmidt     Added the band open which negotiates the
+                              compressed output sink (set ESPA_IMG_COMPRESS)
+8/31/2026    Gail Schmidt     Redirect write opens to a partial file which
+                              is synced and renamed into place on close
+                              (set ESPA_ATOMIC_OUTPUT), and preallocate
+                              bands opened through the band open
+8/31/2026    Gail Schmidt     Note the first read or write for the cold-start
+                              profile
 
 NOTES:
 *****************************************************************************/
 
+/* O_DIRECT is a GNU extension */
+#define _GNU_SOURCE
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
 #include "raw_binary_io.h"
+#include "compressed_binary_io.h"
+#include "espa_checksum.h"
+#include "espa_byteswap.h"
+#include "espa_perf.h"
+#include "espa_startup.h"
+
+/* define the read/write formats to be used for opening a file */
+typedef enum {
+  RB_READ_FORMAT,
+  RB_WRITE_FORMAT,
+  RB_READ_WRITE_FORMAT,
+  RB_DIRECT_WRITE_FORMAT,
+} Raw_binary_format_t;
+const char raw_binary_format[][4] = {"rb", "wb", "rb+", "wbd"};
+
+/* Alignment required by O_DIRECT transfers and size of the bounce buffer
+   used to stage unaligned caller data; the bounce buffer size must be a
+   multiple of the alignment */
+#define RB_DIRECT_ALIGN 4096
+#define RB_DIRECT_BOUNCE (1024 * 1024)
+
+/* Maximum number of direct-write files which can be open at once */
+#define RB_DIRECT_MAX_OPEN 16
+
+/* State for a file opened with "wbd" access.  The caller data is staged
+   through the aligned bounce buffer and written with O_DIRECT so the band
+   output bypasses the page cache. */
+typedef struct
+{
+    FILE *fptr;              /* stream handed back to the caller; used as the
+                                lookup key and to close the descriptor */
+    int fd;                  /* underlying O_DIRECT descriptor */
+    unsigned char *bounce;   /* aligned bounce buffer of RB_DIRECT_BOUNCE
+                                bytes */
+    size_t buffered;         /* bytes currently staged in the bounce buffer */
+    long long total_bytes;   /* logical size of the file; the final padded
+                                block is trimmed back to this on close */
+} Raw_binary_direct_t;
+
+/* Table of open direct-write files, protected by the lock since converters
+   may write bands from multiple threads */
+static Raw_binary_direct_t rb_direct_table[RB_DIRECT_MAX_OPEN];
+static pthread_mutex_t rb_direct_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Maximum number of streams which can have a running checksum at once */
+#define RB_CRC_MAX_OPEN 16
+
+/* Running checksum for a stream whose writes are being fingerprinted, so
+   the band doesn't need a separate full read just to checksum it */
+typedef struct
+{
+    FILE *fptr;              /* stream being checksummed; lookup key */
+    unsigned int crc;        /* running CRC32C of the bytes written */
+} Raw_binary_crc_t;
+
+static Raw_binary_crc_t rb_crc_table[RB_CRC_MAX_OPEN];
+static pthread_mutex_t rb_crc_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Maximum number of streams which can be byte-swapped on read at once */
+#define RB_SWAP_MAX_OPEN 16
+
+/* Byte-swap state for a stream whose band was written on a machine of the
+   other byte order, so the values are swapped lazily as they are read
+   instead of in a separate conversion pass over the file */
+typedef struct
+{
+    FILE *fptr;              /* stream being swapped; lookup key */
+    int size;                /* number of bytes per value in the band */
+} Raw_binary_swap_t;
+
+static Raw_binary_swap_t rb_swap_table[RB_SWAP_MAX_OPEN];
+static pthread_mutex_t rb_swap_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Size of the stdio buffer handed to each raw binary stream and the maximum
+   number of streams buffered at once.  The glibc default of 4KB makes the
+   streaming conversions issue a syscall every few lines; a multi-MB buffer
+   amortizes that, and retired buffers stay in the table so the per-band
+   open/close cycles of the converters reuse them instead of re-allocating */
+#define RB_VBUF_SIZE (4 * 1024 * 1024)
+#define RB_VBUF_MAX_OPEN 16
+
+/* stdio buffer assigned to a stream; a slot with a buffer but no stream is
+   a retired buffer waiting to be reused */
+typedef struct
+{
+    FILE *fptr;              /* stream using the buffer; lookup key */
+    char *buffer;            /* RB_VBUF_SIZE byte stdio buffer */
+} Raw_binary_vbuf_t;
+
+/* Table of stdio buffers, protected by the lock since converters may open
+   bands from multiple threads */
+static Raw_binary_vbuf_t rb_vbuf_table[RB_VBUF_MAX_OPEN];
+static pthread_mutex_t rb_vbuf_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Maximum number of read streams tracked by the descriptor cache, parked
+   and checked out together */
+#define RB_FDCACHE_MAX_OPEN 32
+
+/* Descriptor cache entry for a read stream.  When the ESPA_FD_CACHE
+   environment variable is set, close_raw_binary parks read streams here
+   instead of closing them and open_raw_binary hands a parked stream with a
+   matching path back out, so the stages of a conversion chain reuse the
+   descriptor instead of reopening the same band file at every stage. */
+typedef struct
+{
+    char path[STR_SIZE];     /* filename the stream was opened with */
+    FILE *fptr;              /* tracked stream; NULL when the slot is free */
+    bool in_use;             /* is the stream checked out to a caller? */
+    long long last_used;     /* stamp when the stream was parked, for LRU
+                                eviction */
+} Raw_binary_fdcache_t;
+
+static Raw_binary_fdcache_t rb_fdcache_table[RB_FDCACHE_MAX_OPEN];
+static pthread_mutex_t rb_fdcache_lock = PTHREAD_MUTEX_INITIALIZER;
+static long long rb_fdcache_stamp = 0;
+
+/* Filenames starting with this scheme refer to POSIX shared memory objects
+   instead of files on disk, which lets co-scheduled tools hand band buffers
+   to each other without a round trip through the filesystem */
+#define RAW_BINARY_SHM_SCHEME "shm:"
+
+/******************************************************************************
+MODULE: is_raw_binary_shm (static)
+
+PURPOSE: Checks whether a raw binary filename refers to a shared memory
+object rather than a file on disk.
+
+RETURN VALUE:
+Type = bool
+Value        Description
+-----        -----------
+true         The filename uses the shm: scheme
+false        The filename refers to a regular file
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+static bool is_raw_binary_shm
+(
+    const char *infile   /* I: name of the raw binary file */
+)
+{
+    return strncmp (infile, RAW_BINARY_SHM_SCHEME,
+        strlen (RAW_BINARY_SHM_SCHEME)) == 0;
+}
+
+
+/******************************************************************************
+MODULE: raw_binary_shm_name (static)
+
+PURPOSE: Converts a shm: scheme filename into the POSIX shared memory object
+name, which must start with a single '/'.
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+ERROR        The shared memory object name is empty or too long
+SUCCESS      Object name was constructed
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+static int raw_binary_shm_name
+(
+    const char *infile,  /* I: shm: scheme filename */
+    char *shm_name,      /* O: POSIX shared memory object name */
+    size_t name_size     /* I: size of the shm_name buffer */
+)
+{
+    char FUNC_NAME[] = "raw_binary_shm_name"; /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    const char *name = infile + strlen (RAW_BINARY_SHM_SCHEME);
+    int count;               /* number of chars copied in snprintf */
+
+    /* Skip any leading '/' since one is added below */
+    while (*name == '/')
+        name++;
+    if (*name == '\0')
+    {
+        sprintf (errmsg, "Shared memory object name is empty in %s.", infile);
+        error_handler (true, FUNC_NAME, errmsg);
+        return ERROR;
+    }
+
+    /* Build the object name with the single leading '/' required by
+       shm_open */
+    count = snprintf (shm_name, name_size, "/%s", name);
+    if (count < 0 || count >= name_size)
+    {
+        sprintf (errmsg, "Shared memory object name is too long in %s.",
+            infile);
+        error_handler (true, FUNC_NAME, errmsg);
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+
+/******************************************************************************
+MODULE: open_raw_binary_shm (static)
+
+PURPOSE: Opens a raw binary shared memory object for the specified
+read/write/both binary access and wraps it in a stdio stream, so the callers
+can use the same read/write/seek calls as for a file on disk.
+
+RETURN VALUE:
+Type = FILE *
+Value        Description
+-----        -----------
+NULL         Error opening the shared memory object with the specified access
+non-NULL     FILE pointer to the opened shared memory object
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The object lives in memory (tmpfs) and persists until it is removed
+     with remove_raw_binary, so a producing tool can exit before the
+     consuming tool opens the band.
+*****************************************************************************/
+static FILE *open_raw_binary_shm
+(
+    char *infile,        /* I: shm: scheme name of the object to be opened */
+    char *access_type    /* I: string for the access type for reading the
+                               input file; use the raw_binary_format
+                               array at the top of this file */
+)
+{
+    char FUNC_NAME[] = "open_raw_binary_shm"; /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    char shm_name[STR_SIZE]; /* POSIX shared memory object name */
+    int oflags;              /* open flags matching the access type */
+    int fd = -1;             /* descriptor for the shared memory object */
+    FILE *rb_fptr = NULL;    /* pointer to the raw binary stream */
+
+    /* Build the shared memory object name */
+    if (raw_binary_shm_name (infile, shm_name, sizeof (shm_name)) != SUCCESS)
+        return NULL;
+
+    /* Shared memory already lives in RAM, so direct writes degrade to
+       plain writes */
+    if (!strcmp (access_type, raw_binary_format[RB_DIRECT_WRITE_FORMAT]))
+        access_type = (char *) raw_binary_format[RB_WRITE_FORMAT];
+
+    /* Map the stdio access type onto the open flags */
+    if (!strcmp (access_type, raw_binary_format[RB_READ_FORMAT]))
+        oflags = O_RDONLY;
+    else if (!strcmp (access_type, raw_binary_format[RB_WRITE_FORMAT]))
+        oflags = O_RDWR | O_CREAT | O_TRUNC;
+    else if (!strcmp (access_type, raw_binary_format[RB_READ_WRITE_FORMAT]))
+        oflags = O_RDWR;
+    else
+    {
+        sprintf (errmsg, "Unsupported access type %s for shared memory "
+            "object %s.", access_type, infile);
+        error_handler (true, FUNC_NAME, errmsg);
+        return NULL;
+    }
+
+    /* Open the shared memory object */
+    fd = shm_open (shm_name, oflags, 0666);
+    if (fd == -1)
+    {
+        sprintf (errmsg, "Opening shared memory object %s with %s access.",
+            infile, access_type);
+        error_handler (true, FUNC_NAME, errmsg);
+        return NULL;
+    }
+
+    /* Wrap the descriptor in a stdio stream so the callers are unchanged */
+    rb_fptr = fdopen (fd, access_type);
+    if (rb_fptr == NULL)
+    {
+        sprintf (errmsg, "Wrapping shared memory object %s in a stream.",
+            infile);
+        error_handler (true, FUNC_NAME, errmsg);
+        close (fd);
+        return NULL;
+    }
+
+    return rb_fptr;
+}
+
+/******************************************************************************
+MODULE: find_raw_binary_direct (static)
+
+PURPOSE: Looks up the direct-write state for a stream, if any.
+
+RETURN VALUE:
+Type = Raw_binary_direct_t *
+Value        Description
+-----        -----------
+NULL         The stream was not opened for direct writing
+non-NULL     Direct-write state for the stream
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+static Raw_binary_direct_t *find_raw_binary_direct
+(
+    FILE *rb_fptr   /* I: stream to be looked up in the direct-write table */
+)
+{
+    Raw_binary_direct_t *direct = NULL;  /* matching table entry */
+    int i;                               /* looping variable */
+
+    pthread_mutex_lock (&rb_direct_lock);
+    for (i = 0; i < RB_DIRECT_MAX_OPEN; i++)
+    {
+        if (rb_direct_table[i].fptr == rb_fptr)
+        {
+            direct = &rb_direct_table[i];
+            break;
+        }
+    }
+    pthread_mutex_unlock (&rb_direct_lock);
+
+    return direct;
+}
+
+
+/******************************************************************************
+MODULE: open_raw_binary_direct (static)
+
+PURPOSE: Opens a raw binary file for writing with O_DIRECT so the band data
+bypasses the page cache.
+
+RETURN VALUE:
+Type = FILE *
+Value        Description
+-----        -----------
+NULL         Error opening the specified file
+non-NULL     FILE pointer to the opened file
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. If the filesystem does not support O_DIRECT, or all the direct-write
+     slots are in use, the open quietly falls back to a buffered stream and
+     the caller is none the wiser.
+  2. Write to the returned stream through write_raw_binary only; the stream
+     itself is just the handle the existing callers expect.
+*****************************************************************************/
+static FILE *open_raw_binary_direct
+(
+    char *infile         /* I: name of the output file to be opened */
+)
+{
+    char FUNC_NAME[] = "open_raw_binary_direct"; /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    int fd = -1;             /* O_DIRECT descriptor for the file */
+    int i;                   /* looping variable */
+    void *bounce = NULL;     /* aligned bounce buffer */
+    FILE *rb_fptr = NULL;    /* pointer to the raw binary stream */
+    Raw_binary_direct_t *direct = NULL;  /* free direct-write table entry */
+
+    /* Open with O_DIRECT; fall back to a buffered stream on filesystems
+       which do not support it */
+    fd = open (infile, O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0666);
+    if (fd == -1)
+        return fopen (infile, raw_binary_format[RB_WRITE_FORMAT]);
+
+    /* Allocate the aligned bounce buffer which stages the caller data */
+    if (posix_memalign (&bounce, RB_DIRECT_ALIGN, RB_DIRECT_BOUNCE) != 0)
+    {
+        sprintf (errmsg, "Allocating the direct write bounce buffer for "
+            "file %s.", infile);
+        error_handler (true, FUNC_NAME, errmsg);
+        close (fd);
+        return NULL;
+    }
+
+    /* Wrap the descriptor in a stream to serve as the caller's handle */
+    rb_fptr = fdopen (fd, raw_binary_format[RB_WRITE_FORMAT]);
+    if (rb_fptr == NULL)
+    {
+        sprintf (errmsg, "Wrapping the direct write file %s in a stream.",
+            infile);
+        error_handler (true, FUNC_NAME, errmsg);
+        free (bounce);
+        close (fd);
+        return NULL;
+    }
+
+    /* Claim a slot in the direct-write table */
+    pthread_mutex_lock (&rb_direct_lock);
+    for (i = 0; i < RB_DIRECT_MAX_OPEN; i++)
+    {
+        if (rb_direct_table[i].fptr == NULL)
+        {
+            direct = &rb_direct_table[i];
+            direct->fptr = rb_fptr;
+            break;
+        }
+    }
+    pthread_mutex_unlock (&rb_direct_lock);
+
+    /* If every slot is in use, fall back to a buffered stream */
+    if (direct == NULL)
+    {
+        free (bounce);
+        fclose (rb_fptr);
+        return fopen (infile, raw_binary_format[RB_WRITE_FORMAT]);
+    }
+
+    direct->fd = fd;
+    direct->bounce = bounce;
+    direct->buffered = 0;
+    direct->total_bytes = 0;
+
+    return rb_fptr;
+}
+
+
+/******************************************************************************
+MODULE: write_raw_binary_direct (static)
+
+PURPOSE: Stages caller data through the aligned bounce buffer and writes the
+full blocks with O_DIRECT.
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+ERROR        An error occurred writing data to the raw binary file
+SUCCESS      Writing was successful
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+static int write_raw_binary_direct
+(
+    Raw_binary_direct_t *direct,  /* I: direct-write state for the file */
+    const void *img_array,        /* I: data to be written to the file */
+    long long nbytes              /* I: number of bytes to be written */
+)
+{
+    char FUNC_NAME[] = "write_raw_binary_direct"; /* function name */
+    char errmsg[STR_SIZE];       /* error message */
+    const unsigned char *src = img_array;  /* walking source pointer */
+    size_t chunk;                /* bytes staged in the current pass */
+    ssize_t nwrote;              /* bytes written by the current write */
+
+    direct->total_bytes += nbytes;
+    while (nbytes > 0)
+    {
+        /* Stage as much as fits in the bounce buffer */
+        chunk = RB_DIRECT_BOUNCE - direct->buffered;
+        if ((long long) chunk > nbytes)
+            chunk = nbytes;
+        memcpy (direct->bounce + direct->buffered, src, chunk);
+        direct->buffered += chunk;
+        src += chunk;
+        nbytes -= chunk;
+
+        /* Drain the bounce buffer once it fills; partial tail blocks are
+           handled on close */
+        if (direct->buffered == RB_DIRECT_BOUNCE)
+        {
+            nwrote = write (direct->fd, direct->bounce, RB_DIRECT_BOUNCE);
+            if (nwrote != RB_DIRECT_BOUNCE)
+            {
+                sprintf (errmsg, "Writing %d bytes to the direct write "
+                    "raw binary file.", RB_DIRECT_BOUNCE);
+                error_handler (true, FUNC_NAME, errmsg);
+                return ERROR;
+            }
+            direct->buffered = 0;
+        }
+    }
+
+    return SUCCESS;
+}
+
+
+/******************************************************************************
+MODULE: close_raw_binary_direct (static)
+
+PURPOSE: Flushes the tail of a direct-write file, trims the zero padding of
+the final block, and releases the direct-write state.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. O_DIRECT transfers must be a multiple of the alignment, so the final
+     partial block is zero padded, written, and then truncated back to the
+     true file size.
+*****************************************************************************/
+static void close_raw_binary_direct
+(
+    Raw_binary_direct_t *direct   /* I: direct-write state for the file */
+)
+{
+    char FUNC_NAME[] = "close_raw_binary_direct"; /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    size_t padded;           /* buffered tail padded to the alignment */
+    ssize_t nwrote;          /* bytes written by the tail write */
+
+    /* Pad the buffered tail out to the alignment and write it */
+    if (direct->buffered > 0)
+    {
+        padded = ((direct->buffered + RB_DIRECT_ALIGN - 1) /
+            RB_DIRECT_ALIGN) * RB_DIRECT_ALIGN;
+        memset (direct->bounce + direct->buffered, 0,
+            padded - direct->buffered);
+        nwrote = write (direct->fd, direct->bounce, padded);
+        if (nwrote != (ssize_t) padded)
+        {
+            sprintf (errmsg, "Writing the final block of the direct write "
+                "raw binary file.");
+            error_handler (true, FUNC_NAME, errmsg);
+        }
+    }
+
+    /* Trim the zero padding back off the end of the file */
+    if (ftruncate (direct->fd, direct->total_bytes) != 0)
+    {
+        sprintf (errmsg, "Truncating the direct write raw binary file to "
+            "its final size.");
+        error_handler (true, FUNC_NAME, errmsg);
+    }
+
+    /* Release the slot; the stream itself is closed by the caller */
+    free (direct->bounce);
+    pthread_mutex_lock (&rb_direct_lock);
+    direct->fptr = NULL;
+    direct->fd = -1;
+    direct->bounce = NULL;
+    pthread_mutex_unlock (&rb_direct_lock);
+}
+
+
+/******************************************************************************
+MODULE: set_raw_binary_buffer (static)
+
+PURPOSE: Gives a freshly opened stream a large stdio buffer from the pool,
+reusing a retired buffer when one is available.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Must be called before any I/O on the stream, since setvbuf is only
+     valid on an unused stream.
+  2. Quietly leaves the default buffering in place if the pool is full or
+     the buffer cannot be allocated.
+*****************************************************************************/
+static void set_raw_binary_buffer
+(
+    FILE *fptr           /* I: freshly opened stream to buffer */
+)
+{
+    Raw_binary_vbuf_t *entry = NULL;  /* pool slot for the stream */
+    int i;
+
+    /* Prefer a retired buffer; otherwise take an empty slot */
+    pthread_mutex_lock (&rb_vbuf_lock);
+    for (i = 0; i < RB_VBUF_MAX_OPEN; i++)
+    {
+        if (rb_vbuf_table[i].fptr == NULL && rb_vbuf_table[i].buffer != NULL)
+        {
+            entry = &rb_vbuf_table[i];
+            break;
+        }
+        if (entry == NULL && rb_vbuf_table[i].fptr == NULL)
+            entry = &rb_vbuf_table[i];
+    }
+
+    if (entry != NULL && entry->buffer == NULL)
+        entry->buffer = malloc (RB_VBUF_SIZE);
+
+    if (entry == NULL || entry->buffer == NULL)
+    {  /* Pool is full or the buffer could not be allocated; the stream
+          keeps the default stdio buffering */
+        pthread_mutex_unlock (&rb_vbuf_lock);
+        return;
+    }
+
+    entry->fptr = fptr;
+    pthread_mutex_unlock (&rb_vbuf_lock);
+
+    if (setvbuf (fptr, entry->buffer, _IOFBF, RB_VBUF_SIZE) != 0)
+    {  /* Retire the buffer and keep the default buffering */
+        pthread_mutex_lock (&rb_vbuf_lock);
+        entry->fptr = NULL;
+        pthread_mutex_unlock (&rb_vbuf_lock);
+    }
+}
+
+
+/******************************************************************************
+MODULE: find_raw_binary_vbuf (static)
+
+PURPOSE: Looks up the pooled stdio buffer entry for a stream, if any.
+
+RETURN VALUE:
+Type = Raw_binary_vbuf_t *
+Value        Description
+-----        -----------
+NULL         The stream is using the default stdio buffering
+non-NULL     Pooled buffer entry for the stream
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The entry must not be retired (fptr cleared) until after the stream
+     is closed, since stdio flushes through the buffer during fclose.
+*****************************************************************************/
+static Raw_binary_vbuf_t *find_raw_binary_vbuf
+(
+    FILE *fptr           /* I: stream to look up */
+)
+{
+    Raw_binary_vbuf_t *entry = NULL;  /* pool slot for the stream */
+    int i;
+
+    pthread_mutex_lock (&rb_vbuf_lock);
+    for (i = 0; i < RB_VBUF_MAX_OPEN; i++)
+    {
+        if (rb_vbuf_table[i].fptr == fptr)
+        {
+            entry = &rb_vbuf_table[i];
+            break;
+        }
+    }
+    pthread_mutex_unlock (&rb_vbuf_lock);
+
+    return entry;
+}
+
+
+/******************************************************************************
+MODULE: raw_binary_fdcache_enabled (static)
+
+PURPOSE: Checks whether the read descriptor cache was requested through the
+ESPA_FD_CACHE environment variable.
+
+RETURN VALUE:
+Type = bool
+Value        Description
+-----        -----------
+true         Read streams are parked and reused across open/close cycles
+false        The cache was not requested (the default)
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+static bool raw_binary_fdcache_enabled (void)
+{
+    static int enabled = -1;      /* cached setting; -1 until first call */
+    char *value = NULL;           /* value of the environment variable */
+
+    if (enabled == -1)
+    {
+        value = getenv ("ESPA_FD_CACHE");
+        enabled = (value != NULL && value[0] != '\0' &&
+            strcmp (value, "0") != 0);
+    }
+
+    return enabled;
+}
+
+
+/******************************************************************************
+MODULE: raw_binary_fdcache_invalidate (static)
+
+PURPOSE: Closes any parked streams for a path which is about to be rewritten
+or removed, so a later read open cannot see the stale file.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+static void raw_binary_fdcache_invalidate
+(
+    char *infile         /* I: path being rewritten or removed */
+)
+{
+    Raw_binary_vbuf_t *vbuf = NULL;  /* pooled stdio buffer, if any */
+    int i;                           /* looping variable */
+
+    if (!raw_binary_fdcache_enabled ())
+        return;
+
+    pthread_mutex_lock (&rb_fdcache_lock);
+    for (i = 0; i < RB_FDCACHE_MAX_OPEN; i++)
+    {
+        if (rb_fdcache_table[i].fptr != NULL &&
+            !rb_fdcache_table[i].in_use &&
+            strcmp (rb_fdcache_table[i].path, infile) == 0)
+        {
+            vbuf = find_raw_binary_vbuf (rb_fdcache_table[i].fptr);
+            fclose (rb_fdcache_table[i].fptr);
+            if (vbuf != NULL)
+            {  /* Retire the pooled stdio buffer */
+                pthread_mutex_lock (&rb_vbuf_lock);
+                vbuf->fptr = NULL;
+                pthread_mutex_unlock (&rb_vbuf_lock);
+            }
+            rb_fdcache_table[i].fptr = NULL;
+            rb_fdcache_table[i].path[0] = '\0';
+        }
+    }
+    pthread_mutex_unlock (&rb_fdcache_lock);
+}
+
+
+/******************************************************************************
+MODULE: raw_binary_fdcache_checkout (static)
+
+PURPOSE: Hands a parked read stream for the path back out, if one is in the
+cache, rewound to the start of the file.
+
+RETURN VALUE:
+Type = FILE *
+Value        Description
+-----        -----------
+NULL         No parked stream for the path
+non-NULL     Rewound stream for the path, checked out to the caller
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+static FILE *raw_binary_fdcache_checkout
+(
+    char *infile         /* I: path being opened for read */
+)
+{
+    FILE *fptr = NULL;   /* parked stream for the path, if any */
+    int i;               /* looping variable */
+
+    pthread_mutex_lock (&rb_fdcache_lock);
+    for (i = 0; i < RB_FDCACHE_MAX_OPEN; i++)
+    {
+        if (rb_fdcache_table[i].fptr != NULL &&
+            !rb_fdcache_table[i].in_use &&
+            strcmp (rb_fdcache_table[i].path, infile) == 0)
+        {
+            rb_fdcache_table[i].in_use = true;
+            fptr = rb_fdcache_table[i].fptr;
+            break;
+        }
+    }
+    pthread_mutex_unlock (&rb_fdcache_lock);
+
+    if (fptr != NULL && fseek (fptr, 0, SEEK_SET) != 0)
+    {   /* the parked stream went bad; drop it and reopen fresh */
+        raw_binary_fdcache_invalidate (infile);
+        return NULL;
+    }
+
+    return fptr;
+}
+
+
+/******************************************************************************
+MODULE: raw_binary_fdcache_register (static)
+
+PURPOSE: Tracks a freshly opened read stream in the descriptor cache, so it
+can be parked instead of closed, evicting the least recently parked stream
+when the cache is full.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. If every slot is checked out the stream is simply not tracked, and the
+     close for it closes it like the cache was never there.
+*****************************************************************************/
+static void raw_binary_fdcache_register
+(
+    char *infile,        /* I: path the stream was opened with */
+    FILE *rb_fptr        /* I: freshly opened read stream */
+)
+{
+    Raw_binary_vbuf_t *vbuf = NULL;  /* pooled stdio buffer, if any */
+    FILE *evicted = NULL;   /* parked stream evicted to make room */
+    int slot = -1;          /* slot for the new stream */
+    int i;                  /* looping variable */
+    int count;              /* number of chars copied in snprintf */
+
+    pthread_mutex_lock (&rb_fdcache_lock);
+
+    /* Prefer a free slot; otherwise evict the least recently parked
+       stream */
+    for (i = 0; i < RB_FDCACHE_MAX_OPEN; i++)
+    {
+        if (rb_fdcache_table[i].fptr == NULL)
+        {
+            slot = i;
+            break;
+        }
+    }
+    if (slot == -1)
+    {
+        for (i = 0; i < RB_FDCACHE_MAX_OPEN; i++)
+        {
+            if (rb_fdcache_table[i].in_use)
+                continue;
+            if (slot == -1 ||
+                rb_fdcache_table[i].last_used <
+                rb_fdcache_table[slot].last_used)
+                slot = i;
+        }
+        if (slot != -1)
+            evicted = rb_fdcache_table[slot].fptr;
+    }
+
+    if (slot != -1)
+    {
+        count = snprintf (rb_fdcache_table[slot].path,
+            sizeof (rb_fdcache_table[slot].path), "%s", infile);
+        if (count < 0 || count >= sizeof (rb_fdcache_table[slot].path))
+        {   /* path too long to track; leave the stream uncached */
+            rb_fdcache_table[slot].path[0] = '\0';
+            rb_fdcache_table[slot].fptr = evicted;
+            evicted = NULL;
+            slot = -1;
+        }
+        else
+        {
+            rb_fdcache_table[slot].fptr = rb_fptr;
+            rb_fdcache_table[slot].in_use = true;
+        }
+    }
+    pthread_mutex_unlock (&rb_fdcache_lock);
+
+    if (evicted != NULL)
+    {
+        vbuf = find_raw_binary_vbuf (evicted);
+        fclose (evicted);
+        if (vbuf != NULL)
+        {  /* Retire the pooled stdio buffer */
+            pthread_mutex_lock (&rb_vbuf_lock);
+            vbuf->fptr = NULL;
+            pthread_mutex_unlock (&rb_vbuf_lock);
+        }
+    }
+}
+
+
+/******************************************************************************
+MODULE: raw_binary_fdcache_park (static)
+
+PURPOSE: Parks a tracked read stream on close instead of closing it, so the
+next read open of the same path reuses it.
+
+RETURN VALUE:
+Type = bool
+Value        Description
+-----        -----------
+true         Stream was parked; the caller must not close it
+false        Stream is not tracked by the cache
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+static bool raw_binary_fdcache_park
+(
+    FILE *rb_fptr        /* I: stream being closed */
+)
+{
+    bool parked = false; /* was the stream parked? */
+    int i;               /* looping variable */
+
+    if (!raw_binary_fdcache_enabled ())
+        return false;
+
+    pthread_mutex_lock (&rb_fdcache_lock);
+    for (i = 0; i < RB_FDCACHE_MAX_OPEN; i++)
+    {
+        if (rb_fdcache_table[i].fptr == rb_fptr &&
+            rb_fdcache_table[i].in_use)
+        {
+            rb_fdcache_table[i].in_use = false;
+            rb_fdcache_table[i].last_used = ++rb_fdcache_stamp;
+            parked = true;
+            break;
+        }
+    }
+    pthread_mutex_unlock (&rb_fdcache_lock);
+
+    return parked;
+}
+
+
+/* Maximum number of write streams with a pending atomic commit */
+#define RB_COMMIT_MAX_OPEN 16
+
+/* State for a write stream redirected to a partial file which is renamed
+   onto the final name when the stream is closed */
+typedef struct
+{
+    FILE *fptr;                  /* stream being tracked; NULL while the
+                                    slot is claimed but not yet opened */
+    char final_name[STR_SIZE];   /* name the output commits to */
+    char partial_name[STR_SIZE]; /* name the output is written under; an
+                                    empty name marks the slot free */
+} Raw_binary_commit_t;
+
+static Raw_binary_commit_t rb_commit_table[RB_COMMIT_MAX_OPEN];
+static pthread_mutex_t rb_commit_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/******************************************************************************
+MODULE: raw_binary_atomic_enabled (static)
+
+PURPOSE: Checks whether atomic output commits were requested through the
+ESPA_ATOMIC_OUTPUT environment variable.
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+0            Outputs are written under their final names (the default)
+1            Outputs are written to a partial file and renamed into place
+             when the stream is closed
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. A crashed process then leaves only a .partial file behind instead of
+     a truncated band under the final name, which downstream readers would
+     otherwise only discover when a read fails mid-stream.
+******************************************************************************/
+static int raw_binary_atomic_enabled (void)
+{
+    static int enabled = -1;      /* cached setting; -1 until first call */
+    char *value = NULL;           /* value of the environment variable */
+
+    if (enabled == -1)
+    {
+        value = getenv ("ESPA_ATOMIC_OUTPUT");
+        enabled = (value != NULL && value[0] != '\0' &&
+            strcmp (value, "0") != 0);
+    }
+
+    return enabled;
+}
+
+
+/******************************************************************************
+MODULE: raw_binary_commit_claim (static)
+
+PURPOSE: Claims a commit slot for a write open and builds the partial name
+the output will be written under.
+
+RETURN VALUE:
+Type = Raw_binary_commit_t *
+Value        Description
+-----        -----------
+NULL         No slot was free or the partial name would not fit; the caller
+             writes the final name directly as before
+non-NULL     Claimed slot holding the partial name to be opened
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static Raw_binary_commit_t *raw_binary_commit_claim
+(
+    char *final_name     /* I: name the output commits to */
+)
+{
+    int i;                   /* looping variable */
+    int count;               /* number of chars copied in snprintf */
+    Raw_binary_commit_t *entry = NULL;  /* free commit table entry */
+
+    pthread_mutex_lock (&rb_commit_lock);
+    for (i = 0; i < RB_COMMIT_MAX_OPEN; i++)
+    {
+        if (rb_commit_table[i].partial_name[0] == '\0')
+        {
+            entry = &rb_commit_table[i];
+            break;
+        }
+    }
+
+    if (entry == NULL)
+    {
+        pthread_mutex_unlock (&rb_commit_lock);
+        return NULL;
+    }
+
+    count = snprintf (entry->partial_name, sizeof (entry->partial_name),
+        "%s.partial", final_name);
+    if (count < 0 || count >= (int) sizeof (entry->partial_name))
+    {
+        entry->partial_name[0] = '\0';
+        pthread_mutex_unlock (&rb_commit_lock);
+        return NULL;
+    }
+
+    snprintf (entry->final_name, sizeof (entry->final_name), "%s",
+        final_name);
+    entry->fptr = NULL;
+    pthread_mutex_unlock (&rb_commit_lock);
+    return entry;
+}
+
+
+/******************************************************************************
+MODULE: raw_binary_commit_release (static)
+
+PURPOSE: Releases a claimed commit slot, e.g. when the open failed or the
+commit has been made.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static void raw_binary_commit_release
+(
+    Raw_binary_commit_t *entry   /* I: commit slot to be released; NULL is
+                                       quietly ignored */
+)
+{
+    if (entry == NULL)
+        return;
+
+    pthread_mutex_lock (&rb_commit_lock);
+    entry->fptr = NULL;
+    entry->partial_name[0] = '\0';
+    pthread_mutex_unlock (&rb_commit_lock);
+}
+
+
+/******************************************************************************
+MODULE: find_raw_binary_commit (static)
+
+PURPOSE: Looks up the pending commit for a stream, if any.
+
+RETURN VALUE:
+Type = Raw_binary_commit_t *
+Value        Description
+-----        -----------
+NULL         The stream has no pending commit
+non-NULL     Commit entry for the stream
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static Raw_binary_commit_t *find_raw_binary_commit
+(
+    FILE *fptr           /* I: stream to be looked up */
+)
+{
+    int i;                   /* looping variable */
+    Raw_binary_commit_t *entry = NULL;  /* matching commit table entry */
+
+    pthread_mutex_lock (&rb_commit_lock);
+    for (i = 0; i < RB_COMMIT_MAX_OPEN; i++)
+    {
+        if (rb_commit_table[i].fptr == fptr &&
+            rb_commit_table[i].partial_name[0] != '\0')
+        {
+            entry = &rb_commit_table[i];
+            break;
+        }
+    }
+    pthread_mutex_unlock (&rb_commit_lock);
+    return entry;
+}
+
+
+/******************************************************************************
+MODULE: open_raw_binary
+
+PURPOSE: Opens a raw binary file for specified read/write/both binary access.
+ 
+RETURN VALUE:
+Type = FILE *
+Value        Description
+-----        -----------
+NULL         Error opening the specified file for read specified access
+non-NULL     FILE pointer to the opened file
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+12/12/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added support for the shm: scheme so band
+                              buffers can be exchanged through shared memory
+8/31/2026    Gail Schmidt     Added the "wbd" access type for direct writes
+                              which bypass the page cache
+8/31/2026    Gail Schmidt     Recognize block-compressed bands on read opens
+                              so they decompress transparently
+8/31/2026    Gail Schmidt     Buffer the stream with a large pooled stdio
+                              buffer to cut the syscall count
+8/31/2026    Gail Schmidt     Reuse parked read streams through the
+                              descriptor cache (set ESPA_FD_CACHE)
+8/31/2026    Gail Schmidt     Redirect write opens to a partial file which
+                              is renamed into place on close (set
+                              ESPA_ATOMIC_OUTPUT)
+
+NOTES:
+  1. Filenames starting with "shm:" refer to POSIX shared memory objects
+     instead of files on disk; the remainder of the name is the object name.
+  2. The "wbd" access type writes the file with O_DIRECT so band output
+     which nothing on the node will read again does not evict more useful
+     data from the page cache.  It quietly falls back to buffered writes if
+     the filesystem does not support O_DIRECT.
+*****************************************************************************/
+FILE *open_raw_binary
+(
+    char *infile,        /* I: name of the input file to be opened */
+    char *access_type    /* I: string for the access type for reading the
+                               input file; use the raw_binary_format
+                               array at the top of this file */
+)
+{
+    char FUNC_NAME[] = "open_raw_binary"; /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    char *open_path = infile;  /* path actually opened; redirected to the
+                                  partial file for atomic commits */
+    FILE *rb_fptr = NULL;    /* pointer to the raw binary file */
+    Raw_binary_vbuf_t *vbuf = NULL;  /* pooled stdio buffer entry, if any */
+    Raw_binary_commit_t *commit = NULL;  /* pending atomic commit, if any */
+
+    /* Open shared memory objects through the shm path */
+    if (is_raw_binary_shm (infile))
+        return open_raw_binary_shm (infile, access_type);
+
+    /* A write open rewrites the file, so any parked read stream for the
+       path would be left reading the stale file */
+    if (strcmp (access_type, raw_binary_format[RB_READ_FORMAT]) != 0)
+        raw_binary_fdcache_invalidate (infile);
+
+    /* Redirect write opens to a partial file when atomic output commit was
+       requested (set ESPA_ATOMIC_OUTPUT); the partial file is synced and
+       renamed onto the final name when the stream is closed, so readers
+       never see a truncated band */
+    if (raw_binary_atomic_enabled () &&
+        (!strcmp (access_type, raw_binary_format[RB_WRITE_FORMAT]) ||
+         !strcmp (access_type, raw_binary_format[RB_DIRECT_WRITE_FORMAT])))
+    {
+        commit = raw_binary_commit_claim (infile);
+        if (commit != NULL)
+            open_path = commit->partial_name;
+    }
+
+    /* Open direct-write files through the O_DIRECT path */
+    if (!strcmp (access_type, raw_binary_format[RB_DIRECT_WRITE_FORMAT]))
+    {
+        rb_fptr = open_raw_binary_direct (open_path);
+        if (rb_fptr == NULL)
+            raw_binary_commit_release (commit);
+        else if (commit != NULL)
+            commit->fptr = rb_fptr;
+        return rb_fptr;
+    }
+
+    /* Hand a parked read stream for the path back out if the descriptor
+       cache has one; the compressed-band check below still runs since the
+       parked stream's state was released when it was parked */
+    if (raw_binary_fdcache_enabled () &&
+        !strcmp (access_type, raw_binary_format[RB_READ_FORMAT]))
+    {
+        rb_fptr = raw_binary_fdcache_checkout (infile);
+        if (rb_fptr != NULL)
+        {
+            if (compressed_binary_attach (rb_fptr) != SUCCESS)
+            {  /* Error messages already printed */
+                return NULL;
+            }
+            return rb_fptr;
+        }
+    }
+
+    /* Open the file with the specified access type */
+    rb_fptr = fopen (open_path, access_type);
+    if (rb_fptr == NULL)
+    {
+        sprintf (errmsg, "Opening raw binary file %.1024s with %s access.",
+            open_path, access_type);
+        error_handler (true, FUNC_NAME, errmsg);
+        raw_binary_commit_release (commit);
+        return NULL;
+    }
+    if (commit != NULL)
+        commit->fptr = rb_fptr;
+
+    /* Give the stream a large pooled stdio buffer so the streaming
+       conversions do not issue a syscall every few lines */
+    set_raw_binary_buffer (rb_fptr);
+
+    /* Register block-compressed bands so the reads decompress
+       transparently; plain bands are simply rewound */
+    if (!strcmp (access_type, raw_binary_format[RB_READ_FORMAT]))
+    {
+        if (compressed_binary_attach (rb_fptr) != SUCCESS)
+        {  /* Error messages already printed */
+            vbuf = find_raw_binary_vbuf (rb_fptr);
+            fclose (rb_fptr);
+            if (vbuf != NULL)
+            {  /* Retire the pooled stdio buffer */
+                pthread_mutex_lock (&rb_vbuf_lock);
+                vbuf->fptr = NULL;
+                pthread_mutex_unlock (&rb_vbuf_lock);
+            }
+            return NULL;
+        }
+
+        /* Track the fresh read stream in the descriptor cache so the close
+           parks it for the next stage */
+        if (raw_binary_fdcache_enabled ())
+            raw_binary_fdcache_register (infile, rb_fptr);
+    }
+
+    /* Return the file pointer */
+    return rb_fptr;
+}
+
+
+/******************************************************************************
+MODULE: raw_binary_compress_enabled
+
+PURPOSE: Checks whether compressed band output was requested through the
+ESPA_IMG_COMPRESS environment variable.
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+0            Bands are written as plain raw binary files (the default)
+1            Bands are written through the block-compressed container
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The batch driver sets the variable for its workers when the delivery
+     target wants compressed outputs, so the bands compress while the
+     buffers are cache-hot during conversion instead of in a separate
+     compression pass that rereads everything.
+  2. Exposed so the converters can route around the write paths that need
+     to seek (sparse fill, windowed mosaic stitching), which a compressed
+     stream cannot support.
+******************************************************************************/
+int raw_binary_compress_enabled (void)
+{
+    static int enabled = -1;      /* cached setting; -1 until first call */
+    char *value = NULL;           /* value of the environment variable */
+
+    if (enabled == -1)
+    {
+        value = getenv ("ESPA_IMG_COMPRESS");
+        enabled = (value != NULL && value[0] != '\0' &&
+            strcmp (value, "0") != 0);
+    }
+
+    return enabled;
+}
+
+
+/******************************************************************************
+MODULE: open_raw_binary_band
+
+PURPOSE: Opens a band output file, negotiating the sink for the band: when
+compressed output was requested the band is written through the
+block-compressed container, otherwise it is opened as a plain raw binary
+file with the given access type.
+
+RETURN VALUE:
+Type = FILE *
+Value        Description
+-----        -----------
+NULL         Error opening the band output file
+non-NULL     FILE pointer for write_raw_binary/close_raw_binary
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Preallocate the full band up front to keep the
+                              extents contiguous
+
+NOTES:
+  1. write_raw_binary and close_raw_binary already route compressed streams
+     through the container, so the callers write the band the same way
+     whichever sink was negotiated.
+  2. Plain bands are preallocated to their full size so the extents are
+     laid out contiguously, except for buffered "wb" opens whose callers
+     rely on seek-created fill holes.
+******************************************************************************/
+FILE *open_raw_binary_band
+(
+    char *outfile,       /* I: name of the band output file to be created */
+    int nlines,          /* I: number of lines in the band */
+    int nsamps,          /* I: number of samples per line in the band */
+    int size,            /* I: number of bytes per pixel */
+    char *access_type    /* I: access type for a plain raw binary open, used
+                               when compressed output was not requested */
+)
+{
+    FILE *rb_fptr = NULL;    /* pointer to the raw binary file */
+
+    if (raw_binary_compress_enabled ())
+        return open_compressed_raw_binary (outfile, nlines, nsamps, size);
+
+    rb_fptr = open_raw_binary (outfile, access_type);
+    if (rb_fptr == NULL)
+    {  /* Error messages already printed */
+        return NULL;
+    }
+
+    /* Preallocate the full band up front so the filesystem lays the
+       extents out contiguously; fragmented bands cost real sequential
+       read throughput on aged filesystems.  Plain buffered ("wb") opens
+       are skipped since those callers create fill holes by seeking, which
+       preallocation would defeat, and filesystems without support simply
+       leave the file as it is */
+    if (strcmp (access_type, raw_binary_format[RB_WRITE_FORMAT]) != 0)
+    {
+        if (posix_fallocate (fileno (rb_fptr), 0,
+            (off_t) nlines * nsamps * size) != 0)
+        {  /* Not supported here; the writes allocate as they go */
+        }
+    }
+
+    return rb_fptr;
+}
+
+
+/******************************************************************************
+MODULE: find_raw_binary_byte_swap (static)
+
+PURPOSE: Looks up the byte-swap entry for a stream, if any.
+
+RETURN VALUE:
+Type = Raw_binary_swap_t *
+Value        Description
+-----        -----------
+NULL         No byte swapping was requested for the stream
+non-NULL     Byte-swap entry for the stream
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+static Raw_binary_swap_t *find_raw_binary_byte_swap
+(
+    FILE *rb_fptr   /* I: stream to be looked up in the byte-swap table */
+)
+{
+    Raw_binary_swap_t *entry = NULL; /* matching table entry */
+    int i;                           /* looping variable */
+
+    pthread_mutex_lock (&rb_swap_lock);
+    for (i = 0; i < RB_SWAP_MAX_OPEN; i++)
+    {
+        if (rb_swap_table[i].fptr == rb_fptr)
+        {
+            entry = &rb_swap_table[i];
+            break;
+        }
+    }
+    pthread_mutex_unlock (&rb_swap_lock);
+
+    return entry;
+}
+
+
+/******************************************************************************
+MODULE: close_raw_binary
+
+PURPOSE: Close the raw binary file
+ 
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+12/12/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Flush and trim direct-write files before
+                              closing them
+8/31/2026    Gail Schmidt     Flush and release block-compressed bands before
+                              closing them
+8/31/2026    Gail Schmidt     Release the byte-swap slot for the stream
+8/31/2026    Gail Schmidt     Retire the pooled stdio buffer for the stream
+8/31/2026    Gail Schmidt     Park tracked read streams in the descriptor
+                              cache instead of closing them (set
+                              ESPA_FD_CACHE)
+8/31/2026    Gail Schmidt     Sync and rename pending atomic commits onto
+                              their final names
+
+NOTES:
+*****************************************************************************/
+void close_raw_binary
+(
+    FILE *fptr      /* I: pointer to raw binary file to be closed */
+)
+{
+    char FUNC_NAME[] = "close_raw_binary"; /* function name */
+    char errmsg[STR_SIZE];               /* error message */
+    Raw_binary_direct_t *direct = NULL;  /* direct-write state, if any */
+    Raw_binary_swap_t *swap = NULL;      /* byte-swap state, if any */
+    Raw_binary_vbuf_t *vbuf = NULL;      /* pooled stdio buffer, if any */
+    Raw_binary_commit_t *commit = NULL;  /* pending atomic commit, if any */
+
+    /* Direct-write files need their tail flushed and padding trimmed */
+    direct = find_raw_binary_direct (fptr);
+    if (direct != NULL)
+        close_raw_binary_direct (direct);
+
+    /* Block-compressed bands need their final block and offset index
+       flushed and their state released */
+    close_compressed_binary (fptr);
+
+    /* Release the byte-swap slot if reads of the stream were being
+       swapped */
+    swap = find_raw_binary_byte_swap (fptr);
+    if (swap != NULL)
+    {
+        pthread_mutex_lock (&rb_swap_lock);
+        swap->fptr = NULL;
+        swap->size = 0;
+        pthread_mutex_unlock (&rb_swap_lock);
+    }
+
+    /* Park tracked read streams in the descriptor cache instead of closing
+       them; the next read open of the same path reuses the stream and its
+       pooled stdio buffer */
+    if (raw_binary_fdcache_park (fptr))
+        return;
+
+    /* Streams with a pending atomic commit are synced to disk before the
+       close so the rename below publishes fully-written bytes */
+    commit = find_raw_binary_commit (fptr);
+    if (commit != NULL)
+    {
+        fflush (fptr);
+        fsync (fileno (fptr));
+    }
+
+    /* Look the pooled stdio buffer up before the close; the buffer itself
+       must stay in place until the stream has flushed through it */
+    vbuf = find_raw_binary_vbuf (fptr);
+
+    fclose (fptr);
+
+    /* Publish the output under its final name; a crash before this point
+       leaves only the partial file behind */
+    if (commit != NULL)
+    {
+        if (rename (commit->partial_name, commit->final_name) != 0)
+        {
+            sprintf (errmsg, "Renaming the partial file onto %.1024s; the "
+                "output is left under its partial name.",
+                commit->final_name);
+            error_handler (false, FUNC_NAME, errmsg);
+        }
+        raw_binary_commit_release (commit);
+    }
+
+    /* Retire the pooled stdio buffer, if any, so the next open reuses it */
+    if (vbuf != NULL)
+    {
+        pthread_mutex_lock (&rb_vbuf_lock);
+        vbuf->fptr = NULL;
+        pthread_mutex_unlock (&rb_vbuf_lock);
+    }
+}
+
+
+/******************************************************************************
+MODULE: remove_raw_binary
+
+PURPOSE: Removes a raw binary file or shared memory object
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+ERROR        An error occurred removing the specified file
+SUCCESS      Removal was successful
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Shared memory objects are not removed automatically when the last
+     consumer closes them, so this needs to be called once the band is no
+     longer needed to release the memory.
+*****************************************************************************/
+int remove_raw_binary
+(
+    char *infile         /* I: name of the file or object to be removed */
+)
+{
+    char FUNC_NAME[] = "remove_raw_binary"; /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    char shm_name[STR_SIZE]; /* POSIX shared memory object name */
+
+    /* Remove shared memory objects through shm_unlink */
+    if (is_raw_binary_shm (infile))
+    {
+        if (raw_binary_shm_name (infile, shm_name, sizeof (shm_name))
+            != SUCCESS)
+            return ERROR;
+
+        if (shm_unlink (shm_name) != 0)
+        {
+            sprintf (errmsg, "Removing shared memory object %s.", infile);
+            error_handler (true, FUNC_NAME, errmsg);
+            return ERROR;
+        }
+
+        return SUCCESS;
+    }
+
+    /* Drop any parked read stream for the path before removing it */
+    raw_binary_fdcache_invalidate (infile);
+
+    /* Remove the file from disk */
+    if (remove (infile) != 0)
+    {
+        sprintf (errmsg, "Removing raw binary file %s.", infile);
+        error_handler (true, FUNC_NAME, errmsg);
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+
+/******************************************************************************
+MODULE: advise_raw_binary_fd_sequential
+
+PURPOSE: Advises the kernel that the descriptor will be read sequentially
+from start to finish, so the readahead can be sized accordingly and the
+band does not compete as badly with the other processes on the node.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The advice is only a hint, so failures are ignored; the read calls
+     behave identically either way.
+*****************************************************************************/
+void advise_raw_binary_fd_sequential
+(
+    int fd          /* I: descriptor of the file to be read sequentially */
+)
+{
+    if (fd != -1)
+    {
+        posix_fadvise (fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        posix_fadvise (fd, 0, 0, POSIX_FADV_WILLNEED);
+    }
+}
+
+
+/******************************************************************************
+MODULE: advise_raw_binary_fd_done
+
+PURPOSE: Advises the kernel that the data behind the descriptor has been
+consumed and its cached pages can be dropped, so a band that will not be
+read again does not push more useful pages out of the page cache.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The advice is only a hint, so failures are ignored.  Dirty pages are
+     not dropped, so this is only effective on the read side.
+*****************************************************************************/
+void advise_raw_binary_fd_done
+(
+    int fd          /* I: descriptor of the file which has been consumed */
+)
+{
+    if (fd != -1)
+        posix_fadvise (fd, 0, 0, POSIX_FADV_DONTNEED);
+}
+
+
+/******************************************************************************
+MODULE: advise_raw_binary_sequential
+
+PURPOSE: Advises the kernel that the raw binary file will be read
+sequentially from start to finish.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+void advise_raw_binary_sequential
+(
+    FILE *rb_fptr   /* I: pointer to the raw binary file to be read */
+)
+{
+    advise_raw_binary_fd_sequential (fileno (rb_fptr));
+}
+
+
+/******************************************************************************
+MODULE: advise_raw_binary_done
+
+PURPOSE: Advises the kernel that the raw binary file has been consumed and
+its cached pages can be dropped.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+void advise_raw_binary_done
+(
+    FILE *rb_fptr   /* I: pointer to the consumed raw binary file */
+)
+{
+    advise_raw_binary_fd_done (fileno (rb_fptr));
+}
+
+
+/******************************************************************************
+MODULE: open_raw_binary_mapped
+
+PURPOSE: Maps a raw binary file into memory for read-only access, allowing
+the band pixels to be consumed without copying them through a userspace
+buffer.
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+ERROR        An error occurred mapping the specified file
+SUCCESS      Mapping was successful
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added support for the shm: scheme so band
+                              buffers can be exchanged through shared memory
+
+NOTES:
+  1. The mapped view is read-only.  Use close_raw_binary_mapped to release
+     the mapping when the band data is no longer needed.
+  2. The kernel is advised that the mapping will be accessed sequentially,
+     which matches the line-ordered access pattern of the converters.
+*****************************************************************************/
+int open_raw_binary_mapped
+(
+    char *infile,       /* I: name of the input file to be mapped */
+    void **map_addr,    /* O: address of the read-only mapped view */
+    size_t *map_length  /* O: length of the mapped view in bytes */
+)
+{
+    char FUNC_NAME[] = "open_raw_binary_mapped"; /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    char shm_name[STR_SIZE]; /* POSIX shared memory object name */
+    int fd = -1;             /* file descriptor for the input file */
+    struct stat stat_buf;    /* file information for the input file */
+    void *addr = NULL;       /* address of the mapped view */
+
+    /* Open the file or shared memory object for read-only access */
+    if (is_raw_binary_shm (infile))
+    {
+        if (raw_binary_shm_name (infile, shm_name, sizeof (shm_name))
+            != SUCCESS)
+            return ERROR;
+        fd = shm_open (shm_name, O_RDONLY, 0666);
+    }
+    else
+        fd = open (infile, O_RDONLY);
+    if (fd == -1)
+    {
+        sprintf (errmsg, "Opening raw binary file %s with read access.",
+            infile);
+        error_handler (true, FUNC_NAME, errmsg);
+        return ERROR;
+    }
+
+    /* Obtain the size of the file for the length of the mapping */
+    if (fstat (fd, &stat_buf) == -1)
+    {
+        sprintf (errmsg, "Obtaining the file size of raw binary file %s.",
+            infile);
+        error_handler (true, FUNC_NAME, errmsg);
+        close (fd);
+        return ERROR;
+    }
+
+    /* Map the entire file into memory for read-only access */
+    addr = mmap (NULL, stat_buf.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED)
+    {
+        sprintf (errmsg, "Mapping raw binary file %s into memory.", infile);
+        error_handler (true, FUNC_NAME, errmsg);
+        close (fd);
+        return ERROR;
+    }
+
+    /* The mapping holds its own reference to the file, so the descriptor
+       is no longer needed */
+    close (fd);
+
+    /* Advise the kernel that the band data will be read sequentially */
+    madvise (addr, stat_buf.st_size, MADV_SEQUENTIAL);
+
+    *map_addr = addr;
+    *map_length = stat_buf.st_size;
+    return SUCCESS;
+}
+
+
+/******************************************************************************
+MODULE: close_raw_binary_mapped
+
+PURPOSE: Releases a mapped view of a raw binary file which was obtained from
+open_raw_binary_mapped
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+void close_raw_binary_mapped
+(
+    void *map_addr,     /* I: address of the mapped view to be released */
+    size_t map_length   /* I: length of the mapped view in bytes */
+)
+{
+    munmap (map_addr, map_length);
+}
+
+
+/******************************************************************************
+MODULE: find_raw_binary_checksum (static)
+
+PURPOSE: Looks up the running checksum entry for a stream, if any.
+
+RETURN VALUE:
+Type = Raw_binary_crc_t *
+Value        Description
+-----        -----------
+NULL         No checksum was requested for the stream
+non-NULL     Checksum entry for the stream
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+static Raw_binary_crc_t *find_raw_binary_checksum
+(
+    FILE *rb_fptr   /* I: stream to be looked up in the checksum table */
+)
+{
+    Raw_binary_crc_t *entry = NULL;  /* matching table entry */
+    int i;                           /* looping variable */
+
+    pthread_mutex_lock (&rb_crc_lock);
+    for (i = 0; i < RB_CRC_MAX_OPEN; i++)
+    {
+        if (rb_crc_table[i].fptr == rb_fptr)
+        {
+            entry = &rb_crc_table[i];
+            break;
+        }
+    }
+    pthread_mutex_unlock (&rb_crc_lock);
+
+    return entry;
+}
+
+
+/******************************************************************************
+MODULE: enable_raw_binary_checksum
+
+PURPOSE: Starts a running CRC32C checksum over the data written to the
+stream through write_raw_binary, so the band is fingerprinted from the
+buffers already in memory instead of a separate read of the file.
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+ERROR        All the checksum slots are in use
+SUCCESS      Checksumming was enabled for the stream
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Call this right after opening the band for writing and collect the
+     result with finish_raw_binary_checksum before closing it.
+  2. Only writes going through write_raw_binary are folded in; bands queued
+     through the async writer should be checksummed by the producer with
+     espa_crc32c directly.
+*****************************************************************************/
+int enable_raw_binary_checksum
+(
+    FILE *rb_fptr   /* I: stream whose writes are to be checksummed */
+)
+{
+    char FUNC_NAME[] = "enable_raw_binary_checksum"; /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    int i;                   /* looping variable */
+    Raw_binary_crc_t *entry = NULL;  /* free checksum table entry */
+
+    pthread_mutex_lock (&rb_crc_lock);
+    for (i = 0; i < RB_CRC_MAX_OPEN; i++)
+    {
+        if (rb_crc_table[i].fptr == NULL)
+        {
+            entry = &rb_crc_table[i];
+            entry->fptr = rb_fptr;
+            entry->crc = 0;
+            break;
+        }
+    }
+    pthread_mutex_unlock (&rb_crc_lock);
+
+    if (entry == NULL)
+    {
+        sprintf (errmsg, "All %d checksum slots are in use.",
+            RB_CRC_MAX_OPEN);
+        error_handler (true, FUNC_NAME, errmsg);
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+
+/******************************************************************************
+MODULE: finish_raw_binary_checksum
+
+PURPOSE: Collects the running checksum for a stream as the hex string stored
+in the band metadata and releases the checksum slot.
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+ERROR        No checksum was requested for the stream
+SUCCESS      Checksum string was returned
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+int finish_raw_binary_checksum
+(
+    FILE *rb_fptr,  /* I: stream whose checksum is to be collected */
+    char *checksum  /* O: hex checksum string of ESPA_CHECKSUM_STR_SIZE
+                          characters */
+)
+{
+    char FUNC_NAME[] = "finish_raw_binary_checksum"; /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    Raw_binary_crc_t *entry = NULL;  /* checksum entry for the stream */
+
+    entry = find_raw_binary_checksum (rb_fptr);
+    if (entry == NULL)
+    {
+        sprintf (errmsg, "No checksum was enabled for this stream.");
+        error_handler (true, FUNC_NAME, errmsg);
+        return ERROR;
+    }
+
+    espa_crc32c_string (entry->crc, checksum);
+
+    pthread_mutex_lock (&rb_crc_lock);
+    entry->fptr = NULL;
+    entry->crc = 0;
+    pthread_mutex_unlock (&rb_crc_lock);
+
+    return SUCCESS;
+}
+
+
+/******************************************************************************
+MODULE: enable_raw_binary_byte_swap
+
+PURPOSE: Arranges for the values read from the stream through
+read_raw_binary/read_raw_binary_window to have their bytes swapped, for
+bands whose declared byte order doesn't match the machine reading them.
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+ERROR        All the byte-swap slots are in use
+SUCCESS      Byte swapping was enabled for the stream
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Call this right after opening the band for reading, when the byte
+     order in the band metadata is set and differs from
+     espa_machine_byte_order.  The slot is released by close_raw_binary.
+  2. The swap happens in the caller's buffer right after the read while the
+     data is still in cache, so matching-order bands keep their zero-copy
+     reads and mismatched bands cost one in-cache pass.
+*****************************************************************************/
+int enable_raw_binary_byte_swap
+(
+    FILE *rb_fptr,  /* I: stream whose reads are to be byte-swapped */
+    int size        /* I: number of bytes per value in the band */
+)
+{
+    char FUNC_NAME[] = "enable_raw_binary_byte_swap"; /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    int i;                   /* looping variable */
+    Raw_binary_swap_t *entry = NULL; /* free byte-swap table entry */
+
+    pthread_mutex_lock (&rb_swap_lock);
+    for (i = 0; i < RB_SWAP_MAX_OPEN; i++)
+    {
+        if (rb_swap_table[i].fptr == NULL)
+        {
+            entry = &rb_swap_table[i];
+            entry->fptr = rb_fptr;
+            entry->size = size;
+            break;
+        }
+    }
+    pthread_mutex_unlock (&rb_swap_lock);
+
+    if (entry == NULL)
+    {
+        sprintf (errmsg, "All %d byte-swap slots are in use.",
+            RB_SWAP_MAX_OPEN);
+        error_handler (true, FUNC_NAME, errmsg);
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+
+/******************************************************************************
+MODULE: write_raw_binary
+
+PURPOSE: Writes nlines of data to the raw binary file
+ 
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+ERROR        An error occurred writing data to the raw binary file
+SUCCESS      Writing was successful
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+12/12/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Route files opened with "wbd" access through
+                              the O_DIRECT write path
+8/31/2026    Gail Schmidt     Added performance instrumentation of the writes
+8/31/2026    Gail Schmidt     Route bands opened with open_compressed_raw_binary
+                              through the block compressor
+8/31/2026    Gail Schmidt     Fold the buffer into the running checksum when
+                              one was requested for the stream
+8/31/2026    Gail Schmidt     Report errors through espa_error so the hot
+                              path carries no errmsg stack buffer
+
+NOTES:
+*****************************************************************************/
+int write_raw_binary
+(
+    FILE *rb_fptr,      /* I: pointer to the raw binary file */
+    int nlines,         /* I: number of lines to write to the file */
+    int nsamps,         /* I: number of samples to write to the file */
+    int size,           /* I: number of bytes per pixel (ex. sizeof(uint8)) */
+    void *img_array     /* I: array of nlines * nsamps * size to be written
+                              to the raw binary file */
+)
+{
+    int nvals;               /* number of values written to the file */
+    Raw_binary_direct_t *direct = NULL;  /* direct-write state, if any */
+    Raw_binary_crc_t *crc_entry = NULL;  /* running checksum, if any */
+    Espa_compressed_binary_t *zb = NULL; /* compressed band state, if any */
+    long long perf_start = espa_perf_start ();  /* instrumentation scope */
+
+    espa_startup_note_io ();
+
+    /* Fold the buffer into the running checksum if one was requested; the
+       data is still in cache here, which saves re-reading the file later
+       just to fingerprint it */
+    crc_entry = find_raw_binary_checksum (rb_fptr);
+    if (crc_entry != NULL)
+    {
+        crc_entry->crc = espa_crc32c (crc_entry->crc, img_array,
+            (size_t) nlines * nsamps * size);
+    }
+
+    /* Bands opened for compressed writing go through the block compressor */
+    zb = compressed_binary_find (rb_fptr);
+    if (zb != NULL)
+    {
+        if (write_compressed_binary (zb, nlines, nsamps, size, img_array)
+            != SUCCESS)
+            return ERROR;
+        espa_perf_record ("write_raw_binary", perf_start,
+            (long long) nlines * nsamps * size);
+        return SUCCESS;
+    }
+
+    /* Files opened for direct writing go through the bounce buffer */
+    direct = find_raw_binary_direct (rb_fptr);
+    if (direct != NULL)
+    {
+        if (write_raw_binary_direct (direct, img_array,
+            (long long) nlines * nsamps * size) != SUCCESS)
+            return ERROR;
+        espa_perf_record ("write_raw_binary", perf_start,
+            (long long) nlines * nsamps * size);
+        return SUCCESS;
+    }
+
+    /* Write the data to the raw binary file */
+    nvals = fwrite (img_array, size, nlines * nsamps, rb_fptr);
+    if (nvals != nlines * nsamps)
+    {
+        espa_error ("write_raw_binary", "Writing %d elements of %d bytes in "
+            "size to the raw binary file.", nlines * nsamps, size);
+        return ERROR;
+    }
+
+    espa_perf_record ("write_raw_binary", perf_start,
+        (long long) nlines * nsamps * size);
+    return SUCCESS;
+}
+
+
+/******************************************************************************
+MODULE: write_raw_binary_window
+
+PURPOSE: Writes a spatial window of data to the raw binary file, seeking to
+the start of each line in the window and writing only the samples of
+interest
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+ERROR        An error occurred writing data to the raw binary file
+SUCCESS      Writing was successful
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. start_line and start_samp are 0-based within the band.
+  2. The input buffer is packed with the window data only, i.e. the window
+     lines are contiguous with nsamps samples per line.
+  3. Windowed writes are only supported for files opened with plain
+     buffered access ("wb" or "r+b"); the compressed, direct, and running
+     checksum paths are all stream-oriented and cannot accept seeks.
+*****************************************************************************/
+int write_raw_binary_window
+(
+    FILE *rb_fptr,      /* I: pointer to the raw binary file */
+    int start_line,     /* I: first line of the window (0-based) */
+    int start_samp,     /* I: first sample of the window (0-based) */
+    int nlines,         /* I: number of lines to write to the file */
+    int nsamps,         /* I: number of samples per line to write */
+    int band_nsamps,    /* I: number of samples per line in the band file */
+    int size,           /* I: number of bytes per pixel (ex. sizeof(uint8)) */
+    void *img_array     /* I: array of nlines * nsamps * size to be written
+                              to the raw binary file */
+)
+{
+    int line;                /* looping variable for lines in the window */
+    int nvals;               /* number of values written to the file */
+    off_t offset;            /* byte offset of the current window line */
+    unsigned char *buf = img_array;  /* input position for the next line */
+    long long perf_start = espa_perf_start ();  /* instrumentation scope */
+
+    espa_startup_note_io ();
+
+    /* The stream-oriented write paths cannot accept seeks */
+    if (compressed_binary_find (rb_fptr) != NULL ||
+        find_raw_binary_direct (rb_fptr) != NULL ||
+        find_raw_binary_checksum (rb_fptr) != NULL)
+    {
+        espa_error ("write_raw_binary_window", "Windowed writes are not "
+            "supported for files opened for compressed, direct, or "
+            "checksummed writing.");
+        return ERROR;
+    }
+
+    /* Loop through the window lines, seeking to the start of the samples of
+       interest in each line and writing only those samples */
+    for (line = 0; line < nlines; line++)
+    {
+        offset = ((off_t) (start_line + line) * band_nsamps + start_samp) *
+            size;
+        if (fseeko (rb_fptr, offset, SEEK_SET) != 0)
+        {
+            espa_error ("write_raw_binary_window", "Seeking to line %d, "
+                "sample %d in the raw binary file.", start_line + line,
+                start_samp);
+            return ERROR;
+        }
+
+        nvals = fwrite (buf, size, nsamps, rb_fptr);
+        if (nvals != nsamps)
+        {
+            espa_error ("write_raw_binary_window", "Writing %d elements of "
+                "%d bytes in size to line %d of the raw binary file.",
+                nsamps, size, start_line + line);
+            return ERROR;
+        }
+
+        buf += (size_t) nsamps * size;
+    }
+
+    espa_perf_record ("write_raw_binary_window", perf_start,
+        (long long) nlines * nsamps * size);
+    return SUCCESS;
+}
+
+
+/* A pending buffer queued to the background writer thread.  At most
+   RB_ASYNC_NBUFS buffers can be outstanding, which provides the double
+   buffering; the producer blocks in write_raw_binary_async once the queue
+   is full. */
+typedef struct
+{
+    void *img_array;    /* caller's buffer to be written */
+    int nvals;          /* number of values (nlines * nsamps) to write */
+    int size;           /* number of bytes per value */
+} Raw_binary_async_buf_t;
+
+struct raw_binary_async
+{
+    FILE *rb_fptr;      /* pointer to the raw binary file being written */
+    pthread_t thread;   /* background I/O thread draining the queue */
+    pthread_mutex_t mutex;   /* protects the queue and status fields */
+    pthread_cond_t not_full; /* signaled when a queue slot frees up */
+    pthread_cond_t not_empty;/* signaled when a buffer is queued */
+    Raw_binary_async_buf_t queue[RB_ASYNC_NBUFS];  /* pending buffers */
+    int head;           /* index of the oldest queued buffer */
+    int count;          /* number of queued buffers */
+    bool shutdown;      /* true once the owner has requested shutdown */
+    int status;         /* SUCCESS until any queued write fails */
+};
 
-/* define the read/write formats to be used for opening a file */
-typedef enum {
-  RB_READ_FORMAT,
-  RB_WRITE_FORMAT,
-  RB_READ_WRITE_FORMAT,
-} Raw_binary_format_t;
-const char raw_binary_format[][4] = {"rb", "wb", "rb+"};
 
 /******************************************************************************
-MODULE: open_raw_binary
+MODULE: raw_binary_async_worker (static)
+
+PURPOSE: Background I/O thread which drains queued buffers to the raw binary
+file while the producer prepares the next buffer.
 
-PURPOSE: Opens a raw binary file for specified read/write/both binary access.
- 
 RETURN VALUE:
-Type = FILE *
-Value        Description
------        -----------
-NULL         Error opening the specified file for read specified access
-non-NULL     FILE pointer to the opened file
+Type = void *
+Always NULL.  Write failures are recorded in the writer's status field and
+reported by wait_raw_binary_async/close_raw_binary_async.
 
 HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
-12/12/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Original development
 
 NOTES:
 *****************************************************************************/
-FILE *open_raw_binary
+static void *raw_binary_async_worker
 (
-    char *infile,        /* I: name of the input file to be opened */
-    char *access_type    /* I: string for the access type for reading the
-                               input file; use the raw_binary_format
-                               array at the top of this file */
+    void *arg       /* I: pointer to the async writer state */
 )
 {
-    char FUNC_NAME[] = "open_raw_binary"; /* function name */
+    char FUNC_NAME[] = "raw_binary_async_worker"; /* function name */
     char errmsg[STR_SIZE];   /* error message */
-    FILE *rb_fptr = NULL;    /* pointer to the raw binary file */
+    Raw_binary_async_t *writer = arg;  /* async writer state */
+    Raw_binary_async_buf_t buf;        /* buffer currently being written */
+    int nvals;               /* number of values written to the file */
 
-    /* Open the file with the specified access type */
-    rb_fptr = fopen (infile, access_type);
-    if (rb_fptr == NULL)
+    while (true)
     {
-        sprintf (errmsg, "Opening raw binary file %s with %s access.",
-            infile, access_type);
-        error_handler (true, FUNC_NAME, errmsg);
-        return NULL;
+        /* Wait for a buffer to be queued or for shutdown */
+        pthread_mutex_lock (&writer->mutex);
+        while (writer->count == 0 && !writer->shutdown)
+            pthread_cond_wait (&writer->not_empty, &writer->mutex);
+        if (writer->count == 0 && writer->shutdown)
+        {
+            pthread_mutex_unlock (&writer->mutex);
+            break;
+        }
+        buf = writer->queue[writer->head];
+        pthread_mutex_unlock (&writer->mutex);
+
+        /* Write the buffer outside the lock so the producer can keep
+           queueing.  Skip the write if a previous one already failed. */
+        if (writer->status == SUCCESS)
+        {
+            nvals = fwrite (buf.img_array, buf.size, buf.nvals,
+                writer->rb_fptr);
+            if (nvals != buf.nvals)
+            {
+                sprintf (errmsg, "Writing %d elements of %d bytes in size "
+                    "to the raw binary file.", buf.nvals, buf.size);
+                error_handler (true, FUNC_NAME, errmsg);
+                writer->status = ERROR;
+            }
+        }
+
+        /* Release the queue slot and wake the producer */
+        pthread_mutex_lock (&writer->mutex);
+        writer->head = (writer->head + 1) % RB_ASYNC_NBUFS;
+        writer->count--;
+        pthread_cond_signal (&writer->not_full);
+        pthread_mutex_unlock (&writer->mutex);
     }
 
-    /* Return the file pointer */
-    return rb_fptr;
+    return NULL;
 }
 
 
 /******************************************************************************
-MODULE: close_raw_binary
+MODULE: open_raw_binary_async
+
+PURPOSE: Wraps an open raw binary file with a background I/O thread so that
+band buffers can be queued for writing while the caller prepares the next
+band.
 
-PURPOSE: Close the raw binary file
- 
 RETURN VALUE:
-Type = N/A
+Type = Raw_binary_async_t *
+Value        Description
+-----        -----------
+NULL         Error setting up the background writer
+non-NULL     Pointer to the async writer state
 
 HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
-12/12/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Original development
 
 NOTES:
+  1. The caller retains ownership of the FILE pointer and must not write to
+     it directly while the async writer is open.
 *****************************************************************************/
-void close_raw_binary
+Raw_binary_async_t *open_raw_binary_async
 (
-    FILE *fptr      /* I: pointer to raw binary file to be closed */
+    FILE *rb_fptr       /* I: pointer to the raw binary file to be written */
 )
 {
-    fclose (fptr);
+    char FUNC_NAME[] = "open_raw_binary_async"; /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    Raw_binary_async_t *writer = NULL;  /* async writer state */
+
+    /* Allocate and initialize the writer state */
+    writer = calloc (1, sizeof (Raw_binary_async_t));
+    if (writer == NULL)
+    {
+        sprintf (errmsg, "Allocating memory for the async writer state.");
+        error_handler (true, FUNC_NAME, errmsg);
+        return NULL;
+    }
+    writer->rb_fptr = rb_fptr;
+    writer->status = SUCCESS;
+    pthread_mutex_init (&writer->mutex, NULL);
+    pthread_cond_init (&writer->not_full, NULL);
+    pthread_cond_init (&writer->not_empty, NULL);
+
+    /* Start the background I/O thread */
+    if (pthread_create (&writer->thread, NULL, raw_binary_async_worker,
+        writer) != 0)
+    {
+        sprintf (errmsg, "Creating the background I/O thread.");
+        error_handler (true, FUNC_NAME, errmsg);
+        free (writer);
+        return NULL;
+    }
+
+    return writer;
 }
 
 
 /******************************************************************************
-MODULE: write_raw_binary
+MODULE: write_raw_binary_async
+
+PURPOSE: Queues nlines of data to be written to the raw binary file by the
+background I/O thread
 
-PURPOSE: Writes nlines of data to the raw binary file
- 
 RETURN VALUE:
 Type = int
 Value        Description
 -----        -----------
-ERROR        An error occurred writing data to the raw binary file
-SUCCESS      Writing was successful
+ERROR        A previously-queued write failed
+SUCCESS      Buffer was queued successfully
 
 HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
-12/12/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Original development
 
 NOTES:
+  1. The caller must not modify or free img_array until this buffer has
+     drained.  With double buffering that is guaranteed once a subsequent
+     write_raw_binary_async call for another buffer returns, or after
+     wait_raw_binary_async.
 *****************************************************************************/
-int write_raw_binary
+int write_raw_binary_async
 (
-    FILE *rb_fptr,      /* I: pointer to the raw binary file */
+    Raw_binary_async_t *writer,  /* I: async writer from
+                                       open_raw_binary_async */
     int nlines,         /* I: number of lines to write to the file */
     int nsamps,         /* I: number of samples to write to the file */
     int size,           /* I: number of bytes per pixel (ex. sizeof(uint8)) */
@@ -126,21 +2469,107 @@ int write_raw_binary
                               to the raw binary file */
 )
 {
-    char FUNC_NAME[] = "write_raw_binary"; /* function name */
-    char errmsg[STR_SIZE];   /* error message */
-    int nvals;               /* number of values written to the file */
+    int tail;           /* index of the queue slot to fill */
 
-    /* Write the data to the raw binary file */
-    nvals = fwrite (img_array, size, nlines * nsamps, rb_fptr);
-    if (nvals != nlines * nsamps)
-    {
-        sprintf (errmsg, "Writing %d elements of %d bytes in size to the "
-            "raw binary file.", nlines * nsamps, size);
-        error_handler (true, FUNC_NAME, errmsg);
-        return ERROR;
-    }
+    /* Wait for a free queue slot, then queue the buffer */
+    pthread_mutex_lock (&writer->mutex);
+    while (writer->count == RB_ASYNC_NBUFS)
+        pthread_cond_wait (&writer->not_full, &writer->mutex);
+    tail = (writer->head + writer->count) % RB_ASYNC_NBUFS;
+    writer->queue[tail].img_array = img_array;
+    writer->queue[tail].nvals = nlines * nsamps;
+    writer->queue[tail].size = size;
+    writer->count++;
+    pthread_cond_signal (&writer->not_empty);
+    pthread_mutex_unlock (&writer->mutex);
 
-    return SUCCESS;
+    /* Report any failure from buffers that already drained; the error
+       message was emitted by the I/O thread */
+    return writer->status;
+}
+
+
+/******************************************************************************
+MODULE: wait_raw_binary_async
+
+PURPOSE: Blocks until all queued buffers have been written to the raw binary
+file
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+ERROR        An error occurred writing queued data to the raw binary file
+SUCCESS      All queued writes completed successfully
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+int wait_raw_binary_async
+(
+    Raw_binary_async_t *writer   /* I: async writer from
+                                       open_raw_binary_async */
+)
+{
+    /* Wait for the queue to drain completely */
+    pthread_mutex_lock (&writer->mutex);
+    while (writer->count != 0)
+        pthread_cond_wait (&writer->not_full, &writer->mutex);
+    pthread_mutex_unlock (&writer->mutex);
+
+    return writer->status;
+}
+
+
+/******************************************************************************
+MODULE: close_raw_binary_async
+
+PURPOSE: Drains any queued buffers, stops the background I/O thread, and
+releases the async writer state
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+ERROR        An error occurred writing queued data to the raw binary file
+SUCCESS      All queued writes completed successfully
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The underlying FILE pointer is not closed; the caller still owns it
+     and should close it with close_raw_binary.
+*****************************************************************************/
+int close_raw_binary_async
+(
+    Raw_binary_async_t *writer   /* I: async writer from
+                                       open_raw_binary_async */
+)
+{
+    int status;         /* overall status of the queued writes */
+
+    /* Signal shutdown and wait for the I/O thread to finish draining */
+    pthread_mutex_lock (&writer->mutex);
+    writer->shutdown = true;
+    pthread_cond_signal (&writer->not_empty);
+    pthread_mutex_unlock (&writer->mutex);
+    pthread_join (writer->thread, NULL);
+
+    /* Clean up the writer state */
+    status = writer->status;
+    pthread_mutex_destroy (&writer->mutex);
+    pthread_cond_destroy (&writer->not_full);
+    pthread_cond_destroy (&writer->not_empty);
+    free (writer);
+
+    return status;
 }
 
 
@@ -160,6 +2589,12 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 12/12/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added performance instrumentation of the reads
+8/31/2026    Gail Schmidt     Decompress block-compressed bands transparently
+8/31/2026    Gail Schmidt     Swap the byte order of the values read when
+                              requested via enable_raw_binary_byte_swap
+8/31/2026    Gail Schmidt     Report errors through espa_error so the hot
+                              path carries no errmsg stack buffer
 
 NOTES:
 *****************************************************************************/
@@ -174,20 +2609,311 @@ int read_raw_binary
                               already have been allocated) */
 )
 {
-    char FUNC_NAME[] = "read_raw_binary"; /* function name */
-    char errmsg[STR_SIZE];   /* error message */
     int nvals;               /* number of values read from the file */
+    Espa_compressed_binary_t *zb = NULL; /* compressed band state, if any */
+    Raw_binary_swap_t *swap = NULL;      /* byte-swap state, if any */
+    long long perf_start = espa_perf_start ();  /* instrumentation scope */
 
-    /* Read the data from the raw binary file */
-    nvals = fread (img_array, size, nlines * nsamps, rb_fptr);
-    if (nvals != nlines * nsamps)
+    espa_startup_note_io ();
+
+    /* Block-compressed bands are decompressed transparently */
+    zb = compressed_binary_find (rb_fptr);
+    if (zb != NULL)
     {
-        sprintf (errmsg, "Reading %d elements of %d bytes in size from the "
-            "raw binary file.", nlines * nsamps, size);
-        error_handler (true, FUNC_NAME, errmsg);
+        if (read_compressed_binary (zb, nlines, nsamps, size, img_array) !=
+            SUCCESS)
+        {  /* Error messages already printed */
+            return ERROR;
+        }
+    }
+    else
+    {
+        /* Read the data from the raw binary file */
+        nvals = fread (img_array, size, nlines * nsamps, rb_fptr);
+        if (nvals != nlines * nsamps)
+        {
+            espa_error ("read_raw_binary", "Reading %d elements of %d bytes "
+                "in size from the raw binary file.", nlines * nsamps, size);
+            return ERROR;
+        }
+    }
+
+    /* Bands written on a machine of the other byte order are swapped while
+       the buffer is still in cache */
+    swap = find_raw_binary_byte_swap (rb_fptr);
+    if (swap != NULL)
+    {
+        if (espa_swap_bytes (img_array, (long) nlines * nsamps, swap->size)
+            != SUCCESS)
+        {  /* Error messages already printed */
+            return ERROR;
+        }
+    }
+
+    espa_perf_record ("read_raw_binary", perf_start,
+        (long long) nlines * nsamps * size);
+    return SUCCESS;
+}
+
+
+/******************************************************************************
+MODULE: read_raw_binary_window
+
+PURPOSE: Reads a spatial window of data from the raw binary file, seeking to
+the start of each line in the window and reading only the samples of
+interest
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+ERROR        An error occurred reading data from the raw binary file
+SUCCESS      Reading was successful
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Decompress block-compressed bands transparently
+8/31/2026    Gail Schmidt     Swap the byte order of the values read when
+                              requested via enable_raw_binary_byte_swap
+
+NOTES:
+  1. start_line and start_samp are 0-based within the band.
+  2. The output buffer is packed with the window data only, i.e. the window
+     lines are contiguous with nsamps samples per line.
+*****************************************************************************/
+int read_raw_binary_window
+(
+    FILE *rb_fptr,      /* I: pointer to the raw binary file */
+    int start_line,     /* I: first line of the window (0-based) */
+    int start_samp,     /* I: first sample of the window (0-based) */
+    int nlines,         /* I: number of lines to read from the file */
+    int nsamps,         /* I: number of samples per line to read */
+    int band_nsamps,    /* I: number of samples per line in the band file */
+    int size,           /* I: number of bytes per pixel (ex. sizeof(uint8)) */
+    void *img_array     /* O: array of nlines * nsamps * size to be read from
+                              the raw binary file (sufficient space should
+                              already have been allocated) */
+)
+{
+    int line;                /* looping variable for lines in the window */
+    int nvals;               /* number of values read from the file */
+    off_t offset;            /* byte offset of the current window line */
+    unsigned char *buf = img_array;  /* output position for the next line */
+    Espa_compressed_binary_t *zb = NULL; /* compressed band state, if any */
+    Raw_binary_swap_t *swap = NULL;      /* byte-swap state, if any */
+
+    espa_startup_note_io ();
+
+    /* Block-compressed bands are decompressed transparently */
+    zb = compressed_binary_find (rb_fptr);
+    if (zb != NULL)
+    {
+        if (read_compressed_binary_window (zb, start_line, start_samp,
+            nlines, nsamps, band_nsamps, size, img_array) != SUCCESS)
+        {  /* Error messages already printed */
+            return ERROR;
+        }
+
+        /* Bands written on a machine of the other byte order are swapped
+           while the buffer is still in cache */
+        swap = find_raw_binary_byte_swap (rb_fptr);
+        if (swap != NULL)
+        {
+            if (espa_swap_bytes (img_array, (long) nlines * nsamps,
+                swap->size) != SUCCESS)
+            {  /* Error messages already printed */
+                return ERROR;
+            }
+        }
+
+        return SUCCESS;
+    }
+
+    /* Loop through the window lines, seeking to the start of the samples of
+       interest in each line and reading only those samples */
+    for (line = 0; line < nlines; line++)
+    {
+        offset = ((off_t) (start_line + line) * band_nsamps + start_samp) *
+            size;
+        if (fseeko (rb_fptr, offset, SEEK_SET) != 0)
+        {
+            espa_error ("read_raw_binary_window", "Seeking to line %d, "
+                "sample %d in the raw binary file.", start_line + line,
+                start_samp);
+            return ERROR;
+        }
+
+        nvals = fread (buf, size, nsamps, rb_fptr);
+        if (nvals != nsamps)
+        {
+            espa_error ("read_raw_binary_window", "Reading %d elements of "
+                "%d bytes in size from line %d of the raw binary file.",
+                nsamps, size, start_line + line);
+            return ERROR;
+        }
+
+        buf += (size_t) nsamps * size;
+    }
+
+    /* Bands written on a machine of the other byte order are swapped while
+       the buffer is still in cache */
+    swap = find_raw_binary_byte_swap (rb_fptr);
+    if (swap != NULL)
+    {
+        if (espa_swap_bytes (img_array, (long) nlines * nsamps, swap->size)
+            != SUCCESS)
+        {  /* Error messages already printed */
+            return ERROR;
+        }
+    }
+
+    return SUCCESS;
+}
+
+
+/******************************************************************************
+MODULE: write_raw_binary_packed_bits
+
+PURPOSE: Writes nlines of single-byte mask data to the raw binary file as
+packed bits, eight pixels per byte.  The most significant bit of each byte
+holds the leftmost pixel, matching the bit order used by the land/water mask
+generation, and each line starts on a byte boundary.  Any non-zero input
+pixel sets its bit.
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+ERROR        An error occurred writing data to the raw binary file
+SUCCESS      Writing was successful
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Only one line is packed at a time, so the packed output adds a single
+     line buffer of (nsamps + 7) / 8 bytes regardless of the band size.
+*****************************************************************************/
+int write_raw_binary_packed_bits
+(
+    FILE *rb_fptr,      /* I: pointer to the raw binary file */
+    int nlines,         /* I: number of lines to write to the file */
+    int nsamps,         /* I: number of samples per line to write */
+    unsigned char *img_array  /* I: array of nlines * nsamps mask bytes to be
+                                    packed and written to the raw binary
+                                    file */
+)
+{
+    int line;                /* looping variable for lines */
+    int samp;                /* looping variable for samples */
+    int packed_nsamps;       /* number of packed bytes per line */
+    unsigned char *packed = NULL;    /* packed buffer for the current line */
+    unsigned char *buf = img_array;  /* input position for the next line */
+
+    /* Allocate the packed buffer for one line */
+    packed_nsamps = (nsamps + 7) / 8;
+    packed = calloc (packed_nsamps, sizeof (unsigned char));
+    if (packed == NULL)
+    {
+        espa_error ("write_raw_binary_packed_bits", "Allocating the packed "
+            "line buffer of %d bytes.", packed_nsamps);
         return ERROR;
     }
 
+    /* Pack and write the lines one at a time */
+    for (line = 0; line < nlines; line++)
+    {
+        memset (packed, 0, packed_nsamps);
+        for (samp = 0; samp < nsamps; samp++)
+        {
+            if (buf[samp])
+                packed[samp / 8] |= 1 << (7 - samp % 8);
+        }
+
+        if (write_raw_binary (rb_fptr, 1, packed_nsamps,
+            sizeof (unsigned char), packed) != SUCCESS)
+        {  /* Error messages already printed */
+            free (packed);
+            return ERROR;
+        }
+
+        buf += nsamps;
+    }
+
+    free (packed);
     return SUCCESS;
 }
 
+
+/******************************************************************************
+MODULE: read_raw_binary_packed_bits
+
+PURPOSE: Reads nlines of packed-bit mask data, as written by
+write_raw_binary_packed_bits, and expands them to one byte per pixel (0 or 1).
+
+RETURN VALUE:
+Type = int
+Value        Description
+-----        -----------
+ERROR        An error occurred reading data from the raw binary file
+SUCCESS      Reading was successful
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The lines are expanded one at a time through a line buffer of
+     (nsamps + 7) / 8 bytes, so consumers can stream a band of any size
+     through a small window of lines.
+*****************************************************************************/
+int read_raw_binary_packed_bits
+(
+    FILE *rb_fptr,      /* I: pointer to the raw binary file */
+    int nlines,         /* I: number of lines to read from the file */
+    int nsamps,         /* I: number of samples per line to read */
+    unsigned char *img_array  /* O: array of nlines * nsamps mask bytes
+                                    (sufficient space should already have
+                                    been allocated) */
+)
+{
+    int line;                /* looping variable for lines */
+    int samp;                /* looping variable for samples */
+    int packed_nsamps;       /* number of packed bytes per line */
+    unsigned char *packed = NULL;    /* packed buffer for the current line */
+    unsigned char *buf = img_array;  /* output position for the next line */
+
+    /* Allocate the packed buffer for one line */
+    packed_nsamps = (nsamps + 7) / 8;
+    packed = malloc (packed_nsamps * sizeof (unsigned char));
+    if (packed == NULL)
+    {
+        espa_error ("read_raw_binary_packed_bits", "Allocating the packed "
+            "line buffer of %d bytes.", packed_nsamps);
+        return ERROR;
+    }
+
+    /* Read and expand the lines one at a time */
+    for (line = 0; line < nlines; line++)
+    {
+        if (read_raw_binary (rb_fptr, 1, packed_nsamps,
+            sizeof (unsigned char), packed) != SUCCESS)
+        {  /* Error messages already printed */
+            free (packed);
+            return ERROR;
+        }
+
+        for (samp = 0; samp < nsamps; samp++)
+            buf[samp] = (packed[samp / 8] >> (7 - samp % 8)) & 1;
+
+        buf += nsamps;
+    }
+
+    free (packed);
+    return SUCCESS;
+}
@@ -12,6 +12,15 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 12/12/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Pull in the block-compressed band container
+8/31/2026    Gail Schmidt     Added byte swapping of reads for bands written
+                              on a machine of the other byte order
+8/31/2026    Gail Schmidt     Added packed-bit mask writes and the matching
+                              streaming expander
+8/31/2026    Gail Schmidt     Added the band open which negotiates the
+                              compressed output sink (set ESPA_IMG_COMPRESS)
+8/31/2026    Gail Schmidt     Added atomic output commits through a partial
+                              file renamed into place (set ESPA_ATOMIC_OUTPUT)
 
 NOTES:
 *****************************************************************************/
@@ -23,6 +32,16 @@ NOTES:
 #include <stdio.h>
 #include <string.h>
 #include "error_handler.h"
+#include "espa_checksum.h"
+#include "espa_byteswap.h"
+#include "compressed_binary_io.h"
+
+/* Number of buffers which can be outstanding in the async writer; two
+   provides the classic double buffering of decode and drain */
+#define RB_ASYNC_NBUFS 2
+
+/* Opaque state for the background band writer */
+typedef struct raw_binary_async Raw_binary_async_t;
 
 /* Prototypes */
 FILE *open_raw_binary
@@ -38,6 +57,74 @@ void close_raw_binary
     FILE *fptr      /* I: pointer to raw binary file to be closed */
 );
 
+int raw_binary_compress_enabled (void);
+
+FILE *open_raw_binary_band
+(
+    char *outfile,       /* I: name of the band output file to be created */
+    int nlines,          /* I: number of lines in the band */
+    int nsamps,          /* I: number of samples per line in the band */
+    int size,            /* I: number of bytes per pixel */
+    char *access_type    /* I: access type for a plain raw binary open, used
+                               when compressed output was not requested */
+);
+
+int remove_raw_binary
+(
+    char *infile         /* I: name of the file or object to be removed */
+);
+
+int enable_raw_binary_checksum
+(
+    FILE *rb_fptr   /* I: stream whose writes are to be checksummed */
+);
+
+int finish_raw_binary_checksum
+(
+    FILE *rb_fptr,  /* I: stream whose checksum is to be collected */
+    char *checksum  /* O: hex checksum string of ESPA_CHECKSUM_STR_SIZE
+                          characters */
+);
+
+int enable_raw_binary_byte_swap
+(
+    FILE *rb_fptr,  /* I: stream whose reads are to be byte-swapped */
+    int size        /* I: number of bytes per value in the band */
+);
+
+void advise_raw_binary_fd_sequential
+(
+    int fd          /* I: descriptor of the file to be read sequentially */
+);
+
+void advise_raw_binary_fd_done
+(
+    int fd          /* I: descriptor of the file which has been consumed */
+);
+
+void advise_raw_binary_sequential
+(
+    FILE *rb_fptr   /* I: pointer to the raw binary file to be read */
+);
+
+void advise_raw_binary_done
+(
+    FILE *rb_fptr   /* I: pointer to the consumed raw binary file */
+);
+
+int open_raw_binary_mapped
+(
+    char *infile,       /* I: name of the input file to be mapped */
+    void **map_addr,    /* O: address of the read-only mapped view */
+    size_t *map_length  /* O: length of the mapped view in bytes */
+);
+
+void close_raw_binary_mapped
+(
+    void *map_addr,     /* I: address of the mapped view to be released */
+    size_t map_length   /* I: length of the mapped view in bytes */
+);
+
 int write_raw_binary
 (
     FILE *rb_fptr,      /* I: pointer to the raw binary file */
@@ -48,6 +135,68 @@ int write_raw_binary
                               to the raw binary file */
 );
 
+int write_raw_binary_window
+(
+    FILE *rb_fptr,      /* I: pointer to the raw binary file */
+    int start_line,     /* I: first line of the window (0-based) */
+    int start_samp,     /* I: first sample of the window (0-based) */
+    int nlines,         /* I: number of lines to write to the file */
+    int nsamps,         /* I: number of samples per line to write */
+    int band_nsamps,    /* I: number of samples per line in the band file */
+    int size,           /* I: number of bytes per pixel (ex. sizeof(uint8)) */
+    void *img_array     /* I: array of nlines * nsamps * size to be written
+                              to the raw binary file */
+);
+
+int write_raw_binary_packed_bits
+(
+    FILE *rb_fptr,      /* I: pointer to the raw binary file */
+    int nlines,         /* I: number of lines to write to the file */
+    int nsamps,         /* I: number of samples per line to write */
+    unsigned char *img_array  /* I: array of nlines * nsamps mask bytes to be
+                                    packed and written to the raw binary
+                                    file */
+);
+
+int read_raw_binary_packed_bits
+(
+    FILE *rb_fptr,      /* I: pointer to the raw binary file */
+    int nlines,         /* I: number of lines to read from the file */
+    int nsamps,         /* I: number of samples per line to read */
+    unsigned char *img_array  /* O: array of nlines * nsamps mask bytes
+                                    (sufficient space should already have
+                                    been allocated) */
+);
+
+Raw_binary_async_t *open_raw_binary_async
+(
+    FILE *rb_fptr       /* I: pointer to the raw binary file to be written */
+);
+
+int write_raw_binary_async
+(
+    Raw_binary_async_t *writer,  /* I: async writer from
+                                       open_raw_binary_async */
+    int nlines,         /* I: number of lines to write to the file */
+    int nsamps,         /* I: number of samples to write to the file */
+    int size,           /* I: number of bytes per pixel (ex. sizeof(uint8)) */
+    void *img_array     /* I: array of nlines * nsamps * size to be written
+                              to the raw binary file; must remain valid
+                              until the buffer has drained */
+);
+
+int wait_raw_binary_async
+(
+    Raw_binary_async_t *writer   /* I: async writer from
+                                       open_raw_binary_async */
+);
+
+int close_raw_binary_async
+(
+    Raw_binary_async_t *writer   /* I: async writer from
+                                       open_raw_binary_async */
+);
+
 int read_raw_binary
 (
     FILE *rb_fptr,      /* I: pointer to the raw binary file */
@@ -59,4 +208,18 @@ int read_raw_binary
                               already have been allocated) */
 );
 
+int read_raw_binary_window
+(
+    FILE *rb_fptr,      /* I: pointer to the raw binary file */
+    int start_line,     /* I: first line of the window (0-based) */
+    int start_samp,     /* I: first sample of the window (0-based) */
+    int nlines,         /* I: number of lines to read from the file */
+    int nsamps,         /* I: number of samples per line to read */
+    int band_nsamps,    /* I: number of samples per line in the band file */
+    int size,           /* I: number of bytes per pixel (ex. sizeof(uint8)) */
+    void *img_array     /* O: array of nlines * nsamps * size to be read from
+                              the raw binary file (sufficient space should
+                              already have been allocated) */
+);
+
 #endif
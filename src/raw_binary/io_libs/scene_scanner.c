@@ -0,0 +1,472 @@
+/*****************************************************************************
+FILE: scene_scanner.c
+
+PURPOSE: Contains functions for scanning product directories for ESPA scenes
+and writing batch manifests.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The directory is listed once, then each scene is characterized by a
+     task on the shared thread pool: the band files are paired and stat'ed
+     and the identity fields are peeked from the head of the XML file.
+     Spreading the per-scene stat and peek calls across the pool overlaps
+     their round trips, which is where the time goes on network
+     filesystems.
+*****************************************************************************/
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include "scene_scanner.h"
+#include "espa_thread_pool.h"
+
+/* Shared context for the scene characterization tasks */
+typedef struct
+{
+    char *dir_path;            /* product directory being scanned */
+    char **names;              /* all the directory entry names */
+    int num_names;             /* number of directory entries */
+    Espa_scene_listing_t *listing;  /* listing entries being filled in */
+} Scene_scan_ctx_t;
+
+/******************************************************************************
+MODULE:  peek_xml_field (static function)
+
+PURPOSE: Pulls the text of a simple XML element out of the peeked head of a
+metadata file, without parsing the XML.
+
+RETURN VALUE:
+Type = N/A
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The output string is emptied if the element is not in the peeked head,
+     which callers treat as "not known without a full parse".
+******************************************************************************/
+static void peek_xml_field
+(
+    char *head,          /* I: NUL-terminated head of the XML file */
+    char *element,       /* I: element name to be pulled */
+    char *value,         /* O: element text, or "" if not found */
+    size_t value_size    /* I: size of the value string */
+)
+{
+    char open_tag[STR_SIZE];  /* opening tag for the element */
+    char *start = NULL;       /* start of the element text */
+    char *end = NULL;         /* end of the element text */
+    size_t length;            /* length of the element text */
+
+    value[0] = '\0';
+    snprintf (open_tag, sizeof (open_tag), "<%s>", element);
+    start = strstr (head, open_tag);
+    if (start == NULL)
+        return;
+    start += strlen (open_tag);
+
+    end = strchr (start, '<');
+    if (end == NULL)
+        return;
+
+    length = end - start;
+    if (length >= value_size)
+        length = value_size - 1;
+    memcpy (value, start, length);
+    value[length] = '\0';
+}
+
+
+/******************************************************************************
+MODULE:  scan_scene_task (static function)
+
+PURPOSE: Characterizes one discovered scene: pairs and stats its band files
+and peeks the identity fields from the head of its XML file.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error characterizing the scene
+SUCCESS         Scene listing entry was filled in
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. A band file is paired with the scene when its name is the XML file
+     base plus a suffix ending in .img, which matches the band naming used
+     throughout the library (<base>_<band>.img).
+******************************************************************************/
+static int scan_scene_task
+(
+    void *ctx,           /* I: shared scene scan context */
+    int item             /* I: index of the scene to be characterized */
+)
+{
+    char FUNC_NAME[] = "scan_scene_task";  /* function name */
+    char errmsg[STR_SIZE];     /* error message */
+    char head[SCENE_SCAN_PEEK_BYTES + 1];  /* peeked head of the XML file */
+    char img_file[STR_SIZE];   /* name of the current band file (with path) */
+    char *base = NULL;         /* XML filename without the path */
+    char *name = NULL;         /* current directory entry name */
+    char *suffix = NULL;       /* entry name past the scene base */
+    int i;                     /* looping variable for directory entries */
+    int count;                 /* number of chars copied in snprintf */
+    size_t base_len;           /* length of the scene base name */
+    size_t nread;              /* number of bytes peeked */
+    FILE *fp = NULL;           /* file pointer for the XML peek */
+    struct stat st;            /* band file information */
+    Scene_scan_ctx_t *scan = ctx;  /* shared scene scan context */
+    Espa_scene_listing_t *scene = &scan->listing[item];  /* entry to fill */
+
+    /* Determine the scene base name (the XML filename without the path and
+       extension), which pairs the band files */
+    base = strrchr (scene->xml_file, '/');
+    if (base != NULL)
+        base++;
+    else
+        base = scene->xml_file;
+    base_len = strlen (base) - strlen (".xml");
+
+    /* Pair and stat the band files for this scene */
+    scene->nband_files = 0;
+    scene->band_bytes = 0;
+    for (i = 0; i < scan->num_names; i++)
+    {
+        name = scan->names[i];
+        if (strncmp (name, base, base_len) != 0)
+            continue;
+        suffix = name + base_len;
+        if (strlen (suffix) < strlen (".img") ||
+            strcmp (suffix + strlen (suffix) - strlen (".img"), ".img") != 0)
+            continue;
+
+        count = snprintf (img_file, sizeof (img_file), "%s/%s",
+            scan->dir_path, name);
+        if (count < 0 || count >= sizeof (img_file))
+        {
+            sprintf (errmsg, "Overflow of img_file string");
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+
+        if (stat (img_file, &st) != 0)
+        {
+            sprintf (errmsg, "Unable to stat band file: %.1024s", img_file);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+
+        scene->nband_files++;
+        scene->band_bytes += (long long) st.st_size;
+    }
+
+    /* Peek the head of the XML file for the identity fields, which appear
+       at the top of the global metadata.  Fields beyond the peeked head
+       are left empty rather than paying for a full parse. */
+    fp = fopen (scene->xml_file, "r");
+    if (fp == NULL)
+    {
+        sprintf (errmsg, "Unable to open XML file: %.1024s", scene->xml_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+    nread = fread (head, 1, SCENE_SCAN_PEEK_BYTES, fp);
+    fclose (fp);
+    head[nread] = '\0';
+
+    peek_xml_field (head, "satellite", scene->satellite,
+        sizeof (scene->satellite));
+    peek_xml_field (head, "instrument", scene->instrument,
+        sizeof (scene->instrument));
+    peek_xml_field (head, "acquisition_date", scene->acquisition_date,
+        sizeof (scene->acquisition_date));
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  compare_scene_listings (static function)
+
+PURPOSE: qsort comparison routine ordering the scene listing by XML filename.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+<0,0,>0         Standard comparison result
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static int compare_scene_listings
+(
+    const void *first,   /* I: first scene listing entry */
+    const void *second   /* I: second scene listing entry */
+)
+{
+    return (strcmp (((const Espa_scene_listing_t *) first)->xml_file,
+        ((const Espa_scene_listing_t *) second)->xml_file));
+}
+
+
+/******************************************************************************
+MODULE:  scan_product_directory
+
+PURPOSE: Scans a product directory for ESPA scenes, pairing each XML file
+with its raw binary band files and peeking the identity fields from the head
+of the XML, and returns the discovered scenes as a listing.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error scanning the directory
+SUCCESS         Directory was scanned
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The per-scene stat and peek calls run as tasks on the shared thread
+     pool, which overlaps their round trips on network filesystems.
+  2. A listing with zero scenes is a successful scan of a directory with
+     no XML files.
+******************************************************************************/
+int scan_product_directory
+(
+    char *dir_path,        /* I: product directory to be scanned */
+    int num_threads,       /* I: number of threads to use (0 or less chooses
+                                 automatically) */
+    Espa_scene_listing_t **listing,  /* O: allocated array of the discovered
+                                 scenes, sorted by XML filename; freed by
+                                 the caller */
+    int *num_scenes        /* O: number of scenes in the listing */
+)
+{
+    char FUNC_NAME[] = "scan_product_directory";  /* function name */
+    char errmsg[STR_SIZE];     /* error message */
+    char **names = NULL;       /* all the directory entry names */
+    char **tmp_names = NULL;   /* temporary pointer for growing the names */
+    int num_names = 0;         /* number of directory entries */
+    int alloc_names = 0;       /* allocated size of the names array */
+    int nscenes = 0;           /* number of XML files found */
+    int i;                     /* looping variable */
+    int count;                 /* number of chars copied in snprintf */
+    int status = SUCCESS;      /* return status of the scene tasks */
+    size_t name_len;           /* length of the current entry name */
+    DIR *dir = NULL;           /* directory being scanned */
+    struct dirent *entry = NULL;  /* current directory entry */
+    Espa_scene_listing_t *scenes = NULL;  /* scene listing being built */
+    Scene_scan_ctx_t scan;     /* shared context for the scene tasks */
+
+    *listing = NULL;
+    *num_scenes = 0;
+
+    /* List the directory once, collecting all the entry names so the band
+       pairing never touches the filesystem again */
+    dir = opendir (dir_path);
+    if (dir == NULL)
+    {
+        sprintf (errmsg, "Unable to open product directory: %s", dir_path);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    while ((entry = readdir (dir)) != NULL)
+    {
+        if (entry->d_name[0] == '.')
+            continue;
+
+        if (num_names == alloc_names)
+        {
+            alloc_names = alloc_names == 0 ? 256 : alloc_names * 2;
+            tmp_names = realloc (names, alloc_names * sizeof (char *));
+            if (tmp_names == NULL)
+            {
+                sprintf (errmsg, "Allocating the directory entry names");
+                error_handler (true, FUNC_NAME, errmsg);
+                break;
+            }
+            names = tmp_names;
+        }
+
+        names[num_names] = strdup (entry->d_name);
+        if (names[num_names] == NULL)
+        {
+            sprintf (errmsg, "Allocating a directory entry name");
+            error_handler (true, FUNC_NAME, errmsg);
+            break;
+        }
+        num_names++;
+
+        if (strlen (entry->d_name) > strlen (".xml") &&
+            strcmp (entry->d_name + strlen (entry->d_name) -
+                strlen (".xml"), ".xml") == 0)
+            nscenes++;
+    }
+    closedir (dir);
+
+    if (entry != NULL)
+    {   /* the listing loop broke out on an allocation error */
+        for (i = 0; i < num_names; i++)
+            free (names[i]);
+        free (names);
+        return (ERROR);
+    }
+
+    /* Build the listing entries for the XML files */
+    if (nscenes > 0)
+    {
+        scenes = calloc (nscenes, sizeof (Espa_scene_listing_t));
+        if (scenes == NULL)
+        {
+            sprintf (errmsg, "Allocating the scene listing for %d scenes",
+                nscenes);
+            error_handler (true, FUNC_NAME, errmsg);
+            for (i = 0; i < num_names; i++)
+                free (names[i]);
+            free (names);
+            return (ERROR);
+        }
+
+        nscenes = 0;
+        for (i = 0; i < num_names; i++)
+        {
+            name_len = strlen (names[i]);
+            if (name_len <= strlen (".xml") ||
+                strcmp (names[i] + name_len - strlen (".xml"), ".xml") != 0)
+                continue;
+
+            count = snprintf (scenes[nscenes].xml_file,
+                sizeof (scenes[nscenes].xml_file), "%s/%s", dir_path,
+                names[i]);
+            if (count < 0 || count >= sizeof (scenes[nscenes].xml_file))
+            {
+                sprintf (errmsg, "Overflow of the scene XML filename");
+                error_handler (true, FUNC_NAME, errmsg);
+                free (scenes);
+                for (i = 0; i < num_names; i++)
+                    free (names[i]);
+                free (names);
+                return (ERROR);
+            }
+            nscenes++;
+        }
+
+        /* Characterize the scenes across the thread pool */
+        scan.dir_path = dir_path;
+        scan.names = names;
+        scan.num_names = num_names;
+        scan.listing = scenes;
+        status = espa_pool_run (scan_scene_task, &scan, nscenes,
+            num_threads);
+
+        /* Sort the listing so the manifest order does not depend on the
+           readdir order */
+        qsort (scenes, nscenes, sizeof (Espa_scene_listing_t),
+            compare_scene_listings);
+    }
+
+    for (i = 0; i < num_names; i++)
+        free (names[i]);
+    free (names);
+
+    if (status != SUCCESS)
+    {
+        sprintf (errmsg, "Characterizing the scenes in directory: %s",
+            dir_path);
+        error_handler (true, FUNC_NAME, errmsg);
+        free (scenes);
+        return (ERROR);
+    }
+
+    *listing = scenes;
+    *num_scenes = nscenes;
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  write_scene_manifest
+
+PURPOSE: Writes the discovered scenes to a manifest file, one scene per line.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error writing the manifest
+SUCCESS         Manifest was written
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Each line holds the XML filename followed by the satellite,
+     instrument, acquisition date, band file count, and total band bytes,
+     separated by tabs.  Identity fields which were not in the peeked head
+     of the XML are written as "-".
+******************************************************************************/
+int write_scene_manifest
+(
+    char *manifest_file,   /* I: output manifest filename */
+    Espa_scene_listing_t *listing,  /* I: array of the discovered scenes */
+    int num_scenes         /* I: number of scenes in the listing */
+)
+{
+    char FUNC_NAME[] = "write_scene_manifest";  /* function name */
+    char errmsg[STR_SIZE];     /* error message */
+    int i;                     /* looping variable for scenes */
+    FILE *fp = NULL;           /* file pointer for the manifest */
+    Espa_scene_listing_t *scene = NULL;  /* current scene */
+
+    fp = fopen (manifest_file, "w");
+    if (fp == NULL)
+    {
+        sprintf (errmsg, "Unable to create manifest file: %s", manifest_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    for (i = 0; i < num_scenes; i++)
+    {
+        scene = &listing[i];
+        fprintf (fp, "%s\t%s\t%s\t%s\t%d\t%lld\n", scene->xml_file,
+            scene->satellite[0] ? scene->satellite : "-",
+            scene->instrument[0] ? scene->instrument : "-",
+            scene->acquisition_date[0] ? scene->acquisition_date : "-",
+            scene->nband_files, scene->band_bytes);
+    }
+
+    if (fclose (fp) != 0)
+    {
+        sprintf (errmsg, "Error writing manifest file: %s", manifest_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    return (SUCCESS);
+}
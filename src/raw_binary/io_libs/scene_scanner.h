@@ -0,0 +1,70 @@
+/*****************************************************************************
+FILE: scene_scanner.h
+
+PURPOSE: Contains defines and prototypes for scanning product directories
+for ESPA scenes and writing batch manifests.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The scanner discovers the scenes in a product directory without
+     parsing the XML metadata: each XML file is paired with its raw binary
+     band files by name, and the identity fields are pulled from a peek at
+     the head of the XML file.  The heavyweight stat and peek work is
+     spread across the shared thread pool, which keeps discovery fast over
+     network filesystems.
+*****************************************************************************/
+
+#ifndef SCENE_SCANNER_H
+#define SCENE_SCANNER_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "error_handler.h"
+
+/* Number of bytes peeked from the head of each XML file for the identity
+   fields, which appear at the top of the global metadata */
+#define SCENE_SCAN_PEEK_BYTES 2048
+
+/* One discovered scene in a product directory */
+typedef struct
+{
+    char xml_file[STR_SIZE];      /* scene XML metadata file (with path) */
+    char satellite[STR_SIZE];     /* satellite from the XML peek ("" if the
+                                     field was not in the peeked head) */
+    char instrument[STR_SIZE];    /* instrument from the XML peek */
+    char acquisition_date[STR_SIZE];  /* acquisition date from the XML peek */
+    int nband_files;              /* number of .img files paired with the
+                                     scene by name */
+    long long band_bytes;         /* total size of the paired .img files */
+} Espa_scene_listing_t;
+
+/* Prototypes */
+int scan_product_directory
+(
+    char *dir_path,        /* I: product directory to be scanned */
+    int num_threads,       /* I: number of threads to use (0 or less chooses
+                                 automatically) */
+    Espa_scene_listing_t **listing,  /* O: allocated array of the discovered
+                                 scenes, sorted by XML filename; freed by
+                                 the caller */
+    int *num_scenes        /* O: number of scenes in the listing */
+);
+
+int write_scene_manifest
+(
+    char *manifest_file,   /* I: output manifest filename */
+    Espa_scene_listing_t *listing,  /* I: array of the discovered scenes */
+    int num_scenes         /* I: number of scenes in the listing */
+);
+
+#endif
@@ -21,6 +21,14 @@ Date         Programmer       Reason
                               gain/bias, and K1/K2 constants. Changed
                               toa_gain/bias to rad_gain/bias to be consistent
                               with refl_gain/bias.
+8/31/2026    Gail Schmidt     Added the in-place band filter used by the
+                              format converters
+8/31/2026    Gail Schmidt     Share the interned bitmap description sets
+                              instead of copying the strings
+8/31/2026    Gail Schmidt     Scan for product matches through the compact
+                              band descriptors
+8/31/2026    Gail Schmidt     Copy the QA description through the
+                              lazily-allocated band accessor
 
 NOTES:
   1. The XML metadata format written via this library follows the ESPA internal
@@ -31,6 +39,127 @@ NOTES:
 #include <math.h>
 #include "subset_metadata.h"
 
+/******************************************************************************
+MODULE:  prune_metadata_bands
+
+PURPOSE: Prunes the metadata structure in place to contain only the bands
+matching the filter, so a converter can skip the unwanted bands before any
+of their data is read.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           No bands match the filter, or a filter entry is invalid
+SUCCESS         Successfully pruned the metadata structure
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The filter is a comma-separated list of entries.  A plain entry names
+     a band (matching subset_metadata_by_band semantics); product:<type>
+     and category:<cat> entries match the band's product type and category.
+     A band matching any entry is kept.
+  2. A NULL or empty filter keeps every band, so the converters can pass
+     their filter argument straight through.
+******************************************************************************/
+int prune_metadata_bands
+(
+    Espa_internal_meta_t *metadata, /* I/O: metadata structure to be pruned
+                                       in place */
+    char *band_filter   /* I: comma-separated list of filter entries; each
+                              entry is a band name, product:<type>, or
+                              category:<cat>, and a band matching any entry
+                              is kept; NULL or empty keeps every band */
+)
+{
+    char FUNC_NAME[] = "prune_metadata_bands";   /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    char filter[STR_SIZE];   /* local copy of the filter for tokenizing */
+    char *entry = NULL;      /* current filter entry */
+    char *saveptr = NULL;    /* strtok_r state */
+    int i;                   /* looping variable */
+    int count;               /* number of chars copied in snprintf */
+    int nkeep;               /* number of bands kept */
+    bool keep;               /* does the current band match the filter */
+    Espa_band_meta_t *bmeta = NULL;  /* band metadata array */
+
+    /* An empty filter keeps every band */
+    if (band_filter == NULL || band_filter[0] == '\0')
+        return (SUCCESS);
+
+    count = snprintf (filter, sizeof (filter), "%s", band_filter);
+    if (count < 0 || count >= sizeof (filter))
+    {
+        sprintf (errmsg, "Overflow of the band filter string");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Walk the bands, keeping those which match any filter entry and
+       releasing the allocations of those which don't */
+    bmeta = metadata->band;
+    nkeep = 0;
+    for (i = 0; i < metadata->nbands; i++)
+    {
+        keep = false;
+        count = snprintf (filter, sizeof (filter), "%s", band_filter);
+        for (entry = strtok_r (filter, ",", &saveptr); entry != NULL;
+             entry = strtok_r (NULL, ",", &saveptr))
+        {
+            if (!strncmp (entry, "product:", 8))
+                keep = !strcmp (bmeta[i].product, &entry[8]);
+            else if (!strncmp (entry, "category:", 9))
+                keep = !strcmp (bmeta[i].category, &entry[9]);
+            else
+                keep = !strcmp (bmeta[i].name, entry);
+            if (keep)
+                break;
+        }
+
+        if (keep)
+        {   /* compact the kept band down over the pruned ones */
+            if (nkeep != i)
+                memcpy (&bmeta[nkeep], &bmeta[i], sizeof (bmeta[i]));
+            nkeep++;
+        }
+        else
+        {   /* release the pruned band's allocations, mirroring
+               free_metadata */
+            free_bitmap_metadata (&bmeta[i]);
+            free (bmeta[i].class_values);
+            free (bmeta[i].qa_desc);
+        }
+    }
+
+    if (nkeep == 0)
+    {
+        sprintf (errmsg, "No bands match the band filter '%s'.", band_filter);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+    metadata->nbands = nkeep;
+
+    /* Invalidate the band-name hash; find_band_index rebuilds it lazily
+       over the pruned band array */
+    free (metadata->band_hash);
+    metadata->band_hash = NULL;
+    metadata->band_hash_size = 0;
+    metadata->band_hash_nbands = 0;
+
+    /* Invalidate the hot band descriptors; get_band_hot rebuilds them
+       lazily over the pruned band array */
+    free (metadata->band_hot);
+    metadata->band_hot = NULL;
+    metadata->band_hot_nbands = 0;
+
+    return (SUCCESS);
+}
+
+
 /******************************************************************************
 MODULE:  subset_metadata_by_product
 
@@ -51,6 +180,7 @@ Date         Programmer       Reason
 4/22/2014    Gail Schmidt     Updated for additional projection parameters and
                               datums
 5/7/2014     Gail Schmidt     Updated for modis tiles
+8/31/2026    Gail Schmidt     Share the interned bitmap description sets
 
 NOTES:
   1. If no bands match the product type, then the global and projection
@@ -381,29 +511,12 @@ int subset_metadata_by_product
         outmeta->band[iband].k1_const = inmeta->band[i].k1_const;
         outmeta->band[iband].k2_const = inmeta->band[i].k2_const;
 
-        /* If there is a bitmap description, then allocate memory and copy
-           the information */
-        outmeta->band[iband].nbits = inmeta->band[i].nbits;
-        if (inmeta->band[i].nbits != 0)
-        {
-            if (allocate_bitmap_metadata (&outmeta->band[iband],
-                outmeta->band[iband].nbits) != SUCCESS)
-            {  /* Error messages already printed */
-                return (ERROR);
-            }
-
-            for (k = 0; k < inmeta->band[i].nbits; k++)
-            {
-                count = snprintf (outmeta->band[iband].bitmap_description[k],
-                    STR_SIZE, "%s", inmeta->band[i].bitmap_description[k]);
-                if (count < 0 || count >= STR_SIZE)
-                {
-                    sprintf (errmsg, "Overflow of "
-                        "outmeta->band[iband].bitmap_description[k] string");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
+        /* If there is a bitmap description, then share the interned set
+           instead of copying the strings */
+        if (share_bitmap_metadata (&outmeta->band[iband],
+            &inmeta->band[i]) != SUCCESS)
+        {  /* Error messages already printed */
+            return (ERROR);
         }
 
         /* If there is are class descriptions, then allocate memory and copy
@@ -437,13 +550,9 @@ int subset_metadata_by_product
             }
         }
 
-        count = snprintf (outmeta->band[iband].qa_desc,
-            sizeof (outmeta->band[iband].qa_desc), "%s",
-            inmeta->band[i].qa_desc);
-        if (count < 0 || count >= sizeof (outmeta->band[iband].qa_desc))
-        {
-            sprintf (errmsg, "Overflow of outmeta->band[iband].qa_desc");
-            error_handler (true, FUNC_NAME, errmsg);
+        if (set_band_qa_desc (&outmeta->band[iband],
+            inmeta->band[i].qa_desc) != SUCCESS)
+        {   /* Error messages already printed */
             return (ERROR);
         }
 
@@ -508,6 +617,8 @@ Date         Programmer       Reason
 4/22/2014    Gail Schmidt     Updated for additional projection parameters and
                               datums
 5/7/2014     Gail Schmidt     Updated for modis tiles
+8/31/2026    Gail Schmidt     Look the bands up through the band-name hash
+8/31/2026    Gail Schmidt     Share the interned bitmap description sets
 
 NOTES:
   1. If nbands is 0, then the global and projection information will still
@@ -532,7 +643,6 @@ int subset_metadata_by_band
     int iband;               /* current output band */
     int nskip;               /* number of bands skipped as they weren't found
                                 in the input metadata structure */
-    bool found;              /* was the band found */
 
     /* Initialize the output metadata structure */
     init_metadata_struct (outmeta);
@@ -713,16 +823,8 @@ int subset_metadata_by_band
     for (i = 0; i < nbands; i++)
     {
         /* Is this band one of those specified for the band subset? */
-        found = false;
-        for (j = 0; j < inmeta->nbands; j++)
-        {
-            if (!strcmp (inmeta->band[j].name, bands[i]))
-            {
-                found = true;
-                break;
-            }
-        }
-        if (!found)
+        j = find_band_index (inmeta, bands[i]);
+        if (j < 0)
         {
             sprintf (errmsg, "Band '%s' not found in the XML structure. "
                 "Skipping.", bands[i]);
@@ -847,29 +949,12 @@ int subset_metadata_by_band
         outmeta->band[iband].k1_const = inmeta->band[j].k1_const;
         outmeta->band[iband].k2_const = inmeta->band[j].k2_const;
 
-        /* If there is a bitmap description, then allocate memory and copy
-           the information */
-        outmeta->band[iband].nbits = inmeta->band[j].nbits;
-        if (inmeta->band[j].nbits != 0)
-        {
-            if (allocate_bitmap_metadata (&outmeta->band[iband],
-                outmeta->band[iband].nbits) != SUCCESS)
-            {  /* Error messages already printed */
-                return (ERROR);
-            }
-
-            for (k = 0; k < inmeta->band[j].nbits; k++)
-            {
-                count = snprintf (outmeta->band[iband].bitmap_description[k],
-                    STR_SIZE, "%s", inmeta->band[j].bitmap_description[k]);
-                if (count < 0 || count >= STR_SIZE)
-                {
-                    sprintf (errmsg, "Overflow of "
-                        "outmeta->band[iband].bitmap_description[k] string");
-                    error_handler (true, FUNC_NAME, errmsg);
-                    return (ERROR);
-                }
-            }
+        /* If there is a bitmap description, then share the interned set
+           instead of copying the strings */
+        if (share_bitmap_metadata (&outmeta->band[iband],
+            &inmeta->band[j]) != SUCCESS)
+        {  /* Error messages already printed */
+            return (ERROR);
         }
 
         /* If there is are class descriptions, then allocate memory and copy
@@ -902,13 +987,9 @@ int subset_metadata_by_band
             }
         }
 
-        count = snprintf (outmeta->band[iband].qa_desc,
-            sizeof (outmeta->band[iband].qa_desc), "%s",
-            inmeta->band[i].qa_desc);
-        if (count < 0 || count >= sizeof (outmeta->band[iband].qa_desc))
-        {
-            sprintf (errmsg, "Overflow of outmeta->band[iband].qa_desc");
-            error_handler (true, FUNC_NAME, errmsg);
+        if (set_band_qa_desc (&outmeta->band[iband],
+            inmeta->band[j].qa_desc) != SUCCESS)
+        {   /* Error messages already printed */
             return (ERROR);
         }
 
@@ -944,6 +1025,204 @@ int subset_metadata_by_band
 }
 
 
+/******************************************************************************
+MODULE:  subset_xml_by_band_from_meta
+
+PURPOSE: Write a subset XML file containing only the specified bands directly
+from an already-parsed metadata structure, without re-parsing the XML or deep
+copying the band metadata.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error subsetting the metadata
+SUCCESS         Successfully wrote the subset XML file
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Look the bands up through the band-name hash
+
+NOTES:
+  1. This is the fast path for callers which already hold the parsed
+     metadata (tiling jobs call this once per band set).  The selected band
+     structures are copied with a single structure assignment each, and the
+     bitmap description and class value storage is shared with the input
+     metadata rather than duplicated.
+  2. If nbands is 0, then the global and projection information will still
+     be written.
+******************************************************************************/
+int subset_xml_by_band_from_meta
+(
+    Espa_internal_meta_t *inmeta,  /* I: already-parsed metadata structure to
+                                         be subset */
+    char *out_xml_file,  /* I: output XML file to be written */
+    int nbands,          /* I: number of bands to be included in the subset
+                               XML file */
+    char bands[][STR_SIZE] /* I: array of nbands band names to be appear in
+                               the subset XML file */
+)
+{
+    char FUNC_NAME[] = "subset_xml_by_band_from_meta";   /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    int i, j;                /* looping variables */
+    int iband = 0;           /* current output band */
+    Espa_internal_meta_t outmeta;  /* shallow view of the input metadata over
+                                      the selected bands */
+    Espa_band_meta_t *band_view = NULL;  /* array of selected band structures
+                                      aliasing the input band storage */
+
+    /* Allocate the view array for the selected bands */
+    band_view = malloc (nbands * sizeof (Espa_band_meta_t));
+    if (band_view == NULL && nbands > 0)
+    {
+        sprintf (errmsg, "Allocating the band view for %d bands", nbands);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Select the desired bands.  Each selected band is a single structure
+       copy; the bitmap description and class value pointers continue to
+       reference the input metadata storage. */
+    for (i = 0; i < nbands; i++)
+    {
+        j = find_band_index (inmeta, bands[i]);
+        if (j < 0)
+        {
+            sprintf (errmsg, "Band %s was not found in the input metadata "
+                "structure. Skipping ...", bands[i]);
+            error_handler (false, FUNC_NAME, errmsg);
+            continue;
+        }
+
+        band_view[iband++] = inmeta->band[j];
+    }
+
+    /* Set up the output metadata as a shallow view over the input global
+       metadata and the selected bands */
+    outmeta = *inmeta;
+    outmeta.band = band_view;
+    outmeta.nbands = iband;
+
+    /* Write the subset metadata view to the output XML filename */
+    if (write_metadata (&outmeta, out_xml_file) != SUCCESS)
+    {  /* Error messages already written */
+        free (band_view);
+        return (ERROR);
+    }
+
+    /* Free only the view array; the band contents are owned by the input
+       metadata structure, so free_metadata must not be called on the view */
+    free (band_view);
+
+    /* Successful subset */
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  find_product_band_indices
+
+PURPOSE: Builds an index list of the bands in the metadata structure whose
+product type matches one of the specified product types, as a view over the
+original metadata with no copies made.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error allocating the index list
+>= 0            Number of matching bands in the index list
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Scan through the compact band descriptors when
+                              they are available
+
+NOTES:
+  1. The index list is allocated by this function and refers to bands in the
+     input metadata structure, which the caller continues to own.  The caller
+     is responsible for freeing the index list.
+  2. If no bands match the product types, then a warning is printed and a
+     count of zero is returned.
+******************************************************************************/
+int find_product_band_indices
+(
+    Espa_internal_meta_t *metadata,  /* I: metadata structure to search */
+    int nproducts,                 /* I: number of product types to be matched
+                                         against the bands */
+    char products[][STR_SIZE],     /* I: array of nproducts product types to be
+                                         used for matching */
+    int **band_indices             /* O: allocated list of the indices of the
+                                         matching bands in the metadata band
+                                         array; freed by the caller */
+)
+{
+    char FUNC_NAME[] = "find_product_band_indices";   /* function name */
+    char errmsg[STR_SIZE];   /* error message */
+    int i, j;                /* looping variables */
+    int nindices = 0;        /* number of matching bands */
+    int *indices = NULL;     /* index list being built */
+    unsigned int *product_hashes = NULL;  /* hashes of the product types */
+    const Espa_band_hot_t *hot = NULL;    /* compact band descriptors, or
+                                             NULL to scan the full bands */
+
+    /* Allocate the index list for the worst case of every band matching */
+    *band_indices = NULL;
+    indices = malloc (metadata->nbands * sizeof (int));
+    if (indices == NULL && metadata->nbands > 0)
+    {
+        sprintf (errmsg, "Allocating the band index list for %d bands",
+            metadata->nbands);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Hash the product types once and grab the compact band descriptors, so
+       the scan touches one cache line per band instead of pulling each full
+       band structure through the cache; if either allocation fails the scan
+       falls back to the string compares over the full band structures */
+    hot = get_band_hot (metadata);
+    product_hashes = malloc (nproducts * sizeof (unsigned int));
+    if (product_hashes != NULL)
+    {
+        for (j = 0; j < nproducts; j++)
+            product_hashes[j] = espa_name_hash (products[j]);
+    }
+
+    /* Record the index of each band matching one of the product types */
+    for (i = 0; i < metadata->nbands; i++)
+    {
+        for (j = 0; j < nproducts; j++)
+        {
+            if (hot != NULL && product_hashes != NULL &&
+                hot[i].product_hash != product_hashes[j])
+                continue;
+            if (!strcmp (metadata->band[i].product, products[j]))
+            {
+                indices[nindices++] = i;
+                break;
+            }
+        }
+    }
+    free (product_hashes);
+
+    /* If no bands matched the product type, then print a warning */
+    if (nindices == 0)
+    {
+        sprintf (errmsg, "No bands in the XML file matched the product types.");
+        error_handler (false, FUNC_NAME, errmsg);
+    }
+
+    *band_indices = indices;
+    return (nindices);
+}
+
+
 /******************************************************************************
 MODULE:  subset_xml_by_product
 
@@ -960,6 +1239,9 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 1/10/2014    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Write the subset through an index view over the
+                              parsed metadata instead of deep copying the
+                              matching bands
 
 NOTES:
   1. If no bands match the product type, then the global and projection
@@ -977,10 +1259,16 @@ int subset_xml_by_product
 {
     char FUNC_NAME[] = "subset_xml_by_product";   /* function name */
     char errmsg[STR_SIZE];   /* error message */
+    int i;                   /* looping variable */
+    int nindices;            /* number of bands matching the product types */
+    int *band_indices = NULL;  /* indices of the matching bands in the parsed
+                                metadata */
     Espa_internal_meta_t in_xml_metadata;  /* XML metadata structure to be
                                 populated by reading the input XML file */
-    Espa_internal_meta_t out_xml_metadata; /* XML metadata structure to be
-                                populated by subsetting the input XML */
+    Espa_internal_meta_t out_xml_metadata; /* shallow view of the input
+                                metadata over the matching bands */
+    Espa_band_meta_t *band_view = NULL;  /* array of the matching band
+                                structures aliasing the input band storage */
 
     /* Validate the input metadata file */
     if (validate_xml_file (in_xml_file) != SUCCESS)
@@ -999,30 +1287,60 @@ int subset_xml_by_product
         return (ERROR);
     }
 
-    /* Subset the input XML file using the specified bands */
-    if (subset_metadata_by_product (&in_xml_metadata, &out_xml_metadata,
-        nproducts, products) != SUCCESS)
+    /* Find the bands matching the specified product types; the index list
+       refers to the parsed metadata, so no band metadata is copied */
+    nindices = find_product_band_indices (&in_xml_metadata, nproducts,
+        products, &band_indices);
+    if (nindices < 0)
     {
         sprintf (errmsg, "Subsetting the XML file for the specified products.");
         error_handler (true, FUNC_NAME, errmsg);
+        free_metadata (&in_xml_metadata);
         return (ERROR);
     }
 
-    /* Write the subset metadata structure to the output XML filename */
+    /* Gather the matching bands into the view array.  Each band is a single
+       structure copy; the bitmap description and class value pointers
+       continue to reference the parsed metadata storage. */
+    band_view = malloc (nindices * sizeof (Espa_band_meta_t));
+    if (band_view == NULL && nindices > 0)
+    {
+        sprintf (errmsg, "Allocating the band view for %d bands", nindices);
+        error_handler (true, FUNC_NAME, errmsg);
+        free (band_indices);
+        free_metadata (&in_xml_metadata);
+        return (ERROR);
+    }
+    for (i = 0; i < nindices; i++)
+        band_view[i] = in_xml_metadata.band[band_indices[i]];
+    free (band_indices);
+
+    /* Set up the output metadata as a shallow view over the input global
+       metadata and the matching bands */
+    out_xml_metadata = in_xml_metadata;
+    out_xml_metadata.band = band_view;
+    out_xml_metadata.nbands = nindices;
+
+    /* Write the subset metadata view to the output XML filename */
     if (write_metadata (&out_xml_metadata, out_xml_file) != SUCCESS)
     {  /* Error messages already written */
+        free (band_view);
+        free_metadata (&in_xml_metadata);
         return (ERROR);
     }
 
     /* Validate the output metadata file */
     if (validate_xml_file (out_xml_file) != SUCCESS)
     {  /* Error messages already written */
+        free (band_view);
+        free_metadata (&in_xml_metadata);
         return (ERROR);
     }
 
-    /* Free the metadata structures */
+    /* Free only the view array, then the input metadata which owns the band
+       contents; free_metadata must not be called on the view */
+    free (band_view);
     free_metadata (&in_xml_metadata);
-    free_metadata (&out_xml_metadata);
 
     /* Successful subset */
     return (SUCCESS);
@@ -1064,8 +1382,6 @@ int subset_xml_by_band
     char errmsg[STR_SIZE];   /* error message */
     Espa_internal_meta_t in_xml_metadata;  /* XML metadata structure to be
                                 populated by reading the input XML file */
-    Espa_internal_meta_t out_xml_metadata; /* XML metadata structure to be
-                                populated by subsetting the input XML */
 
     /* Validate the input metadata file */
     if (validate_xml_file (in_xml_file) != SUCCESS)
@@ -1084,8 +1400,9 @@ int subset_xml_by_band
         return (ERROR);
     }
 
-    /* Subset the input XML file using the specified bands */
-    if (subset_metadata_by_band (&in_xml_metadata, &out_xml_metadata,
+    /* Subset the parsed metadata for the specified bands and write the
+       output XML file in one pass, without deep copying the band metadata */
+    if (subset_xml_by_band_from_meta (&in_xml_metadata, out_xml_file,
         nbands, bands) != SUCCESS)
     {
         sprintf (errmsg, "Subsetting the XML file for the specified bands.");
@@ -1093,21 +1410,14 @@ int subset_xml_by_band
         return (ERROR);
     }
 
-    /* Write the subset metadata structure to the output XML filename */
-    if (write_metadata (&out_xml_metadata, out_xml_file) != SUCCESS)
-    {  /* Error messages already written */
-        return (ERROR);
-    }
-
     /* Validate the output metadata file */
     if (validate_xml_file (out_xml_file) != SUCCESS)
     {  /* Error messages already written */
         return (ERROR);
     }
 
-    /* Free the metadata structures */
+    /* Free the metadata structure */
     free_metadata (&in_xml_metadata);
-    free_metadata (&out_xml_metadata);
 
     /* Successful subset */
     return (SUCCESS);
@@ -12,6 +12,10 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 1/10/2014    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added find_product_band_indices for copy-free
+                              product subsetting
+8/31/2026    Gail Schmidt     Added the in-place band filter used by the
+                              format converters
 
 NOTES:
 *****************************************************************************/
@@ -30,6 +34,28 @@ NOTES:
 /* Defines */
 
 /* Prototypes */
+int find_product_band_indices
+(
+    Espa_internal_meta_t *metadata,  /* I: metadata structure to search */
+    int nproducts,                 /* I: number of product types to be matched
+                                         against the bands */
+    char products[][STR_SIZE],     /* I: array of nproducts product types to be
+                                         used for matching */
+    int **band_indices             /* O: allocated list of the indices of the
+                                         matching bands in the metadata band
+                                         array; freed by the caller */
+);
+
+int prune_metadata_bands
+(
+    Espa_internal_meta_t *metadata, /* I/O: metadata structure to be pruned
+                                       in place */
+    char *band_filter   /* I: comma-separated list of filter entries; each
+                              entry is a band name, product:<type>, or
+                              category:<cat>, and a band matching any entry
+                              is kept; NULL or empty keeps every band */
+);
+
 int subset_metadata_by_product
 (
     Espa_internal_meta_t *inmeta,  /* I: input metadata structure to be
@@ -74,4 +100,15 @@ int subset_xml_by_band
                                the subset XML file */
 );
 
+int subset_xml_by_band_from_meta
+(
+    Espa_internal_meta_t *inmeta,  /* I: already-parsed metadata structure to
+                                         be subset */
+    char *out_xml_file,  /* I: output XML file to be written */
+    int nbands,          /* I: number of bands to be included in the subset
+                               XML file */
+    char bands[][STR_SIZE] /* I: array of nbands band names to be appear in
+                               the subset XML file */
+);
+
 #endif
@@ -0,0 +1,542 @@
+/*****************************************************************************
+FILE: subset_pixels.c
+
+PURPOSE: Contains functions for subsetting the raw binary band files to a
+line/sample window, clipping the image data itself in addition to the XML
+metadata.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The XML metadata format parsed or written via this library follows the
+     ESPA internal metadata format found in ESPA Raw Binary Format v1.0.doc.
+     The schema for the ESPA internal metadata format is available at
+     http://espa.cr.usgs.gov/schema/espa_internal_metadata_v1_0.xsd.
+*****************************************************************************/
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#ifdef __linux__
+#include <linux/fs.h>
+#endif
+#include "subset_pixels.h"
+
+/******************************************************************************
+MODULE:  passthrough_band_file (static function)
+
+PURPOSE:  Shares a band file which passes through the subset unchanged,
+reflinking it on filesystems which support clones and hard linking it
+otherwise, so no pixel data is copied.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           The file could not be shared (the caller should fall back
+                to copying it)
+SUCCESS         The output file now shares the source data
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Failures are expected on filesystems without reflink support or when
+     linking across filesystems, so no error message is written; the caller
+     falls back to the streaming copy.
+******************************************************************************/
+static int passthrough_band_file
+(
+    char *in_img_file,   /* I: name of the source band file */
+    char *out_img_file   /* I: name of the output band file */
+)
+{
+    int in_fd;           /* file descriptor for the source band file */
+    int out_fd;          /* file descriptor for the output band file */
+    int cloned = 0;      /* was the file cloned successfully? */
+
+    /* Remove any stale output file so the link and clone paths both start
+       clean */
+    unlink (out_img_file);
+
+#ifdef FICLONE
+    /* Try to reflink the file first, which shares the extents but keeps
+       the two names independent if one is later rewritten */
+    in_fd = open (in_img_file, O_RDONLY);
+    if (in_fd >= 0)
+    {
+        out_fd = open (out_img_file, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+        if (out_fd >= 0)
+        {
+            if (ioctl (out_fd, FICLONE, in_fd) == 0)
+                cloned = 1;
+            close (out_fd);
+            if (!cloned)
+                unlink (out_img_file);
+        }
+        close (in_fd);
+    }
+    if (cloned)
+        return (SUCCESS);
+#endif
+
+    /* Fall back to a hard link, which shares the data but requires both
+       names to live on the same filesystem */
+    if (link (in_img_file, out_img_file) == 0)
+        return (SUCCESS);
+
+    return (ERROR);
+}
+
+
+/******************************************************************************
+MODULE:  subset_band_window
+
+PURPOSE:  Clips one raw binary band file to the specified line/sample window,
+streaming the window through a bounded buffer.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error clipping the band
+SUCCESS         Band was clipped
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Checksum the clipped band as it is written and
+                              record it in the band metadata
+8/31/2026    Gail Schmidt     Swap mismatched-byte-order source bands as they
+                              are read and declare the byte order of the
+                              clipped band in the band metadata
+
+NOTES:
+  1. The window is read a chunk of lines at a time via the windowed read
+     support, so the memory used is bounded by SUBSET_CHUNK_BYTES regardless
+     of the window size.
+******************************************************************************/
+int subset_band_window
+(
+    Espa_band_meta_t *bmeta,  /* I/O: band metadata for the source band; the
+                                      checksum and byte order of the clipped
+                                      band are recorded here */
+    char *out_img_file,       /* I: name of the clipped raw binary file */
+    int start_line,           /* I: first line of the window (0-based) */
+    int start_samp,           /* I: first sample of the window (0-based) */
+    int nlines,               /* I: number of lines in the window */
+    int nsamps                /* I: number of samples in the window */
+)
+{
+    char FUNC_NAME[] = "subset_band_window";   /* function name */
+    char errmsg[STR_SIZE];    /* error message */
+    int nbytes;               /* number of bytes in the data type */
+    int chunk_nlines;         /* number of lines in the chunk buffer */
+    int curr_nlines;          /* number of lines in the current chunk */
+    int chunk_line;           /* first window line of the current chunk */
+    void *chunk_buf = NULL;   /* chunk buffer for the windowed reads */
+    FILE *fp_in = NULL;       /* file pointer for the input band file */
+    FILE *fp_out = NULL;      /* file pointer for the clipped band file */
+
+    /* Validate the window against the band */
+    if (start_line < 0 || start_samp < 0 || nlines <= 0 || nsamps <= 0 ||
+        start_line + nlines > bmeta->nlines ||
+        start_samp + nsamps > bmeta->nsamps)
+    {
+        sprintf (errmsg, "Window of %d lines x %d samples at line %d, "
+            "sample %d does not fit in band %.1024s (%d lines x %d samples).",
+            nlines, nsamps, start_line, start_samp, bmeta->name,
+            bmeta->nlines, bmeta->nsamps);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Determine the number of bytes in the data type */
+    switch (bmeta->data_type)
+    {
+        case ESPA_INT8: nbytes = 1; break;
+        case ESPA_UINT8: nbytes = 1; break;
+        case ESPA_INT16: nbytes = 2; break;
+        case ESPA_UINT16: nbytes = 2; break;
+        case ESPA_INT32: nbytes = 4; break;
+        case ESPA_UINT32: nbytes = 4; break;
+        case ESPA_FLOAT32: nbytes = 4; break;
+        case ESPA_FLOAT64: nbytes = 8; break;
+        default:
+            sprintf (errmsg, "Unsupported data type %d for band %.1024s.",
+                bmeta->data_type, bmeta->name);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+    }
+
+    /* Open the input and output band files */
+    fp_in = open_raw_binary (bmeta->file_name, "rb");
+    if (fp_in == NULL)
+    {
+        sprintf (errmsg, "Opening the input band file: %.1024s", bmeta->file_name);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* If the band was written on a machine of the other byte order, swap
+       the values lazily as they are read */
+    if (bmeta->byte_order != ESPA_INT_META_FILL &&
+        bmeta->byte_order != espa_machine_byte_order ())
+    {
+        if (enable_raw_binary_byte_swap (fp_in, nbytes) != SUCCESS)
+        {  /* Error messages already written */
+            close_raw_binary (fp_in);
+            return (ERROR);
+        }
+    }
+
+    fp_out = open_raw_binary (out_img_file, "wb");
+    if (fp_out == NULL)
+    {
+        sprintf (errmsg, "Opening the clipped band file: %s", out_img_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        close_raw_binary (fp_in);
+        return (ERROR);
+    }
+
+    /* Checksum the clipped band as it is written, while the data is still
+       in memory */
+    if (enable_raw_binary_checksum (fp_out) != SUCCESS)
+    {  /* Error messages already written */
+        close_raw_binary (fp_in);
+        close_raw_binary (fp_out);
+        return (ERROR);
+    }
+
+    /* Allocate a bounded chunk of window lines */
+    chunk_nlines = SUBSET_CHUNK_BYTES / (nsamps * nbytes);
+    if (chunk_nlines < 1)
+        chunk_nlines = 1;
+    if (chunk_nlines > nlines)
+        chunk_nlines = nlines;
+    chunk_buf = malloc ((size_t) chunk_nlines * nsamps * nbytes);
+    if (chunk_buf == NULL)
+    {
+        sprintf (errmsg, "Allocating the chunk buffer for the window.");
+        error_handler (true, FUNC_NAME, errmsg);
+        close_raw_binary (fp_in);
+        close_raw_binary (fp_out);
+        return (ERROR);
+    }
+
+    /* Stream the window a chunk of lines at a time */
+    for (chunk_line = 0; chunk_line < nlines; chunk_line += chunk_nlines)
+    {
+        curr_nlines = chunk_nlines;
+        if (chunk_line + curr_nlines > nlines)
+            curr_nlines = nlines - chunk_line;
+
+        if (read_raw_binary_window (fp_in, start_line + chunk_line,
+            start_samp, curr_nlines, nsamps, bmeta->nsamps, nbytes,
+            chunk_buf) != SUCCESS)
+        {
+            sprintf (errmsg, "Reading window lines %d-%d from band file: %.1024s",
+                start_line + chunk_line,
+                start_line + chunk_line + curr_nlines - 1, bmeta->file_name);
+            error_handler (true, FUNC_NAME, errmsg);
+            free (chunk_buf);
+            close_raw_binary (fp_in);
+            close_raw_binary (fp_out);
+            return (ERROR);
+        }
+
+        if (write_raw_binary (fp_out, curr_nlines, nsamps, nbytes, chunk_buf)
+            != SUCCESS)
+        {
+            sprintf (errmsg, "Writing the window to the clipped band file: "
+                "%s", out_img_file);
+            error_handler (true, FUNC_NAME, errmsg);
+            free (chunk_buf);
+            close_raw_binary (fp_in);
+            close_raw_binary (fp_out);
+            return (ERROR);
+        }
+    }
+
+    /* Record the checksum of the clipped band in the band metadata */
+    if (finish_raw_binary_checksum (fp_out, bmeta->checksum) != SUCCESS)
+    {  /* Error messages already written */
+        free (chunk_buf);
+        close_raw_binary (fp_in);
+        close_raw_binary (fp_out);
+        return (ERROR);
+    }
+
+    /* The clipped band was written in the native byte order of this
+       machine; declare it so readers on the other architecture can swap */
+    bmeta->byte_order = espa_machine_byte_order ();
+
+    /* Clean up */
+    free (chunk_buf);
+    close_raw_binary (fp_in);
+    close_raw_binary (fp_out);
+
+    /* Successful clip */
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  subset_pixels_by_window
+
+PURPOSE:  Subsets the specified bands of the input product to a line/sample
+window, clipping the raw binary band files and writing the output XML
+metadata and ENVI headers for the clipped product.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error subsetting the product
+SUCCESS         Product was subset
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Reflink or hard link bands kept at their full
+                              extent instead of copying the pixels
+
+NOTES:
+  1. All the bands being clipped must have the same number of lines and
+     samples, since the window is specified in line/sample space.  For
+     products with bands of mixed resolutions, subset the bands of one
+     resolution at a time.
+  2. The clipped band files are named after the output XML file base with
+     the band name appended.
+  3. The projection corners are shifted to the window.  The geographic
+     corner and bounding coordinates are left at the full-scene values,
+     which remain a valid superset of the window.
+******************************************************************************/
+int subset_pixels_by_window
+(
+    char *in_xml_file,   /* I: input XML file of the product to be subset */
+    char *out_xml_file,  /* I: output XML file for the clipped product */
+    int nbands,          /* I: number of bands to be included in the subset
+                               product; 0 clips all the bands */
+    char bands[][STR_SIZE], /* I: array of nbands band names to be clipped */
+    int start_line,      /* I: first line of the window (0-based) */
+    int start_samp,      /* I: first sample of the window (0-based) */
+    int nlines,          /* I: number of lines in the window */
+    int nsamps           /* I: number of samples in the window */
+)
+{
+    char FUNC_NAME[] = "subset_pixels_by_window";   /* function name */
+    char errmsg[STR_SIZE];     /* error message */
+    char out_img_file[STR_SIZE];  /* name of the current clipped band file */
+    char out_base[STR_SIZE];   /* output XML file base name */
+    char all_bands[MAX_TOTAL_BANDS][STR_SIZE];  /* names of all the bands
+                                  when no band list was specified */
+    char *cptr = NULL;         /* pointer to the file extension */
+    int i;                     /* looping variable for bands */
+    int count;                 /* number of chars copied in snprintf */
+    Espa_internal_meta_t in_xml_metadata;  /* XML metadata structure for the
+                                  input product */
+    Espa_internal_meta_t out_xml_metadata; /* XML metadata structure for the
+                                  clipped product */
+    Espa_band_meta_t *bmeta = NULL;  /* pointer to the current band */
+
+    /* Initialize the input metadata structure */
+    init_metadata_struct (&in_xml_metadata);
+
+    /* Validate the input metadata file and parse it into our internal
+       metadata structure, using the metadata daemon when one is running;
+       also allocates space as needed for various pointers in the global and
+       band metadata */
+    if (validate_and_parse_metadata (in_xml_file, &in_xml_metadata) !=
+        SUCCESS)
+    {  /* Error messages already written */
+        return (ERROR);
+    }
+
+    /* If no bands were specified then clip all the bands in the product */
+    if (nbands == 0)
+    {
+        if (in_xml_metadata.nbands > MAX_TOTAL_BANDS)
+        {
+            sprintf (errmsg, "Number of bands in the product (%d) exceeds "
+                "the maximum supported (%d).", in_xml_metadata.nbands,
+                MAX_TOTAL_BANDS);
+            error_handler (true, FUNC_NAME, errmsg);
+            free_metadata (&in_xml_metadata);
+            return (ERROR);
+        }
+        nbands = in_xml_metadata.nbands;
+        for (i = 0; i < nbands; i++)
+            strcpy (all_bands[i], in_xml_metadata.band[i].name);
+        bands = all_bands;
+    }
+
+    /* Subset the metadata for the specified bands; the band metadata still
+       refers to the full-scene band files at this point */
+    if (subset_metadata_by_band (&in_xml_metadata, &out_xml_metadata,
+        nbands, bands) != SUCCESS)
+    {
+        sprintf (errmsg, "Subsetting the metadata for the specified bands.");
+        error_handler (true, FUNC_NAME, errmsg);
+        free_metadata (&in_xml_metadata);
+        return (ERROR);
+    }
+
+    if (out_xml_metadata.nbands < 1)
+    {
+        sprintf (errmsg, "None of the specified bands exist in the input "
+            "product, so there is nothing to clip.");
+        error_handler (true, FUNC_NAME, errmsg);
+        free_metadata (&in_xml_metadata);
+        free_metadata (&out_xml_metadata);
+        return (ERROR);
+    }
+
+    /* The window is specified in line/sample space, so all the bands being
+       clipped need to be gridded the same */
+    for (i = 1; i < out_xml_metadata.nbands; i++)
+    {
+        if (out_xml_metadata.band[i].nlines !=
+                out_xml_metadata.band[0].nlines ||
+            out_xml_metadata.band[i].nsamps !=
+                out_xml_metadata.band[0].nsamps)
+        {
+            sprintf (errmsg, "Band %.512s (%d lines x %d samples) does not match "
+                "band %.512s (%d lines x %d samples).  All the bands being "
+                "clipped must have the same size; subset the bands of one "
+                "resolution at a time.", out_xml_metadata.band[i].name,
+                out_xml_metadata.band[i].nlines,
+                out_xml_metadata.band[i].nsamps,
+                out_xml_metadata.band[0].name,
+                out_xml_metadata.band[0].nlines,
+                out_xml_metadata.band[0].nsamps);
+            error_handler (true, FUNC_NAME, errmsg);
+            free_metadata (&in_xml_metadata);
+            free_metadata (&out_xml_metadata);
+            return (ERROR);
+        }
+    }
+
+    /* Determine the output file base from the output XML filename */
+    count = snprintf (out_base, sizeof (out_base), "%s", out_xml_file);
+    if (count < 0 || count >= sizeof (out_base))
+    {
+        sprintf (errmsg, "Overflow of out_base string");
+        error_handler (true, FUNC_NAME, errmsg);
+        free_metadata (&in_xml_metadata);
+        free_metadata (&out_xml_metadata);
+        return (ERROR);
+    }
+    cptr = strrchr (out_base, '.');
+    if (cptr != NULL)
+        *cptr = '\0';
+
+    /* Clip each of the bands to the window */
+    for (i = 0; i < out_xml_metadata.nbands; i++)
+    {
+        bmeta = &out_xml_metadata.band[i];
+        count = snprintf (out_img_file, sizeof (out_img_file), "%s_%s.img",
+            out_base, bmeta->name);
+        if (count < 0 || count >= sizeof (out_img_file))
+        {
+            sprintf (errmsg, "Overflow of out_img_file string");
+            error_handler (true, FUNC_NAME, errmsg);
+            free_metadata (&in_xml_metadata);
+            free_metadata (&out_xml_metadata);
+            return (ERROR);
+        }
+
+        /* A band kept at its full extent passes through the subset
+           unchanged, so share the source file instead of copying the
+           pixels.  The checksum and byte order in the band metadata remain
+           valid since the data is byte-identical.  If the file cannot be
+           shared (no reflink support and a different filesystem), fall
+           through to the streaming copy. */
+        if (start_line == 0 && start_samp == 0 && nlines == bmeta->nlines &&
+            nsamps == bmeta->nsamps &&
+            passthrough_band_file (bmeta->file_name, out_img_file) == SUCCESS)
+        {
+            printf ("  Sharing %s as %s\n", bmeta->file_name, out_img_file);
+        }
+        else
+        {
+            printf ("  Clipping %s to %s\n", bmeta->file_name, out_img_file);
+            if (subset_band_window (bmeta, out_img_file, start_line,
+                start_samp, nlines, nsamps) != SUCCESS)
+            {
+                sprintf (errmsg, "Clipping band %.1024s to the window.",
+                    bmeta->name);
+                error_handler (true, FUNC_NAME, errmsg);
+                free_metadata (&in_xml_metadata);
+                free_metadata (&out_xml_metadata);
+                return (ERROR);
+            }
+        }
+
+        /* Point the band metadata at the clipped file */
+        strcpy (bmeta->file_name, out_img_file);
+        bmeta->nlines = nlines;
+        bmeta->nsamps = nsamps;
+    }
+
+    /* Shift the projection corners to the window, using the pixel size of
+       the (common-sized) bands.  The corners represent the center of the
+       pixel, so the new LR corner is nlines/nsamps - 1 pixels from the new
+       UL corner. */
+    bmeta = &out_xml_metadata.band[0];
+    out_xml_metadata.global.proj_info.ul_corner[0] +=
+        start_samp * bmeta->pixel_size[0];
+    out_xml_metadata.global.proj_info.ul_corner[1] -=
+        start_line * bmeta->pixel_size[1];
+    out_xml_metadata.global.proj_info.lr_corner[0] =
+        out_xml_metadata.global.proj_info.ul_corner[0] +
+        (nsamps - 1) * bmeta->pixel_size[0];
+    out_xml_metadata.global.proj_info.lr_corner[1] =
+        out_xml_metadata.global.proj_info.ul_corner[1] -
+        (nlines - 1) * bmeta->pixel_size[1];
+
+    /* Write the metadata for the clipped product */
+    if (write_metadata (&out_xml_metadata, out_xml_file) != SUCCESS)
+    {  /* Error messages already written */
+        free_metadata (&in_xml_metadata);
+        free_metadata (&out_xml_metadata);
+        return (ERROR);
+    }
+
+    /* Validate the output metadata file */
+    if (validate_xml_file (out_xml_file) != SUCCESS)
+    {  /* Error messages already written */
+        free_metadata (&in_xml_metadata);
+        free_metadata (&out_xml_metadata);
+        return (ERROR);
+    }
+
+    /* Write the ENVI headers for the clipped bands in one batch */
+    if (write_envi_hdrs (&out_xml_metadata) != SUCCESS)
+    {
+        sprintf (errmsg, "Writing the ENVI headers for the clipped bands.");
+        error_handler (true, FUNC_NAME, errmsg);
+        free_metadata (&in_xml_metadata);
+        free_metadata (&out_xml_metadata);
+        return (ERROR);
+    }
+
+    /* Free the metadata structures */
+    free_metadata (&in_xml_metadata);
+    free_metadata (&out_xml_metadata);
+
+    /* Successful subset */
+    return (SUCCESS);
+}
@@ -0,0 +1,63 @@
+/*****************************************************************************
+FILE: subset_pixels.h
+
+PURPOSE: Contains defines and prototypes for subsetting the raw binary band
+files to a line/sample window.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+*****************************************************************************/
+
+#ifndef SUBSET_PIXELS_H
+#define SUBSET_PIXELS_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "error_handler.h"
+#include "espa_metadata.h"
+#include "parse_metadata.h"
+#include "metadata_daemon.h"
+#include "write_metadata.h"
+#include "subset_metadata.h"
+#include "envi_header.h"
+#include "raw_binary_io.h"
+
+/* Defines */
+/* upper bound on the streaming buffer used while clipping a band */
+#define SUBSET_CHUNK_BYTES (4 * 1024 * 1024)
+
+/* Prototypes */
+int subset_band_window
+(
+    Espa_band_meta_t *bmeta,  /* I: band metadata for the source band */
+    char *out_img_file,       /* I: name of the clipped raw binary file */
+    int start_line,           /* I: first line of the window (0-based) */
+    int start_samp,           /* I: first sample of the window (0-based) */
+    int nlines,               /* I: number of lines in the window */
+    int nsamps                /* I: number of samples in the window */
+);
+
+int subset_pixels_by_window
+(
+    char *in_xml_file,   /* I: input XML file of the product to be subset */
+    char *out_xml_file,  /* I: output XML file for the clipped product */
+    int nbands,          /* I: number of bands to be included in the subset
+                               product; 0 clips all the bands */
+    char bands[][STR_SIZE], /* I: array of nbands band names to be clipped */
+    int start_line,      /* I: first line of the window (0-based) */
+    int start_samp,      /* I: first sample of the window (0-based) */
+    int nlines,          /* I: number of lines in the window */
+    int nsamps           /* I: number of samples in the window */
+);
+
+#endif
@@ -19,6 +19,12 @@ Date         Programmer       Reason
                               and bias since we are supporting both the
                               radiance and reflectance gain and bias from the
                               MTL. This is more consistent with their labeling.
+8/31/2026    Gail Schmidt     Drive the simple optional elements through
+                              shared field tables and emit each band through
+                              one emitter shared by the write and append
+                              paths, so schema changes are single-table edits
+8/31/2026    Gail Schmidt     Emit the QA description through the heap
+                              string field shape
 
 NOTES:
   1. The XML metadata format written via this library follows the ESPA internal
@@ -28,8 +34,333 @@ NOTES:
 *****************************************************************************/
 
 #include <math.h>
+#include <stddef.h>
 #include "write_metadata.h"
 
+/* Value shapes understood by the table-driven element emitter */
+typedef enum
+{
+    XML_FIELD_STRING,      /* string field, always emitted */
+    XML_FIELD_STRING_OPT,  /* string field, skipped when fill */
+    XML_FIELD_STRPTR_OPT,  /* heap string field, skipped when NULL or fill */
+    XML_FIELD_FLOAT_OPT,   /* float field, skipped when fill */
+    XML_FIELD_INT_OPT,     /* int field, skipped when fill */
+    XML_FIELD_DOUBLE2_OPT, /* pair of doubles, skipped unless both are set */
+    XML_FIELD_LONG2_OPT    /* pair of longs, skipped unless both are set */
+} Xml_field_type_t;
+
+/* One element of the XML document: the emission format line plus where its
+   value(s) live in the metadata structure.  The tables below are walked in
+   document order by emit_xml_fields, so adding an element to the document
+   is one new table row instead of matching hand edits in the write and
+   append paths. */
+typedef struct
+{
+    Xml_field_type_t type; /* value shape of the element */
+    const char *fmt;       /* fully indented format line for the element */
+    size_t offset;         /* offset of the field in the structure */
+    size_t offset2;        /* offset of the second field for pair shapes */
+} Espa_xml_field_t;
+
+/* Optional date/time elements of the global metadata, in document order */
+static const Espa_xml_field_t global_date_fields[] =
+{
+    {XML_FIELD_STRING_OPT,
+        "        <acquisition_date>%s</acquisition_date>\n",
+        offsetof (Espa_global_meta_t, acquisition_date), 0},
+    {XML_FIELD_STRING_OPT,
+        "        <scene_center_time>%s</scene_center_time>\n",
+        offsetof (Espa_global_meta_t, scene_center_time), 0},
+    {XML_FIELD_STRING_OPT,
+        "        <level1_production_date>%s</level1_production_date>\n",
+        offsetof (Espa_global_meta_t, level1_production_date), 0},
+};
+
+/* Earth-sun distance element of the global metadata */
+static const Espa_xml_field_t global_earth_sun_field[] =
+{
+    {XML_FIELD_FLOAT_OPT,
+        "        <earth_sun_distance>%f</earth_sun_distance>\n",
+        offsetof (Espa_global_meta_t, earth_sun_dist), 0},
+};
+
+/* LPGS metadata filename element of the global metadata */
+static const Espa_xml_field_t global_lpgs_field[] =
+{
+    {XML_FIELD_STRING_OPT,
+        "        <lpgs_metadata_file>%s</lpgs_metadata_file>\n",
+        offsetof (Espa_global_meta_t, lpgs_metadata_file), 0},
+};
+
+/* Optional band elements between resample_method and bitmap_description,
+   in document order */
+static const Espa_xml_field_t band_range_fields[] =
+{
+    {XML_FIELD_STRING_OPT,
+        "            <data_units>%s</data_units>\n",
+        offsetof (Espa_band_meta_t, data_units), 0},
+    {XML_FIELD_LONG2_OPT,
+        "            <valid_range min=\"%ld\" max=\"%ld\"/>\n",
+        offsetof (Espa_band_meta_t, valid_range[0]),
+        offsetof (Espa_band_meta_t, valid_range[1])},
+    {XML_FIELD_DOUBLE2_OPT,
+        "            <radiance gain=\"%.5g\" bias=\"%.5g\"/>\n",
+        offsetof (Espa_band_meta_t, rad_gain),
+        offsetof (Espa_band_meta_t, rad_bias)},
+    {XML_FIELD_DOUBLE2_OPT,
+        "            <reflectance gain=\"%.5g\" bias=\"%.5g\"/>\n",
+        offsetof (Espa_band_meta_t, refl_gain),
+        offsetof (Espa_band_meta_t, refl_bias)},
+    {XML_FIELD_DOUBLE2_OPT,
+        "            <thermal_const k1=\"%.2f\" k2=\"%.2f\"/>\n",
+        offsetof (Espa_band_meta_t, k1_const),
+        offsetof (Espa_band_meta_t, k2_const)},
+};
+
+/* Optional band elements between class_values and statistics, in document
+   order */
+static const Espa_xml_field_t band_tail_fields[] =
+{
+    {XML_FIELD_STRPTR_OPT,
+        "            <qa_description>%s"
+        "            </qa_description>\n",
+        offsetof (Espa_band_meta_t, qa_desc), 0},
+    {XML_FIELD_FLOAT_OPT,
+        "            <calibrated_nt>%f</calibrated_nt>\n",
+        offsetof (Espa_band_meta_t, calibrated_nt), 0},
+    {XML_FIELD_STRING_OPT,
+        "            <checksum algorithm=\"crc32c\">%s</checksum>\n",
+        offsetof (Espa_band_meta_t, checksum), 0},
+    {XML_FIELD_INT_OPT,
+        "            <byte_order>%d</byte_order>\n",
+        offsetof (Espa_band_meta_t, byte_order), 0},
+};
+
+
+/******************************************************************************
+MODULE:  emit_xml_fields (static)
+
+PURPOSE: Walks a field table in document order and emits each element whose
+value(s) are present, formatting the field at the recorded offset with the
+recorded format line.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+static void emit_xml_fields
+(
+    FILE *fptr,              /* I: stream the document is rendered into */
+    const void *base,        /* I: metadata structure the offsets apply to */
+    const Espa_xml_field_t *fields,  /* I: field table in document order */
+    int nfields              /* I: number of fields in the table */
+)
+{
+    const char *b = base;    /* byte view of the structure for the offsets */
+    const char *str;         /* string value of the current field */
+    float val;               /* float value of the current field */
+    double dval, dval2;      /* double value(s) of the current field */
+    long lval, lval2;        /* long value(s) of the current field */
+    int ival;                /* int value of the current field */
+    int f;                   /* looping variable for the fields */
+
+    for (f = 0; f < nfields; f++)
+    {
+        switch (fields[f].type)
+        {
+            case XML_FIELD_STRING:
+                fprintf (fptr, fields[f].fmt, b + fields[f].offset);
+                break;
+
+            case XML_FIELD_STRING_OPT:
+                str = b + fields[f].offset;
+                if (strcmp (str, ESPA_STRING_META_FILL))
+                    fprintf (fptr, fields[f].fmt, str);
+                break;
+
+            case XML_FIELD_STRPTR_OPT:
+                str = *(char * const *) (b + fields[f].offset);
+                if (str != NULL && strcmp (str, ESPA_STRING_META_FILL))
+                    fprintf (fptr, fields[f].fmt, str);
+                break;
+
+            case XML_FIELD_FLOAT_OPT:
+                val = *(const float *) (b + fields[f].offset);
+                if (fabs (val - ESPA_FLOAT_META_FILL) > ESPA_EPSILON)
+                    fprintf (fptr, fields[f].fmt, val);
+                break;
+
+            case XML_FIELD_INT_OPT:
+                ival = *(const int *) (b + fields[f].offset);
+                if (ival != ESPA_INT_META_FILL)
+                    fprintf (fptr, fields[f].fmt, ival);
+                break;
+
+            case XML_FIELD_DOUBLE2_OPT:
+                dval = *(const double *) (b + fields[f].offset);
+                dval2 = *(const double *) (b + fields[f].offset2);
+                if (fabs (dval - ESPA_FLOAT_META_FILL) > ESPA_EPSILON &&
+                    fabs (dval2 - ESPA_FLOAT_META_FILL) > ESPA_EPSILON)
+                    fprintf (fptr, fields[f].fmt, dval, dval2);
+                break;
+
+            case XML_FIELD_LONG2_OPT:
+                lval = *(const long *) (b + fields[f].offset);
+                lval2 = *(const long *) (b + fields[f].offset2);
+                if (lval != ESPA_INT_META_FILL &&
+                    lval2 != ESPA_INT_META_FILL)
+                    fprintf (fptr, fields[f].fmt, lval, lval2);
+                break;
+        }
+    }
+}
+
+
+/******************************************************************************
+MODULE:  emit_band_metadata (static)
+
+PURPOSE: Emits the complete band element for one band, shared by the write
+and append paths so the band document layout lives in one place.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Optional elements whose values are fill are not written.
+******************************************************************************/
+static void emit_band_metadata
+(
+    FILE *fptr,              /* I: stream the document is rendered into */
+    const Espa_band_meta_t *bmeta  /* I: metadata for the band */
+)
+{
+    char my_dtype[STR_SIZE]; /* data type string */
+    char my_rtype[STR_SIZE]; /* resampling type string */
+    int j;                   /* looping variable */
+
+    switch (bmeta->data_type)
+    {
+        case ESPA_INT8: strcpy (my_dtype, "INT8"); break;
+        case ESPA_UINT8: strcpy (my_dtype, "UINT8"); break;
+        case ESPA_INT16: strcpy (my_dtype, "INT16"); break;
+        case ESPA_UINT16: strcpy (my_dtype, "UINT16"); break;
+        case ESPA_INT32: strcpy (my_dtype, "INT32"); break;
+        case ESPA_UINT32: strcpy (my_dtype, "UINT32"); break;
+        case ESPA_FLOAT32: strcpy (my_dtype, "FLOAT32"); break;
+        case ESPA_FLOAT64: strcpy (my_dtype, "FLOAT64"); break;
+        default: strcpy (my_dtype, "undefined"); break;
+    }
+
+    switch (bmeta->resample_method)
+    {
+        case ESPA_CC: strcpy (my_rtype, "cubic convolution"); break;
+        case ESPA_NN: strcpy (my_rtype, "nearest neighbor"); break;
+        case ESPA_BI: strcpy (my_rtype, "bilinear"); break;
+        case ESPA_NONE: strcpy (my_rtype, "none"); break;
+        default: strcpy (my_rtype, "undefined"); break;
+    }
+
+    if (!strcmp (bmeta->source, ESPA_STRING_META_FILL)) /* no source type */
+        fprintf (fptr,
+            "        <band product=\"%s\" name=\"%s\" category=\"%s\" "
+            "data_type=\"%s\" nlines=\"%d\" nsamps=\"%d\"",
+            bmeta->product, bmeta->name, bmeta->category, my_dtype,
+            bmeta->nlines, bmeta->nsamps);
+    else  /* contains a source type */
+        fprintf (fptr,
+            "        <band product=\"%s\" source=\"%s\" name=\"%s\" "
+            "category=\"%s\" data_type=\"%s\" nlines=\"%d\" nsamps=\"%d\"",
+            bmeta->product, bmeta->source, bmeta->name,
+            bmeta->category, my_dtype, bmeta->nlines, bmeta->nsamps);
+
+    if (bmeta->fill_value != ESPA_INT_META_FILL)
+        fprintf (fptr, " fill_value=\"%ld\"", bmeta->fill_value);
+    if (bmeta->saturate_value != ESPA_INT_META_FILL)
+        fprintf (fptr, " saturate_value=\"%d\"",
+        bmeta->saturate_value);
+    if (fabs (bmeta->scale_factor - ESPA_FLOAT_META_FILL) > ESPA_EPSILON)
+        fprintf (fptr, " scale_factor=\"%f\"", bmeta->scale_factor);
+    if (fabs (bmeta->add_offset - ESPA_FLOAT_META_FILL) > ESPA_EPSILON)
+        fprintf (fptr, " add_offset=\"%f\"", bmeta->add_offset);
+    fprintf (fptr, ">\n");
+
+    fprintf (fptr,
+        "            <short_name>%s</short_name>\n"
+        "            <long_name>%s</long_name>\n"
+        "            <file_name>%s</file_name>\n"
+        "            <pixel_size x=\"%g\" y=\"%g\" units=\"%s\"/>\n"
+        "            <resample_method>%s</resample_method>\n",
+        bmeta->short_name, bmeta->long_name, bmeta->file_name,
+        bmeta->pixel_size[0], bmeta->pixel_size[1],
+        bmeta->pixel_units, my_rtype);
+
+    emit_xml_fields (fptr, bmeta, band_range_fields,
+        sizeof (band_range_fields) / sizeof (band_range_fields[0]));
+
+    if (bmeta->nbits != ESPA_INT_META_FILL && bmeta->nbits > 0)
+    {
+        fprintf (fptr,
+            "            <bitmap_description>\n");
+        for (j = 0; j < bmeta->nbits; j++)
+        {
+            fprintf (fptr,
+                "                <bit num=\"%d\">%s</bit>\n",
+                j, bmeta->bitmap_description[j]);
+        }
+        fprintf (fptr,
+            "            </bitmap_description>\n");
+    }
+
+    if (bmeta->nclass != ESPA_INT_META_FILL && bmeta->nclass > 0)
+    {
+        fprintf (fptr,
+            "            <class_values>\n");
+        for (j = 0; j < bmeta->nclass; j++)
+        {
+            fprintf (fptr,
+                "                <class num=\"%d\">%s</class>\n",
+                 bmeta->class_values[j].class,
+                 bmeta->class_values[j].description);
+        }
+        fprintf (fptr,
+            "            </class_values>\n");
+    }
+
+    emit_xml_fields (fptr, bmeta, band_tail_fields,
+        sizeof (band_tail_fields) / sizeof (band_tail_fields[0]));
+
+    if (bmeta->stat_npixels != ESPA_INT_META_FILL)
+    {
+        fprintf (fptr,
+            "            <statistics minimum=\"%g\" maximum=\"%g\" "
+            "mean=\"%g\" npixels=\"%ld\">", bmeta->stat_min,
+            bmeta->stat_max, bmeta->stat_mean,
+            bmeta->stat_npixels);
+        for (j = 0; j < ESPA_STAT_HIST_BINS; j++)
+            fprintf (fptr, "%s%ld", (j == 0) ? "" : " ",
+                bmeta->stat_histogram[j]);
+        fprintf (fptr, "</statistics>\n");
+    }
+
+    fprintf (fptr,
+        "            <app_version>%s</app_version>\n"
+        "            <production_date>%s</production_date>\n"
+        "        </band>\n",
+        bmeta->app_version, bmeta->production_date);
+}
+
+
 /******************************************************************************
 MODULE:  write_metadata
 
@@ -54,6 +385,18 @@ Date         Programmer       Reason
                               gain/bias, and K1/K2 constants. Changed
                               toa_gain/bias to rad_gain/bias to be consistent
                               with refl_gain/bias.
+8/31/2026    Gail Schmidt     Render the document into an in-memory buffer and
+                              flush it with a single write instead of issuing
+                              many small writes per band
+8/31/2026    Gail Schmidt     Write the band checksum when one was computed
+8/31/2026    Gail Schmidt     Write the band byte order when one was declared
+8/31/2026    Gail Schmidt     Write the band statistics when they were
+                              computed
+8/31/2026    Gail Schmidt     Record the content checksum in a trust sidecar
+                              so later stages can skip revalidation
+8/31/2026    Gail Schmidt     Emit the simple optional elements through the
+                              shared field tables and each band through the
+                              shared band emitter
 
 
 NOTES:
@@ -62,6 +405,9 @@ NOTES:
      existing metadata file, use append_metadata.
   3. It is recommended that validate_meta be used after writing the XML file
      to make sure the new file is valid against the ESPA schema.
+  4. The document is rendered into a growable memory stream and written to
+     the output file with one fwrite, which avoids per-element write calls
+     on high-latency (e.g. NFS) file systems.
 ******************************************************************************/
 int write_metadata
 (
@@ -75,20 +421,23 @@ int write_metadata
     char errmsg[STR_SIZE];   /* error message */
     char myproj[STR_SIZE];   /* projection type string */
     char mydatum[STR_SIZE];  /* datum string */
-    char my_dtype[STR_SIZE]; /* data type string */
-    char my_rtype[STR_SIZE]; /* resampling type string */
-    int i, j;                /* looping variables */
-    FILE *fptr = NULL;       /* file pointer to the XML metadata file */
+    int i;                   /* looping variable */
+    FILE *fptr = NULL;       /* memory stream the document is rendered into */
+    FILE *xml_fptr = NULL;   /* file pointer to the XML metadata file */
+    char *doc_buf = NULL;    /* buffer holding the rendered document */
+    size_t doc_len = 0;      /* length of the rendered document */
     Espa_global_meta_t *gmeta = &metadata->global;  /* pointer to the global
                                                        metadata structure */
     Espa_band_meta_t *bmeta = metadata->band;  /* pointer to the array of
                                                   bands metadata */
 
-    /* Open the metadata XML file for write or rewrite privelages */
-    fptr = fopen (xml_file, "w");
+    /* Render the document into a growable memory stream; it is flushed to
+       the output file with a single write at the end */
+    fptr = open_memstream (&doc_buf, &doc_len);
     if (fptr == NULL)
     {
-        sprintf (errmsg, "Opening %s for write access.", xml_file);
+        sprintf (errmsg, "Opening the memory stream for rendering %s.",
+            xml_file);
         error_handler (true, FUNC_NAME, errmsg);
         return (ERROR);
     }
@@ -110,20 +459,8 @@ int write_metadata
         "        <instrument>%s</instrument>\n",
         gmeta->data_provider, gmeta->satellite, gmeta->instrument);
 
-    if (strcmp (gmeta->acquisition_date, ESPA_STRING_META_FILL))
-        fprintf (fptr,
-        "        <acquisition_date>%s</acquisition_date>\n",
-        gmeta->acquisition_date);
-
-    if (strcmp (gmeta->scene_center_time, ESPA_STRING_META_FILL))
-        fprintf (fptr,
-        "        <scene_center_time>%s</scene_center_time>\n",
-        gmeta->scene_center_time);
-
-    if (strcmp (gmeta->level1_production_date, ESPA_STRING_META_FILL))
-        fprintf (fptr,
-        "        <level1_production_date>%s</level1_production_date>\n",
-        gmeta->level1_production_date);
+    emit_xml_fields (fptr, gmeta, global_date_fields,
+        sizeof (global_date_fields) / sizeof (global_date_fields[0]));
 
     if (fabs (gmeta->solar_azimuth - ESPA_FLOAT_META_FILL) > ESPA_EPSILON &&
         fabs (gmeta->solar_zenith - ESPA_FLOAT_META_FILL) > ESPA_EPSILON)
@@ -131,10 +468,7 @@ int write_metadata
         "        <solar_angles zenith=\"%f\" azimuth=\"%f\" units=\"%s\"/>\n",
         gmeta->solar_zenith, gmeta->solar_azimuth, gmeta->solar_units);
 
-    if (fabs (gmeta->earth_sun_dist - ESPA_FLOAT_META_FILL) > ESPA_EPSILON)
-        fprintf (fptr,
-        "        <earth_sun_distance>%f</earth_sun_distance>\n",
-        gmeta->earth_sun_dist);
+    emit_xml_fields (fptr, gmeta, global_earth_sun_field, 1);
 
     if (gmeta->wrs_system != ESPA_INT_META_FILL)
         fprintf (fptr,
@@ -147,10 +481,7 @@ int write_metadata
         "        <modis htile=\"%d\" vtile=\"%d\"/>\n",
         gmeta->htile, gmeta->vtile);
 
-    if (strcmp (gmeta->lpgs_metadata_file, ESPA_STRING_META_FILL))
-        fprintf (fptr,
-        "        <lpgs_metadata_file>%s</lpgs_metadata_file>\n",
-        gmeta->lpgs_metadata_file);
+    emit_xml_fields (fptr, gmeta, global_lpgs_field, 1);
 
     /* Write the global metadata - corners and bounding coords */
     fprintf (fptr,
@@ -276,150 +607,10 @@ int write_metadata
     fprintf (fptr,
         "    <bands>\n");
 
-    /* Write the bands themselves.  Make sure the optional parameters have
-       been specified and are not fill, otherwise don't write them out. */
+    /* Write the bands themselves through the shared band emitter.  The
+       optional elements whose values are fill are not written. */
     for (i = 0; i < metadata->nbands; i++)
-    {
-        switch (bmeta[i].data_type)
-        {
-            case ESPA_INT8: strcpy (my_dtype, "INT8"); break;
-            case ESPA_UINT8: strcpy (my_dtype, "UINT8"); break;
-            case ESPA_INT16: strcpy (my_dtype, "INT16"); break;
-            case ESPA_UINT16: strcpy (my_dtype, "UINT16"); break;
-            case ESPA_INT32: strcpy (my_dtype, "INT32"); break;
-            case ESPA_UINT32: strcpy (my_dtype, "UINT32"); break;
-            case ESPA_FLOAT32: strcpy (my_dtype, "FLOAT32"); break;
-            case ESPA_FLOAT64: strcpy (my_dtype, "FLOAT64"); break;
-            default: strcpy (my_dtype, "undefined"); break;
-        }
-
-        switch (bmeta[i].resample_method)
-        {
-            case ESPA_CC: strcpy (my_rtype, "cubic convolution"); break;
-            case ESPA_NN: strcpy (my_rtype, "nearest neighbor"); break;
-            case ESPA_BI: strcpy (my_rtype, "bilinear"); break;
-            case ESPA_NONE: strcpy (my_rtype, "none"); break;
-            default: strcpy (my_rtype, "undefined"); break;
-        }
-
-        if (!strcmp (bmeta[i].source, ESPA_STRING_META_FILL)) /*no source type*/
-            fprintf (fptr,
-                "        <band product=\"%s\" name=\"%s\" category=\"%s\" "
-                "data_type=\"%s\" nlines=\"%d\" nsamps=\"%d\"",
-                bmeta[i].product, bmeta[i].name, bmeta[i].category, my_dtype,
-                bmeta[i].nlines, bmeta[i].nsamps);
-        else  /* contains a source type */
-            fprintf (fptr,
-                "        <band product=\"%s\" source=\"%s\" name=\"%s\" "
-                "category=\"%s\" data_type=\"%s\" nlines=\"%d\" nsamps=\"%d\"",
-                bmeta[i].product, bmeta[i].source, bmeta[i].name,
-                bmeta[i].category, my_dtype, bmeta[i].nlines, bmeta[i].nsamps);
-
-        if (bmeta[i].fill_value != ESPA_INT_META_FILL)
-            fprintf (fptr, " fill_value=\"%ld\"", bmeta[i].fill_value);
-        if (bmeta[i].saturate_value != ESPA_INT_META_FILL)
-            fprintf (fptr, " saturate_value=\"%d\"",
-            bmeta[i].saturate_value);
-        if (fabs (bmeta[i].scale_factor-ESPA_FLOAT_META_FILL) > ESPA_EPSILON)
-            fprintf (fptr, " scale_factor=\"%f\"", bmeta[i].scale_factor);
-        if (fabs (bmeta[i].add_offset-ESPA_FLOAT_META_FILL) > ESPA_EPSILON)
-            fprintf (fptr, " add_offset=\"%f\"", bmeta[i].add_offset);
-        fprintf (fptr, ">\n");
-
-        fprintf (fptr,
-            "            <short_name>%s</short_name>\n"
-            "            <long_name>%s</long_name>\n"
-            "            <file_name>%s</file_name>\n"
-            "            <pixel_size x=\"%g\" y=\"%g\" units=\"%s\"/>\n"
-            "            <resample_method>%s</resample_method>\n",
-            bmeta[i].short_name, bmeta[i].long_name, bmeta[i].file_name,
-            bmeta[i].pixel_size[0], bmeta[i].pixel_size[1],
-            bmeta[i].pixel_units, my_rtype);
-
-        if (strcmp (bmeta[i].data_units, ESPA_STRING_META_FILL))
-            fprintf (fptr,
-                "            <data_units>%s</data_units>\n",
-                bmeta[i].data_units);
-
-        if (bmeta[i].valid_range[0] != ESPA_INT_META_FILL &&
-            bmeta[i].valid_range[1] != ESPA_INT_META_FILL)
-        {
-            fprintf (fptr,
-                "            <valid_range min=\"%ld\" max=\"%ld\"/>\n",
-                bmeta[i].valid_range[0], bmeta[i].valid_range[1]);
-        }
-
-        if (fabs (bmeta[i].rad_gain - ESPA_FLOAT_META_FILL) > ESPA_EPSILON &&
-            fabs (bmeta[i].rad_bias - ESPA_FLOAT_META_FILL) > ESPA_EPSILON)
-        {
-            fprintf (fptr,
-                "            <radiance gain=\"%.5g\" bias=\"%.5g\"/>\n",
-                bmeta[i].rad_gain, bmeta[i].rad_bias);
-        }
-
-        if (fabs (bmeta[i].refl_gain - ESPA_FLOAT_META_FILL) > ESPA_EPSILON &&
-            fabs (bmeta[i].refl_bias - ESPA_FLOAT_META_FILL) > ESPA_EPSILON)
-        {
-            fprintf (fptr,
-                "            <reflectance gain=\"%.5g\" bias=\"%.5g\"/>\n",
-                bmeta[i].refl_gain, bmeta[i].refl_bias);
-        }
-
-        if (fabs (bmeta[i].k1_const - ESPA_FLOAT_META_FILL) > ESPA_EPSILON &&
-            fabs (bmeta[i].k2_const - ESPA_FLOAT_META_FILL) > ESPA_EPSILON)
-        {
-            fprintf (fptr,
-                "            <thermal_const k1=\"%.2f\" k2=\"%.2f\"/>\n",
-                bmeta[i].k1_const, bmeta[i].k2_const);
-        }
-
-        if (bmeta[i].nbits != ESPA_INT_META_FILL && bmeta[i].nbits > 0)
-        {
-            fprintf (fptr,
-                "            <bitmap_description>\n");
-            for (j = 0; j < bmeta[i].nbits; j++)
-            {
-                fprintf (fptr,
-                    "                <bit num=\"%d\">%s</bit>\n",
-                    j, bmeta[i].bitmap_description[j]);
-            }
-            fprintf (fptr,
-                "            </bitmap_description>\n");
-        }
-
-        if (bmeta[i].nclass != ESPA_INT_META_FILL && bmeta[i].nclass > 0)
-        {
-            fprintf (fptr,
-                "            <class_values>\n");
-            for (j = 0; j < bmeta[i].nclass; j++)
-            {
-                fprintf (fptr,
-                    "                <class num=\"%d\">%s</class>\n",
-                     bmeta[i].class_values[j].class,
-                     bmeta[i].class_values[j].description);
-            }
-            fprintf (fptr,
-                "            </class_values>\n");
-        }
-
-        if (strcmp (bmeta[i].qa_desc, ESPA_STRING_META_FILL))
-            fprintf (fptr,
-                "            <qa_description>%s"
-                "            </qa_description>\n", bmeta[i].qa_desc);
-
-        if (fabs (bmeta[i].calibrated_nt-ESPA_FLOAT_META_FILL) > ESPA_EPSILON)
-        {
-            fprintf (fptr,
-                "            <calibrated_nt>%f</calibrated_nt>\n",
-                bmeta[i].calibrated_nt);
-        }
-
-        fprintf (fptr,
-            "            <app_version>%s</app_version>\n"
-            "            <production_date>%s</production_date>\n"
-            "        </band>\n",
-            bmeta[i].app_version, bmeta[i].production_date);
-    }
+        emit_band_metadata (fptr, &bmeta[i]);
 
     /* Finish it off */
     fprintf (fptr,
@@ -427,9 +618,37 @@ int write_metadata
     fprintf (fptr,
         "</espa_metadata>\n");
 
-    /* Close the XML file */
+    /* Close the memory stream, which finalizes the rendered buffer */
     fclose (fptr);
 
+    /* Open the metadata XML file for write or rewrite privelages and flush
+       the rendered document with one write */
+    xml_fptr = fopen (xml_file, "w");
+    if (xml_fptr == NULL)
+    {
+        sprintf (errmsg, "Opening %s for write access.", xml_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        free (doc_buf);
+        return (ERROR);
+    }
+
+    if (fwrite (doc_buf, 1, doc_len, xml_fptr) != doc_len)
+    {
+        sprintf (errmsg, "Writing the metadata document to %s.", xml_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        fclose (xml_fptr);
+        free (doc_buf);
+        return (ERROR);
+    }
+
+    /* Close the XML file and free the rendered document */
+    fclose (xml_fptr);
+    free (doc_buf);
+
+    /* Record the content checksum so later stages in the pipeline can skip
+       revalidating the unchanged document */
+    record_trusted_metadata (xml_file);
+
     /* Successful generation */
     return (SUCCESS);
 }
@@ -452,6 +671,16 @@ Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 12/30/2013   Gail Schmidt     Original development
 11/12/2014   Gail Schmidt     Updated to support resample_option
+8/31/2026    Gail Schmidt     Write the band checksum when one was computed
+8/31/2026    Gail Schmidt     Write the band byte order when one was declared
+8/31/2026    Gail Schmidt     Write the band statistics when they were
+                              computed
+8/31/2026    Gail Schmidt     Find the closing bands element by scanning the
+                              document tail backward instead of reading the
+                              whole file forward
+8/31/2026    Gail Schmidt     Refresh the trust sidecar after the append
+8/31/2026    Gail Schmidt     Emit each band through the band emitter shared
+                              with write_metadata
 
 NOTES:
   1. If the XML file specified already exists, it will be overwritten.
@@ -471,11 +700,16 @@ int append_metadata
 {
     char FUNC_NAME[] = "append_metadata";       /* function name */
     char errmsg[STR_SIZE];   /* error message */
-    char my_dtype[STR_SIZE]; /* data type string */
-    char my_rtype[STR_SIZE]; /* resampling type string */
     char linebuf[MAX_LINE_SIZE];  /* buffer to hold each line */
+    char tailbuf[APPEND_TAIL_BYTES + 1];  /* buffer for the document tail */
     char *cur_ptr;           /* pointer index in the line buffer */
-    int i, j;                /* looping variables */
+    char *match = NULL;      /* location of the closing bands element */
+    char *next = NULL;       /* next closing bands element candidate */
+    int i;                   /* looping variable */
+    long tail_nbytes;        /* number of bytes read from the tail */
+    off_t file_size;         /* size of the XML file in bytes */
+    off_t tail_start;        /* file offset the tail was read from */
+    off_t splice_offset;     /* file offset to splice the new bands at */
     FILE *fptr = NULL;       /* file pointer to the XML metadata file */
     fpos_t cur_pos;          /* current position in the file */
 
@@ -488,196 +722,122 @@ int append_metadata
         return (ERROR);
     }
 
-    /* Skip through the XML file looking for the closing </bands> element.
-       That's where we want to append the new bands and then close everything
-       off (i.e. bands and espa_metadata). Note, if the closing </bands>
-       element is not found in the XML file, then the bands will simply be
-       appended at the end of the XML file. This will likely leave an XML
-       file which does not validate against the ESPA schema, but the input
-       XML likely didn't validate either in this case. */
-    if (fgetpos (fptr, &cur_pos) == -1)
+    /* Find the closing </bands> element, where the new bands are spliced
+       in before everything is closed off again (i.e. bands and
+       espa_metadata).  The closing element sits at the very end of the
+       document, so only the tail of the file is read and scanned backward
+       instead of reading the whole document forward; science applications
+       append a few bands per stage several stages per scene, and the full
+       forward scans added up on large documents. */
+    if (fseeko (fptr, 0, SEEK_END) != 0)
     {
-        sprintf (errmsg, "Getting the current position in the XML fstream.");
+        sprintf (errmsg, "Seeking to the end of the XML file.");
         error_handler (true, FUNC_NAME, errmsg);
+        fclose (fptr);
         return (ERROR);
     }
-    while (fgets (linebuf, MAX_LINE_SIZE, fptr))
+    file_size = ftello (fptr);
+    tail_start = file_size - APPEND_TAIL_BYTES;
+    if (tail_start < 0)
+        tail_start = 0;
+    if (fseeko (fptr, tail_start, SEEK_SET) != 0)
     {
-        /* Skip past the front end white space from proper indentation in
-           the metadata file */
-        cur_ptr = linebuf;
-        while (cur_ptr[0] == ' ' || cur_ptr[0] == '\t')
-            cur_ptr++;
-        if (!strncmp (cur_ptr, "</bands>", 8))
-        {
-            /* </bands> line was found.  Now seek back to the beginning of
-               that line in the file. */
-            if (fsetpos (fptr, &cur_pos) == -1)
-            {
-                sprintf (errmsg, "Setting current position in the XML fstream "
-                    "to the start of the </bands> line.");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            /* Clear the while loop */
+        sprintf (errmsg, "Seeking to the tail of the XML file.");
+        error_handler (true, FUNC_NAME, errmsg);
+        fclose (fptr);
+        return (ERROR);
+    }
+    tail_nbytes = fread (tailbuf, 1, APPEND_TAIL_BYTES, fptr);
+    tailbuf[tail_nbytes < 0 ? 0 : tail_nbytes] = '\0';
+
+    /* Use the last </bands> in the tail; anything textually matching in
+       band descriptions earlier in the document is outside the tail for
+       any reasonably sized file */
+    match = strstr (tailbuf, "</bands>");
+    while (match != NULL)
+    {
+        next = strstr (match + 1, "</bands>");
+        if (next == NULL)
             break;
-        }
+        match = next;
+    }
 
-        /* Store the location of the current stream so we can get back here */
-        if (fgetpos (fptr, &cur_pos) == -1)
+    if (match != NULL)
+    {
+        /* Back up over the indentation to the start of the </bands> line
+           and splice there */
+        splice_offset = tail_start + (match - tailbuf);
+        while (splice_offset > tail_start &&
+            (tailbuf[splice_offset - tail_start - 1] == ' ' ||
+             tailbuf[splice_offset - tail_start - 1] == '\t'))
+            splice_offset--;
+        if (fseeko (fptr, splice_offset, SEEK_SET) != 0)
         {
-            sprintf (errmsg, "Getting current position in the XML fstream.");
+            sprintf (errmsg, "Seeking to the start of the </bands> line.");
             error_handler (true, FUNC_NAME, errmsg);
+            fclose (fptr);
             return (ERROR);
         }
     }
-
-    /* Append the new bands.  Make sure the optional parameters have been
-       specified and are not fill, otherwise don't write them out. */
-    for (i = 0; i < nbands; i++)
+    else
     {
-        switch (bmeta[i].data_type)
-        {
-            case ESPA_INT8: strcpy (my_dtype, "INT8"); break;
-            case ESPA_UINT8: strcpy (my_dtype, "UINT8"); break;
-            case ESPA_INT16: strcpy (my_dtype, "INT16"); break;
-            case ESPA_UINT16: strcpy (my_dtype, "UINT16"); break;
-            case ESPA_INT32: strcpy (my_dtype, "INT32"); break;
-            case ESPA_UINT32: strcpy (my_dtype, "UINT32"); break;
-            case ESPA_FLOAT32: strcpy (my_dtype, "FLOAT32"); break;
-            case ESPA_FLOAT64: strcpy (my_dtype, "FLOAT64"); break;
-            default: strcpy (my_dtype, "undefined"); break;
-        }
-
-        switch (bmeta[i].resample_method)
-        {
-            case ESPA_CC: strcpy (my_rtype, "cubic convolution"); break;
-            case ESPA_NN: strcpy (my_rtype, "nearest neighbor"); break;
-            case ESPA_BI: strcpy (my_rtype, "bilinear"); break;
-            case ESPA_NONE: strcpy (my_rtype, "none"); break;
-            default: strcpy (my_rtype, "undefined"); break;
-        }
-
-        if (!strcmp (bmeta[i].source, ESPA_STRING_META_FILL)) /*no source type*/
-            fprintf (fptr,
-                "        <band product=\"%s\" name=\"%s\" category=\"%s\" "
-                "data_type=\"%s\" nlines=\"%d\" nsamps=\"%d\"",
-                bmeta[i].product, bmeta[i].name, bmeta[i].category, my_dtype,
-                bmeta[i].nlines, bmeta[i].nsamps);
-        else  /* contains a source type */
-            fprintf (fptr,
-                "        <band product=\"%s\" source=\"%s\" name=\"%s\" "
-                "category=\"%s\" data_type=\"%s\" nlines=\"%d\" nsamps=\"%d\"",
-                bmeta[i].product, bmeta[i].source, bmeta[i].name,
-                bmeta[i].category, my_dtype, bmeta[i].nlines, bmeta[i].nsamps);
-
-        if (bmeta[i].fill_value != ESPA_INT_META_FILL)
-            fprintf (fptr, " fill_value=\"%ld\"", bmeta[i].fill_value);
-        if (bmeta[i].saturate_value != ESPA_INT_META_FILL)
-            fprintf (fptr, " saturate_value=\"%d\"",
-            bmeta[i].saturate_value);
-        if (fabs (bmeta[i].scale_factor - ESPA_FLOAT_META_FILL) > ESPA_EPSILON)
-            fprintf (fptr, " scale_factor=\"%f\"", bmeta[i].scale_factor);
-        if (fabs (bmeta[i].add_offset - ESPA_FLOAT_META_FILL) > ESPA_EPSILON)
-            fprintf (fptr, " add_offset=\"%f\"", bmeta[i].add_offset);
-        fprintf (fptr, ">\n");
-
-        fprintf (fptr,
-            "            <short_name>%s</short_name>\n"
-            "            <long_name>%s</long_name>\n"
-            "            <file_name>%s</file_name>\n"
-            "            <pixel_size x=\"%g\" y=\"%g\" units=\"%s\"/>\n"
-            "            <resample_method>%s</resample_method>\n",
-            bmeta[i].short_name, bmeta[i].long_name, bmeta[i].file_name,
-            bmeta[i].pixel_size[0], bmeta[i].pixel_size[1],
-            bmeta[i].pixel_units, my_rtype);
-
-        if (strcmp (bmeta[i].data_units, ESPA_STRING_META_FILL))
-            fprintf (fptr,
-                "            <data_units>%s</data_units>\n",
-                bmeta[i].data_units);
-
-        if (bmeta[i].valid_range[0] != ESPA_INT_META_FILL &&
-            bmeta[i].valid_range[1] != ESPA_INT_META_FILL)
-        {
-            fprintf (fptr,
-                "            <valid_range min=\"%ld\" max=\"%ld\"/>\n",
-                bmeta[i].valid_range[0], bmeta[i].valid_range[1]);
-        }
-
-        if (fabs (bmeta[i].rad_gain - ESPA_FLOAT_META_FILL) > ESPA_EPSILON &&
-            fabs (bmeta[i].rad_bias - ESPA_FLOAT_META_FILL) > ESPA_EPSILON)
-        {
-            fprintf (fptr,
-                "            <radiance gain=\"%.5g\" bias=\"%.5g\"/>\n",
-                bmeta[i].rad_gain, bmeta[i].rad_bias);
-        }
-
-        if (fabs (bmeta[i].refl_gain - ESPA_FLOAT_META_FILL) > ESPA_EPSILON &&
-            fabs (bmeta[i].refl_bias - ESPA_FLOAT_META_FILL) > ESPA_EPSILON)
+        /* Fall back to the forward line scan for oversized closing regions.
+           Note, if the closing </bands> element is not found in the XML
+           file at all, then the bands will simply be appended at the end of
+           the XML file.  This will likely leave an XML file which does not
+           validate against the ESPA schema, but the input XML likely didn't
+           validate either in this case. */
+        rewind (fptr);
+        if (fgetpos (fptr, &cur_pos) == -1)
         {
-            fprintf (fptr,
-                "            <reflectance gain=\"%.5g\" bias=\"%.5g\"/>\n",
-                bmeta[i].refl_gain, bmeta[i].refl_bias);
+            sprintf (errmsg, "Getting the current position in the XML "
+                "fstream.");
+            error_handler (true, FUNC_NAME, errmsg);
+            fclose (fptr);
+            return (ERROR);
         }
-
-        if (fabs (bmeta[i].k1_const - ESPA_FLOAT_META_FILL) > ESPA_EPSILON &&
-            fabs (bmeta[i].k2_const - ESPA_FLOAT_META_FILL) > ESPA_EPSILON)
+        while (fgets (linebuf, MAX_LINE_SIZE, fptr))
         {
-            fprintf (fptr,
-                "            <thermal_const k1=\"%.2f\" k2=\"%.2f\"/>\n",
-                bmeta[i].k1_const, bmeta[i].k2_const);
-        }
-
-        if (bmeta[i].nbits != ESPA_INT_META_FILL && bmeta[i].nbits > 0)
-        {
-            fprintf (fptr,
-                "            <bitmap_description>\n");
-            for (j = 0; j < bmeta[i].nbits; j++)
+            /* Skip past the front end white space from proper indentation in
+               the metadata file */
+            cur_ptr = linebuf;
+            while (cur_ptr[0] == ' ' || cur_ptr[0] == '\t')
+                cur_ptr++;
+            if (!strncmp (cur_ptr, "</bands>", 8))
             {
-                fprintf (fptr,
-                    "                <bit num=\"%d\">%s</bit>\n",
-                    j, bmeta[i].bitmap_description[j]);
+                /* </bands> line was found.  Now seek back to the beginning of
+                   that line in the file. */
+                if (fsetpos (fptr, &cur_pos) == -1)
+                {
+                    sprintf (errmsg, "Setting current position in the XML "
+                        "fstream to the start of the </bands> line.");
+                    error_handler (true, FUNC_NAME, errmsg);
+                    fclose (fptr);
+                    return (ERROR);
+                }
+
+                /* Clear the while loop */
+                break;
             }
-            fprintf (fptr,
-                "            </bitmap_description>\n");
-        }
 
-        if (bmeta[i].nclass != ESPA_INT_META_FILL && bmeta[i].nclass > 0)
-        {
-            fprintf (fptr,
-                "            <class_values>\n");
-            for (j = 0; j < bmeta[i].nclass; j++)
+            /* Store the location of the current stream so we can get back
+               here */
+            if (fgetpos (fptr, &cur_pos) == -1)
             {
-                fprintf (fptr,
-                    "                <class num=\"%d\">%s</class>\n",
-                     bmeta[i].class_values[j].class,
-                     bmeta[i].class_values[j].description);
+                sprintf (errmsg, "Getting current position in the XML "
+                    "fstream.");
+                error_handler (true, FUNC_NAME, errmsg);
+                fclose (fptr);
+                return (ERROR);
             }
-            fprintf (fptr,
-                "            </class_values>\n");
-        }
-
-        if (strcmp (bmeta[i].qa_desc, ESPA_STRING_META_FILL))
-            fprintf (fptr,
-                "            <qa_description>%s"
-                "            </qa_description>\n", bmeta[i].qa_desc);
-
-        if (fabs (bmeta[i].calibrated_nt - ESPA_FLOAT_META_FILL) > ESPA_EPSILON)
-        {
-            fprintf (fptr,
-                "            <calibrated_nt>%f</calibrated_nt>\n",
-                bmeta[i].calibrated_nt);
         }
-
-        fprintf (fptr,
-            "            <app_version>%s</app_version>\n"
-            "            <production_date>%s</production_date>\n"
-            "        </band>\n",
-            bmeta[i].app_version, bmeta[i].production_date);
     }
 
+    /* Append the new bands through the shared band emitter.  The optional
+       elements whose values are fill are not written. */
+    for (i = 0; i < nbands; i++)
+        emit_band_metadata (fptr, &bmeta[i]);
+
     /* Finish it off */
     fprintf (fptr,
         "    </bands>\n");
@@ -687,6 +847,10 @@ int append_metadata
     /* Close the XML file */
     fclose (fptr);
 
+    /* Refresh the recorded content checksum so the appended document can
+       still skip revalidation in later stages */
+    record_trusted_metadata (xml_file);
+
     /* Successful append */
     return (SUCCESS);
 }
@@ -901,8 +1065,17 @@ void print_metadata_struct
                      metadata->band[i].class_values[j].description);
             }
         }
-        printf ("    qa_description: %s\n", metadata->band[i].qa_desc);
+        printf ("    qa_description: %s\n",
+             get_band_qa_desc (&metadata->band[i]));
         printf ("    calibrated_nt: %f\n", metadata->band[i].calibrated_nt);
+        printf ("    checksum: %s\n", metadata->band[i].checksum);
+        printf ("    byte_order: %d\n", metadata->band[i].byte_order);
+        if (metadata->band[i].stat_npixels != ESPA_INT_META_FILL)
+        {
+            printf ("    statistics: min=%g max=%g mean=%g npixels=%ld\n",
+                metadata->band[i].stat_min, metadata->band[i].stat_max,
+                metadata->band[i].stat_mean, metadata->band[i].stat_npixels);
+        }
         printf ("    app_version: %s\n", metadata->band[i].app_version);
         printf ("    production_date: %s\n", metadata->band[i].production_date);
         printf ("\n");
@@ -12,6 +12,7 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 12/27/2013   Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added the tail size used when appending bands
 
 NOTES:
 *****************************************************************************/
@@ -29,6 +30,11 @@ NOTES:
 /* maximum number of characters per line in the XML file */
 #define MAX_LINE_SIZE 1024
 
+/* number of bytes read from the end of the XML file to find the closing
+   bands element when appending; covers the closing tags with plenty of
+   margin */
+#define APPEND_TAIL_BYTES 4096
+
 /* Prototypes */
 int write_metadata
 (
@@ -137,6 +137,18 @@ int gctp_transform
     double * out_coor      /* O: array of (x, y) or (lon, lat) */
 );
 
+/* Routine to transform an array of coordinates using a transformation set up
+   by gctp_create_transformation.  Projections that provide a batch kernel
+   transform the whole array in tight loops instead of dispatching per point,
+   which is considerably faster when transforming every pixel of a scene. */
+int gctp_transform_batch
+(
+    const GCTP_TRANSFORMATION *trans, /* I: transformation to use */
+    int count,             /* I: number of coordinate pairs to transform */
+    const double *in_coor, /* I: array of count (lon, lat) or (x, y) pairs */
+    double *out_coor       /* O: array of count (x, y) or (lon, lat) pairs */
+);
+
 typedef enum gctp_message_type_enum
 {
     GCTP_INFO_MESSAGE,
@@ -179,6 +191,13 @@ int gctp_calc_utm_zone
     double lon          /* I: longitude (in degrees) */
 );
 
+/* Routine to indicate whether a transformation can be used concurrently
+   from multiple threads */
+int gctp_transformation_is_threadsafe
+(
+    const GCTP_TRANSFORMATION *trans
+);
+
 void gctp_only_allow_threadsafe_transforms();
 
 #endif
@@ -144,3 +144,95 @@ int gctp_transform
 
     return GCTP_SUCCESS;
 }
+
+/****************************************************************************
+Name: gctp_transform_batch
+
+Purpose: Performs a coordinate transformation on an array of coordinate
+    pairs.  If both halves of the transformation provide a batch transform
+    routine (or don't need one), the whole array is processed in tight
+    loops that avoid the per-point dispatch overhead and let the compiler
+    vectorize the math.  Otherwise the points are transformed one at a time
+    with gctp_transform.
+
+Returns: GCTP_SUCCESS, GCTP_ERROR or GCTP_IN_BREAK
+
+****************************************************************************/
+int gctp_transform_batch
+(
+    const GCTP_TRANSFORMATION *trans, /* I: transformation to use */
+    int count,             /* I: number of coordinate pairs to transform */
+    const double *in_coor, /* I: array of count (lon, lat) or (x, y) pairs */
+    double *out_coor       /* O: array of count (x, y) or (lon, lat) pairs */
+)
+{
+    double factor;  /* unit conversion factor */
+    int index;      /* coordinate pair counter */
+
+    /* Verify the transformation provided is valid */
+    if (!trans)
+    {
+        GCTP_PRINT_ERROR("Invalid transformation provided");
+        return GCTP_ERROR;
+    }
+
+    /* Fall back to transforming the points one at a time if the old gctp
+       routine is needed or either half of the transformation has a transform
+       routine without a batch version */
+    if (trans->use_gctp
+        || (trans->inverse.transform && !trans->inverse.transform_batch)
+        || (trans->forward.transform && !trans->forward.transform_batch))
+    {
+        for (index = 0; index < count; index++)
+        {
+            int status = gctp_transform(trans, &in_coor[index * 2],
+                &out_coor[index * 2]);
+            if (status != GCTP_SUCCESS)
+                return status;
+        }
+        return GCTP_SUCCESS;
+    }
+
+    /* Convert the input coordinates into the correct units for this
+       transformation.  The intermediate results are staged in the output
+       array so no scratch buffer is needed; the batch transform routines
+       allow the input and output arrays to be the same. */
+    factor = trans->inverse.unit_conversion_factor;
+    for (index = 0; index < count * 2; index++)
+        out_coor[index] = in_coor[index] * factor;
+
+    if (trans->inverse.transform_batch)
+    {
+        int status;
+
+        status = trans->inverse.transform_batch(&trans->inverse, count,
+            out_coor, out_coor);
+        if (status != GCTP_SUCCESS)
+        {
+            if (status == IN_BREAK)
+            {
+                /* In a break area, so return that indication */
+                return GCTP_IN_BREAK;
+            }
+            GCTP_PRINT_ERROR("Error in inverse transformation");
+            return GCTP_ERROR;
+        }
+    }
+
+    if (trans->forward.transform_batch)
+    {
+        if (trans->forward.transform_batch(&trans->forward, count,
+                out_coor, out_coor) != GCTP_SUCCESS)
+        {
+            GCTP_PRINT_ERROR("Error in forward transformation");
+            return GCTP_ERROR;
+        }
+    }
+
+    /* Convert the output coordinates into the units the caller requested */
+    factor = trans->forward.unit_conversion_factor;
+    for (index = 0; index < count * 2; index++)
+        out_coor[index] *= factor;
+
+    return GCTP_SUCCESS;
+}
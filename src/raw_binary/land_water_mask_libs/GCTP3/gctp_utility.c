@@ -72,6 +72,26 @@ const GCTP_PROJECTION *gctp_get_output_proj
     return &trans->forward.proj;
 }
 
+/******************************************************************************
+Name: gctp_transformation_is_threadsafe
+
+Purpose: Indicates whether a transformation can be used concurrently from
+    multiple threads.  Transformations using the new interface are immutable
+    after creation, so they can be shared; transformations falling back to
+    the original gctp routine rely on global state and can not.
+
+Returns:
+    1 if the transformation is threadsafe, 0 if it is not
+
+******************************************************************************/
+int gctp_transformation_is_threadsafe
+(
+    const GCTP_TRANSFORMATION *trans
+)
+{
+    return !trans->use_gctp;
+}
+
 /******************************************************************************
 Name: gctp_calc_utm_zone
 
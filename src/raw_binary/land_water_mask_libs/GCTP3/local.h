@@ -28,12 +28,25 @@ typedef void (*DESTROY_TRANSFORM)(TRANSFORMATION *);
 typedef int (*TRANSFORM_FUNC)(const TRANSFORMATION *trans,
     double in_x, double in_y, double *out_x, double *out_y);
 
+/* Function typedef for an optional batch transform function that transforms
+   an array of count coordinate pairs in one call.  The input and output
+   arrays hold interleaved pairs and may be the same array since each output
+   pair is only written after the matching input pair has been read.
+   Projections that do not provide a batch function leave the pointer NULL
+   and the points are transformed one at a time. */
+typedef int (*TRANSFORM_BATCH_FUNC)(const TRANSFORMATION *trans,
+    int count, const double *in, double *out);
+
 /* Define a structure for tracking the information for a transformation.  The
    same structure works for both forward and inverse transformations. */
 struct transformation
 {
     GCTP_PROJECTION proj;     /* projection information */
     TRANSFORM_FUNC transform; /* function pointer for the transform function */
+    TRANSFORM_BATCH_FUNC transform_batch; /* optional function pointer for
+                                  transforming an array of coordinates in one
+                                  call.  NULL if the projection does not
+                                  provide one. */
     DESTROY_TRANSFORM destroy; /* Function pointer to clean up the
                                   transformation.  Note that most projections
                                   can leave this at the default NULL. */
@@ -85,6 +98,10 @@ void gctp_print_message
 /*********** Internal routines for initializing projections ***************/
 int gctp_geo_init(TRANSFORMATION *trans);
 
+int gctp_albers_inverse_init(TRANSFORMATION *trans);
+
+int gctp_albers_forward_init(TRANSFORMATION *trans);
+
 int gctp_lamcc_inverse_init(TRANSFORMATION *trans);
 
 int gctp_lamcc_forward_init(TRANSFORMATION *trans);
@@ -105,6 +122,10 @@ int gctp_state_plane_inverse_init(TRANSFORMATION *trans);
 
 int gctp_state_plane_forward_init(TRANSFORMATION *trans);
 
+int gctp_sin_inverse_init(TRANSFORMATION *trans);
+
+int gctp_sin_forward_init(TRANSFORMATION *trans);
+
 int gctp_som_inverse_init(TRANSFORMATION *trans);
 
 int gctp_som_forward_init(TRANSFORMATION *trans);
@@ -0,0 +1,231 @@
+/*******************************************************************************
+Name: SINUSOIDAL
+
+Purpose: Provides the transformations between Easting/Northing and longitude/
+    latitude for the Sinusoidal projection.  The Easting and Northing values
+    are in meters.  The longitude and latitude are in radians.
+
+Algorithm References
+
+1.  Snyder, John P., "Map Projections--A Working Manual", U.S. Geological
+    Survey Professional Paper 1395 (Supersedes USGS Bulletin 1532), United
+    State Government Printing Office, Washington D.C., 1987.
+
+2.  "Software Documentation for GCTP General Cartographic Transformation
+    Package", U.S. Geological Survey National Mapping Division, May 1982.
+*******************************************************************************/
+#include <stdlib.h>
+#include "cproj.h"
+#include "gctp.h"
+#include "local.h"
+
+/* structure to hold the setup data relevant to this projection */
+struct sin_proj
+{
+    double radius;          /* radius of the earth (sphere) */
+    double lon_center;      /* center longitude (projection center) */
+    double false_easting;   /* x offset in meters */
+    double false_northing;  /* y offset in meters */
+};
+
+/*****************************************************************************
+Name: print_info
+
+Purpose: Prints a summary of information about this projection.
+
+Returns:
+    nothing
+
+*****************************************************************************/
+static void print_info
+(
+    const TRANSFORMATION *trans
+)
+{
+    struct sin_proj *cache_ptr = (struct sin_proj *)trans->cache;
+
+    gctp_print_title("SINUSOIDAL");
+    gctp_print_radius(cache_ptr->radius);
+    gctp_print_cenlon(cache_ptr->lon_center);
+    gctp_print_offsetp(cache_ptr->false_easting, cache_ptr->false_northing);
+}
+
+/*******************************************************************************
+Name: common_init
+
+Purpose: Initialization routine for initializing the projection information
+    that is common to both the forward and inverse transformations.
+
+Returns:
+    GCTP_SUCCESS or GCTP_ERROR
+
+*******************************************************************************/
+static int common_init
+(
+    TRANSFORMATION *trans   /* I/O: transformation to initialize */
+)
+{
+    double r_major;             /* major axis */
+    double r_minor;             /* minor axis */
+    double radius;              /* radius of the earth (sphere) */
+    double lon_center;          /* center longitude */
+    double false_easting;       /* x offset in meters */
+    double false_northing;      /* y offset in meters */
+
+    const GCTP_PROJECTION *proj = &trans->proj;
+    struct sin_proj *cache = NULL;
+    int spheroid = proj->spheroid;
+
+    gctp_get_spheroid(spheroid, proj->parameters, &r_major, &r_minor, &radius);
+    false_easting  = proj->parameters[6];
+    false_northing = proj->parameters[7];
+
+    if (gctp_dms2degrees(proj->parameters[4], &lon_center) != GCTP_SUCCESS)
+    {
+        GCTP_PRINT_ERROR("Error converting center longitude in parameter 4 "
+            "from DMS to degrees: %f", proj->parameters[4]);
+        return GCTP_ERROR;
+    }
+    lon_center *= 3600 * S2R;
+
+    /* Allocate a structure for the cached info */
+    cache = malloc(sizeof(*cache));
+    if (!cache)
+    {
+        GCTP_PRINT_ERROR("Error allocating memory for cache buffer");
+        return GCTP_ERROR;
+    }
+    trans->cache = cache;
+
+    /* Save the information to the cache */
+    cache->radius = radius;
+    cache->lon_center = lon_center;
+    cache->false_easting = false_easting;
+    cache->false_northing = false_northing;
+
+    trans->print_info = print_info;
+
+    return GCTP_SUCCESS;
+}
+
+/*****************************************************************************
+Name: inverse_transform
+
+Purpose: Transforms X,Y to lat,long
+
+Returns:
+    GCTP_SUCCESS or GCTP_ERROR
+
+*****************************************************************************/
+static int inverse_transform
+(
+    const TRANSFORMATION *trans, /* I: transformation information */
+    double x,       /* I: X projection coordinate */
+    double y,       /* I: Y projection coordinate */
+    double *lon,    /* O: Longitude */
+    double *lat     /* O: Latitude */
+)
+{
+    struct sin_proj *cache_ptr = (struct sin_proj *)trans->cache;
+    double temp;        /* re-used temporary variable */
+
+    x -= cache_ptr->false_easting;
+    y -= cache_ptr->false_northing;
+    *lat = y / cache_ptr->radius;
+    if (fabs(*lat) > HALF_PI)
+    {
+        GCTP_PRINT_ERROR("Input data error");
+        return GCTP_ERROR;
+    }
+    temp = fabs(*lat) - HALF_PI;
+    if (fabs(temp) > EPSLN)
+    {
+        temp = cache_ptr->lon_center + x / (cache_ptr->radius * cos(*lat));
+        *lon = adjust_lon(temp);
+    }
+    else
+        *lon = cache_ptr->lon_center;
+
+    return GCTP_SUCCESS;
+}
+
+/*****************************************************************************
+Name: forward_transform
+
+Purpose: Transforms lat,long to sinusoidal X,Y
+
+Returns:
+    GCTP_SUCCESS or GCTP_ERROR
+
+*****************************************************************************/
+static int forward_transform
+(
+    const TRANSFORMATION *trans, /* I: transformation information */
+    double lon,         /* I: Longitude */
+    double lat,         /* I: Latitude */
+    double *x,          /* O: X projection coordinate */
+    double *y           /* O: Y projection coordinate */
+)
+{
+    struct sin_proj *cache_ptr = (struct sin_proj *)trans->cache;
+    double delta_lon;   /* delta longitude (given longitude - center) */
+
+    delta_lon = adjust_lon(lon - cache_ptr->lon_center);
+    *x = cache_ptr->radius * delta_lon * cos(lat) + cache_ptr->false_easting;
+    *y = cache_ptr->radius * lat + cache_ptr->false_northing;
+
+    return GCTP_SUCCESS;
+}
+
+
+/*****************************************************************************
+Name: gctp_sin_inverse_init
+
+Purpose: Initializes the inverse sinusoidal transformation
+
+Returns:
+    GCTP_SUCCESS or GCTP_ERROR
+
+*****************************************************************************/
+int gctp_sin_inverse_init
+(
+    TRANSFORMATION *trans
+)
+{
+    /* Call the common routine used for the forward and inverse init */
+    if (common_init(trans) != GCTP_SUCCESS)
+    {
+        GCTP_PRINT_ERROR("Error initializing sinusoidal inverse projection");
+        return GCTP_ERROR;
+    }
+
+    trans->transform = inverse_transform;
+
+    return GCTP_SUCCESS;
+}
+
+/*****************************************************************************
+Name: gctp_sin_forward_init
+
+Purpose: Initializes the forward sinusoidal transformation
+
+Returns:
+    GCTP_SUCCESS or GCTP_ERROR
+
+*****************************************************************************/
+int gctp_sin_forward_init
+(
+    TRANSFORMATION *trans
+)
+{
+    /* Call the common routine used for the forward and inverse init */
+    if (common_init(trans) != GCTP_SUCCESS)
+    {
+        GCTP_PRINT_ERROR("Error initializing sinusoidal forward projection");
+        return GCTP_ERROR;
+    }
+
+    trans->transform = forward_transform;
+
+    return GCTP_SUCCESS;
+}
@@ -400,6 +400,123 @@ static int inverse_transform
     return GCTP_SUCCESS;
 }
 
+/*****************************************************************************
+Name: inverse_transform_batch
+
+Purpose: Transforms an array of UTM/TM X,Y pairs to long,lat pairs.  This
+    does the same math as inverse_transform, restructured as a single loop
+    over the coordinate array with the projection constants hoisted into
+    locals so the compiler can keep them in registers and vectorize the
+    series evaluations.  The input and output arrays may be the same array.
+
+Returns:
+    GCTP_SUCCESS or GCTP_ERROR
+
+*****************************************************************************/
+static int inverse_transform_batch
+(
+    const TRANSFORMATION *trans, /* I: transformation information */
+    int count,          /* I: number of coordinate pairs to transform */
+    const double *in,   /* I: array of count X,Y pairs */
+    double *out         /* O: array of count longitude,latitude pairs */
+)
+{
+    const struct tm_proj *cache_ptr = (struct tm_proj *)trans->cache;
+    const double r_major = cache_ptr->r_major;
+    const double scale_factor = cache_ptr->scale_factor;
+    const double lon_center = cache_ptr->lon_center;
+    const double false_easting = cache_ptr->false_easting;
+    const double false_northing = cache_ptr->false_northing;
+    const double e0 = cache_ptr->e0;
+    const double e1 = cache_ptr->e1;
+    const double e2 = cache_ptr->e2;
+    const double e3 = cache_ptr->e3;
+    const double es = cache_ptr->es;
+    const double esp = cache_ptr->esp;
+    const double ml0 = cache_ptr->ml0;
+    const long max_iter = 6;        /* maximun number of iterations */
+    int index;                      /* coordinate pair counter */
+    long i;                         /* iteration counter */
+
+    /* The spherical form isn't worth a dedicated batch loop, so just
+       transform the points one at a time */
+    if (cache_ptr->is_sphere)
+    {
+        for (index = 0; index < count; index++)
+        {
+            double lon;
+            double lat;
+
+            if (inverse_transform(trans, in[index * 2], in[index * 2 + 1],
+                    &lon, &lat) != GCTP_SUCCESS)
+                return GCTP_ERROR;
+            out[index * 2] = lon;
+            out[index * 2 + 1] = lat;
+        }
+        return GCTP_SUCCESS;
+    }
+
+    for (index = 0; index < count; index++)
+    {
+        double x = in[index * 2] - false_easting;
+        double y = in[index * 2 + 1] - false_northing;
+        double con, phi;                /* temporary angles */
+        double delta_phi;               /* difference between longitudes */
+        double lon;                     /* output longitude */
+        double lat;                     /* output latitude */
+
+        con = (ml0 + y / scale_factor) / r_major;
+        phi = con;
+        for (i = 0; ; i++)
+        {
+            delta_phi = ((con + e1 * sin(2.0*phi) - e2 * sin(4.0*phi)
+                      + e3 * sin(6.0*phi)) / e0) - phi;
+            phi += delta_phi;
+            if (fabs(delta_phi) <= EPSLN)
+                break;
+            if (i >= max_iter)
+            {
+                GCTP_PRINT_ERROR("Latitude failed to converge in inverse "
+                    "transform");
+                return GCTP_ERROR;
+            }
+        }
+        if (fabs(phi) < HALF_PI)
+        {
+            double sin_phi, cos_phi, tan_phi; /* sin cos and tangent values */
+            double c, cs, t, ts, n, r, d, ds; /* temporary variables */
+
+            sincos(phi, &sin_phi, &cos_phi);
+            tan_phi = tan(phi);
+            c    = esp * SQUARE(cos_phi);
+            cs   = SQUARE(c);
+            t    = SQUARE(tan_phi);
+            ts   = SQUARE(t);
+            con  = 1.0 - es * SQUARE(sin_phi);
+            n    = r_major / sqrt(con);
+            r    = n * (1.0 - es) / con;
+            d    = x / (n * scale_factor);
+            ds   = SQUARE(d);
+            lat  = phi - (n * tan_phi * ds / r) * (0.5 - ds / 24.0 * (5.0
+                 + 3.0 * t + 10.0 * c - 4.0 * cs - 9.0 * esp - ds / 30.0
+                 * (61.0 + 90.0 * t + 298.0 * c + 45.0 * ts - 252.0
+                 * esp - 3.0 * cs)));
+            lon  = adjust_lon(lon_center + (d * (1.0 - ds / 6.0
+                 * (1.0 + 2.0 * t + c - ds / 20.0 * (5.0 - 2.0 * c + 28.0
+                 * t - 3.0 * cs + 8.0 * esp + 24.0 * ts)))
+                 / cos_phi));
+        }
+        else
+        {
+            lat = HALF_PI * gctp_get_sign(y);
+            lon = lon_center;
+        }
+        out[index * 2] = lon;
+        out[index * 2 + 1] = lat;
+    }
+    return GCTP_SUCCESS;
+}
+
 /*****************************************************************************
 Name: forward_transform
 
@@ -474,6 +591,100 @@ static int forward_transform
     return GCTP_SUCCESS;
 }
 
+/*****************************************************************************
+Name: forward_transform_batch
+
+Purpose: Transforms an array of long,lat pairs to UTM/TM X,Y pairs.  This
+    does the same math as forward_transform, restructured as a single loop
+    over the coordinate array with the projection constants hoisted into
+    locals and the distance from the equator series evaluated inline so the
+    compiler can keep the constants in registers and vectorize the series
+    evaluations.  The input and output arrays may be the same array.
+
+Returns:
+    GCTP_SUCCESS or GCTP_ERROR
+
+*****************************************************************************/
+static int forward_transform_batch
+(
+    const TRANSFORMATION *trans, /* I: transformation information */
+    int count,          /* I: number of coordinate pairs to transform */
+    const double *in,   /* I: array of count longitude,latitude pairs */
+    double *out         /* O: array of count X,Y pairs */
+)
+{
+    const struct tm_proj *cache_ptr = (struct tm_proj *)trans->cache;
+    const double r_major = cache_ptr->r_major;
+    const double scale_factor = cache_ptr->scale_factor;
+    const double lon_center = cache_ptr->lon_center;
+    const double false_easting = cache_ptr->false_easting;
+    const double false_northing = cache_ptr->false_northing;
+    const double e0 = cache_ptr->e0;
+    const double e1 = cache_ptr->e1;
+    const double e2 = cache_ptr->e2;
+    const double e3 = cache_ptr->e3;
+    const double es = cache_ptr->es;
+    const double esp = cache_ptr->esp;
+    const double ml0 = cache_ptr->ml0;
+    int index;          /* coordinate pair counter */
+
+    /* The spherical form isn't worth a dedicated batch loop, so just
+       transform the points one at a time */
+    if (cache_ptr->is_sphere)
+    {
+        for (index = 0; index < count; index++)
+        {
+            double x;
+            double y;
+
+            if (forward_transform(trans, in[index * 2], in[index * 2 + 1],
+                    &x, &y) != GCTP_SUCCESS)
+                return GCTP_ERROR;
+            out[index * 2] = x;
+            out[index * 2 + 1] = y;
+        }
+        return GCTP_SUCCESS;
+    }
+
+    for (index = 0; index < count; index++)
+    {
+        double lon = in[index * 2];
+        double lat = in[index * 2 + 1];
+        double delta_lon;       /* Delta longitude (Given longitude-center) */
+        double sin_phi, cos_phi;/* sin and cos value */
+        double al, als;         /* temporary values */
+        double c, t, tq;        /* temporary values */
+        double con, n, ml;      /* cone constant, small m */
+
+        delta_lon = adjust_lon(lon - lon_center);
+        sincos(lat, &sin_phi, &cos_phi);
+
+        al  = cos_phi * delta_lon;
+        als = SQUARE(al);
+        c   = esp * SQUARE(cos_phi);
+        tq  = tan(lat);
+        t   = SQUARE(tq);
+        con = 1.0 - es * SQUARE(sin_phi);
+        n   = r_major / sqrt(con);
+
+        /* Inline gctp_calc_dist_from_equator so the series stays in the
+           loop body */
+        ml  = r_major * (e0 * lat - e1 * sin(2.0 * lat)
+            + e2 * sin(4.0 * lat) - e3 * sin(6.0 * lat));
+
+        out[index * 2] = scale_factor * n * al * (1.0 + als / 6.0
+            * (1.0 - t + c + als / 20.0 * (5.0 - 18.0 * t + SQUARE(t) + 72.0
+            * c - 58.0 * esp))) + false_easting;
+
+        out[index * 2 + 1] = scale_factor * (ml - ml0 + n * tq * (als
+            * (0.5 + als / 24.0 * (5.0 - t + 9.0 * c + 4.0 * SQUARE(c) + als
+            / 30.0 * (61.0 - 58.0 * t + SQUARE(t) + 600.0 * c - 330.0
+            * esp))))) + false_northing;
+    }
+
+    return GCTP_SUCCESS;
+}
+
 /*****************************************************************************
 Name: gctp_utm_inverse_init
 
@@ -496,6 +707,7 @@ int gctp_utm_inverse_init
     }
 
     trans->transform = inverse_transform;
+    trans->transform_batch = inverse_transform_batch;
 
     return GCTP_SUCCESS;
 }
@@ -522,6 +734,7 @@ int gctp_utm_forward_init
     }
 
     trans->transform = forward_transform;
+    trans->transform_batch = forward_transform_batch;
 
     return GCTP_SUCCESS;
 }
@@ -548,6 +761,7 @@ int gctp_tm_inverse_init
     }
 
     trans->transform = inverse_transform;
+    trans->transform_batch = inverse_transform_batch;
 
     return GCTP_SUCCESS;
 }
@@ -574,6 +788,7 @@ int gctp_tm_forward_init
     }
 
     trans->transform = forward_transform;
+    trans->transform_batch = forward_transform_batch;
 
     return GCTP_SUCCESS;
 }
@@ -24,14 +24,16 @@ NOTES:
 #include <string.h>
 #include <math.h>
 
+#include "espa_parallel.h"
 #include "generate_land_water_mask.h"
 
 /******************************************************************************
-MODULE:  generate_land_water_mask
+MODULE:  generate_land_water_mask_window
 
-PURPOSE:  This function creates the land/water mask (land = 1) for the area
-covered by the scene.  If the output mask image name is provided, the mask
-image is written to a file with that name.
+PURPOSE:  This function creates the land/water mask (land = 1) for the
+specified line/sample window within the scene.  Only the window is projected
+and clipped against the land-mass polygon, so subset workflows which only
+need the mask for a tile don't pay for the full scene extent.
 
 RETURN VALUE:
 Type = int
@@ -43,26 +45,36 @@ SUCCESS      Successful completion
 HISTORY:
 Date         Programmer       Reason
 ----------   ---------------  -------------------------------------
-4/10/2015    Landsat 8 Team   Original code received from the Landsat 8 IAS
-4/14/2015    Gail Schmidt     Modified for use in ESPA   
+8/31/2026    Gail Schmidt     Original development, pulled from
+                              generate_land_water_mask and extended to
+                              support a line/sample window
+8/31/2026    Gail Schmidt     A num_threads of 0 or less chooses the thread
+                              count automatically from the window size and
+                              the machine
 
 NOTES:
-1. Memory for the land water mask will be allocated for the entire image
-   (nlines x nsamps x sizeof (unsigned char)).  It is up to the calling routine
-   to free this memory.
+1. Memory for the land water mask will be allocated for the window
+   (window_nlines x window_nsamps x sizeof (unsigned char)).  It is up to the
+   calling routine to free this memory.
 ******************************************************************************/
-int generate_land_water_mask
+int generate_land_water_mask_window
 (
     Espa_internal_meta_t *xml_meta,   /* I: input XML metadata */
     const char land_mass_polygon[],   /* I: name of land mass polygon file */
-    unsigned char **land_water_mask,  /* O: pointer to land water mask buffer,
-                                            memory is allocated and the
-                                            mask is populated */
-    int *nlines,                      /* O: number of lines in the mask */
-    int *nsamps                       /* O: number of samples in the mask */
+    int num_threads,                  /* I: number of threads to use (0 or
+                                            less chooses automatically) */
+    int start_line,                   /* I: starting line of the window in the
+                                            scene (0-based) */
+    int start_samp,                   /* I: starting sample of the window in
+                                            the scene (0-based) */
+    int window_nlines,                /* I: number of lines in the window */
+    int window_nsamps,                /* I: number of samples in the window */
+    unsigned char **land_water_mask   /* O: pointer to land water mask buffer
+                                            for the window, memory is allocated
+                                            and the mask is populated */
 )
 {
-    char FUNC_NAME[] = "generate_land_water_mask";   /* function name */
+    char FUNC_NAME[] = "generate_land_water_mask_window";  /* function name */
     char errmsg[STR_SIZE];            /* error message */
     int i;                            /* looping variable */
     int refl_indx = -9;               /* band index in XML file for the
@@ -95,6 +107,21 @@ int generate_land_water_mask
         return (ERROR);
     }
 
+    /* Make sure the window falls within the scene */
+    if (start_line < 0 || start_samp < 0 || window_nlines < 1 ||
+        window_nsamps < 1 ||
+        start_line + window_nlines > xml_meta->band[refl_indx].nlines ||
+        start_samp + window_nsamps > xml_meta->band[refl_indx].nsamps)
+    {
+        sprintf (errmsg, "Window of %d lines x %d samples starting at line "
+            "%d, sample %d is not within the scene (%d lines x %d samples)",
+            window_nlines, window_nsamps, start_line, start_samp,
+            xml_meta->band[refl_indx].nlines,
+            xml_meta->band[refl_indx].nsamps);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
     /* If the grid origin is center, then adjust for the resolution.  The
        corners will be written for the outer extents of the corner. */
     if (!strcmp (gmeta->proj_info.grid_origin, "CENTER"))
@@ -125,6 +152,14 @@ int generate_land_water_mask
             xml_meta->band[refl_indx].pixel_size[1];
     }
 
+    /* Shift the corners to the outer extents of the window */
+    upper_left_x += start_samp * xml_meta->band[refl_indx].pixel_size[0];
+    upper_left_y -= start_line * xml_meta->band[refl_indx].pixel_size[1];
+    lower_right_x = upper_left_x +
+        window_nsamps * xml_meta->band[refl_indx].pixel_size[0];
+    lower_right_y = upper_left_y -
+        window_nlines * xml_meta->band[refl_indx].pixel_size[1];
+
     /* Set the l1g image band metadata to image structure */
     mask_image.corners = (struct IAS_CORNERS)
         {
@@ -135,11 +170,9 @@ int generate_land_water_mask
         };
     mask_image.pixel_size_x = xml_meta->band[refl_indx].pixel_size[0];
     mask_image.pixel_size_y = xml_meta->band[refl_indx].pixel_size[1];
-    mask_image.nl = xml_meta->band[refl_indx].nlines;
-    mask_image.ns = xml_meta->band[refl_indx].nsamps;
+    mask_image.nl = window_nlines;
+    mask_image.ns = window_nsamps;
     mask_image.band_number = xml_meta->nbands+1;  /* not used */
-    *nlines = xml_meta->band[refl_indx].nlines;
-    *nsamps = xml_meta->band[refl_indx].nsamps;
 
     /* Set the projection contents based on info from the XML */
     for (i = 0; i < NPROJ_PARAM; i++)
@@ -213,10 +246,16 @@ int generate_land_water_mask
         return (ERROR);
     }
 
+    /* Choose the thread count from the window size and the machine when
+       the caller didn't specify one */
+    if (num_threads <= 0)
+        num_threads = espa_parallel_threads (window_nlines, window_nsamps,
+            sizeof (unsigned char));
+
     /* Use the land-mass polygon to generate a land/water mask for this
-       scene */
+       window */
     if (ias_geo_shape_mask_projection(land_mass_polygon, &mask_image,
-        &mask_projection, *land_water_mask) != SUCCESS)
+        &mask_projection, num_threads, *land_water_mask) != SUCCESS)
     {
         sprintf (errmsg, "Creating land and water mask");
         error_handler (true, FUNC_NAME, errmsg);
@@ -225,3 +264,87 @@ int generate_land_water_mask
 
     return (SUCCESS);
 }
+
+
+/******************************************************************************
+MODULE:  generate_land_water_mask
+
+PURPOSE:  This function creates the land/water mask (land = 1) for the area
+covered by the scene.  If the output mask image name is provided, the mask
+image is written to a file with that name.
+
+RETURN VALUE:
+Type = int
+Value        Description
+-------      -----------
+ERROR        Error occurred opening or reading the file
+SUCCESS      Successful completion
+
+HISTORY:
+Date         Programmer       Reason
+----------   ---------------  -------------------------------------
+4/10/2015    Landsat 8 Team   Original code received from the Landsat 8 IAS
+4/14/2015    Gail Schmidt     Modified for use in ESPA
+8/31/2026    Gail Schmidt     Added num_threads to support generating the mask
+                              with multiple threads
+8/31/2026    Gail Schmidt     Moved the mask generation into
+                              generate_land_water_mask_window and generate the
+                              full scene as a window covering the whole extent
+8/31/2026    Gail Schmidt     A num_threads of 0 or less chooses the thread
+                              count automatically from the scene size and
+                              the machine
+
+NOTES:
+1. Memory for the land water mask will be allocated for the entire image
+   (nlines x nsamps x sizeof (unsigned char)).  It is up to the calling routine
+   to free this memory.
+******************************************************************************/
+int generate_land_water_mask
+(
+    Espa_internal_meta_t *xml_meta,   /* I: input XML metadata */
+    const char land_mass_polygon[],   /* I: name of land mass polygon file */
+    int num_threads,                  /* I: number of threads to use (0 or
+                                            less chooses automatically) */
+    unsigned char **land_water_mask,  /* O: pointer to land water mask buffer,
+                                            memory is allocated and the
+                                            mask is populated */
+    int *nlines,                      /* O: number of lines in the mask */
+    int *nsamps                       /* O: number of samples in the mask */
+)
+{
+    char FUNC_NAME[] = "generate_land_water_mask";   /* function name */
+    char errmsg[STR_SIZE];            /* error message */
+    int i;                            /* looping variable */
+    int refl_indx = -9;               /* band index in XML file for the
+                                         representative reflectance band */
+
+    /* Use band 1 as the representative band in the XML */
+    for (i = 0; i < xml_meta->nbands; i++)
+    {
+        if (!strcmp (xml_meta->band[i].name, "band1"))
+        {
+            /* this is the index we'll use for reflectance band info */
+            refl_indx = i;
+            break;
+        }
+    }
+
+    /* Make sure the representative band was found in the XML file */
+    if (refl_indx == -9)
+    {
+        sprintf (errmsg, "Band 1 (band1) was not found in the XML file");
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+    *nlines = xml_meta->band[refl_indx].nlines;
+    *nsamps = xml_meta->band[refl_indx].nsamps;
+
+    /* Generate the mask as a window covering the full scene extent */
+    if (generate_land_water_mask_window (xml_meta, land_mass_polygon,
+        num_threads, 0, 0, *nlines, *nsamps, land_water_mask) != SUCCESS)
+    {   /* error message already printed */
+        return (ERROR);
+    }
+
+    return (SUCCESS);
+}
@@ -3,6 +3,7 @@
 
 /* ESPA Includes */
 #include "error_handler.h"
+#include "espa_dms.h"
 #include "espa_metadata.h"
 #include "espa_hdf_eos.h"
 
@@ -12,15 +13,12 @@
 
 #define NAME_STRLEN  256
 
-double deg_to_dms
-(
-    double flt_deg   /* I: input decimal degree value */
-);
-
 int generate_land_water_mask
 (
     Espa_internal_meta_t *xml_meta,   /* I: input XML metadata */
     const char land_mass_polygon[],   /* I: name of land mass polygon file */
+    int num_threads,                  /* I: number of threads to use (0 or
+                                            less chooses automatically) */
     unsigned char **land_water_mask,  /* O: pointer to land water mask buffer,
                                             memory is allocated and the
                                             mask is populated */
@@ -28,4 +26,21 @@ int generate_land_water_mask
     int *nsamps                       /* O: number of samples in the mask */
 );
 
+int generate_land_water_mask_window
+(
+    Espa_internal_meta_t *xml_meta,   /* I: input XML metadata */
+    const char land_mass_polygon[],   /* I: name of land mass polygon file */
+    int num_threads,                  /* I: number of threads to use (0 or
+                                            less chooses automatically) */
+    int start_line,                   /* I: starting line of the window in the
+                                            scene (0-based) */
+    int start_samp,                   /* I: starting sample of the window in
+                                            the scene (0-based) */
+    int window_nlines,                /* I: number of lines in the window */
+    int window_nsamps,                /* I: number of samples in the window */
+    unsigned char **land_water_mask   /* O: pointer to land water mask buffer
+                                            for the window, memory is allocated
+                                            and the mask is populated */
+);
+
 #endif
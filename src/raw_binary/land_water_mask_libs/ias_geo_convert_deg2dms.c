@@ -11,7 +11,8 @@ ERROR    Operation failed
 
 ALGORITHM DESCRIPTION:
         Receive an angle degrees
-        Convert it to DMS.
+        Convert it to DMS (in place) through the shared conversion core in
+          ias_geo_dms.h.
         The angle is then checked to be sure it is within the limits
           of its use (LAT, LON, or DEGREES).
 
@@ -19,23 +20,19 @@ ALGORITHM DESCRIPTION:
 #include <stdlib.h>
 #include <string.h>
 #include "ias_logging.h"
+#include "ias_geo_dms.h"
 #include "ias_lw_geo.h"
 
-int ias_geo_convert_deg2dms 
+int ias_geo_convert_deg2dms
 (
     double deg,         /* I: Angle in seconds, minutes, or degrees */
     double *dms,        /* O: Angle converted to DMS */
-    const char *check   /* I: Angle usage type (LAT, LON, or DEGREES) */ 
+    const char *check   /* I: Angle usage type (LAT, LON, or DEGREES) */
 )
 {
-    double tsec;    /* Total seconds in the input angle */
     double maxdms;  /* Upper bound of the angle value for its use */
     double mindms;  /* Lower bound of the angle value for its use */
 
-    int tdeg;      /* Degrees in the input angle */
-    int tmin;      /* Minutes in the input angle */
-    int sign;      /* Sign of the input angle */
-
     /* Find the upper and lower bound limits for the angle based on its
        usage type (LAT, LON, DEGREES).  */
     if (strcmp (check,"LAT") == 0)
@@ -55,20 +52,7 @@ int ias_geo_convert_deg2dms
     }
 
     /* Convert the angle to DMS based on the coform in degrees.  */
-
-    /* Extract the deg, min, and sec portions of the angle.  */
-    ias_geo_find_deg(deg, &tdeg);
-    ias_geo_find_min(deg, &tmin);
-    ias_geo_find_sec(deg, &tsec);
-
-    /* Find the sign of the angle based on the degrees.  */
-    sign = 1;
-    if (tdeg < 0)
-        sign = -1;
-
-    /* Calculate DMS from the degree, minutes, seconds values.  */
-    tdeg = abs (tdeg);
-    *dms = ((tdeg * 1000000) + (tmin * 1000) + tsec) * sign;
+    *dms = ias_geo_deg2dms_value (deg);
 
     /* Check to be sure the coordinate is within the bounds.  */
     if ((*dms > maxdms) || (*dms < mindms))
@@ -80,3 +64,65 @@ int ias_geo_convert_deg2dms
 
     return SUCCESS;
 }
+
+/****************************************************************************
+NAME: ias_geo_convert_deg2dms_array
+
+PURPOSE:  Convert an array of angles from total degrees to packed DMS,
+resolving the usage type bounds once for the whole batch instead of per
+angle.
+
+RETURN VALUE:   Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion
+ERROR    Operation failed
+
+*****************************************************************************/
+int ias_geo_convert_deg2dms_array
+(
+    const double *degs,  /* I: Angles in seconds, minutes, or degrees */
+    double *dms,         /* O: Angles converted to DMS */
+    int count,           /* I: Number of angles to convert */
+    const char *check    /* I: Angle usage type (LAT, LON, or DEGREES) */
+)
+{
+    double maxdms;  /* Upper bound of the angle values for their use */
+    double mindms;  /* Lower bound of the angle values for their use */
+    int index;      /* Angle index */
+
+    /* Find the upper and lower bound limits for the angles based on their
+       usage type (LAT, LON, DEGREES).  */
+    if (strcmp (check,"LAT") == 0)
+    {
+        maxdms = 90000000;
+        mindms = -90000000;
+    }
+    else if (strcmp (check,"LON") == 0)
+    {
+        maxdms = 180000000;
+        mindms = -180000000;
+    }
+    else
+    { /* DEGREES */
+        maxdms = 360000000;
+        mindms = 0;
+    }
+
+    /* Convert the angles to DMS based on the coform in degrees.  */
+    for (index = 0; index < count; index++)
+        dms[index] = ias_geo_deg2dms_value (degs[index]);
+
+    /* Check to be sure the coordinates are within the bounds.  */
+    for (index = 0; index < count; index++)
+    {
+        if ((dms[index] > maxdms) || (dms[index] < mindms))
+        {
+            IAS_LOG_ERROR("Calculated DMS value of %f outside bounds of %f "
+                "to %f", dms[index], mindms, maxdms);
+            return ERROR;
+        }
+    }
+
+    return SUCCESS;
+}
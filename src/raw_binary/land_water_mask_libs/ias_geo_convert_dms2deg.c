@@ -11,7 +11,8 @@ ERROR    Operation failed
 
 ALGORITHM DESCRIPTION:
         Receive an angle in DMS
-        Convert the angle to total degrees (in place).
+        Convert the angle to total degrees (in place) through the shared
+          conversion core in ias_geo_dms.h.
         The angle is then checked to be sure it is within the limits of
           its use (LAT, LON, or DEGREES).
 
@@ -19,26 +20,22 @@ ALGORITHM DESCRIPTION:
 #include <string.h>
 #include "ias_const.h"
 #include "ias_logging.h"
+#include "ias_geo_dms.h"
 #include "ias_lw_geo.h"
 
-int ias_geo_convert_dms2deg 
+int ias_geo_convert_dms2deg
 (
     double angle_dms,     /* I: Angle in DMS (DDDMMMSSS) format */
     double *angle_degrees,/* O: Angle in decimal degrees */
     const char *type      /* I: Angle usage type (LAT, LON, or DEGREES) */
 )
 {
-    float second;     /* Second of DMS angle value */
     float upper;      /* Upper bound of the angle value for its use */
     float lower;      /* Lower bound of the angle value for its use */
 
-    int  degree;      /* Degree of DMS angle value */
-    int  minute;      /* Minute of DMS angle value */
-    short sign;       /* Sign of the angle */
-
     /* Find the upper and lower bound limits for the angle based on its
        usage type.  */
-    if (strncmp (type,"LAT",3) == 0) 
+    if (strncmp (type,"LAT",3) == 0)
     { /* LAT */
         upper = 90.0;
         lower = -90.0;
@@ -55,19 +52,7 @@ int ias_geo_convert_dms2deg
     }
 
     /* Convert the angle to total degrees based on DMS.  */
-    if (angle_dms < 0)
-    {
-        sign = -1;
-        angle_dms = angle_dms * -1;
-    }
-    else
-        sign = 1;
-
-    degree = (int) (angle_dms / 1000000);
-    angle_dms = angle_dms - (degree * 1000000);
-    minute = (int) (angle_dms / 1000);
-    second = angle_dms - (minute * 1000);
-    *angle_degrees = sign * (degree + (minute/60.0) + (second/3600.0));
+    *angle_degrees = ias_geo_dms2deg_value (angle_dms);
 
     /* Check to make sure the angle is within the limits of its use (LAT, LON,
        or DEGREES) */
@@ -81,3 +66,66 @@ int ias_geo_convert_dms2deg
 
     return SUCCESS;
 }
+
+/****************************************************************************
+NAME: ias_geo_convert_dms2deg_array
+
+PURPOSE:  Convert an array of angles from DMS to total degrees, resolving
+the usage type bounds once for the whole batch instead of per angle.
+
+RETURN VALUE:   Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion
+ERROR    Operation failed
+
+*****************************************************************************/
+int ias_geo_convert_dms2deg_array
+(
+    const double *angles_dms, /* I: Angles in DMS (DDDMMMSSS) format */
+    double *angles_degrees,   /* O: Angles in decimal degrees */
+    int count,                /* I: Number of angles to convert */
+    const char *type          /* I: Angle usage type (LAT, LON, or DEGREES) */
+)
+{
+    float upper;      /* Upper bound of the angle values for their use */
+    float lower;      /* Lower bound of the angle values for their use */
+    int index;        /* Angle index */
+
+    /* Find the upper and lower bound limits for the angles based on their
+       usage type.  */
+    if (strncmp (type,"LAT",3) == 0)
+    { /* LAT */
+        upper = 90.0;
+        lower = -90.0;
+    } /* LAT */
+    else if (strncmp (type,"LON",3) == 0)
+    { /* LON */
+        upper = 180.0;
+        lower = -180.0;
+    } /* LON */
+    else
+    { /* DEGREES */
+        upper = 360.0;
+        lower = 0.0;
+    }
+
+    /* Convert the angles to total degrees based on DMS.  */
+    for (index = 0; index < count; index++)
+        angles_degrees[index] = ias_geo_dms2deg_value (angles_dms[index]);
+
+    /* Check to make sure the angles are within the limits of their use
+       (LAT, LON, or DEGREES) */
+    for (index = 0; index < count; index++)
+    {
+        if ((angles_degrees[index] > upper) || (angles_degrees[index] < lower))
+        {
+            IAS_LOG_ERROR("Illegal coordinate value in decdeg");
+            IAS_LOG_ERROR("Calculated angle of %f outside bounds of %f to %f",
+                angles_degrees[index], lower, upper);
+            return ERROR;
+        }
+    }
+
+    return SUCCESS;
+}
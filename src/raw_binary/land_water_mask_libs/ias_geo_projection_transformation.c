@@ -11,6 +11,7 @@ Notes:
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
+#include <pthread.h>
 #include "gctp.h"
 #include "ias_logging.h"
 #include "ias_lw_geo.h"
@@ -31,8 +32,89 @@ struct ias_geo_proj_transformation
                                    so they can be converted to degrees */
     int target_is_dms;          /* Flag to indicate the target units are DMS
                                    so they can be converted to degrees */
+    IAS_PROJECTION source_projection; /* Source projection the transformation
+                                   was created with (registry lookup key) */
+    IAS_PROJECTION target_projection; /* Target projection the transformation
+                                   was created with (registry lookup key) */
+    int reference_count;        /* Number of handles to this transformation
+                                   that are still outstanding, including the
+                                   reference held by the registry while the
+                                   transformation is cached there */
 };
 
+/* Number of entries in the registry of recently created transformations.
+   Callers (like the tiling pipeline) tend to repeatedly create the exact
+   same transformation (usually UTM <-> geographic), so a small registry of
+   shareable transformations avoids redoing the projection initialization
+   for every request.  The registry is protected by a mutex so it can be
+   used from threaded applications. */
+#define TRANSFORMATION_REGISTRY_SIZE 8
+
+/* Number of points staged per chunk by the batch coordinate transform.
+   The chunk buffer lives on the stack and the chunk is large enough to
+   amortize the per-call overhead of the GCTP batch interface. */
+#define TRANSFORM_BATCH_CHUNK 256
+
+static IAS_GEO_PROJ_TRANSFORMATION *registry[TRANSFORMATION_REGISTRY_SIZE];
+static unsigned long registry_last_use[TRANSFORMATION_REGISTRY_SIZE];
+                                /* Use counter snapshot per entry for LRU
+                                   eviction */
+static unsigned long registry_use_counter; /* Incremented on every registry
+                                   access to track the least recently used
+                                   entry */
+static pthread_mutex_t registry_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*****************************************************************************
+Name: projections_match
+
+Purpose: A helper routine to compare two IAS projection definitions for the
+    registry lookup.
+
+Returns: 1 if the projections match, 0 if they do not
+
+*****************************************************************************/
+static int projections_match
+(
+    const IAS_PROJECTION *proj1,    /* I: first projection to compare */
+    const IAS_PROJECTION *proj2     /* I: second projection to compare */
+)
+{
+    int i;
+
+    if (proj1->proj_code != proj2->proj_code
+        || proj1->zone != proj2->zone
+        || proj1->units != proj2->units
+        || proj1->spheroid != proj2->spheroid)
+        return 0;
+
+    for (i = 0; i < IAS_PROJ_PARAM_SIZE; i++)
+    {
+        if (proj1->parameters[i] != proj2->parameters[i])
+            return 0;
+    }
+
+    return 1;
+}
+
+/*****************************************************************************
+Name: free_proj_transformation
+
+Purpose: A helper routine to release the resources held by a projection
+    transformation once the last reference to it has been dropped.
+
+Returns: nothing
+
+*****************************************************************************/
+static void free_proj_transformation
+(
+    IAS_GEO_PROJ_TRANSFORMATION *trans
+)
+{
+    gctp_destroy_transformation(trans->gctp_transform);
+    trans->gctp_transform = NULL;
+    free(trans);
+}
+
 /*****************************************************************************
 Name: copy_ias_proj_to_gctp_proj
 
@@ -62,6 +144,128 @@ static void copy_ias_proj_to_gctp_proj
 
 }
 
+/*****************************************************************************
+Name: ias_geo_transform_coordinate_batch
+
+Purpose: Using a projection transformation, convert an array of input
+    coordinates from the source projection to the target projection.  The
+    points are pushed through the GCTP batch interface in chunks, so the
+    per-call validation and dispatch overhead is paid once per chunk
+    instead of once per point.  Points that fail to transform are recorded
+    in the caller's failure bitmap instead of aborting the batch, which is
+    what the parallel mask and geolocation callers need -- a few points
+    outside the projection's valid area should not kill the whole tile.
+
+Notes:
+    - The failure bitmap holds one bit per point, point index bit order,
+      and must be at least (count + 7) / 8 bytes.  It is cleared on entry.
+    - The output coordinates of a failed point are undefined.
+
+Returns: SUCCESS or ERROR (ERROR only for invalid arguments; per-point
+    failures are reported through the bitmap and count)
+
+*****************************************************************************/
+int ias_geo_transform_coordinate_batch
+(
+    const IAS_GEO_PROJ_TRANSFORMATION *trans, /* I: transformation to use */
+    int count,              /* I: number of coordinates to transform */
+    const double *inx,      /* I: array of count input X coordinates */
+    const double *iny,      /* I: array of count input Y coordinates */
+    double *outx,           /* O: array of count output X coordinates */
+    double *outy,           /* O: array of count output Y coordinates */
+    unsigned char *failed,  /* O: bitmap of count bits; a set bit flags a
+                                  point that failed to transform */
+    int *failed_count       /* O: number of points that failed */
+)
+{
+    int index;              /* point index */
+    int chunk_start;        /* first point of the current chunk */
+
+    /* Verify the arguments provided are valid */
+    if (trans == NULL || count < 0 || failed == NULL || failed_count == NULL)
+    {
+        IAS_LOG_ERROR("Invalid arguments provided");
+        return ERROR;
+    }
+
+    /* Clear the failure bitmap and count */
+    memset(failed, 0, (size_t)(count + 7) / 8);
+    *failed_count = 0;
+
+    /* The SOM coordinate swapping and DMS unit conversions are per-point
+       fixups that the batch packing below doesn't implement; those
+       projections aren't used by the batch callers, so just transform the
+       points one at a time, collecting the failures in the bitmap */
+    if (trans->source_is_som || trans->target_is_som
+        || trans->source_is_dms || trans->target_is_dms)
+    {
+        for (index = 0; index < count; index++)
+        {
+            if (ias_geo_transform_coordinate(trans, inx[index], iny[index],
+                &outx[index], &outy[index]) != SUCCESS)
+            {
+                failed[index / 8] |= (unsigned char)(1 << (index % 8));
+                (*failed_count)++;
+            }
+        }
+        return SUCCESS;
+    }
+
+    /* Transform the points in chunks through the GCTP batch interface,
+       staging the coordinates in the interleaved order GCTP expects */
+    for (chunk_start = 0; chunk_start < count;
+         chunk_start += TRANSFORM_BATCH_CHUNK)
+    {
+        double coor[TRANSFORM_BATCH_CHUNK * 2]; /* interleaved coordinates */
+        int chunk_count = count - chunk_start;  /* points in this chunk */
+        int chunk_index;                        /* point index in the chunk */
+
+        if (chunk_count > TRANSFORM_BATCH_CHUNK)
+            chunk_count = TRANSFORM_BATCH_CHUNK;
+
+        for (chunk_index = 0; chunk_index < chunk_count; chunk_index++)
+        {
+            coor[chunk_index * 2] = inx[chunk_start + chunk_index];
+            coor[chunk_index * 2 + 1] = iny[chunk_start + chunk_index];
+        }
+
+        if (gctp_transform_batch(trans->gctp_transform, chunk_count, coor,
+            coor) == GCTP_SUCCESS)
+        {
+            for (chunk_index = 0; chunk_index < chunk_count; chunk_index++)
+            {
+                outx[chunk_start + chunk_index] = coor[chunk_index * 2];
+                outy[chunk_start + chunk_index] = coor[chunk_index * 2 + 1];
+            }
+            continue;
+        }
+
+        /* The chunk failed somewhere; redo it one point at a time so only
+           the points that actually fail are flagged in the bitmap */
+        for (chunk_index = 0; chunk_index < chunk_count; chunk_index++)
+        {
+            double point[2];    /* single interleaved coordinate */
+
+            index = chunk_start + chunk_index;
+            point[0] = inx[index];
+            point[1] = iny[index];
+            if (gctp_transform(trans->gctp_transform, point, point)
+                == GCTP_SUCCESS)
+            {
+                outx[index] = point[0];
+                outy[index] = point[1];
+            }
+            else
+            {
+                failed[index / 8] |= (unsigned char)(1 << (index % 8));
+                (*failed_count)++;
+            }
+        }
+    }
+
+    return SUCCESS;
+}
+
 /*****************************************************************************
 Name: ias_geo_set_projection
 
@@ -136,6 +340,11 @@ static void gctp_message_callback
 Name: ias_geo_create_proj_transformation
 
 Purpose: Creates a projection transformation and returns it to the caller.
+    A registry of recently created transformations is kept since callers
+    commonly create the same transformation over and over.  If a matching
+    transformation is found in the registry it is shared with the caller
+    instead of initializing a new one.  The transformations are immutable
+    after creation, so sharing them is safe.
 
 Returns: A pointer to the created projection or NULL if there is an error.
 
@@ -150,8 +359,29 @@ IAS_GEO_PROJ_TRANSFORMATION *ias_geo_create_proj_transformation
     GCTP_TRANSFORMATION *gctp_trans;    /* associated GCTP projection */
     GCTP_PROJECTION source_proj;        /* source GCTP projection */
     GCTP_PROJECTION target_proj;        /* target GCTP projection */
+    int index;                          /* registry entry counter */
+    int empty_index;                    /* first empty registry slot */
+    int lru_index;                      /* least recently used registry slot */
+
+    /* Look for a matching transformation in the registry and share it if one
+       is found */
+    pthread_mutex_lock(&registry_lock);
+    for (index = 0; index < TRANSFORMATION_REGISTRY_SIZE; index++)
+    {
+        trans = registry[index];
+        if (trans
+            && projections_match(&trans->source_projection, source_projection)
+            && projections_match(&trans->target_projection, target_projection))
+        {
+            trans->reference_count++;
+            registry_last_use[index] = ++registry_use_counter;
+            pthread_mutex_unlock(&registry_lock);
+            return trans;
+        }
+    }
+    pthread_mutex_unlock(&registry_lock);
 
-    /* Redirect gctp output to our local callback so we can control the 
+    /* Redirect gctp output to our local callback so we can control the
        formatting.  Note that this will be set for every projection created,
        but it doesn't really matter since it will always be set to the same
        routine. */
@@ -214,14 +444,52 @@ IAS_GEO_PROJ_TRANSFORMATION *ias_geo_create_proj_transformation
     }
     trans->gctp_transform = gctp_trans;
 
+    /* Save the projections the transformation was created with so registry
+       lookups can match against them, and count the caller's reference */
+    trans->source_projection = *source_projection;
+    trans->target_projection = *target_projection;
+    trans->reference_count = 1;
+
+    /* Insert the new transformation into the registry, evicting the least
+       recently used entry if the registry is full */
+    pthread_mutex_lock(&registry_lock);
+    empty_index = -1;
+    lru_index = 0;
+    for (index = 0; index < TRANSFORMATION_REGISTRY_SIZE; index++)
+    {
+        if (!registry[index])
+        {
+            empty_index = index;
+            break;
+        }
+        if (registry_last_use[index] < registry_last_use[lru_index])
+            lru_index = index;
+    }
+    if (empty_index == -1)
+    {
+        /* Drop the registry's reference to the evicted transformation,
+           freeing it if no callers still hold a handle to it */
+        IAS_GEO_PROJ_TRANSFORMATION *evicted = registry[lru_index];
+
+        evicted->reference_count--;
+        if (evicted->reference_count == 0)
+            free_proj_transformation(evicted);
+        empty_index = lru_index;
+    }
+    trans->reference_count++;
+    registry[empty_index] = trans;
+    registry_last_use[empty_index] = ++registry_use_counter;
+    pthread_mutex_unlock(&registry_lock);
+
     return trans;
 }
 
 /*****************************************************************************
 Name: ias_geo_destroy_proj_transformation
 
-Purpose: Releases the resources allocated by the creation of a projection
-    transformation
+Purpose: Releases the caller's reference to a projection transformation.
+    Since transformations can be shared through the registry, the resources
+    are only released once the last reference is dropped.
 
 Returns: nothing
 
@@ -231,11 +499,17 @@ void ias_geo_destroy_proj_transformation
     IAS_GEO_PROJ_TRANSFORMATION *trans
 )
 {
+    int free_transformation;    /* flag indicating the last reference */
+
     if (trans)
     {
-        gctp_destroy_transformation(trans->gctp_transform);
-        trans->gctp_transform = NULL;
-        free(trans);
+        pthread_mutex_lock(&registry_lock);
+        trans->reference_count--;
+        free_transformation = (trans->reference_count == 0);
+        pthread_mutex_unlock(&registry_lock);
+
+        if (free_transformation)
+            free_proj_transformation(trans);
     }
 }
 
@@ -258,6 +532,29 @@ void ias_geo_only_allow_threadsafe_transforms()
     gctp_only_allow_threadsafe_transforms();
 }
 
+/****************************************************************************
+Name: ias_geo_transformation_is_threadsafe
+
+Purpose: Indicates whether a transformation can be used concurrently from
+    multiple threads.  The context-based transformations are immutable after
+    creation, so a single handle can be shared across threads; the
+    transformations falling back to the original gctp routine rely on global
+    state and must be used from a single thread.
+
+Returns: 1 if the transformation is threadsafe, 0 if it is not
+
+****************************************************************************/
+int ias_geo_transformation_is_threadsafe
+(
+    const IAS_GEO_PROJ_TRANSFORMATION *trans /* I: transformation to check */
+)
+{
+    if (trans == NULL || trans->gctp_transform == NULL)
+        return 0;
+
+    return gctp_transformation_is_threadsafe(trans->gctp_transform);
+}
+
 /*****************************************************************************
 Name: ias_geo_transform_coordinate
 
@@ -3,10 +3,22 @@
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
 
 /* IAS Library Includes */
 #include "ias_lw_geo.h"
 #include "ias_logging.h"
+#include "espa_thread_pool.h"
+
+/* Span of ring vertices awaiting a Douglas-Peucker split */
+typedef struct ring_span
+{
+    unsigned int first;         /* First vertex of the span */
+    unsigned int last;          /* Last vertex of the span */
+} RING_SPAN;
 
 /****************************************************************************
 NAME:  ias_geo_get_polygon_offsets
@@ -536,10 +548,89 @@ static int ias_geo_read_polygon
     return id;
 }
 
+/* Work shared by the parallel polygon load tasks */
+typedef struct polygon_load_context
+{
+    const unsigned char *file_buffer;   /* Mapped view of the whole file */
+    size_t file_size;                   /* Size of the mapped view */
+    const int64_t *offsets;             /* Offset of each selected parent */
+    IAS_POLYGON_LINKED_LIST **nodes;    /* Loaded parent per selected slot */
+} POLYGON_LOAD_CONTEXT;
+
+/*****************************************************************************
+NAME:  load_polygon_task
+
+PURPOSE:  Pool task that parses one selected parent polygon (and its
+          children) from the mapped file view through a private in-memory
+          stream, so the parents parse concurrently without sharing a file
+          position.
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion
+ERROR    Operation failed
+
+*****************************************************************************/
+static int load_polygon_task
+(
+    void *context_ptr,      /* I: Polygon load context */
+    int item                /* I: Selected parent slot to parse */
+)
+{
+    POLYGON_LOAD_CONTEXT *context = context_ptr; /* Load context */
+    IAS_POLYGON_LINKED_LIST *polygon;   /* Parsed parent polygon */
+    FILE *mem_fp;                       /* Private in-memory stream */
+
+    /* Open a private stream over the mapped file so the absolute record
+       offsets stay valid and no file position is shared between tasks */
+    mem_fp = fmemopen((void *)context->file_buffer, context->file_size, "rb");
+    if (!mem_fp)
+    {
+        IAS_LOG_ERROR("Opening an in-memory stream over the polygon file");
+        return ERROR;
+    }
+
+    if (fseeko(mem_fp, context->offsets[item], SEEK_SET) != 0)
+    {
+        IAS_LOG_ERROR("Seeking to the polygon record at offset %lld",
+            (long long)context->offsets[item]);
+        fclose(mem_fp);
+        return ERROR;
+    }
+
+    /* Allocate a node for the new polygon */
+    polygon = calloc(1, sizeof(*polygon));
+    if (!polygon)
+    {
+        IAS_LOG_ERROR("Allocating memory for linked list");
+        fclose(mem_fp);
+        return ERROR;
+    }
+
+    /* Read the polygon and its children */
+    if (ias_geo_read_polygon(mem_fp, polygon) < 1)
+    {
+        IAS_LOG_ERROR("Reading polygon record %d", item);
+        fclose(mem_fp);
+        return ERROR;
+    }
+
+    context->nodes[item] = polygon;
+    fclose(mem_fp);
+    return SUCCESS;
+}
+
 /*****************************************************************************
 NAME:  ias_geo_load_polygon
 
-PURPOSE:  Read the polygons in from a file in the parent/child structure. 
+PURPOSE:  Read the polygons in from a file in the parent/child structure.
+          The parent offset table indexes the record boundaries, so the
+          parents within the range of interest are parsed concurrently
+          across the worker pool from a mapped view of the file; when the
+          file cannot be mapped the records are parsed sequentially from
+          the stream as before.
 
 RETURN VALUE:
 Type = int
@@ -567,8 +658,14 @@ int ias_geo_load_polygon
     unsigned int i;                   /* Generic counter */
     int64_t *offset;                  /* Polygon offset in binary list */
     int error_occured = FALSE;        /* Error tracking flag */
+    int status;                       /* Pool run status */
+    unsigned int num_selected;        /* Parents within the range */
     IAS_DBL_XY *bb_max;               /* Bounding box max x/y values */
     IAS_DBL_XY *bb_min;               /* Bounding box min x/y values */
+    IAS_POLYGON_LINKED_LIST **nodes;  /* Loaded parent per selected slot */
+    POLYGON_LOAD_CONTEXT load_context; /* Context for the parallel load */
+    struct stat file_stat;            /* Size of the underlying file */
+    void *file_buffer = NULL;         /* Mapped view of the whole file */
 
     /* Assume no polygons will be read */
     *head = NULL;
@@ -705,49 +802,122 @@ int ias_geo_load_polygon
         return ERROR;
     }
 
-    /* Read the polygons within the range of interest. */
-    polygon = NULL;
+    /* Collect the parents within the range of interest; their offsets from
+       the table above are the record boundaries, so each one can be parsed
+       independently */
+    num_selected = 0;
     for (i = 0; i < nparent_polygons; i++)
     {
         if (bb_min[i].x > max_x || bb_max[i].x < min_x ||
             bb_min[i].y > max_y || bb_max[i].y < min_y)
             continue;
 
-        if (fseeko(fp, offset[i], SEEK_SET) != 0)
+        offset[num_selected] = offset[i];
+        num_selected++;
+    }
+
+    /* Map the file so the selected parents can be parsed concurrently from
+       private in-memory streams; the absolute record offsets stay valid
+       since the view covers the whole file */
+    if (num_selected > 1 && espa_pool_max_threads() > 1
+        && fstat(fileno(fp), &file_stat) == 0 && file_stat.st_size > 0)
+    {
+        file_buffer = mmap(NULL, file_stat.st_size, PROT_READ, MAP_PRIVATE,
+            fileno(fp), 0);
+        if (file_buffer == MAP_FAILED)
+            file_buffer = NULL;
+    }
+
+    nodes = calloc(num_selected > 0 ? num_selected : 1,
+        sizeof(IAS_POLYGON_LINKED_LIST *));
+    if (!nodes)
+    {
+        IAS_LOG_ERROR("Allocating space for the loaded parent polygons");
+        if (file_buffer)
+            munmap(file_buffer, file_stat.st_size);
+        free(offset);
+        free(bb_min);
+        free(bb_max);
+        return ERROR;
+    }
+
+    if (file_buffer)
+    {
+        /* Parse the selected parents across the worker pool */
+        load_context.file_buffer = file_buffer;
+        load_context.file_size = file_stat.st_size;
+        load_context.offsets = offset;
+        load_context.nodes = nodes;
+        status = espa_pool_run(load_polygon_task, &load_context,
+            (int)num_selected, espa_pool_max_threads());
+        munmap(file_buffer, file_stat.st_size);
+        if (status != SUCCESS)
         {
-            IAS_LOG_ERROR("Using fseek to set the position in file pointer");
-            ias_geo_free_polygon_linked_list(*head);
-            *head = NULL;
+            IAS_LOG_ERROR("Reading polygons");
+            for (i = 0; i < num_selected; i++)
+            {
+                if (nodes[i])
+                    ias_geo_free_polygon_linked_list(nodes[i]);
+            }
+            free(nodes);
             free(offset);
             free(bb_min);
             free(bb_max);
             return ERROR;
         }
-
-        /* Allocate a node for the new polygon */
-        polygon = calloc(1, sizeof(IAS_POLYGON_LINKED_LIST));
-        if (polygon == NULL)
+    }
+    else
+    {
+        /* Parse the selected parents sequentially from the stream */
+        for (i = 0; i < num_selected; i++)
         {
-            IAS_LOG_ERROR("Allocating memory for linked list");
-            ias_geo_free_polygon_linked_list(*head);
-            *head = NULL;
-            free(offset);
-            free(bb_min);
-            free(bb_max);
-            return ERROR;
+            if (fseeko(fp, offset[i], SEEK_SET) != 0)
+            {
+                IAS_LOG_ERROR("Using fseek to set the position in file "
+                    "pointer");
+                error_occured = TRUE;
+                break;
+            }
+
+            /* Allocate a node for the new polygon */
+            polygon = calloc(1, sizeof(IAS_POLYGON_LINKED_LIST));
+            if (polygon == NULL)
+            {
+                IAS_LOG_ERROR("Allocating memory for linked list");
+                error_occured = TRUE;
+                break;
+            }
+
+            /* Read the polygon and its children */
+            if (ias_geo_read_polygon(fp, polygon) < 1)
+            {
+                IAS_LOG_ERROR("Reading polygons");
+                error_occured = TRUE;
+                break;
+            }
+
+            nodes[i] = polygon;
         }
 
-        /* Read the polygon and its children */
-        if (ias_geo_read_polygon(fp, polygon) < 1)
+        if (error_occured)
         {
-            IAS_LOG_ERROR("Reading polygons");
-            ias_geo_free_polygon_linked_list(*head);
-            *head = NULL;
+            for (i = 0; i < num_selected; i++)
+            {
+                if (nodes[i])
+                    ias_geo_free_polygon_linked_list(nodes[i]);
+            }
+            free(nodes);
             free(offset);
             free(bb_min);
             free(bb_max);
             return ERROR;
         }
+    }
+
+    /* Link the loaded parents into the list in their table order */
+    for (i = 0; i < num_selected; i++)
+    {
+        polygon = nodes[i];
 
         /* If this is the first polygon read, make it the list head */
         if (!*head)
@@ -761,9 +931,9 @@ int ias_geo_load_polygon
         }
         /* This polygon is now the tail */
         list_tail = polygon;
-
     }
 
+    free(nodes);
     free(offset);
     free(bb_min);
     free(bb_max);
@@ -771,6 +941,134 @@ int ias_geo_load_polygon
     return SUCCESS;
 }
 
+/****************************************************************************
+NAME:  count_polygon_points
+
+PURPOSE:  Count the total number of vertices held by a polygon list,
+          including the children.
+
+RETURN VALUE:
+Type = int64_t
+Value is the total number of vertices in the list
+
+*****************************************************************************/
+static int64_t count_polygon_points
+(
+    const IAS_POLYGON_LINKED_LIST *polygon  /* I: First polygon in list */
+)
+{
+    int64_t total_points = 0;   /* Running vertex count */
+
+    while (polygon)
+    {
+        total_points += polygon->num_points;
+
+        if (polygon->child)
+            total_points += count_polygon_points(polygon->child);
+
+        polygon = polygon->next;
+    }
+
+    return total_points;
+}
+
+/****************************************************************************
+NAME:  pack_polygon_points
+
+PURPOSE:  Copy the vertices of a polygon list, including the children, into
+          the packed vertex buffer and point the polygon nodes at their
+          ranges of the buffer.  The separately allocated per-polygon arrays
+          are freed as they are copied.
+
+RETURN VALUE:
+Type = int64_t
+Value is the updated vertex offset into the packed buffer
+
+*****************************************************************************/
+static int64_t pack_polygon_points
+(
+    IAS_POLYGON_LINKED_LIST *polygon,   /* I/O: First polygon in list */
+    double *point_buffer,               /* I/O: Packed vertex buffer */
+    int64_t total_points,               /* I: Total vertices in the buffer */
+    int64_t offset                      /* I: Next free vertex offset */
+)
+{
+    while (polygon)
+    {
+        /* Copy the vertices into the x and y halves of the buffer and
+           release the old per-polygon arrays */
+        memcpy(&point_buffer[offset], polygon->point_x,
+            polygon->num_points * sizeof(double));
+        memcpy(&point_buffer[total_points + offset], polygon->point_y,
+            polygon->num_points * sizeof(double));
+        free(polygon->point_x);
+        free(polygon->point_y);
+        polygon->point_x = &point_buffer[offset];
+        polygon->point_y = &point_buffer[total_points + offset];
+        polygon->points_packed = 1;
+        offset += polygon->num_points;
+
+        if (polygon->child)
+        {
+            offset = pack_polygon_points(polygon->child, point_buffer,
+                total_points, offset);
+        }
+
+        polygon = polygon->next;
+    }
+
+    return offset;
+}
+
+/*****************************************************************************
+NAME:  ias_geo_pack_polygon_points
+
+PURPOSE:  Repack the separately allocated per-polygon vertex arrays into one
+          contiguous buffer, with all the x values followed by all the y
+          values.  The polygon nodes are updated to point into the buffer, so
+          walking the vertices of a polygon no longer chases pointers across
+          the heap.  The buffer is returned to the caller, who must free it
+          after freeing the polygon list.
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion
+ERROR    Operation failed
+
+*****************************************************************************/
+int ias_geo_pack_polygon_points
+(
+    IAS_POLYGON_LINKED_LIST *polygon_list,  /* I/O: First polygon in list */
+    double **point_buffer   /* O: Packed vertex buffer to free after the
+                                  polygon list is freed */
+)
+{
+    int64_t total_points;   /* Total vertices in the list */
+
+    /* Nothing to pack for an empty list */
+    total_points = count_polygon_points(polygon_list);
+    if (total_points == 0)
+    {
+        *point_buffer = NULL;
+        return SUCCESS;
+    }
+
+    /* Allocate one buffer holding the x values followed by the y values */
+    *point_buffer = malloc(2 * total_points * sizeof(double));
+    if (*point_buffer == NULL)
+    {
+        IAS_LOG_ERROR("Allocating memory for the packed vertex buffer");
+        return ERROR;
+    }
+
+    /* Move the vertices into the buffer */
+    pack_polygon_points(polygon_list, *point_buffer, total_points, 0);
+
+    return SUCCESS;
+}
+
 /*****************************************************************************
 NAME:  ias_geo_free_polygon_linked_list
 
@@ -793,12 +1091,14 @@ void ias_geo_free_polygon_linked_list
 
     while (polygon)
     {
-        if (polygon->point_x)
+        /* Packed vertex arrays point into a shared buffer owned by the
+           caller, so only free the separately allocated arrays */
+        if (polygon->point_x && !polygon->points_packed)
         {
             free(polygon->point_x);
         }
 
-        if (polygon->point_y)
+        if (polygon->point_y && !polygon->points_packed)
         {
             free(polygon->point_y);
         }
@@ -815,105 +1115,1515 @@ void ias_geo_free_polygon_linked_list
     }
 }
 
-/*****************************************************************************
-NAME:  ias_geo_reduce_polygon
+/****************************************************************************
+NAME:  count_cache_sizes
 
-PURPOSE: Discard polygons outside a specified bounding box.
+PURPOSE:  Count the polygon entries, vertices, and segments held by a
+          polygon list, including the children.
 
 RETURN VALUE:
-Type = int
-Value    Description
------    -----------
-SUCCESS  Successful completion
-ERROR    Operation failed
+Type = void
 
 *****************************************************************************/
-int ias_geo_reduce_polygon
+static void count_cache_sizes
 (
-    IAS_POLYGON_LINKED_LIST **polygon_list, /* I/O: First polygon in list */
-    double upper_left_x,                    /* I: Upper left x */
-    double lower_right_x,                   /* I: Lower right x */
-    double upper_left_y,                    /* I: Upper left y */
-    double lower_right_y                    /* I: Lower right y */
+    const IAS_POLYGON_LINKED_LIST *polygon, /* I: First polygon in list */
+    unsigned int *num_polygons,             /* I/O: Running polygon count */
+    int64_t *total_points,                  /* I/O: Running vertex count */
+    int64_t *total_segs                     /* I/O: Running segment count */
 )
 {
-    IAS_POLYGON_LINKED_LIST *polygon;/* Current polygon list pointer */
-    IAS_POLYGON_LINKED_LIST *next;   /* Next polygon list pointer */
-    unsigned int x_crossing;         /* Flag indicating whether a horizontal
-                                        domain boundary is crossed; this is
-                                        usually associated with +/-180 degree
-                                        longitude boundaries */
-
-    if (upper_left_x > lower_right_x)
+    while (polygon)
     {
-        IAS_LOG_ERROR(
-            "Upper left longitude greater than lower right longitude");
-        return ERROR;
-    }
+        (*num_polygons)++;
+        *total_points += polygon->num_points;
+        *total_segs += polygon->num_segs;
 
-    if (upper_left_y < lower_right_y)
-    {
-        IAS_LOG_ERROR("Upper left latitude less than lower right latitude");
-        return ERROR;
-    }
+        if (polygon->child)
+        {
+            count_cache_sizes(polygon->child, num_polygons, total_points,
+                total_segs);
+        }
 
-    /* Set the boundary crossing flag. */
-    if (lower_right_x >= upper_left_x)
-    {
-        x_crossing = 0;
-    }
-    else
-    {
-        x_crossing = 1;
+        polygon = polygon->next;
     }
+}
 
-    polygon = *polygon_list;
+/****************************************************************************
+NAME:  write_cache_entries
+
+PURPOSE:  Write the cache entry table for a polygon list in preorder,
+          assigning the vertex and segment offsets as it goes.
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion
+ERROR    Operation failed
+
+*****************************************************************************/
+static int write_cache_entries
+(
+    FILE *fp,                               /* I: Cache file to write */
+    const IAS_POLYGON_LINKED_LIST *polygon, /* I: First polygon in list */
+    int parent_index,                       /* I: Entry index of the parent
+                                                  polygon, or -1 */
+    int *next_index,                        /* I/O: Next entry index */
+    int64_t *point_offset,                  /* I/O: Next vertex offset */
+    int64_t *seg_offset                     /* I/O: Next segment offset */
+)
+{
     while (polygon)
     {
-        /* Remove unnecessary children. */
-        if (polygon->child)
+        IAS_POLYGON_CACHE_ENTRY entry;  /* Entry being written */
+        int entry_index = *next_index;  /* Entry index of this polygon */
+
+        memset(&entry, 0, sizeof(entry));
+        entry.id = polygon->id;
+        entry.num_points = polygon->num_points;
+        entry.point_offset = *point_offset;
+        entry.num_segs = polygon->num_segs;
+        entry.parent_index = parent_index;
+        entry.seg_offset = *seg_offset;
+        entry.min_x = polygon->min_x;
+        entry.max_x = polygon->max_x;
+        entry.min_y = polygon->min_y;
+        entry.max_y = polygon->max_y;
+
+        if (fwrite(&entry, sizeof(entry), 1, fp) != 1)
         {
-            ias_geo_reduce_polygon(&polygon->child, 
-                upper_left_x, lower_right_x, upper_left_y, lower_right_y);
+            IAS_LOG_ERROR("Writing cache entry for polygon id %d",
+                polygon->id);
+            return ERROR;
         }
 
-        /* Keep track of next polygon */
-        next = polygon->next;
+        (*next_index)++;
+        *point_offset += polygon->num_points;
+        *seg_offset += polygon->num_segs;
 
-        /* Check if polygon is outside the bounding box */
-        if (polygon->min_y > upper_left_y || polygon->max_y < lower_right_y 
-            || (!x_crossing && (polygon->min_x > lower_right_x || polygon->max_x
-            < upper_left_x)) || (x_crossing && (polygon->min_x > lower_right_x 
-            && polygon->max_x < upper_left_x)))
+        if (polygon->child)
         {
-            /* Check if the current polygon is the head of the list */
-            if (polygon != *polygon_list)
-            {
-                /* Polygon is not the head of the list reset the links so 
-                   the list isn't broken */
-                polygon->prev->next = next;
-                if (next != NULL)
-                {
-                    next->prev = polygon->prev;
-                }
-            }
-            else
+            if (write_cache_entries(fp, polygon->child, entry_index,
+                next_index, point_offset, seg_offset) != SUCCESS)
             {
-                /* Polygon is the head of the list so change the head of the
-                   list to the next polygon */
-                *polygon_list = next;
-                if (next != NULL)
-                {
-                    next->prev = NULL;
-                }
+                return ERROR;
             }
-
-            /* Free up the polygon */
-            polygon->next = NULL;
-            ias_geo_free_polygon_linked_list(polygon);
         }
 
-        polygon = next;
+        polygon = polygon->next;
     }
+
+    return SUCCESS;
+}
+
+/****************************************************************************
+NAME:  write_cache_values
+
+PURPOSE:  Write one packed value array for a polygon list in preorder.  The
+          member offset selects the per-polygon array to pack so the same
+          preorder walk lays out the x values, the y values, and the
+          segments.
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion
+ERROR    Operation failed
+
+*****************************************************************************/
+static int write_cache_values
+(
+    FILE *fp,                               /* I: Cache file to write */
+    const IAS_POLYGON_LINKED_LIST *polygon, /* I: First polygon in list */
+    int value_select  /* I: 0 = x vertices, 1 = y vertices, 2 = segments */
+)
+{
+    while (polygon)
+    {
+        const void *values;     /* Array being written */
+        size_t value_size;      /* Size of one array element */
+        size_t count;           /* Number of array elements */
+
+        if (value_select == 0)
+        {
+            values = polygon->point_x;
+            value_size = sizeof(double);
+            count = polygon->num_points;
+        }
+        else if (value_select == 1)
+        {
+            values = polygon->point_y;
+            value_size = sizeof(double);
+            count = polygon->num_points;
+        }
+        else
+        {
+            values = polygon->poly_seg;
+            value_size = sizeof(IAS_POLYGON_SEGMENT);
+            count = polygon->num_segs;
+        }
+
+        if (count > 0 && fwrite(values, value_size, count, fp) != count)
+        {
+            IAS_LOG_ERROR("Writing cache values for polygon id %d",
+                polygon->id);
+            return ERROR;
+        }
+
+        if (polygon->child)
+        {
+            if (write_cache_values(fp, polygon->child, value_select)
+                != SUCCESS)
+            {
+                return ERROR;
+            }
+        }
+
+        polygon = polygon->next;
+    }
+
+    return SUCCESS;
+}
+
+/****************************************************************************
+NAME:  copy_polygon_list
+
+PURPOSE:  Deep copy a polygon list, including the children, into freshly
+          allocated nodes and vertex arrays.  The segment groups are not
+          copied since the copies exist to be simplified and simplification
+          invalidates the segment vertex indices.
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion
+ERROR    Operation failed
+
+*****************************************************************************/
+static int copy_polygon_list
+(
+    const IAS_POLYGON_LINKED_LIST *polygon_list, /* I: First polygon in
+                                                       list */
+    IAS_POLYGON_LINKED_LIST **copy  /* O: Deep copy of the list */
+)
+{
+    const IAS_POLYGON_LINKED_LIST *polygon; /* Current source polygon */
+    IAS_POLYGON_LINKED_LIST *node;          /* Copy of the current polygon */
+    IAS_POLYGON_LINKED_LIST *tail = NULL;   /* Tail of the copied list */
+
+    *copy = NULL;
+
+    for (polygon = polygon_list; polygon; polygon = polygon->next)
+    {
+        node = calloc(1, sizeof(*node));
+        if (node == NULL)
+        {
+            IAS_LOG_ERROR("Allocating memory for the polygon copy");
+            ias_geo_free_polygon_linked_list(*copy);
+            *copy = NULL;
+            return ERROR;
+        }
+
+        node->id = polygon->id;
+        node->num_points = polygon->num_points;
+        node->min_x = polygon->min_x;
+        node->max_x = polygon->max_x;
+        node->min_y = polygon->min_y;
+        node->max_y = polygon->max_y;
+
+        node->point_x = malloc(polygon->num_points
+            * sizeof(*node->point_x));
+        node->point_y = malloc(polygon->num_points
+            * sizeof(*node->point_y));
+        if (node->point_x == NULL || node->point_y == NULL)
+        {
+            IAS_LOG_ERROR("Allocating memory for the copied vertices");
+            free(node->point_x);
+            free(node->point_y);
+            free(node);
+            ias_geo_free_polygon_linked_list(*copy);
+            *copy = NULL;
+            return ERROR;
+        }
+        memcpy(node->point_x, polygon->point_x,
+            polygon->num_points * sizeof(*node->point_x));
+        memcpy(node->point_y, polygon->point_y,
+            polygon->num_points * sizeof(*node->point_y));
+
+        if (polygon->child
+            && copy_polygon_list(polygon->child, &node->child) != SUCCESS)
+        {
+            ias_geo_free_polygon_linked_list(node);
+            ias_geo_free_polygon_linked_list(*copy);
+            *copy = NULL;
+            return ERROR;
+        }
+
+        /* Add the copy to the tail of the output list */
+        if (tail)
+        {
+            tail->next = node;
+            node->prev = tail;
+        }
+        else
+        {
+            *copy = node;
+        }
+        tail = node;
+    }
+
+    return SUCCESS;
+}
+
+/****************************************************************************
+NAME:  free_polygon_levels
+
+PURPOSE:  Free the simplified polygon list copies built for the cache
+          levels.
+
+RETURN VALUE:
+Type = void
+
+*****************************************************************************/
+static void free_polygon_levels
+(
+    IAS_POLYGON_LINKED_LIST **copies,   /* I/O: Simplified list copies */
+    int num_levels                      /* I: Number of level slots */
+)
+{
+    int level;                          /* Level counter */
+
+    for (level = 0; level < num_levels; level++)
+    {
+        ias_geo_free_polygon_linked_list(copies[level]);
+        copies[level] = NULL;
+    }
+}
+
+/*****************************************************************************
+NAME:  coverage_set_bit
+
+PURPOSE:  Set the bit of one 1-degree cell in a coverage bitmap.
+
+RETURN VALUE:
+Type = void
+
+*****************************************************************************/
+static void coverage_set_bit
+(
+    unsigned char *bitmap,      /* I/O: Coverage bitmap */
+    int lon_cell,               /* I: Longitude cell index */
+    int lat_cell                /* I: Latitude cell index */
+)
+{
+    int cell = lat_cell * IAS_POLYGON_CACHE_COVERAGE_LON_CELLS + lon_cell;
+
+    bitmap[cell / 8] |= (unsigned char)(1 << (cell % 8));
+}
+
+/*****************************************************************************
+NAME:  coverage_bit_is_set
+
+PURPOSE:  Test the bit of one 1-degree cell in a coverage bitmap.
+
+RETURN VALUE:
+Type = int (non-zero when the cell's bit is set)
+
+*****************************************************************************/
+static int coverage_bit_is_set
+(
+    const unsigned char *bitmap,/* I: Coverage bitmap */
+    int lon_cell,               /* I: Longitude cell index */
+    int lat_cell                /* I: Latitude cell index */
+)
+{
+    int cell = lat_cell * IAS_POLYGON_CACHE_COVERAGE_LON_CELLS + lon_cell;
+
+    return bitmap[cell / 8] & (1 << (cell % 8));
+}
+
+/*****************************************************************************
+NAME:  coverage_lon_cell
+
+PURPOSE:  Convert a longitude in degrees to a coverage cell index, clamped
+          to the grid.
+
+RETURN VALUE:
+Type = int (cell index in [0, IAS_POLYGON_CACHE_COVERAGE_LON_CELLS))
+
+*****************************************************************************/
+static int coverage_lon_cell
+(
+    double longitude            /* I: Longitude in degrees */
+)
+{
+    int cell = (int)floor(longitude) + 180;
+
+    if (cell < 0)
+        cell = 0;
+    if (cell > IAS_POLYGON_CACHE_COVERAGE_LON_CELLS - 1)
+        cell = IAS_POLYGON_CACHE_COVERAGE_LON_CELLS - 1;
+    return cell;
+}
+
+/*****************************************************************************
+NAME:  coverage_lat_cell
+
+PURPOSE:  Convert a latitude in degrees to a coverage cell index, clamped
+          to the grid.
+
+RETURN VALUE:
+Type = int (cell index in [0, IAS_POLYGON_CACHE_COVERAGE_LAT_CELLS))
+
+*****************************************************************************/
+static int coverage_lat_cell
+(
+    double latitude             /* I: Latitude in degrees */
+)
+{
+    int cell = (int)floor(latitude) + 90;
+
+    if (cell < 0)
+        cell = 0;
+    if (cell > IAS_POLYGON_CACHE_COVERAGE_LAT_CELLS - 1)
+        cell = IAS_POLYGON_CACHE_COVERAGE_LAT_CELLS - 1;
+    return cell;
+}
+
+/*****************************************************************************
+NAME:  mark_coverage_boundary
+
+PURPOSE:  Mark every 1-degree cell that a polygon edge may pass through.
+          Each edge marks the cells its bounding box overlaps, which is a
+          conservative superset of the cells the edge actually crosses.
+
+RETURN VALUE:
+Type = void
+
+*****************************************************************************/
+static void mark_coverage_boundary
+(
+    const IAS_POLYGON_LINKED_LIST *polygon, /* I: First polygon in list */
+    unsigned char *boundary     /* I/O: Boundary cell bitmap */
+)
+{
+    while (polygon)
+    {
+        unsigned int point;     /* Vertex counter */
+
+        for (point = 0; point + 1 < polygon->num_points; point++)
+        {
+            double x0 = polygon->point_x[point];
+            double x1 = polygon->point_x[point + 1];
+            double y0 = polygon->point_y[point];
+            double y1 = polygon->point_y[point + 1];
+            int lon_start = coverage_lon_cell(x0 < x1 ? x0 : x1);
+            int lon_end = coverage_lon_cell(x0 < x1 ? x1 : x0);
+            int lat_start = coverage_lat_cell(y0 < y1 ? y0 : y1);
+            int lat_end = coverage_lat_cell(y0 < y1 ? y1 : y0);
+            int lon_cell;       /* Longitude cell counter */
+            int lat_cell;       /* Latitude cell counter */
+
+            for (lat_cell = lat_start; lat_cell <= lat_end; lat_cell++)
+                for (lon_cell = lon_start; lon_cell <= lon_end; lon_cell++)
+                    coverage_set_bit(boundary, lon_cell, lat_cell);
+        }
+
+        if (polygon->child)
+            mark_coverage_boundary(polygon->child, boundary);
+        polygon = polygon->next;
+    }
+}
+
+/*****************************************************************************
+NAME:  collect_coverage_crossings
+
+PURPOSE:  Collect the longitudes where the polygon edges cross a latitude
+          line, growing the crossing array as needed.  Every ring of the
+          hierarchy contributes, so the even-odd parity of the crossings
+          west of a point classifies it with holes handled correctly.
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion
+ERROR    Operation failed
+
+*****************************************************************************/
+static int collect_coverage_crossings
+(
+    const IAS_POLYGON_LINKED_LIST *polygon, /* I: First polygon in list */
+    double latitude,            /* I: Latitude of the scanline */
+    double **crossings,         /* I/O: Crossing longitude array */
+    int *num_crossings,         /* I/O: Number of crossings collected */
+    int *capacity               /* I/O: Allocated size of the array */
+)
+{
+    while (polygon)
+    {
+        unsigned int point;     /* Vertex counter */
+
+        for (point = 0; point + 1 < polygon->num_points; point++)
+        {
+            double y0 = polygon->point_y[point];
+            double y1 = polygon->point_y[point + 1];
+
+            if ((y0 <= latitude) == (y1 <= latitude))
+                continue;
+
+            if (*num_crossings == *capacity)
+            {
+                int new_capacity = *capacity == 0 ? 256 : *capacity * 2;
+                double *new_crossings = realloc(*crossings,
+                    new_capacity * sizeof(*new_crossings));
+
+                if (!new_crossings)
+                {
+                    IAS_LOG_ERROR("Allocating memory for coverage "
+                        "crossings");
+                    return ERROR;
+                }
+                *crossings = new_crossings;
+                *capacity = new_capacity;
+            }
+
+            (*crossings)[(*num_crossings)++] = polygon->point_x[point]
+                + (polygon->point_x[point + 1] - polygon->point_x[point])
+                * (latitude - y0) / (y1 - y0);
+        }
+
+        if (polygon->child
+            && collect_coverage_crossings(polygon->child, latitude,
+                crossings, num_crossings, capacity) != SUCCESS)
+        {
+            return ERROR;
+        }
+        polygon = polygon->next;
+    }
+
+    return SUCCESS;
+}
+
+/*****************************************************************************
+NAME:  compare_coverage_crossings
+
+PURPOSE:  qsort comparison routine to sort crossing longitudes.
+
+RETURN VALUE:
+Type = int (negative, zero, positive for less, equal, greater)
+
+*****************************************************************************/
+static int compare_coverage_crossings
+(
+    const void *first,          /* I: First crossing to compare */
+    const void *second          /* I: Second crossing to compare */
+)
+{
+    double difference = *(const double *)first - *(const double *)second;
+
+    if (difference < 0.0)
+        return -1;
+    else if (difference > 0.0)
+        return 1;
+    return 0;
+}
+
+/*****************************************************************************
+NAME:  build_cache_coverage
+
+PURPOSE:  Build the 1-degree coverage summary bitmaps for the cache header.
+          Cells touched by a polygon edge are conservatively flagged as
+          possibly containing land; the remaining cells are uniform, so one
+          even-odd parity test of the cell center per scanline classifies
+          them as entirely land or entirely water.
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion
+ERROR    Operation failed
+
+*****************************************************************************/
+static int build_cache_coverage
+(
+    const IAS_POLYGON_LINKED_LIST *polygon_list, /* I: First polygon in list */
+    IAS_POLYGON_CACHE_HEADER *header    /* I/O: Header holding the zeroed
+                                               coverage bitmaps to fill */
+)
+{
+    unsigned char *boundary;    /* Bitmap of cells touched by an edge */
+    double *crossings = NULL;   /* Scanline crossing scratch array */
+    int capacity = 0;           /* Allocated size of the crossing array */
+    int lat_cell;               /* Latitude cell counter */
+
+    boundary = calloc(IAS_POLYGON_CACHE_COVERAGE_BYTES, 1);
+    if (!boundary)
+    {
+        IAS_LOG_ERROR("Allocating memory for the coverage boundary bitmap");
+        return ERROR;
+    }
+
+    mark_coverage_boundary(polygon_list, boundary);
+
+    for (lat_cell = 0; lat_cell < IAS_POLYGON_CACHE_COVERAGE_LAT_CELLS;
+         lat_cell++)
+    {
+        double latitude = lat_cell - 90 + 0.5;  /* Cell center latitude */
+        int num_crossings = 0;  /* Crossings on this scanline */
+        int crossing = 0;       /* Crossings passed walking east */
+        int lon_cell;           /* Longitude cell counter */
+
+        if (collect_coverage_crossings(polygon_list, latitude, &crossings,
+            &num_crossings, &capacity) != SUCCESS)
+        {
+            free(crossings);
+            free(boundary);
+            return ERROR;
+        }
+        qsort(crossings, num_crossings, sizeof(*crossings),
+            compare_coverage_crossings);
+
+        for (lon_cell = 0; lon_cell < IAS_POLYGON_CACHE_COVERAGE_LON_CELLS;
+             lon_cell++)
+        {
+            double longitude = lon_cell - 180 + 0.5; /* Cell center */
+
+            while (crossing < num_crossings
+                   && crossings[crossing] <= longitude)
+                crossing++;
+
+            if (coverage_bit_is_set(boundary, lon_cell, lat_cell))
+            {
+                /* The cell holds a piece of coastline, so it may contain
+                   land but is not entirely land */
+                coverage_set_bit(header->any_land, lon_cell, lat_cell);
+            }
+            else if (crossing % 2 == 1)
+            {
+                /* No edge touches the cell and its center is inside the
+                   polygons, so the whole cell is land */
+                coverage_set_bit(header->any_land, lon_cell, lat_cell);
+                coverage_set_bit(header->all_land, lon_cell, lat_cell);
+            }
+        }
+    }
+
+    free(crossings);
+    free(boundary);
+    return SUCCESS;
+}
+
+/*****************************************************************************
+NAME:  ias_geo_write_polygon_cache
+
+PURPOSE:  Write a polygon list out as a preprocessed cache file that can be
+          memory mapped directly by ias_geo_load_polygon_cache.  The file
+          holds a versioned header, one polygon entry table per
+          simplification level, and the packed vertex and segment arrays, so
+          loading it requires no parsing and the mapped pages are shared
+          between processes.  The header also carries a 1-degree coverage
+          summary of the dataset so scene-overlap pre-tests can skip the
+          polygons entirely.  Level 0 is the caller's full resolution list;
+          each further level is a Douglas-Peucker simplification of the
+          level above it, so the loader can pick the vertex density matching
+          the output resolution.
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion
+ERROR    Operation failed
+
+*****************************************************************************/
+int ias_geo_write_polygon_cache
+(
+    const IAS_POLYGON_LINKED_LIST *polygon_list, /* I: First polygon in list */
+    FILE *fp                        /* I: Cache file to write */
+)
+{
+    /* Simplification tolerance of each pyramid level in the polygon
+       coordinate units (degrees for the land-mass polygons); level 0 is the
+       full resolution list */
+    static const double level_tolerance[] = { 0.0, 0.0001, 0.001, 0.01 };
+    const int num_levels
+        = sizeof(level_tolerance) / sizeof(*level_tolerance);
+
+    IAS_POLYGON_CACHE_HEADER header;    /* Cache file header */
+    const IAS_POLYGON_LINKED_LIST *levels[IAS_POLYGON_CACHE_MAX_LEVELS];
+                                        /* Polygon list of each level */
+    IAS_POLYGON_LINKED_LIST *copies[IAS_POLYGON_CACHE_MAX_LEVELS] = { NULL };
+                                        /* Simplified copies to free */
+    unsigned int level_polygons;        /* Polygon count of one level */
+    int level;                          /* Level counter */
+    int next_index = 0;                 /* Next entry index */
+    int64_t point_offset = 0;           /* Next vertex offset */
+    int64_t seg_offset = 0;             /* Next segment offset */
+    int value_select;                   /* Packed array selector */
+
+    /* Build the header, counting the full resolution list as level 0 */
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, IAS_POLYGON_CACHE_MAGIC, sizeof(header.magic));
+    header.version = IAS_POLYGON_CACHE_VERSION;
+    header.num_polygons = 0;
+    header.total_points = 0;
+    header.total_segs = 0;
+    header.num_levels = num_levels;
+    count_cache_sizes(polygon_list, &header.num_polygons,
+        &header.total_points, &header.total_segs);
+    levels[0] = polygon_list;
+
+    if (header.num_polygons == 0)
+    {
+        IAS_LOG_ERROR("No polygons to write to the cache");
+        return ERROR;
+    }
+
+    /* Build the 1-degree coverage summary from the full resolution list so
+       scene-overlap pre-tests can answer trivially land or water regions
+       without loading any polygons */
+    if (build_cache_coverage(polygon_list, &header) != SUCCESS)
+    {
+        IAS_LOG_ERROR("Building the coverage summary");
+        return ERROR;
+    }
+
+    /* Build each reduced level by simplifying a copy of the level above it.
+       Simplification never adds or removes polygons, so every level holds
+       the same polygons in the same preorder, only with fewer vertices. */
+    for (level = 1; level < num_levels; level++)
+    {
+        if (copy_polygon_list(levels[level - 1], &copies[level]) != SUCCESS
+            || ias_geo_simplify_polygon(copies[level],
+                level_tolerance[level]) != SUCCESS)
+        {
+            IAS_LOG_ERROR("Building simplification level %d", level);
+            free_polygon_levels(copies, num_levels);
+            return ERROR;
+        }
+        levels[level] = copies[level];
+
+        header.tolerances[level] = level_tolerance[level];
+        level_polygons = 0;
+        count_cache_sizes(levels[level], &level_polygons,
+            &header.total_points, &header.total_segs);
+    }
+
+    if (fwrite(&header, sizeof(header), 1, fp) != 1)
+    {
+        IAS_LOG_ERROR("Writing the cache header");
+        free_polygon_levels(copies, num_levels);
+        return ERROR;
+    }
+
+    /* Write the entry table of each level followed by the packed x values,
+       y values, and segments of every level, all in the same preorder.  The
+       vertex and segment offsets run across the levels, so the entries
+       index the combined packed arrays. */
+    for (level = 0; level < num_levels; level++)
+    {
+        if (write_cache_entries(fp, levels[level], -1, &next_index,
+            &point_offset, &seg_offset) != SUCCESS)
+        {
+            IAS_LOG_ERROR("Writing the cache entry table for level %d",
+                level);
+            free_polygon_levels(copies, num_levels);
+            return ERROR;
+        }
+    }
+
+    for (value_select = 0; value_select < 3; value_select++)
+    {
+        for (level = 0; level < num_levels; level++)
+        {
+            if (write_cache_values(fp, levels[level], value_select)
+                != SUCCESS)
+            {
+                IAS_LOG_ERROR("Writing the packed cache arrays");
+                free_polygon_levels(copies, num_levels);
+                return ERROR;
+            }
+        }
+    }
+
+    free_polygon_levels(copies, num_levels);
+    return SUCCESS;
+}
+
+/*****************************************************************************
+NAME:  ias_geo_load_polygon_cache
+
+PURPOSE:  Memory map a preprocessed polygon cache file and build the polygon
+          list for a region of interest from it.  The vertex arrays of the
+          returned polygons point directly into the read-only mapping, so no
+          vertex data is copied and the pages are shared with every other
+          process mapping the same cache.  The coarsest simplification level
+          whose tolerance does not exceed the requested tolerance is loaded,
+          so the vertex density matches the output resolution.  The caller
+          must unload the mapping with ias_geo_unload_polygon_cache after
+          freeing the list.
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion
+ERROR    Operation failed
+
+*****************************************************************************/
+int ias_geo_load_polygon_cache
+(
+    const char *cache_file,         /* I: Polygon cache filename */
+    double min_x,                   /* I: Minimum x value of interest */
+    double max_x,                   /* I: Maximum x value of interest */
+    double min_y,                   /* I: Minimum y value of interest */
+    double max_y,                   /* I: Maximum y value of interest */
+    double tolerance,               /* I: Simplification tolerance wanted, in
+                                          the polygon coordinate units; the
+                                          coarsest level not exceeding it is
+                                          loaded, and zero loads the full
+                                          resolution level */
+    IAS_POLYGON_LINKED_LIST **head, /* O: Polygon pointer */
+    void **map_addr,                /* O: Mapped cache file address */
+    int64_t *map_length             /* O: Mapped cache file length */
+)
+{
+    const IAS_POLYGON_CACHE_HEADER *header; /* Mapped cache header */
+    const IAS_POLYGON_CACHE_ENTRY *entries; /* Mapped entry table */
+    const double *point_x;          /* Mapped packed x values */
+    const double *point_y;          /* Mapped packed y values */
+    const IAS_POLYGON_SEGMENT *segs;/* Mapped packed segments */
+    IAS_POLYGON_LINKED_LIST **nodes;/* Entry index to node lookup */
+    IAS_POLYGON_LINKED_LIST **tails;/* Entry index to child tail lookup */
+    IAS_POLYGON_LINKED_LIST *list_tail = NULL;  /* Tail of the output list */
+    struct stat file_stat;          /* Cache file information */
+    void *map;                      /* Mapped cache file */
+    int64_t expected_length;        /* Expected cache file length */
+    int64_t level_start;            /* First entry index of the level */
+    unsigned int level;             /* Selected simplification level */
+    unsigned int i;                 /* Entry counter */
+    int fd;                         /* Cache file descriptor */
+
+    /* Assume no polygons will be read */
+    *head = NULL;
+    *map_addr = NULL;
+    *map_length = 0;
+
+    /* Open and map the cache file read-only so the pages are shared */
+    fd = open(cache_file, O_RDONLY);
+    if (fd < 0)
+    {
+        IAS_LOG_ERROR("Unable to open %s for reading", cache_file);
+        return ERROR;
+    }
+
+    if (fstat(fd, &file_stat) != 0)
+    {
+        IAS_LOG_ERROR("Getting the size of %s", cache_file);
+        close(fd);
+        return ERROR;
+    }
+
+    if (file_stat.st_size < (int64_t)sizeof(*header))
+    {
+        IAS_LOG_ERROR("Cache file %s is too small to hold a header",
+            cache_file);
+        close(fd);
+        return ERROR;
+    }
+
+    map = mmap(NULL, file_stat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        IAS_LOG_ERROR("Mapping the cache file %s", cache_file);
+        return ERROR;
+    }
+
+    /* Validate the header and the file length it implies */
+    header = (const IAS_POLYGON_CACHE_HEADER *)map;
+    if (memcmp(header->magic, IAS_POLYGON_CACHE_MAGIC,
+            sizeof(header->magic)) != 0
+        || header->version != IAS_POLYGON_CACHE_VERSION)
+    {
+        IAS_LOG_ERROR("Cache file %s is not a version %d polygon cache",
+            cache_file, IAS_POLYGON_CACHE_VERSION);
+        munmap(map, file_stat.st_size);
+        return ERROR;
+    }
+
+    if (header->num_levels < 1
+        || header->num_levels > IAS_POLYGON_CACHE_MAX_LEVELS)
+    {
+        IAS_LOG_ERROR("Cache file %s holds an unsupported level count %d",
+            cache_file, header->num_levels);
+        munmap(map, file_stat.st_size);
+        return ERROR;
+    }
+
+    expected_length = sizeof(*header)
+        + (int64_t)header->num_levels * header->num_polygons
+            * sizeof(*entries)
+        + 2 * header->total_points * sizeof(double)
+        + header->total_segs * sizeof(*segs);
+    if (file_stat.st_size != expected_length)
+    {
+        IAS_LOG_ERROR("Cache file %s length %lld does not match the "
+            "expected length %lld", cache_file,
+            (long long)file_stat.st_size, (long long)expected_length);
+        munmap(map, file_stat.st_size);
+        return ERROR;
+    }
+
+    entries = (const IAS_POLYGON_CACHE_ENTRY *)(header + 1);
+    point_x = (const double *)(entries
+        + (int64_t)header->num_levels * header->num_polygons);
+    point_y = point_x + header->total_points;
+    segs = (const IAS_POLYGON_SEGMENT *)(point_y + header->total_points);
+
+    /* Select the coarsest level whose tolerance doesn't exceed the
+       requested tolerance.  The level tolerances are stored in increasing
+       order, so level 0 (full resolution) is the fallback. */
+    level = 0;
+    for (i = 1; i < header->num_levels; i++)
+    {
+        if (header->tolerances[i] <= tolerance)
+            level = i;
+    }
+    level_start = (int64_t)level * header->num_polygons;
+
+    /* Track the node built for each entry so children can find their
+       parents; filtered entries stay NULL */
+    nodes = calloc(header->num_polygons, sizeof(*nodes));
+    tails = calloc(header->num_polygons, sizeof(*tails));
+    if (nodes == NULL || tails == NULL)
+    {
+        IAS_LOG_ERROR("Allocating memory for the cache entry lookup");
+        free(nodes);
+        free(tails);
+        munmap(map, file_stat.st_size);
+        return ERROR;
+    }
+
+    /* Build the polygon list from the entry table of the selected level.
+       The entries are in preorder, so a parent is always built before its
+       children.  The parent indices run across the whole entry table, so
+       they are rebased to the start of the level. */
+    for (i = 0; i < header->num_polygons; i++)
+    {
+        const IAS_POLYGON_CACHE_ENTRY *entry = &entries[level_start + i];
+        IAS_POLYGON_LINKED_LIST *polygon;   /* Node being built */
+        IAS_POLYGON_LINKED_LIST *parent = NULL; /* Parent node, if any */
+
+        if (entry->parent_index < 0)
+        {
+            /* Skip top level polygons outside the region of interest */
+            if (entry->min_x > max_x || entry->max_x < min_x
+                || entry->min_y > max_y || entry->max_y < min_y)
+            {
+                continue;
+            }
+        }
+        else
+        {
+            /* Skip children of filtered polygons */
+            parent = nodes[entry->parent_index - level_start];
+            if (!parent)
+                continue;
+        }
+
+        polygon = calloc(1, sizeof(*polygon));
+        if (polygon == NULL)
+        {
+            IAS_LOG_ERROR("Allocating memory for linked list");
+            ias_geo_free_polygon_linked_list(*head);
+            *head = NULL;
+            free(nodes);
+            free(tails);
+            munmap(map, file_stat.st_size);
+            return ERROR;
+        }
+
+        polygon->id = entry->id;
+        polygon->num_points = entry->num_points;
+        polygon->min_x = entry->min_x;
+        polygon->max_x = entry->max_x;
+        polygon->min_y = entry->min_y;
+        polygon->max_y = entry->max_y;
+        polygon->num_segs = entry->num_segs;
+
+        /* Point the vertices into the read-only mapping.  The mapped
+           arrays are never written, so dropping the const is safe, and the
+           packed flag keeps the free routine away from them. */
+        polygon->point_x = (double *)&point_x[entry->point_offset];
+        polygon->point_y = (double *)&point_y[entry->point_offset];
+        polygon->points_packed = 1;
+
+        /* The segments are small, so copy them out of the mapping to keep
+           the node freeing unchanged */
+        if (entry->num_segs > 0)
+        {
+            polygon->poly_seg = malloc(entry->num_segs
+                * sizeof(*polygon->poly_seg));
+            if (polygon->poly_seg == NULL)
+            {
+                IAS_LOG_ERROR("Allocating memory for the polygon segments");
+                free(polygon);
+                ias_geo_free_polygon_linked_list(*head);
+                *head = NULL;
+                free(nodes);
+                free(tails);
+                munmap(map, file_stat.st_size);
+                return ERROR;
+            }
+            memcpy(polygon->poly_seg, &segs[entry->seg_offset],
+                entry->num_segs * sizeof(*polygon->poly_seg));
+        }
+
+        nodes[i] = polygon;
+
+        if (parent)
+        {
+            /* Add the polygon to the tail of the parent's child list */
+            if (!parent->child)
+            {
+                parent->child = polygon;
+            }
+            else
+            {
+                tails[entry->parent_index - level_start]->next = polygon;
+                polygon->prev = tails[entry->parent_index - level_start];
+            }
+            tails[entry->parent_index - level_start] = polygon;
+        }
+        else
+        {
+            /* Add the polygon to the tail of the output list */
+            if (!*head)
+                *head = polygon;
+
+            if (list_tail)
+            {
+                list_tail->next = polygon;
+                polygon->prev = list_tail;
+            }
+            list_tail = polygon;
+        }
+    }
+
+    free(nodes);
+    free(tails);
+
+    *map_addr = map;
+    *map_length = file_stat.st_size;
+
+    return SUCCESS;
+}
+
+/*****************************************************************************
+NAME:  ias_geo_unload_polygon_cache
+
+PURPOSE:  Unmap a polygon cache file mapped by ias_geo_load_polygon_cache.
+          The polygon list built from the cache must already be freed.
+
+RETURN VALUE:
+Type = void
+
+*****************************************************************************/
+void ias_geo_unload_polygon_cache
+(
+    void *map_addr,                 /* I: Mapped cache file address */
+    int64_t map_length              /* I: Mapped cache file length */
+)
+{
+    if (map_addr)
+        munmap(map_addr, map_length);
+}
+
+/*****************************************************************************
+NAME:  ias_geo_polygon_cache_coverage
+
+PURPOSE:  Answer whether a region is entirely land or entirely water from
+          the 1-degree coverage summary in a polygon cache header, reading
+          only the header.  The summary is conservative, so a region is only
+          reported constant when every cell it overlaps is; regions that get
+          neither flag need the full polygon processing.
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion (both flags zero when the region is mixed)
+ERROR    The cache header could not be read or is not a current version
+
+*****************************************************************************/
+int ias_geo_polygon_cache_coverage
+(
+    const char *cache_file,         /* I: Polygon cache filename */
+    double min_x,                   /* I: Minimum longitude of interest */
+    double max_x,                   /* I: Maximum longitude of interest; less
+                                          than min_x when the region wraps
+                                          past 180 degrees */
+    double min_y,                   /* I: Minimum latitude of interest */
+    double max_y,                   /* I: Maximum latitude of interest */
+    int *is_all_land,               /* O: Region is entirely land */
+    int *is_all_water               /* O: Region is entirely water */
+)
+{
+    IAS_POLYGON_CACHE_HEADER header;    /* Cache file header */
+    FILE *fp;                   /* Cache file pointer */
+    int lon_start;              /* First longitude cell of the region */
+    int num_lon_cells;          /* Longitude cells the region overlaps */
+    int lat_start;              /* First latitude cell of the region */
+    int lat_end;                /* Last latitude cell of the region */
+    int lat_cell;               /* Latitude cell counter */
+    int lon_count;              /* Longitude cell counter */
+    int all_land = 1;           /* Every overlapped cell is entirely land */
+    int all_water = 1;          /* No overlapped cell contains any land */
+
+    *is_all_land = 0;
+    *is_all_water = 0;
+
+    fp = fopen(cache_file, "rb");
+    if (!fp)
+    {
+        IAS_LOG_ERROR("Unable to open %s for reading.", cache_file);
+        return ERROR;
+    }
+    if (fread(&header, sizeof(header), 1, fp) != 1)
+    {
+        IAS_LOG_ERROR("Reading the cache header from %s", cache_file);
+        fclose(fp);
+        return ERROR;
+    }
+    fclose(fp);
+
+    if (memcmp(header.magic, IAS_POLYGON_CACHE_MAGIC,
+            sizeof(header.magic)) != 0
+        || header.version != IAS_POLYGON_CACHE_VERSION)
+    {
+        IAS_LOG_ERROR("Cache file %s is not a version %d polygon cache",
+            cache_file, IAS_POLYGON_CACHE_VERSION);
+        return ERROR;
+    }
+
+    /* Determine the cells the region overlaps, walking the longitude cells
+       eastward with wrap so a region crossing 180 degrees works */
+    lon_start = coverage_lon_cell(min_x);
+    if (max_x >= min_x)
+        num_lon_cells = coverage_lon_cell(max_x) - lon_start + 1;
+    else
+        num_lon_cells = coverage_lon_cell(max_x)
+            + IAS_POLYGON_CACHE_COVERAGE_LON_CELLS - lon_start + 1;
+    lat_start = coverage_lat_cell(min_y);
+    lat_end = coverage_lat_cell(max_y);
+
+    for (lat_cell = lat_start; lat_cell <= lat_end; lat_cell++)
+    {
+        for (lon_count = 0; lon_count < num_lon_cells; lon_count++)
+        {
+            int lon_cell = (lon_start + lon_count)
+                % IAS_POLYGON_CACHE_COVERAGE_LON_CELLS;
+
+            if (coverage_bit_is_set(header.any_land, lon_cell, lat_cell))
+                all_water = 0;
+            if (!coverage_bit_is_set(header.all_land, lon_cell, lat_cell))
+                all_land = 0;
+
+            if (!all_water && !all_land)
+                return SUCCESS;     /* Mixed region; both flags stay zero */
+        }
+    }
+
+    *is_all_land = all_land;
+    *is_all_water = all_water;
+    return SUCCESS;
+}
+
+/*****************************************************************************
+NAME:  ias_geo_reduce_polygon
+
+PURPOSE: Discard polygons outside a specified bounding box.
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion
+ERROR    Operation failed
+
+*****************************************************************************/
+int ias_geo_reduce_polygon
+(
+    IAS_POLYGON_LINKED_LIST **polygon_list, /* I/O: First polygon in list */
+    double upper_left_x,                    /* I: Upper left x */
+    double lower_right_x,                   /* I: Lower right x */
+    double upper_left_y,                    /* I: Upper left y */
+    double lower_right_y                    /* I: Lower right y */
+)
+{
+    IAS_POLYGON_LINKED_LIST *polygon;/* Current polygon list pointer */
+    IAS_POLYGON_LINKED_LIST *next;   /* Next polygon list pointer */
+    unsigned int x_crossing;         /* Flag indicating whether a horizontal
+                                        domain boundary is crossed; this is
+                                        usually associated with +/-180 degree
+                                        longitude boundaries */
+
+    if (upper_left_x > lower_right_x)
+    {
+        IAS_LOG_ERROR(
+            "Upper left longitude greater than lower right longitude");
+        return ERROR;
+    }
+
+    if (upper_left_y < lower_right_y)
+    {
+        IAS_LOG_ERROR("Upper left latitude less than lower right latitude");
+        return ERROR;
+    }
+
+    /* Set the boundary crossing flag. */
+    if (lower_right_x >= upper_left_x)
+    {
+        x_crossing = 0;
+    }
+    else
+    {
+        x_crossing = 1;
+    }
+
+    polygon = *polygon_list;
+    while (polygon)
+    {
+        /* Remove unnecessary children. */
+        if (polygon->child)
+        {
+            ias_geo_reduce_polygon(&polygon->child, 
+                upper_left_x, lower_right_x, upper_left_y, lower_right_y);
+        }
+
+        /* Keep track of next polygon */
+        next = polygon->next;
+
+        /* Check if polygon is outside the bounding box */
+        if (polygon->min_y > upper_left_y || polygon->max_y < lower_right_y 
+            || (!x_crossing && (polygon->min_x > lower_right_x || polygon->max_x
+            < upper_left_x)) || (x_crossing && (polygon->min_x > lower_right_x 
+            && polygon->max_x < upper_left_x)))
+        {
+            /* Check if the current polygon is the head of the list */
+            if (polygon != *polygon_list)
+            {
+                /* Polygon is not the head of the list reset the links so 
+                   the list isn't broken */
+                polygon->prev->next = next;
+                if (next != NULL)
+                {
+                    next->prev = polygon->prev;
+                }
+            }
+            else
+            {
+                /* Polygon is the head of the list so change the head of the
+                   list to the next polygon */
+                *polygon_list = next;
+                if (next != NULL)
+                {
+                    next->prev = NULL;
+                }
+            }
+
+            /* Free up the polygon */
+            polygon->next = NULL;
+            ias_geo_free_polygon_linked_list(polygon);
+        }
+
+        polygon = next;
+    }
+    return SUCCESS;
+}
+
+/****************************************************************************
+NAME:  select_ring_points
+
+PURPOSE:  Mark the ring vertices to keep when simplifying a polygon with
+          the given tolerance, using Douglas-Peucker splitting with an
+          explicit span stack so deep rings can't overflow the call stack.
+          The first and last (closing) vertices are always kept.
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion
+ERROR    Operation failed
+
+*****************************************************************************/
+static int select_ring_points
+(
+    const double *point_x,      /* I: Ring vertex x values */
+    const double *point_y,      /* I: Ring vertex y values */
+    unsigned int num_points,    /* I: Number of ring vertices */
+    double tolerance,           /* I: Maximum deviation to allow */
+    unsigned char *keep,        /* O: Per-vertex keep flags */
+    unsigned int *num_kept      /* O: Number of vertices kept */
+)
+{
+    RING_SPAN *stack;           /* Spans awaiting a split */
+    int stack_depth = 0;        /* Number of stacked spans */
+    double tolerance_sq = tolerance * tolerance; /* Squared tolerance */
+    unsigned int index;         /* Vertex counter */
+    unsigned int kept = 0;      /* Number of vertices kept */
+
+    /* Each split keeps one new vertex and stacks at most two nested spans,
+       so the stack can never hold more spans than vertices */
+    stack = malloc(num_points * sizeof(*stack));
+    if (stack == NULL)
+    {
+        IAS_LOG_ERROR("Allocating memory for the simplification stack");
+        return ERROR;
+    }
+
+    memset(keep, 0, num_points);
+    keep[0] = 1;
+    keep[num_points - 1] = 1;
+    stack[stack_depth].first = 0;
+    stack[stack_depth].last = num_points - 1;
+    stack_depth++;
+
+    while (stack_depth > 0)
+    {
+        unsigned int first;     /* First vertex of the span */
+        unsigned int last;      /* Last vertex of the span */
+        unsigned int split = 0; /* Vertex farthest from the span chord */
+        double delta_x;         /* Chord x extent */
+        double delta_y;         /* Chord y extent */
+        double length_sq;       /* Squared chord length */
+        double max_dist_sq = -1.0; /* Largest squared vertex deviation */
+
+        stack_depth--;
+        first = stack[stack_depth].first;
+        last = stack[stack_depth].last;
+        if (last - first < 2)
+            continue;
+
+        /* Find the vertex deviating farthest from the span chord.  For the
+           initial span of a closed ring the chord is degenerate, so the
+           deviation falls back to the distance from the shared endpoint. */
+        delta_x = point_x[last] - point_x[first];
+        delta_y = point_y[last] - point_y[first];
+        length_sq = delta_x * delta_x + delta_y * delta_y;
+        for (index = first + 1; index < last; index++)
+        {
+            double dist_sq;     /* Squared deviation of this vertex */
+
+            if (length_sq > 0.0)
+            {
+                double cross = (point_x[index] - point_x[first]) * delta_y
+                    - (point_y[index] - point_y[first]) * delta_x;
+                dist_sq = cross * cross / length_sq;
+            }
+            else
+            {
+                double off_x = point_x[index] - point_x[first];
+                double off_y = point_y[index] - point_y[first];
+                dist_sq = off_x * off_x + off_y * off_y;
+            }
+
+            if (dist_sq > max_dist_sq)
+            {
+                max_dist_sq = dist_sq;
+                split = index;
+            }
+        }
+
+        /* Keep the farthest vertex and split the span at it if it deviates
+           more than the tolerance; otherwise the whole span collapses to
+           its chord */
+        if (max_dist_sq > tolerance_sq)
+        {
+            keep[split] = 1;
+            stack[stack_depth].first = first;
+            stack[stack_depth].last = split;
+            stack_depth++;
+            stack[stack_depth].first = split;
+            stack[stack_depth].last = last;
+            stack_depth++;
+        }
+    }
+    free(stack);
+
+    for (index = 0; index < num_points; index++)
+    {
+        if (keep[index])
+            kept++;
+    }
+    *num_kept = kept;
+
+    return SUCCESS;
+}
+
+/****************************************************************************
+NAME:  simplify_polygon_ring
+
+PURPOSE:  Simplify the ring of one polygon in place, replacing the vertex
+          arrays with the kept subset.  The bounding box is left at the
+          original (conservative) extent and the segment groups are dropped
+          since their vertex indices no longer apply.
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion
+ERROR    Operation failed
+
+*****************************************************************************/
+static int simplify_polygon_ring
+(
+    IAS_POLYGON_LINKED_LIST *polygon,   /* I/O: Polygon to simplify */
+    double tolerance                    /* I: Maximum deviation to allow */
+)
+{
+    unsigned char *keep;        /* Per-vertex keep flags */
+    double *new_x;              /* Simplified x vertices */
+    double *new_y;              /* Simplified y vertices */
+    unsigned int num_kept = 0;  /* Number of vertices kept */
+    unsigned int index;         /* Vertex counter */
+    unsigned int next = 0;      /* Next output vertex */
+
+    /* Rings at the minimum size can't lose any more vertices */
+    if (polygon->num_points <= 4)
+        return SUCCESS;
+
+    keep = malloc(polygon->num_points * sizeof(*keep));
+    if (keep == NULL)
+    {
+        IAS_LOG_ERROR("Allocating memory for the vertex keep flags");
+        return ERROR;
+    }
+
+    if (select_ring_points(polygon->point_x, polygon->point_y,
+        polygon->num_points, tolerance, keep, &num_kept) != SUCCESS)
+    {
+        free(keep);
+        return ERROR;
+    }
+
+    /* A ring entirely below the tolerance still needs enough vertices to
+       enclose area, so fall back to a coarse four vertex ring instead of
+       collapsing it */
+    if (num_kept < 4)
+    {
+        keep[polygon->num_points / 3] = 1;
+        keep[2 * (polygon->num_points / 3)] = 1;
+        num_kept = 0;
+        for (index = 0; index < polygon->num_points; index++)
+        {
+            if (keep[index])
+                num_kept++;
+        }
+    }
+
+    if (num_kept >= polygon->num_points)
+    {
+        free(keep);
+        return SUCCESS;
+    }
+
+    new_x = malloc(num_kept * sizeof(*new_x));
+    new_y = malloc(num_kept * sizeof(*new_y));
+    if (new_x == NULL || new_y == NULL)
+    {
+        IAS_LOG_ERROR("Allocating memory for the simplified vertices");
+        free(new_x);
+        free(new_y);
+        free(keep);
+        return ERROR;
+    }
+
+    for (index = 0; index < polygon->num_points; index++)
+    {
+        if (keep[index])
+        {
+            new_x[next] = polygon->point_x[index];
+            new_y[next] = polygon->point_y[index];
+            next++;
+        }
+    }
+    free(keep);
+
+    /* Packed vertex arrays point into a shared buffer owned by the caller,
+       so only free separately allocated arrays */
+    if (!polygon->points_packed)
+    {
+        free(polygon->point_x);
+        free(polygon->point_y);
+    }
+    polygon->point_x = new_x;
+    polygon->point_y = new_y;
+    polygon->points_packed = 0;
+    polygon->num_points = num_kept;
+
+    /* The segment groups index the original vertices, so they no longer
+       apply to the simplified ring */
+    free(polygon->poly_seg);
+    polygon->poly_seg = NULL;
+    polygon->num_segs = 0;
+
+    return SUCCESS;
+}
+
+/*****************************************************************************
+NAME:  ias_geo_simplify_polygon
+
+PURPOSE:  Simplify every polygon of a list, including the children, with
+          Douglas-Peucker splitting so no kept ring deviates from the
+          original by more than the tolerance.  Matching the tolerance to
+          the output pixel size drops the vertices a raster at that
+          resolution can't resolve, which cuts the crossing-test workload
+          of the mask rasterization accordingly.
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion
+ERROR    Operation failed
+
+*****************************************************************************/
+int ias_geo_simplify_polygon
+(
+    IAS_POLYGON_LINKED_LIST *polygon_list,  /* I/O: First polygon in list */
+    double tolerance                        /* I: Maximum deviation to allow
+                                                  from the original ring, in
+                                                  the polygon coordinate
+                                                  units */
+)
+{
+    IAS_POLYGON_LINKED_LIST *polygon;       /* Current polygon in the list */
+
+    /* A tolerance of zero (or less) keeps the full resolution */
+    if (tolerance <= 0.0)
+        return SUCCESS;
+
+    for (polygon = polygon_list; polygon; polygon = polygon->next)
+    {
+        if (simplify_polygon_ring(polygon, tolerance) != SUCCESS)
+            return ERROR;
+
+        if (polygon->child
+            && ias_geo_simplify_polygon(polygon->child, tolerance)
+                != SUCCESS)
+        {
+            return ERROR;
+        }
+    }
+
     return SUCCESS;
 }
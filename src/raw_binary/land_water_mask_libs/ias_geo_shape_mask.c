@@ -3,87 +3,1626 @@
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
+#include <limits.h>
+#include <sys/stat.h>
 
 /* IAS Library Includes */
-#include "ias_types.h"        
+#include "ias_types.h"
 #include "ias_math.h"
-#include "ias_lw_geo.h"          
+#include "ias_lw_geo.h"
+#include "espa_perf.h"
+#include "espa_cancel.h"          
+#include "espa_thread_pool.h"
+#include "espa_bitset.h"
 #include "ias_logging.h" 
 #include "ias_const.h"
 #include "gctp.h"
 #include "config.h"
 
 /* Local Defines */
-#define GRID_SIZE_HORZ 20
-#define GRID_SIZE_VERT 20
+#define GRID_SIZE_HORZ 64
+#define GRID_SIZE_VERT 64
+/* Blocks at or below this size stop subdividing and transform per pixel */
+#define MASK_BLOCK_MIN_SIZE 8
 #define ALL_BITS_SET 255
 #define NO_BITS_SET 0
+#define INDEX_MAX_BINS_PER_AXIS 256
+
+/* Spatial index for the parent polygon list.  The polygons are binned into a
+   uniform latitude/longitude grid over their combined bounding box so point
+   queries only test the polygons overlapping the bins near the query point
+   instead of walking the entire linked list.  Bins reference the polygons
+   through an entry index so a polygon spanning several bins is only tested
+   once per query (tracked with the visit stamp). */
+typedef struct polygon_spatial_index
+{
+    int num_rows;               /* Number of latitude bins */
+    int num_cols;               /* Number of longitude bins */
+    double min_x;               /* Minimum longitude covered by the index */
+    double max_x;               /* Maximum longitude covered by the index */
+    double min_y;               /* Minimum latitude covered by the index */
+    double max_y;               /* Maximum latitude covered by the index */
+    double bin_width;           /* Longitude bin size (degrees) */
+    double bin_height;          /* Latitude bin size (degrees) */
+    int num_polygons;           /* Number of indexed (parent) polygons */
+    IAS_POLYGON_LINKED_LIST **polygons; /* Indexed polygon pointers */
+    unsigned int *last_visit;   /* Query stamp when each polygon was last
+                                   tested */
+    unsigned int visit_stamp;   /* Current query stamp */
+    int *bin_start;             /* Offset of each bin's first entry in the
+                                   bin_entries array (num_rows * num_cols + 1
+                                   entries) */
+    int *bin_entries;           /* Polygon indices for each bin */
+    struct polygon_family_state *family_state;  /* Per-polygon scanline edge
+                                   state carried across lines */
+} POLYGON_SPATIAL_INDEX;
+
+/* One flattened edge of a polygon family (a parent polygon and all of its
+   descendants).  Horizontal edges never cross a scanline and are dropped
+   when the edges are flattened.  The crossing longitude is maintained
+   incrementally while the edge is active: it is seeded from the upper
+   vertex when the edge activates and stepped by the inverse slope as the
+   scanline descends, so the per-line cost is one multiply-add per active
+   edge instead of an interpolation with a divide. */
+typedef struct polygon_family_edge
+{
+    double top_x;               /* Longitude where the edge meets max_y */
+    double min_y;               /* Lower latitude of the edge */
+    double max_y;               /* Upper latitude of the edge */
+    double inv_slope;           /* Longitude change per unit latitude */
+    double current_x;           /* Crossing longitude at the latitude the
+                                   family state was last advanced to */
+} POLYGON_FAMILY_EDGE;
+
+/* Scanline edge state of one polygon family.  The edges are sorted by their
+   upper latitude, and the state is carried across scanlines so each line of
+   a top-to-bottom rasterization only touches the edges activating, crossing
+   or retiring at its latitude instead of rescanning the whole family. */
+typedef struct polygon_family_state
+{
+    POLYGON_FAMILY_EDGE *edges; /* Family edges sorted by max_y descending */
+    int num_edges;              /* Number of edges in the family */
+    int next_edge;              /* Next edge to activate as the scanline
+                                   latitude descends */
+    int *active;                /* Indices of the currently active edges,
+                                   ordered by crossing longitude */
+    int num_active;             /* Number of active edges */
+    double latitude;            /* Latitude the state was last advanced to */
+    int started;                /* Has the state been advanced yet */
+} POLYGON_FAMILY_STATE;
+
+#ifndef HAVE_LITTLE_ENDIAN
+#error("This code does not properly support big endian")
+#endif
+
+/*****************************************************************************
+NAME:  convert_target_xy_to_input_line_sample
+
+PURPOSE:  Converts an X/Y coordinate to input line/sample and confirms it falls
+    within the image.
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+TRUE     Pixel in mask
+FALSE    Pixel not in mask
+ERROR    Operation failed
+
+*****************************************************************************/
+static int convert_target_xy_to_input_line_sample
+(
+    const IAS_DBL_XY *current_pixel,   /* I: Pixel X/Y coordinate */
+    IAS_GEO_PROJ_TRANSFORMATION *geographic_transformation,/* I: Transformation
+                                                                 Projection */
+    double min_lng,             /* I: Minimum image longitude */
+    double max_lat,             /* I: Maximum image latitude */
+    double delta_longitude,     /* I: Change in longitude from bounding box */
+    double delta_latitude,      /* I: Change in latatiude from bounding box */
+    int num_samples,            /* I: Number of samples in input image */
+    int num_lines,              /* I: Number of lines in input image */
+    IAS_DBL_LS *translated_pixel/* O: Translated to bit mask line/sample */
+)
+{
+    IAS_DBL_LAT_LONG transformed_pixel; /* Pixel transformed to lat/long */
+   
+    /* Transform the X/Y coordinates to Lat/Long */
+    if (ias_geo_transform_coordinate(geographic_transformation, 
+        current_pixel->x, current_pixel->y, &transformed_pixel.lng, 
+        &transformed_pixel.lat) != SUCCESS)
+    {
+        IAS_LOG_ERROR("Converting to lat/long");
+        return ERROR;
+    }
+            
+    /* Translate lat/long to mask line/sample */  
+    translated_pixel->samp = (transformed_pixel.lng - min_lng) 
+        / delta_longitude;
+    translated_pixel->line = (max_lat - transformed_pixel.lat) / delta_latitude;
+            
+    /* Check if the line sample falls within the image */
+    if (translated_pixel->line >= 0 && translated_pixel->line < num_lines 
+        && translated_pixel->samp >= 0 && translated_pixel->samp < num_samples)
+    {
+        return TRUE;
+    } 
+
+    return FALSE;
+}
+
+/*****************************************************************************
+NAME:  free_polygon_spatial_index
+
+PURPOSE:  Free the memory allocated for a polygon spatial index.  The polygons
+    referenced by the index are not freed; they remain owned by the linked
+    list the index was built from.
+
+RETURN VALUE:
+Type = void
+
+*****************************************************************************/
+static void free_polygon_spatial_index
+(
+    POLYGON_SPATIAL_INDEX *spatial_index    /* I: Index to free */
+)
+{
+    if (spatial_index)
+    {
+        free(spatial_index->polygons);
+        free(spatial_index->last_visit);
+        free(spatial_index->bin_start);
+        free(spatial_index->bin_entries);
+        if (spatial_index->family_state)
+        {
+            int entry;      /* Polygon entry counter */
+
+            for (entry = 0; entry < spatial_index->num_polygons; entry++)
+            {
+                free(spatial_index->family_state[entry].edges);
+                free(spatial_index->family_state[entry].active);
+            }
+            free(spatial_index->family_state);
+        }
+        free(spatial_index);
+    }
+}
+
+/*****************************************************************************
+NAME:  get_polygon_bin_range
+
+PURPOSE:  Determine the range of index bins a polygon bounding box overlaps.
+
+RETURN VALUE:
+Type = void
+
+*****************************************************************************/
+static void get_polygon_bin_range
+(
+    const POLYGON_SPATIAL_INDEX *spatial_index, /* I: Spatial index */
+    const IAS_POLYGON_LINKED_LIST *polygon,     /* I: Polygon to locate */
+    int *start_row,             /* O: First latitude bin overlapped */
+    int *end_row,               /* O: Last latitude bin overlapped */
+    int *start_col,             /* O: First longitude bin overlapped */
+    int *end_col                /* O: Last longitude bin overlapped */
+)
+{
+    *start_row = (polygon->min_y - spatial_index->min_y)
+        / spatial_index->bin_height;
+    *end_row = (polygon->max_y - spatial_index->min_y)
+        / spatial_index->bin_height;
+    *start_col = (polygon->min_x - spatial_index->min_x)
+        / spatial_index->bin_width;
+    *end_col = (polygon->max_x - spatial_index->min_x)
+        / spatial_index->bin_width;
+
+    /* Clamp the ranges to the index in case the bounding box touches the
+       index edge */
+    if (*start_row < 0)
+        *start_row = 0;
+    if (*end_row >= spatial_index->num_rows)
+        *end_row = spatial_index->num_rows - 1;
+    if (*start_col < 0)
+        *start_col = 0;
+    if (*end_col >= spatial_index->num_cols)
+        *end_col = spatial_index->num_cols - 1;
+}
+
+/*****************************************************************************
+NAME:  count_family_edges
+
+PURPOSE:  Count the non-horizontal edges of a polygon and all of its
+    descendants.
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+count    Number of non-horizontal edges in the family
+
+*****************************************************************************/
+static int count_family_edges
+(
+    const IAS_POLYGON_LINKED_LIST *polygon  /* I: Polygon to count */
+)
+{
+    const IAS_POLYGON_LINKED_LIST *child;   /* Child polygon pointer */
+    unsigned int point;     /* Point loop counter */
+    int count = 0;          /* Edge count */
+
+    for (point = 0; point < polygon->num_points - 1; point++)
+    {
+        if (polygon->point_y[point] != polygon->point_y[point + 1])
+            count++;
+    }
+
+    for (child = polygon->child; child; child = child->next)
+        count += count_family_edges(child);
+
+    return count;
+}
+
+/*****************************************************************************
+NAME:  flatten_family_edges
+
+PURPOSE:  Append the non-horizontal edges of a polygon and all of its
+    descendants to the flattened edge array of the family.
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+count    Updated number of edges appended
+
+*****************************************************************************/
+static int flatten_family_edges
+(
+    const IAS_POLYGON_LINKED_LIST *polygon, /* I: Polygon to flatten */
+    POLYGON_FAMILY_EDGE *edges, /* I/O: Flattened edge array */
+    int count                   /* I: Number of edges already appended */
+)
+{
+    const IAS_POLYGON_LINKED_LIST *child;   /* Child polygon pointer */
+    unsigned int point;     /* Point loop counter */
+
+    for (point = 0; point < polygon->num_points - 1; point++)
+    {
+        POLYGON_FAMILY_EDGE *edge = &edges[count];
+        double x0 = polygon->point_x[point];    /* First vertex longitude */
+        double y0 = polygon->point_y[point];    /* First vertex latitude */
+        double x1 = polygon->point_x[point + 1];/* Second vertex longitude */
+        double y1 = polygon->point_y[point + 1];/* Second vertex latitude */
+
+        if (y0 == y1)
+            continue;
+
+        /* The inverse slope is the only divide the edge ever needs; the
+           per-line crossings are stepped from it */
+        edge->inv_slope = (x1 - x0) / (y1 - y0);
+        if (y0 > y1)
+        {
+            edge->top_x = x0;
+            edge->min_y = y1;
+            edge->max_y = y0;
+        }
+        else
+        {
+            edge->top_x = x1;
+            edge->min_y = y0;
+            edge->max_y = y1;
+        }
+        edge->current_x = edge->top_x;
+        count++;
+    }
+
+    for (child = polygon->child; child; child = child->next)
+        count = flatten_family_edges(child, edges, count);
+
+    return count;
+}
+
+/*****************************************************************************
+NAME:  compare_family_edges
+
+PURPOSE:  qsort comparison routine ordering family edges by their upper
+    latitude, descending, so a top-to-bottom rasterization activates them in
+    array order.
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+-1       First edge has the higher upper latitude
+ 0       Upper latitudes are equal
+ 1       Second edge has the higher upper latitude
+
+*****************************************************************************/
+static int compare_family_edges
+(
+    const void *a,          /* I: First edge to compare */
+    const void *b           /* I: Second edge to compare */
+)
+{
+    const POLYGON_FAMILY_EDGE *edge_a = a;  /* First edge */
+    const POLYGON_FAMILY_EDGE *edge_b = b;  /* Second edge */
+
+    if (edge_a->max_y > edge_b->max_y)
+        return -1;
+    else if (edge_a->max_y < edge_b->max_y)
+        return 1;
+    return 0;
+}
+
+/*****************************************************************************
+NAME:  advance_family_state
+
+PURPOSE:  Advance the scanline edge state of a polygon family to a latitude.
+    Edges whose upper latitude has been passed are activated and edges whose
+    lower latitude is above the scanline are retired, so consecutive
+    descending scanlines only pay for the edges near their latitude.  The
+    crossing longitude of each surviving edge is stepped down to the
+    scanline with its inverse slope, and the active list is kept ordered by
+    crossing longitude, so the caller reads the crossings already sorted.
+    If the latitude is above the previous one the state is rebuilt from the
+    top.
+
+RETURN VALUE:
+Type = void
+
+*****************************************************************************/
+static void advance_family_state
+(
+    POLYGON_FAMILY_STATE *state,    /* I/O: Family state to advance */
+    double latitude                 /* I: Scanline latitude (degrees) */
+)
+{
+    int entry;          /* Active entry counter */
+    int remaining;      /* Active entries kept after the prune */
+    double step;        /* Latitude change since the previous advance */
+
+    /* Restart from the top for the first line or a non-descending query */
+    if (!state->started || latitude > state->latitude)
+    {
+        state->next_edge = 0;
+        state->num_active = 0;
+        state->started = 1;
+        state->latitude = latitude;
+    }
+    step = latitude - state->latitude;
+    state->latitude = latitude;
+
+    /* Retire the active edges which end above the scanline and step the
+       crossings of the survivors down to it */
+    remaining = 0;
+    for (entry = 0; entry < state->num_active; entry++)
+    {
+        POLYGON_FAMILY_EDGE *edge = &state->edges[state->active[entry]];
+
+        if (edge->min_y <= latitude)
+        {
+            edge->current_x += edge->inv_slope * step;
+            state->active[remaining++] = state->active[entry];
+        }
+    }
+    state->num_active = remaining;
+
+    /* Activate the edges whose latitude span the scanline has reached,
+       seeding each crossing exactly from the edge's upper vertex so the
+       incremental stepping never accumulates error over more lines than
+       the edge spans.  Edges the scanline stepped completely past
+       contribute no crossing on any line and are dropped. */
+    while (state->next_edge < state->num_edges
+        && state->edges[state->next_edge].max_y > latitude)
+    {
+        POLYGON_FAMILY_EDGE *edge = &state->edges[state->next_edge];
+
+        if (edge->min_y <= latitude)
+        {
+            edge->current_x = edge->top_x
+                + edge->inv_slope * (latitude - edge->max_y);
+            state->active[state->num_active++] = state->next_edge;
+        }
+        state->next_edge++;
+    }
+
+    /* Restore the crossing order of the active list.  Edges of a simple
+       polygon rarely exchange crossing order between consecutive lines, so
+       the insertion sort runs in linear time on nearly every line where a
+       full sort would pay its n log n over again. */
+    for (entry = 1; entry < state->num_active; entry++)
+    {
+        int edge_index = state->active[entry];  /* Edge being placed */
+        double crossing = state->edges[edge_index].current_x;
+        int slot;       /* Insertion position being probed */
+
+        for (slot = entry;
+             slot > 0
+                && state->edges[state->active[slot - 1]].current_x > crossing;
+             slot--)
+        {
+            state->active[slot] = state->active[slot - 1];
+        }
+        state->active[slot] = edge_index;
+    }
+}
+
+/*****************************************************************************
+NAME:  build_polygon_spatial_index
+
+PURPOSE:  Build a spatial index over a polygon linked list.  Only the parent
+    polygons are binned; child polygons are still reached through their
+    parent when a point falls inside it.
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion
+ERROR    Operation failed
+
+*****************************************************************************/
+static int build_polygon_spatial_index
+(
+    IAS_POLYGON_LINKED_LIST *polygon_list,  /* I: Polygon list to index */
+    POLYGON_SPATIAL_INDEX **spatial_index   /* O: Index built over the list */
+)
+{
+    POLYGON_SPATIAL_INDEX *index;       /* Index being built */
+    IAS_POLYGON_LINKED_LIST *polygon;   /* Polygon linked list pointer */
+    int num_polygons;                   /* Number of parent polygons */
+    int num_bins;                       /* Total number of bins */
+    int bins_per_axis;                  /* Bins in each grid direction */
+    int entry;                          /* Current polygon entry index */
+    int bin;                            /* Bin counter */
+
+    /* Allocate the index structure */
+    index = calloc(1, sizeof(*index));
+    if (!index)
+    {
+        IAS_LOG_ERROR("Allocating memory for the polygon spatial index");
+        return ERROR;
+    }
+
+    /* Find the number of parent polygons and the overall bounding box */
+    num_polygons = 0;
+    for (polygon = polygon_list; polygon; polygon = polygon->next)
+    {
+        if (num_polygons == 0)
+        {
+            index->min_x = polygon->min_x;
+            index->max_x = polygon->max_x;
+            index->min_y = polygon->min_y;
+            index->max_y = polygon->max_y;
+        }
+        else
+        {
+            if (polygon->min_x < index->min_x)
+                index->min_x = polygon->min_x;
+            if (polygon->max_x > index->max_x)
+                index->max_x = polygon->max_x;
+            if (polygon->min_y < index->min_y)
+                index->min_y = polygon->min_y;
+            if (polygon->max_y > index->max_y)
+                index->max_y = polygon->max_y;
+        }
+        num_polygons++;
+    }
+    index->num_polygons = num_polygons;
+
+    /* An empty list yields an empty index that every query misses */
+    if (num_polygons == 0)
+    {
+        index->num_rows = 0;
+        index->num_cols = 0;
+        *spatial_index = index;
+        return SUCCESS;
+    }
+
+    /* Size the grid so the average bin holds roughly one polygon, limiting
+       the bin count to keep the memory use bounded for very dense files */
+    bins_per_axis = (int)sqrt((double)num_polygons);
+    if (bins_per_axis < 1)
+        bins_per_axis = 1;
+    if (bins_per_axis > INDEX_MAX_BINS_PER_AXIS)
+        bins_per_axis = INDEX_MAX_BINS_PER_AXIS;
+    index->num_rows = bins_per_axis;
+    index->num_cols = bins_per_axis;
+    num_bins = index->num_rows * index->num_cols;
+
+    /* Guard against a degenerate extent so the bin math stays valid */
+    index->bin_width = (index->max_x - index->min_x) / index->num_cols;
+    if (index->bin_width <= 0.0)
+        index->bin_width = 1.0;
+    index->bin_height = (index->max_y - index->min_y) / index->num_rows;
+    if (index->bin_height <= 0.0)
+        index->bin_height = 1.0;
+
+    /* Allocate the polygon entry arrays and bin offsets */
+    index->polygons = malloc(num_polygons * sizeof(*index->polygons));
+    index->last_visit = calloc(num_polygons, sizeof(*index->last_visit));
+    index->bin_start = calloc(num_bins + 1, sizeof(*index->bin_start));
+    if (!index->polygons || !index->last_visit || !index->bin_start)
+    {
+        IAS_LOG_ERROR("Allocating memory for the polygon spatial index");
+        free_polygon_spatial_index(index);
+        return ERROR;
+    }
+
+    /* First pass: count the polygons overlapping each bin */
+    entry = 0;
+    for (polygon = polygon_list; polygon; polygon = polygon->next)
+    {
+        int start_row;      /* First latitude bin overlapped */
+        int end_row;        /* Last latitude bin overlapped */
+        int start_col;      /* First longitude bin overlapped */
+        int end_col;        /* Last longitude bin overlapped */
+        int row;            /* Bin row counter */
+        int col;            /* Bin column counter */
+
+        index->polygons[entry] = polygon;
+        entry++;
+
+        get_polygon_bin_range(index, polygon, &start_row, &end_row,
+            &start_col, &end_col);
+        for (row = start_row; row <= end_row; row++)
+        {
+            for (col = start_col; col <= end_col; col++)
+            {
+                index->bin_start[row * index->num_cols + col + 1]++;
+            }
+        }
+    }
+
+    /* Convert the per-bin counts into starting offsets */
+    for (bin = 0; bin < num_bins; bin++)
+    {
+        index->bin_start[bin + 1] += index->bin_start[bin];
+    }
+
+    index->bin_entries = malloc(index->bin_start[num_bins]
+        * sizeof(*index->bin_entries));
+    if (!index->bin_entries)
+    {
+        IAS_LOG_ERROR("Allocating memory for the polygon spatial index");
+        free_polygon_spatial_index(index);
+        return ERROR;
+    }
+
+    /* Second pass: record each polygon in the bins it overlaps.  The
+       bin_start offsets are advanced while filling and restored afterwards
+       by shifting them back one slot. */
+    for (entry = 0; entry < num_polygons; entry++)
+    {
+        int start_row;      /* First latitude bin overlapped */
+        int end_row;        /* Last latitude bin overlapped */
+        int start_col;      /* First longitude bin overlapped */
+        int end_col;        /* Last longitude bin overlapped */
+        int row;            /* Bin row counter */
+        int col;            /* Bin column counter */
+
+        get_polygon_bin_range(index, index->polygons[entry], &start_row,
+            &end_row, &start_col, &end_col);
+        for (row = start_row; row <= end_row; row++)
+        {
+            for (col = start_col; col <= end_col; col++)
+            {
+                bin = row * index->num_cols + col;
+                index->bin_entries[index->bin_start[bin]] = entry;
+                index->bin_start[bin]++;
+            }
+        }
+    }
+
+    for (bin = num_bins; bin > 0; bin--)
+    {
+        index->bin_start[bin] = index->bin_start[bin - 1];
+    }
+    index->bin_start[0] = 0;
+
+    /* Flatten each family's edges, sorted by upper latitude, so the
+       scanline rasterization can carry the active edge set across lines */
+    index->family_state = calloc(num_polygons, sizeof(*index->family_state));
+    if (!index->family_state)
+    {
+        IAS_LOG_ERROR("Allocating memory for the polygon spatial index");
+        free_polygon_spatial_index(index);
+        return ERROR;
+    }
+    for (entry = 0; entry < num_polygons; entry++)
+    {
+        POLYGON_FAMILY_STATE *state = &index->family_state[entry];
+
+        state->num_edges = count_family_edges(index->polygons[entry]);
+        if (state->num_edges == 0)
+            continue;
+
+        state->edges = malloc(state->num_edges * sizeof(*state->edges));
+        state->active = malloc(state->num_edges * sizeof(*state->active));
+        if (!state->edges || !state->active)
+        {
+            IAS_LOG_ERROR("Allocating memory for the family edge state");
+            free_polygon_spatial_index(index);
+            return ERROR;
+        }
+        flatten_family_edges(index->polygons[entry], state->edges, 0);
+        qsort(state->edges, state->num_edges, sizeof(*state->edges),
+            compare_family_edges);
+    }
+
+    *spatial_index = index;
+    return SUCCESS;
+}
+
+/* Destination for the rasterized scanline runs: either a packed bit mask
+   buffer or a run-length encoded run list */
+typedef struct mask_output
+{
+    unsigned char *bit_mask;    /* Packed bit mask buffer, or NULL */
+    IAS_SHAPE_MASK_RLE *rle;    /* Run list to append to, or NULL */
+    unsigned int line;          /* Mask line being rasterized */
+    unsigned int line_offset;   /* Bit offset of the line in the bit mask */
+} MASK_OUTPUT;
+
+/*****************************************************************************
+NAME:  emit_mask_run
+
+PURPOSE:  Send one run of set samples on the current line to the mask
+    output, either setting the bits in the packed buffer or appending the
+    run to the run list.
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion
+ERROR    Operation failed
+
+*****************************************************************************/
+static int emit_mask_run
+(
+    MASK_OUTPUT *output,        /* I/O: Mask output destination */
+    unsigned int first_sample,  /* I: First sample of the run */
+    unsigned int num_samples    /* I: Number of samples in the run */
+)
+{
+    IAS_SHAPE_MASK_RLE *rle = output->rle;  /* Run list shorthand */
+
+    if (output->bit_mask)
+    {
+        espa_bitset_set_run(output->bit_mask,
+            output->line_offset + first_sample, num_samples);
+        return SUCCESS;
+    }
+
+    /* Grow the run list if it is full */
+    if (rle->num_runs == rle->allocated_runs)
+    {
+        unsigned int new_allocated = rle->allocated_runs == 0
+            ? 1024 : rle->allocated_runs * 2;
+        IAS_MASK_RUN *new_runs = realloc(rle->runs,
+            new_allocated * sizeof(*new_runs));
+
+        if (!new_runs)
+        {
+            IAS_LOG_ERROR("Allocating memory for the mask run list");
+            return ERROR;
+        }
+        rle->runs = new_runs;
+        rle->allocated_runs = new_allocated;
+    }
+
+    rle->runs[rle->num_runs].line = output->line;
+    rle->runs[rle->num_runs].start_sample = first_sample;
+    rle->runs[rle->num_runs].num_samples = num_samples;
+    rle->num_runs++;
+
+    return SUCCESS;
+}
+
+/*****************************************************************************
+NAME:  fill_scanline_run
+
+PURPOSE:  Emit the samples whose longitudes fall in the half-open interval
+    [start_long, end_long) to the mask output.  Sample longitudes of 180
+    degrees or more wrap to the -180 domain, so the interval can map to a
+    sample range on each side of the wrapping sample.
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion
+ERROR    Operation failed
+
+*****************************************************************************/
+static int fill_scanline_run
+(
+    double start_long,      /* I: Starting longitude of the run (degrees) */
+    double end_long,        /* I: Ending longitude of the run (degrees) */
+    double upper_left_long, /* I: Longitude of sample zero (degrees) */
+    double delta_longitude, /* I: Change in longitude per sample */
+    unsigned int num_samples,   /* I: Number of samples in the mask line */
+    unsigned int wrap_sample,   /* I: First sample wrapping past 180 */
+    MASK_OUTPUT *output     /* I/O: Mask output destination */
+)
+{
+    int shift;              /* Longitude domain shift loop counter */
+
+    /* Handle the unwrapped samples (shift 0) and the samples wrapped past
+       180 degrees (shift 1), where the sample longitude is 360 less than
+       upper_left_long + sample * delta_longitude */
+    for (shift = 0; shift < 2; shift++)
+    {
+        double offset = shift ? 360.0 : 0.0;
+        unsigned int range_start = shift ? wrap_sample : 0;
+        unsigned int range_end = shift ? num_samples : wrap_sample;
+        double sample_start;    /* First sample covered by the run */
+        double sample_end;      /* First sample past the run */
+        unsigned int first;     /* First sample to fill */
+        unsigned int last;      /* First sample not to fill */
+
+        sample_start = ceil((start_long + offset - upper_left_long)
+            / delta_longitude);
+        sample_end = ceil((end_long + offset - upper_left_long)
+            / delta_longitude);
+
+        if (sample_start < range_start)
+            first = range_start;
+        else if (sample_start > range_end)
+            first = range_end;
+        else
+            first = sample_start;
+
+        if (sample_end < range_start)
+            last = range_start;
+        else if (sample_end > range_end)
+            last = range_end;
+        else
+            last = sample_end;
+
+        if (first < last)
+        {
+            if (emit_mask_run(output, first, last - first) != SUCCESS)
+                return ERROR;
+        }
+    }
+
+    return SUCCESS;
+}
+
+/*****************************************************************************
+NAME:  rasterize_shape_line
+
+PURPOSE:  Rasterize one scanline of the shape mask.  The candidate polygons
+    for the line's latitude are pulled from the spatial index, each parent
+    polygon family's edge state is advanced to the line (which maintains the
+    sorted crossing longitudes incrementally), and the runs of samples
+    between alternating crossings are filled.
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion
+ERROR    Operation failed
+
+*****************************************************************************/
+static int rasterize_shape_line
+(
+    POLYGON_SPATIAL_INDEX *spatial_index, /* I: Polygon spatial index */
+    double latitude,        /* I: Scanline latitude (degrees) */
+    double upper_left_long, /* I: Longitude of sample zero (degrees) */
+    double delta_longitude, /* I: Change in longitude per sample */
+    unsigned int num_samples,   /* I: Number of samples in the mask line */
+    unsigned int wrap_sample,   /* I: First sample wrapping past 180 */
+    MASK_OUTPUT *output     /* I/O: Mask output destination */
+)
+{
+    int row;                /* Latitude bin for the scanline */
+    int col;                /* Longitude bin counter */
+
+    /* Nothing can intersect a scanline outside the indexed latitudes */
+    if (spatial_index->num_polygons == 0 || latitude < spatial_index->min_y
+        || latitude > spatial_index->max_y)
+    {
+        return SUCCESS;
+    }
+
+    /* Advance the query stamp, resetting the visit tracking if the stamp
+       wraps around to zero */
+    spatial_index->visit_stamp++;
+    if (spatial_index->visit_stamp == 0)
+    {
+        memset(spatial_index->last_visit, 0, spatial_index->num_polygons
+            * sizeof(*spatial_index->last_visit));
+        spatial_index->visit_stamp = 1;
+    }
+
+    /* Locate the latitude bin row for the scanline */
+    row = (latitude - spatial_index->min_y) / spatial_index->bin_height;
+    if (row >= spatial_index->num_rows)
+        row = spatial_index->num_rows - 1;
+
+    /* Rasterize every polygon family binned in the scanline's row.  Each
+       family is filled independently so overlapping parent polygons combine
+       as a union instead of cancelling through the shared parity. */
+    for (col = 0; col < spatial_index->num_cols; col++)
+    {
+        int bin = row * spatial_index->num_cols + col;
+        int entry;          /* Bin entry counter */
+
+        for (entry = spatial_index->bin_start[bin];
+             entry < spatial_index->bin_start[bin + 1]; entry++)
+        {
+            IAS_POLYGON_LINKED_LIST *polygon;   /* Candidate polygon */
+            POLYGON_FAMILY_STATE *state;        /* Family edge state */
+            int crossing;       /* Crossing pair counter */
+            int polygon_index = spatial_index->bin_entries[entry];
+
+            /* Skip polygons already rasterized from an earlier bin */
+            if (spatial_index->last_visit[polygon_index]
+                == spatial_index->visit_stamp)
+            {
+                continue;
+            }
+            spatial_index->last_visit[polygon_index]
+                = spatial_index->visit_stamp;
+
+            polygon = spatial_index->polygons[polygon_index];
+
+            /* Check the polygon bounding box against the scanline */
+            if (polygon->min_y > latitude || polygon->max_y < latitude)
+                continue;
+
+            /* Advance the family edge state to this latitude.  Only the
+               edges activating or retiring here are touched and the
+               crossing longitudes come out maintained and sorted, so the
+               lines of a top-to-bottom rasterization share the scan of the
+               family's edge list instead of repeating it, and never pay
+               for an interpolation or a sort per line. */
+            state = &spatial_index->family_state[polygon_index];
+            advance_family_state(state, latitude);
+            if (state->num_active < 2)
+                continue;
+
+            /* Fill the runs between alternating crossings */
+            for (crossing = 0; crossing + 1 < state->num_active;
+                 crossing += 2)
+            {
+                if (fill_scanline_run(
+                    state->edges[state->active[crossing]].current_x,
+                    state->edges[state->active[crossing + 1]].current_x,
+                    upper_left_long, delta_longitude, num_samples,
+                    wrap_sample, output) != SUCCESS)
+                {
+                    return ERROR;
+                }
+            }
+        }
+    }
+
+    return SUCCESS;
+}
+
+/*****************************************************************************
+NAME:  generate_shape_mask
+
+PURPOSE:  Generate a shape mask for a geographic region from a set of
+          polygons, sending the rasterized runs to the provided mask output.
+          The output destination determines whether the runs set bits in a
+          packed buffer or accumulate in a run list.  When the cache's
+          coverage summary shows the whole region is land or water, the
+          constant mask is emitted directly and the polygons are never
+          loaded.  The cooperative cancellation flag is polled at
+          each line boundary so a preempted job unwinds cleanly.
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion
+ERROR    Operation failed
+
+*****************************************************************************/
+static int generate_shape_mask
+(
+    const char *polygon_file,   /* I: Polygon filename */
+    unsigned int num_lines,     /* I: Number of lines in mask */
+    unsigned int num_samples,   /* I: Number of samples in mask */
+    double upper_left_lat,      /* I: Upper left latitude for mask */
+    double lower_right_lat,     /* I: Lower right latitude for mask */
+    double upper_left_long,     /* I: Upper left longitude for mask */
+    double lower_right_long,    /* I: Lower right longitude for mask */
+    MASK_OUTPUT *output         /* I/O: Mask output destination */
+)
+{
+    unsigned int line;          /* Line counter */
+    unsigned int wrap_sample;   /* First sample wrapping past 180 */
+    double wrap_boundary;       /* Sample where the longitude reaches 180 */
+    double delta_latitude;      /* Delta latitude */
+    double delta_longitude;     /* Delta longitude */
+    double tolerance;           /* Polygon simplification tolerance matching
+                                   the mask pixel size */
+    double *point_buffer = NULL;/* Packed polygon vertex buffer */
+    void *cache_map = NULL;     /* Mapped polygon cache file */
+    int64_t cache_length = 0;   /* Mapped polygon cache file length */
+    int loaded_from_cache = 0;  /* Flag that the cache provided the list */
+    char cache_file[PATH_MAX];  /* Polygon cache filename */
+    struct stat polygon_stat;   /* Polygon file information */
+    struct stat cache_stat;     /* Polygon cache file information */
+    IAS_POLYGON_LINKED_LIST *polygon_list; /* Polygon linked list pointer */
+    POLYGON_SPATIAL_INDEX *spatial_index;  /* Spatial index over the list */
+    FILE *fp;                   /* Polygon file pointer */
+
+    /* Determine the mask pixel size and the simplification tolerance
+       matching it.  Vertices deviating less than half a pixel from their
+       chord can't change which pixel a crossing lands in, so they only add
+       crossing-test work. */
+    delta_latitude = (upper_left_lat - lower_right_lat) / num_lines;
+    if (lower_right_long >= upper_left_long)
+    {
+        delta_longitude = (lower_right_long - upper_left_long) / num_samples;
+    }
+    else
+    {
+        delta_longitude = (lower_right_long - upper_left_long + 360) 
+            / num_samples;
+    }
+    tolerance = 0.5 * (delta_latitude < delta_longitude
+        ? delta_latitude : delta_longitude);
+
+    /* Use the preprocessed cache beside the polygon file when it exists and
+       is at least as new as the polygon file */
+    if (snprintf(cache_file, sizeof(cache_file), "%s.cache", polygon_file)
+            < (int)sizeof(cache_file)
+        && stat(polygon_file, &polygon_stat) == 0
+        && stat(cache_file, &cache_stat) == 0
+        && cache_stat.st_mtime >= polygon_stat.st_mtime)
+    {
+        int is_all_land = 0;    /* Region is entirely land */
+        int is_all_water = 0;   /* Region is entirely water */
+
+        /* Check the coverage summary in the cache header first; an
+           open-ocean or deep-interior region produces a constant mask
+           without loading or clipping any polygons */
+        if (ias_geo_polygon_cache_coverage(cache_file, upper_left_long,
+            lower_right_long, lower_right_lat, upper_left_lat,
+            &is_all_land, &is_all_water) == SUCCESS)
+        {
+            if (is_all_water)
+                return SUCCESS;     /* The mask output starts all water */
+
+            if (is_all_land)
+            {
+                /* Emit a full land run for every line of the mask */
+                for (line = 0; line < num_lines; line++)
+                {
+                    output->line = line;
+                    output->line_offset = line * num_samples;
+                    if (emit_mask_run(output, 0, num_samples) != SUCCESS)
+                    {
+                        IAS_LOG_ERROR("Filling mask line %d as land", line);
+                        return ERROR;
+                    }
+                }
+                return SUCCESS;
+            }
+        }
+
+        if (ias_geo_load_polygon_cache(cache_file, upper_left_long,
+            lower_right_long, lower_right_lat, upper_left_lat, tolerance,
+            &polygon_list, &cache_map, &cache_length) == SUCCESS)
+        {
+            loaded_from_cache = 1;
+        }
+        else
+        {
+            /* An unreadable or outdated cache isn't fatal; fall back to
+               parsing the polygon file */
+            IAS_LOG_WARNING("Loading the polygon cache file %s failed; "
+                "parsing %s instead", cache_file, polygon_file);
+        }
+    }
+
+    if (!loaded_from_cache)
+    {
+        /* Open the polygon file. */
+        if ((fp = fopen(polygon_file, "r")) == NULL)
+        {
+            IAS_LOG_ERROR("Unable to open %s for reading.", polygon_file);
+            return ERROR;
+        }
+
+        /* Load the polygons. */
+        if (ias_geo_load_polygon(fp, upper_left_long, lower_right_long,
+            lower_right_lat, upper_left_lat, &polygon_list) != SUCCESS)
+        {
+            IAS_LOG_ERROR("Loading the polygon file %s", polygon_file);
+            fclose(fp);
+            return ERROR;
+        }
+
+        /* Close the polygon file. */
+        fclose(fp);
+    }
+
+    /* Discard polygons outside the bounding box. */
+    if (ias_geo_reduce_polygon(&polygon_list, upper_left_long, lower_right_long,
+        upper_left_lat, lower_right_lat) != SUCCESS)
+    {
+        IAS_LOG_ERROR("Reducing the polygon");
+        ias_geo_unload_polygon_cache(cache_map, cache_length);
+        return ERROR;
+    }
+
+    /* Thin a freshly parsed list to the mask resolution.  A cache load
+       already provided the simplification level matching the resolution. */
+    if (!loaded_from_cache
+        && ias_geo_simplify_polygon(polygon_list, tolerance) != SUCCESS)
+    {
+        IAS_LOG_ERROR("Simplifying the polygons");
+        ias_geo_free_polygon_linked_list(polygon_list);
+        return ERROR;
+    }
+
+    /* Repack the vertices into one contiguous buffer so the scanline
+       crossing tests walk sequential memory.  The cache already stores the
+       vertices packed, so only a freshly parsed list needs repacking. */
+    if (!loaded_from_cache
+        && ias_geo_pack_polygon_points(polygon_list, &point_buffer) != SUCCESS)
+    {
+        IAS_LOG_ERROR("Packing the polygon vertices");
+        ias_geo_free_polygon_linked_list(polygon_list);
+        return ERROR;
+    }
+
+    /* Build the spatial index over the remaining polygons so each scanline
+       only considers the polygons binned near its latitude */
+    if (build_polygon_spatial_index(polygon_list, &spatial_index) != SUCCESS)
+    {
+        IAS_LOG_ERROR("Building the polygon spatial index");
+        ias_geo_free_polygon_linked_list(polygon_list);
+        free(point_buffer);
+        ias_geo_unload_polygon_cache(cache_map, cache_length);
+        return ERROR;
+    }
+
+    /* Find the first sample whose longitude wraps past 180 degrees */
+    wrap_boundary = ceil((180.0 - upper_left_long) / delta_longitude);
+    if (wrap_boundary < 0)
+        wrap_sample = 0;
+    else if (wrap_boundary > num_samples)
+        wrap_sample = num_samples;
+    else
+        wrap_sample = wrap_boundary;
+
+    /* Rasterize each line of the mask */
+    for (line = 0; line < num_lines; line++)
+    {
+        double latitude = upper_left_lat - delta_latitude * line;
+
+        /* Unwind cleanly at the line boundary if the scheduler asked for
+           a cancellation */
+        if (espa_cancel_requested())
+        {
+            IAS_LOG_ERROR("Mask generation canceled at line %d", line);
+            free_polygon_spatial_index(spatial_index);
+            ias_geo_free_polygon_linked_list(polygon_list);
+            free(point_buffer);
+            ias_geo_unload_polygon_cache(cache_map, cache_length);
+            return ERROR;
+        }
+
+        output->line = line;
+        output->line_offset = line * num_samples;
+        if (rasterize_shape_line(spatial_index, latitude, upper_left_long,
+            delta_longitude, num_samples, wrap_sample, output) != SUCCESS)
+        {
+            IAS_LOG_ERROR("Rasterizing mask line %d", line);
+            free_polygon_spatial_index(spatial_index);
+            ias_geo_free_polygon_linked_list(polygon_list);
+            free(point_buffer);
+            ias_geo_unload_polygon_cache(cache_map, cache_length);
+            return ERROR;
+        }
+    }
+
+    /* Free storage. */
+    free_polygon_spatial_index(spatial_index);
+    ias_geo_free_polygon_linked_list(polygon_list);
+    free(point_buffer);
+    ias_geo_unload_polygon_cache(cache_map, cache_length);
+
+    return SUCCESS;
+}
+
+/*****************************************************************************
+NAME:  ias_geo_shape_mask
+
+PURPOSE:  Generate a mask image (per-bit buffer) based on a set of polygons.
+          Values of zero denote locations outside the polygons, values of one
+          represent locations inside a polygon.
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion
+ERROR    Operation failed
+
+*****************************************************************************/
+int ias_geo_shape_mask
+(
+    const char *polygon_file,   /* I: Polygon filename */
+    unsigned int num_lines,     /* I: Number of lines in mask */
+    unsigned int num_samples,   /* I: Number of samples in mask */
+    double upper_left_lat,      /* I: Upper left latitude for mask */
+    double lower_right_lat,     /* I: Lower right latitude for mask */
+    double upper_left_long,     /* I: Upper left longitude for mask */
+    double lower_right_long,    /* I: Lower right longitude for mask */
+    unsigned char *mask         /* O: Mask buffer */
+)
+{
+    MASK_OUTPUT output;         /* Mask output destination */
+    long long perf_start = espa_perf_start();  /* Instrumentation scope */
+    int status;                 /* Generation status */
+
+    /* Initialize the mask to all zeros. */
+    memset(mask, 0, num_lines * num_samples / 8 + 1);
+
+    output.bit_mask = mask;
+    output.rle = NULL;
+    output.line = 0;
+    output.line_offset = 0;
+
+    status = generate_shape_mask(polygon_file, num_lines, num_samples,
+        upper_left_lat, lower_right_lat, upper_left_long, lower_right_long,
+        &output);
+    if (status == SUCCESS)
+        espa_perf_record("ias_geo_shape_mask", perf_start, 0);
+
+    return status;
+}
+
+/*****************************************************************************
+NAME:  ias_geo_shape_mask_rle
+
+PURPOSE:  Generate a run-length encoded shape mask based on a set of
+          polygons.  The returned run list covers the samples inside the
+          polygons and can be materialized as packed bits or bytes with
+          ias_geo_shape_mask_rle_to_bits/bytes.  Coastal masks are mostly
+          long runs, so the run list is much smaller than a dense buffer.
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion
+ERROR    Operation failed
+
+*****************************************************************************/
+int ias_geo_shape_mask_rle
+(
+    const char *polygon_file,   /* I: Polygon filename */
+    unsigned int num_lines,     /* I: Number of lines in mask */
+    unsigned int num_samples,   /* I: Number of samples in mask */
+    double upper_left_lat,      /* I: Upper left latitude for mask */
+    double lower_right_lat,     /* I: Lower right latitude for mask */
+    double upper_left_long,     /* I: Upper left longitude for mask */
+    double lower_right_long,    /* I: Lower right longitude for mask */
+    IAS_SHAPE_MASK_RLE **mask_rle   /* O: Run-length encoded mask */
+)
+{
+    MASK_OUTPUT output;         /* Mask output destination */
+    IAS_SHAPE_MASK_RLE *rle;    /* Run list being built */
+
+    rle = calloc(1, sizeof(*rle));
+    if (!rle)
+    {
+        IAS_LOG_ERROR("Allocating memory for the run-length encoded mask");
+        return ERROR;
+    }
+    rle->num_lines = num_lines;
+    rle->num_samples = num_samples;
+
+    output.bit_mask = NULL;
+    output.rle = rle;
+    output.line = 0;
+    output.line_offset = 0;
+
+    if (generate_shape_mask(polygon_file, num_lines, num_samples,
+        upper_left_lat, lower_right_lat, upper_left_long, lower_right_long,
+        &output) != SUCCESS)
+    {
+        ias_geo_free_shape_mask_rle(rle);
+        return ERROR;
+    }
+
+    *mask_rle = rle;
+
+    return SUCCESS;
+}
+
+/*****************************************************************************
+NAME:  ias_geo_shape_mask_rle_to_bits
+
+PURPOSE:  Materialize a run-length encoded shape mask into a packed per-bit
+          mask buffer.  The buffer must be sized for the run list's mask
+          dimensions (num_lines * num_samples / 8 + 1 bytes).
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion
+ERROR    Operation failed
+
+*****************************************************************************/
+int ias_geo_shape_mask_rle_to_bits
+(
+    const IAS_SHAPE_MASK_RLE *mask_rle, /* I: Run-length encoded mask */
+    unsigned char *mask         /* O: Mask buffer (per-bit) */
+)
+{
+    unsigned int run;           /* Run counter */
+
+    memset(mask, 0, mask_rle->num_lines * mask_rle->num_samples / 8 + 1);
+
+    for (run = 0; run < mask_rle->num_runs; run++)
+    {
+        const IAS_MASK_RUN *mask_run = &mask_rle->runs[run];
+
+        if (mask_run->line >= mask_rle->num_lines
+            || mask_run->start_sample + mask_run->num_samples
+               > mask_rle->num_samples)
+        {
+            IAS_LOG_ERROR("Mask run %d is outside the mask", run);
+            return ERROR;
+        }
+
+        espa_bitset_set_run(mask, (size_t)mask_run->line
+            * mask_rle->num_samples + mask_run->start_sample,
+            mask_run->num_samples);
+    }
+
+    return SUCCESS;
+}
+
+/*****************************************************************************
+NAME:  ias_geo_shape_mask_rle_to_bytes
+
+PURPOSE:  Materialize a run-length encoded shape mask into a per-byte mask
+          buffer, setting the samples inside the mask to the provided value
+          with one memset per run.  The buffer must be sized for the run
+          list's mask dimensions (num_lines * num_samples bytes).
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion
+ERROR    Operation failed
+
+*****************************************************************************/
+int ias_geo_shape_mask_rle_to_bytes
+(
+    const IAS_SHAPE_MASK_RLE *mask_rle, /* I: Run-length encoded mask */
+    unsigned char mask_value,   /* I: Value for samples inside the mask */
+    unsigned char *mask         /* O: Mask buffer (per-byte) */
+)
+{
+    unsigned int run;           /* Run counter */
+
+    memset(mask, 0, (size_t)mask_rle->num_lines * mask_rle->num_samples);
+
+    for (run = 0; run < mask_rle->num_runs; run++)
+    {
+        const IAS_MASK_RUN *mask_run = &mask_rle->runs[run];
+
+        if (mask_run->line >= mask_rle->num_lines
+            || mask_run->start_sample + mask_run->num_samples
+               > mask_rle->num_samples)
+        {
+            IAS_LOG_ERROR("Mask run %d is outside the mask", run);
+            return ERROR;
+        }
+
+        memset(&mask[(size_t)mask_run->line * mask_rle->num_samples
+            + mask_run->start_sample], mask_value, mask_run->num_samples);
+    }
+
+    return SUCCESS;
+}
+
+/*****************************************************************************
+NAME:  ias_geo_free_shape_mask_rle
+
+PURPOSE:  Free a run-length encoded shape mask.
+
+RETURN VALUE:
+Type = void
+
+*****************************************************************************/
+void ias_geo_free_shape_mask_rle
+(
+    IAS_SHAPE_MASK_RLE *mask_rle    /* I: Run-length encoded mask to free */
+)
+{
+    if (mask_rle)
+    {
+        free(mask_rle->runs);
+        free(mask_rle);
+    }
+}
+
+/* Read-only context shared by the grid row workers while generating the
+   projected shape mask.  Each grid row writes a disjoint slice of mask
+   lines, so the workers only share read-only data. */
+typedef struct mask_grid_context
+{
+    const IAS_IMAGE *image;     /* Input image */
+    IAS_GEO_PROJ_TRANSFORMATION *geographic_transformation;
+                                /* Projection to lat/long transformation */
+    double min_lng;             /* Minimum image longitude */
+    double max_lat;             /* Maximum image latitude */
+    double delta_longitude;     /* Change in longitude per mask sample */
+    double delta_latitude;      /* Change in latitude per mask line */
+    int num_horz_grids;         /* Number of horizontal grids for image */
+    int num_vert_grids;         /* Number of vertical grids for image */
+    unsigned int num_lines;     /* Number of lines in passed image */
+    unsigned int num_samples;   /* Number of samples in passed image */
+    const unsigned char *bit_mask;  /* Lat/long bit mask */
+    unsigned char *mask;        /* Output mask buffer */
+} MASK_GRID_CONTEXT;
+
+/*****************************************************************************
+NAME:  classify_mask_block
+
+PURPOSE:  Classifies a block of the projected mask against the lat/long bit
+    mask by transforming the block corners and scanning the bounding box they
+    cover.  A block whose bounding box holds one uniform value does not need
+    per-pixel transforms.
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion; block_value is set to ALL_BITS_SET or
+         NO_BITS_SET for a uniform block, or -1 for a mixed block or a
+         block whose corners fall outside the bit mask
+ERROR    Operation failed
+
+*****************************************************************************/
+static int classify_mask_block
+(
+    const MASK_GRID_CONTEXT *context,   /* I: Shared mask generation context */
+    unsigned int start_line,            /* I: First line of the block */
+    unsigned int block_lines,           /* I: Number of lines in the block */
+    unsigned int start_sample,          /* I: First sample of the block */
+    unsigned int block_samples,         /* I: Number of samples in the block */
+    int *block_value                    /* O: Uniform block value or -1 */
+)
+{
+    const IAS_IMAGE *image = context->image;    /* Input image */
+    const IAS_CORNERS *corners_ptr = &image->corners;   /* Image corners */
+    const unsigned char *bit_mask = context->bit_mask;  /* Lat/long bit mask */
+    unsigned int num_lines = context->num_lines;    /* Lines in image */
+    unsigned int num_samples = context->num_samples;/* Samples in image */
+    IAS_DBL_LS translated_pixel[4];     /* Translated  line/samp */
+    IAS_DBL_XY grid_corners[4];         /* UL LL UR LR */
+    unsigned int line;              /* Loop variable for lines in bit mask */
+    unsigned int sample;            /* Loop variable for samples in bit mask */
+    unsigned int index;             /* Loop variable for generic use */
+    int grid_value;                 /* Uniform value of the bounding box */
+    int min_line = 0;   /* Max line index in bit_mask */
+    int max_line = 0;   /* Min line index in bit_mask */
+    int min_samp = 0;   /* Min sample index in bit_mask */
+    int max_samp = 0;   /* Max sample index in bit_mask */
+    IAS_LNG_LS max_ls;  /* Maximum line/sample */
+    IAS_LNG_LS min_ls;  /* Minimum line/sample */
+
+    *block_value = -1;
+
+    /* Determine corners for the block */
+    grid_corners[0].y = corners_ptr->upleft.y - (start_line
+        * image->pixel_size_y);
+    grid_corners[0].x = (start_sample * image->pixel_size_x)
+        + corners_ptr->upleft.x;
+
+    grid_corners[1].y = grid_corners[0].y - (block_lines
+        * image->pixel_size_y);
+    grid_corners[1].x = grid_corners[0].x;
+
+    grid_corners[2].y = grid_corners[0].y;
+    grid_corners[2].x = grid_corners[0].x + (block_samples
+        * image->pixel_size_x);
+
+    grid_corners[3].y = grid_corners[1].y;
+    grid_corners[3].x = grid_corners[2].x;
+
+    /* Transform the block corners to bit mask line/sample */
+    for (index = 0; index < 4; index++)
+    {
+        int status; /* Status placeholder */
+
+        status = convert_target_xy_to_input_line_sample(
+            &grid_corners[index], context->geographic_transformation,
+            context->min_lng, context->max_lat,
+            context->delta_longitude, context->delta_latitude, num_samples,
+            num_lines, &translated_pixel[index]);
+        if (status == ERROR)
+        {
+            IAS_LOG_ERROR("Translating block corners for block line %d"
+                " sample %d ", start_line, start_sample);
+            return ERROR;
+        }
+        else if (!status)
+        {
+            /* A corner fell outside the bit mask, so the block can not be
+               classified */
+            return SUCCESS;
+        }
+    }
+
+    /* Creating bounding box around bit_mask block */
+    for (index = 1; index < 4; index++)
+    {
+        if (translated_pixel[min_line].line > translated_pixel[index].line)
+        {
+            min_line = index;
+        }
+        else if (translated_pixel[max_line].line
+                 < translated_pixel[index].line)
+        {
+            max_line = index;
+        }
+
+        if (translated_pixel[min_samp].samp > translated_pixel[index].samp)
+        {
+            min_samp = index;
+        }
+        else if (translated_pixel[max_samp].samp
+                 < translated_pixel[index].samp)
+        {
+            max_samp = index;
+        }
+    }
 
-#ifndef HAVE_LITTLE_ENDIAN
-#error("This code does not properly support big endian")
-#endif
+    max_ls.line = translated_pixel[max_line].line + 1;
+    max_ls.samp = translated_pixel[max_samp].samp + 1;
+    min_ls.line = translated_pixel[min_line].line;
+    min_ls.samp = translated_pixel[min_samp].samp;
+
+    /* Make sure the max_ls is still in the image */
+    if (max_ls.line >= num_lines || max_ls.samp >= num_samples)
+    {
+        return SUCCESS;
+    }
+
+    /* Get the bounding box check value */
+    grid_value = bit_mask[(min_ls.line * num_samples + min_ls.samp) / 8];
+    if (grid_value != ALL_BITS_SET && grid_value != NO_BITS_SET)
+    {
+        return SUCCESS;
+    }
+
+    /* Check that all the values in the bounding box are identical */
+    for (line = min_ls.line; line < max_ls.line; line++)
+    {
+        for (sample = min_ls.samp; sample < max_ls.samp; sample += 8)
+        {
+            if (bit_mask[(line * num_samples + sample) / 8] != grid_value)
+            {
+                return SUCCESS;
+            }
+        }
+    }
+
+    *block_value = grid_value;
+    return SUCCESS;
+}
 
 /*****************************************************************************
-NAME:  convert_target_xy_to_input_line_sample
+NAME:  process_mask_pixels
 
-PURPOSE:  Converts an X/Y coordinate to input line/sample and confirms it falls
-    within the image.
+PURPOSE:  Transforms each pixel of a block individually and sets the mask
+    from the lat/long bit mask.  This is the leaf fallback for blocks the
+    hierarchical classification could not prove uniform.
 
 RETURN VALUE:
 Type = int
 Value    Description
 -----    -----------
-TRUE     Pixel in mask
-FALSE    Pixel not in mask
+SUCCESS  Successful completion
 ERROR    Operation failed
 
 *****************************************************************************/
-static int convert_target_xy_to_input_line_sample
+static int process_mask_pixels
 (
-    const IAS_DBL_XY *current_pixel,   /* I: Pixel X/Y coordinate */
-    IAS_GEO_PROJ_TRANSFORMATION *geographic_transformation,/* I: Transformation
-                                                                 Projection */
-    double min_lng,             /* I: Minimum image longitude */
-    double max_lat,             /* I: Maximum image latitude */
-    double delta_longitude,     /* I: Change in longitude from bounding box */
-    double delta_latitude,      /* I: Change in latatiude from bounding box */
-    int num_samples,            /* I: Number of samples in input image */
-    int num_lines,              /* I: Number of lines in input image */
-    IAS_DBL_LS *translated_pixel/* O: Translated to bit mask line/sample */
+    const MASK_GRID_CONTEXT *context,   /* I: Shared mask generation context */
+    unsigned int start_line,            /* I: First line of the block */
+    unsigned int block_lines,           /* I: Number of lines in the block */
+    unsigned int start_sample,          /* I: First sample of the block */
+    unsigned int block_samples          /* I: Number of samples in the block */
 )
 {
-    IAS_DBL_LAT_LONG transformed_pixel; /* Pixel transformed to lat/long */
-   
-    /* Transform the X/Y coordinates to Lat/Long */
-    if (ias_geo_transform_coordinate(geographic_transformation, 
-        current_pixel->x, current_pixel->y, &transformed_pixel.lng, 
-        &transformed_pixel.lat) != SUCCESS)
+    const IAS_IMAGE *image = context->image;    /* Input image */
+    const IAS_CORNERS *corners_ptr = &image->corners;   /* Image corners */
+    const unsigned char *bit_mask = context->bit_mask;  /* Lat/long bit mask */
+    unsigned char *mask = context->mask;        /* Output mask buffer */
+    unsigned int num_lines = context->num_lines;    /* Lines in image */
+    unsigned int num_samples = context->num_samples;/* Samples in image */
+    unsigned int line;              /* Loop variable for lines in image */
+    unsigned int sample;            /* Loop variable for samples in image */
+    unsigned int index;             /* Loop variable for generic use */
+
+    /* Loop through the block converting each pixel to lat/long */
+    for (line = start_line; line < start_line + block_lines; line++)
     {
-        IAS_LOG_ERROR("Converting to lat/long");
-        return ERROR;
+        IAS_DBL_XY current_pixel;/* Current pixel in image using x/y */
+
+        /* Calculate the Y coordinate */
+        current_pixel.y = corners_ptr->upleft.y - (line
+            * image->pixel_size_y);
+
+        for (sample = start_sample; sample < start_sample + block_samples;
+             sample++)
+        {
+            int status; /* Status placeholder */
+            IAS_DBL_LS translated_pixel; /* Translated to line/samp */
+
+            /* Calculate the X Coordinate */
+            current_pixel.x = (sample * image->pixel_size_x)
+                + corners_ptr->upleft.x;
+
+            /* Check if pixel is part of bit mask */
+            status = convert_target_xy_to_input_line_sample(
+                &current_pixel, context->geographic_transformation,
+                context->min_lng, context->max_lat,
+                context->delta_longitude, context->delta_latitude,
+                num_samples, num_lines, &translated_pixel);
+            if (status == ERROR)
+            {
+                IAS_LOG_ERROR("Translating pixel for line %d sample %d",
+                    line, sample);
+                return ERROR;
+            }
+            else if (status)
+            {
+                unsigned int byte; /* Byte level indexing */
+                unsigned int bit;  /* Bit level indexing */
+                int mask_index;
+                int nearest_line = round(translated_pixel.line);
+                int nearest_sample = round(translated_pixel.samp);
+
+                /* Clamp the line to the image after rounding up might
+                   go off the edge */
+                if (nearest_line >= num_lines)
+                    nearest_line = num_lines - 1;
+                if (nearest_sample >= num_samples)
+                    nearest_sample = num_samples - 1;
+
+                mask_index = nearest_line * num_samples + nearest_sample;
+                byte = mask_index / 8;
+                bit = 7 - mask_index % 8;
+                index = line * num_samples + sample;
+                if (bit_mask[byte] & (1 << bit))
+                {
+                    mask[index] = IAS_GEO_SHAPE_MASK_VALID;
+                }
+            }
+        }
     }
-            
-    /* Translate lat/long to mask line/sample */  
-    translated_pixel->samp = (transformed_pixel.lng - min_lng) 
-        / delta_longitude;
-    translated_pixel->line = (max_lat - transformed_pixel.lat) / delta_latitude;
-            
-    /* Check if the line sample falls within the image */
-    if (translated_pixel->line >= 0 && translated_pixel->line < num_lines 
-        && translated_pixel->samp >= 0 && translated_pixel->samp < num_samples)
-    {
-        return TRUE;
-    } 
 
-    return FALSE;
+    return SUCCESS;
 }
 
 /*****************************************************************************
-NAME:  ias_geo_shape_mask
+NAME:  process_mask_block
 
-PURPOSE:  Generate a mask image (per-bit buffer) based on a set of polygons.
-          Values of zero denote locations outside the polygons, values of one
-          represent locations inside a polygon.
+PURPOSE:  Processes a block of the projected mask hierarchically.  Blocks
+    which classify as uniform are filled (or skipped) whole; mixed blocks
+    are split into quadrants and reclassified, so only the blocks straddling
+    a mask boundary descend to per-pixel transforms.
 
 RETURN VALUE:
 Type = int
@@ -93,131 +1632,170 @@ SUCCESS  Successful completion
 ERROR    Operation failed
 
 *****************************************************************************/
-int ias_geo_shape_mask
+static int process_mask_block
 (
-    const char *polygon_file,   /* I: Polygon filename */
-    unsigned int num_lines,     /* I: Number of lines in mask */
-    unsigned int num_samples,   /* I: Number of samples in mask */
-    double upper_left_lat,      /* I: Upper left latitude for mask */
-    double lower_right_lat,     /* I: Lower right latitude for mask */
-    double upper_left_long,     /* I: Upper left longitude for mask */
-    double lower_right_long,    /* I: Lower right longitude for mask */
-    unsigned char *mask         /* O: Mask buffer */
+    const MASK_GRID_CONTEXT *context,   /* I: Shared mask generation context */
+    unsigned int start_line,            /* I: First line of the block */
+    unsigned int block_lines,           /* I: Number of lines in the block */
+    unsigned int start_sample,          /* I: First sample of the block */
+    unsigned int block_samples          /* I: Number of samples in the block */
 )
 {
-    unsigned int line;          /* Line counter */
-    unsigned int index;         /* Generic counter */
-    double delta_latitude;      /* Delta latitude */
-    double delta_longitude;     /* Delta longitude */
-    IAS_POLYGON_LINKED_LIST *polygon_list; /* Polygon linked list pointer */
-    FILE *fp;                   /* Polygon file pointer */
+    unsigned char *mask = context->mask;    /* Output mask buffer */
+    unsigned int num_samples = context->num_samples;/* Samples in image */
+    unsigned int line;              /* Loop variable for lines in image */
+    unsigned int sample;            /* Loop variable for samples in image */
+    unsigned int half_lines;        /* Lines in the upper quadrants */
+    unsigned int half_samples;      /* Samples in the left quadrants */
+    int block_value;                /* Uniform block value or -1 for mixed */
 
-    /* Open the polygon file. */
-    if ((fp = fopen(polygon_file, "r")) == NULL)
+    /* Classify the block against the bit mask */
+    if (classify_mask_block(context, start_line, block_lines, start_sample,
+        block_samples, &block_value) != SUCCESS)
     {
-        IAS_LOG_ERROR("Unable to open %s for reading.", polygon_file);
         return ERROR;
     }
 
-    /* Load the polygons. */
-    if (ias_geo_load_polygon(fp, upper_left_long, lower_right_long,
-        lower_right_lat, upper_left_lat, &polygon_list) != SUCCESS)
+    /* Uniformly empty blocks need no work at all */
+    if (block_value == NO_BITS_SET)
     {
-        IAS_LOG_ERROR("Loading the polygon file %s", polygon_file);
-        fclose(fp);
-        return ERROR;
+        return SUCCESS;
     }
 
-    /* Close the polygon file. */
-    fclose(fp);
-
-    /* Discard polygons outside the bounding box. */
-    if (ias_geo_reduce_polygon(&polygon_list, upper_left_long, lower_right_long,
-        upper_left_lat, lower_right_lat) != SUCCESS)
+    /* Uniformly set blocks are filled without any per-pixel transforms */
+    if (block_value == ALL_BITS_SET)
     {
-        IAS_LOG_ERROR("Reducing the polygon");
-        return ERROR;
+        for (line = start_line; line < start_line + block_lines; line++)
+        {
+            for (sample = start_sample; sample < start_sample + block_samples;
+                 sample++)
+            {
+                mask[line * num_samples + sample] = IAS_GEO_SHAPE_MASK_VALID;
+            }
+        }
+        return SUCCESS;
     }
 
-    /* Initialize the mask to all zeros. */
-    memset(mask, 0, num_lines * num_samples / 8 + 1);
-
-    /* Determine the mask value for each sample location. */
-    delta_latitude = (upper_left_lat - lower_right_lat) / num_lines;
-    if (lower_right_long >= upper_left_long)
+    /* The block is mixed.  Transform per pixel once the block is small;
+       otherwise split it into quadrants and reclassify each one. */
+    if (block_lines <= MASK_BLOCK_MIN_SIZE
+        || block_samples <= MASK_BLOCK_MIN_SIZE)
     {
-        delta_longitude = (lower_right_long - upper_left_long) / num_samples;
+        return process_mask_pixels(context, start_line, block_lines,
+            start_sample, block_samples);
     }
-    else
+
+    half_lines = block_lines / 2;
+    half_samples = block_samples / 2;
+    if (process_mask_block(context, start_line, half_lines, start_sample,
+            half_samples) != SUCCESS
+        || process_mask_block(context, start_line, half_lines,
+            start_sample + half_samples, block_samples - half_samples)
+            != SUCCESS
+        || process_mask_block(context, start_line + half_lines,
+            block_lines - half_lines, start_sample, half_samples) != SUCCESS
+        || process_mask_block(context, start_line + half_lines,
+            block_lines - half_lines, start_sample + half_samples,
+            block_samples - half_samples) != SUCCESS)
     {
-        delta_longitude = (lower_right_long - upper_left_long + 360) 
-            / num_samples;
+        return ERROR;
     }
 
-    /* Loop through each line */
-    for (line = 0, index = 0; line < num_lines; line++)
-    {
-        unsigned int sample;        /* Sample counter */
-        double latitude;            /* Latitude */
+    return SUCCESS;
+}
+
+/*****************************************************************************
+NAME:  process_mask_grid_row
+
+PURPOSE:  Process one row of grid blocks of the projected mask, writing the
+    mask lines covered by the row.  Each block is classified hierarchically:
+    uniform blocks are filled whole, and mixed blocks subdivide into
+    quadrants until only the boundary leaves transform per pixel.
+
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion
+ERROR    Operation failed
 
-        latitude = upper_left_lat - delta_latitude * line;
+*****************************************************************************/
+static int process_mask_grid_row
+(
+    const MASK_GRID_CONTEXT *context,   /* I: Shared mask generation context */
+    int vgrid                           /* I: Grid row to process */
+)
+{
+    int num_horz_grids = context->num_horz_grids;   /* Horizontal grids */
+    int num_vert_grids = context->num_vert_grids;   /* Vertical grids */
+    unsigned int num_lines = context->num_lines;    /* Lines in image */
+    unsigned int num_samples = context->num_samples;/* Samples in image */
+    int hgrid;                      /* Loop variable for current horz grid */
+    int grid_lines = GRID_SIZE_VERT; /* Number of lines in grid */
 
-        /* Loop through each sample */
-        for (sample = 0; sample < num_samples; sample++, index++)
-        {           
-            IAS_POLYGON_LINKED_LIST *polygon_hit;  /* Polygon linked list 
-                                                      pointer */
-            double longitude;           /* Longitude */
-            double distance;            /* Distance from point to polygon */
-            int inside_flag;            /* Inside/Outside polygon flag */
+    /* If it is the end of the image determine smaller grid */
+    if (vgrid == num_vert_grids)
+    {
+        grid_lines = num_lines % GRID_SIZE_VERT;
+        if (grid_lines == 0)
+        {   
+            return SUCCESS;
+        }
+    }
 
-            longitude = upper_left_long + delta_longitude * sample;
+    for (hgrid = 0; hgrid <= num_horz_grids; hgrid++)
+    {
+        int grid_samples = GRID_SIZE_HORZ;  /* Number of samples in grid */
 
-            /* Adjust for 180 crossing. */
-            if (longitude >= 180)
-            {
-                longitude -= 360;
+        /* If it is the end of the image determine smaller grid */
+        if (hgrid == num_horz_grids)
+        {
+            grid_samples = num_samples % GRID_SIZE_HORZ;
+            if (grid_samples == 0)
+            {   
+                continue;
             }
+        }
 
-            /* Initialize the flag and distances */
-            inside_flag = 0;
-            distance = 1e10;
+        /* Process this block hierarchically */
+        if (process_mask_block(context, GRID_SIZE_VERT * vgrid, grid_lines,
+            GRID_SIZE_HORZ * hgrid, grid_samples) != SUCCESS)
+        {
+            IAS_LOG_ERROR("Processing mask block at line %d sample %d",
+                GRID_SIZE_VERT * vgrid, GRID_SIZE_HORZ * hgrid);
+            return ERROR;
+        }
+    }
+    return SUCCESS;
+}
 
-            /* Determine if point is inside the shape */
-            inside_flag = ias_geo_point_in_shape_distance(polygon_list,
-                latitude, longitude, 0, &distance, &polygon_hit);
-            
-            /* Progress down the line using the distance provided by 
-               point_in_shape_distance so we don't have to recalculate
-               distance for each lat/long */
-            while (sample < num_samples && distance > 0)
-            {
-                /* Set bit if point is inside the polygon */
-                if (inside_flag)
-                {
-                    unsigned int byte;  /* Byte level indexing */
-                    unsigned int bit;   /* Bit-level indexing */
-                    byte = index / 8;
-                    bit = 7 - index % 8;
-                    mask[byte] |= 1 << bit;
-                }
-    
-                /* Progress to the next sample and to the next mask
-                   index */
-                sample++;
-                index++;
+/*****************************************************************************
+NAME:  mask_grid_task
 
-                /* Subtract the distance that we change each sample */
-                distance -= delta_longitude;
-            }
+PURPOSE:  Worker pool task which processes one row of grid squares.  The
+    shared transformation handle is only used concurrently when it is a
+    reentrant context-based one, which is immutable after creation; the
+    caller drops to serial processing otherwise.
 
-            sample--;
-            index--;
-        } /* longitude loop */
-    } /* latitude loop */
-    
-    /* Free storage. */
-    ias_geo_free_polygon_linked_list(polygon_list);
+RETURN VALUE:
+Type = int
+Value    Description
+-----    -----------
+SUCCESS  Successful completion
+ERROR    Operation failed
+
+*****************************************************************************/
+static int mask_grid_task
+(
+    void *context_ptr,          /* I: MASK_GRID_CONTEXT for the mask */
+    int vgrid                   /* I: Grid row to process */
+)
+{
+    if (process_mask_grid_row(context_ptr, vgrid) != SUCCESS)
+    {
+        IAS_LOG_ERROR("Processing mask grid row %d", vgrid);
+        return ERROR;
+    }
 
     return SUCCESS;
 }
@@ -234,14 +1812,19 @@ Value    Description
 SUCCESS  Successful completion
 ERROR    Operation failed
 
-NOTES: Mask should already be initialized when passed to the routine. It should 
+NOTES: Mask should already be initialized when passed to the routine. It should
        be initialized with all zeros.
+
+       Each row of grid squares writes a disjoint slice of the mask, so the
+       rows can be processed across a pool of threads when num_threads is
+       greater than one.
 *****************************************************************************/
 int ias_geo_shape_mask_projection
 (
     const char *polygon_file,         /* I: Polygon filename */
     const IAS_IMAGE *image,           /* I: Input image struct pointer */
     const IAS_PROJECTION *projection, /* I: Input projection struct pointer */
+    int num_threads,                  /* I: Number of threads to use */
     unsigned char *mask               /* O: Mask buffer */
 )
 {
@@ -257,13 +1840,10 @@ int ias_geo_shape_mask_projection
     unsigned char *bit_mask = NULL; /* Bit mask */
     int num_horz_grids;             /* Number of horizontal grids for image */
     int num_vert_grids;             /* Number of vertical grids for image */
-    int vgrid;                      /* Loop variable for current vert grid */
-    int hgrid;                      /* Loop variable for current horz grid */
     unsigned int num_lines;         /* Number of lines in passed image */
     unsigned int num_samples;       /* Number of samples in passed image */
-    unsigned int line;              /* Loop variable for lines in image */
-    unsigned int sample;            /* Loop variable for samples in image */
     unsigned int index;             /* Loop variable for generic use */
+    MASK_GRID_CONTEXT context;      /* Shared context for the grid rows */
     double oparm[IAS_PROJ_PARAM_SIZE];/* Output projection parameters */
     IAS_PROJECTION geographic_projection; /* Geographic projection struct */
     IAS_GEO_PROJ_TRANSFORMATION *geographic_transformation; /* Transformation
@@ -401,250 +1981,42 @@ int ias_geo_shape_mask_projection
         / num_lines;
     delta_longitude = (lng[max_lng] - lng[min_lng]) / num_samples;
     
-    /* Loop through the grids */
-    for (vgrid = 0; vgrid <= num_vert_grids; vgrid++)
+    /* Fill in the shared context for processing the grid rows */
+    context.image = image;
+    context.geographic_transformation = geographic_transformation;
+    context.min_lng = lng[min_lng];
+    context.max_lat = corners[max_lat].lat;
+    context.delta_longitude = delta_longitude;
+    context.delta_latitude = delta_latitude;
+    context.num_horz_grids = num_horz_grids;
+    context.num_vert_grids = num_vert_grids;
+    context.num_lines = num_lines;
+    context.num_samples = num_samples;
+    context.bit_mask = bit_mask;
+    context.mask = mask;
+
+    /* The tasks share the one transformation handle, which is only safe
+       for the context-based transformations; a transformation relying on
+       the original gctp global state must process the rows serially */
+    if (num_threads > 1
+        && !ias_geo_transformation_is_threadsafe(geographic_transformation))
     {
-        int grid_lines = GRID_SIZE_VERT; /* Number of lines in grid */
-
-        /* If it is the end of the image determine smaller grid */
-        if (vgrid == num_vert_grids)
-        {
-            grid_lines = num_lines % GRID_SIZE_VERT;
-            if (grid_lines == 0)
-            {   
-                continue;
-            }
-        }
-
-        for (hgrid = 0; hgrid <= num_horz_grids; hgrid++)
-        {
-            IAS_DBL_LS translated_pixel[4];     /* Translated  line/samp */ 
-            IAS_DBL_XY grid_corners[4];         /* UL LL UR LR */
-            int grid_value = -1;                /* Grid match value */
-            int bad_grid = 0;                   /* Boolean for bad grid check */
-            int grid_samples = GRID_SIZE_HORZ;  /* Number of samples in grid */
-
-            /* If it is the end of the image determine smaller grid */
-            if (hgrid == num_horz_grids)
-            {
-                grid_samples = num_samples % GRID_SIZE_HORZ;
-                if (grid_samples == 0)
-                {   
-                    continue;
-                }
-            }
-
-            /* Determine corners for current grid square */
-            grid_corners[0].y = corners_ptr->upleft.y - (GRID_SIZE_VERT 
-                * vgrid * image->pixel_size_y);
-            grid_corners[0].x = (GRID_SIZE_HORZ * hgrid 
-                * image->pixel_size_x) + corners_ptr->upleft.x;
-
-            grid_corners[1].y = grid_corners[0].y - (grid_lines
-                * image->pixel_size_y);
-            grid_corners[1].x = grid_corners[0].x;
-
-            grid_corners[2].y = grid_corners[0].y;
-            grid_corners[2].x = grid_corners[0].x + (grid_samples
-                * image->pixel_size_x);
-
-            grid_corners[3].y = grid_corners[1].y;
-            grid_corners[3].x = grid_corners[2].x;
-            
-            /* Transform the grid corners to bit mask line/sample */
-            for (index = 0; index < 4; index ++)
-            {
-                int status; /* Status placeholder */
-
-                status = convert_target_xy_to_input_line_sample(
-                    &grid_corners[index], geographic_transformation, 
-                    lng[min_lng], corners[max_lat].lat, 
-                    delta_longitude, delta_latitude, num_samples, 
-                    num_lines, &translated_pixel[index]);
-                if (status == ERROR)
-                {
-                    IAS_LOG_ERROR("Translating grid corners for grid line %d"
-                        " sample %d ", vgrid * GRID_SIZE_VERT, hgrid 
-                        * GRID_SIZE_HORZ);
-                    free(bit_mask);
-                    ias_geo_destroy_proj_transformation(
-                        geographic_transformation);
-                    return ERROR;
-                }
-                else if (!status)
-                {
-                    bad_grid = 1;
-                }
-            }
-
-            /* If all corners are in bit_mask check bit_mask grid */
-            if (!bad_grid)
-            {
-                int min_line = 0;   /* Max line index in bit_mask */
-                int max_line = 0;   /* Min line index in bit_mask */
-                int min_samp = 0;   /* Min sample index in bit_mask */
-                int max_samp = 0;   /* Max sample index in bit_mask */
-                IAS_LNG_LS max_ls;  /* Maximum line/sample */
-                IAS_LNG_LS min_ls;  /* Minimum line/sample */
-
-                /* Creating bounding box around bit_mask grid */
-                for (index = 1; index < 4; index++)
-                {
-                    if (translated_pixel[min_line].line
-                        > translated_pixel[index].line)
-                    {
-                        min_line = index;
-                    }
-                    else if (translated_pixel[max_line].line 
-                             < translated_pixel[index].line)
-                    {
-                        max_line = index;
-                    }   
-
-                    if (translated_pixel[min_samp].samp 
-                        > translated_pixel[index].samp)
-                    {    
-                        min_samp = index;
-                    }
-
-                    else if (translated_pixel[max_samp].samp 
-                             < translated_pixel[index].samp)
-                    {    
-                        max_samp = index;
-                    }
-                }
-
-                max_ls.line = translated_pixel[max_line].line + 1;
-                max_ls.samp = translated_pixel[max_samp].samp + 1;
-                min_ls.line = translated_pixel[min_line].line;
-                min_ls.samp = translated_pixel[min_samp].samp;
- 
-                /* Make sure the max_ls is still in the image */
-                if (max_ls.line >= num_lines || max_ls.samp >= num_samples)
-                {
-                    bad_grid = 1;
-                }
-                else
-                {
-                    /* Get the bounding box check value */
-                    grid_value = bit_mask[(min_ls.line * num_samples 
-                        + min_ls.samp) / 8];
-                    if (grid_value != ALL_BITS_SET && grid_value != NO_BITS_SET)
-                    {
-                        bad_grid = 1;
-                    }
-                }
-
-                if (!bad_grid)
-                {
-                    /* Check that all the values in the bounding box are 
-                       identical*/
-                    for (line = min_ls.line; line < max_ls.line; line++)
-                    {
-                        for (sample = min_ls.samp; sample < max_ls.samp; 
-                             sample += 8)
-                        {
-                            int grid_index = (line * num_samples + sample) / 8;
-                            if (bit_mask[grid_index] != grid_value)
-                            {
-                                bad_grid = 1;
-                                break;  
-                            }
-                        }
-
-                        if (bad_grid)
-                        {
-                            break;
-                        }
-                    }
-                }
-            }
-         
-            /* Grid is either all set bits or all empty bits */
-            if (!bad_grid)
-            {
-                if (grid_value == NO_BITS_SET)
-                {
-                    continue;
-                }
-
-                for (line = GRID_SIZE_VERT * vgrid; line < GRID_SIZE_VERT 
-                 * vgrid + grid_lines; line++)
-                {    
-                    for (sample = GRID_SIZE_HORZ * hgrid; sample 
-                        < GRID_SIZE_HORZ * hgrid + grid_samples; sample++)
-                    {
-                        index = line * num_samples + sample;
-                        mask[index] = IAS_GEO_SHAPE_MASK_VALID;
-                    }
-                }
-
-                continue;
-            }
-
-            /* Loop through image converting each pixel to lat/long */
-            for (line = GRID_SIZE_VERT * vgrid; line < GRID_SIZE_VERT 
-                 * vgrid + grid_lines; line++)
-            {    
-                IAS_DBL_XY current_pixel;/* Current pixel in image using x/y */
+        IAS_LOG_WARNING("The projection transformation is not threadsafe, "
+            "so the mask grid rows are processed serially");
+        num_threads = 1;
+    }
 
-                /* Calculate the Y coordinate */
-                current_pixel.y = corners_ptr->upleft.y - (line 
-                    * image->pixel_size_y);
-    
-                for (sample = GRID_SIZE_HORZ * hgrid; sample < GRID_SIZE_HORZ
-                     * hgrid + grid_samples; sample++)
-                {
-                    int status; /* Status placeholder */
-                    IAS_DBL_LS translated_pixel; /* Translated to line/samp */
-
-                    /* Calculate the X Coordinate */
-                    current_pixel.x = (sample * image->pixel_size_x) 
-                        + corners_ptr->upleft.x;
-
-                    /* Check if pixel is part of bit mask */
-                    status = convert_target_xy_to_input_line_sample(
-                        &current_pixel, geographic_transformation, 
-                        lng[min_lng], corners[max_lat].lat, 
-                        delta_longitude, delta_latitude, num_samples, 
-                        num_lines, &translated_pixel);
-                    if (status == ERROR)
-                    {
-                        IAS_LOG_ERROR("Translating pixel for line %d sample %d",
-                            line, sample);
-                        free(bit_mask);
-                        ias_geo_destroy_proj_transformation(
-                            geographic_transformation);
-                        return ERROR;
-                    }
-                    else if (status) 
-                    {
-                        unsigned int byte; /* Byte level indexing */
-                        unsigned int bit;  /* Bit level indexing */
-                        int mask_index;
-                        int nearest_line = round(translated_pixel.line);
-                        int nearest_sample = round(translated_pixel.samp);
-
-                        /* Clamp the line to the image after rounding up might
-                           go off the edge */
-                        if (nearest_line >= num_lines)
-                            nearest_line = num_lines - 1;
-                        if (nearest_sample >= num_samples)
-                            nearest_sample = num_samples - 1;
-
-                        mask_index = nearest_line * num_samples 
-                            + nearest_sample;
-                        byte = mask_index / 8;
-                        bit = 7 - mask_index % 8;
-                        index = line * num_samples + sample;
-                        if (bit_mask[byte] & (1 << bit))
-                        {
-                            mask[index] = IAS_GEO_SHAPE_MASK_VALID;
-                        }
-                    } 
-                }
-            } 
-        }
+    /* Process the grid rows through the shared worker pool.  Each grid row
+       writes a disjoint range of mask lines, so concurrent tasks never
+       write to the same part of the mask.  A num_threads of 1 (or less)
+       processes the rows serially. */
+    if (espa_pool_run(mask_grid_task, &context, num_vert_grids + 1,
+        num_threads) != SUCCESS)
+    {
+        IAS_LOG_ERROR("Processing the mask grid rows");
+        free(bit_mask);
+        ias_geo_destroy_proj_transformation(geographic_transformation);
+        return ERROR;
     }
 
     /* Free memory */
@@ -4,6 +4,7 @@
 #define IAS_LW_GEO_H
 
 #include <stdio.h>
+#include <stdint.h>
 #include "ias_structures.h"
 #include "ias_math.h"
 
@@ -18,6 +19,89 @@
 /* Define shape mask value */
 #define IAS_GEO_SHAPE_MASK_VALID 0x1
 
+/* One run of consecutive set samples on a mask line */
+typedef struct ias_mask_run
+{
+    unsigned int line;          /* Mask line of the run */
+    unsigned int start_sample;  /* First sample of the run */
+    unsigned int num_samples;   /* Number of samples in the run */
+} IAS_MASK_RUN;
+
+/* Run-length encoded shape mask.  The runs are ordered by line and can be
+   materialized as packed bits or as bytes on demand. */
+typedef struct ias_shape_mask_rle
+{
+    unsigned int num_lines;     /* Number of lines in the mask */
+    unsigned int num_samples;   /* Number of samples per mask line */
+    unsigned int num_runs;      /* Number of runs in the list */
+    unsigned int allocated_runs;/* Allocated size of the run list */
+    IAS_MASK_RUN *runs;         /* Runs of set samples */
+} IAS_SHAPE_MASK_RLE;
+
+/* Magic string and version identifying a preprocessed polygon cache file */
+#define IAS_POLYGON_CACHE_MAGIC "IASPCACH"
+#define IAS_POLYGON_CACHE_VERSION 3
+
+/* Maximum number of simplification levels a polygon cache file can hold */
+#define IAS_POLYGON_CACHE_MAX_LEVELS 8
+
+/* Dimensions of the 1-degree coverage summary grid stored in the cache
+   header.  Cell (0, 0) covers longitude [-180, -179) and latitude
+   [-90, -89); cells step east then north. */
+#define IAS_POLYGON_CACHE_COVERAGE_LON_CELLS 360
+#define IAS_POLYGON_CACHE_COVERAGE_LAT_CELLS 180
+#define IAS_POLYGON_CACHE_COVERAGE_BYTES \
+    ((IAS_POLYGON_CACHE_COVERAGE_LON_CELLS \
+      * IAS_POLYGON_CACHE_COVERAGE_LAT_CELLS + 7) / 8)
+
+/* Header of a preprocessed polygon cache file.  The header is followed by
+   one polygon entry table per simplification level, the packed x vertex
+   values, the packed y vertex values, and the packed polygon segments, in
+   that order.  The packed arrays hold the values of every level
+   concatenated in level order, so the entry offsets index the combined
+   arrays. */
+typedef struct ias_polygon_cache_header
+{
+    char magic[8];              /* IAS_POLYGON_CACHE_MAGIC */
+    unsigned int version;       /* IAS_POLYGON_CACHE_VERSION */
+    unsigned int num_polygons;  /* Polygon entries per level, children
+                                   included; every level holds the same
+                                   polygons at a reduced vertex count */
+    int64_t total_points;       /* Total vertices in each packed value array,
+                                   summed over all the levels */
+    int64_t total_segs;         /* Total packed polygon segments */
+    unsigned int num_levels;    /* Number of simplification levels */
+    double tolerances[IAS_POLYGON_CACHE_MAX_LEVELS];
+                                /* Simplification tolerance of each level in
+                                   the polygon coordinate units, in
+                                   increasing order; level 0 is the full
+                                   resolution list with a zero tolerance */
+    unsigned char any_land[IAS_POLYGON_CACHE_COVERAGE_BYTES];
+                                /* 1-degree cell bitmap; a set bit flags a
+                                   cell that may contain some land */
+    unsigned char all_land[IAS_POLYGON_CACHE_COVERAGE_BYTES];
+                                /* 1-degree cell bitmap; a set bit flags a
+                                   cell that is entirely land */
+} IAS_POLYGON_CACHE_HEADER;
+
+/* One polygon in the cache entry table.  The entries are stored in preorder,
+   so every child entry follows its parent. */
+typedef struct ias_polygon_cache_entry
+{
+    unsigned int id;            /* Polygon id */
+    unsigned int num_points;    /* Number of vertices, including the closing
+                                   duplicate of the first vertex */
+    int64_t point_offset;       /* Vertex offset into the packed value arrays */
+    unsigned int num_segs;      /* Number of polygon segment groups */
+    int parent_index;           /* Entry index of the parent polygon, or -1
+                                   for a top level polygon */
+    int64_t seg_offset;         /* Offset into the packed segment array */
+    double min_x;               /* Minimum x bounds */
+    double max_x;               /* Maximum x bounds */
+    double min_y;               /* Minimum y bounds */
+    double max_y;               /* Maximum y bounds */
+} IAS_POLYGON_CACHE_ENTRY;
+
 /* Type defines for projection related structures */
 typedef struct ias_geo_proj_transformation IAS_GEO_PROJ_TRANSFORMATION;
 /* The ias_projection structure matches the gctp_projection structure
@@ -187,6 +271,14 @@ int ias_geo_convert_deg2dms
     const char *check   /* I: Angle usage type (LAT, LON, or DEGREES) */
 );
 
+int ias_geo_convert_deg2dms_array
+(
+    const double *degs,  /* I: Angles in seconds, minutes, or degrees */
+    double *dms,         /* O: Angles converted to DMS */
+    int count,           /* I: Number of angles to convert */
+    const char *check    /* I: Angle usage type (LAT, LON, or DEGREES) */
+);
+
 int ias_geo_convert_dms2deg
 (
     double angle_dms,     /* I: Angle in DMS (DDDMMMSSS) format */
@@ -194,6 +286,14 @@ int ias_geo_convert_dms2deg
     const char *type      /* I: Angle usage type (LAT, LON, or DEGREES) */
 );
 
+int ias_geo_convert_dms2deg_array
+(
+    const double *angles_dms, /* I: Angles in DMS (DDDMMMSSS) format */
+    double *angles_degrees,   /* O: Angles in decimal degrees */
+    int count,                /* I: Number of angles to convert */
+    const char *type          /* I: Angle usage type (LAT, LON, or DEGREES) */
+);
+
 void ias_geo_convert_geod2cart
 (
     double latitude,    /* I: Lat of geodetic coordinates in radians */
@@ -503,6 +603,11 @@ void ias_geo_destroy_proj_transformation
 
 void ias_geo_only_allow_threadsafe_transforms();
 
+int ias_geo_transformation_is_threadsafe
+(
+    const IAS_GEO_PROJ_TRANSFORMATION *trans /* I: transformation to check */
+);
+
 int ias_geo_transform_coordinate
 (
     const IAS_GEO_PROJ_TRANSFORMATION *trans, /* I: transformation to use */
@@ -512,6 +617,19 @@ int ias_geo_transform_coordinate
     double *outy            /* O: Output Y projection coordinate */
 );
 
+int ias_geo_transform_coordinate_batch
+(
+    const IAS_GEO_PROJ_TRANSFORMATION *trans, /* I: transformation to use */
+    int count,              /* I: number of coordinates to transform */
+    const double *inx,      /* I: array of count input X coordinates */
+    const double *iny,      /* I: array of count input Y coordinates */
+    double *outx,           /* O: array of count output X coordinates */
+    double *outy,           /* O: array of count output Y coordinates */
+    unsigned char *failed,  /* O: bitmap of count bits; a set bit flags a
+                                  point that failed to transform */
+    int *failed_count       /* O: number of points that failed */
+);
+
 void ias_geo_set_projection
 (
     int proj_code,          /* I: input projection code */
@@ -549,6 +667,55 @@ int ias_geo_load_polygon
     IAS_POLYGON_LINKED_LIST **head  /* O: Polygon pointer */
 );
 
+int ias_geo_pack_polygon_points
+(
+    IAS_POLYGON_LINKED_LIST *polygon_list,  /* I/O: First polygon in list */
+    double **point_buffer   /* O: Packed vertex buffer to free after the
+                                  polygon list is freed */
+);
+
+int ias_geo_write_polygon_cache
+(
+    const IAS_POLYGON_LINKED_LIST *polygon_list, /* I: First polygon in list */
+    FILE *fp                        /* I: Cache file to write */
+);
+
+int ias_geo_load_polygon_cache
+(
+    const char *cache_file,         /* I: Polygon cache filename */
+    double min_x,                   /* I: Minimum x value of interest */
+    double max_x,                   /* I: Maximum x value of interest */
+    double min_y,                   /* I: Minimum y value of interest */
+    double max_y,                   /* I: Maximum y value of interest */
+    double tolerance,               /* I: Simplification tolerance wanted, in
+                                          the polygon coordinate units; the
+                                          coarsest level not exceeding it is
+                                          loaded, and zero loads the full
+                                          resolution level */
+    IAS_POLYGON_LINKED_LIST **head, /* O: Polygon pointer */
+    void **map_addr,                /* O: Mapped cache file address */
+    int64_t *map_length             /* O: Mapped cache file length */
+);
+
+void ias_geo_unload_polygon_cache
+(
+    void *map_addr,                 /* I: Mapped cache file address */
+    int64_t map_length              /* I: Mapped cache file length */
+);
+
+int ias_geo_polygon_cache_coverage
+(
+    const char *cache_file,         /* I: Polygon cache filename */
+    double min_x,                   /* I: Minimum longitude of interest */
+    double max_x,                   /* I: Maximum longitude of interest; less
+                                          than min_x when the region wraps
+                                          past 180 degrees */
+    double min_y,                   /* I: Minimum latitude of interest */
+    double max_y,                   /* I: Maximum latitude of interest */
+    int *is_all_land,               /* O: Region is entirely land */
+    int *is_all_water               /* O: Region is entirely water */
+);
+
 void ias_geo_free_polygon_linked_list
 (
     IAS_POLYGON_LINKED_LIST *polygon    /* I: First polygon in list */
@@ -563,6 +730,15 @@ int ias_geo_reduce_polygon
     double lower_right_y                    /* I: Lower right y */
 );
 
+int ias_geo_simplify_polygon
+(
+    IAS_POLYGON_LINKED_LIST *polygon_list,  /* I/O: First polygon in list */
+    double tolerance                        /* I: Maximum deviation to allow
+                                                  from the original ring, in
+                                                  the polygon coordinate
+                                                  units */
+);
+
 int ias_geo_shape_mask
 (
     const char *polygon_file,   /* I: Polygon filename */
@@ -575,11 +751,42 @@ int ias_geo_shape_mask
     unsigned char *mask         /* O: Mask buffer */
 );
 
+int ias_geo_shape_mask_rle
+(
+    const char *polygon_file,   /* I: Polygon filename */
+    unsigned int num_lines,     /* I: Number of lines in mask */
+    unsigned int num_samples,   /* I: Number of samples in mask */
+    double upper_left_lat,      /* I: Upper left latitude for mask */
+    double lower_right_lat,     /* I: Lower right latitude for mask */
+    double upper_left_long,     /* I: Upper left longitude for mask */
+    double lower_right_long,    /* I: Lower right longitude for mask */
+    IAS_SHAPE_MASK_RLE **mask_rle   /* O: Run-length encoded mask */
+);
+
+int ias_geo_shape_mask_rle_to_bits
+(
+    const IAS_SHAPE_MASK_RLE *mask_rle, /* I: Run-length encoded mask */
+    unsigned char *mask         /* O: Mask buffer (per-bit) */
+);
+
+int ias_geo_shape_mask_rle_to_bytes
+(
+    const IAS_SHAPE_MASK_RLE *mask_rle, /* I: Run-length encoded mask */
+    unsigned char mask_value,   /* I: Value for samples inside the mask */
+    unsigned char *mask         /* O: Mask buffer (per-byte) */
+);
+
+void ias_geo_free_shape_mask_rle
+(
+    IAS_SHAPE_MASK_RLE *mask_rle    /* I: Run-length encoded mask to free */
+);
+
 int ias_geo_shape_mask_projection
 (
     const char *polygon_file,         /* I: Polygon filename */
     const IAS_IMAGE *image,           /* I: Input image struct pointer */
     const IAS_PROJECTION *projection, /* I: Input projection struct pointer */
+    int num_threads,                  /* I: Number of threads to use */
     unsigned char *mask               /* O: Mask buffer */
 );
 
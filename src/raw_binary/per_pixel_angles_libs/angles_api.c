@@ -125,3 +125,235 @@ int get_frame
 
     return SUCCESS;
 }
+
+/*******************************************************************************
+Name: l8_point_angles
+
+Purpose: Evaluate the satellite and/or solar angles at a list of L1T
+    coordinates for a single band.  Unlike l8_per_pixel_angles, no per-band
+    frames are set up and no angle arrays are allocated, so this is suitable
+    for quick lookups like the scene-center angles written to the global
+    metadata.
+
+Note: The angles are returned in radians, as zenith/azimuth pairs in point
+    order.
+
+Return: SUCCESS / ERROR
+ ******************************************************************************/
+int l8_point_angles
+(
+    char *angle_coeff_name, /* I: Angle coefficient filename */
+    int band_number,        /* I: Band number to evaluate */
+    int num_points,         /* I: Number of point coordinates */
+    const int *lines,       /* I: L1T line coordinate for each point */
+    const int *samps,       /* I: L1T sample coordinate for each point */
+    ANGLE_TYPE angle_type,  /* I: Type of angles to generate */
+    double *sat_angles,     /* O: Satellite zenith/azimuth pair per point
+                                  (radians; not used for AT_SOLAR) */
+    double *sun_angles      /* O: Solar zenith/azimuth pair per point
+                                  (radians; not used for AT_SATELLITE) */
+)
+{
+    IAS_ANGLE_GEN_METADATA metadata; /* Angle metadata structure */
+    int band_index = -1;             /* Metadata band index */
+    int index;                       /* Band/point index */
+
+    /* Validate the requested angle type and output arrays */
+    if (angle_type != AT_BOTH && angle_type != AT_SATELLITE
+        && angle_type != AT_SOLAR)
+    {
+        IAS_LOG_ERROR("Invalid angle type %d", angle_type);
+        return ERROR;
+    }
+    if (angle_type != AT_SOLAR && !sat_angles)
+    {
+        IAS_LOG_ERROR("Satellite angles requested without an output array");
+        return ERROR;
+    }
+    if (angle_type != AT_SATELLITE && !sun_angles)
+    {
+        IAS_LOG_ERROR("Solar angles requested without an output array");
+        return ERROR;
+    }
+
+    /* Read the metadata file, using the binary cache of the parsed ODL
+       file when a previous run has already written one for this scene */
+    if (ias_angle_gen_read_ang_cached(angle_coeff_name, &metadata) != SUCCESS)
+    {
+        IAS_LOG_ERROR("Reading the metadata file %s", angle_coeff_name);
+        return ERROR;
+    }
+
+    /* Find the metadata band index for the requested band number */
+    for (index = 0; index < IAS_MAX_NBANDS; index++)
+    {
+        if (metadata.band_present[index]
+            && metadata.band_metadata[index].band_number == band_number)
+        {
+            band_index = index;
+            break;
+        }
+    }
+    if (band_index < 0)
+    {
+        IAS_LOG_ERROR("Band number %d is not present in the metadata file "
+            "%s", band_number, angle_coeff_name);
+        ias_angle_gen_free(&metadata);
+        return ERROR;
+    }
+
+    /* Evaluate the angles at each of the points.  The unused output array
+       may be NULL, so only index into the arrays that are provided. */
+    for (index = 0; index < num_points; index++)
+    {
+        if (calculate_angles(&metadata, lines[index], samps[index],
+            band_index, angle_type,
+            sat_angles ? &sat_angles[index * 2] : NULL,
+            sun_angles ? &sun_angles[index * 2] : NULL) != SUCCESS)
+        {
+            IAS_LOG_ERROR("Evaluating angles at line %d, sample %d for band "
+                "number %d", lines[index], samps[index], band_number);
+            ias_angle_gen_free(&metadata);
+            return ERROR;
+        }
+    }
+
+    /* Release the metadata */
+    ias_angle_gen_free(&metadata);
+
+    return SUCCESS;
+}
+
+
+/*******************************************************************************
+Name: l8_sample_angles
+
+Purpose: Evaluate the satellite and/or solar angles at a list of sub-pixel
+    L1T coordinates for a list of bands.  Like l8_point_angles, no frames
+    are set up and no angle arrays are allocated, so a handful of points can
+    be sampled in microseconds instead of generating the full angle bands.
+    The coordinates are doubles, so point services can evaluate at exact
+    (fractional) locations instead of the nearest whole pixel.
+
+Note: The angles are returned in radians as zenith/azimuth pairs, ordered
+    by band then point: the pair for band b at point p is at
+    index (b * num_points + p) * 2.
+
+Return: SUCCESS / ERROR
+ ******************************************************************************/
+int l8_sample_angles
+(
+    char *angle_coeff_name,  /* I: Angle coefficient filename */
+    int num_bands,           /* I: Number of bands to evaluate */
+    const int *band_numbers, /* I: Band number for each band */
+    int num_points,          /* I: Number of point coordinates */
+    const double *lines,     /* I: Sub-pixel L1T line for each point */
+    const double *samps,     /* I: Sub-pixel L1T sample for each point */
+    ANGLE_TYPE angle_type,   /* I: Type of angles to generate */
+    double *sat_angles,      /* O: Satellite zenith/azimuth pair per band
+                                   per point (radians; not used for
+                                   AT_SOLAR) */
+    double *sun_angles       /* O: Solar zenith/azimuth pair per band per
+                                   point (radians; not used for
+                                   AT_SATELLITE) */
+)
+{
+    IAS_ANGLE_GEN_METADATA metadata; /* Angle metadata structure */
+    double elev = 0;                 /* Elevation always set at 0 */
+    double *angle_pair;              /* Output slot for the current pair */
+    int outside_image_flag;          /* Outside of image flag */
+    int band_index;                  /* Metadata band index */
+    int band;                        /* Band list index */
+    int point;                       /* Point list index */
+    int index;                       /* Metadata search index */
+
+    /* Validate the requested angle type and output arrays */
+    if (angle_type != AT_BOTH && angle_type != AT_SATELLITE
+        && angle_type != AT_SOLAR)
+    {
+        IAS_LOG_ERROR("Invalid angle type %d", angle_type);
+        return ERROR;
+    }
+    if (angle_type != AT_SOLAR && !sat_angles)
+    {
+        IAS_LOG_ERROR("Satellite angles requested without an output array");
+        return ERROR;
+    }
+    if (angle_type != AT_SATELLITE && !sun_angles)
+    {
+        IAS_LOG_ERROR("Solar angles requested without an output array");
+        return ERROR;
+    }
+
+    /* Read the metadata file, using the binary cache of the parsed ODL
+       file when a previous run has already written one for this scene */
+    if (ias_angle_gen_read_ang_cached(angle_coeff_name, &metadata) != SUCCESS)
+    {
+        IAS_LOG_ERROR("Reading the metadata file %s", angle_coeff_name);
+        return ERROR;
+    }
+
+    /* Evaluate each requested band at each of the points */
+    for (band = 0; band < num_bands; band++)
+    {
+        /* Find the metadata band index for the requested band number */
+        band_index = -1;
+        for (index = 0; index < IAS_MAX_NBANDS; index++)
+        {
+            if (metadata.band_present[index]
+                && metadata.band_metadata[index].band_number
+                    == band_numbers[band])
+            {
+                band_index = index;
+                break;
+            }
+        }
+        if (band_index < 0)
+        {
+            IAS_LOG_ERROR("Band number %d is not present in the metadata "
+                "file %s", band_numbers[band], angle_coeff_name);
+            ias_angle_gen_free(&metadata);
+            return ERROR;
+        }
+
+        for (point = 0; point < num_points; point++)
+        {
+            if (angle_type != AT_SOLAR)
+            {
+                angle_pair = &sat_angles[(band * num_points + point) * 2];
+                if (ias_angle_gen_calculate_angles_rpc(&metadata,
+                    lines[point], samps[point], &elev, band_index,
+                    IAS_ANGLE_GEN_SATELLITE, &outside_image_flag,
+                    angle_pair) != SUCCESS)
+                {
+                    IAS_LOG_ERROR("Evaluating angles at line %f, sample %f "
+                        "for band number %d", lines[point], samps[point],
+                        band_numbers[band]);
+                    ias_angle_gen_free(&metadata);
+                    return ERROR;
+                }
+            }
+
+            if (angle_type != AT_SATELLITE)
+            {
+                angle_pair = &sun_angles[(band * num_points + point) * 2];
+                if (ias_angle_gen_calculate_angles_rpc(&metadata,
+                    lines[point], samps[point], &elev, band_index,
+                    IAS_ANGLE_GEN_SOLAR, &outside_image_flag,
+                    angle_pair) != SUCCESS)
+                {
+                    IAS_LOG_ERROR("Evaluating solar angles at line %f, "
+                        "sample %f for band number %d", lines[point],
+                        samps[point], band_numbers[band]);
+                    ias_angle_gen_free(&metadata);
+                    return ERROR;
+                }
+            }
+        }
+    }
+
+    /* Release the metadata */
+    ias_angle_gen_free(&metadata);
+
+    return SUCCESS;
+}
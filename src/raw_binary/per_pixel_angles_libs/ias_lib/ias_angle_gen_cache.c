@@ -0,0 +1,254 @@
+/* Standard Library Includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* IAS Library Includes */
+#include "ias_logging.h"
+#include "ias_angle_gen_distro.h"
+#include "ias_angle_gen_private.h"
+
+/* Local Defines */
+#define ANGLE_GEN_CACHE_MAGIC 0x414E4743  /* "ANGC" cache file marker */
+#define ANGLE_GEN_CACHE_VERSION 1         /* Cache file format version */
+
+/* Header written at the start of the cache file.  The magic number rejects
+   files that are not caches (or caches written with a different byte order)
+   and the structure size rejects caches written by a build with a different
+   metadata layout. */
+typedef struct angle_gen_cache_header
+{
+    unsigned int magic;     /* Cache file marker */
+    int version;            /* Cache file format version */
+    int metadata_size;      /* sizeof(IAS_ANGLE_GEN_METADATA) when written */
+    int ephem_count;        /* Number of ephemeris/solar vector samples */
+} ANGLE_GEN_CACHE_HEADER;
+
+/*******************************************************************************
+Name: ias_angle_gen_write_cache
+
+Purpose: Writes the parsed angle metadata structure to a binary cache file so
+         later runs against the same scene can load it directly instead of
+         re-parsing the ODL angle coefficient file.
+
+Returns:
+    Type = integer
+    SUCCESS / ERROR
+ ******************************************************************************/
+int ias_angle_gen_write_cache
+(
+    const char *cache_filename,            /* I: Cache file name to write */
+    const IAS_ANGLE_GEN_METADATA *metadata /* I: Metadata structure to cache */
+)
+{
+    FILE *cache_file;                /* Cache file handle */
+    ANGLE_GEN_CACHE_HEADER header;   /* Cache file header */
+    IAS_ANGLE_GEN_METADATA flat;     /* Metadata copy with pointers cleared */
+
+    /* Build the header */
+    header.magic = ANGLE_GEN_CACHE_MAGIC;
+    header.version = ANGLE_GEN_CACHE_VERSION;
+    header.metadata_size = (int)sizeof(IAS_ANGLE_GEN_METADATA);
+    header.ephem_count = metadata->ephem_count;
+
+    /* Copy the metadata and clear the pointer members since the addresses
+       are only meaningful within the writing process.  The ephemeris and
+       solar vector arrays are written after the structure. */
+    flat = *metadata;
+    flat.ephemeris = NULL;
+    flat.solar_vector = NULL;
+    flat.transformation = NULL;
+
+    /* Open the cache file */
+    cache_file = fopen(cache_filename, "wb");
+    if (!cache_file)
+    {
+        IAS_LOG_ERROR("Opening cache file %s for writing", cache_filename);
+        return ERROR;
+    }
+
+    /* Write the header, the flattened structure and the ephemeris arrays */
+    if (fwrite(&header, sizeof(header), 1, cache_file) != 1
+        || fwrite(&flat, sizeof(flat), 1, cache_file) != 1
+        || fwrite(metadata->ephemeris, sizeof(IAS_ANGLE_GEN_EPHEMERIS),
+            metadata->ephem_count, cache_file)
+            != (size_t)metadata->ephem_count
+        || fwrite(metadata->solar_vector, sizeof(IAS_ANGLE_GEN_EPHEMERIS),
+            metadata->ephem_count, cache_file)
+            != (size_t)metadata->ephem_count)
+    {
+        IAS_LOG_ERROR("Writing cache file %s", cache_filename);
+        fclose(cache_file);
+        remove(cache_filename);
+        return ERROR;
+    }
+
+    /* Close the cache file and remove partial output on failure */
+    if (fclose(cache_file) != 0)
+    {
+        IAS_LOG_ERROR("Closing cache file %s", cache_filename);
+        remove(cache_filename);
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+/*******************************************************************************
+Name: ias_angle_gen_read_cache
+
+Purpose: Reads the angle metadata structure from a binary cache file written
+         by ias_angle_gen_write_cache.
+
+Returns:
+    Type = integer
+    SUCCESS / ERROR
+ ******************************************************************************/
+int ias_angle_gen_read_cache
+(
+    const char *cache_filename,      /* I: Cache file name to read */
+    IAS_ANGLE_GEN_METADATA *metadata /* O: Metadata structure to load */
+)
+{
+    FILE *cache_file;                /* Cache file handle */
+    ANGLE_GEN_CACHE_HEADER header;   /* Cache file header */
+
+    /* Open the cache file */
+    cache_file = fopen(cache_filename, "rb");
+    if (!cache_file)
+    {
+        IAS_LOG_ERROR("Opening cache file %s for reading", cache_filename);
+        return ERROR;
+    }
+
+    /* Read and validate the header */
+    if (fread(&header, sizeof(header), 1, cache_file) != 1)
+    {
+        IAS_LOG_ERROR("Reading the header from cache file %s", cache_filename);
+        fclose(cache_file);
+        return ERROR;
+    }
+
+    if (header.magic != ANGLE_GEN_CACHE_MAGIC
+        || header.version != ANGLE_GEN_CACHE_VERSION
+        || header.metadata_size != (int)sizeof(IAS_ANGLE_GEN_METADATA)
+        || header.ephem_count < 1)
+    {
+        IAS_LOG_ERROR("Cache file %s was not written by this version of the "
+            "library", cache_filename);
+        fclose(cache_file);
+        return ERROR;
+    }
+
+    /* Read the flattened structure */
+    if (fread(metadata, sizeof(*metadata), 1, cache_file) != 1)
+    {
+        IAS_LOG_ERROR("Reading the metadata from cache file %s",
+            cache_filename);
+        fclose(cache_file);
+        return ERROR;
+    }
+
+    /* Make sure the structure is consistent with the header and does not
+       carry pointers from the writing process */
+    metadata->ephem_count = header.ephem_count;
+    metadata->ephemeris = NULL;
+    metadata->solar_vector = NULL;
+    metadata->transformation = NULL;
+
+    /* Allocate the ephemeris and solar vector arrays */
+    if (ias_angle_gen_initialize(metadata) != SUCCESS)
+    {
+        IAS_LOG_ERROR("Allocating ephemeris structures");
+        fclose(cache_file);
+        return ERROR;
+    }
+
+    /* Read the ephemeris and solar vector arrays */
+    if (fread(metadata->ephemeris, sizeof(IAS_ANGLE_GEN_EPHEMERIS),
+            metadata->ephem_count, cache_file)
+            != (size_t)metadata->ephem_count
+        || fread(metadata->solar_vector, sizeof(IAS_ANGLE_GEN_EPHEMERIS),
+            metadata->ephem_count, cache_file)
+            != (size_t)metadata->ephem_count)
+    {
+        IAS_LOG_ERROR("Reading the ephemeris data from cache file %s",
+            cache_filename);
+        ias_angle_gen_free(metadata);
+        fclose(cache_file);
+        return ERROR;
+    }
+
+    fclose(cache_file);
+
+    return SUCCESS;
+}
+
+/*******************************************************************************
+Name: ias_angle_gen_read_ang_cached
+
+Purpose: Reads the ANG metadata through a binary cache file kept next to the
+         ODL angle coefficient file.  If the cache exists it is loaded
+         directly; otherwise the ODL file is parsed and the cache is written
+         for the next run against the same scene.  A cache that cannot be
+         written is not an error since the parsed metadata is still valid.
+
+Returns:
+    Type = integer
+    SUCCESS / ERROR
+ ******************************************************************************/
+int ias_angle_gen_read_ang_cached
+(
+    const char *ang_filename,        /* I: Angle file name to read */
+    IAS_ANGLE_GEN_METADATA *metadata /* O: Metadata structure to load */
+)
+{
+    char *cache_filename;       /* Cache file name */
+    size_t name_length;         /* Cache file name length */
+    FILE *cache_file;           /* Cache file handle used for the probe */
+
+    /* Construct the cache file name from the angle file name */
+    name_length = strlen(ang_filename) + strlen(".cache") + 1;
+    cache_filename = malloc(name_length);
+    if (!cache_filename)
+    {
+        IAS_LOG_ERROR("Allocating the cache file name");
+        return ERROR;
+    }
+    snprintf(cache_filename, name_length, "%s.cache", ang_filename);
+
+    /* Load the cache if one is present */
+    cache_file = fopen(cache_filename, "rb");
+    if (cache_file)
+    {
+        fclose(cache_file);
+        if (ias_angle_gen_read_cache(cache_filename, metadata) == SUCCESS)
+        {
+            free(cache_filename);
+            return SUCCESS;
+        }
+
+        /* The cache is stale or corrupt so fall back to the ODL file and
+           rewrite the cache below */
+        IAS_LOG_WARNING("Cache file %s could not be used so re-parsing %s",
+            cache_filename, ang_filename);
+    }
+
+    /* Parse the ODL angle coefficient file */
+    if (ias_angle_gen_read_ang(ang_filename, metadata) != SUCCESS)
+    {
+        free(cache_filename);
+        return ERROR;
+    }
+
+    /* Write the cache for the next run */
+    if (ias_angle_gen_write_cache(cache_filename, metadata) != SUCCESS)
+    {
+        IAS_LOG_WARNING("Writing cache file %s; the parsed metadata is "
+            "still being used", cache_filename);
+    }
+
+    free(cache_filename);
+
+    return SUCCESS;
+}
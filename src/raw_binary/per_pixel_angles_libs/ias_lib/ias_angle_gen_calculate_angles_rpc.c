@@ -1,60 +1,207 @@
 /* Standard Library Includes */
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
 
 /* IAS Library Includes */
 #include "ias_logging.h"
 #include "ias_angle_gen_private.h"
 
+/* Number of polynomial terms shared by the numerator and denominator of the
+   angle rational polynomials.  The numerator constant term and the implicit
+   denominator constant of 1.0 are handled separately. */
+#define NUM_POLY_TERMS (IAS_ANGLE_GEN_ANG_RPC_COEF - 1)
+
+/* Number of single precision vector evaluations that are cross-checked
+   against the double precision path at the start of a run before the
+   single precision mode is trusted for the rest of the run */
+#define RPC_FLOAT_VALIDATE_COUNT 1024
+
+/* Maximum view/sun vector component difference allowed between the single
+   and double precision paths.  A component error of 1.0e-5 bounds the
+   zenith/azimuth error near 1.0e-5 radians, well inside the
+   hundredth-of-a-degree quantization of the angle band outputs. */
+#define RPC_FLOAT_TOLERANCE 1.0e-5
+
+/* Number of single precision evaluations validated so far this run */
+static int rpc_float_validated = 0;
+
+/* Set when a validation failure demotes the run to double precision */
+static int rpc_float_demoted = 0;
+
 /*******************************************************************************
-Name: calculate_rpc_vector_value
+Name: calculate_rpc_poly_terms
+
+Purpose: Calculates the polynomial terms shared by the numerator and
+         denominator of the x/y/z rational polynomials.  The terms only
+         depend on the pixel location, so they are computed once per pixel
+         and reused for all six polynomial evaluations.
 
-Purpose: Calculates the individual vector value used to evaluate the
-         rational polynomial coefficient.
- 
 Return:
     Type = void
  ******************************************************************************/
-static void calculate_rpc_vector_value
+static void calculate_rpc_poly_terms
 (
     double l1t_line,           /* I: L1T line coordinate */
     double l1t_samp,           /* I: L1T sample coordinate */
     double l1r_line,           /* I: L1R line coordinate */
     double l1r_samp,           /* I: L1R sample coordinate */
-    double mean_offset,        /* I: Vector mean offset */
     double height,             /* I: Input height */
-    const double *numerator,   /* I: Numerator values pointer */
-    const double *denominator, /* I: Denominator values pointer */
-    double *output_value       /* O: Output vector value */ 
+    double *terms              /* O: Array of NUM_POLY_TERMS terms */
+)
+{
+    terms[0] = l1t_line;
+    terms[1] = l1t_samp;
+    terms[2] = height;
+    terms[3] = l1r_line;
+    terms[4] = l1t_line * l1t_line;
+    terms[5] = l1t_samp * l1t_line;
+    terms[6] = l1t_samp * l1t_samp;
+    terms[7] = l1r_samp * l1r_line * l1r_line;
+    terms[8] = l1r_line * l1r_line * l1r_line;
+}
+
+/*******************************************************************************
+Name: calculate_rpc_vector_value
+
+Purpose: Calculates the individual vector value used to evaluate the
+         rational polynomial coefficient.  The numerator and denominator
+         share the same polynomial terms, so both are accumulated in a
+         single pass over the coefficients that the compiler can vectorize.
+
+Return:
+    Type = void
+ ******************************************************************************/
+static void calculate_rpc_vector_value
+(
+    const double *terms,       /* I: Array of NUM_POLY_TERMS terms */
+    double mean_offset,        /* I: Vector mean offset */
+    const IAS_ANGLE_GEN_ANG_RPC_TERMS *rpc_terms, /* I: Axis coefficients */
+    double *output_value       /* O: Output vector value */
 )
 {
     double equation_num;    /* Equation numerator */
     double equation_den;    /* Equation denominator */
+    int term;               /* Term index */
+
+    /* Calculate the numerator and denominator */
+    equation_num = rpc_terms->numerator[0];
+    equation_den = 1.0;
+    for (term = 0; term < NUM_POLY_TERMS; term++)
+    {
+        equation_num += rpc_terms->numerator[term + 1] * terms[term];
+        equation_den += rpc_terms->denominator[term] * terms[term];
+    }
 
-    /* Calculate the numerator */
-    equation_num = numerator[0] + numerator[1] * l1t_line
-        + numerator[2] * l1t_samp
-        + numerator[3] * height
-        + numerator[4] * l1r_line
-        + numerator[5] * l1t_line * l1t_line
-        + numerator[6] * l1t_samp * l1t_line 
-        + numerator[7] * l1t_samp * l1t_samp
-        + numerator[8] * l1r_samp * l1r_line * l1r_line
-        + numerator[9] * l1r_line * l1r_line * l1r_line;
-       
-    /* Calculate the denominator */
-    equation_den = 1.0 + denominator[0] * l1t_line
-        + denominator[1] * l1t_samp
-        + denominator[2] * height
-        + denominator[3] * l1r_line 
-        + denominator[4] * l1t_line * l1t_line 
-        + denominator[5] * l1t_line * l1t_samp
-        + denominator[6] * l1t_samp * l1t_samp
-        + denominator[7] * l1r_samp * l1r_line * l1r_line
-        + denominator[8] * l1r_line * l1r_line * l1r_line;
-   
     *output_value = mean_offset + (equation_num / equation_den);
 }
 
+/*******************************************************************************
+Name: rpc_float_mode
+
+Purpose: Checks whether the single precision vector evaluation was requested
+         through the IAS_ANGLE_RPC_FLOAT environment variable.  The mode is
+         selected per run and defaults to the double precision path.
+
+Return:
+    Type = int (0 = double precision, 1 = single precision)
+ ******************************************************************************/
+static int rpc_float_mode(void)
+{
+    static int enabled = -1;   /* cached setting; -1 until first call */
+    const char *value;         /* value of the environment variable */
+
+    if (enabled == -1)
+    {
+        value = getenv("IAS_ANGLE_RPC_FLOAT");
+        enabled = (value != NULL && value[0] != '\0'
+            && strcmp(value, "0") != 0);
+    }
+
+    return enabled;
+}
+
+/*******************************************************************************
+Name: calculate_rpc_vector_value_float
+
+Purpose: Single precision variant of calculate_rpc_vector_value.  The view
+         and sun vectors are unit scale and the outputs are quantized to
+         hundredths of a degree, so accumulating the numerator and
+         denominator in single precision is well within the output accuracy
+         while doubling the SIMD lane width of the vectorized pass.  Only
+         the shared-term accumulation is demoted; the mean offset is applied
+         in double precision.
+
+Return:
+    Type = void
+ ******************************************************************************/
+static void calculate_rpc_vector_value_float
+(
+    const float *terms,        /* I: Array of NUM_POLY_TERMS terms */
+    double mean_offset,        /* I: Vector mean offset */
+    const IAS_ANGLE_GEN_ANG_RPC_TERMS *rpc_terms, /* I: Axis coefficients */
+    double *output_value       /* O: Output vector value */
+)
+{
+    float equation_num;     /* Equation numerator */
+    float equation_den;     /* Equation denominator */
+    int term;               /* Term index */
+
+    /* Calculate the numerator and denominator */
+    equation_num = (float)rpc_terms->numerator[0];
+    equation_den = 1.0f;
+    for (term = 0; term < NUM_POLY_TERMS; term++)
+    {
+        equation_num += (float)rpc_terms->numerator[term + 1] * terms[term];
+        equation_den += (float)rpc_terms->denominator[term] * terms[term];
+    }
+
+    *output_value = mean_offset + (double)(equation_num / equation_den);
+}
+
+/*******************************************************************************
+Name: validate_rpc_float_vector
+
+Purpose: Cross-checks a single precision vector against the double precision
+         path.  The first RPC_FLOAT_VALIDATE_COUNT evaluations of a run are
+         validated; if any component ever differs by more than the stated
+         tolerance the vector is replaced with the double precision result
+         and the rest of the run is demoted to double precision.
+
+Return:
+    Type = void
+ ******************************************************************************/
+static void validate_rpc_float_vector
+(
+    const double *terms,       /* I: Array of NUM_POLY_TERMS terms */
+    const IAS_ANGLE_GEN_ANG_RPC *data_ptr, /* I: Solar or satellite data */
+    IAS_VECTOR *vector         /* I/O: Single precision vector to validate */
+)
+{
+    IAS_VECTOR check;       /* Double precision vector */
+
+    calculate_rpc_vector_value(terms, data_ptr->mean_offset.x,
+        &data_ptr->x_terms, &check.x);
+    calculate_rpc_vector_value(terms, data_ptr->mean_offset.y,
+        &data_ptr->y_terms, &check.y);
+    calculate_rpc_vector_value(terms, data_ptr->mean_offset.z,
+        &data_ptr->z_terms, &check.z);
+
+    if (fabs(check.x - vector->x) > RPC_FLOAT_TOLERANCE
+        || fabs(check.y - vector->y) > RPC_FLOAT_TOLERANCE
+        || fabs(check.z - vector->z) > RPC_FLOAT_TOLERANCE)
+    {
+        IAS_LOG_WARNING("Single precision RPC evaluation exceeded the %g "
+            "vector tolerance; continuing the run in double precision",
+            RPC_FLOAT_TOLERANCE);
+        rpc_float_demoted = 1;
+        *vector = check;
+        return;
+    }
+
+    __sync_fetch_and_add(&rpc_float_validated, 1);
+}
+
 /*******************************************************************************
 Name: ias_angle_gen_calculate_angle_rpc
 
@@ -62,7 +209,11 @@ Purpose: Calculates the satellite viewing and solar illumination zenith and
          azimuth angles for a specified L1T line/sample and height (from DEM)
          using the rational polynomial coefficients for the current band. If
          the SCA location falls in the SCA overlap area it returns the
-         average value of the combined SCAs.
+         average value of the combined SCAs.  Setting IAS_ANGLE_RPC_FLOAT
+         in the environment selects a single precision vector evaluation for
+         the run; the start of the run is validated against the double
+         precision path and the run is demoted back to double precision if
+         the tolerance is ever exceeded.
 
 Return: 
     Type = integer
@@ -144,30 +295,54 @@ int ias_angle_gen_calculate_angles_rpc
     for (sca_index = 0; sca_index < nsca_found; sca_index++)
     {
         IAS_VECTOR vector;          /* Viewing vector */
-        double l1r_line_from_offset;/* L1R line location using offset */        
+        double l1r_line_from_offset;/* L1R line location using offset */
         double l1r_samp_from_offset;/* L1R sample location using offset */
+        double terms[NUM_POLY_TERMS];/* Shared polynomial terms */
 
-        /* Determine the line and sample location using the L1R offset */   
-        l1r_line_from_offset = l1r_line[sca_index] 
+        /* Determine the line and sample location using the L1R offset */
+        l1r_line_from_offset = l1r_line[sca_index]
             - band_ptr->satellite.line_terms.l1r_mean_offset;
-        l1r_samp_from_offset = l1r_samp[sca_index] 
+        l1r_samp_from_offset = l1r_samp[sca_index]
             - band_ptr->satellite.samp_terms.l1r_mean_offset;
 
-        /* Calculate the rpc vector */ 
-        calculate_rpc_vector_value(l1t_line, l1t_samp, l1r_line_from_offset, 
-            l1r_samp_from_offset, data_ptr->mean_offset.x, height, 
-            data_ptr->x_terms.numerator, data_ptr->x_terms.denominator, 
-            &vector.x);
-
-        calculate_rpc_vector_value(l1t_line, l1t_samp, l1r_line_from_offset, 
-            l1r_samp_from_offset, data_ptr->mean_offset.y, height, 
-            data_ptr->y_terms.numerator, data_ptr->y_terms.denominator, 
-            &vector.y);
-
-        calculate_rpc_vector_value(l1t_line, l1t_samp, l1r_line_from_offset, 
-            l1r_samp_from_offset, data_ptr->mean_offset.z, height, 
-            data_ptr->z_terms.numerator, data_ptr->z_terms.denominator, 
-            &vector.z);
+        /* Calculate the polynomial terms once for this location */
+        calculate_rpc_poly_terms(l1t_line, l1t_samp, l1r_line_from_offset,
+            l1r_samp_from_offset, height, terms);
+
+        /* Calculate the rpc vector */
+        if (rpc_float_mode() && !rpc_float_demoted)
+        {
+            float terms_flt[NUM_POLY_TERMS]; /* Single precision terms */
+            int term;                        /* Term index */
+
+            for (term = 0; term < NUM_POLY_TERMS; term++)
+                terms_flt[term] = (float)terms[term];
+
+            calculate_rpc_vector_value_float(terms_flt,
+                data_ptr->mean_offset.x, &data_ptr->x_terms, &vector.x);
+
+            calculate_rpc_vector_value_float(terms_flt,
+                data_ptr->mean_offset.y, &data_ptr->y_terms, &vector.y);
+
+            calculate_rpc_vector_value_float(terms_flt,
+                data_ptr->mean_offset.z, &data_ptr->z_terms, &vector.z);
+
+            /* Validate the start of the run against the double precision
+               path to the stated tolerance */
+            if (rpc_float_validated < RPC_FLOAT_VALIDATE_COUNT)
+                validate_rpc_float_vector(terms, data_ptr, &vector);
+        }
+        else
+        {
+            calculate_rpc_vector_value(terms, data_ptr->mean_offset.x,
+                &data_ptr->x_terms, &vector.x);
+
+            calculate_rpc_vector_value(terms, data_ptr->mean_offset.y,
+                &data_ptr->y_terms, &vector.y);
+
+            calculate_rpc_vector_value(terms, data_ptr->mean_offset.z,
+                &data_ptr->z_terms, &vector.z);
+        }
 
         /* Calculate zenith and azimuth angles */
         angle[IAS_ANGLE_GEN_ZENITH_INDEX] += acos(vector.z);
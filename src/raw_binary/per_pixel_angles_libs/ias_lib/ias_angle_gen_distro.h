@@ -152,6 +152,24 @@ int ias_angle_gen_read_ang
     IAS_ANGLE_GEN_METADATA *metadata /* O: Metadata structure to load */
 );
 
+int ias_angle_gen_read_ang_cached
+(
+    const char *ang_filename,        /* I: Angle file name to read */
+    IAS_ANGLE_GEN_METADATA *metadata /* O: Metadata structure to load */
+);
+
+int ias_angle_gen_read_cache
+(
+    const char *cache_filename,      /* I: Cache file name to read */
+    IAS_ANGLE_GEN_METADATA *metadata /* O: Metadata structure to load */
+);
+
+int ias_angle_gen_write_cache
+(
+    const char *cache_filename,            /* I: Cache file name to write */
+    const IAS_ANGLE_GEN_METADATA *metadata /* I: Metadata structure to cache */
+);
+
 int ias_angle_gen_write_image
 (
     const char *image_filename, /* I: Image file name */
@@ -17,4 +17,11 @@ int ias_geo_convert_dms2deg
     double *angle_degrees,/* O: Angle in decimal degrees */
     const char *type      /* I: Angle usage type (LAT, LON, or DEGREES) */
 );
+int ias_geo_convert_dms2deg_array
+(
+    const double *angles_dms, /* I: Angles in DMS (DDDMMMSSS) format */
+    double *angles_degrees,   /* O: Angles in decimal degrees */
+    int count,                /* I: Number of angles to convert */
+    const char *type          /* I: Angle usage type (LAT, LON, or DEGREES) */
+);
 #endif
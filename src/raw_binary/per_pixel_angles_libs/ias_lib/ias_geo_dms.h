@@ -0,0 +1,125 @@
+#ifndef IAS_GEO_DMS_H
+#define IAS_GEO_DMS_H
+
+/****************************************************************************
+NAME: ias_geo_dms
+
+PURPOSE: Shared conversion cores between packed DMS (DDDMMMSSS) angles and
+total degrees.  The same math was duplicated between the angle generation
+library and the land/water mask library; both now wrap these inline cores
+so the conversions are implemented (and optimized) once.  The minute and
+second scales are applied with precomputed reciprocals instead of per-call
+divisions since the conversions sit inside per-scene corner loops.
+
+*****************************************************************************/
+
+#include <math.h>
+#include <stdlib.h>
+
+/* Reciprocals of the minute and second scales */
+#define IAS_GEO_DMS_INV_MIN (1.0 / 60.0)
+#define IAS_GEO_DMS_INV_SEC (1.0 / 3600.0)
+
+/****************************************************************************
+NAME: ias_geo_dms2deg_value
+
+PURPOSE: Converts one packed DMS (DDDMMMSSS) angle to total degrees.  The
+bounds checking for the angle usage type stays with the callers.
+
+RETURNS: The angle in decimal degrees
+*****************************************************************************/
+static inline double ias_geo_dms2deg_value
+(
+    double angle_dms      /* I: Angle in DMS (DDDMMMSSS) format */
+)
+{
+    float second;     /* Second of DMS angle value */
+    int degree;       /* Degree of DMS angle value */
+    int minute;       /* Minute of DMS angle value */
+    short sign;       /* Sign of the angle */
+
+    if (angle_dms < 0)
+    {
+        sign = -1;
+        angle_dms = angle_dms * -1;
+    }
+    else
+        sign = 1;
+
+    degree = (int) (angle_dms / 1000000);
+    angle_dms = angle_dms - (degree * 1000000);
+    minute = (int) (angle_dms / 1000);
+    second = angle_dms - (minute * 1000);
+
+    return sign * (degree + (minute * IAS_GEO_DMS_INV_MIN) +
+        (second * IAS_GEO_DMS_INV_SEC));
+}
+
+/****************************************************************************
+NAME: ias_geo_deg2dms_value
+
+PURPOSE: Converts one angle in total degrees to packed DMS (DDDMMMSSS).
+Replicates the degree/minute/second extraction of the ias_geo_find_deg,
+ias_geo_find_min, and ias_geo_find_sec helpers, including the truncation
+of the seconds to 0.001 second.  The bounds checking for the angle usage
+type stays with the callers.
+
+RETURNS: The angle in packed DMS
+*****************************************************************************/
+static inline double ias_geo_deg2dms_value
+(
+    double deg            /* I: Angle in total degrees */
+)
+{
+    double fraction;  /* Fractional degrees of the angle */
+    double tsec;      /* Total seconds in the input angle */
+    double sec;       /* Seconds value used for the rounding checks */
+    int tdeg;         /* Degrees in the input angle */
+    int tmin;         /* Minutes in the input angle */
+    int temp_sec;     /* Seconds truncated to 0.001 second */
+    int sign;         /* Sign of the input angle */
+
+    /* Extract the degree portion of the angle */
+    tdeg = (int) deg;
+    sign = 1;
+    if (tdeg < 0)
+        sign = -1;
+    tdeg = (int) fabs (deg);
+    tmin = (int) ((fabs (deg) - tdeg) * 60.0);
+    sec = (((fabs (deg) - tdeg) * 60.0) - tmin) * 60.0;
+    if (sec >= 60.0)
+        tmin++;
+    if (tmin >= 60)
+        tdeg++;
+    tdeg *= sign;
+
+    /* Extract the minute portion of the angle */
+    fraction = fabs (deg);
+    fraction -= (int) fraction;
+    tmin = (int) (fraction * 60.0);
+    sec = ((fraction * 60.0) - tmin) * 60.0;
+    if (sec > 60.0)
+        tmin++;
+    if (tmin >= 60)
+        tmin -= 60;
+
+    /* Extract the second portion of the angle */
+    tsec = fraction * 60.0;
+    tsec -= (int) tsec;
+    tsec *= 60.0;
+    if (tsec > 60.0)
+        tsec -= 60.0;
+    temp_sec = (int) (tsec * 1000);      /* Truncate to 0.001 sec */
+    tsec = temp_sec / 1000.0;
+
+    /* Find the sign of the angle based on the degrees */
+    sign = 1;
+    if (tdeg < 0)
+        sign = -1;
+
+    /* Calculate DMS from the degree, minutes, seconds values */
+    tdeg = abs (tdeg);
+    return ((tdeg * 1000000) + (tmin * 1000) + tsec) * sign;
+}
+
+#endif
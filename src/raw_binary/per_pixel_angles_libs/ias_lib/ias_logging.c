@@ -35,6 +35,28 @@ static int use_blacklist = 0;                     /* Flag indicates if the
                                                      channel list contains
                                                      disabled channels */
 
+/* Token bucket rate limiting for repeated messages below the ERROR level.
+   The state is kept per thread and per call site so the logging hot path
+   never takes a lock; each thread suppresses its own repeats
+   independently. */
+#define RATE_LIMIT_SITES 16       /* call sites tracked per thread */
+#define RATE_LIMIT_BURST 20.0     /* messages allowed in a burst */
+#define RATE_LIMIT_PER_SECOND 5.0 /* sustained messages allowed per second */
+
+typedef struct rate_limit_site
+{
+    const char *filename;     /* source file of the call site */
+    int line_number;          /* line number of the call site */
+    double tokens;            /* tokens left in the bucket */
+    double last_seconds;      /* time of the last bucket refill */
+    long suppressed;          /* messages suppressed since the last one let
+                                 through */
+} RATE_LIMIT_SITE;
+
+static __thread RATE_LIMIT_SITE rate_limit_sites[RATE_LIMIT_SITES];
+static __thread int rate_limit_victim = 0;  /* slot recycled when the table
+                                               is full */
+
 /*************************************************************************/
 
 /*************************************************************************
@@ -48,7 +70,9 @@ Algorithm References: None
 RETURNS: SUCCESS -- successfully initialized
          ERROR -- error in initialization 
 
-NOTES:
+NOTES: Safe to call more than once; after the first successful call only
+       the program name is updated, so library routines can initialize
+       lazily without redoing the environment setup.
 
 **************************************************************************/
 int ias_log_initialize
@@ -56,6 +80,7 @@ int ias_log_initialize
     const char *log_program_name /* I: name to output with each log message */
 )
 {
+    static int initialized = 0;  /* has the library been initialized? */
     const char *log_level;
     const char *log_channels;
  
@@ -63,6 +88,13 @@ int ias_log_initialize
     strncpy(program_name, log_program_name, sizeof(program_name));
     program_name[sizeof(program_name) - 1] = '\0';
 
+    /* the rest of the setup only depends on the environment and the output
+       stream, so repeated initialization (library routines initializing
+       lazily, batch runs processing many scenes) only updates the program
+       name */
+    if (initialized)
+        return SUCCESS;
+
     if (file_ptr == NULL)
         file_ptr = stdout;        /* set the output pointer to stdout */
     pid = getpid();               /* get current process id */
@@ -128,6 +160,7 @@ int ias_log_initialize
         IAS_LOG_WARNING("Incorrect type or size of buffer for file_ptr");   
     }
 
+    initialized = 1;
     return SUCCESS;
 } 
 
@@ -265,6 +298,102 @@ static int is_channel_enabled
 
 /*************************************************************************
 
+NAME: monotonic_seconds
+
+PURPOSE: Returns a monotonic time in seconds for the rate limiting buckets
+
+RETURNS: Seconds from an arbitrary starting point
+
+**************************************************************************/
+static double monotonic_seconds()
+{
+    struct timespec ts;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+        return 0.0;
+
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1.0e9;
+}
+
+/*************************************************************************
+
+NAME: rate_limit_message
+
+PURPOSE: Applies the per call site token bucket to a message.  Each call
+    site starts with a full burst of tokens which refill at the sustained
+    rate, so occasional messages always pass while a message repeated from
+    a tight loop is suppressed once its burst is spent.
+
+RETURNS: 1 -- the message should be output; suppressed is set to the number
+             of messages suppressed at this call site since the last one
+             let through
+         0 -- the message should be suppressed
+
+**************************************************************************/
+static int rate_limit_message
+(
+    const char *filename,     /* I: source code file name for the message */
+    int line_number,          /* I: source code line number for the message */
+    long *suppressed          /* O: repeats suppressed since the last
+                                    message let through from this site */
+)
+{
+    RATE_LIMIT_SITE *site = NULL;
+    double now;
+    int index;
+
+    /* Look for the call site in this thread's table */
+    for (index = 0; index < RATE_LIMIT_SITES; index++)
+    {
+        if (rate_limit_sites[index].filename == filename
+            && rate_limit_sites[index].line_number == line_number)
+        {
+            site = &rate_limit_sites[index];
+            break;
+        }
+        if (!site && rate_limit_sites[index].filename == NULL)
+            site = &rate_limit_sites[index];
+    }
+
+    now = monotonic_seconds();
+
+    /* Recycle the oldest slot when the table is full, or claim the empty
+       slot found */
+    if (!site || site->filename != filename
+        || site->line_number != line_number)
+    {
+        if (!site)
+        {
+            site = &rate_limit_sites[rate_limit_victim];
+            rate_limit_victim = (rate_limit_victim + 1) % RATE_LIMIT_SITES;
+        }
+        site->filename = filename;
+        site->line_number = line_number;
+        site->tokens = RATE_LIMIT_BURST;
+        site->last_seconds = now;
+        site->suppressed = 0;
+    }
+
+    /* Refill the bucket for the time passed since the last refill */
+    site->tokens += (now - site->last_seconds) * RATE_LIMIT_PER_SECOND;
+    if (site->tokens > RATE_LIMIT_BURST)
+        site->tokens = RATE_LIMIT_BURST;
+    site->last_seconds = now;
+
+    if (site->tokens >= 1.0)
+    {
+        site->tokens -= 1.0;
+        *suppressed = site->suppressed;
+        site->suppressed = 0;
+        return 1;
+    }
+
+    site->suppressed++;
+    return 0;
+}
+
+/*************************************************************************
+
 NAME: log_message
 
 PURPOSE: Outputs logging message to the output file pointer
@@ -307,13 +436,35 @@ static void log_message
     /* if log_level is high enough, output the message */
     if (log_level >= ias_log_message_level)
     {
+        char line_buffer[600];  /* complete formatted line */
+        long suppressed = 0;    /* repeats suppressed at this call site */
+        int length;             /* length of the formatted line */
+
+        /* Rate limit everything below the ERROR level so a message
+           repeated from a tight loop can't flood the log */
+        if (log_level < IAS_LOG_LEVEL_ERROR
+            && !rate_limit_message(filename, line_number, &suppressed))
+            return;
+
         /* Set arg_ptr to beginning of list of optional arguments */
         vsnprintf(temp_string, sizeof(temp_string), format, ap);
 
+        /* Format the complete line into a local buffer so it reaches the
+           stream in a single stdio call; concurrent threads then never
+           interleave within a line and take the stream lock only once per
+           message */
         format_time(time_stamp, sizeof(time_stamp),"%F %H:%M:%S");
-        fprintf(file_ptr, "%19s  %s  %7d %-20s  %6d  %s %s\n",
+        length = snprintf(line_buffer, sizeof(line_buffer),
+                "%19s  %s  %7d %-20s  %6d  %s %s",
                 time_stamp, program_name, pid, filename, 
-                line_number, log_level_message[log_level], temp_string);     
+                line_number, log_level_message[log_level], temp_string);
+        if (suppressed > 0 && length > 0
+            && length < (int)sizeof(line_buffer))
+        {
+            snprintf(&line_buffer[length], sizeof(line_buffer) - length,
+                    " (%ld similar messages suppressed)", suppressed);
+        }
+        fprintf(file_ptr, "%s\n", line_buffer);
     }
 }
 
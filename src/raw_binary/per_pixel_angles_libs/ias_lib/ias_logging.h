@@ -29,6 +29,16 @@ Notes on use:
       a '-'  character, the list is treated as a blacklist and all channels
       will be enabled except the listed channels. If IAS_LOG_CHANNELS is not 
       set, all channels are enabled. 
+    - Messages below the level IAS_LOG_COMPILE_LEVEL compiles to are removed
+      entirely at compile time, so hot loops carry no level test or call for
+      them.  Define IAS_LOG_COMPILE_LEVEL (for example
+      -DIAS_LOG_COMPILE_LEVEL=IAS_LOG_LEVEL_INFO to compile out the debug
+      messages) when building; it defaults to IAS_LOG_LEVEL_DEBUG, which
+      keeps every message.
+    - Messages below the ERROR level are rate limited per call site with a
+      token bucket, so a message repeated from a tight loop is suppressed
+      after its burst and the count of suppressed repeats is reported with
+      the next message that is let through.
 
 ****************************************************************************/
 /* Allow GCC to error check the parameters to the ias_log_message routine
@@ -50,6 +60,12 @@ typedef enum IAS_LOG_MESSAGE_LEVEL {
    IAS_LOG_LEVEL_DISABLE  /* disable logging entirely (only used for tests) */
 } IAS_LOG_MESSAGE_LEVEL;
 
+/* Minimum level compiled into the code; messages below this level are
+   removed at compile time.  The default keeps every message. */
+#ifndef IAS_LOG_COMPILE_LEVEL
+#define IAS_LOG_COMPILE_LEVEL IAS_LOG_LEVEL_DEBUG
+#endif
+
 /* Declare the ias_log_message_level variable as an external variable for
    every file except the .c file where is is declared */
 #ifndef LOGGING_C
@@ -90,7 +106,8 @@ void ias_log_message_with_channel
 
 /************************************************************************/
 #define IAS_LOG_DEBUG_ENABLED() \
-    (((IAS_LOG_LEVEL_DEBUG) >= (ias_log_message_level)) ? (1) : (0))
+    (((IAS_LOG_LEVEL_DEBUG) >= (IAS_LOG_COMPILE_LEVEL)) \
+     && ((IAS_LOG_LEVEL_DEBUG) >= (ias_log_message_level)) ? (1) : (0))
 
 /************************************************************************/
 #define IAS_LOG_ERROR(format,...) \
@@ -98,32 +115,37 @@ ias_log_message(IAS_LOG_LEVEL_ERROR,__FILE__,__LINE__,format,##__VA_ARGS__)
 
 /************************************************************************/
 #define IAS_LOG_WARNING(format,...) \
-    if (IAS_LOG_LEVEL_WARN >= ias_log_message_level)          \
+    if (IAS_LOG_LEVEL_WARN >= IAS_LOG_COMPILE_LEVEL           \
+        && IAS_LOG_LEVEL_WARN >= ias_log_message_level)       \
         ias_log_message(IAS_LOG_LEVEL_WARN,__FILE__,__LINE__, \
                         format,##__VA_ARGS__)
 
 /************************************************************************/
 #define IAS_LOG_INFO(format,...) \
-    if (IAS_LOG_LEVEL_INFO >= ias_log_message_level)          \
+    if (IAS_LOG_LEVEL_INFO >= IAS_LOG_COMPILE_LEVEL           \
+        && IAS_LOG_LEVEL_INFO >= ias_log_message_level)       \
         ias_log_message(IAS_LOG_LEVEL_INFO,__FILE__,__LINE__, \
                         format,##__VA_ARGS__)
 
 /************************************************************************/
 #ifndef IAS_LOG_CHANNEL
 #define IAS_LOG_DEBUG(format,...) \
-    if (IAS_LOG_LEVEL_DEBUG >= ias_log_message_level)          \
+    if (IAS_LOG_LEVEL_DEBUG >= IAS_LOG_COMPILE_LEVEL           \
+        && IAS_LOG_LEVEL_DEBUG >= ias_log_message_level)       \
         ias_log_message(IAS_LOG_LEVEL_DEBUG,__FILE__,__LINE__, \
                         format,##__VA_ARGS__) 
 #else
 #define IAS_LOG_DEBUG(format,...) \
-    if (IAS_LOG_LEVEL_DEBUG >= ias_log_message_level)          \
+    if (IAS_LOG_LEVEL_DEBUG >= IAS_LOG_COMPILE_LEVEL           \
+        && IAS_LOG_LEVEL_DEBUG >= ias_log_message_level)       \
         ias_log_message_with_channel(IAS_LOG_LEVEL_DEBUG, IAS_LOG_CHANNEL, \
             __FILE__,__LINE__, format,##__VA_ARGS__) 
 #endif
 
 /************************************************************************/
 #define IAS_LOG_DEBUG_TO_CHANNEL(channel,format,...) \
-    if (IAS_LOG_LEVEL_DEBUG >= ias_log_message_level) \
+    if (IAS_LOG_LEVEL_DEBUG >= IAS_LOG_COMPILE_LEVEL  \
+        && IAS_LOG_LEVEL_DEBUG >= ias_log_message_level) \
         ias_log_message_with_channel(IAS_LOG_LEVEL_DEBUG, channel, \
             __FILE__, __LINE__, format, ##__VA_ARGS__)
 
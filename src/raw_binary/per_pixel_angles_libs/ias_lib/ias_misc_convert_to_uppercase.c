@@ -1,8 +1,8 @@
 /******************************************************************************
 NAME:           ias_misc_convert_to_uppercase
 
-PURPOSE:        
-ias_misc_convert_to_uppercase converts all the lower case characters in a 
+PURPOSE:
+ias_misc_convert_to_uppercase converts all the lower case characters in a
 string to upper case.
 
 RETURN VALUE:
@@ -13,22 +13,57 @@ pointer  Returns a pointer to the string so it can immediately be used as
          a parameter to another function (such as strcmp)
 
 NOTES:
-The original string is converted in place.
+The original string is converted in place.  Eight bytes are converted at a
+time by detecting the lower case range with byte-parallel arithmetic and
+clearing the case bit, instead of calling toupper per character.  Bytes
+with the high bit set are left unchanged, matching toupper for the ASCII
+strings the library handles.
 ******************************************************************************/
-#include <ctype.h>              /* toupper prototype */
+#include <stdint.h>             /* uint64_t for the byte-parallel words */
+#include <string.h>             /* strlen/memcpy prototypes */
 #include "ias_miscellaneous.h"
 
-char *ias_misc_convert_to_uppercase 
+char *ias_misc_convert_to_uppercase
 (
     char *string_ptr  /* I/O: pointer to string to convert */
 )
 {
+    const uint64_t all_bytes = 0x0101010101010101ULL; /* 1 in every byte */
     char *c_ptr = string_ptr;
+    size_t length = strlen(string_ptr);
 
-    while (*c_ptr != '\0')
+    /* Convert eight bytes at a time.  A byte has its high bit set in
+       is_lower when it falls in 'a' through 'z'; shifting that bit down
+       to 0x20 and clearing it removes the case bit. */
+    while (length >= 8)
     {
-        *c_ptr = toupper(*c_ptr);
+        uint64_t word;          /* Eight characters of the string */
+        uint64_t heptets;       /* The characters with the high bits clear */
+        uint64_t is_gt_z;       /* High bit set for bytes above 'z' */
+        uint64_t is_ge_a;       /* High bit set for bytes at or above 'a' */
+        uint64_t is_ascii;      /* High bit set for ASCII bytes */
+        uint64_t is_lower;      /* High bit set for lower case bytes */
+
+        memcpy(&word, c_ptr, sizeof(word));
+        heptets = word & (0x7F * all_bytes);
+        is_gt_z = heptets + (0x7F - 'z') * all_bytes;
+        is_ge_a = heptets + (0x80 - 'a') * all_bytes;
+        is_ascii = ~word & (0x80 * all_bytes);
+        is_lower = is_ge_a & ~is_gt_z & is_ascii;
+        word ^= is_lower >> 2;
+        memcpy(c_ptr, &word, sizeof(word));
+
+        c_ptr += 8;
+        length -= 8;
+    }
+
+    /* Convert the remaining characters */
+    while (length > 0)
+    {
+        if (*c_ptr >= 'a' && *c_ptr <= 'z')
+            *c_ptr -= 'a' - 'A';
         c_ptr++;
+        length--;
     }
 
     return string_ptr;
@@ -1,7 +1,26 @@
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "ias_logging.h"
 #include "ias_miscellaneous.h"
 
+/* Local Defines */
+#define TRIM_LUT_CACHE_MAGIC 0x54524C43  /* "TRLC" cache file marker */
+#define TRIM_LUT_CACHE_VERSION 1         /* Cache file format version */
+
+/* Header written at the start of the trim LUT cache file.  The trim box
+   corners and output dimensions key the cache to the frame geometry, so a
+   cache written for a different scene or band is rejected and recomputed. */
+typedef struct trim_lut_cache_header
+{
+    unsigned int magic;     /* Cache file marker */
+    int version;            /* Cache file format version */
+    int output_lines;       /* Number of output lines in the table */
+    int output_samples;     /* Number of output samples the table spans */
+    double line[4];         /* Line trim box the table was built from */
+    double samp[4];         /* Sample trim box the table was built from */
+} TRIM_LUT_CACHE_HEADER;
+
 /******************************************************************************
 NAME: ias_misc_create_output_image_trim_lut
 
@@ -134,3 +153,114 @@ IAS_MISC_LINE_EXTENT *ias_misc_create_output_image_trim_lut
 
     return trim_lut;
 }
+
+/******************************************************************************
+NAME: ias_misc_create_output_image_trim_lut_cached
+
+PURPOSE: Builds the output image trim lookup table through a binary cache
+    file keyed by the frame geometry.  If a cache written for the same trim
+    box and output dimensions exists it is loaded directly; otherwise the
+    table is computed from the scene corner intersections and the cache is
+    written for the next run against the same scene.  A cache that cannot
+    be written is not an error since the computed table is still valid.
+
+RETURNS:
+    Pointer to the lookup table created (same number of entries as output lines
+    in the grid) or NULL if an error occurred.
+
+******************************************************************************/
+IAS_MISC_LINE_EXTENT *ias_misc_create_output_image_trim_lut_cached
+(
+    const char *cache_filename,    /* I: Cache file name for the lookup table */
+    const double *line,            /* I: Line trim box(ul, ur, lr, ll) */
+    const double *samp,            /* I: Sample trim box(ul, ur, lr, ll) */
+    int output_lines,              /* I: Number of lines */
+    int output_samples             /* I: Number of samples */
+)
+{
+    FILE *cache_file;              /* Cache file handle */
+    TRIM_LUT_CACHE_HEADER header;  /* Cache file header */
+    IAS_MISC_LINE_EXTENT *trim_lut;/* Trimming lookup table */
+
+    /* Load the cache if one is present for the same frame geometry */
+    cache_file = fopen(cache_filename, "rb");
+    if (cache_file)
+    {
+        if (fread(&header, sizeof(header), 1, cache_file) == 1
+            && header.magic == TRIM_LUT_CACHE_MAGIC
+            && header.version == TRIM_LUT_CACHE_VERSION
+            && header.output_lines == output_lines
+            && header.output_samples == output_samples
+            && memcmp(header.line, line, sizeof(header.line)) == 0
+            && memcmp(header.samp, samp, sizeof(header.samp)) == 0)
+        {
+            trim_lut = (IAS_MISC_LINE_EXTENT *)malloc(sizeof(*trim_lut)
+                * output_lines);
+            if (!trim_lut)
+            {
+                IAS_LOG_ERROR("Error allocating trimming buffer");
+                fclose(cache_file);
+                return NULL;
+            }
+
+            if (fread(trim_lut, sizeof(*trim_lut), output_lines, cache_file)
+                == (size_t)output_lines)
+            {
+                fclose(cache_file);
+                return trim_lut;
+            }
+
+            /* The cache is truncated so fall back to computing the table
+               and rewrite the cache below */
+            free(trim_lut);
+        }
+
+        fclose(cache_file);
+        IAS_LOG_WARNING("Cache file %s could not be used so recomputing the "
+            "trim lookup table", cache_filename);
+    }
+
+    /* Compute the table from the scene corner intersections */
+    trim_lut = ias_misc_create_output_image_trim_lut(line, samp, output_lines,
+        output_samples);
+    if (!trim_lut)
+    {  /* Error message already logged */
+        return NULL;
+    }
+
+    /* Write the cache for the next run */
+    cache_file = fopen(cache_filename, "wb");
+    if (!cache_file)
+    {
+        IAS_LOG_WARNING("Opening cache file %s for writing; the computed "
+            "table is still being used", cache_filename);
+        return trim_lut;
+    }
+
+    header.magic = TRIM_LUT_CACHE_MAGIC;
+    header.version = TRIM_LUT_CACHE_VERSION;
+    header.output_lines = output_lines;
+    header.output_samples = output_samples;
+    memcpy(header.line, line, sizeof(header.line));
+    memcpy(header.samp, samp, sizeof(header.samp));
+
+    if (fwrite(&header, sizeof(header), 1, cache_file) != 1
+        || fwrite(trim_lut, sizeof(*trim_lut), output_lines, cache_file)
+            != (size_t)output_lines)
+    {
+        IAS_LOG_WARNING("Writing cache file %s; the computed table is still "
+            "being used", cache_filename);
+        fclose(cache_file);
+        remove(cache_filename);
+        return trim_lut;
+    }
+
+    if (fclose(cache_file) != 0)
+    {
+        IAS_LOG_WARNING("Closing cache file %s; the computed table is still "
+            "being used", cache_filename);
+        remove(cache_filename);
+    }
+
+    return trim_lut;
+}
@@ -17,6 +17,14 @@ IAS_MISC_LINE_EXTENT *ias_misc_create_output_image_trim_lut
     int output_lines,           /* I: Number of lines */
     int output_samples          /* I: Number of samples */
 );
+IAS_MISC_LINE_EXTENT *ias_misc_create_output_image_trim_lut_cached
+(
+    const char *cache_filename, /* I: Cache file name for the lookup table */
+    const double *line,         /* I: Line trim box(ul, ur, lr, ll) */
+    const double *samp,         /* I: Sample trim box(ul, ur, lr, ll) */
+    int output_lines,           /* I: Number of lines */
+    int output_samples          /* I: Number of samples */
+);
 int ias_misc_write_envi_header
 (
     const char *image_filename, /* I: Full path name of the image file */
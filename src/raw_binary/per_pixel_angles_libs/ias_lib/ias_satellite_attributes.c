@@ -14,7 +14,29 @@ PURPOSE: Implements the Satellite Attributes library for applications
                                           required headers */
 #include "local_defines.h"
 
-static IAS_SATELLITE_ATTRIBUTES *curr_satellite;
+/* The published satellite attributes.  The attributes are immutable once
+   published (the Landsat 8 tables are static data built at compile time),
+   so threads share the singleton without locks: the pointer is published
+   with a release store and read with an acquire load, and nothing behind
+   it is ever modified. */
+static IAS_SATELLITE_ATTRIBUTES *published_satellite;
+
+/*************************************************************************
+
+NAME: get_current_satellite
+
+PURPOSE: Returns the published satellite attributes with an acquire load,
+         pairing with the release store in ias_sat_attr_initialize so a
+         thread observing the pointer also observes the attributes behind
+         it.
+
+RETURNS: The satellite attributes pointer, or NULL if not initialized.
+
+**************************************************************************/
+static IAS_SATELLITE_ATTRIBUTES *get_current_satellite()
+{
+    return __atomic_load_n(&published_satellite, __ATOMIC_ACQUIRE);
+}
 
 /*************************************************************************
 
@@ -22,7 +44,11 @@ NAME: ias_sat_attr_initialize
 
 PURPOSE: Initializes the attributes for the satellite requested and sets
          that satellite as the default to use for the other routines in the 
-         library.
+         library.  Calling it again for the same satellite is a no-op, and
+         the routine is safe to call from several threads at once: the
+         attributes are immutable and racing initializers for the same
+         satellite publish the same pointer, so parallel band workers can
+         each initialize lazily without per-thread copies or locks.
 
 RETURNS: SUCCESS or ERROR
 
@@ -32,16 +58,33 @@ int ias_sat_attr_initialize
     int satellite_id        /* I: Satellite ID */
 )
 {
+    IAS_SATELLITE_ATTRIBUTES *satellite;
+
+    /* Already published for this satellite, so there is nothing to redo;
+       this lets library routines initialize lazily and batch runs pay the
+       setup once */
+    satellite = get_current_satellite();
+    if (satellite && satellite->satellite_id == satellite_id)
+        return SUCCESS;
+
     /* Do satellite attribute initialization based on satellite ID */
     switch (satellite_id)
     {
         case IAS_L8 :
-            curr_satellite = ias_sat_attr_initialize_landsat8();
-            return SUCCESS;
+            satellite = ias_sat_attr_initialize_landsat8();
+            break;
         default:
             IAS_LOG_ERROR("Unrecognized satellite type");
             return ERROR;
     }
+
+    /* Publish the attributes.  The release store pairs with the acquire
+       load in get_current_satellite, so the publish stays correct for a
+       future satellite whose attributes are built at runtime rather than
+       at compile time. */
+    __atomic_store_n(&published_satellite, satellite, __ATOMIC_RELEASE);
+
+    return SUCCESS;
 }
 
 /*************************************************************************
@@ -56,6 +99,8 @@ RETURNS: The satellite attributes pointer, or NULL if not initialized.
 **************************************************************************/
 const IAS_SATELLITE_ATTRIBUTES *ias_sat_attr_get_attributes()
 {
+    IAS_SATELLITE_ATTRIBUTES *curr_satellite = get_current_satellite();
+
     if (!curr_satellite)
         IAS_LOG_ERROR("Satellite Attributes haven't been initialized");
 
@@ -73,6 +118,8 @@ RETURNS: The satellite ID or ERROR if it is not initialized.
 **************************************************************************/
 IAS_SATELLITE_ID ias_sat_attr_get_satellite_id()
 {
+    IAS_SATELLITE_ATTRIBUTES *curr_satellite = get_current_satellite();
+
     if (!curr_satellite)
     {
         IAS_LOG_ERROR("Satellite Attributes haven't been initialized");
@@ -116,6 +163,8 @@ RETURNS: The satellite ID or ERROR if it is not initialized or the satellite
 **************************************************************************/
 int ias_sat_attr_get_satellite_number()
 {
+    IAS_SATELLITE_ATTRIBUTES *curr_satellite = get_current_satellite();
+
     if (!curr_satellite)
     {
         IAS_LOG_ERROR("Satellite Attributes haven't been initialized");
@@ -142,6 +191,8 @@ RETURNS: The number of sensors or ERROR if it is not initialized.
 **************************************************************************/
 int ias_sat_attr_get_sensor_count()
 {
+    IAS_SATELLITE_ATTRIBUTES *curr_satellite = get_current_satellite();
+
     if (!curr_satellite)
     {
         IAS_LOG_ERROR("Satellite Attributes haven't been initialized");
@@ -163,6 +214,8 @@ RETURNS: The number of normal bands on the satellite
 **************************************************************************/
 int ias_sat_attr_get_normal_band_count()
 {
+    IAS_SATELLITE_ATTRIBUTES *curr_satellite = get_current_satellite();
+
     /* Check whether the Satellite Attributes haven't been initialized */
     if (!curr_satellite)
     {
@@ -186,6 +239,7 @@ int ias_sat_attr_get_sensor_sca_count
     int sensor_id           /* I: sensor ID */
 )
 {
+    IAS_SATELLITE_ATTRIBUTES *curr_satellite = get_current_satellite();
     int band_index;
 
     /* Has the library been initialized? */
@@ -228,7 +282,17 @@ const IAS_BAND_ATTRIBUTES *ias_sat_attr_get_band_attributes
     int band_number             /* I: Band number */
 )
 {
-    int band_index = ias_sat_attr_convert_band_number_to_index(band_number);
+    IAS_SATELLITE_ATTRIBUTES *curr_satellite = get_current_satellite();
+    int band_index;
+
+    /* Check whether the Satellite Attributes haven't been initialized */
+    if (!curr_satellite)
+    {
+        IAS_LOG_ERROR("Satellite Attributes haven't been initialized");
+        return NULL;
+    }
+
+    band_index = ias_sat_attr_convert_band_number_to_index(band_number);
 
     if (band_index == ERROR)
     {
@@ -266,6 +330,7 @@ int ias_sat_attr_get_sensor_band_numbers
                                       in the band number array */
 )
 {
+    IAS_SATELLITE_ATTRIBUTES *curr_satellite = get_current_satellite();
     int band_index;
     int band_count;
 
@@ -335,6 +400,7 @@ int ias_sat_attr_get_any_sensor_band_numbers
                                       in the band number array */
 )
 {
+    IAS_SATELLITE_ATTRIBUTES *curr_satellite = get_current_satellite();
     int band_index;
     int band_count = 0;        /* number of bands matching critera */
 
@@ -388,6 +454,7 @@ int ias_sat_attr_band_classification_matches
                                                       to match */
 )
 {
+    IAS_SATELLITE_ATTRIBUTES *curr_satellite = get_current_satellite();
     int band_index;
 
     /* Check whether the Satellite Attributes haven't been initialized */
@@ -429,7 +496,17 @@ const char *ias_sat_attr_convert_band_number_to_name
     int band_number     /* I: band number to convert to a name */
 )
 {
-    int band_index = ias_sat_attr_convert_band_number_to_index(band_number);
+    IAS_SATELLITE_ATTRIBUTES *curr_satellite = get_current_satellite();
+    int band_index;
+
+    /* Check whether the Satellite Attributes haven't been initialized */
+    if (!curr_satellite)
+    {
+        IAS_LOG_ERROR("Satellite Attributes haven't been initialized");
+        return NULL;
+    }
+
+    band_index = ias_sat_attr_convert_band_number_to_index(band_number);
 
     if (band_index == ERROR)
     {
@@ -455,6 +532,7 @@ int ias_sat_attr_convert_band_name_to_number
     const char *band_name              /* I: Band name to search on */
 )
 {
+    IAS_SATELLITE_ATTRIBUTES *curr_satellite = get_current_satellite();
     int band_index;                    /* Band loop counter */
     int band_number = ERROR;           /* Band number to return,
                                           initialized to the ERROR
@@ -506,6 +584,8 @@ int ias_sat_attr_convert_band_index_to_number
     int band_index      /* I: band index to convert to a number */
 )
 {
+    IAS_SATELLITE_ATTRIBUTES *curr_satellite = get_current_satellite();
+
     /* Check whether the Satellite Attributes haven't been initialized */
     if (!curr_satellite)
     {
@@ -536,6 +616,8 @@ int ias_sat_attr_convert_band_number_to_index
     int band_number     /* I: band number to convert to an index */
 )
 {
+    IAS_SATELLITE_ATTRIBUTES *curr_satellite = get_current_satellite();
+
     /* Check whether the Satellite Attributes haven't been initialized */
     if (!curr_satellite)
     {
@@ -569,6 +651,7 @@ int ias_sat_attr_get_band_number_from_type
     IAS_BAND_TYPE band_type     /* I: band type to convert to a band number */
 )
 {
+    IAS_SATELLITE_ATTRIBUTES *curr_satellite = get_current_satellite();
     int band_index;
     IAS_BAND_ATTRIBUTES *band;
 
@@ -609,7 +692,17 @@ int ias_sat_attr_get_scas_per_band
     int band_number             /* I: Band number */
 )
 {
-    int band_index = ias_sat_attr_convert_band_number_to_index(band_number);
+    IAS_SATELLITE_ATTRIBUTES *curr_satellite = get_current_satellite();
+    int band_index;
+
+    /* Check whether the Satellite Attributes haven't been initialized */
+    if (!curr_satellite)
+    {
+        IAS_LOG_ERROR("Satellite Attributes haven't been initialized");
+        return ERROR;
+    }
+
+    band_index = ias_sat_attr_convert_band_number_to_index(band_number);
 
     if (band_index == ERROR)
     {
@@ -635,7 +728,17 @@ int ias_sat_attr_get_detectors_per_sca
     int band_number             /* I: Band number */
 )
 {
-    int band_index = ias_sat_attr_convert_band_number_to_index(band_number);
+    IAS_SATELLITE_ATTRIBUTES *curr_satellite = get_current_satellite();
+    int band_index;
+
+    /* Check whether the Satellite Attributes haven't been initialized */
+    if (!curr_satellite)
+    {
+        IAS_LOG_ERROR("Satellite Attributes haven't been initialized");
+        return ERROR;
+    }
+
+    band_index = ias_sat_attr_convert_band_number_to_index(band_number);
 
     if (band_index == ERROR)
     {
@@ -662,7 +765,17 @@ int ias_sat_attr_get_lines_per_frame
     int band_number             /* I: Band number */
 )
 {
-    int band_index = ias_sat_attr_convert_band_number_to_index(band_number);
+    IAS_SATELLITE_ATTRIBUTES *curr_satellite = get_current_satellite();
+    int band_index;
+
+    /* Check whether the Satellite Attributes haven't been initialized */
+    if (!curr_satellite)
+    {
+        IAS_LOG_ERROR("Satellite Attributes haven't been initialized");
+        return ERROR;
+    }
+
+    band_index = ias_sat_attr_convert_band_number_to_index(band_number);
 
     if (band_index == ERROR)
     {
@@ -724,6 +837,7 @@ int ias_sat_attr_convert_band_number_to_sensor_band_index
     int band_number
 )
 {
+    IAS_SATELLITE_ATTRIBUTES *curr_satellite = get_current_satellite();
     int band_index;
     int sensor_band_index = 0;
 
@@ -766,6 +880,7 @@ RETURNS: A pointer to a string for the satellite name.  If the satellite ID
 **************************************************************************/
 const char *ias_sat_attr_get_satellite_name()
 {
+    IAS_SATELLITE_ATTRIBUTES *curr_satellite = get_current_satellite();
     static const char *unknown = IAS_SATELLITE_NAME_UNKNOWN;
 
     /* Return "unknown" if satellite attributes are not initialized. */
@@ -789,6 +904,7 @@ IAS_SPECTRAL_TYPE ias_sat_attr_get_spectral_type_from_band_number
     int band_number                    /* I: Current 1-based band number */
 )
 {
+    IAS_SATELLITE_ATTRIBUTES *curr_satellite = get_current_satellite();
     IAS_BAND_ATTRIBUTES *band_attributes = NULL;
     int band_index;
 
@@ -827,11 +943,19 @@ int ias_sat_attr_get_sensor_max_normal_detectors
                                          TIRS */
 )
 {
+    IAS_SATELLITE_ATTRIBUTES *curr_satellite = get_current_satellite();
     int normal_band_list[IAS_MAX_NBANDS];
     int band_count;
     int max_detectors = -1;
     int index;
 
+    /* Check whether the Satellite Attributes haven't been initialized */
+    if (!curr_satellite)
+    {
+        IAS_LOG_ERROR("Satellite Attributes haven't been initialized");
+        return ERROR;
+    }
+
     if (ias_sat_attr_get_sensor_band_numbers(sensor_id, IAS_NORMAL_BAND, 0,
             normal_band_list, IAS_MAX_NBANDS, &band_count) == ERROR)
     {
@@ -885,6 +1009,7 @@ int ias_sat_attr_get_band_name_from_type_and_class
     char *band_name                                /* O: Band name */
 )
 {
+    IAS_SATELLITE_ATTRIBUTES *curr_satellite = get_current_satellite();
     int band_index = 0;
 
     /* Make sure the Satellite Attributes Library has been initialized */
@@ -931,8 +1056,16 @@ IAS_BAND_TYPE ias_sat_attr_get_band_type_from_band_number
     int band_number                   /* I: Current band number */
 )
 {
+    IAS_SATELLITE_ATTRIBUTES *curr_satellite = get_current_satellite();
     int band_index;
 
+    /* Check whether the Satellite Attributes haven't been initialized */
+    if (!curr_satellite)
+    {
+        IAS_LOG_ERROR("Satellite Attributes haven't been initialized");
+        return IAS_UNKNOWN_BAND_TYPE;
+    }
+
     /* Get the corresponding band index */
     band_index = ias_sat_attr_convert_band_number_to_index(band_number);
     if (band_index == ERROR)
@@ -962,8 +1095,16 @@ IAS_SENSOR_ID ias_sat_attr_get_sensor_id_from_band_number
     int band_number                  /* I: Current band number */
 )
 {
+    IAS_SATELLITE_ATTRIBUTES *curr_satellite = get_current_satellite();
     int band_index;
 
+    /* Check whether the Satellite Attributes haven't been initialized */
+    if (!curr_satellite)
+    {
+        IAS_LOG_ERROR("Satellite Attributes haven't been initialized");
+        return IAS_INVALID_SENSOR_ID;
+    }
+
     /* Get the corresponding band index */
     band_index = ias_sat_attr_convert_band_number_to_index(band_number);
     if (band_index == ERROR)
@@ -1047,6 +1188,7 @@ int ias_sat_attr_get_quantization_cal_max
 ***************************************************************************/
 const char *ias_sat_attr_get_satellite_sensor_name()
 {
+    IAS_SATELLITE_ATTRIBUTES *curr_satellite = get_current_satellite();
    static const char *unknown = IAS_SENSOR_NAME_UNKNOWN;
 
    /* Return "unknown" if satellite attributes are not initialized. */
@@ -128,6 +128,9 @@ typedef struct ias_polygon_linked_list
     double max_y;                        /* Maximum y bounds */
     unsigned int num_segs;               /* Number of polygon segment groups */
     IAS_POLYGON_SEGMENT *poly_seg;       /* Array of polygon segment groups */
+    int points_packed;                   /* Non-zero if the vertex arrays point
+                                            into a shared packed buffer owned
+                                            by the caller */
     struct ias_polygon_linked_list *prev;/* Pointer to previous polygon */
     struct ias_polygon_linked_list *next;/* Pointer to next polygon */
     struct ias_polygon_linked_list *child;/* Pointer to linked list of children 
@@ -29,6 +29,10 @@
 /*========================================================================*/
 
 #include "lablib3.h"
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 long odl_message_count = {0};
 
@@ -127,11 +131,18 @@ OBJDESC *OdlParseLabelFile (char *filespec, char *message_fname, MASK expand,
 
 {
     OBJDESC *root = {NULL};
-    
+
+    /* Back the parse tree with a bump arena so the tree is released in
+       one pass by OdlFreeTree; nested parses of expanded sub-labels
+       share the arena of the outermost parse */
+    OdlArenaBegin();
+
     root = (OBJDESC *) OdlParseFile(filespec,NULL,message_fname,NULL,suppress_messages,1,1,0);
     root = (OBJDESC *) OdlExpandLabelFile(root, message_fname, expand,
                                          suppress_messages);
 
+    OdlArenaEnd(root);
+
     return(root);
 
 }  /*  End:  "OdlParseLabelFile"  */
@@ -1024,7 +1035,7 @@ OBJDESC *OdlNewObjDesc (const char *object_class, const char *pre_comment,
 {
     OBJDESC *new_object = {NULL};
 
-    if ((new_object = (OBJDESC *)malloc(sizeof(OBJDESC))) == NULL)
+    if ((new_object = (OBJDESC *)OdlArenaMalloc(sizeof(OBJDESC))) == NULL)
         SayGoodbye()
     else
     {
@@ -1943,7 +1954,7 @@ KEYWORD *OdlNewKwd (char *keyword_name, char *value_text, char *pre_comment,
 {
     KEYWORD *new_keyword = {NULL};
 
-    if ((new_keyword = (KEYWORD *)malloc(sizeof(KEYWORD))) == NULL)
+    if ((new_keyword = (KEYWORD *)OdlArenaMalloc(sizeof(KEYWORD))) == NULL)
         SayGoodbye()
     else
     {
@@ -2459,6 +2470,11 @@ OBJDESC *OdlFreeTree (OBJDESC *object)
 
 #endif
 {
+    /* A tree backed by an arena is released in one pass; the node by node
+       walk below is only needed for trees built outside of a parse */
+    if (object != NULL && OdlArenaFree(object))
+        return(NULL);
+
     if (object != NULL)
     {
         (void)OdlFreeTree(object->first_child);
@@ -3771,6 +3787,10 @@ OBJDESC *OdlParseFile( char *label_fname, FILE *label_fptr,
     char line_comment [TB_MAXLINE + 1];
     char intext [TB_MAXLINE + 1];
     char msgtext [TB_MAXLINE + 1];
+    char *map_base = {NULL};
+    long map_size = {0};
+    long map_offset = {0};
+    long map_file_base = {0};
     long line_number = {0};
     long value_list_line_number = {0};
     long object_count = {0};
@@ -3816,11 +3836,17 @@ OBJDESC *OdlParseFile( char *label_fname, FILE *label_fptr,
     {
         NewString(comment, 1)
 
+        /*  map the rest of the label file into memory so the lines can be
+            fetched from the mapping instead of read one at a time; if the
+            file can't be mapped we fall back to reading it  */
+        OdlMapLabel(l_ptr, &map_base, &map_size, &map_offset, &map_file_base);
+
         /*  Initialize a ROOT object to start the tree  */
         curr_object = root = OdlNewObjDesc("ROOT",(char *)0,(char *)0,(char *)0,(char *)0,label_fname,0,(long)0);
 
         /*  read the label file  */
-        while (! end_found && fgets(intext, TB_MAXLINE, l_ptr))
+        while (! end_found && OdlNextLabelLine(intext, (long)TB_MAXLINE, l_ptr,
+                                               map_base, map_size, &map_offset))
         {
             ++line_number;
 
@@ -4054,6 +4080,14 @@ OBJDESC *OdlParseFile( char *label_fname, FILE *label_fptr,
 
         LemmeGo(comment)
 
+        /*  release the mapping and leave the file positioned after the
+            text that was consumed  */
+        if (map_base != NULL)
+        {
+            (void)fseek(l_ptr, map_file_base + map_offset, SEEK_SET);
+            (void)munmap(map_base, (size_t)map_size);
+        }
+
     }  /*  End:  "if (l_ptr == NULL) ... else ..."  */
 
     /*  how'd we do?  */
@@ -4122,6 +4156,133 @@ OBJDESC *OdlParseFile( char *label_fname, FILE *label_fptr,
 }  /*  End routine:  OdlParseFile  */
 
 
+/*******************/
+/*  Local Routine  */
+/*******************/
+
+/*  Maps the remainder of the label file into memory, starting from the
+    file's current position, so the parser can fetch lines from the mapping
+    instead of making a read call for every line.  map_base is left NULL
+    if the file can't be mapped (e.g., it isn't a regular file), in which
+    case the caller falls back to reading lines.  map_offset is the offset
+    of the current position within the mapping, and map_file_base is the
+    file offset where the mapping begins.  */
+
+#ifdef _NO_PROTO
+
+void OdlMapLabel (label_fptr, map_base, map_size, map_offset, map_file_base)
+
+FILE *label_fptr;
+char **map_base;
+long *map_size;
+long *map_offset;
+long *map_file_base;
+
+#else
+
+void OdlMapLabel (FILE *label_fptr, char **map_base, long *map_size,
+                  long *map_offset, long *map_file_base)
+
+#endif
+{
+    struct stat file_stat;
+    char *base = {NULL};
+    long start = {0};
+    long page_size = {0};
+    int fd = {-1};
+
+    *map_base = NULL;
+    *map_size = 0;
+    *map_offset = 0;
+    *map_file_base = 0;
+
+    fd = fileno(label_fptr);
+    if (fd < 0 || fstat(fd, &file_stat) != 0 || ! S_ISREG(file_stat.st_mode))
+        return;
+
+    start = ftell(label_fptr);
+    if (start < 0 || start >= (long)file_stat.st_size)
+        return;
+
+    /*  the mapping has to begin on a page boundary  */
+    page_size = (long)sysconf(_SC_PAGESIZE);
+    if (page_size <= 0)
+        return;
+
+    *map_file_base = (start / page_size) * page_size;
+
+    base = (char *)mmap(NULL, (size_t)(file_stat.st_size - *map_file_base),
+                        PROT_READ, MAP_PRIVATE, fd, (off_t)*map_file_base);
+    if (base == MAP_FAILED)
+    {
+        *map_file_base = 0;
+        return;
+    }
+
+    *map_base = base;
+    *map_size = (long)file_stat.st_size - *map_file_base;
+    *map_offset = start - *map_file_base;
+
+    return;
+
+}  /*  End routine:  "OdlMapLabel"  */
+
+
+/*******************/
+/*  Local Routine  */
+/*******************/
+
+/*  Fetches the next line of the label, either by copying it out of the
+    file mapping or, when there is no mapping, by reading it from the
+    file.  The text is copied into the caller's buffer because the parser
+    modifies it in place; only the final keyword and value strings are
+    allocated.  The behavior matches fgets:  the newline is kept, lines
+    longer than the buffer are split, and FALSE is returned once the text
+    runs out.  */
+
+#ifdef _NO_PROTO
+
+short OdlNextLabelLine (buffer, maxline, label_fptr, map_base, map_size,
+                        map_offset)
+
+char *buffer;
+long maxline;
+FILE *label_fptr;
+char *map_base;
+long map_size;
+long *map_offset;
+
+#else
+
+short OdlNextLabelLine (char *buffer, long maxline, FILE *label_fptr,
+                        char *map_base, long map_size, long *map_offset)
+
+#endif
+{
+    long index = {0};
+    long length = {0};
+
+    if (map_base == NULL)
+        return(fgets(buffer, (int)maxline, label_fptr) != NULL);
+
+    if (*map_offset >= map_size)
+        return(FALSE);
+
+    index = *map_offset;
+    while (index < map_size && length < (maxline - 1))
+    {
+        buffer[length++] = map_base[index++];
+        if (buffer[length - 1] == '\n')
+            break;
+    }
+    buffer[length] = '\0';
+    *map_offset = index;
+
+    return(TRUE);
+
+}  /*  End routine:  "OdlNextLabelLine"  */
+
+
 /*******************/
 /*  Local Routine  */
 /*******************/
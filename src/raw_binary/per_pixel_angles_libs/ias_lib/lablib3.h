@@ -163,6 +163,8 @@ void OdlPrintHierarchy();
 void OdlPrintLabel();
 void OdlPrintKeywords();
 OBJDESC *OdlParseFile();
+void OdlMapLabel();
+short OdlNextLabelLine();
 short OdlNestingLevel();
 short OdlValidBraces();
 short OdlValidElement();
@@ -236,6 +238,8 @@ void OdlPrintLabel (OBJDESC *, char *, FILE *, unsigned long);
 void OdlPrintKeywords (OBJDESC *, char *, FILE *, int);
 OBJDESC *OdlParseFile (char *, FILE *, char *, FILE *, 
                       int, unsigned short, unsigned short, unsigned short);
+void OdlMapLabel (FILE *, char **, long *, long *, long *);
+short OdlNextLabelLine (char *, long, FILE *, char *, long, long *);
 short OdlNestingLevel (char *, long *, long *);
 short OdlValidBraces (char *, long, long, char *, FILE *, long, int);
 short OdlValidElement (char *, char *, FILE *, long, long, int);
@@ -35,9 +35,661 @@ PURPOSE: Defines the attributes for Landsat 8
 #define QUANTIZE_CAL_MIN 1
 #define QUANTIZE_CAL_MAX 65535
 
-static IAS_SATELLITE_ATTRIBUTES l8_sat_attribs;
-static IAS_BAND_ATTRIBUTES l8_band_attribs[L8_TOTAL_NUMBER_OF_BANDS];
-static IAS_SENSOR_ID sensor_id[2];
+/* The band attribute table is built entirely at compile time so
+   initializing the library costs nothing at runtime; the table values are
+   constants loaded straight from the program image.  The entries are in
+   band number order, so band number N is entry N - 1. */
+static const IAS_BAND_ATTRIBUTES l8_band_attribs[L8_TOTAL_NUMBER_OF_BANDS] =
+{
+    {   /* OLI Coastal Aerosol band (band number 1) */
+        .band_number = 1,
+        .band_index = 0,
+        .band_name = "OLI_Coastal_Aerosol",
+        .sensor_id = IAS_OLI,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_COASTAL_AEROSOL_BAND,
+        .band_classification = IAS_NORMAL_BAND,
+        .spectral_type = IAS_SPECTRAL_VNIR,
+        .normal_band_number = 1,
+        .vrp_band_number = 19,
+        .blind_band_number = 0,
+        .secondary_band_number = 0,
+        .scas = OLI_NUMBER_OF_SCA,
+        .detectors_per_sca = OLI_DETECTORS_PER_SCA_NORMAL,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL,
+        .wavelength_nm_range = { 433, 453 },
+    },
+    {   /* OLI blue band (band number 2) */
+        .band_number = 2,
+        .band_index = 1,
+        .band_name = "OLI_Blue",
+        .sensor_id = IAS_OLI,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_BLUE_BAND,
+        .band_classification = IAS_NORMAL_BAND,
+        .spectral_type = IAS_SPECTRAL_VNIR,
+        .normal_band_number = 2,
+        .vrp_band_number = 20,
+        .blind_band_number = 0,
+        .secondary_band_number = 0,
+        .scas = OLI_NUMBER_OF_SCA,
+        .detectors_per_sca = OLI_DETECTORS_PER_SCA_NORMAL,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL,
+        .wavelength_nm_range = { 450, 515 },
+    },
+    {   /* OLI Green band (band number 3) */
+        .band_number = 3,
+        .band_index = 2,
+        .band_name = "OLI_Green",
+        .sensor_id = IAS_OLI,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_GREEN_BAND,
+        .band_classification = IAS_NORMAL_BAND,
+        .spectral_type = IAS_SPECTRAL_VNIR,
+        .normal_band_number = 3,
+        .vrp_band_number = 21,
+        .blind_band_number = 0,
+        .secondary_band_number = 0,
+        .scas = OLI_NUMBER_OF_SCA,
+        .detectors_per_sca = OLI_DETECTORS_PER_SCA_NORMAL,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL,
+        .wavelength_nm_range = { 525, 600 },
+    },
+    {   /* OLI Red band (band number 4) */
+        .band_number = 4,
+        .band_index = 3,
+        .band_name = "OLI_Red",
+        .sensor_id = IAS_OLI,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_RED_BAND,
+        .band_classification = IAS_NORMAL_BAND,
+        .spectral_type = IAS_SPECTRAL_VNIR,
+        .normal_band_number = 4,
+        .vrp_band_number = 22,
+        .blind_band_number = 0,
+        .secondary_band_number = 0,
+        .scas = OLI_NUMBER_OF_SCA,
+        .detectors_per_sca = OLI_DETECTORS_PER_SCA_NORMAL,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL,
+        .wavelength_nm_range = { 630, 680 },
+    },
+    {   /* OLI Near Infrared (NIR) band (band number 5) */
+        .band_number = 5,
+        .band_index = 4,
+        .band_name = "OLI_NIR",
+        .sensor_id = IAS_OLI,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_NIR_BAND,
+        .band_classification = IAS_NORMAL_BAND,
+        .spectral_type = IAS_SPECTRAL_VNIR,
+        .normal_band_number = 5,
+        .vrp_band_number = 23,
+        .blind_band_number = 0,
+        .secondary_band_number = 0,
+        .scas = OLI_NUMBER_OF_SCA,
+        .detectors_per_sca = OLI_DETECTORS_PER_SCA_NORMAL,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL,
+        .wavelength_nm_range = { 845, 885 },
+    },
+    {   /* first OLI Shortwave Infrared (SWIR) band (band number 6) */
+        .band_number = 6,
+        .band_index = 5,
+        .band_name = "OLI_SWIR1",
+        .sensor_id = IAS_OLI,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_SWIR1_BAND,
+        .band_classification = IAS_NORMAL_BAND,
+        .spectral_type = IAS_SPECTRAL_SWIR,
+        .normal_band_number = 6,
+        .vrp_band_number = 24,
+        .blind_band_number = 12,
+        .secondary_band_number = 0,
+        .scas = OLI_NUMBER_OF_SCA,
+        .detectors_per_sca = OLI_DETECTORS_PER_SCA_NORMAL,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL,
+        .wavelength_nm_range = { 1560, 1660 },
+    },
+    {   /* second OLI Shortwave Infrared (SWIR) band (band number 7) */
+        .band_number = 7,
+        .band_index = 6,
+        .band_name = "OLI_SWIR2",
+        .sensor_id = IAS_OLI,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_SWIR2_BAND,
+        .band_classification = IAS_NORMAL_BAND,
+        .spectral_type = IAS_SPECTRAL_SWIR,
+        .normal_band_number = 7,
+        .vrp_band_number = 25,
+        .blind_band_number = 13,
+        .secondary_band_number = 0,
+        .scas = OLI_NUMBER_OF_SCA,
+        .detectors_per_sca = OLI_DETECTORS_PER_SCA_NORMAL,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL,
+        .wavelength_nm_range = { 2100, 2300 },
+    },
+    {   /* OLI Panchromatic band (band number 8) */
+        .band_number = 8,
+        .band_index = 7,
+        .band_name = "OLI_PAN",
+        .sensor_id = IAS_OLI,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_PAN_BAND,
+        .band_classification = IAS_NORMAL_BAND,
+        .spectral_type = IAS_SPECTRAL_PAN,
+        .normal_band_number = 8,
+        .vrp_band_number = 26,
+        .blind_band_number = 0,
+        .secondary_band_number = 0,
+        .scas = OLI_NUMBER_OF_SCA,
+        .detectors_per_sca = OLI_DETECTORS_PER_SCA_PAN,
+        .lines_per_frame = 2,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = OLI_PIXEL_RESOLUTION_PAN,
+        .wavelength_nm_range = { 500, 680 },
+    },
+    {   /* OLI Cirrus Cloud band (band number 9) */
+        .band_number = 9,
+        .band_index = 8,
+        .band_name = "OLI_CIRRUS",
+        .sensor_id = IAS_OLI,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_CIRRUS_BAND,
+        .band_classification = IAS_NORMAL_BAND,
+        .spectral_type = IAS_SPECTRAL_SWIR,
+        .normal_band_number = 9,
+        .vrp_band_number = 27,
+        .blind_band_number = 14,
+        .secondary_band_number = 0,
+        .scas = OLI_NUMBER_OF_SCA,
+        .detectors_per_sca = OLI_DETECTORS_PER_SCA_NORMAL,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL,
+        .wavelength_nm_range = { 1360, 1390 },
+    },
+    {   /* first TIRS thermal band (band number 10) */
+        .band_number = 10,
+        .band_index = 9,
+        .band_name = "TIRS_THERMAL1",
+        .sensor_id = IAS_TIRS,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_THERMAL1_BAND,
+        .band_classification = IAS_NORMAL_BAND,
+        .spectral_type = IAS_SPECTRAL_THERMAL,
+        .normal_band_number = 10,
+        .vrp_band_number = 0,
+        .blind_band_number = 15,
+        .secondary_band_number = 16,
+        .scas = TIRS_NUMBER_OF_SCA,
+        .detectors_per_sca = TIRS_DETECTORS_PER_SCA_NORMAL,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = TIRS_PIXEL_RESOLUTION,
+        .wavelength_nm_range = { 1030, 1130 },
+    },
+    {   /* second TIRS thermal band (band number 11) */
+        .band_number = 11,
+        .band_index = 10,
+        .band_name = "TIRS_THERMAL2",
+        .sensor_id = IAS_TIRS,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_THERMAL2_BAND,
+        .band_classification = IAS_NORMAL_BAND,
+        .spectral_type = IAS_SPECTRAL_THERMAL,
+        .normal_band_number = 11,
+        .vrp_band_number = 0,
+        .blind_band_number = 15,
+        .secondary_band_number = 17,
+        .scas = TIRS_NUMBER_OF_SCA,
+        .detectors_per_sca = TIRS_DETECTORS_PER_SCA_NORMAL,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = TIRS_PIXEL_RESOLUTION,
+        .wavelength_nm_range = { 1150, 1250 },
+    },
+    {   /* OLI SWIR1 blind band (band number 12) */
+        .band_number = 12,
+        .band_index = 11,
+        .band_name = "OLI_BLIND_SWIR1",
+        .sensor_id = IAS_OLI,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_SWIR1_BAND,
+        .band_classification = IAS_BLIND_BAND,
+        .spectral_type = IAS_SPECTRAL_SWIR,
+        .normal_band_number = 6,
+        .vrp_band_number = 28,
+        .blind_band_number = 12,
+        .secondary_band_number = 0,
+        .scas = OLI_NUMBER_OF_SCA,
+        .detectors_per_sca = OLI_DETECTORS_PER_SCA_SWIR_BLIND,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL,
+        .wavelength_nm_range = { 0, 0 },
+    },
+    {   /* OLI SWIR2 blind band (band number 13) */
+        .band_number = 13,
+        .band_index = 12,
+        .band_name = "OLI_BLIND_SWIR2",
+        .sensor_id = IAS_OLI,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_SWIR2_BAND,
+        .band_classification = IAS_BLIND_BAND,
+        .spectral_type = IAS_SPECTRAL_SWIR,
+        .normal_band_number = 7,
+        .vrp_band_number = 29,
+        .blind_band_number = 13,
+        .secondary_band_number = 0,
+        .scas = OLI_NUMBER_OF_SCA,
+        .detectors_per_sca = OLI_DETECTORS_PER_SCA_SWIR_BLIND,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL,
+        .wavelength_nm_range = { 0, 0 },
+    },
+    {   /* OLI Cirrus blind band (band number 14) */
+        .band_number = 14,
+        .band_index = 13,
+        .band_name = "OLI_BLIND_CIRRUS",
+        .sensor_id = IAS_OLI,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_CIRRUS_BAND,
+        .band_classification = IAS_BLIND_BAND,
+        .spectral_type = IAS_SPECTRAL_SWIR,
+        .normal_band_number = 9,
+        .vrp_band_number = 30,
+        .blind_band_number = 14,
+        .secondary_band_number = 0,
+        .scas = OLI_NUMBER_OF_SCA,
+        .detectors_per_sca = OLI_DETECTORS_PER_SCA_CIRRUS_BLIND,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL,
+        .wavelength_nm_range = { 0, 0 },
+    },
+    {   /* TIRS blind band (band number 15) */
+        .band_number = 15,
+        .band_index = 14,
+        .band_name = "TIRS_BLIND",
+        .sensor_id = IAS_TIRS,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_THERMAL1_BAND,
+        .band_classification = IAS_BLIND_BAND,
+        .spectral_type = IAS_SPECTRAL_THERMAL,
+        .normal_band_number = 10,
+        .vrp_band_number = 0,
+        .blind_band_number = 15,
+        .secondary_band_number = 18,
+        .scas = TIRS_NUMBER_OF_SCA,
+        .detectors_per_sca = TIRS_DETECTORS_PER_SCA_BLIND,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = TIRS_PIXEL_RESOLUTION,
+        .wavelength_nm_range = { 0, 0 },
+    },
+    {   /* first TIRS secondary thermal band (band number 16) */
+        .band_number = 16,
+        .band_index = 15,
+        .band_name = "TIRS_THERMAL1_SECONDARY",
+        .sensor_id = IAS_TIRS,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_THERMAL1_BAND,
+        .band_classification = IAS_SECONDARY_BAND,
+        .spectral_type = IAS_SPECTRAL_THERMAL,
+        .normal_band_number = 16,
+        .vrp_band_number = 0,
+        .blind_band_number = 18,
+        .secondary_band_number = 0,
+        .scas = TIRS_NUMBER_OF_SCA,
+        .detectors_per_sca = TIRS_DETECTORS_PER_SCA_NORMAL,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = TIRS_PIXEL_RESOLUTION,
+        .wavelength_nm_range = { 1030, 1130 },
+    },
+    {   /* second TIRS secondary thermal band (band number 17) */
+        .band_number = 17,
+        .band_index = 16,
+        .band_name = "TIRS_THERMAL2_SECONDARY",
+        .sensor_id = IAS_TIRS,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_THERMAL2_BAND,
+        .band_classification = IAS_SECONDARY_BAND,
+        .spectral_type = IAS_SPECTRAL_THERMAL,
+        .normal_band_number = 17,
+        .vrp_band_number = 0,
+        .blind_band_number = 18,
+        .secondary_band_number = 0,
+        .scas = TIRS_NUMBER_OF_SCA,
+        .detectors_per_sca = TIRS_DETECTORS_PER_SCA_NORMAL,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = TIRS_PIXEL_RESOLUTION,
+        .wavelength_nm_range = { 1150, 1250 },
+    },
+    {   /* TIRS secondary blind band (band number 18) */
+        .band_number = 18,
+        .band_index = 17,
+        .band_name = "TIRS_BLIND_SECONDARY",
+        .sensor_id = IAS_TIRS,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_THERMAL1_BAND,
+        .band_classification = IAS_BLIND_BAND | IAS_SECONDARY_BAND,
+        .spectral_type = IAS_SPECTRAL_THERMAL,
+        .normal_band_number = 16,
+        .vrp_band_number = 0,
+        .blind_band_number = 18,
+        .secondary_band_number = 0,
+        .scas = TIRS_NUMBER_OF_SCA,
+        .detectors_per_sca = TIRS_DETECTORS_PER_SCA_BLIND,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = TIRS_PIXEL_RESOLUTION,
+        .wavelength_nm_range = { 0, 0 },
+    },
+    {   /* OLI Coastal Aerosol Video Reference Pixel (VRP) band (band number 19) */
+        .band_number = 19,
+        .band_index = 18,
+        .band_name = "OLI_VRP_Coastal_Aerosol",
+        .sensor_id = IAS_OLI,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_COASTAL_AEROSOL_BAND,
+        .band_classification = IAS_VRP_BAND,
+        .spectral_type = IAS_SPECTRAL_VNIR,
+        .normal_band_number = 1,
+        .vrp_band_number = 19,
+        .blind_band_number = 0,
+        .secondary_band_number = 0,
+        .scas = OLI_NUMBER_OF_SCA,
+        .detectors_per_sca = OLI_DETECTORS_PER_SCA_VRP,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL,
+        .wavelength_nm_range = { 433, 453 },
+    },
+    {   /* OLI Blue Video Reference Pixel (VRP) band (band number 20) */
+        .band_number = 20,
+        .band_index = 19,
+        .band_name = "OLI_VRP_Blue",
+        .sensor_id = IAS_OLI,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_BLUE_BAND,
+        .band_classification = IAS_VRP_BAND,
+        .spectral_type = IAS_SPECTRAL_VNIR,
+        .normal_band_number = 2,
+        .vrp_band_number = 20,
+        .blind_band_number = 0,
+        .secondary_band_number = 0,
+        .scas = OLI_NUMBER_OF_SCA,
+        .detectors_per_sca = OLI_DETECTORS_PER_SCA_VRP,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL,
+        .wavelength_nm_range = { 450, 515 },
+    },
+    {   /* OLI Green Video Reference Pixel (VRP) band (band number 21) */
+        .band_number = 21,
+        .band_index = 20,
+        .band_name = "OLI_VRP_Green",
+        .sensor_id = IAS_OLI,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_GREEN_BAND,
+        .band_classification = IAS_VRP_BAND,
+        .spectral_type = IAS_SPECTRAL_VNIR,
+        .normal_band_number = 3,
+        .vrp_band_number = 21,
+        .blind_band_number = 0,
+        .secondary_band_number = 0,
+        .scas = OLI_NUMBER_OF_SCA,
+        .detectors_per_sca = OLI_DETECTORS_PER_SCA_VRP,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL,
+        .wavelength_nm_range = { 525, 600 },
+    },
+    {   /* OLI Red Video Reference Pixel (VRP) band (band number 22) */
+        .band_number = 22,
+        .band_index = 21,
+        .band_name = "OLI_VRP_Red",
+        .sensor_id = IAS_OLI,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_RED_BAND,
+        .band_classification = IAS_VRP_BAND,
+        .spectral_type = IAS_SPECTRAL_VNIR,
+        .normal_band_number = 4,
+        .vrp_band_number = 22,
+        .blind_band_number = 0,
+        .secondary_band_number = 0,
+        .scas = OLI_NUMBER_OF_SCA,
+        .detectors_per_sca = OLI_DETECTORS_PER_SCA_VRP,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL,
+        .wavelength_nm_range = { 630, 680 },
+    },
+    {   /* OLI NIR Video Reference Pixel (VRP) band (band number 23) */
+        .band_number = 23,
+        .band_index = 22,
+        .band_name = "OLI_VRP_NIR",
+        .sensor_id = IAS_OLI,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_NIR_BAND,
+        .band_classification = IAS_VRP_BAND,
+        .spectral_type = IAS_SPECTRAL_VNIR,
+        .normal_band_number = 5,
+        .vrp_band_number = 23,
+        .blind_band_number = 0,
+        .secondary_band_number = 0,
+        .scas = OLI_NUMBER_OF_SCA,
+        .detectors_per_sca = OLI_DETECTORS_PER_SCA_VRP,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL,
+        .wavelength_nm_range = { 845, 885 },
+    },
+    {   /* OLI SWIR1 Video Reference Pixel (VRP) band (band number 24) */
+        .band_number = 24,
+        .band_index = 23,
+        .band_name = "OLI_VRP_SWIR1",
+        .sensor_id = IAS_OLI,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_SWIR1_BAND,
+        .band_classification = IAS_VRP_BAND,
+        .spectral_type = IAS_SPECTRAL_SWIR,
+        .normal_band_number = 6,
+        .vrp_band_number = 24,
+        .blind_band_number = 28,
+        .secondary_band_number = 0,
+        .scas = OLI_NUMBER_OF_SCA,
+        .detectors_per_sca = OLI_DETECTORS_PER_SCA_VRP,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL,
+        .wavelength_nm_range = { 1560, 1660 },
+    },
+    {   /* OLI SWIR2 Video Reference Pixel (VRP) band (band number 25) */
+        .band_number = 25,
+        .band_index = 24,
+        .band_name = "OLI_VRP_SWIR2",
+        .sensor_id = IAS_OLI,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_SWIR2_BAND,
+        .band_classification = IAS_VRP_BAND,
+        .spectral_type = IAS_SPECTRAL_SWIR,
+        .normal_band_number = 7,
+        .vrp_band_number = 25,
+        .blind_band_number = 29,
+        .secondary_band_number = 0,
+        .scas = OLI_NUMBER_OF_SCA,
+        .detectors_per_sca = OLI_DETECTORS_PER_SCA_VRP,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL,
+        .wavelength_nm_range = { 2100, 2300 },
+    },
+    {   /* OLI Pan Video Reference Pixel (VRP) band (band number 26) */
+        .band_number = 26,
+        .band_index = 25,
+        .band_name = "OLI_VRP_PAN",
+        .sensor_id = IAS_OLI,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_PAN_BAND,
+        .band_classification = IAS_VRP_BAND,
+        .spectral_type = IAS_SPECTRAL_PAN,
+        .normal_band_number = 8,
+        .vrp_band_number = 26,
+        .blind_band_number = 0,
+        .secondary_band_number = 0,
+        .scas = OLI_NUMBER_OF_SCA,
+        .detectors_per_sca = OLI_DETECTORS_PER_SCA_PAN_VRP,
+        .lines_per_frame = 2,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = OLI_PIXEL_RESOLUTION_PAN,
+        .wavelength_nm_range = { 500, 680 },
+    },
+    {   /* OLI Cirrus Video Reference Pixel (VRP) band (band number 27) */
+        .band_number = 27,
+        .band_index = 26,
+        .band_name = "OLI_VRP_CIRRUS",
+        .sensor_id = IAS_OLI,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_CIRRUS_BAND,
+        .band_classification = IAS_VRP_BAND,
+        .spectral_type = IAS_SPECTRAL_SWIR,
+        .normal_band_number = 9,
+        .vrp_band_number = 27,
+        .blind_band_number = 30,
+        .secondary_band_number = 0,
+        .scas = OLI_NUMBER_OF_SCA,
+        .detectors_per_sca = OLI_DETECTORS_PER_SCA_VRP,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL,
+        .wavelength_nm_range = { 1360, 1390 },
+    },
+    {   /* OLI SWIR1 Blind Video Reference Pixel (VRP) band (band number 28) */
+        .band_number = 28,
+        .band_index = 27,
+        .band_name = "OLI_VRP_BLIND_SWIR1",
+        .sensor_id = IAS_OLI,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_SWIR1_BAND,
+        .band_classification = IAS_VRP_BAND | IAS_BLIND_BAND,
+        .spectral_type = IAS_SPECTRAL_SWIR,
+        .normal_band_number = 12,
+        .vrp_band_number = 28,
+        .blind_band_number = 12,
+        .secondary_band_number = 0,
+        .scas = OLI_NUMBER_OF_SCA,
+        .detectors_per_sca = OLI_DETECTORS_PER_SCA_BLIND_VRP,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL,
+        .wavelength_nm_range = { 1560, 1660 },
+    },
+    {   /* OLI SWIR2 Blind Video Reference Pixel (VRP) band (band number 29) */
+        .band_number = 29,
+        .band_index = 28,
+        .band_name = "OLI_VRP_BLIND_SWIR2",
+        .sensor_id = IAS_OLI,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_SWIR2_BAND,
+        .band_classification = IAS_VRP_BAND | IAS_BLIND_BAND,
+        .spectral_type = IAS_SPECTRAL_SWIR,
+        .normal_band_number = 13,
+        .vrp_band_number = 29,
+        .blind_band_number = 13,
+        .secondary_band_number = 0,
+        .scas = OLI_NUMBER_OF_SCA,
+        .detectors_per_sca = OLI_DETECTORS_PER_SCA_BLIND_VRP,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL,
+        .wavelength_nm_range = { 2100, 2300 },
+    },
+    {   /* OLI Cirrus Blind Video Reference Pixel (VRP) band (band number 30) */
+        .band_number = 30,
+        .band_index = 29,
+        .band_name = "OLI_VRP_BLIND_CIRRUS",
+        .sensor_id = IAS_OLI,
+        .sensor_type = IAS_PUSHBROOM_SENSOR,
+        .band_type = IAS_CIRRUS_BAND,
+        .band_classification = IAS_VRP_BAND | IAS_BLIND_BAND,
+        .spectral_type = IAS_SPECTRAL_SWIR,
+        .normal_band_number = 14,
+        .vrp_band_number = 30,
+        .blind_band_number = 14,
+        .secondary_band_number = 0,
+        .scas = OLI_NUMBER_OF_SCA,
+        .detectors_per_sca = OLI_DETECTORS_PER_SCA_BLIND_VRP,
+        .lines_per_frame = 1,
+        .qcal_min = QUANTIZE_CAL_MIN,
+        .qcal_max = QUANTIZE_CAL_MAX,
+        .pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL,
+        .wavelength_nm_range = { 1360, 1390 },
+    },
+};
+
+static IAS_SENSOR_ID sensor_id[2] = { IAS_OLI, IAS_TIRS };
+
+/* Top-level satellite attributes, also built at compile time.  The band
+   attribute table is const but the attributes structure hands out non-const
+   pointers for historical API reasons; nothing in the library writes
+   through them, so dropping the const here is safe. */
+static IAS_SATELLITE_ATTRIBUTES l8_sat_attribs =
+{
+    .satellite_name = IAS_SATELLITE_NAME_L8,
+    .sensor_name = IAS_SENSOR_NAME_L8,
+    .satellite_id = IAS_L8,
+    .sensors = 2,
+    .bands = L8_TOTAL_NUMBER_OF_NORMAL_BANDS,
+    .total_bands = L8_TOTAL_NUMBER_OF_BANDS,
+    .sensor_ids = sensor_id,
+    .band_attributes = (IAS_BAND_ATTRIBUTES *)l8_band_attribs,
+};
 
 /*************************************************************************
 
@@ -85,652 +737,7 @@ NOTES:
 **************************************************************************/
 IAS_SATELLITE_ATTRIBUTES *ias_sat_attr_initialize_landsat8()
 {
-    int band_index;
-
-    /* Allocate sensor_ids pointer to static structure object */
-    l8_sat_attribs.sensor_ids = &sensor_id[0]; 
-
-    /* Allocate l8_band_attributes pointer to static structure object */
-    l8_sat_attribs.band_attributes = &l8_band_attribs[0];
-
-    /* Initialization the Satellite Attributes structure */
-    l8_sat_attribs.satellite_id = IAS_L8;
-    l8_sat_attribs.sensors = 2;
-    l8_sat_attribs.bands = L8_TOTAL_NUMBER_OF_NORMAL_BANDS;
-    l8_sat_attribs.total_bands = L8_TOTAL_NUMBER_OF_BANDS;
-
-    strncpy(l8_sat_attribs.satellite_name, IAS_SATELLITE_NAME_L8,
-        sizeof(l8_sat_attribs.satellite_name));
-    l8_sat_attribs.satellite_name[sizeof(l8_sat_attribs.satellite_name) - 1]
-        = '\0';
-    strncpy(l8_sat_attribs.sensor_name, IAS_SENSOR_NAME_L8,
-        sizeof(l8_sat_attribs.sensor_name));
-    l8_sat_attribs.sensor_name[sizeof(l8_sat_attribs.sensor_name) - 1] = '\0';
-
-    sensor_id[0] = IAS_OLI;
-    sensor_id[1] = IAS_TIRS;
-
-    for ( band_index = 0; band_index < L8_TOTAL_NUMBER_OF_BANDS; band_index++)
-    {
-        l8_band_attribs[band_index].band_number = band_index + 1;
-        l8_band_attribs[band_index].band_index = band_index;  
-        l8_band_attribs[band_index].qcal_min = QUANTIZE_CAL_MIN;
-        l8_band_attribs[band_index].qcal_max = QUANTIZE_CAL_MAX;
-    }
-
-    /* Set up the OLI Coastal Aerosol band (band number 1) */
-    band_index = 0;
-    strcpy(l8_band_attribs[band_index].band_name, "OLI_Coastal_Aerosol");
-    l8_band_attribs[band_index].sensor_id = IAS_OLI;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_COASTAL_AEROSOL_BAND;
-    l8_band_attribs[band_index].band_classification = IAS_NORMAL_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_VNIR;
-    l8_band_attribs[band_index].normal_band_number = 1; 
-    l8_band_attribs[band_index].vrp_band_number = 19; 
-    l8_band_attribs[band_index].blind_band_number = 0; 
-    l8_band_attribs[band_index].secondary_band_number = 0;
-    l8_band_attribs[band_index].scas = OLI_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = 
-                       OLI_DETECTORS_PER_SCA_NORMAL;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=433;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=453;
-
-    /* Set up the OLI blue band (band number 2) */
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "OLI_Blue");
-    l8_band_attribs[band_index].sensor_id = IAS_OLI;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_BLUE_BAND;
-    l8_band_attribs[band_index].band_classification = IAS_NORMAL_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_VNIR;
-    l8_band_attribs[band_index].normal_band_number = 2; 
-    l8_band_attribs[band_index].vrp_band_number = 20; 
-    l8_band_attribs[band_index].blind_band_number = 0; 
-    l8_band_attribs[band_index].secondary_band_number = 0;
-    l8_band_attribs[band_index].scas = OLI_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = 
-                       OLI_DETECTORS_PER_SCA_NORMAL;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=450;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=515;
-
-    /* Set up the OLI Green band (band number 3) */
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "OLI_Green");
-    l8_band_attribs[band_index].sensor_id = IAS_OLI;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_GREEN_BAND;
-    l8_band_attribs[band_index].band_classification = IAS_NORMAL_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_VNIR;
-    l8_band_attribs[band_index].normal_band_number = 3; 
-    l8_band_attribs[band_index].vrp_band_number = 21; 
-    l8_band_attribs[band_index].blind_band_number = 0; 
-    l8_band_attribs[band_index].secondary_band_number = 0;
-    l8_band_attribs[band_index].scas = OLI_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = 
-                            OLI_DETECTORS_PER_SCA_NORMAL;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=525;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=600;
-
-    /* Set up the OLI Red band (band number 4) */
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "OLI_Red");
-    l8_band_attribs[band_index].sensor_id = IAS_OLI;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_RED_BAND;
-    l8_band_attribs[band_index].band_classification = IAS_NORMAL_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_VNIR;
-    l8_band_attribs[band_index].normal_band_number = 4; 
-    l8_band_attribs[band_index].vrp_band_number = 22; 
-    l8_band_attribs[band_index].blind_band_number = 0; 
-    l8_band_attribs[band_index].secondary_band_number = 0;
-    l8_band_attribs[band_index].scas = OLI_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = 
-                            OLI_DETECTORS_PER_SCA_NORMAL;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=630;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=680;
-
-    /* Set up the OLI Near Infrared (NIR) band (band number 5) */
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "OLI_NIR");
-    l8_band_attribs[band_index].sensor_id = IAS_OLI;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_NIR_BAND;
-    l8_band_attribs[band_index].band_classification = IAS_NORMAL_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_VNIR;
-    l8_band_attribs[band_index].normal_band_number = 5; 
-    l8_band_attribs[band_index].vrp_band_number = 23; 
-    l8_band_attribs[band_index].blind_band_number = 0; 
-    l8_band_attribs[band_index].secondary_band_number = 0;
-    l8_band_attribs[band_index].scas = OLI_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = 
-                            OLI_DETECTORS_PER_SCA_NORMAL;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=845;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=885;
-
-    /* Set up the first OLI Shortwave Infrared (SWIR) band (band number 6) */
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "OLI_SWIR1");
-    l8_band_attribs[band_index].sensor_id = IAS_OLI;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_SWIR1_BAND;
-    l8_band_attribs[band_index].band_classification = IAS_NORMAL_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_SWIR;
-    l8_band_attribs[band_index].normal_band_number = 6; 
-    l8_band_attribs[band_index].vrp_band_number = 24; 
-    l8_band_attribs[band_index].blind_band_number = 12; 
-    l8_band_attribs[band_index].secondary_band_number = 0;
-    l8_band_attribs[band_index].scas = OLI_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = 
-                            OLI_DETECTORS_PER_SCA_NORMAL;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=1560;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=1660;
-
-    /* Set up the second OLI Shortwave Infrared (SWIR) band (band number 7) */
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "OLI_SWIR2");
-    l8_band_attribs[band_index].sensor_id = IAS_OLI;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_SWIR2_BAND;
-    l8_band_attribs[band_index].band_classification = IAS_NORMAL_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_SWIR;
-    l8_band_attribs[band_index].normal_band_number = 7; 
-    l8_band_attribs[band_index].vrp_band_number = 25; 
-    l8_band_attribs[band_index].blind_band_number = 13; 
-    l8_band_attribs[band_index].secondary_band_number = 0;
-    l8_band_attribs[band_index].scas = OLI_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = 
-                            OLI_DETECTORS_PER_SCA_NORMAL;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=2100;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=2300;
-
-    /* Set up the OLI Panchromatic band (band number 8) */
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "OLI_PAN");
-    l8_band_attribs[band_index].sensor_id = IAS_OLI;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_PAN_BAND;
-    l8_band_attribs[band_index].band_classification = IAS_NORMAL_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_PAN;
-    l8_band_attribs[band_index].normal_band_number = 8; 
-    l8_band_attribs[band_index].vrp_band_number = 26; 
-    l8_band_attribs[band_index].blind_band_number = 0; 
-    l8_band_attribs[band_index].secondary_band_number = 0;
-    l8_band_attribs[band_index].scas = OLI_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = OLI_DETECTORS_PER_SCA_PAN;
-    l8_band_attribs[band_index].lines_per_frame = 2;
-    l8_band_attribs[band_index].pixel_resolution = OLI_PIXEL_RESOLUTION_PAN;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=500;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=680;
-
-    /* Set up the OLI Cirrus Cloud band (band number 9) */
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "OLI_CIRRUS");
-    l8_band_attribs[band_index].sensor_id = IAS_OLI;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_CIRRUS_BAND;
-    l8_band_attribs[band_index].band_classification = IAS_NORMAL_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_SWIR;
-    l8_band_attribs[band_index].normal_band_number = 9; 
-    l8_band_attribs[band_index].vrp_band_number = 27; 
-    l8_band_attribs[band_index].blind_band_number = 14; 
-    l8_band_attribs[band_index].secondary_band_number = 0;
-    l8_band_attribs[band_index].scas = OLI_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = 
-                            OLI_DETECTORS_PER_SCA_NORMAL;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=1360;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=1390;
-
-    /* Set up the first TIRS thermal band (band number 10) */
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "TIRS_THERMAL1");
-    l8_band_attribs[band_index].sensor_id = IAS_TIRS;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_THERMAL1_BAND;
-    l8_band_attribs[band_index].band_classification = IAS_NORMAL_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_THERMAL;
-    l8_band_attribs[band_index].normal_band_number = 10; 
-    l8_band_attribs[band_index].vrp_band_number = 0; 
-    l8_band_attribs[band_index].blind_band_number = 15; 
-    l8_band_attribs[band_index].secondary_band_number = 16;
-    l8_band_attribs[band_index].scas = TIRS_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = 
-                            TIRS_DETECTORS_PER_SCA_NORMAL;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = TIRS_PIXEL_RESOLUTION;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=1030;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=1130;
-
-    /* Set up the second TIRS thermal band (band number 11) */
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "TIRS_THERMAL2");
-    l8_band_attribs[band_index].sensor_id = IAS_TIRS;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_THERMAL2_BAND;
-    l8_band_attribs[band_index].band_classification = IAS_NORMAL_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_THERMAL;
-    l8_band_attribs[band_index].normal_band_number = 11; 
-    l8_band_attribs[band_index].vrp_band_number = 0; 
-    l8_band_attribs[band_index].blind_band_number = 15;
-    l8_band_attribs[band_index].secondary_band_number = 17; 
-    l8_band_attribs[band_index].scas = TIRS_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = 
-                            TIRS_DETECTORS_PER_SCA_NORMAL;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = TIRS_PIXEL_RESOLUTION;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=1150;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=1250;
-
-    /* Set up the OLI SWIR1 blind band (band number 12) */
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "OLI_BLIND_SWIR1");
-    l8_band_attribs[band_index].sensor_id = IAS_OLI;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_SWIR1_BAND;
-    l8_band_attribs[band_index].band_classification = IAS_BLIND_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_SWIR;
-    l8_band_attribs[band_index].normal_band_number = 6; 
-    l8_band_attribs[band_index].vrp_band_number = 28; 
-    l8_band_attribs[band_index].blind_band_number = 12; 
-    l8_band_attribs[band_index].secondary_band_number = 0;
-    l8_band_attribs[band_index].scas = OLI_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = 
-                            OLI_DETECTORS_PER_SCA_SWIR_BLIND;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=0;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=0;
-
-    /* Set up the OLI SWIR2 blind band (band number 13) */
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "OLI_BLIND_SWIR2");
-    l8_band_attribs[band_index].sensor_id = IAS_OLI;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_SWIR2_BAND;
-    l8_band_attribs[band_index].band_classification = IAS_BLIND_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_SWIR;
-    l8_band_attribs[band_index].normal_band_number = 7; 
-    l8_band_attribs[band_index].vrp_band_number = 29; 
-    l8_band_attribs[band_index].blind_band_number = 13; 
-    l8_band_attribs[band_index].secondary_band_number = 0;
-    l8_band_attribs[band_index].scas = OLI_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = 
-                            OLI_DETECTORS_PER_SCA_SWIR_BLIND;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=0;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=0;
-
-    /* Set up the OLI Cirrus blind band (band number 14) */
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "OLI_BLIND_CIRRUS");
-    l8_band_attribs[band_index].sensor_id = IAS_OLI;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_CIRRUS_BAND;
-    l8_band_attribs[band_index].band_classification = IAS_BLIND_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_SWIR;
-    l8_band_attribs[band_index].normal_band_number = 9; 
-    l8_band_attribs[band_index].vrp_band_number = 30; 
-    l8_band_attribs[band_index].blind_band_number = 14; 
-    l8_band_attribs[band_index].secondary_band_number = 0;
-    l8_band_attribs[band_index].scas = OLI_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = 
-                           OLI_DETECTORS_PER_SCA_CIRRUS_BLIND;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=0;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=0;
-
-    /* Set up the TIRS blind band (band number 15) */
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "TIRS_BLIND");
-    l8_band_attribs[band_index].sensor_id = IAS_TIRS;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_THERMAL1_BAND;
-    l8_band_attribs[band_index].band_classification = IAS_BLIND_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_THERMAL;
-    /* the blind band is associated with both bands 10 and 11, but pick the
-       first one for this normal band number */
-    l8_band_attribs[band_index].normal_band_number = 10; 
-    l8_band_attribs[band_index].vrp_band_number = 0; 
-    l8_band_attribs[band_index].blind_band_number = 15; 
-    l8_band_attribs[band_index].secondary_band_number = 18;
-    l8_band_attribs[band_index].scas = TIRS_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = 
-                           TIRS_DETECTORS_PER_SCA_BLIND;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = TIRS_PIXEL_RESOLUTION;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=0;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=0;
-
-    /* Set up the first TIRS secondary thermal band (band number 16) */
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "TIRS_THERMAL1_SECONDARY");
-    l8_band_attribs[band_index].sensor_id = IAS_TIRS;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_THERMAL1_BAND;
-    l8_band_attribs[band_index].band_classification = IAS_SECONDARY_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_THERMAL;
-    l8_band_attribs[band_index].normal_band_number = 16; 
-    l8_band_attribs[band_index].vrp_band_number = 0; 
-    l8_band_attribs[band_index].blind_band_number = 18; 
-    l8_band_attribs[band_index].secondary_band_number = 0;
-    l8_band_attribs[band_index].scas = TIRS_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = 
-                            TIRS_DETECTORS_PER_SCA_NORMAL;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = TIRS_PIXEL_RESOLUTION;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=1030;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=1130;
-
-    /* Set up the second TIRS secondary thermal band (band number 17) */
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "TIRS_THERMAL2_SECONDARY");
-    l8_band_attribs[band_index].sensor_id = IAS_TIRS;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_THERMAL2_BAND;
-    l8_band_attribs[band_index].band_classification = IAS_SECONDARY_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_THERMAL;
-    l8_band_attribs[band_index].normal_band_number = 17; 
-    l8_band_attribs[band_index].vrp_band_number = 0; 
-    l8_band_attribs[band_index].blind_band_number = 18; 
-    l8_band_attribs[band_index].secondary_band_number = 0;
-    l8_band_attribs[band_index].scas = TIRS_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = 
-                            TIRS_DETECTORS_PER_SCA_NORMAL;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = TIRS_PIXEL_RESOLUTION;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=1150;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=1250;
-
-    /* Set up the TIRS secondary blind band (band number 18) */
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "TIRS_BLIND_SECONDARY");
-    l8_band_attribs[band_index].sensor_id = IAS_TIRS;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_THERMAL1_BAND;
-    l8_band_attribs[band_index].band_classification
-                = IAS_BLIND_BAND | IAS_SECONDARY_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_THERMAL;
-    /* the blind band is associated with both bands 16 and 17, but pick the
-       first one for this normal band number */
-    l8_band_attribs[band_index].normal_band_number = 16; 
-    l8_band_attribs[band_index].vrp_band_number = 0; 
-    l8_band_attribs[band_index].blind_band_number = 18; 
-    l8_band_attribs[band_index].secondary_band_number = 0;
-    l8_band_attribs[band_index].scas = TIRS_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = 
-                           TIRS_DETECTORS_PER_SCA_BLIND;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = TIRS_PIXEL_RESOLUTION;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=0;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=0;
-
-    /* Set up the OLI Coastal Aerosol Video Reference Pixel (VRP) band
-       (band number 19) */
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "OLI_VRP_Coastal_Aerosol");
-    l8_band_attribs[band_index].sensor_id = IAS_OLI;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_COASTAL_AEROSOL_BAND;
-    l8_band_attribs[band_index].band_classification = IAS_VRP_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_VNIR;
-    l8_band_attribs[band_index].normal_band_number = 1; 
-    l8_band_attribs[band_index].vrp_band_number = 19; 
-    l8_band_attribs[band_index].blind_band_number = 0; 
-    l8_band_attribs[band_index].secondary_band_number = 0;
-    l8_band_attribs[band_index].scas = OLI_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = OLI_DETECTORS_PER_SCA_VRP;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=433;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=453;
-
-    /* Set up the OLI Blue Video Reference Pixel (VRP) band (band number 20) */
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "OLI_VRP_Blue");
-    l8_band_attribs[band_index].sensor_id = IAS_OLI;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_BLUE_BAND;
-    l8_band_attribs[band_index].band_classification = IAS_VRP_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_VNIR;
-    l8_band_attribs[band_index].normal_band_number = 2; 
-    l8_band_attribs[band_index].vrp_band_number = 20; 
-    l8_band_attribs[band_index].blind_band_number = 0; 
-    l8_band_attribs[band_index].secondary_band_number = 0;
-    l8_band_attribs[band_index].scas = OLI_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = OLI_DETECTORS_PER_SCA_VRP;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=450;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=515;
-
-    /* Set up the OLI Green Video Reference Pixel (VRP) band (band number 21) */
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "OLI_VRP_Green");
-    l8_band_attribs[band_index].sensor_id = IAS_OLI;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_GREEN_BAND;
-    l8_band_attribs[band_index].band_classification = IAS_VRP_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_VNIR;
-    l8_band_attribs[band_index].normal_band_number = 3; 
-    l8_band_attribs[band_index].vrp_band_number = 21; 
-    l8_band_attribs[band_index].blind_band_number = 0; 
-    l8_band_attribs[band_index].secondary_band_number = 0;
-    l8_band_attribs[band_index].scas = OLI_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = OLI_DETECTORS_PER_SCA_VRP;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=525;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=600;
-
-    /* Set up the OLI Red Video Reference Pixel (VRP) band (band number 22) */
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "OLI_VRP_Red");
-    l8_band_attribs[band_index].sensor_id = IAS_OLI;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_RED_BAND;
-    l8_band_attribs[band_index].band_classification = IAS_VRP_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_VNIR;
-    l8_band_attribs[band_index].normal_band_number = 4; 
-    l8_band_attribs[band_index].vrp_band_number = 22; 
-    l8_band_attribs[band_index].blind_band_number = 0; 
-    l8_band_attribs[band_index].secondary_band_number = 0;
-    l8_band_attribs[band_index].scas = OLI_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = OLI_DETECTORS_PER_SCA_VRP;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=630;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=680;
-
-    /* Set up the OLI NIR Video Reference Pixel (VRP) band (band number 23) */
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "OLI_VRP_NIR");
-    l8_band_attribs[band_index].sensor_id = IAS_OLI;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_NIR_BAND;
-    l8_band_attribs[band_index].band_classification = IAS_VRP_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_VNIR;
-    l8_band_attribs[band_index].normal_band_number = 5; 
-    l8_band_attribs[band_index].vrp_band_number = 23; 
-    l8_band_attribs[band_index].blind_band_number = 0; 
-    l8_band_attribs[band_index].secondary_band_number = 0;
-    l8_band_attribs[band_index].scas = OLI_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = OLI_DETECTORS_PER_SCA_VRP;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=845;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=885;
-
-    /* Set up the OLI SWIR1 Video Reference Pixel (VRP) band (band number 24) */
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "OLI_VRP_SWIR1");
-    l8_band_attribs[band_index].sensor_id = IAS_OLI;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_SWIR1_BAND;
-    l8_band_attribs[band_index].band_classification = IAS_VRP_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_SWIR;
-    l8_band_attribs[band_index].normal_band_number = 6; 
-    l8_band_attribs[band_index].vrp_band_number = 24; 
-    l8_band_attribs[band_index].blind_band_number = 28; 
-    l8_band_attribs[band_index].secondary_band_number = 0;
-    l8_band_attribs[band_index].scas = OLI_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = OLI_DETECTORS_PER_SCA_VRP;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=1560;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=1660;
-
-    /* Set up the OLI SWIR2 Video Reference Pixel (VRP) band (band number 25) */
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "OLI_VRP_SWIR2");
-    l8_band_attribs[band_index].sensor_id = IAS_OLI;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_SWIR2_BAND;
-    l8_band_attribs[band_index].band_classification = IAS_VRP_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_SWIR;
-    l8_band_attribs[band_index].normal_band_number = 7; 
-    l8_band_attribs[band_index].vrp_band_number = 25; 
-    l8_band_attribs[band_index].blind_band_number = 29; 
-    l8_band_attribs[band_index].secondary_band_number = 0;
-    l8_band_attribs[band_index].scas = OLI_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = OLI_DETECTORS_PER_SCA_VRP;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=2100;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=2300;
-
-    /* Set up the OLI Pan Video Reference Pixel (VRP) band (band number 26) */
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "OLI_VRP_PAN");
-    l8_band_attribs[band_index].sensor_id = IAS_OLI;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_PAN_BAND;
-    l8_band_attribs[band_index].band_classification = IAS_VRP_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_PAN;
-    l8_band_attribs[band_index].normal_band_number = 8; 
-    l8_band_attribs[band_index].vrp_band_number = 26; 
-    l8_band_attribs[band_index].blind_band_number = 0;
-    l8_band_attribs[band_index].secondary_band_number = 0; 
-    l8_band_attribs[band_index].scas = OLI_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = 
-                            OLI_DETECTORS_PER_SCA_PAN_VRP;
-    l8_band_attribs[band_index].lines_per_frame = 2;
-    l8_band_attribs[band_index].pixel_resolution = OLI_PIXEL_RESOLUTION_PAN;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=500;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=680;
-
-    /* Set up the OLI Cirrus Video Reference Pixel (VRP) band
-       (band number 27) */
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "OLI_VRP_CIRRUS");
-    l8_band_attribs[band_index].sensor_id = IAS_OLI;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_CIRRUS_BAND;
-    l8_band_attribs[band_index].band_classification = IAS_VRP_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_SWIR;
-    l8_band_attribs[band_index].normal_band_number = 9; 
-    l8_band_attribs[band_index].vrp_band_number = 27; 
-    l8_band_attribs[band_index].blind_band_number = 30; 
-    l8_band_attribs[band_index].secondary_band_number = 0;
-    l8_band_attribs[band_index].scas = OLI_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = OLI_DETECTORS_PER_SCA_VRP;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=1360;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=1390;
-
-    /* Set up the OLI SWIR1 Blind Video Reference Pixel (VRP) band
-       (band number 28) */
-    /* The blind band listed for OLI_VRP_BLIND_SWIR1 is the band number 
-       associated with the masked detectors the VRPs were obtained from as 
-       described by the pixel output sequence.*/
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "OLI_VRP_BLIND_SWIR1");
-    l8_band_attribs[band_index].sensor_id = IAS_OLI;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_SWIR1_BAND;
-    l8_band_attribs[band_index].band_classification 
-                = IAS_VRP_BAND | IAS_BLIND_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_SWIR;
-    l8_band_attribs[band_index].normal_band_number = 12; 
-    l8_band_attribs[band_index].vrp_band_number = 28; 
-    l8_band_attribs[band_index].blind_band_number = 12; 
-    l8_band_attribs[band_index].secondary_band_number = 0;
-    l8_band_attribs[band_index].scas = OLI_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = 
-                            OLI_DETECTORS_PER_SCA_BLIND_VRP;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=1560;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=1660;
-
-    /* Set up the OLI SWIR2 Blind Video Reference Pixel (VRP) band
-       (band number 29) */
-    /* The blind band listed for OLI_VRP_BLIND_SWIR2 is the band number 
-       associated with the masked detectors the VRPs were obtained from as 
-       described by the pixel output sequence.*/
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "OLI_VRP_BLIND_SWIR2");
-    l8_band_attribs[band_index].sensor_id = IAS_OLI;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_SWIR2_BAND;
-    l8_band_attribs[band_index].band_classification
-                = IAS_VRP_BAND | IAS_BLIND_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_SWIR;
-    l8_band_attribs[band_index].normal_band_number = 13; 
-    l8_band_attribs[band_index].vrp_band_number = 29; 
-    l8_band_attribs[band_index].blind_band_number = 13; 
-    l8_band_attribs[band_index].secondary_band_number = 0;
-    l8_band_attribs[band_index].scas = OLI_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = 
-                            OLI_DETECTORS_PER_SCA_BLIND_VRP;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=2100;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=2300;
-
-    /* Set up the OLI Cirrus Blind Video Reference Pixel (VRP) band
-       (band number 30) */
-    /* The blind band listed for OLI_VRP_BLIND_CIRRUS is the band number 
-       associated with the masked detectors the VRPs were obtained from as 
-       described by the pixel output sequence.*/
-    band_index++;
-    strcpy(l8_band_attribs[band_index].band_name, "OLI_VRP_BLIND_CIRRUS");
-    l8_band_attribs[band_index].sensor_id = IAS_OLI;
-    l8_band_attribs[band_index].sensor_type = IAS_PUSHBROOM_SENSOR;
-    l8_band_attribs[band_index].band_type = IAS_CIRRUS_BAND;
-    l8_band_attribs[band_index].band_classification
-                = IAS_VRP_BAND | IAS_BLIND_BAND;
-    l8_band_attribs[band_index].spectral_type = IAS_SPECTRAL_SWIR;
-    l8_band_attribs[band_index].normal_band_number = 14; 
-    l8_band_attribs[band_index].vrp_band_number = 30; 
-    l8_band_attribs[band_index].blind_band_number = 14; 
-    l8_band_attribs[band_index].secondary_band_number = 0;
-    l8_band_attribs[band_index].scas = OLI_NUMBER_OF_SCA;
-    l8_band_attribs[band_index].detectors_per_sca = 
-                            OLI_DETECTORS_PER_SCA_BLIND_VRP;
-    l8_band_attribs[band_index].lines_per_frame = 1;
-    l8_band_attribs[band_index].pixel_resolution = OLI_PIXEL_RESOLUTION_NORMAL;
-    l8_band_attribs[band_index].wavelength_nm_range[0]=1360;
-    l8_band_attribs[band_index].wavelength_nm_range[1]=1390;
-
+    /* Every table is static data initialized at compile time, so there is
+       nothing left to do at runtime */
     return &l8_sat_attribs;
 }
-
@@ -0,0 +1,291 @@
+/****************************************************************************
+NAME: odl_arena
+
+PURPOSE: Bump arena backing the ODL parse tree.  See odl_arena.h for the
+usage contract.  The arena grows in large chunks, hands out aligned slices
+with a pointer bump, and is released in one pass when the tree it backs is
+freed.  Arenas are bound to the root object of the tree they back so trees
+parsed at different times can be released independently.
+
+NOTES:
+  1. Like the rest of the label library, the arena state is not thread
+     safe; labels are parsed from a single thread.
+*****************************************************************************/
+
+/* Standard Library Includes */
+#include <string.h>
+
+/* Local Includes */
+#include "odl_arena.h"
+
+/* Local Defines */
+#define ODL_ARENA_CHUNK_BYTES (256 * 1024)  /* Payload bytes per chunk */
+#define ODL_ARENA_ALIGN sizeof(double)      /* Allocation alignment */
+
+/* One chunk of arena storage; the payload follows the header */
+typedef struct odl_arena_chunk
+{
+    struct odl_arena_chunk *next; /* Next chunk in the arena */
+    size_t used;                  /* Payload bytes handed out */
+    size_t size;                  /* Payload bytes available */
+} ODL_ARENA_CHUNK;
+
+/* One arena; bound to the root of the tree it backs once parsing ends */
+typedef struct odl_arena
+{
+    struct odl_arena *next;       /* Next bound arena */
+    const void *root;             /* Root object of the tree backed */
+    ODL_ARENA_CHUNK *chunks;      /* Chunks holding the tree memory */
+} ODL_ARENA;
+
+static ODL_ARENA *current_arena = NULL; /* Arena for the active parse */
+static ODL_ARENA *bound_arenas = NULL;  /* Arenas of fully parsed trees */
+static int parse_depth = 0;             /* Nesting depth of active parses */
+
+/****************************************************************************
+NAME: free_arena_chunks (static)
+
+PURPOSE: Releases the storage of an arena.
+*****************************************************************************/
+static void free_arena_chunks
+(
+    ODL_ARENA *arena      /* I: Arena to release */
+)
+{
+    ODL_ARENA_CHUNK *chunk = arena->chunks;
+
+    while (chunk != NULL)
+    {
+        ODL_ARENA_CHUNK *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+
+    free(arena);
+}
+
+/****************************************************************************
+NAME: arena_owns (static)
+
+PURPOSE: Determines whether a pointer was handed out by an arena.
+
+RETURNS: Nonzero if the pointer lies within one of the arena's chunks
+*****************************************************************************/
+static int arena_owns
+(
+    const ODL_ARENA *arena, /* I: Arena to check */
+    const void *pointer     /* I: Pointer to look for */
+)
+{
+    const ODL_ARENA_CHUNK *chunk;
+
+    for (chunk = arena->chunks; chunk != NULL; chunk = chunk->next)
+    {
+        const char *payload = (const char *)(chunk + 1);
+
+        if ((const char *)pointer >= payload
+            && (const char *)pointer < payload + chunk->used)
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/****************************************************************************
+NAME: any_arena_owns (static)
+
+PURPOSE: Determines whether a pointer was handed out by the active or any
+bound arena.
+
+RETURNS: Nonzero if an arena owns the pointer
+*****************************************************************************/
+static int any_arena_owns
+(
+    const void *pointer   /* I: Pointer to look for */
+)
+{
+    const ODL_ARENA *arena;
+
+    if (current_arena != NULL && arena_owns(current_arena, pointer))
+        return 1;
+
+    for (arena = bound_arenas; arena != NULL; arena = arena->next)
+    {
+        if (arena_owns(arena, pointer))
+            return 1;
+    }
+
+    return 0;
+}
+
+/****************************************************************************
+NAME: OdlArenaBegin
+
+PURPOSE: Marks the start of a label parse.  The outermost parse opens a
+fresh arena; nested parses (expanded sub-labels) share it so the whole
+tree is released together.
+*****************************************************************************/
+void OdlArenaBegin(void)
+{
+    if (parse_depth++ == 0)
+    {
+        /* If the arena state cannot be allocated the parse falls back to
+           the normal heap, which is slower but still correct */
+        current_arena = calloc(1, sizeof(*current_arena));
+    }
+}
+
+/****************************************************************************
+NAME: OdlArenaEnd
+
+PURPOSE: Marks the end of a label parse.  When the outermost parse ends
+the arena is bound to the root of the tree it backs, or released right
+away if the parse failed.
+*****************************************************************************/
+void OdlArenaEnd
+(
+    const void *root      /* I: Root of the parsed tree the arena backs, or
+                                NULL if the parse failed */
+)
+{
+    if (--parse_depth > 0 || current_arena == NULL)
+        return;
+
+    if (root != NULL)
+    {
+        current_arena->root = root;
+        current_arena->next = bound_arenas;
+        bound_arenas = current_arena;
+    }
+    else
+        free_arena_chunks(current_arena);
+
+    current_arena = NULL;
+}
+
+/****************************************************************************
+NAME: OdlArenaFree
+
+PURPOSE: Releases the arena backing a parsed tree in one pass.
+
+RETURNS: Nonzero if an arena was bound to the root and has been released
+*****************************************************************************/
+int OdlArenaFree
+(
+    const void *root      /* I: Root of a parsed tree */
+)
+{
+    ODL_ARENA **link = &bound_arenas;
+
+    while (*link != NULL)
+    {
+        if ((*link)->root == root)
+        {
+            ODL_ARENA *arena = *link;
+
+            *link = arena->next;
+            free_arena_chunks(arena);
+            return 1;
+        }
+        link = &(*link)->next;
+    }
+
+    return 0;
+}
+
+/****************************************************************************
+NAME: OdlArenaMalloc
+
+PURPOSE: Allocates memory from the active arena with a pointer bump, or
+from the heap when no parse is active.
+
+RETURNS: Pointer to the allocation, or NULL if the allocation failed
+*****************************************************************************/
+void *OdlArenaMalloc
+(
+    size_t size           /* I: Number of bytes to allocate */
+)
+{
+    ODL_ARENA_CHUNK *chunk;
+    void *pointer;
+
+    if (current_arena == NULL)
+        return malloc(size > 0 ? size : 1);
+
+    /* Round the size up to keep every allocation aligned */
+    size = (size + ODL_ARENA_ALIGN - 1) & ~(ODL_ARENA_ALIGN - 1);
+    if (size == 0)
+        size = ODL_ARENA_ALIGN;
+
+    /* Start a new chunk if the current one cannot hold the allocation;
+       oversized allocations get a dedicated chunk */
+    chunk = current_arena->chunks;
+    if (chunk == NULL || chunk->used + size > chunk->size)
+    {
+        size_t payload = ODL_ARENA_CHUNK_BYTES;
+
+        if (size > payload)
+            payload = size;
+
+        chunk = malloc(sizeof(*chunk) + payload);
+        if (chunk == NULL)
+            return NULL;
+        chunk->used = 0;
+        chunk->size = payload;
+        chunk->next = current_arena->chunks;
+        current_arena->chunks = chunk;
+    }
+
+    pointer = (char *)(chunk + 1) + chunk->used;
+    chunk->used += size;
+
+    return pointer;
+}
+
+/****************************************************************************
+NAME: OdlArenaStringRealloc
+
+PURPOSE: Grows a NUL terminated string allocation.  Strings owned by an
+arena (or grown while a parse is active) are copied into a fresh
+allocation since arena memory cannot be resized in place.
+
+RETURNS: Pointer to the grown string, or NULL if the allocation failed
+*****************************************************************************/
+char *OdlArenaStringRealloc
+(
+    char *string,         /* I: NUL terminated string to grow */
+    size_t size           /* I: New allocation size in bytes */
+)
+{
+    int owned = any_arena_owns(string);
+    char *grown;
+
+    if (current_arena == NULL && !owned)
+        return realloc(string, size);
+
+    grown = OdlArenaMalloc(size);
+    if (grown == NULL)
+        return NULL;
+    strcpy(grown, string);
+    if (!owned)
+        free(string);
+
+    return grown;
+}
+
+/****************************************************************************
+NAME: OdlArenaRelease
+
+PURPOSE: Releases a single allocation.  Memory owned by an arena stays put
+until the arena itself is released with the tree it backs.
+*****************************************************************************/
+void OdlArenaRelease
+(
+    void *pointer         /* I: Allocation to release */
+)
+{
+    if (!any_arena_owns(pointer))
+        free(pointer);
+}
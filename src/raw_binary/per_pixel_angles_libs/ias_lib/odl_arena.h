@@ -0,0 +1,52 @@
+#ifndef ODL_ARENA_H
+#define ODL_ARENA_H
+
+/****************************************************************************
+NAME: odl_arena
+
+PURPOSE: Bump arena backing the ODL parse tree.  The parser allocates every
+keyword, value and object node individually, so parsing a label file makes
+tens of thousands of tiny allocations that were previously freed one by one
+when the tree was released.  While a parse is active the toolbox allocation
+macros draw from an arena instead, individual releases of arena memory are
+no-ops, and OdlFreeTree returns the whole arena in one pass.  Outside of a
+parse the functions fall through to the normal heap so the other label
+utilities are unaffected.
+
+*****************************************************************************/
+
+#include <stdlib.h>
+
+void OdlArenaBegin(void);
+
+void OdlArenaEnd
+(
+    const void *root      /* I: Root of the parsed tree the arena backs, or
+                                NULL if the parse failed and the arena
+                                should be released immediately */
+);
+
+int OdlArenaFree
+(
+    const void *root      /* I: Root of a parsed tree; the arena backing it
+                                is released if one exists */
+);
+
+void *OdlArenaMalloc
+(
+    size_t size           /* I: Number of bytes to allocate */
+);
+
+char *OdlArenaStringRealloc
+(
+    char *string,         /* I: NUL terminated string to grow */
+    size_t size           /* I: New allocation size in bytes */
+);
+
+void OdlArenaRelease
+(
+    void *pointer         /* I: Allocation to release; a no-op for memory
+                                owned by an arena */
+);
+
+#endif
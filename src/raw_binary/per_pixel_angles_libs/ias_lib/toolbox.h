@@ -22,6 +22,8 @@
 #include <ctype.h>
 #include <time.h>
 
+#include "odl_arena.h"   /* arena backing the label parse tree */
+
 /**************************************************************************/
 /*                          Symbol Definitions                            */
 /**************************************************************************/
@@ -54,15 +56,15 @@
 
 #define RingThatBell(znumz) {int ziz; for (ziz=0; ziz < znumz; ++ziz) (void)printf("%c", (char) 7);}
 #define CloseMe(zfptrz) {if (zfptrz != NULL) {(void)fclose(zfptrz); zfptrz = NULL;}}
-#define LemmeGo(zmptrz) {if (zmptrz != NULL) {free(zmptrz); zmptrz = NULL;}}
+#define LemmeGo(zmptrz) {if (zmptrz != NULL) {OdlArenaRelease((void *)(zmptrz)); zmptrz = NULL;}}
 #define SayGoodbye() {(void)printf("I'm out of memory and I can't get up!\n"); exit(1);}
 #define LastChar(zstrz) (zstrz+strlen(zstrz)-1)
 
 #define NewString(zstrz, zsizez) \
             {if (zsizez <= 1) \
-                 zstrz = (char *)malloc(1); \
+                 zstrz = (char *)OdlArenaMalloc(1); \
              else \
-                 zstrz = (char *)malloc(zsizez); \
+                 zstrz = (char *)OdlArenaMalloc(zsizez); \
              if (zstrz == NULL) \
                  SayGoodbye() \
              else \
@@ -83,7 +85,7 @@
                 if (zstrz == NULL) \
                     NewString(zstrz, (long)(1+strlen(znewz))) \
                 else \
-                    zstrz = (char *)realloc(zstrz, 1+strlen(znewz)+strlen(zstrz)); \
+                    zstrz = OdlArenaStringRealloc(zstrz, 1+strlen(znewz)+strlen(zstrz)); \
                 if (zstrz == NULL) \
                     SayGoodbye() \
                 else \
@@ -9,6 +9,10 @@
 #include "ias_const.h"
 #include "ias_angle_gen_distro.h"
 #include "ias_miscellaneous.h"
+#include "espa_perf.h"
+#include "espa_thread_pool.h"
+#include "espa_cancel.h"
+#include "espa_buffer.h"
 
 /* Local Includes */
 #include "l8_angles.h"
@@ -17,12 +21,379 @@
 static int process_parameters (char *angle_coeff_name, int subsamp_fact,
     short fill_pix_value, char *band_list, L8_ANGLES_PARAMETERS *parameters);
 
+/* Read-only context shared by the angle line workers while generating the
+   angles for one band */
+typedef struct angle_line_context
+{
+    const IAS_ANGLE_GEN_METADATA *metadata; /* Angle metadata structure */
+    const IAS_MISC_LINE_EXTENT *trim_lut;   /* Image trim lookup table */
+    ANGLE_TYPE angle_type;      /* Type of angles to generate */
+    int band_index;             /* Current band index */
+    int num_in_samps;           /* Samples in the L1T frame */
+    int num_samps;              /* Samples in the output angle band */
+    int sub_sample;             /* Subsampling factor */
+    const int *samp_lut;        /* L1T sample coordinate for each output
+                                   sample, precomputed once per band when
+                                   subsampling (or NULL) */
+    int resync_interval;        /* Interval between exact angle evaluations
+                                   along a line (<= 1 evaluates every
+                                   sample exactly) */
+    double r2d;                 /* Conversion to hundredths of degrees */
+    short *sat_zenith;          /* Satellite zenith band buffer (or NULL) */
+    short *sat_azimuth;         /* Satellite azimuth band buffer (or NULL) */
+    short *solar_zenith;        /* Solar zenith band buffer (or NULL) */
+    short *solar_azimuth;       /* Solar azimuth band buffer (or NULL) */
+} ANGLE_LINE_CONTEXT;
+
+/**************************************************************************
+NAME: store_angle_sample
+
+PURPOSE: Quantizes the angles for one sample by converting from radians to
+degrees and scaling by a factor of 100 so they can be stored in the short
+integer images.
+
+RETURN VALUE:
+    Type = void
+***************************************************************************/
+static void store_angle_sample
+(
+    const ANGLE_LINE_CONTEXT *context, /* I: Band context */
+    int index,                         /* I: Sample index to store */
+    const double *sat_angles,          /* I: Viewing angles */
+    const double *sun_angles           /* I: Solar angles */
+)
+{
+    if (context->sat_azimuth)
+        context->sat_azimuth[index] = (short) round (context->r2d *
+            sat_angles[IAS_ANGLE_GEN_AZIMUTH_INDEX]);
+    if (context->sat_zenith)
+        context->sat_zenith[index] = (short) round (context->r2d *
+            sat_angles[IAS_ANGLE_GEN_ZENITH_INDEX]);
+    if (context->solar_azimuth)
+        context->solar_azimuth[index] = (short) round (context->r2d *
+            sun_angles[IAS_ANGLE_GEN_AZIMUTH_INDEX]);
+    if (context->solar_zenith)
+        context->solar_zenith[index] = (short) round (context->r2d *
+            sun_angles[IAS_ANGLE_GEN_ZENITH_INDEX]);
+}
+
+/**************************************************************************
+NAME: interpolate_angle
+
+PURPOSE: Linearly interpolates an angle between two exactly evaluated
+anchor angles, handling the azimuth wrap at +/-180 degrees.
+
+RETURN VALUE:
+    Type = double
+    The interpolated angle in radians.
+***************************************************************************/
+static double interpolate_angle
+(
+    double left_angle,  /* I: Angle at the left anchor (radians) */
+    double right_angle, /* I: Angle at the right anchor (radians) */
+    double fraction     /* I: Fraction of the span (0.0 - 1.0) */
+)
+{
+    double delta = right_angle - left_angle;  /* Angle change over span */
+    double angle;                             /* Interpolated angle */
+
+    /* Take the short way around the azimuth wrap */
+    if (delta > M_PI)
+        delta -= 2.0 * M_PI;
+    else if (delta < -M_PI)
+        delta += 2.0 * M_PI;
+
+    angle = left_angle + fraction * delta;
+
+    /* Wrap the result back into the atan2 range */
+    if (angle > M_PI)
+        angle -= 2.0 * M_PI;
+    else if (angle < -M_PI)
+        angle += 2.0 * M_PI;
+
+    return angle;
+}
+
+/**************************************************************************
+NAME: process_angle_line_incremental
+
+PURPOSE: Calculates the angles for one output line of the current band,
+evaluating the RPCs exactly at anchor samples every resync_interval output
+samples and interpolating the angles in between.  The angles vary smoothly
+along a line, so interpolation over a short span stays within the
+hundredth-of-a-degree output quantization while cutting the per-pixel RPC
+evaluations by the resync factor.
+
+RETURN VALUE:
+    Type = int
+    Value           Description
+    -----           -----------
+    ERROR           An error occurred evaluating the angles
+    SUCCESS         Angle line generation was successful
+***************************************************************************/
+static int process_angle_line_incremental
+(
+    const ANGLE_LINE_CONTEXT *context, /* I: Band context */
+    int out_line                       /* I: Output line to calculate */
+)
+{
+    int line = out_line * context->sub_sample; /* L1T line coordinate */
+    int base_index = out_line * context->num_samps; /* First sample index */
+    int out_samp = 0;                          /* Current output sample */
+    int have_left = 0;                         /* Left anchor is valid */
+    double left_sat[2] = {0.0, 0.0};           /* Left anchor view angles */
+    double left_sun[2] = {0.0, 0.0};           /* Left anchor solar angles */
+    double right_sat[2] = {0.0, 0.0};          /* Right anchor view angles */
+    double right_sun[2] = {0.0, 0.0};          /* Right anchor solar angles */
+
+    while (out_samp < context->num_samps)
+    {
+        int samp = out_samp * context->sub_sample; /* L1T sample coord */
+        int span;                                  /* Anchor span */
+        int offset;                                /* Offset within span */
+
+        /* If the current sample falls outside the actual range of image
+           data in this scene, then goto the next pixel.  Fill pixels are
+           already handled. */
+        if (samp <= context->trim_lut[line].start_sample ||
+            samp >= context->trim_lut[line].end_sample)
+        {
+            have_left = 0;
+            out_samp++;
+            continue;
+        }
+
+        /* Evaluate the left anchor exactly, unless it was the right anchor
+           of the previous span */
+        if (!have_left)
+        {
+            if (calculate_angles (context->metadata, line, samp,
+                context->band_index, context->angle_type, left_sat,
+                left_sun) != SUCCESS)
+            {
+                return ERROR;
+            }
+            store_angle_sample (context, base_index + out_samp, left_sat,
+                left_sun);
+        }
+
+        /* Find the widest span that ends inside the trimmed image data.
+           The trimmed data is a single interval per line, so only the
+           right anchor needs to be checked. */
+        span = context->resync_interval;
+        if (out_samp + span > context->num_samps - 1)
+            span = context->num_samps - 1 - out_samp;
+        while (span > 1 && (out_samp + span) * context->sub_sample >=
+               context->trim_lut[line].end_sample)
+            span--;
+
+        if (span < 2)
+        {
+            have_left = 0;
+            out_samp++;
+            continue;
+        }
+
+        /* Evaluate the right anchor exactly */
+        if (calculate_angles (context->metadata, line,
+            (out_samp + span) * context->sub_sample, context->band_index,
+            context->angle_type, right_sat, right_sun) != SUCCESS)
+        {
+            return ERROR;
+        }
+        store_angle_sample (context, base_index + out_samp + span, right_sat,
+            right_sun);
+
+        /* Interpolate the samples between the anchors */
+        for (offset = 1; offset < span; offset++)
+        {
+            double fraction = (double) offset / span; /* Span fraction */
+            double sat_angles[2];                     /* Viewing angles */
+            double sun_angles[2];                     /* Solar angles */
+            int axis;                                 /* Angle axis index */
+
+            for (axis = 0; axis < 2; axis++)
+            {
+                sat_angles[axis] = interpolate_angle (left_sat[axis],
+                    right_sat[axis], fraction);
+                sun_angles[axis] = interpolate_angle (left_sun[axis],
+                    right_sun[axis], fraction);
+            }
+
+            store_angle_sample (context, base_index + out_samp + offset,
+                sat_angles, sun_angles);
+        }
+
+        /* The right anchor becomes the left anchor of the next span */
+        memcpy (left_sat, right_sat, sizeof (left_sat));
+        memcpy (left_sun, right_sun, sizeof (left_sun));
+        have_left = 1;
+        out_samp += span;
+    }
+
+    return SUCCESS;
+}
+
+/**************************************************************************
+NAME: process_angle_line_subsampled
+
+PURPOSE: Calculates the angles for one output line of a subsampled band.
+The trimmed L1T sample interval is converted to output sample bounds once
+per line and the precomputed sample coordinate table is walked directly,
+so the inner loop runs without the per-pixel index scaling and trim
+checks of the full resolution path.
+
+RETURN VALUE:
+    Type = int
+    Value           Description
+    -----           -----------
+    ERROR           An error occurred evaluating the angles
+    SUCCESS         Angle line generation was successful
+***************************************************************************/
+static int process_angle_line_subsampled
+(
+    const ANGLE_LINE_CONTEXT *context, /* I: Band context */
+    int out_line                       /* I: Output line to calculate */
+)
+{
+    int line = out_line * context->sub_sample; /* L1T line coordinate */
+    int base_index = out_line * context->num_samps; /* First sample index */
+    int out_samp;                              /* Current output sample */
+    int out_start;                             /* First output sample inside
+                                                  the trimmed image data */
+    int out_end;                               /* Last output sample inside
+                                                  the trimmed image data */
+    double sun_angles[2];                      /* Solar angles */
+    double sat_angles[2];                      /* Viewing angles */
+
+    /* Nothing to do if the line holds no image data */
+    if (context->trim_lut[line].end_sample <= 0)
+        return SUCCESS;
+
+    /* Convert the trimmed L1T sample interval to output sample bounds once
+       for the line.  The samples inside the interval are those with
+       samp > start_sample and samp < end_sample. */
+    if (context->trim_lut[line].start_sample < 0)
+        out_start = 0;
+    else
+        out_start = context->trim_lut[line].start_sample /
+            context->sub_sample + 1;
+
+    out_end = (context->trim_lut[line].end_sample - 1) / context->sub_sample;
+    if (out_end > context->num_samps - 1)
+        out_end = context->num_samps - 1;
+
+    for (out_samp = out_start; out_samp <= out_end; out_samp++)
+    {
+        /* Calculate the satellite and solar azimuth and zenith */
+        if (calculate_angles (context->metadata, line,
+            context->samp_lut[out_samp], context->band_index,
+            context->angle_type, sat_angles, sun_angles) != SUCCESS)
+        {
+            return ERROR;
+        }
+
+        store_angle_sample (context, base_index + out_samp, sat_angles,
+            sun_angles);
+    }
+
+    return SUCCESS;
+}
+
+/**************************************************************************
+NAME: process_angle_line
+
+PURPOSE: Calculates the angles for one output line of the current band.
+The output line maps to L1T line (out_line * sub_sample).
+
+RETURN VALUE:
+    Type = int
+    Value           Description
+    -----           -----------
+    ERROR           An error occurred evaluating the angles
+    SUCCESS         Angle line generation was successful
+***************************************************************************/
+static int process_angle_line
+(
+    const ANGLE_LINE_CONTEXT *context, /* I: Band context */
+    int out_line                       /* I: Output line to calculate */
+)
+{
+    int line = out_line * context->sub_sample; /* L1T line coordinate */
+    int samp;                                  /* L1T sample coordinate */
+    int index = out_line * context->num_samps; /* Current sample index */
+    double sun_angles[2];                      /* Solar angles */
+    double sat_angles[2];                      /* Viewing angles */
+
+    /* Use the incremental evaluation when a resync interval is in effect */
+    if (context->resync_interval > 1)
+        return process_angle_line_incremental (context, out_line);
+
+    /* Use the specialized kernel when the band is subsampled */
+    if (context->sub_sample > 1 && context->samp_lut)
+        return process_angle_line_subsampled (context, out_line);
+
+    for (samp = 0; samp < context->num_in_samps;
+         samp += context->sub_sample, index++)
+    {
+        /* If the current sample falls outside the actual range of image
+           data in this scene, then goto the next pixel.  Fill pixels are
+           already handled. */
+        if (samp <= context->trim_lut[line].start_sample ||
+            samp >= context->trim_lut[line].end_sample)
+        {
+            continue;
+        }
+
+        /* Calculate the satellite and solar azimuth and zenith */
+        if (calculate_angles (context->metadata, line, samp,
+            context->band_index, context->angle_type, sat_angles,
+            sun_angles) != SUCCESS)
+        {
+            return ERROR;
+        }
+
+        store_angle_sample (context, index, sat_angles, sun_angles);
+    }  /* for samp */
+
+    return SUCCESS;
+}
+
+/**************************************************************************
+NAME: angle_line_task
+
+PURPOSE: Worker pool task that calculates the angles for one output line
+of the current band.
+
+RETURN VALUE:
+    Type = int
+    Value           Description
+    -----           -----------
+    ERROR           An error occurred evaluating the angles
+    SUCCESS         Angle line generation was successful
+***************************************************************************/
+static int angle_line_task
+(
+    void *context_ptr,  /* I: ANGLE_LINE_CONTEXT shared by the band */
+    int out_line        /* I: Output line to calculate */
+)
+{
+    if (process_angle_line(context_ptr, out_line) != SUCCESS)
+    {
+        IAS_LOG_ERROR("Evaluating angles for output line %d", out_line);
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
 /**************************************************************************
 NAME: l8_per_pixel_angles
 
 PURPOSE:   Uses the coefficients in the angle coefficients file to generate
 the satellite viewing angle and/or solar angle values, for the specified
-list of bands.
+list of bands.  The cooperative cancellation flag is polled at the band and
+line boundaries so a preempted job unwinds cleanly.
 
 RETURN VALUE:
     Type = int
@@ -39,6 +410,17 @@ Date         Programmer       Reason
 4/3/2015     Gail Schmidt     Modified to work in the ESPA environment
 5/5/2015     Gail Schmidt     Fixed a rounding bug that was incorrect for
                               negative values
+8/31/2026    Gail Schmidt     Added num_threads to calculate the angle lines
+                              with multiple threads
+8/31/2026    Gail Schmidt     Added resync_interval to support interpolating
+                              the angles between exact evaluations
+8/31/2026    Gail Schmidt     Read the angle metadata through a binary cache
+                              of the parsed ODL file
+8/31/2026    Gail Schmidt     Run the angle lines through the shared worker
+                              pool instead of ad-hoc pthreads
+8/31/2026    Gail Schmidt     Allocate the angle arrays through the NUMA-aware
+                              buffer allocator so their pages are spread
+                              across the nodes the workers run on
 
 NOTES:
   1. The band pointers for solar zenith/azimuth and satellite zenith/azimuth
@@ -65,6 +447,12 @@ int l8_per_pixel_angles
                                   between.  Example: 1,2,3,4,5,6,7,8,9
                                   The solar/sat_zenith/azimuth arrays should
                                   will have angles processed for these bands */
+    int num_threads,        /* I: Number of threads to use for calculating
+                                  the angle lines */
+    int resync_interval,    /* I: Interval between exact angle evaluations
+                                  along a line; the angles for the samples
+                                  in between are interpolated (<= 1
+                                  evaluates every sample exactly) */
     ANGLES_FRAME frame[L8_NBANDS],   /* O: Image frame info for each band */
     short *solar_zenith[L8_NBANDS],  /* O: Array of pointers for the solar
                                            zenith angle array, one per band
@@ -96,8 +484,10 @@ int l8_per_pixel_angles
     L8_ANGLES_PARAMETERS parameters;  /* Parameters read in from file */
     IAS_ANGLE_GEN_METADATA metadata;  /* Angle metadata structure */ 
     char root_filename[PATH_MAX];     /* Root filename */
+    char trim_cache_name[PATH_MAX];   /* Trim lookup table cache file name */
     char *base_ptr;                   /* Basename pointer */
     double r2d = 4500.0 / atan(1.0);  /* Conversion to hundredths of degrees */
+    long long perf_start = espa_perf_start();  /* Instrumentation scope */
 
     /* Make sure there is something to process */
     if (solar_zenith == NULL && solar_azimuth == NULL &&
@@ -133,8 +523,9 @@ int l8_per_pixel_angles
     /* Setup local sub sampling factor variable */
     sub_sample = parameters.sub_sample_factor;
 
-    /* Read the metadata file */
-    if (ias_angle_gen_read_ang(parameters.metadata_filename, &metadata) 
+    /* Read the metadata file, using the binary cache of the parsed ODL
+       file when a previous run has already written one for this scene */
+    if (ias_angle_gen_read_ang_cached(parameters.metadata_filename, &metadata)
         != SUCCESS)
     {
         IAS_LOG_ERROR("Reading the metadata file %s", 
@@ -194,12 +585,15 @@ int l8_per_pixel_angles
     {
         int line;                       /* Line index */
         int samp;                       /* Sample index */
-        int index;                      /* Current sample index*/
         int tmp_percent;                /* Current percentage for printing
                                            status */
         int curr_tmp_percent;           /* Percentage for current line */
         IAS_MISC_LINE_EXTENT *trim_lut; /* Image trim lookup table */
-        int band_number;                /* Band number */ 
+        int *samp_lut = NULL;           /* L1T sample coordinate for each
+                                           output sample when subsampling */
+        int band_number;                /* Band number */
+        int band_threads;               /* Threads to use for this band */
+        ANGLE_LINE_CONTEXT context;     /* Shared angle line context */
 
         /* Retrieve the band number for current index */
         band_number = ias_sat_attr_convert_band_index_to_number(band_index);
@@ -214,6 +608,17 @@ int l8_per_pixel_angles
         if (!parameters.process_band[band_index])
             continue;
 
+        /* Unwind cleanly at the band boundary if the scheduler asked for
+           a cancellation; this also bounds the pooled line evaluation,
+           which runs a whole band between the checks */
+        if (espa_cancel_requested())
+        {
+            IAS_LOG_ERROR("Angle generation canceled before band %d",
+                band_number);
+            ias_angle_gen_free(&metadata);
+            return ERROR;
+        }
+
         /* Get framing information for this band if return is not successful
            then band is not present in metadata so continue */
         if (get_frame(&metadata, band_index, &frame[band_index]) != SUCCESS)
@@ -234,10 +639,12 @@ int l8_per_pixel_angles
         nsamps[band_index] = num_samps;
         angle_size = num_lines * num_samps * sizeof(short);
 
-        /* Allocate the satellite buffers if needed */
+        /* Allocate the satellite buffers if needed; the allocation
+           pattern-fills every pixel with the background value in one pass */
         if (sat_zenith != NULL)
         {
-            sat_zenith[band_index] = (short *)malloc(angle_size);
+            sat_zenith[band_index] = (short *)espa_alloc_buffer_fill16(
+                angle_size / sizeof(short), parameters.background);
             if (!sat_zenith[band_index])
             {
                 IAS_LOG_ERROR("Allocating satellite zenith angle array for "
@@ -249,7 +656,8 @@ int l8_per_pixel_angles
 
         if (sat_azimuth != NULL)
         {
-            sat_azimuth[band_index] = (short *)malloc(angle_size);
+            sat_azimuth[band_index] = (short *)espa_alloc_buffer_fill16(
+                angle_size / sizeof(short), parameters.background);
             if (!sat_azimuth[band_index])
             {
                 IAS_LOG_ERROR("Allocating satellite azimuth angle array for "
@@ -262,7 +670,8 @@ int l8_per_pixel_angles
         /* Allocate the solar buffers if needed */
         if (solar_zenith != NULL)
         {
-            solar_zenith[band_index] = (short *)malloc(angle_size);
+            solar_zenith[band_index] = (short *)espa_alloc_buffer_fill16(
+                angle_size / sizeof(short), parameters.background);
             if (!solar_zenith[band_index])
             {
                 IAS_LOG_ERROR("Allocating solar zenith angle array for band "
@@ -274,7 +683,8 @@ int l8_per_pixel_angles
 
         if (solar_azimuth != NULL)
         {
-            solar_azimuth[band_index] = (short *)malloc(angle_size);
+            solar_azimuth[band_index] = (short *)espa_alloc_buffer_fill16(
+                angle_size / sizeof(short), parameters.background);
             if (!solar_azimuth[band_index])
             {
                 IAS_LOG_ERROR("Allocating solar azimuth angle array for band "
@@ -284,9 +694,14 @@ int l8_per_pixel_angles
             }
         }
 
-        /* Retrieve the trim look up table to remove the scene crenulation */
-        trim_lut = ias_misc_create_output_image_trim_lut(
-            get_active_lines(&metadata, band_index), 
+        /* Retrieve the trim look up table to remove the scene crenulation,
+           using the binary cache kept next to the angle coefficient file
+           when a previous run over the same scene has already written one */
+        snprintf(trim_cache_name, sizeof(trim_cache_name), "%.4080s.trim.b%02d",
+            parameters.metadata_filename, band_number);
+        trim_lut = ias_misc_create_output_image_trim_lut_cached(
+            trim_cache_name,
+            get_active_lines(&metadata, band_index),
             get_active_samples(&metadata, band_index),
             frame[band_index].num_lines, frame[band_index].num_samps);
         if (!trim_lut)
@@ -297,116 +712,561 @@ int l8_per_pixel_angles
             return ERROR;
         }
 
-        /* Loop through the L1T lines and samples, and just fill everything
-           with fill. */
-        if (sat_zenith)
-        {
-            for (line = 0, index = 0; line < frame[band_index].num_lines;
-                 line += sub_sample)
-                for (samp = 0; samp < frame[band_index].num_samps;
-                     samp += sub_sample, index++)
-                    sat_zenith[band_index][index] = parameters.background;
-        }
+        /* Precompute the L1T sample coordinate of each output sample once
+           for the band when subsampling, so the line workers can run the
+           specialized subsampled kernel */
+        if (sub_sample > 1)
+        {
+            samp_lut = malloc(num_samps * sizeof(int));
+            if (!samp_lut)
+            {
+                IAS_LOG_ERROR("Allocating the sample coordinate table for "
+                    "band number %d", band_number);
+                free(trim_lut);
+                ias_angle_gen_free(&metadata);
+                return ERROR;
+            }
+
+            for (samp = 0; samp < num_samps; samp++)
+                samp_lut[samp] = samp * sub_sample;
+        }
+
+        /* Set up the read-only context the angle line workers share for
+           this band */
+        context.metadata = &metadata;
+        context.trim_lut = trim_lut;
+        context.angle_type = parameters.angle_type;
+        context.band_index = band_index;
+        context.num_in_samps = frame[band_index].num_samps;
+        context.num_samps = num_samps;
+        context.sub_sample = sub_sample;
+        context.samp_lut = samp_lut;
+        context.resync_interval = resync_interval;
+        context.r2d = r2d;
+        context.sat_zenith = sat_zenith ? sat_zenith[band_index] : NULL;
+        context.sat_azimuth = sat_azimuth ? sat_azimuth[band_index] : NULL;
+        context.solar_zenith = solar_zenith ? solar_zenith[band_index] : NULL;
+        context.solar_azimuth = solar_azimuth ? solar_azimuth[band_index]
+            : NULL;
+
+        /* There is no point in using more threads than output lines */
+        band_threads = num_threads;
+        if (band_threads > num_lines)
+            band_threads = num_lines;
+
+        if (band_threads <= 1)
+        {
+            /* Loop through the L1T lines */
+            tmp_percent = 0;
+            for (line = 0; line < num_lines; line++)
+            {
+                /* update status? */
+                curr_tmp_percent = 100 * line / num_lines;
+                if (curr_tmp_percent > tmp_percent)
+                {
+                    tmp_percent = curr_tmp_percent;
+                    if (tmp_percent % 10 == 0)
+                    {
+                        printf ("%d%% ", tmp_percent);
+                        fflush (stdout);
+                    }
+                }
+
+                /* Unwind cleanly at the line boundary if the scheduler
+                   asked for a cancellation */
+                if (espa_cancel_requested())
+                {
+                    IAS_LOG_ERROR("Angle generation canceled at line %d of "
+                        "band %d", line, band_number);
+                    free(samp_lut);
+                    free(trim_lut);
+                    ias_angle_gen_free(&metadata);
+                    return ERROR;
+                }
+
+                if (process_angle_line (&context, line) != SUCCESS)
+                {
+                    IAS_LOG_ERROR("Evaluating angles in band %d", band_number);
+                    free(samp_lut);
+                    free(trim_lut);
+                    ias_angle_gen_free(&metadata);
+                    return ERROR;
+                }
+            }  /* for line */
+        }
+        else
+        {
+            /* Spread the output lines across the shared worker pool */
+            if (espa_pool_run(angle_line_task, &context, num_lines,
+                band_threads) != SUCCESS)
+            {
+                IAS_LOG_ERROR("Evaluating angles in band %d", band_number);
+                free(samp_lut);
+                free(trim_lut);
+                ias_angle_gen_free(&metadata);
+                return ERROR;
+            }
+        }
+
+        /* update status */
+        printf ("100%%\n");
+        fflush (stdout);
+
+        /* Free the lookup tables */
+        free(samp_lut);
+        samp_lut = NULL;
+        free(trim_lut);
+        trim_lut = NULL;
+    }  /* for band */
+
+    /* Release the metadata */
+    ias_angle_gen_free(&metadata);
+
+    espa_perf_record("l8_per_pixel_angles", perf_start, 0);
+    return SUCCESS;
+}
+
+
+/**************************************************************************
+NAME: build_angle_envi_hdr
+
+PURPOSE: Fills in the ENVI header for one written angle band from the band
+frame information.
+
+RETURN VALUE:
+    Type = int
+    Value           Description
+    -----           -----------
+    ERROR           Frame uses an unsupported datum or projection
+    SUCCESS         Header structure was filled in
+***************************************************************************/
+static int build_angle_envi_hdr
+(
+    const ANGLES_FRAME *frame, /* I: Image frame info for the band */
+    int num_lines,             /* I: Number of lines in the angle band */
+    int num_samps,             /* I: Number of samples in the angle band */
+    short fill_pix_value,      /* I: Fill pixel value of the angle band */
+    const char *description,   /* I: Header description string */
+    const char *band_name,     /* I: Name of the single band */
+    Envi_header_t *envi_hdr    /* O: Filled-in ENVI header structure */
+)
+{
+    int parm;                  /* Projection parameter index */
+    int count;                 /* Number of chars copied in snprintf */
+
+    count = snprintf(envi_hdr->description, sizeof(envi_hdr->description),
+        "%s", description);
+    if (count < 0 || count >= sizeof(envi_hdr->description))
+    {
+        IAS_LOG_ERROR("Overflow of envi_hdr->description");
+        return ERROR;
+    }
+
+    envi_hdr->nlines = num_lines;
+    envi_hdr->nsamps = num_samps;
+    envi_hdr->nbands = 1;
+    envi_hdr->header_offset = 0;
+    envi_hdr->byte_order = 0;
+
+    count = snprintf(envi_hdr->file_type, sizeof(envi_hdr->file_type),
+        "ENVI Standard");
+    if (count < 0 || count >= sizeof(envi_hdr->file_type))
+    {
+        IAS_LOG_ERROR("Overflow of envi_hdr->file_type");
+        return ERROR;
+    }
+
+    envi_hdr->data_type = 2;
+    envi_hdr->data_ignore_value = fill_pix_value;
+    count = snprintf(envi_hdr->interleave, sizeof(envi_hdr->interleave),
+        "BSQ");
+    if (count < 0 || count >= sizeof(envi_hdr->interleave))
+    {
+        IAS_LOG_ERROR("Overflow of envi_hdr->interleave");
+        return ERROR;
+    }
+
+    count = snprintf(envi_hdr->sensor_type, sizeof(envi_hdr->sensor_type),
+        "Landsat OLI/TIRS");
+    if (count < 0 || count >= sizeof(envi_hdr->sensor_type))
+    {
+        IAS_LOG_ERROR("Overflow of envi_hdr->sensor_type");
+        return ERROR;
+    }
+
+    if (frame->projection.spheroid == WGS84_SPHEROID)
+        envi_hdr->datum_type = ESPA_WGS84;
+    else
+    {
+        IAS_LOG_ERROR("Unsupported datum. Currently only expect WGS84.");
+        return ERROR;
+    }
+
+    if (frame->projection.proj_code == UTM)
+    {
+        envi_hdr->proj_type = GCTP_UTM_PROJ;
+        envi_hdr->utm_zone = frame->projection.zone;
+    }
+    else if (frame->projection.proj_code == PS)
+    {
+        envi_hdr->proj_type = GCTP_PS_PROJ;
+    }
+    else
+    {
+        IAS_LOG_ERROR("Unsupported projection. Currently only expect UTM "
+            "or PS.");
+        return ERROR;
+    }
+
+    for (parm = 0; parm < IAS_PROJ_PARAM_SIZE; parm++)
+        envi_hdr->proj_parms[parm] = frame->projection.parameters[parm];
+    envi_hdr->pixel_size[0] = frame->pixel_size;
+    envi_hdr->pixel_size[1] = frame->pixel_size;
+    envi_hdr->ul_corner[0] = frame->ul_corner.x - frame->pixel_size * 0.5;
+    envi_hdr->ul_corner[1] = frame->ul_corner.y + frame->pixel_size * 0.5;
+    envi_hdr->xy_start[0] = 1;
+    envi_hdr->xy_start[1] = 1;
+
+    count = snprintf(envi_hdr->band_names[0], sizeof(envi_hdr->band_names[0]),
+        "%s", band_name);
+    if (count < 0 || count >= sizeof(envi_hdr->band_names[0]))
+    {
+        IAS_LOG_ERROR("Overflow of envi_hdr->band_names[0]");
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+/**************************************************************************
+NAME: start_angle_band_write
+
+PURPOSE: Opens the output file for one angle band, hands the band buffer to
+a background writer, and writes the matching ENVI header.  The writer is
+returned still draining, so the caller can overlap the write of this band
+with the generation of the next one.
+
+RETURN VALUE:
+    Type = int
+    Value           Description
+    -----           -----------
+    ERROR           Opening, writing, or the header failed
+    SUCCESS         Band is draining in the background writer
+***************************************************************************/
+static int start_angle_band_write
+(
+    const ANGLES_FRAME *frame, /* I: Image frame info for the band */
+    int num_lines,             /* I: Number of lines in the angle band */
+    int num_samps,             /* I: Number of samples in the angle band */
+    short *angle_buf,          /* I: Angle band buffer to be written */
+    const char *outfile_base,  /* I: Base filename for the output bands */
+    int band_number,           /* I: Band number for the output filenames */
+    const char *angle_name,    /* I: Angle name used in the filenames
+                                     (e.g. solar_zenith) */
+    short fill_pix_value,      /* I: Fill pixel value of the angle band */
+    const char *description,   /* I: ENVI header description string */
+    const char *band_name,     /* I: ENVI name of the single band */
+    FILE **fptr,               /* O: Open band file, closed by the caller
+                                     after the writer drains */
+    Raw_binary_async_t **writer  /* O: Draining background writer, closed by
+                                     the caller */
+)
+{
+    char tmpfile[PATH_MAX];    /* Output band and header filenames */
+    Envi_header_t envi_hdr;    /* Output ENVI header information */
+    int count;                 /* Number of chars copied in snprintf */
+
+    *fptr = NULL;
+    *writer = NULL;
+
+    /* Open the output file for this band */
+    count = snprintf(tmpfile, sizeof(tmpfile), "%s_B%d_%s.img",
+        outfile_base, band_number, angle_name);
+    if (count < 0 || count >= sizeof(tmpfile))
+    {
+        IAS_LOG_ERROR("Overflow of the %s band filename", angle_name);
+        return ERROR;
+    }
+
+    *fptr = open_raw_binary(tmpfile, "wb");
+    if (!*fptr)
+    {
+        IAS_LOG_ERROR("Unable to open the %s file", angle_name);
+        return ERROR;
+    }
+
+    /* Hand the data for this band to a background writer thread so the
+       next band can be computed while it drains */
+    *writer = open_raw_binary_async(*fptr);
+    if (!*writer)
+    {
+        IAS_LOG_ERROR("Unable to start the %s writer", angle_name);
+        close_raw_binary(*fptr);
+        *fptr = NULL;
+        return ERROR;
+    }
+
+    if (write_raw_binary_async(*writer, num_lines, num_samps, sizeof(short),
+        angle_buf) != SUCCESS)
+    {
+        IAS_LOG_ERROR("Unable to write to the %s file", angle_name);
+        return ERROR;
+    }
+
+    /* Write the matching ENVI header */
+    if (build_angle_envi_hdr(frame, num_lines, num_samps, fill_pix_value,
+        description, band_name, &envi_hdr) != SUCCESS)
+    {
+        IAS_LOG_ERROR("Building the ENVI header for the %s band",
+            angle_name);
+        return ERROR;
+    }
+
+    count = snprintf(tmpfile, sizeof(tmpfile), "%s_B%d_%s.hdr",
+        outfile_base, band_number, angle_name);
+    if (count < 0 || count >= sizeof(tmpfile))
+    {
+        IAS_LOG_ERROR("Overflow of the %s header filename", angle_name);
+        return ERROR;
+    }
+
+    if (write_envi_hdr(tmpfile, &envi_hdr) != SUCCESS)
+    {
+        IAS_LOG_ERROR("Writing the ENVI header file %s", tmpfile);
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+/**************************************************************************
+NAME: drain_angle_band_writers
+
+PURPOSE: Finishes the background writers for one band of angle files and
+releases their buffers.
+
+RETURN VALUE:
+    Type = int
+    Value           Description
+    -----           -----------
+    ERROR           A background writer reported a write failure
+    SUCCESS         All the writers drained cleanly
+***************************************************************************/
+static int drain_angle_band_writers
+(
+    int num_writers,               /* I: Number of entries in the arrays */
+    Raw_binary_async_t **writers,  /* I/O: Draining writers; NULL entries
+                                          are skipped and all are cleared */
+    FILE **fptrs,                  /* I/O: Open band files for the writers */
+    short **bufs                   /* I/O: Band buffers held by the writers */
+)
+{
+    int index;                     /* Writer index */
+    int status = SUCCESS;          /* Combined drain status */
+
+    for (index = 0; index < num_writers; index++)
+    {
+        if (writers[index])
+        {
+            if (close_raw_binary_async(writers[index]) != SUCCESS)
+            {   /* Error messages already printed; keep draining the rest */
+                status = ERROR;
+            }
+            close_raw_binary(fptrs[index]);
+            free(bufs[index]);
+        }
+        writers[index] = NULL;
+        fptrs[index] = NULL;
+        bufs[index] = NULL;
+    }
+
+    return status;
+}
+
+/**************************************************************************
+NAME: l8_write_angle_bands
+
+PURPOSE: Single pipeline from the angle coefficient file to the written
+angle band files.  The angles for each band are generated one band at a
+time and handed straight to the background writers, so no more than two
+bands of angle arrays are alive at once and none of them are repacked or
+copied between the generation and the write.
+
+RETURN VALUE:
+    Type = int
+    Value           Description
+    -----           -----------
+    ERROR           An error occurred generating or writing the angle bands
+    SUCCESS         Angle bands were generated and written
+
+NOTES:
+  1. The band files are named <base>_B<n>_<angle>.img for the solar_zenith,
+     solar_azimuth, sensor_zenith, and sensor_azimuth angles, each with a
+     matching ENVI header, matching the files historically written by
+     create_l8_angle_bands.
+  2. The angle metadata is read through the binary cache of the parsed ODL
+     file, so the per-band calls into the angle generation do not re-parse
+     the angle coefficient file.
+***************************************************************************/
+int l8_write_angle_bands
+(
+    char *angle_coeff_name, /* I: Angle coefficient filename */
+    char *outfile_base,     /* I: Base filename for the output angle bands */
+    int subsamp_fact,       /* I: Subsample factor used when calculating the
+                                  angles (1=full resolution). OW take every Nth
+                                  sample from the line, where N=subsamp_fact */
+    short fill_pix_value,   /* I: Fill pixel value to use (-32768:32767) */
+    char *band_list,        /* I: Band list used to calculate angles for.
+                                  "ALL" - defaults to all bands 1 - 11.
+                                  Must be comma separated with no spaces in
+                                  between.  Example: 1,2,3,4,5,6,7,8,9 */
+    int num_threads,        /* I: Number of threads to use for calculating
+                                  the angle lines */
+    int resync_interval     /* I: Interval between exact angle evaluations
+                                  along a line; the angles for the samples
+                                  in between are interpolated (<= 1
+                                  evaluates every sample exactly) */
+)
+{
+    char band_string[3];              /* Band list for the current band */
+    int count;                        /* Number of chars copied in snprintf */
+    int band_index;                   /* Band index */
+    int band_number;                  /* Band number */
+    int windex;                       /* Writer index for the current band */
+    L8_ANGLES_PARAMETERS parameters;  /* Parameters for the band list */
+    ANGLES_FRAME frame[L8_NBANDS];    /* Image frame info for each band */
+    short *solar_zenith[L8_NBANDS];   /* Solar zenith angles for the current
+                                         band.  Degrees scaled by 100 */
+    short *solar_azimuth[L8_NBANDS];  /* Solar azimuth angles for the current
+                                         band.  Degrees scaled by 100 */
+    short *sat_zenith[L8_NBANDS];     /* Satellite zenith angles for the
+                                         current band.  Degrees scaled by 100 */
+    short *sat_azimuth[L8_NBANDS];    /* Satellite azimuth angles for the
+                                         current band.  Degrees scaled by 100 */
+    int nlines[L8_NBANDS];            /* Number of lines for each band */
+    int nsamps[L8_NBANDS];            /* Number of samples for each band */
+    short *band_bufs[4];              /* Buffers for the current band, in
+                                         write order */
+    const char *angle_names[4] = {"solar_zenith", "solar_azimuth",
+        "sensor_zenith", "sensor_azimuth"};  /* Filename angle names */
+    const char *descriptions[4] = {"Solar angle file", "Solar angle file",
+        "Satellite/View angle file", "Satellite/View angle file"};
+                                      /* ENVI header descriptions */
+    const char *band_names[4] = {"Solar zenith angle", "Solar azimuth angle",
+        "View zenith angle", "View azimuth angle"};  /* ENVI band names */
+    Raw_binary_async_t *writers[4] = {NULL, NULL, NULL, NULL};
+                                      /* Writers for the current band */
+    FILE *fptrs[4] = {NULL, NULL, NULL, NULL};  /* Current band files */
+    Raw_binary_async_t *prev_writers[4] = {NULL, NULL, NULL, NULL};
+                                      /* Draining writers for the previous
+                                         band */
+    FILE *prev_fptrs[4] = {NULL, NULL, NULL, NULL};  /* Previous band files */
+    short *prev_bufs[4] = {NULL, NULL, NULL, NULL};  /* Previous band
+                                         buffers */
+
+    /* Resolve the band list into the per-band processing flags */
+    if (process_parameters(angle_coeff_name, subsamp_fact, fill_pix_value,
+        band_list, &parameters) != SUCCESS)
+    {
+        IAS_LOG_ERROR("Invalid input parameters");
+        return ERROR;
+    }
+
+    /* Generate and write the bands one at a time; the writes of one band
+       drain in the background while the next band is computed */
+    for (band_index = 0; band_index < L8_NBANDS; band_index++)
+    {
+        if (!parameters.process_band[band_index])
+            continue;
+        band_number = band_index + 1;
 
-        if (sat_azimuth)
+        /* Build the single band list for this band */
+        count = snprintf(band_string, sizeof(band_string), "%d", band_number);
+        if (count < 0 || count >= sizeof(band_string))
         {
-            for (line = 0, index = 0; line < frame[band_index].num_lines;
-                 line += sub_sample)
-                for (samp = 0; samp < frame[band_index].num_samps;
-                     samp += sub_sample, index++)
-                    sat_azimuth[band_index][index] = parameters.background;
+            IAS_LOG_ERROR("Overflow of band_string");
+            drain_angle_band_writers(4, prev_writers, prev_fptrs, prev_bufs);
+            return ERROR;
         }
 
-        if (solar_zenith)
-        {
-            for (line = 0, index = 0; line < frame[band_index].num_lines;
-                 line += sub_sample)
-                for (samp = 0; samp < frame[band_index].num_samps;
-                     samp += sub_sample, index++)
-                    solar_zenith[band_index][index] = parameters.background;
+        /* Create the angle bands for this band.  This call allocates the
+           angle buffers for the band. */
+        solar_zenith[band_index] = NULL;
+        solar_azimuth[band_index] = NULL;
+        sat_zenith[band_index] = NULL;
+        sat_azimuth[band_index] = NULL;
+        if (l8_per_pixel_angles(angle_coeff_name, subsamp_fact,
+            fill_pix_value, band_string, num_threads, resync_interval, frame,
+            solar_zenith, solar_azimuth, sat_zenith, sat_azimuth, nlines,
+            nsamps) != SUCCESS)
+        {   /* Error messages already written */
+            drain_angle_band_writers(4, prev_writers, prev_fptrs, prev_bufs);
+            return ERROR;
         }
 
-        if (solar_azimuth)
-        {
-            for (line = 0, index = 0; line < frame[band_index].num_lines;
-                 line += sub_sample)
-                for (samp = 0; samp < frame[band_index].num_samps;
-                     samp += sub_sample, index++)
-                    solar_azimuth[band_index][index] =
-                        parameters.background;
-        }
+        /* A band missing from the angle metadata was warned about by the
+           generation; there is nothing to write for it */
+        if (!solar_zenith[band_index] && !solar_azimuth[band_index]
+            && !sat_zenith[band_index] && !sat_azimuth[band_index])
+            continue;
 
-        /* Loop through the L1T lines and samples */
-        tmp_percent = 0;
-        for (line = 0, index = 0; line < frame[band_index].num_lines;
-             line += sub_sample)
+        /* Hand the four angle buffers for this band to the background
+           writers and write their ENVI headers */
+        IAS_LOG_INFO("Writing the angle bands for band number %d",
+            band_number);
+        band_bufs[0] = solar_zenith[band_index];
+        band_bufs[1] = solar_azimuth[band_index];
+        band_bufs[2] = sat_zenith[band_index];
+        band_bufs[3] = sat_azimuth[band_index];
+        for (windex = 0; windex < 4; windex++)
         {
-            double sun_angles[2];   /* Solar angles */
-            double sat_angles[2];   /* Viewing angles */
-
-            /* update status? */
-            curr_tmp_percent = 100 * line / frame[band_index].num_lines;
-            if (curr_tmp_percent > tmp_percent)
-            {
-                tmp_percent = curr_tmp_percent;
-                if (tmp_percent % 10 == 0)
-                {
-                    printf ("%d%% ", tmp_percent);
-                    fflush (stdout);
-                }
-            }
-
-            for (samp = 0; samp < frame[band_index].num_samps;
-                 samp += sub_sample, index++)
+            if (start_angle_band_write(&frame[band_index],
+                nlines[band_index], nsamps[band_index], band_bufs[windex],
+                outfile_base, band_number, angle_names[windex],
+                fill_pix_value, descriptions[windex], band_names[windex],
+                &fptrs[windex], &writers[windex]) != SUCCESS)
             {
-                /* If the current sample falls outside the actual range of
-                   image data in this scene, then goto the next pixel.  Fill
-                   pixels are already handled. */
-                if (samp <= trim_lut[line].start_sample || 
-                    samp >= trim_lut[line].end_sample)
-                {
-                    continue;
-                }
+                IAS_LOG_ERROR("Writing the %s band for band number %d",
+                    angle_names[windex], band_number);
 
-                /* Calculate the satellite and solar azimuth and zenith */
-                if (calculate_angles (&metadata, line, samp, band_index, 
-                    parameters.angle_type, sat_angles, sun_angles) != SUCCESS)
+                /* Free the buffers not yet handed to a writer, then finish
+                   the writers already draining */
+                for (windex = 0; windex < 4; windex++)
                 {
-                    IAS_LOG_ERROR("Evaluating angles in band %d", band_number);
-                    free(trim_lut);
-                    ias_angle_gen_free(&metadata);
-                    return ERROR;
+                    if (!writers[windex])
+                        free(band_bufs[windex]);
                 }
+                drain_angle_band_writers(4, writers, fptrs, band_bufs);
+                drain_angle_band_writers(4, prev_writers, prev_fptrs,
+                    prev_bufs);
+                return ERROR;
+            }
+        }
 
-                /* Quantize the angles by converting from radians to degrees 
-                   and scaling by a factor of 100 so it can be stored in the
-                   short integer image */
-                if (sat_azimuth)
-                    sat_azimuth[band_index][index] = (short) round (r2d *
-                        sat_angles[IAS_ANGLE_GEN_AZIMUTH_INDEX]);
-                if (sat_zenith)
-                    sat_zenith[band_index][index] = (short) round (r2d *
-                        sat_angles[IAS_ANGLE_GEN_ZENITH_INDEX]);
-                if (solar_azimuth)
-                    solar_azimuth[band_index][index] = (short) round (r2d *
-                        sun_angles[IAS_ANGLE_GEN_AZIMUTH_INDEX]);
-                if (solar_zenith)
-                    solar_zenith[band_index][index] = (short) round (r2d *
-                        sun_angles[IAS_ANGLE_GEN_ZENITH_INDEX]);
-            }  /* for samp */
-        }  /* for line */
-
-        /* update status */
-        printf ("100%%\n");
-        fflush (stdout);
-
-        /* Free the lookup table */
-        free(trim_lut);
-        trim_lut = NULL;
-    }  /* for band */
+        /* Finish the previous band while this one drains, then remember
+           this band as the draining one */
+        if (drain_angle_band_writers(4, prev_writers, prev_fptrs, prev_bufs)
+            != SUCCESS)
+        {   /* Error messages already printed */
+            drain_angle_band_writers(4, writers, fptrs, band_bufs);
+            return ERROR;
+        }
+        for (windex = 0; windex < 4; windex++)
+        {
+            prev_writers[windex] = writers[windex];
+            prev_fptrs[windex] = fptrs[windex];
+            prev_bufs[windex] = band_bufs[windex];
+            writers[windex] = NULL;
+            fptrs[windex] = NULL;
+        }
+    }
 
-    /* Release the metadata */
-    ias_angle_gen_free(&metadata);
+    /* Finish the last band still draining in the background writers */
+    if (drain_angle_band_writers(4, prev_writers, prev_fptrs, prev_bufs)
+        != SUCCESS)
+    {   /* Error messages already printed */
+        return ERROR;
+    }
 
     return SUCCESS;
 }
@@ -433,6 +1293,10 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 5/3/2015     Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added num_threads to calculate the angle lines
+                              with multiple threads
+8/31/2026    Gail Schmidt     Added resync_interval to support interpolating
+                              the angles between exact evaluations
 
 NOTES:
   1. The band pointers for solar zenith/azimuth and satellite zenith/azimuth
@@ -452,6 +1316,12 @@ int l8_per_pixel_avg_refl_angles
                                   angles (1=full resolution). OW take every Nth
                                   sample from the line, where N=subsamp_fact */
     short fill_pix_value,   /* I: Fill pixel value to use (-32768:32767) */
+    int num_threads,        /* I: Number of threads to use for calculating
+                                  the angle lines */
+    int resync_interval,    /* I: Interval between exact angle evaluations
+                                  along a line; the angles for the samples
+                                  in between are interpolated (<= 1
+                                  evaluates every sample exactly) */
     ANGLES_FRAME *avg_frame,  /* O: Image frame info for the scene */
     short **avg_solar_zenith, /* O: Addr of pointer for the average solar zenith
                                     angle array (if NULL, don't process),
@@ -530,8 +1400,8 @@ int l8_per_pixel_avg_refl_angles
        satellite/view angles for the reflectance band list. */
     sub_sample = subsamp_fact;
     if (l8_per_pixel_angles (angle_coeff_name, sub_sample, -9999,
-        refl_band_list, frame, solar_zenith, solar_azimuth, sat_zenith,
-        sat_azimuth, nlines, nsamps) != SUCCESS)
+        refl_band_list, num_threads, resync_interval, frame, solar_zenith,
+        solar_azimuth, sat_zenith, sat_azimuth, nlines, nsamps) != SUCCESS)
     {  /* Error messages already written */
         IAS_LOG_ERROR("Creating the per-pixel angles for the reflective bands");
         return ERROR;
@@ -1164,6 +2034,382 @@ int l8_per_pixel_avg_refl_angles
     return SUCCESS;
 }
 
+
+/**************************************************************************
+NAME: accumulate_band_angles
+
+PURPOSE: Adds one band's angle values into the running sum and pixel count
+arrays for the band average.  Values of 0 occur on the scene edges and are
+not counted so they don't throw off the average.
+
+RETURN VALUE:
+    Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+***************************************************************************/
+static void accumulate_band_angles
+(
+    const short *band_angles, /* I: Angle array for the current band */
+    int num_pixels,           /* I: Number of pixels in the band */
+    long *sum,                /* I/O: Running sum of the angles */
+    ushort *pix_count         /* I/O: Running count of the non-zero pixels */
+)
+{
+    int index;                /* current sample index */
+
+    for (index = 0; index < num_pixels; index++)
+    {
+        if (band_angles[index] != 0)
+        {
+            sum[index] += band_angles[index];
+            pix_count[index]++;
+        }
+    }
+}
+
+
+/**************************************************************************
+NAME: finalize_band_average
+
+PURPOSE: Converts the running sum and pixel count arrays into the average
+angle array.  Pixels which had no non-zero band values remain 0.
+
+RETURN VALUE:
+    Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+***************************************************************************/
+static void finalize_band_average
+(
+    const long *sum,          /* I: Running sum of the angles */
+    const ushort *pix_count,  /* I: Running count of the non-zero pixels */
+    int num_pixels,           /* I: Number of pixels in the band */
+    short *avg_angles         /* O: Average angle array */
+)
+{
+    int index;                /* current sample index */
+
+    for (index = 0; index < num_pixels; index++)
+    {
+        if (pix_count[index] != 0)
+            avg_angles[index] =
+                (short) (round ((float) sum[index] / pix_count[index]));
+    }
+}
+
+
+/**************************************************************************
+NAME: l8_per_pixel_avg_refl_angles_fused
+
+PURPOSE:   Uses the coefficients in the angle coefficients file to generate
+the average of the reflective band satellite viewing angle and/or solar
+angle values, on a per-pixel basis.  The bands are processed one at a time
+and accumulated into the running averages so only a single band of angles
+is ever held in memory, instead of the full set of per-band arrays that
+l8_per_pixel_avg_refl_angles keeps for its band difference diagnostics.
+
+RETURN VALUE:
+    Type = int
+    Value           Description
+    -----           -----------
+    ERROR           An error occurred generating the per-pixel solar and/or
+                    view angles
+    SUCCESS         Angle band generation was successful
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The band pointers for solar zenith/azimuth and satellite zenith/azimuth
+     averages will have space allocated for the entire band
+     (nlines * nsamps * sizeof (short)), unless NULL is passed in for the
+     address.
+  2. If any of the above pointers are NULL, then those per-pixel angles will
+     not be calculated.
+  3. It will be up to the calling routine to delete the memory allocated
+     for this reflectance band average angle array.
+  4. The angles that are returned are in degrees and have been scaled by 100.
+  5. The per-band difference diagnostics written by
+     l8_per_pixel_avg_refl_angles are not available from this routine since
+     the per-band arrays are released as each band is accumulated.
+***************************************************************************/
+int l8_per_pixel_avg_refl_angles_fused
+(
+    char *angle_coeff_name, /* I: Angle coefficient filename */
+    int subsamp_fact,       /* I: Subsample factor used when calculating the
+                                  angles (1=full resolution). OW take every Nth
+                                  sample from the line, where N=subsamp_fact */
+    short fill_pix_value,   /* I: Fill pixel value to use (-32768:32767) */
+    int num_threads,        /* I: Number of threads to use for calculating
+                                  the angle lines */
+    int resync_interval,    /* I: Interval between exact angle evaluations
+                                  along a line; the angles for the samples
+                                  in between are interpolated (<= 1
+                                  evaluates every sample exactly) */
+    ANGLES_FRAME *avg_frame,  /* O: Image frame info for the scene */
+    short **avg_solar_zenith, /* O: Addr of pointer for the average solar zenith
+                                    angle array (if NULL, don't process),
+                                    degrees scaled by 100 */
+    short **avg_solar_azimuth,/* O: Addr of pointer for the average solar
+                                    azimuth angle array (if NULL, don't
+                                    process), degrees scaled by 100 */
+    short **avg_sat_zenith,   /* O: Addr of pointer for the average satellite
+                                    zenith angle array (if NULL, don't process),
+                                    degrees scaled by 100 */
+    short **avg_sat_azimuth,  /* O: Addr of pointer for the average satellite
+                                    azimuth angle array (if NULL, don't
+                                    process), degrees scaled by 100 */
+    int *avg_nlines,          /* O: Number of lines for the bands, based on
+                                    on the subsample factor */
+    int *avg_nsamps           /* O: Number of samples for the bands, based on
+                                    the subsample factor */
+)
+{
+    char band_string[3];              /* band list for the current band */
+    int count;                        /* number of chars copied in snprintf */
+    int refl_band;                    /* reflectance band loop index */
+    int band_index;                   /* band index */
+    int angle_size = 0;               /* memory alloc angle size */
+    long *solar_zenith_sum = NULL;    /* running solar zenith sum */
+    long *solar_azimuth_sum = NULL;   /* running solar azimuth sum */
+    long *sat_zenith_sum = NULL;      /* running satellite zenith sum */
+    long *sat_azimuth_sum = NULL;     /* running satellite azimuth sum */
+    ushort *solar_zenith_count = NULL;  /* non-zero solar zenith pixels */
+    ushort *solar_azimuth_count = NULL; /* non-zero solar azimuth pixels */
+    ushort *sat_zenith_count = NULL;    /* non-zero satellite zenith pixels */
+    ushort *sat_azimuth_count = NULL;   /* non-zero satellite azimuth pixels */
+    ANGLES_FRAME frame[L8_NBANDS];    /* image frame info for each band */
+    short *solar_zenith[L8_NBANDS];   /* solar zenith angles for the current
+                                         band.  Degrees scaled by 100 */
+    short *solar_azimuth[L8_NBANDS];  /* solar azimuth angles for the current
+                                         band.  Degrees scaled by 100 */
+    short *sat_zenith[L8_NBANDS];     /* satellite zenith angles for the
+                                         current band.  Degrees scaled by 100 */
+    short *sat_azimuth[L8_NBANDS];    /* satellite azimuth angles for the
+                                         current band.  Degrees scaled by 100 */
+    int refl_band_numbers[] = {1, 2, 3, 4, 5, 6, 7, 9}; /* reflectance bands
+                                         to be used in the average */
+    int num_refl_bands = sizeof (refl_band_numbers)
+        / sizeof (refl_band_numbers[0]); /* number of reflectance bands */
+    int nlines[L8_NBANDS];  /* number of lines for each band, based on the
+                               subsample factor */
+    int nsamps[L8_NBANDS];  /* number of samples for each band, based on the
+                               subsample factor */
+
+    /* Process the reflectance bands one at a time and accumulate the angles
+       into the running sums.  Create a sub_sample product with a fill value
+       of -9999 to match the Landsat 8 image data. */
+    for (refl_band = 0; refl_band < num_refl_bands; refl_band++)
+    {
+        /* Build the single band list for this band */
+        count = snprintf (band_string, sizeof (band_string), "%d",
+            refl_band_numbers[refl_band]);
+        if (count < 0 || count >= sizeof (band_string))
+        {
+            IAS_LOG_ERROR("Overflow of band_string");
+            return ERROR;
+        }
+        band_index = refl_band_numbers[refl_band] - 1;
+
+        /* Create the angle band for this reflectance band.  This call
+           allocates memory for the requested angles for this band. */
+        if (l8_per_pixel_angles (angle_coeff_name, subsamp_fact, -9999,
+            band_string, num_threads, resync_interval, frame,
+            avg_solar_zenith ? solar_zenith : NULL,
+            avg_solar_azimuth ? solar_azimuth : NULL,
+            avg_sat_zenith ? sat_zenith : NULL,
+            avg_sat_azimuth ? sat_azimuth : NULL, nlines, nsamps) != SUCCESS)
+        {  /* Error messages already written */
+            IAS_LOG_ERROR("Creating the per-pixel angles for band %d",
+                refl_band_numbers[refl_band]);
+            free (solar_zenith_sum);
+            free (solar_zenith_count);
+            free (solar_azimuth_sum);
+            free (solar_azimuth_count);
+            free (sat_zenith_sum);
+            free (sat_zenith_count);
+            free (sat_azimuth_sum);
+            free (sat_azimuth_count);
+            return ERROR;
+        }
+
+        /* Allocate the running sum and pixel count arrays for the requested
+           angles on the first band.  The reflectance bands all share the
+           same 30m framing. */
+        if (refl_band == 0)
+        {
+            angle_size = nlines[band_index] * nsamps[band_index];
+            *avg_frame = frame[band_index];
+            *avg_nlines = nlines[band_index];
+            *avg_nsamps = nsamps[band_index];
+
+            if ((avg_solar_zenith != NULL
+                    && ((solar_zenith_sum = calloc (angle_size,
+                        sizeof (long))) == NULL
+                    || (solar_zenith_count = calloc (angle_size,
+                        sizeof (ushort))) == NULL))
+                || (avg_solar_azimuth != NULL
+                    && ((solar_azimuth_sum = calloc (angle_size,
+                        sizeof (long))) == NULL
+                    || (solar_azimuth_count = calloc (angle_size,
+                        sizeof (ushort))) == NULL))
+                || (avg_sat_zenith != NULL
+                    && ((sat_zenith_sum = calloc (angle_size,
+                        sizeof (long))) == NULL
+                    || (sat_zenith_count = calloc (angle_size,
+                        sizeof (ushort))) == NULL))
+                || (avg_sat_azimuth != NULL
+                    && ((sat_azimuth_sum = calloc (angle_size,
+                        sizeof (long))) == NULL
+                    || (sat_azimuth_count = calloc (angle_size,
+                        sizeof (ushort))) == NULL)))
+            {
+                IAS_LOG_ERROR("Allocating arrays for holding the running "
+                    "sums of the bands");
+                free (solar_zenith_sum);
+                free (solar_zenith_count);
+                free (solar_azimuth_sum);
+                free (solar_azimuth_count);
+                free (sat_zenith_sum);
+                free (sat_zenith_count);
+                free (sat_azimuth_sum);
+                free (sat_azimuth_count);
+                if (avg_solar_zenith != NULL)
+                    free (solar_zenith[band_index]);
+                if (avg_solar_azimuth != NULL)
+                    free (solar_azimuth[band_index]);
+                if (avg_sat_zenith != NULL)
+                    free (sat_zenith[band_index]);
+                if (avg_sat_azimuth != NULL)
+                    free (sat_azimuth[band_index]);
+                return ERROR;
+            }
+        }
+
+        /* Add this band to the running sums, then release the band since
+           only the accumulators are carried forward */
+        if (avg_solar_zenith != NULL)
+        {
+            accumulate_band_angles (solar_zenith[band_index], angle_size,
+                solar_zenith_sum, solar_zenith_count);
+            free (solar_zenith[band_index]);
+        }
+
+        if (avg_solar_azimuth != NULL)
+        {
+            accumulate_band_angles (solar_azimuth[band_index], angle_size,
+                solar_azimuth_sum, solar_azimuth_count);
+            free (solar_azimuth[band_index]);
+        }
+
+        if (avg_sat_zenith != NULL)
+        {
+            accumulate_band_angles (sat_zenith[band_index], angle_size,
+                sat_zenith_sum, sat_zenith_count);
+            free (sat_zenith[band_index]);
+        }
+
+        if (avg_sat_azimuth != NULL)
+        {
+            accumulate_band_angles (sat_azimuth[band_index], angle_size,
+                sat_azimuth_sum, sat_azimuth_count);
+            free (sat_azimuth[band_index]);
+        }
+    }  /* for refl_band */
+
+    /* Allocate the average angle arrays and compute the averages from the
+       running sums */
+    if (avg_solar_zenith != NULL)
+    {
+        *avg_solar_zenith = calloc (angle_size, sizeof (short));
+        if (*avg_solar_zenith == NULL)
+        {
+            IAS_LOG_ERROR("Allocating average solar zenith angle array");
+            free (solar_zenith_sum);
+            free (solar_zenith_count);
+            free (solar_azimuth_sum);
+            free (solar_azimuth_count);
+            free (sat_zenith_sum);
+            free (sat_zenith_count);
+            free (sat_azimuth_sum);
+            free (sat_azimuth_count);
+            return ERROR;
+        }
+        finalize_band_average (solar_zenith_sum, solar_zenith_count,
+            angle_size, *avg_solar_zenith);
+        free (solar_zenith_sum);
+        free (solar_zenith_count);
+    }
+
+    if (avg_solar_azimuth != NULL)
+    {
+        *avg_solar_azimuth = calloc (angle_size, sizeof (short));
+        if (*avg_solar_azimuth == NULL)
+        {
+            IAS_LOG_ERROR("Allocating average solar azimuth angle array");
+            free (solar_azimuth_sum);
+            free (solar_azimuth_count);
+            free (sat_zenith_sum);
+            free (sat_zenith_count);
+            free (sat_azimuth_sum);
+            free (sat_azimuth_count);
+            return ERROR;
+        }
+        finalize_band_average (solar_azimuth_sum, solar_azimuth_count,
+            angle_size, *avg_solar_azimuth);
+        free (solar_azimuth_sum);
+        free (solar_azimuth_count);
+    }
+
+    if (avg_sat_zenith != NULL)
+    {
+        *avg_sat_zenith = calloc (angle_size, sizeof (short));
+        if (*avg_sat_zenith == NULL)
+        {
+            IAS_LOG_ERROR("Allocating average satellite zenith angle array");
+            free (sat_zenith_sum);
+            free (sat_zenith_count);
+            free (sat_azimuth_sum);
+            free (sat_azimuth_count);
+            return ERROR;
+        }
+        finalize_band_average (sat_zenith_sum, sat_zenith_count, angle_size,
+            *avg_sat_zenith);
+        free (sat_zenith_sum);
+        free (sat_zenith_count);
+    }
+
+    if (avg_sat_azimuth != NULL)
+    {
+        *avg_sat_azimuth = calloc (angle_size, sizeof (short));
+        if (*avg_sat_azimuth == NULL)
+        {
+            IAS_LOG_ERROR("Allocating average satellite azimuth angle array");
+            free (sat_azimuth_sum);
+            free (sat_azimuth_count);
+            return ERROR;
+        }
+        finalize_band_average (sat_azimuth_sum, sat_azimuth_count, angle_size,
+            *avg_sat_azimuth);
+        free (sat_azimuth_sum);
+        free (sat_azimuth_count);
+    }
+
+    return SUCCESS;
+}
+
 /******************************************************************************
 NAME: process_parameters
 
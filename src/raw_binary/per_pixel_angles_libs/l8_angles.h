@@ -60,6 +60,12 @@ int l8_per_pixel_angles
                                   between.  Example: 1,2,3,4,5,6,7,8,9
                                   The solar/sat_zenith/azimuth arrays should
                                   will have angles processed for these bands */
+    int num_threads,        /* I: Number of threads to use for calculating
+                                  the angle lines */
+    int resync_interval,    /* I: Interval between exact angle evaluations
+                                  along a line; the angles for the samples
+                                  in between are interpolated (<= 1
+                                  evaluates every sample exactly) */
     ANGLES_FRAME frame[L8_NBANDS],   /* O: Image frame info for each band */
     short *solar_zenith[L8_NBANDS],  /* O: Array of pointers for the solar
                                            zenith angle array, one per band
@@ -77,6 +83,32 @@ int l8_per_pixel_angles
     int nsamps[L8_NBANDS]   /* O: Number of samples for each band */
 );
 
+/* Single pipeline from the angle coefficient file to the written angle band
+   files: the angles are generated one band at a time and handed straight to
+   background writers, so no more than two bands of angle arrays are alive
+   at once and nothing is repacked between the generation and the write.
+   The band files are named <base>_B<n>_<angle>.img for the solar_zenith,
+   solar_azimuth, sensor_zenith, and sensor_azimuth angles, each with a
+   matching ENVI header. */
+int l8_write_angle_bands
+(
+    char *angle_coeff_name, /* I: Angle coefficient filename */
+    char *outfile_base,     /* I: Base filename for the output angle bands */
+    int subsamp_fact,       /* I: Subsample factor used when calculating the
+                                  angles (1=full resolution) */
+    short fill_pix_value,   /* I: Fill pixel value to use (-32768:32767) */
+    char *band_list,        /* I: Band list used to calculate angles for.
+                                  "ALL" - defaults to all bands 1 - 11.
+                                  Must be comma separated with no spaces in
+                                  between.  Example: 1,2,3,4,5,6,7,8,9 */
+    int num_threads,        /* I: Number of threads to use for calculating
+                                  the angle lines */
+    int resync_interval     /* I: Interval between exact angle evaluations
+                                  along a line; the angles for the samples
+                                  in between are interpolated (<= 1
+                                  evaluates every sample exactly) */
+);
+
 int l8_per_pixel_avg_refl_angles
 (
     char *angle_coeff_name, /* I: Angle coefficient filename */
@@ -84,6 +116,47 @@ int l8_per_pixel_avg_refl_angles
                                   angles (1=full resolution). OW take every Nth
                                   sample from the line, where N=subsamp_fact */
     short fill_pix_value,   /* I: Fill pixel value to use (-32768:32767) */
+    int num_threads,        /* I: Number of threads to use for calculating
+                                  the angle lines */
+    int resync_interval,    /* I: Interval between exact angle evaluations
+                                  along a line; the angles for the samples
+                                  in between are interpolated (<= 1
+                                  evaluates every sample exactly) */
+    ANGLES_FRAME *avg_frame,  /* O: Image frame info for the scene */
+    short **avg_solar_zenith, /* O: Addr of pointer for the average solar zenith
+                                    angle array (if NULL, don't process),
+                                    degrees scaled by 100 */
+    short **avg_solar_azimuth,/* O: Addr of pointer for the average solar
+                                    azimuth angle array (if NULL, don't
+                                    process), degrees scaled by 100 */
+    short **avg_sat_zenith,   /* O: Addr of pointer for the average satellite
+                                    zenith angle array (if NULL, don't process),
+                                    degrees scaled by 100 */
+    short **avg_sat_azimuth,  /* O: Addr of pointer for the average satellite
+                                    azimuth angle array (if NULL, don't
+                                    process), degrees scaled by 100 */
+    int *avg_nlines,          /* O: Number of lines for the bands, based on
+                                    on the subsample factor */
+    int *avg_nsamps           /* O: Number of samples for the bands, based on
+                                    the subsample factor */
+);
+
+/* Same interface as l8_per_pixel_avg_refl_angles, but accumulates the bands
+   one at a time so only a single band of angles is held in memory.  Does not
+   provide the per-band difference diagnostics. */
+int l8_per_pixel_avg_refl_angles_fused
+(
+    char *angle_coeff_name, /* I: Angle coefficient filename */
+    int subsamp_fact,       /* I: Subsample factor used when calculating the
+                                  angles (1=full resolution). OW take every Nth
+                                  sample from the line, where N=subsamp_fact */
+    short fill_pix_value,   /* I: Fill pixel value to use (-32768:32767) */
+    int num_threads,        /* I: Number of threads to use for calculating
+                                  the angle lines */
+    int resync_interval,    /* I: Interval between exact angle evaluations
+                                  along a line; the angles for the samples
+                                  in between are interpolated (<= 1
+                                  evaluates every sample exactly) */
     ANGLES_FRAME *avg_frame,  /* O: Image frame info for the scene */
     short **avg_solar_zenith, /* O: Addr of pointer for the average solar zenith
                                     angle array (if NULL, don't process),
@@ -103,9 +176,46 @@ int l8_per_pixel_avg_refl_angles
                                     the subsample factor */
 );
 
+/* Evaluates the angles at a list of L1T coordinates for a single band
+   without setting up per-band frames or allocating angle arrays.  Intended
+   for quick lookups like the scene-center angles. */
+int l8_point_angles
+(
+    char *angle_coeff_name, /* I: Angle coefficient filename */
+    int band_number,        /* I: Band number to evaluate */
+    int num_points,         /* I: Number of point coordinates */
+    const int *lines,       /* I: L1T line coordinate for each point */
+    const int *samps,       /* I: L1T sample coordinate for each point */
+    ANGLE_TYPE angle_type,  /* I: Type of angles to generate */
+    double *sat_angles,     /* O: Satellite zenith/azimuth pair per point
+                                  (radians; not used for AT_SOLAR) */
+    double *sun_angles      /* O: Solar zenith/azimuth pair per point
+                                  (radians; not used for AT_SATELLITE) */
+);
+
+/* Evaluates the angles at a list of sub-pixel L1T coordinates for a list
+   of bands without setting up frames or allocating angle arrays.  The
+   pairs are ordered by band then point. */
+int l8_sample_angles
+(
+    char *angle_coeff_name,  /* I: Angle coefficient filename */
+    int num_bands,           /* I: Number of bands to evaluate */
+    const int *band_numbers, /* I: Band number for each band */
+    int num_points,          /* I: Number of point coordinates */
+    const double *lines,     /* I: Sub-pixel L1T line for each point */
+    const double *samps,     /* I: Sub-pixel L1T sample for each point */
+    ANGLE_TYPE angle_type,   /* I: Type of angles to generate */
+    double *sat_angles,      /* O: Satellite zenith/azimuth pair per band
+                                   per point (radians; not used for
+                                   AT_SOLAR) */
+    double *sun_angles       /* O: Solar zenith/azimuth pair per band per
+                                   point (radians; not used for
+                                   AT_SATELLITE) */
+);
+
 int calculate_angles
 (
-    const IAS_ANGLE_GEN_METADATA *metadata, /* I: Angle metadata structure */ 
+    const IAS_ANGLE_GEN_METADATA *metadata, /* I: Angle metadata structure */
     int line,                               /* I: L1T line coordinate */
     int samp,                               /* I: L1T sample coordinate */
     int band_index,                         /* I: Spectral band number */
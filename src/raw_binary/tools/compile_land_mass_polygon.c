@@ -0,0 +1,275 @@
+/*****************************************************************************
+FILE: compile_land_mass_polygon
+
+PURPOSE: Compiles the land-mass polygon file into a preprocessed binary cache
+that the land/water mask generation can memory map instead of re-parsing the
+polygon file for every scene.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     The cache now holds reduced-resolution
+                              simplification levels of the polygons, selected
+                              at load time by the mask pixel size
+
+NOTES:
+*****************************************************************************/
+#include <getopt.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "error_handler.h"
+#include "ias_lw_geo.h"
+#include "espa_startup.h"
+
+/******************************************************************************
+MODULE: usage
+
+PURPOSE: Prints the usage information for this application.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+---------    ---------------  -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void usage ()
+{
+    printf ("compile_land_mass_polygon compiles a land-mass polygon file "
+            "into a preprocessed binary cache, written beside the polygon "
+            "file with a .cache extension.  The land/water mask generation "
+            "memory maps the cache instead of re-parsing the polygon file "
+            "for every scene.\n\n");
+    printf ("usage: compile_land_mass_polygon "
+            "[--polygon=land_mass_polygon_filename]\n");
+
+    printf ("\nwhere the following parameters are optional:\n");
+    printf ("    -polygon: name of the land-mass polygon file.  If not "
+            "specified, the polygon file named by the "
+            "ESPA_LAND_MASS_POLYGON environment variable is used.\n");
+    printf ("\nExample: compile_land_mass_polygon "
+            "--polygon=land_no_buf.ply\n");
+    printf ("\n    --startup-profile: report the time spent in the startup "
+            "phases (library init, schema validation, XML parse, first I/O) "
+            "to stderr; shared by all the ESPA tools\n");
+}
+
+
+/******************************************************************************
+MODULE:  get_args
+
+PURPOSE:  Gets the command-line arguments and validates that the required
+arguments were specified.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error getting the command-line arguments or a command-line
+                argument and associated value were not specified
+SUCCESS         No errors encountered
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Memory is allocated for the input polygon file.  The caller is
+     responsible for freeing the allocated memory upon successful return.
+******************************************************************************/
+short get_args
+(
+    int argc,             /* I: number of cmd-line args */
+    char *argv[],         /* I: string of cmd-line args */
+    char **polygon_file   /* O: address of input polygon filename */
+)
+{
+    int c;                           /* current argument index */
+    int option_index;                /* index for the command-line option */
+    char errmsg[STR_SIZE];           /* error message */
+    char FUNC_NAME[] = "get_args";   /* function name */
+    static struct option long_options[] =
+    {
+        {"polygon", required_argument, 0, 'p'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    /* Loop through all the cmd-line options */
+    opterr = 0;   /* turn off getopt_long error msgs as we'll print our own */
+    while (1)
+    {
+        /* optstring in call to getopt_long is empty since we will only
+           support the long options */
+        c = getopt_long (argc, argv, "", long_options, &option_index);
+        if (c == -1)
+        {   /* Out of cmd-line options */
+            break;
+        }
+
+        switch (c)
+        {
+            case 0:
+                /* If this option set a flag, do nothing else now. */
+                if (long_options[option_index].flag != 0)
+                    break;
+
+            case 'h':  /* help */
+                usage ();
+                return (ERROR);
+                break;
+
+            case 'p':  /* polygon infile */
+            *polygon_file = strdup (optarg);
+            break;
+
+            case '?':
+            default:
+                sprintf (errmsg, "Unknown option %s", argv[optind-1]);
+                error_handler (true, FUNC_NAME, errmsg);
+                usage ();
+                return (ERROR);
+                break;
+        }
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  main
+
+PURPOSE: Loads the complete land-mass polygon file and writes it back out as
+a preprocessed binary cache file, named after the polygon file with a .cache
+extension.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error compiling the polygon cache
+SUCCESS         No errors encountered
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. If the polygon file is not specified on the command line, the
+     ESPA_LAND_MASS_POLYGON environment variable needs to be defined and
+     contain the full path and filename of the land-mass polygon.
+******************************************************************************/
+int main (int argc, char** argv)
+{
+    char FUNC_NAME[] = "compile_land_mass_polygon";  /* function name */
+    char errmsg[STR_SIZE];       /* error message */
+    char cachefile[STR_SIZE];    /* output polygon cache filename */
+    char *polygon_file = NULL;   /* filename of the land-mass polygon */
+    IAS_POLYGON_LINKED_LIST *polygon_list = NULL;  /* polygon linked list */
+    FILE *fptr = NULL;           /* file pointer */
+
+    /* Strip the shared --startup-profile option before parsing the
+       tool's own arguments */
+    espa_startup_profile_args (&argc, argv);
+
+    /* Read the command-line arguments */
+    if (get_args (argc, argv, &polygon_file) != SUCCESS)
+    {   /* get_args already printed the error message */
+        exit (ERROR);
+    }
+
+    /* Fall back to the ESPA land/water mask environment variable which
+       specifies the location of the land-mass polygon */
+    if (polygon_file == NULL)
+    {
+        char *env_polygon = getenv ("ESPA_LAND_MASS_POLYGON");
+        if (env_polygon == NULL)
+        {
+            sprintf (errmsg, "No polygon file was specified and the "
+                "ESPA_LAND_MASS_POLYGON environment variable is not "
+                "defined. Specify --polygon or define the environment "
+                "variable to contain the full path and filename of the "
+                "land-mass polygon.\n");
+            error_handler (true, FUNC_NAME, errmsg);
+            exit (ERROR);
+        }
+        polygon_file = strdup (env_polygon);
+    }
+    printf ("Compiling land-mass polygon file: %s\n", polygon_file);
+
+    /* Load the complete polygon file */
+    fptr = fopen (polygon_file, "r");
+    if (!fptr)
+    {
+        sprintf (errmsg, "Unable to open the land-mass polygon file: %s",
+            polygon_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        exit (ERROR);
+    }
+
+    if (ias_geo_load_polygon (fptr, -360.0, 360.0, -90.0, 90.0,
+        &polygon_list) != SUCCESS)
+    {
+        sprintf (errmsg, "Loading the land-mass polygon file: %s",
+            polygon_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        fclose (fptr);
+        exit (ERROR);
+    }
+    fclose (fptr);
+
+    /* Write the polygon cache beside the polygon file */
+    if (snprintf (cachefile, sizeof (cachefile), "%s.cache", polygon_file)
+        >= (int) sizeof (cachefile))
+    {
+        sprintf (errmsg, "Polygon cache filename is too long");
+        error_handler (true, FUNC_NAME, errmsg);
+        exit (ERROR);
+    }
+
+    fptr = fopen (cachefile, "wb");
+    if (!fptr)
+    {
+        sprintf (errmsg, "Unable to open the polygon cache file: %.1024s",
+            cachefile);
+        error_handler (true, FUNC_NAME, errmsg);
+        exit (ERROR);
+    }
+
+    if (ias_geo_write_polygon_cache (polygon_list, fptr) != SUCCESS)
+    {
+        sprintf (errmsg, "Writing the polygon cache file: %.1024s", cachefile);
+        error_handler (true, FUNC_NAME, errmsg);
+        fclose (fptr);
+        exit (ERROR);
+    }
+
+    if (fclose (fptr) != 0)
+    {
+        sprintf (errmsg, "Closing the polygon cache file: %.1024s", cachefile);
+        error_handler (true, FUNC_NAME, errmsg);
+        exit (ERROR);
+    }
+    printf ("Wrote polygon cache file: %s\n", cachefile);
+
+    /* Free the polygon list and the filename */
+    ias_geo_free_polygon_linked_list (polygon_list);
+    free (polygon_file);
+
+    /* Successful completion */
+    exit (SUCCESS);
+}
@@ -15,6 +15,17 @@ Date         Programmer       Reason
 1/14/2014    Gail Schmidt     Original development
 4/2/2014     Gail Schmidt     Added a command-line flag to remove the source
                               files if specified
+8/31/2026    Gail Schmidt     Added command-line options to write tiled
+                              GeoTIFFs and to convert the bands with multiple
+                              threads
+8/31/2026    Gail Schmidt     Added command-line options for the compression
+                              codec and level
+8/31/2026    Gail Schmidt     Added a command-line option for cloud-optimized
+                              GeoTIFF output
+8/31/2026    Gail Schmidt     Added a command-line option to select the bands
+                              to convert
+8/31/2026    Gail Schmidt     Added a command-line option for the browse
+                              reduction factor
 
 NOTES:
   1. The XML metadata format parsed or written via this library follows the
@@ -24,6 +35,7 @@ NOTES:
 *****************************************************************************/
 #include <getopt.h>
 #include "convert_espa_to_gtif.h"
+#include "espa_startup.h"
 
 /******************************************************************************
 MODULE: usage
@@ -50,17 +62,41 @@ void usage ()
     printf ("usage: convert_espa_to_gtif "
             "--xml=input_metadata_filename "
             "--gtif=output_geotiff_base_filename "
-            "[--del_src_files]\n");
+            "[--bands=band_filter] [--del_src_files] [--tiled] [--cog] "
+            "[--compress=deflate|lzw] [--compress_level=level] "
+            "[--browse=factor] [--num_threads=nthreads]\n");
 
     printf ("\nwhere the following parameters are required:\n");
     printf ("    -xml: name of the input XML metadata file which follows "
             "the ESPA internal raw binary schema\n");
     printf ("    -gtif: base filename of the output GeoTIFF files\n");
+    printf ("    -bands: comma-separated list of bands to convert; each "
+            "entry is a band name, product:<product type>, or "
+            "category:<category> (default is to convert every band)\n");
     printf ("    -del_src_files: if specified the source image and header "
             "files will be removed\n");
+    printf ("    -tiled: if specified the GeoTIFF files will be written "
+            "tiled instead of stripped, for faster windowed reads\n");
+    printf ("    -cog: if specified cloud-optimized GeoTIFF files "
+            "(tiled, header-first layout, internal pyramid overviews) will "
+            "be written, ready for range-read consumers without a separate "
+            "GDAL pass\n");
+    printf ("    -compress: compression codec for the GeoTIFF files "
+            "(deflate or lzw; default is uncompressed)\n");
+    printf ("    -compress_level: deflate compression level, 1-9 (default "
+            "is 6; ignored for the other codecs)\n");
+    printf ("    -browse: browse reduction factor; the GeoTIFF files are "
+            "written at 1/factor of the band resolution, reduced in the "
+            "conversion itself so the full-resolution GeoTIFF is never "
+            "materialized (default is 1 for full resolution)\n");
+    printf ("    -num_threads: number of threads to use for converting the "
+            "bands (default is 1 for serial conversion)\n");
     printf ("\nExample: convert_espa_to_gtif "
             "--xml=LE70230282011250EDC00.xml "
             "--gtif=LE70230282011250EDC00\n");
+    printf ("\n    --startup-profile: report the time spent in the startup "
+            "phases (library init, schema validation, XML parse, first I/O) "
+            "to stderr; shared by all the ESPA tools\n");
 }
 
 
@@ -82,6 +118,17 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 1/14/2014    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added command-line options to write tiled
+                              GeoTIFFs and to convert the bands with multiple
+                              threads
+8/31/2026    Gail Schmidt     Added command-line options for the compression
+                              codec and level
+8/31/2026    Gail Schmidt     Added a command-line option for cloud-optimized
+                              GeoTIFF output
+8/31/2026    Gail Schmidt     Added a command-line option to select the bands
+                              to convert
+8/31/2026    Gail Schmidt     Added a command-line option for the browse
+                              reduction factor
 
 NOTES:
   1. Memory is allocated for the input and output files.  All of these should
@@ -94,7 +141,18 @@ short get_args
     char *argv[],         /* I: string of cmd-line args */
     char **xml_infile,    /* O: address of input XML filename */
     char **gtif_outfile,  /* O: address of output GeoTIFF base filename */
-    bool *del_src         /* O: should source files be removed? */
+    char **band_filter,   /* O: address of the band filter; NULL to convert
+                                every band */
+    bool *del_src,        /* O: should source files be removed? */
+    bool *tiled,          /* O: should the GeoTIFFs be written tiled? */
+    bool *cog,            /* O: should cloud-optimized GeoTIFFs be written? */
+    char **compress,      /* O: address of the compression codec; NULL for
+                                uncompressed output */
+    int *compress_level,  /* O: deflate compression level */
+    int *browse_factor,   /* O: browse reduction factor; 1 for full
+                                resolution */
+    int *num_threads      /* O: number of threads to use for converting the
+                                bands */
 )
 {
     int c;                           /* current argument index */
@@ -102,9 +160,19 @@ short get_args
     char errmsg[STR_SIZE];           /* error message */
     char FUNC_NAME[] = "get_args";   /* function name */
     static int del_flag = 0;         /* flag for removing the source files */
+    static int tiled_flag = 0;       /* flag for writing tiled GeoTIFFs */
+    static int cog_flag = 0;         /* flag for writing cloud-optimized
+                                        GeoTIFFs */
     static struct option long_options[] =
     {
         {"del_src_files", no_argument, &del_flag, 1},
+        {"tiled", no_argument, &tiled_flag, 1},
+        {"cog", no_argument, &cog_flag, 1},
+        {"compress", required_argument, 0, 'c'},
+        {"compress_level", required_argument, 0, 'l'},
+        {"browse", required_argument, 0, 'r'},
+        {"num_threads", required_argument, 0, 't'},
+        {"bands", required_argument, 0, 'b'},
         {"xml", required_argument, 0, 'i'},
         {"gtif", required_argument, 0, 'o'},
         {"help", no_argument, 0, 'h'},
@@ -142,7 +210,27 @@ short get_args
             case 'o':  /* GeoTIFF base outfile */
                 *gtif_outfile = strdup (optarg);
                 break;
-     
+
+            case 'b':  /* band filter */
+                *band_filter = strdup (optarg);
+                break;
+
+            case 'c':  /* compression codec */
+                *compress = strdup (optarg);
+                break;
+
+            case 'l':  /* deflate compression level */
+                *compress_level = atoi (optarg);
+                break;
+
+            case 'r':  /* browse reduction factor */
+                *browse_factor = atoi (optarg);
+                break;
+
+            case 't':  /* number of band conversion threads */
+                *num_threads = atoi (optarg);
+                break;
+
             case '?':
             default:
                 sprintf (errmsg, "Unknown option %s", argv[optind-1]);
@@ -174,6 +262,50 @@ short get_args
     if (del_flag)
         *del_src = true;
 
+    /* Check the tiled GeoTIFF flag */
+    if (tiled_flag)
+        *tiled = true;
+
+    /* Check the cloud-optimized GeoTIFF flag */
+    if (cog_flag)
+        *cog = true;
+
+    /* Make sure the compression codec and level are sensible */
+    if (*compress != NULL && strcmp (*compress, "deflate") &&
+        strcmp (*compress, "lzw"))
+    {
+        sprintf (errmsg, "Compression codec must be deflate or lzw");
+        error_handler (true, FUNC_NAME, errmsg);
+        usage ();
+        return (ERROR);
+    }
+
+    if (*compress_level < 1 || *compress_level > 9)
+    {
+        sprintf (errmsg, "Compression level must be between 1 and 9");
+        error_handler (true, FUNC_NAME, errmsg);
+        usage ();
+        return (ERROR);
+    }
+
+    /* Make sure the browse reduction factor is sensible */
+    if (*browse_factor < 1)
+    {
+        sprintf (errmsg, "Browse reduction factor must be 1 or greater");
+        error_handler (true, FUNC_NAME, errmsg);
+        usage ();
+        return (ERROR);
+    }
+
+    /* Make sure the number of threads is sensible */
+    if (*num_threads < 1)
+    {
+        sprintf (errmsg, "Number of threads must be 1 or higher");
+        error_handler (true, FUNC_NAME, errmsg);
+        usage ();
+        return (ERROR);
+    }
+
     return (SUCCESS);
 }
 
@@ -204,16 +336,32 @@ int main (int argc, char** argv)
 {
     char *xml_infile = NULL;     /* input XML filename */
     char *gtif_outfile = NULL;   /* output base GeoTIFF filename */
+    char *band_filter = NULL;    /* band filter; NULL to convert every band */
     bool del_src = false;        /* should source files be removed? */
+    bool tiled = false;          /* should the GeoTIFFs be written tiled? */
+    bool cog = false;            /* should cloud-optimized GeoTIFFs be
+                                    written? */
+    char *compress = NULL;       /* compression codec; NULL for uncompressed */
+    int compress_level = 6;      /* deflate compression level */
+    int browse_factor = 1;       /* browse reduction factor */
+    int num_threads = 1;         /* number of band conversion threads */
+
+    /* Strip the shared --startup-profile option before parsing the
+       tool's own arguments */
+    espa_startup_profile_args (&argc, argv);
 
     /* Read the command-line arguments */
-    if (get_args (argc, argv, &xml_infile, &gtif_outfile, &del_src) != SUCCESS)
+    if (get_args (argc, argv, &xml_infile, &gtif_outfile, &band_filter,
+        &del_src, &tiled, &cog, &compress, &compress_level, &browse_factor,
+        &num_threads) != SUCCESS)
     {   /* get_args already printed the error message */
         exit (EXIT_FAILURE);
     }
 
     /* Convert the internal ESPA raw binary product to GeoTIFF */
-    if (convert_espa_to_gtif (xml_infile, gtif_outfile, del_src) != SUCCESS)
+    if (convert_espa_to_gtif (xml_infile, gtif_outfile, band_filter, del_src,
+        tiled, cog, compress, compress_level, browse_factor,
+        num_threads) != SUCCESS)
     {  /* Error messages already written */
         exit (EXIT_FAILURE);
     }
@@ -221,6 +369,8 @@ int main (int argc, char** argv)
     /* Free the pointers */
     free (xml_infile);
     free (gtif_outfile);
+    free (band_filter);
+    free (compress);
 
     /* Successful completion */
     exit (EXIT_SUCCESS);
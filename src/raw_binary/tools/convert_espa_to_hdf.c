@@ -15,6 +15,8 @@ Date         Programmer       Reason
 1/14/2014    Gail Schmidt     Original development
 4/2/2014     Gail Schmidt     Added a command-line flag to remove the source
                               files if specified
+8/31/2026    Gail Schmidt     Added a command-line option to select the bands
+                              to convert
 
 NOTES:
   1. The XML metadata format parsed or written via this library follows the
@@ -24,6 +26,7 @@ NOTES:
 *****************************************************************************/
 #include <getopt.h>
 #include "convert_espa_to_hdf.h"
+#include "espa_startup.h"
 
 /******************************************************************************
 MODULE: usage
@@ -50,17 +53,23 @@ void usage ()
     printf ("usage: convert_espa_to_hdf "
             "--xml=input_metadata_filename "
             "--hdf=output_hdf_filename "
-            "[--del_src_files]\n");
+            "[--bands=band_filter] [--del_src_files]\n");
 
     printf ("\nwhere the following parameters are required:\n");
     printf ("    -xml: name of the input XML metadata file which follows "
             "the ESPA internal raw binary schema\n");
     printf ("    -hdf: filename of the output HDF file\n");
+    printf ("    -bands: comma-separated list of bands to convert; each "
+            "entry is a band name, product:<product type>, or "
+            "category:<category> (default is to convert every band)\n");
     printf ("    -del_src_files: if specified the source image and header "
             "files will be removed\n");
     printf ("\nExample: convert_espa_to_hdf "
             "--xml=LE70230282011250EDC00.xml "
             "--hdf=LE70230282011250EDC00.hdf\n");
+    printf ("\n    --startup-profile: report the time spent in the startup "
+            "phases (library init, schema validation, XML parse, first I/O) "
+            "to stderr; shared by all the ESPA tools\n");
 }
 
 
@@ -82,6 +91,8 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 1/14/2014    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added a command-line option to select the bands
+                              to convert
 
 NOTES:
   1. Memory is allocated for the input and output files.  All of these should
@@ -94,6 +105,8 @@ short get_args
     char *argv[],         /* I: string of cmd-line args */
     char **xml_infile,    /* O: address of input XML filename */
     char **hdf_outfile,   /* O: address of output HDF filename */
+    char **band_filter,   /* O: address of the band filter; NULL to convert
+                                every band */
     bool *del_src         /* O: should source files be removed? */
 )
 {
@@ -105,6 +118,7 @@ short get_args
     static struct option long_options[] =
     {
         {"del_src_files", no_argument, &del_flag, 1},
+        {"bands", required_argument, 0, 'b'},
         {"xml", required_argument, 0, 'i'},
         {"hdf", required_argument, 0, 'o'},
         {"help", no_argument, 0, 'h'},
@@ -142,6 +156,10 @@ short get_args
             case 'o':  /* HDF outfile */
                 *hdf_outfile = strdup (optarg);
                 break;
+
+            case 'b':  /* band filter */
+                *band_filter = strdup (optarg);
+                break;
      
             case '?':
             default:
@@ -204,16 +222,23 @@ int main (int argc, char** argv)
 {
     char *xml_infile = NULL;     /* input XML filename */
     char *hdf_outfile = NULL;    /* output HDF filename */
+    char *band_filter = NULL;    /* band filter; NULL to convert every band */
     bool del_src = false;        /* should source files be removed? */
 
+    /* Strip the shared --startup-profile option before parsing the
+       tool's own arguments */
+    espa_startup_profile_args (&argc, argv);
+
     /* Read the command-line arguments */
-    if (get_args (argc, argv, &xml_infile, &hdf_outfile, &del_src) != SUCCESS)
+    if (get_args (argc, argv, &xml_infile, &hdf_outfile, &band_filter,
+        &del_src) != SUCCESS)
     {   /* get_args already printed the error message */
         exit (EXIT_FAILURE);
     }
 
     /* Convert the internal ESPA raw binary product to HDF with external SDSs */
-    if (convert_espa_to_hdf (xml_infile, hdf_outfile, del_src) != SUCCESS)
+    if (convert_espa_to_hdf (xml_infile, hdf_outfile, band_filter,
+        del_src) != SUCCESS)
     {  /* Error messages already written */
         exit (EXIT_FAILURE);
     }
@@ -221,6 +246,7 @@ int main (int argc, char** argv)
     /* Free the pointers */
     free (xml_infile);
     free (hdf_outfile);
+    free (band_filter);
 
     /* Successful completion */
     exit (EXIT_SUCCESS);
@@ -15,6 +15,8 @@ Date         Programmer       Reason
 1/14/2014    Gail Schmidt     Original development
 4/2/2014     Gail Schmidt     Added a command-line flag to remove the source
                               files if specified
+8/31/2026    Gail Schmidt     Added a command-line option to convert the
+                              bands with multiple threads
 
 NOTES:
   1. The XML metadata format parsed or written via this library follows the
@@ -24,6 +26,9 @@ NOTES:
 *****************************************************************************/
 #include <getopt.h>
 #include "convert_lpgs_to_espa.h"
+#include "espa_perf.h"
+#include "espa_cancel.h"
+#include "espa_startup.h"
 
 /******************************************************************************
 MODULE: usage
@@ -48,7 +53,8 @@ void usage ()
     printf ("usage: convert_lpgs_to_espa "
             "--mtl=input_mtl_filename "
             "--xml=output_xml_filename "
-            "[--del_src_files]\n");
+            "[--del_src_files] "
+            "[--num_threads=nthreads]\n");
 
     printf ("\nwhere the following parameters are required:\n");
     printf ("    -mtl: name of the input LPGS MTL metadata file\n");
@@ -57,9 +63,14 @@ void usage ()
     printf ("    -del_src_files: if specified the source GeoTIFF files will "
             "be removed.  The _MTL.txt file will remain along with the "
             "gap directory for ETM+ products.\n");
+    printf ("    -num_threads: number of threads to use for converting the "
+            "bands (default is 1 for serial conversion)\n");
     printf ("\nExample: convert_lpgs_to_espa "
             "--mtl=LE70230282011250EDC00_MTL.txt "
             "--xml=LE70230282011250EDC00.xml\n");
+    printf ("\n    --startup-profile: report the time spent in the startup "
+            "phases (library init, schema validation, XML parse, first I/O) "
+            "to stderr; shared by all the ESPA tools\n");
 }
 
 
@@ -93,7 +104,8 @@ short get_args
     char *argv[],         /* I: string of cmd-line args */
     char **mtl_infile,    /* O: address of input LPGS MTL filename */
     char **xml_outfile,   /* O: address of output XML filename */
-    bool *del_src         /* O: should source files be removed? */
+    bool *del_src,        /* O: should source files be removed? */
+    int *num_threads      /* O: number of threads for the band conversion */
 )
 {
     int c;                           /* current argument index */
@@ -106,6 +118,7 @@ short get_args
         {"del_src_files", no_argument, &del_flag, 1},
         {"mtl", required_argument, 0, 'i'},
         {"xml", required_argument, 0, 'o'},
+        {"num_threads", required_argument, 0, 't'},
         {"help", no_argument, 0, 'h'},
         {0, 0, 0, 0}
     };
@@ -142,6 +155,10 @@ short get_args
                 *xml_outfile = strdup (optarg);
                 break;
      
+            case 't':  /* number of band conversion threads */
+                *num_threads = atoi (optarg);
+                break;
+     
             case '?':
             default:
                 sprintf (errmsg, "Unknown option %s", argv[optind-1]);
@@ -173,6 +190,15 @@ short get_args
     if (del_flag)
         *del_src = true;
 
+    /* Make sure the number of threads is sensible */
+    if (*num_threads < 1)
+    {
+        sprintf (errmsg, "Number of threads must be 1 or higher");
+        error_handler (true, FUNC_NAME, errmsg);
+        usage ();
+        return (ERROR);
+    }
+
     return (SUCCESS);
 }
 
@@ -194,6 +220,10 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 1/14/2014    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Emit one resource accounting record for the
+                              conversion when the instrumentation is enabled
+8/31/2026    Gail Schmidt     Install the cooperative cancellation handler
+                              so SIGTERM unwinds cleanly
 
 NOTES:
 ******************************************************************************/
@@ -202,18 +232,32 @@ int main (int argc, char** argv)
     char *mtl_infile = NULL;      /* input LPGS MTL filename */
     char *xml_outfile = NULL;     /* output XML filename */
     bool del_src = false;         /* should source files be removed? */
+    int num_threads = 1;          /* number of band conversion threads */
+    Espa_perf_stage_t perf_stage; /* resource snapshot for the conversion */
+
+    /* Install the cooperative cancellation handler so SIGTERM/SIGINT
+       unwind cleanly at the conversion checkpoints */
+    espa_cancel_install ();
+
+    /* Strip the shared --startup-profile option before parsing the
+       tool's own arguments */
+    espa_startup_profile_args (&argc, argv);
 
     /* Read the command-line arguments */
-    if (get_args (argc, argv, &mtl_infile, &xml_outfile, &del_src) != SUCCESS)
+    if (get_args (argc, argv, &mtl_infile, &xml_outfile, &del_src,
+        &num_threads) != SUCCESS)
     {   /* get_args already printed the error message */
         exit (EXIT_FAILURE);
     }
 
     /* Convert the LPGS MTL and data to ESPA raw binary and XML */
-    if (convert_lpgs_to_espa (mtl_infile, xml_outfile, del_src) != SUCCESS)
+    espa_perf_stage_begin (&perf_stage);
+    if (convert_lpgs_to_espa (mtl_infile, xml_outfile, del_src, num_threads)
+        != SUCCESS)
     {  /* Error messages already written */
         exit (EXIT_FAILURE);
     }
+    espa_perf_stage_end (xml_outfile, &perf_stage);
 
     /* Free the pointers */
     free (mtl_infile);
@@ -13,6 +13,8 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 5/2/2014     Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added a command-line option to convert the
+                              SDSs with multiple threads
 
 NOTES:
   1. The XML metadata format parsed or written via this library follows the
@@ -22,6 +24,9 @@ NOTES:
 *****************************************************************************/
 #include <getopt.h>
 #include "convert_modis_to_espa.h"
+#include "espa_perf.h"
+#include "espa_cancel.h"
+#include "espa_startup.h"
 
 /******************************************************************************
 MODULE: usage
@@ -46,7 +51,8 @@ void usage ()
     printf ("usage: convert_modis_to_espa "
             "--hdf=input_hdf_filename "
             "--xml=output_xml_filename "
-            "[--del_src_files]\n");
+            "[--del_src_files] "
+            "[--num_threads=nthreads]\n");
 
     printf ("\nwhere the following parameters are required:\n");
     printf ("    -hdf: name of the input MODIS HDF file\n");
@@ -54,9 +60,14 @@ void usage ()
             "the ESPA internal raw binary schema\n");
     printf ("    -del_src_files: if specified the source HDF file will "
             "be removed.\n");
+    printf ("    -num_threads: number of threads to use for converting the "
+            "SDSs (default is 1 for serial conversion)\n");
     printf ("\nExample: convert_modis_to_espa "
             "--hdf=MOD09A1.A2013241.h08v05.005.2013252120055.hdf "
             "--xml=MOD09A1.A2013241.h08v05.005.2013252120055.xml\n");
+    printf ("\n    --startup-profile: report the time spent in the startup "
+            "phases (library init, schema validation, XML parse, first I/O) "
+            "to stderr; shared by all the ESPA tools\n");
 }
 
 
@@ -90,7 +101,8 @@ short get_args
     char *argv[],         /* I: string of cmd-line args */
     char **hdf_infile,    /* O: address of input MODIS HDF filename */
     char **xml_outfile,   /* O: address of output XML filename */
-    bool *del_src         /* O: should source files be removed? */
+    bool *del_src,        /* O: should source files be removed? */
+    int *num_threads      /* O: number of threads for the SDS conversion */
 )
 {
     int c;                           /* current argument index */
@@ -103,6 +115,7 @@ short get_args
         {"del_src_files", no_argument, &del_flag, 1},
         {"hdf", required_argument, 0, 'i'},
         {"xml", required_argument, 0, 'o'},
+        {"num_threads", required_argument, 0, 't'},
         {"help", no_argument, 0, 'h'},
         {0, 0, 0, 0}
     };
@@ -138,7 +151,11 @@ short get_args
             case 'o':  /* XML outfile */
                 *xml_outfile = strdup (optarg);
                 break;
-     
+
+            case 't':  /* number of SDS conversion threads */
+                *num_threads = atoi (optarg);
+                break;
+
             case '?':
             default:
                 sprintf (errmsg, "Unknown option %s", argv[optind-1]);
@@ -170,6 +187,15 @@ short get_args
     if (del_flag)
         *del_src = true;
 
+    /* Make sure the number of threads is sensible */
+    if (*num_threads < 1)
+    {
+        sprintf (errmsg, "Number of threads must be 1 or higher");
+        error_handler (true, FUNC_NAME, errmsg);
+        usage ();
+        return (ERROR);
+    }
+
     return (SUCCESS);
 }
 
@@ -191,6 +217,10 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 5/2/2014     Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Emit one resource accounting record for the
+                              conversion when the instrumentation is enabled
+8/31/2026    Gail Schmidt     Install the cooperative cancellation handler
+                              so SIGTERM unwinds cleanly
 
 NOTES:
 ******************************************************************************/
@@ -199,18 +229,32 @@ int main (int argc, char** argv)
     char *hdf_infile = NULL;      /* input MODIS HDF filename */
     char *xml_outfile = NULL;     /* output XML filename */
     bool del_src = false;         /* should source files be removed? */
+    int num_threads = 1;          /* number of SDS conversion threads */
+    Espa_perf_stage_t perf_stage; /* resource snapshot for the conversion */
+
+    /* Install the cooperative cancellation handler so SIGTERM/SIGINT
+       unwind cleanly at the conversion checkpoints */
+    espa_cancel_install ();
+
+    /* Strip the shared --startup-profile option before parsing the
+       tool's own arguments */
+    espa_startup_profile_args (&argc, argv);
 
     /* Read the command-line arguments */
-    if (get_args (argc, argv, &hdf_infile, &xml_outfile, &del_src) != SUCCESS)
+    if (get_args (argc, argv, &hdf_infile, &xml_outfile, &del_src,
+        &num_threads) != SUCCESS)
     {   /* get_args already printed the error message */
         exit (EXIT_FAILURE);
     }
 
     /* Convert the MODIS HDF and data to ESPA raw binary and XML */
-    if (convert_modis_to_espa (hdf_infile, xml_outfile, del_src) != SUCCESS)
+    espa_perf_stage_begin (&perf_stage);
+    if (convert_modis_to_espa (hdf_infile, xml_outfile, del_src,
+        num_threads) != SUCCESS)
     {  /* Error messages already written */
         exit (EXIT_FAILURE);
     }
+    espa_perf_stage_end (xml_outfile, &perf_stage);
 
     /* Free the pointers */
     free (hdf_infile);
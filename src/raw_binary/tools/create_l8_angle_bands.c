@@ -17,6 +17,11 @@ Date         Programmer       Reason
 5/5/2015     Gail Schmidt     Updated to support writing the average of the
                               reflectance bands for each angle vs. all the
                               bands
+8/31/2026    Gail Schmidt     Hand the angle bands to a background writer
+                              thread so the next band is processed while the
+                              previous one drains to disk
+8/31/2026    Gail Schmidt     Replaced the per-band generate-then-write loops
+                              with the l8_write_angle_bands library pipeline
 
 NOTES:
 *****************************************************************************/
@@ -26,6 +31,8 @@ NOTES:
 #include <string.h>
 #include "error_handler.h"
 #include "l8_angles.h"
+#include "espa_cancel.h"
+#include "espa_startup.h"
 
 /******************************************************************************
 MODULE: usage
@@ -39,6 +46,8 @@ HISTORY:
 Date         Programmer       Reason
 ---------    ---------------  -------------------------------------
 4/3/2015     Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added the optional num_threads argument
+8/31/2026    Gail Schmidt     Added the optional resync_interval argument
 
 NOTES:
 ******************************************************************************/
@@ -52,14 +61,21 @@ void usage ()
     printf ("usage: create_l8_angle_bands "
             "--ang=angle_coefficient_filename\n"
             "--outfile=base_output_filename "
-            "{--average}");
+            "{--average} [--num_threads=number_of_threads]\n"
+            "[--resync_interval=number_of_samples]");
 
     printf ("\nwhere the following parameters are required:\n");
     printf ("    -ang: input angle coefficient file\n");
     printf ("    -outfile: base filename of the output angle files\n");
     printf ("and the following parameters are optional:\n");
     printf ("    -average: write the reflectance band averages instead of "
-            "writing each of the band angles.\n\n");
+            "writing each of the band angles.\n");
+    printf ("    -num_threads: number of threads to use for calculating the "
+            "angles (default is 1)\n");
+    printf ("    -resync_interval: interval between exact angle evaluations "
+            "along a line.  The angles for the samples in between are "
+            "interpolated.  The default of 1 evaluates every sample "
+            "exactly.\n\n");
 
     printf ("\nExample: create_l8_angle_bands "
             "--ang=LC80470272013287LGN00_ANG.txt "
@@ -72,6 +88,9 @@ void usage ()
             "--outfile=LC80470272013287LGN00 --average\n");
     printf ("This writes an average band file for the solar azimuth/zenith "
             "and the satellite azimuth/zenith angles.\n");
+    printf ("\n    --startup-profile: report the time spent in the startup "
+            "phases (library init, schema validation, XML parse, first I/O) "
+            "to stderr; shared by all the ESPA tools\n");
 }
 
 
@@ -93,6 +112,8 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 4/3/2015     Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added the optional num_threads argument
+8/31/2026    Gail Schmidt     Added the optional resync_interval argument
 
 NOTES:
   1. Memory is allocated for the input and output files.  All of these should
@@ -105,8 +126,10 @@ short get_args
     char *argv[],         /* I: string of cmd-line args */
     char **ang_infile,    /* O: address of input angle coefficient filename */
     char **outfile,       /* O: address of output base filename */
-    bool *band_avg        /* O: should the reflectance band average be
+    bool *band_avg,       /* O: should the reflectance band average be
                                 processed? */
+    int *num_threads,     /* O: number of threads for the angle calculation */
+    int *resync_interval  /* O: interval between exact angle evaluations */
 )
 {
     int c;                           /* current argument index */
@@ -120,6 +143,8 @@ short get_args
         {"average", no_argument, &avg_flag, 1},
         {"ang", required_argument, 0, 'a'},
         {"outfile", required_argument, 0, 'o'},
+        {"num_threads", required_argument, 0, 't'},
+        {"resync_interval", required_argument, 0, 'r'},
         {"help", no_argument, 0, 'h'},
         {0, 0, 0, 0}
     };
@@ -155,7 +180,15 @@ short get_args
             case 'o':  /* base outfile */
                 *outfile = strdup (optarg);
                 break;
-     
+
+            case 't':  /* number of angle calculation threads */
+                *num_threads = atoi (optarg);
+                break;
+
+            case 'r':  /* interval between exact angle evaluations */
+                *resync_interval = atoi (optarg);
+                break;
+
             case '?':
             default:
                 sprintf (errmsg, "Unknown option %s", argv[optind-1]);
@@ -183,6 +216,24 @@ short get_args
         return (ERROR);
     }
 
+    /* Make sure the number of threads is sensible */
+    if (*num_threads < 1)
+    {
+        sprintf (errmsg, "Number of threads must be 1 or higher");
+        error_handler (true, FUNC_NAME, errmsg);
+        usage ();
+        return (ERROR);
+    }
+
+    /* Make sure the resync interval is sensible */
+    if (*resync_interval < 1)
+    {
+        sprintf (errmsg, "Resync interval must be 1 or higher");
+        error_handler (true, FUNC_NAME, errmsg);
+        usage ();
+        return (ERROR);
+    }
+
     /* Check the band average flag */
     if (avg_flag)
         *band_avg = true;
@@ -210,24 +261,25 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 4/3/2015     Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added the optional num_threads argument
+8/31/2026    Gail Schmidt     Added the optional resync_interval argument
+8/31/2026    Gail Schmidt     Install the cooperative cancellation handler
+                              so SIGTERM unwinds cleanly
+8/31/2026    Gail Schmidt     Write the per-band angle bands through the
+                              l8_write_angle_bands library pipeline
 
 NOTES:
 1. Angles are written in degrees and scaled by 100.
-2. Note this is a memory hog.  The goal here was to have an application to
-   be able to write out the per-pixel angle bands for testing the per-pixel
-   angles.  In order to make this a less memory hog, then break it down to
-   process the solar angles, write the solar angles, process the satellite
-   angles, and write the satellite angles.
+2. The per-band angle bands are generated and written one band at a time by
+   the library pipeline, so only a couple of bands of angle arrays are held
+   in memory at once.
 ******************************************************************************/
 int main (int argc, char** argv)
 {
     bool band_avg;               /* should the reflectance band average be
                                     processed? */
-    int i;                       /* looping variable */
     int parm;                    /* looping variable */
     int count;                   /* number of chars copied in snprintf */
-    int nlines[L8_NBANDS];       /* number of lines for each band */
-    int nsamps[L8_NBANDS];       /* number of samples for each band */
     int avg_nlines;              /* number of lines for band average */
     int avg_nsamps;              /* number of samples for band average */
     char FUNC_NAME[] = "create_l8_angle_bands";  /* function name */
@@ -235,627 +287,61 @@ int main (int argc, char** argv)
     char tmpfile[1024];          /* temporary filename */
     char *ang_infile = NULL;     /* input angle coefficient filename */
     char *outfile = NULL;        /* output base filename for angle bands */
-    ANGLES_FRAME frame[L8_NBANDS];   /* image frame info for each band */
-    short *solar_zenith[L8_NBANDS];  /* array of pointers for the solar zenith
-                                        angle array, one per band */
-    short *solar_azimuth[L8_NBANDS]; /* array of pointers for the solar azimuth
-                                        angle array, one per band */
-    short *sat_zenith[L8_NBANDS];    /* array of pointers for the satellite
-                                        zenith angle array, one per band */
-    short *sat_azimuth[L8_NBANDS];   /* array of pointers for the satellite
-                                        azimuth angle array, one per band */
+    int num_threads = 1;         /* number of angle calculation threads */
+    int resync_interval = 1;     /* interval between exact angle evaluations */
     ANGLES_FRAME avg_frame;        /* image frame info for band average */
     short *avg_solar_zenith=NULL;  /* array for solar zenith angle average */
     short *avg_solar_azimuth=NULL; /* array for solar azimuth angle average */
     short *avg_sat_zenith=NULL;    /* array for satellite zenith angle avg */
     short *avg_sat_azimuth=NULL;   /* array for satellite azimuth angle avg */
     FILE *fptr=NULL;               /* file pointer */
+    FILE *prev_fptr=NULL;          /* file pointer still draining in the
+                                      background writer */
+    Raw_binary_async_t *writer=NULL;      /* background writer for the
+                                             current angle band */
+    Raw_binary_async_t *prev_writer=NULL; /* background writer for the
+                                             previous angle band */
+    short *prev_buf=NULL;          /* angle array still draining in the
+                                      background writer */
     Envi_header_t envi_hdr;        /* output ENVI header information */
 
+    /* Install the cooperative cancellation handler so SIGTERM/SIGINT
+       unwind cleanly at the conversion checkpoints */
+    espa_cancel_install ();
+
+    /* Strip the shared --startup-profile option before parsing the
+       tool's own arguments */
+    espa_startup_profile_args (&argc, argv);
+
     /* Read the command-line arguments */
-    if (get_args (argc, argv, &ang_infile, &outfile, &band_avg) != SUCCESS)
+    if (get_args (argc, argv, &ang_infile, &outfile, &band_avg, &num_threads,
+        &resync_interval) != SUCCESS)
     {   /* get_args already printed the error message */
         exit (ERROR);
     }
 
     if (!band_avg)
     {
-        /* Create the Landsat 8 angle bands for all bands.  Create a full
-           resolution product with a fill value of -9999 to match the Landsat 8
-           image data. */
-        if (l8_per_pixel_angles (ang_infile, 1, -9999, "ALL", frame,
-            solar_zenith, solar_azimuth, sat_zenith, sat_azimuth, nlines,
-            nsamps) != SUCCESS)
+        /* Create and write the Landsat 8 angle bands for all bands through
+           the library pipeline, which generates the bands one at a time and
+           hands each straight to a background writer while the next band is
+           computed.  Create a full resolution product with a fill value of
+           -9999 to match the Landsat 8 image data. */
+        if (l8_write_angle_bands (ang_infile, outfile, 1, -9999, "ALL",
+            num_threads, resync_interval) != SUCCESS)
         {  /* Error messages already written */
             exit (ERROR);
         }
-
-        /* Write the solar zenith output angles */
-        printf ("Writing solar zenith angles ...\n");
-        for (i = 0; i < L8_NBANDS; i++)
-        {
-            /* Open the output file for this band */
-            count = snprintf (tmpfile, sizeof (tmpfile),
-                "%s_B%d_solar_zenith.img", outfile, i+1);
-            if (count < 0 || count >= sizeof (tmpfile))
-            {
-                sprintf (errmsg, "Overflow of tmpfile");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            fptr = open_raw_binary (tmpfile, "wb");
-            if (!fptr)
-            {
-                sprintf (errmsg, "Unable to open the solar zenith file");
-                error_handler (true, FUNC_NAME, errmsg);
-                exit (ERROR);
-            }
-
-            /* Write the data for this band */
-            if (write_raw_binary (fptr, nlines[i], nsamps[i], sizeof (short),
-                &solar_zenith[i][0]) != SUCCESS)
-            {
-                sprintf (errmsg, "Unable to write to the solar zenith file");
-                error_handler (true, FUNC_NAME, errmsg);
-                exit (ERROR);
-            }
-
-            /* Close the file and free the pointer for this band */
-            close_raw_binary (fptr);
-            free (solar_zenith[i]);
-
-            /* Create the ENVI header */
-            count = snprintf (envi_hdr.description,
-                sizeof (envi_hdr.description), "Solar angle file");
-            if (count < 0 || count >= sizeof (envi_hdr.description))
-            {
-                sprintf (errmsg, "Overflow of envi_hdr.description");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            envi_hdr.nlines = nlines[i];
-            envi_hdr.nsamps = nsamps[i];
-            envi_hdr.nbands = 1;
-            envi_hdr.header_offset = 0;
-            envi_hdr.byte_order = 0;
-
-            count = snprintf (envi_hdr.file_type, sizeof (envi_hdr.file_type),
-                "ENVI Standard");
-            if (count < 0 || count >= sizeof (envi_hdr.file_type))
-            {
-                sprintf (errmsg, "Overflow of envi_hdr.file_type");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            envi_hdr.data_type = 2;
-            envi_hdr.data_ignore_value = -9999;
-            count = snprintf (envi_hdr.interleave, sizeof (envi_hdr.interleave),
-                "BSQ");
-            if (count < 0 || count >= sizeof (envi_hdr.interleave))
-            {
-                sprintf (errmsg, "Overflow of envi_hdr.interleave");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            count = snprintf (envi_hdr.sensor_type,
-                sizeof (envi_hdr.sensor_type), "Landsat OLI/TIRS");
-            if (count < 0 || count >= sizeof (envi_hdr.sensor_type))
-            {
-                sprintf (errmsg, "Overflow of envi_hdr.interleave");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            if (frame[i].projection.spheroid == WGS84_SPHEROID)
-                envi_hdr.datum_type = ESPA_WGS84;
-            else
-            {
-                sprintf (errmsg, "Unsupported datum. Currently only expect "
-                    "WGS84.");
-                error_handler (true, FUNC_NAME, errmsg);
-                exit (ERROR);
-            }
-
-            if (frame[i].projection.proj_code == UTM)
-            {
-                envi_hdr.proj_type = GCTP_UTM_PROJ;
-                envi_hdr.utm_zone = frame[i].projection.zone;
-            }
-            else if (frame[i].projection.proj_code == PS)
-            {
-                envi_hdr.proj_type = GCTP_PS_PROJ;
-            }
-            else
-            {
-                sprintf (errmsg, "Unsupported projection. Currently only "
-                    "expect UTM or PS.");
-                error_handler (true, FUNC_NAME, errmsg);
-                exit (ERROR);
-            }
-
-            for (parm = 0; parm < IAS_PROJ_PARAM_SIZE; parm++)
-                envi_hdr.proj_parms[parm] =
-                    frame[i].projection.parameters[parm];
-            envi_hdr.pixel_size[0] = frame[i].pixel_size;
-            envi_hdr.pixel_size[1] = frame[i].pixel_size;
-            envi_hdr.ul_corner[0] = frame[i].ul_corner.x -
-                frame[i].pixel_size * 0.5;
-            envi_hdr.ul_corner[1] = frame[i].ul_corner.y +
-                frame[i].pixel_size * 0.5;
-            envi_hdr.xy_start[0] = 1;
-            envi_hdr.xy_start[1] = 1;
-            count = snprintf (envi_hdr.band_names[0],
-                sizeof (envi_hdr.band_names[0]), "Solar zenith angle");
-            if (count < 0 || count >= sizeof (envi_hdr.band_names[0]))
-            {
-                sprintf (errmsg, "Overflow of envi_hdr.band_names[0]");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            /* Write the ENVI header */
-            count = snprintf (tmpfile, sizeof (tmpfile),
-                "%s_B%d_solar_zenith.hdr", outfile, i+1);
-            if (count < 0 || count >= sizeof (tmpfile))
-            {
-                sprintf (errmsg, "Overflow of tmpfile");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            if (write_envi_hdr (tmpfile, &envi_hdr) != SUCCESS)
-            {
-                sprintf (errmsg, "Writing the ENVI header file: %s.", tmpfile);
-                error_handler (true, FUNC_NAME, errmsg);
-                exit (ERROR);
-            }
-        }
-
-        /* Write the solar azimuth output angles */
-        printf ("Writing solar azimuth angles ...\n");
-        for (i = 0; i < L8_NBANDS; i++)
-        {
-            /* Open the output file for this band */
-            count = snprintf (tmpfile, sizeof (tmpfile),
-                "%s_B%d_solar_azimuth.img", outfile, i+1);
-            if (count < 0 || count >= sizeof (tmpfile))
-            {
-                sprintf (errmsg, "Overflow of tmpfile");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            fptr = open_raw_binary (tmpfile, "wb");
-            if (!fptr)
-            {
-                sprintf (errmsg, "Unable to open the solar azimuth file");
-                error_handler (true, FUNC_NAME, errmsg);
-                exit (ERROR);
-            }
-
-            /* Write the data for this band */
-            if (write_raw_binary (fptr, nlines[i], nsamps[i], sizeof (short),
-                &solar_azimuth[i][0]) != SUCCESS)
-            {
-                sprintf (errmsg, "Unable to write to the solar azimuth file");
-                error_handler (true, FUNC_NAME, errmsg);
-                exit (ERROR);
-            }
-
-            /* Close the file and free the pointer for this band */
-            close_raw_binary (fptr);
-            free (solar_azimuth[i]);
-
-            /* Create the ENVI header */
-            count = snprintf (envi_hdr.description,
-                sizeof (envi_hdr.description), "Solar angle file");
-            if (count < 0 || count >= sizeof (envi_hdr.description))
-            {
-                sprintf (errmsg, "Overflow of envi_hdr.description");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            envi_hdr.nlines = nlines[i];
-            envi_hdr.nsamps = nsamps[i];
-            envi_hdr.nbands = 1;
-            envi_hdr.header_offset = 0;
-            envi_hdr.byte_order = 0;
-            count = snprintf (envi_hdr.file_type, sizeof (envi_hdr.file_type),
-                "ENVI Standard");
-            if (count < 0 || count >= sizeof (envi_hdr.file_type))
-            {
-                sprintf (errmsg, "Overflow of envi_hdr.file_type");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            envi_hdr.data_type = 2;
-            envi_hdr.data_ignore_value = -9999;
-            count = snprintf (envi_hdr.interleave, sizeof (envi_hdr.interleave),
-                "BSQ");
-            if (count < 0 || count >= sizeof (envi_hdr.interleave))
-            {
-                sprintf (errmsg, "Overflow of envi_hdr.interleave");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            count = snprintf (envi_hdr.sensor_type,
-                sizeof (envi_hdr.sensor_type), "Landsat OLI/TIRS");
-            if (count < 0 || count >= sizeof (envi_hdr.sensor_type))
-            {
-                sprintf (errmsg, "Overflow of envi_hdr.interleave");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            if (frame[i].projection.spheroid == WGS84_SPHEROID)
-                envi_hdr.datum_type = ESPA_WGS84;
-            else
-            {
-                sprintf (errmsg, "Unsupported datum. Currently only expect "
-                    "WGS84.");
-                error_handler (true, FUNC_NAME, errmsg);
-                exit (ERROR);
-            }
-
-            if (frame[i].projection.proj_code == UTM)
-            {
-                envi_hdr.proj_type = GCTP_UTM_PROJ;
-                envi_hdr.utm_zone = frame[i].projection.zone;
-            }
-            else if (frame[i].projection.proj_code == PS)
-            {
-                envi_hdr.proj_type = GCTP_PS_PROJ;
-            }
-            else
-            {
-                sprintf (errmsg, "Unsupported projection. Currently only "
-                    "expect UTM or PS.");
-                error_handler (true, FUNC_NAME, errmsg);
-                exit (ERROR);
-            }
-
-            for (parm = 0; parm < IAS_PROJ_PARAM_SIZE; parm++)
-                envi_hdr.proj_parms[parm] =
-                    frame[i].projection.parameters[parm];
-            envi_hdr.pixel_size[0] = frame[i].pixel_size;
-            envi_hdr.pixel_size[1] = frame[i].pixel_size;
-            envi_hdr.ul_corner[0] = frame[i].ul_corner.x -
-                frame[i].pixel_size * 0.5;
-            envi_hdr.ul_corner[1] = frame[i].ul_corner.y +
-                frame[i].pixel_size * 0.5;
-            envi_hdr.xy_start[0] = 1;
-            envi_hdr.xy_start[1] = 1;
-            count = snprintf (envi_hdr.band_names[0],
-                sizeof (envi_hdr.band_names[0]), "Solar azimuth angle");
-            if (count < 0 || count >= sizeof (envi_hdr.band_names[0]))
-            {
-                sprintf (errmsg, "Overflow of envi_hdr.band_names[0]");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            /* Write the ENVI header */
-            count = snprintf (tmpfile, sizeof (tmpfile),
-                "%s_B%d_solar_azimuth.hdr", outfile, i+1);
-            if (count < 0 || count >= sizeof (tmpfile))
-            {
-                sprintf (errmsg, "Overflow of tmpfile");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            if (write_envi_hdr (tmpfile, &envi_hdr) != SUCCESS)
-            {
-                sprintf (errmsg, "Writing the ENVI header file: %s.", tmpfile);
-                error_handler (true, FUNC_NAME, errmsg);
-                exit (ERROR);
-            }
-        }
-
-        /* Write the sat zenith output angles */
-        printf ("Writing view zenith angles ...\n");
-        for (i = 0; i < L8_NBANDS; i++)
-        {
-            /* Open the output file for this band */
-            count = snprintf (tmpfile, sizeof (tmpfile),
-                "%s_B%d_sensor_zenith.img", outfile, i+1);
-            if (count < 0 || count >= sizeof (tmpfile))
-            {
-                sprintf (errmsg, "Overflow of tmpfile");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            fptr = open_raw_binary (tmpfile, "wb");
-            if (!fptr)
-            {
-                sprintf (errmsg, "Unable to open the sat zenith file");
-                error_handler (true, FUNC_NAME, errmsg);
-                exit (ERROR);
-            }
-
-            /* Write the data for this band */
-            if (write_raw_binary (fptr, nlines[i], nsamps[i], sizeof (short),
-                &sat_zenith[i][0]) != SUCCESS)
-            {
-                sprintf (errmsg, "Unable to write to the sat zenith file");
-                error_handler (true, FUNC_NAME, errmsg);
-                exit (ERROR);
-            }
-
-            /* Close the file and free the pointer for this band */
-            close_raw_binary (fptr);
-            free (sat_zenith[i]);
-
-            /* Create the ENVI header */
-            count = snprintf (envi_hdr.description,
-                sizeof (envi_hdr.description), "Satellite/View angle file");
-            if (count < 0 || count >= sizeof (envi_hdr.description))
-            {
-                sprintf (errmsg, "Overflow of envi_hdr.description");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            envi_hdr.nlines = nlines[i];
-            envi_hdr.nsamps = nsamps[i];
-            envi_hdr.nbands = 1;
-            envi_hdr.header_offset = 0;
-            envi_hdr.byte_order = 0;
-
-            count = snprintf (envi_hdr.file_type, sizeof (envi_hdr.file_type),
-                "ENVI Standard");
-            if (count < 0 || count >= sizeof (envi_hdr.file_type))
-            {
-                sprintf (errmsg, "Overflow of envi_hdr.file_type");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            envi_hdr.data_type = 2;
-            envi_hdr.data_ignore_value = -9999;
-            count = snprintf (envi_hdr.interleave, sizeof (envi_hdr.interleave),
-                "BSQ");
-            if (count < 0 || count >= sizeof (envi_hdr.interleave))
-            {
-                sprintf (errmsg, "Overflow of envi_hdr.interleave");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            count = snprintf (envi_hdr.sensor_type,
-                sizeof (envi_hdr.sensor_type), "Landsat OLI/TIRS");
-            if (count < 0 || count >= sizeof (envi_hdr.sensor_type))
-            {
-                sprintf (errmsg, "Overflow of envi_hdr.interleave");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            if (frame[i].projection.spheroid == WGS84_SPHEROID)
-                envi_hdr.datum_type = ESPA_WGS84;
-            else
-            {
-                sprintf (errmsg, "Unsupported datum. Currently only expect "
-                    "WGS84.");
-                error_handler (true, FUNC_NAME, errmsg);
-                exit (ERROR);
-            }
-
-            if (frame[i].projection.proj_code == UTM)
-            {
-                envi_hdr.proj_type = GCTP_UTM_PROJ;
-                envi_hdr.utm_zone = frame[i].projection.zone;
-            }
-            else if (frame[i].projection.proj_code == PS)
-            {
-                envi_hdr.proj_type = GCTP_PS_PROJ;
-            }
-            else
-            {
-                sprintf (errmsg, "Unsupported projection. Currently only "
-                    "expect UTM or PS.");
-                error_handler (true, FUNC_NAME, errmsg);
-                exit (ERROR);
-            }
-
-            for (parm = 0; parm < IAS_PROJ_PARAM_SIZE; parm++)
-                envi_hdr.proj_parms[parm] =
-                    frame[i].projection.parameters[parm];
-            envi_hdr.pixel_size[0] = frame[i].pixel_size;
-            envi_hdr.pixel_size[1] = frame[i].pixel_size;
-            envi_hdr.ul_corner[0] = frame[i].ul_corner.x -
-                frame[i].pixel_size * 0.5;
-            envi_hdr.ul_corner[1] = frame[i].ul_corner.y +
-                frame[i].pixel_size * 0.5;
-            envi_hdr.xy_start[0] = 1;
-            envi_hdr.xy_start[1] = 1;
-            count = snprintf (envi_hdr.band_names[0],
-                sizeof (envi_hdr.band_names[0]), "View zenith angle");
-            if (count < 0 || count >= sizeof (envi_hdr.band_names[0]))
-            {
-                sprintf (errmsg, "Overflow of envi_hdr.band_names[0]");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            /* Write the ENVI header */
-            count = snprintf (tmpfile, sizeof (tmpfile),
-                "%s_B%d_sensor_zenith.hdr", outfile, i+1);
-            if (count < 0 || count >= sizeof (tmpfile))
-            {
-                sprintf (errmsg, "Overflow of tmpfile");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            if (write_envi_hdr (tmpfile, &envi_hdr) != SUCCESS)
-            {
-                sprintf (errmsg, "Writing the ENVI header file: %s.", tmpfile);
-                error_handler (true, FUNC_NAME, errmsg);
-                exit (ERROR);
-            }
-        }
-
-        /* Write the sat azimuth output angles */
-        printf ("Writing view azimuth angles ...\n");
-        for (i = 0; i < L8_NBANDS; i++)
-        {
-            /* Open the output file for this band */
-            count = snprintf (tmpfile, sizeof (tmpfile),
-                "%s_B%d_sensor_azimuth.img", outfile, i+1);
-            if (count < 0 || count >= sizeof (tmpfile))
-            {
-                sprintf (errmsg, "Overflow of tmpfile");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            fptr = open_raw_binary (tmpfile, "wb");
-            if (!fptr)
-            {
-                sprintf (errmsg, "Unable to open the sat azimuth file");
-                error_handler (true, FUNC_NAME, errmsg);
-                exit (ERROR);
-            }
-
-            /* Write the data for this band */
-            if (write_raw_binary (fptr, nlines[i], nsamps[i], sizeof (short),
-                &sat_azimuth[i][0]) != SUCCESS)
-            {
-                sprintf (errmsg, "Unable to write to the sat azimuth file");
-                error_handler (true, FUNC_NAME, errmsg);
-                exit (ERROR);
-            }
-
-            /* Close the file and free the pointer for this band */
-            close_raw_binary (fptr);
-            free (sat_azimuth[i]);
-
-            /* Create the ENVI header */
-            count = snprintf (envi_hdr.description,
-                sizeof (envi_hdr.description), "Satellite/View angle file");
-            if (count < 0 || count >= sizeof (envi_hdr.description))
-            {
-                sprintf (errmsg, "Overflow of envi_hdr.description");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            envi_hdr.nlines = nlines[i];
-            envi_hdr.nsamps = nsamps[i];
-            envi_hdr.nbands = 1;
-            envi_hdr.header_offset = 0;
-            envi_hdr.byte_order = 0;
-            count = snprintf (envi_hdr.file_type, sizeof (envi_hdr.file_type),
-                "ENVI Standard");
-            if (count < 0 || count >= sizeof (envi_hdr.file_type))
-            {
-                sprintf (errmsg, "Overflow of envi_hdr.file_type");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            envi_hdr.data_type = 2;
-            envi_hdr.data_ignore_value = -9999;
-            count = snprintf (envi_hdr.interleave, sizeof (envi_hdr.interleave),
-                "BSQ");
-            if (count < 0 || count >= sizeof (envi_hdr.interleave))
-            {
-                sprintf (errmsg, "Overflow of envi_hdr.interleave");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            count = snprintf (envi_hdr.sensor_type,
-                sizeof (envi_hdr.sensor_type), "Landsat OLI/TIRS");
-            if (count < 0 || count >= sizeof (envi_hdr.sensor_type))
-            {
-                sprintf (errmsg, "Overflow of envi_hdr.interleave");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            if (frame[i].projection.spheroid == WGS84_SPHEROID)
-                envi_hdr.datum_type = ESPA_WGS84;
-            else
-            {
-                sprintf (errmsg, "Unsupported datum. Currently only expect "
-                    "WGS84.");
-                error_handler (true, FUNC_NAME, errmsg);
-                exit (ERROR);
-            }
-
-            if (frame[i].projection.proj_code == UTM)
-            {
-                envi_hdr.proj_type = GCTP_UTM_PROJ;
-                envi_hdr.utm_zone = frame[i].projection.zone;
-            }
-            else if (frame[i].projection.proj_code == PS)
-            {
-                envi_hdr.proj_type = GCTP_PS_PROJ;
-            }
-            else
-            {
-                sprintf (errmsg, "Unsupported projection. Currently only "
-                    "expect UTM or PS.");
-                error_handler (true, FUNC_NAME, errmsg);
-                exit (ERROR);
-            }
-
-            for (parm = 0; parm < IAS_PROJ_PARAM_SIZE; parm++)
-                envi_hdr.proj_parms[parm] =
-                    frame[i].projection.parameters[parm];
-            envi_hdr.pixel_size[0] = frame[i].pixel_size;
-            envi_hdr.pixel_size[1] = frame[i].pixel_size;
-            envi_hdr.ul_corner[0] = frame[i].ul_corner.x -
-                frame[i].pixel_size * 0.5;
-            envi_hdr.ul_corner[1] = frame[i].ul_corner.y +
-                frame[i].pixel_size * 0.5;
-            envi_hdr.xy_start[0] = 1;
-            envi_hdr.xy_start[1] = 1;
-            count = snprintf (envi_hdr.band_names[0],
-                sizeof (envi_hdr.band_names[0]), "View azimuth angle");
-            if (count < 0 || count >= sizeof (envi_hdr.band_names[0]))
-            {
-                sprintf (errmsg, "Overflow of envi_hdr.band_names[0]");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            /* Write the ENVI header */
-            count = snprintf (tmpfile, sizeof (tmpfile),
-                "%s_B%d_sensor_azimuth.hdr", outfile, i+1);
-            if (count < 0 || count >= sizeof (tmpfile))
-            {
-                sprintf (errmsg, "Overflow of tmpfile");
-                error_handler (true, FUNC_NAME, errmsg);
-                return (ERROR);
-            }
-
-            if (write_envi_hdr (tmpfile, &envi_hdr) != SUCCESS)
-            {
-                sprintf (errmsg, "Writing the ENVI header file: %s.", tmpfile);
-                error_handler (true, FUNC_NAME, errmsg);
-                exit (ERROR);
-            }
-        }
     }
     else
     {
         /* Create the average Landsat 8 angle bands over the reflectance bands.
            Create a full resolution product with a fill value of -9999 to match
            the Landsat 8 image data. */
-        if (l8_per_pixel_avg_refl_angles (ang_infile, 1, -9999, &avg_frame,
-            &avg_solar_zenith, &avg_solar_azimuth, &avg_sat_zenith,
-            &avg_sat_azimuth, &avg_nlines, &avg_nsamps) != SUCCESS)
+        if (l8_per_pixel_avg_refl_angles (ang_infile, 1, -9999, num_threads,
+            resync_interval, &avg_frame, &avg_solar_zenith,
+            &avg_solar_azimuth, &avg_sat_zenith, &avg_sat_azimuth,
+            &avg_nlines, &avg_nsamps) != SUCCESS)
         {  /* Error messages already written */
             exit (ERROR);
         }
@@ -881,18 +367,38 @@ int main (int argc, char** argv)
             exit (ERROR);
         }
 
-        /* Write the data for this band */
-        if (write_raw_binary (fptr, avg_nlines, avg_nsamps, sizeof (short),
-            avg_solar_zenith) != SUCCESS)
+        /* Hand the data for this band to a background writer thread so the
+           next band can be processed while it drains */
+        writer = open_raw_binary_async (fptr);
+        if (!writer)
+        {
+            sprintf (errmsg, "Unable to start the average solar zenith writer");
+            error_handler (true, FUNC_NAME, errmsg);
+            exit (ERROR);
+        }
+
+        if (write_raw_binary_async (writer, avg_nlines, avg_nsamps,
+            sizeof (short), avg_solar_zenith) != SUCCESS)
         {
             sprintf (errmsg, "Unable to write to average solar zenith file");
             error_handler (true, FUNC_NAME, errmsg);
             exit (ERROR);
         }
 
-        /* Close the file and free the pointer for this angle */
-        close_raw_binary (fptr);
-        free (avg_solar_zenith);
+        /* Finish the previous band while this one drains in the
+           background */
+        if (prev_writer)
+        {
+            if (close_raw_binary_async (prev_writer) != SUCCESS)
+            {  /* Error messages already printed */
+                exit (ERROR);
+            }
+            close_raw_binary (prev_fptr);
+            free (prev_buf);
+        }
+        prev_writer = writer;
+        prev_fptr = fptr;
+        prev_buf = avg_solar_zenith;
 
         /* Create the ENVI header */
         count = snprintf (envi_hdr.description,
@@ -1024,18 +530,38 @@ int main (int argc, char** argv)
             exit (ERROR);
         }
 
-        /* Write the data for this band */
-        if (write_raw_binary (fptr, avg_nlines, avg_nsamps, sizeof (short),
-            avg_solar_azimuth) != SUCCESS)
+        /* Hand the data for this band to a background writer thread so the
+           next band can be processed while it drains */
+        writer = open_raw_binary_async (fptr);
+        if (!writer)
+        {
+            sprintf (errmsg, "Unable to start the average solar azimuth writer");
+            error_handler (true, FUNC_NAME, errmsg);
+            exit (ERROR);
+        }
+
+        if (write_raw_binary_async (writer, avg_nlines, avg_nsamps,
+            sizeof (short), avg_solar_azimuth) != SUCCESS)
         {
             sprintf (errmsg, "Unable to write to average solar azimuth file");
             error_handler (true, FUNC_NAME, errmsg);
             exit (ERROR);
         }
 
-        /* Close the file and free the pointer for this angle */
-        close_raw_binary (fptr);
-        free (avg_solar_azimuth);
+        /* Finish the previous band while this one drains in the
+           background */
+        if (prev_writer)
+        {
+            if (close_raw_binary_async (prev_writer) != SUCCESS)
+            {  /* Error messages already printed */
+                exit (ERROR);
+            }
+            close_raw_binary (prev_fptr);
+            free (prev_buf);
+        }
+        prev_writer = writer;
+        prev_fptr = fptr;
+        prev_buf = avg_solar_azimuth;
 
         /* Create the ENVI header.  Many of the fields needed have already been
            filled in above with the solar zenith fields. */
@@ -1086,18 +612,38 @@ int main (int argc, char** argv)
             exit (ERROR);
         }
 
-        /* Write the data for this band */
-        if (write_raw_binary (fptr, avg_nlines, avg_nsamps, sizeof (short),
-            avg_sat_zenith) != SUCCESS)
+        /* Hand the data for this band to a background writer thread so the
+           next band can be processed while it drains */
+        writer = open_raw_binary_async (fptr);
+        if (!writer)
+        {
+            sprintf (errmsg, "Unable to start the average sensor zenith writer");
+            error_handler (true, FUNC_NAME, errmsg);
+            exit (ERROR);
+        }
+
+        if (write_raw_binary_async (writer, avg_nlines, avg_nsamps,
+            sizeof (short), avg_sat_zenith) != SUCCESS)
         {
             sprintf (errmsg, "Unable to write to average sensor zenith file");
             error_handler (true, FUNC_NAME, errmsg);
             exit (ERROR);
         }
 
-        /* Close the file and free the pointer for this angle */
-        close_raw_binary (fptr);
-        free (avg_sat_zenith);
+        /* Finish the previous band while this one drains in the
+           background */
+        if (prev_writer)
+        {
+            if (close_raw_binary_async (prev_writer) != SUCCESS)
+            {  /* Error messages already printed */
+                exit (ERROR);
+            }
+            close_raw_binary (prev_fptr);
+            free (prev_buf);
+        }
+        prev_writer = writer;
+        prev_fptr = fptr;
+        prev_buf = avg_sat_zenith;
 
         /* Create the ENVI header.  Many of the fields needed have already been
            filled in above with the solar zenith fields. */
@@ -1157,18 +703,38 @@ int main (int argc, char** argv)
             exit (ERROR);
         }
 
-        /* Write the data for this band */
-        if (write_raw_binary (fptr, avg_nlines, avg_nsamps, sizeof (short),
-            avg_sat_azimuth) != SUCCESS)
+        /* Hand the data for this band to a background writer thread so the
+           next band can be processed while it drains */
+        writer = open_raw_binary_async (fptr);
+        if (!writer)
+        {
+            sprintf (errmsg, "Unable to start the average sensor azimuth writer");
+            error_handler (true, FUNC_NAME, errmsg);
+            exit (ERROR);
+        }
+
+        if (write_raw_binary_async (writer, avg_nlines, avg_nsamps,
+            sizeof (short), avg_sat_azimuth) != SUCCESS)
         {
             sprintf (errmsg, "Unable to write to average sensor azimuth file");
             error_handler (true, FUNC_NAME, errmsg);
             exit (ERROR);
         }
 
-        /* Close the file and free the pointer for this angle */
-        close_raw_binary (fptr);
-        free (avg_sat_azimuth);
+        /* Finish the previous band while this one drains in the
+           background */
+        if (prev_writer)
+        {
+            if (close_raw_binary_async (prev_writer) != SUCCESS)
+            {  /* Error messages already printed */
+                exit (ERROR);
+            }
+            close_raw_binary (prev_fptr);
+            free (prev_buf);
+        }
+        prev_writer = writer;
+        prev_fptr = fptr;
+        prev_buf = avg_sat_azimuth;
 
         /* Create the ENVI header.  Many of the fields needed have already been
            filled in above with the solar zenith fields. */
@@ -1199,6 +765,17 @@ int main (int argc, char** argv)
         }
     }
 
+    /* Finish the last band still draining in the background writer */
+    if (prev_writer)
+    {
+        if (close_raw_binary_async (prev_writer) != SUCCESS)
+        {  /* Error messages already printed */
+            exit (ERROR);
+        }
+        close_raw_binary (prev_fptr);
+        free (prev_buf);
+    }
+
     /* Free the pointers */
     free (ang_infile);
     free (outfile);
@@ -28,6 +28,8 @@ NOTES:
 #include "write_metadata.h"
 #include "raw_binary_io.h"
 #include "generate_land_water_mask.h"
+#include "espa_cancel.h"
+#include "espa_startup.h"
 
 /******************************************************************************
 MODULE: usage
@@ -41,6 +43,10 @@ HISTORY:
 Date         Programmer       Reason
 ---------    ---------------  -------------------------------------
 4/17/2015     Gail Schmidt     Original development
+8/31/2026     Gail Schmidt     Added the optional num_threads argument
+8/31/2026     Gail Schmidt     Added the optional packed argument
+8/31/2026     Gail Schmidt     The number of threads defaults to an automatic
+                               choice based on the scene size and the machine
 
 NOTES:
 ******************************************************************************/
@@ -49,13 +55,25 @@ void usage ()
     printf ("create_land_water_mask creates the land/water mask for the "
             "input scene, based on a static land-mass polygon.\n\n");
     printf ("usage: create_land_water_mask "
-            "--xml=input_metadata_filename\n");
+            "--xml=input_metadata_filename "
+            "[--num_threads=number_of_threads] [--packed]\n");
 
     printf ("\nwhere the following parameters are required:\n");
     printf ("    -xml: name of the input XML metadata file which follows "
             "the ESPA internal raw binary schema\n");
+    printf ("\nwhere the following parameters are optional:\n");
+    printf ("    -num_threads: number of threads to use for generating the "
+            "mask (default is to choose the thread count automatically from "
+            "the scene size and the machine)\n");
+    printf ("    -packed: write the mask as packed bits, 8 pixels per byte "
+            "with the leftmost pixel in the most significant bit, instead "
+            "of one byte per pixel.  The packed file is 8x smaller and can "
+            "be expanded with read_raw_binary_packed_bits.\n");
     printf ("\nExample: create_land_water_mask "
             "--xml=LC80470272013287LGN00.xml\n");
+    printf ("\n    --startup-profile: report the time spent in the startup "
+            "phases (library init, schema validation, XML parse, first I/O) "
+            "to stderr; shared by all the ESPA tools\n");
 }
 
 
@@ -77,6 +95,10 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 4/17/2015     Gail Schmidt     Original development
+8/31/2026     Gail Schmidt     Added the optional num_threads argument
+8/31/2026     Gail Schmidt     Added the optional packed argument
+8/31/2026     Gail Schmidt     The number of threads defaults to an automatic
+                               choice based on the scene size and the machine
 
 NOTES:
   1. Memory is allocated for the input and output files.  All of these should
@@ -87,16 +109,21 @@ short get_args
 (
     int argc,             /* I: number of cmd-line args */
     char *argv[],         /* I: string of cmd-line args */
-    char **xml_infile     /* O: address of input XML filename */
+    char **xml_infile,    /* O: address of input XML filename */
+    int *num_threads,     /* O: number of threads for the mask generation */
+    bool *packed          /* O: should the mask be written as packed bits? */
 )
 {
     int c;                           /* current argument index */
     int option_index;                /* index for the command-line option */
     char errmsg[STR_SIZE];           /* error message */
     char FUNC_NAME[] = "get_args";   /* function name */
+    static int packed_flag = 0;      /* flag for writing packed bits */
     static struct option long_options[] =
     {
+        {"packed", no_argument, &packed_flag, 1},
         {"xml", required_argument, 0, 'i'},
+        {"num_threads", required_argument, 0, 't'},
         {"help", no_argument, 0, 'h'},
         {0, 0, 0, 0}
     };
@@ -129,6 +156,10 @@ short get_args
             *xml_infile = strdup (optarg);
             break;
 
+            case 't':  /* number of mask generation threads */
+            *num_threads = atoi (optarg);
+            break;
+
             case '?':
             default:
                 sprintf (errmsg, "Unknown option %s", argv[optind-1]);
@@ -148,6 +179,20 @@ short get_args
         return (ERROR);
     }
 
+    /* Make sure the number of threads is sensible when it was specified;
+       0 leaves the automatic choice in place */
+    if (*num_threads < 0)
+    {
+        sprintf (errmsg, "Number of threads must be 0 (automatic) or higher");
+        error_handler (true, FUNC_NAME, errmsg);
+        usage ();
+        return (ERROR);
+    }
+
+    /* Check if the packed bits flag was specified */
+    if (packed_flag)
+        *packed = true;
+
     return (SUCCESS);
 }
 
@@ -173,6 +218,15 @@ Date         Programmer       Reason
 4/17/2015     Gail Schmidt     Original development
 4/22/2015     Gail Schmidt     Make this band an intermediate_data product
                                since it won't be delivered
+8/31/2026     Gail Schmidt     Added the optional num_threads argument
+8/31/2026     Gail Schmidt     Added the optional packed argument to write the
+                               mask as packed bits, 8 pixels per byte
+8/31/2026     Gail Schmidt     The number of threads defaults to an automatic
+                               choice based on the scene size and the machine
+8/31/2026     Gail Schmidt     Write the ENVI header straight from the band
+                               metadata with the direct emitter
+8/31/2026     Gail Schmidt     Install the cooperative cancellation handler
+                               so SIGTERM unwinds cleanly
 
 NOTES:
   1. The ESPA_LAND_MASS_POLYGON environment variable needs to be defined and
@@ -196,11 +250,13 @@ int main (int argc, char** argv)
     int nlines;                  /* number of lines in the land/water mask */
     int nsamps;                  /* number of samples in the land/water mask */
     int refl_indx = -99;         /* index of band1 or first band */
+    int num_threads = 0;         /* number of mask generation threads; 0
+                                    chooses the count automatically */
+    bool packed = false;         /* write the mask as packed bits? */
     unsigned char *land_water_mask = NULL;  /* land/water mask buffer */
     time_t tp;                   /* time structure */
     struct tm *tm = NULL;        /* time structure for UTC time */
     FILE *fptr=NULL;             /* file pointer */
-    Envi_header_t envi_hdr;      /* output ENVI header information */
     Espa_global_meta_t *gmeta = NULL; /* pointer to global metadata structure */
     Espa_band_meta_t *bmeta = NULL;   /* pointer to band metadata structure */
     Espa_band_meta_t *out_bmeta = NULL;/* band metadata for land-water mask */
@@ -208,8 +264,17 @@ int main (int argc, char** argv)
     Espa_internal_meta_t xml_metadata;  /* XML metadata structure to be
                                 populated by reading the MTL metadata file */
 
+    /* Install the cooperative cancellation handler so SIGTERM/SIGINT
+       unwind cleanly at the conversion checkpoints */
+    espa_cancel_install ();
+
+    /* Strip the shared --startup-profile option before parsing the
+       tool's own arguments */
+    espa_startup_profile_args (&argc, argv);
+
     /* Read the command-line arguments */
-    if (get_args (argc, argv, &espa_xml_file) != SUCCESS)
+    if (get_args (argc, argv, &espa_xml_file, &num_threads, &packed)
+        != SUCCESS)
     {   /* get_args already printed the error message */
         exit (ERROR);
     }
@@ -249,7 +314,7 @@ int main (int argc, char** argv)
     /* Generate the land/water mask for this scene. Memory is allocated for
        the land/water mask. */
     if (generate_land_water_mask (&xml_metadata, land_mass_polygon,
-        &land_water_mask, &nlines, &nsamps) != SUCCESS)
+        num_threads, &land_water_mask, &nlines, &nsamps) != SUCCESS)
     {  /* Error messages already written */
         exit (ERROR);
     }
@@ -307,16 +372,31 @@ int main (int argc, char** argv)
     strcpy (out_bmeta->category, "qa");
     out_bmeta->data_type = ESPA_UINT8;
     out_bmeta->nlines = nlines;
-    out_bmeta->nsamps = nsamps;
     strncpy (tmpstr, bmeta->short_name, 3);
     sprintf (out_bmeta->short_name, "%sLWMASK", tmpstr);
-    strcpy (out_bmeta->long_name, "static land/water mask");
-    out_bmeta->pixel_size[0] = bmeta->pixel_size[0];
     out_bmeta->pixel_size[1] = bmeta->pixel_size[1];
     strcpy (out_bmeta->pixel_units, bmeta->pixel_units);
     strcpy (out_bmeta->data_units, "quality/feature classification");
-    out_bmeta->valid_range[0] = 0;
-    out_bmeta->valid_range[1] = 1;
+    if (packed)
+    {
+        /* The schema doesn't support a 1-bit data type, so the packed mask
+           is described as a UINT8 band of the packed bytes, each covering
+           8 pixels across */
+        out_bmeta->nsamps = (nsamps + 7) / 8;
+        strcpy (out_bmeta->long_name, "static land/water mask, packed 8 "
+            "pixels per byte (MSB first)");
+        out_bmeta->pixel_size[0] = bmeta->pixel_size[0] * 8.0;
+        out_bmeta->valid_range[0] = 0;
+        out_bmeta->valid_range[1] = 255;
+    }
+    else
+    {
+        out_bmeta->nsamps = nsamps;
+        strcpy (out_bmeta->long_name, "static land/water mask");
+        out_bmeta->pixel_size[0] = bmeta->pixel_size[0];
+        out_bmeta->valid_range[0] = 0;
+        out_bmeta->valid_range[1] = 1;
+    }
     sprintf (out_bmeta->app_version, "create_land_water_mask_%s",
         ESPA_COMMON_VERSION);
 
@@ -332,18 +412,23 @@ int main (int argc, char** argv)
     }
     sprintf (cptr, "_land_water_mask.img");
 
-    /* Set up the 2 classes for land (1) and water (0) */
-    out_bmeta->nclass = 2;
-    if (allocate_class_metadata (out_bmeta, 2) != SUCCESS)
+    /* Set up the 2 classes for land (1) and water (0).  The packed bytes
+       hold 8 pixels each, so the class values only apply to the per-byte
+       mask. */
+    if (!packed)
     {
-        sprintf (errmsg, "Cannot allocate memory for the classes");
-        error_handler (true, FUNC_NAME, errmsg);
-        exit (ERROR);
+        out_bmeta->nclass = 2;
+        if (allocate_class_metadata (out_bmeta, 2) != SUCCESS)
+        {
+            sprintf (errmsg, "Cannot allocate memory for the classes");
+            error_handler (true, FUNC_NAME, errmsg);
+            exit (ERROR);
+        }
+        out_bmeta->class_values[0].class = 0;
+        out_bmeta->class_values[1].class = 1;
+        strcpy (out_bmeta->class_values[0].description, "water");
+        strcpy (out_bmeta->class_values[1].description, "land");
     }
-    out_bmeta->class_values[0].class = 0;
-    out_bmeta->class_values[1].class = 1;
-    strcpy (out_bmeta->class_values[0].description, "water");
-    strcpy (out_bmeta->class_values[1].description, "land");
 
     /* Get the current date/time (UTC) for the production date of each band */
     if (time (&tp) == -1)
@@ -379,8 +464,19 @@ int main (int argc, char** argv)
         exit (ERROR);
     }
 
-    /* Write the data for this band */
-    if (write_raw_binary (fptr, nlines, nsamps, sizeof (unsigned char),
+    /* Write the data for this band, packing 8 pixels per byte if the
+       packed product was requested */
+    if (packed)
+    {
+        if (write_raw_binary_packed_bits (fptr, nlines, nsamps,
+            land_water_mask) != SUCCESS)
+        {
+            sprintf (errmsg, "Unable to write to the land/water mask file");
+            error_handler (true, FUNC_NAME, errmsg);
+            exit (ERROR);
+        }
+    }
+    else if (write_raw_binary (fptr, nlines, nsamps, sizeof (unsigned char),
         land_water_mask) != SUCCESS)
     {
         sprintf (errmsg, "Unable to write to the land/water mask file");
@@ -392,18 +488,10 @@ int main (int argc, char** argv)
     close_raw_binary (fptr);
     free (land_water_mask);
 
-    /* Create the ENVI header using the representative band */
-    if (create_envi_struct (out_bmeta, gmeta, &envi_hdr) != SUCCESS)
-    {
-        sprintf (errmsg, "Error creating the ENVI header file.");
-        error_handler (true, FUNC_NAME, errmsg);
-        exit (ERROR);
-    }
-
-    /* Write the ENVI header */
+    /* Write the ENVI header straight from the band metadata */
     sprintf (tmpstr, "%s", maskfile);
     sprintf (&tmpstr[strlen(tmpstr)-3], "hdr");
-    if (write_envi_hdr (tmpstr, &envi_hdr) != SUCCESS)
+    if (write_envi_hdr_meta (tmpstr, out_bmeta, gmeta) != SUCCESS)
     {
         sprintf (errmsg, "Writing the ENVI header file: %s.", tmpstr);
         error_handler (true, FUNC_NAME, errmsg);
@@ -0,0 +1,444 @@
+/*****************************************************************************
+FILE: espa_archive_band
+
+PURPOSE: Contains functions for rewriting the raw binary bands of an ESPA
+product into the block-compressed band container for archive-tier storage.
+The compressed bands keep their .img filenames and are read transparently
+through the library, including windowed reads which touch only the blocks
+covering the window, so archived scenes can serve single-band and windowed
+requests without decompressing the whole scene.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The XML metadata format parsed or written via this library follows the
+     ESPA internal metadata format found in ESPA Raw Binary Format v1.0.doc.
+     The schema for the ESPA internal metadata format is available at
+     http://espa.cr.usgs.gov/schema/espa_internal_metadata_v1_0.xsd.
+  2. The blocks compress across the worker pool, so the thread count is
+     bounded by the ESPA_NUM_THREADS environment variable.
+*****************************************************************************/
+#include <getopt.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "espa_metadata.h"
+#include "parse_metadata.h"
+#include "raw_binary_io.h"
+#include "espa_buffer.h"
+#include "espa_thread_pool.h"
+#include "espa_startup.h"
+
+/******************************************************************************
+MODULE: usage
+
+PURPOSE: Prints the usage information for this application.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+---------    ---------------  -------------------------------------
+8/31/2026    Gail Schmidt     Original Development
+
+NOTES:
+******************************************************************************/
+void usage ()
+{
+    printf ("espa_archive_band rewrites the raw binary bands of an ESPA "
+            "product into the block-compressed band container in place.  "
+            "The compressed bands keep their .img filenames and are read "
+            "transparently through the library, including windowed reads "
+            "which decompress only the blocks covering the window, so "
+            "archived scenes serve single-band and windowed requests "
+            "without being restored first.\n\n");
+    printf ("usage: espa_archive_band "
+            "--xml=input_metadata_filename\n");
+
+    printf ("\nwhere the following parameters are required:\n");
+    printf ("    -xml: name of the input XML metadata file which follows "
+            "the ESPA internal raw binary schema\n");
+    printf ("\nExample: espa_archive_band "
+            "--xml=LE07_L1TP_022033_20140228_20160905_01_T1.xml\n");
+    printf ("\n    --startup-profile: report the time spent in the startup "
+            "phases (library init, schema validation, XML parse, first I/O) "
+            "to stderr; shared by all the ESPA tools\n");
+}
+
+
+/******************************************************************************
+MODULE:  get_args
+
+PURPOSE:  Gets the command-line arguments and validates that the required
+arguments were specified.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error getting the command-line arguments or a command-line
+                argument and associated value were not specified
+SUCCESS         No errors encountered
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Memory is allocated for the input file.  It should be a character
+     pointer set to NULL on input.  The caller is responsible for freeing
+     the allocated memory upon successful return.
+******************************************************************************/
+short get_args
+(
+    int argc,             /* I: number of cmd-line args */
+    char *argv[],         /* I: string of cmd-line args */
+    char **xml_infile     /* O: address of input XML filename */
+)
+{
+    int c;                           /* current argument index */
+    int option_index;                /* index for the command-line option */
+    char errmsg[STR_SIZE];           /* error message */
+    char FUNC_NAME[] = "get_args";   /* function name */
+    static struct option long_options[] =
+    {
+        {"xml", required_argument, 0, 'i'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    /* Loop through all the cmd-line options */
+    opterr = 0;   /* turn off getopt_long error msgs as we'll print our own */
+    while (1)
+    {
+        /* optstring in call to getopt_long is empty since we will only
+           support the long options */
+        c = getopt_long (argc, argv, "", long_options, &option_index);
+        if (c == -1)
+        {   /* Out of cmd-line options */
+            break;
+        }
+
+        switch (c)
+        {
+            case 0:
+                /* If this option set a flag, do nothing else now. */
+                if (long_options[option_index].flag != 0)
+                    break;
+
+            case 'h':  /* help */
+                usage ();
+                return (ERROR);
+                break;
+
+            case 'i':  /* XML infile */
+                *xml_infile = strdup (optarg);
+                break;
+
+            case '?':
+            default:
+                sprintf (errmsg, "Unknown option %s", argv[optind-1]);
+                error_handler (true, FUNC_NAME, errmsg);
+                usage ();
+                return (ERROR);
+                break;
+        }
+    }
+
+    /* Make sure the infile was specified */
+    if (*xml_infile == NULL)
+    {
+        sprintf (errmsg, "XML input file is a required argument");
+        error_handler (true, FUNC_NAME, errmsg);
+        usage ();
+        return (ERROR);
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  archive_band
+
+PURPOSE:  Rewrites one raw binary band file into the block-compressed band
+container, replacing the band file in place under its original name.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error archiving the band
+SUCCESS         No errors encountered
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Bands which are already in the compressed container are left alone,
+     so the tool can be rerun on a partially archived scene.
+  2. The band is streamed through a chunk of whole compression blocks per
+     worker thread, so the blocks of each chunk compress in parallel and
+     the band is never held in memory at once.
+  3. The compressed band is written to a temporary file and renamed onto
+     the band filename once it is complete, so a failed run leaves the
+     original band in place.
+******************************************************************************/
+int archive_band
+(
+    Espa_band_meta_t *bmeta,  /* I: metadata for the band to be archived */
+    bool *skipped             /* O: was the band already archived? */
+)
+{
+    char FUNC_NAME[] = "archive_band";   /* function name */
+    char errmsg[STR_SIZE];    /* error message */
+    char tmpfile[STR_SIZE];   /* temporary name for the compressed band */
+    int nbytes;               /* number of bytes in the data type */
+    int chunk_lines;          /* band lines rewritten per chunk */
+    int line;                 /* current band line of the streaming pass */
+    int nread;                /* number of band lines in the current chunk */
+    int count;                /* number of characters in the temp filename */
+    unsigned char *buf = NULL;  /* chunk buffer */
+    FILE *fp_in = NULL;       /* file pointer for the band file */
+    FILE *fp_out = NULL;      /* file pointer for the compressed band file */
+
+    /* Determine the number of bytes in the data type */
+    *skipped = false;
+    switch (bmeta->data_type)
+    {
+        case ESPA_INT8: nbytes = 1; break;
+        case ESPA_UINT8: nbytes = 1; break;
+        case ESPA_INT16: nbytes = 2; break;
+        case ESPA_UINT16: nbytes = 2; break;
+        case ESPA_INT32: nbytes = 4; break;
+        case ESPA_UINT32: nbytes = 4; break;
+        case ESPA_FLOAT32: nbytes = 4; break;
+        case ESPA_FLOAT64: nbytes = 8; break;
+        default:
+            sprintf (errmsg, "Unsupported data type %d for band %.1024s.",
+                bmeta->data_type, bmeta->name);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+    }
+
+    /* Open the band file for reading */
+    fp_in = open_raw_binary (bmeta->file_name, "rb");
+    if (fp_in == NULL)
+    {
+        sprintf (errmsg, "Opening the band file: %.1024s", bmeta->file_name);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Leave bands which are already in the compressed container alone */
+    if (compressed_binary_find (fp_in) != NULL)
+    {
+        close_raw_binary (fp_in);
+        *skipped = true;
+        return (SUCCESS);
+    }
+    advise_raw_binary_sequential (fp_in);
+
+    /* Open the compressed band under a temporary name so a failed run
+       leaves the original band in place */
+    count = snprintf (tmpfile, sizeof (tmpfile), "%s.archive",
+        bmeta->file_name);
+    if (count < 0 || count >= sizeof (tmpfile))
+    {
+        sprintf (errmsg, "Overflow of tmpfile string");
+        error_handler (true, FUNC_NAME, errmsg);
+        close_raw_binary (fp_in);
+        return (ERROR);
+    }
+
+    fp_out = open_compressed_raw_binary (tmpfile, bmeta->nlines,
+        bmeta->nsamps, nbytes);
+    if (fp_out == NULL)
+    {
+        sprintf (errmsg, "Opening the compressed band file: %.1024s", tmpfile);
+        error_handler (true, FUNC_NAME, errmsg);
+        close_raw_binary (fp_in);
+        return (ERROR);
+    }
+
+    /* Borrow the chunk buffer; a chunk holds one whole compression block
+       per worker thread so the blocks of each chunk compress in parallel */
+    chunk_lines = ESPA_COMPRESSED_BINARY_BLOCK_LINES *
+        espa_pool_max_threads ();
+    if (chunk_lines > bmeta->nlines)
+        chunk_lines = bmeta->nlines;
+    buf = espa_borrow_buffer ((size_t) chunk_lines * bmeta->nsamps * nbytes);
+    if (buf == NULL)
+    {
+        sprintf (errmsg, "Borrowing the chunk buffer for band %.1024s.",
+            bmeta->name);
+        error_handler (true, FUNC_NAME, errmsg);
+        close_raw_binary (fp_in);
+        close_raw_binary (fp_out);
+        unlink (tmpfile);
+        return (ERROR);
+    }
+
+    /* Stream the band through the chunk buffer into the compressed
+       container */
+    for (line = 0; line < bmeta->nlines; line += nread)
+    {
+        nread = chunk_lines;
+        if (nread > bmeta->nlines - line)
+            nread = bmeta->nlines - line;
+
+        if (read_raw_binary (fp_in, nread, bmeta->nsamps, nbytes, buf)
+            != SUCCESS)
+        {
+            sprintf (errmsg, "Reading lines %d-%d of band %.1024s.", line,
+                line + nread - 1, bmeta->name);
+            error_handler (true, FUNC_NAME, errmsg);
+            espa_return_buffer (buf);
+            close_raw_binary (fp_in);
+            close_raw_binary (fp_out);
+            unlink (tmpfile);
+            return (ERROR);
+        }
+
+        if (write_raw_binary (fp_out, nread, bmeta->nsamps, nbytes, buf)
+            != SUCCESS)
+        {
+            sprintf (errmsg, "Writing lines %d-%d of band %.1024s to the "
+                "compressed container.", line, line + nread - 1, bmeta->name);
+            error_handler (true, FUNC_NAME, errmsg);
+            espa_return_buffer (buf);
+            close_raw_binary (fp_in);
+            close_raw_binary (fp_out);
+            unlink (tmpfile);
+            return (ERROR);
+        }
+    }
+
+    espa_return_buffer (buf);
+    close_raw_binary (fp_in);
+
+    /* The close flushes the final block and the offset index */
+    close_raw_binary (fp_out);
+
+    /* Replace the band file with the completed compressed container */
+    if (rename (tmpfile, bmeta->file_name) != 0)
+    {
+        sprintf (errmsg, "Renaming %.512s onto the band file: %.512s", tmpfile,
+            bmeta->file_name);
+        error_handler (true, FUNC_NAME, errmsg);
+        unlink (tmpfile);
+        return (ERROR);
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  main
+
+PURPOSE:  Rewrites the raw binary bands of the ESPA product into the
+block-compressed band container for archive-tier storage.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error archiving the bands
+SUCCESS         No errors encountered
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+int main (int argc, char** argv)
+{
+    char FUNC_NAME[] = "espa_archive_band";  /* function name */
+    char errmsg[STR_SIZE];        /* error message */
+    char *xml_infile = NULL;      /* input XML filename */
+    struct stat st;               /* information for the current band file */
+    long long in_bytes = 0;       /* total band bytes before archiving */
+    long long out_bytes = 0;      /* total band bytes after archiving */
+    int narchived = 0;            /* number of bands archived */
+    int nskipped = 0;             /* number of bands already archived */
+    int i;                        /* looping variable for the bands */
+    bool skipped;                 /* was the band already archived? */
+    Espa_internal_meta_t xml_metadata;  /* XML metadata structure to be
+                                     populated by reading the input XML
+                                     metadata file */
+
+    /* Strip the shared --startup-profile option before parsing the
+       tool's own arguments */
+    espa_startup_profile_args (&argc, argv);
+
+    /* Read the command-line arguments */
+    if (get_args (argc, argv, &xml_infile) != SUCCESS)
+    {   /* get_args already printed the error message */
+        exit (EXIT_FAILURE);
+    }
+
+    /* Validate the input metadata file */
+    if (validate_xml_file (xml_infile) != SUCCESS)
+    {  /* Error messages already written */
+        exit (EXIT_FAILURE);
+    }
+
+    /* Initialize the metadata structure */
+    init_metadata_struct (&xml_metadata);
+
+    /* Parse the metadata file into our internal metadata structure; also
+       allocates space as needed for various pointers in the global and band
+       metadata */
+    if (parse_metadata (xml_infile, &xml_metadata) != SUCCESS)
+    {  /* Error messages already written */
+        exit (EXIT_FAILURE);
+    }
+
+    /* Archive each band, leaving already-archived bands alone */
+    for (i = 0; i < xml_metadata.nbands; i++)
+    {
+        if (stat (xml_metadata.band[i].file_name, &st) == 0)
+            in_bytes += (long long) st.st_size;
+
+        if (archive_band (&xml_metadata.band[i], &skipped) != SUCCESS)
+        {
+            sprintf (errmsg, "Archiving band %.1024s.",
+                xml_metadata.band[i].name);
+            error_handler (true, FUNC_NAME, errmsg);
+            free_metadata (&xml_metadata);
+            exit (EXIT_FAILURE);
+        }
+
+        if (stat (xml_metadata.band[i].file_name, &st) == 0)
+            out_bytes += (long long) st.st_size;
+
+        if (skipped)
+            nskipped++;
+        else
+            narchived++;
+    }
+
+    printf ("Archived %d band(s) (%d already archived): %lld -> %lld "
+        "bytes\n", narchived, nskipped, in_bytes, out_bytes);
+
+    /* Free the metadata structure and the pointers */
+    free_metadata (&xml_metadata);
+    free (xml_infile);
+
+    /* Successful completion */
+    exit (EXIT_SUCCESS);
+}
@@ -13,6 +13,8 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 1/14/2014    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added support for clipping the raw binary band
+                              files to a line/sample window
 
 NOTES:
   1. The XML metadata format parsed or written via this library follows the
@@ -22,6 +24,9 @@ NOTES:
 *****************************************************************************/
 #include <getopt.h>
 #include "subset_metadata.h"
+#include "subset_pixels.h"
+#include "espa_geoloc.h"
+#include "espa_startup.h"
 
 /******************************************************************************
 MODULE: usage
@@ -35,6 +40,8 @@ HISTORY:
 Date         Programmer       Reason
 ---------    ---------------  -------------------------------------
 1/14/2014    Gail Schmidt     Original Development
+8/31/2026    Gail Schmidt     Added the line/sample window options for
+                              clipping the image data
 
 NOTES:
 ******************************************************************************/
@@ -42,11 +49,17 @@ void usage ()
 {
     printf ("espa_band_subset subsets the specified bands from the input XML "
             "metadata file and creates a new XML metadata file containing "
-            "only the specified bands.\n\n");
+            "only the specified bands.  If a line/sample window is specified "
+            "then the raw binary band files are also clipped to the window "
+            "and new band files, ENVI headers, and metadata are written for "
+            "the clipped product.\n\n");
     printf ("usage: espa_band_subset "
             "--xml=input_metadata_filename "
             "--subset_xml=output_subset_metadata_filename "
-            "[--band=band_name (multiple --band options can be specified)].\n");
+            "[--band=band_name (multiple --band options can be specified)] "
+            "[--start_line=line --start_samp=sample --nlines=number_of_lines "
+            "--nsamps=number_of_samples] "
+            "[--geo_bounds].\n");
 
     printf ("\nwhere the following parameters are required:\n");
     printf ("    -xml: name of the input XML metadata file which follows "
@@ -57,7 +70,19 @@ void usage ()
     printf ("\nwhere the following parameters are optional:\n");
     printf ("    -band: name of the band in the input XML file to be written "
             "to the subset XML file. If not specified, then only the global "
-            "and projection metadata will be copied to the subset XML file.\n");
+            "and projection metadata will be copied to the subset XML file "
+            "(or all the bands are clipped when a window is specified).\n");
+    printf ("    -start_line: first line of the window (0-based)\n");
+    printf ("    -start_samp: first sample of the window (0-based)\n");
+    printf ("    -nlines: number of lines in the window\n");
+    printf ("    -nsamps: number of samples in the window. All four window "
+            "parameters must be specified together to clip the image "
+            "data.\n");
+    printf ("    -geo_bounds: recompute the geographic corner and bounding "
+            "coordinates for the window via the map projection. By default "
+            "the projection corners are shifted arithmetically and the "
+            "geographic coordinates keep their full-scene values, which "
+            "remain a valid superset of the window.\n");
     printf ("\nExample: espa_band_subset "
             "--xml=LE70230282011250EDC00.xml "
             "--subset_xml=LE70230282011250EDC00_subset.xml "
@@ -65,6 +90,9 @@ void usage ()
     printf ("\nExample: espa_band_subset "
             "--xml=LE70230282011250EDC00.xml "
             "--subset_xml=LE70230282011250EDC00_subset.xml\n");
+    printf ("\n    --startup-profile: report the time spent in the startup "
+            "phases (library init, schema validation, XML parse, first I/O) "
+            "to stderr; shared by all the ESPA tools\n");
 }
 
 
@@ -86,6 +114,8 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 1/14/2014    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added the line/sample window options
+8/31/2026    Gail Schmidt     Added the geo_bounds option
 
 NOTES:
   1. Memory is allocated for the input and output files.  All of these should
@@ -99,7 +129,15 @@ short get_args
     char **xml_infile,    /* O: address of input XML filename */
     char **xml_subset_outfile,  /* O: address of output subset XML filename */
     int *nbands,          /* O: number of bands in the subset */
-    char bands[][STR_SIZE]  /* O: array of band names to be subset */
+    char bands[][STR_SIZE], /* O: array of band names to be subset */
+    int *start_line,      /* O: first line of the window; -1 if no window */
+    int *start_samp,      /* O: first sample of the window; -1 if no window */
+    int *nlines,          /* O: number of lines in the window; -1 if no
+                                window */
+    int *nsamps,          /* O: number of samples in the window; -1 if no
+                                window */
+    bool *geo_bounds      /* O: should the geographic corner and bounding
+                                coordinates be recomputed for the window? */
 )
 {
     int c;                           /* current argument index */
@@ -107,17 +145,25 @@ short get_args
     int count;                       /* number of chars copied in snprintf */
     char errmsg[STR_SIZE];           /* error message */
     char FUNC_NAME[] = "get_args";   /* function name */
+    static int geo_bounds_flag = 0;  /* flag for recomputing the geographic
+                                        coordinates of the window */
     static struct option long_options[] =
     {
+        {"geo_bounds", no_argument, &geo_bounds_flag, 1},
         {"xml", required_argument, 0, 'i'},
         {"subset_xml", required_argument, 0, 'o'},
         {"band", required_argument, 0, 'b'},
+        {"start_line", required_argument, 0, 'l'},
+        {"start_samp", required_argument, 0, 's'},
+        {"nlines", required_argument, 0, 'n'},
+        {"nsamps", required_argument, 0, 'm'},
         {"help", no_argument, 0, 'h'},
         {0, 0, 0, 0}
     };
 
     /* Loop through all the cmd-line options */
     *nbands = 0;
+    *start_line = *start_samp = *nlines = *nsamps = -1;
     opterr = 0;   /* turn off getopt_long error msgs as we'll print our own */
     while (1)
     {
@@ -168,7 +214,23 @@ short get_args
                     error_handler (false, FUNC_NAME, errmsg);
                 }
                 break;
-     
+
+            case 'l':  /* first line of the window */
+                *start_line = atoi (optarg);
+                break;
+
+            case 's':  /* first sample of the window */
+                *start_samp = atoi (optarg);
+                break;
+
+            case 'n':  /* number of lines in the window */
+                *nlines = atoi (optarg);
+                break;
+
+            case 'm':  /* number of samples in the window */
+                *nsamps = atoi (optarg);
+                break;
+
             case '?':
             default:
                 sprintf (errmsg, "Unknown option %s", argv[optind-1]);
@@ -196,8 +258,38 @@ short get_args
         return (ERROR);
     }
 
+    /* Check the geographic coordinate recompute flag */
+    if (geo_bounds_flag)
+        *geo_bounds = true;
+
+    /* If any window parameter was specified then all of them are needed */
+    if (*start_line != -1 || *start_samp != -1 || *nlines != -1 ||
+        *nsamps != -1)
+    {
+        if (*start_line < 0 || *start_samp < 0 || *nlines <= 0 ||
+            *nsamps <= 0)
+        {
+            sprintf (errmsg, "All four window parameters (start_line, "
+                "start_samp, nlines, nsamps) must be specified together to "
+                "clip the image data.");
+            error_handler (true, FUNC_NAME, errmsg);
+            usage ();
+            return (ERROR);
+        }
+    }
+
+    /* Recomputing the geographic coordinates only applies to a window */
+    if (*geo_bounds && *nlines == -1)
+    {
+        sprintf (errmsg, "The geo_bounds option requires a line/sample "
+            "window.");
+        error_handler (true, FUNC_NAME, errmsg);
+        usage ();
+        return (ERROR);
+    }
+
     /* Warn the user if no bands were specified */
-    if (*nbands == 0)
+    if (*nbands == 0 && *nlines == -1)
     {
         sprintf (errmsg, "No bands were specified, therefore only the "
             "global and projection metadata will be copied to the subset "
@@ -226,10 +318,18 @@ HISTORY:
 Date         Programmer       Reason
 ----------   --------------   -------------------------------------
 1/14/2014    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added support for clipping the image data to a
+                              line/sample window
+8/31/2026    Gail Schmidt     Optionally recompute the geographic corner and
+                              bounding coordinates for the window via the
+                              map projection (--geo_bounds)
 
 NOTES:
   1. If nbands is 0 or no bands match the bands specified, then the global and
      projection information will still be copied to the subset XML file.
+  2. If a line/sample window is specified then the raw binary band files are
+     clipped to the window as well; with no band list, all the bands are
+     clipped.
 ******************************************************************************/
 int main (int argc, char** argv)
 {
@@ -237,20 +337,74 @@ int main (int argc, char** argv)
     char *xml_subset_outfile = NULL;  /* output subset XML filename */
     char bands[MAX_TOTAL_BANDS][STR_SIZE];  /* array of nbands band names */
     int nbands;                       /* number of bands specified */
+    int start_line;                   /* first line of the window */
+    int start_samp;                   /* first sample of the window */
+    int nlines;                       /* number of lines in the window */
+    int nsamps;                       /* number of samples in the window */
+    bool geo_bounds = false;          /* recompute the geographic corner and
+                                         bounding coordinates of the window? */
+    Espa_internal_meta_t xml_metadata;  /* XML metadata of the clipped
+                                         product, for the geographic
+                                         coordinate recompute */
+
+    /* Strip the shared --startup-profile option before parsing the
+       tool's own arguments */
+    espa_startup_profile_args (&argc, argv);
 
     /* Read the command-line arguments */
     if (get_args (argc, argv, &xml_infile, &xml_subset_outfile, &nbands,
-        bands) != SUCCESS)
+        bands, &start_line, &start_samp, &nlines, &nsamps, &geo_bounds)
+        != SUCCESS)
     {   /* get_args already printed the error message */
         exit (EXIT_FAILURE);
     }
 
-    /* Subset the input XML metadata file with the specified bands and write
-       to the output XML metadata file */
-    if (subset_xml_by_band (xml_infile, xml_subset_outfile, nbands, bands) !=
-        SUCCESS)
-    {  /* Error messages already written */
-        exit (EXIT_FAILURE);
+    if (nlines != -1)
+    {
+        /* Clip the image data of the specified bands to the window, and
+           write the clipped band files, ENVI headers, and XML metadata */
+        if (subset_pixels_by_window (xml_infile, xml_subset_outfile, nbands,
+            bands, start_line, start_samp, nlines, nsamps) != SUCCESS)
+        {  /* Error messages already written */
+            exit (EXIT_FAILURE);
+        }
+
+        /* Recompute the geographic corner and bounding coordinates of the
+           window via the map projection, if requested.  The default leaves
+           the full-scene values in place, which are a valid superset and
+           avoid setting up the projection transforms at all. */
+        if (geo_bounds)
+        {
+            init_metadata_struct (&xml_metadata);
+            if (parse_metadata (xml_subset_outfile, &xml_metadata) != SUCCESS)
+            {  /* Error messages already written */
+                exit (EXIT_FAILURE);
+            }
+
+            if (!update_geo_window_bounds (&xml_metadata))
+            {  /* Error messages already written */
+                free_metadata (&xml_metadata);
+                exit (EXIT_FAILURE);
+            }
+
+            if (write_metadata (&xml_metadata, xml_subset_outfile) != SUCCESS
+                || validate_xml_file (xml_subset_outfile) != SUCCESS)
+            {  /* Error messages already written */
+                free_metadata (&xml_metadata);
+                exit (EXIT_FAILURE);
+            }
+            free_metadata (&xml_metadata);
+        }
+    }
+    else
+    {
+        /* Subset the input XML metadata file with the specified bands and
+           write to the output XML metadata file */
+        if (subset_xml_by_band (xml_infile, xml_subset_outfile, nbands,
+            bands) != SUCCESS)
+        {  /* Error messages already written */
+            exit (EXIT_FAILURE);
+        }
     }
 
     /* Free the pointers */
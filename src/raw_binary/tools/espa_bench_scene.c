@@ -0,0 +1,874 @@
+/*****************************************************************************
+FILE: espa_bench_scene.c
+
+PURPOSE: Contains the scene-level regression benchmark harness, which runs
+the LPGS to ESPA to GeoTIFF (and optionally HDF) conversion chain over a
+generated synthetic scene, records per-stage wall/CPU/RSS, and gates the
+timings against a stored baseline.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The synthetic scene is a 7-band TM-style uint8 product with a
+     deterministic pixel pattern, so no real data is needed and runs are
+     comparable.  The scene is generated in the current directory and
+     removed afterwards.
+  2. The baseline file holds one "stage wall_seconds" line per stage.  A
+     stage fails the gate when its wall time exceeds the baseline by more
+     than the tolerance; run with --update_baseline to record the current
+     machine's numbers.
+*****************************************************************************/
+#include <getopt.h>
+#include <unistd.h>
+#include <math.h>
+#include <time.h>
+#include <sys/resource.h>
+#include "tiffio.h"
+#include "error_handler.h"
+#include "espa_metadata.h"
+#include "parse_metadata.h"
+#include "raw_binary_io.h"
+#include "convert_lpgs_to_espa.h"
+#include "convert_espa_to_gtif.h"
+#include "convert_espa_to_hdf.h"
+#include "espa_startup.h"
+
+/* Number of bands in the synthetic TM-style scene */
+#define BENCH_SCENE_NBANDS 7
+
+/* Base name of the synthetic scene */
+#define BENCH_SCENE_ID "LT50330342011001EDC00"
+
+/* Maximum number of benchmarked stages */
+#define BENCH_MAX_STAGES 8
+
+/* Default allowed slowdown vs. the baseline, in percent */
+#define BENCH_DEFAULT_TOLERANCE 20.0
+
+/* Per-stage measurements */
+typedef struct
+{
+    char name[STR_SIZE];   /* stage name */
+    double wall;           /* wall clock seconds in the stage */
+    double cpu;            /* user+system CPU seconds in the stage */
+    double max_rss_mb;     /* peak resident set size after the stage, MB */
+} Bench_stage_t;
+
+/******************************************************************************
+MODULE:  usage
+
+PURPOSE:  Prints the usage information for this application.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void usage ()
+{
+    printf ("espa_bench_scene runs the LPGS->ESPA->GeoTIFF (and optionally "
+            "HDF) conversion chain over a generated synthetic scene, "
+            "reports per-stage wall/CPU/RSS, and gates the wall times "
+            "against a stored baseline.\n\n");
+    printf ("usage: espa_bench_scene "
+            "[--nlines=number_of_lines] "
+            "[--nsamps=number_of_samples] "
+            "[--num_threads=number_of_threads] "
+            "[--baseline=baseline_file] "
+            "[--tolerance=percent] "
+            "[--update_baseline] "
+            "[--hdf]\n");
+
+    printf ("\nwhere the following parameters are optional:\n");
+    printf ("    -nlines: number of lines in the synthetic bands "
+            "(default 2000)\n");
+    printf ("    -nsamps: number of samples in the synthetic bands "
+            "(default 2000)\n");
+    printf ("    -num_threads: number of threads for the band conversions "
+            "(default 1)\n");
+    printf ("    -baseline: baseline file to gate against (default "
+            "espa_bench_scene.baseline)\n");
+    printf ("    -tolerance: allowed slowdown vs. the baseline in percent "
+            "(default %.0f)\n", BENCH_DEFAULT_TOLERANCE);
+    printf ("    -update_baseline: write the current timings to the "
+            "baseline file instead of gating\n");
+    printf ("    -hdf: also run the ESPA to HDF stage\n");
+    printf ("\nespa_bench_scene --help will print the usage statement\n");
+    printf ("\n    --startup-profile: report the time spent in the startup "
+            "phases (library init, schema validation, XML parse, first I/O) "
+            "to stderr; shared by all the ESPA tools\n");
+}
+
+/******************************************************************************
+MODULE:  get_args
+
+PURPOSE:  Gets the command-line arguments and validates that the required
+arguments were specified.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error getting the command-line arguments or a command-line
+                argument and associated value were not specified
+SUCCESS         No errors encountered
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+short get_args
+(
+    int argc,             /* I: number of cmd-line args */
+    char *argv[],         /* I: string of cmd-line args */
+    int *nlines,          /* O: number of lines in the synthetic bands */
+    int *nsamps,          /* O: number of samples in the synthetic bands */
+    int *num_threads,     /* O: number of threads for the conversions */
+    char **baseline_file, /* O: address of the baseline filename */
+    double *tolerance,    /* O: allowed slowdown in percent */
+    bool *update_baseline,/* O: write the baseline instead of gating */
+    bool *run_hdf         /* O: also run the HDF stage */
+)
+{
+    int c;                           /* current argument index */
+    int option_index;                /* index for the command-line option */
+    char errmsg[STR_SIZE];           /* error message */
+    char FUNC_NAME[] = "get_args";   /* function name */
+    static int update_flag = 0;      /* update the baseline flag */
+    static int hdf_flag = 0;         /* run the HDF stage flag */
+    static struct option long_options[] =
+    {
+        {"update_baseline", no_argument, &update_flag, 1},
+        {"hdf", no_argument, &hdf_flag, 1},
+        {"nlines", required_argument, 0, 'l'},
+        {"nsamps", required_argument, 0, 's'},
+        {"num_threads", required_argument, 0, 't'},
+        {"baseline", required_argument, 0, 'b'},
+        {"tolerance", required_argument, 0, 'p'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    /* Loop through all the cmd-line options */
+    opterr = 0;   /* turn off getopt_long error msgs as we'll print our own */
+    while (1)
+    {
+        /* optstring in call to getopt_long is empty since we will only
+           support the long options */
+        c = getopt_long (argc, argv, "", long_options, &option_index);
+        if (c == -1)
+        {   /* Out of cmd-line options */
+            break;
+        }
+
+        switch (c)
+        {
+            case 0:
+                /* If this option set a flag, do nothing else now. */
+                if (long_options[option_index].flag != 0)
+                    break;
+                break;
+
+            case 'h':  /* help */
+                usage ();
+                return (ERROR);
+                break;
+
+            case 'l':  /* number of lines */
+                *nlines = atoi (optarg);
+                break;
+
+            case 's':  /* number of samples */
+                *nsamps = atoi (optarg);
+                break;
+
+            case 't':  /* number of threads */
+                *num_threads = atoi (optarg);
+                break;
+
+            case 'b':  /* baseline file */
+                *baseline_file = strdup (optarg);
+                break;
+
+            case 'p':  /* tolerance */
+                *tolerance = atof (optarg);
+                break;
+
+            case '?':
+            default:
+                sprintf (errmsg, "Unknown option %s", argv[optind-1]);
+                error_handler (true, FUNC_NAME, errmsg);
+                usage ();
+                return (ERROR);
+                break;
+        }
+    }
+
+    /* Validate the sizes */
+    if (*nlines < 16 || *nsamps < 16)
+    {
+        sprintf (errmsg, "Scene size must be at least 16 x 16");
+        error_handler (true, FUNC_NAME, errmsg);
+        usage ();
+        return (ERROR);
+    }
+
+    if (*tolerance <= 0.0)
+    {
+        sprintf (errmsg, "Tolerance must be a positive percentage");
+        error_handler (true, FUNC_NAME, errmsg);
+        usage ();
+        return (ERROR);
+    }
+
+    *update_baseline = (update_flag != 0);
+    *run_hdf = (hdf_flag != 0);
+
+    return (SUCCESS);
+}
+
+/******************************************************************************
+MODULE:  bench_wall_seconds
+
+PURPOSE:  Returns the monotonic wall clock in seconds.
+
+RETURN VALUE:
+Type = double
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+double bench_wall_seconds ()
+{
+    struct timespec ts;   /* monotonic clock reading */
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec + ts.tv_nsec * 1e-9);
+}
+
+/******************************************************************************
+MODULE:  bench_cpu_seconds
+
+PURPOSE:  Returns the user plus system CPU seconds consumed by the process.
+
+RETURN VALUE:
+Type = double
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+double bench_cpu_seconds ()
+{
+    struct rusage usage;  /* process resource usage */
+
+    getrusage (RUSAGE_SELF, &usage);
+    return (usage.ru_utime.tv_sec + usage.ru_utime.tv_usec * 1e-6 +
+            usage.ru_stime.tv_sec + usage.ru_stime.tv_usec * 1e-6);
+}
+
+/******************************************************************************
+MODULE:  bench_max_rss_mb
+
+PURPOSE:  Returns the peak resident set size of the process in megabytes.
+
+RETURN VALUE:
+Type = double
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The peak is monotonic for the life of the process, so later stages
+     report at least the peak of the earlier ones.
+******************************************************************************/
+double bench_max_rss_mb ()
+{
+    struct rusage usage;  /* process resource usage */
+
+    getrusage (RUSAGE_SELF, &usage);
+    return (usage.ru_maxrss / 1024.0);
+}
+
+/******************************************************************************
+MODULE:  write_synthetic_band
+
+PURPOSE:  Writes one synthetic uint8 TIFF band with a deterministic pixel
+pattern.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error writing the band
+SUCCESS         Band was written
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+int write_synthetic_band
+(
+    char *tif_file,   /* I: name of the TIFF file to be written */
+    int band,         /* I: band number, folded into the pixel pattern */
+    int nlines,       /* I: number of lines in the band */
+    int nsamps        /* I: number of samples in the band */
+)
+{
+    char FUNC_NAME[] = "write_synthetic_band";  /* function name */
+    char errmsg[STR_SIZE];      /* error message */
+    unsigned char *line_buf = NULL;  /* buffer for one line of pixels */
+    TIFF *fp_tiff = NULL;       /* file pointer for the TIFF file */
+    int line;                   /* looping variable for lines */
+    int samp;                   /* looping variable for samples */
+
+    fp_tiff = TIFFOpen (tif_file, "w");
+    if (fp_tiff == NULL)
+    {
+        sprintf (errmsg, "Opening the synthetic TIFF file %s", tif_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    TIFFSetField (fp_tiff, TIFFTAG_IMAGEWIDTH, nsamps);
+    TIFFSetField (fp_tiff, TIFFTAG_IMAGELENGTH, nlines);
+    TIFFSetField (fp_tiff, TIFFTAG_BITSPERSAMPLE, 8);
+    TIFFSetField (fp_tiff, TIFFTAG_SAMPLESPERPIXEL, 1);
+    TIFFSetField (fp_tiff, TIFFTAG_ROWSPERSTRIP, 1);
+    TIFFSetField (fp_tiff, TIFFTAG_COMPRESSION, COMPRESSION_NONE);
+    TIFFSetField (fp_tiff, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+    TIFFSetField (fp_tiff, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_MINISBLACK);
+
+    line_buf = malloc (nsamps);
+    if (line_buf == NULL)
+    {
+        sprintf (errmsg, "Allocating the line buffer for %s", tif_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        TIFFClose (fp_tiff);
+        return (ERROR);
+    }
+
+    /* Deterministic pattern with some per-band variation; zero is left for
+       the fill corners of a real scene */
+    for (line = 0; line < nlines; line++)
+    {
+        for (samp = 0; samp < nsamps; samp++)
+            line_buf[samp] = (unsigned char) ((line * 7 + samp * 3 +
+                band * 31) % 254 + 1);
+        if (TIFFWriteScanline (fp_tiff, line_buf, line, 0) != 1)
+        {
+            sprintf (errmsg, "Writing line %d of %s", line, tif_file);
+            error_handler (true, FUNC_NAME, errmsg);
+            free (line_buf);
+            TIFFClose (fp_tiff);
+            return (ERROR);
+        }
+    }
+
+    free (line_buf);
+    TIFFClose (fp_tiff);
+    return (SUCCESS);
+}
+
+/******************************************************************************
+MODULE:  generate_synthetic_scene
+
+PURPOSE:  Writes the MTL file and the seven synthetic TIFF bands of the
+TM-style scene.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error generating the scene
+SUCCESS         Scene was generated
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The projection corners are consistent with the band size at 30m
+     pixels in UTM zone 13, so the geolocation setup in the MTL reader
+     gets a coherent scene.
+******************************************************************************/
+int generate_synthetic_scene
+(
+    char *mtl_file,   /* I: name of the MTL file to be written */
+    int nlines,       /* I: number of lines in the bands */
+    int nsamps        /* I: number of samples in the bands */
+)
+{
+    char FUNC_NAME[] = "generate_synthetic_scene";  /* function name */
+    char errmsg[STR_SIZE];      /* error message */
+    char tif_file[STR_SIZE];    /* name of the current TIFF band */
+    double ul_x = 255000.0;     /* UL projection x (pixel center) */
+    double ul_y = 4764000.0;    /* UL projection y (pixel center) */
+    double pixsize = 30.0;      /* pixel size in meters */
+    double lr_x;                /* LR projection x (pixel center) */
+    double lr_y;                /* LR projection y (pixel center) */
+    FILE *fptr = NULL;          /* file pointer for the MTL file */
+    int band;                   /* looping variable for bands */
+
+    lr_x = ul_x + (nsamps - 1) * pixsize;
+    lr_y = ul_y - (nlines - 1) * pixsize;
+
+    /* Write the MTL file */
+    fptr = fopen (mtl_file, "w");
+    if (fptr == NULL)
+    {
+        sprintf (errmsg, "Opening the MTL file %s for writing", mtl_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    fprintf (fptr,
+        "GROUP = L1_METADATA_FILE\n"
+        "  GROUP = METADATA_FILE_INFO\n"
+        "    FILE_DATE = 2026-08-31T00:00:00Z\n"
+        "    PROCESSING_SOFTWARE_VERSION = \"ESPA_BENCH_1.0\"\n"
+        "  END_GROUP = METADATA_FILE_INFO\n"
+        "  GROUP = PRODUCT_METADATA\n"
+        "    DATA_TYPE = \"L1T\"\n"
+        "    SPACECRAFT_ID = \"LANDSAT_5\"\n"
+        "    SENSOR_ID = \"TM\"\n"
+        "    WRS_PATH = 33\n"
+        "    WRS_ROW = 34\n"
+        "    DATE_ACQUIRED = 2011-01-01\n"
+        "    SCENE_CENTER_TIME = 17:30:00.0000000Z\n"
+        "    CORNER_UL_LAT_PRODUCT = 43.02\n"
+        "    CORNER_UL_LON_PRODUCT = -106.01\n"
+        "    CORNER_UR_LAT_PRODUCT = 43.00\n"
+        "    CORNER_UR_LON_PRODUCT = -104.00\n"
+        "    CORNER_LL_LAT_PRODUCT = 41.02\n"
+        "    CORNER_LL_LON_PRODUCT = -106.00\n"
+        "    CORNER_LR_LAT_PRODUCT = 41.00\n"
+        "    CORNER_LR_LON_PRODUCT = -104.01\n"
+        "    CORNER_UL_PROJECTION_X_PRODUCT = %.3f\n"
+        "    CORNER_UL_PROJECTION_Y_PRODUCT = %.3f\n"
+        "    CORNER_LR_PROJECTION_X_PRODUCT = %.3f\n"
+        "    CORNER_LR_PROJECTION_Y_PRODUCT = %.3f\n"
+        "    REFLECTIVE_LINES = %d\n"
+        "    REFLECTIVE_SAMPLES = %d\n"
+        "    THERMAL_LINES = %d\n"
+        "    THERMAL_SAMPLES = %d\n",
+        ul_x, ul_y, lr_x, lr_y, nlines, nsamps, nlines, nsamps);
+
+    for (band = 1; band <= BENCH_SCENE_NBANDS; band++)
+        fprintf (fptr, "    FILE_NAME_BAND_%d = \"%s_B%d.TIF\"\n", band,
+            BENCH_SCENE_ID, band);
+
+    fprintf (fptr,
+        "  END_GROUP = PRODUCT_METADATA\n"
+        "  GROUP = IMAGE_ATTRIBUTES\n"
+        "    SUN_AZIMUTH = 153.27\n"
+        "    SUN_ELEVATION = 25.36\n"
+        "  END_GROUP = IMAGE_ATTRIBUTES\n"
+        "  GROUP = MIN_MAX_PIXEL_VALUE\n");
+
+    for (band = 1; band <= BENCH_SCENE_NBANDS; band++)
+        fprintf (fptr,
+            "    QUANTIZE_CAL_MAX_BAND_%d = 255\n"
+            "    QUANTIZE_CAL_MIN_BAND_%d = 1\n", band, band);
+
+    fprintf (fptr,
+        "  END_GROUP = MIN_MAX_PIXEL_VALUE\n"
+        "  GROUP = RADIOMETRIC_RESCALING\n");
+
+    for (band = 1; band <= BENCH_SCENE_NBANDS; band++)
+        fprintf (fptr,
+            "    RADIANCE_MULT_BAND_%d = 0.76583\n"
+            "    RADIANCE_ADD_BAND_%d = -2.28583\n", band, band);
+
+    fprintf (fptr,
+        "  END_GROUP = RADIOMETRIC_RESCALING\n"
+        "  GROUP = PROJECTION_PARAMETERS\n"
+        "    MAP_PROJECTION = \"UTM\"\n"
+        "    DATUM = \"WGS84\"\n"
+        "    ELLIPSOID = \"WGS84\"\n"
+        "    UTM_ZONE = 13\n"
+        "    GRID_CELL_SIZE_REFLECTIVE = %.2f\n"
+        "    GRID_CELL_SIZE_THERMAL = %.2f\n"
+        "    RESAMPLING_OPTION = \"CUBIC_CONVOLUTION\"\n"
+        "  END_GROUP = PROJECTION_PARAMETERS\n"
+        "END_GROUP = L1_METADATA_FILE\n"
+        "END\n", pixsize, pixsize);
+
+    fclose (fptr);
+
+    /* Write the synthetic bands */
+    for (band = 1; band <= BENCH_SCENE_NBANDS; band++)
+    {
+        sprintf (tif_file, "%s_B%d.TIF", BENCH_SCENE_ID, band);
+        if (write_synthetic_band (tif_file, band, nlines, nsamps) != SUCCESS)
+        {   /* Error messages already printed */
+            return (ERROR);
+        }
+    }
+
+    return (SUCCESS);
+}
+
+/******************************************************************************
+MODULE:  remove_scene_files
+
+PURPOSE:  Removes the generated scene inputs and every product file named in
+the ESPA metadata, plus the GeoTIFF/HDF outputs of the later stages.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void remove_scene_files
+(
+    char *mtl_file,   /* I: name of the generated MTL file */
+    char *xml_file,   /* I: name of the ESPA XML file, if created */
+    bool run_hdf      /* I: was the HDF stage run? */
+)
+{
+    char filename[STR_SIZE];    /* name of the current file to remove */
+    char *cptr = NULL;          /* pointer to the file extension */
+    Espa_internal_meta_t xml_metadata;  /* XML metadata structure */
+    int i;                      /* looping variable */
+
+    /* Remove the scene inputs */
+    remove (mtl_file);
+    for (i = 1; i <= BENCH_SCENE_NBANDS; i++)
+    {
+        sprintf (filename, "%s_B%d.TIF", BENCH_SCENE_ID, i);
+        remove (filename);
+    }
+
+    /* Remove the products named in the XML, along with their ENVI headers
+       and the per-band GeoTIFF outputs */
+    init_metadata_struct (&xml_metadata);
+    if (parse_metadata (xml_file, &xml_metadata) == SUCCESS)
+    {
+        for (i = 0; i < xml_metadata.nbands; i++)
+        {
+            sprintf (filename, "%s", xml_metadata.band[i].file_name);
+            remove (filename);
+            cptr = strrchr (filename, '.');
+            if (cptr != NULL)
+            {
+                strcpy (cptr, ".hdr");
+                remove (filename);
+                strcpy (cptr, ".tif");
+                remove (filename);
+            }
+        }
+        free_metadata (&xml_metadata);
+    }
+    remove (xml_file);
+
+    if (run_hdf)
+    {
+        sprintf (filename, "%s.hdf", BENCH_SCENE_ID);
+        remove (filename);
+        sprintf (filename, "%s.hdf.hdr", BENCH_SCENE_ID);
+        remove (filename);
+        sprintf (filename, "%s.hdf.xml", BENCH_SCENE_ID);
+        remove (filename);
+    }
+}
+
+/******************************************************************************
+MODULE:  gate_against_baseline
+
+PURPOSE:  Compares the recorded stage wall times against the baseline file,
+or rewrites the baseline when updating.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           A stage exceeded the baseline by more than the tolerance,
+                or the baseline could not be read/written
+SUCCESS         All stages within tolerance, or the baseline was updated
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Stages in the baseline which were not run this time (e.g. the HDF
+     stage) are ignored; new stages without a baseline entry pass with a
+     note so adding stages does not break existing baselines.
+******************************************************************************/
+int gate_against_baseline
+(
+    char *baseline_file,       /* I: name of the baseline file */
+    Bench_stage_t stages[],    /* I: recorded stages */
+    int nstages,               /* I: number of recorded stages */
+    double tolerance,          /* I: allowed slowdown in percent */
+    bool update_baseline       /* I: write the baseline instead of gating */
+)
+{
+    char FUNC_NAME[] = "gate_against_baseline";  /* function name */
+    char errmsg[STR_SIZE];     /* error message */
+    char name[STR_SIZE];       /* stage name from the baseline */
+    double base_wall;          /* baseline wall seconds for the stage */
+    double limit;              /* gate limit for the stage */
+    FILE *fptr = NULL;         /* file pointer for the baseline file */
+    bool found;                /* was the stage found in the baseline? */
+    int nfailed = 0;           /* number of stages over the gate */
+    int i;                     /* looping variable */
+
+    if (update_baseline)
+    {
+        fptr = fopen (baseline_file, "w");
+        if (fptr == NULL)
+        {
+            sprintf (errmsg, "Opening the baseline file %s for writing",
+                baseline_file);
+            error_handler (true, FUNC_NAME, errmsg);
+            return (ERROR);
+        }
+        for (i = 0; i < nstages; i++)
+            fprintf (fptr, "%s %.6f\n", stages[i].name, stages[i].wall);
+        fclose (fptr);
+        printf ("Baseline written to %s\n", baseline_file);
+        return (SUCCESS);
+    }
+
+    fptr = fopen (baseline_file, "r");
+    if (fptr == NULL)
+    {
+        printf ("No baseline file %s; run with --update_baseline to record "
+                "one.  Timings reported but not gated.\n", baseline_file);
+        return (SUCCESS);
+    }
+
+    for (i = 0; i < nstages; i++)
+    {
+        /* Look the stage up in the baseline */
+        found = false;
+        rewind (fptr);
+        while (fscanf (fptr, "%s %lf", name, &base_wall) == 2)
+        {
+            if (!strcmp (name, stages[i].name))
+            {
+                found = true;
+                break;
+            }
+        }
+
+        if (!found)
+        {
+            printf ("  %-18s no baseline entry; passing\n", stages[i].name);
+            continue;
+        }
+
+        limit = base_wall * (1.0 + tolerance / 100.0);
+        if (stages[i].wall > limit)
+        {
+            printf ("  %-18s FAILED: %.3fs vs. baseline %.3fs "
+                    "(limit %.3fs)\n", stages[i].name, stages[i].wall,
+                    base_wall, limit);
+            nfailed++;
+        }
+        else
+            printf ("  %-18s ok: %.3fs vs. baseline %.3fs (limit %.3fs)\n",
+                stages[i].name, stages[i].wall, base_wall, limit);
+    }
+    fclose (fptr);
+
+    if (nfailed > 0)
+    {
+        sprintf (errmsg, "%d stage(s) exceeded the baseline by more than "
+            "%.0f%%", nfailed, tolerance);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    return (SUCCESS);
+}
+
+/******************************************************************************
+MODULE:  main
+
+PURPOSE:  Generates the synthetic scene, runs the conversion stages with
+per-stage wall/CPU/RSS measurements, and gates against the baseline.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error running the benchmark or a stage failed the gate
+SUCCESS         Benchmark ran and passed the gate
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+int main (int argc, char** argv)
+{
+    char mtl_file[STR_SIZE];   /* name of the generated MTL file */
+    char xml_file[STR_SIZE];   /* name of the ESPA XML file */
+    char gtif_base[STR_SIZE];  /* base name for the GeoTIFF outputs */
+    char hdf_file[STR_SIZE];   /* name of the HDF output */
+    char *baseline_file = NULL;  /* name of the baseline file */
+    double tolerance = BENCH_DEFAULT_TOLERANCE;  /* allowed slowdown, pct */
+    double wall_start;         /* wall clock at the start of the stage */
+    double cpu_start;          /* CPU clock at the start of the stage */
+    bool update_baseline = false;  /* write the baseline instead of gating */
+    bool run_hdf = false;      /* also run the HDF stage */
+    int nlines = 2000;         /* lines in the synthetic bands */
+    int nsamps = 2000;         /* samples in the synthetic bands */
+    int num_threads = 1;       /* threads for the band conversions */
+    int nstages = 0;           /* number of recorded stages */
+    int status = SUCCESS;      /* status of the stages */
+    int i;                     /* looping variable */
+    Bench_stage_t stages[BENCH_MAX_STAGES];  /* per-stage measurements */
+    Espa_scene_context_t scene_context;  /* per-scene state shared by the
+                                  conversion stages */
+
+    printf ("espa_bench_scene: scene-level conversion benchmark\n");
+
+    /* Strip the shared --startup-profile option before parsing the
+       tool's own arguments */
+    espa_startup_profile_args (&argc, argv);
+
+    /* Read the command-line arguments */
+    if (get_args (argc, argv, &nlines, &nsamps, &num_threads, &baseline_file,
+        &tolerance, &update_baseline, &run_hdf) != SUCCESS)
+    {   /* get_args already printed the error message */
+        exit (EXIT_FAILURE);
+    }
+    if (baseline_file == NULL)
+        baseline_file = strdup ("espa_bench_scene.baseline");
+
+    sprintf (mtl_file, "%s_MTL.txt", BENCH_SCENE_ID);
+    sprintf (xml_file, "%s.xml", BENCH_SCENE_ID);
+    sprintf (gtif_base, "%s", BENCH_SCENE_ID);
+    sprintf (hdf_file, "%s.hdf", BENCH_SCENE_ID);
+
+    /* Stage: generate the synthetic scene */
+    wall_start = bench_wall_seconds ();
+    cpu_start = bench_cpu_seconds ();
+    if (generate_synthetic_scene (mtl_file, nlines, nsamps) != SUCCESS)
+    {
+        remove_scene_files (mtl_file, xml_file, run_hdf);
+        exit (EXIT_FAILURE);
+    }
+    strcpy (stages[nstages].name, "generate_scene");
+    stages[nstages].wall = bench_wall_seconds () - wall_start;
+    stages[nstages].cpu = bench_cpu_seconds () - cpu_start;
+    stages[nstages].max_rss_mb = bench_max_rss_mb ();
+    nstages++;
+
+    /* Stage: LPGS to ESPA; the scene context carries the parsed metadata
+       into the following stages so they don't re-parse the XML file */
+    init_scene_context (&scene_context);
+    wall_start = bench_wall_seconds ();
+    cpu_start = bench_cpu_seconds ();
+    if (convert_lpgs_to_espa_scene (&scene_context, mtl_file, xml_file,
+        false, num_threads) != SUCCESS)
+        status = ERROR;
+    strcpy (stages[nstages].name, "lpgs_to_espa");
+    stages[nstages].wall = bench_wall_seconds () - wall_start;
+    stages[nstages].cpu = bench_cpu_seconds () - cpu_start;
+    stages[nstages].max_rss_mb = bench_max_rss_mb ();
+    nstages++;
+
+    /* Stage: ESPA to GeoTIFF */
+    if (status == SUCCESS)
+    {
+        wall_start = bench_wall_seconds ();
+        cpu_start = bench_cpu_seconds ();
+        if (convert_espa_to_gtif_scene (&scene_context, xml_file, gtif_base,
+            NULL, false, false, false, NULL, 0, 1, num_threads) != SUCCESS)
+            status = ERROR;
+        strcpy (stages[nstages].name, "espa_to_gtif");
+        stages[nstages].wall = bench_wall_seconds () - wall_start;
+        stages[nstages].cpu = bench_cpu_seconds () - cpu_start;
+        stages[nstages].max_rss_mb = bench_max_rss_mb ();
+        nstages++;
+    }
+
+    /* Stage: ESPA to HDF, when requested */
+    if (status == SUCCESS && run_hdf)
+    {
+        wall_start = bench_wall_seconds ();
+        cpu_start = bench_cpu_seconds ();
+        if (convert_espa_to_hdf_scene (&scene_context, xml_file, hdf_file,
+            NULL, false) != SUCCESS)
+            status = ERROR;
+        strcpy (stages[nstages].name, "espa_to_hdf");
+        stages[nstages].wall = bench_wall_seconds () - wall_start;
+        stages[nstages].cpu = bench_cpu_seconds () - cpu_start;
+        stages[nstages].max_rss_mb = bench_max_rss_mb ();
+        nstages++;
+    }
+
+    free_scene_context (&scene_context);
+
+    /* Report the per-stage measurements */
+    printf ("\n  %-18s %10s %10s %12s\n", "stage", "wall (s)", "cpu (s)",
+        "max rss (MB)");
+    for (i = 0; i < nstages; i++)
+        printf ("  %-18s %10.3f %10.3f %12.1f\n", stages[i].name,
+            stages[i].wall, stages[i].cpu, stages[i].max_rss_mb);
+    printf ("\n");
+
+    /* Clean up the scene before gating so a gate failure still leaves a
+       clean directory */
+    remove_scene_files (mtl_file, xml_file, run_hdf);
+
+    if (status != SUCCESS)
+    {
+        printf ("espa_bench_scene: conversion FAILED\n");
+        exit (EXIT_FAILURE);
+    }
+
+    /* Gate against the baseline */
+    if (gate_against_baseline (baseline_file, stages, nstages, tolerance,
+        update_baseline) != SUCCESS)
+    {
+        printf ("espa_bench_scene: gate FAILED\n");
+        exit (EXIT_FAILURE);
+    }
+
+    printf ("espa_bench_scene: complete\n");
+    free (baseline_file);
+    exit (EXIT_SUCCESS);
+}
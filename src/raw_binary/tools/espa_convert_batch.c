@@ -0,0 +1,800 @@
+/*****************************************************************************
+FILE: espa_convert_batch
+
+PURPOSE: Runs the LPGS to ESPA formatting chain for a batch of scenes listed
+in a manifest file, using a shared pool of threads within a single process.
+Each scene is converted from LPGS to the ESPA internal raw binary format and
+can optionally be converted on to GeoTIFF as a pipelined second stage, so the
+scheduler does not need to string the individual tools together with one
+process per scene per step.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Drain the band buffer reuse pool once the
+                              batch completes
+8/31/2026    Gail Schmidt     Added a command-line option negotiating the
+                              compressed band output sink with the writer
+8/31/2026    Gail Schmidt     Added a packaging mode assembling a delivery
+                              tar per scene with kernel-side copies
+8/31/2026    Gail Schmidt     Emit one resource accounting record per scene
+                              when the instrumentation is enabled
+8/31/2026    Gail Schmidt     Prefetch the band files ahead of the stages
+                              that read them back
+
+NOTES:
+  1. The manifest file contains one scene per line with the input LPGS MTL
+     filename followed by the output ESPA XML filename, separated by
+     whitespace.  Blank lines and lines starting with '#' are skipped.
+  2. Scenes are processed in parallel across the thread pool while the
+     conversion of each individual scene runs serially, which keeps the
+     per-scene work in one process and one page-cache pass.
+*****************************************************************************/
+#include <getopt.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include "error_handler.h"
+#include "espa_buffer.h"
+#include "espa_xml_init.h"
+#include "convert_lpgs_to_espa.h"
+#include "convert_espa_to_gtif.h"
+#include "espa_package.h"
+#include "espa_prefetch.h"
+#include "espa_perf.h"
+#include "espa_cancel.h"
+#include "espa_startup.h"
+
+/* Work order for a single scene from the manifest */
+typedef struct batch_scene
+{
+    char *mtl_file;            /* input LPGS MTL metadata filename */
+    char *xml_file;            /* output ESPA XML metadata filename */
+    int status;                /* SUCCESS/ERROR result for this scene */
+} Batch_scene_t;
+
+/* Read-only batch options shared by all the workers */
+typedef struct batch_context
+{
+    Batch_scene_t *scenes;     /* array of scenes to process */
+    int num_scenes;            /* number of scenes in the array */
+    bool del_src;              /* remove the source files after conversion? */
+    bool gtif;                 /* convert each scene on to GeoTIFF? */
+    bool tiled;                /* write the GeoTIFFs tiled vs. stripped? */
+    bool package;              /* assemble a delivery tar for each scene? */
+} Batch_context_t;
+
+/* Shared state for the pool of scene workers */
+typedef struct batch_pool
+{
+    const Batch_context_t *context;  /* read-only batch options */
+    int next_scene;            /* next scene index to be processed */
+    pthread_mutex_t lock;      /* mutex protecting next_scene */
+} Batch_pool_t;
+
+
+/******************************************************************************
+MODULE: usage
+
+PURPOSE: Prints the usage information for this application.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+---------    ---------------  -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added the packaging mode
+
+NOTES:
+******************************************************************************/
+void usage ()
+{
+    printf ("espa_convert_batch converts a batch of LPGS scenes listed in a "
+            "manifest file to the ESPA internal raw binary format, with an "
+            "optional pipelined conversion on to GeoTIFF, using a shared "
+            "pool of threads in a single process.\n\n");
+    printf ("usage: espa_convert_batch "
+            "--manifest=input_manifest_filename\n"
+            "[--num_threads=number_of_threads] [--gtif] [--tiled] "
+            "[--compress_img] [--package] [--del_src_files]\n");
+
+    printf ("\nwhere the following parameters are required:\n");
+    printf ("    -manifest: name of the input manifest file.  Each line "
+            "contains the input LPGS MTL filename followed by the output "
+            "ESPA XML filename, separated by whitespace.  Blank lines and "
+            "lines starting with '#' are skipped.\n");
+    printf ("\nwhere the following parameters are optional:\n");
+    printf ("    -num_threads: number of scenes to process concurrently "
+            "(default is 1)\n");
+    printf ("    -gtif: after each scene is converted to the ESPA internal "
+            "format, also convert it to GeoTIFF.  The base GeoTIFF filename "
+            "is the ESPA XML filename without the .xml extension.\n");
+    printf ("    -tiled: write the GeoTIFFs tiled instead of stripped (only "
+            "used with -gtif)\n");
+    printf ("    -compress_img: write the ESPA raw binary bands through the "
+            "block-compressed container, so delivery compression happens "
+            "while the band buffers are cache-hot during conversion instead "
+            "of in a separate pass that rereads everything\n");
+    printf ("    -package: after each scene completes, assemble its XML, "
+            "raw binary, and ENVI header files into an uncompressed tar "
+            "package named after the XML file.  The members are copied with "
+            "kernel-side extent copies where the filesystem supports them, "
+            "so the payloads do not pass through userspace again.\n");
+    printf ("    -del_src_files: the source files will be removed as each "
+            "conversion stage completes\n");
+    printf ("\nExample: espa_convert_batch --manifest=scenes.txt "
+            "--num_threads=4 --gtif\n");
+    printf ("\n    --startup-profile: report the time spent in the startup "
+            "phases (library init, schema validation, XML parse, first I/O) "
+            "to stderr; shared by all the ESPA tools\n");
+}
+
+
+/******************************************************************************
+MODULE:  get_args
+
+PURPOSE:  Gets the command-line arguments and validates that the required
+arguments were specified.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error getting the command-line arguments or a command-line
+                argument and associated value were not specified
+SUCCESS         No errors encountered
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Added the packaging mode
+
+NOTES:
+  1. Memory is allocated for the input manifest file.  This should be a
+     character pointer set to NULL on input.  The caller is responsible
+     for freeing the allocated memory upon successful return.
+******************************************************************************/
+short get_args
+(
+    int argc,             /* I: number of cmd-line args */
+    char *argv[],         /* I: string of cmd-line args */
+    char **manifest_file, /* O: address of input manifest filename */
+    int *num_threads,     /* O: number of scenes to process concurrently */
+    bool *gtif,           /* O: should the scenes also be converted to
+                                GeoTIFF? */
+    bool *tiled,          /* O: should the GeoTIFFs be written tiled? */
+    bool *compress_img,   /* O: should the bands be written through the
+                                block-compressed container? */
+    bool *package,        /* O: should a delivery tar be assembled for each
+                                scene? */
+    bool *del_src         /* O: should source files be removed? */
+)
+{
+    int c;                           /* current argument index */
+    int option_index;                /* index for the command-line option */
+    static int del_flag = 0;         /* flag for removing the source files */
+    static int gtif_flag = 0;        /* flag for the GeoTIFF stage */
+    static int tiled_flag = 0;       /* flag for writing tiled GeoTIFFs */
+    static int compress_flag = 0;    /* flag for compressed band output */
+    static int package_flag = 0;     /* flag for the packaging mode */
+    char errmsg[STR_SIZE];           /* error message */
+    char FUNC_NAME[] = "get_args";   /* function name */
+    static struct option long_options[] =
+    {
+        {"del_src_files", no_argument, &del_flag, 1},
+        {"gtif", no_argument, &gtif_flag, 1},
+        {"tiled", no_argument, &tiled_flag, 1},
+        {"compress_img", no_argument, &compress_flag, 1},
+        {"package", no_argument, &package_flag, 1},
+        {"manifest", required_argument, 0, 'm'},
+        {"num_threads", required_argument, 0, 't'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    /* Loop through all the cmd-line options */
+    opterr = 0;   /* turn off getopt_long error msgs as we'll print our own */
+    while (1)
+    {
+        /* optstring in call to getopt_long is empty since we will only
+           support the long options */
+        c = getopt_long (argc, argv, "", long_options, &option_index);
+        if (c == -1)
+        {   /* Out of cmd-line options */
+            break;
+        }
+
+        switch (c)
+        {
+            case 0:
+                /* If this option set a flag, do nothing else now. */
+                if (long_options[option_index].flag != 0)
+                    break;
+
+            case 'h':  /* help */
+                usage ();
+                return (ERROR);
+                break;
+
+            case 'm':  /* manifest file */
+                *manifest_file = strdup (optarg);
+                break;
+
+            case 't':  /* number of scene processing threads */
+                *num_threads = atoi (optarg);
+                break;
+
+            case '?':
+            default:
+                sprintf (errmsg, "Unknown option %s", argv[optind-1]);
+                error_handler (true, FUNC_NAME, errmsg);
+                usage ();
+                return (ERROR);
+                break;
+        }
+    }
+
+    /* Make sure the manifest file was specified */
+    if (*manifest_file == NULL)
+    {
+        sprintf (errmsg, "Manifest file is a required argument");
+        error_handler (true, FUNC_NAME, errmsg);
+        usage ();
+        return (ERROR);
+    }
+
+    /* Make sure the number of threads is sensible */
+    if (*num_threads < 1)
+    {
+        sprintf (errmsg, "Number of threads must be 1 or higher");
+        error_handler (true, FUNC_NAME, errmsg);
+        usage ();
+        return (ERROR);
+    }
+
+    /* Check the flags */
+    if (del_flag)
+        *del_src = true;
+    if (gtif_flag)
+        *gtif = true;
+    if (tiled_flag)
+        *tiled = true;
+    if (compress_flag)
+        *compress_img = true;
+    if (package_flag)
+        *package = true;
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  read_manifest
+
+PURPOSE:  Reads the manifest file into an array of scene work orders.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error reading the manifest file
+SUCCESS         No errors encountered
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Memory is allocated for the scene array and the filenames within it.
+     The caller is responsible for freeing the allocated memory.
+******************************************************************************/
+short read_manifest
+(
+    char *manifest_file,      /* I: name of the input manifest file */
+    Batch_scene_t **scenes,   /* O: address of the scene array */
+    int *num_scenes           /* O: number of scenes in the array */
+)
+{
+    char FUNC_NAME[] = "read_manifest";  /* function name */
+    char errmsg[STR_SIZE];    /* error message */
+    char line[STR_SIZE*2];    /* current line from the manifest */
+    char *mtl_file = NULL;    /* MTL filename token from the current line */
+    char *xml_file = NULL;    /* XML filename token from the current line */
+    char *extra = NULL;       /* unexpected extra token */
+    int line_number = 0;      /* current line number in the manifest */
+    int count = 0;            /* number of scenes read */
+    int alloc_count = 16;     /* number of scenes allocated */
+    Batch_scene_t *scene_list = NULL;  /* local scene array */
+    Batch_scene_t *tmp_list = NULL;    /* temporary pointer for realloc */
+    FILE *fptr = NULL;        /* manifest file pointer */
+
+    /* Open the manifest file */
+    fptr = fopen (manifest_file, "r");
+    if (fptr == NULL)
+    {
+        sprintf (errmsg, "Unable to open the manifest file: %s",
+            manifest_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Allocate the initial scene array */
+    scene_list = calloc (alloc_count, sizeof (Batch_scene_t));
+    if (scene_list == NULL)
+    {
+        sprintf (errmsg, "Allocating memory for the scene array");
+        error_handler (true, FUNC_NAME, errmsg);
+        fclose (fptr);
+        return (ERROR);
+    }
+
+    /* Read the scenes, one per line */
+    while (fgets (line, sizeof (line), fptr) != NULL)
+    {
+        line_number++;
+
+        /* Pull the MTL and XML filenames from the line, skipping blank
+           and comment lines */
+        mtl_file = strtok (line, " \t\r\n");
+        if (mtl_file == NULL || mtl_file[0] == '#')
+            continue;
+        xml_file = strtok (NULL, " \t\r\n");
+        extra = strtok (NULL, " \t\r\n");
+        if (xml_file == NULL || extra != NULL)
+        {
+            sprintf (errmsg, "Line %d of the manifest file does not contain "
+                "an MTL filename followed by an XML filename", line_number);
+            error_handler (true, FUNC_NAME, errmsg);
+            fclose (fptr);
+            *scenes = scene_list;
+            *num_scenes = count;
+            return (ERROR);
+        }
+
+        /* Grow the scene array if needed */
+        if (count == alloc_count)
+        {
+            alloc_count *= 2;
+            tmp_list = realloc (scene_list,
+                alloc_count * sizeof (Batch_scene_t));
+            if (tmp_list == NULL)
+            {
+                sprintf (errmsg, "Growing the scene array");
+                error_handler (true, FUNC_NAME, errmsg);
+                fclose (fptr);
+                *scenes = scene_list;
+                *num_scenes = count;
+                return (ERROR);
+            }
+            scene_list = tmp_list;
+        }
+
+        /* Store the scene */
+        scene_list[count].mtl_file = strdup (mtl_file);
+        scene_list[count].xml_file = strdup (xml_file);
+        scene_list[count].status = ERROR;
+        if (scene_list[count].mtl_file == NULL ||
+            scene_list[count].xml_file == NULL)
+        {
+            sprintf (errmsg, "Allocating memory for the scene filenames");
+            error_handler (true, FUNC_NAME, errmsg);
+            fclose (fptr);
+            *scenes = scene_list;
+            *num_scenes = count + 1;
+            return (ERROR);
+        }
+        count++;
+    }
+
+    /* Close the manifest file */
+    fclose (fptr);
+
+    /* Make sure at least one scene was listed */
+    if (count == 0)
+    {
+        sprintf (errmsg, "Manifest file %s does not contain any scenes",
+            manifest_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        free (scene_list);
+        return (ERROR);
+    }
+
+    *scenes = scene_list;
+    *num_scenes = count;
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  process_scene
+
+PURPOSE:  Runs the formatting chain for a single scene: LPGS to ESPA raw
+binary, followed by the optional GeoTIFF stage.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           An error occurred processing the scene
+SUCCESS         Scene was processed successfully
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Wait on the scene's queued metadata/header
+                              writes before reporting the scene complete
+8/31/2026    Gail Schmidt     Assemble the scene's delivery package once its
+                              files are complete, if requested
+8/31/2026    Gail Schmidt     Emit one resource accounting record per scene
+                              when the instrumentation is enabled
+8/31/2026    Gail Schmidt     Prefetch the band files ahead of the stages
+                              that read them back
+
+NOTES:
+******************************************************************************/
+int process_scene
+(
+    const Batch_context_t *context,  /* I: read-only batch options */
+    Batch_scene_t *scene             /* I: scene to process */
+)
+{
+    char FUNC_NAME[] = "process_scene";  /* function name */
+    char errmsg[STR_SIZE];      /* error message */
+    char gtif_file[STR_SIZE];   /* base output GeoTIFF filename */
+    char tar_file[STR_SIZE];    /* output delivery package filename */
+    char *cptr = NULL;          /* pointer to the .xml extension */
+    int count;                  /* number of chars copied in snprintf */
+    Espa_scene_context_t scene_context;  /* per-scene state shared by the
+                                   conversion stages */
+    Espa_perf_stage_t perf_stage;  /* resource snapshot for the scene */
+
+    /* Take the resource snapshot for the scene's accounting record; a
+       single flag check when the instrumentation is disabled */
+    espa_perf_stage_begin (&perf_stage);
+
+    /* Convert the LPGS MTL and data to ESPA raw binary and XML.  The band
+       conversion runs serially since the batch parallelism is across
+       scenes.  The scene context carries the parsed metadata into the
+       following stages so they don't re-parse the XML file. */
+    init_scene_context (&scene_context);
+    if (convert_lpgs_to_espa_scene (&scene_context, scene->mtl_file,
+        scene->xml_file, context->del_src, 1) != SUCCESS)
+    {
+        sprintf (errmsg, "Converting %s to the ESPA internal format",
+            scene->mtl_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        free_scene_context (&scene_context);
+        return (ERROR);
+    }
+
+    /* Convert the scene on to GeoTIFF if requested, using the XML filename
+       without the .xml extension as the base GeoTIFF filename */
+    if (context->gtif)
+    {
+        /* Hint the band files to the kernel in their declared order so
+           the stage's reads overlap this setup work; the cached metadata
+           lists the files without re-parsing the XML */
+        if (load_scene_context_metadata (&scene_context, scene->xml_file)
+            == SUCCESS)
+            espa_prefetch_band_files (&scene_context.xml_metadata, 0);
+
+        count = snprintf (gtif_file, sizeof (gtif_file), "%s",
+            scene->xml_file);
+        if (count < 0 || count >= sizeof (gtif_file))
+        {
+            sprintf (errmsg, "Overflow of gtif_file string");
+            error_handler (true, FUNC_NAME, errmsg);
+            free_scene_context (&scene_context);
+            return (ERROR);
+        }
+        cptr = strrchr (gtif_file, '.');
+        if (cptr != NULL && !strcmp (cptr, ".xml"))
+            *cptr = '\0';
+
+        if (convert_espa_to_gtif_scene (&scene_context, scene->xml_file,
+            gtif_file, NULL, context->del_src, context->tiled, false, NULL,
+            0, 1, 1) != SUCCESS)
+        {
+            sprintf (errmsg, "Converting %s to GeoTIFF", scene->xml_file);
+            error_handler (true, FUNC_NAME, errmsg);
+            free_scene_context (&scene_context);
+            return (ERROR);
+        }
+    }
+
+    /* Complete any metadata/header writes still queued behind the scene
+       before its result is reported */
+    if (wait_scene_context_writes (&scene_context) != SUCCESS)
+    {
+        sprintf (errmsg, "Completing the metadata/header writes for %s",
+            scene->xml_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        free_scene_context (&scene_context);
+        return (ERROR);
+    }
+
+    /* Assemble the scene's delivery package now that all its files are
+       complete, using the tar name derived from the XML filename.  The
+       cached metadata lists the band files, so the packaging does not
+       re-parse the XML. */
+    if (context->package)
+    {
+        count = snprintf (tar_file, sizeof (tar_file), "%s",
+            scene->xml_file);
+        if (count < 0 || count >= sizeof (tar_file) - 4)
+        {
+            sprintf (errmsg, "Overflow of tar_file string");
+            error_handler (true, FUNC_NAME, errmsg);
+            free_scene_context (&scene_context);
+            return (ERROR);
+        }
+        cptr = strrchr (tar_file, '.');
+        if (cptr != NULL && !strcmp (cptr, ".xml"))
+            *cptr = '\0';
+        strcat (tar_file, ".tar");
+
+        if (load_scene_context_metadata (&scene_context, scene->xml_file)
+            != SUCCESS)
+        {
+            sprintf (errmsg, "Packaging %s for delivery", scene->xml_file);
+            error_handler (true, FUNC_NAME, errmsg);
+            free_scene_context (&scene_context);
+            return (ERROR);
+        }
+
+        /* Hint the band files ahead of the packaging pass, which streams
+           every file of the scene back in */
+        espa_prefetch_band_files (&scene_context.xml_metadata, 0);
+
+        if (espa_package_scene (scene->xml_file,
+                &scene_context.xml_metadata, tar_file) != SUCCESS)
+        {
+            sprintf (errmsg, "Packaging %s for delivery", scene->xml_file);
+            error_handler (true, FUNC_NAME, errmsg);
+            free_scene_context (&scene_context);
+            return (ERROR);
+        }
+    }
+
+    /* Emit the scene's resource accounting record */
+    espa_perf_stage_end (scene->xml_file, &perf_stage);
+
+    free_scene_context (&scene_context);
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  batch_scene_worker
+
+PURPOSE:  Thread worker which pulls scenes from the shared pool and runs the
+formatting chain for each one until no scenes remain.
+
+RETURN VALUE:
+Type = void *
+Value           Description
+-----           -----------
+NULL            Always returned
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. A scene that fails is recorded in its work order and does not stop the
+     remaining scenes from being processed.
+******************************************************************************/
+static void *batch_scene_worker
+(
+    void *pool_ptr      /* I/O: pool of scenes to process (Batch_pool_t) */
+)
+{
+    Batch_pool_t *pool = pool_ptr;   /* shared scene pool */
+    Batch_scene_t *scene = NULL;     /* current scene to process */
+    int scene_index;                 /* index of the current scene */
+
+    while (true)
+    {
+        /* Pull the next scene from the pool */
+        pthread_mutex_lock (&pool->lock);
+        scene_index = pool->next_scene;
+        if (scene_index < pool->context->num_scenes)
+            pool->next_scene++;
+        pthread_mutex_unlock (&pool->lock);
+        if (scene_index >= pool->context->num_scenes)
+            break;
+
+        /* Run the formatting chain for this scene */
+        scene = &pool->context->scenes[scene_index];
+        scene->status = process_scene (pool->context, scene);
+    }
+
+    return (NULL);
+}
+
+
+/******************************************************************************
+MODULE:  espa_convert_batch
+
+PURPOSE:  Runs the LPGS to ESPA formatting chain for a batch of scenes listed
+in a manifest file, using a shared pool of threads in a single process.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error processing one or more of the scenes
+SUCCESS         All scenes were processed successfully
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+8/31/2026    Gail Schmidt     Install the cooperative cancellation handler
+                              so SIGTERM unwinds cleanly
+
+NOTES:
+******************************************************************************/
+int main (int argc, char** argv)
+{
+    char FUNC_NAME[] = "espa_convert_batch";  /* function name */
+    char errmsg[STR_SIZE];        /* error message */
+    char *manifest_file = NULL;   /* input manifest filename */
+    bool del_src = false;         /* should source files be removed? */
+    bool gtif = false;            /* should the scenes be converted to
+                                     GeoTIFF? */
+    bool tiled = false;           /* should the GeoTIFFs be written tiled? */
+    bool compress_img = false;    /* should the bands be written through the
+                                     block-compressed container? */
+    bool package = false;         /* should a delivery tar be assembled for
+                                     each scene? */
+    int num_threads = 1;          /* number of scene processing threads */
+    int num_scenes = 0;           /* number of scenes in the manifest */
+    int num_failed = 0;           /* number of scenes that failed */
+    int i;                        /* looping variable */
+    Batch_scene_t *scenes = NULL; /* array of scenes to process */
+    Batch_context_t context;      /* read-only batch options */
+    Batch_pool_t pool;            /* shared scene pool */
+
+    /* Install the cooperative cancellation handler so SIGTERM/SIGINT
+       unwind cleanly at the conversion checkpoints */
+    espa_cancel_install ();
+
+    /* Strip the shared --startup-profile option before parsing the
+       tool's own arguments */
+    espa_startup_profile_args (&argc, argv);
+
+    /* Read the command-line arguments */
+    if (get_args (argc, argv, &manifest_file, &num_threads, &gtif, &tiled,
+        &compress_img, &package, &del_src) != SUCCESS)
+    {   /* get_args already printed the error message */
+        exit (ERROR);
+    }
+
+    /* Read the manifest file into the scene array */
+    if (read_manifest (manifest_file, &scenes, &num_scenes) != SUCCESS)
+    {   /* Error messages already written */
+        exit (ERROR);
+    }
+    printf ("Processing %d scenes from %s with %d thread(s)\n", num_scenes,
+        manifest_file, num_threads);
+
+    /* Negotiate the compressed band sink with the raw binary writer for
+       every worker before any conversion starts; the converters then
+       compress each band while its buffers are cache-hot instead of a
+       separate compression pass rereading the outputs */
+    if (compress_img)
+        setenv ("ESPA_IMG_COMPRESS", "1", 1);
+
+    /* Initialize the libxml2 parser before any threads use it, since the
+       parser setup is not thread-safe to repeat concurrently */
+    espa_xml_init ();
+
+    /* Don't use more threads than there are scenes */
+    if (num_threads > num_scenes)
+        num_threads = num_scenes;
+
+    /* Set up the read-only context shared by the workers */
+    context.scenes = scenes;
+    context.num_scenes = num_scenes;
+    context.del_src = del_src;
+    context.gtif = gtif;
+    context.tiled = tiled;
+    context.package = package;
+
+    if (num_threads <= 1)
+    {
+        /* Process the scenes serially */
+        for (i = 0; i < num_scenes; i++)
+            scenes[i].status = process_scene (&context, &scenes[i]);
+    }
+    else
+    {
+        pthread_t threads[num_threads];  /* thread pool handles */
+        int threads_created = 0;         /* number of threads started */
+
+        /* Set up the scene pool */
+        pool.context = &context;
+        pool.next_scene = 0;
+        if (pthread_mutex_init (&pool.lock, NULL) != 0)
+        {
+            sprintf (errmsg, "Initializing the scene pool mutex");
+            error_handler (true, FUNC_NAME, errmsg);
+            exit (ERROR);
+        }
+
+        /* Start the scene workers */
+        for (i = 0; i < num_threads; i++)
+        {
+            if (pthread_create (&threads[i], NULL, batch_scene_worker, &pool)
+                != 0)
+            {
+                sprintf (errmsg, "Unable to create all %d scene threads; "
+                    "continuing with %d", num_threads, threads_created);
+                error_handler (false, FUNC_NAME, errmsg);
+                break;
+            }
+            threads_created++;
+        }
+
+        /* Make sure at least one thread was started, otherwise process the
+           scenes serially */
+        if (threads_created == 0)
+        {
+            for (i = 0; i < num_scenes; i++)
+                scenes[i].status = process_scene (&context, &scenes[i]);
+        }
+
+        /* Wait for the workers to drain the pool */
+        for (i = 0; i < threads_created; i++)
+            pthread_join (threads[i], NULL);
+        pthread_mutex_destroy (&pool.lock);
+    }
+
+    /* Report the per-scene results */
+    for (i = 0; i < num_scenes; i++)
+    {
+        if (scenes[i].status != SUCCESS)
+        {
+            printf ("Failed: %s\n", scenes[i].mtl_file);
+            num_failed++;
+        }
+    }
+    printf ("%d of %d scenes completed successfully\n",
+        num_scenes - num_failed, num_scenes);
+
+    /* Release the band buffers pooled across the batch */
+    espa_drain_buffer_pool ();
+
+    /* Clean up the libxml2 parser */
+    espa_xml_cleanup ();
+
+    /* Free the pointers */
+    for (i = 0; i < num_scenes; i++)
+    {
+        free (scenes[i].mtl_file);
+        free (scenes[i].xml_file);
+    }
+    free (scenes);
+    free (manifest_file);
+
+    /* Exit with an error if any of the scenes failed */
+    if (num_failed != 0)
+        exit (ERROR);
+
+    /* Successful completion */
+    exit (SUCCESS);
+}
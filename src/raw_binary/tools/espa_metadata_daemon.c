@@ -0,0 +1,205 @@
+/*****************************************************************************
+FILE: espa_metadata_daemon
+
+PURPOSE: Runs the long-lived metadata validation/parsing daemon, which keeps
+libxml2 and the compiled ESPA schema warm and hands parsed metadata back to
+the tools over a unix socket.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The XML metadata format parsed or written via this library follows the
+     ESPA internal metadata format found in ESPA Raw Binary Format v1.0.doc.
+     The schema for the ESPA internal metadata format is available at
+     http://espa.cr.usgs.gov/schema/espa_internal_metadata_v1_0.xsd.
+*****************************************************************************/
+#include <getopt.h>
+#include "metadata_daemon.h"
+#include "espa_startup.h"
+
+/******************************************************************************
+MODULE: usage
+
+PURPOSE: Prints the usage information for this application.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+---------    ---------------  -------------------------------------
+8/31/2026    Gail Schmidt     Original Development
+
+NOTES:
+******************************************************************************/
+void usage ()
+{
+    printf ("espa_metadata_daemon runs a long-lived daemon which validates "
+            "and parses ESPA XML metadata files on behalf of the tools, "
+            "keeping libxml2 and the compiled schema warm across "
+            "invocations.  Tools use the daemon when the "
+            "ESPA_METADATA_DAEMON environment variable is set to the "
+            "daemon's socket path, and fall back to the in-process "
+            "validate and parse otherwise.  The daemon runs until it is "
+            "terminated.\n\n");
+    printf ("usage: espa_metadata_daemon "
+            "--socket=socket_path\n");
+
+    printf ("\nwhere the following parameters are required:\n");
+    printf ("    -socket: path of the unix socket for the daemon to listen "
+            "on; point the ESPA_METADATA_DAEMON environment variable of the "
+            "tools at the same path\n");
+    printf ("\nExample: espa_metadata_daemon "
+            "--socket=/tmp/espa_metadata.sock &\n");
+    printf ("         export ESPA_METADATA_DAEMON=/tmp/espa_metadata.sock\n");
+    printf ("\n    --startup-profile: report the time spent in the startup "
+            "phases (library init, schema validation, XML parse, first I/O) "
+            "to stderr; shared by all the ESPA tools\n");
+}
+
+
+/******************************************************************************
+MODULE:  get_args
+
+PURPOSE:  Gets the command-line arguments and validates that the required
+arguments were specified.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error getting the command-line arguments or a command-line
+                argument and associated value were not specified
+SUCCESS         No errors encountered
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Memory is allocated for the socket path.  This should be a character
+     pointer set to NULL on input.  The caller is responsible for freeing
+     the allocated memory upon successful return.
+******************************************************************************/
+short get_args
+(
+    int argc,             /* I: number of cmd-line args */
+    char *argv[],         /* I: string of cmd-line args */
+    char **socket_path    /* O: address of the daemon socket path */
+)
+{
+    int c;                           /* current argument index */
+    int option_index;                /* index for the command-line option */
+    char errmsg[STR_SIZE];           /* error message */
+    char FUNC_NAME[] = "get_args";   /* function name */
+    static struct option long_options[] =
+    {
+        {"socket", required_argument, 0, 's'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    /* Loop through all the cmd-line options */
+    opterr = 0;   /* turn off getopt_long error msgs as we'll print our own */
+    while (1)
+    {
+        /* optstring in call to getopt_long is empty since we will only
+           support the long options */
+        c = getopt_long (argc, argv, "", long_options, &option_index);
+        if (c == -1)
+        {   /* Out of cmd-line options */
+            break;
+        }
+
+        switch (c)
+        {
+            case 0:
+                /* If this option set a flag, do nothing else now. */
+                if (long_options[option_index].flag != 0)
+                    break;
+
+            case 'h':  /* help */
+                usage ();
+                return (ERROR);
+                break;
+
+            case 's':  /* daemon socket path */
+                *socket_path = strdup (optarg);
+                break;
+
+            case '?':
+            default:
+                sprintf (errmsg, "Unknown option %s", argv[optind-1]);
+                error_handler (true, FUNC_NAME, errmsg);
+                usage ();
+                return (ERROR);
+                break;
+        }
+    }
+
+    /* Make sure the socket path was specified */
+    if (*socket_path == NULL)
+    {
+        sprintf (errmsg, "Socket path is a required argument");
+        error_handler (true, FUNC_NAME, errmsg);
+        usage ();
+        return (ERROR);
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  main
+
+PURPOSE:  Runs the metadata daemon on the specified unix socket.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error running the daemon
+SUCCESS         Not returned; the daemon runs until terminated
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+int main (int argc, char** argv)
+{
+    char *socket_path = NULL;     /* daemon socket path */
+
+    /* Strip the shared --startup-profile option before parsing the
+       tool's own arguments */
+    espa_startup_profile_args (&argc, argv);
+
+    /* Read the command-line arguments */
+    if (get_args (argc, argv, &socket_path) != SUCCESS)
+    {   /* get_args already printed the error message */
+        exit (EXIT_FAILURE);
+    }
+
+    /* Run the daemon; this only returns on error */
+    if (run_metadata_daemon (socket_path) != SUCCESS)
+    {  /* Error messages already written */
+        free (socket_path);
+        exit (EXIT_FAILURE);
+    }
+
+    /* Not reached */
+    free (socket_path);
+    exit (EXIT_SUCCESS);
+}
@@ -22,6 +22,7 @@ NOTES:
 *****************************************************************************/
 #include <getopt.h>
 #include "subset_metadata.h"
+#include "espa_startup.h"
 
 
 /******************************************************************************
@@ -61,6 +62,9 @@ void usage ()
             "--xml=LE70230282011250EDC00.xml "
             "--subset_xml=LE70230282011250EDC00_subset.xml "
             "--product L1G --product L1T --product surface_reflectance\n");
+    printf ("\n    --startup-profile: report the time spent in the startup "
+            "phases (library init, schema validation, XML parse, first I/O) "
+            "to stderr; shared by all the ESPA tools\n");
 }
 
 
@@ -237,6 +241,10 @@ int main (int argc, char** argv)
                                        product types */
     int nproducts;                   /* number of product types specified */
 
+    /* Strip the shared --startup-profile option before parsing the
+       tool's own arguments */
+    espa_startup_profile_args (&argc, argv);
+
     /* Read the command-line arguments */
     if (get_args (argc, argv, &xml_infile, &xml_subset_outfile, &nproducts,
         products) != SUCCESS)
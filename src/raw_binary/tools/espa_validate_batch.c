@@ -0,0 +1,336 @@
+/*****************************************************************************
+FILE: espa_validate_batch
+
+PURPOSE: Validates a batch of ESPA XML metadata files listed in a manifest
+file against the ESPA schema, within a single process.  The schema is parsed
+and compiled once and shared across a pool of validation threads, so archive
+sweeps don't pay a process fork and a schema compile per file.
+
+PROJECT:  Land Satellites Data System Science Research and Development (LSRD)
+at the USGS EROS
+
+LICENSE TYPE:  NASA Open Source Agreement Version 1.3
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. The manifest file contains one XML metadata filename per line.  Blank
+     lines and lines starting with '#' are skipped.
+*****************************************************************************/
+#include <getopt.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "error_handler.h"
+#include "espa_metadata.h"
+#include "espa_startup.h"
+
+/******************************************************************************
+MODULE: usage
+
+PURPOSE: Prints the usage information for this application.
+
+RETURN VALUE:
+Type = None
+
+HISTORY:
+Date         Programmer       Reason
+---------    ---------------  -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+void usage ()
+{
+    printf ("espa_validate_batch validates a batch of ESPA XML metadata "
+            "files listed in a manifest file against the ESPA schema, "
+            "sharing one compiled schema across a pool of threads in a "
+            "single process.\n\n");
+    printf ("usage: espa_validate_batch "
+            "--manifest=input_manifest_filename\n"
+            "[--num_threads=number_of_threads]\n");
+
+    printf ("\nwhere the following parameters are required:\n");
+    printf ("    -manifest: name of the input manifest file.  Each line "
+            "contains one XML metadata filename.  Blank lines and lines "
+            "starting with '#' are skipped.\n");
+    printf ("\nwhere the following parameters are optional:\n");
+    printf ("    -num_threads: number of files to validate concurrently "
+            "(default is one thread per online processor)\n");
+    printf ("\nExample: espa_validate_batch --manifest=archive.txt "
+            "--num_threads=8\n");
+    printf ("\n    --startup-profile: report the time spent in the startup "
+            "phases (library init, schema validation, XML parse, first I/O) "
+            "to stderr; shared by all the ESPA tools\n");
+}
+
+
+/******************************************************************************
+MODULE:  get_args
+
+PURPOSE:  Gets the command-line arguments and validates that the required
+arguments were specified.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error getting the command-line arguments or a command-line
+                argument and associated value were not specified
+SUCCESS         No errors encountered
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Memory is allocated for the input manifest file.  This should be a
+     character pointer set to NULL on input.  The caller is responsible
+     for freeing the allocated memory upon successful return.
+******************************************************************************/
+short get_args
+(
+    int argc,             /* I: number of cmd-line args */
+    char *argv[],         /* I: string of cmd-line args */
+    char **manifest_file, /* O: address of input manifest filename */
+    int *num_threads      /* O: number of files to validate concurrently */
+)
+{
+    int c;                           /* current argument index */
+    int option_index;                /* index for the command-line option */
+    char errmsg[STR_SIZE];           /* error message */
+    char FUNC_NAME[] = "get_args";   /* function name */
+    static struct option long_options[] =
+    {
+        {"manifest", required_argument, 0, 'm'},
+        {"num_threads", required_argument, 0, 't'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    /* Loop through all the cmd-line options */
+    opterr = 0;   /* turn off getopt_long error msgs as we'll print our own */
+    while (1)
+    {
+        /* optstring in call to getopt_long is empty since we will only
+           support the long options */
+        c = getopt_long (argc, argv, "", long_options, &option_index);
+        if (c == -1)
+        {   /* Out of cmd-line options */
+            break;
+        }
+
+        switch (c)
+        {
+            case 0:
+                /* If this option set a flag, do nothing else now. */
+                if (long_options[option_index].flag != 0)
+                    break;
+
+            case 'h':  /* help */
+                usage ();
+                return (ERROR);
+                break;
+
+            case 'm':  /* manifest file */
+                *manifest_file = strdup (optarg);
+                break;
+
+            case 't':  /* number of validation threads */
+                *num_threads = atoi (optarg);
+                break;
+
+            case '?':
+            default:
+                sprintf (errmsg, "Unknown option %s", argv[optind-1]);
+                error_handler (true, FUNC_NAME, errmsg);
+                usage ();
+                return (ERROR);
+                break;
+        }
+    }
+
+    /* Make sure the manifest file was specified */
+    if (*manifest_file == NULL)
+    {
+        sprintf (errmsg, "Manifest file is a required argument");
+        error_handler (true, FUNC_NAME, errmsg);
+        usage ();
+        return (ERROR);
+    }
+
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  read_manifest
+
+PURPOSE:  Reads the manifest file into an array of XML metadata filenames.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error reading the manifest file
+SUCCESS         Manifest file was read
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+  1. Memory is allocated for the filename array and each filename.  The
+     caller is responsible for freeing both upon successful return.
+******************************************************************************/
+int read_manifest
+(
+    char *manifest_file,  /* I: name of the input manifest file */
+    char ***xml_files,    /* O: address of the array of XML filenames */
+    int *num_files        /* O: number of XML filenames in the array */
+)
+{
+    char FUNC_NAME[] = "read_manifest";   /* function name */
+    char errmsg[STR_SIZE];        /* error message */
+    char line[STR_SIZE];          /* current line of the manifest */
+    char *token = NULL;           /* filename token on the current line */
+    char **files = NULL;          /* array of XML filenames */
+    int nfiles = 0;               /* number of filenames read */
+    int nalloc = 0;               /* number of filename slots allocated */
+    char **tmp_files = NULL;      /* temporary pointer for realloc */
+    FILE *fptr = NULL;            /* manifest file pointer */
+
+    /* Open the manifest file */
+    fptr = fopen (manifest_file, "r");
+    if (fptr == NULL)
+    {
+        sprintf (errmsg, "Opening the manifest file %s", manifest_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        return (ERROR);
+    }
+
+    /* Read the XML filenames, one per line, skipping blank and comment
+       lines */
+    while (fgets (line, sizeof (line), fptr) != NULL)
+    {
+        token = strtok (line, " \t\r\n");
+        if (token == NULL || token[0] == '#')
+            continue;
+
+        /* Grow the filename array as needed */
+        if (nfiles >= nalloc)
+        {
+            nalloc = (nalloc == 0) ? 64 : nalloc * 2;
+            tmp_files = realloc (files, nalloc * sizeof (char *));
+            if (tmp_files == NULL)
+            {
+                sprintf (errmsg, "Allocating the filename array for %d "
+                    "files", nalloc);
+                error_handler (true, FUNC_NAME, errmsg);
+                fclose (fptr);
+                free (files);
+                return (ERROR);
+            }
+            files = tmp_files;
+        }
+
+        files[nfiles] = strdup (token);
+        if (files[nfiles] == NULL)
+        {
+            sprintf (errmsg, "Allocating the filename for line %d",
+                nfiles + 1);
+            error_handler (true, FUNC_NAME, errmsg);
+            fclose (fptr);
+            free (files);
+            return (ERROR);
+        }
+        nfiles++;
+    }
+    fclose (fptr);
+
+    /* Make sure at least one filename was listed */
+    if (nfiles == 0)
+    {
+        sprintf (errmsg, "Manifest file %s contains no XML filenames",
+            manifest_file);
+        error_handler (true, FUNC_NAME, errmsg);
+        free (files);
+        return (ERROR);
+    }
+
+    *xml_files = files;
+    *num_files = nfiles;
+    return (SUCCESS);
+}
+
+
+/******************************************************************************
+MODULE:  espa_validate_batch
+
+PURPOSE:  Validates a batch of ESPA XML metadata files listed in a manifest
+file against the ESPA schema, using a shared pool of threads in a single
+process.
+
+RETURN VALUE:
+Type = int
+Value           Description
+-----           -----------
+ERROR           Error validating one or more of the XML files
+SUCCESS         All XML files validated successfully
+
+HISTORY:
+Date         Programmer       Reason
+----------   --------------   -------------------------------------
+8/31/2026    Gail Schmidt     Original development
+
+NOTES:
+******************************************************************************/
+int main (int argc, char** argv)
+{
+    char *manifest_file = NULL;   /* input manifest filename */
+    char **xml_files = NULL;      /* array of XML filenames to validate */
+    int num_threads = 0;          /* number of validation threads; 0 uses
+                                     one per online processor */
+    int num_files = 0;            /* number of XML files in the manifest */
+    int status;                   /* overall validation status */
+    int i;                        /* looping variable */
+
+    /* Strip the shared --startup-profile option before parsing the
+       tool's own arguments */
+    espa_startup_profile_args (&argc, argv);
+
+    /* Read the command-line arguments */
+    if (get_args (argc, argv, &manifest_file, &num_threads) != SUCCESS)
+    {   /* get_args already printed the error message */
+        exit (ERROR);
+    }
+
+    /* Read the manifest file into the filename array */
+    if (read_manifest (manifest_file, &xml_files, &num_files) != SUCCESS)
+    {   /* Error messages already written */
+        exit (ERROR);
+    }
+
+    /* Validate the files across the thread pool, sharing one compiled
+       schema; failures are reported as they are found */
+    status = validate_xml_files (xml_files, num_files, num_threads);
+
+    /* Free the pointers */
+    for (i = 0; i < num_files; i++)
+        free (xml_files[i]);
+    free (xml_files);
+    free (manifest_file);
+
+    /* Exit with an error if any of the files failed to validate */
+    if (status != SUCCESS)
+        exit (ERROR);
+
+    /* Successful completion */
+    exit (SUCCESS);
+}